@@ -3,6 +3,7 @@
 #include "megdnn/basic_types.h"
 #include "megdnn/oprs/base.h"
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -52,31 +53,63 @@ public:
                   m_param_ptr{param_ptr},
                   m_param_size{param_size} {}
 
+        //! fill m_buf with the layouts, the opr type and the device
+        void build_key_buf() const;
+
         KeyStorage build_key_storage() const;
+
+    private:
+        KeyStorage hash_key_buf() const;
+        friend class AlgorithmCache;
     };
 
     struct Result {
         ExecutionPolicy policy;
         size_t workspace;
 
-        // for cache collision
+        // for cache collision, only filled by get() on miss to be put back
         SmallVector<size_t> m_buf;
         SmallVector<char> m_param_buf;
     };
 
+    using LastEntry = detail::AlgoCacheLastEntry;
+
     MGE_WIN_DECLSPEC_FUC void put(const Key& key, Result& result);
 
     MGE_WIN_DECLSPEC_FUC Result get(const Key& key);
 
+    /*!
+     * \brief get the result with the one-entry cache of an opr
+     *
+     * \param last the last hit of the opr, see
+     *      MultiAlgoOpr::algo_cache_last_entry(); it is updated on hit
+     */
+    MGE_WIN_DECLSPEC_FUC Result get(const Key& key, LastEntry& last);
+
     MGE_WIN_DECLSPEC_FUC void clear();
 
 private:
-    std::unordered_map<KeyStorage, Result, Hash> m_heuristic_cache;
+    //! the cache is split by key so that lookups from threads rarely contend
+    static constexpr size_t NR_SHARD = 16;
+
+    struct Shard {
+        std::unordered_map<KeyStorage, Result, Hash> heuristic_cache;
 #if __DEPLOY_ON_XP_SP2__
-    size_t m_mtx;
+        size_t mtx;
 #else
-    std::mutex m_mtx;
+        std::mutex mtx;
 #endif
+    };
+
+    Shard m_shards[NR_SHARD];
+
+    //! increased on each modification to invalidate the LastEntry of oprs
+    std::atomic_size_t m_generation{1};
+
+    Shard& shard(const KeyStorage& ks) { return m_shards[ks.k1 % NR_SHARD]; }
+
+    //! get by key whose m_buf is built
+    Result get_built(const Key& key);
 };
 
 }  // namespace megdnn
@@ -3,6 +3,7 @@
 
 #include <cuda_runtime_api.h>
 #include <memory>
+#include <string>
 
 #include "megdnn/internal/visibility_prologue.h"
 namespace megdnn {
@@ -11,6 +12,27 @@ std::unique_ptr<Handle> make_cuda_handle_with_stream(
         cudaStream_t stream, int device_id = -1);
 cudaStream_t get_cuda_stream(Handle* handle);
 
+/*!
+ * \brief storage of the serialized cudnn frontend execution plans
+ *
+ * The plans compiled from the cudnn heuristics are put into the storage, so that
+ * they can be loaded instead of rebuilt in another process. The implementation
+ * must be thread safe.
+ */
+class CudnnPlanStorage {
+public:
+    virtual ~CudnnPlanStorage() = default;
+
+    //! \return empty string if there is no plan for \p key
+    virtual std::string get(const std::string& key) = 0;
+
+    virtual void put(const std::string& key, const std::string& plan) = 0;
+};
+
+//! set the plan storage, which is null by default; return the original one
+std::shared_ptr<CudnnPlanStorage> set_cudnn_plan_storage(
+        std::shared_ptr<CudnnPlanStorage> storage);
+
 }  // namespace megdnn
 #include "megdnn/internal/visibility_epilogue.h"
 
@@ -12,6 +12,7 @@
 #include <utility>
 #endif
 
+#include "megdnn/dtype/float8.hpp"
 #include "megdnn/internal/visibility_prologue.h"
 
 #if MEGDNN_DISABLE_FLOAT16
@@ -38,7 +39,8 @@ namespace megdnn {
 #define MEGDNN_FOREACH_DTYPE_NAME(cb)                                                \
     cb(Float32) cb(Uint8) cb(Int8) cb(Int16) cb(Int32) cb(IntB1) cb(IntB2) cb(IntB4) \
             cb(Byte) DNN_INC_FLOAT16(cb(Float16)) DNN_INC_FLOAT16(cb(BFloat16))      \
-                    cb(UintB4) cb(Bool) cb(Uint16) cb(Complex64)
+                    cb(UintB4) cb(Bool) cb(Uint16) cb(Complex64) cb(Float8E4M3)      \
+                            cb(Float8E5M2)
 
 /*!
  * \brief iterate through each full byte dtype
@@ -46,7 +48,7 @@ namespace megdnn {
 #define MEGDNN_FOREACH_FULL_BYTE_DTYPE(cb)                                      \
     cb(Float32) cb(Uint8) cb(Int8) cb(Int16) cb(Int32) cb(Byte)                 \
             DNN_INC_FLOAT16(cb(Float16)) DNN_INC_FLOAT16(cb(BFloat16)) cb(Bool) \
-                    cb(Uint16) cb(Complex64)
+                    cb(Uint16) cb(Complex64) cb(Float8E4M3) cb(Float8E5M2)
 
 /*!
  * \brief iterate through each fractional byte dtype
@@ -322,6 +324,8 @@ typedef uint16_t dt_uint16;
 DNN_INC_FLOAT16(typedef half_float::half dt_float16;)
 DNN_INC_FLOAT16(typedef half_bfloat16::bfloat16 dt_bfloat16;)
 typedef std::complex<float> dt_complex64;
+typedef float8::e4m3 dt_float8_e4m3;
+typedef float8::e5m2 dt_float8_e5m2;
 
 #define MEGDNN_PARAMETERIZED_DTYPE_ENUM_BASE 100000
 #if MEGDNN_CC_HOST
@@ -350,6 +354,8 @@ struct DTypeEnum {
     Bool = 12,
     Uint16 = 13,
     Complex64 = 14,
+    Float8E4M3 = 15,
+    Float8E5M2 = 16,
 #define FST(_name) _name = MEGDNN_PARAMETERIZED_DTYPE_ENUM_BASE,
 #define D(_name)   _name,
     MEGDNN_FOREACH_PARAMETERIZED_DTYPE_2(FST, D)
@@ -693,6 +699,12 @@ DNN_INC_FLOAT16(MEGDNN_DEF_DT(
         BFloat16, dt_bfloat16, FLOAT, SIGNED,
         std::numeric_limits<dt_bfloat16>::lowest(),
         std::numeric_limits<dt_bfloat16>::max()));
+MEGDNN_DEF_DT(
+        Float8E4M3, dt_float8_e4m3, FLOAT, SIGNED, dt_float8_e4m3::lowest(),
+        dt_float8_e4m3::max());
+MEGDNN_DEF_DT(
+        Float8E5M2, dt_float8_e5m2, FLOAT, SIGNED, dt_float8_e5m2::lowest(),
+        dt_float8_e5m2::max());
 
 template <>
 struct DTypeTrait<dtype::Byte> {
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+#include "megdnn/arch.h"
+
+namespace megdnn {
+namespace float8 {
+
+/*!
+ * \brief 8-bit floating point storage type with \p EXP exponent bits and \p MANT
+ *      mantissa bits
+ *
+ * The encodings follow the OCP 8-bit floating point specification: E4M3 has no
+ * infinity and only one NaN pattern per sign (0x7f), which extends its maximum
+ * finite value to 448; E5M2 follows the IEEE-754 convention with a maximum
+ * finite value of 57344.
+ *
+ * Conversion from float rounds to nearest even and saturates to the maximum
+ * finite value, as the fp8 types are only used as storage of scaled tensors.
+ * All arithmetic is done on float after the implicit conversion.
+ */
+template <int EXP, int MANT>
+class float8_base {
+    static_assert(EXP + MANT == 7, "float8 should have 1 sign bit");
+
+    static constexpr int BIAS = (1 << (EXP - 1)) - 1;
+    static constexpr bool IEEE = EXP != 4;
+    static constexpr uint32_t MANT_MASK = (1u << MANT) - 1;
+    static constexpr uint32_t EXP_MASK = (1u << EXP) - 1;
+    //! 0x7e for E4M3 and 0x7b for E5M2
+    static constexpr uint32_t MAX_CODE = IEEE ? ((EXP_MASK - 1) << MANT) | MANT_MASK
+                                              : (EXP_MASK << MANT) | (MANT_MASK - 1);
+    static constexpr uint32_t NAN_CODE = IEEE ? (EXP_MASK << MANT) | (1u << (MANT - 1))
+                                              : 0x7f;
+
+    uint8_t m_bits;
+
+    union FloatBits {
+        float f;
+        uint32_t u;
+    };
+
+    static MEGDNN_HOST MEGDNN_DEVICE uint8_t from_float(float val) {
+        FloatBits fb;
+        fb.f = val;
+        uint32_t sign = (fb.u >> 24) & 0x80;
+        uint32_t a = fb.u & 0x7fffffff;
+        if (a > 0x7f800000) {
+            return sign | NAN_CODE;
+        }
+        uint32_t code;
+        if (a >= static_cast<uint32_t>(128 - BIAS) << 23) {
+            //! normal in fp8: round the float mantissa to MANT bits and rebias
+            //! the exponent; the carry of rounding moves into the exponent
+            constexpr int drop = 23 - MANT;
+            uint32_t r = a + ((1u << (drop - 1)) - 1) + ((a >> drop) & 1);
+            code = (r >> drop) - (static_cast<uint32_t>(127 - BIAS) << MANT);
+            code = code < MAX_CODE ? code : MAX_CODE;
+        } else {
+            //! subnormal in fp8: the code is val / 2^(1 - BIAS - MANT) rounded
+            //! to nearest even; the float subnormals are all flushed to zero
+            int e = a >> 23;
+            int shift = 151 - BIAS - MANT - e;
+            if (e == 0 || shift > 24) {
+                return sign;
+            }
+            uint32_t m = (a & 0x7fffff) | 0x800000;
+            uint32_t half = 1u << (shift - 1);
+            uint32_t rem = m & ((half << 1) - 1);
+            code = m >> shift;
+            if (rem > half || (rem == half && (code & 1))) {
+                ++code;
+            }
+        }
+        return sign | code;
+    }
+
+    static MEGDNN_HOST MEGDNN_DEVICE float to_float(uint8_t bits) {
+        uint32_t sign = static_cast<uint32_t>(bits & 0x80) << 24;
+        uint32_t e = (bits >> MANT) & EXP_MASK;
+        uint32_t m = bits & MANT_MASK;
+        FloatBits fb;
+        if (IEEE ? e == EXP_MASK : (bits & 0x7f) == NAN_CODE) {
+            fb.u = sign | 0x7f800000 | (m ? 0x400000 : 0);
+        } else if (e == 0) {
+            //! subnormal: m * 2^(1 - BIAS - MANT)
+            FloatBits quantum;
+            quantum.u = static_cast<uint32_t>(128 - BIAS - MANT) << 23;
+            fb.f = static_cast<float>(m) * quantum.f;
+            fb.u |= sign;
+        } else {
+            fb.u = sign | ((e + 127 - BIAS) << 23) | (m << (23 - MANT));
+        }
+        return fb.f;
+    }
+
+public:
+    float8_base() = default;
+
+    template <
+            typename T, typename = typename std::enable_if<
+                                !std::is_same<T, float8_base>::value>::type>
+    MEGDNN_HOST MEGDNN_DEVICE float8_base(T val)
+            : m_bits(from_float(static_cast<float>(val))) {}
+
+    MEGDNN_HOST MEGDNN_DEVICE operator float() const { return to_float(m_bits); }
+
+    MEGDNN_HOST MEGDNN_DEVICE uint8_t bits() const { return m_bits; }
+
+    static MEGDNN_HOST MEGDNN_DEVICE float8_base from_bits(uint8_t bits) {
+        float8_base ret;
+        ret.m_bits = bits;
+        return ret;
+    }
+
+    static MEGDNN_HOST MEGDNN_DEVICE float8_base max() {
+        return from_bits(MAX_CODE);
+    }
+
+    static MEGDNN_HOST MEGDNN_DEVICE float8_base lowest() {
+        return from_bits(0x80 | MAX_CODE);
+    }
+};
+
+using e4m3 = float8_base<4, 3>;
+using e5m2 = float8_base<5, 2>;
+
+}  // namespace float8
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -295,6 +295,21 @@ struct ExecutionPolicy {
     std::vector<ExecutionPolicy> sub_policy;
 };
 
+/*!
+ * \brief the last hit of an opr in AlgorithmCache
+ *
+ * Repeated lookups with the same layouts and param are answered from it,
+ * without hashing the key or locking the cache.
+ */
+struct AlgoCacheLastEntry {
+    //! generation of AlgorithmCache when the entry is filled, 0 for empty
+    size_t generation = 0;
+    SmallVector<size_t> key_buf;
+    SmallVector<char> param_buf;
+    ExecutionPolicy policy;
+    size_t workspace = 0;
+};
+
 /*!
  * \brief define Algorithm and ExecutionPolicy for oprs that have
  *      multiple impl algos
@@ -326,6 +341,8 @@ public:
 
     const ExecutionPolicy& execution_policy() const { return m_execution_policy; }
 
+    AlgoCacheLastEntry& algo_cache_last_entry() { return m_algo_cache_last_entry; }
+
     virtual Algorithm* get_algorithm_from_desc(const AlgorithmDesc&) = 0;
 
 protected:
@@ -333,6 +350,7 @@ protected:
 
 private:
     ExecutionPolicy m_execution_policy;
+    AlgoCacheLastEntry m_algo_cache_last_entry;
 };
 
 //! specialize for nargs == 2
@@ -388,6 +388,48 @@ protected:
 };
 using SeparableFilter = SeparableFilterForward;
 
+/*!
+ * \brief channel reordering, resize, normalization and layout conversion of
+ *      images fused into one pass
+ *
+ * dst = (resize(reorder(src)) - mean) * scale, computed in float32 without
+ * writing the intermediate images. Only INTER_NEAREST and INTER_LINEAR are
+ * supported, with the same coordinates as Resize.
+ *
+ * \param src (n, h, w, c), Uint8, c is 1, 3 or 4
+ * \param norm (2, c), float32, mean in the first row and scale in the second,
+ *      indexed by the reordered channels
+ * \param dst (n, c, out_h, out_w) in NCHW or (n, c / 4, out_h, out_w, 4) in
+ *      NCHW44 with c rounded up to 4 and the padded channels zero, float32
+ */
+class FusedPreprocess : public OperatorBase {
+    DEF_OPR_IMPL(FusedPreprocess, OperatorBase, 2, 1);
+    DEF_OPR_PARAM(FusedPreprocess);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in norm, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& src, const TensorLayout& norm, TensorLayout& dst);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& norm,
+            const TensorLayout& dst) = 0;
+
+    //! the two source indices along an axis and the weight of the second one
+    struct Coord {
+        int idx0, idx1;
+        float alpha;
+    };
+
+protected:
+    void get_coords(size_t in_size, size_t out_size, Coord* coords);
+
+    void check_exec(
+            const TensorLayout& src, const TensorLayout& norm,
+            const TensorLayout& dst, size_t workspace_in_bytes);
+};
+
 }  // namespace megdnn
 
 #include "megdnn/internal/opr_header_epilogue.h"
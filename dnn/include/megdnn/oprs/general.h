@@ -1525,6 +1525,53 @@ protected:
 
 using LAMB = LAMBUpdate;
 
+/*!
+ * \brief update the parameters, gradients and states of many tensors packed by
+ *      ParamPackConcat in one operator
+ *
+ * param, grad, exp_avg and exp_avg_sq are 1-dim buffers of the same length, and
+ * offsets gives the range of each tensor in the format of ParamPackConcat. The
+ * ranges are only used by the trust ratio of LAMB, and the elements outside of
+ * all ranges are updated with a trust ratio of 1.
+ *
+ * exp_avg is the momentum buffer of SGD; exp_avg_sq is not used by SGD, and
+ * new_exp_avg_sq is left untouched in that case. The outputs may share the
+ * storage of the corresponding inputs.
+ */
+class FusedOptimizerUpdate : public OperatorBase {
+    DEF_OPR_PARAM(FusedOptimizerUpdate);
+    // input = (param, grad, exp_avg, exp_avg_sq, offsets),
+    // output = (new_param, new_exp_avg, new_exp_avg_sq)
+    DEF_OPR_IMPL(FusedOptimizerUpdate, OperatorBase, 5, 3);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in param, _megdnn_tensor_in grad, _megdnn_tensor_in exp_avg,
+            _megdnn_tensor_in exp_avg_sq, _megdnn_tensor_in offsets,
+            _megdnn_tensor_out new_param, _megdnn_tensor_out new_exp_avg,
+            _megdnn_tensor_out new_exp_avg_sq, _megdnn_workspace workspace) = 0;
+
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& param, const TensorLayout& grad,
+            const TensorLayout& exp_avg, const TensorLayout& exp_avg_sq,
+            const TensorLayout& offsets, const TensorLayout& new_param,
+            const TensorLayout& new_exp_avg, const TensorLayout& new_exp_avg_sq) = 0;
+
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& param, const TensorLayout& grad,
+            const TensorLayout& exp_avg, const TensorLayout& exp_avg_sq,
+            const TensorLayout& offsets, TensorLayout& new_param,
+            TensorLayout& new_exp_avg, TensorLayout& new_exp_avg_sq);
+
+protected:
+    void check_exec(
+            const TensorLayout& param, const TensorLayout& grad,
+            const TensorLayout& exp_avg, const TensorLayout& exp_avg_sq,
+            const TensorLayout& offsets, const TensorLayout& new_param,
+            const TensorLayout& new_exp_avg, const TensorLayout& new_exp_avg_sq,
+            size_t workspace_in_bytes);
+};
+
 class NormBase : public OperatorBase {
     DEF_OPR_PARAM(Norm);  // package norm params in Norm keyword from py declaration
     DEF_OPR_IMPL(NormBase, OperatorBase, 1, 1);  // constructor and static members
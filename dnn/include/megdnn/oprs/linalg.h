@@ -233,6 +233,78 @@ protected:
             size_t workspace_in_bytes);
 };
 
+/*!
+ * \brief matrix mul of a float activation and weight only quantized weights
+ *
+ * C = A * dequant(B)^t, where dequant(B)[n, k] = B[n, k] *
+ * scales[n, k / group_size]. Leading dimensions of A are batch dimensions
+ * sharing the same weights.
+ *
+ * \param A (..., m, k), float32 or float16
+ * \param B (n, k), Int8 or QuantizedS4, the scale of QuantizedS4 is applied
+ *      together with scales
+ * \param scales (n, k / group_size), the same dtype as A
+ * \param C (..., m, n), the same dtype as A
+ */
+class WeightOnlyQuantMatrixMul : public OperatorBase {
+    DEF_OPR_IMPL(WeightOnlyQuantMatrixMul, OperatorBase, 3, 1);
+    DEF_OPR_PARAM(WeightOnlyQuantMatrixMul);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in A, _megdnn_tensor_in B, _megdnn_tensor_in scales,
+            _megdnn_tensor_out C, _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+            TensorLayout& C);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+            const TensorLayout& C) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+            const TensorLayout& C, size_t workspace_in_bytes);
+};
+
+/*!
+ * \brief matrix mul of a float activation and N:M structured sparse weights
+ *
+ * C = A * B^t, where B is a (n, k) weight matrix in which every group of
+ * sparse_m consecutive weights along k has at most sparse_n non-zeros. B is
+ * stored compressed: the kept weights of each group are in values and their
+ * positions inside the group in indices. Leading dimensions of A are batch
+ * dimensions sharing the same weights.
+ *
+ * \param A (..., m, k), float32
+ * \param values (n, k / sparse_m * sparse_n), float32
+ * \param indices (n, k / sparse_m * sparse_n), Uint8, each in [0, sparse_m)
+ * \param C (..., m, n), float32
+ */
+class StructuredSparseMatrixMul : public OperatorBase {
+    DEF_OPR_IMPL(StructuredSparseMatrixMul, OperatorBase, 3, 1);
+    DEF_OPR_PARAM(StructuredSparseMatrixMul);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in A, _megdnn_tensor_in values, _megdnn_tensor_in indices,
+            _megdnn_tensor_out C, _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& A, const TensorLayout& values,
+            const TensorLayout& indices, TensorLayout& C);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& A, const TensorLayout& values,
+            const TensorLayout& indices, const TensorLayout& C) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& A, const TensorLayout& values,
+            const TensorLayout& indices, const TensorLayout& C,
+            size_t workspace_in_bytes);
+    //! check the host indices against sparse_m before any kernel reads A by them
+    void check_indices(const TensorND& indices);
+};
+
 }  // namespace megdnn
 
 #include "megdnn/internal/opr_header_epilogue.h"
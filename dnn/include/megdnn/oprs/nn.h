@@ -715,6 +715,47 @@ protected:
 };
 using ConvPooling = ConvPoolingForward;
 
+/*!
+ * \brief a channel wise conv_bias followed by a 1x1 conv_bias
+ *
+ * dst = pw_nonline(conv1x1(dw_nonline(conv_chanwise(src) + dw_bias)) +
+ * pw_bias), the output of the channel wise conv is consumed while it is still
+ * in cache instead of being written to memory. All tensors are in NCHW44:
+ *
+ * \param src (n, c / 4, ih, iw, 4)
+ * \param dw_filter (c / 4, 1, 1, fh, fw, 4)
+ * \param dw_bias (1, c / 4, 1, 1, 4)
+ * \param pw_filter (oc / 4, c / 4, 1, 1, 4, 4)
+ * \param pw_bias (1, oc / 4, 1, 1, 4)
+ * \param dst (n, oc / 4, oh, ow, 4)
+ */
+class DepthwisePointwiseConvBias : public OperatorBase {
+    DEF_OPR_IMPL(DepthwisePointwiseConvBias, OperatorBase, 5, 1);
+    DEF_OPR_PARAM(DepthwisePointwiseConvBias);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in dw_filter,
+            _megdnn_tensor_in dw_bias, _megdnn_tensor_in pw_filter,
+            _megdnn_tensor_in pw_bias, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& src, const TensorLayout& dw_filter,
+            const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+            const TensorLayout& pw_bias, TensorLayout& dst);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& dw_filter,
+            const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+            const TensorLayout& pw_bias, const TensorLayout& dst) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& src, const TensorLayout& dw_filter,
+            const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+            const TensorLayout& pw_bias, const TensorLayout& dst,
+            size_t workspace_in_bytes);
+};
+
 class GroupLocalBase : public OperatorBase {
     DEF_OPR_IMPL_CTOR(GroupLocalBase, OperatorBase);
     DEF_OPR_PARAM(Convolution);
@@ -2118,6 +2159,41 @@ protected:
 };
 using LayerNorm = LayerNormForward;
 
+/*!
+ * \brief layer norm of data + residual, which also outputs the sum for the
+ *      following residual branch
+ *
+ * sum = data + residual, dst = LayerNorm(sum); mean and rstd are the same as
+ * LayerNormForward
+ */
+class ResidualLayerNormForward : public LayerNormBase {
+    DEF_OPR_IMPL(ResidualLayerNormForward, LayerNormBase, 4, 4);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in data, _megdnn_tensor_in residual,
+            _megdnn_tensor_in weight, _megdnn_tensor_in bias, _megdnn_tensor_out dst,
+            _megdnn_tensor_out sum, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+            _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& data, const TensorLayout& residual,
+            const TensorLayout& weight, const TensorLayout& bias, TensorLayout& dst,
+            TensorLayout& sum, TensorLayout& mean, TensorLayout& rstd);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& data, const TensorLayout& residual,
+            const TensorLayout& weight, const TensorLayout& bias,
+            const TensorLayout& dst, const TensorLayout& sum, const TensorLayout& mean,
+            const TensorLayout& rstd) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& data, const TensorLayout& residual,
+            const TensorLayout& weight, const TensorLayout& bias,
+            const TensorLayout& dst, const TensorLayout& sum, const TensorLayout& mean,
+            const TensorLayout& rstd, size_t workspace_in_bytes);
+};
+using ResidualLayerNorm = ResidualLayerNormForward;
+
 class LayerNormBackward : public LayerNormBase {
     DEF_OPR_IMPL(LayerNormBackward, LayerNormBase, 5, 3);
 
@@ -2714,6 +2790,183 @@ protected:
             const TensorLayout& dqkvo_weight_bias, const TensorLayout& dbias_k,
             const TensorLayout& dbias_v, size_t workspace_in_bytes);
 };
+
+/*!
+ * \brief append the keys and values of a decode step into the paged kv cache
+ *
+ * The kv cache of all the sequences is stored in fixed size blocks, the logical
+ * block i of sequence b is the physical block block_table[b, i]. The output of
+ * the fused qkv projection is split into heads, the rotary position embedding
+ * is applied to q and k at the positions after the cached tokens, and k and v
+ * are written into the cache inplace.
+ *
+ * \param[in] qkv (batch, seqlen, 3 * num_heads * head_dim)
+ * \param[in] positions int32 (batch), number of tokens already in the cache
+ * \param[in] block_table int32 (batch, max_nr_blocks)
+ * \param[in,out] k_cache (nr_blocks, num_heads, block_size, head_dim)
+ * \param[in,out] v_cache the same layout as k_cache
+ * \param[out] q (batch, num_heads, seqlen, head_dim)
+ */
+class KVCacheAppend : public OperatorBase {
+    DEF_OPR_IMPL(KVCacheAppend, OperatorBase, 5, 1);
+    DEF_OPR_PARAM(KVCacheAppend);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in qkv, _megdnn_tensor_in positions,
+            _megdnn_tensor_in block_table, _megdnn_tensor_inout k_cache,
+            _megdnn_tensor_inout v_cache, _megdnn_tensor_out q,
+            _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& qkv, const TensorLayout& positions,
+            const TensorLayout& block_table, const TensorLayout& k_cache,
+            const TensorLayout& v_cache, TensorLayout& q);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& qkv, const TensorLayout& positions,
+            const TensorLayout& block_table, const TensorLayout& k_cache,
+            const TensorLayout& v_cache, const TensorLayout& q) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& qkv, const TensorLayout& positions,
+            const TensorLayout& block_table, const TensorLayout& k_cache,
+            const TensorLayout& v_cache, const TensorLayout& q,
+            size_t workspace_in_bytes);
+};
+
+/*!
+ * \brief causal attention of the queries of a decode step over the paged kv
+ *      cache filled by KVCacheAppend
+ *
+ * The query at step t of sequence b attends to the first positions[b] + t + 1
+ * tokens in the cache.
+ *
+ * \param[in] q (batch, num_heads, seqlen, head_dim)
+ * \param[in] k_cache (nr_blocks, num_heads, block_size, head_dim)
+ * \param[in] v_cache the same layout as k_cache
+ * \param[in] positions int32 (batch), number of tokens in the cache before
+ *      this step
+ * \param[in] block_table int32 (batch, max_nr_blocks)
+ * \param[out] dst (batch, seqlen, num_heads * head_dim)
+ */
+class KVCacheAttention : public OperatorBase {
+    DEF_OPR_IMPL(KVCacheAttention, OperatorBase, 5, 1);
+    DEF_OPR_PARAM(KVCacheAttention);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in q, _megdnn_tensor_in k_cache, _megdnn_tensor_in v_cache,
+            _megdnn_tensor_in positions, _megdnn_tensor_in block_table,
+            _megdnn_tensor_out dst, _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& q, const TensorLayout& k_cache,
+            const TensorLayout& v_cache, const TensorLayout& positions,
+            const TensorLayout& block_table, TensorLayout& dst);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& q, const TensorLayout& k_cache,
+            const TensorLayout& v_cache, const TensorLayout& positions,
+            const TensorLayout& block_table, const TensorLayout& dst) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& q, const TensorLayout& k_cache,
+            const TensorLayout& v_cache, const TensorLayout& positions,
+            const TensorLayout& block_table, const TensorLayout& dst,
+            size_t workspace_in_bytes);
+};
+
+class EmbeddingBagBase : public OperatorBase {
+    DEF_OPR_IMPL_CTOR(EmbeddingBagBase, OperatorBase);
+    DEF_OPR_PARAM(EmbeddingBag);
+
+public:
+    //! per_sample_weights is given if it is not empty
+    static bool has_per_sample_weights(const TensorLayout& per_sample_weights) {
+        return per_sample_weights.ndim && per_sample_weights.total_nr_elems();
+    }
+
+protected:
+    void check_bags(
+            const TensorLayout& indices, const TensorLayout& offsets,
+            const TensorLayout& per_sample_weights);
+};
+
+/*!
+ * \brief look up the rows of an embedding table for each bag of indices and
+ *      pool them, without the gathered rows as an intermediate
+ *
+ * Bag b is made of indices[offsets[b]:offsets[b + 1]], and the last bag ends at
+ * the end of indices. An empty bag gives zeros.
+ *
+ * \param[in] weight (num_embeddings, dim)
+ * \param[in] indices int32 (nr_indices)
+ * \param[in] offsets int32 (batch), non-decreasing
+ * \param[in] per_sample_weights (nr_indices) of the dtype of weight, or empty
+ *      if the rows are not weighted; only used in SUM mode
+ * \param[out] dst (batch, dim)
+ * \param[out] max_idx int32 (batch, dim), the position in indices of the max
+ *      of each channel in MAX mode, -1 for empty bags; empty in other modes
+ */
+class EmbeddingBagForward : public EmbeddingBagBase {
+    DEF_OPR_IMPL(EmbeddingBagForward, EmbeddingBagBase, 4, 2);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices,
+            _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+            _megdnn_tensor_out dst, _megdnn_tensor_out max_idx,
+            _megdnn_workspace workspace) = 0;
+    MGE_WIN_DECLSPEC_FUC void deduce_layout(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+            TensorLayout& dst, TensorLayout& max_idx);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+            const TensorLayout& dst, const TensorLayout& max_idx) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& weight, const TensorLayout& indices,
+            const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+            const TensorLayout& dst, const TensorLayout& max_idx,
+            size_t workspace_in_bytes);
+};
+using EmbeddingBag = EmbeddingBagForward;
+
+/*!
+ * \brief the gradient of the embedding table of EmbeddingBagForward
+ *
+ * The rows which are not looked up get zeros. Each row is written once, by
+ * summing its contributions in the order of the indices, so the result is
+ * deterministic and hot rows do not contend.
+ *
+ * \param[in] diff (batch, dim)
+ * \param[in] indices, offsets, per_sample_weights, max_idx the same as the
+ *      forward
+ * \param[out] grad (num_embeddings, dim)
+ */
+class EmbeddingBagBackward : public EmbeddingBagBase {
+    DEF_OPR_IMPL(EmbeddingBagBackward, EmbeddingBagBase, 5, 1);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in diff, _megdnn_tensor_in indices,
+            _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+            _megdnn_tensor_in max_idx, _megdnn_tensor_out grad,
+            _megdnn_workspace workspace) = 0;
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& diff, const TensorLayout& indices,
+            const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+            const TensorLayout& max_idx, const TensorLayout& grad) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& diff, const TensorLayout& indices,
+            const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+            const TensorLayout& max_idx, const TensorLayout& grad,
+            size_t workspace_in_bytes);
+};
 }  // namespace megdnn
 #include "megdnn/internal/opr_header_epilogue.h"
 
@@ -116,6 +116,36 @@ protected:
             size_t workspace_in_bytes);
 };
 
+/*!
+ * \brief sample one token from each row of logits
+ *
+ * The logits are divided by param().temperature, filtered by top_k and top_p and
+ * then a token is drawn from the softmax of the kept logits. A token is kept by
+ * top_k if fewer than top_k logits are strictly larger than it, and by top_p if
+ * the tokens more probable than it take less than top_p of the probability kept
+ * by top_k, so tied logits are either all kept or all dropped.
+ *
+ * \param[in] logits (batch, vocab)
+ * \param[out] dst (batch,) of the sampled token indices in int32
+ */
+class LogitsSamplingRNG : public OperatorBase {
+    DEF_OPR_IMPL(LogitsSamplingRNG, OperatorBase, 1, 1);
+    DEF_OPR_PARAM(LogitsSamplingRNG);
+
+public:
+    virtual void exec(
+            _megdnn_tensor_in logits, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) = 0;
+    void deduce_layout(const TensorLayout& logits, TensorLayout& dst);
+    virtual size_t get_workspace_in_bytes(
+            const TensorLayout& logits, const TensorLayout& dst) = 0;
+
+protected:
+    void check_exec(
+            const TensorLayout& logits, const TensorLayout& dst,
+            size_t workspace_in_bytes);
+};
+
 class ShuffleRNGForward : public OperatorBase {
     DEF_OPR_IMPL(ShuffleRNGForward, OperatorBase, 1, 2);
     DEF_OPR_PARAM(ShuffleRNG);
@@ -52,6 +52,7 @@ if __name__ == "__main__":
         write_merge_file_name(f, "gemm", "simt", 2)
         write_merge_file_name(f, "gemm", "tensorop884", 30)
         write_merge_file_name(f, "gemm", "tensorop1688", 2)
+        write_merge_file_name(f, "gemm", "tensorop16816", 2)
         write_merge_file_name(f, "gemv", "simt", 2)
         write_merge_file_name(f, "deconv", "simt", 2)
         write_merge_file_name(f, "deconv", "tensorop8816", 4)
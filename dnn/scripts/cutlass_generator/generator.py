@@ -1713,6 +1713,86 @@ def GeneratesGemm_TensorOp_1688(args):
     return operations
 
 
+#
+def GeneratesGemm_TensorOp_16816(args):
+    layouts = [
+        (LayoutType.ColumnMajor, LayoutType.ColumnMajor, LayoutType.RowMajor),  # nn
+        (LayoutType.ColumnMajor, LayoutType.RowMajor, LayoutType.RowMajor),  # nt
+        (LayoutType.RowMajor, LayoutType.ColumnMajor, LayoutType.RowMajor),  # tn
+        (LayoutType.RowMajor, LayoutType.RowMajor, LayoutType.RowMajor),  # tt
+    ]
+
+    math_instructions = [
+        MathInstruction(
+            [16, 8, 16],
+            DataType.f16,
+            DataType.f16,
+            DataType.f32,
+            OpcodeClass.TensorOp,
+            MathOperation.multiply_add,
+        ),
+        MathInstruction(
+            [16, 8, 16],
+            DataType.f16,
+            DataType.f16,
+            DataType.f16,
+            OpcodeClass.TensorOp,
+            MathOperation.multiply_add,
+        ),
+    ]
+
+    # multistage kernels pipelined by cp.async, they also run on sm_90
+    min_cc = 80
+    max_cc = 1024
+
+    alignment_constraints = [
+        8,
+        4,
+        2,
+    ]
+    cuda_major = 11
+    cuda_minor = 0
+
+    operations = []
+    for math_inst in math_instructions:
+        for layout in layouts:
+            for align in alignment_constraints:
+                tile_descriptions = [
+                    TileDescription(
+                        [256, 128, 32], 3, [4, 2, 1], math_inst, min_cc, max_cc
+                    ),
+                    TileDescription(
+                        [128, 256, 32], 3, [2, 4, 1], math_inst, min_cc, max_cc
+                    ),
+                    TileDescription(
+                        [128, 128, 32], 4, [2, 2, 1], math_inst, min_cc, max_cc
+                    ),
+                ]
+
+                data_type = [
+                    math_inst.element_a,
+                    math_inst.element_b,
+                    math_inst.element_a,
+                    math_inst.element_accumulator,
+                ]
+
+                for tile in tile_descriptions:
+                    operations += GeneratesGemm(
+                        tile,
+                        data_type,
+                        layout[0],
+                        layout[1],
+                        layout[2],
+                        min_cc,
+                        align * 16,
+                        align * 16,
+                        align * 16,
+                        cuda_major,
+                        cuda_minor,
+                    )
+    return operations
+
+
 #
 def GeneratesGemm_TensorOp_884(args):
     layouts = [
@@ -1869,6 +1949,8 @@ def GenerateGemmOperations(args):
         return GeneratesGemm_TensorOp_884(args)
     elif args.type == "tensorop1688":
         return GeneratesGemm_TensorOp_1688(args)
+    elif args.type == "tensorop16816":
+        return GeneratesGemm_TensorOp_16816(args)
     else:
         assert (
             args.type == "simt"
@@ -2126,7 +2208,14 @@ if __name__ == "__main__":
     parser.add_argument(
         "--type",
         type=str,
-        choices=["simt", "tensorop8816", "tensorop8832", "tensorop884", "tensorop1688"],
+        choices=[
+            "simt",
+            "tensorop8816",
+            "tensorop8832",
+            "tensorop884",
+            "tensorop1688",
+            "tensorop16816",
+        ],
         default="simt",
         help="kernel type of CUTLASS kernel generator",
     )
@@ -1299,6 +1299,10 @@ PADDING_MODES = [Doc('REPLICATE = 0', 'aaaaaa|abcdefgh|hhhhhhh'),
  .add_fields('float32', 'eps', '1e-5f')
  .add_fields('uint64', 'axis_start', '0')
  .add_fields('uint64', 'axis_end', '0')
+ .add_enum(Doc('Mode', 'normalization applied to every slice'),
+           Doc('LAYER_NORM = 0', 'subtract the mean and divide by the standard deviation'),
+           Doc('RMS_NORM = 1', 'divide by the root mean square without centering, '
+               'mean is reported as zero'))
  )
 
 (pdef('Dropout')
@@ -1347,6 +1351,25 @@ PADDING_MODES = [Doc('REPLICATE = 0', 'aaaaaa|abcdefgh|hhhhhhh'),
  add_fields('bool', Doc('bias_correction', 'whether correct bias'), 'true').
  add_fields('bool', Doc('always_adapt', 'apply adaptive lr to 0.0'), 'false')
 )
+
+(pdef('FusedOptimizerUpdate').
+ add_enum('Mode',
+          Doc('SGD = 0', 'sgd with momentum, where exp_avg is the momentum buffer'),
+          Doc('ADAM = 1', 'adam with the weight decay added to the gradient'),
+          Doc('ADAMW = 2', 'adam with the weight decay added to the update'),
+          Doc('LAMB = 3', 'lamb with the trust ratio computed for each tensor'),
+          name_field='mode').
+ add_fields('float32', Doc('lr', 'learning rate'), '1.f').
+ add_fields('float32', Doc('weight_decay', 'weight decay'), '0.f').
+ add_fields('float32', Doc('momentum', 'momentum factor of sgd'), '0.f').
+ add_fields('bool', Doc('nesterov', 'whether to use nesterov momentum in sgd'), 'false').
+ add_fields('float32', Doc('beta_1', 'beta_1 parameter of adam and lamb'), '0.9f').
+ add_fields('float32', Doc('beta_2', 'beta_2 parameter of adam and lamb'), '0.999f').
+ add_fields('float32', Doc('eps', 'eps added to the denominator'), '1e-8f').
+ add_fields('float32', Doc('step', 'training step counted from 1'), '1.f').
+ add_fields('bool', Doc('bias_correction', 'whether to correct the bias in lamb'), 'true').
+ add_fields('bool', Doc('always_adapt', 'apply adaptive lr to 0.0 weight decay in lamb'), 'false')
+)
 (pdef("Norm").
  add_enum('Mode',
             Doc('P_NORM=0', 'calculate p-norm, parameter p would be ignored in other mode'),
@@ -1396,3 +1419,83 @@ PADDING_MODES = [Doc('REPLICATE = 0', 'aaaaaa|abcdefgh|hhhhhhh'),
  add_fields('uint64', 'num_samples', '1').
  add_fields('bool', 'replacement', 'false')
  )
+
+(pdef('WeightOnlyQuantMatrixMul',
+      'matrix mul of a float activation and weights quantized to int8 or int4 '
+      'with per group scales').
+ add_fields(
+     'uint32',
+     Doc('group_size', 'number of consecutive weights along k sharing one scale'),
+     '64'))
+
+(pdef('DepthwisePointwiseConvBias',
+      'a channel wise conv_bias followed by a 1x1 conv_bias in NCHW44 format, '
+      'the intermediate tensor is not written to memory').
+ add_enum_alias('NonlineMode', 'ConvBiasV0', name_field='dw_nonline_mode').
+ add_enum_alias(
+     'PwNonlineMode', 'ConvBiasV0', 'NonlineMode', name_field='pw_nonline_mode').
+ add_fields(
+     'uint32',
+     Doc('pad_h', 'padding of the channel wise conv on the first dimension'), 0,
+     Doc('pad_w', 'padding of the channel wise conv on the second dimension'), 0,
+     Doc('stride_h', 'stride of the channel wise conv on the first dimension'), 1,
+     Doc('stride_w', 'stride of the channel wise conv on the second dimension'), 1))
+
+(pdef('StructuredSparseMatrixMul',
+      'matrix mul of a float activation and N:M structured sparse weights, where '
+      'every group of sparse_m consecutive weights along k keeps sparse_n of them').
+ add_fields(
+     'uint32',
+     Doc('sparse_n', 'number of weights kept in each group'), 2,
+     Doc('sparse_m', 'number of consecutive weights along k in a group'), 4))
+
+(pdef('FusedPreprocess',
+      'channel reordering, resize, normalization and layout conversion of NHWC '
+      'uint8 images in one pass, the output is (x - mean) * scale in float32').
+ add_enum('ColorMode',
+          Doc('NONE = 0', 'keep the channel order'),
+          Doc('REVERSE = 1', 'reverse the channel order, e.g. BGR to RGB'),
+          name_field='color_mode').
+ add_enum_alias('InterpolationMode', 'WarpPerspectiveV1', name_field='imode').
+ add_enum_alias('Format', 'Convolution').
+ add_fields(
+     'uint32',
+     Doc('out_h', 'height of the output'), 0,
+     Doc('out_w', 'width of the output'), 0))
+
+(pdef('KVCacheAppend',
+      'split the fused qkv projection, apply the rotary position embedding to q '
+      'and k and append k and v into the paged kv cache inplace').
+ add_fields(
+     'uint32',
+     Doc('num_heads', 'number of attention heads'), 1,
+     Doc('rotary_dim', 'number of leading channels of each head that are '
+         'rotated, 0 means no rotary embedding'), 0).
+ add_fields('float32', Doc('rotary_base', 'base of the rotary frequencies'),
+            '10000.f'))
+
+(pdef('KVCacheAttention',
+      'causal attention of the queries of a decode step over the paged kv cache').
+ add_fields('float32', Doc('scale', 'scale of the attention scores, 0 means '
+                          '1 / sqrt(head_dim)'), '0.f'))
+
+(pdef('LogitsSamplingRNG',
+      'draw one token from each row of logits after temperature scaling, top-k '
+      'and top-p filtering').
+ add_fields('uint64', 'seed', '0').
+ add_fields('uint32', Doc('top_k', 'number of the largest logits that are kept, '
+                          '0 means all of them'), 0).
+ add_fields(
+     'float32',
+     Doc('top_p', 'keep the smallest set of the most probable tokens whose total '
+         'probability reaches top_p, 1 means no filtering'), '1.f',
+     Doc('temperature', 'the logits are divided by the temperature'), '1.f'))
+
+(pdef('EmbeddingBag',
+      'look up the rows of an embedding table for each bag of indices and pool '
+      'them').
+ add_enum('Mode',
+          Doc('SUM = 0', 'sum of the rows, weighted by the per sample weights '
+              'if given'),
+          Doc('MEAN = 1', 'mean of the rows'),
+          Doc('MAX = 2', 'channel-wise max of the rows')))
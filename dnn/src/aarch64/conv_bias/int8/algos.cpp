@@ -2,6 +2,7 @@
 #include "src/aarch64/conv_bias/int8/strategy.h"
 #include "src/arm_common/convolution/img2col_helper.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/utils.h"
 #include "src/common/opr_delegate.h"
 #include "src/fallback/conv_bias/common.h"
 #include "src/fallback/matrix_mul/gemm_impl.h"
@@ -67,7 +68,7 @@ WorkspaceBundle ConvBiasImpl::AlgoS8MatrixMul::get_bundle(
                     M, N, K, false, false, strategy)                     \
                     .get_workspace_size();
 
-        if (cpuinfo_has_arm_neon_dot()) {
+        if (arm_common::cpu_has_dotprod()) {
             DISPATCH_GEMM_BIAS(s8_8x12, 1)
         } else {
             DISPATCH_GEMM_BIAS(s8_4x4, 0)
@@ -171,7 +172,7 @@ void ConvBiasImpl::AlgoS8MatrixMul::kimpl(
             gemm_interleaved(M, N, K, false, false, strategy);                   \
     gemm_interleaved.execute(filter, K, B, N, dst, N, workspace.raw_ptr, bias);
 
-            if (cpuinfo_has_arm_neon_dot()) {
+            if (arm_common::cpu_has_dotprod()) {
                 DISPATCH_GEMM_BIAS(s8_8x12, 1)
             } else {
                 DISPATCH_GEMM_BIAS(s8_4x4, 0)
@@ -4,6 +4,7 @@
 #include "src/aarch64/matrix_mul/quint8_dot/strategy.h"
 #include "src/arm_common/convolution/img2col_helper.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/utils.h"
 #include "src/common/opr_delegate.h"
 #include "src/fallback/conv_bias/common.h"
 #include "src/fallback/matrix_mul/gemm_impl.h"
@@ -69,7 +70,7 @@ WorkspaceBundle ConvBiasImpl::AlgoQU8MatrixMul::get_bundle(
                     M, N, K, false, false, strategy)                     \
                     .get_workspace_size();
 
-        if (cpuinfo_has_arm_neon_dot()) {
+        if (arm_common::cpu_has_dotprod()) {
             DISPATCH_GEMM_BIAS(u8_8x8_dot, 1);
         } else {
             DISPATCH_GEMM_BIAS(u8_8x8_nodot, 0);
@@ -174,7 +175,7 @@ void ConvBiasImpl::AlgoQU8MatrixMul::kimpl(
             gemm_interleaved(M, N, K, false, false, strategy);                   \
     gemm_interleaved.execute(filter, K, B, N, dst, N, workspace.raw_ptr, bias);
 
-            if (cpuinfo_has_arm_neon_dot()) {
+            if (arm_common::cpu_has_dotprod()) {
                 DISPATCH_GEMM_BIAS(u8_8x8_dot, 1)
             } else {
                 DISPATCH_GEMM_BIAS(u8_8x8_nodot, 0)
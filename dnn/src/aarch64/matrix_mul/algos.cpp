@@ -1,14 +1,19 @@
 #include "src/aarch64/matrix_mul/algos.h"
+#include "src/aarch64/matrix_mul/bf16/strategy.h"
 #include "src/aarch64/matrix_mul/fp16/strategy.h"
 #include "src/aarch64/matrix_mul/fp32/strategy.h"
 #include "src/aarch64/matrix_mul/int16/strategy.h"
+#include "src/aarch64/matrix_mul/int4_dot/strategy.h"
 #include "src/aarch64/matrix_mul/int4x4x16/strategy.h"
 #include "src/aarch64/matrix_mul/int8/strategy.h"
 #include "src/aarch64/matrix_mul/int8_dot/strategy.h"
+#include "src/aarch64/matrix_mul/int8_mmla/strategy.h"
 #include "src/aarch64/matrix_mul/int8x8x16/strategy.h"
 #include "src/aarch64/matrix_mul/quint8/strategy.h"
 #include "src/aarch64/matrix_mul/quint8_dot/gemv.h"
 #include "src/aarch64/matrix_mul/quint8_dot/strategy.h"
+#include "src/aarch64/matrix_mul/sve/gemm.h"
+#include "src/arm_common/utils.h"
 #include "src/common/utils.h"
 #include "src/fallback/matrix_mul/gemm_impl.h"
 
@@ -440,7 +445,7 @@ void int8x8x32_k8x12x4_dotprod_kern(const MatrixMulImpl::KernParam& kern_param)
 
 bool MatrixMulImpl::AlgoInt8x8x32K8x12x4DotProd::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return can_be_treated_as_int8x8x32(kern_size_param);
@@ -500,7 +505,7 @@ void int8x8x32_mk4_8x12x4_dotprod_kern(const MatrixMulImpl::KernParam& kern_para
 
 bool MatrixMulImpl::AlgoInt8x8x32MK4_8x12x4DotProd::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
 
@@ -544,6 +549,188 @@ MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL(
         int8_t, int32_t, AlgoDataType::QINT8X8X32, MK4_DOT);
 #endif
 
+#if MGB_ENABLE_MMLA
+/* ==================== Int8x8x32 K8x12x8 MMLA algo ==================== */
+namespace {
+void int8x8x32_k8x12x8_mmla_kern(const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(
+            megdnn_aarch64_matmul_kern,
+            midout_iv("int8x8x32_k8x12x8_mmla_kern"_hash)) {
+        auto M = kern_param.M, N = kern_param.N, K = kern_param.K;
+        auto trA = kern_param.trA, trB = kern_param.trB;
+        auto LDA = kern_param.LDA, LDB = kern_param.LDB, LDC = kern_param.LDC;
+        auto A_type = kern_param.A_type, B_type = kern_param.B_type,
+             C_type = kern_param.C_type;
+        const auto Aptr = kern_param.A<dt_int8>(), Bptr = kern_param.B<dt_int8>();
+        auto Cptr = kern_param.C<dt_int32>();
+
+        aarch64::matmul::gemm_s8_8x12x8_mmla strategy(M, N, K, A_type, B_type, C_type);
+        megdnn::matmul::GemmInterleaved<aarch64::matmul::gemm_s8_8x12x8_mmla>(
+                M, N, K, trA, trB, strategy)
+                .execute(Aptr, LDA, Bptr, LDB, Cptr, LDC, kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // anonymous namespace
+
+bool MatrixMulImpl::AlgoInt8x8x32K8x12x8MMLA::usable(
+        const KernSizeParam& kern_size_param) const {
+    if (!arm_common::cpu_has_i8mm()) {
+        return false;
+    }
+    return can_be_treated_as_int8x8x32(kern_size_param);
+}
+
+size_t MatrixMulImpl::AlgoInt8x8x32K8x12x8MMLA::get_workspace(
+        const KernSizeParam& kern_size_param) const {
+    MIDOUT_BEGIN(
+            megdnn_aarch64_matmul_kern,
+            midout_iv("AlgoInt8x8x32K8x12x8MMLA::get_workspace"_hash)) {
+        auto M = kern_size_param.M, N = kern_size_param.N, K = kern_size_param.K;
+        auto trA = kern_size_param.trA, trB = kern_size_param.trB;
+        auto A_type = kern_size_param.A_type, B_type = kern_size_param.B_type,
+             C_type = kern_size_param.C_type;
+
+        aarch64::matmul::gemm_s8_8x12x8_mmla strategy(M, N, K, A_type, B_type, C_type);
+        return megdnn::matmul::GemmInterleaved<aarch64::matmul::gemm_s8_8x12x8_mmla>(
+                       M, N, K, trA, trB, strategy)
+                .get_workspace_size();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoInt8x8x32K8x12x8MMLA::get_kern(
+        const KernSizeParam&) const {
+    return int8x8x32_k8x12x8_mmla_kern;
+}
+
+MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL(
+        AlgoInt8x8x32K8x12x8MMLA, megdnn_aarch64_matmul_kern,
+        "AlgoInt8x8x32K8x12x8MMLAImpl"_hash, aarch64::matmul::gemm_s8_8x12x8_mmla,
+        int8_t, int32_t, AlgoDataType::QINT8X8X32, DEFAULT);
+
+/* ==================== BF16 K8x12x4 MMLA algo ==================== */
+namespace {
+void bf16_k8x12x4_mmla_kern(const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(megdnn_aarch64_matmul_kern, midout_iv("bf16_k8x12x4_mmla_kern"_hash)) {
+        auto M = kern_param.M, N = kern_param.N, K = kern_param.K;
+        auto trA = kern_param.trA, trB = kern_param.trB;
+        auto LDA = kern_param.LDA, LDB = kern_param.LDB, LDC = kern_param.LDC;
+        auto A_type = kern_param.A_type, B_type = kern_param.B_type,
+             C_type = kern_param.C_type;
+        const auto Aptr = kern_param.A<dt_bfloat16>(),
+                   Bptr = kern_param.B<dt_bfloat16>();
+        auto Cptr = kern_param.C<dt_bfloat16>();
+
+        aarch64::matmul::gemm_bf16_8x12x4_mmla strategy(
+                M, N, K, A_type, B_type, C_type);
+        megdnn::matmul::GemmInterleaved<aarch64::matmul::gemm_bf16_8x12x4_mmla>(
+                M, N, K, trA, trB, strategy)
+                .execute(Aptr, LDA, Bptr, LDB, Cptr, LDC, kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // anonymous namespace
+
+bool MatrixMulImpl::AlgoBf16K8x12x4MMLA::usable(
+        const KernSizeParam& kern_size_param) const {
+    //! the products are always accumulated in fp32, so both compute modes are
+    //! accepted
+    return arm_common::cpu_has_bf16() &&
+           kern_size_param.A_type.enumv() == DTypeEnum::BFloat16 &&
+           kern_size_param.B_type.enumv() == DTypeEnum::BFloat16 &&
+           kern_size_param.C_type.enumv() == DTypeEnum::BFloat16 &&
+           kern_size_param.format == param::MatrixMul::Format::DEFAULT;
+}
+
+size_t MatrixMulImpl::AlgoBf16K8x12x4MMLA::get_workspace(
+        const KernSizeParam& kern_size_param) const {
+    MIDOUT_BEGIN(
+            megdnn_aarch64_matmul_kern,
+            midout_iv("AlgoBf16K8x12x4MMLA::get_workspace"_hash)) {
+        auto M = kern_size_param.M, N = kern_size_param.N, K = kern_size_param.K;
+        auto trA = kern_size_param.trA, trB = kern_size_param.trB;
+        auto A_type = kern_size_param.A_type, B_type = kern_size_param.B_type,
+             C_type = kern_size_param.C_type;
+
+        aarch64::matmul::gemm_bf16_8x12x4_mmla strategy(
+                M, N, K, A_type, B_type, C_type);
+        return megdnn::matmul::GemmInterleaved<aarch64::matmul::gemm_bf16_8x12x4_mmla>(
+                       M, N, K, trA, trB, strategy)
+                .get_workspace_size();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoBf16K8x12x4MMLA::get_kern(
+        const KernSizeParam&) const {
+    return bf16_k8x12x4_mmla_kern;
+}
+#endif
+
+#if MGB_ENABLE_SVE
+/* ===================== F32 SVE algo ===================== */
+namespace {
+void f32_sve_kern(const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(megdnn_aarch64_matmul_kern, midout_iv("f32_sve_kern"_hash)) {
+        aarch64::matmul::sgemm_sve(
+                kern_param.A<float>(), kern_param.LDA, kern_param.B<float>(),
+                kern_param.LDB, kern_param.C<float>(), kern_param.LDC, kern_param.M,
+                kern_param.N, kern_param.K);
+    }
+    MIDOUT_END();
+}
+}  // anonymous namespace
+
+bool MatrixMulImpl::AlgoF32SVE::usable(const KernSizeParam& kern_size_param) const {
+    return arm_common::cpu_has_sve() &&
+           kern_size_param.compute_mode == Param::ComputeMode::DEFAULT &&
+           kern_size_param.C_type == dtype::Float32() &&
+           kern_size_param.B_type == dtype::Float32() &&
+           kern_size_param.A_type == dtype::Float32() &&
+           kern_size_param.format == param::MatrixMul::Format::DEFAULT &&
+           !kern_size_param.trA && !kern_size_param.trB;
+}
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoF32SVE::get_kern(const KernSizeParam&) const {
+    return f32_sve_kern;
+}
+
+/* ===================== Int8x8x32 SVE algo ===================== */
+namespace {
+void int8x8x32_sve_kern(const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(megdnn_aarch64_matmul_kern, midout_iv("int8x8x32_sve_kern"_hash)) {
+        aarch64::matmul::gemm_s8s8s32_sve(
+                kern_param.A<dt_int8>(), kern_param.LDA, kern_param.B<dt_int8>(),
+                kern_param.LDB, kern_param.C<dt_int32>(), kern_param.LDC, kern_param.M,
+                kern_param.N, kern_param.K, kern_param.trB, kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // anonymous namespace
+
+bool MatrixMulImpl::AlgoInt8x8x32SVE::usable(
+        const KernSizeParam& kern_size_param) const {
+    return arm_common::cpu_has_sve() &&
+           can_be_treated_as_int8x8x32(kern_size_param) &&
+           kern_size_param.format == param::MatrixMul::Format::DEFAULT &&
+           !kern_size_param.trA;
+}
+
+size_t MatrixMulImpl::AlgoInt8x8x32SVE::get_workspace(
+        const KernSizeParam& kern_size_param) const {
+    return aarch64::matmul::gemm_s8s8s32_sve_workspace(
+            kern_size_param.N, kern_size_param.K);
+}
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoInt8x8x32SVE::get_kern(
+        const KernSizeParam&) const {
+    return int8x8x32_sve_kern;
+}
+#endif
+
 /* ===================== Int8x8x32 MK4 4x4x16 algo ===================== */
 namespace {
 void int8x8x32_mk4_4x4x16_kern(const MatrixMulImpl::KernParam& kern_param) {
@@ -1144,7 +1331,7 @@ void quint8_k8x8x4_dotprod_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoQuint8K8x8x4DotProd::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return kern_size_param.A_type.enumv() == DTypeEnum::Quantized8Asymm &&
@@ -1204,7 +1391,7 @@ void quint8_gemv_dotprod_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoQuint8GemvDotProd::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return kern_size_param.A_type.enumv() == DTypeEnum::Quantized8Asymm &&
@@ -1418,4 +1605,71 @@ MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL(
         AlgoInt4x4x16K8x8x8, megdnn_aarch64_matmul_kern, "AlgoInt4x4x16K8x8x8Impl"_hash,
         aarch64::matmul::gemm_s4x4x16_s4_8x8x8, int8_t, int16_t,
         AlgoDataType::INT4X4X16, DEFAULT);
+
+#if MGB_ENABLE_DOT
+/* ==================== Int4x4x32 K8x12x4 Dotprod algo ==================== */
+namespace {
+void int4x4x32_k8x12x4_dotprod_kern(const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(
+            megdnn_aarch64_matmul_kern,
+            midout_iv("int4x4x32_k8x12x4_dotprod_kern"_hash)) {
+        auto M = kern_param.M, N = kern_param.N, K = kern_param.K;
+        auto trA = kern_param.trA, trB = kern_param.trB;
+        auto LDA = kern_param.LDA, LDB = kern_param.LDB, LDC = kern_param.LDC;
+        auto A_type = kern_param.A_type, B_type = kern_param.B_type,
+             C_type = kern_param.C_type;
+        const auto Aptr = kern_param.A<dt_int8>(), Bptr = kern_param.B<dt_int8>();
+        auto Cptr = kern_param.C<dt_int32>();
+
+        aarch64::matmul::gemm_s4x4x32_8x12 strategy(M, N, K, A_type, B_type, C_type);
+        megdnn::matmul::GemmInterleaved<aarch64::matmul::gemm_s4x4x32_8x12>(
+                M, N, K, trA, trB, strategy)
+                .execute(Aptr, LDA, Bptr, LDB, Cptr, LDC, kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // anonymous namespace
+
+bool MatrixMulImpl::AlgoInt4x4x32K8x12x4DotProd::usable(
+        const KernSizeParam& kern_size_param) const {
+    if (!arm_common::cpu_has_dotprod()) {
+        return false;
+    }
+    return kern_size_param.A_type.enumv() == kern_size_param.B_type.enumv() &&
+           (kern_size_param.A_type.enumv() == DTypeEnum::QuantizedS4 ||
+            kern_size_param.A_type.enumv() == DTypeEnum::Quantized4Asymm) &&
+           kern_size_param.C_type.enumv() == DTypeEnum::QuantizedS32 &&
+           kern_size_param.format == param::MatrixMul::Format::DEFAULT &&
+           kern_size_param.compute_mode == Param::ComputeMode::DEFAULT;
+}
+
+size_t MatrixMulImpl::AlgoInt4x4x32K8x12x4DotProd::get_workspace(
+        const KernSizeParam& kern_size_param) const {
+    MIDOUT_BEGIN(
+            megdnn_aarch64_matmul_kern,
+            midout_iv("AlgoInt4x4x32K8x12x4DotProd::get_workspace"_hash)) {
+        auto M = kern_size_param.M, N = kern_size_param.N, K = kern_size_param.K;
+        auto trA = kern_size_param.trA, trB = kern_size_param.trB;
+        auto A_type = kern_size_param.A_type, B_type = kern_size_param.B_type,
+             C_type = kern_size_param.C_type;
+
+        aarch64::matmul::gemm_s4x4x32_8x12 strategy(M, N, K, A_type, B_type, C_type);
+        return megdnn::matmul::GemmInterleaved<aarch64::matmul::gemm_s4x4x32_8x12>(
+                       M, N, K, trA, trB, strategy)
+                .get_workspace_size();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoInt4x4x32K8x12x4DotProd::get_kern(
+        const KernSizeParam&) const {
+    return int4x4x32_k8x12x4_dotprod_kern;
+}
+
+MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL(
+        AlgoInt4x4x32K8x12x4DotProd, megdnn_aarch64_matmul_kern,
+        "AlgoInt4x4x32K8x12x4DotProdImpl"_hash, aarch64::matmul::gemm_s4x4x32_8x12,
+        int8_t, int32_t, AlgoDataType::QINT4x4x32, DEFAULT);
+#endif
 // vim: syntax=cpp.doxygen
@@ -123,6 +123,61 @@ public:
 };
 #endif
 
+#if MGB_ENABLE_MMLA
+class MatrixMulImpl::AlgoInt8x8x32K8x12x8MMLA final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "AARCH64_INT8X8X32_K8X12X8_MMLA"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    MEGDNN_REG_GEMM_FUNC_FOR_IM2COL();
+    MEGDNN_DECL_ALGO_TYPE(AARCH64_INT8X8X32_K8X12X8_MMLA)
+};
+
+//! bf16 conv_bias has no im2col implementation, so the packed interface is not
+//! exported
+class MatrixMulImpl::AlgoBf16K8x12x4MMLA final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "AARCH64_BF16_K8X12X4_MMLA"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    PackMode packmode() const override { return PackMode::NO_PACK; }
+    MEGDNN_OVERRIDE_MATMUL_DESC(8, 12, 4, 2, AlgoDataType::FLOAT32, DEFAULT)
+    MEGDNN_DECL_ALGO_TYPE(AARCH64_BF16_K8X12X4_MMLA)
+};
+#endif
+
+#if MGB_ENABLE_SVE
+//! the block width of the sve algos depends on the vector length, so they have
+//! no packed interface and the n of the description is the one of 128-bit sve
+class MatrixMulImpl::AlgoF32SVE final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "AARCH64_F32_SVE"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override { return 0; }
+    kern_t get_kern(const KernSizeParam&) const override;
+    PackMode packmode() const override { return PackMode::NO_PACK; }
+    MEGDNN_OVERRIDE_MATMUL_DESC(8, 8, 1, 4, AlgoDataType::FLOAT32, DEFAULT)
+    MEGDNN_DECL_ALGO_TYPE(AARCH64_F32_SVE)
+};
+
+class MatrixMulImpl::AlgoInt8x8x32SVE final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "AARCH64_INT8X8X32_SVE"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    PackMode packmode() const override { return PackMode::NO_PACK; }
+    MEGDNN_OVERRIDE_MATMUL_DESC(8, 8, 4, 2, AlgoDataType::QINT8X8X32, DEFAULT)
+    MEGDNN_DECL_ALGO_TYPE(AARCH64_INT8X8X32_SVE)
+};
+#endif
+
 class MatrixMulImpl::AlgoInt8x8x32MK4_4x4x16 final : public AlgoBase {
 public:
     AlgoAttribute attribute() const override {
@@ -204,6 +259,19 @@ public:
     MEGDNN_DECL_ALGO_TYPE(AARCH64_INT4X4X16_K8X8X8)
 };
 
+#if MGB_ENABLE_DOT
+class MatrixMulImpl::AlgoInt4x4x32K8x12x4DotProd final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "AARCH64_INT4X4X32_K8X12X4_DOTPROD"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    MEGDNN_REG_GEMM_FUNC_FOR_IM2COL();
+    MEGDNN_DECL_ALGO_TYPE(AARCH64_INT4X4X32_K8X12X4_DOTPROD)
+};
+#endif
+
 class MatrixMulImpl::AlgoInt8x8x16MK4_16x12x4 final : public AlgoBase {
 public:
     AlgoAttribute attribute() const override {
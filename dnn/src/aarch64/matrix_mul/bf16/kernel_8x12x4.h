@@ -0,0 +1,167 @@
+#pragma once
+
+#if MGB_ENABLE_MMLA
+#include <cstring>
+#include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace aarch64 {
+namespace matmul_mmla_bf16_8x12x4 {
+
+//! acc += a * b^T, where a and b are 2x4 bf16 matrices in row major and acc
+//! is the 2x2 fp32 matrix in row major
+MEGDNN_ATTRIBUTE_TARGET("bf16")
+static inline float32x4_t bfmmla(float32x4_t acc, uint16x8_t a, uint16x8_t b) {
+    asm("bfmmla %[acc].4s, %[a].8h, %[b].8h"
+        : [acc] "+w"(acc)
+        : [a] "w"(a), [b] "w"(b));
+    return acc;
+}
+
+/**
+ * The layout is the same as matmul_mmla_8x12x8::kern_8x12 except that every
+ * 4 k form a block: the packed panels hold an 8x4 block of A and a 12x4 block
+ * of B (transposed) in row major, and c[i][j] accumulates the 2x2 fp32 block
+ * of C at rows {2i, 2i + 1} and columns {2j, 2j + 1}. C is converted from and
+ * to bf16 when it is loaded and stored.
+ */
+MEGDNN_ATTRIBUTE_TARGET("bf16")
+static void kern_8x12(
+        const dt_bfloat16* packA, const dt_bfloat16* packB, int K,
+        dt_bfloat16* output, int LDC, bool is_first_k, int m, int n) {
+    const uint16_t* a_ptr = reinterpret_cast<const uint16_t*>(packA);
+    const uint16_t* b_ptr = reinterpret_cast<const uint16_t*>(packB);
+    float32x4_t c[4][6];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            c[i][j] = vdupq_n_f32(0.f);
+        }
+    }
+    for (int k = 0; k < K; k += 4) {
+        uint16x8_t a[4];
+        for (int i = 0; i < 4; ++i) {
+            a[i] = vld1q_u16(a_ptr + 8 * i);
+        }
+        for (int j = 0; j < 6; ++j) {
+            uint16x8_t b = vld1q_u16(b_ptr + 8 * j);
+            for (int i = 0; i < 4; ++i) {
+                c[i][j] = bfmmla(c[i][j], a[i], b);
+            }
+        }
+        a_ptr += 32;
+        b_ptr += 48;
+    }
+
+    float tmp[8 * 12];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            float64x2_t lo = vreinterpretq_f64_f32(c[i][2 * j]);
+            float64x2_t hi = vreinterpretq_f64_f32(c[i][2 * j + 1]);
+            vst1q_f32(
+                    tmp + 2 * i * 12 + 4 * j,
+                    vreinterpretq_f32_f64(vzip1q_f64(lo, hi)));
+            vst1q_f32(
+                    tmp + (2 * i + 1) * 12 + 4 * j,
+                    vreinterpretq_f32_f64(vzip2q_f64(lo, hi)));
+        }
+    }
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            float v = tmp[i * 12 + j];
+            if (!is_first_k) {
+                v += static_cast<float>(output[i * LDC + j]);
+            }
+            output[i * LDC + j] = dt_bfloat16(v);
+        }
+    }
+}
+
+//! out[y / 8][k / 4][y % 8][k % 4] = A[y, k], with A in row major
+static void gemm_bf16_8x12x4_pack_A_n(
+        dt_bfloat16* out, const dt_bfloat16* in, int ldin, int y0, int ymax, int k0,
+        int kmax) {
+    for (int y = y0; y < ymax; y += 8) {
+        int rows = std::min(8, ymax - y);
+        for (int k = k0; k < kmax; k += 4) {
+            int depth = std::min(4, kmax - k);
+            if (rows < 8 || depth < 4) {
+                memset(out, 0, 32 * sizeof(dt_bfloat16));
+            }
+            for (int i = 0; i < rows; ++i) {
+                memcpy(
+                        out + i * 4, in + (y + i) * ldin + k,
+                        depth * sizeof(dt_bfloat16));
+            }
+            out += 32;
+        }
+    }
+}
+
+//! out[y / 8][k / 4][y % 8][k % 4] = A[y, k], with A given by its transpose
+static void gemm_bf16_8x12x4_pack_A_t(
+        dt_bfloat16* out, const dt_bfloat16* in, int ldin, int y0, int ymax, int k0,
+        int kmax) {
+    for (int y = y0; y < ymax; y += 8) {
+        int rows = std::min(8, ymax - y);
+        for (int k = k0; k < kmax; k += 4) {
+            int depth = std::min(4, kmax - k);
+            memset(out, 0, 32 * sizeof(dt_bfloat16));
+            for (int kk = 0; kk < depth; ++kk) {
+                const dt_bfloat16* inptr = in + (k + kk) * ldin + y;
+                for (int i = 0; i < rows; ++i) {
+                    out[i * 4 + kk] = inptr[i];
+                }
+            }
+            out += 32;
+        }
+    }
+}
+
+//! out[x / 12][k / 4][x % 12][k % 4] = B[k, x], with B in row major
+static void gemm_bf16_8x12x4_pack_B_n(
+        dt_bfloat16* out, const dt_bfloat16* in, int ldin, int x0, int xmax, int k0,
+        int kmax) {
+    for (int x = x0; x < xmax; x += 12) {
+        int cols = std::min(12, xmax - x);
+        for (int k = k0; k < kmax; k += 4) {
+            int depth = std::min(4, kmax - k);
+            memset(out, 0, 48 * sizeof(dt_bfloat16));
+            for (int kk = 0; kk < depth; ++kk) {
+                const dt_bfloat16* inptr = in + (k + kk) * ldin + x;
+                for (int j = 0; j < cols; ++j) {
+                    out[j * 4 + kk] = inptr[j];
+                }
+            }
+            out += 48;
+        }
+    }
+}
+
+//! out[x / 12][k / 4][x % 12][k % 4] = B[k, x], with B given by its transpose
+static void gemm_bf16_8x12x4_pack_B_t(
+        dt_bfloat16* out, const dt_bfloat16* in, int ldin, int x0, int xmax, int k0,
+        int kmax) {
+    for (int x = x0; x < xmax; x += 12) {
+        int cols = std::min(12, xmax - x);
+        for (int k = k0; k < kmax; k += 4) {
+            int depth = std::min(4, kmax - k);
+            if (cols < 12 || depth < 4) {
+                memset(out, 0, 48 * sizeof(dt_bfloat16));
+            }
+            for (int j = 0; j < cols; ++j) {
+                memcpy(
+                        out + j * 4, in + (x + j) * ldin + k,
+                        depth * sizeof(dt_bfloat16));
+            }
+            out += 48;
+        }
+    }
+}
+
+}  // namespace matmul_mmla_bf16_8x12x4
+}  // namespace aarch64
+}  // namespace megdnn
+
+#endif
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,73 @@
+#include "src/aarch64/matrix_mul/bf16/strategy.h"
+#if MGB_ENABLE_MMLA
+#include "src/aarch64/matrix_mul/bf16/kernel_8x12x4.h"
+#include "src/common/utils.h"
+
+using namespace megdnn;
+using namespace aarch64;
+using namespace aarch64::matmul;
+
+/* ====================== gemm_bf16_8x12x4_mmla ===========================*/
+MEGDNN_REG_GEMM_STRATEGY_IMPL(gemm_bf16_8x12x4_mmla);
+
+void gemm_bf16_8x12x4_mmla::pack_A(
+        dt_bfloat16* outptr, const dt_bfloat16* inptr, int ldin, int y0, int ymax,
+        int k0, int kmax, bool transpose) const {
+    if (transpose) {
+        matmul_mmla_bf16_8x12x4::gemm_bf16_8x12x4_pack_A_t(
+                outptr, inptr, ldin, y0, ymax, k0, kmax);
+    } else {
+        matmul_mmla_bf16_8x12x4::gemm_bf16_8x12x4_pack_A_n(
+                outptr, inptr, ldin, y0, ymax, k0, kmax);
+    }
+}
+
+void gemm_bf16_8x12x4_mmla::pack_B(
+        dt_bfloat16* out, const dt_bfloat16* in, int ldin, int x0, int xmax, int k0,
+        int kmax, bool transpose) const {
+    if (transpose) {
+        matmul_mmla_bf16_8x12x4::gemm_bf16_8x12x4_pack_B_t(
+                out, in, ldin, x0, xmax, k0, kmax);
+    } else {
+        matmul_mmla_bf16_8x12x4::gemm_bf16_8x12x4_pack_B_n(
+                out, in, ldin, x0, xmax, k0, kmax);
+    }
+}
+
+void gemm_bf16_8x12x4_mmla::kern(
+        const dt_bfloat16* packA, const dt_bfloat16* packB, size_t M, size_t N,
+        size_t K, dt_bfloat16* C, size_t LDC, bool is_first_k, const dt_float32*,
+        dt_float32*) const {
+    megdnn_assert(
+            A_dtype.enumv() == B_dtype.enumv() &&
+                    A_dtype.enumv() == C_dtype.enumv() &&
+                    A_dtype.enumv() == DTypeEnum::BFloat16,
+            "A: %s B: %s C: %s", A_dtype.name(), B_dtype.name(), C_dtype.name());
+
+    MEGDNN_MARK_USED_VAR(A_dtype);
+    MEGDNN_MARK_USED_VAR(B_dtype);
+    MEGDNN_MARK_USED_VAR(C_dtype);
+
+    constexpr size_t A_INTERLEAVE = 8;
+    constexpr size_t B_INTERLEAVE = 12;
+    //! K is packed to times of 4
+    K = round_up<size_t>(K, 4);
+    const size_t K8 = K * A_INTERLEAVE;
+    const size_t K12 = K * B_INTERLEAVE;
+
+    for (size_t m = 0; m < M; m += A_INTERLEAVE) {
+        dt_bfloat16* output = C + (m * LDC);
+        const dt_bfloat16* cur_packB = packB;
+        for (size_t n = 0; n < N; n += B_INTERLEAVE) {
+            matmul_mmla_bf16_8x12x4::kern_8x12(
+                    packA, cur_packB, K, output, LDC, is_first_k,
+                    std::min<size_t>(M - m, A_INTERLEAVE),
+                    std::min<size_t>(N - n, B_INTERLEAVE));
+            output += B_INTERLEAVE;
+            cur_packB += K12;
+        }
+        packA += K8;
+    }
+}
+#endif
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,17 @@
+#pragma once
+#include "src/fallback/matrix_mul/gemm_common.h"
+
+#if MGB_ENABLE_MMLA
+namespace megdnn {
+namespace aarch64 {
+namespace matmul {
+
+MEGDNN_REG_GEMM_STRATEGY(
+        dt_bfloat16, dt_bfloat16, dt_float32, 8, 12, 4, false, false,
+        gemm_bf16_8x12x4_mmla);
+
+}  // namespace matmul
+}  // namespace aarch64
+}  // namespace megdnn
+#endif
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,247 @@
+#pragma once
+#if MGB_ENABLE_DOT
+#include "src/aarch64/matrix_mul/asm/common.h"
+#include "src/arm_common/simd_macro/marm_neon.h"
+
+namespace megdnn {
+namespace aarch64 {
+namespace matmul_s4_8x12x4 {
+
+/**
+ * The 4bit matrices are unpacked to int8 when they are packed, so the packed
+ * panels have the same layout as the ones of gemm_s8_8x12 and are computed by
+ * its dotprod kernels. Only the 4bit data is read from memory.
+ *
+ * Two elements are stored in a byte with the former one in the low nibble. The
+ * zero point of uint4 is subtracted when unpacking, which keeps the values in
+ * [-15, 15], so both int4 and uint4 are multiplied by sdot.
+ */
+
+//! the element in the low nibble of \p val
+template <bool is_signed>
+static inline int8_t low_nibble(int8_t val, int8_t zero_point) {
+    if (is_signed) {
+        return static_cast<int8_t>(val << 4) >> 4;
+    }
+    return (val & 0xF) - zero_point;
+}
+
+//! the element in the high nibble of \p val
+template <bool is_signed>
+static inline int8_t high_nibble(int8_t val, int8_t zero_point) {
+    if (is_signed) {
+        return val >> 4;
+    }
+    return ((static_cast<uint8_t>(val) >> 4) & 0xF) - zero_point;
+}
+
+/**
+ * \brief unpack \p size 4bit elements starting from the \p idx th element of
+ * \p inptr to int8
+ */
+template <bool is_signed>
+static inline void unpack_4bit(
+        const int8_t* inptr, size_t idx, int size, int8_t zero_point,
+        int8_t* outptr) {
+    inptr += idx / 2;
+    int i = 0;
+    if ((idx & 1) && size > 0) {
+        outptr[i++] = high_nibble<is_signed>(*inptr++, zero_point);
+    }
+    int8x8_t vzp = vdup_n_s8(zero_point);
+    for (; i + 16 <= size; i += 16) {
+        int8x8_t val = vld1_s8(inptr);
+        int8x8_t low, high;
+        if (is_signed) {
+            low = vshr_n_s8(vshl_n_s8(val, 4), 4);
+            high = vshr_n_s8(val, 4);
+        } else {
+            low = vsub_s8(vand_s8(val, vdup_n_s8(0xF)), vzp);
+            high = vsub_s8(
+                    vreinterpret_s8_u8(vshr_n_u8(vreinterpret_u8_s8(val), 4)), vzp);
+        }
+        int8x8x2_t ret = vzip_s8(low, high);
+        vst1_s8(outptr + i, ret.val[0]);
+        vst1_s8(outptr + i + 8, ret.val[1]);
+        inptr += 8;
+    }
+    for (; i + 1 < size; i += 2) {
+        outptr[i] = low_nibble<is_signed>(*inptr, zero_point);
+        outptr[i + 1] = high_nibble<is_signed>(*inptr, zero_point);
+        inptr++;
+    }
+    if (i < size) {
+        outptr[i] = low_nibble<is_signed>(*inptr, zero_point);
+    }
+}
+
+//! pack the rows [y0, ymax) of a row major matrix, 8 rows, then 4 rows a time
+template <bool is_signed>
+static void gemm_s4_8x12_pack_A_n(
+        dt_int8* outptr, const dt_int8* inptr, int ldin, int y0, int ymax, int k0,
+        int kmax, int8_t zero_point) {
+    int8_t buf[8][16];
+
+    int y = y0;
+    for (; y + 7 < ymax; y += 8) {
+        for (int k = k0; k < kmax; k += 16) {
+            int size = std::min(16, kmax - k);
+            for (int i = 0; i < 8; i++) {
+                unpack_4bit<is_signed>(
+                        inptr, static_cast<size_t>(y + i) * ldin + k, size, zero_point,
+                        buf[i]);
+            }
+            const int8_t *inptr0 = buf[0], *inptr1 = buf[1], *inptr2 = buf[2],
+                         *inptr3 = buf[3], *inptr4 = buf[4], *inptr5 = buf[5],
+                         *inptr6 = buf[6], *inptr7 = buf[7];
+            if (size == 16) {
+                interleave_8x4_4_b(
+                        inptr0, inptr1, inptr2, inptr3, inptr4, inptr5, inptr6,
+                        inptr7, outptr);
+            } else {
+                interleave_8(
+                        inptr0, inptr1, inptr2, inptr3, inptr4, inptr5, inptr6,
+                        inptr7, outptr, 4, size);
+            }
+        }
+    }
+    for (; y < ymax; y += 4) {
+        for (int k = k0; k < kmax; k += 16) {
+            int size = std::min(16, kmax - k);
+            for (int i = 0; i < 4; i++) {
+                if (y + i < ymax) {
+                    unpack_4bit<is_signed>(
+                            inptr, static_cast<size_t>(y + i) * ldin + k, size,
+                            zero_point, buf[i]);
+                } else {
+                    std::memset(buf[i], 0, sizeof(buf[i]));
+                }
+            }
+            const int8_t *inptr0 = buf[0], *inptr1 = buf[1], *inptr2 = buf[2],
+                         *inptr3 = buf[3];
+            if (size == 16) {
+                interleave_4x4_4_b(inptr0, inptr1, inptr2, inptr3, outptr);
+            } else {
+                interleave_4(inptr0, inptr1, inptr2, inptr3, outptr, 4, size);
+            }
+        }
+    }
+}
+
+//! pack the rows [y0, ymax) of a row major matrix, 12 rows, then 4 rows a time
+template <bool is_signed>
+static void gemm_s4_8x12_pack_B_t(
+        dt_int8* outptr, const dt_int8* inptr, int ldin, int y0, int ymax, int k0,
+        int kmax, int8_t zero_point) {
+    int8_t buf[12][16];
+
+    int y = y0;
+    for (; y + 11 < ymax; y += 12) {
+        for (int k = k0; k < kmax; k += 16) {
+            int size = std::min(16, kmax - k);
+            for (int i = 0; i < 12; i++) {
+                unpack_4bit<is_signed>(
+                        inptr, static_cast<size_t>(y + i) * ldin + k, size, zero_point,
+                        buf[i]);
+            }
+            const int8_t *inptr0 = buf[0], *inptr1 = buf[1], *inptr2 = buf[2],
+                         *inptr3 = buf[3], *inptr4 = buf[4], *inptr5 = buf[5],
+                         *inptr6 = buf[6], *inptr7 = buf[7], *inptr8 = buf[8],
+                         *inptr9 = buf[9], *inptr10 = buf[10], *inptr11 = buf[11];
+            if (size == 16) {
+                interleave_12x4_4_b(
+                        inptr0, inptr1, inptr2, inptr3, inptr4, inptr5, inptr6,
+                        inptr7, inptr8, inptr9, inptr10, inptr11, outptr);
+            } else {
+                interleave_12(
+                        inptr0, inptr1, inptr2, inptr3, inptr4, inptr5, inptr6,
+                        inptr7, inptr8, inptr9, inptr10, inptr11, outptr, 4, size);
+            }
+        }
+    }
+    for (; y < ymax; y += 4) {
+        for (int k = k0; k < kmax; k += 16) {
+            int size = std::min(16, kmax - k);
+            for (int i = 0; i < 4; i++) {
+                if (y + i < ymax) {
+                    unpack_4bit<is_signed>(
+                            inptr, static_cast<size_t>(y + i) * ldin + k, size,
+                            zero_point, buf[i]);
+                } else {
+                    std::memset(buf[i], 0, sizeof(buf[i]));
+                }
+            }
+            const int8_t *inptr0 = buf[0], *inptr1 = buf[1], *inptr2 = buf[2],
+                         *inptr3 = buf[3];
+            if (size == 16) {
+                interleave_4x4_4_b(inptr0, inptr1, inptr2, inptr3, outptr);
+            } else {
+                interleave_4(inptr0, inptr1, inptr2, inptr3, outptr, 4, size);
+            }
+        }
+    }
+}
+
+/**
+ * \brief pack the columns [x0, xmax) of a row major matrix, \p interleave
+ * columns, then 4 columns a time
+ */
+template <bool is_signed, int interleave>
+static void gemm_s4_8x12_pack_transpose(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax,
+        int8_t zero_point) {
+    static_assert(interleave == 8 || interleave == 12, "invalid interleave");
+    int8_t buf[4][16];
+    const int ksize = kmax - k0;
+    const int ksize_interleave = round_up(ksize, 4) * interleave;
+    const int ksize4 = round_up(ksize, 4) * 4;
+    int8_t* outptr_base = out;
+    //! 4x4 block output start pos
+    int8_t* outptr_base4 = out + ((xmax - x0) / interleave) * ksize_interleave;
+
+    auto unpack = [&](int k, int x, int size) {
+        for (int i = 0; i < 4; i++) {
+            if (k + i < kmax) {
+                unpack_4bit<is_signed>(
+                        in, static_cast<size_t>(k + i) * ldin + x, size, zero_point,
+                        buf[i]);
+            } else {
+                std::memset(buf[i], 0, sizeof(buf[i]));
+            }
+        }
+    };
+    for (int k = k0; k < kmax; k += 4) {
+        int x = x0;
+        int8_t* outptr = outptr_base;
+        for (; x + interleave - 1 < xmax; x += interleave) {
+            unpack(k, x, interleave);
+            const int8_t *inptr0 = buf[0], *inptr1 = buf[1], *inptr2 = buf[2],
+                         *inptr3 = buf[3];
+            if (interleave == 12) {
+                transpose_12x4_1_b(inptr0, inptr1, inptr2, inptr3, outptr);
+            } else {
+                transpose_8x4_1_b(inptr0, inptr1, inptr2, inptr3, outptr);
+            }
+            outptr += ksize_interleave;
+        }
+
+        outptr = outptr_base4;
+        for (; x < xmax; x += 4) {
+            int size = std::min(4, xmax - x);
+            unpack(k, x, size);
+            const int8_t *inptr0 = buf[0], *inptr1 = buf[1], *inptr2 = buf[2],
+                         *inptr3 = buf[3];
+            transpose_4(inptr0, inptr1, inptr2, inptr3, outptr, 4, size);
+            outptr += ksize4;
+        }
+
+        outptr_base += interleave * 4;
+        outptr_base4 += 4 * 4;
+    }
+}
+
+}  // namespace matmul_s4_8x12x4
+}  // namespace aarch64
+}  // namespace megdnn
+#endif
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,132 @@
+#include "src/aarch64/matrix_mul/int4_dot/strategy.h"
+#if MGB_ENABLE_DOT
+#include "src/aarch64/matrix_mul/asm/common.h"
+#include "src/aarch64/matrix_mul/int4_dot/kernel_8x12x4.h"
+#include "src/aarch64/matrix_mul/int8_dot/kernel_8x12x4.h"
+#include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/common/utils.h"
+
+using namespace megdnn;
+using namespace aarch64;
+using namespace aarch64::matmul;
+
+namespace {
+int8_t zero_point_of(DType dtype) {
+    if (dtype.enumv() == DTypeEnum::Quantized4Asymm) {
+        return dtype.param<dtype::Quantized4Asymm>().zero_point;
+    }
+    return 0;
+}
+}  // anonymous namespace
+
+/* ====================== gemm_s4x4x32_8x12 ===========================*/
+MEGDNN_REG_GEMM_STRATEGY_IMPL(gemm_s4x4x32_8x12);
+
+void gemm_s4x4x32_8x12::pack_A(
+        dt_int8* outptr, const dt_int8* inptr, int ldin, int y0, int ymax, int k0,
+        int kmax, bool transpose) const {
+    int8_t zp = zero_point_of(A_dtype);
+#define cb(_is_signed)                                                               \
+    if (transpose) {                                                                 \
+        matmul_s4_8x12x4::gemm_s4_8x12_pack_transpose<_is_signed, 8>(                \
+                outptr, inptr, ldin, y0, ymax, k0, kmax, zp);                        \
+    } else {                                                                         \
+        matmul_s4_8x12x4::gemm_s4_8x12_pack_A_n<_is_signed>(                         \
+                outptr, inptr, ldin, y0, ymax, k0, kmax, zp);                        \
+    }
+    if (A_dtype.enumv() == DTypeEnum::QuantizedS4) {
+        cb(true);
+    } else {
+        cb(false);
+    }
+#undef cb
+}
+
+void gemm_s4x4x32_8x12::pack_B(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax,
+        bool transpose) const {
+    int8_t zp = zero_point_of(B_dtype);
+#define cb(_is_signed)                                                               \
+    if (transpose) {                                                                 \
+        matmul_s4_8x12x4::gemm_s4_8x12_pack_B_t<_is_signed>(                         \
+                out, in, ldin, x0, xmax, k0, kmax, zp);                              \
+    } else {                                                                         \
+        matmul_s4_8x12x4::gemm_s4_8x12_pack_transpose<_is_signed, 12>(               \
+                out, in, ldin, x0, xmax, k0, kmax, zp);                              \
+    }
+    if (B_dtype.enumv() == DTypeEnum::QuantizedS4) {
+        cb(true);
+    } else {
+        cb(false);
+    }
+#undef cb
+}
+
+void gemm_s4x4x32_8x12::kern(
+        const dt_int8* packA, const dt_int8* packB, size_t M, size_t N, size_t K,
+        dt_int32* C, size_t LDC, bool is_first_k, const dt_int32*, dt_int32*) const {
+    megdnn_assert(
+            A_dtype.enumv() == B_dtype.enumv() &&
+                    (A_dtype.enumv() == DTypeEnum::QuantizedS4 ||
+                     A_dtype.enumv() == DTypeEnum::Quantized4Asymm) &&
+                    C_dtype.enumv() == DTypeEnum::QuantizedS32,
+            "A: %s B: %s C: %s", A_dtype.name(), B_dtype.name(), C_dtype.name());
+
+    MEGDNN_MARK_USED_VAR(A_dtype);
+    MEGDNN_MARK_USED_VAR(B_dtype);
+    MEGDNN_MARK_USED_VAR(C_dtype);
+
+    constexpr size_t A_INTERLEAVE = 8;
+    constexpr size_t B_INTERLEAVE = 12;
+    //! K is packed to times of 4
+    K = round_up<size_t>(K, 4);
+    const int K8 = (K << 3);
+    const int K12 = K * 12;
+    const int K4 = K * 4;
+
+    size_t m = 0;
+    for (; m + A_INTERLEAVE - 1 < M; m += A_INTERLEAVE) {
+        int32_t* output = C + (m * LDC);
+
+        size_t n = 0;
+        const dt_int8* cur_packB = packB;
+        for (; n + B_INTERLEAVE - 1 < N; n += B_INTERLEAVE) {
+            matmul_8x12x4::kern_8x12(packA, cur_packB, K, output, LDC, is_first_k);
+            output += B_INTERLEAVE;
+            cur_packB += K12;
+        }
+
+        for (; n < N; n += 4) {
+            matmul_8x12x4::kern_8x4(
+                    packA, cur_packB, K, output, LDC, is_first_k,
+                    std::min<size_t>(N - n, 4));
+            output += 4;
+            cur_packB += K4;
+        }
+        packA += K8;
+    }
+
+    for (; m < M; m += 4) {
+        int32_t* output = C + (m * LDC);
+        const dt_int8* cur_packB = packB;
+        size_t n = 0;
+        for (; n + B_INTERLEAVE - 1 < N; n += B_INTERLEAVE) {
+            matmul_8x12x4::kern_4x12(
+                    packA, cur_packB, K, output, LDC, is_first_k,
+                    std::min<size_t>(M - m, 4));
+            output += B_INTERLEAVE;
+            cur_packB += K12;
+        }
+
+        for (; n < N; n += 4) {
+            matmul_8x12x4::kern_4x4(
+                    packA, cur_packB, K, output, LDC, is_first_k,
+                    std::min<size_t>(M - m, 4), std::min<size_t>(N - n, 4));
+            output += 4;
+            cur_packB += K4;
+        }
+        packA += K4;
+    }
+}
+#endif
+// vim: syntax=cpp.doxygen
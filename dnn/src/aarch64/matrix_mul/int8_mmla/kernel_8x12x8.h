@@ -0,0 +1,180 @@
+#pragma once
+
+#if MGB_ENABLE_MMLA
+#include <cstring>
+#include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace aarch64 {
+namespace matmul_mmla_8x12x8 {
+
+//! acc += a * b^T, where a and b are 2x8 int8 matrices in row major and acc
+//! is the 2x2 int32 matrix in row major
+MEGDNN_ATTRIBUTE_TARGET("i8mm")
+static inline int32x4_t smmla(int32x4_t acc, int8x16_t a, int8x16_t b) {
+    asm("smmla %[acc].4s, %[a].16b, %[b].16b"
+        : [acc] "+w"(acc)
+        : [a] "w"(a), [b] "w"(b));
+    return acc;
+}
+
+/**
+ * Overview of register layout:
+ *
+ * Every 8 k the packed panels hold an 8x8 block of A in row major and a 12x8
+ * block of B (transposed) in row major, so a pair of rows of A (columns of B)
+ * is exactly one operand of smmla. c[i][j] accumulates the 2x2 block of C at
+ * rows {2i, 2i + 1} and columns {2j, 2j + 1}.
+ *
+ *                     +----+----+     +----+----+
+ *                     | b0 | b1 | ... | b4 | b5 |  (2 cols x 8 k each)
+ *                     +----+----+     +----+----+
+ *  +----+             +---------+     +---------+
+ *  | a0 |             | c00 c01 | ... |     c05 |
+ *  | a1 |             | c10 c11 |     |     c15 |
+ *  | a2 |             |         |     |         |
+ *  | a3 |             | c30     |     |     c35 |
+ *  +----+             +---------+     +---------+
+ *  (2 rows x 8 k each)
+ *
+ * The panels are zero padded to 8 rows and 12 columns, only the m x n valid
+ * part of C is written back.
+ */
+MEGDNN_ATTRIBUTE_TARGET("i8mm")
+static void kern_8x12(
+        const dt_int8* packA, const dt_int8* packB, int K, dt_int32* output, int LDC,
+        bool is_first_k, int m, int n) {
+    int32x4_t c[4][6];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            c[i][j] = vdupq_n_s32(0);
+        }
+    }
+    for (int k = 0; k < K; k += 8) {
+        int8x16_t a[4];
+        for (int i = 0; i < 4; ++i) {
+            a[i] = vld1q_s8(packA + 16 * i);
+        }
+        for (int j = 0; j < 6; ++j) {
+            int8x16_t b = vld1q_s8(packB + 16 * j);
+            for (int i = 0; i < 4; ++i) {
+                c[i][j] = smmla(c[i][j], a[i], b);
+            }
+        }
+        packA += 64;
+        packB += 96;
+    }
+
+    //! zip the 64-bit halves of two neighbouring 2x2 blocks to get 4 contiguous
+    //! outputs of each of the two rows
+    bool full = m == 8 && n == 12;
+    dt_int32 tmp[8 * 12];
+    dt_int32* dst = full ? output : tmp;
+    int ld = full ? LDC : 12;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            int64x2_t lo = vreinterpretq_s64_s32(c[i][2 * j]);
+            int64x2_t hi = vreinterpretq_s64_s32(c[i][2 * j + 1]);
+            int32x4_t r0 = vreinterpretq_s32_s64(vzip1q_s64(lo, hi));
+            int32x4_t r1 = vreinterpretq_s32_s64(vzip2q_s64(lo, hi));
+            dt_int32* p0 = dst + 2 * i * ld + 4 * j;
+            dt_int32* p1 = p0 + ld;
+            if (full && !is_first_k) {
+                r0 = vaddq_s32(r0, vld1q_s32(p0));
+                r1 = vaddq_s32(r1, vld1q_s32(p1));
+            }
+            vst1q_s32(p0, r0);
+            vst1q_s32(p1, r1);
+        }
+    }
+    if (!full) {
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) {
+                dt_int32 v = tmp[i * 12 + j];
+                output[i * LDC + j] = is_first_k ? v : output[i * LDC + j] + v;
+            }
+        }
+    }
+}
+
+//! out[y / 8][k / 8][y % 8][k % 8] = A[y, k], with A in row major
+static void gemm_s8_8x12x8_pack_A_n(
+        dt_int8* out, const dt_int8* in, int ldin, int y0, int ymax, int k0, int kmax) {
+    for (int y = y0; y < ymax; y += 8) {
+        int rows = std::min(8, ymax - y);
+        for (int k = k0; k < kmax; k += 8) {
+            int depth = std::min(8, kmax - k);
+            if (rows < 8 || depth < 8) {
+                memset(out, 0, 64);
+            }
+            for (int i = 0; i < rows; ++i) {
+                memcpy(out + i * 8, in + (y + i) * ldin + k, depth);
+            }
+            out += 64;
+        }
+    }
+}
+
+//! out[y / 8][k / 8][y % 8][k % 8] = A[y, k], with A given by its transpose
+static void gemm_s8_8x12x8_pack_A_t(
+        dt_int8* out, const dt_int8* in, int ldin, int y0, int ymax, int k0, int kmax) {
+    for (int y = y0; y < ymax; y += 8) {
+        int rows = std::min(8, ymax - y);
+        for (int k = k0; k < kmax; k += 8) {
+            int depth = std::min(8, kmax - k);
+            memset(out, 0, 64);
+            for (int kk = 0; kk < depth; ++kk) {
+                const dt_int8* inptr = in + (k + kk) * ldin + y;
+                for (int i = 0; i < rows; ++i) {
+                    out[i * 8 + kk] = inptr[i];
+                }
+            }
+            out += 64;
+        }
+    }
+}
+
+//! out[x / 12][k / 8][x % 12][k % 8] = B[k, x], with B in row major
+static void gemm_s8_8x12x8_pack_B_n(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax) {
+    for (int x = x0; x < xmax; x += 12) {
+        int cols = std::min(12, xmax - x);
+        for (int k = k0; k < kmax; k += 8) {
+            int depth = std::min(8, kmax - k);
+            memset(out, 0, 96);
+            for (int kk = 0; kk < depth; ++kk) {
+                const dt_int8* inptr = in + (k + kk) * ldin + x;
+                for (int j = 0; j < cols; ++j) {
+                    out[j * 8 + kk] = inptr[j];
+                }
+            }
+            out += 96;
+        }
+    }
+}
+
+//! out[x / 12][k / 8][x % 12][k % 8] = B[k, x], with B given by its transpose
+static void gemm_s8_8x12x8_pack_B_t(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax) {
+    for (int x = x0; x < xmax; x += 12) {
+        int cols = std::min(12, xmax - x);
+        for (int k = k0; k < kmax; k += 8) {
+            int depth = std::min(8, kmax - k);
+            if (cols < 12 || depth < 8) {
+                memset(out, 0, 96);
+            }
+            for (int j = 0; j < cols; ++j) {
+                memcpy(out + j * 8, in + (x + j) * ldin + k, depth);
+            }
+            out += 96;
+        }
+    }
+}
+
+}  // namespace matmul_mmla_8x12x8
+}  // namespace aarch64
+}  // namespace megdnn
+
+#endif
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,16 @@
+#pragma once
+#include "src/fallback/matrix_mul/gemm_common.h"
+
+#if MGB_ENABLE_MMLA
+namespace megdnn {
+namespace aarch64 {
+namespace matmul {
+
+MEGDNN_REG_GEMM_STRATEGY(
+        dt_int8, dt_int32, dt_int32, 8, 12, 8, false, false, gemm_s8_8x12x8_mmla);
+
+}  // namespace matmul
+}  // namespace aarch64
+}  // namespace megdnn
+#endif
+// vim: syntax=cpp.doxygen
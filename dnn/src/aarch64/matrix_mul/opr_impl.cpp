@@ -20,6 +20,14 @@ class MatrixMulImpl::AlgoPack : NonCopyableObj {
 #if MGB_ENABLE_DOT
     AlgoInt8x8x32K8x12x4DotProd int8x8x32_k8x12x4_dotprod;
     AlgoInt8x8x32MK4_8x12x4DotProd int8x8x32_mk4_8x12x4_dotprod;
+#endif
+#if MGB_ENABLE_MMLA
+    AlgoInt8x8x32K8x12x8MMLA int8x8x32_k8x12x8_mmla;
+    AlgoBf16K8x12x4MMLA bf16_k8x12x4_mmla;
+#endif
+#if MGB_ENABLE_SVE
+    AlgoF32SVE f32_sve;
+    AlgoInt8x8x32SVE int8x8x32_sve;
 #endif
     AlgoInt8x8x32MK4_4x4x16 int8x8x32_mk4_4x4x16;
     AlgoInt8x8x32K4x4x16 int8x8x32_k4x4x16;
@@ -39,6 +47,9 @@ class MatrixMulImpl::AlgoPack : NonCopyableObj {
 #endif
     AlgoQuint8K8x8x8 quint8_k8x8x8;
     AlgoInt4x4x16K8x8x8 int4x4x16_k8x8x8;
+#if MGB_ENABLE_DOT
+    AlgoInt4x4x32K8x12x4DotProd int4x4x32_k8x12x4_dotprod;
+#endif
 
     SmallVector<fallback::MatrixMulImpl::AlgoBase*> m_all_algos;
     fallback::MatrixMulImpl::AlgoBase::Mapper m_all_algos_map;
@@ -46,6 +57,9 @@ class MatrixMulImpl::AlgoPack : NonCopyableObj {
 public:
     AlgoPack() {
         m_all_algos.emplace_back(&f32_gemv);
+#if MGB_ENABLE_SVE
+        m_all_algos.emplace_back(&f32_sve);
+#endif
         m_all_algos.emplace_back(&f32K8x12x1);
         m_all_algos.emplace_back(&f32_mk4_8x12x1);
         m_all_algos.emplace_back(&f32k4x16x1);
@@ -55,6 +69,13 @@ public:
         m_all_algos.emplace_back(&f16_mk8_8x8);
         m_all_algos.emplace_back(&f16_mk8_16x12x1);
 #endif
+#if MGB_ENABLE_MMLA
+        m_all_algos.emplace_back(&int8x8x32_k8x12x8_mmla);
+        m_all_algos.emplace_back(&bf16_k8x12x4_mmla);
+#endif
+#if MGB_ENABLE_SVE
+        m_all_algos.emplace_back(&int8x8x32_sve);
+#endif
 #if MGB_ENABLE_DOT
         m_all_algos.emplace_back(&int8x8x32_k8x12x4_dotprod);
         m_all_algos.emplace_back(&int8x8x32_mk4_8x12x4_dotprod);
@@ -75,6 +96,9 @@ public:
         m_all_algos.emplace_back(&quint8_k8x8x4_dotprod);
 #endif
         m_all_algos.emplace_back(&quint8_k8x8x8);
+#if MGB_ENABLE_DOT
+        m_all_algos.emplace_back(&int4x4x32_k8x12x4_dotprod);
+#endif
         m_all_algos.emplace_back(&int4x4x16_k8x8x8);
 
         for (auto&& algo : m_all_algos) {
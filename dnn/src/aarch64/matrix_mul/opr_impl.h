@@ -35,6 +35,14 @@ private:
                                            // 8x12x4 DotProduct
     class AlgoInt8x8x32MK4_8x12x4DotProd;  // Aarch64 nchw44 Int8x8x32 Kernel
                                            // 8x12x4 DotProduct
+#endif
+#if MGB_ENABLE_MMLA
+    class AlgoInt8x8x32K8x12x8MMLA;  // Aarch64 Int8x8x32 Kernel 8x12x8 i8mm
+    class AlgoBf16K8x12x4MMLA;       // Aarch64 BF16 Kernel 8x12x4 bf16
+#endif
+#if MGB_ENABLE_SVE
+    class AlgoF32SVE;        // Aarch64 F32 vector length agnostic sve
+    class AlgoInt8x8x32SVE;  // Aarch64 Int8x8x32 vector length agnostic sve
 #endif
     class AlgoInt8x8x32MK4_4x4x16;   // Aarch64 nchw44 Int8x8x32 Kernel 4x4x16
     class AlgoInt8x8x32K4x4x16;      // Aarch64 Int8x8x32 Kernel 4x4x16
@@ -55,6 +63,10 @@ private:
     class AlgoQuint8K8x8x8;         // Aarch64 Quint8 Kernel 8x8x8
     class AlgoInt8x8x16MK4_K8x8x8;  // Aarch64 Int8x8x16 Kernel 4x4x16
     class AlgoInt4x4x16K8x8x8;      // Aarch64 Int4x4x16 Kernel 4x4x16
+#if MGB_ENABLE_DOT
+    class AlgoInt4x4x32K8x12x4DotProd;  // Aarch64 Int4x4x32 Kernel
+                                        // 8x12x4 DotProduct
+#endif
     class AlgoPack;
 
 public:
@@ -0,0 +1,206 @@
+#include "src/aarch64/matrix_mul/sve/gemm.h"
+
+#if MGB_ENABLE_SVE
+#include <arm_sve.h>
+#include <cstring>
+#include "src/common/unroll_macro.h"
+
+using namespace megdnn;
+using namespace aarch64;
+
+namespace {
+
+constexpr size_t MR = 8;
+//! the block of B kept in L2 cache, at most KB x NB elements
+constexpr size_t KB = 256;
+constexpr size_t NB = 256;
+//! bytes of the packed int8 B kept in L2 cache
+constexpr size_t B_BLOCK_BYTES = 256 * 1024;
+
+/*!
+ * \brief C[0:R, n0:n1] (+)= A[0:R, 0:K] * B[0:K, n0:n1] in fp32
+ *
+ * Every step of k broadcasts one element of each row of A and accumulates it
+ * with two vectors of a row of B, so there are 2 * R accumulators. The
+ * predicates mask the tail of the columns.
+ */
+template <size_t R>
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void sgemm_rows(
+        const float* A, size_t LDA, const float* B, size_t LDB, float* C, size_t LDC,
+        size_t n0, size_t n1, size_t K, bool is_first_k) {
+    const size_t vl = svcntw();
+    for (size_t n = n0; n < n1; n += 2 * vl) {
+        svbool_t pg0 = svwhilelt_b32_u64(n, n1);
+        svbool_t pg1 = svwhilelt_b32_u64(n + vl, n1);
+#define cb(i)                                                            \
+    svfloat32_t c##i##0 = svdup_n_f32(0.f), c##i##1 = svdup_n_f32(0.f); \
+    if (i < R && !is_first_k) {                                         \
+        c##i##0 = svld1_f32(pg0, C + i * LDC + n);                      \
+        c##i##1 = svld1_f32(pg1, C + i * LDC + n + vl);                 \
+    }
+        UNROLL_CALL_NOWRAPPER(8, cb);
+#undef cb
+        const float* bptr = B + n;
+        for (size_t k = 0; k < K; ++k) {
+            svfloat32_t b0 = svld1_f32(pg0, bptr);
+            svfloat32_t b1 = svld1_f32(pg1, bptr + vl);
+#define cb(i)                                         \
+    if (i < R) {                                      \
+        float a = A[i * LDA + k];                     \
+        c##i##0 = svmla_n_f32_x(pg0, c##i##0, b0, a); \
+        c##i##1 = svmla_n_f32_x(pg1, c##i##1, b1, a); \
+    }
+            UNROLL_CALL_NOWRAPPER(8, cb);
+#undef cb
+            bptr += LDB;
+        }
+#define cb(i)                                           \
+    if (i < R) {                                        \
+        svst1_f32(pg0, C + i * LDC + n, c##i##0);       \
+        svst1_f32(pg1, C + i * LDC + n + vl, c##i##1);  \
+    }
+        UNROLL_CALL_NOWRAPPER(8, cb);
+#undef cb
+    }
+}
+
+using sgemm_rows_t = void (*)(
+        const float*, size_t, const float*, size_t, float*, size_t, size_t, size_t,
+        size_t, bool);
+const sgemm_rows_t sgemm_rows_kerns[MR] = {
+        sgemm_rows<1>, sgemm_rows<2>, sgemm_rows<3>, sgemm_rows<4>,
+        sgemm_rows<5>, sgemm_rows<6>, sgemm_rows<7>, sgemm_rows<8>};
+
+//! out[k / 4][x][k % 4] = B[k, x], zero padded to a multiple of 4 along k
+void pack_B_s8(
+        dt_int8* out, const dt_int8* B, size_t LDB, size_t N, size_t K, bool trB) {
+    size_t K4 = div_ceil<size_t>(K, 4);
+    memset(out, 0, K4 * 4 * N);
+    for (size_t k = 0; k < K; ++k) {
+        dt_int8* outptr = out + k / 4 * 4 * N + k % 4;
+        if (trB) {
+            for (size_t x = 0; x < N; ++x) {
+                outptr[x * 4] = B[x * LDB + k];
+            }
+        } else {
+            const dt_int8* inptr = B + k * LDB;
+            for (size_t x = 0; x < N; ++x) {
+                outptr[x * 4] = inptr[x];
+            }
+        }
+    }
+}
+
+/*!
+ * \brief C[0:R, n0:n1] = A[0:R, 0:K] * B[0:K, n0:n1] in int32 with sdot
+ *
+ * Every 4 k of a row of A are broadcast as one int32 and dotted with the
+ * packed B, whose int32 lanes hold the 4 k of one column. The last group of k
+ * of A is read partially so no byte out of A is touched.
+ */
+template <size_t R>
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void gemm_s8_rows(
+        const dt_int8* A, size_t LDA, const dt_int8* packB, size_t N, dt_int32* C,
+        size_t LDC, size_t n0, size_t n1, size_t K) {
+    const size_t vl = svcntw();
+    const size_t K4 = K / 4, tail = K % 4;
+    for (size_t n = n0; n < n1; n += 2 * vl) {
+        svbool_t pg0 = svwhilelt_b32_u64(n, n1);
+        svbool_t pg1 = svwhilelt_b32_u64(n + vl, n1);
+        svbool_t pb0 = svwhilelt_b8_u64(4 * n, 4 * n1);
+        svbool_t pb1 = svwhilelt_b8_u64(4 * (n + vl), 4 * n1);
+#define cb(i) svint32_t c##i##0 = svdup_n_s32(0), c##i##1 = svdup_n_s32(0);
+        UNROLL_CALL_NOWRAPPER(8, cb);
+#undef cb
+        const dt_int8* bptr = packB + 4 * n;
+#define cb(i, cnt)                                              \
+    if (i < R) {                                                \
+        int32_t a = 0;                                          \
+        memcpy(&a, A + i * LDA + 4 * k, cnt);                   \
+        svint8_t va = svreinterpret_s8_s32(svdup_n_s32(a));     \
+        c##i##0 = svdot_s32(c##i##0, b0, va);                   \
+        c##i##1 = svdot_s32(c##i##1, b1, va);                   \
+    }
+        size_t k = 0;
+        for (; k < K4; ++k) {
+            svint8_t b0 = svld1_s8(pb0, bptr);
+            svint8_t b1 = svld1_s8(pb1, bptr + 4 * vl);
+            UNROLL_CALL_RAW(8, cb, 4);
+            bptr += 4 * N;
+        }
+        if (tail) {
+            svint8_t b0 = svld1_s8(pb0, bptr);
+            svint8_t b1 = svld1_s8(pb1, bptr + 4 * vl);
+            UNROLL_CALL_RAW(8, cb, tail);
+        }
+#undef cb
+#define cb(i)                                           \
+    if (i < R) {                                        \
+        svst1_s32(pg0, C + i * LDC + n, c##i##0);       \
+        svst1_s32(pg1, C + i * LDC + n + vl, c##i##1);  \
+    }
+        UNROLL_CALL_NOWRAPPER(8, cb);
+#undef cb
+    }
+}
+
+using gemm_s8_rows_t = void (*)(
+        const dt_int8*, size_t, const dt_int8*, size_t, dt_int32*, size_t, size_t,
+        size_t, size_t);
+const gemm_s8_rows_t gemm_s8_rows_kerns[MR] = {
+        gemm_s8_rows<1>, gemm_s8_rows<2>, gemm_s8_rows<3>, gemm_s8_rows<4>,
+        gemm_s8_rows<5>, gemm_s8_rows<6>, gemm_s8_rows<7>, gemm_s8_rows<8>};
+
+}  // anonymous namespace
+
+void matmul::sgemm_sve(
+        const float* A, size_t LDA, const float* B, size_t LDB, float* C, size_t LDC,
+        size_t M, size_t N, size_t K) {
+    if (K == 0) {
+        for (size_t m = 0; m < M; ++m) {
+            memset(C + m * LDC, 0, N * sizeof(float));
+        }
+        return;
+    }
+    //! stream the rows of A over a KB x NB block of B in L2 cache
+    for (size_t n0 = 0; n0 < N; n0 += NB) {
+        size_t n1 = std::min(N, n0 + NB);
+        for (size_t k0 = 0; k0 < K; k0 += KB) {
+            size_t kb = std::min(K - k0, KB);
+            for (size_t m = 0; m < M; m += MR) {
+                size_t rows = std::min(MR, M - m);
+                sgemm_rows_kerns[rows - 1](
+                        A + m * LDA + k0, LDA, B + k0 * LDB, LDB, C + m * LDC, LDC, n0,
+                        n1, kb, k0 == 0);
+            }
+        }
+    }
+}
+
+size_t matmul::gemm_s8s8s32_sve_workspace(size_t N, size_t K) {
+    return round_up<size_t>(K, 4) * N;
+}
+
+void matmul::gemm_s8s8s32_sve(
+        const dt_int8* A, size_t LDA, const dt_int8* B, size_t LDB, dt_int32* C,
+        size_t LDC, size_t M, size_t N, size_t K, bool trB, void* workspace) {
+    dt_int8* packB = static_cast<dt_int8*>(workspace);
+    pack_B_s8(packB, B, LDB, N, K, trB);
+    //! stream the rows of A over a block of the packed B in L2 cache
+    size_t K4 = std::max<size_t>(div_ceil<size_t>(K, 4), 1);
+    size_t nb = std::max<size_t>(B_BLOCK_BYTES / (4 * K4) / 16 * 16, 16);
+    for (size_t n0 = 0; n0 < N; n0 += nb) {
+        size_t n1 = std::min(N, n0 + nb);
+        for (size_t m = 0; m < M; m += MR) {
+            size_t rows = std::min(MR, M - m);
+            gemm_s8_rows_kerns[rows - 1](
+                    A + m * LDA, LDA, packB, N, C + m * LDC, LDC, n0, n1, K);
+        }
+    }
+}
+
+#endif
+
+// vim: syntax=cpp.doxygen
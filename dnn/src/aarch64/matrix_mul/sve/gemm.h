@@ -0,0 +1,36 @@
+#pragma once
+
+#include "src/common/utils.h"
+
+#if MGB_ENABLE_SVE
+namespace megdnn {
+namespace aarch64 {
+namespace matmul {
+
+/*!
+ * The gemm here are vector length agnostic: the kernels compute 8 rows of C
+ * and two sve vectors of columns at a time, so the block width is decided by
+ * svcntw() at runtime and no GemmInterleaved strategy with a fixed block
+ * could be registered. They should only be called when cpu_has_sve() is true.
+ */
+
+//! C = A * B, with A, B and C all in row major
+void sgemm_sve(
+        const float* A, size_t LDA, const float* B, size_t LDB, float* C, size_t LDC,
+        size_t M, size_t N, size_t K);
+
+//! workspace of gemm_s8s8s32_sve, which holds the packed B
+size_t gemm_s8s8s32_sve_workspace(size_t N, size_t K);
+
+//! C = A * B, with A and C in row major, B is given by its transpose if trB is
+//! true
+void gemm_s8s8s32_sve(
+        const dt_int8* A, size_t LDA, const dt_int8* B, size_t LDB, dt_int32* C,
+        size_t LDC, size_t M, size_t N, size_t K, bool trB, void* workspace);
+
+}  // namespace matmul
+}  // namespace aarch64
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -6,6 +6,7 @@
 #include "src/arm_common/conv_bias/int8/stride2.h"
 #include "src/arm_common/conv_bias/int8/stride2_dotprod.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/utils.h"
 #include "src/fallback/conv_bias/common.h"
 
 #include "midout.h"
@@ -156,7 +157,7 @@ SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoS8DirectStride2::dispatch_k
 /* ===================== dot stride1 algo ======================== */
 bool ConvBiasImpl::AlgoDotS8DirectStride1::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return direct_dotprod_int8_stride1::can_conv_direct_stride1_int8(param);
@@ -190,7 +191,7 @@ SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoDotS8DirectStride1::dispatc
 /* ===================== dot stride2 algo ======================== */
 bool ConvBiasImpl::AlgoDotS8DirectStride2::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return direct_dotprod_int8_stride2::can_conv_direct_stride2_int8(param);
@@ -306,6 +307,48 @@ MEGDNN_WINOGRAD_ALGO_FUN_DEFINE_ALL(
         AlgoS8CF32WinogradF23_4x4_NCHW44, winograd::winograd_2x3_4x4_s8_f32_nchw44,
         megdnn_arm_common_conv_bias_int8, param::MatrixMul::Format::MK4);
 
+bool ConvBiasImpl::AlgoS8CF32WinogradF43_4x4_NCHW44::usable(
+        const NCBKernSizeParam& param,
+        AlgoSelectionStrategy /*algo_selection_strategy*/) const {
+    MEGDNN_MARK_USED_VAR(param);
+    MIDOUT_BEGIN(
+            megdnn_arm_common_conv_bias_int8,
+            midout_iv("arm_common_AlgoS8CF32WinogradF43_4x4::usable"_hash)) {
+        if (param.filter_meta.icpg % 4 != 0 || param.filter_meta.ocpg % 4 != 0)
+            return false;
+        bool is_matmul_usable = false;
+
+        using Strategy = winograd::winograd_4x3_4x4_s8_f32_nchw44;
+        using PackMode = fallback::MatrixMulImpl::AlgoBase::PackMode;
+        Strategy strategy(param.src_type, param.filter_type, param.dst_type);
+        is_matmul_usable = m_matmul_algo->usable(
+                megdnn::winograd::ConvBias<Strategy, param::MatrixMul::Format::MK4>(
+                        strategy, m_tile_size, param)
+                        .get_matmul_kern_param(param));
+        return is_matmul_usable && m_matmul_algo->packmode() == PackMode::NO_PACK &&
+               (param.filter_meta.format == param::ConvBias::Format::NCHW44 &&
+                param.filter_type.enumv() == DTypeEnum::QuantizedS8) &&
+               !param.filter_meta.should_flip &&
+               (param.filter_meta.spatial[0] == param.filter_meta.spatial[1] &&
+                param.filter_meta.spatial[0] == 3) &&
+               (param.filter_meta.stride[0] == param.filter_meta.stride[1] &&
+                param.filter_meta.stride[0] == 1) &&
+               (param.filter_meta.dilation[0] == param.filter_meta.dilation[1] &&
+                param.filter_meta.dilation[0] == 1) &&
+               (param.compute_mode == param::ConvBias::ComputeMode::FLOAT32 ||
+                param.compute_mode == param::ConvBias::ComputeMode::DEFAULT) &&
+               param.src_type.enumv() == DTypeEnum::QuantizedS8 &&
+               param.bias_type.enumv() == DTypeEnum::QuantizedS32 &&
+               param.dst_type.enumv() == DTypeEnum::QuantizedS8;
+    }
+    MIDOUT_END();
+    return false;
+}
+
+MEGDNN_WINOGRAD_ALGO_FUN_DEFINE_ALL(
+        AlgoS8CF32WinogradF43_4x4_NCHW44, winograd::winograd_4x3_4x4_s8_f32_nchw44,
+        megdnn_arm_common_conv_bias_int8, param::MatrixMul::Format::MK4);
+
 /* ======================= AlgoS8WinogradF23_8x8_NCHW44 ======================== */
 bool ConvBiasImpl::AlgoS8WinogradF23_8x8_NCHW44::usable(
         const NCBKernSizeParam& param,
@@ -249,6 +249,24 @@ public:
     MEGDNN_DECL_ALGO_TYPE(ARM_COMMON_WINOGRAD_F23_8X8_NCHW44_S8CF32)
 };
 
+class ConvBiasImpl::AlgoS8CF32WinogradF43_4x4_NCHW44 final : public AlgoBase {
+public:
+    AlgoS8CF32WinogradF43_4x4_NCHW44(
+            fallback::MatrixMulImpl::AlgoBase* matmul_algo, uint32_t tile_size)
+            : m_matmul_algo{matmul_algo}, m_tile_size{tile_size} {}
+    const char* name() const override {
+        if (m_name.empty()) {
+            m_name = ConvBiasImpl::algo_name<ConvBias::WinogradParam>(
+                    m_matmul_algo->name(), {4, 4, m_tile_size, 3},
+                    param::ConvBias::Format::NCHW44);
+        }
+        return m_name.c_str();
+    }
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    MEGDNN_WINOGRAD_ALGO_FUN_DECLARE(AlgoDataType::QINT8X8X32);
+    MEGDNN_DECL_ALGO_TYPE(ARM_COMMON_WINOGRAD_F43_4X4_NCHW44_S8CF32)
+};
+
 //=======================input int8 compute int16 output int8============
 class ConvBiasImpl::AlgoS8WinogradF23_8x8_NCHW44 final : public AlgoBase {
 public:
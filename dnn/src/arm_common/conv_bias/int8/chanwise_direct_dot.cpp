@@ -1,6 +1,7 @@
 #include <arm_neon.h>
 #include "src/arm_common/conv_bias/int8/algos.h"
 #include "src/arm_common/conv_bias/int8/direct_kernels/dot_direct_nchw_large.h"
+#include "src/arm_common/utils.h"
 #include "src/common/unroll_macro.h"
 #if MGB_ENABLE_DOT
 #include "midout.h"
@@ -192,7 +193,7 @@ void do_conv(
 
 bool ConvBiasImpl::AlgoDotS8DirectChanWiseLarge::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     auto&& fm = param.filter_meta;
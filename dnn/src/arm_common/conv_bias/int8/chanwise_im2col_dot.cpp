@@ -4,6 +4,7 @@
 
 #include "src/arm_common/conv_bias/int8/algos.h"
 #include "src/arm_common/matrix_mul/int8/gemv.h"
+#include "src/arm_common/utils.h"
 
 #include "midout.h"
 
@@ -347,7 +348,7 @@ void do_conv(
 
 bool ConvBiasImpl::AlgoDotS8Im2colChanWiseLarge::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     auto&& fm = param.filter_meta;
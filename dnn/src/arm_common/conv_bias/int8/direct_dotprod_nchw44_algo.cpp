@@ -3,6 +3,7 @@
 #include "src/arm_common/conv_bias/int8/algos.h"
 #include "src/arm_common/conv_bias/int8/direct_dotprod_nchw44.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/utils.h"
 
 #include "midout.h"
 
@@ -142,7 +143,7 @@ static void conv_kern(
 bool ConvBiasImpl::AlgoDotS8Direct_NCHW44::usable(
         const NCBKernSizeParam& param,
         AlgoSelectionStrategy algo_selection_strategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     MEGDNN_MARK_USED_VAR(algo_selection_strategy);
@@ -15,6 +15,7 @@
 #include "src/arm_common/conv_bias/int8/algos.h"
 #include "src/arm_common/conv_bias/int8/dot_direct_nchw_nchw44_kern.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/utils.h"
 #include "src/common/nchw_nchwxx_valid.h"
 #include "src/fallback/conv_bias/gi/block_helper.h"
 
@@ -169,7 +170,7 @@ static void do_conv_kern(
 
 bool ConvBiasImpl::AlgoDotS8DirectNCHWNCHW44::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return nchw_nchwxx_valid<NchwNchwxxType::NCHW44_INT8_DOT>(
@@ -120,6 +120,35 @@ struct ConvBiasMatmul<bmode, Op, dt_int8, block_m, 12, m, 12> {
     }
 };
 
+template <BiasMode bmode, typename Op, int block_m, int m>
+struct ConvBiasMatmul<bmode, Op, dt_int8, block_m, 8, m, 8> {
+    static void postprocess(
+            const dt_int32* bias, const dt_int32* workspace, dt_int8* C, size_t LDC,
+            const Op& op) {
+        static_assert(m > 0 && m <= block_m, "invalid m or n");
+        int32x4_t vbias0, vwp0, vwp1;
+        if (bmode != BiasMode::BROADCAST_CHANNEL_BIAS) {
+            vbias0 = QConverterBase::vzero();
+        }
+        for (int i = 0; i < m; i++) {
+            if (bmode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+                vbias0 = vdupq_n_s32(*bias);
+            }
+            vwp0 = vld1q_s32(workspace);
+            vwp1 = vld1q_s32(workspace + 4);
+
+            int8x8_t vres;
+            vres = Process<Op, dt_qint8, int8x8_t>::run(
+                    {{vwp0, vwp1}}, {{vbias0, vbias0}}, op);
+            vst1_s8(C, vres);
+
+            bias++;
+            C += LDC;
+            workspace += 8;
+        }
+    }
+};
+
 template <BiasMode bmode, typename Op, int block_m, int m, int n>
 struct ConvBiasMatmul<bmode, Op, dt_int8, block_m, 4, m, n> {
     static void postprocess(
@@ -134,6 +134,10 @@ public:
                         static_cast<fallback::MatrixMulImpl::AlgoBase*>(algo),
                         tile_size));
                 m_winograd_algos.emplace_back(refhold.back().get());
+                refhold.emplace_back(new AlgoS8CF32WinogradF43_4x4_NCHW44(
+                        static_cast<fallback::MatrixMulImpl::AlgoBase*>(algo),
+                        tile_size));
+                m_winograd_algos.emplace_back(refhold.back().get());
             }
         }
 
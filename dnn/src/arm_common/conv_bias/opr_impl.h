@@ -67,6 +67,7 @@ private:
     class AlgoI8x8x16DirectNCHWNCHW44;
     class AlgoS8WinogradF23_8x8;
     class AlgoS8CF32WinogradF23_4x4_NCHW44;
+    class AlgoS8CF32WinogradF43_4x4_NCHW44;
     class AlgoS8WinogradF23_8x8_NCHW44;
 #if __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
     class AlgoF16Direct;
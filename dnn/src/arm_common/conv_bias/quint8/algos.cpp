@@ -4,6 +4,7 @@
 #include "src/arm_common/conv_bias/quint8/stride2.h"
 #include "src/arm_common/conv_bias/quint8/stride2_dotprod.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/utils.h"
 #include "src/fallback/conv_bias/common.h"
 
 #include "midout.h"
@@ -78,7 +79,7 @@ SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoQU8DirectStride2::dispatch_
 /* ===================== stride1 algo ===================== */
 bool ConvBiasImpl::AlgoDotU8DirectStride1::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return direct_dotprod_quint8_stride1::can_conv_direct_stride1_quint8(param);
@@ -112,7 +113,7 @@ SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoDotU8DirectStride1::dispatc
 /* ===================== stride2 algo ===================== */
 bool ConvBiasImpl::AlgoDotU8DirectStride2::usable(
         const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return direct_dotprod_quint8_stride2::can_conv_direct_stride2_quint8(param);
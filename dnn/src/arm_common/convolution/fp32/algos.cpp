@@ -0,0 +1,46 @@
+#include "src/arm_common/convolution/fp32/algos.h"
+#include "src/arm_common/convolution/fp32/conv_backdata_nchw44.h"
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_arm_conv_f32_kimpl)
+
+using namespace megdnn;
+using namespace arm_common;
+
+/* ===================== ConvolutionBackwardData  ===================== */
+/* ===================== direct nchw44 algo ===================== */
+bool ConvolutionBackwardDataImpl::AlgoF32DirectNCHW44::usable(
+        fallback::ConvolutionBackwardDataImpl*, const NCBKernSizeParam& param) const {
+    return deconv::can_direct_nchw44_fp32(param);
+}
+
+size_t ConvolutionBackwardDataImpl::AlgoF32DirectNCHW44::get_workspace(
+        fallback::ConvolutionBackwardDataImpl*, const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            megdnn_arm_conv_f32_kimpl,
+            midout_iv("AlgoF32DirectNCHW44::get_workspace"_hash)) {
+        return deconv::get_workspace_in_bytes_direct_nchw44_fp32(param);
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+ConvolutionBackwardDataImpl::ncb_kern_t ConvolutionBackwardDataImpl::
+        AlgoF32DirectNCHW44::dispatch_kern(
+                fallback::ConvolutionBackwardDataImpl*, const NCBKernSizeParam&) const {
+    MIDOUT_BEGIN(
+            megdnn_arm_conv_f32_kimpl,
+            midout_iv("AlgoF32DirectNCHW44::dispatch_kern"_hash)) {
+        return deconv::direct_nchw44_fp32;
+    }
+    MIDOUT_END();
+    return {};
+}
+
+bool ConvolutionBackwardDataImpl::AlgoF32DirectNCHW44::is_preferred(
+        const NCBKernSizeParam& param) const {
+    return param.filter_meta.stride[0] == 2 && param.filter_meta.stride[1] == 2;
+}
+
+// vim: syntax=cpp.doxygen
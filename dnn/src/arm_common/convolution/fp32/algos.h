@@ -0,0 +1,35 @@
+#pragma once
+
+#include "src/arm_common/convolution/opr_impl.h"
+
+namespace megdnn {
+namespace arm_common {
+
+/* ===================== ConvolutionBackwardData ===================== */
+
+class ConvolutionBackwardDataImpl::AlgoF32DirectNCHW44 final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "ARM_COMMON_F32_DECONV_NCHW44_DIRECT"; }
+
+    bool usable(fallback::ConvolutionBackwardDataImpl*, const NCBKernSizeParam& param)
+            const override;
+
+    size_t get_workspace(
+            fallback::ConvolutionBackwardDataImpl*,
+            const NCBKernSizeParam& param) const override;
+
+    ncb_kern_t dispatch_kern(
+            fallback::ConvolutionBackwardDataImpl*,
+            const NCBKernSizeParam&) const override;
+
+    //! stride 2 deconvs do not pay for the col2im buffer of the matmul algo
+    bool is_preferred(const NCBKernSizeParam& param) const override;
+    bool is_batch_parallel() const override { return true; }
+    MEGDNN_DECL_ALGO_TYPE(ARM_COMMON_DIRECT_NCHW44_F32)
+};
+
+}  // namespace arm_common
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,216 @@
+#include "src/arm_common/convolution/fp32/conv_backdata_nchw44.h"
+#include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/common/utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace megdnn;
+using namespace arm_common;
+using namespace deconv;
+
+namespace {
+
+constexpr size_t PACK = 4;
+
+/*!
+ * \brief relayout the filter from (OC/4, IC/4, FH, FW, 4ic, 4oc) to
+ * (IC/4, FH, FW, OC/4, 4oc, 4ic), flipped if needed
+ *
+ * So a tap of an ic block is contiguous over OC, and column oc of a 4x4 block
+ * is a vector over the 4 ics.
+ */
+void pack_filter(const NCBKernParam& param, float* dst) {
+    auto&& fm = param.filter_meta;
+    size_t IC = fm.icpg, OC = fm.ocpg, FH = fm.spatial[0], FW = fm.spatial[1];
+    const float* filter = param.filter<float>();
+    for (size_t ocb = 0; ocb < OC / PACK; ++ocb) {
+        for (size_t icb = 0; icb < IC / PACK; ++icb) {
+            for (size_t fh = 0; fh < FH; ++fh) {
+                for (size_t fw = 0; fw < FW; ++fw) {
+                    size_t dh = fm.should_flip ? FH - 1 - fh : fh,
+                           dw = fm.should_flip ? FW - 1 - fw : fw;
+                    const float* src = filter +
+                                       (((ocb * IC / PACK + icb) * FH + fh) * FW + fw) *
+                                               PACK * PACK;
+                    float* out =
+                            dst + (((icb * FH + dh) * FW + dw) * OC / PACK + ocb) *
+                                          PACK * PACK;
+                    for (size_t ic = 0; ic < PACK; ++ic) {
+                        for (size_t oc = 0; oc < PACK; ++oc) {
+                            out[oc * PACK + ic] = src[ic * PACK + oc];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#define FMA_OC(_acc, _d)                         \
+    _acc = vfmaq_laneq_f32(_acc, w0, _d, 0);     \
+    _acc = vfmaq_laneq_f32(_acc, w1, _d, 1);     \
+    _acc = vfmaq_laneq_f32(_acc, w2, _d, 2);     \
+    _acc = vfmaq_laneq_f32(_acc, w3, _d, 3);
+
+/*!
+ * \brief accumulate a tap into the pixels [lo, hi) of a grad phase row
+ *
+ * \param out the grad pixel 0 of the phase row, \p out_step floats apart
+ * \param diff the diff pixel read by grad pixel 0 of the phase row, in the
+ *      first oc block
+ * \param weight the transposed 4x4 blocks of the tap over the oc blocks
+ */
+void accumulate_tap(
+        float* out, size_t out_step, const float* diff, size_t diff_ocb_step,
+        const float* weight, size_t nr_ocb, size_t lo, size_t hi) {
+    size_t i = lo;
+    for (; i + 4 <= hi; i += 4) {
+        float* o = out + i * out_step;
+        float32x4_t acc0 = vld1q_f32(o);
+        float32x4_t acc1 = vld1q_f32(o + out_step);
+        float32x4_t acc2 = vld1q_f32(o + 2 * out_step);
+        float32x4_t acc3 = vld1q_f32(o + 3 * out_step);
+        const float* d = diff + i * PACK;
+        const float* w = weight;
+        for (size_t ocb = 0; ocb < nr_ocb; ++ocb) {
+            float32x4_t w0 = vld1q_f32(w);
+            float32x4_t w1 = vld1q_f32(w + 4);
+            float32x4_t w2 = vld1q_f32(w + 8);
+            float32x4_t w3 = vld1q_f32(w + 12);
+            float32x4_t d0 = vld1q_f32(d);
+            float32x4_t d1 = vld1q_f32(d + 4);
+            float32x4_t d2 = vld1q_f32(d + 8);
+            float32x4_t d3 = vld1q_f32(d + 12);
+            FMA_OC(acc0, d0);
+            FMA_OC(acc1, d1);
+            FMA_OC(acc2, d2);
+            FMA_OC(acc3, d3);
+            d += diff_ocb_step;
+            w += PACK * PACK;
+        }
+        vst1q_f32(o, acc0);
+        vst1q_f32(o + out_step, acc1);
+        vst1q_f32(o + 2 * out_step, acc2);
+        vst1q_f32(o + 3 * out_step, acc3);
+    }
+    for (; i < hi; ++i) {
+        float* o = out + i * out_step;
+        float32x4_t acc = vld1q_f32(o);
+        const float* d = diff + i * PACK;
+        const float* w = weight;
+        for (size_t ocb = 0; ocb < nr_ocb; ++ocb) {
+            float32x4_t w0 = vld1q_f32(w);
+            float32x4_t w1 = vld1q_f32(w + 4);
+            float32x4_t w2 = vld1q_f32(w + 8);
+            float32x4_t w3 = vld1q_f32(w + 12);
+            float32x4_t d0 = vld1q_f32(d);
+            FMA_OC(acc, d0);
+            d += diff_ocb_step;
+            w += PACK * PACK;
+        }
+        vst1q_f32(o, acc);
+    }
+}
+#undef FMA_OC
+
+//! the offset of the diff index from the grad index in a phase, or false if
+//! the tap does not hit the phase
+bool get_tap_offset(
+        ptrdiff_t phase, ptrdiff_t pad, ptrdiff_t tap, ptrdiff_t stride,
+        ptrdiff_t& offset) {
+    ptrdiff_t t = phase + pad - tap;
+    if (t % stride != 0) {
+        return false;
+    }
+    offset = t / stride;
+    return true;
+}
+
+//! the range of [lo, hi) of the phase index whose diff index
+//! (phase index + offset) lies in [0, size)
+void get_valid_range(
+        ptrdiff_t offset, size_t size, size_t len, size_t& lo, size_t& hi) {
+    ptrdiff_t l = std::max<ptrdiff_t>(0, -offset),
+              h = std::min<ptrdiff_t>(len, static_cast<ptrdiff_t>(size) - offset);
+    lo = l;
+    hi = std::max(l, h);
+}
+
+}  // namespace
+
+bool deconv::can_direct_nchw44_fp32(const NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return fm.format == param::Convolution::Format::NCHW44 &&
+           param.diff_type.enumv() == DTypeEnum::Float32 &&
+           param.filter_type.enumv() == DTypeEnum::Float32 &&
+           param.grad_type.enumv() == DTypeEnum::Float32 && fm.spatial_ndim == 2 &&
+           fm.group == 1 && fm.icpg % PACK == 0 && fm.ocpg % PACK == 0 &&
+           fm.stride[0] <= 2 && fm.stride[1] <= 2 && fm.spatial[0] <= 7 &&
+           fm.spatial[1] <= 7 && param.diff_layout.is_contiguous() &&
+           param.grad_layout.is_contiguous();
+}
+
+size_t deconv::get_workspace_in_bytes_direct_nchw44_fp32(
+        const NCBKernSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    return fm.icpg * fm.ocpg * fm.spatial[0] * fm.spatial[1] * sizeof(float);
+}
+
+void deconv::direct_nchw44_fp32(const NCBKernParam& param) {
+    UNPACK_CONV_F32_NCB_KERN_SIZES(param);
+    auto&& fm = param.filter_meta;
+    size_t DH = fm.dilation[0], DW = fm.dilation[1];
+    float* packed = static_cast<float*>(param.workspace_ptr);
+    pack_filter(param, packed);
+
+    size_t nr_ocb = OC / PACK, diff_ocb_step = IH * IW * PACK;
+    for (size_t n = 0; n < N; ++n) {
+        const float* diff = param.diff<float>() + n * param.inp_bs;
+        float* grad = param.grad<float>() + n * param.out_bs;
+        std::memset(grad, 0, IC * OH * OW * sizeof(float));
+        for (size_t icb = 0; icb < IC / PACK; ++icb) {
+            float* grad_icb = grad + icb * OH * OW * PACK;
+            const float* weight_icb = packed + icb * FH * FW * OC * PACK;
+            for (size_t rh = 0; rh < std::min<size_t>(SH, OH); ++rh) {
+                for (size_t rw = 0; rw < std::min<size_t>(SW, OW); ++rw) {
+                    //! number of rows and columns of the phase
+                    size_t PHH = div_ceil<size_t>(OH - rh, SH),
+                           PHW = div_ceil<size_t>(OW - rw, SW);
+                    for (size_t fh = 0; fh < FH; ++fh) {
+                        ptrdiff_t off_h;
+                        if (!get_tap_offset(rh, PH, fh * DH, SH, off_h)) {
+                            continue;
+                        }
+                        size_t jlo, jhi;
+                        get_valid_range(off_h, IH, PHH, jlo, jhi);
+                        for (size_t fw = 0; fw < FW; ++fw) {
+                            ptrdiff_t off_w;
+                            if (!get_tap_offset(rw, PW, fw * DW, SW, off_w)) {
+                                continue;
+                            }
+                            size_t ilo, ihi;
+                            get_valid_range(off_w, IW, PHW, ilo, ihi);
+                            const float* weight =
+                                    weight_icb + (fh * FW + fw) * OC * PACK;
+                            for (size_t j = jlo; j < jhi; ++j) {
+                                size_t oh = rh + j * SH, ih = j + off_h;
+                                //! diff pixel read by phase column 0, which
+                                //! may be out of the row but is never read
+                                const float* diff_row =
+                                        diff + (static_cast<ptrdiff_t>(ih * IW) +
+                                                off_w) * static_cast<ptrdiff_t>(PACK);
+                                accumulate_tap(
+                                        grad_icb + (oh * OW + rw) * PACK, SW * PACK,
+                                        diff_row, diff_ocb_step, weight, nr_ocb, ilo,
+                                        ihi);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "src/arm_common/convolution/opr_impl.h"
+
+#include <cstddef>
+
+namespace megdnn {
+namespace arm_common {
+namespace deconv {
+
+using NCBKernSizeParam = ConvolutionBackwardDataImpl::NCBKernSizeParam;
+using NCBKernParam = ConvolutionBackwardDataImpl::NCBKernParam;
+
+bool can_direct_nchw44_fp32(const NCBKernSizeParam& param);
+
+/*!
+ * \brief fp32 NCHW44 deconv that writes grad directly
+ *
+ * The grad is split into SH * SW phases by (oh % SH, ow % SW). The filter taps
+ * hitting a phase are fixed, and the diff pixel a tap reads moves by one when
+ * the grad pixel moves by the stride, so each phase is a dense stride 1 gather
+ * from diff and no col2im buffer is needed. The workspace only holds the
+ * filter with its 4x4 blocks transposed.
+ */
+void direct_nchw44_fp32(const NCBKernParam& param);
+
+size_t get_workspace_in_bytes_direct_nchw44_fp32(const NCBKernSizeParam& param);
+
+}  // namespace deconv
+}  // namespace arm_common
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
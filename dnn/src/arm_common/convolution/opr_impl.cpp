@@ -1,4 +1,5 @@
 #include "./opr_impl.h"
+#include "./fp32/algos.h"
 #include "./int8x8x32/algos.h"
 #include "./quint8/algos.h"
 
@@ -12,6 +13,7 @@ using namespace arm_common;
 
 /* ===================== ConvolutionBackwardData ===================== */
 class ConvolutionBackwardDataImpl::AlgoPack : NonCopyableObj {
+    AlgoF32DirectNCHW44 f32_direct_nchw44;
 #if MGB_ENABLE_DOT
     AlgoSdot8DirectStride1 i8x8x32_direct_stride1_sdot;
     AlgoSdot8DirectStride2 i8x8x32_direct_stride2_sdot;
@@ -24,6 +26,7 @@ class ConvolutionBackwardDataImpl::AlgoPack : NonCopyableObj {
 
 public:
     AlgoPack() {
+        m_all_algos.emplace_back(&f32_direct_nchw44);
 #if MGB_ENABLE_DOT
         m_all_algos.emplace_back(&i8x8x32_direct_stride1_sdot);
         m_all_algos.emplace_back(&i8x8x32_direct_stride2_sdot);
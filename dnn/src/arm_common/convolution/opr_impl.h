@@ -47,6 +47,7 @@ public:
     MEGDNN_FB_DECL_GET_ALGO_FROM_DESC(ConvolutionBackwardDataImpl);
 
 private:
+    class AlgoF32DirectNCHW44;
 #if MGB_ENABLE_DOT
     class AlgoSdot8DirectStride1;
     class AlgoSdot8DirectStride2;
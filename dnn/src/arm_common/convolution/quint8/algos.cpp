@@ -2,6 +2,7 @@
 #include "src/arm_common/convolution/img2col_helper.h"
 #include "src/arm_common/convolution/quint8/conv_backdata_stride1.h"
 #include "src/arm_common/convolution/quint8/conv_backdata_stride2.h"
+#include "src/arm_common/utils.h"
 #include "src/common/opr_delegate.h"
 
 #include "midout.h"
@@ -18,7 +19,7 @@ using namespace arm_common;
 /* ===================== direct stride 1 algo ===================== */
 bool ConvolutionBackwardDataImpl::AlgoUdot8DirectStride1::usable(
         fallback::ConvolutionBackwardDataImpl*, const NCBKernSizeParam& param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return deconv::can_stride1_quint8_dot(param);
@@ -50,7 +51,7 @@ ConvolutionBackwardDataImpl::ncb_kern_t ConvolutionBackwardDataImpl::
 /* ===================== direct stride 2 algo ===================== */
 bool ConvolutionBackwardDataImpl::AlgoUdot8DirectStride2::usable(
         fallback::ConvolutionBackwardDataImpl*, const NCBKernSizeParam& param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return deconv::can_stride2_quint8_dot(param);
@@ -1,5 +1,7 @@
 #include "src/arm_common/elemwise/binary/algo.h"
 #include "src/arm_common/elemwise_helper/elemwise_op.h"
+#include "src/arm_common/sve/kernels.h"
+#include "src/arm_common/utils.h"
 
 #include "src/common/utils.h"
 #include "src/naive/handle.h"
@@ -561,4 +563,55 @@ void ElemwiseImpl::AlgoBinaryVecBcast101xX::exec(const KernParam& kern_param) co
 #undef DISPATCH_MODE_FLOAT
 #undef DISPATCH_MODE_INT
 
+#if MGB_ENABLE_SVE
+bool ElemwiseImpl::AlgoBinarySVE::is_available(const KernParam& kern_param) const {
+    auto type = kern_param.broad_cast_type;
+    if (!cpu_has_sve() || !sve::binary_mode_supported(kern_param.mode) ||
+        (BcastType::VEC_VEC != type && BcastType::VEC_SCALAR != type &&
+         BcastType::SCALAR_VEC != type))
+        return false;
+
+    auto& elparam = kern_param.binary_elparam;
+    return elparam[0].layout.dtype == dtype::Float32() &&
+           elparam[1].layout.dtype == dtype::Float32() &&
+           kern_param.m_dst->layout.dtype == dtype::Float32();
+}
+
+void ElemwiseImpl::AlgoBinarySVE::exec(const KernParam& kern_param) const {
+    auto& elparam = kern_param.binary_elparam;
+    auto &src0 = elparam[0], &src1 = elparam[1];
+    auto&& dst = *(kern_param.m_dst);
+    auto mode = kern_param.mode;
+    auto handle = static_cast<naive::HandleImpl*>(kern_param.handle);
+    const float* sptr0 = static_cast<const float*>(src0.raw_ptr());
+    const float* sptr1 = static_cast<const float*>(src1.raw_ptr());
+    float* dptr = static_cast<float*>(dst.raw_ptr());
+    size_t nr_elems = dst.layout.total_nr_elems();
+
+    MIDOUT_BEGIN(
+            megdnn_arm_common_elemwise_binary, midout_iv("AlgoBinarySVE::exec"_hash)) {
+        switch (kern_param.broad_cast_type) {
+            case BcastType::VEC_VEC:
+                MEGDNN_DISPATCH_CPU_KERN(
+                        handle,
+                        sve::binary_vec_vec_f32(mode, sptr0, sptr1, dptr, nr_elems));
+                return;
+            case BcastType::VEC_SCALAR:
+                MEGDNN_DISPATCH_CPU_KERN(
+                        handle, sve::binary_vec_scalar_f32(
+                                        mode, sptr0, sptr1[0], dptr, nr_elems, false));
+                return;
+            case BcastType::SCALAR_VEC:
+                MEGDNN_DISPATCH_CPU_KERN(
+                        handle, sve::binary_vec_scalar_f32(
+                                        mode, sptr1, sptr0[0], dptr, nr_elems, true));
+                return;
+            default:
+                megdnn_throw("unsupported broadcast type for sve binary algo");
+        }
+    }
+    MIDOUT_END();
+}
+#endif
+
 // vim: syntax=cpp.doxygen
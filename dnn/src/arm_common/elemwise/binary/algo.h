@@ -25,6 +25,10 @@ DECL_CB(VecBcast101);
 DECL_CB(VecBcastX0X);
 DECL_CB(VecBcast111C);
 DECL_CB(VecBcast101xX);
+#if MGB_ENABLE_SVE
+//! fp32 vec-vec and vec-scalar cases with the vector length agnostic kernels
+DECL_CB(SVE);
+#endif
 #undef DECL_CB
 }  // namespace arm_common
 }  // namespace megdnn
@@ -12,6 +12,9 @@ using namespace megdnn;
 using namespace arm_common;
 
 class ElemwiseImpl::AlgoPack {
+#if MGB_ENABLE_SVE
+    AlgoBinarySVE algo_binary_sve;
+#endif
     AlgoUnary algo_unary;
     AlgoBinaryVecVec algo_binary_vec_vec;
     AlgoBinaryVecScalar algo_binary_vec_sca;
@@ -32,6 +35,9 @@ class ElemwiseImpl::AlgoPack {
 
 public:
     AlgoPack() {
+#if MGB_ENABLE_SVE
+        all_algos.emplace_back(&algo_binary_sve);
+#endif
         all_algos.emplace_back(&algo_unary);
         all_algos.emplace_back(&algo_binary_vec_vec);
         all_algos.emplace_back(&algo_binary_vec_sca);
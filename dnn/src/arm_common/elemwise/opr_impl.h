@@ -20,6 +20,9 @@ private:
     class AlgoBinaryVecBcastX0X;
     class AlgoBinaryVecBcast111C;
     class AlgoBinaryVecBcast101xX;
+#if MGB_ENABLE_SVE
+    class AlgoBinarySVE;
+#endif
     class AlgoTernaryFma3VecVecVec;
     class AlgoTernaryFma3VecVecScalar;
     class AlgoTernaryFma3Bcast101VecBcast101;
@@ -1,4 +1,5 @@
 #pragma once
+#include "src/arm_common/utils.h"
 #include "src/fallback/handle.h"
 #if MGB_ENABLE_CPUINFO
 #include "cpuinfo.h"
@@ -16,6 +17,11 @@ public:
 #if MGB_ENABLE_CPUINFO
         cpuinfo_initialize();
 #endif
+        auto detected = detect_cpu_isa_level();
+        init_cpu_isa_level(detected);
+        if (cpu_isa_level() < detected) {
+            limit_cpu_features(cpu_isa_level());
+        }
     }
 
     template <typename Opr>
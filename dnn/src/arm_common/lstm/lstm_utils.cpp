@@ -60,37 +60,4 @@ TensorNDArray megdnn::arm_common::split_tensor(
     return tensors;
 }
 
-namespace megdnn {
-namespace arm_common {
-
-template <>
-void cell_opr_compute<LSTMCell, LstmStates>(
-        _megdnn_tensor_in input, _megdnn_tensor_in weight_ih,
-        _megdnn_tensor_in weight_hh, _megdnn_tensor_in bias_ih,
-        _megdnn_tensor_in bias_hh, const LstmStates& state_in, LstmStates& state_out,
-        Workspace cell_workspace, Handle* handle) {
-    auto opr = handle->create_operator<LSTMCellForward>();
-    TensorLayout gates, h_new, c_new;
-    opr->deduce_layout(
-            input.layout, weight_ih.layout, bias_ih.layout, state_in.m_h.layout,
-            weight_hh.layout, bias_hh.layout, state_in.m_c.layout, h_new, c_new, gates);
-
-    auto workspace_bundle = LstmCellCompute::get_workspace_bundle(
-            input.layout, weight_ih.layout, bias_ih.layout, state_in.m_h.layout,
-            weight_hh.layout, bias_hh.layout, state_in.m_c.layout, h_new, c_new, gates);
-
-    workspace_bundle.set(cell_workspace.raw_ptr);
-
-    TensorND gates_tensor{workspace_bundle.get(0), gates};
-    _megdnn_workspace new_workspace = {
-            static_cast<dt_byte*>(workspace_bundle.get(1)),
-            workspace_bundle.get_size(1)};
-
-    LstmCellCompute::run(
-            input, weight_ih, bias_ih, state_in.m_h, weight_hh, bias_hh, state_in.m_c,
-            state_out.m_h, state_out.m_c, gates_tensor, new_workspace, handle);
-}
-}  // namespace arm_common
-}  // namespace megdnn
-
 // vim: syntax=cpp.doxygen
@@ -9,13 +9,6 @@
 namespace megdnn {
 namespace arm_common {
 
-template <class CellOp, class States>
-void cell_opr_compute(
-        _megdnn_tensor_in step_input, _megdnn_tensor_in weight_ih,
-        _megdnn_tensor_in weight_hh, _megdnn_tensor_in bias_ih,
-        _megdnn_tensor_in bias_hh, const States& state_in, States& state_out,
-        Workspace cell_workspace, Handle* handle);
-
 struct LstmCellWeight {
     size_t m_weight_size = 0;
 
@@ -86,11 +79,10 @@ void exec_kernel(
             states_in.size() == num_layers * dir_size);
     megdnn_assert(outputs.size() == inputs.size());
     //! two tmp state workspace
-    megdnn_assert(workspace_bundle.nr_workspace() == 4 + States::nr_states());
+    megdnn_assert(workspace_bundle.nr_workspace() == 5 + States::nr_states());
 
     size_t seq_len = inputs.size();
     size_t batch_size = inputs[0].layout.shape[0];
-    size_t input_size = inputs[0].layout.shape[1];
     size_t hidden_size = cells[0].m_weight_hh.layout.shape[1];
 
     TensorLayout batch_output_layout{
@@ -99,17 +91,25 @@ void exec_kernel(
             {batch_size, hidden_size}, outputs[0].layout.dtype};  // output hy
     TensorLayout seq_output_layout{
             {batch_size, dir_size * hidden_size}, outputs[0].layout.dtype};
-    TensorLayout cell_first_input_layout{
-            {batch_size, input_size}, inputs[0].layout.dtype};  // input
     TensorLayout cell_input_layout{
             {batch_size, dir_size * hidden_size}, inputs[0].layout.dtype};
     TensorLayout tmp_output_layout{
             {seq_len, batch_size, dir_size * hidden_size}, outputs[0].layout.dtype};
+    size_t gate_hidden_size = cells[0].m_weight_hh.layout.shape[0];
+    TensorLayout gates_layout{
+            {batch_size, gate_hidden_size}, outputs[0].layout.dtype};
 
     //! workspace get
-    Workspace cell_workspace(
-            static_cast<dt_byte*>(workspace_bundle.get(0)),
-            workspace_bundle.get_size(0) + workspace_bundle.get_size(1));
+    TensorND gates{workspace_bundle.get(0), gates_layout};
+    Workspace matmul_workspace(
+            static_cast<dt_byte*>(workspace_bundle.get(1)),
+            workspace_bundle.get_size(1));
+    //! the input projections of all the timesteps of a cell
+    TensorND input_proj{
+            workspace_bundle.get(4),
+            TensorLayout{
+                    {seq_len * batch_size, gate_hidden_size}, outputs[0].layout.dtype}};
+    auto&& step_input_projs = split_tensor(input_proj, seq_len, gates_layout);
     auto&& tmp_inputs_1 = split_tensor(
             TensorND{workspace_bundle.get(2), tmp_output_layout}, seq_len,
             cell_input_layout);
@@ -131,10 +131,15 @@ void exec_kernel(
 
     SmallVector<RefPtr> ptr;
     for (size_t index = 0; index < States::nr_states(); index++) {
-        ptr.push_back(workspace_bundle.get(4 + index));
+        ptr.push_back(workspace_bundle.get(5 + index));
     }
     auto&& tmp_state = States(ptr, hidden_size, batch_size, outputs[0].layout.dtype);
 
+    //! the matmul opr is shared by all the cells and steps, it dispatches the
+    //! compute task to device, so record mode performance will not be effect
+    auto matmul = handle->create_operator<MatrixMulForward>();
+    matmul->param().transposeB = true;
+
     for (size_t layer = 0; layer < num_layers; layer++) {
         auto layer_inputs = io_pairs[layer % 2].first;
         auto layer_outputs = io_pairs[layer % 2].second;
@@ -146,28 +151,41 @@ void exec_kernel(
         if (0 == layer) {
             layer_inputs = inputs;
         }
+        //! the inputs of all the timesteps are contiguous
+        size_t layer_input_size = layer_inputs[0].layout.shape[1];
+        TensorND layer_input{
+                TensorLayout{
+                        {seq_len * batch_size, layer_input_size},
+                        layer_inputs[0].layout.dtype},
+                layer_inputs[0].get_ref_ptr()};
         for (size_t d = 0; d < dir_size; ++d) {
             size_t cell_idx = layer * dir_size + d;
             auto& cell = cells[cell_idx];
             auto& state_in_origin = states_in[cell_idx];
             auto& state_out_origin = states_out[cell_idx];
 
+            //! project the inputs of all the timesteps by one matmul, then
+            //! only the recurrent matmul is left to each step
+            LstmCellCompute::run_input_proj(
+                    layer_input, cell.m_weight_ih, cell.m_bias_ih, cell.m_bias_hh,
+                    input_proj, matmul_workspace, matmul.get(), handle);
+
             auto state_in = state_in_origin;
             auto state_out = tmp_state;
 
             for (size_t i = 0; i < seq_len; ++i) {
                 size_t step = d == 0 ? i : seq_len - 1 - i;
-                auto& step_input = layer_inputs[step];
                 auto& step_output = layer_outputs[step];
 
                 if (i == seq_len - 1) {
                     state_out = state_out_origin;
                 }
                 //! task 1
-                //! this CellOp will dispatch task inner, so here not dispatch task
-                cell_opr_compute<CellOpr, LstmStates>(
-                        step_input, cell.m_weight_ih, cell.m_weight_hh, cell.m_bias_ih,
-                        cell.m_bias_hh, state_in, state_out, cell_workspace, handle);
+                //! the cell step will dispatch task inner, so here not dispatch task
+                LstmCellCompute::run_step(
+                        step_input_projs[step], state_in.m_h, cell.m_weight_hh,
+                        state_in.m_c, state_out.m_h, state_out.m_c, gates,
+                        matmul_workspace, matmul.get(), handle);
                 //! task 2
                 //! copy output to continue space
                 auto copy_to_output = [=]() {
@@ -206,33 +224,40 @@ WorkspaceBundle get_workspace_bundle(
         const TensorLayout& input, const TensorLayout& output,
         const TensorLayout& flatten_weights, size_t hidden_size, size_t dir_size,
         size_t states_size) {
+    size_t seq_len = input.shape[0];
     size_t batch_size = input.shape[1];
     size_t input_size = input.shape[2];
     size_t gate_hidden_size = flatten_weights.shape[0];
+    auto dtype = output.dtype;
 
-    // cell workspace
-    TensorLayout weight_ih{{gate_hidden_size, input_size}, flatten_weights.dtype};
-    TensorLayout weight_hh{
+    //! the matmul of the input projections of the first layer and the other
+    //! layers, and the matmul of the recurrent step
+    TensorLayout first_input{{seq_len * batch_size, input_size}, input.dtype};
+    TensorLayout first_weight_ih{{gate_hidden_size, input_size}, flatten_weights.dtype};
+    TensorLayout layer_input{{seq_len * batch_size, dir_size * hidden_size}, dtype};
+    TensorLayout weight_ih{
             {gate_hidden_size, dir_size * hidden_size}, flatten_weights.dtype};
-    TensorLayout bias{{1, gate_hidden_size}, flatten_weights.dtype};
-    TensorLayout hx{{batch_size, dir_size * hidden_size}, input.dtype};
-
-    auto cell_opr = inplace_cpu_handle()->create_operator<CellOpr>();
+    TensorLayout input_proj{{seq_len * batch_size, gate_hidden_size}, dtype};
+    TensorLayout hx{{batch_size, hidden_size}, dtype};
+    TensorLayout weight_hh{{gate_hidden_size, hidden_size}, flatten_weights.dtype};
+    TensorLayout gates{{batch_size, gate_hidden_size}, dtype};
 
-    TensorLayout h_new, c_new, gates;
-    cell_opr->deduce_layout(
-            input, weight_ih, bias, hx, weight_hh, bias, hx, h_new, c_new, gates);
+    auto matmul = inplace_cpu_handle()->create_operator<MatrixMulForward>();
+    matmul->param().transposeB = true;
+    size_t matmul_workspace = std::max(
+            {matmul->get_workspace_in_bytes(first_input, first_weight_ih, input_proj),
+             matmul->get_workspace_in_bytes(layer_input, weight_ih, input_proj),
+             matmul->get_workspace_in_bytes(hx, weight_hh, gates)});
 
     SmallVector<size_t> workspaces;
-    //! the cell opr compute workspace
-    size_t cell_opr_workspace = cell_opr->get_workspace_in_bytes(
-            input, weight_ih, bias, hx, weight_hh, bias, hx, h_new, c_new, gates);
     workspaces.push_back(gates.span().dist_byte());
-    workspaces.push_back(cell_opr_workspace);
+    workspaces.push_back(matmul_workspace);
     //! double tmp output memory
     size_t tmp_output_workspace = output.span().dist_byte();
     workspaces.push_back(tmp_output_workspace);
     workspaces.push_back(tmp_output_workspace);
+    //! the input projections of all the timesteps
+    workspaces.push_back(input_proj.span().dist_byte());
 
     //! tmp states memory
     size_t tmp_state_workspace = hx.span().dist_byte();
@@ -197,6 +197,22 @@ void rnn_cell_elemwise_compute(
         }
     }
 }
+void add_bias(
+        float* dst, const float* bias_ih, const float* bias_hh, size_t rows,
+        size_t length) {
+    for (size_t r = 0; r < rows; r++) {
+        size_t index = 0;
+        for (; index + 3 < length; index += 4) {
+            auto bias =
+                    vaddq_f32(vld1q_f32(bias_ih + index), vld1q_f32(bias_hh + index));
+            vst1q_f32(dst + index, vaddq_f32(vld1q_f32(dst + index), bias));
+        }
+        for (; index < length; index++) {
+            dst[index] += bias_ih[index] + bias_hh[index];
+        }
+        dst += length;
+    }
+}
 }  // namespace
 
 void LstmCellCompute::run(
@@ -233,6 +249,36 @@ void LstmCellCompute::run(
     }
 }
 
+void LstmCellCompute::run_input_proj(
+        _megdnn_tensor_in input, _megdnn_tensor_in weight_ih, _megdnn_tensor_in bias_ih,
+        _megdnn_tensor_in bias_hh, _megdnn_tensor_out input_proj,
+        _megdnn_workspace workspace, MatrixMulForward* matmul, Handle* handle) {
+    matmul->exec(input, weight_ih, input_proj, workspace);
+    if (bias_ih.layout.ndim != 0) {
+        megdnn_assert(bias_hh.layout.ndim != 0);
+        auto run = [=]() {
+            size_t length = bias_ih.layout.total_nr_elems();
+            add_bias(
+                    input_proj.ptr<float>(), bias_ih.ptr<float>(), bias_hh.ptr<float>(),
+                    input_proj.layout.total_nr_elems() / length, length);
+        };
+        MEGDNN_DISPATCH_CPU_KERN(static_cast<naive::HandleImpl*>(handle), run());
+    }
+}
+
+void LstmCellCompute::run_step(
+        _megdnn_tensor_in input_proj, _megdnn_tensor_in hx, _megdnn_tensor_in weight_hh,
+        _megdnn_tensor_in cx, _megdnn_tensor_out h_new, _megdnn_tensor_out c_new,
+        _megdnn_tensor_out gates, _megdnn_workspace workspace, MatrixMulForward* matmul,
+        Handle* handle) {
+    matmul->exec(hx, weight_hh, gates, workspace);
+    //! the biases have been added to input_proj
+    MEGDNN_DISPATCH_CPU_KERN(
+            static_cast<naive::HandleImpl*>(handle),
+            rnn_cell_elemwise_compute<false>(
+                    gates, input_proj, {}, {}, cx, h_new, c_new));
+}
+
 WorkspaceBundle LstmCellCompute::get_workspace_bundle(
         const TensorLayout& input, const TensorLayout& weight_ih, const TensorLayout&,
         const TensorLayout& hx, const TensorLayout& weight_hh, const TensorLayout&,
@@ -28,6 +28,29 @@ struct LstmCellCompute {
             _megdnn_tensor_in weight_hh, _megdnn_tensor_in bias_hh,
             _megdnn_tensor_in cx, _megdnn_tensor_out h_new, _megdnn_tensor_out c_new,
             _megdnn_tensor_out gates, _megdnn_workspace workspace, Handle* handle);
+
+    /*!
+     * \brief compute input * weight_ih^T + bias_ih + bias_hh, the input may hold
+     * the rows of all the timesteps, so that they are projected by one matmul
+     */
+    static void run_input_proj(
+            _megdnn_tensor_in input, _megdnn_tensor_in weight_ih,
+            _megdnn_tensor_in bias_ih, _megdnn_tensor_in bias_hh,
+            _megdnn_tensor_out input_proj, _megdnn_workspace workspace,
+            MatrixMulForward* matmul, Handle* handle);
+
+    /*!
+     * \brief one cell step whose input projection with the biases has been
+     * computed by run_input_proj, only hx * weight_hh^T is left to the matmul
+     *
+     * hx and cx may be the same memory as h_new and c_new.
+     */
+    static void run_step(
+            _megdnn_tensor_in input_proj, _megdnn_tensor_in hx,
+            _megdnn_tensor_in weight_hh, _megdnn_tensor_in cx,
+            _megdnn_tensor_out h_new, _megdnn_tensor_out c_new,
+            _megdnn_tensor_out gates, _megdnn_workspace workspace,
+            MatrixMulForward* matmul, Handle* handle);
 };
 
 }  // namespace arm_common
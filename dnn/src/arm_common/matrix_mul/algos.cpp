@@ -3,6 +3,7 @@
 #include "src/arm_common/matrix_mul/fp16/hgemv.h"
 #include "src/arm_common/matrix_mul/fp32/exec_sgemv.h"
 #include "src/arm_common/matrix_mul/int8/gemv.h"
+#include "src/arm_common/utils.h"
 
 #include "midout.h"
 
@@ -159,7 +160,7 @@ void int8x8x32_gevm_dot_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoInt8x8x32GevmDot::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     auto M = kern_size_param.M;
@@ -200,7 +201,7 @@ void int8x8x32_gevm_n32k4_dot_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoInt8x8x32GevmN32K4Dot::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     auto M = kern_size_param.M;
@@ -243,7 +244,7 @@ void int8x8x32_gemv_mk4_dot_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoInt8x8x32GemvMK4Dot::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     auto M = kern_size_param.M;
@@ -2,6 +2,7 @@
 
 #include "megdnn/oprs.h"
 #include "src/arm_common/matrix_mul/int8/gemv.h"
+#include "src/arm_common/utils.h"
 #include "src/common/unroll_macro.h"
 #include "src/common/utils.h"
 
@@ -388,7 +389,7 @@ void arm_common::gemv_like(
     megdnn_assert(N == 1);
     MIDOUT_BEGIN(megdnn_arm_common_int8_gemv, midout_iv("INT8_gemv_like"_hash)) {
 #if MGB_ENABLE_DOT
-        if (cpuinfo_has_arm_neon_dot()) {
+        if (arm_common::cpu_has_dotprod()) {
             return gemv_naive_n_dot(A, B, C, M, N, K, Astride, Bstride, Cstride);
         } else {
             return gemv_naive_n(A, B, C, M, N, K, Astride, Bstride, Cstride);
@@ -406,7 +407,7 @@ void arm_common::gemv_like_mk4(
     megdnn_assert(N == 1);
     MIDOUT_BEGIN(megdnn_arm_common_int8_gemv, midout_iv("INT8_gemv_like_mk4"_hash)) {
 #if MGB_ENABLE_DOT
-        if (cpuinfo_has_arm_neon_dot()) {
+        if (arm_common::cpu_has_dotprod()) {
             return gemv_naive_n_mk4_dotprod(
                     A, B, C, M, N, K, Astride, Bstride, Cstride);
         } else {
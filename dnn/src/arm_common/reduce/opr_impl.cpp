@@ -3,6 +3,8 @@
 #include <cstring>
 #include "src/arm_common/quantized_converter.h"
 #include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/arm_common/sve/kernels.h"
+#include "src/arm_common/utils.h"
 #include "src/common/reduce_helper.h"
 #include "src/common/unroll_macro.h"
 #include "src/common/utils.h"
@@ -568,6 +570,19 @@ void ReduceImpl::exec(
     reduce::get_ABC(src.layout, A, B, C, param().axis);
     bool execed = false;
     using Mode = param::Reduce::Mode;
+#if MGB_ENABLE_SVE
+    if (src.layout.is_contiguous() && src.layout.dtype == dtype::Float32() &&
+        param().data_type == param::Reduce::DataType::DEFAULT &&
+        sve::reduce_mode_supported(param().mode) && cpu_has_sve()) {
+        MIDOUT_BEGIN(megdnn_arm_common_reduce, midout_iv("reduce_sve_f32"_hash)) {
+            auto mode = param().mode;
+            MEGDNN_DISPATCH_CPU_KERN_OPR(sve::reduce_f32(
+                    mode, src.ptr<dt_float32>(), dst.ptr<dt_float32>(), A, B, C));
+            return;
+        }
+        MIDOUT_END();
+    }
+#endif
 #define DISPATCH_FUNC(Reducer, _dtype, ctype, comp_type)                            \
     if (C == 1) {                                                                   \
         using _Reducer = Reducer<_dtype, ctype, comp_type, true>;                   \
@@ -0,0 +1,260 @@
+#include "src/arm_common/sve/kernels.h"
+
+#if MGB_ENABLE_SVE
+#include <arm_sve.h>
+#include <limits>
+
+using namespace megdnn;
+
+namespace {
+
+using Mode = Elemwise::Mode;
+using ReduceMode = param::Reduce::Mode;
+
+#define DEF_BINARY_OP(_name, _expr)                                               \
+    struct _name {                                                                \
+        MEGDNN_ATTRIBUTE_TARGET("sve")                                            \
+        svfloat32_t operator()(svbool_t pg, svfloat32_t a, svfloat32_t b) const { \
+            return _expr;                                                         \
+        }                                                                         \
+    };
+DEF_BINARY_OP(AddOp, svadd_f32_x(pg, a, b))
+DEF_BINARY_OP(SubOp, svsub_f32_x(pg, a, b))
+DEF_BINARY_OP(MulOp, svmul_f32_x(pg, a, b))
+DEF_BINARY_OP(TrueDivOp, svdiv_f32_x(pg, a, b))
+DEF_BINARY_OP(MinOp, svmin_f32_x(pg, a, b))
+DEF_BINARY_OP(MaxOp, svmax_f32_x(pg, a, b))
+DEF_BINARY_OP(FuseAddReluOp, svmax_n_f32_x(pg, svadd_f32_x(pg, a, b), 0.f))
+#undef DEF_BINARY_OP
+
+template <typename Op>
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void run_vec_vec(const float* src0, const float* src1, float* dst, size_t nr_elems) {
+    Op op;
+    for (size_t i = 0; i < nr_elems; i += svcntw()) {
+        svbool_t pg = svwhilelt_b32_u64(i, nr_elems);
+        svfloat32_t a = svld1_f32(pg, src0 + i), b = svld1_f32(pg, src1 + i);
+        svst1_f32(pg, dst + i, op(pg, a, b));
+    }
+}
+
+template <typename Op>
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void run_vec_scalar(
+        const float* src, float scalar, float* dst, size_t nr_elems,
+        bool scalar_first) {
+    Op op;
+    svfloat32_t vscalar = svdup_n_f32(scalar);
+    if (scalar_first) {
+        for (size_t i = 0; i < nr_elems; i += svcntw()) {
+            svbool_t pg = svwhilelt_b32_u64(i, nr_elems);
+            svst1_f32(pg, dst + i, op(pg, vscalar, svld1_f32(pg, src + i)));
+        }
+    } else {
+        for (size_t i = 0; i < nr_elems; i += svcntw()) {
+            svbool_t pg = svwhilelt_b32_u64(i, nr_elems);
+            svst1_f32(pg, dst + i, op(pg, svld1_f32(pg, src + i), vscalar));
+        }
+    }
+}
+
+#define FOR_EACH_BINARY_MODE(cb) \
+    cb(ADD, AddOp);              \
+    cb(SUB, SubOp);              \
+    cb(MUL, MulOp);              \
+    cb(TRUE_DIV, TrueDivOp);     \
+    cb(MIN, MinOp);              \
+    cb(MAX, MaxOp);              \
+    cb(FUSE_ADD_RELU, FuseAddReluOp);
+
+/*!
+ * \brief the reducers accumulate the lanes of a vector with the merging
+ *      predicate, so the inactive lanes of the tail keep the initial value
+ */
+struct SumReducer {
+    static constexpr float init = 0.f;
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static svfloat32_t feed(svbool_t pg, svfloat32_t acc, svfloat32_t v) {
+        return svadd_f32_m(pg, acc, v);
+    }
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static float reduce(svfloat32_t acc) { return svaddv_f32(svptrue_b32(), acc); }
+};
+
+struct SumSqrReducer : SumReducer {
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static svfloat32_t feed(svbool_t pg, svfloat32_t acc, svfloat32_t v) {
+        return svmla_f32_m(pg, acc, v, v);
+    }
+};
+
+struct MaxReducer {
+    static constexpr float init = -std::numeric_limits<float>::infinity();
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static svfloat32_t feed(svbool_t pg, svfloat32_t acc, svfloat32_t v) {
+        return svmax_f32_m(pg, acc, v);
+    }
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static float reduce(svfloat32_t acc) { return svmaxv_f32(svptrue_b32(), acc); }
+};
+
+struct MinReducer {
+    static constexpr float init = std::numeric_limits<float>::infinity();
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static svfloat32_t feed(svbool_t pg, svfloat32_t acc, svfloat32_t v) {
+        return svmin_f32_m(pg, acc, v);
+    }
+    MEGDNN_ATTRIBUTE_TARGET("sve")
+    static float reduce(svfloat32_t acc) { return svminv_f32(svptrue_b32(), acc); }
+};
+
+//! reduce every contiguous row of B elements into one element
+template <typename Reducer>
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void reduce_c1(const float* src, float* dst, size_t A, size_t B, float coef) {
+    for (size_t a = 0; a < A; ++a) {
+        svfloat32_t acc = svdup_n_f32(Reducer::init);
+        for (size_t b = 0; b < B; b += svcntw()) {
+            svbool_t pg = svwhilelt_b32_u64(b, B);
+            acc = Reducer::feed(pg, acc, svld1_f32(pg, src + b));
+        }
+        dst[a] = Reducer::reduce(acc) * coef;
+        src += B;
+    }
+}
+
+//! reduce along B with the lanes laid along C, every lane is reduced alone
+template <typename Reducer>
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void reduce_cn(
+        const float* src, float* dst, size_t A, size_t B, size_t C, float coef) {
+    for (size_t a = 0; a < A; ++a) {
+        for (size_t c = 0; c < C; c += svcntw()) {
+            svbool_t pg = svwhilelt_b32_u64(c, C);
+            svfloat32_t acc = svdup_n_f32(Reducer::init);
+            const float* sptr = src + c;
+            for (size_t b = 0; b < B; ++b) {
+                acc = Reducer::feed(pg, acc, svld1_f32(pg, sptr));
+                sptr += C;
+            }
+            svst1_f32(pg, dst + c, svmul_n_f32_x(pg, acc, coef));
+        }
+        src += B * C;
+        dst += C;
+    }
+}
+
+template <typename Reducer>
+void run_reduce(
+        const float* src, float* dst, size_t A, size_t B, size_t C, float coef) {
+    if (C == 1) {
+        reduce_c1<Reducer>(src, dst, A, B, coef);
+    } else {
+        reduce_cn<Reducer>(src, dst, A, B, C, coef);
+    }
+}
+
+}  // anonymous namespace
+
+namespace megdnn {
+namespace arm_common {
+namespace sve {
+
+bool binary_mode_supported(Elemwise::Mode mode) {
+#define cb(_mode, _op)   \
+    if (mode == Mode::_mode) \
+    return true
+    FOR_EACH_BINARY_MODE(cb)
+#undef cb
+    return false;
+}
+
+void binary_vec_vec_f32(
+        Elemwise::Mode mode, const float* src0, const float* src1, float* dst,
+        size_t nr_elems) {
+    switch (mode) {
+#define cb(_mode, _op) \
+    case Mode::_mode:  \
+        return run_vec_vec<_op>(src0, src1, dst, nr_elems)
+        FOR_EACH_BINARY_MODE(cb)
+#undef cb
+        default:
+            megdnn_throw(ssprintf(
+                    "unsupported mode for sve binary kernel: %d",
+                    static_cast<int>(mode)));
+    }
+}
+
+void binary_vec_scalar_f32(
+        Elemwise::Mode mode, const float* src, float scalar, float* dst,
+        size_t nr_elems, bool scalar_first) {
+    switch (mode) {
+#define cb(_mode, _op) \
+    case Mode::_mode:  \
+        return run_vec_scalar<_op>(src, scalar, dst, nr_elems, scalar_first)
+        FOR_EACH_BINARY_MODE(cb)
+#undef cb
+        default:
+            megdnn_throw(ssprintf(
+                    "unsupported mode for sve binary kernel: %d",
+                    static_cast<int>(mode)));
+    }
+}
+
+bool reduce_mode_supported(param::Reduce::Mode mode) {
+    return mode == ReduceMode::SUM || mode == ReduceMode::SUM_SQR ||
+           mode == ReduceMode::MEAN || mode == ReduceMode::MAX ||
+           mode == ReduceMode::MIN;
+}
+
+void reduce_f32(
+        param::Reduce::Mode mode, const float* src, float* dst, size_t A, size_t B,
+        size_t C) {
+    switch (mode) {
+        case ReduceMode::SUM:
+            return run_reduce<SumReducer>(src, dst, A, B, C, 1.f);
+        case ReduceMode::SUM_SQR:
+            return run_reduce<SumSqrReducer>(src, dst, A, B, C, 1.f);
+        case ReduceMode::MEAN:
+            return run_reduce<SumReducer>(src, dst, A, B, C, 1.f / B);
+        case ReduceMode::MAX:
+            return run_reduce<MaxReducer>(src, dst, A, B, C, 1.f);
+        case ReduceMode::MIN:
+            return run_reduce<MinReducer>(src, dst, A, B, C, 1.f);
+        default:
+            megdnn_throw(ssprintf(
+                    "unsupported mode for sve reduce kernel: %d",
+                    static_cast<int>(mode)));
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void quantize_f32_s8(const float* src, int8_t* dst, float scale, size_t nr_elems) {
+    for (size_t i = 0; i < nr_elems; i += svcntw()) {
+        svbool_t pg = svwhilelt_b32_u64(i, nr_elems);
+        //! round half away from zero, the same as std::round
+        svfloat32_t v = svmul_n_f32_x(pg, svld1_f32(pg, src + i), scale);
+        v = svrinta_f32_x(pg, v);
+        svint32_t q = svcvt_s32_f32_x(pg, v);
+        q = svmin_n_s32_x(pg, svmax_n_s32_x(pg, q, -128), 127);
+        svst1b_s32(pg, dst + i, q);
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("sve")
+void dequantize_s8_f32(const int8_t* src, float* dst, float scale, size_t nr_elems) {
+    for (size_t i = 0; i < nr_elems; i += svcntw()) {
+        svbool_t pg = svwhilelt_b32_u64(i, nr_elems);
+        svfloat32_t v = svcvt_f32_s32_x(pg, svld1sb_s32(pg, src + i));
+        svst1_f32(pg, dst + i, svmul_n_f32_x(pg, v, scale));
+    }
+}
+
+}  // namespace sve
+}  // namespace arm_common
+}  // namespace megdnn
+
+#undef FOR_EACH_BINARY_MODE
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+#if MGB_ENABLE_SVE
+namespace megdnn {
+namespace arm_common {
+namespace sve {
+
+/*!
+ * The kernels here are vector length agnostic, they are compiled with the sve
+ * target attribute and should only be called when cpu_has_sve() is true. The
+ * tails are handled by the predicates, so no scalar remain loop is needed.
+ */
+
+//! whether the fp32 binary elemwise mode is implemented by the sve kernels
+bool binary_mode_supported(Elemwise::Mode mode);
+
+//! dst[i] = op(src0[i], src1[i])
+void binary_vec_vec_f32(
+        Elemwise::Mode mode, const float* src0, const float* src1, float* dst,
+        size_t nr_elems);
+
+//! dst[i] = op(src[i], scalar), or op(scalar, src[i]) if scalar_first is true
+void binary_vec_scalar_f32(
+        Elemwise::Mode mode, const float* src, float scalar, float* dst,
+        size_t nr_elems, bool scalar_first);
+
+//! whether the fp32 reduce mode is implemented by the sve kernels
+bool reduce_mode_supported(param::Reduce::Mode mode);
+
+//! reduce the contiguous src of shape [A, B, C] along B to dst of shape [A, C]
+void reduce_f32(
+        param::Reduce::Mode mode, const float* src, float* dst, size_t A, size_t B,
+        size_t C);
+
+//! dst[i] = saturate(round(src[i] * scale)), where scale is the reciprocal of the
+//! scale of dst
+void quantize_f32_s8(const float* src, int8_t* dst, float scale, size_t nr_elems);
+
+//! dst[i] = src[i] * scale
+void dequantize_s8_f32(const int8_t* src, float* dst, float scale, size_t nr_elems);
+
+}  // namespace sve
+}  // namespace arm_common
+}  // namespace megdnn
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -5,6 +5,8 @@
 #include "midout.h"
 #include "src/arm_common/quantized_converter.h"
 #include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/arm_common/sve/kernels.h"
+#include "src/arm_common/utils.h"
 #include "src/common/utils.h"
 #include "src/naive/handle.h"
 
@@ -12,6 +14,7 @@ MIDOUT_DECL(megdnn_arm_typecvt_fix2float)
 MIDOUT_DECL(megdnn_arm_typecvt_quan2float)
 MIDOUT_DECL(megdnn_arm_typecvt_quantized)
 MIDOUT_DECL(megdnn_arm_typecvt_float)
+MIDOUT_DECL(megdnn_arm_typecvt_sve)
 
 using namespace megdnn;
 using namespace arm_common;
@@ -578,6 +581,35 @@ void TypeCvtImpl::exec(_megdnn_tensor_in src, _megdnn_tensor_out dst) {
     if (src.layout.is_contiguous()) {
         using namespace dtype;
         size_t nr_elems = src.layout.total_nr_elems();
+#if MGB_ENABLE_SVE
+        if (cpu_has_sve() && dst.layout.is_contiguous()) {
+            if (src_dtype.enumv() == DTypeEnum::Float32 &&
+                dst_dtype.enumv() == DTypeEnum::QuantizedS8) {
+                MIDOUT_BEGIN(megdnn_arm_typecvt_sve, midout_iv(0)) {
+                    float scale = 1.f / dst_dtype.param<QuantizedS8>().scale;
+                    MEGDNN_DISPATCH_CPU_KERN_OPR(sve::quantize_f32_s8(
+                            src.ptr<dt_float32>(), dst.compatible_ptr<int8_t>(), scale,
+                            nr_elems));
+                    return;
+                }
+                MIDOUT_END();
+            }
+            if ((src_dtype.enumv() == DTypeEnum::QuantizedS8 ||
+                 src_dtype.enumv() == DTypeEnum::Int8) &&
+                dst_dtype.enumv() == DTypeEnum::Float32) {
+                MIDOUT_BEGIN(megdnn_arm_typecvt_sve, midout_iv(1)) {
+                    float scale = src_dtype.enumv() == DTypeEnum::Int8
+                                        ? 1.f
+                                        : src_dtype.param<QuantizedS8>().scale;
+                    MEGDNN_DISPATCH_CPU_KERN_OPR(sve::dequantize_s8_f32(
+                            src.compatible_ptr<int8_t>(), dst.ptr<dt_float32>(), scale,
+                            nr_elems));
+                    return;
+                }
+                MIDOUT_END();
+            }
+        }
+#endif
 #define DISPATCH_QUANTIZED(_stype_enumv, _stype, _dtype_enumv, _dtype, _midout_iv) \
     if (src_dtype.enumv() == DTypeTrait<_stype_enumv>::enumv &&                    \
         dst_dtype.enumv() == DTypeTrait<_dtype_enumv>::enumv) {                    \
@@ -1,11 +1,47 @@
 #include "src/common/utils.h"
 #include <cstring>
 #include "src/arm_common/simd_macro/marm_neon.h"
+#include "src/arm_common/utils.h"
+#if MGB_ENABLE_CPUINFO
+#include "cpuinfo.h"
+#endif
+
+#if MEGDNN_AARCH64
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/auxv.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+#endif
 
 using namespace megdnn;
 
 namespace {
 
+#if MEGDNN_AARCH64
+//! the auxv entry holding the feature bit on linux
+enum class Hwcap { HWCAP, HWCAP2 };
+
+//! detect the cpu feature by the bit of AT_HWCAP or AT_HWCAP2 on linux or by
+//! the sysctl name on apple, a null sysctl name means the feature is never
+//! reported on apple
+bool detect_feature(Hwcap hwcap, unsigned long bit, const char* sysctl_name) {
+    MEGDNN_MARK_USED_VAR(hwcap);
+    MEGDNN_MARK_USED_VAR(bit);
+    MEGDNN_MARK_USED_VAR(sysctl_name);
+#if (defined(__linux__) || defined(__ANDROID__)) && defined(AT_HWCAP2)
+    return getauxval(hwcap == Hwcap::HWCAP ? AT_HWCAP : AT_HWCAP2) & bit;
+#elif defined(__APPLE__)
+    int value = 0;
+    size_t size = sizeof(value);
+    return sysctl_name &&
+           sysctlbyname(sysctl_name, &value, &size, nullptr, 0) == 0 && value;
+#else
+    return false;
+#endif
+}
+#endif
+
 template <typename dtype>
 void transpose_naive(const dtype* src, dtype* dst, int lda, int ldb, int n, int m) {
     rep(i, n) rep(j, m) { dst[i * ldb + j] = src[j * lda + i]; }
@@ -177,5 +213,95 @@ void transpose_knc2nsck(
 }
 #endif
 
+namespace {
+
+bool detect_dotprod() {
+#if MGB_ENABLE_CPUINFO
+    return cpuinfo_has_arm_neon_dot();
+#elif MEGDNN_AARCH64
+    //! HWCAP_ASIMDDP of asm/hwcap.h
+    static bool supported = detect_feature(
+            Hwcap::HWCAP, 1ul << 20, "hw.optional.arm.FEAT_DotProd");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool detect_i8mm() {
+#if MEGDNN_AARCH64
+    //! HWCAP2_I8MM of asm/hwcap.h
+    static bool supported = detect_feature(
+            Hwcap::HWCAP2, 1ul << 13, "hw.optional.arm.FEAT_I8MM");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool detect_bf16() {
+#if MEGDNN_AARCH64
+    //! HWCAP2_BF16 of asm/hwcap.h
+    static bool supported = detect_feature(
+            Hwcap::HWCAP2, 1ul << 14, "hw.optional.arm.FEAT_BF16");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+fallback::CpuIsaLevel max_cpu_isa_level = fallback::CpuIsaLevel::ARM_V8_6_I8MM;
+bool sve_enabled = true;
+
+}  // anonymous namespace
+
+fallback::CpuIsaLevel arm_common::detect_cpu_isa_level() {
+    using Level = fallback::CpuIsaLevel;
+    if (detect_i8mm()) {
+        return Level::ARM_V8_6_I8MM;
+    }
+    return detect_dotprod() ? Level::ARM_V8_2_DOTPROD : Level::ARM_V8_0;
+}
+
+void arm_common::limit_cpu_features(fallback::CpuIsaLevel level) {
+    if (level < max_cpu_isa_level) {
+        max_cpu_isa_level = level;
+    }
+    sve_enabled = false;
+}
+
+bool arm_common::cpu_has_dotprod() {
+    return max_cpu_isa_level >= fallback::CpuIsaLevel::ARM_V8_2_DOTPROD &&
+           detect_dotprod();
+}
+
+bool arm_common::cpu_has_i8mm() {
+    return max_cpu_isa_level >= fallback::CpuIsaLevel::ARM_V8_6_I8MM && detect_i8mm();
+}
+
+bool arm_common::cpu_has_bf16() {
+    return max_cpu_isa_level >= fallback::CpuIsaLevel::ARM_V8_6_I8MM && detect_bf16();
+}
+
+bool arm_common::cpu_has_sve() {
+#if MEGDNN_AARCH64
+    //! HWCAP_SVE of asm/hwcap.h, apple cpus do not implement sve
+    static bool supported = detect_feature(Hwcap::HWCAP, 1ul << 22, nullptr);
+    return sve_enabled && supported;
+#else
+    return false;
+#endif
+}
+
+bool arm_common::cpu_has_sve2() {
+#if MEGDNN_AARCH64
+    //! HWCAP2_SVE2 of asm/hwcap.h
+    static bool supported = detect_feature(Hwcap::HWCAP2, 1ul << 1, nullptr);
+    return sve_enabled && supported;
+#else
+    return false;
+#endif
+}
+
 }  // namespace megdnn
 // vim: syntax=cpp.doxygen
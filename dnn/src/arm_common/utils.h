@@ -3,6 +3,7 @@
 #include <cstring>
 #include "src/arm_common/simd_macro/marm_neon.h"
 #include "src/common/utils.h"
+#include "src/fallback/cpu_dispatch.h"
 
 namespace megdnn {
 namespace arm_common {
@@ -503,6 +504,38 @@ struct Vector<int32_t, 8> {
     }
 };
 
+/*!
+ * The cpu_has_*() below report the features of the host cpu not above the isa
+ * level set by limit_cpu_features(), so a handle capped by the env
+ * MEGDNN_CPU_ISA_LEVEL also disables the algos checking them. sve is not one of
+ * the levels and is only reported when the level is not capped.
+ */
+
+//! the isa level of the host cpu by cpuinfo or HWCAP
+fallback::CpuIsaLevel detect_cpu_isa_level();
+
+//! disable the features above a (capped) isa level
+void limit_cpu_features(fallback::CpuIsaLevel level);
+
+//! whether the cpu supports the int8 dot product instructions (sdot) of
+//! armv8.2-a
+bool cpu_has_dotprod();
+
+//! whether the cpu supports the int8 matrix multiply instructions (smmla) of
+//! armv8.6-a, always false on armv7
+bool cpu_has_i8mm();
+
+//! whether the cpu supports the bf16 instructions (bfmmla) of armv8.6-a,
+//! always false on armv7
+bool cpu_has_bf16();
+
+//! whether the cpu supports the scalable vector extension, always false on
+//! armv7 and apple
+bool cpu_has_sve();
+
+//! whether the cpu supports sve2, always false on armv7 and apple
+bool cpu_has_sve2();
+
 }  // namespace arm_common
 }  // namespace megdnn
 
@@ -1,5 +1,6 @@
 #include "src/armv7/conv_bias/int8/algos.h"
 #include "src/arm_common/convolution/img2col_helper.h"
+#include "src/arm_common/utils.h"
 #include "src/armv7/conv_bias/int8/strategy.h"
 #include "src/common/opr_delegate.h"
 #include "src/fallback/conv_bias/common.h"
@@ -67,7 +68,15 @@ WorkspaceBundle ConvBiasImpl::AlgoS8MatrixMul::get_bundle(
     }                                                                             \
     MIDOUT_END()
 
+#if MGB_ENABLE_DOT
+        if (arm_common::cpu_has_dotprod()) {
+            DISPATCH_GEMM_BIAS(s8_6x8, 1)
+        } else {
+            DISPATCH_GEMM_BIAS(s8_4x2, 0)
+        }
+#else
         DISPATCH_GEMM_BIAS(s8_4x2, 0)
+#endif
 
 #undef DISPATCH_GEMM_STRATEGY
     }
@@ -155,7 +164,15 @@ void ConvBiasImpl::AlgoS8MatrixMul::kimpl(
     }                                                                                \
     MIDOUT_END()
 
+#if MGB_ENABLE_DOT
+            if (arm_common::cpu_has_dotprod()) {
+                DISPATCH_GEMM_BIAS(s8_6x8, 1)
+            } else {
+                DISPATCH_GEMM_BIAS(s8_4x2, 0)
+            }
+#else
             DISPATCH_GEMM_BIAS(s8_4x2, 0)
+#endif
 #undef DISPATCH_GEMM_STRATEGY
         }
     }
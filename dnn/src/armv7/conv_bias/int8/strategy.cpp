@@ -6,6 +6,7 @@
 
 #include "src/arm_common/conv_bias/matmul_postprocess.h"
 #include "src/armv7/matrix_mul/int8/kernel_4x2x16.h"
+#include "src/armv7/matrix_mul/int8/kernel_6x8x4.h"
 
 using namespace megdnn;
 using namespace armv7;
@@ -90,6 +91,119 @@ struct KernCaller<bmode, Op, 4, 2> {
     }
 };
 
+#if MGB_ENABLE_DOT
+//! the m of a block is at most 6, the tail of which is dispatched here
+#define DISPATCH_M6(cb, _m, _n)         \
+    switch (_m) {                       \
+        case 5: {                       \
+            DISPATCH_N(cb, 5, _n);      \
+            break;                      \
+        }                               \
+        default: {                      \
+            DISPATCH_M(cb, _m, _n);     \
+            break;                      \
+        }                               \
+    }
+
+#define DISPATCH_M6_N(cb, _m, _n)       \
+    switch (_m) {                       \
+        case 5: {                       \
+            cb(5, _n);                  \
+            break;                      \
+        }                               \
+        default: {                      \
+            DISPATCH_M_N(cb, _m, _n);   \
+            break;                      \
+        }                               \
+    }
+
+template <BiasMode bmode, typename Op>
+struct KernCaller<bmode, Op, 6, 8> {
+    static void run(
+            const dt_int8* packA, const dt_int8* packB, size_t M, size_t N, size_t K,
+            dt_int8* C, size_t LDC, bool is_first_k, Op op, const dt_int32* bias,
+            dt_int32* workspace) {
+        megdnn_assert(is_first_k);
+
+        constexpr size_t A_INTERLEAVE = 6;
+        constexpr size_t B_INTERLEAVE = 8;
+        //! K is packed to times of 4
+        K = round_up<size_t>(K, 4);
+        const int K4 = K * 4;
+        const int K6 = K * 6;
+        const int K8 = K * 8;
+
+        size_t m = 0;
+        for (; m + A_INTERLEAVE - 1 < M; m += A_INTERLEAVE) {
+            int8_t* output = C + (m * LDC);
+
+            size_t n = 0;
+            const dt_int8* cur_packB = packB;
+            for (; n + B_INTERLEAVE - 1 < N; n += B_INTERLEAVE) {
+                matmul_dot_6x8x4::kern_6x8(packA, cur_packB, K, workspace, 8, true);
+                arm_common::ConvBiasMatmul<bmode, Op, dt_int8, 6, 8, 6, 8>::postprocess(
+                        bias, workspace, output, LDC, op);
+                output += B_INTERLEAVE;
+                cur_packB += K8;
+            }
+
+            for (; n < N; n += 4) {
+                size_t n_remain = std::min<size_t>(N - n, 4);
+                matmul_dot_6x8x4::kern_6x4(
+                        packA, cur_packB, K, workspace, 4, true, n_remain);
+#define cb(m, n)                                                             \
+    arm_common::ConvBiasMatmul<bmode, Op, dt_int8, 6, 4, 6, n>::postprocess( \
+            bias, workspace, output, LDC, op);
+                DISPATCH_N(cb, 6, n_remain);
+#undef cb
+                output += 4;
+                cur_packB += K4;
+            }
+
+            packA += K6;
+            if (bmode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+                bias += A_INTERLEAVE;
+            }
+        }
+
+        if (m < M) {
+            int8_t* output = C + (m * LDC);
+            size_t m_remain = std::min<size_t>(M - m, 6);
+
+            size_t n = 0;
+            const dt_int8* cur_packB = packB;
+            for (; n + B_INTERLEAVE - 1 < N; n += B_INTERLEAVE) {
+                matmul_dot_6x8x4::kern_6x8(
+                        packA, cur_packB, K, workspace, 8, true, m_remain);
+#define cb(m, n)                                                             \
+    arm_common::ConvBiasMatmul<bmode, Op, dt_int8, 6, 8, m, n>::postprocess( \
+            bias, workspace, output, LDC, op);
+                DISPATCH_M6_N(cb, m_remain, 8);
+#undef cb
+                output += B_INTERLEAVE;
+                cur_packB += K8;
+            }
+
+            for (; n < N; n += 4) {
+                size_t n_remain = std::min<size_t>(N - n, 4);
+                matmul_dot_6x8x4::kern_6x4(
+                        packA, cur_packB, K, workspace, 4, true, n_remain, m_remain);
+#define cb(m, n)                                                             \
+    arm_common::ConvBiasMatmul<bmode, Op, dt_int8, 6, 4, m, n>::postprocess( \
+            bias, workspace, output, LDC, op);
+                DISPATCH_M6(cb, m_remain, n_remain);
+#undef cb
+                output += 4;
+                cur_packB += K4;
+            }
+        }
+    }
+};
+
+#undef DISPATCH_M6
+#undef DISPATCH_M6_N
+#endif
+
 }  // namespace impl
 
 MEGDNN_REG_GEMM_STRATEGY_IMPL(gemm_s8_4x2_nobias_identity)
@@ -112,8 +226,36 @@ size_t gemm_s8_4x2_nobias_identity::get_workspace_size() const {
     return 4 * 2 * sizeof(dt_int32);
 }
 
-#define KERN(_bias, _BIAS, _nonline, _OP)                                             \
-    void gemm_s8_4x2_##_bias##_##_nonline::kern(                                      \
+#if MGB_ENABLE_DOT
+MEGDNN_REG_GEMM_STRATEGY_IMPL(gemm_s8_6x8_nobias_identity)
+
+void gemm_s8_6x8_nobias_identity::pack_A(
+        dt_int8* outptr, const dt_int8* inptr, int ldin, int y0, int ymax, int k0,
+        int kmax, bool transpose) const {
+    if (transpose) {
+        matmul_dot_6x8x4::gemm_s8_6x8_pack_A_t(outptr, inptr, ldin, y0, ymax, k0, kmax);
+    } else {
+        matmul_dot_6x8x4::gemm_s8_6x8_pack_A_n(outptr, inptr, ldin, y0, ymax, k0, kmax);
+    }
+}
+
+void gemm_s8_6x8_nobias_identity::pack_B(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax,
+        bool transpose) const {
+    if (transpose) {
+        matmul_dot_6x8x4::gemm_s8_6x8_pack_B_t(out, in, ldin, x0, xmax, k0, kmax);
+    } else {
+        matmul_dot_6x8x4::gemm_s8_6x8_pack_B_n(out, in, ldin, x0, xmax, k0, kmax);
+    }
+}
+
+size_t gemm_s8_6x8_nobias_identity::get_workspace_size() const {
+    return 6 * 8 * sizeof(dt_int32);
+}
+#endif
+
+#define KERN(_block_m, _block_n, _bias, _BIAS, _nonline, _OP)                         \
+    void gemm_s8_##_block_m##x##_block_n##_##_bias##_##_nonline::kern(                \
             const dt_int8* packA, const dt_int8* packB, size_t M, size_t N, size_t K, \
             dt_int8* C, size_t LDC, bool is_first_k, const dt_int32* bias,            \
             dt_int32* workspace) const {                                              \
@@ -121,24 +263,34 @@ size_t gemm_s8_4x2_nobias_identity::get_workspace_size() const {
         float scale_B = B_dtype.param<dtype::QuantizedS8>().scale;                    \
         float scale_C = C_dtype.param<dtype::QuantizedS8>().scale;                    \
         DEFINE_OP(_OP);                                                               \
-        impl::KernCaller<_BIAS, decltype(op), 4, 2>::run(                             \
+        impl::KernCaller<_BIAS, decltype(op), _block_m, _block_n>::run(               \
                 packA, packB, M, N, K, C, LDC, is_first_k, op, bias, workspace);      \
     }
 
 #define DEFINE_OP(_Op) \
     arm_common::_Op<dt_qint32, dt_qint8> op(scale_A* scale_B, scale_C);
 
-KERN(nobias, BiasMode::NO_BIAS, identity, TypeCvtOp)
-KERN(nobias, BiasMode::NO_BIAS, relu, ReluOp)
-KERN(nobias, BiasMode::NO_BIAS, hswish, HSwishOp)
+KERN(4, 2, nobias, BiasMode::NO_BIAS, identity, TypeCvtOp)
+KERN(4, 2, nobias, BiasMode::NO_BIAS, relu, ReluOp)
+KERN(4, 2, nobias, BiasMode::NO_BIAS, hswish, HSwishOp)
+#if MGB_ENABLE_DOT
+KERN(6, 8, nobias, BiasMode::NO_BIAS, identity, TypeCvtOp)
+KERN(6, 8, nobias, BiasMode::NO_BIAS, relu, ReluOp)
+KERN(6, 8, nobias, BiasMode::NO_BIAS, hswish, HSwishOp)
+#endif
 #undef DEFINE_OP
 
 #define DEFINE_OP(_Op)                             \
     arm_common::_Op<dt_qint32, dt_qint8, true> op( \
             scale_A* scale_B, scale_A* scale_B, scale_C);
-KERN(bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, identity, AddOp)
-KERN(bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, relu, FuseAddReluOp)
-KERN(bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, hswish, FuseAddHSwishOp)
+KERN(4, 2, bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, identity, AddOp)
+KERN(4, 2, bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, relu, FuseAddReluOp)
+KERN(4, 2, bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, hswish, FuseAddHSwishOp)
+#if MGB_ENABLE_DOT
+KERN(6, 8, bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, identity, AddOp)
+KERN(6, 8, bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, relu, FuseAddReluOp)
+KERN(6, 8, bias_channel, BiasMode::BROADCAST_CHANNEL_BIAS, hswish, FuseAddHSwishOp)
+#endif
 #undef DEFINE_OP
 
 #undef KERN
@@ -28,6 +28,26 @@ MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
 MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
         gemm_s8_4x2_bias_channel_hswish, gemm_s8_4x2_nobias_identity);
 
+#if MGB_ENABLE_DOT
+MEGDNN_REG_GEMM_STRATEGY_WITH_WRITEBACK(
+        dt_int8, dt_int8, dt_int32, 6, 8, 4, false, true, gemm_s8_6x8_nobias_identity);
+
+MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
+        gemm_s8_6x8_nobias_relu, gemm_s8_6x8_nobias_identity);
+
+MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
+        gemm_s8_6x8_nobias_hswish, gemm_s8_6x8_nobias_identity);
+
+MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
+        gemm_s8_6x8_bias_channel_identity, gemm_s8_6x8_nobias_identity);
+
+MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
+        gemm_s8_6x8_bias_channel_relu, gemm_s8_6x8_nobias_identity);
+
+MEGDNN_REG_GEMM_STRATEGY_WITH_SUPER(
+        gemm_s8_6x8_bias_channel_hswish, gemm_s8_6x8_nobias_identity);
+#endif
+
 }  // namespace matmul
 }  // namespace armv7
 }  // namespace megdnn
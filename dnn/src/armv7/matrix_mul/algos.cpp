@@ -1,3 +1,4 @@
+#include "src/arm_common/utils.h"
 #include "src/armv7/matrix_mul/algos.h"
 #include "src/armv7/matrix_mul/fp16/strategy.h"
 #include "src/armv7/matrix_mul/fp32/strategy.h"
@@ -701,7 +702,7 @@ void int8_k6x8x4_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoInt8x8x32K6x8x4::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return can_be_treated_as_int8x8x32(kern_size_param);
@@ -756,7 +757,7 @@ void quint8_dot_k4x8x4_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoQuint8DotK4x8x4::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return kern_size_param.A_type.enumv() == DTypeEnum::Quantized8Asymm &&
@@ -816,7 +817,7 @@ void int8_mk4_8x4x4_dotprod_kern(const MatrixMulImpl::KernParam& kern_param) {
 
 bool MatrixMulImpl::AlgoInt8x8x32MK4_8x4x4DotProd::usable(
         const KernSizeParam& kern_size_param) const {
-    if (!cpuinfo_has_arm_neon_dot()) {
+    if (!arm_common::cpu_has_dotprod()) {
         return false;
     }
     return kern_size_param.A_type.enumv() == kern_size_param.B_type.enumv() &&
@@ -34,7 +34,7 @@ typename Opr::AlgoBase* get_algorithm(Opr* opr, Args&&... args) {
                                 layouts.data(), layouts.size(),
                                 &opr->param(),  sizeof(opr->param())};
         // then get from global algorithm cache
-        auto rst = AlgorithmCache::instance().get(key);
+        auto rst = AlgorithmCache::instance().get(key, opr->algo_cache_last_entry());
         if (rst.policy.algo.valid()) {
             ret = rst.policy.algo;
         } else {
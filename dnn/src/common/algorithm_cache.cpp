@@ -21,9 +21,10 @@ AlgorithmCache& AlgorithmCache::instance() {
     return ins;
 }
 
-AlgorithmCache::KeyStorage AlgorithmCache::Key::build_key_storage() const {
+void AlgorithmCache::Key::build_key_buf() const {
     size_t buf_size = 16 * m_inp_layouts_size + 6;
-    size_t buf[buf_size];
+    m_buf.resize(buf_size);
+    size_t* buf = m_buf.data();
 
     size_t pos = 0;
     for (size_t i = 0; i < m_inp_layouts_size; i++) {
@@ -46,9 +47,12 @@ AlgorithmCache::KeyStorage AlgorithmCache::Key::build_key_storage() const {
     switch (m_handle->type()) {
 #if MEGDNN_WITH_CUDA
         case Handle::HandleType::CUDA: {
-            int cuda_rt = -1;
-            cuda_check(cudaRuntimeGetVersion(&cuda_rt));
-            cuda_rt /= 1000;
+            // the runtime does not change in a process
+            static int cuda_rt = [] {
+                int ver = -1;
+                cuda_check(cudaRuntimeGetVersion(&ver));
+                return ver / 1000;
+            }();
             auto&& handle = static_cast<megdnn::cuda::HandleImpl*>(m_handle);
             auto&& prop = handle->device_prop();
             buf[pos++] = prop.major;
@@ -61,9 +65,16 @@ AlgorithmCache::KeyStorage AlgorithmCache::Key::build_key_storage() const {
         case Handle::HandleType::ROCM: {
             auto&& handle = static_cast<megdnn::rocm::HandleImpl*>(m_handle);
             auto&& prop = handle->device_prop();
-            int drv = -1, hip_rt = -1;
-            hip_check(hipDriverGetVersion(&drv));
-            hip_check(hipRuntimeGetVersion(&hip_rt));
+            static int drv = [] {
+                int ver = -1;
+                hip_check(hipDriverGetVersion(&ver));
+                return ver;
+            }();
+            static int hip_rt = [] {
+                int ver = -1;
+                hip_check(hipRuntimeGetVersion(&ver));
+                return ver;
+            }();
             buf[pos++] = prop.major;
             buf[pos++] = prop.minor;
             buf[pos++] = drv;
@@ -96,19 +107,29 @@ AlgorithmCache::KeyStorage AlgorithmCache::Key::build_key_storage() const {
     }
 
     m_buf.resize(pos);
-    SmallVector<size_t> tmp(buf, buf + pos);
-    m_buf = std::move(tmp);
+}
 
-    size_t k1 = XXHash64CT::hash((const char*)buf, pos * sizeof(size_t), 20220328);
+AlgorithmCache::KeyStorage AlgorithmCache::Key::hash_key_buf() const {
+    size_t k1 = XXHash64CT::hash(
+            (const char*)m_buf.data(), m_buf.size() * sizeof(size_t), 20220328);
     size_t k2 = XXHash64CT::hash((const char*)m_param_ptr, m_param_size, 20220328);
 
     return {k1, k2};
 }
 
+AlgorithmCache::KeyStorage AlgorithmCache::Key::build_key_storage() const {
+    build_key_buf();
+    return hash_key_buf();
+}
+
 void AlgorithmCache::put(const Key& key, Result& result) {
-    MEGDNN_LOCK_GUARD(m_mtx);
-    if (result.policy.algo.valid())
-        m_heuristic_cache[key.build_key_storage()] = result;
+    if (!result.policy.algo.valid())
+        return;
+    auto ks = key.build_key_storage();
+    auto&& sd = shard(ks);
+    MEGDNN_LOCK_GUARD(sd.mtx);
+    sd.heuristic_cache[ks] = result;
+    ++m_generation;
 }
 
 template <typename T>
@@ -127,17 +148,48 @@ bool is_same_buf(
 }
 
 AlgorithmCache::Result AlgorithmCache::get(const Key& key) {
-    MEGDNN_LOCK_GUARD(m_mtx);
-    KeyStorage ks = key.build_key_storage();
-    auto iter = m_heuristic_cache.find(ks);
-    if (iter != m_heuristic_cache.end()) {
+    key.build_key_buf();
+    return get_built(key);
+}
+
+AlgorithmCache::Result AlgorithmCache::get(const Key& key, LastEntry& last) {
+    key.build_key_buf();
+    size_t generation = m_generation.load(std::memory_order_acquire);
+    if (last.generation == generation &&
+        is_same_buf(
+                key.m_buf.data(), key.m_buf.size(), last.key_buf.data(),
+                last.key_buf.size()) &&
+        is_same_buf(
+                (char*)(key.m_param_ptr), key.m_param_size, last.param_buf.data(),
+                last.param_buf.size())) {
+        return Result{last.policy, last.workspace, {}, {}};
+    }
+    auto rst = get_built(key);
+    if (rst.policy.algo.valid()) {
+        last.generation = generation;
+        last.key_buf = key.m_buf;
+        last.param_buf.assign(
+                (char*)key.m_param_ptr, (char*)key.m_param_ptr + key.m_param_size);
+        last.policy = rst.policy;
+        last.workspace = rst.workspace;
+    }
+    return rst;
+}
+
+AlgorithmCache::Result AlgorithmCache::get_built(const Key& key) {
+    KeyStorage ks = key.hash_key_buf();
+    auto&& sd = shard(ks);
+    MEGDNN_LOCK_GUARD(sd.mtx);
+    auto iter = sd.heuristic_cache.find(ks);
+    if (iter != sd.heuristic_cache.end()) {
         if (is_same_buf(
                     key.m_buf.data(), key.m_buf.size(), iter->second.m_buf.data(),
                     iter->second.m_buf.size()) &&
             is_same_buf(
                     (char*)(key.m_param_ptr), key.m_param_size,
                     iter->second.m_param_buf.data(), iter->second.m_param_buf.size())) {
-            return iter->second;
+            // the buffers are only needed to put a missed key back
+            return Result{iter->second.policy, iter->second.workspace, {}, {}};
         }
         megdnn_log_warn(
                 "hash collision occurs in heuristic cache with key: (%zu, %zu)", ks.k1,
@@ -149,6 +201,9 @@ AlgorithmCache::Result AlgorithmCache::get(const Key& key) {
 }
 
 void AlgorithmCache::clear() {
-    MEGDNN_LOCK_GUARD(m_mtx);
-    m_heuristic_cache.clear();
+    for (auto&& sd : m_shards) {
+        MEGDNN_LOCK_GUARD(sd.mtx);
+        sd.heuristic_cache.clear();
+    }
+    ++m_generation;
 }
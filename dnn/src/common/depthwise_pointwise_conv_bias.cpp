@@ -0,0 +1,87 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+void DepthwisePointwiseConvBias::deduce_layout(
+        const TensorLayout& src, const TensorLayout& dw_filter,
+        const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+        const TensorLayout& pw_bias, TensorLayout& dst) {
+    MEGDNN_MARK_USED_VAR(dw_bias);
+    MEGDNN_MARK_USED_VAR(pw_bias);
+    megdnn_assert(
+            src.ndim == 5 && src[4] == 4 && dw_filter.ndim == 6 &&
+                    pw_filter.ndim == 6 && pw_filter[4] == 4 && pw_filter[5] == 4,
+            "depthwise pointwise conv_bias only supports NCHW44: src=%s dw=%s "
+            "pw=%s",
+            src.to_string().c_str(), dw_filter.to_string().c_str(),
+            pw_filter.to_string().c_str());
+    auto&& p = param();
+    size_t fh = dw_filter[3], fw = dw_filter[4];
+    size_t ih = src[2] + 2 * p.pad_h, iw = src[3] + 2 * p.pad_w;
+    megdnn_assert(
+            p.stride_h > 0 && p.stride_w > 0 && ih >= fh && iw >= fw,
+            "invalid channel wise conv: src=%s dw=%s", src.to_string().c_str(),
+            dw_filter.to_string().c_str());
+    size_t oh = (ih - fh) / p.stride_h + 1;
+    size_t ow = (iw - fw) / p.stride_w + 1;
+    dst = TensorLayout{{src[0], pw_filter[0], oh, ow, 4}, src.dtype};
+}
+
+void DepthwisePointwiseConvBias::check_exec(
+        const TensorLayout& src, const TensorLayout& dw_filter,
+        const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+        const TensorLayout& pw_bias, const TensorLayout& dst,
+        size_t workspace_in_bytes) {
+    auto errmsg = [&]() {
+        return megdnn_layout_msg(src) + ", " + megdnn_layout_msg(dw_filter) + ", " +
+               megdnn_layout_msg(dw_bias) + ", " + megdnn_layout_msg(pw_filter) +
+               ", " + megdnn_layout_msg(pw_bias) + ", " + megdnn_layout_msg(dst);
+    };
+    MEGDNN_MARK_USED_VAR(errmsg);
+    megdnn_assert(
+            src.dtype.enumv() == DTypeEnum::Float32,
+            "depthwise pointwise conv_bias only supports float32: %s",
+            errmsg().c_str());
+    megdnn_assert_eq_dtype(src, dw_filter);
+    megdnn_assert_eq_dtype(src, dw_bias);
+    megdnn_assert_eq_dtype(src, pw_filter);
+    megdnn_assert_eq_dtype(src, pw_bias);
+
+    TensorLayout dst_expected;
+    deduce_layout(src, dw_filter, dw_bias, pw_filter, pw_bias, dst_expected);
+    megdnn_assert_eq_layout(dst_expected, dst);
+
+    size_t cb = src[1], ocb = pw_filter[0];
+    megdnn_assert(
+            dw_filter[0] == cb && dw_filter[1] == 1 && dw_filter[2] == 1 &&
+                    dw_filter[5] == 4,
+            "channel wise filter should be (c / 4, 1, 1, fh, fw, 4): %s",
+            errmsg().c_str());
+    megdnn_assert(
+            pw_filter[1] == cb && pw_filter[2] == 1 && pw_filter[3] == 1,
+            "pointwise filter should be (oc / 4, c / 4, 1, 1, 4, 4): %s",
+            errmsg().c_str());
+    auto check_bias = [&](const TensorLayout& bias, size_t nr_blocks) {
+        megdnn_assert(
+                bias.ndim == 5 && bias[0] == 1 && bias[1] == nr_blocks &&
+                        bias[2] == 1 && bias[3] == 1 && bias[4] == 4,
+                "bias should broadcast along channels: %s", errmsg().c_str());
+    };
+    check_bias(dw_bias, cb);
+    check_bias(pw_bias, ocb);
+
+    megdnn_assert_contiguous(src);
+    megdnn_assert_contiguous(dw_filter);
+    megdnn_assert_contiguous(dw_bias);
+    megdnn_assert_contiguous(pw_filter);
+    megdnn_assert_contiguous(pw_bias);
+    megdnn_assert_contiguous(dst);
+    auto required_workspace_in_bytes = get_workspace_in_bytes(
+            src, dw_filter, dw_bias, pw_filter, pw_bias, dst);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,109 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+void EmbeddingBagBase::check_bags(
+        const TensorLayout& indices, const TensorLayout& offsets,
+        const TensorLayout& per_sample_weights) {
+    megdnn_assert(
+            indices.ndim == 1 && indices.dtype == dtype::Int32(),
+            "indices should be int32 (nr_indices): %s", indices.to_string().c_str());
+    megdnn_assert(
+            offsets.ndim == 1 && offsets.dtype == dtype::Int32(),
+            "offsets should be int32 (batch): %s", offsets.to_string().c_str());
+    megdnn_assert_contiguous(indices);
+    megdnn_assert_contiguous(offsets);
+    if (has_per_sample_weights(per_sample_weights)) {
+        megdnn_assert(
+                param().mode == Param::Mode::SUM,
+                "per_sample_weights is only supported in SUM mode");
+        megdnn_assert(
+                per_sample_weights.ndim == 1 &&
+                        per_sample_weights.shape[0] == indices.shape[0],
+                "per_sample_weights should be (nr_indices): %s",
+                per_sample_weights.to_string().c_str());
+        megdnn_assert_contiguous(per_sample_weights);
+    }
+}
+
+void EmbeddingBagForward::deduce_layout(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+        TensorLayout& dst, TensorLayout& max_idx) {
+    MEGDNN_MARK_USED_VAR(indices);
+    MEGDNN_MARK_USED_VAR(per_sample_weights);
+    megdnn_assert(weight.ndim == 2, "%s", weight.to_string().c_str());
+    megdnn_assert(offsets.ndim == 1, "%s", offsets.to_string().c_str());
+    dst = TensorLayout{{offsets.shape[0], weight.shape[1]}, weight.dtype};
+    if (param().mode == Param::Mode::MAX) {
+        max_idx = TensorLayout{{offsets.shape[0], weight.shape[1]}, dtype::Int32()};
+    } else {
+        max_idx = TensorLayout{{0}, dtype::Int32()};
+    }
+}
+
+void EmbeddingBagForward::check_exec(
+        const TensorLayout& weight, const TensorLayout& indices,
+        const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+        const TensorLayout& dst, const TensorLayout& max_idx,
+        size_t workspace_in_bytes) {
+    megdnn_assert(
+            weight.ndim == 2 && weight.dtype.category() == DTypeCategory::FLOAT,
+            "weight should be float (num_embeddings, dim): %s",
+            weight.to_string().c_str());
+    megdnn_assert_contiguous(weight);
+    check_bags(indices, offsets, per_sample_weights);
+    if (has_per_sample_weights(per_sample_weights)) {
+        megdnn_assert(per_sample_weights.dtype == weight.dtype);
+    }
+    TensorLayout dst_expected, max_idx_expected;
+    deduce_layout(
+            weight, indices, offsets, per_sample_weights, dst_expected,
+            max_idx_expected);
+    megdnn_assert_eq_layout(dst_expected, dst);
+    megdnn_assert_contiguous(dst);
+    if (param().mode == Param::Mode::MAX) {
+        megdnn_assert_eq_layout(max_idx_expected, max_idx);
+        megdnn_assert_contiguous(max_idx);
+    }
+    auto required_workspace_in_bytes = get_workspace_in_bytes(
+            weight, indices, offsets, per_sample_weights, dst, max_idx);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+void EmbeddingBagBackward::check_exec(
+        const TensorLayout& diff, const TensorLayout& indices,
+        const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+        const TensorLayout& max_idx, const TensorLayout& grad,
+        size_t workspace_in_bytes) {
+    megdnn_assert(
+            grad.ndim == 2 && grad.dtype.category() == DTypeCategory::FLOAT,
+            "grad should be float (num_embeddings, dim): %s",
+            grad.to_string().c_str());
+    megdnn_assert_contiguous(grad);
+    check_bags(indices, offsets, per_sample_weights);
+    megdnn_assert(
+            diff.ndim == 2 && diff.shape[0] == offsets.shape[0] &&
+                    diff.shape[1] == grad.shape[1] && diff.dtype == grad.dtype,
+            "diff should be (batch, dim) in the dtype of grad: %s",
+            diff.to_string().c_str());
+    megdnn_assert_contiguous(diff);
+    if (has_per_sample_weights(per_sample_weights)) {
+        megdnn_assert(per_sample_weights.dtype == grad.dtype);
+    }
+    if (param().mode == Param::Mode::MAX) {
+        megdnn_assert(
+                max_idx.dtype == dtype::Int32() && max_idx.eq_shape(diff),
+                "max_idx should be int32 (batch, dim): %s",
+                max_idx.to_string().c_str());
+        megdnn_assert_contiguous(max_idx);
+    }
+    auto required_workspace_in_bytes = get_workspace_in_bytes(
+            diff, indices, offsets, per_sample_weights, max_idx, grad);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
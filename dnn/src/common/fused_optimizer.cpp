@@ -0,0 +1,61 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+void FusedOptimizerUpdate::deduce_layout(
+        const TensorLayout& param, const TensorLayout& grad,
+        const TensorLayout& exp_avg, const TensorLayout& exp_avg_sq,
+        const TensorLayout& offsets, TensorLayout& new_param,
+        TensorLayout& new_exp_avg, TensorLayout& new_exp_avg_sq) {
+    MEGDNN_MARK_USED_VAR(grad);
+    MEGDNN_MARK_USED_VAR(offsets);
+    new_param = param;
+    new_exp_avg = exp_avg;
+    new_exp_avg_sq = exp_avg_sq;
+}
+
+void FusedOptimizerUpdate::check_exec(
+        const TensorLayout& param, const TensorLayout& grad,
+        const TensorLayout& exp_avg, const TensorLayout& exp_avg_sq,
+        const TensorLayout& offsets, const TensorLayout& new_param,
+        const TensorLayout& new_exp_avg, const TensorLayout& new_exp_avg_sq,
+        size_t workspace_in_bytes) {
+    auto errmsg = [&]() {
+        return megdnn_layout_msg(param) + ", " + megdnn_layout_msg(grad) + ", " +
+               megdnn_layout_msg(exp_avg) + ", " + megdnn_layout_msg(exp_avg_sq) +
+               ", " + megdnn_layout_msg(offsets);
+    };
+    MEGDNN_MARK_USED_VAR(errmsg);
+    megdnn_assert(
+            param.ndim == 1 && param.dtype == dtype::Float32(),
+            "param of fused optimizer should be a 1-dim float32 buffer: %s",
+            errmsg().c_str());
+    megdnn_assert(
+            grad.dtype.category() == DTypeCategory::FLOAT,
+            "bad grad dtype of fused optimizer: %s", errmsg().c_str());
+    megdnn_assert(grad.eq_shape(param), "%s", errmsg().c_str());
+    megdnn_assert_eq_layout(param, exp_avg);
+    megdnn_assert_eq_layout(param, exp_avg_sq);
+    megdnn_assert(
+            offsets.ndim == 1 && offsets.shape[0] % 2 == 0 &&
+                    offsets.dtype == dtype::Int32(),
+            "offsets of fused optimizer should be int32 in the format of "
+            "ParamPackConcat: %s",
+            errmsg().c_str());
+    megdnn_assert_eq_layout(param, new_param);
+    megdnn_assert_eq_layout(exp_avg, new_exp_avg);
+    megdnn_assert_eq_layout(exp_avg_sq, new_exp_avg_sq);
+    megdnn_assert_contiguous(param);
+    megdnn_assert_contiguous(grad);
+    megdnn_assert_contiguous(offsets);
+
+    auto required_workspace_in_bytes = get_workspace_in_bytes(
+            param, grad, exp_avg, exp_avg_sq, offsets, new_param, new_exp_avg,
+            new_exp_avg_sq);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,89 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+void FusedPreprocess::deduce_layout(
+        const TensorLayout& src, const TensorLayout& norm, TensorLayout& dst) {
+    MEGDNN_MARK_USED_VAR(norm);
+    megdnn_assert(
+            src.ndim == 4, "src of fused preprocess should be NHWC: %s",
+            src.to_string().c_str());
+    size_t N = src[0], C = src[3], OH = param().out_h, OW = param().out_w;
+    megdnn_assert(OH > 0 && OW > 0, "output size of fused preprocess is not set");
+    if (param().format == Param::Format::NCHW44) {
+        dst = TensorLayout{{N, div_ceil<size_t>(C, 4), OH, OW, 4}, dtype::Float32()};
+    } else {
+        dst = TensorLayout{{N, C, OH, OW}, dtype::Float32()};
+    }
+}
+
+void FusedPreprocess::get_coords(size_t in_size, size_t out_size, Coord* coords) {
+    float scale = static_cast<float>(out_size) / in_size;
+    for (size_t i = 0; i < out_size; ++i) {
+        if (param().imode == Param::InterpolationMode::INTER_NEAREST) {
+            int idx = std::min(static_cast<int>(i / scale), int(in_size) - 1);
+            coords[i] = {idx, idx, 0.f};
+            continue;
+        }
+        if (in_size == 1) {
+            coords[i] = {0, 0, 0.f};
+            continue;
+        }
+        //! the same as the linear coordinates of Resize
+        float alpha = (i + 0.5f) / scale - 0.5f;
+        int idx = static_cast<int>(std::floor(alpha));
+        alpha -= idx;
+        if (idx < 0) {
+            idx = 0;
+            alpha = 0;
+        } else if (idx + 1 >= static_cast<int>(in_size)) {
+            idx = in_size - 2;
+            alpha = 1;
+        }
+        coords[i] = {idx, idx + 1, alpha};
+    }
+}
+
+void FusedPreprocess::check_exec(
+        const TensorLayout& src, const TensorLayout& norm, const TensorLayout& dst,
+        size_t workspace_in_bytes) {
+    auto errmsg = [&]() {
+        return megdnn_layout_msg(src) + ", " + megdnn_layout_msg(norm) + ", " +
+               megdnn_layout_msg(dst);
+    };
+    MEGDNN_MARK_USED_VAR(errmsg);
+    megdnn_assert(
+            src.dtype.enumv() == DTypeEnum::Uint8,
+            "fused preprocess only supports Uint8 src: %s", errmsg().c_str());
+    megdnn_assert(
+            param().format == Param::Format::NCHW ||
+                    param().format == Param::Format::NCHW44,
+            "fused preprocess only supports NCHW and NCHW44 dst");
+    megdnn_assert(
+            param().imode == Param::InterpolationMode::INTER_NEAREST ||
+                    param().imode == Param::InterpolationMode::INTER_LINEAR,
+            "fused preprocess only supports nearest and linear interpolation");
+
+    TensorLayout dst_expected;
+    deduce_layout(src, norm, dst_expected);
+    megdnn_assert_eq_layout(dst_expected, dst);
+
+    size_t C = src[3];
+    megdnn_assert(
+            C == 1 || C == 3 || C == 4, "fused preprocess expects 1, 3 or 4 channels");
+    megdnn_assert(
+            norm.dtype.enumv() == DTypeEnum::Float32 && norm.ndim == 2 &&
+                    norm[0] == 2 && norm[1] == C,
+            "norm of fused preprocess should be (2, c) float32: %s", errmsg().c_str());
+
+    megdnn_assert_contiguous(src);
+    megdnn_assert_contiguous(norm);
+    megdnn_assert_contiguous(dst);
+    auto required_workspace_in_bytes = get_workspace_in_bytes(src, norm, dst);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -144,6 +144,7 @@ private:
     cb(PoissonRNG) \
     cb(PermutationRNG) \
     cb(MultinomialRNG) \
+    cb(LogitsSamplingRNG) \
     cb(ShuffleRNGForward) \
     cb(ShuffleRNGBackward) \
     cb(ExponentialRNG) \
@@ -205,6 +206,7 @@ private:
     cb(PaddingBackward) \
     cb(LayerNormForward) \
     cb(LayerNormBackward) \
+    cb(ResidualLayerNormForward) \
     cb(GeneralNormForward) \
     cb(GeneralNormBackward) \
     cb(DropoutForward) \
@@ -215,6 +217,7 @@ private:
     cb(RNNBackward) \
     cb(LSTM) \
     cb(LAMBUpdate) \
+    cb(FusedOptimizerUpdate) \
     cb(LSTMBackward) \
     cb(SoftmaxForward) \
     cb(SoftmaxBackward) \
@@ -227,7 +230,15 @@ private:
     cb(MaskedFill) \
     cb(MultiHeadAttnForward)\
     cb(MultiHeadAttnBackward) \
+    cb(KVCacheAppend) \
+    cb(KVCacheAttention) \
+    cb(EmbeddingBagForward) \
+    cb(EmbeddingBagBackward) \
     cb(Cross)  \
+    cb(WeightOnlyQuantMatrixMul) \
+    cb(DepthwisePointwiseConvBias) \
+    cb(StructuredSparseMatrixMul) \
+    cb(FusedPreprocess) \
     cb(WhereForward)    \
     cb(WhereBackward) \
     cb(NonZero)
@@ -0,0 +1,122 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+namespace {
+
+//! check the cache and the block table, return the head_dim of the cache
+size_t check_kv_cache(
+        const TensorLayout& k_cache, const TensorLayout& v_cache,
+        const TensorLayout& positions, const TensorLayout& block_table,
+        size_t batch, size_t num_heads, DType dtype) {
+    megdnn_assert(
+            k_cache.ndim == 4 && k_cache.dtype == dtype,
+            "kv cache should be (nr_blocks, num_heads, block_size, head_dim) in the "
+            "dtype of the queries: %s",
+            k_cache.to_string().c_str());
+    megdnn_assert(k_cache.shape[1] == num_heads, "%s", k_cache.to_string().c_str());
+    megdnn_assert_eq_layout(k_cache, v_cache);
+    megdnn_assert_contiguous(k_cache);
+    megdnn_assert(
+            positions.ndim == 1 && positions.shape[0] == batch &&
+                    positions.dtype == dtype::Int32(),
+            "positions should be int32 (batch): %s", positions.to_string().c_str());
+    megdnn_assert(
+            block_table.ndim == 2 && block_table.shape[0] == batch &&
+                    block_table.dtype == dtype::Int32(),
+            "block_table should be int32 (batch, max_nr_blocks): %s",
+            block_table.to_string().c_str());
+    megdnn_assert_contiguous(positions);
+    megdnn_assert_contiguous(block_table);
+    return k_cache.shape[3];
+}
+
+}  // namespace
+
+void KVCacheAppend::deduce_layout(
+        const TensorLayout& qkv, const TensorLayout& positions,
+        const TensorLayout& block_table, const TensorLayout& k_cache,
+        const TensorLayout& v_cache, TensorLayout& q) {
+    MEGDNN_MARK_USED_VAR(positions);
+    MEGDNN_MARK_USED_VAR(block_table);
+    MEGDNN_MARK_USED_VAR(k_cache);
+    MEGDNN_MARK_USED_VAR(v_cache);
+    megdnn_assert(qkv.ndim == 3, "%s", qkv.to_string().c_str());
+    size_t num_heads = param().num_heads;
+    size_t head_dim = qkv.shape[2] / (3 * num_heads);
+    q = TensorLayout{{qkv.shape[0], num_heads, qkv.shape[1], head_dim}, qkv.dtype};
+}
+
+void KVCacheAppend::check_exec(
+        const TensorLayout& qkv, const TensorLayout& positions,
+        const TensorLayout& block_table, const TensorLayout& k_cache,
+        const TensorLayout& v_cache, const TensorLayout& q,
+        size_t workspace_in_bytes) {
+    auto&& p = param();
+    megdnn_assert(
+            qkv.ndim == 3 && qkv.dtype.category() == DTypeCategory::FLOAT &&
+                    p.num_heads > 0 && qkv.shape[2] % (3 * p.num_heads) == 0,
+            "qkv should be (batch, seqlen, 3 * num_heads * head_dim): %s",
+            qkv.to_string().c_str());
+    megdnn_assert_contiguous(qkv);
+    size_t head_dim = check_kv_cache(
+            k_cache, v_cache, positions, block_table, qkv.shape[0], p.num_heads,
+            qkv.dtype);
+    megdnn_assert(
+            qkv.shape[2] == 3 * p.num_heads * head_dim,
+            "head_dim mismatch between qkv and kv cache: qkv=%s k_cache=%s",
+            qkv.to_string().c_str(), k_cache.to_string().c_str());
+    megdnn_assert(
+            p.rotary_dim % 2 == 0 && p.rotary_dim <= head_dim,
+            "rotary_dim should be even and no larger than head_dim, got %u vs %zu",
+            p.rotary_dim, head_dim);
+    TensorLayout q_expected;
+    deduce_layout(qkv, positions, block_table, k_cache, v_cache, q_expected);
+    megdnn_assert_eq_layout(q_expected, q);
+
+    auto required_workspace_in_bytes =
+            get_workspace_in_bytes(qkv, positions, block_table, k_cache, v_cache, q);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+void KVCacheAttention::deduce_layout(
+        const TensorLayout& q, const TensorLayout& k_cache,
+        const TensorLayout& v_cache, const TensorLayout& positions,
+        const TensorLayout& block_table, TensorLayout& dst) {
+    MEGDNN_MARK_USED_VAR(k_cache);
+    MEGDNN_MARK_USED_VAR(v_cache);
+    MEGDNN_MARK_USED_VAR(positions);
+    MEGDNN_MARK_USED_VAR(block_table);
+    megdnn_assert(q.ndim == 4, "%s", q.to_string().c_str());
+    dst = TensorLayout{{q.shape[0], q.shape[2], q.shape[1] * q.shape[3]}, q.dtype};
+}
+
+void KVCacheAttention::check_exec(
+        const TensorLayout& q, const TensorLayout& k_cache,
+        const TensorLayout& v_cache, const TensorLayout& positions,
+        const TensorLayout& block_table, const TensorLayout& dst,
+        size_t workspace_in_bytes) {
+    megdnn_assert(
+            q.ndim == 4 && q.dtype.category() == DTypeCategory::FLOAT,
+            "q should be (batch, num_heads, seqlen, head_dim): %s",
+            q.to_string().c_str());
+    megdnn_assert_contiguous(q);
+    size_t head_dim = check_kv_cache(
+            k_cache, v_cache, positions, block_table, q.shape[0], q.shape[1],
+            q.dtype);
+    megdnn_assert(
+            q.shape[3] == head_dim, "head_dim mismatch: q=%s k_cache=%s",
+            q.to_string().c_str(), k_cache.to_string().c_str());
+    TensorLayout dst_expected;
+    deduce_layout(q, k_cache, v_cache, positions, block_table, dst_expected);
+    megdnn_assert_eq_layout(dst_expected, dst);
+
+    auto required_workspace_in_bytes =
+            get_workspace_in_bytes(q, k_cache, v_cache, positions, block_table, dst);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -96,6 +96,28 @@ void LayerNormForward::check_exec(
     megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
 }
 
+void ResidualLayerNormForward::deduce_layout(
+        const TensorLayout& data, const TensorLayout& residual,
+        const TensorLayout& weight, const TensorLayout& bias, TensorLayout& dst,
+        TensorLayout& sum, TensorLayout& mean, TensorLayout& rstd) {
+    MEGDNN_MARK_USED_VAR(residual);
+    deduce_layout_fwd(data, weight, bias, dst, mean, rstd);
+    sum = data;
+}
+
+void ResidualLayerNormForward::check_exec(
+        const TensorLayout& data, const TensorLayout& residual,
+        const TensorLayout& weight, const TensorLayout& bias, const TensorLayout& dst,
+        const TensorLayout& sum, const TensorLayout& mean, const TensorLayout& rstd,
+        size_t workspace_in_bytes) {
+    check_layout_fwd(data, weight, bias, dst, mean, rstd);
+    megdnn_assert_eq_layout(data, residual);
+    megdnn_assert_eq_layout(data, sum);
+    auto required_workspace_in_bytes = get_workspace_in_bytes(
+            data, residual, weight, bias, dst, sum, mean, rstd);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
 void LayerNormBackward::deduce_layout(
         const TensorLayout& diff, const TensorLayout& data, const TensorLayout& weight,
         const TensorLayout& mean, const TensorLayout& rstd, TensorLayout& ddata,
@@ -10,7 +10,11 @@ void MatrixMulForward::deduce_dtype(DType A, DType B, DType& C) {
     // expected dtypes. If the user does not specify an output dtype by setting
     // C = {}, we deduce one (C_dtype) and return it to the user.
     DType C_candi, C_candi2;
-    if (A.category() == DTypeCategory::FLOAT) {
+    if (A.enumv() == DTypeEnum::Float8E4M3 || A.enumv() == DTypeEnum::Float8E5M2) {
+        //! fp8 is only used for storage, the products are accumulated in float32
+        C_candi = dtype::Float32();
+        DNN_INC_FLOAT16(C_candi2 = dtype::Float16());
+    } else if (A.category() == DTypeCategory::FLOAT) {
         C_candi = A;
     } else if (A.enumv() == DTypeEnum::Int8) {
         C_candi = dtype::Int32();
@@ -25,6 +29,7 @@ void MatrixMulForward::deduce_dtype(DType A, DType B, DType& C) {
         C_candi = dtype::QuantizedS32(mul_scale(A, B));
     } else if (A.enumv() == DTypeEnum::QuantizedS4) {
         C_candi = dtype::QuantizedS16(mul_scale(A, B));
+        C_candi2 = dtype::QuantizedS32(mul_scale(A, B));
     }
     if (!C.valid()) {
         C = C_candi;
@@ -38,7 +43,9 @@ void MatrixMulForward::deduce_dtype(DType A, DType B, DType& C) {
             "                       MatMul(QuantizedS8, QuantizedS8)\n"
             "                       MatMul(Quantized8Asymm, Quantized8Asymm)\n"
             "                       MatMul(Quantized4Asymm, Quantized4Asymm)\n"
-            "                       MatMul(QuantizedS4, QuantizedS4)\n",
+            "                       MatMul(QuantizedS4, QuantizedS4) -> "
+            "QuantizedS16/QuantizedS32\n"
+            "                       MatMul(Float8, Float8) -> Float32/Float16\n",
             A.name(), B.name(), C.name());
 }
 
@@ -186,7 +193,13 @@ void MatrixMulForward::check_exec(
     }
 
     megdnn_assert(A.dtype.enumv() == B.dtype.enumv());
-    if (A.dtype.category() == DTypeCategory::FLOAT) {
+    if (A.dtype.enumv() == DTypeEnum::Float8E4M3 ||
+        A.dtype.enumv() == DTypeEnum::Float8E5M2) {
+        megdnn_assert(
+                C.dtype == dtype::Float32()
+                        DNN_INC_FLOAT16(|| C.dtype == dtype::Float16()),
+                "%s", errmsg().c_str());
+    } else if (A.dtype.category() == DTypeCategory::FLOAT) {
         megdnn_assert(A.dtype == C.dtype);
     } else if (A.dtype == dtype::Int8()) {
         megdnn_assert(C.dtype == dtype::Int16() || C.dtype == dtype::Int32());
@@ -196,7 +209,9 @@ void MatrixMulForward::check_exec(
             A.dtype.enumv() == DTypeEnum::Quantized4Asymm) {
         megdnn_assert(C.dtype.enumv() == DTypeEnum::QuantizedS32);
     } else if (A.dtype.enumv() == DTypeEnum::QuantizedS4) {
-        megdnn_assert(C.dtype.enumv() == DTypeEnum::QuantizedS16);
+        megdnn_assert(
+                C.dtype.enumv() == DTypeEnum::QuantizedS16 ||
+                C.dtype.enumv() == DTypeEnum::QuantizedS32);
     }
     megdnn_assert(
             param().compute_mode != Param::ComputeMode::FLOAT32 DNN_INC_FLOAT16(
@@ -84,6 +84,10 @@ DEF(Linspace, 1, true, false);
 DEF(Eye, 1, true, false);
 DEF(Diag, 2, true, true);
 DEF(Cross, 3, true, true);
+DEF(WeightOnlyQuantMatrixMul, 4, true, true);
+DEF(StructuredSparseMatrixMul, 4, true, true);
+DEF(FusedPreprocess, 3, true, true);
+DEF(DepthwisePointwiseConvBias, 6, true, true);
 DEF(Flip, 2, true, true);
 DEF(ROICopy, 2, true, true);
 DEF(Rotate, 2, true, true);
@@ -124,6 +128,7 @@ DEF(GammaRNG, 3, true, true);
 DEF(BetaRNG, 3, true, true);
 DEF(PoissonRNG, 2, true, true);
 DEF(MultinomialRNG, 2, true, true);
+DEF(LogitsSamplingRNG, 2, true, true);
 DEF(PermutationRNG, 1, true, true);
 DEF(ShuffleRNGForward, 3, true, true);
 DEF(ShuffleRNGBackward, 3, true, false);
@@ -135,9 +140,11 @@ DEF(LSQBackward, 7, true, false);
 DEF(Fill, 1, true, false);
 DEF(LayerNormForward, 6, true, true);
 DEF(LayerNormBackward, 8, true, true);
+DEF(ResidualLayerNormForward, 8, true, true);
 DEF(GeneralNormForward, 6, true, true);
 DEF(GeneralNormBackward, 8, true, true);
 DEF(LAMBUpdate, 7, true, true);
+DEF(FusedOptimizerUpdate, 8, true, true);
 DEF(DropoutForward, 3, true, true);
 DEF(DropoutBackward, 3, true, true);
 DEF(RNNCellForward, 7, true, true);
@@ -156,6 +163,10 @@ DEF(GroupNormBackward, 8, true, true);
 DEF(MaskedFill, 3, true, true);
 DEF(MultiHeadAttnForward, 11, true, true);
 DEF(MultiHeadAttnBackward, 15, true, true);
+DEF(KVCacheAppend, 6, true, true);
+DEF(KVCacheAttention, 6, true, true);
+DEF(EmbeddingBagForward, 6, true, true);
+DEF(EmbeddingBagBackward, 6, true, false);
 DEF(Resize3D, 2, true, false);
 }  // namespace megdnn
 
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include "megdnn/arch.h"
+
+namespace megdnn {
+namespace philox {
+
+/*!
+ * \brief counter-based Philox4x32-10 generator shared by host and device code
+ *
+ * The numbers are a pure function of (key, counter), so a stream given by a
+ * seed and an offset is the same on every device and can be generated in any
+ * order. Each counter gives 4 numbers; the element i of a stream starting at
+ * counter offset is the word i % 4 of counter offset + i / 4.
+ */
+struct Philox4x32 {
+    uint32_t v[4];
+
+    static MEGDNN_HOST MEGDNN_DEVICE MEGDNN_FORCE_INLINE uint32_t
+    mulhilo(uint32_t a, uint32_t b, uint32_t& hi) {
+        uint64_t prod = static_cast<uint64_t>(a) * b;
+        hi = static_cast<uint32_t>(prod >> 32);
+        return static_cast<uint32_t>(prod);
+    }
+
+    //! generate the 4 numbers of the counter for the seed
+    MEGDNN_HOST MEGDNN_DEVICE Philox4x32(uint64_t seed, uint64_t counter) {
+        uint32_t k0 = static_cast<uint32_t>(seed),
+                 k1 = static_cast<uint32_t>(seed >> 32);
+        v[0] = static_cast<uint32_t>(counter);
+        v[1] = static_cast<uint32_t>(counter >> 32);
+        v[2] = v[3] = 0;
+#pragma unroll
+        for (int round = 0; round < 10; ++round) {
+            uint32_t hi0, hi1;
+            uint32_t lo0 = mulhilo(0xD2511F53u, v[0], hi0),
+                     lo1 = mulhilo(0xCD9E8D57u, v[2], hi1);
+            v[0] = hi1 ^ v[1] ^ k0;
+            v[1] = lo1;
+            v[2] = hi0 ^ v[3] ^ k1;
+            v[3] = lo0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+    }
+
+    //! uniform float in [0, 1) with 24 random bits
+    static MEGDNN_HOST MEGDNN_DEVICE MEGDNN_FORCE_INLINE float uniform(uint32_t x) {
+        return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+//! number of counters used by a stream of size numbers
+static MEGDNN_HOST MEGDNN_DEVICE MEGDNN_FORCE_INLINE uint64_t
+nr_counters(uint64_t size) {
+    return (size + 3) / 4;
+}
+
+}  // namespace philox
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -111,6 +111,26 @@ void MultinomialRNG::check_exec(
     megdnn_assert(m_param.replacement || m_param.num_samples <= probs.shape[1]);
 }
 
+void LogitsSamplingRNG::deduce_layout(const TensorLayout& logits, TensorLayout& dst) {
+    dst = TensorLayout(TensorShape({logits.shape[0]}), dtype::Int32());
+}
+
+void LogitsSamplingRNG::check_exec(
+        const TensorLayout& logits, const TensorLayout& dst,
+        size_t workspace_in_bytes) {
+    megdnn_assert(logits.is_contiguous() && dst.is_contiguous());
+    megdnn_assert(logits.ndim == 2 && logits.shape[1] > 0);
+    TensorLayout dst_expected;
+    deduce_layout(logits, dst_expected);
+    megdnn_assert_eq_layout(dst_expected, dst);
+    megdnn_assert(logits.dtype.category() == DTypeCategory::FLOAT);
+    megdnn_assert(
+            m_param.temperature > 0 && m_param.top_p > 0 && m_param.top_p <= 1,
+            "bad param for logits sampling: temperature=%g top_p=%g",
+            m_param.temperature, m_param.top_p);
+    megdnn_assert(workspace_in_bytes >= get_workspace_in_bytes(logits, dst));
+}
+
 #define INST_CHECK_EXEC(RNG_NAME)                                                   \
     void RNG_NAME::check_exec(const TensorLayout& dst, size_t workspace_in_bytes) { \
         megdnn_assert(                                                              \
@@ -0,0 +1,76 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+void StructuredSparseMatrixMul::deduce_layout(
+        const TensorLayout& A, const TensorLayout& values, const TensorLayout& indices,
+        TensorLayout& C) {
+    MEGDNN_MARK_USED_VAR(indices);
+    megdnn_assert(
+            A.ndim >= 2 && values.ndim == 2,
+            "structured sparse matrix mul shape mismatch: A=%s values=%s",
+            A.to_string().c_str(), values.to_string().c_str());
+    TensorShape shp = A;
+    shp[shp.ndim - 1] = values[0];
+    C = TensorLayout{shp, A.dtype};
+}
+
+void StructuredSparseMatrixMul::check_exec(
+        const TensorLayout& A, const TensorLayout& values, const TensorLayout& indices,
+        const TensorLayout& C, size_t workspace_in_bytes) {
+    auto errmsg = [&]() {
+        return megdnn_layout_msg(A) + ", " + megdnn_layout_msg(values) + ", " +
+               megdnn_layout_msg(indices) + ", " + megdnn_layout_msg(C);
+    };
+    MEGDNN_MARK_USED_VAR(errmsg);
+    megdnn_assert(
+            A.dtype.enumv() == DTypeEnum::Float32,
+            "structured sparse matrix mul only supports float32: %s",
+            errmsg().c_str());
+    megdnn_assert_eq_dtype(A, values);
+    megdnn_assert(
+            indices.dtype.enumv() == DTypeEnum::Uint8,
+            "indices of structured sparse matrix mul should be Uint8: %s",
+            errmsg().c_str());
+
+    TensorLayout c_expected;
+    deduce_layout(A, values, indices, c_expected);
+    megdnn_assert_eq_layout(c_expected, C);
+
+    size_t sparse_n = param().sparse_n, sparse_m = param().sparse_m;
+    megdnn_assert(
+            sparse_n > 0 && sparse_n <= sparse_m && sparse_m <= 256,
+            "invalid sparsity %zu:%zu", sparse_n, sparse_m);
+    size_t k = A[A.ndim - 1];
+    megdnn_assert(
+            k % sparse_m == 0, "k(%zu) should be divisible by sparse_m(%zu)", k,
+            sparse_m);
+    megdnn_assert(
+            values[1] == k / sparse_m * sparse_n && indices.eq_shape(values),
+            "values and indices should be (n, k / sparse_m * sparse_n): %s",
+            errmsg().c_str());
+
+    megdnn_assert_contiguous(A);
+    megdnn_assert_contiguous(values);
+    megdnn_assert_contiguous(indices);
+    megdnn_assert_contiguous(C);
+    auto required_workspace_in_bytes = get_workspace_in_bytes(A, values, indices, C);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+void StructuredSparseMatrixMul::check_indices(const TensorND& indices) {
+    size_t sparse_m = param().sparse_m;
+    auto ptr = indices.ptr<dt_uint8>();
+    size_t nr_elems = indices.layout.total_nr_elems();
+    for (size_t i = 0; i < nr_elems; ++i) {
+        megdnn_assert(
+                ptr[i] < sparse_m,
+                "structured sparse matrix mul index %d at %zu out of range [0, %zu)",
+                static_cast<int>(ptr[i]), i, sparse_m);
+    }
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
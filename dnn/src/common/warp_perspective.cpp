@@ -262,6 +262,11 @@ void WarpPerspectiveBase::check_layout_fwd(
                 (src.dtype.enumv() == DTypeEnum::Quantized8Asymm ||
                  src.dtype.enumv() == DTypeEnum::Uint8),
                 "src expected Quantized8Asymm or Uint8, but got %s", src.dtype.name());
+        megdnn_assert(
+                dst.dtype.enumv() == DTypeEnum::Float32 ||
+                        DNN_FLOAT16_SELECT(
+                                dst.dtype.enumv() == DTypeEnum::Float16, false),
+                "dst expected Float32 or Float16, but got %s", dst.dtype.name());
         megdnn_assert(
                 mat.dtype == dtype::Float32(), "matrix dtype expected float, got %s",
                 mat.dtype.name());
@@ -276,7 +281,8 @@ void WarpPerspectiveBase::check_layout_fwd(
         megdnn_assert(
                 (src.dtype.enumv() == DTypeEnum::Quantized8Asymm ||
                  src.dtype.enumv() == DTypeEnum::Uint8) &&
-                dst.dtype.enumv() == DTypeEnum::Float32);
+                (dst.dtype.enumv() == DTypeEnum::Float32 ||
+                 DNN_FLOAT16_SELECT(dst.dtype.enumv() == DTypeEnum::Float16, false)));
     }
 }
 
@@ -0,0 +1,66 @@
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+
+void WeightOnlyQuantMatrixMul::deduce_layout(
+        const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+        TensorLayout& C) {
+    MEGDNN_MARK_USED_VAR(scales);
+    megdnn_assert(
+            A.ndim >= 2 && B.ndim == 2 && A[A.ndim - 1] == B[1],
+            "weight only quant matrix mul shape mismatch: A=%s B=%s",
+            A.to_string().c_str(), B.to_string().c_str());
+    TensorShape shp = A;
+    shp[shp.ndim - 1] = B[0];
+    C = TensorLayout{shp, A.dtype};
+}
+
+void WeightOnlyQuantMatrixMul::check_exec(
+        const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+        const TensorLayout& C, size_t workspace_in_bytes) {
+    auto errmsg = [&]() {
+        return megdnn_layout_msg(A) + ", " + megdnn_layout_msg(B) + ", " +
+               megdnn_layout_msg(scales) + ", " + megdnn_layout_msg(C);
+    };
+    MEGDNN_MARK_USED_VAR(errmsg);
+    bool float_act = A.dtype.enumv() == DTypeEnum::Float32;
+    DNN_INC_FLOAT16(float_act |= A.dtype.enumv() == DTypeEnum::Float16);
+    megdnn_assert(
+            float_act, "activation of weight only quant matrix mul should be float: %s",
+            errmsg().c_str());
+    megdnn_assert(
+            B.dtype.enumv() == DTypeEnum::Int8 ||
+                    B.dtype.enumv() == DTypeEnum::QuantizedS4,
+            "weight of weight only quant matrix mul should be Int8 or QuantizedS4: "
+            "%s",
+            errmsg().c_str());
+    megdnn_assert_eq_dtype(A, scales);
+
+    TensorLayout c_expected;
+    deduce_layout(A, B, scales, c_expected);
+    megdnn_assert_eq_layout(c_expected, C);
+
+    size_t group_size = param().group_size;
+    size_t k = B[1];
+    megdnn_assert(
+            group_size > 0 && k % group_size == 0,
+            "k(%zu) should be divisible by group_size(%zu)", k, group_size);
+    megdnn_assert(
+            B.dtype.enumv() != DTypeEnum::QuantizedS4 || group_size % 2 == 0,
+            "group_size(%zu) of QuantizedS4 weights should be even", group_size);
+    megdnn_assert(
+            scales.ndim == 2 && scales[0] == B[0] && scales[1] == k / group_size,
+            "scales should be (n, k / group_size): %s", errmsg().c_str());
+
+    megdnn_assert_contiguous(A);
+    megdnn_assert_contiguous(B);
+    megdnn_assert_contiguous(scales);
+    megdnn_assert_contiguous(C);
+    auto required_workspace_in_bytes = get_workspace_in_bytes(A, B, scales, C);
+    megdnn_assert(workspace_in_bytes >= required_workspace_in_bytes);
+}
+
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
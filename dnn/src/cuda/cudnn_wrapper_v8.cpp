@@ -6,6 +6,7 @@
 #include "src/cuda/utils.h"
 
 #include "src/cuda/conv_bias/helper.h"
+#include "src/cuda/handle.h"
 
 #include "cudnn_frontend_EngineConfigGenerator.h"
 
@@ -436,6 +437,78 @@ void filter_engine_configs(
     };
     cudnn_frontend::filter(from, to, filter);
 }
+
+//! the key of the plan in the plan storage, which is valid across processes
+std::string plan_storage_key(
+        Handle* handle, const StaticData::KeyStorage& key,
+        cudnn_frontend::OperationGraph& op_graph) {
+    auto&& prop = concrete_handle(handle)->device_prop();
+    return ssprintf(
+            "%zx:%zx;cap=%d.%d;cudnn=%zu;det=%d;%s", key.k1, key.k2, prop.major,
+            prop.minor, cudnnGetVersion(), static_data().deterministic,
+            op_graph.getTag().c_str());
+}
+
+/*!
+ * build the plan of the first engine config that works and put it into the
+ * cache; the plan is loaded from the plan storage instead if it has been built
+ * in another process
+ */
+cudnn_frontend::ExecutionPlan* build_plan(
+        Handle* megdnn_handle, const StaticData::KeyStorage& key,
+        cudnn_frontend::OperationGraph& op_graph, size_t nr_sources,
+        cudnn_frontend::GeneratorSource const* sources) {
+    auto&& handle = cudnn_handle(megdnn_handle);
+    auto& cache = static_data().cache;
+    auto insert = [&](cudnn_frontend::ExecutionPlan&& plan) {
+        MEGDNN_LOCK_GUARD(static_data().cache_mutex);
+        return &cache.insert(std::make_pair(key, std::move(plan))).first->second;
+    };
+
+#if CUDNN_VERSION >= 8400
+    auto storage = cudnn_plan_storage();
+    std::string storage_key;
+    if (storage) {
+        storage_key = plan_storage_key(megdnn_handle, key, op_graph);
+        auto json = storage->get(storage_key);
+        if (!json.empty()) {
+            try {
+                return insert(cudnn_frontend::ExecutionPlanBuilder()
+                                      .setHandle(handle)
+                                      .loadFromJson(json)
+                                      .build());
+            } catch (cudnn_frontend::cudnnException& e) {
+                megdnn_log_warn(
+                        "failed to load cudnn plan from storage, rebuild it: %s",
+                        e.what());
+            }
+        }
+    }
+#endif
+
+    cudnn_frontend::EngineConfigGenerator generator(nr_sources, sources);
+    auto configs = generator.generate_engine_config(op_graph);
+
+    for (auto& config : configs) {
+        try {
+            auto plan = cudnn_frontend::ExecutionPlanBuilder()
+                                .setHandle(handle)
+                                .setEngineConfig(config)
+                                .build();
+            auto workspace_size = plan.getWorkspaceSize();
+            MEGDNN_MARK_USED_VAR(workspace_size);
+#if CUDNN_VERSION >= 8400
+            if (storage) {
+                storage->put(storage_key, plan.getJsonRepresentation());
+            }
+#endif
+            return insert(std::move(plan));
+        } catch (cudnn_frontend::cudnnException& e) {
+            continue;
+        }
+    }
+    return nullptr;
+}
 };  // namespace
 
 /* --------- get heuristic plan from megdnn opr -------- */
@@ -501,25 +574,7 @@ cudnn_frontend::ExecutionPlan* megdnn::cuda::get_heuristic_plan_from_opr(
     std::array<cudnn_frontend::GeneratorSource const, 2> sources = {
             heurgen_method, fallback_method};
 
-    cudnn_frontend::EngineConfigGenerator generator(sources.size(), sources.data());
-    auto configs = generator.generate_engine_config(op_graph);
-
-    for (auto& config : configs) {
-        try {
-            auto plan = cudnn_frontend::ExecutionPlanBuilder()
-                                .setHandle(handle)
-                                .setEngineConfig(config)
-                                .build();
-            auto workspace_size = plan.getWorkspaceSize();
-            MEGDNN_MARK_USED_VAR(workspace_size);
-            MEGDNN_LOCK_GUARD(static_data().cache_mutex);
-            auto insert = cache.insert(std::make_pair(key, std::move(plan)));
-            return &insert.first->second;
-        } catch (cudnn_frontend::cudnnException& e) {
-            continue;
-        }
-    }
-    return nullptr;
+    return build_plan(opr->handle(), key, op_graph, sources.size(), sources.data());
 }
 
 #define INST(_Opr)                                                                     \
@@ -606,25 +661,7 @@ cudnn_frontend::ExecutionPlan* megdnn::cuda::get_heuristic_plan_from_opr(
 
     std::array<cudnn_frontend::GeneratorSource const, 1> sources = {heurgen_method};
 
-    cudnn_frontend::EngineConfigGenerator generator(sources.size(), sources.data());
-    auto configs = generator.generate_engine_config(op_graph);
-
-    for (auto& config : configs) {
-        try {
-            auto plan = cudnn_frontend::ExecutionPlanBuilder()
-                                .setHandle(handle)
-                                .setEngineConfig(config)
-                                .build();
-            auto workspace_size = plan.getWorkspaceSize();
-            MEGDNN_MARK_USED_VAR(workspace_size);
-            MEGDNN_LOCK_GUARD(static_data().cache_mutex);
-            auto insert = cache.insert(std::make_pair(key, std::move(plan)));
-            return &insert.first->second;
-        } catch (cudnn_frontend::cudnnException& e) {
-            continue;
-        }
-    }
-    return nullptr;
+    return build_plan(opr->handle(), key, op_graph, sources.size(), sources.data());
 }
 
 /* ------ impl for running a single conv ----- */
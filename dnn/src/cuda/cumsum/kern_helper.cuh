@@ -11,6 +11,14 @@ void get_BX_BY(uint32_t A, uint32_t B, uint32_t C, uint32_t& BX, uint32_t& BY);
 
 uint32_t get_workspace_bytes_for_cub_1d(uint32_t nr_item, uint32_t item_size);
 
+/*!
+ * \brief whether the lines of a (A, B, 1) tensor are scanned in a single pass
+ *      by decoupled look-back, rather than by the multi-pass block scan
+ */
+static inline bool use_lookback(uint32_t A, uint32_t B, uint32_t C) {
+    return A > 1 && C == 1 && B > 1024;
+}
+
 }  // namespace cumsum
 }  // namespace cuda
 }  // namespace megdnn
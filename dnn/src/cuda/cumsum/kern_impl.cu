@@ -59,6 +59,9 @@ uint32_t cumsum::get_workspace_in_bytes(
     if (A == 1 && C == 1) {
         return get_workspace_bytes_for_cub_1d(B, item_size);
     }
+    if (use_lookback(A, B, C)) {
+        return detail::lookback::get_workspace_in_bytes(A, B);
+    }
     uint32_t BX, BY;
     get_BX_BY(A, B, C, BX, BY);
     uint32_t BY2 = BY * 2;
@@ -42,6 +42,10 @@ namespace library {
 #define CUTLASS_ARCH_MMA_SM75_SUPPORTED 1
 #endif
 
+#if (__CUDACC_VER_MAJOR__ >= 11)
+#define CUTLASS_ARCH_MMA_SM80_SUPPORTED 1
+#endif
+
 #if __CUDACC_VER_MAJOR__ > 9 || (__CUDACC_VER_MAJOR__ == 9 && __CUDACC_VER_MINOR__ >= 2)
 
 void initialize_all_gemm_simt_operations(Manifest& manifest);
@@ -63,6 +67,9 @@ void initialize_all_conv2d_tensorop8816_operations(Manifest& manifest);
 void initialize_all_conv2d_tensorop8832_operations(Manifest& manifest);
 void initialize_all_deconv_tensorop8816_operations(Manifest& manifest);
 #endif
+#if defined(CUTLASS_ARCH_MMA_SM80_SUPPORTED) && CUTLASS_ARCH_MMA_SM80_SUPPORTED
+void initialize_all_gemm_tensorop16816_operations(Manifest& manifest);
+#endif
 
 void initialize_all(Manifest& manifest) {
     initialize_all_gemm_simt_operations(manifest);
@@ -84,6 +91,9 @@ void initialize_all(Manifest& manifest) {
     initialize_all_conv2d_tensorop8832_operations(manifest);
     initialize_all_deconv_tensorop8816_operations(manifest);
 #endif
+#if defined(CUTLASS_ARCH_MMA_SM80_SUPPORTED) && CUTLASS_ARCH_MMA_SM80_SUPPORTED
+    initialize_all_gemm_tensorop16816_operations(manifest);
+#endif
 }
 
 #else
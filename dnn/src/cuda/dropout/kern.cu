@@ -0,0 +1,97 @@
+#include "./kern.cuh"
+#include "megdnn/dtype.h"
+#include "src/common/philox.h"
+
+using namespace megdnn;
+using namespace cuda;
+
+// use a namespace (but not anonymous namespace) to avoid name confliction while
+// maintaining readability of cuda kernel names
+namespace cuda_kern {
+
+//! each thread draws 4 masks from one philox counter
+template <typename T>
+__global__ void dropout_forward(
+        const T* inp, T* oup, uint8_t* mask, size_t size, uint64_t seed,
+        uint64_t offset, float drop_prob, float scale) {
+    uint64_t nr_counters = philox::nr_counters(size),
+             stride = static_cast<uint64_t>(gridDim.x) * blockDim.x;
+    for (uint64_t c = blockIdx.x * blockDim.x + threadIdx.x; c < nr_counters;
+         c += stride) {
+        philox::Philox4x32 rand{seed, offset + c};
+#pragma unroll
+        for (int j = 0; j < 4; ++j) {
+            size_t i = c * 4 + j;
+            if (i < size) {
+                uint8_t keep =
+                        philox::Philox4x32::uniform(rand.v[j]) < drop_prob ? 0 : 1;
+                mask[i] = keep;
+                oup[i] = static_cast<T>(
+                        keep ? static_cast<float>(inp[i]) * scale : 0.f);
+            }
+        }
+    }
+}
+
+template <typename T>
+__global__ void dropout_backward(
+        const T* doup, const uint8_t* mask, T* dinp, size_t size, float scale) {
+    size_t stride = static_cast<size_t>(gridDim.x) * blockDim.x;
+    for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < size; i += stride) {
+        dinp[i] = static_cast<T>(mask[i] ? static_cast<float>(doup[i]) * scale : 0.f);
+    }
+}
+
+}  // namespace cuda_kern
+
+namespace {
+//! grid size of a grid-stride loop over size items
+uint32_t get_nr_blocks(uint64_t size) {
+    return static_cast<uint32_t>(
+            std::min<uint64_t>(DIVUP(size, NR_THREADS), 65535 * 16));
+}
+}  // anonymous namespace
+
+namespace megdnn {
+namespace cuda {
+namespace dropout {
+
+template <typename T>
+void forward(
+        const T* inp, T* oup, uint8_t* mask, size_t size, uint64_t seed,
+        uint64_t offset, float drop_prob, cudaStream_t stream) {
+    if (!size)
+        return;
+    float scale = 1.0f / (1.0f - drop_prob);
+    cuda_kern::dropout_forward<T>
+            <<<get_nr_blocks(philox::nr_counters(size)), NR_THREADS, 0, stream>>>(
+                    inp, oup, mask, size, seed, offset, drop_prob, scale);
+    after_kernel_launch();
+}
+
+template <typename T>
+void backward(
+        const T* doup, const uint8_t* mask, T* dinp, size_t size, float drop_prob,
+        cudaStream_t stream) {
+    if (!size)
+        return;
+    float scale = 1.0f / (1.0f - drop_prob);
+    cuda_kern::dropout_backward<T><<<get_nr_blocks(size), NR_THREADS, 0, stream>>>(
+            doup, mask, dinp, size, scale);
+    after_kernel_launch();
+}
+
+#define INST(T)                                                                    \
+    template void forward<T>(                                                      \
+            const T*, T*, uint8_t*, size_t, uint64_t, uint64_t, float, cudaStream_t); \
+    template void backward<T>(                                                     \
+            const T*, const uint8_t*, T*, size_t, float, cudaStream_t);
+INST(dt_float32)
+INST(dt_float16)
+#undef INST
+
+}  // namespace dropout
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: ft=cuda syntax=cpp.doxygen
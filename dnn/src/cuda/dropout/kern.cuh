@@ -0,0 +1,30 @@
+#pragma once
+
+#include "megdnn/basic_types.h"
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace dropout {
+
+/*!
+ * \brief write the mask and the scaled output of dropout
+ *
+ * The mask of element i is drawn from the word i % 4 of the philox counter
+ * offset + i / 4, the same as the naive implementation.
+ */
+template <typename T>
+void forward(
+        const T* inp, T* oup, uint8_t* mask, size_t size, uint64_t seed,
+        uint64_t offset, float drop_prob, cudaStream_t stream);
+
+template <typename T>
+void backward(
+        const T* doup, const uint8_t* mask, T* dinp, size_t size, float drop_prob,
+        cudaStream_t stream);
+
+}  // namespace dropout
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: ft=cpp syntax=cpp.doxygen
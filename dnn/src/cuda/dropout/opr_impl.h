@@ -59,16 +59,14 @@ public:
         desc.restore(handle, drop_prob, status, status_size, seed);
     }
     bool initialized() { return status != nullptr; }
-    friend class DropoutForwardImpl;
-    friend class DropoutBackwardImpl;
 #if CUDNN_VERSION >= 8004
     friend class MultiHeadAttnStatus;
 #endif
 };
 
-// similar to RNG operator, dropout operator also have status
 class DropoutForwardImpl final : public DropoutForward {
-    DropoutStatus dropout_status;
+    //! counter offset of the next exec in the philox stream of m_seed
+    uint64_t m_seed = 0, m_offset = 0;
 
 public:
     using DropoutForward::DropoutForward;
@@ -83,15 +81,6 @@ public:
 };
 
 class DropoutBackwardImpl final : public DropoutBackward {
-#if CUDNN_VERSION >= 7000
-    DropoutDesc op_desc;
-#else
-    // cudnnDropoutRestore is not support when cudnn version < 7000
-    // so we need save the dropout status and set the dropoutDesc
-    // rather than restore
-    DropoutStatus dropout_status;
-#endif
-
 public:
     using DropoutBackward::DropoutBackward;
     void exec(
@@ -9,13 +9,39 @@ namespace cuda {
 template <int arity, class KernImpl, typename enable = void>
 struct ElemArithKernWrapper;
 
+//! ctypes whose ElemArithKernWrapper implements the call on vect_type
+template <typename ctype>
+struct ElemArithHasVectCall {
+    static const bool value = std::is_same<ctype, dt_int8>::value ||
+                              std::is_same<ctype, dt_uint8>::value ||
+                              std::is_same<ctype, dt_bool>::value ||
+                              std::is_same<ctype, dt_float16>::value ||
+                              std::is_same<ctype, dt_bfloat16>::value;
+};
+
+#if MEGDNN_CC_CUDA
+/*!
+ * \brief store a vector to dst[idx]; dst may be not aligned to vect_type, e.g.
+ *      a sub tensor of float16, so fall back to storing the lanes one by one
+ */
+template <typename ctype, typename vect_type>
+__device__ __forceinline__ void store_vect(ctype* dst, uint32_t idx, vect_type val) {
+    if (reinterpret_cast<uintptr_t>(dst) % sizeof(vect_type) == 0) {
+        *(vect_type*)(&dst[idx]) = val;
+    } else {
+        dst[idx] = val.x;
+        dst[idx + 1] = val.y;
+        dst[idx + 2] = val.z;
+        dst[idx + 3] = val.w;
+    }
+}
+#endif
+
 template <class KernImpl>
 struct ElemArithKernWrapper<
         1, KernImpl,
         typename std::enable_if<
-                !std::is_same<typename KernImpl::ctype, dt_int8>::value &&
-                !std::is_same<typename KernImpl::ctype, dt_uint8>::value &&
-                !std::is_same<typename KernImpl::ctype, dt_bool>::value>::type> {
+                !ElemArithHasVectCall<typename KernImpl::ctype>::value>::type> {
     typedef typename KernImpl::ctype ctype;
     ctype* dst;
 
@@ -27,9 +53,7 @@ template <class KernImpl>
 struct ElemArithKernWrapper<
         2, KernImpl,
         typename std::enable_if<
-                !std::is_same<typename KernImpl::ctype, dt_int8>::value &&
-                !std::is_same<typename KernImpl::ctype, dt_uint8>::value &&
-                !std::is_same<typename KernImpl::ctype, dt_bool>::value>::type> {
+                !ElemArithHasVectCall<typename KernImpl::ctype>::value>::type> {
     typedef typename KernImpl::ctype ctype;
     ctype* dst;
 
@@ -43,9 +67,7 @@ template <class KernImpl>
 struct ElemArithKernWrapper<
         3, KernImpl,
         typename std::enable_if<
-                !std::is_same<typename KernImpl::ctype, dt_int8>::value &&
-                !std::is_same<typename KernImpl::ctype, dt_uint8>::value &&
-                !std::is_same<typename KernImpl::ctype, dt_bool>::value>::type> {
+                !ElemArithHasVectCall<typename KernImpl::ctype>::value>::type> {
     typedef typename KernImpl::ctype ctype;
     ctype* dst;
 
@@ -60,12 +82,11 @@ template <class KernImpl>
 struct ElemArithKernWrapper<
         1, KernImpl,
         typename std::enable_if<
-                std::is_same<typename KernImpl::ctype, dt_int8>::value ||
-                std::is_same<typename KernImpl::ctype, dt_uint8>::value ||
-                std::is_same<typename KernImpl::ctype, dt_bool>::value>::type> {
+                ElemArithHasVectCall<typename KernImpl::ctype>::value>::type> {
     typedef typename KernImpl::ctype ctype;
     using VectTypeTrait = elemwise_intl::VectTypeTrait<ctype>;
     typedef typename VectTypeTrait::vect_type vect_type;
+    static const bool has_vect_call = true;
     ctype* dst;
 #if MEGDNN_CC_CUDA
     __device__ __forceinline__ void operator()(uint32_t idx, ctype x) {
@@ -76,7 +97,7 @@ struct ElemArithKernWrapper<
         ctype b = KernImpl::apply(x.y);
         ctype g = KernImpl::apply(x.z);
         ctype r = KernImpl::apply(x.w);
-        *(vect_type*)(&dst[idx]) = VectTypeTrait::make_vector(a, b, g, r);
+        store_vect(dst, idx, VectTypeTrait::make_vector(a, b, g, r));
     }
 #endif
 };
@@ -85,12 +106,11 @@ template <class KernImpl>
 struct ElemArithKernWrapper<
         2, KernImpl,
         typename std::enable_if<
-                std::is_same<typename KernImpl::ctype, dt_int8>::value ||
-                std::is_same<typename KernImpl::ctype, dt_uint8>::value ||
-                std::is_same<typename KernImpl::ctype, dt_bool>::value>::type> {
+                ElemArithHasVectCall<typename KernImpl::ctype>::value>::type> {
     typedef typename KernImpl::ctype ctype;
     using VectTypeTrait = elemwise_intl::VectTypeTrait<ctype>;
     typedef typename VectTypeTrait::vect_type vect_type;
+    static const bool has_vect_call = true;
     ctype* dst;
 #if MEGDNN_CC_CUDA
     __device__ __forceinline__ void operator()(uint32_t idx, ctype x, ctype y) {
@@ -101,7 +121,7 @@ struct ElemArithKernWrapper<
         ctype b = KernImpl::apply(x.y, y.y);
         ctype g = KernImpl::apply(x.z, y.z);
         ctype r = KernImpl::apply(x.w, y.w);
-        *(vect_type*)(&dst[idx]) = VectTypeTrait::make_vector(a, b, g, r);
+        store_vect(dst, idx, VectTypeTrait::make_vector(a, b, g, r));
     }
 #endif
 };
@@ -110,12 +130,11 @@ template <class KernImpl>
 struct ElemArithKernWrapper<
         3, KernImpl,
         typename std::enable_if<
-                std::is_same<typename KernImpl::ctype, dt_int8>::value ||
-                std::is_same<typename KernImpl::ctype, dt_uint8>::value ||
-                std::is_same<typename KernImpl::ctype, dt_bool>::value>::type> {
+                ElemArithHasVectCall<typename KernImpl::ctype>::value>::type> {
     typedef typename KernImpl::ctype ctype;
     using VectTypeTrait = elemwise_intl::VectTypeTrait<ctype>;
     typedef typename VectTypeTrait::vect_type vect_type;
+    static const bool has_vect_call = true;
     ctype* dst;
 #if MEGDNN_CC_CUDA
     __device__ __forceinline__ void operator()(
@@ -128,7 +147,7 @@ struct ElemArithKernWrapper<
         ctype b = KernImpl::apply(x.y, y.y, z.y);
         ctype g = KernImpl::apply(x.z, y.z, z.z);
         ctype r = KernImpl::apply(x.w, y.w, z.w);
-        *(vect_type*)(&dst[idx]) = VectTypeTrait::make_vector(a, b, g, r);
+        store_vect(dst, idx, VectTypeTrait::make_vector(a, b, g, r));
     }
 #endif
 };
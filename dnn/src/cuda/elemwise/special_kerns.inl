@@ -108,6 +108,10 @@ public:
     operator const Op&() const { return m_op; }
 };
 
+//! the fused ops read m_src2 and m_src3 at the offsets of the params
+template <class Op>
+struct OpReadsByParamOffset<FuseOpWrapper<Op>> : std::true_type {};
+
 template <class Op, class PVis0, class PVis1>
 struct OpCallerBinary<FuseOpWrapper<Op>, PVis0, PVis1> {
     Op op;
@@ -223,6 +223,8 @@ INST(dt_bool);
 INST(dt_qint8);
 INST(dt_qint1);
 INST(dt_quint8);
+INST(dt_float16);
+INST(dt_bfloat16);
 #undef dt_ibyte
 
 template <int ndim>
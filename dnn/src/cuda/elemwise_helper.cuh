@@ -426,15 +426,39 @@ public:
 #define _brdcast_mask BCAST_OTHER
 INST_PARAM_VECT_VISITOR;
 #undef _brdcast_mask
-#define _brdcast_mask BCAST_01
-INST_PARAM_VECT_VISITOR;
-#undef _brdcast_mask
 #define _brdcast_mask BCAST_10
 INST_PARAM_VECT_VISITOR;
 #undef _brdcast_mask
+
+/*!
+ * the last dim is broadcasted and its size is a multiple of packed_size, so all
+ * the lanes of a vector share one element
+ */
+#define INST_PARAM_VECT_LANE_BRDCAST_VISITOR                                  \
+    template <int ndim, typename ctype>                                       \
+    class ParamVectVisitor<ndim, ctype, _brdcast_mask>                        \
+            : public ParamVisitorBase<ndim, ctype, _brdcast_mask> {           \
+    public:                                                                   \
+        using Super = ParamVisitorBase<ndim, ctype, _brdcast_mask>;           \
+        using rwtype = typename VectTypeTrait<ctype>::vect_type;              \
+        static const int packed_size = sizeof(rwtype) / sizeof(ctype);        \
+        void host_init(const TensorND& rv, int grid_size, int block_size) {   \
+            ParamVisitorBase<ndim, ctype, _brdcast_mask>::host_init(          \
+                    rv, grid_size, block_size, packed_size);                  \
+        }                                                                     \
+        DEVICE_WRAPPER(rwtype vect_lane; devfunc rwtype & at(uint32_t idx) {  \
+            ctype v = Super::m_ptr[Super::offset(idx)];                       \
+            vect_lane = VectTypeTrait<ctype>::make_vector(v, v, v, v);        \
+            return vect_lane;                                                 \
+        })                                                                    \
+    };
+#define _brdcast_mask BCAST_01
+INST_PARAM_VECT_LANE_BRDCAST_VISITOR;
+#undef _brdcast_mask
 #define _brdcast_mask BCAST_101
-INST_PARAM_VECT_VISITOR;
+INST_PARAM_VECT_LANE_BRDCAST_VISITOR;
 #undef _brdcast_mask
+#undef INST_PARAM_VECT_LANE_BRDCAST_VISITOR
 #define INST_DT_IBYTE(ctype)                                                         \
     template <int ndim>                                                              \
     class ParamVectVisitor<ndim, ctype, BCAST_FULL>                                  \
@@ -459,6 +483,8 @@ INST_DT_IBYTE(dt_qint8);
 INST_DT_IBYTE(dt_qint1);
 INST_DT_IBYTE(dt_quint8);
 INST_DT_IBYTE(dt_bool);
+INST_DT_IBYTE(dt_float16);
+INST_DT_IBYTE(dt_bfloat16);
 #undef INST_DT_IBYTE
 #undef DEVICE_WRAPPER
 #undef INST_PARAM_VECT_VISITOR
@@ -1106,11 +1132,46 @@ __global__ void cuda_kern(OpCallerUniform<Op, arity, PVis> op_caller, uint32_t s
 template <class Op, typename ctype, int arity>
 class UserOpInvoker;
 
+/*!
+ * \brief whether an Op on float16 or bfloat16 implements the call on vect_type
+ *
+ * The vectorized call is mandatory for the byte types, while it is optional for
+ * the half types; an Op having it declares `static const bool has_vect_call`.
+ */
+template <class Op, typename enable = void>
+struct OpHasVectCall : std::false_type {};
+
+template <class Op>
+struct OpHasVectCall<Op, typename std::enable_if<Op::has_vect_call>::type>
+        : std::true_type {};
+
+/*!
+ * \brief whether an Op reads other tensors by the offsets of the params, which
+ *      must then be real vectors rather than broadcasted lanes
+ */
+template <class Op>
+struct OpReadsByParamOffset : std::false_type {};
+
+//! whether the vectors of a param with last-contig layout are aligned
+template <typename ctype>
+bool is_vect_aligned(const TensorND& param) {
+    using vect_type = typename VectTypeTrait<ctype>::vect_type;
+    const size_t packed_size = VectTypeTrait<ctype>::packed_size;
+    auto&& layout = param.layout;
+    if (reinterpret_cast<uintptr_t>(param.raw_ptr()) % sizeof(vect_type))
+        return false;
+    for (size_t i = 0; i + 1 < layout.ndim; ++i) {
+        if (layout.stride[i] % static_cast<ptrdiff_t>(packed_size))
+            return false;
+    }
+    return true;
+}
+
 /* f{{{ UserOpInvoker specializations */
 
 //! run op by promoting all params to same ndim
 template <class Op, typename ctype, int arity>
-class UserOpInvokerToSameNdim {
+class UserOpInvokerToSameNdimGeneral {
     const ElemwiseOpParamN<arity>& m_param;
     cudaStream_t m_stream;
     const Op& m_op;
@@ -1145,13 +1206,22 @@ class UserOpInvokerToSameNdim {
     }
 
 public:
-    UserOpInvokerToSameNdim(
+    UserOpInvokerToSameNdimGeneral(
             const ElemwiseOpParamN<arity>& param, cudaStream_t stream, const Op& op)
             : m_param(param), m_stream(stream), m_op(op) {
         dispatch0();
     }
 };
 
+template <class Op, typename ctype, int arity>
+class UserOpInvokerToSameNdim
+        : public UserOpInvokerToSameNdimGeneral<Op, ctype, arity> {
+public:
+    UserOpInvokerToSameNdim(
+            const ElemwiseOpParamN<arity>& param, cudaStream_t stream, const Op& op)
+            : UserOpInvokerToSameNdimGeneral<Op, ctype, arity>(param, stream, op) {}
+};
+
 template <class Op, typename ctype, int arity>
 class UserOpInvokerToSameNdimIByteHelper {
 public:
@@ -1253,7 +1323,8 @@ private:
          * \NOTE: remove try_scalar() to adapt multi-type tenary op
          */
         for (int i = 0; i < arity; ++i) {
-            if (!try_last_contig(m_param[i].layout))
+            if (!try_last_contig(m_param[i].layout) ||
+                !is_vect_aligned<ctype>(m_param[i]))
                 return false;
         }
         m_rw_size /= packed_size;
@@ -1266,7 +1337,7 @@ private:
             return (layout.is_contiguous());
         };
         for (int i = 0; i < arity; ++i) {
-            if (!try_contig(m_param[i].layout))
+            if (!try_contig(m_param[i].layout) || !is_vect_aligned<ctype>(m_param[i]))
                 return false;
         }
         m_rw_size = DIVUP(m_rw_size, packed_size);
@@ -1295,6 +1366,28 @@ INST_DT_IBYTE(dt_quint8);
 INST_DT_IBYTE(dt_bool);
 #undef INST_DT_IBYTE
 
+#define INST_DT_HALF(ctype)                                                      \
+    template <class Op, int arity>                                               \
+    class UserOpInvokerToSameNdim<Op, ctype, arity>                              \
+            : public std::conditional<                                           \
+                      OpHasVectCall<Op>::value,                                  \
+                      UserOpInvokerToSameNdimIByteHelper<Op, ctype, arity>,      \
+                      UserOpInvokerToSameNdimGeneral<Op, ctype, arity>>::type {  \
+        using Super = typename std::conditional<                                 \
+                OpHasVectCall<Op>::value,                                        \
+                UserOpInvokerToSameNdimIByteHelper<Op, ctype, arity>,            \
+                UserOpInvokerToSameNdimGeneral<Op, ctype, arity>>::type;         \
+                                                                                 \
+    public:                                                                      \
+        UserOpInvokerToSameNdim(                                                 \
+                const ElemwiseOpParamN<arity>& param, cudaStream_t stream,       \
+                const Op& op)                                                    \
+                : Super{param, stream, op} {}                                    \
+    }
+INST_DT_HALF(dt_float16);
+INST_DT_HALF(dt_bfloat16);
+#undef INST_DT_HALF
+
 //! implement general case by UserOpInvokerToSameNdim
 template <class Op, typename ctype, int arity>
 class UserOpInvoker : public UserOpInvokerToSameNdim<Op, ctype, arity> {
@@ -1348,9 +1441,9 @@ public:
         _cb_dispatch(3, BCAST_OTHER);                                        \
     }
 
-//! specialization for binary opr
+//! binary opr with broadcast patterns dispatched to specialized visitors
 template <class Op, typename ctype>
-class UserOpInvoker<Op, ctype, 2> {
+class UserOpInvokerBinaryGeneral {
     bool m_invoked;
     const ElemwiseOpParamN<2>& m_param;
     cudaStream_t m_stream;
@@ -1420,7 +1513,8 @@ class UserOpInvoker<Op, ctype, 2> {
     }
 
 public:
-    UserOpInvoker(const ElemwiseOpParamN<2>& param, cudaStream_t stream, const Op& op)
+    UserOpInvokerBinaryGeneral(
+            const ElemwiseOpParamN<2>& param, cudaStream_t stream, const Op& op)
             : m_param(param), m_stream(stream), m_op(op) {
         m_invoked = false;
         dispatch0();
@@ -1428,6 +1522,14 @@ public:
     }
 };
 
+//! specialization for binary opr
+template <class Op, typename ctype>
+class UserOpInvoker<Op, ctype, 2> : public UserOpInvokerBinaryGeneral<Op, ctype> {
+public:
+    UserOpInvoker(const ElemwiseOpParamN<2>& param, cudaStream_t stream, const Op& op)
+            : UserOpInvokerBinaryGeneral<Op, ctype>(param, stream, op) {}
+};
+
 #define INST_DT_TYPE(ctype)                                                            \
     template <class Op>                                                                \
     class UserOpInvoker<Op, ctype, 2> : public UserOpInvokerToSameNdim<Op, ctype, 2> { \
@@ -1462,13 +1564,22 @@ private:
     using vect_type = typename VectTypeTrait<ctype>::vect_type;
     static const size_t packed_size = VectTypeTrait<ctype>::packed_size;
     bool try_vect_load_store() {
-        auto try_last_contig_or_scalar = [](const TensorLayout& layout) {
-            return (layout.stride[layout.ndim - 1] == 1 &&
-                    layout[layout.ndim - 1] % packed_size == 0) ||
-                   (layout.ndim == 1 && layout.stride[0] == 0);
+        auto try_vect_param = [](const TensorND& param) {
+            auto&& layout = param.layout;
+            size_t last = layout.ndim - 1;
+            if (layout.ndim == 1 && layout.stride[0] == 0)
+                return true;
+            if (layout[last] % packed_size)
+                return false;
+            if (layout.stride[last] == 1)
+                return is_vect_aligned<ctype>(param);
+            //! BCAST_01 or BCAST_101, whose lanes share one element
+            return !OpReadsByParamOffset<Op>::value && !layout.stride[last] &&
+                   ((layout.ndim == 2 && layout.stride[0]) ||
+                    (layout.ndim == 3 && !layout.stride[0] && layout.stride[1]));
         };
         for (int i = 0; i < 2; ++i) {
-            if (!try_last_contig_or_scalar(m_param[i].layout))
+            if (!try_vect_param(m_param[i]))
                 return false;
         }
         m_rw_size /= packed_size;
@@ -1481,7 +1592,7 @@ private:
             return (layout.is_contiguous());
         };
         for (int i = 0; i < 2; ++i) {
-            if (!try_contig(m_param[i].layout))
+            if (!try_contig(m_param[i].layout) || !is_vect_aligned<ctype>(m_param[i]))
                 return false;
         }
         m_rw_size = DIVUP(m_rw_size, packed_size);
@@ -1645,6 +1756,26 @@ INST_DT_IBYTE(dt_qint1);
 INST_DT_IBYTE(dt_quint8);
 INST_DT_IBYTE(dt_bool);
 #undef INST_DT_IBYTE
+
+#define INST_DT_HALF(ctype)                                                          \
+    template <class Op>                                                              \
+    class UserOpInvoker<Op, ctype, 2>                                                \
+            : public std::conditional<                                               \
+                      OpHasVectCall<Op>::value,                                      \
+                      UserOpInvokerBinaryIByteHelper<Op, ctype>,                     \
+                      UserOpInvokerBinaryGeneral<Op, ctype>>::type {                 \
+        using Super = typename std::conditional<                                     \
+                OpHasVectCall<Op>::value, UserOpInvokerBinaryIByteHelper<Op, ctype>, \
+                UserOpInvokerBinaryGeneral<Op, ctype>>::type;                        \
+                                                                                     \
+    public:                                                                          \
+        UserOpInvoker(                                                               \
+                const ElemwiseOpParamN<2>& param, cudaStream_t stream, const Op& op) \
+                : Super{param, stream, op} {}                                        \
+    }
+INST_DT_HALF(dt_float16);
+INST_DT_HALF(dt_bfloat16);
+#undef INST_DT_HALF
 #endif
 
 #undef DEFINE_BRDCAST_DISPATCH_RECEIVERS
@@ -1668,7 +1799,8 @@ INST_DT_IBYTE(dt_bool);
  *      if arity == 0, there is only an `idx` input
  *      if ctype=dt_int8, dt_uint8, dt_qint8, dt_quint8, a signature compatible
  * with `void op(uint32_t idx, vect_type& param0, ..., ctype& param[arity - 1])`
- * should be implemented
+ * should be implemented; if ctype=dt_float16, dt_bfloat16, it is optional and
+ * is used only when the op declares `static const bool has_vect_call = true`
  */
 template <class Op, typename ctype, int arity>
 void run_elemwise(
@@ -0,0 +1,204 @@
+#include "megdnn/dtype.h"
+#include "src/cuda/embedding_bag/embedding_bag.cuh"
+#include "src/cuda/utils.cuh"
+
+#include "src/cuda/cub/device/device_radix_sort.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace embedding_bag {
+
+namespace {
+
+constexpr uint32_t NR_THREADS = 256;
+constexpr uint32_t MODE_MEAN = 1, MODE_MAX = 2;
+
+__device__ __forceinline__ void get_bag(
+        const int32_t* offsets, uint32_t bag, const BagDesc& desc, uint32_t& begin,
+        uint32_t& end) {
+    begin = offsets[bag];
+    end = bag + 1 < desc.batch ? offsets[bag + 1] : desc.nr_indices;
+}
+
+//! the last bag starting at or before \p pos, i.e. the bag containing it
+__device__ __forceinline__ uint32_t bag_of(
+        const int32_t* offsets, uint32_t pos, uint32_t batch) {
+    uint32_t lo = 0, hi = batch;
+    while (hi - lo > 1) {
+        uint32_t mid = (lo + hi) / 2;
+        if (static_cast<uint32_t>(offsets[mid]) <= pos) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <typename T>
+__global__ void forward_kernel(
+        const T* weight, const int32_t* indices, const int32_t* offsets,
+        const T* psw, T* dst, int32_t* max_idx, BagDesc desc) {
+    uint32_t bag = blockIdx.x, D = desc.dim, begin, end;
+    get_bag(offsets, bag, desc, begin, end);
+    float scale = desc.mode == MODE_MEAN && end > begin ? 1.f / (end - begin) : 1.f;
+    for (uint32_t c = threadIdx.x; c < D; c += blockDim.x) {
+        float acc = 0;
+        int32_t arg = -1;
+        for (uint32_t p = begin; p < end; ++p) {
+            float v = weight[static_cast<size_t>(indices[p]) * D + c];
+            if (desc.mode != MODE_MAX) {
+                acc += psw ? v * static_cast<float>(psw[p]) : v;
+            } else if (p == begin || v > acc) {
+                acc = v;
+                arg = p;
+            }
+        }
+        size_t out = static_cast<size_t>(bag) * D + c;
+        dst[out] = static_cast<T>(acc * scale);
+        if (desc.mode == MODE_MAX) {
+            max_idx[out] = arg;
+        }
+    }
+}
+
+__global__ void arange_kernel(int32_t* dst, uint32_t n) {
+    uint32_t i = threadIdx.x + blockIdx.x * blockDim.x;
+    if (i < n) {
+        dst[i] = i;
+    }
+}
+
+/*!
+ * block i handles the run of equal rows starting at i of the sorted indices,
+ * and exits at once if i is not the start of a run
+ */
+template <typename T>
+__global__ void backward_kernel(
+        const T* diff, const int32_t* sorted_rows, const int32_t* sorted_pos,
+        const int32_t* offsets, const T* psw, const int32_t* max_idx, T* grad,
+        BagDesc desc) {
+    uint32_t start = blockIdx.x, D = desc.dim;
+    int32_t row = sorted_rows[start];
+    if (start && sorted_rows[start - 1] == row) {
+        return;
+    }
+    uint32_t stop = start + 1;
+    while (stop < desc.nr_indices && sorted_rows[stop] == row) {
+        ++stop;
+    }
+    for (uint32_t c = threadIdx.x; c < D; c += blockDim.x) {
+        float acc = 0;
+        for (uint32_t i = start; i < stop; ++i) {
+            uint32_t pos = sorted_pos[i], bag = bag_of(offsets, pos, desc.batch);
+            size_t off = static_cast<size_t>(bag) * D + c;
+            float dy = diff[off];
+            if (desc.mode == MODE_MAX) {
+                if (max_idx[off] == static_cast<int32_t>(pos)) {
+                    acc += dy;
+                }
+            } else if (desc.mode == MODE_MEAN) {
+                uint32_t begin, end;
+                get_bag(offsets, bag, desc, begin, end);
+                acc += dy * (1.f / (end - begin));
+            } else {
+                acc += psw ? dy * static_cast<float>(psw[pos]) : dy;
+            }
+        }
+        grad[static_cast<size_t>(row) * D + c] = static_cast<T>(acc);
+    }
+}
+
+uint32_t nr_threads(uint32_t dim) {
+    return std::min<uint32_t>(NR_THREADS, DIVUP(dim, 32) * 32);
+}
+
+//! bits of the largest row, as the radix sort only needs to look at them
+int nr_key_bits(uint32_t num_embeddings) {
+    int bits = 1;
+    while (bits < 32 && (1u << bits) < num_embeddings) {
+        ++bits;
+    }
+    return bits;
+}
+
+size_t cub_sort(
+        void* workspace, size_t workspace_size, const int32_t* keys_in,
+        int32_t* keys_out, const int32_t* values_in, int32_t* values_out,
+        const BagDesc& desc, cudaStream_t stream) {
+    cuda_check(cub::DeviceRadixSort::SortPairs(
+            workspace, workspace_size, keys_in, keys_out, values_in, values_out,
+            desc.nr_indices, 0, nr_key_bits(desc.num_embeddings), stream));
+    return workspace_size;
+}
+
+size_t align(size_t size) {
+    return DIVUP(size, 256) * 256;
+}
+
+}  // anonymous namespace
+
+template <typename T>
+void forward(
+        const T* weight, const int32_t* indices, const int32_t* offsets,
+        const T* psw, T* dst, int32_t* max_idx, const BagDesc& desc,
+        cudaStream_t stream) {
+    if (!desc.batch || !desc.dim) {
+        return;
+    }
+    forward_kernel<T><<<desc.batch, nr_threads(desc.dim), 0, stream>>>(
+            weight, indices, offsets, psw, dst, max_idx, desc);
+    after_kernel_launch();
+}
+
+size_t get_backward_workspace_in_bytes(const BagDesc& desc) {
+    size_t buf = align(sizeof(int32_t) * desc.nr_indices);
+    return buf * 3 +
+           cub_sort(nullptr, 0, nullptr, nullptr, nullptr, nullptr, desc, nullptr);
+}
+
+template <typename T>
+void backward(
+        const T* diff, const int32_t* indices, const int32_t* offsets,
+        const T* psw, const int32_t* max_idx, T* grad, void* workspace,
+        const BagDesc& desc, cudaStream_t stream) {
+    cuda_check(cudaMemsetAsync(
+            grad, 0, sizeof(T) * desc.num_embeddings * desc.dim, stream));
+    uint32_t n = desc.nr_indices;
+    if (!n || !desc.dim) {
+        return;
+    }
+    size_t buf = align(sizeof(int32_t) * n);
+    auto ptr = static_cast<uint8_t*>(workspace);
+    auto sorted_rows = reinterpret_cast<int32_t*>(ptr);
+    auto pos = reinterpret_cast<int32_t*>(ptr + buf);
+    auto sorted_pos = reinterpret_cast<int32_t*>(ptr + buf * 2);
+    arange_kernel<<<DIVUP(n, NR_THREADS), NR_THREADS, 0, stream>>>(pos, n);
+    after_kernel_launch();
+    // the radix sort is stable, so the positions of a row stay in order
+    cub_sort(
+            ptr + buf * 3, get_backward_workspace_in_bytes(desc) - buf * 3, indices,
+            sorted_rows, pos, sorted_pos, desc, stream);
+    backward_kernel<T><<<n, nr_threads(desc.dim), 0, stream>>>(
+            diff, sorted_rows, sorted_pos, offsets, psw, max_idx, grad, desc);
+    after_kernel_launch();
+}
+
+#define INST(T)                                                                \
+    template void forward<T>(                                                  \
+            const T*, const int32_t*, const int32_t*, const T*, T*, int32_t*,  \
+            const BagDesc&, cudaStream_t);                                     \
+    template void backward<T>(                                                 \
+            const T*, const int32_t*, const int32_t*, const T*, const int32_t*, \
+            T*, void*, const BagDesc&, cudaStream_t);
+
+INST(dt_float32)
+INST(dt_float16)
+INST(dt_bfloat16)
+#undef INST
+
+}  // namespace embedding_bag
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,49 @@
+#pragma once
+#include <cuda_runtime_api.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace megdnn {
+namespace cuda {
+namespace embedding_bag {
+
+struct BagDesc {
+    //! number of rows and columns of the table, number of bags and indices
+    uint32_t num_embeddings, dim, batch, nr_indices;
+    //! 0 for SUM, 1 for MEAN and 2 for MAX, as param::EmbeddingBag::Mode
+    uint32_t mode;
+};
+
+/*!
+ * \brief reduce the rows of each bag, one block for each bag
+ *
+ * \param psw per sample weights, may be null
+ * \param max_idx only written in MAX mode
+ */
+template <typename T>
+void forward(
+        const T* weight, const int32_t* indices, const int32_t* offsets,
+        const T* psw, T* dst, int32_t* max_idx, const BagDesc& desc,
+        cudaStream_t stream);
+
+//! workspace of backward: the sorted indices and positions and of cub
+size_t get_backward_workspace_in_bytes(const BagDesc& desc);
+
+/*!
+ * \brief the gradient of the table by segment reduction
+ *
+ * The positions are sorted by their rows, and the positions of each row are
+ * summed by a single block, so that no atomic operation is needed and the
+ * result does not depend on the scheduling.
+ */
+template <typename T>
+void backward(
+        const T* diff, const int32_t* indices, const int32_t* offsets,
+        const T* psw, const int32_t* max_idx, T* grad, void* workspace,
+        const BagDesc& desc, cudaStream_t stream);
+
+}  // namespace embedding_bag
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
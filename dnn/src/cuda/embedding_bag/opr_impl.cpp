@@ -0,0 +1,82 @@
+#include "src/cuda/embedding_bag/opr_impl.h"
+#include "src/cuda/embedding_bag/embedding_bag.cuh"
+#include "src/cuda/utils.h"
+
+namespace megdnn {
+namespace cuda {
+
+namespace {
+embedding_bag::BagDesc make_desc(
+        const TensorLayout& table, const TensorLayout& indices,
+        const TensorLayout& offsets, param::EmbeddingBag::Mode mode) {
+    return {static_cast<uint32_t>(table[0]), static_cast<uint32_t>(table[1]),
+            static_cast<uint32_t>(offsets[0]), static_cast<uint32_t>(indices[0]),
+            static_cast<uint32_t>(mode)};
+}
+}  // anonymous namespace
+
+void EmbeddingBagForwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices,
+        _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+        _megdnn_tensor_out dst, _megdnn_tensor_out max_idx,
+        _megdnn_workspace workspace) {
+    check_exec(
+            weight.layout, indices.layout, offsets.layout, per_sample_weights.layout,
+            dst.layout, max_idx.layout, workspace.size);
+    auto desc = make_desc(weight.layout, indices.layout, offsets.layout, param().mode);
+    bool has_psw = has_per_sample_weights(per_sample_weights.layout);
+    dt_int32* max_idx_ptr =
+            param().mode == Param::Mode::MAX ? max_idx.ptr<dt_int32>() : nullptr;
+    auto stream = cuda_stream(handle());
+#define cb(DType)                                                                 \
+    if (weight.layout.dtype == DType()) {                                         \
+        using T = typename DTypeTrait<DType>::ctype;                              \
+        embedding_bag::forward<T>(                                                \
+                weight.ptr<T>(), indices.ptr<dt_int32>(), offsets.ptr<dt_int32>(), \
+                has_psw ? per_sample_weights.ptr<T>() : nullptr, dst.ptr<T>(),    \
+                max_idx_ptr, desc, stream);                                       \
+        return;                                                                   \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+size_t EmbeddingBagBackwardImpl::get_workspace_in_bytes(
+        const TensorLayout&, const TensorLayout& indices, const TensorLayout& offsets,
+        const TensorLayout&, const TensorLayout&, const TensorLayout& grad) {
+    return embedding_bag::get_backward_workspace_in_bytes(
+            make_desc(grad, indices, offsets, param().mode));
+}
+
+void EmbeddingBagBackwardImpl::exec(
+        _megdnn_tensor_in diff, _megdnn_tensor_in indices,
+        _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+        _megdnn_tensor_in max_idx, _megdnn_tensor_out grad,
+        _megdnn_workspace workspace) {
+    check_exec(
+            diff.layout, indices.layout, offsets.layout, per_sample_weights.layout,
+            max_idx.layout, grad.layout, workspace.size);
+    auto desc = make_desc(grad.layout, indices.layout, offsets.layout, param().mode);
+    bool has_psw = has_per_sample_weights(per_sample_weights.layout);
+    const dt_int32* max_idx_ptr =
+            param().mode == Param::Mode::MAX ? max_idx.ptr<dt_int32>() : nullptr;
+    auto stream = cuda_stream(handle());
+#define cb(DType)                                                               \
+    if (grad.layout.dtype == DType()) {                                         \
+        using T = typename DTypeTrait<DType>::ctype;                            \
+        embedding_bag::backward<T>(                                             \
+                diff.ptr<T>(), indices.ptr<dt_int32>(), offsets.ptr<dt_int32>(), \
+                has_psw ? per_sample_weights.ptr<T>() : nullptr, max_idx_ptr,   \
+                grad.ptr<T>(), workspace.raw_ptr, desc, stream);                \
+        return;                                                                 \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
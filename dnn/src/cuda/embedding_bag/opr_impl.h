@@ -0,0 +1,41 @@
+#pragma once
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace cuda {
+
+class EmbeddingBagForwardImpl final : public EmbeddingBagForward {
+public:
+    using EmbeddingBagForward::EmbeddingBagForward;
+    void exec(
+            _megdnn_tensor_in weight, _megdnn_tensor_in indices,
+            _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+            _megdnn_tensor_out dst, _megdnn_tensor_out max_idx,
+            _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+};
+
+class EmbeddingBagBackwardImpl final : public EmbeddingBagBackward {
+public:
+    using EmbeddingBagBackward::EmbeddingBagBackward;
+    void exec(
+            _megdnn_tensor_in diff, _megdnn_tensor_in indices,
+            _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+            _megdnn_tensor_in max_idx, _megdnn_tensor_out grad,
+            _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout& diff, const TensorLayout& indices,
+            const TensorLayout& offsets, const TensorLayout& per_sample_weights,
+            const TensorLayout& max_idx, const TensorLayout& grad) override;
+};
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
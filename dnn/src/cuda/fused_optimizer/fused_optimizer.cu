@@ -0,0 +1,219 @@
+#include <cmath>
+#include "megdnn/dtype.h"
+#include "src/cuda/fused_optimizer/fused_optimizer.cuh"
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace fused_optimizer {
+
+namespace {
+
+constexpr uint32_t NR_THREADS = 256;
+
+struct KernParam {
+    float lr, weight_decay, momentum, beta_1, beta_2, eps, bc_1, bc_2;
+    bool nesterov, adapt;
+    Param::Mode mode;
+};
+
+template <typename T>
+__global__ void sgd_kernel(
+        const float* param, const T* grad, const float* buf, float* new_param,
+        float* new_buf, size_t total_nr_elem, KernParam p) {
+    size_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx >= total_nr_elem) {
+        return;
+    }
+    float g = static_cast<float>(grad[idx]) + p.weight_decay * param[idx];
+    if (p.momentum != 0) {
+        float v = p.momentum * buf[idx] + g;
+        new_buf[idx] = v;
+        g = p.nesterov ? g + p.momentum * v : v;
+    }
+    new_param[idx] = param[idx] - p.lr * g;
+}
+
+//! update the moments and return the update direction of adam
+template <typename T>
+__device__ __forceinline__ float adam_update(
+        const float* param, const T* grad, const float* exp_avg,
+        const float* exp_avg_sq, float* new_exp_avg, float* new_exp_avg_sq,
+        size_t idx, const KernParam& p) {
+    float g = static_cast<float>(grad[idx]);
+    if (p.mode == Param::Mode::ADAM) {
+        g += p.weight_decay * param[idx];
+    }
+    float m = p.beta_1 * exp_avg[idx] + (1 - p.beta_1) * g;
+    float v = p.beta_2 * exp_avg_sq[idx] + (1 - p.beta_2) * g * g;
+    new_exp_avg[idx] = m;
+    new_exp_avg_sq[idx] = v;
+    float update = (m / p.bc_1) / (sqrtf(v / p.bc_2) + p.eps);
+    if (p.mode != Param::Mode::ADAM) {
+        update += p.weight_decay * param[idx];
+    }
+    return update;
+}
+
+template <typename T>
+__global__ void adam_kernel(
+        const float* param, const T* grad, const float* exp_avg,
+        const float* exp_avg_sq, float* new_param, float* new_exp_avg,
+        float* new_exp_avg_sq, size_t total_nr_elem, KernParam p) {
+    size_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx >= total_nr_elem) {
+        return;
+    }
+    float update = adam_update(
+            param, grad, exp_avg, exp_avg_sq, new_exp_avg, new_exp_avg_sq, idx, p);
+    new_param[idx] = param[idx] - p.lr * update;
+}
+
+//! index of the tensor containing \p idx, or -1 if it is in no tensor
+__device__ __forceinline__ int find_tensor(
+        const int32_t* offsets, int nr_tensors, size_t idx) {
+    if (!nr_tensors) {
+        return -1;
+    }
+    int lo = 0, hi = nr_tensors - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (static_cast<size_t>(offsets[mid * 2]) <= idx) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    bool inside = static_cast<size_t>(offsets[lo * 2]) <= idx &&
+                  idx < static_cast<size_t>(offsets[lo * 2 + 1]);
+    return inside ? lo : -1;
+}
+
+/*!
+ * write the update direction of LAMB to \p update and accumulate the squared
+ * norms of the param and the update of each tensor to \p sqr_sum
+ *
+ * The threads of a warp usually fall into the same tensor, where the sums are
+ * reduced in the warp before the atomic add.
+ */
+template <typename T>
+__global__ void lamb_kernel_1(
+        const float* param, const T* grad, const float* exp_avg,
+        const float* exp_avg_sq, const int32_t* offsets, float* new_exp_avg,
+        float* new_exp_avg_sq, float* update, float* sqr_sum, size_t total_nr_elem,
+        int nr_tensors, KernParam p) {
+    size_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    int tensor = -1;
+    float p_sqr = 0, d_sqr = 0;
+    if (idx < total_nr_elem) {
+        float d = adam_update(
+                param, grad, exp_avg, exp_avg_sq, new_exp_avg, new_exp_avg_sq, idx,
+                p);
+        update[idx] = d;
+        tensor = find_tensor(offsets, nr_tensors, idx);
+        p_sqr = param[idx] * param[idx];
+        d_sqr = d * d;
+    }
+    int first = __shfl_sync(0xffffffffu, tensor, 0);
+    if (__all_sync(0xffffffffu, tensor == first)) {
+        for (int delta = 16; delta; delta >>= 1) {
+            p_sqr += __shfl_down_sync(0xffffffffu, p_sqr, delta);
+            d_sqr += __shfl_down_sync(0xffffffffu, d_sqr, delta);
+        }
+        if (threadIdx.x % 32 != 0) {
+            tensor = -1;
+        }
+    }
+    if (tensor >= 0) {
+        atomicAdd(sqr_sum + tensor * 2, p_sqr);
+        atomicAdd(sqr_sum + tensor * 2 + 1, d_sqr);
+    }
+}
+
+__global__ void lamb_kernel_2(
+        const float* param, const int32_t* offsets, const float* update,
+        const float* sqr_sum, float* new_param, size_t total_nr_elem,
+        int nr_tensors, KernParam p) {
+    size_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx >= total_nr_elem) {
+        return;
+    }
+    float trust_ratio = 1;
+    int tensor = find_tensor(offsets, nr_tensors, idx);
+    if (p.adapt && tensor >= 0) {
+        float p_norm = sqrtf(sqr_sum[tensor * 2]),
+              d_norm = sqrtf(sqr_sum[tensor * 2 + 1]);
+        if (p_norm > 0 && d_norm > 0) {
+            trust_ratio = p_norm / d_norm;
+        }
+    }
+    new_param[idx] = param[idx] - p.lr * trust_ratio * update[idx];
+}
+
+}  // anonymous namespace
+
+template <typename T>
+void update(
+        const float* param, const T* grad, const float* exp_avg,
+        const float* exp_avg_sq, const int32_t* offsets, float* new_param,
+        float* new_exp_avg, float* new_exp_avg_sq, float* workspace,
+        size_t total_nr_elem, size_t nr_tensors, const Param& p,
+        cudaStream_t stream) {
+    KernParam kp;
+    kp.lr = p.lr;
+    kp.weight_decay = p.weight_decay;
+    kp.momentum = p.momentum;
+    kp.beta_1 = p.beta_1;
+    kp.beta_2 = p.beta_2;
+    kp.eps = p.eps;
+    kp.bc_1 = kp.bc_2 = 1;
+    if (p.mode != Param::Mode::LAMB || p.bias_correction) {
+        kp.bc_1 = 1 - std::pow(p.beta_1, p.step);
+        kp.bc_2 = 1 - std::pow(p.beta_2, p.step);
+    }
+    kp.nesterov = p.nesterov;
+    kp.adapt = p.always_adapt || p.weight_decay > 0;
+    kp.mode = p.mode;
+
+    uint32_t nr_blocks = DIVUP(total_nr_elem, NR_THREADS);
+    if (p.mode == Param::Mode::SGD) {
+        sgd_kernel<T><<<nr_blocks, NR_THREADS, 0, stream>>>(
+                param, grad, exp_avg, new_param, new_exp_avg, total_nr_elem, kp);
+        after_kernel_launch();
+    } else if (p.mode != Param::Mode::LAMB) {
+        adam_kernel<T><<<nr_blocks, NR_THREADS, 0, stream>>>(
+                param, grad, exp_avg, exp_avg_sq, new_param, new_exp_avg,
+                new_exp_avg_sq, total_nr_elem, kp);
+        after_kernel_launch();
+    } else {
+        float* update = workspace;
+        float* sqr_sum = workspace + total_nr_elem;
+        cuda_check(cudaMemsetAsync(
+                sqr_sum, 0, sizeof(float) * 2 * nr_tensors, stream));
+        lamb_kernel_1<T><<<nr_blocks, NR_THREADS, 0, stream>>>(
+                param, grad, exp_avg, exp_avg_sq, offsets, new_exp_avg,
+                new_exp_avg_sq, update, sqr_sum, total_nr_elem, nr_tensors, kp);
+        after_kernel_launch();
+        lamb_kernel_2<<<nr_blocks, NR_THREADS, 0, stream>>>(
+                param, offsets, update, sqr_sum, new_param, total_nr_elem,
+                nr_tensors, kp);
+        after_kernel_launch();
+    }
+}
+
+#define INST(T)                                                                 \
+    template void update<T>(                                                    \
+            const float*, const T*, const float*, const float*, const int32_t*, \
+            float*, float*, float*, float*, size_t, size_t, const Param&,       \
+            cudaStream_t);
+
+INST(dt_float32)
+INST(dt_float16)
+INST(dt_bfloat16)
+#undef INST
+
+}  // namespace fused_optimizer
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,32 @@
+#pragma once
+#include <cuda_runtime_api.h>
+#include <stdint.h>
+#include "megdnn/opr_param_defs.h"
+
+namespace megdnn {
+namespace cuda {
+namespace fused_optimizer {
+
+using Param = megdnn::param::FusedOptimizerUpdate;
+
+/*!
+ * \brief update all the tensors in the packed buffers with one launch, or
+ *      two launches for LAMB
+ *
+ * \param offsets device pointer of the ranges of the tensors, only used by LAMB
+ * \param workspace (total_nr_elem + 2 * nr_tensors) floats for LAMB, unused
+ *      otherwise
+ */
+template <typename T>
+void update(
+        const float* param, const T* grad, const float* exp_avg,
+        const float* exp_avg_sq, const int32_t* offsets, float* new_param,
+        float* new_exp_avg, float* new_exp_avg_sq, float* workspace,
+        size_t total_nr_elem, size_t nr_tensors, const Param& p,
+        cudaStream_t stream);
+
+}  // namespace fused_optimizer
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,39 @@
+#include "src/cuda/fused_optimizer/opr_impl.h"
+#include "src/cuda/fused_optimizer/fused_optimizer.cuh"
+#include "src/cuda/utils.h"
+
+namespace megdnn {
+namespace cuda {
+
+void FusedOptimizerUpdateImpl::exec(
+        _megdnn_tensor_in param, _megdnn_tensor_in grad, _megdnn_tensor_in exp_avg,
+        _megdnn_tensor_in exp_avg_sq, _megdnn_tensor_in offsets,
+        _megdnn_tensor_out new_param, _megdnn_tensor_out new_exp_avg,
+        _megdnn_tensor_out new_exp_avg_sq, _megdnn_workspace workspace) {
+    check_exec(
+            param.layout, grad.layout, exp_avg.layout, exp_avg_sq.layout,
+            offsets.layout, new_param.layout, new_exp_avg.layout,
+            new_exp_avg_sq.layout, workspace.size);
+    size_t total_elem = param.layout.total_nr_elems();
+    size_t nr_tensors = offsets.layout.total_nr_elems() / 2;
+    auto stream = cuda_stream(handle());
+#define cb(DType)                                                                  \
+    if (grad.layout.dtype == DType()) {                                            \
+        using T = typename DTypeTrait<DType>::ctype;                               \
+        fused_optimizer::update<T>(                                                \
+                param.ptr<dt_float32>(), grad.ptr<T>(), exp_avg.ptr<dt_float32>(), \
+                exp_avg_sq.ptr<dt_float32>(), offsets.ptr<dt_int32>(),             \
+                new_param.ptr<dt_float32>(), new_exp_avg.ptr<dt_float32>(),        \
+                new_exp_avg_sq.ptr<dt_float32>(), workspace.ptr<dt_float32>(),     \
+                total_elem, nr_tensors, this->param(), stream);                    \
+        return;                                                                    \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,32 @@
+#pragma once
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace cuda {
+
+class FusedOptimizerUpdateImpl final : public FusedOptimizerUpdate {
+public:
+    using FusedOptimizerUpdate::FusedOptimizerUpdate;
+    void exec(
+            _megdnn_tensor_in param, _megdnn_tensor_in grad, _megdnn_tensor_in exp_avg,
+            _megdnn_tensor_in exp_avg_sq, _megdnn_tensor_in offsets,
+            _megdnn_tensor_out new_param, _megdnn_tensor_out new_exp_avg,
+            _megdnn_tensor_out new_exp_avg_sq, _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout& param, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout& offsets, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&) override {
+        if (this->param().mode != Param::Mode::LAMB) {
+            return 0;
+        }
+        //! the update direction and the squared norms of each tensor
+        return sizeof(float) *
+               (param.total_nr_elems() + offsets.total_nr_elems());
+    }
+};
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
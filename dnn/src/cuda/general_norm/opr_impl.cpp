@@ -14,6 +14,9 @@ void GeneralNormForwardImpl::exec(
             rstd.layout, workspace.size);
 
     auto p = param();
+    megdnn_assert(
+            p.mode == Param::Mode::LAYER_NORM,
+            "rms norm is not supported by cuda general norm");
     float eps = p.eps;
     bool affine = p.affine;
     uint64_t axis_start = p.axis_start;
@@ -48,6 +51,9 @@ void GeneralNormBackwardImpl::exec(
             diff.layout, data.layout, weight.layout, mean.layout, rstd.layout,
             ddata.layout, dweight.layout, dbias.layout, workspace.size);
     auto p = param();
+    megdnn_assert(
+            p.mode == Param::Mode::LAYER_NORM,
+            "rms norm is not supported by cuda general norm");
     bool affine = p.affine;
     uint64_t axis_start = p.axis_start;
     uint64_t axis_end = p.axis_end;
@@ -133,7 +133,34 @@ HandleImpl::HandleVendorType HandleImpl::vendor_type() const {
     return HandleVendorType::CUDA;
 }
 
+namespace {
+struct PlanStorageHolder {
+    std::mutex mtx;
+    std::shared_ptr<CudnnPlanStorage> storage;
+};
+
+PlanStorageHolder& plan_storage_holder() {
+    static PlanStorageHolder inst;
+    return inst;
+}
+}  // anonymous namespace
+
+std::shared_ptr<CudnnPlanStorage> cudnn_plan_storage() {
+    auto&& holder = plan_storage_holder();
+    MEGDNN_LOCK_GUARD(holder.mtx);
+    return holder.storage;
+}
+
 }  // namespace cuda
+
+std::shared_ptr<CudnnPlanStorage> set_cudnn_plan_storage(
+        std::shared_ptr<CudnnPlanStorage> storage) {
+    auto&& holder = cuda::plan_storage_holder();
+    MEGDNN_LOCK_GUARD(holder.mtx);
+    std::swap(holder.storage, storage);
+    return storage;
+}
+
 }  // namespace megdnn
 
 MEGDNN_VERSION_SYMBOL(CUDA, CUDA_VERSION);
@@ -1,6 +1,7 @@
 #pragma once
 #include "megcore_cuda.h"
 #include "megdnn/basic_types.h"
+#include "megdnn/cuda.h"
 #include "megdnn/handle.h"
 #include "megdnn/oprs/general.h"
 
@@ -123,6 +124,9 @@ private:
     void initialize_cusolver();
 };
 
+//! the storage set by set_cudnn_plan_storage(), which may be null
+std::shared_ptr<CudnnPlanStorage> cudnn_plan_storage();
+
 }  // namespace cuda
 }  // namespace megdnn
 
@@ -27,10 +27,12 @@
 #include "src/cuda/dropout/opr_impl.h"
 #include "src/cuda/elemwise/opr_impl.h"
 #include "src/cuda/elemwise_multi_type/opr_impl.h"
+#include "src/cuda/embedding_bag/opr_impl.h"
 #include "src/cuda/eye/opr_impl.h"
 #include "src/cuda/fake_quant/opr_impl.h"
 #include "src/cuda/fill/opr_impl.h"
 #include "src/cuda/flip/opr_impl.h"
+#include "src/cuda/fused_optimizer/opr_impl.h"
 #include "src/cuda/gaussian_blur/opr_impl.h"
 #include "src/cuda/general_norm/opr_impl.h"
 #include "src/cuda/group_local/opr_impl.h"
@@ -38,6 +40,7 @@
 #include "src/cuda/images2neibs/opr_impl.h"
 #include "src/cuda/indexing_multi_axis_vec/opr_impl.h"
 #include "src/cuda/indexing_one_hot/opr_impl.h"
+#include "src/cuda/kv_cache/opr_impl.h"
 #include "src/cuda/lamb/opr_impl.h"
 #include "src/cuda/layer_norm/opr_impl.h"
 #include "src/cuda/linspace/opr_impl.h"
@@ -162,6 +165,7 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(GammaRNG);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(BetaRNG);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(PoissonRNG);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(MultinomialRNG);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(LogitsSamplingRNG);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(PermutationRNG);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ShuffleRNGForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ShuffleRNGBackward);
@@ -227,9 +231,11 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(PaddingForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(PaddingBackward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(LayerNormForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(LayerNormBackward);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(ResidualLayerNormForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(GeneralNormForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(GeneralNormBackward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(LAMBUpdate);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(FusedOptimizerUpdate);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(DropoutForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(DropoutBackward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(SoftmaxForward);
@@ -240,6 +246,10 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(RegionRestrictedConvolutionBackwardData);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(RegionRestrictedConvolutionBackwardFilter);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(MultiHeadAttnForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(MultiHeadAttnBackward);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(KVCacheAppend);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(KVCacheAttention);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(EmbeddingBagForward);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(EmbeddingBagBackward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Cross);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(WhereForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(WhereBackward);
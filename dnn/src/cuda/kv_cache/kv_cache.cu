@@ -0,0 +1,186 @@
+#include "megdnn/dtype.h"
+#include "src/cuda/kv_cache/kv_cache.cuh"
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace kv_cache {
+
+namespace {
+
+constexpr uint32_t NR_THREADS = 256;
+constexpr uint32_t NR_ATTN_THREADS = 128;
+
+/*!
+ * thread i of a head computes channel i of q, k and v; the threads in the
+ * first half of the rotary channels also compute their rotary partners
+ */
+template <typename T>
+__global__ void append_kernel(
+        const T* qkv, const int32_t* positions, const int32_t* block_table,
+        T* k_cache, T* v_cache, T* q, uint32_t seqlen, uint32_t rotary_dim,
+        float log_base, CacheDesc desc) {
+    uint32_t H = desc.num_heads, D = desc.head_dim, BS = desc.block_size;
+    uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x;
+    if (idx >= desc.batch * seqlen * H * D) {
+        return;
+    }
+    uint32_t i = idx % D, h = idx / D % H, t = idx / D / H % seqlen,
+             b = idx / D / H / seqlen;
+    uint32_t half = rotary_dim / 2;
+    if (i >= half && i < rotary_dim) {
+        return;
+    }
+    int32_t pos = positions[b] + t;
+    uint32_t phys = block_table[b * desc.max_nr_blocks + pos / BS];
+    size_t cache_off = ((static_cast<size_t>(phys) * H + h) * BS + pos % BS) * D;
+    const T* row = qkv + (static_cast<size_t>(b) * seqlen + t) * 3 * H * D;
+    const T* q_src = row + h * D;
+    const T* k_src = row + (H + h) * D;
+    T* q_dst = q + ((static_cast<size_t>(b) * H + h) * seqlen + t) * D;
+    T* k_dst = k_cache + cache_off;
+    v_cache[cache_off + i] = row[(2 * H + h) * D + i];
+    if (i >= rotary_dim) {
+        q_dst[i] = q_src[i];
+        k_dst[i] = k_src[i];
+        return;
+    }
+    float angle = pos * __expf(-2.f * i / rotary_dim * log_base);
+    float c, s;
+    __sincosf(angle, &s, &c);
+    float x1 = q_src[i], x2 = q_src[i + half];
+    q_dst[i] = x1 * c - x2 * s;
+    q_dst[i + half] = x2 * c + x1 * s;
+    x1 = k_src[i];
+    x2 = k_src[i + half];
+    k_dst[i] = x1 * c - x2 * s;
+    k_dst[i + half] = x2 * c + x1 * s;
+    v_cache[cache_off + i + half] = row[(2 * H + h) * D + i + half];
+}
+
+//! reduce \p val over the block with \p op, \p buf has NR_ATTN_THREADS floats
+template <typename Op>
+__device__ __forceinline__ float block_reduce(float val, float* buf, Op op) {
+    buf[threadIdx.x] = val;
+    __syncthreads();
+    for (uint32_t stride = NR_ATTN_THREADS / 2; stride; stride >>= 1) {
+        if (threadIdx.x < stride) {
+            buf[threadIdx.x] = op(buf[threadIdx.x], buf[threadIdx.x + stride]);
+        }
+        __syncthreads();
+    }
+    float ret = buf[0];
+    __syncthreads();
+    return ret;
+}
+
+struct MaxOp {
+    __device__ float operator()(float a, float b) const { return fmaxf(a, b); }
+};
+
+struct SumOp {
+    __device__ float operator()(float a, float b) const { return a + b; }
+};
+
+/*!
+ * block (b * num_heads + h) * seqlen + t handles the query at step t of head
+ * h of sequence b; the scores are kept in the workspace as the cache of a
+ * sequence can be longer than the shared memory
+ */
+template <typename T>
+__global__ void attention_kernel(
+        const T* q, const T* k_cache, const T* v_cache, const int32_t* positions,
+        const int32_t* block_table, T* dst, float* workspace, uint32_t seqlen,
+        float scale, CacheDesc desc) {
+    __shared__ float buf[NR_ATTN_THREADS];
+    uint32_t H = desc.num_heads, D = desc.head_dim, BS = desc.block_size;
+    uint32_t query = blockIdx.x;
+    uint32_t t = query % seqlen, h = query / seqlen % H, b = query / seqlen / H;
+    uint32_t len = positions[b] + t + 1;
+    const int32_t* table = block_table + b * desc.max_nr_blocks;
+    const T* qrow = q + static_cast<size_t>(query) * D;
+    float* score = workspace + static_cast<size_t>(query) * BS * desc.max_nr_blocks;
+    auto cache_off = [&](uint32_t j) {
+        return ((static_cast<size_t>(table[j / BS]) * H + h) * BS + j % BS) * D;
+    };
+
+    float max_score = -INFINITY;
+    for (uint32_t j = threadIdx.x; j < len; j += NR_ATTN_THREADS) {
+        const T* krow = k_cache + cache_off(j);
+        float s = 0;
+        for (uint32_t d = 0; d < D; ++d) {
+            s += static_cast<float>(qrow[d]) * static_cast<float>(krow[d]);
+        }
+        s *= scale;
+        score[j] = s;
+        max_score = fmaxf(max_score, s);
+    }
+    max_score = block_reduce(max_score, buf, MaxOp());
+    float sum = 0;
+    for (uint32_t j = threadIdx.x; j < len; j += NR_ATTN_THREADS) {
+        float e = __expf(score[j] - max_score);
+        score[j] = e;
+        sum += e;
+    }
+    sum = block_reduce(sum, buf, SumOp());
+
+    T* out = dst + (static_cast<size_t>(b) * seqlen + t) * H * D + h * D;
+    for (uint32_t d = threadIdx.x; d < D; d += NR_ATTN_THREADS) {
+        float acc = 0;
+        for (uint32_t j = 0; j < len; ++j) {
+            acc += score[j] * static_cast<float>(v_cache[cache_off(j) + d]);
+        }
+        out[d] = acc / sum;
+    }
+}
+
+}  // anonymous namespace
+
+template <typename T>
+void append(
+        const T* qkv, const int32_t* positions, const int32_t* block_table,
+        T* k_cache, T* v_cache, T* q, uint32_t seqlen, uint32_t rotary_dim,
+        float rotary_base, const CacheDesc& desc, cudaStream_t stream) {
+    uint32_t total = desc.batch * seqlen * desc.num_heads * desc.head_dim;
+    if (!total) {
+        return;
+    }
+    append_kernel<T><<<DIVUP(total, NR_THREADS), NR_THREADS, 0, stream>>>(
+            qkv, positions, block_table, k_cache, v_cache, q, seqlen, rotary_dim,
+            logf(rotary_base), desc);
+    after_kernel_launch();
+}
+
+template <typename T>
+void attention(
+        const T* q, const T* k_cache, const T* v_cache, const int32_t* positions,
+        const int32_t* block_table, T* dst, float* workspace, uint32_t seqlen,
+        float scale, const CacheDesc& desc, cudaStream_t stream) {
+    uint32_t nr_queries = desc.batch * desc.num_heads * seqlen;
+    if (!nr_queries) {
+        return;
+    }
+    attention_kernel<T><<<nr_queries, NR_ATTN_THREADS, 0, stream>>>(
+            q, k_cache, v_cache, positions, block_table, dst, workspace, seqlen,
+            scale, desc);
+    after_kernel_launch();
+}
+
+#define INST(T)                                                               \
+    template void append<T>(                                                  \
+            const T*, const int32_t*, const int32_t*, T*, T*, T*, uint32_t,   \
+            uint32_t, float, const CacheDesc&, cudaStream_t);                 \
+    template void attention<T>(                                               \
+            const T*, const T*, const T*, const int32_t*, const int32_t*, T*, \
+            float*, uint32_t, float, const CacheDesc&, cudaStream_t);
+
+INST(dt_float32)
+INST(dt_float16)
+INST(dt_bfloat16)
+#undef INST
+
+}  // namespace kv_cache
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
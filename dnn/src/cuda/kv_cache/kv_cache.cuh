@@ -0,0 +1,40 @@
+#pragma once
+#include <cuda_runtime_api.h>
+#include <stdint.h>
+
+namespace megdnn {
+namespace cuda {
+namespace kv_cache {
+
+struct CacheDesc {
+    //! batch, number of heads, head_dim, block_size and max_nr_blocks
+    uint32_t batch, num_heads, head_dim, block_size, max_nr_blocks;
+};
+
+/*!
+ * \brief split \p qkv into heads, rotate q and k and append k and v into the
+ *      cache, each thread handles one channel of the three heads
+ */
+template <typename T>
+void append(
+        const T* qkv, const int32_t* positions, const int32_t* block_table,
+        T* k_cache, T* v_cache, T* q, uint32_t seqlen, uint32_t rotary_dim,
+        float rotary_base, const CacheDesc& desc, cudaStream_t stream);
+
+/*!
+ * \brief causal attention over the cache, one block for each query
+ *
+ * \param workspace batch * num_heads * seqlen * block_size * max_nr_blocks
+ *      floats of the attention scores
+ */
+template <typename T>
+void attention(
+        const T* q, const T* k_cache, const T* v_cache, const int32_t* positions,
+        const int32_t* block_table, T* dst, float* workspace, uint32_t seqlen,
+        float scale, const CacheDesc& desc, cudaStream_t stream);
+
+}  // namespace kv_cache
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,73 @@
+#include "src/cuda/kv_cache/opr_impl.h"
+#include <cmath>
+#include "src/cuda/kv_cache/kv_cache.cuh"
+#include "src/cuda/utils.h"
+
+namespace megdnn {
+namespace cuda {
+
+void KVCacheAppendImpl::exec(
+        _megdnn_tensor_in qkv, _megdnn_tensor_in positions,
+        _megdnn_tensor_in block_table, _megdnn_tensor_inout k_cache,
+        _megdnn_tensor_inout v_cache, _megdnn_tensor_out q,
+        _megdnn_workspace workspace) {
+    check_exec(
+            qkv.layout, positions.layout, block_table.layout, k_cache.layout,
+            v_cache.layout, q.layout, workspace.size);
+    kv_cache::CacheDesc desc{
+            static_cast<uint32_t>(qkv.layout[0]), param().num_heads,
+            static_cast<uint32_t>(k_cache.layout[3]),
+            static_cast<uint32_t>(k_cache.layout[2]),
+            static_cast<uint32_t>(block_table.layout[1])};
+    auto stream = cuda_stream(handle());
+#define cb(DType)                                                                   \
+    if (qkv.layout.dtype == DType()) {                                              \
+        using T = typename DTypeTrait<DType>::ctype;                                \
+        kv_cache::append<T>(                                                        \
+                qkv.ptr<T>(), positions.ptr<dt_int32>(),                            \
+                block_table.ptr<dt_int32>(), k_cache.ptr<T>(), v_cache.ptr<T>(),    \
+                q.ptr<T>(), qkv.layout[1], param().rotary_dim, param().rotary_base, \
+                desc, stream);                                                      \
+        return;                                                                     \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+void KVCacheAttentionImpl::exec(
+        _megdnn_tensor_in q, _megdnn_tensor_in k_cache, _megdnn_tensor_in v_cache,
+        _megdnn_tensor_in positions, _megdnn_tensor_in block_table,
+        _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(
+            q.layout, k_cache.layout, v_cache.layout, positions.layout,
+            block_table.layout, dst.layout, workspace.size);
+    kv_cache::CacheDesc desc{
+            static_cast<uint32_t>(q.layout[0]), static_cast<uint32_t>(q.layout[1]),
+            static_cast<uint32_t>(q.layout[3]),
+            static_cast<uint32_t>(k_cache.layout[2]),
+            static_cast<uint32_t>(block_table.layout[1])};
+    float scale = param().scale;
+    if (scale == 0) {
+        scale = 1.f / std::sqrt(static_cast<float>(q.layout[3]));
+    }
+    auto stream = cuda_stream(handle());
+#define cb(DType)                                                              \
+    if (q.layout.dtype == DType()) {                                           \
+        using T = typename DTypeTrait<DType>::ctype;                           \
+        kv_cache::attention<T>(                                                \
+                q.ptr<T>(), k_cache.ptr<T>(), v_cache.ptr<T>(),                \
+                positions.ptr<dt_int32>(), block_table.ptr<dt_int32>(),        \
+                dst.ptr<T>(), workspace.ptr<dt_float32>(), q.layout[2], scale, \
+                desc, stream);                                                 \
+        return;                                                                \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,43 @@
+#pragma once
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace cuda {
+
+class KVCacheAppendImpl final : public KVCacheAppend {
+public:
+    using KVCacheAppend::KVCacheAppend;
+    void exec(
+            _megdnn_tensor_in qkv, _megdnn_tensor_in positions,
+            _megdnn_tensor_in block_table, _megdnn_tensor_inout k_cache,
+            _megdnn_tensor_inout v_cache, _megdnn_tensor_out q,
+            _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+};
+
+class KVCacheAttentionImpl final : public KVCacheAttention {
+public:
+    using KVCacheAttention::KVCacheAttention;
+    void exec(
+            _megdnn_tensor_in q, _megdnn_tensor_in k_cache, _megdnn_tensor_in v_cache,
+            _megdnn_tensor_in positions, _megdnn_tensor_in block_table,
+            _megdnn_tensor_out dst, _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout& q, const TensorLayout& k_cache, const TensorLayout&,
+            const TensorLayout&, const TensorLayout& block_table,
+            const TensorLayout&) override {
+        //! the scores of each query over the whole cache of its sequence
+        return sizeof(float) * q[0] * q[1] * q[2] * k_cache[2] * block_table[1];
+    }
+};
+
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -129,24 +129,12 @@ combine_welford_stat(const WelfordStat lhs, const WelfordStat rhs) {
     return {mean, sigma2, count};
 }
 
-template <typename T>
+/*!
+ * reduce the per-thread stats of a slice over the whole block, which returns
+ * the mean and the biased variance of the slice to every thread
+ */
 MEGDNN_DEVICE WelfordStat
-compute_stats(const T* __restrict__ X, const int slice_len, float* buf) {
-    using vec_t = aligned_vector<T, vec_size>;
-    using acc_t = acc_type<T, true>;
-    const vec_t* X_vec = reinterpret_cast<const vec_t*>(X);
-    const int numx = blockDim.x * blockDim.y;
-    const int thrx = threadIdx.x + threadIdx.y * blockDim.x;
-    const int n_vec_to_read = slice_len / vec_size;
-    WelfordStat w_stat(0.f, 0.f, 0.f);
-    for (int i = thrx; i < n_vec_to_read; i += numx) {
-        vec_t data = X_vec[i];
-#pragma unroll
-        for (int ii = 0; ii < vec_size; ii++) {
-            w_stat = update_welford_stat_online(
-                    static_cast<acc_t>(data.val[ii]), w_stat);
-        }
-    }
+block_reduce_stats(WelfordStat w_stat, const int slice_len, float* buf) {
     // intra-warp reduction
 #pragma unroll
     for (int offset = (warpSize >> 1); offset > 0; offset >>= 1) {
@@ -195,6 +183,27 @@ compute_stats(const T* __restrict__ X, const int slice_len, float* buf) {
     }
 }
 
+template <typename T>
+MEGDNN_DEVICE WelfordStat
+compute_stats(const T* __restrict__ X, const int slice_len, float* buf) {
+    using vec_t = aligned_vector<T, vec_size>;
+    using acc_t = acc_type<T, true>;
+    const vec_t* X_vec = reinterpret_cast<const vec_t*>(X);
+    const int numx = blockDim.x * blockDim.y;
+    const int thrx = threadIdx.x + threadIdx.y * blockDim.x;
+    const int n_vec_to_read = slice_len / vec_size;
+    WelfordStat w_stat(0.f, 0.f, 0.f);
+    for (int i = thrx; i < n_vec_to_read; i += numx) {
+        vec_t data = X_vec[i];
+#pragma unroll
+        for (int ii = 0; ii < vec_size; ii++) {
+            w_stat = update_welford_stat_online(
+                    static_cast<acc_t>(data.val[ii]), w_stat);
+        }
+    }
+    return block_reduce_stats(w_stat, slice_len, buf);
+}
+
 template <typename T, typename T_ACC>
 __global__ void vectorized_layer_norm_forward_affine_kernel(
         const int slice_len, T_ACC eps, const T* __restrict__ X, const T* weight,
@@ -292,6 +301,73 @@ void launch_vectorized_layer_norm_forward_kernel(
     after_kernel_launch();
 }
 
+/*!
+ * S = X + R and Y = LayerNorm(S) of a slice in a single pass over the global
+ * memory: the stats are accumulated while S is written, and each thread reads
+ * back only the S vectors written by itself to normalize them
+ */
+template <typename T, typename T_ACC>
+__global__ void vectorized_residual_layer_norm_forward_kernel(
+        const int slice_len, T_ACC eps, const T* __restrict__ X,
+        const T* __restrict__ R, const T* weight, const T* bias, T_ACC* mean,
+        T_ACC* rstd, T* Y, T* S) {
+    extern __shared__ float s_data[];
+
+    using vec_t = aligned_vector<T, vec_size>;
+    auto slice_id = blockIdx.x;
+    const vec_t* X_vec = reinterpret_cast<const vec_t*>(X + slice_id * slice_len);
+    const vec_t* R_vec = reinterpret_cast<const vec_t*>(R + slice_id * slice_len);
+    vec_t* S_vec = reinterpret_cast<vec_t*>(S + slice_id * slice_len);
+    vec_t* Y_vec = reinterpret_cast<vec_t*>(Y + slice_id * slice_len);
+    const int numx = blockDim.x * blockDim.y;
+    const int thrx = threadIdx.x + threadIdx.y * blockDim.x;
+    const int n_vec_to_read = slice_len / vec_size;
+
+    WelfordStat w_stat(0.f, 0.f, 0.f);
+    for (int i = thrx; i < n_vec_to_read; i += numx) {
+        vec_t data = X_vec[i], res = R_vec[i], sum;
+#pragma unroll
+        for (int ii = 0; ii < vec_size; ii++) {
+            sum.val[ii] = static_cast<T_ACC>(data.val[ii]) +
+                          static_cast<T_ACC>(res.val[ii]);
+            w_stat = update_welford_stat_online(
+                    static_cast<T_ACC>(sum.val[ii]), w_stat);
+        }
+        S_vec[i] = sum;
+    }
+    WelfordStat slice_w_stat = block_reduce_stats(w_stat, slice_len, s_data);
+    T_ACC rstd_val = static_cast<T_ACC>(rsqrt(slice_w_stat.sigma2 + eps));
+
+    for (int i = thrx; i < n_vec_to_read; i += numx) {
+        vec_t sum = S_vec[i];
+        vec_t out;
+#pragma unroll
+        for (int ii = 0; ii < vec_size; ii++) {
+            T_ACC val =
+                    rstd_val * (static_cast<T_ACC>(sum.val[ii]) - slice_w_stat.mean);
+            if (weight != nullptr) {
+                val = val * static_cast<T_ACC>(weight[i * vec_size + ii]) +
+                      static_cast<T_ACC>(bias[i * vec_size + ii]);
+            }
+            out.val[ii] = val;
+        }
+        Y_vec[i] = out;
+    }
+    if (thrx == 0) {
+        mean[slice_id] = slice_w_stat.mean;
+        rstd[slice_id] = rstd_val;
+    }
+}
+
+template <typename T, typename T_ACC>
+__global__ void residual_add_kernel(
+        int64_t nr_elems, const T* X, const T* R, T* S) {
+    for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nr_elems;
+         i += blockDim.x * gridDim.x) {
+        S[i] = static_cast<T_ACC>(X[i]) + static_cast<T_ACC>(R[i]);
+    }
+}
+
 template <typename T, class ReduceOp>
 __inline__ MEGDNN_DEVICE T welford_warp_reduce(T val, const ReduceOp& op) {
 #pragma unroll
@@ -399,6 +475,37 @@ void forward(
     }
 }
 
+template <typename T, typename T_ACC>
+void forward_residual(
+        T* X, T* R, T* weight, T* bias, int64_t slice_num, int64_t slice_len,
+        T_ACC eps, T* Y, T* S, T_ACC* mean, T_ACC* rstd, cudaStream_t stream) {
+    auto can_vectorize = [&](const T* ptr, int alignment) {
+        uint64_t addr = reinterpret_cast<uint64_t>(ptr);
+        return addr % alignment == 0;
+    };
+    constexpr int alignment = vec_size * sizeof(T);
+    if (slice_len <= static_cast<int64_t>(1ULL << std::numeric_limits<float>::digits) &&
+        slice_len % vec_size == 0 && can_vectorize(X, alignment) &&
+        can_vectorize(R, alignment) && can_vectorize(S, alignment) &&
+        can_vectorize(Y, alignment)) {
+        const dim3 threads(WARP_SIZE, 128 / WARP_SIZE, 1);
+        int nshared = threads.y * 3 / 2 * sizeof(T_ACC);
+        vectorized_residual_layer_norm_forward_kernel<T, T_ACC>
+                <<<slice_num, threads, nshared, stream>>>(
+                        slice_len, eps, X, R, weight, bias, mean, rstd, Y, S);
+        after_kernel_launch();
+    } else {
+        int64_t nr_elems = slice_num * slice_len;
+        int nr_blocks = std::min<int64_t>(
+                DIVUP(nr_elems, kCUDANumThreads), std::numeric_limits<int>::max());
+        residual_add_kernel<T, T_ACC>
+                <<<nr_blocks, kCUDANumThreads, 0, stream>>>(nr_elems, X, R, S);
+        after_kernel_launch();
+        forward<T, T_ACC>(
+                S, weight, bias, slice_num, slice_len, eps, Y, mean, rstd, stream);
+    }
+}
+
 template <typename T>
 __inline__ MEGDNN_DEVICE T warp_reduce_sum(T val) {
 #pragma unroll
@@ -639,7 +746,10 @@ void backward(
             T*, T*, T*, int64_t, int64_t, T_ACC, T*, T_ACC*, T_ACC*, cudaStream_t); \
     template void backward<T, T_ACC>(                                               \
             const T*, const T*, const T_ACC*, const T_ACC*, const T*, int64_t,      \
-            int64_t, T*, T*, T*, cudaStream_t);
+            int64_t, T*, T*, T*, cudaStream_t);                                     \
+    template void forward_residual<T, T_ACC>(                                       \
+            T*, T*, T*, T*, int64_t, int64_t, T_ACC, T*, T*, T_ACC*, T_ACC*,        \
+            cudaStream_t);
 
 INST(dt_float32, dt_float32)
 INST(dt_float16, dt_float32)
@@ -10,6 +10,12 @@ void forward(
         T* X, T* gamma, T* beta, int64_t M, int64_t N, T_ACC eps, T* Y, T_ACC* mean,
         T_ACC* rstd, cudaStream_t stream);
 
+//! S = X + R and Y = LayerNorm(S)
+template <typename T, typename T_ACC>
+void forward_residual(
+        T* X, T* R, T* gamma, T* beta, int64_t M, int64_t N, T_ACC eps, T* Y, T* S,
+        T_ACC* mean, T_ACC* rstd, cudaStream_t stream);
+
 template <typename T, typename T_ACC>
 void backward(
         const T* dY_data, const T* X_data, const T_ACC* mean_data,
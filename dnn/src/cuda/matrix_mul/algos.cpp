@@ -110,6 +110,10 @@ void MatrixMulForwardImpl::AlgoPack::fill_cutlass_algos() {
     cb(256, 128, 32, 64, 64, 32, 16, 8, 8);        \
     cb(128, 256, 32, 64, 64, 32, 16, 8, 8);        \
     cb(128, 128, 32, 64, 64, 32, 16, 8, 8);
+#define FOREACH_CUTLASS_MATMUL_MMA_SM80_SHAPES(cb) \
+    cb(256, 128, 32, 64, 64, 32, 16, 8, 16, 3);    \
+    cb(128, 256, 32, 64, 64, 32, 16, 8, 16, 3);    \
+    cb(128, 128, 32, 64, 64, 32, 16, 8, 16, 4);
 #define cb(...)                                            \
     tensorop_float16.emplace_back(AlgoParam{__VA_ARGS__}); \
     tensorop_float16_split_k.emplace_back(AlgoParam{__VA_ARGS__});
@@ -119,9 +123,13 @@ void MatrixMulForwardImpl::AlgoPack::fill_cutlass_algos() {
 #if CUDA_VERSION >= 10020
     FOREACH_CUTLASS_MATMUL_MMA_SM75_SHAPES(cb)
 #endif
+#if CUDA_VERSION >= 11000
+    FOREACH_CUTLASS_MATMUL_MMA_SM80_SHAPES(cb)
+#endif
 #undef cb
 #undef FOREACH_CUTLASS_MATMUL_MMA_SM70_SHAPES
 #undef FOREACH_CUTLASS_MATMUL_MMA_SM75_SHAPES
+#undef FOREACH_CUTLASS_MATMUL_MMA_SM80_SHAPES
 }
 #endif
 
@@ -209,10 +209,12 @@ public:
         int threadblock_m, threadblock_n, threadblock_k;
         int warp_m, warp_n, warp_k;
         int instruction_m, instruction_n, instruction_k;
+        //! number of pipeline stages, more than 2 for the sm80 multistage kernels
+        int stage;
         AlgoParam(
                 int threadblock_m_, int threadblock_n_, int threadblock_k_, int warp_m_,
                 int warp_n_, int warp_k_, int instruction_m_ = 1,
-                int instruction_n_ = 1, int instruction_k_ = 1)
+                int instruction_n_ = 1, int instruction_k_ = 1, int stage_ = 2)
                 : threadblock_m{threadblock_m_},
                   threadblock_n{threadblock_n_},
                   threadblock_k{threadblock_k_},
@@ -221,16 +223,25 @@ public:
                   warp_k{warp_k_},
                   instruction_m{instruction_m_},
                   instruction_n{instruction_n_},
-                  instruction_k{instruction_k_} {}
+                  instruction_k{instruction_k_},
+                  stage{stage_} {}
         std::string to_string() const;
     };
     AlgoCutlassMatrixMulBase(AlgoParam algo_param) : m_algo_param{algo_param} {}
     void exec(const ExecArgs& args) const override;
     std::string param() const override {
         std::string ret;
-        serialize_write_pod(m_algo_param, ret);
+        //! the stage is only written for multistage kernels, so the params of the
+        //! two stage kernels stay compatible with existing fastrun caches
+        ret.append(
+                reinterpret_cast<const char*>(&m_algo_param),
+                offsetof(AlgoParam, stage));
+        if (m_algo_param.stage != 2) {
+            serialize_write_pod(m_algo_param.stage, ret);
+        }
         return ret;
     }
+    const AlgoParam& algo_param() const { return m_algo_param; }
 
 protected:
     virtual int min_alignment_requirement() const = 0;
@@ -238,6 +249,9 @@ protected:
     std::pair<bool, TensorLayoutArray> construct_aligned_layouts(
             const SizeArgs& args) const;
     int max_alignment(const SizeArgs& args) const;
+    //! number of k slices of the parallel split k kernels, see the
+    //! implementation for the heuristic
+    int get_split_k_slices(int m, int n, int k) const;
     AlgoParam m_algo_param;
 };
 
@@ -17,11 +17,26 @@ static cudaDataType_t to_cuda_dtype(DType tp) {
         case DTypeEnum::Int32:
         case DTypeEnum::QuantizedS32:
             return CUDA_R_32I;
+#if CUDA_VERSION >= 11080
+        case DTypeEnum::Float8E4M3:
+            return CUDA_R_8F_E4M3;
+        case DTypeEnum::Float8E5M2:
+            return CUDA_R_8F_E5M2;
+#endif
         default:
-            megdnn_throw("dtype must be float16/float32/int8/qs8/int32");
+            megdnn_throw("dtype must be float16/float32/int8/qs8/int32/float8");
     }
 }
 
+static bool is_float8(cudaDataType_t tp) {
+#if CUDA_VERSION >= 11080
+    return tp == CUDA_R_8F_E4M3 || tp == CUDA_R_8F_E5M2;
+#else
+    MEGDNN_MARK_USED_VAR(tp);
+    return false;
+#endif
+}
+
 #if CUDA_VERSION >= 11000
 static cublasComputeType_t to_cublas_compute_type(DType tp) {
     switch (tp.enumv()) {
@@ -48,14 +63,24 @@ static const char* cuda_type_to_str(cudaDataType_t tp) {
             return "CUDA_R_8I";
         case CUDA_R_32I:
             return "CUDA_R_32I";
+#if CUDA_VERSION >= 11080
+        case CUDA_R_8F_E4M3:
+            return "CUDA_R_8F_E4M3";
+        case CUDA_R_8F_E5M2:
+            return "CUDA_R_8F_E5M2";
+#endif
         default:
-            megdnn_throw("dtype must be float16/float32/int8/int32");
+            megdnn_throw("dtype must be float16/float32/int8/int32/float8");
     }
 }
 
 static size_t cuda_dtype_size(cudaDataType_t dt) {
     switch (dt) {
         case CUDA_R_8I:
+#if CUDA_VERSION >= 11080
+        case CUDA_R_8F_E4M3:
+        case CUDA_R_8F_E5M2:
+#endif
             return 1_z;
         case CUDA_R_16F:
             return 2_z;
@@ -63,7 +88,7 @@ static size_t cuda_dtype_size(cudaDataType_t dt) {
         case CUDA_R_32I:
             return 4_z;
         default:
-            megdnn_throw("dtype must be float16/float32/int8/int32");
+            megdnn_throw("dtype must be float16/float32/int8/int32/float8");
     }
 }
 
@@ -97,8 +122,14 @@ void CUBLASLTMatmulDesc::set(const SizeArgs& args, bool batched) {
 
     megdnn_assert(dt_a == dt_b, "matrix A and B should have same precision");
 #if CUDA_VERSION >= 11000
-    dt_compute = to_cublas_compute_type(args.layout_c.dtype);
-    cublas_check(cublasLtMatmulDescCreate(&matmul_desc, dt_compute, dt_c));
+    if (is_float8(dt_a)) {
+        //! fp8 matmul only supports float32 compute type and scale type
+        dt_compute = CUBLAS_COMPUTE_32F;
+        cublas_check(cublasLtMatmulDescCreate(&matmul_desc, dt_compute, CUDA_R_32F));
+    } else {
+        dt_compute = to_cublas_compute_type(args.layout_c.dtype);
+        cublas_check(cublasLtMatmulDescCreate(&matmul_desc, dt_compute, dt_c));
+    }
 #else
     dt_compute = dt_c;
     cublas_check(cublasLtMatmulDescCreate(&matmul_desc, dt_compute));
@@ -217,14 +248,14 @@ bool CUBLASLTMatmulDesc::is_available(const SizeArgs& args, size_t ws_limit) {
     cublasLtMatmulAlgo_t algo;
     switch (dt_c) {
         case CUDA_R_16F:
-            support = (dt_a == CUDA_R_16F);
+            support = (dt_a == CUDA_R_16F || is_float8(dt_a));
             break;
         case CUDA_R_32I: {
             support = (dt_a == CUDA_R_8I) && (!args.transposeA && !args.transposeB);
             break;
         }
         case CUDA_R_32F:
-            support = (dt_a == CUDA_R_16F || dt_a == CUDA_R_32F);
+            support = (dt_a == CUDA_R_16F || dt_a == CUDA_R_32F || is_float8(dt_a));
             break;
         case CUDA_R_64F: /* not support? */
         default:
@@ -232,6 +263,13 @@ bool CUBLASLTMatmulDesc::is_available(const SizeArgs& args, size_t ws_limit) {
             break;
     }
     support = support && dt_a == dt_b;
+    if (is_float8(dt_a)) {
+        //! fp8 kernels need sm89 and the TN layout of cublas, i.e. row-major A
+        //! and transposed B of megdnn; E5M2 x E5M2 is not supported by cublasLt
+        support = support && is_compute_capability_required(8, 9) &&
+                  !args.transposeA && args.transposeB &&
+                  args.layout_a.dtype.enumv() == DTypeEnum::Float8E4M3;
+    }
     support = support && get_algorithm_heuristic(args, ws_limit, algo);
     return support;
 }
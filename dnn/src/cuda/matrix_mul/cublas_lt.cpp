@@ -62,6 +62,18 @@ void MatrixMulForwardImpl::AlgoCuBlasLt::exec(const ExecArgs& args) const {
                 desc.layout_c, static_cast<__half*>(args.tensor_c.raw_ptr()),
                 desc.layout_c, &algo, ws_bundle.get(0), ws_bundle.get_size(0), stream));
     };
+    auto fp8gemm = [&]() {
+        auto zero = handle->zero_device();
+        auto one = handle->one_device();
+        megdnn_assert(
+                ws_bundle.nr_workspace() == 1,
+                "workspace bundle size should be 1(ws_algo)");
+        cublas_check(cublasLtMatmul(
+                cublasLt_handle, desc.matmul_desc, one, args.tensor_b.raw_ptr(),
+                desc.layout_b, args.tensor_a.raw_ptr(), desc.layout_a, zero,
+                args.tensor_c.raw_ptr(), desc.layout_c, args.tensor_c.raw_ptr(),
+                desc.layout_c, &algo, ws_bundle.get(0), ws_bundle.get_size(0), stream));
+    };
     auto igemm = [&]() {
         auto zero = handle->zero_device();
         auto one = handle->one_device();
@@ -113,6 +125,9 @@ void MatrixMulForwardImpl::AlgoCuBlasLt::exec(const ExecArgs& args) const {
         case CUBLAS_COMPUTE_32I:
             igemm();
             break;
+        case CUBLAS_COMPUTE_32F:
+            fp8gemm();
+            break;
         default:
             megdnn_throw("compute type must be float16/float32/int32");
     }
@@ -22,11 +22,15 @@ bool MatrixMulForwardImpl::AlgoFloat16TensorOp::is_available(
     if (m_algo_param.instruction_m == 8 && m_algo_param.instruction_n == 8 &&
         m_algo_param.instruction_k == 4) {
         available &= is_compute_capability_required(7, 0);
+    } else if (m_algo_param.instruction_k == 8) {
+        megdnn_assert(
+                m_algo_param.instruction_m == 16 && m_algo_param.instruction_n == 8);
+        available &= is_compute_capability_required(7, 5);
     } else {
         megdnn_assert(
                 m_algo_param.instruction_m == 16 && m_algo_param.instruction_n == 8 &&
-                m_algo_param.instruction_k == 8);
-        available &= is_compute_capability_required(7, 5);
+                m_algo_param.instruction_k == 16);
+        available &= is_compute_capability_required(8, 0);
     }
 
     return available;
@@ -107,7 +111,7 @@ void MatrixMulForwardImpl::AlgoFloat16TensorOp::do_exec(const ExecArgs& args) co
             m_algo_param.instruction_m,
             m_algo_param.instruction_n,
             m_algo_param.instruction_k,
-            2,
+            m_algo_param.stage,
             alignment,
             alignment,
             SplitKMode::kNone};
@@ -15,7 +15,8 @@ bool MatrixMulForwardImpl::AlgoFloat16TensorOpSplitK::is_available(
     bool available = args.opr->param().format == param::MatrixMul::Format::DEFAULT &&
                      args.layout_a.dtype == dtype::Float16() &&
                      args.layout_b.dtype == dtype::Float16() &&
-                     args.layout_c.dtype == dtype::Float16() && k > n;
+                     args.layout_c.dtype == dtype::Float16() &&
+                     (k > n || get_split_k_slices(m, n, k) > 1);
     auto&& device_prop = cuda::current_device_prop();
     int y_grid_limit = device_prop.maxGridSize[1];
     // limit y grid
@@ -25,11 +26,15 @@ bool MatrixMulForwardImpl::AlgoFloat16TensorOpSplitK::is_available(
     if (m_algo_param.instruction_m == 8 && m_algo_param.instruction_n == 8 &&
         m_algo_param.instruction_k == 4) {
         available &= is_compute_capability_required(7, 0);
+    } else if (m_algo_param.instruction_k == 8) {
+        megdnn_assert(
+                m_algo_param.instruction_m == 16 && m_algo_param.instruction_n == 8);
+        available &= is_compute_capability_required(7, 5);
     } else {
         megdnn_assert(
                 m_algo_param.instruction_m == 16 && m_algo_param.instruction_n == 8 &&
-                m_algo_param.instruction_k == 8);
-        available &= is_compute_capability_required(7, 5);
+                m_algo_param.instruction_k == 16);
+        available &= is_compute_capability_required(8, 0);
     }
 
     return available;
@@ -41,13 +46,13 @@ size_t MatrixMulForwardImpl::AlgoFloat16TensorOpSplitK::get_workspace_in_bytes(
     auto&& param = args.opr->param();
     int m = args.layout_c.shape[0], n = args.layout_c.shape[1],
         k = args.layout_a.shape[param.transposeA ? 0 : 1];
-    int split_k_slices = std::max(1, k / n);
+    int split_k_slices = get_split_k_slices(m, n, k);
     if (!aligned.first)
         return sizeof(float) * (m * n * split_k_slices);
     const auto& layouts = aligned.second;
     int align_m = layouts[2].shape[0], align_n = layouts[2].shape[1],
         align_k = layouts[0].shape[1];
-    split_k_slices = std::max(1, align_k / align_n);
+    split_k_slices = get_split_k_slices(align_m, align_n, align_k);
     size_t ws_size = sizeof(float) * (align_m * align_n * split_k_slices);
     for (auto&& ly : layouts)
         ws_size += ly.span().dist_byte();
@@ -68,7 +73,7 @@ void MatrixMulForwardImpl::AlgoFloat16TensorOpSplitK::do_exec(
             m % alignment == 0 && n % alignment == 0 && k % alignment == 0 &&
             alignment >= min_alignment);
     cutlass::gemm::GemmCoord problem_size{m, n, k};
-    int split_k_slices = std::max(1, k / n);
+    int split_k_slices = get_split_k_slices(m, n, k);
     auto&& stream = cuda_stream(args.opr->handle());
     int* workspace = reinterpret_cast<int*>(args.workspace.raw_ptr);
     // \note these constants (i.e. one and zero) of cutlass epilogue will be
@@ -118,7 +123,7 @@ void MatrixMulForwardImpl::AlgoFloat16TensorOpSplitK::do_exec(
             m_algo_param.instruction_m,
             m_algo_param.instruction_n,
             m_algo_param.instruction_k,
-            2,
+            m_algo_param.stage,
             alignment,
             alignment,
             SplitKMode::kParallel};
@@ -49,7 +49,8 @@ bool MatrixMulForwardImpl::AlgoFloat32SIMTSplitK::is_available(
     bool available = args.opr->param().format == param::MatrixMul::Format::DEFAULT &&
                      args.layout_a.dtype == dtype::Float32() &&
                      args.layout_b.dtype == dtype::Float32() &&
-                     args.layout_c.dtype == dtype::Float32() && k > n;
+                     args.layout_c.dtype == dtype::Float32() &&
+                     (k > n || get_split_k_slices(m, n, k) > 1);
     auto&& device_prop = cuda::current_device_prop();
     int y_grid_limit = device_prop.maxGridSize[1];
     // limit y grid
@@ -66,7 +67,7 @@ size_t MatrixMulForwardImpl::AlgoFloat32SIMTSplitK::get_workspace_in_bytes(
     auto&& param = args.opr->param();
     int m = args.layout_c.shape[0], n = args.layout_c.shape[1],
         k = args.layout_a.shape[param.transposeA ? 0 : 1];
-    int split_k_slices = std::max(1, k / n);
+    int split_k_slices = get_split_k_slices(m, n, k);
     return args.layout_c.dtype.size(m * n * split_k_slices);
 }
 
@@ -77,7 +78,7 @@ void MatrixMulForwardImpl::AlgoFloat32SIMTSplitK::do_exec(const ExecArgs& args)
     int m = args.tensor_c.layout.shape[0], n = args.tensor_c.layout.shape[1],
         k = args.tensor_a.layout.shape[param.transposeA ? 0 : 1];
     cutlass::gemm::GemmCoord problem_size{m, n, k};
-    int split_k_slices = std::max(1, k / n);
+    int split_k_slices = get_split_k_slices(m, n, k);
     auto&& stream = cuda_stream(args.opr->handle());
     int* workspace = reinterpret_cast<int*>(args.workspace.raw_ptr);
 
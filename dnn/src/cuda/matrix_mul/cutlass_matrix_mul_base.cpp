@@ -9,9 +9,31 @@ using namespace cuda;
 
 std::string MatrixMulForwardImpl::AlgoCutlassMatrixMulBase::AlgoParam::to_string()
         const {
-    return ssprintf(
+    std::string ret = ssprintf(
             "%dX%dX%d_%dX%dX%d", threadblock_m, threadblock_n, threadblock_k, warp_m,
             warp_n, warp_k);
+    if (stage != 2) {
+        ret += ssprintf("_%dstage", stage);
+    }
+    return ret;
+}
+
+/*!
+ * The threadblocks of the output tiles are multiplied by the slices until
+ * they fill every SM at least once, so the skinny matmuls with a long k do not
+ * leave most SMs idle. Each slice still iterates over at least MIN_K_ITERS
+ * threadblock_k to amortize the reduction of the partial sums. The slices only
+ * depend on the shape and the SM count, so no profiling is needed.
+ */
+int MatrixMulForwardImpl::AlgoCutlassMatrixMulBase::get_split_k_slices(
+        int m, int n, int k) const {
+    constexpr int MIN_K_ITERS = 8;
+    int nr_tiles = ((m + m_algo_param.threadblock_m - 1) / m_algo_param.threadblock_m) *
+                   ((n + m_algo_param.threadblock_n - 1) / m_algo_param.threadblock_n);
+    int nr_sms = cuda::current_device_prop().multiProcessorCount;
+    int max_slices = k / (m_algo_param.threadblock_k * MIN_K_ITERS);
+    int slices = (nr_sms + nr_tiles - 1) / nr_tiles;
+    return std::max(1, std::min(slices, max_slices));
 }
 
 std::pair<bool, TensorLayoutArray> MatrixMulForwardImpl::AlgoCutlassMatrixMulBase::
@@ -28,6 +28,32 @@ MatrixMulForwardImpl::Algorithm* MatrixMulForwardImpl::get_algorithm_heuristic(
         size_t workspace_limit_in_bytes, const AlgoAttribute& positive_attr,
         const AlgoAttribute& negative_attr) {
     AlgoBase::SizeArgs args{this, A, B, C};
+#if CUDA_VERSION >= 9020
+    //! the skinny float32 matmuls, like the ones of decoding, only launch a
+    //! few threadblocks along m, so the split k kernels are preferred when
+    //! they are available, i.e. the k dimension is long enough to be split
+    //! over the idle SMs; the tile with the least padded rows is chosen
+    if (C.dtype == dtype::Float32() && C.ndim == 2 && C.shape[0] <= 16) {
+        AlgoFloat32SIMTSplitK* best = nullptr;
+        int best_pad = 0;
+        for (auto&& algo : sm_algo_pack.simt_float32_split_k) {
+            int tb_m = algo.algo_param().threadblock_m;
+            int pad = (C.shape[0] + tb_m - 1) / tb_m * tb_m - C.shape[0];
+            if ((!best || pad < best_pad ||
+                 (pad == best_pad && algo.algo_param().threadblock_n >
+                                             best->algo_param().threadblock_n)) &&
+                algo.is_available_attribute(
+                        args, positive_attr, negative_attr,
+                        workspace_limit_in_bytes)) {
+                best = &algo;
+                best_pad = pad;
+            }
+        }
+        if (best) {
+            return best;
+        }
+    }
+#endif
     if (sm_algo_pack.cublas.is_available_attribute(
                 args, positive_attr, negative_attr, workspace_limit_in_bytes)) {
         return &sm_algo_pack.cublas;
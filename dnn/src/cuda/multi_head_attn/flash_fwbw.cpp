@@ -0,0 +1,225 @@
+#include "src/cuda/multi_head_attn/flash_fwbw.h"
+#include "megdnn/dtype.h"
+#include "src/cuda/handle.h"
+#include "src/cuda/utils.h"
+
+namespace megdnn {
+namespace cuda {
+
+namespace {
+
+flash_attn::KernParam make_kern_param(
+        const Param& param, const TensorLayout& queries, const TensorLayout& keys,
+        const TensorLayout& values) {
+    flash_attn::KernParam kern_param;
+    kern_param.batch = queries[0];
+    kern_param.seq_q = queries[1];
+    kern_param.seq_k = keys[1];
+    kern_param.qk_dim = keys[2];
+    kern_param.v_dim = values[2];
+    kern_param.scaler = param.sm_scaler;
+    kern_param.causal = param.attn_mask_type == MaskType::DEFAULT_MASK;
+    kern_param.drop_prob = param.training ? param.attn_prob : 0.f;
+    kern_param.seed = param.seed;
+    return kern_param;
+}
+
+//! lse and the copy of out, kept in othr_reservespace for backward
+WorkspaceBundle get_reservespace_bundle(
+        const TensorLayout& queries, const TensorLayout& values, void* ptr = nullptr) {
+    size_t rows = queries[0] * queries[1];
+    return {ptr, {rows * sizeof(float), rows * values[2] * queries.dtype.size()}};
+}
+
+//! delta and the float accumulator of dq
+WorkspaceBundle get_backward_bundle(const TensorLayout& queries, void* ptr = nullptr) {
+    size_t rows = queries[0] * queries[1];
+    return {ptr, {rows * sizeof(float), rows * queries[2] * sizeof(float)}};
+}
+
+}  // namespace
+
+bool can_use_mha_flash(
+        const Param& param, const TensorLayout& queries, const TensorLayout& keys,
+        const TensorLayout& values) {
+    auto dtype = queries.dtype.enumv();
+    if ((dtype != DTypeEnum::Float16 && dtype != DTypeEnum::BFloat16) ||
+        keys.dtype.enumv() != dtype || values.dtype.enumv() != dtype) {
+        return false;
+    }
+    if (!is_compute_capability_required(8, 0)) {
+        return false;
+    }
+    if (param.num_heads != 1 || param.qproj_size || param.kproj_size ||
+        param.vproj_size || param.oproj_size) {
+        return false;
+    }
+    if (param.tensor_combination_type != InputType::NONE || param.add_zero_attn ||
+        param.need_weights) {
+        return false;
+    }
+    if (param.attn_mask_type != MaskType::NO_MASK &&
+        param.attn_mask_type != MaskType::DEFAULT_MASK) {
+        return false;
+    }
+    if (param.training && param.out_prob > 0.f) {
+        return false;
+    }
+    return keys.ndim == 3 && values.ndim == 3 &&
+           keys[2] <= static_cast<size_t>(flash_attn::MAX_HEAD_DIM) &&
+           values[2] <= static_cast<size_t>(flash_attn::MAX_HEAD_DIM);
+}
+
+/***************************** MHA forward *****************************/
+void MHAForwardFlashOpr::deduce_layout(MHA_PROXY_FORWARD_LAYOUT_PARAM) {
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    attn_weight = TensorLayout(
+            TensorShape{queries[0] * param.num_heads, queries[1], keys[1]},
+            queries.dtype);
+    out = TensorLayout(TensorShape{queries[0], queries[1], values[2]}, queries.dtype);
+    mask_reservespace = TensorLayout(TensorShape{0}, dtype::Uint8());
+    size_t reserve = get_othr_reservespace_in_bytes(
+            handle, param, queries, keys, values, qkvo_weight_bias, attn_mask, bias_k,
+            bias_v, out, attn_weight, mask_reservespace, othr_reservespace);
+    othr_reservespace = TensorLayout(
+            TensorShape{div_ceil(reserve, queries.dtype.size())}, queries.dtype);
+}
+
+size_t MHAForwardFlashOpr::get_workspace_in_bytes(
+        MHA_PROXY_FORWARD_LAYOUT_CONST_PARAM) {
+    MEGDNN_MARK_USED_VAR(handle);
+    MEGDNN_MARK_USED_VAR(param);
+    MEGDNN_MARK_USED_VAR(queries);
+    MEGDNN_MARK_USED_VAR(keys);
+    MEGDNN_MARK_USED_VAR(values);
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(out);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    return 0;
+}
+
+size_t MHAForwardFlashOpr::get_mask_reservespace_in_bytes(
+        MHA_PROXY_FORWARD_LAYOUT_CONST_PARAM) {
+    MEGDNN_MARK_USED_VAR(handle);
+    MEGDNN_MARK_USED_VAR(param);
+    MEGDNN_MARK_USED_VAR(queries);
+    MEGDNN_MARK_USED_VAR(keys);
+    MEGDNN_MARK_USED_VAR(values);
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(out);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    return 0;
+}
+
+size_t MHAForwardFlashOpr::get_othr_reservespace_in_bytes(
+        MHA_PROXY_FORWARD_LAYOUT_CONST_PARAM) {
+    MEGDNN_MARK_USED_VAR(handle);
+    MEGDNN_MARK_USED_VAR(param);
+    MEGDNN_MARK_USED_VAR(keys);
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(out);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    return get_reservespace_bundle(queries, values).total_size_in_bytes();
+}
+
+void MHAForwardFlashOpr::exec(MHA_PROXY_FORWARD_EXEC_PARAM) {
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(workspace);
+    auto kern_param =
+            make_kern_param(param, queries.layout, keys.layout, values.layout);
+    auto bundle = get_reservespace_bundle(
+            queries.layout, values.layout, othr_reservespace.raw_ptr());
+    auto stream = cuda_stream(handle);
+#define cb(DType)                                                                 \
+    if (queries.layout.dtype.enumv() == DTypeTrait<DType>::enumv) {               \
+        using T = DTypeTrait<DType>::ctype;                                       \
+        flash_attn::forward<T>(                                                   \
+                queries.ptr<T>(), keys.ptr<T>(), values.ptr<T>(), out.ptr<T>(),   \
+                static_cast<T*>(bundle.get(1)), static_cast<float*>(bundle.get(0)), \
+                kern_param, stream);                                              \
+        return;                                                                   \
+    }
+    cb(::megdnn::dtype::Float16) cb(::megdnn::dtype::BFloat16)
+#undef cb
+    megdnn_throw("fused attention only supports float16 and bfloat16");
+}
+
+/***************************** MHA backward *****************************/
+size_t MHABackwardFlashOpr::get_workspace_in_bytes(
+        MHA_PROXY_BACKWARD_LAYOUT_CONST_PARAM) {
+    MEGDNN_MARK_USED_VAR(handle);
+    MEGDNN_MARK_USED_VAR(param);
+    MEGDNN_MARK_USED_VAR(diff);
+    MEGDNN_MARK_USED_VAR(keys);
+    MEGDNN_MARK_USED_VAR(values);
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    MEGDNN_MARK_USED_VAR(dqueries);
+    MEGDNN_MARK_USED_VAR(dkeys);
+    MEGDNN_MARK_USED_VAR(dvalues);
+    MEGDNN_MARK_USED_VAR(dqkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(dbias_k);
+    MEGDNN_MARK_USED_VAR(dbias_v);
+    return get_backward_bundle(queries).total_size_in_bytes();
+}
+
+void MHABackwardFlashOpr::exec(MHA_PROXY_BACKWARD_EXEC_PARAM) {
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(dqkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(dbias_k);
+    MEGDNN_MARK_USED_VAR(dbias_v);
+    auto kern_param =
+            make_kern_param(param, queries.layout, keys.layout, values.layout);
+    auto reserve = get_reservespace_bundle(
+            queries.layout, values.layout, othr_reservespace.raw_ptr());
+    auto bundle = get_backward_bundle(queries.layout, workspace.raw_ptr);
+    auto stream = cuda_stream(handle);
+#define cb(DType)                                                            \
+    if (queries.layout.dtype.enumv() == DTypeTrait<DType>::enumv) {          \
+        using T = DTypeTrait<DType>::ctype;                                  \
+        flash_attn::backward<T>(                                             \
+                queries.ptr<T>(), keys.ptr<T>(), values.ptr<T>(),            \
+                static_cast<T*>(reserve.get(1)), diff.ptr<T>(),              \
+                static_cast<float*>(reserve.get(0)),                         \
+                static_cast<float*>(bundle.get(0)),                          \
+                static_cast<float*>(bundle.get(1)), dqueries.ptr<T>(),       \
+                dkeys.ptr<T>(), dvalues.ptr<T>(), kern_param, stream);       \
+        return;                                                              \
+    }
+    cb(::megdnn::dtype::Float16) cb(::megdnn::dtype::BFloat16)
+#undef cb
+    megdnn_throw("fused attention only supports float16 and bfloat16");
+}
+
+}  // namespace cuda
+}  // namespace megdnn
+   // vim: syntax=cpp.doxygen
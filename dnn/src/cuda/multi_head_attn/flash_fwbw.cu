@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <cfloat>
+#include "megdnn/dtype.h"
+#include "src/cuda/multi_head_attn/flash_fwbw.cuh"
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace flash_attn {
+
+namespace {
+
+//! query rows per block in forward, one thread per row
+constexpr int FWD_BLOCK_M = 64;
+//! keys per block in both passes, one thread per key in backward
+constexpr int BLOCK_N = 32;
+//! query rows per tile in backward
+constexpr int BWD_BLOCK_M = 32;
+
+//! counter based keep/drop decision, forward and backward see the same mask
+__device__ __forceinline__ bool dropout_keep(
+        uint64_t seed, uint64_t idx, float drop_prob) {
+    uint64_t x = seed + idx * 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return static_cast<float>(x >> 40) * (1.f / 16777216.f) >= drop_prob;
+}
+
+template <typename T>
+__device__ __forceinline__ void load_tile(
+        float* dst, int dst_stride, const T* src, int rows, int valid_rows, int dim,
+        int padded_dim) {
+    for (int idx = threadIdx.x; idx < rows * padded_dim; idx += blockDim.x) {
+        int r = idx / padded_dim, c = idx % padded_dim;
+        dst[r * dst_stride + c] = (r < valid_rows && c < dim)
+                                        ? static_cast<float>(src[r * dim + c])
+                                        : 0.f;
+    }
+}
+
+/*!
+ * every thread owns one query row and walks the keys tile by tile with a
+ * running max and sum, so the score matrix only ever lives in registers
+ */
+template <typename T, int D>
+__global__ void flash_fwd_kernel(
+        const T* q, const T* k, const T* v, T* out, T* out_copy, float* lse,
+        KernParam p) {
+    extern __shared__ float smem[];
+    float* s_q = smem;
+    float* s_k = s_q + FWD_BLOCK_M * (D + 1);
+    float* s_v = s_k + BLOCK_N * D;
+
+    int bh = blockIdx.y;
+    int row0 = blockIdx.x * FWD_BLOCK_M;
+    int row = row0 + threadIdx.x;
+    bool valid = row < p.seq_q;
+    q += static_cast<size_t>(bh) * p.seq_q * p.qk_dim;
+    k += static_cast<size_t>(bh) * p.seq_k * p.qk_dim;
+    v += static_cast<size_t>(bh) * p.seq_k * p.v_dim;
+
+    load_tile(
+            s_q, D + 1, q + static_cast<size_t>(row0) * p.qk_dim, FWD_BLOCK_M,
+            p.seq_q - row0, p.qk_dim, D);
+    const float* my_q = s_q + threadIdx.x * (D + 1);
+
+    float acc[D];
+#pragma unroll
+    for (int c = 0; c < D; ++c) {
+        acc[c] = 0.f;
+    }
+    float row_max = -FLT_MAX, row_sum = 0.f;
+    float keep_scale = 1.f / (1.f - p.drop_prob);
+    int k_end = p.causal ? min(p.seq_k, row0 + FWD_BLOCK_M) : p.seq_k;
+
+    for (int kb = 0; kb < k_end; kb += BLOCK_N) {
+        int kn = min(BLOCK_N, p.seq_k - kb);
+        __syncthreads();
+        load_tile(s_k, D, k + static_cast<size_t>(kb) * p.qk_dim, BLOCK_N, kn,
+                  p.qk_dim, D);
+        load_tile(s_v, D, v + static_cast<size_t>(kb) * p.v_dim, BLOCK_N, kn,
+                  p.v_dim, D);
+        __syncthreads();
+        if (!valid) {
+            continue;
+        }
+        float score[BLOCK_N];
+        float blk_max = -FLT_MAX;
+#pragma unroll
+        for (int j = 0; j < BLOCK_N; ++j) {
+            float s = -FLT_MAX;
+            if (j < kn && !(p.causal && kb + j > row)) {
+                s = 0.f;
+#pragma unroll
+                for (int c = 0; c < D; ++c) {
+                    s += my_q[c] * s_k[j * D + c];
+                }
+                s *= p.scaler;
+            }
+            score[j] = s;
+            blk_max = fmaxf(blk_max, s);
+        }
+        if (blk_max == -FLT_MAX) {
+            continue;
+        }
+        float new_max = fmaxf(row_max, blk_max);
+        float alpha = __expf(row_max - new_max);
+        row_sum *= alpha;
+#pragma unroll
+        for (int c = 0; c < D; ++c) {
+            acc[c] *= alpha;
+        }
+#pragma unroll
+        for (int j = 0; j < BLOCK_N; ++j) {
+            if (score[j] == -FLT_MAX) {
+                continue;
+            }
+            float prob = __expf(score[j] - new_max);
+            row_sum += prob;
+            if (p.drop_prob > 0.f) {
+                uint64_t idx = (static_cast<uint64_t>(bh) * p.seq_q + row) * p.seq_k +
+                               kb + j;
+                prob = dropout_keep(p.seed, idx, p.drop_prob) ? prob * keep_scale
+                                                               : 0.f;
+            }
+#pragma unroll
+            for (int c = 0; c < D; ++c) {
+                acc[c] += prob * s_v[j * D + c];
+            }
+        }
+        row_max = new_max;
+    }
+
+    if (valid) {
+        float inv = row_sum > 0.f ? 1.f / row_sum : 0.f;
+        size_t off = (static_cast<size_t>(bh) * p.seq_q + row) * p.v_dim;
+        for (int c = 0; c < p.v_dim; ++c) {
+            T o = static_cast<T>(acc[c] * inv);
+            out[off + c] = o;
+            out_copy[off + c] = o;
+        }
+        lse[static_cast<size_t>(bh) * p.seq_q + row] =
+                row_sum > 0.f ? row_max + __logf(row_sum) : FLT_MAX;
+    }
+}
+
+//! delta = rowsum(dout * out), the softmax backward term shared by a row
+template <typename T>
+__global__ void flash_bwd_delta_kernel(
+        const T* out, const T* dout, float* delta, int rows, int dim) {
+    int row = blockIdx.x * blockDim.x + threadIdx.x;
+    if (row >= rows) {
+        return;
+    }
+    size_t off = static_cast<size_t>(row) * dim;
+    float sum = 0.f;
+    for (int c = 0; c < dim; ++c) {
+        sum += static_cast<float>(out[off + c]) * static_cast<float>(dout[off + c]);
+    }
+    delta[row] = sum;
+}
+
+/*!
+ * every thread owns one key row and accumulates its dk/dv in shared memory
+ * while the query tiles stream by; the probabilities are recomputed from lse
+ * and the partial dq of a tile is reduced in the block before one atomic add
+ */
+template <typename T, int D>
+__global__ void flash_bwd_kernel(
+        const T* q, const T* k, const T* v, const T* dout, const float* lse,
+        const float* delta, float* dq_accum, T* dk, T* dv, KernParam p) {
+    extern __shared__ float smem[];
+    float* s_k = smem;
+    float* s_v = s_k + BLOCK_N * (D + 1);
+    float* s_dk = s_v + BLOCK_N * (D + 1);
+    float* s_dv = s_dk + BLOCK_N * (D + 1);
+    float* s_q = s_dv + BLOCK_N * (D + 1);
+    float* s_do = s_q + BWD_BLOCK_M * D;
+    float* s_lse = s_do + BWD_BLOCK_M * D;
+    float* s_delta = s_lse + BWD_BLOCK_M;
+    float* s_ds = s_delta + BWD_BLOCK_M;
+
+    int bh = blockIdx.y;
+    int col0 = blockIdx.x * BLOCK_N;
+    int col = col0 + threadIdx.x;
+    bool valid = col < p.seq_k;
+    size_t q_base = static_cast<size_t>(bh) * p.seq_q;
+    q += q_base * p.qk_dim;
+    dout += q_base * p.v_dim;
+    lse += q_base;
+    delta += q_base;
+    dq_accum += q_base * p.qk_dim;
+    k += static_cast<size_t>(bh) * p.seq_k * p.qk_dim;
+    v += static_cast<size_t>(bh) * p.seq_k * p.v_dim;
+
+    load_tile(
+            s_k, D + 1, k + static_cast<size_t>(col0) * p.qk_dim, BLOCK_N,
+            p.seq_k - col0, p.qk_dim, D);
+    load_tile(
+            s_v, D + 1, v + static_cast<size_t>(col0) * p.v_dim, BLOCK_N,
+            p.seq_k - col0, p.v_dim, D);
+    float* my_k = s_k + threadIdx.x * (D + 1);
+    float* my_v = s_v + threadIdx.x * (D + 1);
+    float* my_dk = s_dk + threadIdx.x * (D + 1);
+    float* my_dv = s_dv + threadIdx.x * (D + 1);
+#pragma unroll
+    for (int c = 0; c < D; ++c) {
+        my_dk[c] = 0.f;
+        my_dv[c] = 0.f;
+    }
+    float keep_scale = 1.f / (1.f - p.drop_prob);
+    //! with the causal mask rows before the first key of this block see nothing
+    int m_begin = p.causal ? col0 / BWD_BLOCK_M * BWD_BLOCK_M : 0;
+
+    for (int mb = m_begin; mb < p.seq_q; mb += BWD_BLOCK_M) {
+        int mn = min(BWD_BLOCK_M, p.seq_q - mb);
+        __syncthreads();
+        load_tile(s_q, D, q + static_cast<size_t>(mb) * p.qk_dim, BWD_BLOCK_M, mn,
+                  p.qk_dim, D);
+        load_tile(s_do, D, dout + static_cast<size_t>(mb) * p.v_dim, BWD_BLOCK_M,
+                  mn, p.v_dim, D);
+        for (int i = threadIdx.x; i < BWD_BLOCK_M; i += blockDim.x) {
+            s_lse[i] = i < mn ? lse[mb + i] : FLT_MAX;
+            s_delta[i] = i < mn ? delta[mb + i] : 0.f;
+        }
+        __syncthreads();
+
+        for (int i = 0; i < BWD_BLOCK_M; ++i) {
+            int row = mb + i;
+            float ds = 0.f;
+            if (valid && i < mn && !(p.causal && col > row)) {
+                const float* qi = s_q + i * D;
+                const float* doi = s_do + i * D;
+                float s = 0.f, dp = 0.f;
+#pragma unroll
+                for (int c = 0; c < D; ++c) {
+                    s += qi[c] * my_k[c];
+                    dp += doi[c] * my_v[c];
+                }
+                float prob = __expf(s * p.scaler - s_lse[i]);
+                float prob_drop = prob;
+                if (p.drop_prob > 0.f) {
+                    uint64_t idx =
+                            (static_cast<uint64_t>(bh) * p.seq_q + row) * p.seq_k + col;
+                    bool keep = dropout_keep(p.seed, idx, p.drop_prob);
+                    prob_drop = keep ? prob * keep_scale : 0.f;
+                    dp = keep ? dp * keep_scale : 0.f;
+                }
+#pragma unroll
+                for (int c = 0; c < D; ++c) {
+                    my_dv[c] += prob_drop * doi[c];
+                }
+                ds = prob * (dp - s_delta[i]) * p.scaler;
+#pragma unroll
+                for (int c = 0; c < D; ++c) {
+                    my_dk[c] += ds * qi[c];
+                }
+            }
+            s_ds[i * (BLOCK_N + 1) + threadIdx.x] = ds;
+        }
+        __syncthreads();
+
+        for (int idx = threadIdx.x; idx < mn * p.qk_dim; idx += blockDim.x) {
+            int i = idx / p.qk_dim, c = idx % p.qk_dim;
+            float sum = 0.f;
+#pragma unroll
+            for (int j = 0; j < BLOCK_N; ++j) {
+                sum += s_ds[i * (BLOCK_N + 1) + j] * s_k[j * (D + 1) + c];
+            }
+            atomicAdd(dq_accum + static_cast<size_t>(mb + i) * p.qk_dim + c, sum);
+        }
+    }
+
+    if (valid) {
+        size_t k_off = (static_cast<size_t>(bh) * p.seq_k + col) * p.qk_dim;
+        size_t v_off = (static_cast<size_t>(bh) * p.seq_k + col) * p.v_dim;
+        for (int c = 0; c < p.qk_dim; ++c) {
+            dk[k_off + c] = static_cast<T>(my_dk[c]);
+        }
+        for (int c = 0; c < p.v_dim; ++c) {
+            dv[v_off + c] = static_cast<T>(my_dv[c]);
+        }
+    }
+}
+
+template <typename T>
+__global__ void convert_kernel(const float* src, T* dst, size_t size) {
+    size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx < size) {
+        dst[idx] = static_cast<T>(src[idx]);
+    }
+}
+
+constexpr size_t fwd_smem_size(int dim) {
+    return (FWD_BLOCK_M * (dim + 1) + 2 * BLOCK_N * dim) * sizeof(float);
+}
+
+constexpr size_t bwd_smem_size(int dim) {
+    return (4 * BLOCK_N * (dim + 1) + 2 * BWD_BLOCK_M * dim + 2 * BWD_BLOCK_M +
+            BWD_BLOCK_M * (BLOCK_N + 1)) *
+           sizeof(float);
+}
+
+template <typename T, int D>
+void forward_impl(
+        const T* q, const T* k, const T* v, T* out, T* out_copy, float* lse,
+        const KernParam& param, cudaStream_t stream) {
+    constexpr size_t smem = fwd_smem_size(D);
+    cuda_check(cudaFuncSetAttribute(
+            flash_fwd_kernel<T, D>, cudaFuncAttributeMaxDynamicSharedMemorySize,
+            smem));
+    dim3 grid((param.seq_q + FWD_BLOCK_M - 1) / FWD_BLOCK_M, param.batch);
+    flash_fwd_kernel<T, D>
+            <<<grid, FWD_BLOCK_M, smem, stream>>>(q, k, v, out, out_copy, lse, param);
+    after_kernel_launch();
+}
+
+template <typename T, int D>
+void backward_impl(
+        const T* q, const T* k, const T* v, const T* dout, const float* lse,
+        const float* delta, float* dq_accum, T* dk, T* dv, const KernParam& param,
+        cudaStream_t stream) {
+    constexpr size_t smem = bwd_smem_size(D);
+    cuda_check(cudaFuncSetAttribute(
+            flash_bwd_kernel<T, D>, cudaFuncAttributeMaxDynamicSharedMemorySize,
+            smem));
+    dim3 grid((param.seq_k + BLOCK_N - 1) / BLOCK_N, param.batch);
+    flash_bwd_kernel<T, D><<<grid, BLOCK_N, smem, stream>>>(
+            q, k, v, dout, lse, delta, dq_accum, dk, dv, param);
+    after_kernel_launch();
+}
+
+}  // namespace
+
+#define DISPATCH_HEAD_DIM(_dim, _cb)                                     \
+    do {                                                                 \
+        if ((_dim) <= 32) {                                              \
+            _cb(32);                                                     \
+        } else if ((_dim) <= 64) {                                       \
+            _cb(64);                                                     \
+        } else {                                                         \
+            megdnn_assert((_dim) <= MAX_HEAD_DIM, "unsupported head dim"); \
+            _cb(128);                                                    \
+        }                                                                \
+    } while (0)
+
+template <typename T>
+void forward(
+        const T* q, const T* k, const T* v, T* out, T* out_copy, float* lse,
+        const KernParam& param, cudaStream_t stream) {
+#define cb(_d) forward_impl<T, _d>(q, k, v, out, out_copy, lse, param, stream)
+    DISPATCH_HEAD_DIM(std::max(param.qk_dim, param.v_dim), cb);
+#undef cb
+}
+
+template <typename T>
+void backward(
+        const T* q, const T* k, const T* v, const T* out, const T* dout,
+        const float* lse, float* delta, float* dq_accum, T* dq, T* dk, T* dv,
+        const KernParam& param, cudaStream_t stream) {
+    int rows = param.batch * param.seq_q;
+    constexpr int NR_THREADS = 256;
+    flash_bwd_delta_kernel<T><<<(rows + NR_THREADS - 1) / NR_THREADS, NR_THREADS, 0,
+                                stream>>>(out, dout, delta, rows, param.v_dim);
+    after_kernel_launch();
+
+    size_t dq_size = static_cast<size_t>(rows) * param.qk_dim;
+    cuda_check(cudaMemsetAsync(dq_accum, 0, dq_size * sizeof(float), stream));
+#define cb(_d)                                                                    \
+    backward_impl<T, _d>(                                                         \
+            q, k, v, dout, lse, delta, dq_accum, dk, dv, param, stream)
+    DISPATCH_HEAD_DIM(std::max(param.qk_dim, param.v_dim), cb);
+#undef cb
+
+    convert_kernel<T><<<(dq_size + NR_THREADS - 1) / NR_THREADS, NR_THREADS, 0,
+                        stream>>>(dq_accum, dq, dq_size);
+    after_kernel_launch();
+}
+
+#undef DISPATCH_HEAD_DIM
+
+#define INST(T)                                                                  \
+    template void forward<T>(                                                    \
+            const T*, const T*, const T*, T*, T*, float*, const KernParam&,       \
+            cudaStream_t);                                                       \
+    template void backward<T>(                                                   \
+            const T*, const T*, const T*, const T*, const T*, const float*, float*, \
+            float*, T*, T*, T*, const KernParam&, cudaStream_t);
+INST(dt_float16)
+INST(dt_bfloat16)
+#undef INST
+
+}  // namespace flash_attn
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
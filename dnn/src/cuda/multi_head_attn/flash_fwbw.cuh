@@ -0,0 +1,49 @@
+#pragma once
+#include <cuda_runtime_api.h>
+#include <stdint.h>
+
+namespace megdnn {
+namespace cuda {
+namespace flash_attn {
+
+//! largest q/k and v feature size handled by the fused kernels
+constexpr int MAX_HEAD_DIM = 128;
+
+struct KernParam {
+    //! batch * heads, every one is an independent [seq, dim] attention
+    int batch;
+    int seq_q, seq_k;
+    int qk_dim, v_dim;
+    float scaler;
+    //! mask keys after the query position, i.e. the DEFAULT_MASK
+    bool causal;
+    float drop_prob;
+    uint64_t seed;
+};
+
+/*!
+ * \brief out = dropout(softmax(q * k^T * scaler)) * v
+ *
+ * lse receives the per row log-sum-exp and out_copy a second copy of out,
+ * backward recomputes the probabilities from them.
+ */
+template <typename T>
+void forward(
+        const T* q, const T* k, const T* v, T* out, T* out_copy, float* lse,
+        const KernParam& param, cudaStream_t stream);
+
+/*!
+ * \param delta workspace of batch * seq_q floats
+ * \param dq_accum workspace of batch * seq_q * qk_dim floats
+ */
+template <typename T>
+void backward(
+        const T* q, const T* k, const T* v, const T* out, const T* dout,
+        const float* lse, float* delta, float* dq_accum, T* dq, T* dk, T* dv,
+        const KernParam& param, cudaStream_t stream);
+
+}  // namespace flash_attn
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
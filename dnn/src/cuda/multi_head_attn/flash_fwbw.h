@@ -0,0 +1,52 @@
+#pragma once
+#include "megdnn/handle.h"
+#include "megdnn/oprs/nn.h"
+#include "src/common/multi_head_attn/helper.h"
+#include "src/common/utils.h"
+#include "src/cuda/multi_head_attn/flash_fwbw.cuh"
+
+namespace megdnn {
+namespace cuda {
+
+using Param = megdnn::MultiHeadAttn::Param;
+using MaskType = Param::AttnMaskType;
+using InputType = Param::TensorCombinationType;
+
+/*!
+ * \brief whether the fused attention kernels can run the given problem
+ *
+ * They cover the attention core only: one head (heads folded into batch by
+ * the caller), no projection, fp16/bf16 on sm80+, no mask or the causal
+ * DEFAULT_MASK, and dropout on the attention probabilities only.
+ */
+bool can_use_mha_flash(
+        const Param& param, const TensorLayout& queries, const TensorLayout& keys,
+        const TensorLayout& values);
+
+/*!
+ * othr_reservespace keeps the row log-sum-exp and a copy of out, backward
+ * recomputes the attention probabilities from them instead of storing the
+ * [batch, seq_q, seq_k] matrix
+ */
+class MHAForwardFlashOpr {
+public:
+    MHAForwardFlashOpr(){};
+
+    void exec(MHA_PROXY_FORWARD_EXEC_PARAM);
+    void deduce_layout(MHA_PROXY_FORWARD_LAYOUT_PARAM);
+    size_t get_workspace_in_bytes(MHA_PROXY_FORWARD_LAYOUT_CONST_PARAM);
+    size_t get_mask_reservespace_in_bytes(MHA_PROXY_FORWARD_LAYOUT_CONST_PARAM);
+    size_t get_othr_reservespace_in_bytes(MHA_PROXY_FORWARD_LAYOUT_CONST_PARAM);
+};
+
+class MHABackwardFlashOpr {
+public:
+    MHABackwardFlashOpr(){};
+
+    void exec(MHA_PROXY_BACKWARD_EXEC_PARAM);
+    size_t get_workspace_in_bytes(MHA_PROXY_BACKWARD_LAYOUT_CONST_PARAM);
+};
+
+}  // namespace cuda
+}  // namespace megdnn
+   // vim: syntax=cpp.doxygen
@@ -53,6 +53,10 @@ bool can_use_mha_cudnn(const Param& param) {
 
 void MultiHeadAttnForwardImpl::deduce_layout(MHA_FORWARD_LAYOUT_PARAM) {
     Param p = param();
+    if (can_use_mha_flash(p, queries, keys, values)) {
+        flash_opr.deduce_layout(this->handle(), p, MHA_FORWARD_CALL);
+        return;
+    }
 #if CUDNN_VERSION < 8004
     proxy_opr.deduce_layout(this->handle(), p, MHA_FORWARD_CALL);
 #else
@@ -67,6 +71,9 @@ void MultiHeadAttnForwardImpl::deduce_layout(MHA_FORWARD_LAYOUT_PARAM) {
 size_t MultiHeadAttnForwardImpl::get_workspace_in_bytes(
         MHA_FORWARD_LAYOUT_CONST_PARAM) {
     Param p = param();
+    if (can_use_mha_flash(p, queries, keys, values)) {
+        return flash_opr.get_workspace_in_bytes(this->handle(), p, MHA_FORWARD_CALL);
+    }
 #if CUDNN_VERSION < 8004
     return proxy_opr.get_workspace_in_bytes(this->handle(), p, MHA_FORWARD_CALL);
 #else
@@ -81,6 +88,10 @@ size_t MultiHeadAttnForwardImpl::get_workspace_in_bytes(
 size_t MultiHeadAttnForwardImpl::get_mask_reservespace_in_bytes(
         MHA_FORWARD_LAYOUT_CONST_PARAM) {
     Param p = param();
+    if (can_use_mha_flash(p, queries, keys, values)) {
+        return flash_opr.get_mask_reservespace_in_bytes(
+                this->handle(), p, MHA_FORWARD_CALL);
+    }
 #if CUDNN_VERSION < 8004
     return proxy_opr.get_mask_reservespace_in_bytes(
             this->handle(), p, MHA_FORWARD_CALL);
@@ -98,6 +109,10 @@ size_t MultiHeadAttnForwardImpl::get_mask_reservespace_in_bytes(
 size_t MultiHeadAttnForwardImpl::get_othr_reservespace_in_bytes(
         MHA_FORWARD_LAYOUT_CONST_PARAM) {
     Param p = param();
+    if (can_use_mha_flash(p, queries, keys, values)) {
+        return flash_opr.get_othr_reservespace_in_bytes(
+                this->handle(), p, MHA_FORWARD_CALL);
+    }
 #if CUDNN_VERSION < 8004
     return proxy_opr.get_othr_reservespace_in_bytes(
             this->handle(), p, MHA_FORWARD_CALL);
@@ -115,6 +130,10 @@ size_t MultiHeadAttnForwardImpl::get_othr_reservespace_in_bytes(
 void MultiHeadAttnForwardImpl::exec(MHA_FORWARD_EXEC_PARAM) {
     check_exec(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL, workspace.size);
     Param p = param();
+    if (can_use_mha_flash(p, queries.layout, keys.layout, values.layout)) {
+        flash_opr.exec(this->handle(), p, MHA_FORWARD_CALL, workspace);
+        return;
+    }
 #if CUDNN_VERSION < 8004
     proxy_opr.exec(this->handle(), p, MHA_FORWARD_CALL, workspace);
 #else
@@ -129,6 +148,10 @@ void MultiHeadAttnForwardImpl::exec(MHA_FORWARD_EXEC_PARAM) {
 void MultiHeadAttnBackwardImpl::exec(MHA_BACKWARD_EXEC_PARAM) {
     check_exec(MHA_BACKWARD_TENSOR_TO_LAYOUT_CALL, workspace.size);
     Param p = param();
+    if (can_use_mha_flash(p, queries.layout, keys.layout, values.layout)) {
+        flash_opr.exec(this->handle(), p, MHA_BACKWARD_CALL, workspace);
+        return;
+    }
 #if CUDNN_VERSION < 8004
     proxy_opr.exec(this->handle(), p, MHA_BACKWARD_CALL, workspace);
 #else
@@ -143,6 +166,9 @@ void MultiHeadAttnBackwardImpl::exec(MHA_BACKWARD_EXEC_PARAM) {
 size_t MultiHeadAttnBackwardImpl::get_workspace_in_bytes(
         MHA_BACKWARD_LAYOUT_CONST_PARAM) {
     Param p = param();
+    if (can_use_mha_flash(p, queries, keys, values)) {
+        return flash_opr.get_workspace_in_bytes(this->handle(), p, MHA_BACKWARD_CALL);
+    }
     if (can_use_mha_cudnn(p)) {
         return 0;
     } else {
@@ -5,6 +5,7 @@
 #include "src/cuda/cudnn_wrapper.h"
 #include "src/cuda/handle.h"
 #include "src/cuda/multi_head_attn/cudnn_fwbw.h"
+#include "src/cuda/multi_head_attn/flash_fwbw.h"
 #include "src/cuda/multi_head_attn/proxy_bw.h"
 #include "src/cuda/multi_head_attn/proxy_fw.h"
 #include "src/cuda/utils.h"
@@ -24,6 +25,7 @@ public:
 #if CUDNN_VERSION >= 8004
     MHAForwardCudnnOpr cudnn_opr;
 #endif
+    MHAForwardFlashOpr flash_opr;
     MHAForwardProxyOpr proxy_opr;
 
     void exec(MHA_FORWARD_EXEC_PARAM) override;
@@ -39,6 +41,7 @@ public:
 #if CUDNN_VERSION >= 8004
     MHABackwardCudnnOpr cudnn_opr;
 #endif
+    MHABackwardFlashOpr flash_opr;
     MHABackwardProxyOpr proxy_opr;
 
     void exec(MHA_BACKWARD_EXEC_PARAM) override;
@@ -0,0 +1,168 @@
+#include "src/cuda/relayout/kern_vectorized.cuh"
+#include <algorithm>
+#include <limits>
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace cuda {
+namespace relayout_vectorized {
+
+namespace {
+
+//! dims of the matched layouts in elements, from the innermost one
+struct Dims {
+    int ndim = 0;
+    size_t shape[MAX_NDIM];
+    ptrdiff_t src_stride[MAX_NDIM], dst_stride[MAX_NDIM];
+};
+
+/*!
+ * split the dims of src and dst until they have the same shape, e.g.
+ * (6, 4) and (3, 8) are both split into (3, 2, 4)
+ */
+bool match_dims(const TensorLayout& src, const TensorLayout& dst, Dims& dims) {
+    int i = src.ndim - 1, j = dst.ndim - 1;
+    size_t a = src.shape[i], b = dst.shape[j];
+    ptrdiff_t sa = src.stride[i], sb = dst.stride[j];
+    while (i >= 0 && j >= 0) {
+        size_t m;
+        if (a % b == 0) {
+            m = b;
+        } else if (b % a == 0) {
+            m = a;
+        } else {
+            return false;
+        }
+        if (m > 1) {
+            if (dims.ndim == MAX_NDIM) {
+                return false;
+            }
+            dims.shape[dims.ndim] = m;
+            dims.src_stride[dims.ndim] = sa;
+            dims.dst_stride[dims.ndim] = sb;
+            ++dims.ndim;
+        }
+        a /= m;
+        b /= m;
+        sa *= m;
+        sb *= m;
+        if (a == 1 && --i >= 0) {
+            a = src.shape[i];
+            sa = src.stride[i];
+        }
+        if (b == 1 && --j >= 0) {
+            b = dst.shape[j];
+            sb = dst.stride[j];
+        }
+    }
+    return dims.ndim > 0;
+}
+
+//! merge the adjacent dims that are contiguous on both sides
+void collapse_dims(Dims& dims) {
+    int n = 0;
+    for (int i = 1; i < dims.ndim; ++i) {
+        size_t inner = dims.shape[n];
+        if (dims.src_stride[i] == dims.src_stride[n] * static_cast<ptrdiff_t>(inner) &&
+            dims.dst_stride[i] == dims.dst_stride[n] * static_cast<ptrdiff_t>(inner)) {
+            dims.shape[n] *= dims.shape[i];
+        } else {
+            ++n;
+            dims.shape[n] = dims.shape[i];
+            dims.src_stride[n] = dims.src_stride[i];
+            dims.dst_stride[n] = dims.dst_stride[i];
+        }
+    }
+    dims.ndim = n + 1;
+}
+
+}  // namespace
+
+bool make_plan(const TensorND& src, const TensorND& dst, Plan& plan) {
+    Dims dims;
+    if (!match_dims(src.layout, dst.layout, dims)) {
+        return false;
+    }
+    collapse_dims(dims);
+    if (dims.src_stride[0] != 1 || dims.dst_stride[0] != 1) {
+        return false;
+    }
+    for (int i = 0; i < dims.ndim; ++i) {
+        if (dims.src_stride[i] < 0 || dims.dst_stride[i] < 0) {
+            return false;
+        }
+    }
+
+    auto&& dtype = dst.layout.dtype;
+    size_t bits = dtype.is_low_bit() ? dtype.low_bit() : dtype.size() * 8;
+    auto src_addr = reinterpret_cast<uintptr_t>(src.raw_ptr()),
+         dst_addr = reinterpret_cast<uintptr_t>(dst.raw_ptr());
+    size_t vec_bytes = 0;
+    for (size_t v : {16, 8, 4}) {
+        size_t vec_bits = v * 8;
+        if (vec_bits <= bits || src_addr % v || dst_addr % v) {
+            continue;
+        }
+        bool ok = dims.shape[0] * bits % vec_bits == 0;
+        for (int i = 1; i < dims.ndim && ok; ++i) {
+            ok = dims.src_stride[i] * bits % vec_bits == 0 &&
+                 dims.dst_stride[i] * bits % vec_bits == 0;
+        }
+        if (ok) {
+            vec_bytes = v;
+            break;
+        }
+    }
+    if (!vec_bytes) {
+        return false;
+    }
+
+    //! convert to vectors and reverse the dims to be outermost first
+    size_t vec_bits = vec_bytes * 8;
+    size_t total = 1, src_span = 1, dst_span = 1;
+    plan.ndim = dims.ndim;
+    plan.vec_bytes = vec_bytes;
+    for (int i = 0; i < dims.ndim; ++i) {
+        int r = dims.ndim - 1 - i;
+        size_t shape = i ? dims.shape[i] : dims.shape[i] * bits / vec_bits;
+        size_t src_stride = i ? dims.src_stride[i] * bits / vec_bits : 1;
+        size_t dst_stride = i ? dims.dst_stride[i] * bits / vec_bits : 1;
+        total *= shape;
+        src_span += (shape - 1) * src_stride;
+        dst_span += (shape - 1) * dst_stride;
+        plan.shape[r] = shape;
+        plan.src_stride[r] = src_stride;
+        plan.dst_stride[r] = dst_stride;
+    }
+    constexpr size_t MAX_INDEX = std::numeric_limits<uint32_t>::max();
+    if (total > MAX_INDEX || src_span > MAX_INDEX || dst_span > MAX_INDEX) {
+        return false;
+    }
+
+    //! tile the dims next to the contiguous runs if they differ in src and dst,
+    //! a tile row has 32 vectors so the runs should be a power of 2 up to 16
+    int last = plan.ndim - 1;
+    uint32_t run = plan.shape[last];
+    plan.tile_src_dim = plan.tile_dst_dim = -1;
+    if (run <= 16 && !(run & (run - 1))) {
+        for (int i = 0; i < last; ++i) {
+            if (plan.src_stride[i] == run) {
+                plan.tile_src_dim = i;
+            }
+            if (plan.dst_stride[i] == run) {
+                plan.tile_dst_dim = i;
+            }
+        }
+        if (plan.tile_src_dim < 0 || plan.tile_dst_dim < 0 ||
+            plan.tile_src_dim == plan.tile_dst_dim) {
+            plan.tile_src_dim = plan.tile_dst_dim = -1;
+        }
+    }
+    return true;
+}
+
+}  // namespace relayout_vectorized
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,139 @@
+#include "src/cuda/relayout/kern_vectorized.cuh"
+#include <algorithm>
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace relayout_vectorized {
+
+namespace {
+
+constexpr uint32_t NR_THREADS = 256;
+//! a tile row has TILE_WIDTH vectors, loaded by a warp
+constexpr uint32_t TILE_WIDTH = 32;
+constexpr uint32_t TILE_ROWS_PER_ITER = 8;
+
+//! offsets of the \p idx th vector in the row-major order of \p dims
+__device__ __forceinline__ void get_offsets(
+        const Plan& plan, uint32_t idx, int first, int last, uint32_t& src_off,
+        uint32_t& dst_off) {
+    for (int i = last; i >= first; --i) {
+        uint32_t shape = plan.shape[i];
+        uint32_t coord = idx % shape;
+        idx /= shape;
+        src_off += coord * plan.src_stride[i];
+        dst_off += coord * plan.dst_stride[i];
+    }
+}
+
+template <typename V>
+__global__ void copy_kernel(const V* src, V* dst, Plan plan, uint32_t total) {
+    int last = plan.ndim - 1;
+    for (uint32_t idx = threadIdx.x + blockIdx.x * blockDim.x; idx < total;
+         idx += blockDim.x * gridDim.x) {
+        //! the last dim is contiguous on both sides
+        uint32_t run = plan.shape[last];
+        uint32_t src_off = idx % run, dst_off = src_off;
+        get_offsets(plan, idx / run, 0, last - 1, src_off, dst_off);
+        dst[dst_off] = src[src_off];
+    }
+}
+
+/*!
+ * each block transposes a tile of TILE_WIDTH / run elements of the two tiled
+ * dims, where an element is a contiguous run of vectors; the other dims are
+ * enumerated by the blocks as well
+ */
+template <typename V>
+__global__ void tiled_copy_kernel(
+        const V* src, V* dst, Plan plan, uint32_t nr_tiles_a, uint32_t nr_tiles_b) {
+    __shared__ V tile[TILE_WIDTH][TILE_WIDTH + 1];
+    int last = plan.ndim - 1, a = plan.tile_src_dim, b = plan.tile_dst_dim;
+    uint32_t run = plan.shape[last], tile_size = TILE_WIDTH / run;
+    uint32_t tile_idx = blockIdx.x % (nr_tiles_a * nr_tiles_b);
+    uint32_t a0 = tile_idx % nr_tiles_a * tile_size,
+             b0 = tile_idx / nr_tiles_a * tile_size;
+
+    //! offsets of the dims other than the tiled ones and the last one
+    uint32_t src_base = 0, dst_base = 0;
+    uint32_t outer = blockIdx.x / (nr_tiles_a * nr_tiles_b);
+    for (int i = last - 1; i >= 0; --i) {
+        if (i == a || i == b) {
+            continue;
+        }
+        uint32_t coord = outer % plan.shape[i];
+        outer /= plan.shape[i];
+        src_base += coord * plan.src_stride[i];
+        dst_base += coord * plan.dst_stride[i];
+    }
+
+    uint32_t elem = threadIdx.x / run, vec = threadIdx.x % run;
+    //! load rows along b, each row is contiguous in src
+    for (uint32_t row = threadIdx.y; row < tile_size; row += TILE_ROWS_PER_ITER) {
+        uint32_t ia = a0 + elem, ib = b0 + row;
+        if (ia < plan.shape[a] && ib < plan.shape[b]) {
+            tile[row][threadIdx.x] =
+                    src[src_base + ia * plan.src_stride[a] + ib * plan.src_stride[b] +
+                        vec];
+        }
+    }
+    __syncthreads();
+    //! store rows along a, each row is contiguous in dst
+    for (uint32_t row = threadIdx.y; row < tile_size; row += TILE_ROWS_PER_ITER) {
+        uint32_t ia = a0 + row, ib = b0 + elem;
+        if (ia < plan.shape[a] && ib < plan.shape[b]) {
+            dst[dst_base + ia * plan.dst_stride[a] + ib * plan.dst_stride[b] + vec] =
+                    tile[elem][row * run + vec];
+        }
+    }
+}
+
+template <typename V>
+void dispatch(const void* src, void* dst, const Plan& plan, cudaStream_t stream) {
+    auto sptr = static_cast<const V*>(src);
+    auto dptr = static_cast<V*>(dst);
+    if (plan.tile_src_dim >= 0) {
+        uint32_t tile_size = TILE_WIDTH / plan.shape[plan.ndim - 1];
+        uint32_t nr_tiles_a = DIVUP(plan.shape[plan.tile_src_dim], tile_size),
+                 nr_tiles_b = DIVUP(plan.shape[plan.tile_dst_dim], tile_size);
+        uint32_t nr_blocks = nr_tiles_a * nr_tiles_b;
+        for (int i = 0; i < plan.ndim - 1; ++i) {
+            if (i != plan.tile_src_dim && i != plan.tile_dst_dim) {
+                nr_blocks *= plan.shape[i];
+            }
+        }
+        dim3 threads(TILE_WIDTH, TILE_ROWS_PER_ITER);
+        tiled_copy_kernel<V><<<nr_blocks, threads, 0, stream>>>(
+                sptr, dptr, plan, nr_tiles_a, nr_tiles_b);
+    } else {
+        uint32_t total = 1;
+        for (int i = 0; i < plan.ndim; ++i) {
+            total *= plan.shape[i];
+        }
+        uint32_t nr_blocks = std::min<uint32_t>(DIVUP(total, NR_THREADS), 65535);
+        copy_kernel<V><<<nr_blocks, NR_THREADS, 0, stream>>>(sptr, dptr, plan, total);
+    }
+    after_kernel_launch();
+}
+
+}  // anonymous namespace
+
+void copy(
+        const TensorND& dst, const TensorND& src, const Plan& plan,
+        cudaStream_t stream) {
+    switch (plan.vec_bytes) {
+        case 16:
+            return dispatch<int4>(src.raw_ptr(), dst.raw_ptr(), plan, stream);
+        case 8:
+            return dispatch<int2>(src.raw_ptr(), dst.raw_ptr(), plan, stream);
+        case 4:
+            return dispatch<int>(src.raw_ptr(), dst.raw_ptr(), plan, stream);
+    }
+    megdnn_assert(0, "bad vector size");
+}
+
+}  // namespace relayout_vectorized
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: ft=cpp syntax=cuda.doxygen
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cuda_runtime_api.h>
+#include <stdint.h>
+#include "megdnn/basic_types.h"
+
+namespace megdnn {
+namespace cuda {
+namespace relayout_vectorized {
+
+//! max number of dims after matching the shapes of src and dst
+constexpr int MAX_NDIM = 8;
+
+/*!
+ * \brief relayout of vectors of \p vec_bytes bytes, where src and dst are split
+ *      into the same shape and the last dim is contiguous on both sides
+ *
+ * If the dim next to the last one in src (\p tile_src_dim) differs from that in
+ * dst (\p tile_dst_dim), tiles of the two dims are transposed through shared
+ * memory, so that both the loads and the stores are coalesced.
+ */
+struct Plan {
+    int ndim;
+    uint32_t vec_bytes;
+    uint32_t shape[MAX_NDIM];
+    //! strides in number of vectors
+    uint32_t src_stride[MAX_NDIM], dst_stride[MAX_NDIM];
+    //! -1 if the copy is not tiled
+    int tile_src_dim, tile_dst_dim;
+};
+
+/*!
+ * \brief collapse and match the dims of src and dst and choose the widest
+ *      vector of 16, 8 or 4 bytes that divides the contiguous runs, the strides
+ *      and the pointers
+ *
+ * Sub-byte dtypes are supported as long as the vectors are byte aligned.
+ *
+ * \return false if there is no vector wider than the element
+ */
+bool make_plan(const TensorND& src, const TensorND& dst, Plan& plan);
+
+void copy(
+        const TensorND& dst, const TensorND& src, const Plan& plan,
+        cudaStream_t stream);
+
+}  // namespace relayout_vectorized
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
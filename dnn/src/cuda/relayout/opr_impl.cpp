@@ -1,6 +1,7 @@
 #include "src/cuda/relayout/kern.cuh"
 #include "src/cuda/relayout/kern_contiguous.cuh"
 #include "src/cuda/relayout/kern_transpose.cuh"
+#include "src/cuda/relayout/kern_vectorized.cuh"
 
 #include "src/common/relayout_helper.h"
 #include "src/common/utils.h"
@@ -172,6 +173,14 @@ bool RelayoutForwardImpl::Param::try_copy_last_contig() {
     return false;
 }
 
+bool RelayoutForwardImpl::Param::try_copy_vectorized() {
+    relayout_vectorized::Plan plan;
+    if (!relayout_vectorized::make_plan(m_src, m_dst, plan))
+        return false;
+    relayout_vectorized::copy(m_dst, m_src, plan, m_opr->stream());
+    return true;
+}
+
 void RelayoutForwardImpl::Param::copy_general() {
     copy_noncontig_general(m_dst, m_src, m_opr->stream());
 }
@@ -200,7 +209,9 @@ void RelayoutForwardImpl::exec(
     }
     Param param{src, dst, this};
     if (!param.try_transpose() && !param.try_copy_contig() &&
-        !param.try_copy_2d(cross_dev) && !param.try_copy_last_contig()) {
+        !param.try_copy_2d(cross_dev) &&
+        (cross_dev || !param.try_copy_vectorized()) &&
+        !param.try_copy_last_contig()) {
         megdnn_assert(!cross_dev, "cross-device general non-contig copy unsupported");
         param.copy_general();
     }
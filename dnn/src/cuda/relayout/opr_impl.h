@@ -25,6 +25,9 @@ class RelayoutForwardImpl final : public RelayoutForward {
         //! try to copy by cudaMemcpy2DAsync
         bool try_copy_2d(bool cross_dev);
 
+        //! try to copy by vectors of up to 16 bytes, including sub-byte dtypes
+        bool try_copy_vectorized();
+
         void copy_general();
 
         //! try to copy if last contiguous
@@ -300,6 +300,13 @@ void multinomial(
         size_t len_probs, uint64_t seed, uint64_t offset, int max_grid_size_y,
         cudaStream_t stream);
 
+//! sample one token from each row of logits, see megdnn::LogitsSamplingRNG
+template <typename T>
+void logits_sampling(
+        const T* logits, dt_int32* dst, size_t num_groups, size_t len_logits,
+        uint32_t top_k, float top_p, float temperature, uint64_t seed,
+        uint64_t offset, cudaStream_t stream);
+
 template <typename T>
 void shuffle_forward(
         T* sptr, T* dptr, dt_int32* iptr, size_t len, size_t step, cudaStream_t stream);
@@ -0,0 +1,218 @@
+#include <curand_kernel.h>
+#include "./kernel.cuh"
+#include "src/cuda/cub/block/block_reduce.cuh"
+#include "src/cuda/cub/block/block_scan.cuh"
+#include "src/cuda/utils.cuh"
+
+namespace megdnn {
+namespace cuda {
+namespace random {
+
+namespace {
+
+constexpr int NR_THREADS = 512;
+constexpr int RADIX_BITS = 8;
+constexpr int RADIX_SIZE = 1 << RADIX_BITS;
+
+//! map a float to an unsigned key of the same order
+__device__ __forceinline__ uint32_t float_to_key(float x) {
+    uint32_t bits = __float_as_uint(x);
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+template <typename T>
+struct Row {
+    const T* ptr;
+    uint32_t len;
+    float inv_temp;
+
+    //! -0 is mapped to +0 so that equal logits have equal keys
+    __device__ __forceinline__ float operator[](uint32_t i) const {
+        return static_cast<float>(ptr[i]) * inv_temp + 0.f;
+    }
+};
+
+struct SharedStorage {
+    union {
+        cub::BlockReduce<float, NR_THREADS>::TempStorage reduce;
+        cub::BlockScan<float, NR_THREADS>::TempStorage scan;
+    } cub;
+    float hist[RADIX_SIZE];
+    float value;
+    uint32_t key, index;
+};
+
+/*!
+ * \brief the smallest key k such that the elements with keys larger than k weigh
+ *      less than target in total, where only the elements with keys no less than
+ *      min_key are counted
+ *
+ * The key is found by RADIX_BITS bits in each pass, weighted histograms of the
+ * candidate keys are accumulated in shared memory.
+ */
+template <typename T, bool count>
+__device__ uint32_t radix_select(
+        const Row<T>& row, float max_x, float target, uint32_t min_key,
+        SharedStorage& storage) {
+    uint32_t prefix = 0, prefix_mask = 0;
+    float above = 0;
+    for (int shift = 32 - RADIX_BITS; shift >= 0; shift -= RADIX_BITS) {
+        for (int i = threadIdx.x; i < RADIX_SIZE; i += NR_THREADS) {
+            storage.hist[i] = 0;
+        }
+        __syncthreads();
+        for (uint32_t i = threadIdx.x; i < row.len; i += NR_THREADS) {
+            float x = row[i];
+            uint32_t key = float_to_key(x);
+            if (key >= min_key && (key & prefix_mask) == prefix) {
+                atomicAdd(
+                        &storage.hist[(key >> shift) & (RADIX_SIZE - 1)],
+                        count ? 1.f : __expf(x - max_x));
+            }
+        }
+        __syncthreads();
+        if (threadIdx.x == 0) {
+            //! the lowest digit whose larger digits weigh less than target
+            float acc = above, digit_above = above;
+            uint32_t digit = 0;
+            for (int d = RADIX_SIZE - 1; d >= 0 && acc < target; --d) {
+                if (storage.hist[d] > 0) {
+                    digit = d;
+                    digit_above = acc;
+                }
+                acc += storage.hist[d];
+            }
+            storage.key = prefix | (digit << shift);
+            storage.value = digit_above;
+        }
+        __syncthreads();
+        prefix = storage.key;
+        above = storage.value;
+        prefix_mask |= (RADIX_SIZE - 1u) << shift;
+        __syncthreads();
+    }
+    return prefix;
+}
+
+//! sum of exp(x - max_x) of the elements with keys no less than min_key
+template <typename T>
+__device__ float sum_exp(
+        const Row<T>& row, float max_x, uint32_t min_key, SharedStorage& storage) {
+    float sum = 0;
+    for (uint32_t i = threadIdx.x; i < row.len; i += NR_THREADS) {
+        float x = row[i];
+        if (float_to_key(x) >= min_key) {
+            sum += __expf(x - max_x);
+        }
+    }
+    sum = cub::BlockReduce<float, NR_THREADS>(storage.cub.reduce).Sum(sum);
+    if (threadIdx.x == 0) {
+        storage.value = sum;
+    }
+    __syncthreads();
+    sum = storage.value;
+    __syncthreads();
+    return sum;
+}
+
+/*!
+ * each block samples one row: the top_k and top_p thresholds are found by radix
+ * select, then the kept probabilities are scanned in chunks until the prefix sum
+ * passes the uniform sample
+ */
+template <typename T>
+__global__ void logits_sampling_kernel(
+        const T* logits, dt_int32* dst, uint32_t len_logits, uint32_t top_k,
+        float top_p, float inv_temp, uint64_t seed, uint64_t offset) {
+    __shared__ SharedStorage storage;
+    Row<T> row{logits + blockIdx.x * static_cast<size_t>(len_logits), len_logits,
+               inv_temp};
+
+    float max_x = -INFINITY;
+    for (uint32_t i = threadIdx.x; i < row.len; i += NR_THREADS) {
+        max_x = fmaxf(max_x, row[i]);
+    }
+    max_x = cub::BlockReduce<float, NR_THREADS>(storage.cub.reduce)
+                    .Reduce(max_x, cub::Max());
+    if (threadIdx.x == 0) {
+        storage.value = max_x;
+    }
+    __syncthreads();
+    max_x = storage.value;
+    __syncthreads();
+
+    uint32_t min_key = 0;
+    if (top_k && top_k < row.len) {
+        min_key = radix_select<T, true>(row, max_x, top_k, 0, storage);
+    }
+    float sum = sum_exp(row, max_x, min_key, storage);
+    if (top_p < 1) {
+        min_key = radix_select<T, false>(row, max_x, top_p * sum, min_key, storage);
+        sum = sum_exp(row, max_x, min_key, storage);
+    }
+
+    Philox state;
+    curand_init(seed, blockIdx.x, offset, &state);
+    float target = _curand_uniform(&state) * sum, running = 0;
+    if (threadIdx.x == 0) {
+        storage.index = row.len;
+        storage.key = 0;
+    }
+    __syncthreads();
+    for (uint32_t base = 0; base < row.len; base += NR_THREADS) {
+        uint32_t i = base + threadIdx.x;
+        float w = 0;
+        if (i < row.len) {
+            float x = row[i];
+            if (float_to_key(x) >= min_key) {
+                w = __expf(x - max_x);
+            }
+        }
+        float prefix, chunk_sum;
+        cub::BlockScan<float, NR_THREADS>(storage.cub.scan)
+                .ExclusiveSum(w, prefix, chunk_sum);
+        if (w > 0) {
+            //! the last kept element is the fallback for rounding errors
+            atomicMax(&storage.key, i);
+            if (running + prefix + w > target) {
+                atomicMin(&storage.index, i);
+            }
+        }
+        running += chunk_sum;
+        __syncthreads();
+        if (storage.index < row.len) {
+            break;
+        }
+    }
+    if (threadIdx.x == 0) {
+        dst[blockIdx.x] = storage.index < row.len ? storage.index : storage.key;
+    }
+}
+
+}  // anonymous namespace
+
+template <typename T>
+void logits_sampling(
+        const T* logits, dt_int32* dst, size_t num_groups, size_t len_logits,
+        uint32_t top_k, float top_p, float temperature, uint64_t seed,
+        uint64_t offset, cudaStream_t stream) {
+    logits_sampling_kernel<T><<<num_groups, NR_THREADS, 0, stream>>>(
+            logits, dst, len_logits, top_k, top_p, 1.f / temperature, seed, offset);
+    after_kernel_launch();
+}
+
+#define INST(T)                                                                    \
+    template void logits_sampling<T>(                                              \
+            const T*, dt_int32*, size_t, size_t, uint32_t, float, float, uint64_t, \
+            uint64_t, cudaStream_t);
+
+INST(dt_float32)
+INST(dt_float16)
+INST(dt_bfloat16)
+#undef INST
+
+}  // namespace random
+}  // namespace cuda
+}  // namespace megdnn
+
+// vim: ft=cpp syntax=cuda.doxygen
@@ -229,6 +229,37 @@ void MultinomialRNGImpl::exec(
     }
 }
 
+LogitsSamplingRNGImpl::LogitsSamplingRNGImpl(Handle* handle)
+        : LogitsSamplingRNG(handle),
+          m_seed(0),
+          m_offset(0),
+          m_stream(cuda_stream(handle)) {}
+
+void LogitsSamplingRNGImpl::exec(
+        _megdnn_tensor_in logits, _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(logits.layout, dst.layout, workspace.size);
+    size_t num_groups = logits.layout.shape[0];
+    size_t len_logits = logits.layout.shape[1];
+    ensure_seed(m_param.seed);
+    switch (logits.layout.dtype.enumv()) {
+#define cb(_dt)                                                                   \
+    case DTypeTrait<_dt>::enumv: {                                                \
+        using ctype = DTypeTrait<_dt>::ctype;                                     \
+        random::logits_sampling<ctype>(                                           \
+                logits.ptr<ctype>(), dst.ptr<dt_int32>(), num_groups, len_logits, \
+                m_param.top_k, m_param.top_p, m_param.temperature, m_seed,        \
+                m_offset, m_stream);                                              \
+        break;                                                                    \
+    }
+        MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+        default:
+            megdnn_throw("bad dtype");
+    }
+    //! each row draws one uniform sample from its own philox subsequence
+    m_offset += 4;
+}
+
 size_t MultinomialRNGImpl::get_workspace_in_bytes(
         const TensorLayout& src, const TensorLayout& dst) {
     return get_workspace_bundle(nullptr, src, dst).total_size_in_bytes();
@@ -147,6 +147,29 @@ public:
     }
 };
 
+class LogitsSamplingRNGImpl : public LogitsSamplingRNG {
+    uint64_t m_seed, m_offset;
+    cudaStream_t m_stream;
+
+public:
+    LogitsSamplingRNGImpl(Handle* handle);
+
+    void exec(_megdnn_tensor_in logits, _megdnn_tensor_out dst, _megdnn_workspace)
+            override;
+
+    size_t get_workspace_in_bytes(const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+
+    void seed(uint64_t seed) { m_seed = seed; }
+
+    void ensure_seed(uint64_t seed) {
+        if (m_seed != seed) {
+            this->seed(seed);
+        }
+    }
+};
+
 class PermutationRNGImpl : public PermutationRNG {
     uint64_t m_seed, m_offset;
     cudaStream_t m_stream;
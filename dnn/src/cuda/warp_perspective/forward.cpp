@@ -454,6 +454,23 @@ void WarpPerspectiveForwardImpl::exec(
                             dst.compatible_ptr<dt_int8>(), src.layout[0], mat.layout[0],
                             C, IH, IW, OH, OW, bval, src_dtype_param, bmode,
                             async_error_info(handle()), m_error_tracker, stream);
+#if !MEGDNN_DISABLE_FLOAT16
+                } else if (
+                        dst.layout.dtype.enumv() == DTypeEnum::Float16 &&
+                        ((param().format == Param::Format::NCHW) ||
+                         (param().format == Param::Format::NHWC_NCHW))) {
+                    // convert the crops to the fp16 input of the network in the
+                    // same pass, with half of the store traffic of float32
+                    bool is_nhwc = (param().format == Param::Format::NHWC_NCHW);
+                    warp_perspective::forward_proxy_quint8_dimshuffle_typecvt_nchw<
+                            dt_quint8, dt_uint8, dt_float16>(
+                            is_nhwc, src.compatible_ptr<dt_uint8>(),
+                            mat.ptr<dt_float32>(),
+                            mat_idx.raw_ptr() ? mat_idx.ptr<int>() : nullptr,
+                            dst.ptr<dt_float16>(), src.layout[0], mat.layout[0], C,
+                            IH, IW, OH, OW, bval, src_dtype_param, bmode,
+                            async_error_info(handle()), m_error_tracker, stream);
+#endif
                 } else {
                     megdnn_assert(
                             ((dst.layout.dtype.enumv() == DTypeEnum::Float32) &&
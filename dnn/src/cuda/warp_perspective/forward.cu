@@ -1146,6 +1146,17 @@ struct CudaTypeCvt<dt_quint8, float> {
     }
 };
 
+#if !MEGDNN_DISABLE_FLOAT16
+template <>
+struct CudaTypeCvt<dt_quint8, dt_float16> {
+    CudaDTypeParamImpl<dt_quint8> m_src_param;
+    CudaTypeCvt(CudaDTypeParamImpl<dt_quint8> src_param) { m_src_param = src_param; };
+    __device__ __forceinline__ dt_float16 operator()(uint8_t val) {
+        return static_cast<dt_float16>(m_src_param.dequantize(dt_quint8(val)));
+    }
+};
+#endif
+
 #define INST(dst_ctype, vec_dst_type)                                               \
     template <                                                                      \
             typename src_dtype, typename src_ctype, typename Getter,                \
@@ -1581,6 +1592,9 @@ void dispatch_with_visitor_quint8_dimshuffle_typecvt_nchw4(
     }
 
 INST(float)
+#if !MEGDNN_DISABLE_FLOAT16
+INST(dt_float16)
+#endif
 #undef INST
 
 #define INST(dst_ctype)                                                             \
@@ -1629,6 +1643,9 @@ INST(float)
     }
 
 INST(float)
+#if !MEGDNN_DISABLE_FLOAT16
+INST(dt_float16)
+#endif
 #undef INST
 
 #define INST(dst_ctype)                                                             \
@@ -1673,6 +1690,9 @@ INST(float)
     }
 
 INST(float)
+#if !MEGDNN_DISABLE_FLOAT16
+INST(dt_float16)
+#endif
 #undef INST
 
 #define INST(dst_ctype)                                                             \
@@ -1724,6 +1744,9 @@ INST(float)
     }
 
 INST(float)
+#if !MEGDNN_DISABLE_FLOAT16
+INST(dt_float16)
+#endif
 #undef INST
 
 template <
@@ -2042,6 +2065,9 @@ void forward_proxy_quint8_dimshuffle_typecvt_nchw(
             BorderMode, megcore::AsyncErrorInfo*, void*, cudaStream_t);
 
 INST(dt_quint8, uint8_t, float)
+#if !MEGDNN_DISABLE_FLOAT16
+INST(dt_quint8, uint8_t, dt_float16)
+#endif
 #undef INST
 
 }  // namespace warp_perspective
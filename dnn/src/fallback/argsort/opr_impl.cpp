@@ -0,0 +1,172 @@
+#include "src/fallback/argsort/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+using namespace megdnn;
+using namespace fallback;
+
+namespace {
+
+//! rows shorter than it are sorted by comparison
+constexpr size_t RADIX_SORT_MIN_LEN = 256;
+//! workspace of a thread for each element of a row
+constexpr size_t WORKSPACE_PER_ELEM = 4 * sizeof(uint32_t);
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+//! unsigned keys in the same order as the values
+uint32_t to_key(dt_float32 val) {
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    // -0 equals to +0
+    if (bits == 0x80000000u) {
+        bits = 0;
+    }
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+uint32_t to_key(dt_int32 val) {
+    return static_cast<uint32_t>(val) ^ 0x80000000u;
+}
+
+/*!
+ * \brief stable LSD radix sort of a row by 8-bit digits
+ *
+ * \param buf 4 * n uint32, for the keys and the indices in two buffers
+ */
+template <typename ctype>
+void radix_sort_row(
+        const ctype* src, size_t n, bool ascending, ctype* dst, dt_int32* idx,
+        uint32_t* buf) {
+    uint32_t *key = buf, *key_tmp = buf + n, *id = buf + n * 2, *id_tmp = buf + n * 3;
+    for (size_t j = 0; j < n; ++j) {
+        key[j] = to_key(src[j]);
+        id[j] = j;
+    }
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t cnt[256] = {0};
+        for (size_t j = 0; j < n; ++j) {
+            ++cnt[(key[j] >> shift) & 255];
+        }
+        // the pass keeps the order if all keys share the digit
+        if (cnt[(key[0] >> shift) & 255] == n) {
+            continue;
+        }
+        size_t sum = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            size_t c = cnt[b];
+            cnt[b] = sum;
+            sum += c;
+        }
+        for (size_t j = 0; j < n; ++j) {
+            size_t pos = cnt[(key[j] >> shift) & 255]++;
+            key_tmp[pos] = key[j];
+            id_tmp[pos] = id[j];
+        }
+        std::swap(key, key_tmp);
+        std::swap(id, id_tmp);
+    }
+    // ties are in ascending order of index after the stable sort, and the
+    // reversed order is the same as descending order of (value, index) pairs
+    // in naive
+    for (size_t j = 0; j < n; ++j) {
+        uint32_t i = id[ascending ? j : n - 1 - j];
+        dst[j] = src[i];
+        idx[j] = i;
+    }
+}
+
+template <typename ctype>
+void compare_sort_row(
+        const ctype* src, size_t n, bool ascending, ctype* dst, dt_int32* idx,
+        void* buf) {
+    using KV = std::pair<ctype, int>;
+    auto row = static_cast<KV*>(buf);
+    for (size_t j = 0; j < n; ++j) {
+        row[j] = {src[j], static_cast<int>(j)};
+    }
+    if (ascending) {
+        std::sort(row, row + n);
+    } else {
+        std::sort(row, row + n, std::greater<KV>{});
+    }
+    for (size_t j = 0; j < n; ++j) {
+        dst[j] = row[j].first;
+        idx[j] = row[j].second;
+    }
+}
+
+template <typename ctype>
+struct RadixSortable : std::false_type {};
+template <>
+struct RadixSortable<dt_float32> : std::true_type {};
+template <>
+struct RadixSortable<dt_int32> : std::true_type {};
+
+template <typename ctype>
+void sort_row(
+        const ctype* src, size_t n, bool ascending, ctype* dst, dt_int32* idx,
+        void* buf, std::true_type) {
+    if (n >= RADIX_SORT_MIN_LEN) {
+        radix_sort_row(src, n, ascending, dst, idx, static_cast<uint32_t*>(buf));
+    } else {
+        compare_sort_row(src, n, ascending, dst, idx, buf);
+    }
+}
+
+template <typename ctype>
+void sort_row(
+        const ctype* src, size_t n, bool ascending, ctype* dst, dt_int32* idx,
+        void* buf, std::false_type) {
+    compare_sort_row(src, n, ascending, dst, idx, buf);
+}
+
+}  // anonymous namespace
+
+void ArgsortForwardImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_tensor_out indices,
+        _megdnn_workspace workspace) {
+    check_exec(src.layout, dst.layout, indices.layout, workspace.size);
+    size_t M = src.layout.shape[0], N = src.layout.shape[1];
+    bool ascending = param().order == Order::ASCENDING;
+    auto wk = workspace.ptr<dt_byte>();
+    switch (src.layout.dtype.enumv()) {
+#define cb(dt)                                                                     \
+    case DTypeTrait<dt>::enumv: {                                                  \
+        using ctype = DTypeTrait<dt>::ctype;                                       \
+        static_assert(                                                             \
+                sizeof(std::pair<ctype, int>) <= WORKSPACE_PER_ELEM,               \
+                "workspace is too small");                                         \
+        auto sptr = src.ptr<ctype>();                                              \
+        auto dptr = dst.ptr<ctype>();                                              \
+        auto iptr = indices.ptr<dt_int32>();                                       \
+        auto run = [=](size_t m, size_t thread_id) {                               \
+            sort_row(                                                              \
+                    sptr + m * N, N, ascending, dptr + m * N, iptr + m * N,        \
+                    wk + thread_id * N * WORKSPACE_PER_ELEM,                       \
+                    RadixSortable<ctype>{});                                       \
+        };                                                                         \
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, M);                         \
+        return;                                                                    \
+    }
+        MEGDNN_FOREACH_COMPUTING_DTYPE(cb)
+#undef cb
+        default:
+            megdnn_throw("bad dtype");
+    }
+}
+
+size_t ArgsortForwardImpl::get_workspace_in_bytes(
+        const TensorLayout& src, const TensorLayout&, const TensorLayout&) {
+    return get_nr_threads(handle()) * src.shape[1] * WORKSPACE_PER_ELEM;
+}
+
+// vim: syntax=cpp.doxygen
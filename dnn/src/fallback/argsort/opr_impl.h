@@ -0,0 +1,28 @@
+#pragma once
+
+#include "src/naive/argsort/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief Argsort on rows in parallel
+ *
+ * Long rows of float32 and int32 are sorted by a stable LSD radix sort on
+ * their order preserving unsigned keys, and others by comparison.
+ */
+class ArgsortForwardImpl : public naive::ArgsortForwardImpl {
+public:
+    using naive::ArgsortForwardImpl::ArgsortForwardImpl;
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_tensor_out indices,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& dst,
+            const TensorLayout& indices) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
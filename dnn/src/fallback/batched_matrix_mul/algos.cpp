@@ -1,11 +1,14 @@
 #include "src/fallback/batched_matrix_mul/algos.h"
 #include "src/common/algo_base.h"
+#include "src/fallback/general_intrinsic/gi_float.h"
 #include "src/naive/handle.h"
 
 using namespace megdnn;
 using namespace fallback;
 
 BatchedMatrixMulForwardImpl::AlgoPack::AlgoPack() {
+    all_algos.push_back(&algo_f32_small);
+    all_algos.push_back(&algo_int8x8x32);
     all_algos.push_back(&algo_default);
 
     for (auto&& algo : all_algos) {
@@ -93,4 +96,283 @@ void BatchedMatrixMulForwardImpl::AlgoDefault::exec(const ExecArgs& args) const
     static_cast<naive::HandleImpl*>(args.opr->handle())->dispatch_kern(kern);
 }
 
+/* ===================== small f32 algo ===================== */
+namespace {
+
+constexpr size_t SMALL_MAX_MN = 64;
+constexpr size_t SMALL_MAX_K = 256;
+//! rows of C computed by one task
+constexpr size_t SMALL_TILE_M = 16;
+constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+
+template <bool trans_a>
+GI_FORCEINLINE const float* get_a_ptr(const float* A, size_t lda, size_t i) {
+    return trans_a ? A + i : A + i * lda;
+}
+
+template <bool trans_a>
+GI_FORCEINLINE float get_a(const float* A, size_t lda, size_t i, size_t kk) {
+    return trans_a ? A[kk * lda + i] : A[i * lda + kk];
+}
+
+//! \p mr rows and \p nr_vec vectors of columns of C
+template <size_t mr, size_t nr_vec, bool trans_a>
+void kern_block(
+        const float* A, size_t lda, const float* B, size_t ldb, float* C, size_t ldc,
+        size_t k) {
+    GI_FLOAT32_FIXLEN_t acc[mr][nr_vec];
+    for (size_t r = 0; r < mr; ++r) {
+        for (size_t v = 0; v < nr_vec; ++v) {
+            acc[r][v] = GiFloat32Type2FixLenType(GiBroadcastFloat32(0.f));
+        }
+    }
+    for (size_t kk = 0; kk < k; ++kk) {
+        const float* b = B + kk * ldb;
+        for (size_t r = 0; r < mr; ++r) {
+            GI_FLOAT32_t a = GiBroadcastFloat32(get_a<trans_a>(A, lda, r, kk));
+            for (size_t v = 0; v < nr_vec; ++v) {
+                acc[r][v] = GiFloat32Type2FixLenType(GiMlaqFloat32(
+                        GiFixLenType2GiFloat32Type(acc[r][v]),
+                        GiLoadFloat32(b + v * SIMD_STEP), a));
+            }
+        }
+    }
+    for (size_t r = 0; r < mr; ++r) {
+        for (size_t v = 0; v < nr_vec; ++v) {
+            GiStoreFloat32(
+                    C + r * ldc + v * SIMD_STEP, GiFixLenType2GiFloat32Type(acc[r][v]));
+        }
+    }
+}
+
+template <size_t mr, bool trans_a>
+void kern_rows(
+        const float* A, size_t lda, const float* B, size_t ldb, float* C, size_t ldc,
+        size_t n, size_t k) {
+    size_t j = 0;
+    for (; j + 2 * SIMD_STEP <= n; j += 2 * SIMD_STEP) {
+        kern_block<mr, 2, trans_a>(A, lda, B + j, ldb, C + j, ldc, k);
+    }
+    for (; j + SIMD_STEP <= n; j += SIMD_STEP) {
+        kern_block<mr, 1, trans_a>(A, lda, B + j, ldb, C + j, ldc, k);
+    }
+    for (; j < n; ++j) {
+        for (size_t r = 0; r < mr; ++r) {
+            float sum = 0.f;
+            for (size_t kk = 0; kk < k; ++kk) {
+                sum += get_a<trans_a>(A, lda, r, kk) * B[kk * ldb + j];
+            }
+            C[r * ldc + j] = sum;
+        }
+    }
+}
+
+//! C(m, n) = A(m, k) * B(k, n), with B row major
+template <bool trans_a>
+void kern_tile(
+        const float* A, size_t lda, const float* B, size_t ldb, float* C, size_t ldc,
+        size_t m, size_t n, size_t k) {
+    size_t i = 0;
+    for (; i + 4 <= m; i += 4) {
+        kern_rows<4, trans_a>(
+                get_a_ptr<trans_a>(A, lda, i), lda, B, ldb, C + i * ldc, ldc, n, k);
+    }
+    const float* a = get_a_ptr<trans_a>(A, lda, i);
+    switch (m - i) {
+        case 3:
+            kern_rows<3, trans_a>(a, lda, B, ldb, C + i * ldc, ldc, n, k);
+            break;
+        case 2:
+            kern_rows<2, trans_a>(a, lda, B, ldb, C + i * ldc, ldc, n, k);
+            break;
+        case 1:
+            kern_rows<1, trans_a>(a, lda, B, ldb, C + i * ldc, ldc, n, k);
+            break;
+        default:
+            break;
+    }
+}
+
+}  // namespace
+
+bool BatchedMatrixMulForwardImpl::AlgoF32Small::is_available(
+        const SizeArgs& args) const {
+    auto&& param = args.opr->param();
+    auto&& A = args.layout_a;
+    auto&& B = args.layout_b;
+    auto&& C = args.layout_c;
+    size_t m = C[1], n = C[2], k = A[param.transposeA ? 1 : 2];
+    bool ok_type = A.dtype == dtype::Float32() && B.dtype == dtype::Float32() &&
+                   C.dtype == dtype::Float32();
+    bool ok_param = param.format == param::MatrixMul::Format::DEFAULT &&
+                    param.compute_mode == param::MatrixMul::ComputeMode::DEFAULT;
+    bool ok_layout = A.stride[2] == 1 && B.stride[2] == 1 && C.stride[2] == 1;
+    bool ok_size = m <= SMALL_MAX_MN && n <= SMALL_MAX_MN && k <= SMALL_MAX_K;
+    return ok_type && ok_param && ok_layout && ok_size;
+}
+
+size_t BatchedMatrixMulForwardImpl::AlgoF32Small::get_workspace_in_bytes(
+        const SizeArgs& args) const {
+    if (!args.opr->param().transposeB) {
+        return 0;
+    }
+    //! one row major copy of B for each thread
+    size_t nr_threads = static_cast<naive::HandleImpl*>(args.opr->handle())
+                                ->megcore_dispatcher()
+                                ->nr_threads();
+    size_t n = args.layout_c[2], k = args.layout_b[2];
+    return nr_threads * k * n * sizeof(float);
+}
+
+void BatchedMatrixMulForwardImpl::AlgoF32Small::exec(const ExecArgs& args) const {
+    auto param = args.opr->param();
+    bool trans_a = param.transposeA, trans_b = param.transposeB;
+    auto&& A = args.layout_a;
+    auto&& B = args.layout_b;
+    auto&& C = args.layout_c;
+    size_t m = C[1], n = C[2], k = A[trans_a ? 1 : 2];
+    ptrdiff_t a_batch = A.stride[0], b_batch = B.stride[0], c_batch = C.stride[0];
+    size_t lda = A.stride[1], ldb = B.stride[1], ldc = C.stride[1];
+    size_t nr_tiles = div_ceil(m, SMALL_TILE_M);
+    auto a_ptr = args.tensor_a.ptr<dt_float32>();
+    auto b_ptr = args.tensor_b.ptr<dt_float32>();
+    auto c_ptr = args.tensor_c.ptr<dt_float32>();
+    auto buf = args.workspace.ptr<dt_float32>();
+    auto kern = [=](size_t index, size_t thread_id) {
+        size_t batch_id = index / nr_tiles;
+        size_t m_begin = index % nr_tiles * SMALL_TILE_M;
+        size_t rows = std::min(m - m_begin, SMALL_TILE_M);
+        const float* a = a_ptr + batch_id * a_batch;
+        a += trans_a ? m_begin : m_begin * lda;
+        const float* b = b_ptr + batch_id * b_batch;
+        size_t b_ld = ldb;
+        if (trans_b) {
+            float* packed = buf + thread_id * k * n;
+            for (size_t j = 0; j < n; ++j) {
+                for (size_t kk = 0; kk < k; ++kk) {
+                    packed[kk * n + j] = b[j * ldb + kk];
+                }
+            }
+            b = packed;
+            b_ld = n;
+        }
+        float* c = c_ptr + batch_id * c_batch + m_begin * ldc;
+        if (trans_a) {
+            kern_tile<true>(a, lda, b, b_ld, c, ldc, rows, n, k);
+        } else {
+            kern_tile<false>(a, lda, b, b_ld, c, ldc, rows, n, k);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(args.opr->handle()),
+            A[0] * nr_tiles, kern);
+}
+
+/* ===================== int8x8x32 algo ===================== */
+namespace {
+
+constexpr size_t INT8_MAX_MN = 128;
+constexpr size_t INT8_MAX_K = 512;
+constexpr size_t INT8_TILE_M = 16;
+
+//! C(m, n) = A(m, k) * B(k, n), with B row major
+template <bool trans_a>
+void kern_tile_int8(
+        const dt_int8* A, size_t lda, const dt_int8* B, size_t ldb, dt_int32* C,
+        size_t ldc, size_t m, size_t n, size_t k) {
+    for (size_t i = 0; i < m; ++i) {
+        dt_int32* c = C + i * ldc;
+        std::fill(c, c + n, 0);
+        for (size_t kk = 0; kk < k; ++kk) {
+            dt_int32 a = trans_a ? A[kk * lda + i] : A[i * lda + kk];
+            const dt_int8* b = B + kk * ldb;
+            //! contiguous widening multiply-add, which is vectorized by the
+            //! compiler
+            for (size_t j = 0; j < n; ++j) {
+                c[j] += a * static_cast<dt_int32>(b[j]);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+bool BatchedMatrixMulForwardImpl::AlgoInt8x8x32::is_available(
+        const SizeArgs& args) const {
+    auto&& param = args.opr->param();
+    auto&& A = args.layout_a;
+    auto&& B = args.layout_b;
+    auto&& C = args.layout_c;
+    size_t m = C[1], n = C[2], k = A[param.transposeA ? 1 : 2];
+    bool ok_type = (A.dtype.enumv() == DTypeEnum::Int8 &&
+                    B.dtype.enumv() == DTypeEnum::Int8 &&
+                    C.dtype.enumv() == DTypeEnum::Int32) ||
+                   (A.dtype.enumv() == DTypeEnum::QuantizedS8 &&
+                    B.dtype.enumv() == DTypeEnum::QuantizedS8 &&
+                    C.dtype.enumv() == DTypeEnum::QuantizedS32);
+    bool ok_param = param.format == param::MatrixMul::Format::DEFAULT &&
+                    param.compute_mode == param::MatrixMul::ComputeMode::DEFAULT;
+    bool ok_layout = A.stride[2] == 1 && B.stride[2] == 1 && C.stride[2] == 1;
+    bool ok_size = m <= INT8_MAX_MN && n <= INT8_MAX_MN && k <= INT8_MAX_K;
+    return ok_type && ok_param && ok_layout && ok_size;
+}
+
+size_t BatchedMatrixMulForwardImpl::AlgoInt8x8x32::get_workspace_in_bytes(
+        const SizeArgs& args) const {
+    if (!args.opr->param().transposeB) {
+        return 0;
+    }
+    //! one row major copy of B for each thread
+    size_t nr_threads = static_cast<naive::HandleImpl*>(args.opr->handle())
+                                ->megcore_dispatcher()
+                                ->nr_threads();
+    size_t n = args.layout_c[2], k = args.layout_b[2];
+    return nr_threads * k * n * sizeof(dt_int8);
+}
+
+void BatchedMatrixMulForwardImpl::AlgoInt8x8x32::exec(const ExecArgs& args) const {
+    auto param = args.opr->param();
+    bool trans_a = param.transposeA, trans_b = param.transposeB;
+    auto&& A = args.layout_a;
+    auto&& B = args.layout_b;
+    auto&& C = args.layout_c;
+    size_t m = C[1], n = C[2], k = A[trans_a ? 1 : 2];
+    ptrdiff_t a_batch = A.stride[0], b_batch = B.stride[0], c_batch = C.stride[0];
+    size_t lda = A.stride[1], ldb = B.stride[1], ldc = C.stride[1];
+    size_t nr_tiles = div_ceil(m, INT8_TILE_M);
+    //! Int8 and QuantizedS8 share the same storage
+    auto a_ptr = static_cast<const dt_int8*>(args.tensor_a.raw_ptr());
+    auto b_ptr = static_cast<const dt_int8*>(args.tensor_b.raw_ptr());
+    auto c_ptr = static_cast<dt_int32*>(args.tensor_c.raw_ptr());
+    auto buf = args.workspace.ptr<dt_int8>();
+    auto kern = [=](size_t index, size_t thread_id) {
+        size_t batch_id = index / nr_tiles;
+        size_t m_begin = index % nr_tiles * INT8_TILE_M;
+        size_t rows = std::min(m - m_begin, INT8_TILE_M);
+        const dt_int8* a = a_ptr + batch_id * a_batch;
+        a += trans_a ? m_begin : m_begin * lda;
+        const dt_int8* b = b_ptr + batch_id * b_batch;
+        size_t b_ld = ldb;
+        if (trans_b) {
+            dt_int8* packed = buf + thread_id * k * n;
+            for (size_t j = 0; j < n; ++j) {
+                for (size_t kk = 0; kk < k; ++kk) {
+                    packed[kk * n + j] = b[j * ldb + kk];
+                }
+            }
+            b = packed;
+            b_ld = n;
+        }
+        dt_int32* c = c_ptr + batch_id * c_batch + m_begin * ldc;
+        if (trans_a) {
+            kern_tile_int8<true>(a, lda, b, b_ld, c, ldc, rows, n, k);
+        } else {
+            kern_tile_int8<false>(a, lda, b, b_ld, c, ldc, rows, n, k);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(
+            static_cast<naive::HandleImpl*>(args.opr->handle()),
+            A[0] * nr_tiles, kern);
+}
+
 // vim: syntax=cpp.doxygen
@@ -22,6 +22,8 @@ protected:
 public:
     enum class AlgoType : uint32_t {
         fallback_BLAS,
+        fallback_small_f32,
+        fallback_int8x8x32,
     };
     using Mapper = std::unordered_map<AlgorithmDesc, AlgoBase*>;
 
@@ -81,6 +83,44 @@ public:
     MEGDNN_DECL_ALGO_TYPE(fallback_BLAS)
 };
 
+/*!
+ * \brief fp32 batched matmul of small matrices
+ *
+ * Each task computes a tile of rows of one batch item straight from the
+ * strided inputs, so neither a MatrixMul operator nor its packed panels are
+ * set up per batch item; only a transposed B is copied into the workspace
+ * of the thread. Tasks are spread over batch * tiles.
+ */
+class BatchedMatrixMulForwardImpl::AlgoF32Small final : public AlgoBase {
+public:
+    AlgoF32Small() = default;
+    bool is_available(const SizeArgs& args) const override;
+    size_t get_workspace_in_bytes(const SizeArgs& args) const override;
+    const char* name() const override { return "FB_BATCHED_SMALL_F32"; }
+    virtual void exec(const ExecArgs&) const override;
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    MEGDNN_DECL_ALGO_TYPE(fallback_small_f32)
+};
+
+/*!
+ * \brief int8 x int8 -> int32 batched matmul of attention sized matrices
+ *
+ * Like AlgoF32Small, tasks are spread over batch * tiles of rows, so that the
+ * batched matmuls of the heads of a quantized transformer run in parallel
+ * rather than batch item by batch item. The requantization is left to the
+ * TypeCvt following it.
+ */
+class BatchedMatrixMulForwardImpl::AlgoInt8x8x32 final : public AlgoBase {
+public:
+    AlgoInt8x8x32() = default;
+    bool is_available(const SizeArgs& args) const override;
+    size_t get_workspace_in_bytes(const SizeArgs& args) const override;
+    const char* name() const override { return "FB_BATCHED_INT8X8X32"; }
+    virtual void exec(const ExecArgs&) const override;
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    MEGDNN_DECL_ALGO_TYPE(fallback_int8x8x32)
+};
+
 class BatchedMatrixMulForwardImpl::AlgoPack : NonCopyableObj {
 private:
     AlgoBase::Mapper m_all_algos_map;
@@ -88,6 +128,8 @@ private:
 public:
     AlgoPack();
     AlgoDefault algo_default;
+    AlgoF32Small algo_f32_small;
+    AlgoInt8x8x32 algo_int8x8x32;
     std::vector<AlgoBase*> all_algos;
 
     const AlgoBase::Mapper& all_algos_map() const { return m_all_algos_map; }
@@ -27,6 +27,14 @@ BatchedMatrixMulForwardImpl::Algorithm* BatchedMatrixMulForwardImpl::
                 size_t workspace_limit_in_bytes, const AlgoAttribute& positive_attr,
                 const AlgoAttribute& negative_attr) {
     AlgoBase::SizeArgs args{this, A, B, C};
+    if (sm_algo_pack.algo_f32_small.is_available_attribute(
+                args, positive_attr, negative_attr, workspace_limit_in_bytes)) {
+        return &sm_algo_pack.algo_f32_small;
+    }
+    if (sm_algo_pack.algo_int8x8x32.is_available_attribute(
+                args, positive_attr, negative_attr, workspace_limit_in_bytes)) {
+        return &sm_algo_pack.algo_int8x8x32;
+    }
     if (sm_algo_pack.algo_default.is_available_attribute(
                 args, positive_attr, negative_attr, workspace_limit_in_bytes)) {
         return &sm_algo_pack.algo_default;
@@ -18,6 +18,8 @@ public:
 
     class AlgoBase;
     class AlgoDefault;
+    class AlgoF32Small;
+    class AlgoInt8x8x32;
     class AlgoPack;
     static const AlgoPack& algo_pack() { return sm_algo_pack; }
     Algorithm* get_algorithm_from_desc(const AlgorithmDesc&) override;
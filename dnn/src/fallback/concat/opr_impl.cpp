@@ -1,39 +1,19 @@
 #include "src/fallback/concat/opr_impl.h"
 
-#include <cstring>
 #include <numeric>
 #include "src/common/utils.h"
+#include "src/fallback/copy_helper.h"
 #include "src/naive/handle.h"
 
-namespace megdnn {
-namespace fallback {
-namespace concat {
-
-template <typename ctype>
-void exec_generic(
-        const TensorNDArray& srcs, const TensorND& dst, size_t A, size_t B, size_t C,
-        size_t* Bv) {
-    rep(a, A) {
-        size_t b = 0u;
-        rep(i, srcs.size()) {
-            auto dptr = dst.ptr<ctype>() + (a * B + b) * C;
-            auto sptr = srcs[i].ptr<ctype>() + a * Bv[i] * C;
-            std::memcpy(dptr, sptr, sizeof(ctype) * (Bv[i] * C));
-            b += Bv[i];
-        }
-    }
-}
-
-}  // namespace concat
-}  // namespace fallback
-}  // namespace megdnn
-
 namespace megdnn {
 namespace fallback {
 
 void ConcatImpl::exec(
         _megdnn_in const TensorNDArray& srcs, _megdnn_tensor_out dst,
         _megdnn_workspace workspace) {
+    if (dst.layout.dtype.is_low_bit()) {
+        return naive::ConcatForwardImpl::exec(srcs, dst, workspace);
+    }
     auto srcs_layout = apply_vector<TensorLayout>(m_get_layout, srcs);
     auto srcs_shape = apply_vector<TensorShape>(m_get_shape, srcs_layout);
     check_exec(srcs_layout, dst.layout, workspace.size);
@@ -41,21 +21,38 @@ void ConcatImpl::exec(
     size_t A, B, C;
     get_ABC(srcs_shape, A, Bv, C);
     B = std::accumulate(Bv, Bv + srcs.size(), 0u);
-    switch (srcs[0].layout.dtype.enumv()) {
-#define parser(_dt)                                                   \
-    case DTypeTrait<_dt>::enumv: {                                    \
-        using ctype = typename DTypeTrait<_dt>::ctype;                \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(                                 \
-                concat::exec_generic<ctype>(srcs, dst, A, B, C, Bv)); \
-        break;                                                        \
-    };
-        MEGDNN_FOREACH_COMPUTING_DTYPE(parser)
-        default: {
-            naive::ConcatForwardImpl::exec(srcs, dst, workspace);
+
+    // a unit copies a src to a row of dst, and the units are split into tasks
+    size_t nr_srcs = srcs.size(), esize = dst.layout.dtype.size();
+    size_t nr_units = A * nr_srcs;
+    size_t nr_tasks = get_nr_copy_tasks(
+            nr_units, A * B * C * esize, get_nr_threads(handle()));
+    size_t units_per_task = div_ceil(nr_units, nr_tasks);
+    nr_tasks = div_ceil(nr_units, units_per_task);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t begin = task_id * units_per_task,
+               end = std::min(begin + units_per_task, nr_units);
+        size_t a = begin / nr_srcs, i = begin % nr_srcs, b = 0;
+        for (size_t k = 0; k < i; ++k) {
+            b += Bv[k];
         }
-#undef parser
-    }
+        auto dptr = static_cast<dt_byte*>(dst.raw_ptr());
+        for (size_t unit = begin; unit < end; ++unit) {
+            size_t size = Bv[i] * C * esize;
+            copy_bytes(
+                    dptr + (a * B + b) * C * esize,
+                    static_cast<const dt_byte*>(srcs[i].raw_ptr()) + a * size, size);
+            b += Bv[i];
+            if (++i == nr_srcs) {
+                i = 0;
+                b = 0;
+                ++a;
+            }
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
 }
+
 }  // namespace fallback
 }  // namespace megdnn
 
@@ -33,7 +33,11 @@ size_t ConvBiasImpl::AlgoConv1x1::get_oc_tile_size_heuristic(
     size_t OC = param.filter_meta.ocpg;
     if (OH * OW >= 56 * 56 || OC >= 64)
         return m_oc_block_size;
-    size_t oc_block_size_one_thread = div_ceil(OC, param.nr_threads);
+    //! batches and groups are computed in parallel, so OC is only split for
+    //! the remaining threads
+    size_t nr_tasks = std::max<size_t>(param.n * param.filter_meta.group, 1);
+    size_t nr_threads = div_ceil(param.nr_threads, nr_tasks);
+    size_t oc_block_size_one_thread = div_ceil(OC, nr_threads);
     return round_up<size_t>(oc_block_size_one_thread, 24);
 }
 
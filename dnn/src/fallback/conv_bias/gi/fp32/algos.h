@@ -346,6 +346,27 @@ public:
     MEGDNN_DECL_ALGO_TYPE(GI_COMMON_CHWNWISE_NCHW44_F32)
 };
 
+/*!
+ * \brief channel wise conv for filters from 7x7 to 31x31, keeping a block of
+ *      outputs and their input window in registers
+ */
+class ConvBiasImpl::AlgoF32ChannelWiseLargeNCHW44 final : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "F32_CHANNEL_WISE_LARGE_NCHW44"; }
+    bool usable(
+            const NCBKernSizeParam& param,
+            AlgoSelectionStrategy algo_selection_strategy) const override;
+
+    size_t get_workspace(const NCBKernSizeParam& param) const override;
+    virtual SmallVector<NCBKern> dispatch_kerns(
+            const NCBKernSizeParam& param) const override;
+    ConvAlgoTypePack get_algo_type() const override {
+        return {AlgoDataType::FLOAT32, AlgoCategory::DIRECT};
+    }
+    MEGDNN_DECL_ALGO_TYPE(GI_COMMON_CHWNWISE_LARGE_NCHW44_F32)
+};
+
 }  // namespace fallback
 }  // namespace megdnn
 
@@ -0,0 +1,196 @@
+#include "src/fallback/conv_bias/gi/fp32/algos.h"
+#include "src/fallback/conv_bias/gi/fp32/channel_wise_large_nchw44_kern.h"
+#include "src/fallback/elemwise_helper/elemwise_op.h"
+
+#include "midout.h"
+
+using namespace megdnn;
+using namespace fallback;
+using conv_fun = std::function<void(
+        const float* src, const float* filter, const float* bias, float* dst,
+        const size_t IW2, const size_t FH, const size_t FW, const size_t OH,
+        const size_t OW)>;
+
+MIDOUT_DECL(conv_bias_fp32_channel_wise_large_nchw44)
+
+namespace {
+
+constexpr size_t pack_group_size = 4;
+//! smaller filters are served by AlgoF32ChannelWiseNCHW44
+constexpr size_t min_filter_size = 7;
+constexpr size_t max_filter_size = 31;
+
+bool need_padding(const ConvBiasImpl::NCBKernSizeParam& param) {
+    return param.filter_meta.padding[0] || param.filter_meta.padding[1];
+}
+
+//! bytes of the zero padded copy of one channel block
+size_t get_padded_src_bytes(const ConvBiasImpl::NCBKernSizeParam& param) {
+    size_t IH2 = param.isz[0] + 2 * param.filter_meta.padding[0];
+    size_t IW2 = param.isz[1] + 2 * param.filter_meta.padding[1];
+    return IH2 * IW2 * pack_group_size * sizeof(float);
+}
+
+WorkspaceBundle get_bundle(const ConvBiasImpl::NCBKernSizeParam& param) {
+    if (!need_padding(param)) {
+        return {nullptr, {}};
+    }
+    return {nullptr, {get_padded_src_bytes(param) * param.nr_threads}};
+}
+
+void copy_padding(
+        const float* src, float* dst, size_t IH, size_t IW, size_t PH, size_t PW) {
+    size_t IW2 = IW + 2 * PW;
+    size_t row_bytes = IW2 * pack_group_size * sizeof(float);
+    std::memset(dst, 0, PH * row_bytes);
+    dst += PH * IW2 * pack_group_size;
+    for (size_t ih = 0; ih < IH; ++ih) {
+        std::memset(dst, 0, PW * pack_group_size * sizeof(float));
+        std::memcpy(
+                dst + PW * pack_group_size, src + ih * IW * pack_group_size,
+                IW * pack_group_size * sizeof(float));
+        std::memset(
+                dst + (PW + IW) * pack_group_size, 0,
+                PW * pack_group_size * sizeof(float));
+        dst += IW2 * pack_group_size;
+    }
+    std::memset(dst, 0, PH * row_bytes);
+}
+
+}  // namespace
+
+bool ConvBiasImpl::AlgoF32ChannelWiseLargeNCHW44::usable(
+        const NCBKernSizeParam& param, AlgoSelectionStrategy) const {
+    auto&& fm = param.filter_meta;
+    size_t FH = fm.spatial[0], FW = fm.spatial[1];
+    bool ok_type =
+            (param.src_type.enumv() == DTypeEnum::Float32 &&
+             param.filter_type.enumv() == DTypeEnum::Float32 &&
+             (param.dst_type.enumv() == DTypeEnum::Float32));
+    bool ok_format = fm.ocpg == 1 && fm.icpg == 1 && fm.group % 4 == 0 &&
+                     fm.format == param::Convolution::Format::NCHW44;
+    bool ok_filter = fm.spatial_ndim == 2 && FH >= min_filter_size &&
+                     FW >= min_filter_size && FH <= max_filter_size &&
+                     FW <= max_filter_size;
+    bool ok_slide = fm.dilation[0] == 1 && fm.dilation[1] == 1 &&
+                    fm.stride[0] == fm.stride[1] &&
+                    (fm.stride[0] == 1 || fm.stride[0] == 2);
+    bool ok_conv = !fm.should_flip;
+    return ok_type && ok_format && ok_filter && ok_slide && ok_conv;
+}
+
+size_t ConvBiasImpl::AlgoF32ChannelWiseLargeNCHW44::get_workspace(
+        const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            conv_bias_fp32_channel_wise_large_nchw44,
+            midout_iv("AlgoF32ChannelWiseLargeNCHW44::get_workspace"_hash)) {
+        return get_bundle(param).total_size_in_bytes();
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+SmallVector<ConvBiasImpl::NCBKern> ConvBiasImpl::AlgoF32ChannelWiseLargeNCHW44::
+        dispatch_kerns(const NCBKernSizeParam& param) const {
+    auto fm = param.filter_meta;
+    const int batch = param.n;
+    const int group = fm.group;
+    const int stride = fm.stride[0];
+
+    conv_fun do_conv_fun = nullptr;
+#define DO_CONV_KERN_FUN(_stride, bias_mode, op)                     \
+    MIDOUT_BEGIN(                                                    \
+            conv_bias_fp32_channel_wise_large_nchw44,                \
+            midout_iv(#_stride #bias_mode #op##_hash)) {             \
+        do_conv_fun = channel_wise_large_nchw44_float::do_conv_kern< \
+                bias_mode, op, _stride>;                             \
+    }                                                                \
+    MIDOUT_END();
+
+#define GET_OP_PARAM(_stride, bias_mode)                                \
+    switch (param.nonlineMode) {                                        \
+        case param::ConvBias::NonlineMode::IDENTITY:                    \
+            DO_CONV_KERN_FUN(_stride, bias_mode, NoneOp<dt_float32>)    \
+            break;                                                      \
+        case param::ConvBias::NonlineMode::RELU:                        \
+            DO_CONV_KERN_FUN(_stride, bias_mode, ReluOp<dt_float32>)    \
+            break;                                                      \
+        case param::ConvBias::NonlineMode::SIGMOID:                     \
+            DO_CONV_KERN_FUN(_stride, bias_mode, SigmoidOp<dt_float32>) \
+            break;                                                      \
+        case param::ConvBias::NonlineMode::H_SWISH:                     \
+            DO_CONV_KERN_FUN(_stride, bias_mode, HSwishOp<dt_float32>)  \
+            break;                                                      \
+        default:                                                        \
+            megdnn_assert(0);                                           \
+            break;                                                      \
+    }
+
+#define GET_BIAS_MODE_PARAM(_stride)                                \
+    switch (param.bias_mode) {                                      \
+        case BiasMode::NO_BIAS:                                     \
+            GET_OP_PARAM(_stride, BiasMode::NO_BIAS)                \
+            break;                                                  \
+        case BiasMode::BROADCAST_CHANNEL_BIAS:                      \
+            GET_OP_PARAM(_stride, BiasMode::BROADCAST_CHANNEL_BIAS) \
+            break;                                                  \
+        case BiasMode::BIAS:                                        \
+            GET_OP_PARAM(_stride, BiasMode::BIAS)                   \
+            break;                                                  \
+        default:                                                    \
+            megdnn_assert(0);                                       \
+            break;                                                  \
+    }
+
+    if (1 == stride) {
+        GET_BIAS_MODE_PARAM(1);
+    } else {
+        GET_BIAS_MODE_PARAM(2);
+    }
+
+#undef DO_CONV_KERN_FUN
+#undef GET_OP_PARAM
+#undef GET_BIAS_MODE_PARAM
+
+    megdnn_assert(do_conv_fun);
+
+    WorkspaceBundle bundle = get_bundle(param);
+    size_t padded_src_bytes = get_padded_src_bytes(param);
+    SmallVector<ConvBiasImpl::NCBKern> ret_kerns;
+    CpuNDRange ncb_range = {
+            static_cast<size_t>(batch), static_cast<size_t>(group / pack_group_size)};
+    auto do_conv = [bundle, do_conv_fun, padded_src_bytes](
+                           const NCBKernParam& kern_param,
+                           const NCBKernIndex& ncb_index) mutable {
+        size_t PH = kern_param.filter_meta.padding[0];
+        size_t PW = kern_param.filter_meta.padding[1];
+        size_t FH = kern_param.filter_meta.spatial[0];
+        size_t FW = kern_param.filter_meta.spatial[1];
+        size_t OH = kern_param.osz[0];
+        size_t OW = kern_param.osz[1];
+        size_t IH = kern_param.isz[0];
+        size_t IW = kern_param.isz[1];
+
+        size_t batch_id = ncb_index.ndrange_id[0];
+        size_t group_id = ncb_index.ndrange_id[1];
+        const float* sptr =
+                kern_param.src<float>(batch_id, group_id, 0, pack_group_size);
+        const float* fptr = kern_param.filter<float>(group_id, pack_group_size);
+        float* dst = kern_param.dst<float>(batch_id, group_id, 0, pack_group_size);
+        const float* bptr =
+                kern_param.bias<float>(batch_id, group_id, 0, pack_group_size);
+        if (PH || PW) {
+            bundle.set(kern_param.workspace_ptr);
+            float* padded = reinterpret_cast<float*>(
+                    static_cast<int8_t*>(bundle.get(0)) +
+                    ncb_index.thread_id * padded_src_bytes);
+            copy_padding(sptr, padded, IH, IW, PH, PW);
+            sptr = padded;
+        }
+        do_conv_fun(sptr, fptr, bptr, dst, IW + 2 * PW, FH, FW, OH, OW);
+    };
+    ret_kerns.push_back({do_conv, ncb_range});
+    return ret_kerns;
+}
+
+// vim: syntax=cpp.doxygen
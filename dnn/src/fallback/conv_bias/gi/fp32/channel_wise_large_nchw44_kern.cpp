@@ -0,0 +1,128 @@
+#include "src/fallback/conv_bias/gi/fp32/channel_wise_large_nchw44_kern.h"
+#include "src/common/utils.h"
+#include "src/fallback/conv_bias/common.h"
+#include "src/fallback/elemwise_helper/elemwise_op.h"
+
+using namespace megdnn;
+using namespace fallback;
+
+namespace {
+
+//! outputs of a row kept in registers together with their input window
+#if defined(GI_NEON_INTRINSICS)
+constexpr size_t OW_BLOCK = 8;
+#else
+constexpr size_t OW_BLOCK = 4;
+#endif
+
+template <BiasMode bias_mode>
+GI_FORCEINLINE GI_FLOAT32_t
+load_bias(const float* bias, const GI_FLOAT32_t& init, size_t offset) {
+    return bias_mode == BiasMode::BIAS ? GiLoadFloat32(bias + offset) : init;
+}
+
+/*!
+ * compute \p block outputs of one row
+ *
+ * The filter columns are visited phase by phase modulo the stride. Moving to
+ * the next column of the same phase shifts the input window by exactly one
+ * output, so every filter tap loads one filter vector and one new input
+ * vector for \p block multiply-adds.
+ */
+template <size_t block, BiasMode bias_mode, typename Op, int stride>
+GI_FORCEINLINE void compute_block(
+        const float* src, const float* filter, const float* bias, float* dst,
+        const GI_FLOAT32_t& init, const size_t IW2, const size_t FH, const size_t FW,
+        const Op& op) {
+    GI_FLOAT32_FIXLEN_t acc[block], win[block];
+    for (size_t i = 0; i < block; ++i) {
+        acc[i] = GiFloat32Type2FixLenType(load_bias<bias_mode>(bias, init, i * 4));
+    }
+    for (size_t fh = 0; fh < FH; ++fh) {
+        const float* row = src + fh * IW2 * 4;
+        const float* kernel = filter + fh * FW * 4;
+        for (size_t phase = 0; phase < static_cast<size_t>(stride); ++phase) {
+            for (size_t i = 0; i < block; ++i) {
+                win[i] = GiFloat32Type2FixLenType(
+                        GiLoadFloat32(row + (i * stride + phase) * 4));
+            }
+            for (size_t fw = phase;; fw += stride) {
+                GI_FLOAT32_t w = GiLoadFloat32(kernel + fw * 4);
+                for (size_t i = 0; i < block; ++i) {
+                    acc[i] = GiFloat32Type2FixLenType(GiMlaqFloat32(
+                            GiFixLenType2GiFloat32Type(acc[i]),
+                            GiFixLenType2GiFloat32Type(win[i]), w));
+                }
+                if (fw + stride >= FW) {
+                    break;
+                }
+                for (size_t i = 0; i + 1 < block; ++i) {
+                    win[i] = win[i + 1];
+                }
+                win[block - 1] = GiFloat32Type2FixLenType(GiLoadFloat32(
+                        row + ((block - 1) * stride + fw + stride) * 4));
+            }
+        }
+    }
+    for (size_t i = 0; i < block; ++i) {
+        op(GiFixLenType2GiFloat32Type(acc[i]), dst + i * 4);
+    }
+}
+
+}  // namespace
+
+template <BiasMode bias_mode, typename Op, int stride>
+void channel_wise_large_nchw44_float::do_conv_kern(
+        const float* src, const float* filter, const float* bias, float* dst,
+        const size_t IW2, const size_t FH, const size_t FW, const size_t OH,
+        const size_t OW) {
+    static_assert(stride == 1 || stride == 2, "invalid stride");
+    megdnn_assert_internal(FW >= static_cast<size_t>(stride));
+    Op op;
+    GI_FLOAT32_t init = GiZeroFloat32();
+    if (bias_mode == BiasMode::BROADCAST_CHANNEL_BIAS) {
+        init = GiLoadFloat32(bias);
+    }
+    for (size_t oh = 0; oh < OH; ++oh) {
+        const float* sptr = src + oh * stride * IW2 * 4;
+        float* dptr = dst + oh * OW * 4;
+        const float* bptr = bias + oh * OW * 4;
+        size_t ow = 0;
+        for (; ow + OW_BLOCK <= OW; ow += OW_BLOCK) {
+            compute_block<OW_BLOCK, bias_mode, Op, stride>(
+                    sptr + ow * stride * 4, filter, bptr + ow * 4, dptr + ow * 4,
+                    init, IW2, FH, FW, op);
+        }
+        for (; ow < OW; ++ow) {
+            compute_block<1, bias_mode, Op, stride>(
+                    sptr + ow * stride * 4, filter, bptr + ow * 4, dptr + ow * 4,
+                    init, IW2, FH, FW, op);
+        }
+    }
+}
+
+#define INSTANTIATION(stride, bias, Op)                                     \
+    template void                                                           \
+    channel_wise_large_nchw44_float::do_conv_kern<bias, Op, stride>(        \
+            const float*, const float*, const float*, float*, const size_t, \
+            const size_t, const size_t, const size_t, const size_t);
+
+#define FOR_OP(stride, bias)                           \
+    INSTANTIATION(stride, bias, SigmoidOp<dt_float32>) \
+    INSTANTIATION(stride, bias, ReluOp<dt_float32>)    \
+    INSTANTIATION(stride, bias, HSwishOp<dt_float32>)  \
+    INSTANTIATION(stride, bias, NoneOp<dt_float32>)
+
+#define FOR_BIAS(stride)                             \
+    FOR_OP(stride, BiasMode::NO_BIAS)                \
+    FOR_OP(stride, BiasMode::BROADCAST_CHANNEL_BIAS) \
+    FOR_OP(stride, BiasMode::BIAS)
+
+FOR_BIAS(1)
+FOR_BIAS(2)
+
+#undef FOR_BIAS
+#undef FOR_OP
+#undef INSTANTIATION
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "src/fallback/conv_bias/common.h"
+#include "src/fallback/conv_bias/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+namespace channel_wise_large_nchw44_float {
+
+/*!
+ * \brief channel wise conv of one channel block with a large filter
+ *
+ * \p src is the padded input of shape (IH2, IW2, 4), so the kernel never
+ * checks the borders; \p filter is (FH, FW, 4)
+ */
+template <BiasMode bias_mode, typename Op, int stride>
+void do_conv_kern(
+        const float* src, const float* filter, const float* bias, float* dst,
+        const size_t IW2, const size_t FH, const size_t FW, const size_t OH,
+        const size_t OW);
+
+}  // namespace channel_wise_large_nchw44_float
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
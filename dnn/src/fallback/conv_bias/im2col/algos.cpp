@@ -70,7 +70,12 @@ static void choice_ohw_oc_block(
     //! when oc_tile_size < this value oc_tile_size =
     //! DEFAULT_OC_MIN_TILE_SIZE the purpose is aligning the calculation
     size_t DEFAULT_OC_MIN_TILE_SIZE = round_up(static_cast<size_t>(128), block_m);
-    size_t nr_threads = param.nr_threads;
+    //! batches and groups are already dispatched as separate tasks, so the
+    //! tiles only have to provide the parallelism they lack. Splitting a
+    //! group conv with many small groups further just adds the per tile
+    //! overhead of im2col and packing
+    size_t nr_tasks = std::max<size_t>(param.n * param.filter_meta.group, 1);
+    size_t nr_threads = div_ceil(param.nr_threads, nr_tasks);
     size_t OC = param.filter_meta.ocpg;
     size_t ohw = param.osz[0] * param.osz[1];
     oc_tile_size = DEFAULT_OC_TILE_SIZE;
@@ -90,6 +95,9 @@ static void choice_ohw_oc_block(
                 } else if (oc_tile_size < DEFAULT_OC_MIN_TILE_SIZE) {
                     oc_tile_size = DEFAULT_OC_MIN_TILE_SIZE;
                 }
+                //! a tile larger than the channels of a group only wastes
+                //! workspace
+                oc_tile_size = std::min(oc_tile_size, OC);
             }
         }
     } else {
@@ -89,6 +89,7 @@ class ConvBiasImpl::AlgoPack : NonCopyableObj {
     AlgoF32DirectNCHWNCHW44 f32_nchw_nchw44;
     AlgoF32DirectNCHWNCHW44AGENT f32_nchw_nchw44_agent;
     AlgoF32ChannelWiseNCHW44 f32_chanel_wise_nchw44;
+    AlgoF32ChannelWiseLargeNCHW44 f32_chanel_wise_large_nchw44;
     AlgoF32DirectNCHW44 f32_direct_nchw44;
 
     AlgoF32Direct f32_direct;
@@ -109,6 +110,7 @@ public:
 #endif
 
         m_all_algos.emplace_back(&f32_chanel_wise_nchw44);
+        m_all_algos.emplace_back(&f32_chanel_wise_large_nchw44);
         m_all_algos.emplace_back(&f32_direct_nchw44);
         m_all_algos.emplace_back(&f32_direct_stride1);
         m_all_algos.emplace_back(&f32_direct_stride2);
@@ -352,7 +354,7 @@ size_t ConvBiasImpl::get_workspace_in_bytes(
     AlgorithmCache::Key key{this->handle(), this->get_opr_type(),
                             layouts.data(), layouts.size(),
                             &this->param(), sizeof(this->param())};
-    auto rst = AlgorithmCache::instance().get(key);
+    auto rst = AlgorithmCache::instance().get(key, this->algo_cache_last_entry());
     if (rst.policy.algo.valid()) {
         return rst.workspace;
     }
@@ -236,6 +236,7 @@ public:
             GI_COMMON_DIRECT_NCHW_NCHW44_FP32,
             GI_COMMON_DIRECT_NCHW_NCHW44_AGENT_FP32,
             GI_COMMON_CHWNWISE_NCHW44_F32,
+            GI_COMMON_CHWNWISE_LARGE_NCHW44_F32,
 
 #if MEGDNN_X86
             X86_DIRECT = 1 << 8,
@@ -294,6 +295,7 @@ public:
             ARMV7_MATMUL_S8,
             ARMV7_MATMUL_QU8,
 #endif  // MEGDNN_AARCH64
+            ARM_COMMON_WINOGRAD_F43_4X4_NCHW44_S8CF32,
 #endif
         };
 
@@ -406,6 +408,7 @@ private:
     class AlgoF32DirectNCHWNCHW44;
     class AlgoF32DirectNCHWNCHW44AGENT;
     class AlgoF32ChannelWiseNCHW44;
+    class AlgoF32ChannelWiseLargeNCHW44;
     class AlgoF32DirectNCHW44;
 
     class AlgoPack;
@@ -10,6 +10,7 @@ using namespace fallback;
 
 MIDOUT_DECL(megdnn_fallback_conv)
 MIDOUT_DECL(megdnn_fallback_deconv)
+MIDOUT_DECL(megdnn_fallback_wgrad)
 
 namespace {
 
@@ -700,4 +701,221 @@ bool ConvolutionBackwardDataImpl::AlgoMatrixMulNCHW44::is_preferred(
     return is_matrix_mul_preferred(param);
 }
 
+/////////////////////////// ConvolutionBackwardFilter /////////////////////
+namespace {
+using WgradSizeParam = ConvolutionBackwardFilterImpl::NCBKernSizeParam;
+using WgradParam = ConvolutionBackwardFilterImpl::NCBKernParam;
+
+//! sizes of one group of the wgrad, where the channels are unpacked
+struct WgradShape {
+    size_t N, G, IC, OC, IH, IW, OH, OW, FH, FW, SH, SW, PH, PW, DH, DW;
+    //! channels packed in the innermost dim, 1 for NCHW
+    size_t pack;
+    //! rows and columns of the im2col matrix
+    size_t K, S;
+};
+
+WgradShape get_wgrad_shape(const WgradSizeParam& param) {
+    auto&& fm = param.filter_meta;
+    auto&& src = param.src_layout;
+    auto&& diff = param.diff_layout;
+    size_t pack = 1;
+    if (fm.format == param::Convolution::Format::NCHW44) {
+        pack = 4;
+    } else if (fm.format == param::Convolution::Format::NCHW88) {
+        pack = 8;
+    }
+    WgradShape ret;
+    ret.N = src[0];
+    ret.G = fm.group;
+    ret.IC = fm.icpg;
+    ret.OC = fm.ocpg;
+    ret.IH = src[2];
+    ret.IW = src[3];
+    ret.OH = diff[2];
+    ret.OW = diff[3];
+    ret.FH = fm.spatial[0];
+    ret.FW = fm.spatial[1];
+    ret.SH = fm.stride[0];
+    ret.SW = fm.stride[1];
+    ret.PH = fm.padding[0];
+    ret.PW = fm.padding[1];
+    ret.DH = fm.dilation[0];
+    ret.DW = fm.dilation[1];
+    ret.pack = pack;
+    ret.K = ret.IC * ret.FH * ret.FW;
+    ret.S = ret.OH * ret.OW;
+    return ret;
+}
+
+MatrixMul* get_wgrad_matmul_opr() {
+    static CpuOprDelegationStorage<1> storage;
+    MatrixMul::Param p;
+    p.transposeB = true;
+    return storage.get<MatrixMul>(p);
+}
+
+size_t get_wgrad_nr_tasks(const WgradSizeParam& param) {
+    return std::max<size_t>(1, std::min(param.src_layout[0], param.nr_threads));
+}
+
+//! workspace of a task: im2col, unpacked diff, matmul dst, accumulator and
+//! matmul workspace
+WorkspaceBundle get_wgrad_task_bundle(const WgradSizeParam& param) {
+    auto s = get_wgrad_shape(param);
+    size_t mm_ws = get_wgrad_matmul_opr()->get_workspace_in_bytes(
+            {{s.OC, s.S}, dtype::Float32()}, {{s.K, s.S}, dtype::Float32()},
+            {{s.OC, s.K}, dtype::Float32()});
+    return {nullptr,
+            {s.K * s.S * sizeof(float), s.pack > 1 ? s.OC * s.S * sizeof(float) : 0,
+             s.OC * s.K * sizeof(float), s.G * s.OC * s.K * sizeof(float), mm_ws}};
+}
+
+//! unroll the input of a group of a sample into a (K, S) matrix
+void wgrad_im2col(const float* src, float* col, const WgradShape& s) {
+    for (size_t ic = 0; ic < s.IC; ++ic) {
+        const float* chan = src + (ic / s.pack * s.IH * s.IW) * s.pack + ic % s.pack;
+        for (size_t fh = 0; fh < s.FH; ++fh) {
+            for (size_t fw = 0; fw < s.FW; ++fw) {
+                for (size_t oh = 0; oh < s.OH; ++oh) {
+                    ptrdiff_t ih = oh * s.SH + fh * s.DH - s.PH;
+                    bool h_valid = ih >= 0 && ih < static_cast<ptrdiff_t>(s.IH);
+                    for (size_t ow = 0; ow < s.OW; ++ow) {
+                        ptrdiff_t iw = ow * s.SW + fw * s.DW - s.PW;
+                        bool valid = h_valid && iw >= 0 &&
+                                     iw < static_cast<ptrdiff_t>(s.IW);
+                        *col++ = valid ? chan[(ih * s.IW + iw) * s.pack] : 0.f;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void wgrad_kern_accumulate(const WgradParam& param, size_t index) {
+    auto s = get_wgrad_shape(param);
+    size_t nr_tasks = get_wgrad_nr_tasks(param);
+    auto bundle = get_wgrad_task_bundle(param);
+    bundle.set(static_cast<dt_byte*>(param.workspace_ptr) +
+               index * bundle.total_size_in_bytes());
+    auto col = static_cast<float*>(bundle.get(0));
+    auto dmat = static_cast<float*>(bundle.get(1));
+    auto tmp = static_cast<float*>(bundle.get(2));
+    auto acc = static_cast<float*>(bundle.get(3));
+    std::memset(acc, 0, bundle.get_size(3));
+
+    size_t chunk = div_ceil(s.N, nr_tasks);
+    size_t n_begin = index * chunk, n_end = std::min(s.N, n_begin + chunk);
+    size_t src_group = s.IC * s.IH * s.IW, diff_group = s.OC * s.S;
+    for (size_t n = n_begin; n < n_end; ++n) {
+        for (size_t g = 0; g < s.G; ++g) {
+            wgrad_im2col(
+                    param.src<float>() + n * param.src_layout.stride[0] +
+                            g * src_group,
+                    col, s);
+            const float* diff = param.diff<float>() + n * param.diff_layout.stride[0] +
+                                g * diff_group;
+            if (s.pack > 1) {
+                for (size_t oc = 0; oc < s.OC; ++oc) {
+                    const float* chan = diff + oc / s.pack * s.S * s.pack + oc % s.pack;
+                    for (size_t i = 0; i < s.S; ++i) {
+                        dmat[oc * s.S + i] = chan[i * s.pack];
+                    }
+                }
+                diff = dmat;
+            }
+            TensorND A{const_cast<float*>(diff), {{s.OC, s.S}, dtype::Float32()}},
+                    B{col, {{s.K, s.S}, dtype::Float32()}},
+                    C{tmp, {{s.OC, s.K}, dtype::Float32()}};
+            get_wgrad_matmul_opr()->exec(
+                    A, B, C,
+                    {static_cast<dt_byte*>(bundle.get(4)), bundle.get_size(4)});
+            float* dst = acc + g * s.OC * s.K;
+            for (size_t i = 0; i < s.OC * s.K; ++i) {
+                dst[i] += tmp[i];
+            }
+        }
+    }
+}
+
+//! sum the accumulators of the tasks into row \p index of (G * OC, K)
+void wgrad_kern_reduce(const WgradParam& param, size_t index) {
+    auto s = get_wgrad_shape(param);
+    size_t nr_tasks = get_wgrad_nr_tasks(param);
+    auto bundle = get_wgrad_task_bundle(param);
+    size_t task_size = bundle.total_size_in_bytes();
+    bool flip = param.filter_meta.should_flip;
+    size_t g = index / s.OC, oc = index % s.OC, P = s.pack;
+    float* grad = param.grad<float>() + g * s.OC * s.K;
+    for (size_t k = 0; k < s.K; ++k) {
+        float sum = 0;
+        for (size_t t = 0; t < nr_tasks; ++t) {
+            bundle.set(static_cast<dt_byte*>(param.workspace_ptr) + t * task_size);
+            sum += static_cast<float*>(bundle.get(3))[index * s.K + k];
+        }
+        size_t ic = k / (s.FH * s.FW), fh = k / s.FW % s.FH, fw = k % s.FW;
+        if (flip) {
+            fh = s.FH - 1 - fh;
+            fw = s.FW - 1 - fw;
+        }
+        //! (oc/P, ic/P, fh, fw, ic%P, oc%P), which is (oc, ic, fh, fw) for NCHW
+        size_t off =
+                (((oc / P * (s.IC / P) + ic / P) * s.FH + fh) * s.FW + fw) * P * P +
+                ic % P * P + oc % P;
+        grad[off] = sum;
+    }
+}
+
+}  // namespace
+
+bool ConvolutionBackwardFilterImpl::AlgoMatrixMul::usable(
+        const NCBKernSizeParam& param) const {
+    using Format = param::Convolution::Format;
+    auto&& fm = param.filter_meta;
+    bool dtype_ok = param.src_layout.dtype.enumv() == DTypeEnum::Float32 &&
+                    param.diff_layout.dtype.enumv() == DTypeEnum::Float32 &&
+                    param.grad_layout.dtype.enumv() == DTypeEnum::Float32;
+    bool layout_ok = param.src_layout.is_contiguous() &&
+                     param.diff_layout.is_contiguous() &&
+                     param.grad_layout.is_contiguous();
+    bool format_ok = false;
+    if (fm.format == Format::NCHW) {
+        format_ok = true;
+    } else if (fm.format == Format::NCHW44 || fm.format == Format::NCHW88) {
+        size_t pack = fm.format == Format::NCHW44 ? 4 : 8;
+        //! the hybrid first layer and the channel wise ones are not supported
+        format_ok = fm.group == 1 && param.src_layout.ndim == 5 &&
+                    fm.icpg % pack == 0 && fm.ocpg % pack == 0;
+    }
+    return dtype_ok && layout_ok && format_ok && fm.spatial_ndim == 2;
+}
+
+size_t ConvolutionBackwardFilterImpl::AlgoMatrixMul::get_workspace(
+        const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(
+            megdnn_fallback_wgrad, midout_iv("AlgoMatrixMul::get_workspace"_hash)) {
+        return get_wgrad_task_bundle(param).total_size_in_bytes() *
+               get_wgrad_nr_tasks(param);
+    }
+    MIDOUT_END();
+    return 0;
+}
+
+SmallVector<ConvolutionBackwardFilterImpl::NCBKern> ConvolutionBackwardFilterImpl::
+        AlgoMatrixMul::dispatch_kerns(const NCBKernSizeParam& param) const {
+    MIDOUT_BEGIN(megdnn_fallback_wgrad, midout_iv("AlgoMatrixMul::dispatch"_hash)) {
+        auto accumulate = [](const NCBKernParam& p, size_t index, size_t) {
+            wgrad_kern_accumulate(p, index);
+        };
+        auto reduce = [](const NCBKernParam& p, size_t index, size_t) {
+            wgrad_kern_reduce(p, index);
+        };
+        auto&& fm = param.filter_meta;
+        return {{accumulate, get_wgrad_nr_tasks(param)},
+                {reduce, fm.group * fm.ocpg}};
+    }
+    MIDOUT_END();
+    return {};
+}
+
 // vim: syntax=cpp.doxygen
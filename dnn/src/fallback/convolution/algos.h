@@ -194,6 +194,7 @@ public:
     ncb_kern_t dispatch_kern(
             ConvolutionBackwardDataImpl*, const NCBKernSizeParam&) const override;
     bool is_preferred(const NCBKernSizeParam& param) const override;
+    bool is_batch_parallel() const override { return true; }
     AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
     MEGDNN_DECL_ALGO_TYPE(FB_MATMUL)
 };
@@ -208,10 +209,29 @@ public:
     ncb_kern_t dispatch_kern(
             ConvolutionBackwardDataImpl*, const NCBKernSizeParam&) const override;
     bool is_preferred(const NCBKernSizeParam& param) const override;
+    bool is_batch_parallel() const override { return true; }
     AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
     MEGDNN_DECL_ALGO_TYPE(FB_MATMUL_NCHW44)
 };
 
+////////////////////////// convolutionbackwardfilter //////////////////////
+/*!
+ * \brief im2col + matmul for float32 NCHW, NCHW44 and NCHW88
+ *
+ * The batch is split among the threads, each accumulating the grad of its
+ * part into its own buffer, and the buffers are summed in a fixed order at
+ * last, so the result does not depend on the scheduling.
+ */
+class ConvolutionBackwardFilterImpl::AlgoMatrixMul final : public AlgoBase {
+public:
+    const char* name() const override { return "WgradMatmul"; }
+    bool usable(const NCBKernSizeParam& param) const override;
+    size_t get_workspace(const NCBKernSizeParam& param) const override;
+    SmallVector<NCBKern> dispatch_kerns(const NCBKernSizeParam& param) const override;
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    MEGDNN_DECL_ALGO_TYPE(FB_MATMUL)
+};
+
 }  // namespace fallback
 }  // namespace megdnn
 
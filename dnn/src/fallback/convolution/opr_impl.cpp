@@ -133,7 +133,7 @@ size_t ConvolutionImpl::get_workspace_in_bytes(
     AlgorithmCache::Key key{this->handle(), this->get_opr_type(),
                             layouts.data(), layouts.size(),
                             &this->param(), sizeof(this->param())};
-    auto rst = AlgorithmCache::instance().get(key);
+    auto rst = AlgorithmCache::instance().get(key, this->algo_cache_last_entry());
     if (rst.policy.algo.valid()) {
         return rst.workspace;
     }
@@ -486,7 +486,7 @@ size_t ConvolutionBackwardDataImpl::get_workspace_in_bytes(
     AlgorithmCache::Key key{this->handle(), this->get_opr_type(),
                             layouts.data(), layouts.size(),
                             &this->param(), sizeof(this->param())};
-    auto rst = AlgorithmCache::instance().get(key);
+    auto rst = AlgorithmCache::instance().get(key, this->algo_cache_last_entry());
     if (rst.policy.algo.valid()) {
         return rst.workspace;
     }
@@ -619,7 +619,31 @@ void ConvolutionBackwardDataImpl::exec_with_ncb_kern(const NCBKernParam& param)
     p1g.filter_meta.group = 1;
     auto&& algo = get_algorithm(p1g);
     auto kptr = ncb_1g_dispatch_kern(algo, p1g);
-    if (group == 1 || static_cast<AlgoBase*>(algo)->is_naive()) {
+    if (is_batch_parallel(algo)) {
+        //! each task runs the kern on a chunk of the samples of a group, with
+        //! the workspace of the thread it runs on
+        auto&& fm = p1g.filter_meta;
+        size_t N = p1g.n, nr_chunks = get_nr_batch_chunks(p1g.n, group),
+               chunk = div_ceil(N, nr_chunks);
+        size_t ws = ncb_1g_get_workspace(algo, p1g);
+        ptrdiff_t fstrd = fm.icpg * fm.ocpg * fm.spatial[0] * fm.spatial[1] *
+                          p1g.filter_type.size(),
+                  istrd = fm.ocpg * p1g.isz[0] * p1g.isz[1] * p1g.diff_type.size(),
+                  ostrd = fm.icpg * p1g.osz[0] * p1g.osz[1] * p1g.grad_type.size();
+        p1g.diff_extra_mem_size = p1g.filter_extra_mem_size =
+                p1g.grad_extra_mem_size = 0;
+        auto run = [=](size_t index, size_t thread_id) {
+            auto p = p1g;
+            size_t g = index / nr_chunks, n0 = index % nr_chunks * chunk;
+            p.n = std::min(chunk, N - n0);
+            p.diff_ptr += g * istrd + n0 * p.inp_bs * p.diff_type.size();
+            p.filter_ptr += g * fstrd;
+            p.grad_ptr += g * ostrd + n0 * p.out_bs * p.grad_type.size();
+            p.workspace_ptr = static_cast<dt_byte*>(p.workspace_ptr) + ws * thread_id;
+            kptr(p);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, group * nr_chunks);
+    } else if (group == 1 || static_cast<AlgoBase*>(algo)->is_naive()) {
         auto run = [kptr, param]() { kptr(param); };
         static_cast<naive::HandleImpl*>(handle())->dispatch_kern(run);
     } else {
@@ -669,14 +693,32 @@ void ConvolutionBackwardDataImpl::exec_with_ncb_kern(const NCBKernParam& param)
 
 size_t ConvolutionBackwardDataImpl::get_workspace_with_ncb(
         const NCBKernSizeParam& param) {
-    if (param.filter_meta.group != 1) {
-        auto p1g = param;
-        p1g.filter_meta.group = 1;
-        auto algo = get_algorithm(p1g);
-        return ncb_1g_get_workspace(algo, p1g);
+    auto p1g = param;
+    p1g.filter_meta.group = 1;
+    auto algo = get_algorithm(p1g);
+    size_t ws = ncb_1g_get_workspace(algo, p1g);
+    if (is_batch_parallel(algo)) {
+        size_t nr_threads = static_cast<naive::HandleImpl*>(handle())
+                                    ->megcore_dispatcher()
+                                    ->nr_threads();
+        return ws * nr_threads;
     }
-    auto algo = get_algorithm(param);
-    return ncb_1g_get_workspace(algo, param);
+    return ws;
+}
+
+bool ConvolutionBackwardDataImpl::is_batch_parallel(Algorithm* algo) {
+    return algo->handle_type() != Handle::HandleType::NAIVE &&
+           static_cast<AlgoBase*>(algo)->is_batch_parallel();
+}
+
+size_t ConvolutionBackwardDataImpl::get_nr_batch_chunks(size_t n, size_t group) {
+    size_t nr_threads = static_cast<naive::HandleImpl*>(handle())
+                                ->megcore_dispatcher()
+                                ->nr_threads();
+    size_t nr_chunks = std::max<size_t>(1, std::min(n, div_ceil(nr_threads, group)));
+    //! drop the chunks left empty by rounding up the chunk size
+    size_t chunk = div_ceil(n, nr_chunks);
+    return chunk ? div_ceil(n, chunk) : 1;
 }
 
 std::vector<ConvolutionBackwardDataImpl::Algorithm*> ConvolutionBackwardDataImpl::
@@ -818,4 +860,168 @@ const char* ConvolutionBackwardDataImpl::get_algorithm_set_name() const {
     return "FALLBACK_CONVOLUTION_BACKWARD_DATA_IMPL0";
 }
 
+/* ===================== ConvolutionBackwardFilter ===================== */
+
+class ConvolutionBackwardFilterImpl::AlgoPack : NonCopyableObj {
+    AlgoMatrixMul algo_matmul;
+    SmallVector<AlgoBase*> m_all_algos;
+    AlgoBase::Mapper m_all_algos_map;
+
+public:
+    AlgoPack() {
+        m_all_algos.emplace_back(&algo_matmul);
+
+        for (auto&& algo : m_all_algos) {
+            m_all_algos_map.emplace(algo->info().desc, algo);
+        }
+    }
+    const SmallVector<AlgoBase*>& all_algos() const { return m_all_algos; }
+    const AlgoBase::Mapper& all_algos_map() const { return m_all_algos_map; }
+};
+
+const ConvolutionBackwardFilterImpl::AlgoPack& ConvolutionBackwardFilterImpl::
+        algo_pack() {
+    static AlgoPack algo_pack;
+    return algo_pack;
+}
+
+ConvolutionBackwardFilterImpl::NCBKernSizeParam ConvolutionBackwardFilterImpl::
+        make_ncb_kern_size_param(
+                const TensorLayout& src, const TensorLayout& diff,
+                const TensorLayout& grad) {
+    size_t nr_threads = static_cast<naive::HandleImpl*>(handle())
+                                ->megcore_dispatcher()
+                                ->nr_threads();
+    return {check_layout_fwd(src, grad, diff), src, diff, grad, nr_threads};
+}
+
+void ConvolutionBackwardFilterImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_in diff, _megdnn_tensor_out grad,
+        _megdnn_workspace workspace) {
+    auto size_param = make_ncb_kern_size_param(src.layout, diff.layout, grad.layout);
+    auto algo = get_algorithm(size_param);
+    if (algo->handle_type() != Handle::HandleType::FALLBACK) {
+        return naive::ConvolutionBackwardFilterImpl::exec(src, diff, grad, workspace);
+    }
+    check_exec(src.layout, diff.layout, grad.layout, workspace.size);
+    NCBKernParam param;
+    static_cast<NCBKernSizeParam&>(param) = size_param;
+    param.src_ptr = src.get_ref_ptr();
+    param.diff_ptr = diff.get_ref_ptr();
+    param.grad_ptr = grad.get_ref_ptr();
+    param.workspace_ptr = workspace.raw_ptr;
+    param.workspace_size = workspace.size;
+    for (auto&& kern : static_cast<AlgoBase*>(algo)->dispatch_kerns(size_param)) {
+        auto run = [param, kern = kern.kern](size_t index, size_t thread_id) {
+            kern(param, index, thread_id);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, kern.nr_tasks);
+    }
+}
+
+size_t ConvolutionBackwardFilterImpl::get_workspace_in_bytes(
+        const TensorLayout& src, const TensorLayout& diff, const TensorLayout& grad) {
+    TensorLayoutArray layouts{src, diff, grad};
+    AlgorithmCache::Key key{this->handle(), this->get_opr_type(),
+                            layouts.data(), layouts.size(),
+                            &this->param(), sizeof(this->param())};
+    auto rst = AlgorithmCache::instance().get(key, this->algo_cache_last_entry());
+    if (rst.policy.algo.valid()) {
+        return rst.workspace;
+    }
+
+    auto size_param = make_ncb_kern_size_param(src, diff, grad);
+    auto algo = get_algorithm(size_param);
+    if (algo->handle_type() == Handle::HandleType::FALLBACK) {
+        return static_cast<AlgoBase*>(algo)->get_workspace(size_param);
+    }
+    return naive::ConvolutionBackwardFilterImpl::get_workspace_in_bytes(
+            src, diff, grad);
+}
+
+std::vector<ConvolutionBackwardFilterImpl::Algorithm*> ConvolutionBackwardFilterImpl::
+        get_all_algorithms(
+                const TensorLayout& src, const TensorLayout& diff,
+                const TensorLayout& grad) {
+    std::vector<Algorithm*> ret;
+    if (param().compute_mode == Param::ComputeMode::DEFAULT) {
+        auto size_param = make_ncb_kern_size_param(src, diff, grad);
+        for (auto&& algo : algo_pack().all_algos()) {
+            if (algo->usable(size_param)) {
+                ret.push_back(algo);
+            }
+        }
+    }
+    ret.push_back(static_cast<naive::HandleImpl*>(handle())
+                          ->default_conv_bwd_filter_algo());
+    return ret;
+}
+
+std::vector<ConvolutionBackwardFilterImpl::Algorithm*> ConvolutionBackwardFilterImpl::
+        get_all_algorithms_safe(
+                const TensorLayout& src, const TensorLayout& diff,
+                const TensorLayout& grad) {
+    auto ret_safe =
+            ConvolutionBackwardFilterImpl::get_all_algorithms(src, diff, grad);
+    megdnn_assert(!ret_safe.empty(), "no usable conv bwd filter algorithm");
+    return ret_safe;
+}
+
+ConvolutionBackwardFilterImpl::Algorithm* ConvolutionBackwardFilterImpl::
+        get_algorithm_heuristic(
+                const TensorLayout& src, const TensorLayout& diff,
+                const TensorLayout& grad, size_t workspace_limit_in_bytes,
+                const AlgoAttribute& positive_attr,
+                const AlgoAttribute& negative_attr) {
+    auto size_param = make_ncb_kern_size_param(src, diff, grad);
+    for (auto algo : get_all_algorithms(src, diff, grad)) {
+        if (algo->handle_type() != Handle::HandleType::FALLBACK) {
+            continue;
+        }
+        if (static_cast<AlgoBase*>(algo)->get_workspace(size_param) <=
+                    workspace_limit_in_bytes &&
+            algo->contain_attribute_all(positive_attr) &&
+            !algo->contain_attribute_any(negative_attr)) {
+            return algo;
+        }
+    }
+    return naive::ConvolutionBackwardFilterImpl::get_algorithm_heuristic(
+            src, diff, grad, workspace_limit_in_bytes, positive_attr, negative_attr);
+}
+
+ConvolutionBackwardFilterImpl::Algorithm* ConvolutionBackwardFilterImpl::
+        get_algorithm_from_desc(const AlgorithmDesc& desc) {
+    if (!desc.valid()) {
+        return nullptr;
+    }
+    switch (desc.handle_type) {
+        case Handle::HandleType::FALLBACK: {
+            const auto& map = algo_pack().all_algos_map();
+            megdnn_assert(map.find(desc) != map.end());
+            return map.at(desc);
+        }
+        case Handle::HandleType::NAIVE:
+            return naive::ConvolutionBackwardFilterImpl::get_algorithm_from_desc(desc);
+        default:
+            megdnn_throw("Unknown handle type");
+            return nullptr;
+    }
+}
+
+ConvolutionBackwardFilterImpl::Algorithm* ConvolutionBackwardFilterImpl::
+        get_algorithm(const NCBKernSizeParam& param) {
+    if (auto algo = get_algorithm_from_desc(execution_policy().algo)) {
+        return algo;
+    }
+    return get_algorithm_heuristic(
+            param.src_layout, param.diff_layout, param.grad_layout,
+            std::numeric_limits<size_t>::max(), AlgoAttribute::DEFAULT,
+            AlgoAttribute::DEFAULT);
+}
+
+const char* ConvolutionBackwardFilterImpl::get_algorithm_set_name() const {
+    // fallback version 0
+    return "FALLBACK_CONVOLUTION_BACKWARD_FILTER_IMPL0";
+}
+
 // vim: syntax=cpp.doxygen
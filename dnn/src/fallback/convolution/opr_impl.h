@@ -398,7 +398,8 @@ protected:
             ARM_COMMON_DIRECT_STRD1_DOT_INT8X8X32 = 1 << 8,
             ARM_COMMON_DIRECT_STRD2_DOT_INT8X8X32,
             ARM_COMMON_DIRECT_STRD1_DOT_QU8,
-            ARM_COMMON_DIRECT_STRD2_DOT_QU8
+            ARM_COMMON_DIRECT_STRD2_DOT_QU8,
+            ARM_COMMON_DIRECT_NCHW44_F32
 #endif
         };
 
@@ -421,6 +422,12 @@ protected:
         virtual bool is_preferred(const NCBKernSizeParam&) const { return false; }
         //! if the algo is naive, it will not split by group
         virtual bool is_naive() const { return false; }
+        /*!
+         * whether the kern can run on any sub range of the batch, so that
+         * the groups and the batch are split among the threads, each with
+         * its own workspace
+         */
+        virtual bool is_batch_parallel() const { return false; }
         using Mapper = std::unordered_map<AlgorithmDesc, AlgoBase*>;
     };
 
@@ -470,6 +477,12 @@ private:
     //! get algorithm set by user or by heuristic
     Algorithm* get_algorithm(const NCBKernSizeParam& param);
 
+    //! whether \p algo runs on chunks of the batch in parallel
+    static bool is_batch_parallel(Algorithm* algo);
+
+    //! number of chunks the batch of \p n samples is split into per group
+    size_t get_nr_batch_chunks(size_t n, size_t group);
+
     NCBKernSizeParam make_ncb_kern_size_param(
             const TensorLayout& filter, const TensorLayout& diff,
             const TensorLayout& grad);
@@ -490,6 +503,110 @@ public:
     static const AlgoPack& algo_pack();
 };
 
+/*!
+ * \brief fallback convolution backward filter impl
+ *
+ * The fallback algos are listed before the naive one, so that the heuristic
+ * prefers them and fastrun can profile all of them.
+ */
+class ConvolutionBackwardFilterImpl : public naive::ConvolutionBackwardFilterImpl {
+public:
+    using naive::ConvolutionBackwardFilterImpl::ConvolutionBackwardFilterImpl;
+
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in diff, _megdnn_tensor_out grad,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& diff,
+            const TensorLayout& grad) override;
+    std::vector<Algorithm*> get_all_algorithms(
+            const TensorLayout& src, const TensorLayout& diff,
+            const TensorLayout& grad) override;
+    std::vector<Algorithm*> get_all_algorithms_safe(
+            const TensorLayout& src, const TensorLayout& diff,
+            const TensorLayout& grad) override;
+    Algorithm* get_algorithm_heuristic(
+            const TensorLayout& src, const TensorLayout& diff, const TensorLayout& grad,
+            size_t workspace_limit_in_bytes, const AlgoAttribute& positive_attr,
+            const AlgoAttribute& negative_attr) override;
+    const char* get_algorithm_set_name() const override;
+
+    struct NCBKernSizeParam {
+        CanonizedFilterMeta filter_meta;
+        TensorLayout src_layout, diff_layout, grad_layout;
+        size_t nr_threads;
+    };
+
+    struct NCBKernParam : public NCBKernSizeParam {
+        RefPtr src_ptr;
+        RefPtr diff_ptr;
+        RefPtr grad_ptr;
+        void* workspace_ptr;
+        size_t workspace_size;
+
+        template <typename T>
+        const T* src() const {
+            src_layout.dtype.assert_is_compatible_ctype<T>();
+            return static_cast<const T*>(src_ptr.get_ptr());
+        }
+
+        template <typename T>
+        const T* diff() const {
+            diff_layout.dtype.assert_is_compatible_ctype<T>();
+            return static_cast<const T*>(diff_ptr.get_ptr());
+        }
+
+        template <typename T>
+        T* grad() const {
+            grad_layout.dtype.assert_is_compatible_ctype<T>();
+            return static_cast<T*>(grad_ptr.get_ptr());
+        }
+    };
+
+    //! kern(param, index, thread_id) with index in [0, nr_tasks)
+    using ncb_kern_t = thin_function<void(const NCBKernParam&, size_t, size_t)>;
+    struct NCBKern {
+        ncb_kern_t kern;
+        size_t nr_tasks;
+    };
+
+protected:
+    class AlgoBase : public Algorithm {
+    protected:
+        ~AlgoBase() = default;
+
+    public:
+        AlgoBase() : Algorithm() { m_handle_type = Handle::HandleType::FALLBACK; }
+        enum class AlgoType : uint32_t {
+            //! fallback
+            FB_MATMUL = 1 << 0,
+        };
+
+        virtual bool usable(const NCBKernSizeParam& param) const = 0;
+        virtual size_t get_workspace(const NCBKernSizeParam& param) const = 0;
+        //! the kerns are run one after another
+        virtual SmallVector<NCBKern> dispatch_kerns(
+                const NCBKernSizeParam& param) const = 0;
+        using Mapper = std::unordered_map<AlgorithmDesc, AlgoBase*>;
+    };
+
+    Algorithm* get_algorithm_from_desc(const AlgorithmDesc& desc) override;
+
+private:
+    NCBKernSizeParam make_ncb_kern_size_param(
+            const TensorLayout& src, const TensorLayout& diff,
+            const TensorLayout& grad);
+
+    //! get algorithm set by user or by heuristic
+    Algorithm* get_algorithm(const NCBKernSizeParam& param);
+
+    class AlgoMatrixMul;
+    class AlgoPack;
+
+public:
+    static const AlgoPack& algo_pack();
+};
+
 }  // namespace fallback
 }  // namespace megdnn
 
@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "megdnn/dtype.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+static inline size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+//! a task copies at least so many bytes, to amortize the dispatch overhead
+constexpr size_t COPY_TASK_MIN_BYTES = 32 * 1024;
+
+/*!
+ * \brief copy a small block with a copy of constant size
+ *
+ * Copies of the inner blocks of concat and split are often a few elements
+ * (e.g. a channel in NCHW44), where a memcpy call costs more than the copy;
+ * constant sizes are inlined and vectorized by the compiler.
+ */
+static inline void copy_bytes(void* dst, const void* src, size_t size) {
+    switch (size) {
+#define cb(_size)                            \
+    case _size:                              \
+        std::memcpy(dst, src, _size);        \
+        return;
+        cb(1) cb(2) cb(4) cb(8) cb(12) cb(16) cb(32) cb(64)
+#undef cb
+        default:
+            std::memcpy(dst, src, size);
+    }
+}
+
+/*!
+ * \brief number of tasks to split nr_units units of total_bytes into
+ *
+ * Each task copies at least COPY_TASK_MIN_BYTES, and there are at most 4 tasks
+ * for each thread to balance the load.
+ */
+static inline size_t get_nr_copy_tasks(
+        size_t nr_units, size_t total_bytes, size_t nr_threads) {
+    size_t nr_tasks = std::min(
+            total_bytes / COPY_TASK_MIN_BYTES, std::max<size_t>(nr_threads, 1) * 4);
+    return std::max<size_t>(std::min(nr_tasks, nr_units), 1);
+}
+
+/*!
+ * \brief tile (m, n) bytes to (m, n * times), or repeat them to (m * times, n)
+ *
+ * Only rows [row_begin, row_end) are processed, so that the rows can be
+ * distributed to threads.
+ */
+static inline void tile_or_repeat_rows(
+        const dt_byte* __restrict src, dt_byte* __restrict dst, size_t n,
+        size_t times, size_t row_begin, size_t row_end) {
+    src += row_begin * n;
+    dst += row_begin * n * times;
+    for (size_t i = row_begin; i < row_end; ++i) {
+        copy_bytes(dst, src, n);
+        size_t k = 1u;
+        while (k * 2 <= times) {
+            std::memcpy(dst + k * n, dst, k * n);
+            k *= 2;
+        }
+        if (k < times) {
+            std::memcpy(dst + k * n, dst, (times - k) * n);
+        }
+        src += n;
+        dst += n * times;
+    }
+}
+
+/*!
+ * \brief input and output of the step-th of nr_steps single axis tile/repeat
+ *
+ * The intermediate results are in workspace0 and workspace1 in turn, and the
+ * last step writes to dst.
+ */
+static inline std::pair<const dt_byte*, dt_byte*> tile_repeat_step_buffers(
+        const dt_byte* src, dt_byte* dst, dt_byte* workspace0, dt_byte* workspace1,
+        size_t step, size_t nr_steps) {
+    auto output = [=](size_t s) {
+        return s + 1 == nr_steps ? dst : (s % 2 ? workspace1 : workspace0);
+    };
+    return {step ? output(step - 1) : src, output(step)};
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,62 @@
+#include "src/fallback/cpu_dispatch.h"
+
+#include <cstring>
+#include "megdnn/common.h"
+
+using namespace megdnn;
+using namespace fallback;
+
+namespace {
+
+struct LevelName {
+    CpuIsaLevel level;
+    const char* name;
+};
+
+constexpr LevelName LEVEL_NAMES[] = {
+        {CpuIsaLevel::GENERIC, "generic"},
+        {CpuIsaLevel::X86_SSE4_2, "sse4.2"},
+        {CpuIsaLevel::X86_AVX, "avx"},
+        {CpuIsaLevel::X86_AVX2, "avx2"},
+        {CpuIsaLevel::X86_AVX512, "avx512"},
+        {CpuIsaLevel::ARM_V8_0, "armv8.0"},
+        {CpuIsaLevel::ARM_V8_2_DOTPROD, "dotprod"},
+        {CpuIsaLevel::ARM_V8_6_I8MM, "i8mm"},
+};
+
+}  // anonymous namespace
+
+const char* fallback::cpu_isa_level_name(CpuIsaLevel level) {
+    for (auto&& i : LEVEL_NAMES) {
+        if (i.level == level) {
+            return i.name;
+        }
+    }
+    return "unknown";
+}
+
+CpuIsaLevel fallback::cap_cpu_isa_level(CpuIsaLevel detected) {
+    const char* env = MGB_GETENV("MEGDNN_CPU_ISA_LEVEL");
+    if (!env) {
+        return detected;
+    }
+    for (auto&& i : LEVEL_NAMES) {
+        if (!strcmp(env, i.name)) {
+            bool same_arch = (static_cast<uint32_t>(i.level) >> 8) ==
+                             (static_cast<uint32_t>(detected) >> 8);
+            if (i.level == CpuIsaLevel::GENERIC ||
+                (same_arch && i.level < detected)) {
+                megdnn_log(
+                        "cpu isa level is capped from %s to %s by "
+                        "MEGDNN_CPU_ISA_LEVEL",
+                        cpu_isa_level_name(detected), i.name);
+                return i.level;
+            }
+            return detected;
+        }
+    }
+    megdnn_log_warn("unknown MEGDNN_CPU_ISA_LEVEL: %s, ignored", env);
+    return detected;
+}
+
+// vim: syntax=cpp.doxygen
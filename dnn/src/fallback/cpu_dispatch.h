@@ -0,0 +1,83 @@
+#pragma once
+
+#include <initializer_list>
+#include <utility>
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief the instruction set levels which the cpu kernels are specialized for
+ *
+ * The levels of one arch are ordered: a cpu of some level supports all the
+ * lower levels of the same arch. GENERIC is the baseline the library is
+ * compiled for and is usable on every arch.
+ */
+enum class CpuIsaLevel : uint32_t {
+    GENERIC = 0,
+
+    X86_SSE4_2 = 0x100,
+    X86_AVX,
+    //! avx2 together with fma
+    X86_AVX2,
+    X86_AVX512,
+
+    ARM_V8_0 = 0x200,
+    ARM_V8_2_DOTPROD,
+    ARM_V8_6_I8MM,
+};
+
+const char* cpu_isa_level_name(CpuIsaLevel level);
+
+/*!
+ * \brief cap the detected level by the env MEGDNN_CPU_ISA_LEVEL
+ *
+ * The env takes the name of a level of the same arch, such as "avx2" or
+ * "dotprod", so one fat library could be pinned to the kernels of a lower isa,
+ * e.g. to reproduce the results of an older host. An env of another arch or
+ * above the detected level is ignored.
+ */
+CpuIsaLevel cap_cpu_isa_level(CpuIsaLevel detected);
+
+/*!
+ * \brief the versions of a kernel specialized for the cpu isa levels
+ *
+ * The table is usually a static built from the multiversioned kernels, and
+ * the version is chosen by the level of the handle, see
+ * fallback::HandleImpl::cpu_isa_level(). get() returns the version of the
+ * highest level not above the given one, a GENERIC version matches any level.
+ */
+template <typename Fn>
+class KernelTable {
+public:
+    KernelTable(std::initializer_list<std::pair<CpuIsaLevel, Fn>> versions)
+            : m_versions(versions) {}
+
+    Fn get(CpuIsaLevel level) const {
+        const std::pair<CpuIsaLevel, Fn>* best = nullptr;
+        for (auto&& version : m_versions) {
+            bool usable = version.first == CpuIsaLevel::GENERIC ||
+                          (same_arch(version.first, level) && version.first <= level);
+            if (usable && (!best || version.first > best->first)) {
+                best = &version;
+            }
+        }
+        megdnn_assert(
+                best, "no kernel version for cpu isa level %s",
+                cpu_isa_level_name(level));
+        return best->second;
+    }
+
+private:
+    static bool same_arch(CpuIsaLevel a, CpuIsaLevel b) {
+        return (static_cast<uint32_t>(a) >> 8) == (static_cast<uint32_t>(b) >> 8);
+    }
+
+    SmallVector<std::pair<CpuIsaLevel, Fn>> m_versions;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
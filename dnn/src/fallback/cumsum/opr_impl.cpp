@@ -0,0 +1,199 @@
+#include "src/fallback/cumsum/opr_impl.h"
+#include "src/common/reduce_helper.h"
+#include "src/common/utils.h"
+#include "src/fallback/copy_helper.h"
+
+using namespace megdnn;
+using namespace fallback;
+
+namespace {
+
+//! a line is only split into chunks of at least so many elements
+constexpr size_t CHUNK_MIN_LEN = 8192;
+
+//! a task of the C > 1 case adds at least so many elements
+constexpr size_t TASK_MIN_ELEMS = 16384;
+
+//! the index along B of the k-th element in the scan order
+template <bool reverse>
+MEGDNN_FORCE_INLINE size_t scan_idx(size_t k, size_t B) {
+    return reverse ? B - 1 - k : k;
+}
+
+/*!
+ * \brief scan the elements [begin, end) in the scan order of a line of stride 1
+ *
+ * \return the sum of the scanned elements and init
+ */
+template <typename T, bool exclusive, bool reverse>
+T scan_line(
+        const T* __restrict src, T* __restrict dst, size_t B, size_t begin,
+        size_t end, T init) {
+    T sum = init;
+    for (size_t k = begin; k < end; ++k) {
+        size_t b = scan_idx<reverse>(k, B);
+        if (exclusive) {
+            dst[b] = sum;
+            sum += src[b];
+        } else {
+            sum += src[b];
+            dst[b] = sum;
+        }
+    }
+    return sum;
+}
+
+template <typename T>
+T sum_line(const T* __restrict src, size_t begin, size_t end) {
+    T sum = T(0);
+    for (size_t i = begin; i < end; ++i) {
+        sum += src[i];
+    }
+    return sum;
+}
+
+template <typename T>
+void add_rows(
+        const T* __restrict lhs, const T* __restrict rhs, T* __restrict dst,
+        size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = lhs[i] + rhs[i];
+    }
+}
+
+/*!
+ * \brief scan the columns [c_begin, c_end) of a (B, C) block
+ *
+ * Each row of the output is the previous row of the output plus a row of the
+ * input, which is the same summation order as naive.
+ */
+template <typename T, bool exclusive, bool reverse>
+void scan_rows(
+        const T* src, T* dst, size_t B, size_t C, size_t c_begin, size_t c_end) {
+    size_t n = c_end - c_begin;
+    src += c_begin;
+    dst += c_begin;
+    auto row = [&](size_t k) { return scan_idx<reverse>(k, B) * C; };
+    if (exclusive) {
+        std::fill_n(dst + row(0), n, T(0));
+        for (size_t k = 1; k < B; ++k) {
+            add_rows(dst + row(k - 1), src + row(k - 1), dst + row(k), n);
+        }
+    } else {
+        std::copy_n(src + row(0), n, dst + row(0));
+        for (size_t k = 1; k < B; ++k) {
+            add_rows(dst + row(k - 1), src + row(k), dst + row(k), n);
+        }
+    }
+}
+
+}  // anonymous namespace
+
+size_t CumsumForwardImpl::get_nr_chunks(size_t A, size_t B, size_t C) {
+    size_t nr_threads = get_nr_threads(handle());
+    if (C != 1 || A >= nr_threads) {
+        return 1;
+    }
+    return std::max<size_t>(
+            std::min(div_ceil(nr_threads, A), B / CHUNK_MIN_LEN), 1);
+}
+
+size_t CumsumForwardImpl::get_workspace_in_bytes(
+        const TensorLayout& src, const TensorLayout&) {
+    size_t A, B, C;
+    reduce::get_ABC(src, A, B, C, param().axis);
+    size_t nr_chunks = get_nr_chunks(A, B, C);
+    return nr_chunks > 1 ? A * nr_chunks * src.dtype.size() : 0;
+}
+
+template <typename T, bool exclusive, bool reverse>
+void CumsumForwardImpl::exec_internal(
+        const T* src, T* dst, size_t A, size_t B, size_t C, void* workspace) {
+    size_t nr_threads = get_nr_threads(handle());
+    if (C > 1) {
+        size_t nr_c_tasks = std::max<size_t>(
+                std::min(div_ceil(nr_threads, A), B * C / TASK_MIN_ELEMS), 1);
+        size_t c_step = div_ceil(C, nr_c_tasks);
+        nr_c_tasks = div_ceil(C, c_step);
+        auto kern = [=](size_t index, size_t) {
+            size_t a = index / nr_c_tasks, c_begin = index % nr_c_tasks * c_step;
+            scan_rows<T, exclusive, reverse>(
+                    src + a * B * C, dst + a * B * C, B, C, c_begin,
+                    std::min(c_begin + c_step, C));
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, A * nr_c_tasks);
+        return;
+    }
+
+    size_t nr_chunks = get_nr_chunks(A, B, C);
+    if (nr_chunks == 1) {
+        auto kern = [=](size_t a, size_t) {
+            scan_line<T, exclusive, reverse>(src + a * B, dst + a * B, B, 0, B, T(0));
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, A);
+        return;
+    }
+
+    //! the chunks are in the scan order, and the sums of the chunks are turned
+    //! into the sums of the elements before them
+    size_t chunk = div_ceil(B, nr_chunks);
+    T* sums = static_cast<T*>(workspace);
+    auto chunk_range = [=](size_t index, size_t& begin, size_t& end) {
+        begin = std::min(index % nr_chunks * chunk, B);
+        end = std::min(begin + chunk, B);
+    };
+    auto sum_kern = [=](size_t index, size_t) {
+        size_t begin, end;
+        chunk_range(index, begin, end);
+        const T* line = src + index / nr_chunks * B;
+        sums[index] = reverse ? sum_line(line, B - end, B - begin)
+                              : sum_line(line, begin, end);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(sum_kern, A * nr_chunks);
+    auto prefix_kern = [=]() {
+        for (size_t a = 0; a < A; ++a) {
+            T sum = T(0);
+            for (size_t i = a * nr_chunks; i < (a + 1) * nr_chunks; ++i) {
+                T cur = sums[i];
+                sums[i] = sum;
+                sum += cur;
+            }
+        }
+    };
+    MEGDNN_DISPATCH_CPU_KERN_OPR(prefix_kern());
+    auto scan_kern = [=](size_t index, size_t) {
+        size_t begin, end, offset = index / nr_chunks * B;
+        chunk_range(index, begin, end);
+        scan_line<T, exclusive, reverse>(
+                src + offset, dst + offset, B, begin, end, sums[index]);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(scan_kern, A * nr_chunks);
+}
+
+void CumsumForwardImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(src.layout, dst.layout, workspace.size);
+    size_t A, B, C;
+    reduce::get_ABC(src.layout, A, B, C, param().axis);
+    bool exclusive = param().exclusive, reverse = param().reverse;
+#define DISPATCH(exclusive_v, reverse_v)                                         \
+    if (exclusive == exclusive_v && reverse == reverse_v) {                      \
+        exec_internal<ctype, exclusive_v, reverse_v>(                            \
+                src.ptr<ctype>(), dst.ptr<ctype>(), A, B, C, workspace.raw_ptr); \
+        return;                                                                  \
+    }
+#define cb(DType)                                   \
+    if (src.layout.dtype == DType()) {              \
+        using ctype = DTypeTrait<DType>::ctype;     \
+        DISPATCH(true, true)                        \
+        DISPATCH(true, false)                       \
+        DISPATCH(false, true)                       \
+        DISPATCH(false, false)                      \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE(cb)
+#undef cb
+#undef DISPATCH
+    naive::CumsumForwardImpl::exec(src, dst, workspace);
+}
+
+// vim: syntax=cpp.doxygen
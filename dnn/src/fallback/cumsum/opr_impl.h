@@ -0,0 +1,37 @@
+#pragma once
+
+#include "src/naive/cumsum/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief cumsum of the (A, B, C) view in parallel
+ *
+ * When C > 1, the rows of C elements are added one by one in vectorized
+ * loops, and the tasks are split over A and C. When C == 1, each line is
+ * scanned by one task, except that a few long lines are split into chunks,
+ * whose sums are scanned before the chunks are.
+ */
+class CumsumForwardImpl : public naive::CumsumForwardImpl {
+public:
+    using naive::CumsumForwardImpl::CumsumForwardImpl;
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& dst) override;
+
+private:
+    template <typename T, bool exclusive, bool reverse>
+    void exec_internal(
+            const T* src, T* dst, size_t A, size_t B, size_t C, void* workspace);
+
+    //! number of chunks each line is split into, 1 if the lines are not split
+    size_t get_nr_chunks(size_t A, size_t B, size_t C);
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
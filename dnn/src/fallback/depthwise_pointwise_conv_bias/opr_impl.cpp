@@ -0,0 +1,206 @@
+#include "src/fallback/depthwise_pointwise_conv_bias/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/fallback/elemwise/gi_impl/gi_mathfun.h"
+#include "src/naive/handle.h"
+
+#include <algorithm>
+
+namespace megdnn {
+namespace fallback {
+
+namespace {
+
+using NonlineMode = param::DepthwisePointwiseConvBias::NonlineMode;
+
+//! budget of the per thread buffer holding the channel wise output
+constexpr size_t MID_BUFFER_BYTES = 64 * 1024;
+//! output pixels computed together by the 1x1 conv
+constexpr size_t PW_PIXEL_BLOCK = 4;
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+//! output rows of the channel wise conv computed by one task
+size_t get_rows_per_task(size_t C, size_t OH, size_t OW) {
+    size_t row_bytes = C * OW * sizeof(float);
+    return std::min(OH, std::max<size_t>(1, MID_BUFFER_BYTES / row_bytes));
+}
+
+void nonline_inplace(float* ptr, size_t len, NonlineMode mode) {
+    auto run = [=](auto op) {
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            GiStoreFloat32(ptr + i, op(GiLoadFloat32(ptr + i)));
+        }
+        megdnn_assert_internal(i == len);
+    };
+    switch (mode) {
+        case NonlineMode::RELU:
+            run([](GI_FLOAT32_t x) {
+                return GiMaximumFloat32(x, GiBroadcastFloat32(0.f));
+            });
+            break;
+        case NonlineMode::SIGMOID:
+            run([](GI_FLOAT32_t x) { return GiSigmoidPsFloat32(x); });
+            break;
+        case NonlineMode::H_SWISH:
+            run([](GI_FLOAT32_t x) {
+                GI_FLOAT32_t t = GiAddFloat32(x, GiBroadcastFloat32(3.f));
+                t = GiMinimumFloat32(
+                        GiMaximumFloat32(t, GiBroadcastFloat32(0.f)),
+                        GiBroadcastFloat32(6.f));
+                return GiMultiplyScalerFloat32(GiMultiplyFloat32(x, t), 1.f / 6.f);
+            });
+            break;
+        default:
+            break;
+    }
+}
+
+/*!
+ * channel wise conv of one channel block for the output rows [oh_begin,
+ * oh_end) into \p mid of shape (oh_end - oh_begin, OW, 4)
+ */
+void dw_rows(
+        const float* src, const float* filter, const float* bias, float* mid,
+        size_t IH, size_t IW, size_t FH, size_t FW, size_t OW, size_t oh_begin,
+        size_t oh_end, const param::DepthwisePointwiseConvBias& p) {
+    GI_FLOAT32_t vbias = GiLoadFloat32(bias);
+    for (size_t oh = oh_begin; oh < oh_end; ++oh) {
+        float* out = mid + (oh - oh_begin) * OW * 4;
+        for (size_t ow = 0; ow < OW; ++ow) {
+            GiStoreFloat32(out + ow * 4, vbias);
+        }
+        for (size_t fh = 0; fh < FH; ++fh) {
+            int ih = static_cast<int>(oh * p.stride_h + fh) - static_cast<int>(p.pad_h);
+            if (ih < 0 || ih >= static_cast<int>(IH))
+                continue;
+            const float* in = src + ih * IW * 4;
+            for (size_t fw = 0; fw < FW; ++fw) {
+                if (IW + p.pad_w <= fw) {
+                    continue;
+                }
+                GI_FLOAT32_t w = GiLoadFloat32(filter + (fh * FW + fw) * 4);
+                //! the outputs whose input column lies inside the image
+                size_t ow_begin = 0;
+                if (fw < p.pad_w) {
+                    ow_begin = div_ceil<size_t>(p.pad_w - fw, p.stride_w);
+                }
+                size_t ow_end =
+                        std::min(OW, (IW + p.pad_w - fw - 1) / p.stride_w + 1);
+                for (size_t ow = ow_begin; ow < ow_end; ++ow) {
+                    size_t iw = ow * p.stride_w + fw - p.pad_w;
+                    GI_FLOAT32_t acc = GiLoadFloat32(out + ow * 4);
+                    acc = GiMlaqFloat32(acc, GiLoadFloat32(in + iw * 4), w);
+                    GiStoreFloat32(out + ow * 4, acc);
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * 1x1 conv of \p nr_pixels pixels of \p mid, which is (CB, nr_pixels, 4),
+ * into one output channel block
+ */
+void pw_pixels(
+        const float* mid, const float* filter, const float* bias, float* dst,
+        size_t CB, size_t nr_pixels) {
+    GI_FLOAT32_t vbias = GiLoadFloat32(bias);
+    size_t px = 0;
+    for (; px + PW_PIXEL_BLOCK <= nr_pixels; px += PW_PIXEL_BLOCK) {
+        GI_FLOAT32_t acc0 = vbias, acc1 = vbias, acc2 = vbias, acc3 = vbias;
+        for (size_t cb = 0; cb < CB; ++cb) {
+            const float* x = mid + (cb * nr_pixels + px) * 4;
+            const float* w = filter + cb * 16;
+            for (size_t ic = 0; ic < 4; ++ic) {
+                GI_FLOAT32_t wv = GiLoadFloat32(w + ic * 4);
+                acc0 = GiMlaqFloat32(acc0, wv, GiBroadcastFloat32(x[ic]));
+                acc1 = GiMlaqFloat32(acc1, wv, GiBroadcastFloat32(x[4 + ic]));
+                acc2 = GiMlaqFloat32(acc2, wv, GiBroadcastFloat32(x[8 + ic]));
+                acc3 = GiMlaqFloat32(acc3, wv, GiBroadcastFloat32(x[12 + ic]));
+            }
+        }
+        GiStoreFloat32(dst + px * 4, acc0);
+        GiStoreFloat32(dst + px * 4 + 4, acc1);
+        GiStoreFloat32(dst + px * 4 + 8, acc2);
+        GiStoreFloat32(dst + px * 4 + 12, acc3);
+    }
+    for (; px < nr_pixels; ++px) {
+        GI_FLOAT32_t acc = vbias;
+        for (size_t cb = 0; cb < CB; ++cb) {
+            const float* x = mid + (cb * nr_pixels + px) * 4;
+            const float* w = filter + cb * 16;
+            for (size_t ic = 0; ic < 4; ++ic) {
+                acc = GiMlaqFloat32(
+                        acc, GiLoadFloat32(w + ic * 4), GiBroadcastFloat32(x[ic]));
+            }
+        }
+        GiStoreFloat32(dst + px * 4, acc);
+    }
+}
+
+}  // namespace
+
+size_t DepthwisePointwiseConvBiasImpl::get_workspace_in_bytes(
+        const TensorLayout& src, const TensorLayout& dw_filter,
+        const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+        const TensorLayout& pw_bias, const TensorLayout& dst) {
+    MEGDNN_MARK_USED_VAR(dw_filter);
+    MEGDNN_MARK_USED_VAR(dw_bias);
+    MEGDNN_MARK_USED_VAR(pw_filter);
+    MEGDNN_MARK_USED_VAR(pw_bias);
+    size_t C = src[1] * 4, OH = dst[2], OW = dst[3];
+    size_t rows = get_rows_per_task(C, OH, OW);
+    return get_nr_threads(handle()) * C * rows * OW * sizeof(float);
+}
+
+void DepthwisePointwiseConvBiasImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_in dw_filter, _megdnn_tensor_in dw_bias,
+        _megdnn_tensor_in pw_filter, _megdnn_tensor_in pw_bias,
+        _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(
+            src.layout, dw_filter.layout, dw_bias.layout, pw_filter.layout,
+            pw_bias.layout, dst.layout, workspace.size);
+    size_t N = src.layout[0], CB = src.layout[1], IH = src.layout[2],
+           IW = src.layout[3];
+    size_t FH = dw_filter.layout[3], FW = dw_filter.layout[4];
+    size_t OCB = dst.layout[1], OH = dst.layout[2], OW = dst.layout[3];
+    size_t rows = get_rows_per_task(CB * 4, OH, OW);
+    size_t nr_row_blocks = div_ceil(OH, rows);
+    auto p = param();
+    auto sptr = src.ptr<dt_float32>();
+    auto dwf = dw_filter.ptr<dt_float32>();
+    auto dwb = dw_bias.ptr<dt_float32>();
+    auto pwf = pw_filter.ptr<dt_float32>();
+    auto pwb = pw_bias.ptr<dt_float32>();
+    auto dptr = dst.ptr<dt_float32>();
+    auto buf = workspace.ptr<float>();
+    auto run = [=](size_t index, size_t thread_id) {
+        size_t n = index / nr_row_blocks;
+        size_t oh_begin = index % nr_row_blocks * rows;
+        size_t oh_end = std::min(OH, oh_begin + rows);
+        size_t nr_pixels = (oh_end - oh_begin) * OW;
+        float* mid = buf + thread_id * CB * rows * OW * 4;
+        for (size_t cb = 0; cb < CB; ++cb) {
+            float* mid_cb = mid + cb * nr_pixels * 4;
+            dw_rows(sptr + ((n * CB + cb) * IH * IW) * 4, dwf + cb * FH * FW * 4,
+                    dwb + cb * 4, mid_cb, IH, IW, FH, FW, OW, oh_begin, oh_end, p);
+            nonline_inplace(mid_cb, nr_pixels * 4, p.dw_nonline_mode);
+        }
+        for (size_t ocb = 0; ocb < OCB; ++ocb) {
+            float* out = dptr + ((n * OCB + ocb) * OH + oh_begin) * OW * 4;
+            pw_pixels(mid, pwf + ocb * CB * 16, pwb + ocb * 4, out, CB, nr_pixels);
+            nonline_inplace(out, nr_pixels * 4, p.pw_nonline_mode);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, N * nr_row_blocks);
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
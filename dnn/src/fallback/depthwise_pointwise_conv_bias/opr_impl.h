@@ -0,0 +1,33 @@
+#pragma once
+#include "src/naive/depthwise_pointwise_conv_bias/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief fused channel wise and 1x1 conv_bias in NCHW44
+ *
+ * Each task computes the channel wise conv for a block of output rows of all
+ * the channels into a per thread buffer small enough to stay in cache, and
+ * the 1x1 conv reads that buffer back right away. The intermediate tensor is
+ * never written to memory.
+ */
+class DepthwisePointwiseConvBiasImpl : public naive::DepthwisePointwiseConvBiasImpl {
+public:
+    using naive::DepthwisePointwiseConvBiasImpl::DepthwisePointwiseConvBiasImpl;
+
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in dw_filter,
+            _megdnn_tensor_in dw_bias, _megdnn_tensor_in pw_filter,
+            _megdnn_tensor_in pw_bias, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& dw_filter,
+            const TensorLayout& dw_bias, const TensorLayout& pw_filter,
+            const TensorLayout& pw_bias, const TensorLayout& dst) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
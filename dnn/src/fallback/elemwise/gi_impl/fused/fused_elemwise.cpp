@@ -0,0 +1,270 @@
+#include "src/fallback/elemwise/gi_impl/fused/fused_elemwise.h"
+#include "src/fallback/elemwise_helper/elemwise_op.h"
+
+#include "midout.h"
+
+MIDOUT_DECL(megdnn_fallback_fused_elemwise)
+
+using namespace megdnn;
+using namespace fallback;
+using namespace fused_elemwise;
+
+namespace {
+
+using Mode = Elemwise::Mode;
+constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+
+//! the inputs of a row, a scalar input is broadcast to the vector
+template <size_t nr_inputs>
+struct RowInputs {
+    const float* ptr[nr_inputs];
+    bool is_scalar[nr_inputs];
+
+    GI_FLOAT32_V2_t load(size_t i, size_t offset) const {
+        if (is_scalar[i]) {
+            return elemwise::ParamElemVisitorDupV2<dt_float32>()(ptr[i]);
+        }
+        return elemwise::ParamElemVisitorV2<dt_float32>()(
+                ptr[i] + offset, ptr[i] + offset + SIMD_WIDTH);
+    }
+
+    float load_scalar(size_t i, size_t offset) const {
+        return is_scalar[i] ? *ptr[i] : ptr[i][offset];
+    }
+};
+
+/*!
+ * \brief a stage of the chain runs Op on the result of the last stage and
+ *      nr_extra inputs starting from the input I
+ */
+template <typename Op, size_t nr_extra>
+struct Stage;
+
+template <typename Op>
+struct Stage<Op, 0> {
+    static constexpr size_t NR_EXTRA = 0;
+    template <size_t I, typename Inputs, typename T>
+    static T apply(const T& x, const Inputs&, size_t) {
+        return Op()(x);
+    }
+};
+
+template <typename Op>
+struct Stage<Op, 1> {
+    static constexpr size_t NR_EXTRA = 1;
+    template <size_t I, typename Inputs>
+    static GI_FLOAT32_V2_t apply(
+            const GI_FLOAT32_V2_t& x, const Inputs& inputs, size_t offset) {
+        return Op()(x, inputs.load(I, offset));
+    }
+    template <size_t I, typename Inputs>
+    static float apply(float x, const Inputs& inputs, size_t offset) {
+        return Op()(x, inputs.load_scalar(I, offset));
+    }
+};
+
+template <typename Op>
+struct Stage<Op, 2> {
+    static constexpr size_t NR_EXTRA = 2;
+    template <size_t I, typename Inputs>
+    static GI_FLOAT32_V2_t apply(
+            const GI_FLOAT32_V2_t& x, const Inputs& inputs, size_t offset) {
+        return Op()(x, inputs.load(I, offset), inputs.load(I + 1, offset));
+    }
+    template <size_t I, typename Inputs>
+    static float apply(float x, const Inputs& inputs, size_t offset) {
+        return Op()(
+                x, inputs.load_scalar(I, offset), inputs.load_scalar(I + 1, offset));
+    }
+};
+
+template <Mode mode>
+struct ModeStage;
+
+#define cb(_mode, _op, _nr_extra)                          \
+    template <>                                            \
+    struct ModeStage<Mode::_mode> {                        \
+        using type = Stage<_op<dt_float32>, _nr_extra>;    \
+    };
+cb(RELU, ReluOp, 0);
+cb(SIGMOID, SigmoidOp, 0);
+cb(TANH, TanhOp, 0);
+cb(H_SWISH, HSwishOp, 0);
+cb(ADD, AddOp, 1);
+cb(SUB, SubOp, 1);
+cb(MUL, MulOp, 1);
+cb(MAX, MaxOp, 1);
+cb(MIN, MinOp, 1);
+cb(FUSE_ADD_RELU, FuseAddReluOp, 1);
+cb(FUSE_ADD_SIGMOID, FuseAddSigmoidOp, 1);
+cb(FUSE_ADD_TANH, FuseAddTanhOp, 1);
+cb(FUSE_ADD_H_SWISH, FuseAddHSwishOp, 1);
+cb(FUSE_MUL_ADD3, FuseMulAdd3Op, 2);
+#undef cb
+
+//! the stages are expanded at compile time, so the chain stays in registers
+template <size_t I, Mode... modes>
+struct Chain;
+
+template <size_t I>
+struct Chain<I> {
+    static constexpr size_t NR_INPUTS = I;
+    template <typename Inputs, typename T>
+    static T apply(const T& x, const Inputs&, size_t) {
+        return x;
+    }
+};
+
+template <size_t I, Mode mode, Mode... rest>
+struct Chain<I, mode, rest...> {
+    using S = typename ModeStage<mode>::type;
+    using Next = Chain<I + S::NR_EXTRA, rest...>;
+    static constexpr size_t NR_INPUTS = Next::NR_INPUTS;
+    template <typename Inputs, typename T>
+    static T apply(const T& x, const Inputs& inputs, size_t offset) {
+        return Next::apply(S::template apply<I>(x, inputs, offset), inputs, offset);
+    }
+};
+
+template <typename dst_ctype>
+struct Store;
+
+template <>
+struct Store<dt_float32> {
+    explicit Store(DType) {}
+    void operator()(const GI_FLOAT32_V2_t& v, dt_float32* dst) const {
+        GiStoreFloat32(dst, GiGetSubVectorFloat32V2(v, 0));
+        GiStoreFloat32(dst + SIMD_WIDTH, GiGetSubVectorFloat32V2(v, 1));
+    }
+    void operator()(float v, dt_float32* dst) const { *dst = v; }
+};
+
+template <>
+struct Store<dt_qint8> {
+    float scale;
+    GI_FLOAT32_FIXLEN_t vscale;
+
+    explicit Store(DType dtype) {
+        scale = 1.f / dtype.param<dtype::QuantizedS8>().scale;
+        vscale = GiFloat32Type2FixLenType(GiBroadcastFloat32(scale));
+    }
+    void operator()(const GI_FLOAT32_V2_t& v, dt_qint8* dst) const {
+        auto s = GiFixLenType2GiFloat32Type(vscale);
+        GI_FLOAT32_V2_t ret;
+        GiSetSubVectorFloat32V2(
+                ret, 0, GiMultiplyFloat32(GiGetSubVectorFloat32V2(v, 0), s));
+        GiSetSubVectorFloat32V2(
+                ret, 1, GiMultiplyFloat32(GiGetSubVectorFloat32V2(v, 1), s));
+        GiStoreLowInt8(
+                reinterpret_cast<int8_t*>(dst),
+                QConverter::convert<GI_INT8_t, GI_FLOAT32_V2_t>(ret));
+    }
+    void operator()(float v, dt_qint8* dst) const {
+        *dst = QConverter::convert<dt_qint8, float>(v * scale);
+    }
+};
+
+template <typename dst_ctype, Mode... modes>
+void run_chain(const KernParam& param, size_t row_begin, size_t row_end) {
+    using C = Chain<1, modes...>;
+    constexpr size_t nr_inputs = C::NR_INPUTS;
+    megdnn_assert(
+            param.srcs.size() == nr_inputs && param.src_types.size() == nr_inputs &&
+            param.src_types[0] == InputType::VEC);
+    Store<dst_ctype> store(param.dst_dtype);
+    size_t len = param.channel_size;
+    for (size_t row = row_begin; row < row_end; ++row) {
+        RowInputs<nr_inputs> inputs;
+        for (size_t i = 0; i < nr_inputs; ++i) {
+            switch (param.src_types[i]) {
+                case InputType::VEC:
+                    inputs.ptr[i] = param.srcs[i] + row * len;
+                    break;
+                case InputType::SCALAR:
+                    inputs.ptr[i] = param.srcs[i];
+                    break;
+                case InputType::BCAST101:
+                    inputs.ptr[i] = param.srcs[i] + row % param.channel;
+                    break;
+            }
+            inputs.is_scalar[i] = param.src_types[i] != InputType::VEC;
+        }
+        dst_ctype* dst = static_cast<dst_ctype*>(param.dst) + row * len;
+        size_t i = 0;
+        for (; i + 2 * SIMD_WIDTH <= len; i += 2 * SIMD_WIDTH) {
+            auto x = elemwise::ParamElemVisitorV2<dt_float32>()(
+                    inputs.ptr[0] + i, inputs.ptr[0] + i + SIMD_WIDTH);
+            store(C::apply(x, inputs, i), dst + i);
+        }
+        for (; i < len; ++i) {
+            store(C::apply(inputs.ptr[0][i], inputs, i), dst + i);
+        }
+    }
+}
+
+struct KernEntry {
+    SmallVector<Mode> modes;
+    DTypeEnum dst_dtype;
+    Kern kern;
+};
+
+template <Mode... modes>
+void add_chain(std::vector<KernEntry>& table) {
+    table.push_back({{modes...}, DTypeEnum::Float32, run_chain<dt_float32, modes...>});
+    table.push_back(
+            {{modes...}, DTypeEnum::QuantizedS8, run_chain<dt_qint8, modes...>});
+}
+
+const std::vector<KernEntry>& kern_table() {
+    static const std::vector<KernEntry> table = [] {
+        std::vector<KernEntry> ret;
+        //! bias and activation
+        add_chain<Mode::FUSE_ADD_RELU>(ret);
+        add_chain<Mode::FUSE_ADD_SIGMOID>(ret);
+        add_chain<Mode::FUSE_ADD_TANH>(ret);
+        add_chain<Mode::FUSE_ADD_H_SWISH>(ret);
+        add_chain<Mode::ADD, Mode::RELU>(ret);
+        add_chain<Mode::ADD, Mode::SIGMOID>(ret);
+        add_chain<Mode::ADD, Mode::H_SWISH>(ret);
+        //! scale and shift, such as the folded batch normalization
+        add_chain<Mode::FUSE_MUL_ADD3>(ret);
+        add_chain<Mode::FUSE_MUL_ADD3, Mode::RELU>(ret);
+        add_chain<Mode::MUL, Mode::ADD>(ret);
+        add_chain<Mode::MUL, Mode::ADD, Mode::RELU>(ret);
+        add_chain<Mode::ADD, Mode::MUL, Mode::RELU>(ret);
+        //! residual add
+        add_chain<Mode::ADD, Mode::FUSE_ADD_RELU>(ret);
+        add_chain<Mode::ADD, Mode::ADD, Mode::RELU>(ret);
+        //! clip
+        add_chain<Mode::MAX, Mode::MIN>(ret);
+        return ret;
+    }();
+    return table;
+}
+
+}  // anonymous namespace
+
+size_t ChainDesc::nr_inputs() const {
+    size_t ret = 1;
+    for (auto mode : modes) {
+        ret += Elemwise::ModeTrait::from_mode(mode).arity - 1;
+    }
+    return ret;
+}
+
+Kern fused_elemwise::get_kern(const ChainDesc& desc) {
+    MIDOUT_BEGIN(megdnn_fallback_fused_elemwise, midout_iv("get_kern"_hash)) {
+        for (auto&& entry : kern_table()) {
+            if (entry.dst_dtype == desc.dst_dtype.enumv() &&
+                entry.modes.size() == desc.modes.size() &&
+                std::equal(
+                        entry.modes.begin(), entry.modes.end(), desc.modes.begin())) {
+                return entry.kern;
+            }
+        }
+    }
+    MIDOUT_END();
+    return nullptr;
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "megdnn/oprs/general.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace fallback {
+namespace fused_elemwise {
+
+/*!
+ * \brief a chain of elemwise modes, which is run in one pass over memory
+ *
+ * The chain starts from the first input, and every mode takes the result of
+ * the last one as its first operand and its other operands from the following
+ * inputs in order, e.g. ADD, MUL, RELU of inputs (x, b, s) computes
+ * relu((x + b) * s). The result is stored in float32 or converted to the
+ * QuantizedS8 dst dtype, so the typecvt of the chain is fused as well.
+ */
+struct ChainDesc {
+    SmallVector<Elemwise::Mode> modes;
+    DType dst_dtype;
+
+    //! number of inputs the chain takes
+    size_t nr_inputs() const;
+};
+
+//! how an input is read with the shape {batch, channel, channel_size} of the
+//! first input
+enum class InputType {
+    VEC,
+    SCALAR,
+    //! one element of each channel
+    BCAST101,
+};
+
+struct KernParam {
+    //! all the inputs are float32, the first one must be VEC
+    SmallVector<const float*> srcs;
+    SmallVector<InputType> src_types;
+    void* dst;
+    DType dst_dtype;
+    size_t batch, channel, channel_size;
+
+    //! the rows of channel_size elements, which are the unit of the kernel
+    size_t nr_rows() const { return batch * channel; }
+};
+
+//! run the rows in [row_begin, row_end)
+using Kern = void (*)(const KernParam& param, size_t row_begin, size_t row_end);
+
+/*!
+ * \brief get the kernel of a chain, or nullptr if the chain is not one of the
+ *      chains instantiated in the library
+ *
+ * The library covers the chains left by gopt around conv and matmul, such as
+ * bias-add followed by activations, scale and shift, residual add and their
+ * QuantizedS8 outputs.
+ */
+Kern get_kern(const ChainDesc& desc);
+
+}  // namespace fused_elemwise
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,180 @@
+#include "src/fallback/fused_preprocess/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/fallback/general_intrinsic/gi_float.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+namespace {
+
+using Coord = FusedPreprocess::Coord;
+
+constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+//! output rows computed by one task
+constexpr size_t ROW_BLOCK = 16;
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+//! the coordinates of rows and columns and two interpolated rows per thread
+WorkspaceBundle get_bundle(Handle* handle, size_t C, size_t OH, size_t OW) {
+    size_t row_bytes = round_up<size_t>(C, 4) * OW * sizeof(float);
+    return {nullptr,
+            {(OH + OW) * sizeof(Coord), get_nr_threads(handle) * 2 * row_bytes}};
+}
+
+struct Image {
+    const uint8_t* ptr;
+    size_t IW, C;
+    bool reverse, nchw44;
+};
+
+/*!
+ * interpolate source row \p ih along the width into \p dst, which is (C, OW)
+ * for NCHW and (OW, 4) with the padded channels zero for NCHW44
+ */
+void interpolate_row(
+        const Image& img, int ih, const Coord* wc, size_t OW, float* dst) {
+    const uint8_t* row = img.ptr + ih * img.IW * img.C;
+    size_t C = img.C;
+    for (size_t ow = 0; ow < OW; ++ow) {
+        const uint8_t* p0 = row + wc[ow].idx0 * C;
+        const uint8_t* p1 = row + wc[ow].idx1 * C;
+        float a1 = wc[ow].alpha, a0 = 1.f - a1;
+        for (size_t oc = 0; oc < C; ++oc) {
+            size_t ic = img.reverse ? C - 1 - oc : oc;
+            float val = p0[ic] * a0 + p1[ic] * a1;
+            if (img.nchw44) {
+                dst[ow * 4 + oc] = val;
+            } else {
+                dst[oc * OW + ow] = val;
+            }
+        }
+        if (img.nchw44) {
+            for (size_t oc = C; oc < 4; ++oc) {
+                dst[ow * 4 + oc] = 0.f;
+            }
+        }
+    }
+}
+
+//! dst = r0 * w0 + r1 * w1 + bias
+GI_FORCEINLINE void blend(
+        const float* r0, const float* r1, const GI_FLOAT32_t& w0,
+        const GI_FLOAT32_t& w1, const GI_FLOAT32_t& bias, float* dst) {
+    GI_FLOAT32_t val = GiMlaqFloat32(bias, GiLoadFloat32(r0), w0);
+    GiStoreFloat32(dst, GiMlaqFloat32(val, GiLoadFloat32(r1), w1));
+}
+
+void blend_nchw(
+        const float* r0, const float* r1, float w0, float w1, float bias, size_t OW,
+        float* dst) {
+    GI_FLOAT32_t vw0 = GiBroadcastFloat32(w0), vw1 = GiBroadcastFloat32(w1),
+                 vbias = GiBroadcastFloat32(bias);
+    size_t ow = 0;
+    for (; ow + SIMD_STEP <= OW; ow += SIMD_STEP) {
+        blend(r0 + ow, r1 + ow, vw0, vw1, vbias, dst + ow);
+    }
+    for (; ow < OW; ++ow) {
+        dst[ow] = r0[ow] * w0 + r1[ow] * w1 + bias;
+    }
+}
+
+void blend_nchw44(
+        const float* r0, const float* r1, const float* w0, const float* w1,
+        const float* bias, size_t OW, float* dst) {
+    GI_FLOAT32_t vw0 = GiLoadFloat32(w0), vw1 = GiLoadFloat32(w1),
+                 vbias = GiLoadFloat32(bias);
+    for (size_t ow = 0; ow < OW; ++ow) {
+        blend(r0 + ow * 4, r1 + ow * 4, vw0, vw1, vbias, dst + ow * 4);
+    }
+}
+
+}  // namespace
+
+size_t FusedPreprocessImpl::get_workspace_in_bytes(
+        const TensorLayout& src, const TensorLayout&, const TensorLayout&) {
+    return get_bundle(handle(), src[3], param().out_h, param().out_w)
+            .total_size_in_bytes();
+}
+
+void FusedPreprocessImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_in norm, _megdnn_tensor_out dst,
+        _megdnn_workspace workspace) {
+    check_exec(src.layout, norm.layout, dst.layout, workspace.size);
+    size_t N = src.layout[0], IH = src.layout[1], IW = src.layout[2],
+           C = src.layout[3];
+    size_t OH = param().out_h, OW = param().out_w;
+    size_t C4 = round_up<size_t>(C, 4);
+    bool nchw44 = param().format == Param::Format::NCHW44;
+    auto bundle = get_bundle(handle(), C, OH, OW);
+    bundle.set(workspace.raw_ptr);
+    auto hc = static_cast<Coord*>(bundle.get(0));
+    auto wc = hc + OH;
+    //! the workspace is only valid when the kernels run
+    auto fill_coords = [=]() {
+        get_coords(IH, OH, hc);
+        get_coords(IW, OW, wc);
+    };
+    MEGDNN_DISPATCH_CPU_KERN_OPR(fill_coords());
+    Image img{
+            src.ptr<dt_uint8>(), IW, C,
+            param().color_mode == Param::ColorMode::REVERSE, nchw44};
+    auto mean = norm.ptr<dt_float32>();
+    auto scale = mean + C;
+    auto dptr = dst.ptr<dt_float32>();
+    auto rows = static_cast<float*>(bundle.get(1));
+    size_t nr_row_blocks = div_ceil(OH, ROW_BLOCK);
+    auto run = [=](size_t index, size_t thread_id) {
+        size_t n = index / nr_row_blocks;
+        size_t oh_begin = index % nr_row_blocks * ROW_BLOCK;
+        size_t oh_end = std::min(OH, oh_begin + ROW_BLOCK);
+        Image cur = img;
+        cur.ptr += n * IH * IW * C;
+        float* row_buf[2] = {
+                rows + thread_id * 2 * C4 * OW, rows + (thread_id * 2 + 1) * C4 * OW};
+        int row_id[2] = {-1, -1};
+        //! the buffer of source row \p ih, never evicting source row \p keep
+        auto get_row = [&](int ih, int keep) -> const float* {
+            for (int i = 0; i < 2; ++i) {
+                if (row_id[i] == ih) {
+                    return row_buf[i];
+                }
+            }
+            int slot = row_id[0] == keep ? 1 : 0;
+            interpolate_row(cur, ih, wc, OW, row_buf[slot]);
+            row_id[slot] = ih;
+            return row_buf[slot];
+        };
+        float w0[4] = {0}, w1[4] = {0}, bias[4] = {0};
+        for (size_t oh = oh_begin; oh < oh_end; ++oh) {
+            const Coord& h = hc[oh];
+            const float* r0 = get_row(h.idx0, h.idx1);
+            const float* r1 = get_row(h.idx1, h.idx0);
+            for (size_t oc = 0; oc < C; ++oc) {
+                w0[oc % 4] = (1.f - h.alpha) * scale[oc];
+                w1[oc % 4] = h.alpha * scale[oc];
+                bias[oc % 4] = -mean[oc] * scale[oc];
+                if (!nchw44) {
+                    blend_nchw(
+                            r0 + oc * OW, r1 + oc * OW, w0[oc], w1[oc], bias[oc], OW,
+                            dptr + ((n * C + oc) * OH + oh) * OW);
+                }
+            }
+            if (nchw44) {
+                //! c is at most 4, so there is a single channel block
+                blend_nchw44(r0, r1, w0, w1, bias, OW, dptr + (n * OH + oh) * OW * 4);
+            }
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, N * nr_row_blocks);
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
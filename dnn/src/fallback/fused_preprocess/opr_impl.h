@@ -0,0 +1,30 @@
+#pragma once
+#include "src/naive/fused_preprocess/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief fused preprocess computed row by row
+ *
+ * Every output row needs at most two source rows. They are horizontally
+ * interpolated once into float rows of reordered channels, kept while the
+ * following output rows still use them, and blended vertically with the
+ * normalization folded into the two weights.
+ */
+class FusedPreprocessImpl : public naive::FusedPreprocessImpl {
+public:
+    using naive::FusedPreprocessImpl::FusedPreprocessImpl;
+
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in norm, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& norm,
+            const TensorLayout& dst) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -19,6 +19,9 @@
 
 #if defined(__riscv_vector)
 #include <riscv_vector.h>
+#if defined(__riscv_v_intrinsic) && __riscv_v_intrinsic >= 11000
+#include "gi_rvv_v1.h"
+#endif
 #endif
 
 #if defined(__x86_64__) || defined(__i386__) || defined(_M_IX86) || defined(_M_X64)
@@ -325,8 +328,8 @@ typedef vint16m1x2_t GI_INT16_V2_t;
 typedef vint8m1x2_t GI_INT8_V2_t;
 typedef vint8m1x3_t GI_INT8_V3_t;
 typedef vint8m1x4_t GI_INT8_V4_t;
-//! vfloat32mf2_t usable at RVV1.0, now we support 0.7, as
-//! a workaround, we use vfloat32m1_t instead
+//! vfloat32mf2_t is only usable at RVV1.0, to share the code with 0.7, we use
+//! vfloat32m1_t instead
 typedef vfloat32m1_t float32x2_t;
 
 #else
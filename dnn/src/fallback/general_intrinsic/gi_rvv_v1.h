@@ -0,0 +1,204 @@
+#pragma once
+
+//! RVV 1.0 toolchains (gcc >= 13, clang >= 17) ship the v0.11+ intrinsic api,
+//! where every intrinsic is prefixed by __riscv_, the destination operand of
+//! reductions and slidedown is dropped, vmerge takes the mask last and segment
+//! stores take a tuple. GI is written against the previous api, which
+//! is what the RVV 0.7 toolchains provide, so map the intrinsics used by GI to
+//! the new names here instead of duplicating every RVV path.
+
+#define vadd_vv_i16m1              __riscv_vadd_vv_i16m1
+#define vadd_vv_i32m1              __riscv_vadd_vv_i32m1
+#define vadd_vv_i8m1               __riscv_vadd_vv_i8m1
+#define vadd_vv_u32m1              __riscv_vadd_vv_u32m1
+#define vand_vv_i16m1              __riscv_vand_vv_i16m1
+#define vand_vv_i32m1              __riscv_vand_vv_i32m1
+#define vand_vv_i8m1               __riscv_vand_vv_i8m1
+#define vcreate_f32m1x2            __riscv_vcreate_v_f32m1x2
+#define vcreate_f32m1x3            __riscv_vcreate_v_f32m1x3
+#define vfabs_v_f32m1              __riscv_vfabs_v_f32m1
+#define vfadd_vv_f16m1             __riscv_vfadd_vv_f16m1
+#define vfadd_vv_f32m1             __riscv_vfadd_vv_f32m1
+#define vfcvt_f_x_v_f32m1          __riscv_vfcvt_f_x_v_f32m1
+#define vfcvt_rtz_x_f_v_i32m1      __riscv_vfcvt_rtz_x_f_v_i32m1
+#define vfcvt_x_f_v_i32m1          __riscv_vfcvt_x_f_v_i32m1
+#define vfdiv_vv_f32m1             __riscv_vfdiv_vv_f32m1
+#define vfmadd_vf_f16m1            __riscv_vfmadd_vf_f16m1
+#define vfmadd_vf_f32m1            __riscv_vfmadd_vf_f32m1
+#define vfmadd_vv_f16m1            __riscv_vfmadd_vv_f16m1
+#define vfmadd_vv_f32m1            __riscv_vfmadd_vv_f32m1
+#define vfmax_vv_f16m1             __riscv_vfmax_vv_f16m1
+#define vfmax_vv_f32m1             __riscv_vfmax_vv_f32m1
+#define vfmin_vv_f16m1             __riscv_vfmin_vv_f16m1
+#define vfmin_vv_f32m1             __riscv_vfmin_vv_f32m1
+#define vfmul_vf_f16m1             __riscv_vfmul_vf_f16m1
+#define vfmul_vf_f32m1             __riscv_vfmul_vf_f32m1
+#define vfmul_vv_f16m1             __riscv_vfmul_vv_f16m1
+#define vfmul_vv_f32m1             __riscv_vfmul_vv_f32m1
+#define vfmv_v_f_f16m1             __riscv_vfmv_v_f_f16m1
+#define vfmv_v_f_f32m1             __riscv_vfmv_v_f_f32m1
+#define vfmv_v_f_f32m2             __riscv_vfmv_v_f_f32m2
+#define vfncvt_f_f_w_f16m1         __riscv_vfncvt_f_f_w_f16m1
+#define vfneg_v_f32m1              __riscv_vfneg_v_f32m1
+#define vfnmsub_vf_f16m1           __riscv_vfnmsub_vf_f16m1
+#define vfnmsub_vf_f32m1           __riscv_vfnmsub_vf_f32m1
+#define vfnmsub_vv_f32m1           __riscv_vfnmsub_vv_f32m1
+#define vfsub_vv_f16m1             __riscv_vfsub_vv_f16m1
+#define vfsub_vv_f32m1             __riscv_vfsub_vv_f32m1
+#define vfwcvt_f_f_v_f32m2         __riscv_vfwcvt_f_f_v_f32m2
+#define vget_f16m1x2_f16m1         __riscv_vget_v_f16m1x2_f16m1
+#define vget_f32m1x2_f32m1         __riscv_vget_v_f32m1x2_f32m1
+#define vget_f32m1x3_f32m1         __riscv_vget_v_f32m1x3_f32m1
+#define vget_f32m1x4_f32m1         __riscv_vget_v_f32m1x4_f32m1
+#define vget_i16m1x2_i16m1         __riscv_vget_v_i16m1x2_i16m1
+#define vget_i32m1x2_i32m1         __riscv_vget_v_i32m1x2_i32m1
+#define vget_i32m1x4_i32m1         __riscv_vget_v_i32m1x4_i32m1
+#define vget_i8m1x2_i8m1           __riscv_vget_v_i8m1x2_i8m1
+#define vget_i8m1x3_i8m1           __riscv_vget_v_i8m1x3_i8m1
+#define vget_i8m1x4_i8m1           __riscv_vget_v_i8m1x4_i8m1
+#define vget_v_f32m2_f32m1         __riscv_vget_v_f32m2_f32m1
+#define vget_v_f32m4_f32m1         __riscv_vget_v_f32m4_f32m1
+#define vget_v_i16m2_i16m1         __riscv_vget_v_i16m2_i16m1
+#define vget_v_i32m2_i32m1         __riscv_vget_v_i32m2_i32m1
+#define vget_v_u16m2_u16m1         __riscv_vget_v_u16m2_u16m1
+#define vle16_v_f16m1              __riscv_vle16_v_f16m1
+#define vle16_v_i16m1              __riscv_vle16_v_i16m1
+#define vle16_v_u16m1              __riscv_vle16_v_u16m1
+#define vle32_v_f32m1              __riscv_vle32_v_f32m1
+#define vle32_v_i32m1              __riscv_vle32_v_i32m1
+#define vle32_v_u32m1              __riscv_vle32_v_u32m1
+#define vle32_v_u32m2              __riscv_vle32_v_u32m2
+#define vle32_v_u32m4              __riscv_vle32_v_u32m4
+#define vle8_v_i8m1                __riscv_vle8_v_i8m1
+#define vle8_v_u8m1                __riscv_vle8_v_u8m1
+#define vlse8_v_u8m1               __riscv_vlse8_v_u8m1
+#define vlseg2e32_v_f32m1x2        __riscv_vlseg2e32_v_f32m1x2
+#define vlseg2e8_v_i8m1x2          __riscv_vlseg2e8_v_i8m1x2
+#define vlseg3e32_v_f32m1x3        __riscv_vlseg3e32_v_f32m1x3
+#define vlseg3e8_v_i8m1x3          __riscv_vlseg3e8_v_i8m1x3
+#define vlseg4e32_v_f32m1x4        __riscv_vlseg4e32_v_f32m1x4
+#define vlseg4e8_v_i8m1x4          __riscv_vlseg4e8_v_i8m1x4
+#define vmadd_vv_i32m1             __riscv_vmadd_vv_i32m1
+#define vmadd_vv_i8m1              __riscv_vmadd_vv_i8m1
+#define vmax_vv_i32m1              __riscv_vmax_vv_i32m1
+#define vmax_vv_i8m1               __riscv_vmax_vv_i8m1
+#define vmfgt_vv_f32m1_b32         __riscv_vmfgt_vv_f32m1_b32
+#define vmfle_vv_f32m1_b32         __riscv_vmfle_vv_f32m1_b32
+#define vmflt_vv_f32m1_b32         __riscv_vmflt_vv_f32m1_b32
+#define vmin_vv_i32m1              __riscv_vmin_vv_i32m1
+#define vmin_vv_i8m1               __riscv_vmin_vv_i8m1
+#define vmsgt_vv_i16m1_b16         __riscv_vmsgt_vv_i16m1_b16
+#define vmsgt_vv_i16m2_b8          __riscv_vmsgt_vv_i16m2_b8
+#define vmsgt_vv_i32m1_b32         __riscv_vmsgt_vv_i32m1_b32
+#define vmsgt_vv_i32m2_b16         __riscv_vmsgt_vv_i32m2_b16
+#define vmsgt_vv_i32m4_b8          __riscv_vmsgt_vv_i32m4_b8
+#define vmsgt_vv_i8m1_b8           __riscv_vmsgt_vv_i8m1_b8
+#define vmslt_vv_i16m2_b8          __riscv_vmslt_vv_i16m2_b8
+#define vmslt_vv_i32m2_b16         __riscv_vmslt_vv_i32m2_b16
+#define vmslt_vv_i32m4_b8          __riscv_vmslt_vv_i32m4_b8
+#define vmul_vv_i32m1              __riscv_vmul_vv_i32m1
+#define vmul_vv_i8m1               __riscv_vmul_vv_i8m1
+#define vmv_v_v_f32m1              __riscv_vmv_v_v_f32m1
+#define vmv_v_x_i16m1              __riscv_vmv_v_x_i16m1
+#define vmv_v_x_i16m2              __riscv_vmv_v_x_i16m2
+#define vmv_v_x_i32m1              __riscv_vmv_v_x_i32m1
+#define vmv_v_x_i32m2              __riscv_vmv_v_x_i32m2
+#define vmv_v_x_i32m4              __riscv_vmv_v_x_i32m4
+#define vmv_v_x_i8m1               __riscv_vmv_v_x_i8m1
+#define vmv_v_x_u32m1              __riscv_vmv_v_x_u32m1
+#define vncvt_x_x_w_i16m1          __riscv_vncvt_x_x_w_i16m1
+#define vncvt_x_x_w_i16m2          __riscv_vncvt_x_x_w_i16m2
+#define vncvt_x_x_w_i8m1           __riscv_vncvt_x_x_w_i8m1
+#define vncvt_x_x_w_u8m1           __riscv_vncvt_x_x_w_u8m1
+#define vneg_v_i32m1               __riscv_vneg_v_i32m1
+#define vneg_v_i8m1                __riscv_vneg_v_i8m1
+#define vneg_v_u32m1               __riscv_vneg_v_u32m1
+#define vnot_v_i32m1               __riscv_vnot_v_i32m1
+#define vnot_v_i8m1                __riscv_vnot_v_i8m1
+#define vor_vv_i32m1               __riscv_vor_vv_i32m1
+#define vor_vv_i8m1                __riscv_vor_vv_i8m1
+#define vreinterpret_v_f32m1_i32m1 __riscv_vreinterpret_v_f32m1_i32m1
+#define vreinterpret_v_f32m1_u32m1 __riscv_vreinterpret_v_f32m1_u32m1
+#define vreinterpret_v_i16m1_i32m1 __riscv_vreinterpret_v_i16m1_i32m1
+#define vreinterpret_v_i16m2_u16m2 __riscv_vreinterpret_v_i16m2_u16m2
+#define vreinterpret_v_i32m1_f32m1 __riscv_vreinterpret_v_i32m1_f32m1
+#define vreinterpret_v_i32m1_i8m1  __riscv_vreinterpret_v_i32m1_i8m1
+#define vreinterpret_v_i8m1_i16m1  __riscv_vreinterpret_v_i8m1_i16m1
+#define vreinterpret_v_i8m1_i32m1  __riscv_vreinterpret_v_i8m1_i32m1
+#define vreinterpret_v_i8m1_u8m1   __riscv_vreinterpret_v_i8m1_u8m1
+#define vreinterpret_v_u16m1_i16m1 __riscv_vreinterpret_v_u16m1_i16m1
+#define vreinterpret_v_u32m1_f32m1 __riscv_vreinterpret_v_u32m1_f32m1
+#define vrgather_vv_f32m2          __riscv_vrgather_vv_f32m2
+#define vrgather_vv_f32m4          __riscv_vrgather_vv_f32m4
+#define vrgather_vv_i16m1          __riscv_vrgather_vv_i16m1
+#define vrgather_vv_i32m1          __riscv_vrgather_vv_i32m1
+#define vrgather_vv_i8m1           __riscv_vrgather_vv_i8m1
+#define vrgather_vv_u8m1           __riscv_vrgather_vv_u8m1
+#define vse16_v_f16m1              __riscv_vse16_v_f16m1
+#define vse16_v_i16m1              __riscv_vse16_v_i16m1
+#define vse32_v_f32m1              __riscv_vse32_v_f32m1
+#define vse32_v_i32m1              __riscv_vse32_v_i32m1
+#define vse32_v_u32m1              __riscv_vse32_v_u32m1
+#define vse8_v_i8m1                __riscv_vse8_v_i8m1
+#define vse8_v_u8m1                __riscv_vse8_v_u8m1
+#define vset_f16m1x2               __riscv_vset_v_f16m1_f16m1x2
+#define vset_f32m1x2               __riscv_vset_v_f32m1_f32m1x2
+#define vset_f32m1x3               __riscv_vset_v_f32m1_f32m1x3
+#define vset_f32m1x4               __riscv_vset_v_f32m1_f32m1x4
+#define vset_i16m1x2               __riscv_vset_v_i16m1_i16m1x2
+#define vset_i32m1x2               __riscv_vset_v_i32m1_i32m1x2
+#define vset_i32m1x4               __riscv_vset_v_i32m1_i32m1x4
+#define vset_i8m1x2                __riscv_vset_v_i8m1_i8m1x2
+#define vset_v_f32m1_f32m2         __riscv_vset_v_f32m1_f32m2
+#define vset_v_f32m1_f32m4         __riscv_vset_v_f32m1_f32m4
+#define vset_v_i16m1_i16m2         __riscv_vset_v_i16m1_i16m2
+#define vset_v_i32m1_i32m2         __riscv_vset_v_i32m1_i32m2
+#define vset_v_i32m1_i32m4         __riscv_vset_v_i32m1_i32m4
+#define vslideup_vx_i16m1          __riscv_vslideup_vx_i16m1
+#define vslideup_vx_i32m1          __riscv_vslideup_vx_i32m1
+#define vslideup_vx_u8m1           __riscv_vslideup_vx_u8m1
+#define vsll_vx_i32m1              __riscv_vsll_vx_i32m1
+#define vsra_vx_i16m1              __riscv_vsra_vx_i16m1
+#define vsra_vx_i32m1              __riscv_vsra_vx_i32m1
+#define vsra_vx_i8m1               __riscv_vsra_vx_i8m1
+#define vsse8_v_u8m1               __riscv_vsse8_v_u8m1
+#define vsub_vv_i16m1              __riscv_vsub_vv_i16m1
+#define vsub_vv_i32m1              __riscv_vsub_vv_i32m1
+#define vsub_vv_i8m1               __riscv_vsub_vv_i8m1
+#define vsub_vv_u32m1              __riscv_vsub_vv_u32m1
+#define vundefined_f32m1           __riscv_vundefined_f32m1
+#define vundefined_f32m2           __riscv_vundefined_f32m2
+#define vundefined_f32m4           __riscv_vundefined_f32m4
+#define vundefined_i16m1           __riscv_vundefined_i16m1
+#define vundefined_i32m2           __riscv_vundefined_i32m2
+#define vundefined_i32m4           __riscv_vundefined_i32m4
+#define vundefined_i8m1            __riscv_vundefined_i8m1
+#define vundefined_u16m1           __riscv_vundefined_u16m1
+#define vundefined_u32m1           __riscv_vundefined_u32m1
+#define vundefined_u8m1            __riscv_vundefined_u8m1
+#define vwcvt_x_x_v_i16m2          __riscv_vwcvt_x_x_v_i16m2
+#define vwcvt_x_x_v_i32m2          __riscv_vwcvt_x_x_v_i32m2
+#define vwcvtu_x_x_v_u16m2         __riscv_vwcvtu_x_x_v_u16m2
+#define vxor_vv_i16m1              __riscv_vxor_vv_i16m1
+#define vxor_vv_i32m1              __riscv_vxor_vv_i32m1
+#define vxor_vv_i8m1               __riscv_vxor_vv_i8m1
+#define vxor_vv_u32m1              __riscv_vxor_vv_u32m1
+
+#define vfredosum_vs_f32m1_f32m1(dest, vector, scalar, vl) \
+    __riscv_vfredosum_vs_f32m1_f32m1(vector, scalar, vl)
+#define vmerge_vvm_i16m1(mask, a, b, vl) __riscv_vmerge_vvm_i16m1(a, b, mask, vl)
+#define vmerge_vvm_i16m2(mask, a, b, vl) __riscv_vmerge_vvm_i16m2(a, b, mask, vl)
+#define vmerge_vvm_i32m1(mask, a, b, vl) __riscv_vmerge_vvm_i32m1(a, b, mask, vl)
+#define vmerge_vvm_i32m2(mask, a, b, vl) __riscv_vmerge_vvm_i32m2(a, b, mask, vl)
+#define vmerge_vvm_i32m4(mask, a, b, vl) __riscv_vmerge_vvm_i32m4(a, b, mask, vl)
+#define vmerge_vvm_i8m1(mask, a, b, vl) __riscv_vmerge_vvm_i8m1(a, b, mask, vl)
+#define vredmax_vs_i8m1_i8m1(dest, vector, scalar, vl) \
+    __riscv_vredmax_vs_i8m1_i8m1(vector, scalar, vl)
+#define vredmin_vs_i8m1_i8m1(dest, vector, scalar, vl) \
+    __riscv_vredmin_vs_i8m1_i8m1(vector, scalar, vl)
+#define vslidedown_vx_i32m1(dest, src, offset, vl) \
+    __riscv_vslidedown_vx_i32m1(src, offset, vl)
+#define vsseg3e8_v_i8m1(base, v0, v1, v2, vl) \
+    __riscv_vsseg3e8_v_i8m1x3(base, __riscv_vcreate_v_i8m1x3(v0, v1, v2), vl)
+#define vwredsum_vs_i8m1_i16m1(dest, vector, scalar, vl) \
+    __riscv_vwredsum_vs_i8m1_i16m1(vector, scalar, vl)
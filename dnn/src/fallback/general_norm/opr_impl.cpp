@@ -0,0 +1,85 @@
+#include "src/fallback/general_norm/opr_impl.h"
+#include <algorithm>
+#include "src/common/reduce_helper.h"
+#include "src/common/utils.h"
+#include "src/fallback/norm_helper.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+void GeneralNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+        _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+        _megdnn_workspace workspace) {
+    if (data.layout.dtype.enumv() != DTypeEnum::Float32) {
+        naive::GeneralNormForwardImpl::exec(
+                data, weight, bias, dst, mean, rstd, workspace);
+        return;
+    }
+    check_exec(
+            data.layout, weight.layout, bias.layout, dst.layout, mean.layout,
+            rstd.layout, workspace.size);
+
+    auto p = param();
+    size_t A, B, C;
+    reduce::get_ABC(data.layout, A, B, C, p.axis_start, p.axis_end);
+    if (!A || !B || !C) {
+        return;
+    }
+    float eps = p.eps;
+    bool rms = p.mode == Param::Mode::RMS_NORM;
+    const float* sptr = data.ptr<dt_float32>();
+    const float* wptr = p.affine ? weight.ptr<dt_float32>() : nullptr;
+    const float* bptr = p.affine ? bias.ptr<dt_float32>() : nullptr;
+    float* dptr = dst.ptr<dt_float32>();
+    float* mptr = mean.ptr<dt_float32>();
+    float* rptr = rstd.ptr<dt_float32>();
+    auto handle = static_cast<naive::HandleImpl*>(this->handle());
+
+    if (C == 1) {
+        //! every slice is a contiguous row and the affine is elementwise over it
+        size_t rows_per_task = std::max<size_t>(norm::NORM_TASK_ELEMS / B, 1);
+        auto kern = [=](size_t task_id, size_t) {
+            size_t begin = task_id * rows_per_task,
+                   end = std::min(A, begin + rows_per_task);
+            for (size_t a = begin; a < end; ++a) {
+                float m = 0.f, var;
+                if (rms) {
+                    var = norm::row_mean_square(sptr + a * B, B);
+                } else {
+                    norm::row_moments(sptr + a * B, B, m, var);
+                }
+                float r = 1.f / std::sqrt(var + eps);
+                norm::normalize_row(sptr + a * B, dptr + a * B, B, m, r, wptr, bptr);
+                mptr[a] = m;
+                rptr[a] = r;
+            }
+        };
+        handle->dispatch_kern(kern, div_ceil(A, rows_per_task));
+        return;
+    }
+
+    //! the slices are columns of [B, C] blocks, tasks take tiles of columns
+    size_t cols = round_up(
+            std::max<size_t>(norm::NORM_TASK_ELEMS / B, 1), norm::SIMD_WIDTH);
+    size_t nr_col_tasks = div_ceil(C, cols);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t a = task_id / nr_col_tasks, c0 = task_id % nr_col_tasks * cols,
+               c1 = std::min(C, c0 + cols);
+        float* m = mptr + a * C;
+        float* r = rptr + a * C;
+        norm::column_moments(sptr + a * B * C, B, C, c0, c1, rms, m, r);
+        for (size_t c = c0; c < c1; ++c) {
+            r[c] = 1.f / std::sqrt(r[c] + eps);
+        }
+        norm::normalize_columns(
+                sptr + a * B * C, dptr + a * B * C, B, C, c0, c1, m, r, wptr, bptr);
+    };
+    handle->dispatch_kern(kern, A * nr_col_tasks);
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
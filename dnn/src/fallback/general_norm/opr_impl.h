@@ -0,0 +1,19 @@
+#pragma once
+#include "src/naive/general_norm/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+class GeneralNormForwardImpl : public naive::GeneralNormForwardImpl {
+public:
+    using naive::GeneralNormForwardImpl::GeneralNormForwardImpl;
+    void exec(
+            _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+            _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+            _megdnn_workspace workspace) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,74 @@
+#include "src/fallback/group_norm/opr_impl.h"
+#include <algorithm>
+#include "src/common/utils.h"
+#include "src/fallback/norm_helper.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+void GroupNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+        _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+        _megdnn_workspace workspace) {
+    if (data.layout.dtype.enumv() != DTypeEnum::Float32) {
+        naive::GroupNormForwardImpl::exec(
+                data, weight, bias, dst, mean, rstd, workspace);
+        return;
+    }
+    check_exec(
+            data.layout, weight.layout, bias.layout, dst.layout, mean.layout,
+            rstd.layout, workspace.size);
+
+    auto p = param();
+    size_t N = data.layout.shape[0], C = data.layout.shape[1];
+    size_t HxW = data.layout.shape[2] * data.layout.shape[3];
+    size_t G = p.group, D = C / G, inner_size = D * HxW;
+    if (!N || !inner_size) {
+        return;
+    }
+    float eps = p.eps;
+    bool affine = p.affine;
+    const float* sptr = data.ptr<dt_float32>();
+    const float* wptr = affine ? weight.ptr<dt_float32>() : nullptr;
+    const float* bptr = affine ? bias.ptr<dt_float32>() : nullptr;
+    float* dptr = dst.ptr<dt_float32>();
+    float* mptr = mean.ptr<dt_float32>();
+    float* vptr = rstd.ptr<dt_float32>();
+
+    size_t groups = N * G;
+    size_t groups_per_task = std::max<size_t>(norm::NORM_TASK_ELEMS / inner_size, 1);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t begin = task_id * groups_per_task,
+               end = std::min(groups, begin + groups_per_task);
+        for (size_t i = begin; i < end; ++i) {
+            const float* srow = sptr + i * inner_size;
+            float* drow = dptr + i * inner_size;
+            float m, var;
+            norm::row_moments(srow, inner_size, m, var);
+            float r = 1.f / std::sqrt(var + eps);
+            if (affine) {
+                //! the affine is per channel, fold it into one scale and shift
+                size_t c0 = i % G * D;
+                for (size_t j = 0; j < D; ++j) {
+                    float scale = r * wptr[c0 + j];
+                    norm::scale_shift_row(
+                            srow + j * HxW, drow + j * HxW, HxW, scale,
+                            bptr[c0 + j] - scale * m);
+                }
+            } else {
+                norm::scale_shift_row(srow, drow, inner_size, r, -m * r);
+            }
+            mptr[i] = m;
+            //! same as naive, the second output of group norm keeps the variance
+            vptr[i] = var;
+        }
+    };
+    static_cast<naive::HandleImpl*>(handle())->dispatch_kern(
+            kern, div_ceil(groups, groups_per_task));
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
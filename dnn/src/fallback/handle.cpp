@@ -2,17 +2,25 @@
 #include "src/common/handle_impl.h"
 
 #include "src/fallback/add_update/opr_impl.h"
+#include "src/fallback/argsort/opr_impl.h"
 #include "src/fallback/batched_matrix_mul/opr_impl.h"
 #include "src/fallback/concat/opr_impl.h"
 #include "src/fallback/conv_bias/opr_impl.h"
 #include "src/fallback/convolution/opr_impl.h"
+#include "src/fallback/cumsum/opr_impl.h"
+#include "src/fallback/depthwise_pointwise_conv_bias/opr_impl.h"
 #include "src/fallback/elemwise/opr_impl.h"
 #include "src/fallback/elemwise_multi_type/opr_impl.h"
 #include "src/fallback/flip/opr_impl.h"
+#include "src/fallback/fused_preprocess/opr_impl.h"
 #include "src/fallback/gaussian_blur/opr_impl.h"
+#include "src/fallback/general_norm/opr_impl.h"
 #include "src/fallback/group_local/opr_impl.h"
+#include "src/fallback/group_norm/opr_impl.h"
+#include "src/fallback/layer_norm/opr_impl.h"
 #include "src/fallback/mask_conv/opr_impl.h"
 #include "src/fallback/matrix_mul/opr_impl.h"
+#include "src/fallback/multi_head_attn/opr_impl.h"
 #include "src/fallback/pooling/opr_impl.h"
 #include "src/fallback/powc/opr_impl.h"
 #include "src/fallback/reduce/opr_impl.h"
@@ -23,9 +31,12 @@
 #include "src/fallback/rotate/opr_impl.h"
 #include "src/fallback/softmax/opr_impl.h"
 #include "src/fallback/split/opr_impl.h"
+#include "src/fallback/structured_sparse_matrix_mul/opr_impl.h"
 #include "src/fallback/tile/opr_impl.h"
+#include "src/fallback/topk/opr_impl.h"
 #include "src/fallback/type_cvt/opr_impl.h"
 #include "src/fallback/warp_perspective/opr_impl.h"
+#include "src/fallback/weight_only_quant_matrix_mul/opr_impl.h"
 
 namespace megdnn {
 namespace fallback {
@@ -37,6 +48,7 @@ std::unique_ptr<Opr> HandleImpl::create_operator() {
 
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Convolution)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ConvolutionBackwardData)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(ConvolutionBackwardFilter)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Elemwise)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Pooling)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Reduce)
@@ -61,6 +73,17 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(Resize)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(BatchedMatrixMulForward)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ConvBias)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(PowC)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(MultiHeadAttnForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(WeightOnlyQuantMatrixMul)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(DepthwisePointwiseConvBias)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(StructuredSparseMatrixMul)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(FusedPreprocess)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(LayerNormForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(GroupNormForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(GeneralNormForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(TopK)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(ArgsortForward)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(CumsumForward)
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpragmas"
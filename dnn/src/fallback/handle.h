@@ -1,5 +1,6 @@
 #pragma once
 #include "src/common/utils.h"
+#include "src/fallback/cpu_dispatch.h"
 #include "src/naive/handle.h"
 
 #include <mutex>
@@ -21,8 +22,27 @@ public:
     Relayout* relayout_opr() override final {
         return get_helper_opr<Relayout, 3>(this);
     }
+
+    //! the isa level to choose the kernel versions from the KernelTable with,
+    //! decided when the handle is created
+    CpuIsaLevel cpu_isa_level() const { return m_cpu_isa_level; }
+
+protected:
+    //! set by the handle of each arch with the level detected from
+    //! CPUID/HWCAP, which is capped by the env MEGDNN_CPU_ISA_LEVEL
+    void init_cpu_isa_level(CpuIsaLevel detected) {
+        m_cpu_isa_level = cap_cpu_isa_level(detected);
+    }
+
+private:
+    CpuIsaLevel m_cpu_isa_level = CpuIsaLevel::GENERIC;
 };
 
+//! the isa level of the handle of a cpu operator
+inline CpuIsaLevel cpu_isa_level(Handle* handle) {
+    return static_cast<HandleImpl*>(handle)->cpu_isa_level();
+}
+
 }  // namespace fallback
 }  // namespace megdnn
 
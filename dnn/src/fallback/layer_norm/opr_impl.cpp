@@ -0,0 +1,57 @@
+#include "src/fallback/layer_norm/opr_impl.h"
+#include <algorithm>
+#include "src/common/utils.h"
+#include "src/fallback/norm_helper.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+void LayerNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in weight, _megdnn_tensor_in bias,
+        _megdnn_tensor_out dst, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+        _megdnn_workspace workspace) {
+    if (data.layout.dtype.enumv() != DTypeEnum::Float32) {
+        naive::LayerNormForwardImpl::exec(
+                data, weight, bias, dst, mean, rstd, workspace);
+        return;
+    }
+    check_exec(
+            data.layout, weight.layout, bias.layout, dst.layout, mean.layout,
+            rstd.layout, workspace.size);
+
+    auto p = param();
+    size_t len = p.normalized_size;
+    size_t rows = len ? data.layout.total_nr_elems() / len : 0;
+    if (!rows) {
+        return;
+    }
+    float eps = p.eps;
+    const float* sptr = data.ptr<dt_float32>();
+    const float* wptr = p.affine ? weight.ptr<dt_float32>() : nullptr;
+    const float* bptr = p.affine ? bias.ptr<dt_float32>() : nullptr;
+    float* dptr = dst.ptr<dt_float32>();
+    float* mptr = mean.ptr<dt_float32>();
+    float* rptr = rstd.ptr<dt_float32>();
+
+    size_t rows_per_task = std::max<size_t>(norm::NORM_TASK_ELEMS / len, 1);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t begin = task_id * rows_per_task,
+               end = std::min(rows, begin + rows_per_task);
+        for (size_t i = begin; i < end; ++i) {
+            float m, var;
+            norm::row_moments(sptr + i * len, len, m, var);
+            float r = 1.f / std::sqrt(var + eps);
+            norm::normalize_row(sptr + i * len, dptr + i * len, len, m, r, wptr, bptr);
+            mptr[i] = m;
+            rptr[i] = r;
+        }
+    };
+    static_cast<naive::HandleImpl*>(handle())->dispatch_kern(
+            kern, div_ceil(rows, rows_per_task));
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -120,6 +120,9 @@ public:
             X86_F32_6x16,
             X86_INT8X8X32_VNNI,
             X86_INT8X8X32_MKLDNN,
+            X86_F32_AVX512_12X32,
+            X86_INT8X8X32_AMX_32X32X64,
+            X86_F16_F16C_6X16,
 #elif MEGDNN_AARCH64 || MEGDNN_ARMV7
             ARM_COMMON_INT8X8X16 = 1 << 8,
             ARM_COMMON_INT8X8X32_GEMV,
@@ -154,6 +157,11 @@ public:
             AARCH64_QUINT8_GEMV_DOTPROD,
             AARCH64_QUINT8_K8X8X8,
             AARCH64_INT4X4X16_K8X8X8,
+            AARCH64_INT8X8X32_K8X12X8_MMLA,
+            AARCH64_BF16_K8X12X4_MMLA,
+            AARCH64_F32_SVE,
+            AARCH64_INT8X8X32_SVE,
+            AARCH64_INT4X4X32_K8X12X4_DOTPROD,
 #else
             ARMV7_F32 = 1 << 16,
             ARMV7_F32_MK4_PACK_4X12,
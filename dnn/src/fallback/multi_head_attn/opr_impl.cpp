@@ -0,0 +1,377 @@
+#include "src/fallback/multi_head_attn/opr_impl.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "src/fallback/softmax/softmax_kern.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+using namespace multi_head_attn;
+
+namespace {
+
+//! query rows sharing one key/value block, keep the block hot in cache
+constexpr size_t ROW_BLOCK = 8;
+//! keys scored at once before the running softmax state is updated
+constexpr size_t KEY_BLOCK = 64;
+constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+
+struct AttnShape {
+    size_t batch, seq_q, seq_k, heads;
+    size_t qproj, kproj, vproj, oproj;
+    //! per head feature size of q/k and v, z is all heads of v concatenated
+    size_t khead, vhead, zdim;
+    size_t wq_off = 0, wk_off = 0, wv_off = 0, wo_off = 0;
+    size_t bq_off = 0, bk_off = 0, bv_off = 0, bo_off = 0;
+};
+
+//! same packing of qkvo_weight_bias as MHAForwardProxyBase::layout_refill
+AttnShape get_attn_shape(
+        const Param& p, const TensorLayout& queries, const TensorLayout& keys) {
+    AttnShape s;
+    s.batch = queries[0];
+    s.seq_q = queries[1];
+    s.seq_k = keys[1];
+    s.heads = p.num_heads;
+    s.qproj = p.qproj_size;
+    s.kproj = p.kproj_size;
+    s.vproj = p.vproj_size;
+    s.oproj = p.oproj_size;
+    s.khead = s.kproj ? s.kproj / s.heads : p.k_size;
+    s.vhead = s.vproj ? s.vproj / s.heads : p.v_size;
+    s.zdim = s.vhead * s.heads;
+
+    size_t end = 0;
+    if (s.qproj) {
+        s.wq_off = end;
+        end += p.embeding_size * s.qproj;
+    }
+    if (s.kproj) {
+        s.wk_off = end;
+        end += p.k_size * s.kproj;
+    }
+    if (s.vproj) {
+        s.wv_off = end;
+        end += p.v_size * s.vproj;
+    }
+    if (s.oproj) {
+        s.wo_off = end;
+        end += s.zdim * s.oproj;
+    }
+    if (p.qbias && s.qproj) {
+        s.bq_off = end;
+        end += s.qproj;
+    }
+    if (p.kbias && s.kproj) {
+        s.bk_off = end;
+        end += s.kproj;
+    }
+    if (p.vbias && s.vproj) {
+        s.bv_off = end;
+        end += s.vproj;
+    }
+    if (p.obias && s.oproj) {
+        s.bo_off = end;
+    }
+    return s;
+}
+
+//! one of q/k/v/z seen as [batch, seq, heads, head_dim], head_stride is 0
+//! when every head reads the same unprojected input
+struct HeadView {
+    float* ptr;
+    size_t batch_stride, row_stride, head_stride;
+
+    float* head(size_t b, size_t h) const {
+        return ptr + b * batch_stride + h * head_stride;
+    }
+};
+
+float dot(const float* a, const float* b, size_t n) {
+    GI_FLOAT32_t vsum = GiZeroFloat32();
+    size_t i = 0;
+    for (; i + SIMD_STEP <= n; i += SIMD_STEP) {
+        vsum = GiMlaqFloat32(vsum, GiLoadFloat32(a + i), GiLoadFloat32(b + i));
+    }
+    float sum = GiReduceAddFloat32(vsum);
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+//! y += alpha * x
+void axpy(float* y, const float* x, float alpha, size_t n) {
+    size_t i = 0;
+    for (; i + SIMD_STEP <= n; i += SIMD_STEP) {
+        GiStoreFloat32(
+                y + i, GiMultiplyAddScalarFloat32(
+                               GiLoadFloat32(y + i), GiLoadFloat32(x + i), alpha));
+    }
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+//! y = alpha * x, x and y may alias
+void scale(float* y, const float* x, float alpha, size_t n) {
+    size_t i = 0;
+    for (; i + SIMD_STEP <= n; i += SIMD_STEP) {
+        GiStoreFloat32(y + i, GiMultiplyScalerFloat32(GiLoadFloat32(x + i), alpha));
+    }
+    for (; i < n; ++i) {
+        y[i] = alpha * x[i];
+    }
+}
+
+void add_bias(float* dst, const float* bias, size_t rows, size_t cols) {
+    for (size_t r = 0; r < rows; ++r) {
+        float* row = dst + r * cols;
+        size_t c = 0;
+        for (; c + SIMD_STEP <= cols; c += SIMD_STEP) {
+            GiStoreFloat32(
+                    row + c,
+                    GiAddFloat32(GiLoadFloat32(row + c), GiLoadFloat32(bias + c)));
+        }
+        for (; c < cols; ++c) {
+            row[c] += bias[c];
+        }
+    }
+}
+
+size_t scratch_size(const AttnShape& s) {
+    return (ROW_BLOCK * (s.vhead + 2) + KEY_BLOCK) * sizeof(float);
+}
+
+/*!
+ * softmax(q * k^T * scaler + mask) * v for rows [row_begin, row_end) of one
+ * (batch, head), walking the keys block by block and rescaling the partial
+ * output whenever the running row max grows
+ */
+void attn_rows(
+        const AttnShape& s, const float* q, size_t q_stride, const float* k,
+        size_t k_stride, const float* v, size_t v_stride, float* z, size_t z_stride,
+        const float* mask, float scaler, size_t row_begin, size_t row_end,
+        float* scratch) {
+    constexpr float neg_inf = -std::numeric_limits<float>::infinity();
+    size_t rows = row_end - row_begin;
+    float* acc = scratch;
+    float* row_max = acc + ROW_BLOCK * s.vhead;
+    float* row_sum = row_max + ROW_BLOCK;
+    float* score = row_sum + ROW_BLOCK;
+    for (size_t r = 0; r < rows; ++r) {
+        row_max[r] = neg_inf;
+        row_sum[r] = 0.f;
+    }
+    std::fill_n(acc, rows * s.vhead, 0.f);
+
+    for (size_t kb = 0; kb < s.seq_k; kb += KEY_BLOCK) {
+        size_t kn = std::min(KEY_BLOCK, s.seq_k - kb);
+        for (size_t r = 0; r < rows; ++r) {
+            size_t row = row_begin + r;
+            const float* qrow = q + row * q_stride;
+            const float* mrow = mask ? mask + row * s.seq_k + kb : nullptr;
+            for (size_t j = 0; j < kn; ++j) {
+                score[j] = dot(qrow, k + (kb + j) * k_stride, s.khead);
+            }
+            float blk_max = softmax::scale_mask_max(score, kn, scaler, mrow);
+            //! the whole block is masked out
+            if (blk_max == neg_inf) {
+                continue;
+            }
+            float new_max = std::max(row_max[r], blk_max);
+            float alpha = std::exp(row_max[r] - new_max);
+            row_max[r] = new_max;
+            float blk_sum = softmax::exp_sub_max(score, kn, new_max);
+            float* acc_row = acc + r * s.vhead;
+            if (alpha != 1.f) {
+                scale(acc_row, acc_row, alpha, s.vhead);
+            }
+            row_sum[r] = row_sum[r] * alpha + blk_sum;
+            for (size_t j = 0; j < kn; ++j) {
+                if (score[j] != 0.f) {
+                    axpy(acc_row, v + (kb + j) * v_stride, score[j], s.vhead);
+                }
+            }
+        }
+    }
+
+    for (size_t r = 0; r < rows; ++r) {
+        float inv = row_sum[r] > 0.f ? 1.f / row_sum[r] : 0.f;
+        scale(z + (row_begin + r) * z_stride, acc + r * s.vhead, inv, s.vhead);
+    }
+}
+
+}  // namespace
+
+bool MultiHeadAttnForwardImpl::usable(MHA_FORWARD_LAYOUT_CONST_PARAM) {
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    auto&& p = param();
+    auto is_fp32 = [](const TensorLayout& layout) {
+        return layout.dtype.enumv() == DTypeEnum::Float32;
+    };
+    bool has_weight = p.qproj_size || p.kproj_size || p.vproj_size || p.oproj_size;
+    bool dtype_ok = is_fp32(queries) && is_fp32(keys) && is_fp32(values) &&
+                    is_fp32(out) && (!has_weight || is_fp32(qkvo_weight_bias));
+    bool mask_ok = p.attn_mask_type == MaskType::NO_MASK ||
+                   ((p.attn_mask_type == MaskType::DEFAULT_MASK ||
+                     p.attn_mask_type == MaskType::USER_DEFINED_MASK) &&
+                    (attn_mask.ndim == 2 || attn_mask.ndim == 3) &&
+                    is_fp32(attn_mask) && attn_mask.is_contiguous());
+    bool input_ok = p.tensor_combination_type == InputType::NONE ||
+                    p.tensor_combination_type == InputType::ONLY_MASK;
+    return !p.training && !p.need_weights && !p.add_zero_attn && input_ok &&
+           dtype_ok && mask_ok;
+}
+
+WorkspaceBundle MultiHeadAttnForwardImpl::get_bundle(
+        MHA_FORWARD_LAYOUT_CONST_PARAM, void* ptr) {
+    MEGDNN_MARK_USED_VAR(values);
+    MEGDNN_MARK_USED_VAR(qkvo_weight_bias);
+    MEGDNN_MARK_USED_VAR(attn_mask);
+    MEGDNN_MARK_USED_VAR(bias_k);
+    MEGDNN_MARK_USED_VAR(bias_v);
+    MEGDNN_MARK_USED_VAR(out);
+    MEGDNN_MARK_USED_VAR(attn_weight);
+    MEGDNN_MARK_USED_VAR(mask_reservespace);
+    MEGDNN_MARK_USED_VAR(othr_reservespace);
+    auto&& p = param();
+    auto s = get_attn_shape(p, queries, keys);
+    if (!m_matmul_opr) {
+        m_matmul_opr = handle()->create_operator<MatrixMulForward>();
+    }
+    m_matmul_opr->param().transposeA = false;
+    m_matmul_opr->param().transposeB = false;
+    m_matmul_opr->param().format = param::MatrixMul::Format::DEFAULT;
+
+    size_t matmul_ws = 0;
+    auto update_matmul_ws = [&](size_t m, size_t k, size_t n) {
+        TensorLayout A{{m, k}, dtype::Float32()}, B{{k, n}, dtype::Float32()},
+                C{{m, n}, dtype::Float32()};
+        matmul_ws = std::max(matmul_ws, m_matmul_opr->get_workspace_in_bytes(A, B, C));
+    };
+    size_t fsize = sizeof(float);
+    size_t q_size = 0, k_size = 0, v_size = 0, z_size = 0;
+    if (s.qproj) {
+        q_size = s.batch * s.seq_q * s.qproj * fsize;
+        update_matmul_ws(s.seq_q, p.embeding_size, s.qproj);
+    }
+    if (s.kproj) {
+        k_size = s.batch * s.seq_k * s.kproj * fsize;
+        update_matmul_ws(s.seq_k, p.k_size, s.kproj);
+    }
+    if (s.vproj) {
+        v_size = s.batch * s.seq_k * s.vproj * fsize;
+        update_matmul_ws(s.seq_k, p.v_size, s.vproj);
+    }
+    if (s.oproj) {
+        z_size = s.batch * s.seq_q * s.zdim * fsize;
+        update_matmul_ws(s.seq_q, s.zdim, s.oproj);
+    }
+    //! every thread keeps its own running softmax state
+    size_t nr_threads = static_cast<naive::HandleImpl*>(handle())
+                                ->megcore_dispatcher()
+                                ->nr_threads();
+    return {ptr,
+            {q_size, k_size, v_size, z_size, matmul_ws, nr_threads * scratch_size(s)}};
+}
+
+size_t MultiHeadAttnForwardImpl::get_workspace_in_bytes(
+        MHA_FORWARD_LAYOUT_CONST_PARAM) {
+    if (!usable(MHA_FORWARD_CALL)) {
+        return naive::MultiHeadAttnForwardImpl::get_workspace_in_bytes(
+                MHA_FORWARD_CALL);
+    }
+    return get_bundle(MHA_FORWARD_CALL).total_size_in_bytes();
+}
+
+void MultiHeadAttnForwardImpl::exec(MHA_FORWARD_EXEC_PARAM) {
+    if (!usable(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL)) {
+        naive::MultiHeadAttnForwardImpl::exec(MHA_FORWARD_CALL, workspace);
+        return;
+    }
+    check_exec(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL, workspace.size);
+    auto&& p = param();
+    auto s = get_attn_shape(p, queries.layout, keys.layout);
+    auto bundle = get_bundle(MHA_FORWARD_TENSOR_TO_LAYOUT_CALL, workspace.raw_ptr);
+    auto matmul_ws = bundle.get_workspace(4);
+    float* weight = qkvo_weight_bias.layout.ndim
+                          ? static_cast<float*>(qkvo_weight_bias.raw_ptr())
+                          : nullptr;
+
+    //! dst = src * weight + bias, src is [batch, seq, in], dst is [batch, seq, out]
+    auto project = [&](const TensorND& src, size_t w_off, bool has_bias, size_t b_off,
+                       size_t out_size, const TensorND& dst) {
+        TensorND w{weight + w_off, {{src.layout[2], out_size}, dtype::Float32()}};
+        matmul_exec(m_matmul_opr, src, w, dst, matmul_ws);
+        if (has_bias) {
+            float* dptr = static_cast<float*>(dst.raw_ptr());
+            const float* bias = weight + b_off;
+            size_t rows = dst.layout[0] * dst.layout[1];
+            MEGDNN_DISPATCH_CPU_KERN_OPR(add_bias(dptr, bias, rows, out_size));
+        }
+    };
+    auto view = [&](const TensorND& input, size_t proj, size_t head_dim, size_t seq,
+                    size_t proj_idx, size_t w_off, bool has_bias, size_t b_off) {
+        if (!proj) {
+            size_t dim = input.layout[2];
+            return HeadView{static_cast<float*>(input.raw_ptr()), seq * dim, dim, 0};
+        }
+        TensorND dst{
+                bundle.get(proj_idx), {{s.batch, seq, proj}, dtype::Float32()}};
+        project(input, w_off, has_bias, b_off, proj, dst);
+        return HeadView{
+                static_cast<float*>(dst.raw_ptr()), seq * proj, proj, head_dim};
+    };
+    HeadView q = view(
+            queries, s.qproj, s.khead, s.seq_q, 0, s.wq_off, p.qbias, s.bq_off);
+    HeadView k =
+            view(keys, s.kproj, s.khead, s.seq_k, 1, s.wk_off, p.kbias, s.bk_off);
+    HeadView v = view(
+            values, s.vproj, s.vhead, s.seq_k, 2, s.wv_off, p.vbias, s.bv_off);
+    TensorND z = s.oproj ? TensorND{bundle.get(3), {{s.batch, s.seq_q, s.zdim},
+                                                    dtype::Float32()}}
+                         : out;
+    HeadView zv{
+            static_cast<float*>(z.raw_ptr()), s.seq_q * s.zdim, s.zdim, s.vhead};
+
+    const float* mask = nullptr;
+    bool mask_per_head = false;
+    if (p.attn_mask_type != MaskType::NO_MASK) {
+        mask = static_cast<const float*>(attn_mask.raw_ptr());
+        mask_per_head = attn_mask.layout.ndim == 3;
+    }
+    float scaler = p.sm_scaler;
+    float* scratch = static_cast<float*>(bundle.get(5));
+    size_t scratch_stride = scratch_size(s) / sizeof(float);
+    size_t nr_row_blocks = div_ceil(s.seq_q, ROW_BLOCK);
+    auto run = [=](size_t index, size_t thread_id) {
+        size_t bh = index / nr_row_blocks;
+        size_t row_begin = index % nr_row_blocks * ROW_BLOCK;
+        size_t row_end = std::min(row_begin + ROW_BLOCK, s.seq_q);
+        size_t b = bh / s.heads, h = bh % s.heads;
+        const float* head_mask =
+                mask_per_head ? mask + bh * s.seq_q * s.seq_k : mask;
+        attn_rows(
+                s, q.head(b, h), q.row_stride, k.head(b, h), k.row_stride,
+                v.head(b, h), v.row_stride, zv.head(b, h), zv.row_stride, head_mask,
+                scaler, row_begin, row_end, scratch + thread_id * scratch_stride);
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(
+            run, s.batch * s.heads * nr_row_blocks);
+
+    if (s.oproj) {
+        project(z, s.wo_off, p.obias, s.bo_off, s.oproj, out);
+    }
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
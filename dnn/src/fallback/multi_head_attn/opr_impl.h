@@ -0,0 +1,36 @@
+#pragma once
+#include "src/common/multi_head_attn/helper.h"
+#include "src/common/utils.h"
+#include "src/naive/multi_head_attn/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief fused attention forward for inference
+ *
+ * The projections still go through MatrixMul, but softmax(q * k^T) * v is
+ * computed tile by tile with an online softmax, so the [batch * heads, seq_q,
+ * seq_k] score matrix is never materialized. Only float32 inference without
+ * dropout, bias_kv, add_zero_attn and need_weights takes this path, the other
+ * cases are forwarded to the naive proxy.
+ */
+class MultiHeadAttnForwardImpl : public naive::MultiHeadAttnForwardImpl {
+public:
+    using naive::MultiHeadAttnForwardImpl::MultiHeadAttnForwardImpl;
+
+    void exec(MHA_FORWARD_EXEC_PARAM) override;
+    size_t get_workspace_in_bytes(MHA_FORWARD_LAYOUT_CONST_PARAM) override;
+
+    bool usable(MHA_FORWARD_LAYOUT_CONST_PARAM);
+
+private:
+    WorkspaceBundle get_bundle(MHA_FORWARD_LAYOUT_CONST_PARAM, void* ptr = nullptr);
+
+    std::unique_ptr<MatrixMulForward> m_matmul_opr;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
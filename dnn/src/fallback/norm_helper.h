@@ -0,0 +1,206 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include "src/fallback/general_intrinsic/gi_float.h"
+
+namespace megdnn {
+namespace fallback {
+namespace norm {
+
+constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+
+//! minimal number of elements normalized by a task
+constexpr size_t NORM_TASK_ELEMS = 16 * 1024;
+
+//! merge the moments (nb, mean_b, m2_b) into (na, mean_a, m2_a)
+inline void merge_moments(
+        float& na, float& mean_a, float& m2_a, float nb, float mean_b, float m2_b) {
+    float n = na + nb;
+    if (n == 0.f) {
+        return;
+    }
+    float delta = mean_b - mean_a;
+    mean_a += delta * (nb / n);
+    m2_a += m2_b + delta * delta * (na * nb / n);
+    na = n;
+}
+
+/*!
+ * mean and biased variance of a contiguous row in a single pass: every lane
+ * runs Welford's update, then the lanes are merged with Chan's formula
+ */
+inline void row_moments(const float* src, size_t len, float& mean, float& var) {
+    float cnt = 0.f, m = 0.f, m2 = 0.f;
+    size_t i = 0;
+    if (len >= 2 * SIMD_WIDTH) {
+        GI_FLOAT32_t vmean0 = GiBroadcastFloat32(0.f), vmean1 = vmean0;
+        GI_FLOAT32_t vm20 = vmean0, vm21 = vmean0;
+        size_t n = 0;
+        for (; i + 2 * SIMD_WIDTH <= len; i += 2 * SIMD_WIDTH) {
+            float rn = 1.f / static_cast<float>(++n);
+            GI_FLOAT32_t x0 = GiLoadFloat32(src + i);
+            GI_FLOAT32_t x1 = GiLoadFloat32(src + i + SIMD_WIDTH);
+            GI_FLOAT32_t d0 = GiSubtractFloat32(x0, vmean0);
+            GI_FLOAT32_t d1 = GiSubtractFloat32(x1, vmean1);
+            vmean0 = GiMultiplyAddScalarFloat32(vmean0, d0, rn);
+            vmean1 = GiMultiplyAddScalarFloat32(vmean1, d1, rn);
+            vm20 = GiMultiplyAddFloat32(vm20, d0, GiSubtractFloat32(x0, vmean0));
+            vm21 = GiMultiplyAddFloat32(vm21, d1, GiSubtractFloat32(x1, vmean1));
+        }
+        float lane_mean[2 * SIMD_WIDTH], lane_m2[2 * SIMD_WIDTH];
+        GiStoreFloat32(lane_mean, vmean0);
+        GiStoreFloat32(lane_mean + SIMD_WIDTH, vmean1);
+        GiStoreFloat32(lane_m2, vm20);
+        GiStoreFloat32(lane_m2 + SIMD_WIDTH, vm21);
+        for (size_t k = 0; k < 2 * SIMD_WIDTH; ++k) {
+            merge_moments(
+                    cnt, m, m2, static_cast<float>(n), lane_mean[k], lane_m2[k]);
+        }
+    }
+    for (; i < len; ++i) {
+        cnt += 1.f;
+        float delta = src[i] - m;
+        m += delta / cnt;
+        m2 += delta * (src[i] - m);
+    }
+    mean = m;
+    var = len ? m2 / static_cast<float>(len) : 0.f;
+}
+
+//! mean of the squares of a contiguous row
+inline float row_mean_square(const float* src, size_t len) {
+    size_t i = 0;
+    float sum = 0.f;
+    if (len >= 2 * SIMD_WIDTH) {
+        GI_FLOAT32_t vsum0 = GiBroadcastFloat32(0.f), vsum1 = vsum0;
+        for (; i + 2 * SIMD_WIDTH <= len; i += 2 * SIMD_WIDTH) {
+            GI_FLOAT32_t x0 = GiLoadFloat32(src + i);
+            GI_FLOAT32_t x1 = GiLoadFloat32(src + i + SIMD_WIDTH);
+            vsum0 = GiMultiplyAddFloat32(vsum0, x0, x0);
+            vsum1 = GiMultiplyAddFloat32(vsum1, x1, x1);
+        }
+        sum = GiReduceAddFloat32(GiAddFloat32(vsum0, vsum1));
+    }
+    for (; i < len; ++i) {
+        sum += src[i] * src[i];
+    }
+    return len ? sum / static_cast<float>(len) : 0.f;
+}
+
+//! dst = src * scale + shift
+inline void scale_shift_row(
+        const float* src, float* dst, size_t len, float scale, float shift) {
+    size_t i = 0;
+    GI_FLOAT32_t vscale = GiBroadcastFloat32(scale);
+    GI_FLOAT32_t vshift = GiBroadcastFloat32(shift);
+    for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+        GiStoreFloat32(
+                dst + i,
+                GiMultiplyAddFloat32(vshift, GiLoadFloat32(src + i), vscale));
+    }
+    for (; i < len; ++i) {
+        dst[i] = src[i] * scale + shift;
+    }
+}
+
+/*!
+ * dst = (src - mean) * rstd * weight + bias with an elementwise affine over
+ * the row, the row is only read once; weight and bias may be null
+ */
+inline void normalize_row(
+        const float* src, float* dst, size_t len, float mean, float rstd,
+        const float* weight, const float* bias) {
+    if (!weight) {
+        scale_shift_row(src, dst, len, rstd, -mean * rstd);
+        return;
+    }
+    size_t i = 0;
+    GI_FLOAT32_t vmean = GiBroadcastFloat32(mean);
+    for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+        GI_FLOAT32_t x = GiMultiplyScalerFloat32(
+                GiSubtractFloat32(GiLoadFloat32(src + i), vmean), rstd);
+        x = GiMultiplyAddFloat32(GiLoadFloat32(bias + i), x, GiLoadFloat32(weight + i));
+        GiStoreFloat32(dst + i, x);
+    }
+    for (; i < len; ++i) {
+        dst[i] = (src[i] - mean) * rstd * weight[i] + bias[i];
+    }
+}
+
+/*!
+ * moments along the rows of a [B, C] block for the columns in [c_begin,
+ * c_end), the columns are updated a vector at a time with Welford's update;
+ * with \p rms only the mean square is computed and mean is zero
+ */
+inline void column_moments(
+        const float* src, size_t B, size_t C, size_t c_begin, size_t c_end,
+        bool rms, float* mean, float* var) {
+    size_t c = c_begin;
+    for (; c + SIMD_WIDTH <= c_end; c += SIMD_WIDTH) {
+        GI_FLOAT32_t vmean = GiBroadcastFloat32(0.f), vm2 = vmean;
+        if (rms) {
+            for (size_t b = 0; b < B; ++b) {
+                GI_FLOAT32_t x = GiLoadFloat32(src + b * C + c);
+                vm2 = GiMultiplyAddFloat32(vm2, x, x);
+            }
+        } else {
+            for (size_t b = 0; b < B; ++b) {
+                GI_FLOAT32_t x = GiLoadFloat32(src + b * C + c);
+                GI_FLOAT32_t delta = GiSubtractFloat32(x, vmean);
+                vmean = GiMultiplyAddScalarFloat32(
+                        vmean, delta, 1.f / static_cast<float>(b + 1));
+                vm2 = GiMultiplyAddFloat32(vm2, delta, GiSubtractFloat32(x, vmean));
+            }
+        }
+        GiStoreFloat32(mean + c, vmean);
+        GiStoreFloat32(
+                var + c, GiMultiplyScalerFloat32(vm2, 1.f / static_cast<float>(B)));
+    }
+    for (; c < c_end; ++c) {
+        float m = 0.f, m2 = 0.f;
+        for (size_t b = 0; b < B; ++b) {
+            float x = src[b * C + c];
+            if (rms) {
+                m2 += x * x;
+            } else {
+                float delta = x - m;
+                m += delta / static_cast<float>(b + 1);
+                m2 += delta * (x - m);
+            }
+        }
+        mean[c] = m;
+        var[c] = m2 / static_cast<float>(B);
+    }
+}
+
+/*!
+ * dst[b, c] = (src[b, c] - mean[c]) * rstd[c] * weight[b] + bias[b] for the
+ * columns in [c_begin, c_end); weight and bias may be null
+ */
+inline void normalize_columns(
+        const float* src, float* dst, size_t B, size_t C, size_t c_begin,
+        size_t c_end, const float* mean, const float* rstd, const float* weight,
+        const float* bias) {
+    for (size_t b = 0; b < B; ++b) {
+        const float* sptr = src + b * C;
+        float* dptr = dst + b * C;
+        float w = weight ? weight[b] : 1.f, bi = bias ? bias[b] : 0.f;
+        GI_FLOAT32_t vbias = GiBroadcastFloat32(bi);
+        size_t c = c_begin;
+        for (; c + SIMD_WIDTH <= c_end; c += SIMD_WIDTH) {
+            GI_FLOAT32_t x = GiMultiplyFloat32(
+                    GiSubtractFloat32(GiLoadFloat32(sptr + c), GiLoadFloat32(mean + c)),
+                    GiLoadFloat32(rstd + c));
+            GiStoreFloat32(dptr + c, GiMultiplyAddScalarFloat32(vbias, x, w));
+        }
+        for (; c < c_end; ++c) {
+            dptr[c] = (sptr[c] - mean[c]) * rstd[c] * w + bi;
+        }
+    }
+}
+
+}  // namespace norm
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
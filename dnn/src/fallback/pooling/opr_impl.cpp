@@ -98,7 +98,7 @@ size_t PoolingImpl::get_workspace_in_bytes(
     AlgorithmCache::Key key{this->handle(), this->get_opr_type(),
                             layouts.data(), layouts.size(),
                             &this->param(), sizeof(this->param())};
-    auto rst = AlgorithmCache::instance().get(key);
+    auto rst = AlgorithmCache::instance().get(key, this->algo_cache_last_entry());
     if (rst.policy.algo.valid()) {
         return rst.workspace;
     }
@@ -3,6 +3,8 @@
 #include "src/common/utils.h"
 #include "src/naive/handle.h"
 
+#include <algorithm>
+
 #include "midout.h"
 #include "reducer.h"
 
@@ -61,6 +63,130 @@ void reduce_exec(size_t A, size_t B, size_t C, Op op) MEGDNN_NOEXCEPT {
     }
 }
 
+template <typename ctype>
+using ReduceFunc = std::function<void(
+        const ctype*, ctype*, DType, size_t, size_t, size_t, _megdnn_workspace)>;
+
+//! minimal number of elements reduced by a task
+constexpr size_t REDUCE_TASK_ELEMS = 16 * 1024;
+//! minimal number of elements in a part when the reduced axis is split
+constexpr size_t REDUCE_SPLIT_K_ELEMS = 32 * 1024;
+
+//! workspace of the large B kernels of Mean, Sum and SumSqr when C == 1
+size_t c1_large_b_workspace(size_t B) {
+    // Using B = 247 as an example, you can understand why these parameters exist
+    size_t _60xT_in_4 = (60 * 3) / 4;  // T = 3
+    size_t _60xX_in_4 = 4;             // 0 < X < T, X = 1,2.
+    size_t _XXxT_in_4 = 4;
+    return ((B / _60xT_in_4 + _60xX_in_4 + _XXxT_in_4) * sizeof(float));
+}
+
+/*!
+ * number of parts the reduced axis is split into; it is only split when
+ * C == 1 and there are too few rows to keep the threads busy
+ */
+size_t get_nr_split(size_t A, size_t B, size_t C, size_t nr_threads) {
+    if (C != 1 || A >= nr_threads) {
+        return 1;
+    }
+    return std::max<size_t>(
+            1, std::min(div_ceil(nr_threads, A), B / REDUCE_SPLIT_K_ELEMS));
+}
+
+//! C != 1: every task reduces a tile of columns of one [B, C] slice
+template <typename Reducer>
+void reduce_multi_thread_c(
+        naive::HandleImpl* handle, const TensorND& src, const TensorND& dst,
+        DType src_type, size_t A, size_t B, size_t C) {
+    using ctype = typename Reducer::ctype;
+    size_t cols = round_up(
+            std::max<size_t>(REDUCE_TASK_ELEMS / B, 1),
+            static_cast<size_t>(4 * Reducer::SIMD_WIDTH));
+    size_t nr_col_tasks = div_ceil(C, cols);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t a = task_id / nr_col_tasks, c0 = task_id % nr_col_tasks * cols;
+        reduce_columns<Reducer>(
+                static_cast<const ctype*>(src.raw_ptr()) + a * B * C,
+                static_cast<ctype*>(dst.raw_ptr()) + a * C, src_type, B, C, c0,
+                std::min(C, c0 + cols));
+    };
+    handle->dispatch_kern(kern, A * nr_col_tasks);
+}
+
+//! C == 1: every task reduces a group of rows with the workspace of its thread
+template <typename ctype>
+void reduce_multi_thread_c1(
+        naive::HandleImpl* handle, const ReduceFunc<ctype>& do_reduce,
+        size_t simd_width, const TensorND& src, const TensorND& dst, DType src_type,
+        size_t A, size_t B, const Workspace& workspace, size_t ws_per_thread) {
+    size_t rows = round_up(std::max<size_t>(REDUCE_TASK_ELEMS / B, 1), simd_width);
+    auto kern = [=](size_t task_id, size_t thread_id) {
+        size_t a0 = task_id * rows;
+        Workspace ws{workspace.raw_ptr + thread_id * ws_per_thread, ws_per_thread};
+        do_reduce(
+                static_cast<const ctype*>(src.raw_ptr()) + a0 * B,
+                static_cast<ctype*>(dst.raw_ptr()) + a0, src_type,
+                std::min(rows, A - a0), B, 1, ws);
+    };
+    handle->dispatch_kern(kern, div_ceil(A, rows));
+}
+
+/*!
+ * C == 1 with few rows: the parts of every row are reduced in parallel into
+ * the workspace after the per thread workspaces, then combined; MEAN parts
+ * are weighted by their length so the mean scaling is still applied once
+ */
+template <typename ctype>
+void reduce_split_k(
+        naive::HandleImpl* handle, const ReduceFunc<ctype>& do_reduce,
+        param::Reduce::Mode mode, size_t simd_width, const TensorND& src,
+        const TensorND& dst, DType src_type, size_t A, size_t B, size_t nr_split,
+        const Workspace& workspace, size_t ws_per_thread) {
+    using Mode = param::Reduce::Mode;
+    size_t nr_threads = handle->megcore_dispatcher()->nr_threads();
+    size_t part = round_up(div_ceil(B, nr_split), simd_width);
+    nr_split = div_ceil(B, part);
+    ctype* partial = reinterpret_cast<ctype*>(
+            workspace.raw_ptr + nr_threads * ws_per_thread);
+    auto kern = [=](size_t task_id, size_t thread_id) {
+        size_t a = task_id / nr_split, b0 = task_id % nr_split * part,
+               len = std::min(part, B - b0);
+        Workspace ws{workspace.raw_ptr + thread_id * ws_per_thread, ws_per_thread};
+        do_reduce(
+                static_cast<const ctype*>(src.raw_ptr()) + a * B + b0,
+                partial + task_id, src_type, 1, len, 1, ws);
+        if (mode == Mode::MEAN) {
+            partial[task_id] = partial[task_id] * (static_cast<float>(len) / B);
+        }
+    };
+    handle->dispatch_kern(kern, A * nr_split);
+    auto combine = [=]() {
+        auto dptr = static_cast<ctype*>(dst.raw_ptr());
+        for (size_t a = 0; a < A; ++a) {
+            const ctype* p = partial + a * nr_split;
+            ctype res = p[0];
+            for (size_t i = 1; i < nr_split; ++i) {
+                switch (mode) {
+                    case Mode::MAX:
+                        res = std::max(res, p[i]);
+                        break;
+                    case Mode::MIN:
+                        res = std::min(res, p[i]);
+                        break;
+                    case Mode::PRODUCT:
+                        res = res * p[i];
+                        break;
+                    default:
+                        res = res + p[i];
+                        break;
+                }
+            }
+            dptr[a] = res;
+        }
+    };
+    handle->dispatch_kern(combine);
+}
+
 }  // anonymous namespace
 
 namespace megdnn {
@@ -71,18 +197,23 @@ size_t ReduceImpl::get_workspace_in_bytes(
     MEGDNN_MARK_USED_VAR(src);
     MEGDNN_MARK_USED_VAR(dst);
 
-    if (src.dtype.enumv() == DTypeEnum::Float32 &&
-        (param().mode == Mode::MEAN || param().mode == Mode::SUM ||
-         param().mode == Mode::SUM_SQR)) {
+    if (src.dtype.enumv() == DTypeEnum::Float32) {
         size_t A, B, C;
         reduce::get_ABC(src, A, B, C, param().axis);
-        if (C == 1) {
-            // Using B = 247 as an example, you can understand why these parameters exist
-            size_t _60xT_in_4 = (60 * 3) / 4;  // T = 3
-            size_t _60xX_in_4 = 4;             // 0 < X < T, X = 1,2.
-            size_t _XXxT_in_4 = 4;
-            return ((B / _60xT_in_4 + _60xX_in_4 + _XXxT_in_4) * sizeof(float));
+        size_t nr_threads = static_cast<naive::HandleImpl*>(handle())
+                                    ->megcore_dispatcher()
+                                    ->nr_threads();
+        size_t size = 0;
+        if (C == 1 && (param().mode == Mode::MEAN || param().mode == Mode::SUM ||
+                       param().mode == Mode::SUM_SQR)) {
+            size = nr_threads * c1_large_b_workspace(B);
         }
+        size_t nr_split = get_nr_split(A, B, C, nr_threads);
+        if (nr_split > 1) {
+            size += A * nr_split * sizeof(float);
+        }
+        return std::max(
+                size, naive::ReduceForwardImpl::get_workspace_in_bytes(src, dst));
     }
     return naive::ReduceForwardImpl::get_workspace_in_bytes(src, dst);
 }
@@ -203,47 +334,56 @@ bool ReduceImpl::exec_optimized(
     reduce::get_ABC(src.layout, A, B, C, param().axis);
     bool execed = false;
     using Mode = param::Reduce::Mode;
+    auto cpu_handle = static_cast<naive::HandleImpl*>(handle());
+    size_t nr_threads = cpu_handle->megcore_dispatcher()->nr_threads();
+    //! quantized parts would be rounded before they are combined
+    size_t nr_split = src.layout.dtype.enumv() == DTypeEnum::Float32
+                            ? get_nr_split(A, B, C, nr_threads)
+                            : 1;
+    size_t ws_per_thread = 0;
+    if (src.layout.dtype.enumv() == DTypeEnum::Float32 && C == 1 &&
+        (param().mode == Mode::MEAN || param().mode == Mode::SUM ||
+         param().mode == Mode::SUM_SQR)) {
+        ws_per_thread = c1_large_b_workspace(B);
+    }
 
-#define DISPATCH_FUNC(Reducer, dtype, ctype, comp_type)                         \
-    if (C == 1) {                                                               \
-        using _Reducer = Reducer<dtype, ctype, comp_type, true>;                \
-        using _ReducerC1SmallB = Reducer<dtype, ctype, comp_type, false>;       \
-        std::function<void(                                                     \
-                const ctype*, ctype*, DType, size_t, size_t, size_t,            \
-                _megdnn_workspace)>                                             \
-                do_reduce = Exec<_Reducer, true>::do_reduce;                    \
-        if (B == 2)                                                             \
-            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 2>::do_reduce;    \
-        if (B == 3)                                                             \
-            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 3>::do_reduce;    \
-        if (B == 4)                                                             \
-            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 4>::do_reduce;    \
-        MIDOUT_BEGIN(                                                           \
-                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,      \
-                midout_iv(0)) {                                                 \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_reduce(                             \
-                    reinterpret_cast<ctype*>(src.raw_ptr()),                    \
-                    reinterpret_cast<ctype*>(dst.raw_ptr()), src_type, A, B, C, \
-                    workspace));                                                \
-            execed = true;                                                      \
-        }                                                                       \
-        MIDOUT_END();                                                           \
-    } else {                                                                    \
-        using _Reducer = Reducer<dtype, ctype, comp_type, false>;               \
-        std::function<void(                                                     \
-                const ctype*, ctype*, DType, size_t, size_t, size_t,            \
-                _megdnn_workspace)>                                             \
-                do_reduce = Exec<_Reducer, false>::do_reduce;                   \
-        MIDOUT_BEGIN(                                                           \
-                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,      \
-                midout_iv(1)) {                                                 \
-            MEGDNN_DISPATCH_CPU_KERN_OPR(do_reduce(                             \
-                    reinterpret_cast<ctype*>(src.raw_ptr()),                    \
-                    reinterpret_cast<ctype*>(dst.raw_ptr()), src_type, A, B, C, \
-                    workspace));                                                \
-            execed = true;                                                      \
-        }                                                                       \
-        MIDOUT_END();                                                           \
+#define DISPATCH_FUNC(Reducer, dtype, ctype, comp_type)                          \
+    if (C == 1) {                                                                \
+        using _Reducer = Reducer<dtype, ctype, comp_type, true>;                 \
+        using _ReducerC1SmallB = Reducer<dtype, ctype, comp_type, false>;        \
+        ReduceFunc<ctype> do_reduce = Exec<_Reducer, true>::do_reduce;           \
+        if (B == 2)                                                              \
+            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 2>::do_reduce;     \
+        if (B == 3)                                                              \
+            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 3>::do_reduce;     \
+        if (B == 4)                                                              \
+            do_reduce = ExecC1SmallB<_ReducerC1SmallB, ctype, 4>::do_reduce;     \
+        MIDOUT_BEGIN(                                                            \
+                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,       \
+                midout_iv(0)) {                                                  \
+            if (nr_split > 1) {                                                  \
+                reduce_split_k<ctype>(                                           \
+                        cpu_handle, do_reduce, param().mode,                     \
+                        _Reducer::SIMD_WIDTH, src, dst, src_type, A, B,          \
+                        nr_split, workspace, ws_per_thread);                     \
+            } else {                                                             \
+                reduce_multi_thread_c1<ctype>(                                   \
+                        cpu_handle, do_reduce, _Reducer::SIMD_WIDTH, src,        \
+                        dst, src_type, A, B, workspace, ws_per_thread);          \
+            }                                                                    \
+            execed = true;                                                       \
+        }                                                                        \
+        MIDOUT_END();                                                            \
+    } else {                                                                     \
+        using _Reducer = Reducer<dtype, ctype, comp_type, false>;                \
+        MIDOUT_BEGIN(                                                            \
+                megdnn_fallback_reduce_optimized, ctype, dtype, comp_type,       \
+                midout_iv(1)) {                                                  \
+            reduce_multi_thread_c<_Reducer>(                                     \
+                    cpu_handle, src, dst, src_type, A, B, C);                    \
+            execed = true;                                                       \
+        }                                                                        \
+        MIDOUT_END();                                                            \
     }
 
 #define DISPATCH_MODE_QUANTIZED(dtype, ctype, comp_type)         \
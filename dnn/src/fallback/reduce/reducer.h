@@ -423,28 +423,57 @@ struct Exec<Reducer, true> {
     }
 };
 
+/*!
+ * \brief reduce columns [c_begin, c_end) of one [B, C] slice
+ *
+ * Four vectors of columns are reduced together, so every b reads a whole
+ * cache line instead of striding over B once per vector.
+ */
+template <typename Reducer>
+void reduce_columns(
+        const typename Reducer::ctype* src, typename Reducer::ctype* dst,
+        DType src_dtype, size_t B, size_t C, size_t c_begin, size_t c_end) {
+    constexpr size_t W = Reducer::SIMD_WIDTH;
+    size_t c = c_begin;
+    for (; c + 4 * W <= c_end; c += 4 * W) {
+        Reducer reducer0(src_dtype, B), reducer1(src_dtype, B),
+                reducer2(src_dtype, B), reducer3(src_dtype, B);
+        auto src_ptr = src + c;
+        for (size_t b = 0; b < B; b++) {
+            reducer0.feed(src_ptr);
+            reducer1.feed(src_ptr + W);
+            reducer2.feed(src_ptr + 2 * W);
+            reducer3.feed(src_ptr + 3 * W);
+            src_ptr += C;
+        }
+        reducer0.post(dst + c);
+        reducer1.post(dst + c + W);
+        reducer2.post(dst + c + 2 * W);
+        reducer3.post(dst + c + 3 * W);
+    }
+    for (; c + W <= c_end; c += W) {
+        Reducer reducer(src_dtype, B);
+        for (size_t b = 0; b < B; b++)
+            reducer.feed(src + c + C * b);
+        reducer.post(dst + c);
+    }
+    for (; c < c_end; c++) {
+        Reducer reducer(src_dtype, B);
+        for (size_t b = 0; b < B; b++)
+            reducer.feed_remain(src + c + C * b);
+        reducer.post_remain(dst + c);
+    }
+}
+
 template <typename Reducer>
 struct Exec<Reducer, false> {
     static void do_reduce(
             const typename Reducer::ctype* src, typename Reducer::ctype* dst,
             DType src_dtype, size_t A, size_t B, size_t C, _megdnn_workspace) {
         for (size_t a = 0; a < A; a++) {
-            size_t c = 0;
-            for (; c + Reducer::SIMD_WIDTH <= C; c += Reducer::SIMD_WIDTH) {
-                Reducer reducer(src_dtype, B);
-                for (size_t b = 0; b < B; b++)
-                    reducer.feed(src + c + C * b);
-                reducer.post(dst);
-                dst += Reducer::SIMD_WIDTH;
-            }
-            for (; c < C; c++) {
-                Reducer reducer(src_dtype, B);
-                for (size_t b = 0; b < B; b++)
-                    reducer.feed_remain(src + c + C * b);
-                reducer.post_remain(dst);
-                dst++;
-            }
+            reduce_columns<Reducer>(src, dst, src_dtype, B, C, 0, C);
             src += B * C;
+            dst += C;
         }
     }
 };
@@ -3,6 +3,7 @@
 #include "src/common/utils.h"
 #include "src/naive/handle.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace megdnn;
@@ -458,6 +459,220 @@ void transpose_cv(
     }
 }
 
+/* ======================= strided relayout ======================= */
+
+/*!
+ * \brief relayout between a strided layout and a contiguous one of the same
+ *      shape, split into tasks for the thread pool
+ *
+ * The unit stride axis of the strided layout is paired with the last axis,
+ * which has unit stride on the contiguous side. Rows are copied when the two
+ * are the same axis, otherwise the pair is transposed by blocks of
+ * transpose_traits<T>::block_size so both sides are accessed by whole cache
+ * lines. The remaining axes form the outer loop.
+ */
+struct StridedRelayoutParam {
+    size_t nr_outer, nr_outer_elems;
+    size_t outer_shape[TensorLayout::MAX_NDIM];
+    size_t outer_nonc_stride[TensorLayout::MAX_NDIM];
+    size_t outer_cont_stride[TensorLayout::MAX_NDIM];
+
+    //! length of the last axis and its stride on the strided side
+    size_t row_len, row_nonc_stride;
+    //! length of the transposed axis and its stride on the contiguous side;
+    //! tile_len is 0 if rows are copied
+    size_t tile_len, tile_cont_stride;
+    size_t block;
+
+    bool nonc_is_src;
+    size_t rows_per_task, nr_tasks;
+
+    bool init(const TensorLayout& nonc, bool nonc_is_src);
+
+    void outer_offset(size_t idx, size_t& nonc_off, size_t& cont_off) const {
+        nonc_off = cont_off = 0;
+        for (size_t i = nr_outer; i--;) {
+            size_t x = idx % outer_shape[i];
+            idx /= outer_shape[i];
+            nonc_off += x * outer_nonc_stride[i];
+            cont_off += x * outer_cont_stride[i];
+        }
+    }
+};
+
+//! minimal bytes copied by a task when whole rows are copied
+constexpr size_t STRIDED_ROW_TASK_BYTES = 16 * 1024;
+
+bool StridedRelayoutParam::init(const TensorLayout& nonc, bool nonc_is_src) {
+    size_t dsize = nonc.dtype.size();
+    if (nonc.dtype.is_low_bit() || !nonc.total_nr_elems() ||
+        (dsize != 1 && dsize != 2 && dsize != 4 && dsize != 8)) {
+        return false;
+    }
+    size_t ndim = nonc.ndim, last = ndim - 1;
+    size_t cont_stride[TensorLayout::MAX_NDIM];
+    cont_stride[last] = 1;
+    for (size_t i = last; i > 0; --i) {
+        cont_stride[i - 1] = cont_stride[i] * nonc[i];
+    }
+    for (size_t i = 0; i < ndim; ++i) {
+        if (nonc.stride[i] < 0) {
+            return false;
+        }
+    }
+    size_t tile_axis = ndim;
+    if (nonc.stride[last] != 1) {
+        for (size_t i = 0; i < last; ++i) {
+            if (nonc.stride[i] == 1) {
+                tile_axis = i;
+                break;
+            }
+        }
+    }
+
+    this->nonc_is_src = nonc_is_src;
+    row_len = nonc[last];
+    row_nonc_stride = nonc.stride[last];
+    tile_len = tile_axis == ndim ? 0 : nonc[tile_axis];
+    tile_cont_stride = tile_axis == ndim ? 0 : cont_stride[tile_axis];
+    block = relayout::transpose_fallback::BLOCK_LINE_SIZE_BYTES / dsize;
+    nr_outer = 0;
+    nr_outer_elems = 1;
+    for (size_t i = 0; i < last; ++i) {
+        if (i == tile_axis) {
+            continue;
+        }
+        outer_shape[nr_outer] = nonc[i];
+        outer_nonc_stride[nr_outer] = nonc.stride[i];
+        outer_cont_stride[nr_outer] = cont_stride[i];
+        nr_outer_elems *= nonc[i];
+        ++nr_outer;
+    }
+    if (tile_len) {
+        rows_per_task = 0;
+        nr_tasks = nr_outer_elems * div_ceil(tile_len, block);
+    } else {
+        rows_per_task = std::max<size_t>(1, STRIDED_ROW_TASK_BYTES / (row_len * dsize));
+        nr_tasks = div_ceil(nr_outer_elems, rows_per_task);
+    }
+    return true;
+}
+
+template <typename T>
+void strided_relayout_transpose(
+        const T* src, T* dst, size_t src_stride, size_t dst_stride, size_t h,
+        size_t w) {
+    constexpr size_t B = relayout::transpose_fallback::transpose_traits<T>::block_size;
+    if (h == B && w == B) {
+        relayout::transpose_fallback::transpose_block(src, dst, src_stride, dst_stride);
+    } else {
+        relayout::transpose_fallback::transpose_block(
+                src, dst, src_stride, dst_stride, h, w);
+    }
+}
+
+template <typename T>
+void strided_relayout_task(
+        const StridedRelayoutParam& p, const T* src, T* dst, size_t task_id) {
+    size_t nonc_off, cont_off;
+    if (!p.tile_len) {
+        size_t begin = task_id * p.rows_per_task,
+               end = std::min(begin + p.rows_per_task, p.nr_outer_elems);
+        size_t stride = p.row_nonc_stride;
+        for (size_t r = begin; r < end; ++r) {
+            p.outer_offset(r, nonc_off, cont_off);
+            const T* sptr = src + (p.nonc_is_src ? nonc_off : cont_off);
+            T* dptr = dst + (p.nonc_is_src ? cont_off : nonc_off);
+            if (stride == 1) {
+                memcpy(dptr, sptr, p.row_len * sizeof(T));
+            } else if (p.nonc_is_src) {
+                for (size_t j = 0; j < p.row_len; ++j) {
+                    dptr[j] = sptr[j * stride];
+                }
+            } else {
+                for (size_t j = 0; j < p.row_len; ++j) {
+                    dptr[j * stride] = sptr[j];
+                }
+            }
+        }
+        return;
+    }
+
+    constexpr size_t B = relayout::transpose_fallback::transpose_traits<T>::block_size;
+    size_t nr_blocks = div_ceil(p.tile_len, B);
+    size_t x0 = task_id % nr_blocks * B, xlen = std::min(B, p.tile_len - x0);
+    p.outer_offset(task_id / nr_blocks, nonc_off, cont_off);
+    nonc_off += x0;
+    cont_off += x0 * p.tile_cont_stride;
+    for (size_t y0 = 0; y0 < p.row_len; y0 += B) {
+        size_t ylen = std::min(B, p.row_len - y0);
+        if (p.nonc_is_src) {
+            strided_relayout_transpose(
+                    src + nonc_off + y0 * p.row_nonc_stride, dst + cont_off + y0,
+                    p.row_nonc_stride, p.tile_cont_stride, ylen, xlen);
+        } else {
+            strided_relayout_transpose(
+                    src + cont_off + y0, dst + nonc_off + y0 * p.row_nonc_stride,
+                    p.tile_cont_stride, p.row_nonc_stride, xlen, ylen);
+        }
+    }
+}
+
+template <size_t size, typename T>
+void dispatch_strided_relayout(
+        Handle* handle, const StridedRelayoutParam& p, const TensorND& src,
+        const TensorND& dst) {
+    static_assert(sizeof(T) == size, "bad ctype");
+    auto kern = [p, src, dst](size_t task_id, size_t) {
+        auto sptr = src.raw_ptr(), dptr = dst.raw_ptr();
+        auto addr = reinterpret_cast<uintptr_t>(sptr) |
+                    reinterpret_cast<uintptr_t>(dptr);
+        if (!(addr & (alignof(T) - 1))) {
+            strided_relayout_task(
+                    p, static_cast<const T*>(sptr), static_cast<T*>(dptr), task_id);
+        } else {
+            using U = equiv_ctype_storage<size>;
+            strided_relayout_task(
+                    p, static_cast<const U*>(sptr), static_cast<U*>(dptr), task_id);
+        }
+    };
+    static_cast<naive::HandleImpl*>(handle)->dispatch_kern(kern, p.nr_tasks);
+}
+
+/*!
+ * \brief try the strided relayout; one of \p src and \p dst must be
+ *      contiguous
+ * \return whether the relayout has been dispatched
+ */
+bool dispatch_strided(Handle* handle, const TensorND& src, const TensorND& dst) {
+    using relayout::is_contig;
+    bool nonc_is_src = is_contig(dst.layout);
+    if (!nonc_is_src && !is_contig(src.layout)) {
+        return false;
+    }
+    StridedRelayoutParam p;
+    if (!p.init(nonc_is_src ? src.layout : dst.layout, nonc_is_src)) {
+        return false;
+    }
+    switch (src.layout.dtype.size()) {
+        case 1:
+            dispatch_strided_relayout<1, uint8_t>(handle, p, src, dst);
+            break;
+        case 2:
+            dispatch_strided_relayout<2, uint16_t>(handle, p, src, dst);
+            break;
+        case 4:
+            dispatch_strided_relayout<4, uint32_t>(handle, p, src, dst);
+            break;
+        case 8:
+            dispatch_strided_relayout<8, uint64_t>(handle, p, src, dst);
+            break;
+        default:
+            megdnn_assert_internal(0);
+    }
+    return true;
+}
+
 }  // anonymous namespace
 
 void RelayoutForwardImpl::exec(
@@ -495,8 +710,13 @@ void RelayoutForwardImpl::exec(
 
 void RelayoutForwardImpl::exec_after_preprocess(
         const TensorND& src, const TensorND& dst, relayout::TransposeParam* transpose) {
+    using relayout::is_contig;
+
     if (transpose) {
         bool is_bit4 = is_int4(src.layout);
+        if (transpose->c == 1 && !is_bit4 && dispatch_strided(handle(), src, dst)) {
+            return;
+        }
         auto kernel = [tparam = *transpose, src, dst, is_bit4]() {
             auto t = tparam;
             void (*kptr)(size_t, size_t, size_t, size_t, void*, void*, size_t) =
@@ -565,16 +785,20 @@ void RelayoutForwardImpl::exec_after_preprocess(
                 megdnn_assert(t.c != 1, "unsupported dtype size");
             }
         };
-        MEGDNN_DISPATCH_CPU_KERN_OPR(kernel());
+        if (is_bit4 || src.layout.dtype.size() * transpose->c <= TRANSPOSE_CV_MAX_C) {
+            MEGDNN_DISPATCH_CPU_KERN_OPR(kernel());
+            return;
+        }
     }
 
-    using relayout::is_contig;
-
     if (is_contig(dst.layout) && is_contig(src.layout)) {
         auto sz = src.layout.span().dist_byte();
         MEGDNN_DISPATCH_CPU_KERN_OPR(memcpy(dst.raw_ptr(), src.raw_ptr(), sz));
         return;
     }
+    if (dispatch_strided(handle(), src, dst)) {
+        return;
+    }
     memcpy_policy_t cpy_noncont2cont = memcpy_noncont2cont;
     memcpy_policy_t cpy_cont2noncont = memcpy_cont2noncont;
     bool is_bit4 = src.layout.dtype.enumv() == DTypeEnum::QuantizedS4 ||
@@ -2,8 +2,8 @@
 
 #include <cstring>
 #include <numeric>
-#include "src/common/tile_repeat_helper.h"
 #include "src/common/utils.h"
+#include "src/fallback/copy_helper.h"
 #include "src/naive/handle.h"
 
 namespace megdnn {
@@ -17,49 +17,56 @@ size_t RepeatImpl::get_workspace_in_bytes(
 
 void RepeatImpl::exec(
         _megdnn_tensor_in src_, _megdnn_tensor_out dst_, _megdnn_workspace workspace) {
+    if (src_.layout.dtype.is_low_bit()) {
+        return naive::RepeatForwardImpl::exec(src_, dst_, workspace);
+    }
     check_exec(src_.layout, dst_.layout, workspace.size);
     TensorShape src, dst, times;
     simplify_shape(src_.layout, dst_.layout, param().times, src, dst, times);
     auto nr_reduces = count_not_ones_in_shape(times);
+    size_t esize = src_.layout.dtype.size();
     if (nr_reduces == 0) {
         MEGDNN_DISPATCH_CPU_KERN_OPR(std::memcpy(
-                dst_.raw_ptr(), src_.raw_ptr(), sizeof(float) * dst.total_nr_elems()));
+                dst_.raw_ptr(), src_.raw_ptr(), esize * dst.total_nr_elems()));
         return;
     }
 
-    auto kern = [=]() {
-        auto ndim = times.ndim;
-        WorkspaceBundle workspaces(
-                workspace.raw_ptr, {dst.total_nr_elems() * sizeof(float),
-                                    dst.total_nr_elems() * sizeof(float)});
-        auto workspace0 = static_cast<float*>(workspaces.get(0));
-        auto workspace1 = static_cast<float*>(workspaces.get(1));
-
-        float *current, *next;
-        size_t state;
-
-        init_tile_repeat_state(
-                src_.ptr<dt_float32>(), dst_.ptr<dt_float32>(), workspace0, workspace1,
-                current, next, state, nr_reduces);
-
-        for (size_t i = ndim; i > 0; --i) {
-            size_t j = i - 1;
-            if (times.shape[j] != 1) {
-                // m = sshape[0]*...*sshape[i-1]
-                auto m = std::accumulate(
-                        src.shape, src.shape + i, 1_z, SafeMultiplies<size_t>());
-                // n = dshape[i]*...
-                auto n = std::accumulate(
-                        dst.shape + i, dst.shape + ndim, 1_z, SafeMultiplies<size_t>());
-                // forward is repeat (m, n) to (m*times, n)
-                tile_or_repeat_single_axis(current, next, m, n, times[j]);
-                update_tile_repeat_state(
-                        src_.ptr<dt_float32>(), dst_.ptr<dt_float32>(), workspace0,
-                        workspace1, current, next, state, nr_reduces);
-            }
-        }
-    };
-    MEGDNN_DISPATCH_CPU_KERN_OPR(kern());
+    // each axis is a step reading the output of the previous step, and the rows
+    // of a step are distributed to the threads
+    auto ndim = times.ndim;
+    size_t nr_threads = get_nr_threads(handle()), step = 0;
+    for (size_t i = ndim; i > 0; --i) {
+        size_t j = i - 1;
+        if (times.shape[j] == 1)
+            continue;
+        // m = sshape[0]*...*sshape[i-1]
+        auto m = std::accumulate(
+                src.shape, src.shape + i, 1_z, SafeMultiplies<size_t>());
+        // n = dshape[i]*...
+        auto n = std::accumulate(
+                dst.shape + i, dst.shape + ndim, 1_z, SafeMultiplies<size_t>());
+        size_t nr_times = times[j], row_bytes = n * esize;
+        size_t nr_tasks = get_nr_copy_tasks(m, m * row_bytes * nr_times, nr_threads);
+        size_t rows_per_task = div_ceil(m, nr_tasks);
+        nr_tasks = div_ceil(m, rows_per_task);
+        auto kern = [=](size_t task_id, size_t) {
+            WorkspaceBundle workspaces(
+                    workspace.raw_ptr, {dst.total_nr_elems() * esize,
+                                        dst.total_nr_elems() * esize});
+            auto bufs = tile_repeat_step_buffers(
+                    static_cast<const dt_byte*>(src_.raw_ptr()),
+                    static_cast<dt_byte*>(dst_.raw_ptr()),
+                    static_cast<dt_byte*>(workspaces.get(0)),
+                    static_cast<dt_byte*>(workspaces.get(1)), step, nr_reduces);
+            size_t begin = task_id * rows_per_task;
+            // forward is repeat (m, n) to (m*times, n)
+            tile_or_repeat_rows(
+                    bufs.first, bufs.second, row_bytes, nr_times, begin,
+                    std::min(begin + rows_per_task, m));
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
+        ++step;
+    }
 }
 
 }  // namespace fallback
@@ -1,146 +1,85 @@
 #include "src/fallback/softmax/opr_impl.h"
+#include <algorithm>
 #include <cstring>
-#include <numeric>
-#include "src/fallback/elemwise/gi_impl/gi_mathfun.h"
+#include <limits>
+#include "src/fallback/softmax/softmax_kern.h"
 #include "src/naive/handle.h"
 
 namespace megdnn {
 namespace fallback {
 
-static void do_softmax(
-        const float* sptr, float* dptr, size_t A, size_t B, size_t C,
-        _megdnn_workspace workspace) {
-    constexpr auto float_min = std::numeric_limits<float>::min();
-    constexpr auto step = GI_SIMD_LEN_BYTE / sizeof(float);
-    // TODO: When C=2,3,4..., src_ptr span is relatively large, the performance may
-    // be poor
+namespace {
 
-    if (C != 1) {
-        WorkspaceBundle workspace_bundle{
-                workspace.raw_ptr, {A * C * sizeof(float), A * C * sizeof(float)}};
-        float* max = workspace_bundle.get_workspace(0).raw_ptr->as<float>();
-        GI_FLOAT32_t v_max = GiBroadcastFloat32(float_min);
-        size_t i = 0;
-        for (; i + step <= A * C; i += step)
-            GiStoreFloat32(max + i, v_max);
-        for (; i < A * C; i++)
-            max[i] = float_min;
-
-        for (size_t a = 0; a < A; a++) {
-            for (size_t b = 0; b < B; b++) {
-                auto max_ptr = max + a * C;
-                auto limit = max_ptr + C;
-                auto src_ptr = sptr + a * B * C + b * C;
+//! minimal number of elements normalized by a task
+constexpr size_t SOFTMAX_TASK_ELEMS = 16 * 1024;
 
-                for (; max_ptr + step <= limit; max_ptr += step, src_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    GI_FLOAT32_t v_max = GiLoadFloat32(max_ptr);
-                    v_max = GiMaximumFloat32(v_max, v_p);
-                    GiStoreFloat32(max_ptr, v_max);
-                }
-                for (; max_ptr < limit; ++max_ptr, ++src_ptr) {
-                    *max_ptr = std::max(*src_ptr, *max_ptr);
-                }
-            }
+/*!
+ * softmax along B of one [B, C] slice, max and sum are C floats of workspace;
+ * every step along B handles a vector of columns
+ */
+void softmax_columns(
+        const float* sptr, float* dptr, size_t B, size_t C, float* max, float* sum) {
+    constexpr auto lowest = std::numeric_limits<float>::lowest();
+    constexpr auto step = GI_SIMD_LEN_BYTE / sizeof(float);
+    std::fill_n(max, C, lowest);
+    for (size_t b = 0; b < B; b++) {
+        auto max_ptr = max;
+        auto limit = max_ptr + C;
+        auto src_ptr = sptr + b * C;
+
+        for (; max_ptr + step <= limit; max_ptr += step, src_ptr += step) {
+            GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
+            GI_FLOAT32_t v_max = GiLoadFloat32(max_ptr);
+            v_max = GiMaximumFloat32(v_max, v_p);
+            GiStoreFloat32(max_ptr, v_max);
         }
-
-        float* sum = workspace_bundle.get_workspace(1).raw_ptr->as<float>();
-        memset(sum, 0, A * C * sizeof(float));
-        for (size_t a = 0; a < A; a++) {
-            for (size_t b = 0; b < B; b++) {
-                auto max_ptr = max + a * C;
-                auto limit = max_ptr + C;
-                auto sum_ptr = sum + a * C;
-                auto src_ptr = sptr + a * B * C + C * b;
-                auto dst_ptr = dptr + a * B * C + C * b;
-                for (; max_ptr + step <= limit; max_ptr += step, sum_ptr += step,
-                                                src_ptr += step, dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    GI_FLOAT32_t v_max = GiLoadFloat32(max_ptr);
-                    GI_FLOAT32_t v_sum = GiLoadFloat32(sum_ptr);
-                    v_p = GiExpPsFloat32(GiSubtractFloat32(v_p, v_max));
-                    v_sum = GiAddFloat32(v_p, v_sum);
-                    GiStoreFloat32(dst_ptr, v_p);
-                    GiStoreFloat32(sum_ptr, v_sum);
-                }
-                for (; max_ptr < limit; ++max_ptr, ++sum_ptr, ++src_ptr, ++dst_ptr) {
-                    *dst_ptr = exp(*src_ptr - *max_ptr);
-                    *sum_ptr += *dst_ptr;
-                }
-            }
+        for (; max_ptr < limit; ++max_ptr, ++src_ptr) {
+            *max_ptr = std::max(*src_ptr, *max_ptr);
         }
+    }
 
-        for (size_t a = 0; a < A; a++) {
-            for (size_t b = 0; b < B; b++) {
-                auto sum_ptr = sum + a * C;
-                auto limit = sum_ptr + C;
-                auto dst_ptr = dptr + a * B * C + C * b;
-                for (; sum_ptr + step <= limit; sum_ptr += step, dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(dst_ptr);
-                    GI_FLOAT32_t v_sum = GiLoadFloat32(sum_ptr);
-                    v_p = GiDivideFloat32(v_p, v_sum);
-                    GiStoreFloat32(dst_ptr, v_p);
-                }
-                for (; sum_ptr < limit; ++sum_ptr, ++dst_ptr)
-                    *dst_ptr = *dst_ptr / *sum_ptr;
-            }
+    memset(sum, 0, C * sizeof(float));
+    for (size_t b = 0; b < B; b++) {
+        auto max_ptr = max;
+        auto limit = max_ptr + C;
+        auto sum_ptr = sum;
+        auto src_ptr = sptr + C * b;
+        auto dst_ptr = dptr + C * b;
+        for (; max_ptr + step <= limit; max_ptr += step, sum_ptr += step,
+                                        src_ptr += step, dst_ptr += step) {
+            GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
+            GI_FLOAT32_t v_max = GiLoadFloat32(max_ptr);
+            GI_FLOAT32_t v_sum = GiLoadFloat32(sum_ptr);
+            v_p = GiExpPsFloat32(GiSubtractFloat32(v_p, v_max));
+            v_sum = GiAddFloat32(v_p, v_sum);
+            GiStoreFloat32(dst_ptr, v_p);
+            GiStoreFloat32(sum_ptr, v_sum);
         }
-    } else {
-        for (size_t a = 0; a < A; a++) {
-            auto max = float_min;
-            {
-                auto src_ptr = sptr + a * B;
-                auto limit = src_ptr + B;
-                GI_FLOAT32_t v_max = GiBroadcastFloat32(max);
-
-                for (; src_ptr + step <= limit; src_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    v_max = GiMaximumFloat32(v_max, v_p);
-                }
-                max = std::max(max, GiReduceMaxNanFloat32(v_max));
-                for (; src_ptr < limit; ++src_ptr) {
-                    max = std::max(*src_ptr, max);
-                }
-            }
-
-            auto sum = 0.f;
-            {
-                auto src_ptr = sptr + a * B;
-                auto limit = src_ptr + B;
-                auto dst_ptr = dptr + a * B;
-                GI_FLOAT32_t v_sum = GiZeroFloat32();
-                GI_FLOAT32_t v_max = GiBroadcastFloat32(max);
+        for (; max_ptr < limit; ++max_ptr, ++sum_ptr, ++src_ptr, ++dst_ptr) {
+            *dst_ptr = exp(*src_ptr - *max_ptr);
+            *sum_ptr += *dst_ptr;
+        }
+    }
 
-                for (; src_ptr + step <= limit; src_ptr += step, dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(src_ptr);
-                    v_p = GiExpPsFloat32(GiSubtractFloat32(v_p, v_max));
-                    GiStoreFloat32(dst_ptr, v_p);
-                    v_sum = GiAddFloat32(v_sum, v_p);
-                }
-                sum += GiReduceAddFloat32(v_sum);
-                for (; src_ptr < limit; ++src_ptr, ++dst_ptr) {
-                    *dst_ptr = exp(*src_ptr - max);
-                    sum += *dst_ptr;
-                }
-            }
-            {
-                auto dst_ptr = dptr + a * B;
-                auto limit = dst_ptr + B;
-                sum = 1 / sum;
-                GI_FLOAT32_t v_sum = GiBroadcastFloat32(sum);
-                for (; dst_ptr + step <= limit; dst_ptr += step) {
-                    GI_FLOAT32_t v_p = GiLoadFloat32(dst_ptr);
-                    v_p = GiMultiplyFloat32(v_p, v_sum);
-                    GiStoreFloat32(dst_ptr, v_p);
-                }
-                for (; dst_ptr < limit; ++dst_ptr) {
-                    *dst_ptr *= sum;
-                }
-            }
+    for (size_t c = 0; c < C; ++c) {
+        sum[c] = 1.f / sum[c];
+    }
+    for (size_t b = 0; b < B; b++) {
+        auto sum_ptr = sum;
+        auto limit = sum_ptr + C;
+        auto dst_ptr = dptr + C * b;
+        for (; sum_ptr + step <= limit; sum_ptr += step, dst_ptr += step) {
+            GI_FLOAT32_t v_p = GiLoadFloat32(dst_ptr);
+            GI_FLOAT32_t v_sum = GiLoadFloat32(sum_ptr);
+            GiStoreFloat32(dst_ptr, GiMultiplyFloat32(v_p, v_sum));
         }
+        for (; sum_ptr < limit; ++sum_ptr, ++dst_ptr)
+            *dst_ptr = *dst_ptr * *sum_ptr;
     }
 }
 
+}  // namespace
+
 void SoftmaxForwardImpl::exec(
         _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_workspace workspace) {
     auto axis = param().axis;
@@ -160,7 +99,34 @@ void SoftmaxForwardImpl::exec(
 
     size_t A, B, C;
     reduce::get_ABC(src.layout, A, B, C, axis);
-    MEGDNN_DISPATCH_CPU_KERN_OPR(do_softmax(sptr, dptr, A, B, C, workspace));
+    if (!A || !B || !C) {
+        return;
+    }
+    if (C != 1) {
+        // TODO: When C=2,3,4..., src_ptr span is relatively large, the performance
+        // may be poor
+        WorkspaceBundle workspace_bundle{
+                workspace.raw_ptr, {A * C * sizeof(float), A * C * sizeof(float)}};
+        float* max = workspace_bundle.get_workspace(0).raw_ptr->as<float>();
+        float* sum = workspace_bundle.get_workspace(1).raw_ptr->as<float>();
+        auto kern = [=](size_t a, size_t) {
+            softmax_columns(
+                    sptr + a * B * C, dptr + a * B * C, B, C, max + a * C,
+                    sum + a * C);
+        };
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, A);
+        return;
+    }
+
+    size_t rows_per_task = std::max<size_t>(SOFTMAX_TASK_ELEMS / B, 1);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t begin = task_id * rows_per_task,
+               end = std::min(A, begin + rows_per_task);
+        for (size_t a = begin; a < end; ++a) {
+            softmax::softmax_row(sptr + a * B, dptr + a * B, B);
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, div_ceil(A, rows_per_task));
 }
 
 }  // namespace fallback
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "src/fallback/elemwise/gi_impl/gi_mathfun.h"
+
+namespace megdnn {
+namespace fallback {
+namespace softmax {
+
+constexpr size_t SIMD_WIDTH = GI_SIMD_LEN_BYTE / sizeof(float);
+
+//! load x * scale + mask, mask may be null
+GI_FORCEINLINE GI_FLOAT32_t
+load_scaled(const float* src, const float* mask, size_t i, float scale) {
+    GI_FLOAT32_t x = GiMultiplyScalerFloat32(GiLoadFloat32(src + i), scale);
+    return mask ? GiAddFloat32(x, GiLoadFloat32(mask + i)) : x;
+}
+
+/*!
+ * x = x * scale + mask in place, mask may be null; return the max of x
+ */
+inline float scale_mask_max(float* x, size_t len, float scale, const float* mask) {
+    float max = -std::numeric_limits<float>::infinity();
+    size_t i = 0;
+    if (len >= SIMD_WIDTH) {
+        GI_FLOAT32_t vmax = GiBroadcastFloat32(max);
+        for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+            GI_FLOAT32_t v = load_scaled(x, mask, i, scale);
+            GiStoreFloat32(x + i, v);
+            vmax = GiMaximumFloat32(vmax, v);
+        }
+        max = GiReduceMaxNanFloat32(vmax);
+    }
+    for (; i < len; ++i) {
+        x[i] = x[i] * scale + (mask ? mask[i] : 0.f);
+        max = std::max(max, x[i]);
+    }
+    return max;
+}
+
+//! x = exp(x - max) in place, return the sum
+inline float exp_sub_max(float* x, size_t len, float max) {
+    GI_FLOAT32_t vmax = GiBroadcastFloat32(max);
+    GI_FLOAT32_t vsum = GiZeroFloat32();
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+        GI_FLOAT32_t v = GiExpPsFloat32(GiSubtractFloat32(GiLoadFloat32(x + i), vmax));
+        GiStoreFloat32(x + i, v);
+        vsum = GiAddFloat32(vsum, v);
+    }
+    float sum = GiReduceAddFloat32(vsum);
+    for (; i < len; ++i) {
+        x[i] = std::exp(x[i] - max);
+        sum += x[i];
+    }
+    return sum;
+}
+
+/*!
+ * max and sum of exp(x - max) of x = src * scale + mask, reading src once
+ *
+ * Every lane keeps its own running max and sum. A new element costs one exp:
+ * exp(-|x - max|) either rescales the sum when x becomes the new max or is
+ * added to it otherwise. The lanes are merged at the end.
+ */
+inline void online_max_sum(
+        const float* src, size_t len, float scale, const float* mask, float& max,
+        float& sum) {
+    //! lowest instead of -inf, so that a masked -inf never yields inf - inf
+    constexpr float lowest = std::numeric_limits<float>::lowest();
+    float m = lowest, s = 0.f;
+    size_t i = 0;
+    if (len >= SIMD_WIDTH) {
+        GI_FLOAT32_t vmax = GiBroadcastFloat32(lowest);
+        GI_FLOAT32_t vsum = GiZeroFloat32();
+        GI_FLOAT32_t vone = GiBroadcastFloat32(1.f);
+        for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+            GI_FLOAT32_t x = load_scaled(src, mask, i, scale);
+            GI_FLOAT32_t e = GiExpPsFloat32(
+                    GiNegFloat32(GiAbsFloat32(GiSubtractFloat32(x, vmax))));
+            GI_UINT32_t grow = GiGreaterThanFloat32(x, vmax);
+            vsum = GiBSLFloat32(
+                    grow, GiMultiplyAddFloat32(vone, vsum, e), GiAddFloat32(vsum, e));
+            vmax = GiMaximumFloat32(vmax, x);
+        }
+        float lane_max[SIMD_WIDTH], lane_sum[SIMD_WIDTH];
+        GiStoreFloat32(lane_max, vmax);
+        GiStoreFloat32(lane_sum, vsum);
+        for (size_t k = 0; k < SIMD_WIDTH; ++k) {
+            m = std::max(m, lane_max[k]);
+        }
+        for (size_t k = 0; k < SIMD_WIDTH; ++k) {
+            s += lane_sum[k] * std::exp(lane_max[k] - m);
+        }
+    }
+    for (; i < len; ++i) {
+        float x = src[i] * scale + (mask ? mask[i] : 0.f);
+        if (x > m) {
+            s = s * std::exp(m - x) + 1.f;
+            m = x;
+        } else {
+            s += std::exp(x - m);
+        }
+    }
+    max = m;
+    sum = s;
+}
+
+/*!
+ * dst = softmax(src * scale + mask) over a contiguous row in two passes: the
+ * online max and sum, then the normalized exp; mask may be null
+ */
+inline void softmax_row(
+        const float* src, float* dst, size_t len, float scale = 1.f,
+        const float* mask = nullptr) {
+    float max, sum;
+    online_max_sum(src, len, scale, mask, max, sum);
+    float inv = 1.f / sum;
+    GI_FLOAT32_t vmax = GiBroadcastFloat32(max);
+    size_t i = 0;
+    for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+        GI_FLOAT32_t x = GiExpPsFloat32(
+                GiSubtractFloat32(load_scaled(src, mask, i, scale), vmax));
+        GiStoreFloat32(dst + i, GiMultiplyScalerFloat32(x, inv));
+    }
+    for (; i < len; ++i) {
+        dst[i] = std::exp(src[i] * scale + (mask ? mask[i] : 0.f) - max) * inv;
+    }
+}
+
+}  // namespace softmax
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -1,38 +1,19 @@
 #include "src/fallback/split/opr_impl.h"
 
-#include <cstring>
 #include <numeric>
 #include "src/common/utils.h"
+#include "src/fallback/copy_helper.h"
 #include "src/naive/handle.h"
 
-namespace megdnn {
-namespace fallback {
-namespace split {
-
-void exec_generic(
-        const TensorND& src, const TensorNDArray& dsts, size_t A, size_t B, size_t C,
-        size_t* Bv) {
-    rep(a, A) {
-        size_t b = 0u;
-        rep(i, dsts.size()) {
-            auto sptr = src.ptr<dt_float32>() + (a * B + b) * C;
-            auto dptr = dsts[i].ptr<dt_float32>() + a * Bv[i] * C;
-            std::memcpy(dptr, sptr, sizeof(float) * (Bv[i] * C));
-            b += Bv[i];
-        }
-    }
-}
-
-}  // namespace split
-}  // namespace fallback
-}  // namespace megdnn
-
 namespace megdnn {
 namespace fallback {
 
 void SplitImpl::exec(
         _megdnn_tensor_in src, _megdnn_out const TensorNDArray& dsts,
         _megdnn_workspace workspace) {
+    if (src.layout.dtype.is_low_bit()) {
+        return naive::SplitForwardImpl::exec(src, dsts, workspace);
+    }
     auto dsts_layout = apply_vector<TensorLayout>(m_get_layout, dsts);
     auto dsts_shape = apply_vector<TensorShape>(m_get_shape, dsts_layout);
     check_exec(src.layout, dsts_layout, workspace.size);
@@ -40,7 +21,36 @@ void SplitImpl::exec(
     size_t A, B, C;
     get_ABC(dsts_shape, A, Bv, C);
     B = std::accumulate(Bv, Bv + dsts.size(), 0u);
-    MEGDNN_DISPATCH_CPU_KERN_OPR(split::exec_generic(src, dsts, A, B, C, Bv));
+
+    // a unit copies a row of src to a dst, and the units are split into tasks
+    size_t nr_dsts = dsts.size(), esize = src.layout.dtype.size();
+    size_t nr_units = A * nr_dsts;
+    size_t nr_tasks = get_nr_copy_tasks(
+            nr_units, A * B * C * esize, get_nr_threads(handle()));
+    size_t units_per_task = div_ceil(nr_units, nr_tasks);
+    nr_tasks = div_ceil(nr_units, units_per_task);
+    auto kern = [=](size_t task_id, size_t) {
+        size_t begin = task_id * units_per_task,
+               end = std::min(begin + units_per_task, nr_units);
+        size_t a = begin / nr_dsts, i = begin % nr_dsts, b = 0;
+        for (size_t k = 0; k < i; ++k) {
+            b += Bv[k];
+        }
+        auto sptr = static_cast<const dt_byte*>(src.raw_ptr());
+        for (size_t unit = begin; unit < end; ++unit) {
+            size_t size = Bv[i] * C * esize;
+            copy_bytes(
+                    static_cast<dt_byte*>(dsts[i].raw_ptr()) + a * size,
+                    sptr + (a * B + b) * C * esize, size);
+            b += Bv[i];
+            if (++i == nr_dsts) {
+                i = 0;
+                b = 0;
+                ++a;
+            }
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(kern, nr_tasks);
 }
 
 }  // namespace fallback
@@ -0,0 +1,147 @@
+#include "src/fallback/structured_sparse_matrix_mul/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/fallback/general_intrinsic/gi_float.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+namespace {
+
+constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+//! vectors of accumulators along the activation rows
+constexpr size_t NR_ACC = 8;
+//! activation rows transposed together
+constexpr size_t ROW_BLOCK = NR_ACC * SIMD_STEP;
+//! weight rows computed by one task
+constexpr size_t COL_BLOCK = 64;
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+struct SparseRow {
+    const float* values;
+    const uint8_t* indices;
+    size_t nr_groups, sparse_n, sparse_m;
+};
+
+//! dst is (k, ROW_BLOCK)
+void transpose_rows(const float* src, size_t k, float* dst) {
+    for (size_t r = 0; r < ROW_BLOCK; ++r) {
+        const float* row = src + r * k;
+        for (size_t c = 0; c < k; ++c) {
+            dst[c * ROW_BLOCK + r] = row[c];
+        }
+    }
+}
+
+//! ROW_BLOCK outputs of one weight row from the transposed activations
+void compute_block(
+        const float* at, const SparseRow& w, float* dst, size_t dst_stride) {
+    GI_FLOAT32_FIXLEN_t acc[NR_ACC];
+    for (size_t i = 0; i < NR_ACC; ++i) {
+        acc[i] = GiFloat32Type2FixLenType(GiBroadcastFloat32(0.f));
+    }
+    const float* val = w.values;
+    const uint8_t* idx = w.indices;
+    for (size_t g = 0; g < w.nr_groups; ++g) {
+        const float* group = at + g * w.sparse_m * ROW_BLOCK;
+        for (size_t j = 0; j < w.sparse_n; ++j) {
+            const float* col = group + (*idx++) * ROW_BLOCK;
+            GI_FLOAT32_t v = GiBroadcastFloat32(*val++);
+            for (size_t i = 0; i < NR_ACC; ++i) {
+                acc[i] = GiFloat32Type2FixLenType(GiMlaqFloat32(
+                        GiFixLenType2GiFloat32Type(acc[i]),
+                        GiLoadFloat32(col + i * SIMD_STEP), v));
+            }
+        }
+    }
+    float out[ROW_BLOCK];
+    for (size_t i = 0; i < NR_ACC; ++i) {
+        GiStoreFloat32(out + i * SIMD_STEP, GiFixLenType2GiFloat32Type(acc[i]));
+    }
+    for (size_t r = 0; r < ROW_BLOCK; ++r) {
+        dst[r * dst_stride] = out[r];
+    }
+}
+
+//! one output of an activation row, gathering it by the weight positions
+float compute_single(const float* a, const SparseRow& w) {
+    const float* val = w.values;
+    const uint8_t* idx = w.indices;
+    float sum = 0.f;
+    for (size_t g = 0; g < w.nr_groups; ++g) {
+        const float* group = a + g * w.sparse_m;
+        for (size_t j = 0; j < w.sparse_n; ++j) {
+            sum += group[*idx++] * (*val++);
+        }
+    }
+    return sum;
+}
+
+}  // namespace
+
+size_t StructuredSparseMatrixMulImpl::get_workspace_in_bytes(
+        const TensorLayout& A, const TensorLayout&, const TensorLayout&,
+        const TensorLayout&) {
+    size_t k = A[A.ndim - 1];
+    if (A.total_nr_elems() / k < ROW_BLOCK) {
+        return 0;
+    }
+    //! one block of transposed activations for each thread
+    return get_nr_threads(handle()) * k * ROW_BLOCK * sizeof(float);
+}
+
+void StructuredSparseMatrixMulImpl::exec(
+        _megdnn_tensor_in A, _megdnn_tensor_in values, _megdnn_tensor_in indices,
+        _megdnn_tensor_out C, _megdnn_workspace workspace) {
+    check_exec(A.layout, values.layout, indices.layout, C.layout, workspace.size);
+    size_t n = values.layout[0], nnz = values.layout[1];
+    size_t k = A.layout[A.layout.ndim - 1];
+    size_t m = A.layout.total_nr_elems() / k;
+    size_t sparse_n = param().sparse_n, sparse_m = param().sparse_m;
+    size_t nr_row_blocks = div_ceil(m, ROW_BLOCK);
+    size_t nr_col_blocks = div_ceil(n, COL_BLOCK);
+    auto a_ptr = A.ptr<dt_float32>();
+    auto v_ptr = values.ptr<dt_float32>();
+    auto i_ptr = indices.ptr<dt_uint8>();
+    auto c_ptr = C.ptr<dt_float32>();
+    auto buf = workspace.ptr<float>();
+    auto run = [=](size_t index, size_t thread_id) {
+        size_t m_begin = index / nr_col_blocks * ROW_BLOCK;
+        size_t m_end = std::min(m, m_begin + ROW_BLOCK);
+        size_t n_begin = index % nr_col_blocks * COL_BLOCK;
+        size_t n_end = std::min(n, n_begin + COL_BLOCK);
+        auto get_row = [&](size_t ni) {
+            return SparseRow{
+                    v_ptr + ni * nnz, i_ptr + ni * nnz, k / sparse_m, sparse_n,
+                    sparse_m};
+        };
+        if (m_end - m_begin == ROW_BLOCK) {
+            float* at = buf + thread_id * k * ROW_BLOCK;
+            transpose_rows(a_ptr + m_begin * k, k, at);
+            for (size_t ni = n_begin; ni < n_end; ++ni) {
+                compute_block(at, get_row(ni), c_ptr + m_begin * n + ni, n);
+            }
+            return;
+        }
+        for (size_t ni = n_begin; ni < n_end; ++ni) {
+            SparseRow row = get_row(ni);
+            for (size_t mi = m_begin; mi < m_end; ++mi) {
+                c_ptr[mi * n + ni] = compute_single(a_ptr + mi * k, row);
+            }
+        }
+    };
+    //! the kernels index A by the indices unchecked, so validate them up front;
+    //! the dispatcher runs kernels in order, so this finishes before any task
+    MEGDNN_DISPATCH_CPU_KERN_OPR(check_indices(indices));
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, nr_row_blocks * nr_col_blocks);
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
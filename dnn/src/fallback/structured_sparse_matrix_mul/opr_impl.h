@@ -0,0 +1,30 @@
+#pragma once
+#include "src/naive/structured_sparse_matrix_mul/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief structured sparse matrix mul that only computes the kept weights
+ *
+ * Full blocks of activation rows are transposed into a per thread buffer, so
+ * each kept weight becomes a broadcast multiply-add over a contiguous column
+ * of the block held in registers. The remaining rows, which include the
+ * single row of decoding, gather their activations by the weight positions.
+ */
+class StructuredSparseMatrixMulImpl : public naive::StructuredSparseMatrixMulImpl {
+public:
+    using naive::StructuredSparseMatrixMulImpl::StructuredSparseMatrixMulImpl;
+
+    void exec(
+            _megdnn_tensor_in A, _megdnn_tensor_in values, _megdnn_tensor_in indices,
+            _megdnn_tensor_out C, _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& A, const TensorLayout& values,
+            const TensorLayout& indices, const TensorLayout& C) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,129 @@
+#include "src/fallback/topk/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+using namespace megdnn;
+using namespace fallback;
+
+namespace {
+
+//! rows longer than k times this are selected by a heap of k elements
+constexpr size_t HEAP_SELECT_RATIO = 16;
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+/*!
+ * \brief put the first k (value, index) pairs of a row in the order of cmp at
+ *      the front of wk, and sort them if needed
+ *
+ * Ties of values are broken by indices, the same as naive.
+ */
+template <typename ctype, typename Cmp>
+void select_row(
+        const ctype* row, size_t n, size_t k, bool sorted,
+        std::pair<ctype, uint32_t>* wk, Cmp cmp) {
+    using Pair = std::pair<ctype, uint32_t>;
+    if (k * HEAP_SELECT_RATIO <= n) {
+        for (size_t j = 0; j < k; ++j) {
+            wk[j] = {row[j], static_cast<uint32_t>(j)};
+        }
+        // the top of the heap is the last one of the kept pairs
+        std::make_heap(wk, wk + k, cmp);
+        for (size_t j = k; j < n; ++j) {
+            Pair cur{row[j], static_cast<uint32_t>(j)};
+            if (cmp(cur, wk[0])) {
+                std::pop_heap(wk, wk + k, cmp);
+                wk[k - 1] = cur;
+                std::push_heap(wk, wk + k, cmp);
+            }
+        }
+        if (sorted) {
+            std::sort_heap(wk, wk + k, cmp);
+        }
+        return;
+    }
+    for (size_t j = 0; j < n; ++j) {
+        wk[j] = {row[j], static_cast<uint32_t>(j)};
+    }
+    if (sorted) {
+        std::partial_sort(wk, wk + k, wk + n, cmp);
+    } else {
+        std::nth_element(wk, wk + k - 1, wk + n, cmp);
+    }
+}
+
+}  // anonymous namespace
+
+template <typename ctype>
+void TopKImpl::exec_rows(
+        int k, size_t m, size_t n, ptrdiff_t lda, const ctype* data, ctype* values,
+        int* indices, void* workspace) {
+    using Pair = std::pair<ctype, uint32_t>;
+    megdnn_assert(n <= std::numeric_limits<uint32_t>::max());
+    auto mode = param().mode;
+    size_t wk_stride = std::max(sizeof(uint32_t), sizeof(ctype)) * 2 * n;
+    auto run = [=](size_t i, size_t thread_id) {
+        auto wk = static_cast<dt_byte*>(workspace) + thread_id * wk_stride;
+        const ctype* row = data + i * lda;
+        if (mode == Param::Mode::KTH_ONLY) {
+            auto buf = reinterpret_cast<ctype*>(wk);
+            size_t kth = k < 0 ? n + k : k - 1;
+            memcpy(buf, row, sizeof(ctype) * n);
+            std::nth_element(buf, buf + kth, buf + n);
+            values[i] = buf[kth];
+            return;
+        }
+        auto pairs = reinterpret_cast<Pair*>(wk);
+        bool sorted = mode == Param::Mode::VALUE_IDX_SORTED;
+        size_t ow = std::abs(k);
+        if (k < 0) {
+            select_row(row, n, ow, sorted, pairs, std::greater<Pair>{});
+        } else {
+            select_row(row, n, ow, sorted, pairs, std::less<Pair>{});
+        }
+        for (size_t j = 0; j < ow; ++j) {
+            values[i * ow + j] = pairs[j].first;
+            indices[i * ow + j] = pairs[j].second;
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, m);
+}
+
+void TopKImpl::do_exec(
+        int k, _megdnn_tensor_in data, _megdnn_tensor_out values, int32_t* indices,
+        _megdnn_workspace workspace) {
+    size_t m = data.layout[0], n = data.layout[1];
+    ptrdiff_t lda = data.layout.stride[0];
+    switch (data.layout.dtype.enumv()) {
+#define cb(t)                                                                    \
+    case DTypeTrait<t>::enumv: {                                                 \
+        using ct = DTypeTrait<t>::ctype;                                         \
+        exec_rows<ct>(                                                           \
+                k, m, n, lda, data.ptr<ct>(), values.ptr<ct>(), indices,         \
+                workspace.raw_ptr);                                              \
+        return;                                                                  \
+    }
+        MEGDNN_FOREACH_COMPUTING_DTYPE(cb);
+#undef cb
+        default:
+            naive::TopKImpl::do_exec(k, data, values, indices, workspace);
+    }
+}
+
+size_t TopKImpl::get_workspace_in_bytes(
+        int k, const TensorLayout& data, const TensorLayout& values,
+        const TensorLayout& indices) {
+    return get_nr_threads(handle()) *
+           naive::TopKImpl::get_workspace_in_bytes(k, data, values, indices);
+}
+
+// vim: syntax=cpp.doxygen
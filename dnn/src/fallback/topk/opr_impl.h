@@ -0,0 +1,36 @@
+#pragma once
+
+#include "src/naive/topk/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief TopK on rows in parallel
+ *
+ * A small k is selected by a bounded heap in one pass over the row, while
+ * a large one falls back to nth_element/partial_sort as naive.
+ */
+class TopKImpl : public naive::TopKImpl {
+    template <typename ctype>
+    void exec_rows(
+            int k, size_t m, size_t n, ptrdiff_t lda, const ctype* data,
+            ctype* values, int* indices, void* workspace);
+
+protected:
+    void do_exec(
+            int k, _megdnn_tensor_in data, _megdnn_tensor_out values, int32_t* indices,
+            _megdnn_workspace workspace) override;
+
+public:
+    using naive::TopKImpl::TopKImpl;
+
+    size_t get_workspace_in_bytes(
+            int k, const TensorLayout& data, const TensorLayout& values,
+            const TensorLayout& indices) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
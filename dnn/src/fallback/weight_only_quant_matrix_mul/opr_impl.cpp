@@ -0,0 +1,167 @@
+#include "src/fallback/weight_only_quant_matrix_mul/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/fallback/general_intrinsic/gi_float.h"
+#include "src/fallback/general_intrinsic/gi_int.h"
+#include "src/naive/handle.h"
+
+namespace megdnn {
+namespace fallback {
+
+namespace {
+
+//! output columns computed by one task
+constexpr size_t COL_BLOCK = 16;
+constexpr size_t SIMD_STEP = GI_SIMD_LEN_BYTE / sizeof(float);
+
+size_t get_nr_threads(Handle* handle) {
+    return static_cast<naive::HandleImpl*>(handle)
+            ->megcore_dispatcher()
+            ->nr_threads();
+}
+
+void dequant_int8_group(const int8_t* src, size_t len, float scale, float* dst) {
+    size_t i = 0;
+    for (; i + GI_SIMD_LEN_BYTE <= len; i += GI_SIMD_LEN_BYTE) {
+        GI_INT8_t w8 = GiLoadInt8(src + i);
+        GI_INT16_t w16_lo = GiMoveLowLongInt8(w8);
+        GI_INT16_t w16_hi = GiMoveHighLongInt8(w8);
+        GiStoreFloat32(
+                dst + i, GiMultiplyScalerFloat32(
+                                 GiCastToFloat32(GiMoveLowLongInt16(w16_lo)), scale));
+        GiStoreFloat32(
+                dst + i + SIMD_STEP,
+                GiMultiplyScalerFloat32(
+                        GiCastToFloat32(GiMoveHighLongInt16(w16_lo)), scale));
+        GiStoreFloat32(
+                dst + i + 2 * SIMD_STEP,
+                GiMultiplyScalerFloat32(
+                        GiCastToFloat32(GiMoveLowLongInt16(w16_hi)), scale));
+        GiStoreFloat32(
+                dst + i + 3 * SIMD_STEP,
+                GiMultiplyScalerFloat32(
+                        GiCastToFloat32(GiMoveHighLongInt16(w16_hi)), scale));
+    }
+    for (; i < len; ++i) {
+        dst[i] = src[i] * scale;
+    }
+}
+
+//! 4 bytes sign extended to int32 lanes, store the 8 int4 values they hold
+GI_FORCEINLINE void dequant_int4_lanes(GI_INT32_t bytes, float scale, float* dst) {
+    GI_INT32_t lo = GiShiftRightInt32(GiShiftLeftInt32(bytes, 28), 28);
+    GI_INT32_t hi = GiShiftRightInt32(bytes, 4);
+    GI_FLOAT32_V2_t val;
+    GiSetSubVectorFloat32V2(
+            val, 0, GiMultiplyScalerFloat32(GiCastToFloat32(lo), scale));
+    GiSetSubVectorFloat32V2(
+            val, 1, GiMultiplyScalerFloat32(GiCastToFloat32(hi), scale));
+    GiStoreZipFloat32V2(dst, val);
+}
+
+//! \p len is the number of int4 values, low nibble first
+void dequant_int4_group(const int8_t* src, size_t len, float scale, float* dst) {
+    size_t i = 0;
+    for (; i + 2 * GI_SIMD_LEN_BYTE <= len; i += 2 * GI_SIMD_LEN_BYTE) {
+        GI_INT8_t w8 = GiLoadInt8(src + i / 2);
+        GI_INT16_t w16_lo = GiMoveLowLongInt8(w8);
+        GI_INT16_t w16_hi = GiMoveHighLongInt8(w8);
+        dequant_int4_lanes(GiMoveLowLongInt16(w16_lo), scale, dst + i);
+        dequant_int4_lanes(
+                GiMoveHighLongInt16(w16_lo), scale, dst + i + 2 * SIMD_STEP);
+        dequant_int4_lanes(
+                GiMoveLowLongInt16(w16_hi), scale, dst + i + 4 * SIMD_STEP);
+        dequant_int4_lanes(
+                GiMoveHighLongInt16(w16_hi), scale, dst + i + 6 * SIMD_STEP);
+    }
+    for (; i < len; i += 2) {
+        int8_t val = src[i / 2];
+        dst[i] = (static_cast<int8_t>(val << 4) >> 4) * scale;
+        dst[i + 1] = (val >> 4) * scale;
+    }
+}
+
+float dot(const float* a, const float* w, size_t k) {
+    GI_FLOAT32_t acc0 = GiBroadcastFloat32(0.f);
+    GI_FLOAT32_t acc1 = GiBroadcastFloat32(0.f);
+    size_t i = 0;
+    for (; i + 2 * SIMD_STEP <= k; i += 2 * SIMD_STEP) {
+        acc0 = GiMlaqFloat32(acc0, GiLoadFloat32(a + i), GiLoadFloat32(w + i));
+        acc1 = GiMlaqFloat32(
+                acc1, GiLoadFloat32(a + i + SIMD_STEP),
+                GiLoadFloat32(w + i + SIMD_STEP));
+    }
+    for (; i + SIMD_STEP <= k; i += SIMD_STEP) {
+        acc0 = GiMlaqFloat32(acc0, GiLoadFloat32(a + i), GiLoadFloat32(w + i));
+    }
+    float sum = GiReduceAddFloat32(GiAddFloat32(acc0, acc1));
+    for (; i < k; ++i) {
+        sum += a[i] * w[i];
+    }
+    return sum;
+}
+
+}  // namespace
+
+size_t WeightOnlyQuantMatrixMulImpl::get_workspace_in_bytes(
+        const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+        const TensorLayout& C) {
+    if (A.dtype.enumv() != DTypeEnum::Float32) {
+        return naive::WeightOnlyQuantMatrixMulImpl::get_workspace_in_bytes(
+                A, B, scales, C);
+    }
+    //! one dequantized weight row for each thread
+    return get_nr_threads(handle()) * B[1] * sizeof(float);
+}
+
+void WeightOnlyQuantMatrixMulImpl::exec(
+        _megdnn_tensor_in A, _megdnn_tensor_in B, _megdnn_tensor_in scales,
+        _megdnn_tensor_out C, _megdnn_workspace workspace) {
+    if (A.layout.dtype.enumv() != DTypeEnum::Float32) {
+        return naive::WeightOnlyQuantMatrixMulImpl::exec(A, B, scales, C, workspace);
+    }
+    check_exec(A.layout, B.layout, scales.layout, C.layout, workspace.size);
+    size_t n = B.layout[0], k = B.layout[1];
+    size_t m = A.layout.total_nr_elems() / k;
+    size_t group_size = param().group_size;
+    size_t nr_groups = k / group_size;
+    bool is_int4 = B.layout.dtype.enumv() == DTypeEnum::QuantizedS4;
+    float dtype_scale = 1.f;
+    if (is_int4) {
+        dtype_scale = B.layout.dtype.param<dtype::QuantizedS4>().scale;
+    }
+    //! bytes of one weight row
+    size_t row_bytes = is_int4 ? k / 2 : k;
+    auto a_ptr = A.ptr<dt_float32>();
+    auto b_ptr = static_cast<const int8_t*>(B.raw_ptr());
+    auto s_ptr = scales.ptr<dt_float32>();
+    auto c_ptr = C.ptr<dt_float32>();
+    auto buf = workspace.ptr<float>();
+    auto run = [=](size_t index, size_t thread_id) {
+        float* weight = buf + thread_id * k;
+        size_t n_end = std::min(n, (index + 1) * COL_BLOCK);
+        for (size_t ni = index * COL_BLOCK; ni < n_end; ++ni) {
+            const int8_t* row = b_ptr + ni * row_bytes;
+            for (size_t g = 0; g < nr_groups; ++g) {
+                float scale = s_ptr[ni * nr_groups + g] * dtype_scale;
+                if (is_int4) {
+                    dequant_int4_group(
+                            row + g * group_size / 2, group_size, scale,
+                            weight + g * group_size);
+                } else {
+                    dequant_int8_group(
+                            row + g * group_size, group_size, scale,
+                            weight + g * group_size);
+                }
+            }
+            for (size_t mi = 0; mi < m; ++mi) {
+                c_ptr[mi * n + ni] = dot(a_ptr + mi * k, weight, k);
+            }
+        }
+    };
+    MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, div_ceil(n, COL_BLOCK));
+}
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,30 @@
+#pragma once
+#include "src/naive/weight_only_quant_matrix_mul/opr_impl.h"
+
+namespace megdnn {
+namespace fallback {
+
+/*!
+ * \brief weight only quant matrix mul for float32 activations
+ *
+ * Each weight row is dequantized on the fly into a per thread buffer and then
+ * reused by all the activation rows, so the quantized weights are read from
+ * memory only once, which is what bounds the speed of decoding. Other dtypes
+ * are forwarded to naive.
+ */
+class WeightOnlyQuantMatrixMulImpl : public naive::WeightOnlyQuantMatrixMulImpl {
+public:
+    using naive::WeightOnlyQuantMatrixMulImpl::WeightOnlyQuantMatrixMulImpl;
+
+    void exec(
+            _megdnn_tensor_in A, _megdnn_tensor_in B, _megdnn_tensor_in scales,
+            _megdnn_tensor_out C, _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& A, const TensorLayout& B, const TensorLayout& scales,
+            const TensorLayout& C) override;
+};
+
+}  // namespace fallback
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,100 @@
+#include "src/naive/depthwise_pointwise_conv_bias/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace megdnn {
+namespace naive {
+
+namespace {
+
+using NonlineMode = param::DepthwisePointwiseConvBias::NonlineMode;
+
+float apply_nonline(float x, NonlineMode mode) {
+    switch (mode) {
+        case NonlineMode::RELU:
+            return std::max(x, 0.f);
+        case NonlineMode::SIGMOID:
+            return 1.f / (1.f + std::exp(-x));
+        case NonlineMode::H_SWISH:
+            return x * std::min(std::max(x + 3.f, 0.f), 6.f) / 6.f;
+        default:
+            return x;
+    }
+}
+
+void exec_internal(
+        const TensorND& src, const TensorND& dw_filter, const TensorND& dw_bias,
+        const TensorND& pw_filter, const TensorND& pw_bias, const TensorND& dst,
+        float* mid, const param::DepthwisePointwiseConvBias& p) {
+    size_t N = src.layout[0], CB = src.layout[1], IH = src.layout[2],
+           IW = src.layout[3];
+    size_t FH = dw_filter.layout[3], FW = dw_filter.layout[4];
+    size_t OCB = dst.layout[1], OH = dst.layout[2], OW = dst.layout[3];
+    auto sptr = src.ptr<dt_float32>();
+    auto dwf = dw_filter.ptr<dt_float32>();
+    auto dwb = dw_bias.ptr<dt_float32>();
+    auto pwf = pw_filter.ptr<dt_float32>();
+    auto pwb = pw_bias.ptr<dt_float32>();
+    auto dptr = dst.ptr<dt_float32>();
+    for (size_t n = 0; n < N; ++n) {
+        //! mid is (c / 4, oh, ow, 4)
+        for (size_t cb = 0; cb < CB; ++cb)
+            for (size_t oh = 0; oh < OH; ++oh)
+                for (size_t ow = 0; ow < OW; ++ow)
+                    for (size_t c = 0; c < 4; ++c) {
+                        float sum = dwb[cb * 4 + c];
+                        for (size_t fh = 0; fh < FH; ++fh)
+                            for (size_t fw = 0; fw < FW; ++fw) {
+                                int ih = static_cast<int>(oh * p.stride_h + fh) -
+                                         static_cast<int>(p.pad_h);
+                                int iw = static_cast<int>(ow * p.stride_w + fw) -
+                                         static_cast<int>(p.pad_w);
+                                if (ih < 0 || ih >= static_cast<int>(IH) || iw < 0 ||
+                                    iw >= static_cast<int>(IW))
+                                    continue;
+                                sum += sptr[((cb * IH + ih) * IW + iw) * 4 + c] *
+                                       dwf[((cb * FH + fh) * FW + fw) * 4 + c];
+                            }
+                        mid[((cb * OH + oh) * OW + ow) * 4 + c] =
+                                apply_nonline(sum, p.dw_nonline_mode);
+                    }
+        for (size_t ocb = 0; ocb < OCB; ++ocb)
+            for (size_t oh = 0; oh < OH; ++oh)
+                for (size_t ow = 0; ow < OW; ++ow)
+                    for (size_t oc = 0; oc < 4; ++oc) {
+                        float sum = pwb[ocb * 4 + oc];
+                        for (size_t cb = 0; cb < CB; ++cb)
+                            for (size_t ic = 0; ic < 4; ++ic) {
+                                sum += mid[((cb * OH + oh) * OW + ow) * 4 + ic] *
+                                       pwf[((ocb * CB + cb) * 4 + ic) * 4 + oc];
+                            }
+                        dptr[((ocb * OH + oh) * OW + ow) * 4 + oc] =
+                                apply_nonline(sum, p.pw_nonline_mode);
+                    }
+        sptr += CB * IH * IW * 4;
+        dptr += OCB * OH * OW * 4;
+    }
+}
+
+}  // namespace
+
+void DepthwisePointwiseConvBiasImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_in dw_filter, _megdnn_tensor_in dw_bias,
+        _megdnn_tensor_in pw_filter, _megdnn_tensor_in pw_bias,
+        _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(
+            src.layout, dw_filter.layout, dw_bias.layout, pw_filter.layout,
+            pw_bias.layout, dst.layout, workspace.size);
+    auto p = param();
+    auto mid = workspace.ptr<float>();
+    MEGDNN_DISPATCH_CPU_KERN_OPR(exec_internal(
+            src, dw_filter, dw_bias, pw_filter, pw_bias, dst, mid, p));
+}
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
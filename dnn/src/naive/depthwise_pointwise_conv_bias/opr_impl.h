@@ -0,0 +1,28 @@
+#pragma once
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace naive {
+
+class DepthwisePointwiseConvBiasImpl : public DepthwisePointwiseConvBias {
+public:
+    using DepthwisePointwiseConvBias::DepthwisePointwiseConvBias;
+
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in dw_filter,
+            _megdnn_tensor_in dw_bias, _megdnn_tensor_in pw_filter,
+            _megdnn_tensor_in pw_bias, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&,
+            const TensorLayout& dst) override {
+        //! the whole output of the channel wise conv
+        return src[0] * src[1] * dst[2] * dst[3] * 4 * sizeof(float);
+    }
+};
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
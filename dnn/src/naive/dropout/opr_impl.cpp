@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include "src/common/philox.h"
 #include "src/common/utils.h"
 #include "src/naive/handle.h"
 
@@ -12,25 +13,21 @@ namespace {
 
 using Param = megdnn::Dropout::Param;
 
-dt_float32 get_random_number(uint64_t x) {
-    union {
-        uint32_t i;
-        dt_float32 f;
-    } u;
-    u.i = (0x7F << 23) | (x >> 41);
-    return 2 - u.f;
-}
-
+//! the mask is the same as that of the cuda kernel with the same seed and offset
 template <typename T>
 void forward(
-        T* inp, T* oup, void* raw_reserved, size_t len, Xoroshiro128plus& rng,
+        T* inp, T* oup, void* raw_reserved, size_t len, uint64_t seed, uint64_t offset,
         float drop_prob) {
     uint8_t* reserved = reinterpret_cast<uint8_t*>(raw_reserved);
     float scale = 1.0f / (1.0f - drop_prob);
-    for (size_t i = 0; i < len; ++i) {
-        float rn = get_random_number(rng());
-        reserved[i] = rn < drop_prob ? 0 : 1;
-        oup[i] = static_cast<T>(reserved[i] ? static_cast<float>(inp[i]) * scale : 0.f);
+    for (size_t i = 0; i < len; i += 4) {
+        philox::Philox4x32 rand{seed, offset + i / 4};
+        for (size_t j = i; j < std::min(i + 4, len); ++j) {
+            float rn = philox::Philox4x32::uniform(rand.v[j - i]);
+            reserved[j] = rn < drop_prob ? 0 : 1;
+            oup[j] = static_cast<T>(
+                    reserved[j] ? static_cast<float>(inp[j]) * scale : 0.f);
+        }
     }
 }
 
@@ -62,14 +59,20 @@ void DropoutForwardImpl::exec(
     uint64_t seed = param().seed;
     float prob = param().drop_prob;
 
-    m_rng.ensure_seed(seed);
+    if (seed != m_seed) {
+        m_seed = seed;
+        m_offset = 0;
+    }
+    uint64_t offset = m_offset;
+    m_offset += philox::nr_counters(length);
 
-#define cb(DType)                                                                  \
-    if (inp.layout.dtype == DType()) {                                             \
-        using T = typename DTypeTrait<DType>::ctype;                               \
-        MEGDNN_DISPATCH_CPU_KERN_OPR(forward<T>(                                   \
-                inp.ptr<T>(), oup.ptr<T>(), mask.raw_ptr(), length, m_rng, prob)); \
-        return;                                                                    \
+#define cb(DType)                                                                 \
+    if (inp.layout.dtype == DType()) {                                            \
+        using T = typename DTypeTrait<DType>::ctype;                              \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(forward<T>(                                  \
+                inp.ptr<T>(), oup.ptr<T>(), mask.raw_ptr(), length, seed, offset, \
+                prob));                                                           \
+        return;                                                                   \
     }
     MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
 #undef cb
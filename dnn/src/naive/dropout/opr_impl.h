@@ -1,12 +1,12 @@
 #pragma once
 #include "megdnn/oprs.h"
-#include "src/naive/rng/opr_impl.h"
 
 namespace megdnn {
 namespace naive {
 
 class DropoutForwardImpl final : public DropoutForward {
-    Xoroshiro128plus m_rng;
+    //! counter offset of the next exec in the philox stream of m_seed
+    uint64_t m_seed = 0, m_offset = 0;
 
 public:
     using DropoutForward::DropoutForward;
@@ -0,0 +1,156 @@
+#include "src/naive/embedding_bag/opr_impl.h"
+#include <vector>
+#include "src/naive/handle.h"
+
+using namespace megdnn;
+using namespace naive;
+
+namespace {
+
+using Mode = param::EmbeddingBag::Mode;
+
+//! the range of the positions in indices of bag b
+void get_bag(
+        const dt_int32* offsets, size_t batch, size_t nr_indices, size_t b,
+        size_t& begin, size_t& end) {
+    begin = offsets[b];
+    end = b + 1 < batch ? offsets[b + 1] : nr_indices;
+    megdnn_assert(
+            begin <= end && end <= nr_indices, "bad offsets of bag %zu: [%zu, %zu)",
+            b, begin, end);
+}
+
+size_t get_row(const dt_int32* indices, size_t pos, size_t num_embeddings) {
+    auto row = indices[pos];
+    megdnn_assert(
+            row >= 0 && static_cast<size_t>(row) < num_embeddings,
+            "index %d out of range [0, %zu)", row, num_embeddings);
+    return row;
+}
+
+template <typename T>
+void forward(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices,
+        _megdnn_tensor_in offsets, const T* psw, _megdnn_tensor_out dst,
+        dt_int32* max_idx, Mode mode) {
+    size_t N = weight.layout[0], D = weight.layout[1], batch = offsets.layout[0],
+           nr_indices = indices.layout[0];
+    auto w = weight.ptr<T>();
+    auto idx = indices.ptr<dt_int32>();
+    auto off = offsets.ptr<dt_int32>();
+    auto out = dst.ptr<T>();
+    std::vector<float> acc(D);
+    for (size_t b = 0; b < batch; ++b) {
+        size_t begin, end;
+        get_bag(off, batch, nr_indices, b, begin, end);
+        std::fill(acc.begin(), acc.end(), 0.f);
+        if (mode == Mode::MAX) {
+            std::fill(max_idx + b * D, max_idx + (b + 1) * D, -1);
+        }
+        for (size_t p = begin; p < end; ++p) {
+            const T* row = w + get_row(idx, p, N) * D;
+            float scale = psw ? static_cast<float>(psw[p]) : 1.f;
+            for (size_t c = 0; c < D; ++c) {
+                float v = row[c];
+                if (mode != Mode::MAX) {
+                    acc[c] += v * scale;
+                } else if (p == begin || v > acc[c]) {
+                    acc[c] = v;
+                    max_idx[b * D + c] = p;
+                }
+            }
+        }
+        float scale = mode == Mode::MEAN && end > begin ? 1.f / (end - begin) : 1.f;
+        for (size_t c = 0; c < D; ++c) {
+            out[b * D + c] = static_cast<T>(acc[c] * scale);
+        }
+    }
+}
+
+template <typename T>
+void backward(
+        _megdnn_tensor_in diff, _megdnn_tensor_in indices, _megdnn_tensor_in offsets,
+        const T* psw, const dt_int32* max_idx, _megdnn_tensor_out grad, Mode mode) {
+    size_t N = grad.layout[0], D = grad.layout[1], batch = offsets.layout[0],
+           nr_indices = indices.layout[0];
+    auto dy = diff.ptr<T>();
+    auto idx = indices.ptr<dt_int32>();
+    auto off = offsets.ptr<dt_int32>();
+    //! the contributions to each row are summed in the order of the positions
+    std::vector<float> acc(N * D, 0.f);
+    for (size_t b = 0; b < batch; ++b) {
+        size_t begin, end;
+        get_bag(off, batch, nr_indices, b, begin, end);
+        for (size_t p = begin; p < end; ++p) {
+            float* row = acc.data() + get_row(idx, p, N) * D;
+            float scale = psw ? static_cast<float>(psw[p]) : 1.f;
+            if (mode == Mode::MEAN) {
+                scale = 1.f / (end - begin);
+            }
+            for (size_t c = 0; c < D; ++c) {
+                if (mode != Mode::MAX) {
+                    row[c] += static_cast<float>(dy[b * D + c]) * scale;
+                } else if (max_idx[b * D + c] == static_cast<dt_int32>(p)) {
+                    row[c] += static_cast<float>(dy[b * D + c]);
+                }
+            }
+        }
+    }
+    auto out = grad.ptr<T>();
+    for (size_t i = 0; i < N * D; ++i) {
+        out[i] = static_cast<T>(acc[i]);
+    }
+}
+
+}  // namespace
+
+void EmbeddingBagForwardImpl::exec(
+        _megdnn_tensor_in weight, _megdnn_tensor_in indices,
+        _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+        _megdnn_tensor_out dst, _megdnn_tensor_out max_idx,
+        _megdnn_workspace workspace) {
+    check_exec(
+            weight.layout, indices.layout, offsets.layout, per_sample_weights.layout,
+            dst.layout, max_idx.layout, workspace.size);
+    bool has_psw = has_per_sample_weights(per_sample_weights.layout);
+    auto mode = param().mode;
+    dt_int32* max_idx_ptr = mode == Mode::MAX ? max_idx.ptr<dt_int32>() : nullptr;
+#define cb(DType)                                                              \
+    if (weight.layout.dtype == DType()) {                                      \
+        using T = typename DTypeTrait<DType>::ctype;                           \
+        const T* psw = has_psw ? per_sample_weights.ptr<T>() : nullptr;        \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(forward<T>(                               \
+                weight, indices, offsets, psw, dst, max_idx_ptr, mode));       \
+        return;                                                                \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+void EmbeddingBagBackwardImpl::exec(
+        _megdnn_tensor_in diff, _megdnn_tensor_in indices,
+        _megdnn_tensor_in offsets, _megdnn_tensor_in per_sample_weights,
+        _megdnn_tensor_in max_idx, _megdnn_tensor_out grad,
+        _megdnn_workspace workspace) {
+    check_exec(
+            diff.layout, indices.layout, offsets.layout, per_sample_weights.layout,
+            max_idx.layout, grad.layout, workspace.size);
+    bool has_psw = has_per_sample_weights(per_sample_weights.layout);
+    auto mode = param().mode;
+    const dt_int32* max_idx_ptr =
+            mode == Mode::MAX ? max_idx.ptr<dt_int32>() : nullptr;
+#define cb(DType)                                                              \
+    if (grad.layout.dtype == DType()) {                                        \
+        using T = typename DTypeTrait<DType>::ctype;                           \
+        const T* psw = has_psw ? per_sample_weights.ptr<T>() : nullptr;        \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(backward<T>(                              \
+                diff, indices, offsets, psw, max_idx_ptr, grad, mode));        \
+        return;                                                                \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,115 @@
+#include "src/naive/fused_optimizer/opr_impl.h"
+#include <cmath>
+#include <vector>
+#include "src/naive/handle.h"
+
+using namespace megdnn;
+using namespace naive;
+
+namespace {
+using Param = megdnn::FusedOptimizerUpdate::Param;
+using Mode = Param::Mode;
+
+template <typename T>
+void update(
+        _megdnn_tensor_in param, _megdnn_tensor_in grad, _megdnn_tensor_in exp_avg,
+        _megdnn_tensor_in exp_avg_sq, _megdnn_tensor_in offsets,
+        _megdnn_tensor_out new_param, _megdnn_tensor_out new_exp_avg,
+        _megdnn_tensor_out new_exp_avg_sq, const Param& p) {
+    size_t total_elem = param.layout.total_nr_elems();
+    auto pptr = param.ptr<dt_float32>();
+    auto gptr = grad.ptr<T>();
+    auto mptr = exp_avg.ptr<dt_float32>();
+    auto vptr = exp_avg_sq.ptr<dt_float32>();
+    auto new_pptr = new_param.ptr<dt_float32>();
+    auto new_mptr = new_exp_avg.ptr<dt_float32>();
+    auto new_vptr = new_exp_avg_sq.ptr<dt_float32>();
+
+    if (p.mode == Mode::SGD) {
+        for (size_t i = 0; i < total_elem; ++i) {
+            float g = static_cast<float>(gptr[i]) + p.weight_decay * pptr[i];
+            if (p.momentum != 0) {
+                float buf = p.momentum * mptr[i] + g;
+                new_mptr[i] = buf;
+                g = p.nesterov ? g + p.momentum * buf : buf;
+            }
+            new_pptr[i] = pptr[i] - p.lr * g;
+        }
+        return;
+    }
+
+    float bc_1 = 1, bc_2 = 1;
+    if (p.mode != Mode::LAMB || p.bias_correction) {
+        bc_1 = 1 - std::pow(p.beta_1, p.step);
+        bc_2 = 1 - std::pow(p.beta_2, p.step);
+    }
+    std::vector<float> update(total_elem);
+    for (size_t i = 0; i < total_elem; ++i) {
+        float g = static_cast<float>(gptr[i]);
+        if (p.mode == Mode::ADAM) {
+            g += p.weight_decay * pptr[i];
+        }
+        float m = p.beta_1 * mptr[i] + (1 - p.beta_1) * g;
+        float v = p.beta_2 * vptr[i] + (1 - p.beta_2) * g * g;
+        new_mptr[i] = m;
+        new_vptr[i] = v;
+        update[i] = (m / bc_1) / (std::sqrt(v / bc_2) + p.eps);
+        if (p.mode != Mode::ADAM) {
+            update[i] += p.weight_decay * pptr[i];
+        }
+    }
+
+    std::vector<float> trust_ratio(total_elem, 1.f);
+    if (p.mode == Mode::LAMB && (p.always_adapt || p.weight_decay > 0)) {
+        auto optr = offsets.ptr<dt_int32>();
+        for (size_t t = 0; t < offsets.layout.total_nr_elems() / 2; ++t) {
+            size_t begin = optr[t * 2], end = optr[t * 2 + 1];
+            float p_norm = 0, d_norm = 0;
+            for (size_t i = begin; i < end; ++i) {
+                p_norm += pptr[i] * pptr[i];
+                d_norm += update[i] * update[i];
+            }
+            p_norm = std::sqrt(p_norm);
+            d_norm = std::sqrt(d_norm);
+            if (p_norm > 0 && d_norm > 0) {
+                for (size_t i = begin; i < end; ++i) {
+                    trust_ratio[i] = p_norm / d_norm;
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < total_elem; ++i) {
+        new_pptr[i] = pptr[i] - p.lr * trust_ratio[i] * update[i];
+    }
+}
+
+}  // namespace
+
+namespace megdnn {
+namespace naive {
+
+void FusedOptimizerUpdateImpl::exec(
+        _megdnn_tensor_in param, _megdnn_tensor_in grad, _megdnn_tensor_in exp_avg,
+        _megdnn_tensor_in exp_avg_sq, _megdnn_tensor_in offsets,
+        _megdnn_tensor_out new_param, _megdnn_tensor_out new_exp_avg,
+        _megdnn_tensor_out new_exp_avg_sq, _megdnn_workspace workspace) {
+    check_exec(
+            param.layout, grad.layout, exp_avg.layout, exp_avg_sq.layout,
+            offsets.layout, new_param.layout, new_exp_avg.layout,
+            new_exp_avg_sq.layout, workspace.size);
+#define cb(DType)                                                               \
+    if (grad.layout.dtype == DType()) {                                         \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(update<typename DTypeTrait<DType>::ctype>( \
+                param, grad, exp_avg, exp_avg_sq, offsets, new_param,           \
+                new_exp_avg, new_exp_avg_sq, this->param()));                   \
+        return;                                                                 \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,28 @@
+#pragma once
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace naive {
+
+class FusedOptimizerUpdateImpl final : public FusedOptimizerUpdate {
+public:
+    using FusedOptimizerUpdate::FusedOptimizerUpdate;
+    void exec(
+            _megdnn_tensor_in param, _megdnn_tensor_in grad, _megdnn_tensor_in exp_avg,
+            _megdnn_tensor_in exp_avg_sq, _megdnn_tensor_in offsets,
+            _megdnn_tensor_out new_param, _megdnn_tensor_out new_exp_avg,
+            _megdnn_tensor_out new_exp_avg_sq, _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+};
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,77 @@
+#include "src/naive/fused_preprocess/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <vector>
+
+namespace megdnn {
+namespace naive {
+
+namespace {
+
+using Coord = FusedPreprocess::Coord;
+
+void exec_internal(
+        const TensorND& src, const TensorND& norm, const TensorND& dst,
+        const std::vector<Coord>& hc, const std::vector<Coord>& wc, bool reverse,
+        bool nchw44) {
+    size_t N = src.layout[0], IH = src.layout[1], IW = src.layout[2],
+           C = src.layout[3];
+    size_t OH = hc.size(), OW = wc.size();
+    size_t OC = nchw44 ? round_up<size_t>(C, 4) : C;
+    auto sptr = src.ptr<dt_uint8>();
+    auto mean = norm.ptr<dt_float32>();
+    auto scale = mean + C;
+    auto dptr = dst.ptr<dt_float32>();
+    for (size_t n = 0; n < N; ++n) {
+        const uint8_t* img = sptr + n * IH * IW * C;
+        for (size_t oc = 0; oc < OC; ++oc) {
+            size_t ic = reverse ? C - 1 - oc : oc;
+            for (size_t oh = 0; oh < OH; ++oh) {
+                for (size_t ow = 0; ow < OW; ++ow) {
+                    float val = 0.f;
+                    if (oc < C) {
+                        auto at = [&](int h, int w) -> float {
+                            return img[(h * IW + w) * C + ic];
+                        };
+                        const Coord &h = hc[oh], &w = wc[ow];
+                        float top = at(h.idx0, w.idx0) * (1 - w.alpha) +
+                                    at(h.idx0, w.idx1) * w.alpha;
+                        float bottom = at(h.idx1, w.idx0) * (1 - w.alpha) +
+                                       at(h.idx1, w.idx1) * w.alpha;
+                        val = top * (1 - h.alpha) + bottom * h.alpha;
+                        val = (val - mean[oc]) * scale[oc];
+                    }
+                    size_t offset;
+                    if (nchw44) {
+                        offset = (((n * OC / 4 + oc / 4) * OH + oh) * OW + ow) * 4 +
+                                 oc % 4;
+                    } else {
+                        offset = ((n * OC + oc) * OH + oh) * OW + ow;
+                    }
+                    dptr[offset] = val;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void FusedPreprocessImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_in norm, _megdnn_tensor_out dst,
+        _megdnn_workspace workspace) {
+    check_exec(src.layout, norm.layout, dst.layout, workspace.size);
+    std::vector<Coord> hc(param().out_h), wc(param().out_w);
+    get_coords(src.layout[1], hc.size(), hc.data());
+    get_coords(src.layout[2], wc.size(), wc.data());
+    bool reverse = param().color_mode == Param::ColorMode::REVERSE;
+    bool nchw44 = param().format == Param::Format::NCHW44;
+    MEGDNN_DISPATCH_CPU_KERN_OPR(
+            exec_internal(src, norm, dst, hc, wc, reverse, nchw44));
+}
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -18,6 +18,7 @@ void forward(
         const Param& param) {
     float eps = param.eps;
     bool affine = param.affine;
+    bool rms = param.mode == Param::Mode::RMS_NORM;
     size_t A, B, C;
     megdnn::reduce::get_ABC(data.layout, A, B, C, param.axis_start, param.axis_end);
 
@@ -30,7 +31,8 @@ void forward(
                 slice_sum += value;
                 slice_sum_sqr += value * value;
             }
-            T_ACC slice_mean = static_cast<T_ACC>(slice_sum / B);
+            T_ACC slice_mean = rms ? static_cast<T_ACC>(0.0f)
+                                   : static_cast<T_ACC>(slice_sum / B);
             T_ACC slice_std = static_cast<T_ACC>(
                     sqrt(std::abs(slice_sum_sqr / B - slice_mean * slice_mean) + eps));
 
@@ -55,6 +57,7 @@ void backward(
         _megdnn_tensor_in mean, _megdnn_tensor_in rstd, _megdnn_tensor_out ddata,
         _megdnn_tensor_out dweight, _megdnn_tensor_out dbias, const Param& param) {
     bool affine = param.affine;
+    bool rms = param.mode == Param::Mode::RMS_NORM;
     size_t A, B, C;
     megdnn::reduce::get_ABC(data.layout, A, B, C, param.axis_start, param.axis_end);
 
@@ -95,7 +98,10 @@ void backward(
 
             atmp = rstd.ptr<T_ACC>()[a * C + c];
             btmp = (db * mean.ptr<T_ACC>()[a * C + c] - ds) * atmp * atmp * atmp / B;
-            ctmp = -btmp * mean.ptr<T_ACC>()[a * C + c] - db * atmp / B;
+            //! the mean is not subtracted in rms norm, so it has no gradient term
+            ctmp = rms ? static_cast<T_ACC>(0.0f)
+                       : static_cast<T_ACC>(
+                                 -btmp * mean.ptr<T_ACC>()[a * C + c] - db * atmp / B);
 
             for (size_t b = 0; b < B; b++) {
                 auto weight_v = affine ? weight.ptr<T>()[b] : static_cast<T>(1.0f);
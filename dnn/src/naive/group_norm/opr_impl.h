@@ -5,7 +5,7 @@
 namespace megdnn {
 namespace naive {
 
-class GroupNormForwardImpl final : public GroupNormForward {
+class GroupNormForwardImpl : public GroupNormForward {
 public:
     using GroupNormForward::GroupNormForward;
     void exec(
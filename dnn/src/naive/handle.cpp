@@ -24,15 +24,19 @@
 #include "src/naive/dct/opr_impl.h"
 #include "src/naive/deformable_conv/opr_impl.h"
 #include "src/naive/deformable_ps_roi_pooling/opr_impl.h"
+#include "src/naive/depthwise_pointwise_conv_bias/opr_impl.h"
 #include "src/naive/diag/opr_impl.h"
 #include "src/naive/dot/opr_impl.h"
 #include "src/naive/dropout/opr_impl.h"
 #include "src/naive/elemwise/opr_impl.h"
 #include "src/naive/elemwise_multi_type/opr_impl.h"
+#include "src/naive/embedding_bag/opr_impl.h"
 #include "src/naive/eye/opr_impl.h"
 #include "src/naive/fake_quant/opr_impl.h"
 #include "src/naive/fill/opr_impl.h"
 #include "src/naive/flip/opr_impl.h"
+#include "src/naive/fused_optimizer/opr_impl.h"
+#include "src/naive/fused_preprocess/opr_impl.h"
 #include "src/naive/gaussian_blur/opr_impl.h"
 #include "src/naive/general_norm/opr_impl.h"
 #include "src/naive/group_local/opr_impl.h"
@@ -40,6 +44,7 @@
 #include "src/naive/images2neibs/opr_impl.h"
 #include "src/naive/indexing_multi_axis_vec/opr_impl.h"
 #include "src/naive/indexing_one_hot/opr_impl.h"
+#include "src/naive/kv_cache/opr_impl.h"
 #include "src/naive/lamb/opr_impl.h"
 #include "src/naive/layer_norm/opr_impl.h"
 #include "src/naive/linspace/opr_impl.h"
@@ -82,6 +87,7 @@
 #include "src/naive/sliding_window_transpose/opr_impl.h"
 #include "src/naive/softmax/opr_impl.h"
 #include "src/naive/split/opr_impl.h"
+#include "src/naive/structured_sparse_matrix_mul/opr_impl.h"
 #include "src/naive/svd/opr_impl.h"
 #include "src/naive/tensor_remap/opr_impl.h"
 #include "src/naive/tile/opr_impl.h"
@@ -91,6 +97,7 @@
 #include "src/naive/type_cvt/opr_impl.h"
 #include "src/naive/warp_affine/opr_impl.h"
 #include "src/naive/warp_perspective/opr_impl.h"
+#include "src/naive/weight_only_quant_matrix_mul/opr_impl.h"
 #include "src/naive/where/opr_impl.h"
 
 namespace megdnn {
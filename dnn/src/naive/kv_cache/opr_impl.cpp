@@ -0,0 +1,167 @@
+#include "src/naive/kv_cache/opr_impl.h"
+#include <cmath>
+#include <vector>
+#include "src/naive/handle.h"
+
+using namespace megdnn;
+using namespace naive;
+
+namespace {
+
+//! copy a head of \p head_dim channels, rotating the first \p rotary_dim ones
+template <typename T>
+void rotate(
+        const T* src, T* dst, size_t head_dim, size_t rotary_dim, float base,
+        int pos) {
+    size_t half = rotary_dim / 2;
+    for (size_t i = 0; i < half; ++i) {
+        float inv_freq = std::pow(base, -2.f * i / rotary_dim);
+        float angle = pos * inv_freq;
+        float c = std::cos(angle), s = std::sin(angle);
+        float x1 = src[i], x2 = src[i + half];
+        dst[i] = x1 * c - x2 * s;
+        dst[i + half] = x2 * c + x1 * s;
+    }
+    for (size_t i = rotary_dim; i < head_dim; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+template <typename T>
+void append(
+        _megdnn_tensor_in qkv, _megdnn_tensor_in positions,
+        _megdnn_tensor_in block_table, _megdnn_tensor_inout k_cache,
+        _megdnn_tensor_inout v_cache, _megdnn_tensor_out q,
+        const KVCacheAppend::Param& p) {
+    size_t B = qkv.layout[0], T_ = qkv.layout[1], H = p.num_heads,
+           D = k_cache.layout[3], BS = k_cache.layout[2],
+           M = block_table.layout[1], NB = k_cache.layout[0];
+    auto src = qkv.ptr<T>();
+    auto pos = positions.ptr<dt_int32>();
+    auto table = block_table.ptr<dt_int32>();
+    auto kptr = k_cache.ptr<T>();
+    auto vptr = v_cache.ptr<T>();
+    auto qptr = q.ptr<T>();
+    for (size_t b = 0; b < B; ++b) {
+        for (size_t t = 0; t < T_; ++t) {
+            int cur = pos[b] + t;
+            size_t blk = cur / BS, off = cur % BS;
+            megdnn_assert(blk < M, "kv cache of sequence %zu is full", b);
+            size_t phys = table[b * M + blk];
+            megdnn_assert(phys < NB, "bad block id %zu", phys);
+            const T* row = src + (b * T_ + t) * 3 * H * D;
+            for (size_t h = 0; h < H; ++h) {
+                size_t cache_off = ((phys * H + h) * BS + off) * D;
+                rotate(row + h * D, qptr + ((b * H + h) * T_ + t) * D, D,
+                       p.rotary_dim, p.rotary_base, cur);
+                rotate(row + (H + h) * D, kptr + cache_off, D, p.rotary_dim,
+                       p.rotary_base, cur);
+                rotate(row + (2 * H + h) * D, vptr + cache_off, D, 0, 0, cur);
+            }
+        }
+    }
+}
+
+template <typename T>
+void attention(
+        _megdnn_tensor_in q, _megdnn_tensor_in k_cache, _megdnn_tensor_in v_cache,
+        _megdnn_tensor_in positions, _megdnn_tensor_in block_table,
+        _megdnn_tensor_out dst, float scale) {
+    size_t B = q.layout[0], H = q.layout[1], T_ = q.layout[2], D = q.layout[3],
+           BS = k_cache.layout[2], M = block_table.layout[1];
+    auto qptr = q.ptr<T>();
+    auto kptr = k_cache.ptr<T>();
+    auto vptr = v_cache.ptr<T>();
+    auto pos = positions.ptr<dt_int32>();
+    auto table = block_table.ptr<dt_int32>();
+    auto dptr = dst.ptr<T>();
+    if (scale == 0) {
+        scale = 1.f / std::sqrt(static_cast<float>(D));
+    }
+    std::vector<float> score;
+    for (size_t b = 0; b < B; ++b) {
+        for (size_t h = 0; h < H; ++h) {
+            for (size_t t = 0; t < T_; ++t) {
+                size_t len = pos[b] + t + 1;
+                megdnn_assert(len <= M * BS, "kv cache of sequence %zu is full", b);
+                const T* qrow = qptr + ((b * H + h) * T_ + t) * D;
+                auto cache_off = [&](size_t j) {
+                    size_t phys = table[b * M + j / BS];
+                    return ((phys * H + h) * BS + j % BS) * D;
+                };
+                score.resize(len);
+                float max_score = -INFINITY;
+                for (size_t j = 0; j < len; ++j) {
+                    const T* krow = kptr + cache_off(j);
+                    float s = 0;
+                    for (size_t d = 0; d < D; ++d) {
+                        s += static_cast<float>(qrow[d]) * static_cast<float>(krow[d]);
+                    }
+                    score[j] = s * scale;
+                    max_score = std::max(max_score, score[j]);
+                }
+                float sum = 0;
+                for (size_t j = 0; j < len; ++j) {
+                    score[j] = std::exp(score[j] - max_score);
+                    sum += score[j];
+                }
+                T* out = dptr + (b * T_ + t) * H * D + h * D;
+                for (size_t d = 0; d < D; ++d) {
+                    float acc = 0;
+                    for (size_t j = 0; j < len; ++j) {
+                        acc += score[j] * static_cast<float>(vptr[cache_off(j) + d]);
+                    }
+                    out[d] = acc / sum;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+namespace megdnn {
+namespace naive {
+
+void KVCacheAppendImpl::exec(
+        _megdnn_tensor_in qkv, _megdnn_tensor_in positions,
+        _megdnn_tensor_in block_table, _megdnn_tensor_inout k_cache,
+        _megdnn_tensor_inout v_cache, _megdnn_tensor_out q,
+        _megdnn_workspace workspace) {
+    check_exec(
+            qkv.layout, positions.layout, block_table.layout, k_cache.layout,
+            v_cache.layout, q.layout, workspace.size);
+#define cb(DType)                                                                 \
+    if (qkv.layout.dtype == DType()) {                                            \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(append<typename DTypeTrait<DType>::ctype>(   \
+                qkv, positions, block_table, k_cache, v_cache, q, this->param())); \
+        return;                                                                   \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+void KVCacheAttentionImpl::exec(
+        _megdnn_tensor_in q, _megdnn_tensor_in k_cache, _megdnn_tensor_in v_cache,
+        _megdnn_tensor_in positions, _megdnn_tensor_in block_table,
+        _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(
+            q.layout, k_cache.layout, v_cache.layout, positions.layout,
+            block_table.layout, dst.layout, workspace.size);
+#define cb(DType)                                                                  \
+    if (q.layout.dtype == DType()) {                                               \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(attention<typename DTypeTrait<DType>::ctype>( \
+                q, k_cache, v_cache, positions, block_table, dst,                  \
+                this->param().scale));                                             \
+        return;                                                                    \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+}
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,42 @@
+#pragma once
+#include "megdnn/oprs.h"
+#include "src/common/utils.h"
+
+namespace megdnn {
+namespace naive {
+
+class KVCacheAppendImpl final : public KVCacheAppend {
+public:
+    using KVCacheAppend::KVCacheAppend;
+    void exec(
+            _megdnn_tensor_in qkv, _megdnn_tensor_in positions,
+            _megdnn_tensor_in block_table, _megdnn_tensor_inout k_cache,
+            _megdnn_tensor_inout v_cache, _megdnn_tensor_out q,
+            _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+};
+
+class KVCacheAttentionImpl final : public KVCacheAttention {
+public:
+    using KVCacheAttention::KVCacheAttention;
+    void exec(
+            _megdnn_tensor_in q, _megdnn_tensor_in k_cache, _megdnn_tensor_in v_cache,
+            _megdnn_tensor_in positions, _megdnn_tensor_in block_table,
+            _megdnn_tensor_out dst, _megdnn_workspace workspace) override;
+
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+};
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
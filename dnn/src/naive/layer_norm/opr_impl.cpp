@@ -54,6 +54,18 @@ void forward(
     }
 }
 
+template <typename T, typename T_ACC = float>
+void residual_forward(
+        _megdnn_tensor_in data, _megdnn_tensor_in residual, _megdnn_tensor_in weight,
+        _megdnn_tensor_in bias, _megdnn_tensor_out dst, _megdnn_tensor_out sum,
+        _megdnn_tensor_out mean, _megdnn_tensor_out rstd, const Param& param) {
+    size_t nr_elems = data.layout.total_nr_elems();
+    for (size_t i = 0; i < nr_elems; ++i) {
+        sum.ptr<T>()[i] = data.ptr<T>()[i] + residual.ptr<T>()[i];
+    }
+    forward<T, T_ACC>(sum, weight, bias, dst, mean, rstd, param);
+}
+
 template <typename T, typename T_ACC = float>
 void backward(
         _megdnn_tensor_in diff, _megdnn_tensor_in data, _megdnn_tensor_in weight,
@@ -139,6 +151,30 @@ void LayerNormForwardImpl::exec(
 #endif
 }
 
+void ResidualLayerNormForwardImpl::exec(
+        _megdnn_tensor_in data, _megdnn_tensor_in residual, _megdnn_tensor_in weight,
+        _megdnn_tensor_in bias, _megdnn_tensor_out dst, _megdnn_tensor_out sum,
+        _megdnn_tensor_out mean, _megdnn_tensor_out rstd, _megdnn_workspace workspace) {
+#if !MGE_BUILD_WITHOUT_NAIVE_EXEC
+    check_exec(
+            data.layout, residual.layout, weight.layout, bias.layout, dst.layout,
+            sum.layout, mean.layout, rstd.layout, workspace.size);
+#define cb(DType)                                                           \
+    if (data.layout.dtype == DType()) {                                     \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(                                       \
+                residual_forward<typename DTypeTrait<DType>::ctype>(        \
+                        data, residual, weight, bias, dst, sum, mean, rstd, \
+                        param()));                                          \
+        return;                                                             \
+    }
+    MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+    megdnn_throw("bad dtype");
+#else
+    __builtin_trap();
+#endif
+}
+
 void LayerNormBackwardImpl::exec(
         _megdnn_tensor_in diff, _megdnn_tensor_in data, _megdnn_tensor_in weight,
         _megdnn_tensor_in mean, _megdnn_tensor_in rstd, _megdnn_tensor_out ddata,
@@ -4,7 +4,7 @@
 namespace megdnn {
 namespace naive {
 
-class LayerNormForwardImpl final : public LayerNormForward {
+class LayerNormForwardImpl : public LayerNormForward {
 public:
     using LayerNormForward::LayerNormForward;
     void exec(
@@ -18,6 +18,22 @@ public:
     }
 };
 
+class ResidualLayerNormForwardImpl final : public ResidualLayerNormForward {
+public:
+    using ResidualLayerNormForward::ResidualLayerNormForward;
+    void exec(
+            _megdnn_tensor_in data, _megdnn_tensor_in residual,
+            _megdnn_tensor_in weight, _megdnn_tensor_in bias, _megdnn_tensor_out dst,
+            _megdnn_tensor_out sum, _megdnn_tensor_out mean, _megdnn_tensor_out rstd,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&, const TensorLayout&,
+            const TensorLayout&, const TensorLayout&) override {
+        return 0;
+    }
+};
+
 class LayerNormBackwardImpl final : public LayerNormBackward {
 public:
     using LayerNormBackward::LayerNormBackward;
@@ -209,7 +209,7 @@ void exec_matrix_mul_quint4x4x32_helper(
             static_cast<dt_int32*>(C), M, N, K, LDA, LDB, LDC, nA.layout.dtype,
             nB.layout.dtype);
 }
-template <bool transA, bool transB>
+template <bool transA, bool transB, typename dst_type>
 void exec_matrix_mul_qint4x4x16_helper(
         const void* A, const void* B, void* C, void* workspace, size_t M, size_t N,
         size_t K, ptrdiff_t LDA, ptrdiff_t LDB, ptrdiff_t LDC, DType A_type,
@@ -254,9 +254,9 @@ void exec_matrix_mul_qint4x4x16_helper(
     };
     convert_4to8(tensorA, nA);
     convert_4to8(tensorB, nB);
-    run_matrix_mul_tpl<int8_t, dt_int16, transA, transB, dt_int16>(
+    run_matrix_mul_tpl<int8_t, dst_type, transA, transB, dst_type>(
             nA.compatible_ptr<int8_t>(), nB.compatible_ptr<int8_t>(),
-            static_cast<dt_int16*>(C), M, N, K, LDA, LDB, LDC, nA.layout.dtype,
+            static_cast<dst_type*>(C), M, N, K, LDA, LDB, LDC, nA.layout.dtype,
             nB.layout.dtype);
 }
 
@@ -306,6 +306,16 @@ void dispatch_ta_tb(
         } else if (compute_mode == Param::ComputeMode::FLOAT32) {
             cb(dt_bfloat16, dt_bfloat16, dt_float32);
         }
+#endif
+    } else if (A_type == dtype::Float8E4M3() && C_type == dtype::Float32()) {
+        cb(dt_float8_e4m3, dt_float32, dt_float32);
+    } else if (A_type == dtype::Float8E5M2() && C_type == dtype::Float32()) {
+        cb(dt_float8_e5m2, dt_float32, dt_float32);
+#if !MEGDNN_DISABLE_FLOAT16
+    } else if (A_type == dtype::Float8E4M3() && C_type == dtype::Float16()) {
+        cb(dt_float8_e4m3, dt_float16, dt_float32);
+    } else if (A_type == dtype::Float8E5M2() && C_type == dtype::Float16()) {
+        cb(dt_float8_e5m2, dt_float16, dt_float32);
 #endif
     } else if (A_type == dtype::Int8() && C_type == dtype::Int16()) {
         cb(dt_int8, dt_int16, dt_int16);
@@ -331,7 +341,15 @@ void dispatch_ta_tb(
             A_type.enumv() == DTypeEnum::QuantizedS4 &&
             C_type.enumv() == DTypeEnum::QuantizedS16 &&
             format == param::MatrixMul::Format::DEFAULT) {
-        exec_matrix_mul_qint4x4x16_helper<TA, TB>(
+        exec_matrix_mul_qint4x4x16_helper<TA, TB, dt_int16>(
+                A, B, C, workspace, M, N, K, LDA, LDB, LDC, A_type, B_type, C_type,
+                format, compute_mode);
+        return;
+    } else if (
+            A_type.enumv() == DTypeEnum::QuantizedS4 &&
+            C_type.enumv() == DTypeEnum::QuantizedS32 &&
+            format == param::MatrixMul::Format::DEFAULT) {
+        exec_matrix_mul_qint4x4x16_helper<TA, TB, dt_int32>(
                 A, B, C, workspace, M, N, K, LDA, LDB, LDC, A_type, B_type, C_type,
                 format, compute_mode);
         return;
@@ -717,9 +717,13 @@ void RelayoutFormatImpl::exec(
         }
     }
 
-    // do relayout
-    if (src.layout.dtype.enumv() == DTypeEnum::Quantized8Asymm &&
-        dst.layout.dtype.enumv() == DTypeEnum::QuantizedS8) {
+    // do relayout, the copy kernels below are only needed to requantize
+    if (exec_src_nd.layout.dtype == exec_dst_nd.layout.dtype &&
+        !exec_src_nd.layout.dtype.is_low_bit()) {
+        m_handle->relayout_opr()->exec(exec_src_nd, exec_dst_nd, handle());
+    } else if (
+            src.layout.dtype.enumv() == DTypeEnum::Quantized8Asymm &&
+            dst.layout.dtype.enumv() == DTypeEnum::QuantizedS8) {
         check_layout_and_canonize(exec_src_nd.layout, exec_dst_nd.layout);
         MEGDNN_DISPATCH_CPU_KERN(
                 m_handle, do_copy_diff_qu8_q8(exec_dst_nd, exec_src_nd));
@@ -174,6 +174,66 @@ void fill_multinomial(
     }
 }
 
+template <typename U>
+void fill_logits_sampling(
+        Xoroshiro128plus* rng, const U* logits, dt_int32* dst, size_t num_groups,
+        size_t len_logits, const param::LogitsSamplingRNG& param) {
+    std::vector<float> x(len_logits), weight(len_logits);
+    std::vector<size_t> order(len_logits);
+    for (size_t i = 0; i < num_groups; ++i) {
+        for (size_t j = 0; j < len_logits; ++j) {
+            x[j] = static_cast<float>(logits[i * len_logits + j]) / param.temperature;
+        }
+        // sort by the logits in descending order, a token is kept only if all the
+        // tokens before it with a different logit are kept
+        for (size_t j = 0; j < len_logits; ++j) {
+            order[j] = j;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return x[a] > x[b];
+        });
+        float max_x = x[order[0]];
+        size_t nr_kept = len_logits;
+        if (param.top_k && param.top_k < len_logits) {
+            nr_kept = param.top_k;
+            while (nr_kept < len_logits && x[order[nr_kept]] == x[order[nr_kept - 1]])
+                ++nr_kept;
+        }
+        float sum = 0;
+        for (size_t j = 0; j < nr_kept; ++j) {
+            sum += std::exp(x[order[j]] - max_x);
+        }
+        if (param.top_p < 1) {
+            float mass = 0;
+            size_t j = 0;
+            while (j < nr_kept && mass < param.top_p * sum) {
+                size_t k = j;
+                for (; k < nr_kept && x[order[k]] == x[order[j]]; ++k) {
+                    mass += std::exp(x[order[k]] - max_x);
+                }
+                j = k;
+            }
+            nr_kept = j;
+        }
+
+        std::fill(weight.begin(), weight.end(), 0.f);
+        float kept_sum = 0;
+        for (size_t j = 0; j < nr_kept; ++j) {
+            weight[order[j]] = std::exp(x[order[j]] - max_x);
+            kept_sum += weight[order[j]];
+        }
+        float target = uniform_sample<float>(rng) * kept_sum, cumsum = 0;
+        dst[i] = order[0];
+        for (size_t j = 0; j < len_logits; ++j) {
+            cumsum += weight[j];
+            if (weight[j] > 0 && target <= cumsum) {
+                dst[i] = j;
+                break;
+            }
+        }
+    }
+}
+
 template <typename T, typename U>
 void fill_poisson(Xoroshiro128plus* rng, U* dst, U* lam, size_t size) {
     for (size_t i = 0; i < size; ++i) {
@@ -429,6 +489,36 @@ size_t MultinomialRNGImpl::get_workspace_in_bytes(
     return 0;
 }
 
+void LogitsSamplingRNGImpl::exec(
+        _megdnn_tensor_in logits, _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(logits.layout, dst.layout, workspace.size);
+    auto prng = &m_rng.ensure_seed(m_param.seed);
+    size_t num_groups = logits.layout.shape[0];
+    size_t len_logits = logits.layout.shape[1];
+    auto param = m_param;
+    switch (logits.layout.dtype.enumv()) {
+#define cb(_dt)                                                                 \
+    case DTypeTrait<_dt>::enumv: {                                              \
+        using ctype = DTypeTrait<_dt>::ctype;                                   \
+        MEGDNN_DISPATCH_CPU_KERN_OPR({                                          \
+            fill_logits_sampling(                                               \
+                    prng, logits.ptr<ctype>(), dst.ptr<dt_int32>(), num_groups, \
+                    len_logits, param);                                         \
+        };);                                                                    \
+        return;                                                                 \
+    }
+        MEGDNN_FOREACH_COMPUTING_DTYPE_FLOAT(cb)
+#undef cb
+        default:
+            megdnn_throw("bad dtype");
+    }
+}
+
+size_t LogitsSamplingRNGImpl::get_workspace_in_bytes(
+        const TensorLayout&, const TensorLayout&) {
+    return 0;
+}
+
 void PoissonRNGImpl::exec(
         _megdnn_tensor_in lam, _megdnn_tensor_inout dst, _megdnn_workspace workspace) {
     check_exec(lam.layout, dst.layout, workspace.size);
@@ -130,6 +130,17 @@ public:
     size_t get_workspace_in_bytes(const TensorLayout&, const TensorLayout&) override;
 };
 
+class LogitsSamplingRNGImpl : public LogitsSamplingRNG {
+    Xoroshiro128plus m_rng;
+
+public:
+    using LogitsSamplingRNG::LogitsSamplingRNG;
+
+    void exec(_megdnn_tensor_in logits, _megdnn_tensor_out dst, _megdnn_workspace)
+            override;
+    size_t get_workspace_in_bytes(const TensorLayout&, const TensorLayout&) override;
+};
+
 class ShuffleRNGForwardImpl : public ShuffleRNGForward {
     Xoroshiro128plus m_rng;
 
@@ -0,0 +1,55 @@
+#include "src/naive/structured_sparse_matrix_mul/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <vector>
+
+namespace megdnn {
+namespace naive {
+
+namespace {
+
+void exec_internal(
+        const TensorND& A, const TensorND& values, const TensorND& indices,
+        const TensorND& C, size_t sparse_n, size_t sparse_m) {
+    size_t n = values.layout[0], nnz = values.layout[1];
+    size_t k = A.layout[A.layout.ndim - 1];
+    size_t m = A.layout.total_nr_elems() / k;
+    auto a_ptr = A.ptr<dt_float32>();
+    auto v_ptr = values.ptr<dt_float32>();
+    auto i_ptr = indices.ptr<dt_uint8>();
+    auto c_ptr = C.ptr<dt_float32>();
+    std::vector<float> weight(k);
+    for (size_t ni = 0; ni < n; ++ni) {
+        std::fill(weight.begin(), weight.end(), 0.f);
+        for (size_t i = 0; i < nnz; ++i) {
+            size_t pos = i_ptr[ni * nnz + i];
+            weight[i / sparse_n * sparse_m + pos] += v_ptr[ni * nnz + i];
+        }
+        for (size_t mi = 0; mi < m; ++mi) {
+            float sum = 0.f;
+            for (size_t ki = 0; ki < k; ++ki) {
+                sum += a_ptr[mi * k + ki] * weight[ki];
+            }
+            c_ptr[mi * n + ni] = sum;
+        }
+    }
+}
+
+}  // namespace
+
+void StructuredSparseMatrixMulImpl::exec(
+        _megdnn_tensor_in A, _megdnn_tensor_in values, _megdnn_tensor_in indices,
+        _megdnn_tensor_out C, _megdnn_workspace workspace) {
+    check_exec(A.layout, values.layout, indices.layout, C.layout, workspace.size);
+    size_t sparse_n = param().sparse_n, sparse_m = param().sparse_m;
+    MEGDNN_DISPATCH_CPU_KERN_OPR({
+        check_indices(indices);
+        exec_internal(A, values, indices, C, sparse_n, sparse_m);
+    });
+}
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
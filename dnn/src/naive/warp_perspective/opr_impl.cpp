@@ -510,7 +510,8 @@ void WarpPerspectiveForwardImpl::kern_naive_dimshuffle_typecvt(
         uint8_t zero_point = 0;
         float scale = 1.f;
 
-        bool is_dst_float = kern_param.dst_dtype.enumv() == DTypeEnum::Float32;
+        bool is_dst_float = kern_param.dst_dtype.enumv() == DTypeEnum::Float32 ||
+                            kern_param.dst_dtype.enumv() == DTypeEnum::Float16;
         if (kern_param.src_dtype.enumv() == DTypeTrait<dtype::Quantized8Asymm>::enumv) {
             auto dtype_param =
                     kern_param.src_dtype.template param<dtype::Quantized8Asymm>();
@@ -614,6 +615,9 @@ void WarpPerspectiveForwardImpl::kern_naive_dimshuffle_typecvt(
 
 INST(uint8_t, int8_t, float);
 INST(uint8_t, float, float);
+#if !MEGDNN_DISABLE_FLOAT16
+INST(uint8_t, dt_float16, float);
+#endif
 
 #undef INST
 
@@ -794,6 +798,15 @@ void WarpPerspectiveForwardImpl::exec(
             };
             MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, kparam.oh * batch);
             return;
+#if !MEGDNN_DISABLE_FLOAT16
+        } else if (dst.layout.dtype.enumv() == DTypeTrait<dtype::Float16>::enumv) {
+            auto run = [kparam, this](size_t index, size_t) {
+                kern_naive_dimshuffle_typecvt<uint8_t, dt_float16, float>(
+                        kparam, index);
+            };
+            MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN_OPR(run, kparam.oh * batch);
+            return;
+#endif
         } else if (
                 dst.layout.dtype.enumv() == DTypeTrait<dtype::QuantizedS8>::enumv &&
                 dst.layout.dtype.param<dtype::QuantizedS8>().scale == scale) {
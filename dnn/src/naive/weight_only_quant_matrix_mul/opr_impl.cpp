@@ -0,0 +1,79 @@
+#include "src/naive/weight_only_quant_matrix_mul/opr_impl.h"
+#include "src/common/utils.h"
+#include "src/naive/handle.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace megdnn {
+namespace naive {
+
+namespace {
+
+//! the n-th row of B as int8, low nibble first for QuantizedS4
+void unpack_weight_row(const TensorND& B, size_t n, int8_t* dst) {
+    size_t k = B.layout[1];
+    if (B.layout.dtype.enumv() == DTypeEnum::Int8) {
+        auto src = B.ptr<dt_int8>() + n * k;
+        std::copy(src, src + k, dst);
+        return;
+    }
+    auto src = static_cast<const int8_t*>(B.raw_ptr()) + n * k / 2;
+    for (size_t i = 0; i < k; i += 2) {
+        int8_t val = src[i / 2];
+        dst[i] = static_cast<int8_t>(val << 4) >> 4;
+        dst[i + 1] = val >> 4;
+    }
+}
+
+template <typename ctype>
+void exec_internal(
+        const TensorND& A, const TensorND& B, const TensorND& scales,
+        const TensorND& C, size_t group_size) {
+    size_t n = B.layout[0], k = B.layout[1];
+    size_t m = A.layout.total_nr_elems() / k;
+    float dtype_scale = 1.f;
+    if (B.layout.dtype.enumv() == DTypeEnum::QuantizedS4) {
+        dtype_scale = B.layout.dtype.param<dtype::QuantizedS4>().scale;
+    }
+    auto a_ptr = A.ptr<ctype>();
+    auto s_ptr = scales.ptr<ctype>();
+    auto c_ptr = C.ptr<ctype>();
+    std::vector<int8_t> weight(k);
+    for (size_t ni = 0; ni < n; ++ni) {
+        unpack_weight_row(B, ni, weight.data());
+        auto row_scales = s_ptr + ni * (k / group_size);
+        for (size_t mi = 0; mi < m; ++mi) {
+            float sum = 0.f;
+            for (size_t ki = 0; ki < k; ++ki) {
+                float scale = static_cast<float>(row_scales[ki / group_size]);
+                sum += static_cast<float>(a_ptr[mi * k + ki]) * weight[ki] * scale;
+            }
+            c_ptr[mi * n + ni] = static_cast<ctype>(sum * dtype_scale);
+        }
+    }
+}
+
+}  // namespace
+
+void WeightOnlyQuantMatrixMulImpl::exec(
+        _megdnn_tensor_in A, _megdnn_tensor_in B, _megdnn_tensor_in scales,
+        _megdnn_tensor_out C, _megdnn_workspace workspace) {
+    check_exec(A.layout, B.layout, scales.layout, C.layout, workspace.size);
+    size_t group_size = param().group_size;
+#define cb(DType)                                                   \
+    if (A.layout.dtype == DType()) {                                \
+        using ctype = typename DTypeTrait<DType>::ctype;            \
+        MEGDNN_DISPATCH_CPU_KERN_OPR(                               \
+                exec_internal<ctype>(A, B, scales, C, group_size)); \
+        return;                                                     \
+    }
+    cb(dtype::Float32) DNN_INC_FLOAT16(cb(dtype::Float16))
+#undef cb
+    megdnn_throw("unsupported activation dtype of weight only quant matrix mul");
+}
+
+}  // namespace naive
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
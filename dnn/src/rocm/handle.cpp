@@ -29,6 +29,7 @@
 #include "src/rocm/relayout/opr_impl.h"
 #include "src/rocm/rng/opr_impl.h"
 #include "src/rocm/sleep/opr_impl.h"
+#include "src/rocm/softmax/opr_impl.h"
 #include "src/rocm/topk/opr_impl.h"
 #include "src/rocm/type_cvt/opr_impl.h"
 
@@ -178,6 +179,8 @@ MEGDNN_SPECIALIZE_CREATE_OPERATOR(BNForward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(BNBackward);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(ParamPackConcat);
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Fill);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(SoftmaxForward);
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(SoftmaxBackward);
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpragmas"
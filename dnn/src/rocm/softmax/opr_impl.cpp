@@ -0,0 +1,68 @@
+#include "hcc_detail/hcc_defs_prologue.h"
+
+#include "src/rocm/softmax/opr_impl.h"
+#include "src/rocm/handle.h"
+#include "src/rocm/utils.h"
+
+using namespace megdnn;
+using namespace rocm;
+
+namespace {
+
+/*!
+ * \brief view the tensor as (N, dim, D, 1) around the softmax axis
+ *
+ * MIOpen normalizes over the C dim in the channel mode and over C, H, W in the
+ * instance mode, so the latter is only used when the axis is the last one.
+ */
+TensorLayout softmax_layout(
+        const TensorLayout& layout, int axis, miopenSoftmaxMode_t& mode) {
+    const int rank = layout.ndim;
+    if (axis < 0)
+        axis += rank;
+    megdnn_assert(axis >= 0 && axis < rank, "invalid softmax axis %d", axis);
+    size_t n = 1, d = 1;
+    for (int i = 0; i < axis; ++i)
+        n *= layout[i];
+    for (int i = axis + 1; i < rank; ++i)
+        d *= layout[i];
+    mode = axis == rank - 1 ? MIOPEN_SOFTMAX_MODE_INSTANCE
+                            : MIOPEN_SOFTMAX_MODE_CHANNEL;
+    return TensorLayout({n, layout[axis], d, 1}, layout.dtype);
+}
+
+}  // namespace
+
+void SoftmaxForwardImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_out dst, _megdnn_workspace workspace) {
+    check_exec(src.layout, dst.layout, workspace.size);
+    miopenSoftmaxMode_t mode;
+    auto layout = softmax_layout(src.layout, param().axis, mode);
+    TensorDesc src_desc, dst_desc;
+    src_desc.set(layout);
+    dst_desc.set(layout);
+    dt_float32 alpha = 1.0f, beta = 0.0f;
+    miopen_check(miopenSoftmaxForward_V2(
+            miopen_handle(this->handle()), &alpha, src_desc.desc, src.raw_ptr(), &beta,
+            dst_desc.desc, dst.raw_ptr(), MIOPEN_SOFTMAX_ACCURATE, mode));
+}
+
+void SoftmaxBackwardImpl::exec(
+        _megdnn_tensor_in src, _megdnn_tensor_in diff, _megdnn_tensor_out grad,
+        _megdnn_workspace workspace) {
+    check_exec(src.layout, diff.layout, grad.layout, workspace.size);
+    miopenSoftmaxMode_t mode;
+    auto layout = softmax_layout(src.layout, param().axis, mode);
+    TensorDesc src_desc, diff_desc, grad_desc;
+    src_desc.set(layout);
+    diff_desc.set(layout);
+    grad_desc.set(layout);
+    dt_float32 alpha = 1.0f, beta = 0.0f;
+    // like cudnn, the forward output is passed as y
+    miopen_check(miopenSoftmaxBackward_V2(
+            miopen_handle(this->handle()), &alpha, src_desc.desc, src.raw_ptr(),
+            diff_desc.desc, diff.raw_ptr(), &beta, grad_desc.desc, grad.raw_ptr(),
+            MIOPEN_SOFTMAX_ACCURATE, mode));
+}
+
+// vim: syntax=cpp.doxygen
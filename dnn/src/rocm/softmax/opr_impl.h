@@ -0,0 +1,38 @@
+#pragma once
+#include "megdnn/oprs.h"
+#include "src/rocm/miopen_wrapper.h"
+
+namespace megdnn {
+namespace rocm {
+
+class SoftmaxForwardImpl final : public SoftmaxForward {
+public:
+    using SoftmaxForward::SoftmaxForward;
+
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& /* src */, const TensorLayout& /* dst */) override {
+        return 0;
+    }
+};
+
+class SoftmaxBackwardImpl final : public SoftmaxBackward {
+public:
+    using SoftmaxBackward::SoftmaxBackward;
+
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_in diff, _megdnn_tensor_out grad,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& /* src */, const TensorLayout& /* diff */,
+            const TensorLayout& /* grad */) override {
+        return 0;
+    }
+};
+
+}  // namespace rocm
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
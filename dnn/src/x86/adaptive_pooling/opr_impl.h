@@ -0,0 +1,26 @@
+#pragma once
+#include "megdnn/oprs.h"
+
+namespace megdnn {
+namespace x86 {
+
+/*!
+ * \brief adaptive pooling by the pooling opr of the same handle
+ *
+ * So it runs the vectorized and multithreaded x86 pooling algos instead of the
+ * naive pooling.
+ */
+class AdaptivePoolingImpl final : public AdaptivePoolingForward {
+public:
+    using AdaptivePoolingForward::AdaptivePoolingForward;
+    void exec(
+            _megdnn_tensor_in src, _megdnn_tensor_out dst,
+            _megdnn_workspace workspace) override;
+    size_t get_workspace_in_bytes(
+            const TensorLayout& src, const TensorLayout& dst) override;
+};
+
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -3,6 +3,7 @@
 
 #include "src/x86/handle.h"
 
+#include "src/x86/adaptive_pooling/opr_impl.h"
 #include "src/x86/add_update/opr_impl.h"
 #include "src/x86/conv_bias/opr_impl.h"
 #include "src/x86/cvt_color/opr_impl.h"
@@ -45,6 +46,11 @@ std::unique_ptr<Opr> HandleImpl::create_operator() {
 HandleImpl::HandleImpl(megcoreComputingHandle_t computing_handle, HandleType type)
         : fallback::HandleImpl::HandleImpl(computing_handle, type) {
     disable_denorm();
+    auto detected = detect_cpu_isa_level();
+    init_cpu_isa_level(detected);
+    if (cpu_isa_level() < detected) {
+        limit_simd_type(cpu_isa_level());
+    }
 #if MEGDNN_X86_WITH_MKL
     vmlSetMode(VML_LA | VML_FTZDAZ_ON | VML_ERRMODE_ERRNO);
 #endif
@@ -63,6 +69,7 @@ size_t HandleImpl::alignment_requirement() const {
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(SeparableConv)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(SeparableFilter)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Pooling)
+MEGDNN_SPECIALIZE_CREATE_OPERATOR(AdaptivePooling)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(Local)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(LRN)
 MEGDNN_SPECIALIZE_CREATE_OPERATOR(MatrixMul)
@@ -2,6 +2,7 @@
 #include "./local_simd.h"
 
 #include "src/common/utils.h"
+#include "src/fallback/handle.h"
 #include "src/x86/utils.h"
 
 using namespace megdnn;
@@ -19,26 +20,21 @@ LocalImpl::float_noncontig_batch_kern LocalImpl::dispatch_float_noncontig_batch(
             src.stride[0] > 0 &&
             static_cast<size_t>(src.stride[0]) >= src.total_nr_elems() / src.shape[0]);
 
+    using fallback::CpuIsaLevel;
+    //! sse is the baseline of the x86 build
+    static const fallback::KernelTable<float_noncontig_batch_kern> xcorr_kerns{
+            {CpuIsaLevel::GENERIC, local_xcorr_SSE},
+            {CpuIsaLevel::X86_AVX, local_xcorr_AVX},
+            {CpuIsaLevel::X86_AVX2, local_xcorr_FMA}};
+    static const fallback::KernelTable<float_noncontig_batch_kern> conv_kerns{
+            {CpuIsaLevel::GENERIC, local_conv_SSE},
+            {CpuIsaLevel::X86_AVX, local_conv_AVX},
+            {CpuIsaLevel::X86_AVX2, local_conv_FMA}};
+    auto level = fallback::cpu_isa_level(handle());
     if (param().mode == Mode::CROSS_CORRELATION) {
-        if (is_supported(SIMDType::FMA)) {
-            return local_xcorr_FMA;
-        } else if (is_supported(SIMDType::AVX)) {
-            return local_xcorr_AVX;
-        } else if (is_supported(SIMDType::SSE)) {
-            return local_xcorr_SSE;
-        } else {
-            megdnn_throw("no fma/avx/sse detected");
-        }
+        return xcorr_kerns.get(level);
     } else {
-        if (is_supported(SIMDType::FMA)) {
-            return local_conv_FMA;
-        } else if (is_supported(SIMDType::AVX)) {
-            return local_conv_AVX;
-        } else if (is_supported(SIMDType::SSE)) {
-            return local_conv_SSE;
-        } else {
-            megdnn_throw("no fma/avx/sse detected");
-        }
+        return conv_kerns.get(level);
     }
 }
 
@@ -1,6 +1,7 @@
 #include "src/x86/lrn/opr_impl.h"
 
 #include "src/common/utils.h"
+#include "src/fallback/handle.h"
 #include "src/naive/handle.h"
 #include "src/x86/simd_helper.h"
 #include "src/x86/utils.h"
@@ -78,18 +79,15 @@ void LRNImpl::exec(
     auto N = src.layout.shape[0], C = src.layout.shape[1], H = src.layout.shape[2],
          W = src.layout.shape[3];
 
-    std::function<void(
-            const float*, float*, size_t, size_t, size_t, size_t, float, float, float)>
-            f = nullptr;
-    if (is_supported(SIMDType::FMA)) {
-        f = &lrn_single_instance<SIMDType::FMA>;
-    } else if (is_supported(SIMDType::AVX)) {
-        f = &lrn_single_instance<SIMDType::AVX>;
-    } else if (is_supported(SIMDType::SSE)) {
-        f = &lrn_single_instance<SIMDType::SSE>;
-    } else {
-        megdnn_throw("no fma/avx/sse detected");
-    }
+    using Kern = void (*)(
+            const float*, float*, size_t, size_t, size_t, size_t, float, float, float);
+    using fallback::CpuIsaLevel;
+    //! sse is the baseline of the x86 build
+    static const fallback::KernelTable<Kern> kerns{
+            {CpuIsaLevel::GENERIC, &lrn_single_instance<SIMDType::SSE>},
+            {CpuIsaLevel::X86_AVX, &lrn_single_instance<SIMDType::AVX>},
+            {CpuIsaLevel::X86_AVX2, &lrn_single_instance<SIMDType::FMA>}};
+    auto f = kerns.get(fallback::cpu_isa_level(handle()));
     auto n = param().n;
     auto k = param().k;
     auto alpha = param().alpha;
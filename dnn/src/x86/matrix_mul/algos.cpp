@@ -1,6 +1,7 @@
 #include "src/x86/matrix_mul/algos.h"
 #include "src/common/utils.h"
 #include "src/fallback/matrix_mul/gemm_impl.h"
+#include "src/x86/matrix_mul/f16/strategy.h"
 #include "src/x86/matrix_mul/f32/strategy.h"
 #include "src/x86/matrix_mul/int8/strategy.h"
 
@@ -679,4 +680,169 @@ MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL_DETAIL(
         x86::matmul::sgemm_pack_6x16_avx2, float, float, float, AlgoDataType::FLOAT32,
         DEFAULT);
 
+/*************************AlgoFloatAVX512M12N32********************/
+namespace {
+void gemm_f32_avx512_12x32(const MatrixMulImpl::KernParam& kern_param) {
+    MEGDNN_MARK_USED_VAR(kern_param);
+    MIDOUT_BEGIN(megdnn_x86_matmul_kern_avx512_12x32, midout_iv(0)) {
+        constexpr int cacheline = 64;
+        x86::matmul::sgemm_pack_12x32_avx512 strategy(
+                kern_param.M, kern_param.N, kern_param.K, kern_param.A_type,
+                kern_param.B_type, kern_param.C_type);
+
+        megdnn::matmul::GemmInterleaved<x86::matmul::sgemm_pack_12x32_avx512>(
+                kern_param.M, kern_param.N, kern_param.K, kern_param.trA,
+                kern_param.trB, strategy, cacheline)
+                .execute(
+                        kern_param.A<float>(), kern_param.LDA, kern_param.B<float>(),
+                        kern_param.LDB, kern_param.C<float>(), kern_param.LDC,
+                        kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // namespace
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoFloatAVX512M12N32::get_kern(
+        const KernSizeParam&) const {
+    return gemm_f32_avx512_12x32;
+}
+bool MatrixMulImpl::AlgoFloatAVX512M12N32::usable(
+        const KernSizeParam& kern_size_param) const {
+    return kern_size_param.A_type.enumv() == kern_size_param.B_type.enumv() &&
+           kern_size_param.A_type.enumv() == DTypeEnum::Float32 &&
+           kern_size_param.C_type.enumv() == DTypeEnum::Float32 &&
+           kern_size_param.compute_mode == Param::ComputeMode::DEFAULT &&
+           kern_size_param.format == Param::Format::DEFAULT &&
+           is_supported(SIMDType::AVX512F);
+}
+size_t MatrixMulImpl::AlgoFloatAVX512M12N32::get_workspace(
+        const KernSizeParam& kern_param) const {
+    constexpr int cacheline = 64;
+    x86::matmul::sgemm_pack_12x32_avx512 strategy(
+            kern_param.M, kern_param.N, kern_param.K, kern_param.A_type,
+            kern_param.B_type, kern_param.C_type);
+    return megdnn::matmul::GemmInterleaved<x86::matmul::sgemm_pack_12x32_avx512>(
+                   kern_param.M, kern_param.N, kern_param.K, kern_param.trA,
+                   kern_param.trB, strategy, cacheline)
+            .get_workspace_size();
+}
+
+MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL_DETAIL(
+        AlgoFloatAVX512M12N32, megdnn_x86_matmul_kern, "AlgoFloatAVX512M12N32"_hash,
+        x86::matmul::sgemm_pack_12x32_avx512, float, float, float,
+        AlgoDataType::FLOAT32, DEFAULT);
+
+/*************************AlgoF16F16CM6N16********************/
+#if !MEGDNN_DISABLE_FLOAT16
+namespace {
+void gemm_f16_f16c_6x16(const MatrixMulImpl::KernParam& kern_param) {
+    MIDOUT_BEGIN(megdnn_x86_matmul_kern, midout_iv("gemm_f16_f16c_6x16"_hash)) {
+        constexpr int cacheline = 64;
+        x86::matmul::hgemm_pack_6x16_f16c strategy(
+                kern_param.M, kern_param.N, kern_param.K, kern_param.A_type,
+                kern_param.B_type, kern_param.C_type);
+        megdnn::matmul::GemmInterleaved<x86::matmul::hgemm_pack_6x16_f16c>(
+                kern_param.M, kern_param.N, kern_param.K, kern_param.trA,
+                kern_param.trB, strategy, cacheline)
+                .execute(
+                        kern_param.A<dt_float16>(), kern_param.LDA,
+                        kern_param.B<dt_float16>(), kern_param.LDB,
+                        kern_param.C<dt_float16>(), kern_param.LDC,
+                        kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // namespace
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoF16F16CM6N16::get_kern(
+        const KernSizeParam&) const {
+    return gemm_f16_f16c_6x16;
+}
+
+bool MatrixMulImpl::AlgoF16F16CM6N16::usable(
+        const KernSizeParam& kern_size_param) const {
+    //! the accumulation is always in fp32, which also satisfies FLOAT32
+    return kern_size_param.A_type.enumv() == DTypeEnum::Float16 &&
+           kern_size_param.B_type.enumv() == DTypeEnum::Float16 &&
+           kern_size_param.C_type.enumv() == DTypeEnum::Float16 &&
+           kern_size_param.format == Param::Format::DEFAULT &&
+           is_supported(SIMDType::AVX2) && is_supported(SIMDType::FMA) &&
+           is_supported(SIMDType::F16C);
+}
+
+size_t MatrixMulImpl::AlgoF16F16CM6N16::get_workspace(
+        const KernSizeParam& kern_param) const {
+    constexpr int cacheline = 64;
+    x86::matmul::hgemm_pack_6x16_f16c strategy(
+            kern_param.M, kern_param.N, kern_param.K, kern_param.A_type,
+            kern_param.B_type, kern_param.C_type);
+    return megdnn::matmul::GemmInterleaved<x86::matmul::hgemm_pack_6x16_f16c>(
+                   kern_param.M, kern_param.N, kern_param.K, kern_param.trA,
+                   kern_param.trB, strategy, cacheline)
+            .get_workspace_size();
+}
+
+MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL_DETAIL(
+        AlgoF16F16CM6N16, megdnn_x86_matmul_kern, "AlgoF16F16CM6N16"_hash,
+        x86::matmul::hgemm_pack_6x16_f16c, dt_float16, dt_float16, float,
+        AlgoDataType::FLOAT16, DEFAULT);
+#endif
+
+/*************************AlgoInt8x8x32AMXM32N32K64********************/
+#if MEGDNN_X86_WITH_AMX
+namespace {
+void gemm_s8s8s32_amx_32x32x64(const MatrixMulImpl::KernParam& kern_param) {
+    MEGDNN_MARK_USED_VAR(kern_param);
+    MIDOUT_BEGIN(megdnn_x86_matmul_kern_amx_32x32x64, midout_iv(0)) {
+        constexpr int cacheline = 64;
+        x86::matmul::gemm_amx_s8s8s32_32x32x64 strategy(
+                kern_param.M, kern_param.N, kern_param.K, kern_param.A_type,
+                kern_param.B_type, kern_param.C_type);
+
+        megdnn::matmul::GemmInterleaved<x86::matmul::gemm_amx_s8s8s32_32x32x64>(
+                kern_param.M, kern_param.N, kern_param.K, kern_param.trA,
+                kern_param.trB, strategy, cacheline)
+                .execute(
+                        kern_param.A<dt_int8>(), kern_param.LDA,
+                        kern_param.B<dt_int8>(), kern_param.LDB,
+                        kern_param.C<dt_int32>(), kern_param.LDC,
+                        kern_param.workspace_ptr);
+    }
+    MIDOUT_END();
+}
+}  // namespace
+
+MatrixMulImpl::kern_t MatrixMulImpl::AlgoInt8x8x32AMXM32N32K64::get_kern(
+        const KernSizeParam&) const {
+    return gemm_s8s8s32_amx_32x32x64;
+}
+bool MatrixMulImpl::AlgoInt8x8x32AMXM32N32K64::usable(
+        const KernSizeParam& kern_size_param) const {
+    return kern_size_param.A_type.enumv() == kern_size_param.B_type.enumv() &&
+           ((kern_size_param.A_type.enumv() == DTypeEnum::Int8 &&
+             kern_size_param.C_type.enumv() == DTypeEnum::Int32) ||
+            (kern_size_param.A_type.enumv() == DTypeEnum::QuantizedS8 &&
+             kern_size_param.C_type.enumv() == DTypeEnum::QuantizedS32)) &&
+           kern_size_param.compute_mode == Param::ComputeMode::DEFAULT &&
+           kern_size_param.format == Param::Format::DEFAULT &&
+           is_supported(SIMDType::AMX_INT8);
+}
+size_t MatrixMulImpl::AlgoInt8x8x32AMXM32N32K64::get_workspace(
+        const KernSizeParam& kern_param) const {
+    constexpr int cacheline = 64;
+    x86::matmul::gemm_amx_s8s8s32_32x32x64 strategy(
+            kern_param.M, kern_param.N, kern_param.K, kern_param.A_type,
+            kern_param.B_type, kern_param.C_type);
+    return megdnn::matmul::GemmInterleaved<x86::matmul::gemm_amx_s8s8s32_32x32x64>(
+                   kern_param.M, kern_param.N, kern_param.K, kern_param.trA,
+                   kern_param.trB, strategy, cacheline)
+            .get_workspace_size();
+}
+
+MEGDNN_REG_GEMM_FUNC_FOR_IM2COL_IMPL_DETAIL(
+        AlgoInt8x8x32AMXM32N32K64, megdnn_x86_matmul_kern,
+        "AlgoInt8x8x32AMXM32N32K64"_hash, x86::matmul::gemm_amx_s8s8s32_32x32x64,
+        dt_int8, dt_int32, dt_int8, AlgoDataType::QINT8X8X32, DEFAULT);
+#endif
+
 // vim: syntax=cpp.doxygen
@@ -133,6 +133,43 @@ public:
     MEGDNN_DECL_ALGO_TYPE(X86_F32_6x16)
 };
 
+class MatrixMulImpl::AlgoFloatAVX512M12N32 : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "X86_F32_AVX512_12X32"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    MEGDNN_REG_GEMM_FUNC_FOR_IM2COL();
+    MEGDNN_DECL_ALGO_TYPE(X86_F32_AVX512_12X32)
+};
+
+#if !MEGDNN_DISABLE_FLOAT16
+class MatrixMulImpl::AlgoF16F16CM6N16 : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "X86_F16_F16C_6X16"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    MEGDNN_REG_GEMM_FUNC_FOR_IM2COL();
+    MEGDNN_DECL_ALGO_TYPE(X86_F16_F16C_6X16)
+};
+#endif
+
+#if MEGDNN_X86_WITH_AMX
+class MatrixMulImpl::AlgoInt8x8x32AMXM32N32K64 : public AlgoBase {
+public:
+    AlgoAttribute attribute() const override { return AlgoAttribute::REPRODUCIBLE; }
+    const char* name() const override { return "X86_INT8X8X32_AMX_32X32X64"; }
+    bool usable(const KernSizeParam&) const override;
+    size_t get_workspace(const KernSizeParam&) const override;
+    kern_t get_kern(const KernSizeParam&) const override;
+    MEGDNN_REG_GEMM_FUNC_FOR_IM2COL();
+    MEGDNN_DECL_ALGO_TYPE(X86_INT8X8X32_AMX_32X32X64)
+};
+#endif
+
 #if MEGDNN_X86_WITH_VNNI
 class MatrixMulImpl::AlgoInt8x8x32Vnni : public AlgoBase {
 public:
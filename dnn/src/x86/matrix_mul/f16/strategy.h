@@ -0,0 +1,19 @@
+#pragma once
+#include "src/fallback/matrix_mul/gemm_common.h"
+
+namespace megdnn {
+namespace x86 {
+namespace matmul {
+
+/*!
+ * fp16 storage with fp32 compute: A is unpacked to fp32 when packing, B stays
+ * fp16 in its panels and is widened by F16C in the kernel, and C is rounded
+ * back to fp16 when stored
+ */
+MEGDNN_REG_GEMM_STRATEGY_WITH_PACK_A_TYPE(
+        dt_float16, float, dt_float16, float, 6, 16, 1, false, false,
+        hgemm_pack_6x16_f16c);
+
+}  // namespace matmul
+}  // namespace x86
+}  // namespace megdnn
@@ -0,0 +1,213 @@
+#include <immintrin.h>
+
+#include "src/common/utils.h"
+#include "src/x86/matrix_mul/f16/strategy.h"
+
+using namespace megdnn;
+using namespace x86;
+
+#define DNN_F16C_TARGET
+#if !defined(__clang__)
+//! bypass gcc bug https://bugs.launchpad.net/ubuntu/+source/gcc-5/+bug/1642109
+#pragma GCC target("avx2", "fma", "f16c")
+#else
+#undef DNN_F16C_TARGET
+#define DNN_F16C_TARGET MEGDNN_ATTRIBUTE_TARGET("avx2,fma,f16c")
+#endif
+
+namespace {
+
+constexpr int MR = 6;
+constexpr int NR = 16;
+
+DNN_F16C_TARGET
+inline __m256 load_half8(const dt_float16* ptr) {
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+}
+
+DNN_F16C_TARGET
+inline void store_half8(dt_float16* ptr, __m256 val) {
+    _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(ptr),
+            _mm256_cvtps_ph(val, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+DNN_F16C_TARGET
+inline float half_to_float(dt_float16 val) {
+    return _cvtsh_ss(*reinterpret_cast<const uint16_t*>(&val));
+}
+
+DNN_F16C_TARGET
+inline dt_float16 float_to_half(float val) {
+    uint16_t bits = _cvtss_sh(val, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return *reinterpret_cast<const dt_float16*>(&bits);
+}
+
+//! out is (kmax - k0, MR) for every MR rows, zero padded after ymax
+DNN_F16C_TARGET
+void pack_A_n(
+        float* out, const dt_float16* in, int ldin, int y0, int ymax, int k0,
+        int kmax) {
+    float buf[MR][8];
+    for (int y = y0; y < ymax; y += MR) {
+        int rows = std::min(MR, ymax - y);
+        int k = k0;
+        for (; k < kmax; k += 8) {
+            int len = std::min(8, kmax - k);
+            for (int r = 0; r < MR; ++r) {
+                const dt_float16* src = in + (y + r) * ldin + k;
+                if (r >= rows) {
+                    _mm256_storeu_ps(buf[r], _mm256_setzero_ps());
+                } else if (len == 8) {
+                    _mm256_storeu_ps(buf[r], load_half8(src));
+                } else {
+                    for (int i = 0; i < len; ++i) {
+                        buf[r][i] = half_to_float(src[i]);
+                    }
+                }
+            }
+            for (int i = 0; i < len; ++i) {
+                for (int r = 0; r < MR; ++r) {
+                    *out++ = buf[r][i];
+                }
+            }
+        }
+    }
+}
+
+//! the input is (k, m), so every k holds MR consecutive rows
+DNN_F16C_TARGET
+void pack_A_t(
+        float* out, const dt_float16* in, int ldin, int y0, int ymax, int k0,
+        int kmax) {
+    for (int y = y0; y < ymax; y += MR) {
+        int rows = std::min(MR, ymax - y);
+        for (int k = k0; k < kmax; ++k) {
+            const dt_float16* src = in + k * ldin + y;
+            for (int r = 0; r < MR; ++r) {
+                *out++ = r < rows ? half_to_float(src[r]) : 0.f;
+            }
+        }
+    }
+}
+
+//! out is (kmax - k0, NR) fp16 for every NR columns, zero padded after xmax
+void pack_B_n(
+        dt_float16* out, const dt_float16* in, int ldin, int x0, int xmax, int k0,
+        int kmax) {
+    for (int x = x0; x < xmax; x += NR) {
+        int cols = std::min(NR, xmax - x);
+        for (int k = k0; k < kmax; ++k) {
+            const dt_float16* src = in + k * ldin + x;
+            std::memcpy(out, src, cols * sizeof(dt_float16));
+            std::memset(out + cols, 0, (NR - cols) * sizeof(dt_float16));
+            out += NR;
+        }
+    }
+}
+
+//! the input is (n, k)
+void pack_B_t(
+        dt_float16* out, const dt_float16* in, int ldin, int x0, int xmax, int k0,
+        int kmax) {
+    for (int x = x0; x < xmax; x += NR) {
+        int cols = std::min(NR, xmax - x);
+        for (int k = k0; k < kmax; ++k) {
+            for (int c = 0; c < NR; ++c) {
+                out[c] = c < cols ? in[(x + c) * ldin + k] : dt_float16(0.f);
+            }
+            out += NR;
+        }
+    }
+}
+
+/*!
+ * MR x NR block of C; all MR rows are computed from the zero padded panels
+ * while only \p rows x \p cols are written. The whole K is accumulated in fp32
+ * and C is rounded to fp16 only once.
+ */
+DNN_F16C_TARGET
+void kern_6x16(
+        const float* packA, const dt_float16* packB, size_t K, dt_float16* C,
+        size_t LDC, int rows, int cols) {
+    __m256 acc[MR][2];
+    for (int r = 0; r < MR; ++r) {
+        acc[r][0] = _mm256_setzero_ps();
+        acc[r][1] = _mm256_setzero_ps();
+    }
+    for (size_t k = 0; k < K; ++k) {
+        __m256 b0 = load_half8(packB);
+        __m256 b1 = load_half8(packB + 8);
+        for (int r = 0; r < MR; ++r) {
+            __m256 a = _mm256_broadcast_ss(packA + r);
+            acc[r][0] = _mm256_fmadd_ps(a, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_ps(a, b1, acc[r][1]);
+        }
+        packA += MR;
+        packB += NR;
+    }
+    for (int r = 0; r < rows; ++r) {
+        dt_float16* dst = C + r * LDC;
+        if (cols == NR) {
+            store_half8(dst, acc[r][0]);
+            store_half8(dst + 8, acc[r][1]);
+            continue;
+        }
+        float out[NR];
+        _mm256_storeu_ps(out, acc[r][0]);
+        _mm256_storeu_ps(out + 8, acc[r][1]);
+        for (int c = 0; c < cols; ++c) {
+            dst[c] = float_to_half(out[c]);
+        }
+    }
+}
+
+}  // namespace
+
+namespace megdnn {
+namespace x86 {
+namespace matmul {
+
+MEGDNN_REG_GEMM_STRATEGY_IMPL(hgemm_pack_6x16_f16c);
+
+void hgemm_pack_6x16_f16c::pack_A(
+        float* out, const dt_float16* in, int ldin, int y0, int ymax, int k0, int kmax,
+        bool transpose_A) const {
+    if (!transpose_A)
+        pack_A_n(out, in, ldin, y0, ymax, k0, kmax);
+    else
+        pack_A_t(out, in, ldin, y0, ymax, k0, kmax);
+}
+
+void hgemm_pack_6x16_f16c::pack_B(
+        dt_float16* out, const dt_float16* in, int ldin, int x0, int xmax, int k0,
+        int kmax, bool transpose_B) const {
+    if (!transpose_B)
+        pack_B_n(out, in, ldin, x0, xmax, k0, kmax);
+    else
+        pack_B_t(out, in, ldin, x0, xmax, k0, kmax);
+}
+
+void hgemm_pack_6x16_f16c::kern(
+        const float* packA, const dt_float16* packB, size_t M, size_t N, size_t K,
+        dt_float16* C, size_t LDC, bool is_first_k, const float*, float*) const {
+    //! block_k covers the whole K, so the partial sums are never rounded to the
+    //! fp16 C between K blocks, which is required by ComputeMode::FLOAT32
+    megdnn_assert(is_first_k, "hgemm_pack_6x16_f16c does not split K");
+    for (size_t n = 0; n < N; n += NR) {
+        int cols = std::min<size_t>(NR, N - n);
+        const float* cur_packA = packA;
+        for (size_t m = 0; m < M; m += MR) {
+            int rows = std::min<size_t>(MR, M - m);
+            kern_6x16(cur_packA, packB, K, C + m * LDC + n, LDC, rows, cols);
+            cur_packA += K * MR;
+        }
+        packB += K * NR;
+    }
+}
+
+}  // namespace matmul
+}  // namespace x86
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -11,6 +11,9 @@ MEGDNN_REG_GEMM_STRATEGY_NOPACK(
 MEGDNN_REG_GEMM_STRATEGY_WITH_PACK_A_TYPE(
         float, float, float, float, 6, 16, 1, false, false, sgemm_pack_6x16_avx2);
 
+MEGDNN_REG_GEMM_STRATEGY(
+        float, float, float, 12, 32, 1, false, false, sgemm_pack_12x32_avx512);
+
 }  // namespace matmul
 }  // namespace x86
 }  // namespace megdnn
\ No newline at end of file
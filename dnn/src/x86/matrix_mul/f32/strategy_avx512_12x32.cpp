@@ -0,0 +1,191 @@
+#include <immintrin.h>
+#include "src/common/unroll_macro.h"
+#include "src/common/utils.h"
+#include "src/x86/matrix_mul/f32/strategy.h"
+
+using namespace megdnn;
+using namespace x86;
+using namespace x86::matmul;
+
+namespace {
+
+constexpr size_t MR = 12;
+constexpr size_t NR = 32;
+
+//! mask of the lowest n lanes of a 16-lane vector, n could exceed 16
+__mmask16 tail_mask(size_t n) {
+    return n >= 16 ? 0xffff : static_cast<__mmask16>((1u << n) - 1);
+}
+
+/*!
+ * \brief C[0:rows, 0:n] (+)= A * B on a 12-row panel of A and a 32-column
+ *      panel of B
+ *
+ * The panels are zero padded, so the kernel always computes 12x32 outputs and
+ * only masks the load and store of C.
+ */
+MEGDNN_ATTRIBUTE_TARGET("avx512f")
+void kern_12x32(
+        const float* packA, const float* packB, size_t K, float* C, size_t LDC,
+        bool is_first_k, size_t rows, size_t n) {
+    __mmask16 mask0 = tail_mask(n), mask1 = tail_mask(n > 16 ? n - 16 : 0);
+#define cb(i) __m512 c##i##0, c##i##1;
+    UNROLL_CALL_NOWRAPPER(12, cb);
+#undef cb
+    if (is_first_k) {
+#define cb(i)                        \
+    c##i##0 = _mm512_setzero_ps(); \
+    c##i##1 = _mm512_setzero_ps();
+        UNROLL_CALL_NOWRAPPER(12, cb);
+#undef cb
+    } else {
+#define cb(i)                                                                  \
+    c##i##0 = _mm512_maskz_loadu_ps(i < rows ? mask0 : 0, C + i * LDC);      \
+    c##i##1 = _mm512_maskz_loadu_ps(i < rows ? mask1 : 0, C + i * LDC + 16);
+        UNROLL_CALL_NOWRAPPER(12, cb);
+#undef cb
+    }
+
+    for (size_t k = 0; k < K; ++k) {
+        __m512 b0 = _mm512_loadu_ps(packB);
+        __m512 b1 = _mm512_loadu_ps(packB + 16);
+#define cb(i)                                      \
+    {                                              \
+        __m512 a = _mm512_set1_ps(packA[i]);       \
+        c##i##0 = _mm512_fmadd_ps(a, b0, c##i##0); \
+        c##i##1 = _mm512_fmadd_ps(a, b1, c##i##1); \
+    }
+        UNROLL_CALL_NOWRAPPER(12, cb);
+#undef cb
+        packA += MR;
+        packB += NR;
+    }
+
+#define cb(i)                                                        \
+    if (i < rows) {                                                  \
+        _mm512_mask_storeu_ps(C + i * LDC, mask0, c##i##0);          \
+        _mm512_mask_storeu_ps(C + i * LDC + 16, mask1, c##i##1);     \
+    }
+    UNROLL_CALL_NOWRAPPER(12, cb);
+#undef cb
+}
+
+//! out[k * MR + i] = A[y0 + i, k], with A in row major
+void pack_A_n(
+        float* out, const float* in, int ldin, int y0, int ymax, int k0, int kmax) {
+    for (int y = y0; y < ymax; y += MR) {
+        int rows = std::min<int>(MR, ymax - y);
+        const float* inptr = in + y * ldin;
+        for (int k = k0; k < kmax; ++k) {
+            int i = 0;
+            for (; i < rows; ++i) {
+                out[i] = inptr[i * ldin + k];
+            }
+            for (; i < static_cast<int>(MR); ++i) {
+                out[i] = 0.f;
+            }
+            out += MR;
+        }
+    }
+}
+
+//! out[k * MR + i] = A[y0 + i, k], with A given by its transpose
+MEGDNN_ATTRIBUTE_TARGET("avx512f")
+void pack_A_t(
+        float* out, const float* in, int ldin, int y0, int ymax, int k0, int kmax) {
+    for (int y = y0; y < ymax; y += MR) {
+        __mmask16 mask = tail_mask(std::min<int>(MR, ymax - y));
+        for (int k = k0; k < kmax; ++k) {
+            __m512 v = _mm512_maskz_loadu_ps(mask, in + k * ldin + y);
+            _mm512_mask_storeu_ps(out, 0xfff, v);
+            out += MR;
+        }
+    }
+}
+
+//! out[k * NR + j] = B[k, x0 + j], with B in row major
+MEGDNN_ATTRIBUTE_TARGET("avx512f")
+void pack_B_n(
+        float* out, const float* in, int ldin, int x0, int xmax, int k0, int kmax) {
+    for (int x = x0; x < xmax; x += NR) {
+        size_t cols = std::min<int>(NR, xmax - x);
+        __mmask16 mask0 = tail_mask(cols), mask1 = tail_mask(cols > 16 ? cols - 16 : 0);
+        for (int k = k0; k < kmax; ++k) {
+            const float* inptr = in + k * ldin + x;
+            _mm512_storeu_ps(out, _mm512_maskz_loadu_ps(mask0, inptr));
+            _mm512_storeu_ps(out + 16, _mm512_maskz_loadu_ps(mask1, inptr + 16));
+            out += NR;
+        }
+    }
+}
+
+//! out[k * NR + j] = B[k, x0 + j], with B given by its transpose
+void pack_B_t(
+        float* out, const float* in, int ldin, int x0, int xmax, int k0, int kmax) {
+    for (int x = x0; x < xmax; x += NR) {
+        int cols = std::min<int>(NR, xmax - x);
+        const float* inptr = in + x * ldin;
+        for (int k = k0; k < kmax; ++k) {
+            int j = 0;
+            for (; j < cols; ++j) {
+                out[j] = inptr[j * ldin + k];
+            }
+            for (; j < static_cast<int>(NR); ++j) {
+                out[j] = 0.f;
+            }
+            out += NR;
+        }
+    }
+}
+
+}  // anonymous namespace
+
+MEGDNN_REG_GEMM_STRATEGY_IMPL(sgemm_pack_12x32_avx512);
+
+void sgemm_pack_12x32_avx512::pack_A(
+        float* out, const float* in, int ldin, int y0, int ymax, int k0, int kmax,
+        bool transpose_A) const {
+    if (transpose_A) {
+        pack_A_t(out, in, ldin, y0, ymax, k0, kmax);
+    } else {
+        pack_A_n(out, in, ldin, y0, ymax, k0, kmax);
+    }
+}
+
+void sgemm_pack_12x32_avx512::pack_B(
+        float* out, const float* in, int ldin, int x0, int xmax, int k0, int kmax,
+        bool transpose_B) const {
+    if (transpose_B) {
+        pack_B_t(out, in, ldin, x0, xmax, k0, kmax);
+    } else {
+        pack_B_n(out, in, ldin, x0, xmax, k0, kmax);
+    }
+}
+
+void sgemm_pack_12x32_avx512::kern(
+        const float* packA, const float* packB, size_t M, size_t N, size_t K, float* C,
+        size_t LDC, bool is_first_k, const float*, float*) const {
+    megdnn_assert(
+            A_dtype.enumv() == B_dtype.enumv() &&
+            A_dtype.enumv() == C_dtype.enumv() &&
+            A_dtype.enumv() == DTypeEnum::Float32);
+    //! keep a chunk of packed B in L2 cache and stream the panels of A over it
+    size_t chunk = std::max<size_t>(
+            NR, (1 << 20) / (std::max<size_t>(K, 1) * sizeof(float)) / NR * NR);
+    for (size_t n0 = 0; n0 < N; n0 += chunk) {
+        size_t n1 = std::min(N, n0 + chunk);
+        const float* a_panel = packA;
+        for (size_t m = 0; m < M; m += MR) {
+            const float* b_panel = packB + n0 * K;
+            for (size_t n = n0; n < n1; n += NR) {
+                kern_12x32(
+                        a_panel, b_panel, K, C + m * LDC + n, LDC, is_first_k,
+                        std::min(MR, M - m), std::min(NR, N - n));
+                b_panel += NR * K;
+            }
+            a_panel += MR * K;
+        }
+    }
+}
+
+// vim: syntax=cpp.doxygen
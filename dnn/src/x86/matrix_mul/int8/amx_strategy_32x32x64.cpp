@@ -0,0 +1,239 @@
+#include "src/common/utils.h"
+#include "src/x86/matrix_mul/int8/strategy.h"
+#include "src/x86/utils.h"
+
+#if MEGDNN_X86_WITH_AMX
+#include <immintrin.h>
+#include <cstring>
+
+using namespace megdnn;
+using namespace x86;
+using namespace x86::matmul;
+
+namespace {
+
+constexpr size_t MR = 32;
+constexpr size_t NR = 32;
+constexpr size_t KR = 64;
+
+/*!
+ * \brief the tile config of the kernel
+ *
+ * tmm0~tmm3 hold the 2x2 blocks of 16x16 int32 output, tmm4 and tmm5 hold the
+ * two 16x64 int8 blocks of A, and tmm6 and tmm7 hold the two 16x16x4 int8
+ * blocks of B in the dot product layout.
+ */
+struct alignas(64) TileConfig {
+    uint8_t palette_id = 1;
+    uint8_t start_row = 0;
+    uint8_t reserved[14] = {0};
+    uint16_t colsb[16] = {0};
+    uint8_t rows[16] = {0};
+
+    TileConfig() {
+        for (int i = 0; i < 8; ++i) {
+            colsb[i] = 64;
+            rows[i] = 16;
+        }
+    }
+};
+
+/*!
+ * \brief C[0:rows, 0:n] (+)= A * B on a 32-row panel of A and a 32-column
+ *      panel of B, the tile config should have been loaded
+ *
+ * The packed A is stored as [K / 64][32][64] and the packed B is stored as
+ * [K / 64][16][32][4], both are zero padded.
+ */
+MEGDNN_ATTRIBUTE_TARGET("amx-tile,amx-int8,avx512f")
+void kern_32x32(
+        const dt_int8* packA, const dt_int8* packB, size_t K, dt_int32* C,
+        size_t LDC, bool is_first_k, size_t rows, size_t n) {
+    alignas(64) dt_int32 out[MR * NR];
+    _tile_zero(0);
+    _tile_zero(1);
+    _tile_zero(2);
+    _tile_zero(3);
+    for (size_t k = 0; k < K; k += KR) {
+        _tile_loadd(4, packA, KR);
+        _tile_loadd(5, packA + 16 * KR, KR);
+        _tile_loadd(6, packB, NR * 4);
+        _tile_loadd(7, packB + 16 * 4, NR * 4);
+        _tile_dpbssd(0, 4, 6);
+        _tile_dpbssd(1, 4, 7);
+        _tile_dpbssd(2, 5, 6);
+        _tile_dpbssd(3, 5, 7);
+        packA += MR * KR;
+        packB += NR * KR;
+    }
+    _tile_stored(0, out, NR * sizeof(dt_int32));
+    _tile_stored(1, out + 16, NR * sizeof(dt_int32));
+    _tile_stored(2, out + 16 * NR, NR * sizeof(dt_int32));
+    _tile_stored(3, out + 16 * NR + 16, NR * sizeof(dt_int32));
+
+    __mmask16 mask0 = n >= 16 ? 0xffff : static_cast<__mmask16>((1u << n) - 1);
+    __mmask16 mask1 = n >= 32 ? 0xffff
+                    : n > 16  ? static_cast<__mmask16>((1u << (n - 16)) - 1)
+                              : 0;
+    for (size_t i = 0; i < rows; ++i) {
+        __m512i v0 = _mm512_load_si512(out + i * NR);
+        __m512i v1 = _mm512_load_si512(out + i * NR + 16);
+        dt_int32* c = C + i * LDC;
+        if (!is_first_k) {
+            v0 = _mm512_add_epi32(v0, _mm512_maskz_loadu_epi32(mask0, c));
+            v1 = _mm512_add_epi32(v1, _mm512_maskz_loadu_epi32(mask1, c + 16));
+        }
+        _mm512_mask_storeu_epi32(c, mask0, v0);
+        _mm512_mask_storeu_epi32(c + 16, mask1, v1);
+    }
+}
+
+//! out[k / 64][i][k % 64] = A[y0 + i, k], with A in row major
+MEGDNN_ATTRIBUTE_TARGET("avx512f,avx512bw")
+void pack_A_n(
+        dt_int8* out, const dt_int8* in, int ldin, int y0, int ymax, int k0, int kmax) {
+    for (int y = y0; y < ymax; y += MR) {
+        int rows = std::min<int>(MR, ymax - y);
+        for (int k = k0; k < kmax; k += KR) {
+            int cols = std::min<int>(KR, kmax - k);
+            __mmask64 mask = cols == 64 ? ~0ull : (1ull << cols) - 1;
+            for (int i = 0; i < static_cast<int>(MR); ++i) {
+                __m512i v = i < rows ? _mm512_maskz_loadu_epi8(
+                                               mask, in + (y + i) * ldin + k)
+                                     : _mm512_setzero_si512();
+                _mm512_storeu_si512(out, v);
+                out += KR;
+            }
+        }
+    }
+}
+
+//! out[k / 64][i][k % 64] = A[y0 + i, k], with A given by its transpose
+void pack_A_t(
+        dt_int8* out, const dt_int8* in, int ldin, int y0, int ymax, int k0, int kmax) {
+    for (int y = y0; y < ymax; y += MR) {
+        int rows = std::min<int>(MR, ymax - y);
+        for (int k = k0; k < kmax; k += KR) {
+            int cols = std::min<int>(KR, kmax - k);
+            memset(out, 0, MR * KR);
+            for (int kk = 0; kk < cols; ++kk) {
+                const dt_int8* inptr = in + (k + kk) * ldin + y;
+                for (int i = 0; i < rows; ++i) {
+                    out[i * KR + kk] = inptr[i];
+                }
+            }
+            out += MR * KR;
+        }
+    }
+}
+
+//! out[k / 64][k % 64 / 4][j][k % 4] = B[k, x0 + j], with B in row major
+void pack_B_n(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax) {
+    for (int x = x0; x < xmax; x += NR) {
+        int cols = std::min<int>(NR, xmax - x);
+        for (int k = k0; k < kmax; k += KR) {
+            int depth = std::min<int>(KR, kmax - k);
+            memset(out, 0, NR * KR);
+            for (int kk = 0; kk < depth; ++kk) {
+                const dt_int8* inptr = in + (k + kk) * ldin + x;
+                dt_int8* outptr = out + kk / 4 * NR * 4 + kk % 4;
+                for (int j = 0; j < cols; ++j) {
+                    outptr[j * 4] = inptr[j];
+                }
+            }
+            out += NR * KR;
+        }
+    }
+}
+
+//! out[k / 64][k % 64 / 4][j][k % 4] = B[k, x0 + j], with B given by its
+//! transpose
+void pack_B_t(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax) {
+    for (int x = x0; x < xmax; x += NR) {
+        int cols = std::min<int>(NR, xmax - x);
+        for (int k = k0; k < kmax; k += KR) {
+            int depth = std::min<int>(KR, kmax - k);
+            memset(out, 0, NR * KR);
+            for (int j = 0; j < cols; ++j) {
+                const dt_int8* inptr = in + (x + j) * ldin + k;
+                for (int kk = 0; kk < depth; ++kk) {
+                    out[kk / 4 * NR * 4 + j * 4 + kk % 4] = inptr[kk];
+                }
+            }
+            out += NR * KR;
+        }
+    }
+}
+
+MEGDNN_ATTRIBUTE_TARGET("amx-tile")
+void load_tile_config() {
+    static const TileConfig config;
+    _tile_loadconfig(&config);
+}
+
+MEGDNN_ATTRIBUTE_TARGET("amx-tile")
+void release_tile() {
+    _tile_release();
+}
+
+}  // anonymous namespace
+
+MEGDNN_REG_GEMM_STRATEGY_IMPL(gemm_amx_s8s8s32_32x32x64);
+
+void gemm_amx_s8s8s32_32x32x64::pack_A(
+        dt_int8* out, const dt_int8* in, int ldin, int y0, int ymax, int k0, int kmax,
+        bool transpose) const {
+    if (transpose) {
+        pack_A_t(out, in, ldin, y0, ymax, k0, kmax);
+    } else {
+        pack_A_n(out, in, ldin, y0, ymax, k0, kmax);
+    }
+}
+
+void gemm_amx_s8s8s32_32x32x64::pack_B(
+        dt_int8* out, const dt_int8* in, int ldin, int x0, int xmax, int k0, int kmax,
+        bool transpose) const {
+    if (transpose) {
+        pack_B_t(out, in, ldin, x0, xmax, k0, kmax);
+    } else {
+        pack_B_n(out, in, ldin, x0, xmax, k0, kmax);
+    }
+}
+
+void gemm_amx_s8s8s32_32x32x64::kern(
+        const dt_int8* packA, const dt_int8* packB, size_t M, size_t N, size_t K,
+        dt_int32* C, size_t LDC, bool is_first_k, const dt_int32*, dt_int32*) const {
+    megdnn_assert(
+            A_dtype.enumv() == B_dtype.enumv() &&
+                    ((A_dtype.enumv() == DTypeEnum::Int8 &&
+                      C_dtype.enumv() == DTypeEnum::Int32) ||
+                     (A_dtype.enumv() == DTypeEnum::QuantizedS8 &&
+                      C_dtype.enumv() == DTypeEnum::QuantizedS32)),
+            "A: %s B: %s C: %s", A_dtype.name(), B_dtype.name(), C_dtype.name());
+    //! the tile config is per thread, so it is loaded by every call
+    load_tile_config();
+    const size_t roundup_k = round_up(K, KR);
+    //! keep a chunk of packed B in L2 cache and stream the panels of A over it
+    size_t chunk = std::max<size_t>(NR, (1 << 20) / roundup_k / NR * NR);
+    for (size_t n0 = 0; n0 < N; n0 += chunk) {
+        size_t n1 = std::min(N, n0 + chunk);
+        const dt_int8* a_panel = packA;
+        for (size_t m = 0; m < M; m += MR) {
+            const dt_int8* b_panel = packB + n0 * roundup_k;
+            for (size_t n = n0; n < n1; n += NR) {
+                kern_32x32(
+                        a_panel, b_panel, roundup_k, C + m * LDC + n, LDC, is_first_k,
+                        std::min(MR, M - m), std::min(NR, N - n));
+                b_panel += NR * roundup_k;
+            }
+            a_panel += MR * roundup_k;
+        }
+    }
+    release_tile();
+}
+
+#endif
+
+// vim: syntax=cpp.doxygen
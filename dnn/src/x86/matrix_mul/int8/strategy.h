@@ -1,5 +1,6 @@
 #pragma once
 #include "src/fallback/matrix_mul/gemm_common.h"
+#include "src/x86/utils.h"
 
 namespace megdnn {
 namespace x86 {
@@ -12,6 +13,12 @@ MEGDNN_REG_GEMM_STRATEGY_WITH_PACK_A_TYPE(
         gemm_int8_vnni_12x32x4);
 #endif
 
+#if MEGDNN_X86_WITH_AMX
+MEGDNN_REG_GEMM_STRATEGY(
+        dt_int8, dt_int32, dt_int32, 32, 32, 64, false, false,
+        gemm_amx_s8s8s32_32x32x64);
+#endif
+
 MEGDNN_REG_GEMM_STRATEGY(
         dt_int8, dt_int32, dt_int32, 2, 4, 16, false, false, gemm_avx2_s8s8s32_2x4x16);
 
@@ -23,12 +23,24 @@ class MatrixMulImpl::AlgoPack : NonCopyableObj {
     AlgoInt8x8x16SSE algoint8x8x16sse_m4n8k2;
     AlgoF32MK8_8x8 algof32mk8_8x8;
     AlgoFloatAVX2M6N16 algof32_6x16;
+    AlgoFloatAVX512M12N32 algof32_avx512_12x32;
+#if !MEGDNN_DISABLE_FLOAT16
+    AlgoF16F16CM6N16 algof16_f16c_6x16;
+#endif
+#if MEGDNN_X86_WITH_AMX
+    AlgoInt8x8x32AMXM32N32K64 algoint8x8x32amx_32x32x64;
+#endif
 
     SmallVector<fallback::MatrixMulImpl::AlgoBase*> m_all_algos;
     fallback::MatrixMulImpl::AlgoBase::Mapper m_all_algos_map;
 
 public:
     AlgoPack() {
+        if (is_supported(SIMDType::AMX_INT8)) {
+#if MEGDNN_X86_WITH_AMX
+            m_all_algos.emplace_back(&algoint8x8x32amx_32x32x64);
+#endif
+        }
         if (is_supported(SIMDType::VNNI)) {
 #if MEGDNN_X86_WITH_VNNI
             m_all_algos.emplace_back(&algoint8x8x32vnni);
@@ -47,7 +59,15 @@ public:
 #if MEGDNN_X86_WITH_MKL && SUPPORT_MKL_PACKED_GEMM
         m_all_algos.emplace_back(&f32mkl_packa);
 #endif
+        if (is_supported(SIMDType::AVX512F)) {
+            m_all_algos.emplace_back(&algof32_avx512_12x32);
+        }
         m_all_algos.emplace_back(&algof32_6x16);
+#if !MEGDNN_DISABLE_FLOAT16
+        if (is_supported(SIMDType::F16C)) {
+            m_all_algos.emplace_back(&algof16_f16c_6x16);
+        }
+#endif
 
         for (auto&& algo : m_all_algos) {
             m_all_algos_map.emplace(algo->info().desc, algo);
@@ -57,6 +57,13 @@ private:
     class AlgoPack;
     class AlgoF32MK8_8x8;
     class AlgoFloatAVX2M6N16;
+    class AlgoFloatAVX512M12N32;
+#if !MEGDNN_DISABLE_FLOAT16
+    class AlgoF16F16CM6N16;
+#endif
+#if MEGDNN_X86_WITH_AMX
+    class AlgoInt8x8x32AMXM32N32K64;
+#endif
 
 public:
     static const AlgoPack& algo_pack();
@@ -59,6 +59,7 @@ PoolingImpl::AlgoPack::AlgoPack() {
     all_algos.push_back(&algo_mkldnn_nchw);
     all_algos.push_back(&algo_mkldnn_nchw88);
 #endif
+    all_algos.push_back(&algo_channel_vec_avx);
     all_algos.push_back(&algo_fallback);
 
     for (auto&& algo : all_algos) {
@@ -481,3 +482,145 @@ void PoolingImpl::AlgoMaxS1NCHW88AVX::exec(const ExecArgs& args) const {
     };
     MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(handle, N * IC, run);
 }
+
+namespace {
+//! strides in floats of a fp32 tensor whose channels are split into vectors of 8
+struct ChannelVecLayout {
+    size_t N, H, W, nr_vec;
+    size_t n_stride, vec_stride, h_stride, w_stride;
+    //! valid lanes of the last vector
+    size_t tail;
+};
+
+ChannelVecLayout get_channel_vec_layout(
+        const TensorLayout& layout, param::Pooling::Format format) {
+    ChannelVecLayout ret;
+    ret.N = layout[0];
+    if (format == param::Pooling::Format::NCHW88) {
+        ret.nr_vec = layout[1];
+        ret.H = layout[2];
+        ret.W = layout[3];
+        ret.tail = 8;
+        ret.w_stride = 8;
+        ret.h_stride = ret.W * 8;
+        ret.vec_stride = ret.H * ret.h_stride;
+        ret.n_stride = ret.nr_vec * ret.vec_stride;
+    } else {
+        size_t C = layout[3];
+        ret.H = layout[1];
+        ret.W = layout[2];
+        ret.nr_vec = div_ceil<size_t>(C, 8);
+        ret.tail = C - (ret.nr_vec - 1) * 8;
+        ret.vec_stride = 8;
+        ret.w_stride = C;
+        ret.h_stride = ret.W * C;
+        ret.n_stride = ret.H * ret.h_stride;
+    }
+    return ret;
+}
+
+template <param::Pooling::Mode mode, bool masked>
+MEGDNN_ATTRIBUTE_TARGET("avx")
+void pooling_channel_vec(
+        const float* src, float* dst, const ChannelVecLayout& sl, size_t ih0,
+        size_t ih1, size_t iw0, size_t iw1, __m256 scale, __m256i mask) {
+    constexpr bool is_max = mode == param::Pooling::Mode::MAX;
+    __m256 acc = is_max ? _mm256_set1_ps(-std::numeric_limits<float>::max())
+                        : _mm256_setzero_ps();
+    for (size_t ih = ih0; ih < ih1; ++ih) {
+        const float* row = src + ih * sl.h_stride;
+        for (size_t iw = iw0; iw < iw1; ++iw) {
+            const float* p = row + iw * sl.w_stride;
+            __m256 x = masked ? _mm256_maskload_ps(p, mask) : _mm256_loadu_ps(p);
+            acc = is_max ? _mm256_max_ps(acc, x) : _mm256_add_ps(acc, x);
+        }
+    }
+    if (!is_max) {
+        acc = _mm256_mul_ps(acc, scale);
+    }
+    if (masked) {
+        _mm256_maskstore_ps(dst, mask, acc);
+    } else {
+        _mm256_storeu_ps(dst, acc);
+    }
+}
+
+//! compute the output row \p oh of the sample \p n
+template <param::Pooling::Mode mode>
+MEGDNN_ATTRIBUTE_TARGET("avx")
+void pooling_channel_vec_row(
+        const float* src, float* dst, const ChannelVecLayout& sl,
+        const ChannelVecLayout& dl, const param::Pooling& param, size_t n,
+        size_t oh) {
+    alignas(32) int32_t mask_lanes[8];
+    for (size_t i = 0; i < 8; ++i) {
+        mask_lanes[i] = i < sl.tail ? -1 : 0;
+    }
+    __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(mask_lanes));
+    ptrdiff_t ih_start = static_cast<ptrdiff_t>(oh * param.stride_h) - param.pad_h;
+    size_t ih0 = std::max<ptrdiff_t>(ih_start, 0),
+           ih1 = std::min<ptrdiff_t>(ih_start + param.window_h, sl.H);
+    src += n * sl.n_stride;
+    dst += n * dl.n_stride + oh * dl.h_stride;
+    for (size_t ow = 0; ow < dl.W; ++ow) {
+        ptrdiff_t iw_start = static_cast<ptrdiff_t>(ow * param.stride_w) - param.pad_w;
+        size_t iw0 = std::max<ptrdiff_t>(iw_start, 0),
+               iw1 = std::min<ptrdiff_t>(iw_start + param.window_w, sl.W);
+        size_t count = mode == param::Pooling::Mode::AVERAGE
+                             ? param.window_h * param.window_w
+                             : (ih1 - ih0) * (iw1 - iw0);
+        __m256 scale = _mm256_set1_ps(1.f / std::max<size_t>(count, 1));
+        float* out = dst + ow * dl.w_stride;
+        size_t nr_full = sl.tail == 8 ? sl.nr_vec : sl.nr_vec - 1;
+        for (size_t v = 0; v < nr_full; ++v) {
+            pooling_channel_vec<mode, false>(
+                    src + v * sl.vec_stride, out + v * dl.vec_stride, sl, ih0, ih1,
+                    iw0, iw1, scale, mask);
+        }
+        if (nr_full < sl.nr_vec) {
+            pooling_channel_vec<mode, true>(
+                    src + nr_full * sl.vec_stride, out + nr_full * dl.vec_stride, sl,
+                    ih0, ih1, iw0, iw1, scale, mask);
+        }
+    }
+}
+}  // namespace
+
+bool PoolingImpl::AlgoChannelVecAVX::is_available(const SizeArgs& args) const {
+    auto&& param = args.opr->param();
+    bool is_format_ok =
+            (param.format == Param::Format::NCHW88 && args.layout_src.ndim == 5 &&
+             args.layout_src[4] == 8) ||
+            (param.format == Param::Format::NHWC && args.layout_src.ndim == 4 &&
+             args.layout_src[3] > 0);
+    return is_supported(SIMDType::AVX) && is_format_ok &&
+           args.layout_src.dtype == dtype::Float32() &&
+           args.layout_src.is_contiguous() && args.layout_dst.is_contiguous() &&
+           param.pad_h < param.window_h && param.pad_w < param.window_w;
+}
+
+void PoolingImpl::AlgoChannelVecAVX::exec(const ExecArgs& args) const {
+    auto param = args.opr->param();
+    auto sl = get_channel_vec_layout(args.layout_src, param.format);
+    auto dl = get_channel_vec_layout(args.layout_dst, param.format);
+    auto src = args.src_tensor;
+    auto dst = args.dst_tensor;
+    size_t OH = dl.H;
+#define cb(_mode)                                                           \
+    if (param.mode == _mode) {                                              \
+        auto run = [=](size_t index, size_t) {                              \
+            pooling_channel_vec_row<_mode>(                                 \
+                    static_cast<const float*>(src.raw_ptr()),               \
+                    static_cast<float*>(dst.raw_ptr()), sl, dl, param,      \
+                    index / OH, index % OH);                                \
+        };                                                                  \
+        MEGDNN_DISPATCH_MULTI_THREAD_CPU_KERN(args.handle, dl.N * OH, run); \
+        return;                                                             \
+    }
+    cb(Mode::MAX);
+    cb(Mode::AVERAGE);
+    cb(Mode::AVERAGE_COUNT_EXCLUDE_PADDING);
+#undef cb
+    megdnn_throw("unsupported pooling mode");
+}
+
@@ -22,7 +22,8 @@ public:
         X86_MKLDNNNCHW,
         X86_MKLDNNNCHW88,
 #endif
-        X86_Fallback
+        X86_Fallback,
+        X86_ChannelVecAVX
     };
     using Mapper = std::unordered_map<AlgorithmDesc, AlgoBase*>;
     AlgoBase() : Algorithm() { m_handle_type = Handle::HandleType::X86; }
@@ -77,6 +78,8 @@ ALGO_IMPL(MeanW2S2SSE3)
 ALGO_IMPL(MaxW2S2SSE)
 ALGO_IMPL(MaxW3S3SSE)
 ALGO_IMPL(MaxS1NCHW88AVX)
+//! fp32 NCHW88 and NHWC with any window, vectorized over 8 channels
+ALGO_IMPL(ChannelVecAVX)
 #if MEGDNN_X86_WITH_MKL_DNN
 ALGO_IMPL(MKLDNNNCHW)
 ALGO_IMPL(MKLDNNNCHW88)
@@ -109,6 +112,7 @@ private:
     AlgoMKLDNNNCHW88 algo_mkldnn_nchw88;
 #endif
     AlgoMaxS1NCHW88AVX algo_max_w13s1_nchw88_avx;
+    AlgoChannelVecAVX algo_channel_vec_avx;
     AlgoFallback algo_fallback;
 
 public:
@@ -11,6 +11,7 @@ private:
     class AlgoMaxW2S2SSE;
     class AlgoMaxW3S3SSE;
     class AlgoMaxS1NCHW88AVX;
+    class AlgoChannelVecAVX;
 #if MEGDNN_X86_WITH_MKL_DNN
     class AlgoMKLDNNNCHW;
     class AlgoMKLDNNNCHW88;
@@ -8,6 +8,11 @@
 #include <intrin.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #if MEGDNN_X86_WITH_MKL || MEGDNN_X86_WITH_OPENBLAS
 #include <pmmintrin.h>
 #endif
@@ -117,6 +122,67 @@ bool feature_detect_vnni() {
     return (eax & 6) == 6;
 }
 
+void cpuid_leaf7(uint32_t subleaf, uint32_t* regs) {
+#if defined(_WIN32)
+    int cpuInfo[4];
+    __cpuidex(cpuInfo, 7, subleaf);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = cpuInfo[i];
+    }
+#else
+    asm volatile("cpuid\n"
+                 : "=a"(regs[0]), "=b"(regs[1]), "=c"(regs[2]), "=d"(regs[3])
+                 : "a"(7), "c"(subleaf)
+                 : "cc");
+#endif
+}
+
+uint32_t xcr0() {
+    uint32_t eax, edx;
+    asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+}
+
+bool feature_detect_avx512f() {
+    if (!bit(cpuid.ecx, 27)) {
+        return false;
+    }
+    uint32_t regs[4];
+    cpuid_leaf7(0, regs);
+    // avx512f ---> 16 ebx
+    if (!bit(regs[1], 16))
+        return false;
+
+    // check os support of ymm, opmask and zmm states
+    return (xcr0() & 0xe6) == 0xe6;
+}
+
+bool feature_detect_amx_int8() {
+    if (!bit(cpuid.ecx, 27)) {
+        return false;
+    }
+    uint32_t regs[4];
+    cpuid_leaf7(0, regs);
+    // avx512bw ---> 30 ebx
+    // amx-tile ---> 24 edx
+    // amx-int8 ---> 25 edx
+    if (!(bit(regs[1], 16) && bit(regs[1], 30) && bit(regs[3], 24) &&
+          bit(regs[3], 25)))
+        return false;
+
+    // check os support of the tile config and tile data states
+    if ((xcr0() & 0x600e6) != 0x600e6)
+        return false;
+#if defined(__linux__) && defined(SYS_arch_prctl)
+    // linux enables the tile data state on request, see
+    // Documentation/x86/xstate.rst
+    constexpr int ARCH_REQ_XCOMP_PERM = 0x1023, XFEATURE_XTILEDATA = 18;
+    return syscall(SYS_arch_prctl, ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA) == 0;
+#else
+    return true;
+#endif
+}
+
 bool feature_detect_avx_fma(int ftr) {
     // see Detecting Availability and Support in
     // https://software.intel.com/en-us/articles/introduction-to-intel-advanced-vector-extensions
@@ -134,8 +200,11 @@ bool feature_detect_avx_fma(int ftr) {
 
 bool is_avx_supported = feature_detect_avx_fma(28);
 bool is_fma_supported = feature_detect_avx_fma(12);
+bool is_f16c_supported = feature_detect_avx_fma(29);
 bool is_avx2_supported = feature_detect_avx2();
 bool is_vnni_supported = feature_detect_vnni();
+bool is_avx512f_supported = feature_detect_avx512f();
+bool is_amx_int8_supported = feature_detect_amx_int8();
 
 SIMDType disabled_simd_type_thresh = SIMDType::__NR_SIMD_TYPE;
 
@@ -167,8 +236,14 @@ bool x86::is_supported(SIMDType type) {
             return is_fma_supported;
         case SIMDType::AVX2:
             return is_avx2_supported;
+        case SIMDType::F16C:
+            return is_f16c_supported;
+        case SIMDType::AVX512F:
+            return is_avx512f_supported;
         case SIMDType::VNNI:
             return is_vnni_supported;
+        case SIMDType::AMX_INT8:
+            return is_amx_int8_supported;
         default:
             break;
     }
@@ -179,6 +254,43 @@ void x86::disable_simd_type(SIMDType type) {
     disabled_simd_type_thresh = type;
 }
 
+fallback::CpuIsaLevel x86::detect_cpu_isa_level() {
+    using Level = fallback::CpuIsaLevel;
+    if (!is_supported(SIMDType::SSE4_2)) {
+        return Level::GENERIC;
+    }
+    if (!is_supported(SIMDType::AVX)) {
+        return Level::X86_SSE4_2;
+    }
+    if (!is_supported(SIMDType::AVX2) || !is_supported(SIMDType::FMA)) {
+        return Level::X86_AVX;
+    }
+    return is_supported(SIMDType::AVX512F) ? Level::X86_AVX512 : Level::X86_AVX2;
+}
+
+void x86::limit_simd_type(fallback::CpuIsaLevel level) {
+    using Level = fallback::CpuIsaLevel;
+    SIMDType thresh = SIMDType::__NR_SIMD_TYPE;
+    switch (level) {
+        case Level::GENERIC:
+        case Level::X86_SSE4_2:
+            thresh = SIMDType::AVX;
+            break;
+        case Level::X86_AVX:
+            thresh = SIMDType::AVX2;
+            break;
+        case Level::X86_AVX2:
+            thresh = SIMDType::AVX512F;
+            break;
+        default:
+            break;
+    }
+    //! never enable the types disabled for testing
+    if (thresh < disabled_simd_type_thresh) {
+        disabled_simd_type_thresh = thresh;
+    }
+}
+
 template <>
 void transpose(
         const float* src, float* dst, size_t m, size_t n, ptrdiff_t lds,
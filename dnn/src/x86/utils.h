@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <vector>
 #include "src/common/utils.h"
+#include "src/fallback/cpu_dispatch.h"
 
 #if MEGDNN_X86_WITH_MKL
 #include <mkl.h>
@@ -15,6 +16,15 @@
 
 #endif
 
+//! the AMX intrinsics are available since gcc 11 and clang 12
+#if !defined(_MSC_VER) &&                                          \
+        ((defined(__clang__) && __clang_major__ >= 12) ||          \
+         (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 11))
+#define MEGDNN_X86_WITH_AMX 1
+#else
+#define MEGDNN_X86_WITH_AMX 0
+#endif
+
 namespace megdnn {
 namespace x86 {
 
@@ -27,7 +37,13 @@ enum class SIMDType {
     AVX,
     AVX2,
     FMA,
+    //! conversion between fp16 and fp32
+    F16C,
+    AVX512F,
     VNNI,
+    //! AMX tiles with int8 dot product, which also needs the permission of
+    //! the OS to use the tile data
+    AMX_INT8,
     NONE,
     __NR_SIMD_TYPE  //! total number of SIMD types; used for testing
 };
@@ -37,6 +53,15 @@ bool is_supported(SIMDType type);
 //! disable a particular and more advanced SIMD types, for testing
 void disable_simd_type(SIMDType type);
 
+//! the isa level of the host cpu by cpuid
+fallback::CpuIsaLevel detect_cpu_isa_level();
+
+/*!
+ * \brief disable the SIMD types above a (capped) isa level, so the kernels
+ *      checked by is_supported() agree with the level of the handle
+ */
+void limit_simd_type(fallback::CpuIsaLevel level);
+
 template <typename T>
 T find_nearest_elem(T val, const std::vector<T>& vec) {
     megdnn_assert_internal(!vec.empty());
@@ -6,6 +6,7 @@
 #include "test/common/matrix_mul.h"
 #include "test/common/rng.h"
 
+#include "src/arm_common/utils.h"
 #include "test/arm_common/cpuinfo_help.h"
 using namespace megdnn;
 using namespace test;
@@ -82,6 +83,47 @@ TEST_F(AARCH64, MATRIX_MUL_F16_MK8_16x12x1) {
 }
 #endif
 
+#if MGB_ENABLE_MMLA
+TEST_F(AARCH64, MATRIX_MUL_INT8X8X32_K8X12X8_MMLA) {
+    if (!arm_common::cpu_has_i8mm()) {
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::Int8{}, dtype::Int8{}, dtype::Int32{}, handle(),
+            "AARCH64_INT8X8X32_K8X12X8_MMLA");
+}
+
+TEST_F(AARCH64, MATRIX_MUL_BF16_K8X12X4_MMLA) {
+    if (!arm_common::cpu_has_bf16()) {
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::BFloat16{}, dtype::BFloat16{}, dtype::BFloat16{}, handle(),
+            "AARCH64_BF16_K8X12X4_MMLA", param::MatrixMul::Format::DEFAULT, 1, 3e-2,
+            {}, true, param::MatrixMul::ComputeMode::FLOAT32);
+}
+#endif
+
+#if MGB_ENABLE_SVE
+TEST_F(AARCH64, MATRIX_MUL_F32_SVE) {
+    if (!arm_common::cpu_has_sve()) {
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::Float32{}, dtype::Float32{}, dtype::Float32{}, handle(),
+            "AARCH64_F32_SVE");
+}
+
+TEST_F(AARCH64, MATRIX_MUL_INT8X8X32_SVE) {
+    if (!arm_common::cpu_has_sve()) {
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::Int8{}, dtype::Int8{}, dtype::Int32{}, handle(),
+            "AARCH64_INT8X8X32_SVE");
+}
+#endif
+
 #if MGB_ENABLE_DOT
 TEST_F(AARCH64, MATRIX_MUL_INT8X8X32_K8X12X4_DOTPROD) {
     matrix_mul::check_matrix_mul(
@@ -210,6 +252,42 @@ TEST_F(AARCH64, MATRIX_MUL_INT4x4x16_K8x8x8_QUANTIZEDS4) {
     run(16, 16, 16);
 }
 
+#if MGB_ENABLE_DOT
+TEST_F(AARCH64, MATRIX_MUL_INT4x4x32_K8X12X4_DOTPROD) {
+    Checker<MatrixMul> checker(handle());
+    checker.set_before_exec_callback(
+            AlgoChecker<MatrixMul>("AARCH64_INT4X4X32_K8X12X4_DOTPROD"));
+
+    auto run = [&](size_t M, size_t N, size_t K, bool trA, bool trB) {
+        param::MatrixMul param;
+        param.transposeA = trA;
+        param.transposeB = trB;
+        checker.set_param(param);
+        TensorShape A = trA ? TensorShape{K, M} : TensorShape{M, K};
+        TensorShape B = trB ? TensorShape{N, K} : TensorShape{K, N};
+        checker.exec({A, B, {}});
+    };
+    auto run_all = [&]() {
+        for (bool trA : {false, true})
+            for (bool trB : {false, true})
+                for (size_t m : {1, 3, 4, 7, 8, 9, 16, 20})
+                    for (size_t n : {1, 3, 4, 11, 12, 13, 24, 28})
+                        for (size_t k : {2, 4, 6, 16, 18, 32, 34})
+                            run(m, n, k, trA, trB);
+        run(128, 256, 512, false, false);
+    };
+
+    checker.set_dtype(0, dtype::QuantizedS4{0.6})
+            .set_dtype(1, dtype::QuantizedS4{0.5})
+            .set_dtype(2, dtype::QuantizedS32{0.6 * 0.5});
+    run_all();
+    checker.set_dtype(0, dtype::Quantized4Asymm{0.6, 3})
+            .set_dtype(1, dtype::Quantized4Asymm{0.5, 8})
+            .set_dtype(2, dtype::QuantizedS32{0.6 * 0.5});
+    run_all();
+}
+#endif
+
 TEST_F(AARCH64, MATRIX_MUL_INT16x16x32_K12X8X1) {
     matrix_mul::check_matrix_mul(
             dtype::Int16{}, dtype::Int16{}, dtype::Int32{}, handle(),
@@ -787,6 +865,33 @@ TEST_F(AARCH64, BENCHMARK_MATRIX_MUL_INT8X8X32_MK4_8X12X4) {
 }
 #endif  // MGB_ENABLE_DOT
 
+#if MGB_ENABLE_MMLA && MGB_ENABLE_DOT
+TEST_F(AARCH64, BENCHMARK_MATRIX_MUL_INT8X8X32_MMLA_VS_DOTPROD) {
+    if (!arm_common::cpu_has_i8mm()) {
+        return;
+    }
+    auto args = matrix_mul::get_benchmark_matmul_args();
+    matrix_mul::benchmark_with_contrast(
+            handle(), args, dtype::Int8{}, dtype::Int8{}, dtype::Int32{},
+            "AARCH64_INT8X8X32_K8X12X8_MMLA", param::MatrixMul::Format::DEFAULT,
+            dtype::Int8{}, dtype::Int8{}, dtype::Int32{},
+            "AARCH64_INT8X8X32_K8X12X4_DOTPROD");
+}
+#endif
+
+#if MGB_ENABLE_SVE
+TEST_F(AARCH64, BENCHMARK_MATRIX_MUL_F32_SVE_VS_NEON) {
+    if (!arm_common::cpu_has_sve()) {
+        return;
+    }
+    auto args = matrix_mul::get_benchmark_matmul_args();
+    matrix_mul::benchmark_with_contrast(
+            handle(), args, dtype::Float32{}, dtype::Float32{}, dtype::Float32{},
+            "AARCH64_F32_SVE", param::MatrixMul::Format::DEFAULT, dtype::Float32{},
+            dtype::Float32{}, dtype::Float32{}, "AARCH64_F32K8X12X1");
+}
+#endif
+
 #if __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
 TEST_F(AARCH64, BENCHMARK_MATRIX_MUL_F16_MK8) {
     auto args = matrix_mul::get_benchmark_matmul_mk_packed_args(8);
@@ -0,0 +1,14 @@
+#include "test/arm_common/fixture.h"
+
+#include "test/common/benchmark_suite.h"
+
+using namespace megdnn;
+using namespace test;
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(ARM_COMMON, BENCHMARK_SUITE) {
+    benchmark_suite::run(handle(), "arm_common");
+}
+#endif
+
+// vim: syntax=cpp.doxygen
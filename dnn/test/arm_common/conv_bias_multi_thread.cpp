@@ -1125,6 +1125,34 @@ TEST_F(ARM_COMMON_MULTI_THREADS, CONV_BIAS_WINOGRAD_NCHW44_MK_PACKED_INT8_COMP_F
         dtype::QuantizedS8(0.49550694f), epsilon);
 }
 
+TEST_F(ARM_COMMON_MULTI_THREADS,
+       CONV_BIAS_WINOGRAD_NCHW44_MK_PACKED_INT8_COMP_F32_F43) {
+    using namespace conv_bias;
+
+    Checker<ConvBiasForward> checker(handle());
+#if MEGDNN_AARCH64
+    const char* matmul_name = "AARCH64_F32_MK4_4x16";
+#else
+    const char* matmul_name = "ARMV7_F32_MK4_4x8";
+#endif
+    checker.set_before_exec_callback(conv_bias::ConvBiasAlgoChecker<ConvBias>(
+            ssprintf("WINOGRAD_NCHW44:%s:4:4:32", matmul_name).c_str()));
+    std::vector<TestArg> quantized_args = get_int8_nchw44_args(3, 4, true);
+    UniformIntRNG int_rng{-50, 50};
+    //! the larger transform of F(4, 3) may round the output one step away
+    checker.set_rng(0, &int_rng)
+            .set_rng(1, &int_rng)
+            .set_rng(2, &int_rng)
+            .set_dtype(0, dtype::QuantizedS8(0.41113496f))
+            .set_dtype(1, dtype::QuantizedS8(0.01887994f))
+            .set_dtype(2, dtype::QuantizedS32(0.41113496f * 0.01887994f))
+            .set_dtype(4, dtype::QuantizedS8(0.49550694f))
+            .set_epsilon(1);
+    for (auto&& arg : quantized_args) {
+        checker.set_param(arg.param).execs({arg.src, arg.filter, arg.bias, {}, {}});
+    }
+}
+
 #if __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
 TEST_F(ARM_COMMON_MULTI_THREADS, CONV_BIAS_WINOGRAD_F16_F23) {
     using namespace conv_bias;
@@ -10,6 +10,42 @@ using namespace test;
 
 using Param = param::Convolution;
 
+TEST_F(ARM_COMMON_MULTI_THREADS, CONVOLUTION_BACKWARD_DATA_F32_NCHW44_DIRECT) {
+    Checker<ConvolutionBackwardData> checker(handle());
+    using Param = ConvolutionBackwardData::Param;
+    Param param;
+    param.format = Param::Format::NCHW44;
+    auto run = [&](size_t n, size_t ic, size_t oh, size_t ow, size_t oc, size_t f,
+                   size_t stride, size_t pad, size_t dilate) {
+        param.pad_h = param.pad_w = pad;
+        param.stride_h = param.stride_w = stride;
+        param.dilate_h = param.dilate_w = dilate;
+        TensorLayout diff{{n, oc / 4, oh, ow, 4}, dtype::Float32()};
+        TensorLayout filter{{oc / 4, ic / 4, f, f, 4, 4}, dtype::Float32()};
+        TensorLayout grad;
+        {
+            auto opr = handle()->create_operator<ConvolutionBackwardData>();
+            opr->param() = param;
+            opr->deduce_layout(filter, diff, grad);
+        }
+        checker.set_param(param).set_epsilon(1e-3).set_before_exec_callback(
+                AlgoChecker<ConvolutionBackwardData>(
+                        "ARM_COMMON_F32_DECONV_NCHW44_DIRECT"));
+        checker.exec(TensorLayoutArray{filter, diff, grad});
+    };
+
+    for (auto mode : {Param::Mode::CONVOLUTION, Param::Mode::CROSS_CORRELATION}) {
+        param.mode = mode;
+        for (size_t f : {1, 2, 3, 4, 5})
+            for (size_t stride : {1, 2}) {
+                run(2, 4, 7, 9, 8, f, stride, f / 2, 1);
+                run(3, 8, 6, 13, 4, f, stride, 0, 1);
+            }
+        run(1, 4, 5, 5, 4, 3, 2, 1, 2);
+        run(5, 16, 10, 11, 16, 3, 2, 2, 2);
+    }
+}
+
 #if MGB_ENABLE_DOT
 TEST_F(ARM_COMMON, CONVOLUTION_BACKWARD_DATA_INT8_INT8_INT32) {
     Checker<ConvolutionBackwardData> checker(handle());
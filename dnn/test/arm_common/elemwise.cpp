@@ -6,6 +6,7 @@
 
 #include "megdnn/opr_param_defs.h"
 #include "megdnn/oprs/general.h"
+#include "src/arm_common/utils.h"
 
 using namespace megdnn;
 using namespace test;
@@ -388,6 +389,42 @@ TEST_F(ARM_COMMON, ELEMWISE_FORWARD_N1HW_FP32_BCAST) {
     run(Mode::SUB);
 }
 
+#if MGB_ENABLE_SVE
+TEST_F(ARM_COMMON, ELEMWISE_FORWARD_BINARY_SVE) {
+    if (!arm_common::cpu_has_sve()) {
+        return;
+    }
+    using Mode = ElemwiseForward::Param::Mode;
+    Checker<ElemwiseForward> checker(handle());
+
+    //! positive values keep TRUE_DIV away from the zero divisor
+    UniformFloatRNG rng(1e-1, 1e1), rng_signed(-1e1, 1e1);
+    checker.set_epsilon(1e-5);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_dtype(1, dtype::Float32());
+
+    //! the sizes cover the predicated tails of any vector length
+    auto run = [&](Mode mode) {
+        for (size_t size : {1, 3, 4, 15, 16, 17, 63, 64, 65, 1000}) {
+            // VEC_VEC
+            checker.set_param(mode).execs({{size}, {size}, {}});
+            checker.set_param(mode).execs({{3, size}, {3, size}, {}});
+            // VEC_SCALAR
+            checker.set_param(mode).execs({{3, size}, {1}, {}});
+            // SCALAR_VEC
+            checker.set_param(mode).execs({{1}, {3, size}, {}});
+        }
+    };
+    for (auto mode : {Mode::ADD, Mode::SUB, Mode::MUL, Mode::MIN, Mode::MAX,
+                      Mode::FUSE_ADD_RELU}) {
+        checker.set_rng(0, &rng_signed).set_rng(1, &rng_signed);
+        run(mode);
+    }
+    checker.set_rng(0, &rng).set_rng(1, &rng);
+    run(Mode::TRUE_DIV);
+}
+#endif
+
 TEST_F(ARM_COMMON, ELEMWISE_FORWARD_TERNARY_RECORD) {
     using Mode = ElemwiseForward::Param::Mode;
     TaskRecordChecker<ElemwiseForward> checker(0);
@@ -1,6 +1,7 @@
 #include "test/arm_common/fixture.h"
 
 #include "megdnn/oprs.h"
+#include "src/arm_common/utils.h"
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
 #include "test/common/task_record_check.h"
@@ -77,6 +78,30 @@ TEST_F(ARM_COMMON, REDUCE) {
     }
 }
 
+#if MGB_ENABLE_SVE
+TEST_F(ARM_COMMON, REDUCE_SVE) {
+    if (!arm_common::cpu_has_sve()) {
+        return;
+    }
+    using Param = Reduce::Param;
+    using Mode = Param::Mode;
+    Checker<Reduce> checker(handle());
+    UniformFloatRNG rng_float(-2, 2);
+    checker.set_rng(0, &rng_float);
+    checker.set_dtype(0, dtype::Float32());
+    checker.set_epsilon(1e-3);
+    for (auto mode : {Mode::SUM, Mode::SUM_SQR, Mode::MEAN, Mode::MAX, Mode::MIN})
+        for (size_t A : {1, 3})
+            for (size_t B : {1, 4, 15, 16, 17, 65, 1000}) {
+                //! C == 1
+                checker.set_param(Param(mode, 1)).execs({{A, B}, {}});
+                //! C > 1, the sizes cover the predicated tails
+                for (size_t C : {2, 3, 16, 17, 65})
+                    checker.set_param(Param(mode, 1)).execs({{A, B, C}, {}});
+            }
+}
+#endif
+
 TEST_F(ARM_COMMON, REDUCE_RECORD) {
     using Param = Reduce::Param;
     using Mode = Param::Mode;
@@ -222,5 +247,38 @@ TEST_F(ARM_COMMON, BENCHMARK_REDUCE) {
             }
         }
 }
+
+TEST_F(ARM_COMMON, BENCHMARK_REDUCE_MULTI_THREADS) {
+    using Mode = param::Reduce::Mode;
+    TaskExecutorConfig config;
+    config.nr_thread = 4;
+    auto handle_multi = create_cpu_handle(0, true, &config);
+    auto run = [&](const TensorShape& shape, int32_t axis, Mode mode, DType dtype) {
+        constexpr size_t RUNS = 50;
+        Benchmarker<Reduce> benchmarker(handle());
+        Benchmarker<Reduce> benchmarker_multi(handle_multi.get());
+        benchmarker.set_display(false).set_times(RUNS).set_dtype(0, dtype);
+        benchmarker_multi.set_display(false).set_times(RUNS).set_dtype(0, dtype);
+        param::Reduce param(mode, axis);
+        benchmarker.set_param(param);
+        benchmarker_multi.set_param(param);
+        auto single = benchmarker.execs({shape, {}}) / RUNS;
+        auto multi = benchmarker_multi.execs({shape, {}}) / RUNS;
+        printf("reduce %s %s axis=%d mode=%d: 1 thread %fms, 4 threads %fms "
+               "speedup=%f\n",
+               shape.to_string().c_str(), dtype.name(), axis, static_cast<int>(mode),
+               single, multi, single / multi);
+    };
+    for (auto mode : {Mode::MEAN, Mode::MAX})
+        for (auto dtype :
+             std::vector<DType>{dtype::Float32(), dtype::QuantizedS8(4.2f)}) {
+            // over C and over H of NCHW, over HW, and a global reduce
+            run({1, 256, 56, 56}, 1, mode, dtype);
+            run({8, 64, 56, 56}, 2, mode, dtype);
+            run({8, 256, 3136}, 2, mode, dtype);
+            run({1, 3 * 224 * 224 * 10}, 1, mode, dtype);
+        }
+    run({1, 3 * 224 * 224 * 10}, 1, Mode::SUM_SQR, dtype::Float32());
+}
 #endif
 // vim: syntax=cpp.doxygen
@@ -4,6 +4,8 @@
 #include "test/arm_common/fixture.h"
 #include "test/common/task_record_check.h"
 
+#include "src/arm_common/utils.h"
+
 namespace megdnn {
 namespace test {
 
@@ -79,6 +81,35 @@ TEST_F(ARM_COMMON, TYPE_CVT) {
             .execs({{1, 32, 24, 128}, {1, 32, 24, 128}});
 }
 
+#if MGB_ENABLE_SVE
+TEST_F(ARM_COMMON, TYPE_CVT_SVE) {
+    if (!arm_common::cpu_has_sve()) {
+        return;
+    }
+    Checker<TypeCvt> checker(handle());
+    //! the float values exceed the range of the quantized dtype to check the
+    //! saturation
+    UniformFloatRNG rng_float{-40.f, 40.f};
+    UniformIntRNG rng8{INT8_MIN, INT8_MAX};
+
+    for (size_t size : {1, 3, 4, 15, 16, 17, 63, 64, 65, 10000}) {
+        checker.set_rng(0, &rng_float)
+                .set_dtype(0, dtype::Float32())
+                .set_dtype(1, dtype::QuantizedS8(0.245121f))
+                .execs({{size}, {size}});
+
+        checker.set_rng(0, &rng8)
+                .set_dtype(0, dtype::QuantizedS8(0.245121f))
+                .set_dtype(1, dtype::Float32())
+                .execs({{size}, {size}});
+
+        checker.set_dtype(0, dtype::Int8())
+                .set_dtype(1, dtype::Float32())
+                .execs({{size}, {size}});
+    }
+}
+#endif
+
 TEST_F(ARM_COMMON, TYPE_CVT_RECORD) {
     TaskRecordChecker<TypeCvt> checker(0);
     UniformIntRNG rng{INT32_MIN >> 1, INT32_MAX >> 1};
@@ -58,5 +58,75 @@ TEST_F(ARMV7, CONV_BIAS_MATMUL_QS8) {
                 .execs({arg.src, arg.filter, arg.bias, {}, {}});
     }
 }
+
+TEST_F(ARMV7, CONV_BIAS_MATMUL_QS8_TAIL) {
+    //! output channels and spatial sizes not divisible by the gemm block, which
+    //! is 6x8 with dotprod and 4x2 otherwise
+    Checker<ConvBiasForward> checker(handle());
+    checker.set_before_exec_callback(
+            conv_bias::ConvBiasAlgoChecker<ConvBias>("S8MATMUL"));
+    UniformIntRNG rng{-50, 50};
+    checker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.7f))
+            .set_dtype(2, dtype::QuantizedS32(6.75f))
+            .set_dtype(4, dtype::QuantizedS8(60.25f))
+            .set_rng(0, &rng)
+            .set_rng(1, &rng)
+            .set_rng(2, &rng)
+            .set_epsilon(1.0f);
+    using NLMode = param::ConvBias::NonlineMode;
+    for (size_t oc : {1, 5, 6, 7, 13})
+        for (size_t hw : {3, 5, 9})
+            for (size_t kernel : {1, 3})
+                for (auto mode : {NLMode::IDENTITY, NLMode::RELU, NLMode::H_SWISH}) {
+                    param::ConvBias param;
+                    param.pad_h = param.pad_w = kernel / 2;
+                    param.nonlineMode = mode;
+                    checker.set_param(param).execs(
+                            {{1, 7, hw, hw},
+                             {oc, 7, kernel, kernel},
+                             {1, oc, 1, 1},
+                             {},
+                             {}});
+                }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(ARMV7, BENCHMARK_CONV_BIAS_MATMUL_QS8) {
+    constexpr size_t RUNS = 50;
+    Benchmarker<ConvBias> benchmarker(handle());
+    benchmarker.set_before_exec_callback(
+            conv_bias::ConvBiasAlgoChecker<ConvBias>("S8MATMUL"));
+    benchmarker.set_dtype(0, dtype::QuantizedS8(2.5f))
+            .set_dtype(1, dtype::QuantizedS8(2.7f))
+            .set_dtype(2, dtype::QuantizedS32(6.75f))
+            .set_dtype(4, dtype::QuantizedS8(60.25f))
+            .set_times(RUNS)
+            .set_display(false);
+    Benchmarker<ConvBias> benchmarker_float(handle());
+    benchmarker_float.set_times(RUNS).set_display(false);
+
+    auto run = [&](size_t IC, size_t OC, size_t H, size_t kernel) {
+        param::ConvBias param;
+        param.pad_h = param.pad_w = kernel / 2;
+        param.nonlineMode = param::ConvBias::NonlineMode::RELU;
+        TensorShapeArray shapes{
+                {1, IC, H, H}, {OC, IC, kernel, kernel}, {1, OC, 1, 1}, {}, {}};
+        auto int_used = benchmarker.set_param(param).exec(shapes) / RUNS;
+        auto float_used = benchmarker_float.set_param(param).exec(shapes) / RUNS;
+        float computations = IC * OC * H * H * kernel * kernel * 2.f * 1e-6f;
+        printf("IC=%zu OC=%zu H=%zu k=%zu: int8 %f ms %f Gops, float %f ms %f "
+               "Gflops, speedup %f\n",
+               IC, OC, H, kernel, int_used, computations / int_used, float_used,
+               computations / float_used, float_used / int_used);
+    };
+    run(32, 32, 56, 1);
+    run(64, 64, 28, 1);
+    run(128, 128, 14, 1);
+    run(256, 256, 7, 1);
+    run(32, 32, 56, 3);
+    run(64, 64, 28, 3);
+}
+#endif
 }  // namespace
 // vim: syntax=cpp.doxygen
@@ -0,0 +1,88 @@
+#include "test/common/benchmark_suite.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace megdnn;
+using namespace test;
+using namespace benchmark_suite;
+
+namespace {
+double env_double(const char* name) {
+    auto value = std::getenv(name);
+    return value ? std::atof(value) : 0;
+}
+
+std::string layouts_str(const TensorLayoutArray& layouts) {
+    std::string ret;
+    for (auto&& layout : layouts) {
+        if (!ret.empty())
+            ret += " ";
+        ret += layout.ndim ? layout.TensorShape::to_string() : "{}";
+    }
+    return ret;
+}
+}  // anonymous namespace
+
+Recorder::Recorder(std::string backend)
+        : m_backend{std::move(backend)},
+          m_peak_gflops{env_double("MEGDNN_BENCH_PEAK_GFLOPS")},
+          m_peak_gbps{env_double("MEGDNN_BENCH_PEAK_GBPS")} {}
+
+void Recorder::add(
+        const std::string& opr, const std::string& name,
+        const TensorLayoutArray& layouts, double time_ms, double flops) {
+    Record record;
+    record.opr = opr;
+    record.name = name;
+    record.shapes = layouts_str(layouts);
+    record.time_ms = time_ms;
+    record.flops = flops;
+    for (auto&& layout : layouts) {
+        if (layout.ndim)
+            record.bytes += layout.span().dist_byte();
+    }
+    double secs = time_ms * 1e-3;
+    if (secs > 0) {
+        record.gflops = flops / secs * 1e-9;
+        record.gbps = record.bytes / secs * 1e-9;
+    }
+    if (flops > 0 && m_peak_gflops > 0 && m_peak_gbps > 0) {
+        double attainable =
+                std::min(m_peak_gflops, flops / record.bytes * m_peak_gbps);
+        record.efficiency = record.gflops / attainable;
+    } else if (flops == 0 && m_peak_gbps > 0) {
+        record.efficiency = record.gbps / m_peak_gbps;
+    }
+    printf("%s %s [%s]: %.4fms %.2fGFlops %.2fGB/s\n", opr.c_str(), name.c_str(),
+           record.shapes.c_str(), time_ms, record.gflops, record.gbps);
+    m_records.emplace_back(std::move(record));
+}
+
+void Recorder::dump() const {
+    auto dir = std::getenv("MEGDNN_BENCH_OUTPUT_DIR");
+    std::string path = std::string{dir ? dir : "."} + "/megdnn_bench_" +
+                       m_backend + ".json";
+    FILE* fout = fopen(path.c_str(), "w");
+    megdnn_assert(fout, "failed to open %s", path.c_str());
+    fprintf(fout,
+            "{\n  \"backend\": \"%s\",\n  \"peak_gflops\": %g,\n"
+            "  \"peak_gbps\": %g,\n  \"records\": [",
+            m_backend.c_str(), m_peak_gflops, m_peak_gbps);
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        auto&& r = m_records[i];
+        fprintf(fout,
+                "%s\n    {\"opr\": \"%s\", \"name\": \"%s\", \"shapes\": \"%s\", "
+                "\"time_ms\": %.6g, \"flops\": %.6g, \"bytes\": %.6g, "
+                "\"gflops\": %.6g, \"gbps\": %.6g, \"efficiency\": %.4g}",
+                i ? "," : "", r.opr.c_str(), r.name.c_str(), r.shapes.c_str(),
+                r.time_ms, r.flops, r.bytes, r.gflops, r.gbps, r.efficiency);
+    }
+    fprintf(fout, "\n  ]\n}\n");
+    fclose(fout);
+    printf("benchmark results of %s written to %s\n", m_backend.c_str(),
+           path.c_str());
+}
+
+// vim: syntax=cpp.doxygen
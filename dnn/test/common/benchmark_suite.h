@@ -0,0 +1,263 @@
+#pragma once
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+
+#include <string>
+#include <vector>
+
+namespace megdnn {
+namespace test {
+namespace benchmark_suite {
+
+/*!
+ * \brief result of one case of the benchmark suite
+ *
+ * The roofline efficiency is the achieved throughput divided by the attainable
+ * one, min(peak_gflops, flops / bytes * peak_gbps), or the achieved bandwidth
+ * divided by peak_gbps for the oprs without computation. It is negative if the
+ * peak of the device is not given.
+ */
+struct Record {
+    std::string opr, name, shapes;
+    //! average time of one run
+    double time_ms = 0;
+    double flops = 0, bytes = 0;
+    double gflops = 0, gbps = 0, efficiency = -1;
+};
+
+//! collect the records of the suite on a backend and dump them to json
+class Recorder {
+public:
+    explicit Recorder(std::string backend);
+
+    void add(const std::string& opr, const std::string& name,
+             const TensorLayoutArray& layouts, double time_ms, double flops);
+
+    const std::vector<Record>& records() const { return m_records; }
+
+    /*!
+     * \brief write the records to ${MEGDNN_BENCH_OUTPUT_DIR}/megdnn_bench_<backend>.json
+     *
+     * The peaks used for roofline efficiency are read from the environment
+     * variables MEGDNN_BENCH_PEAK_GFLOPS and MEGDNN_BENCH_PEAK_GBPS; the output
+     * dir defaults to the current dir. Use tools/compare_benchmark.py to check the
+     * output against a stored baseline.
+     */
+    void dump() const;
+
+private:
+    std::string m_backend;
+    double m_peak_gflops, m_peak_gbps;
+    std::vector<Record> m_records;
+};
+
+//! run time of each case, in seconds, for adaptive benchmarking
+constexpr float CASE_SECS = 0.2f;
+
+template <typename Opr, typename T>
+double run_case(
+        Handle* handle, const typename Opr::Param& param,
+        const TensorLayoutArray& layouts) {
+    Benchmarker<Opr, T> benchmarker(handle);
+    benchmarker.set_display(false)
+            .set_adaptive_benchmark(CASE_SECS)
+            .set_param(param);
+    return benchmarker.execl(layouts);
+}
+
+inline TensorLayout contig(const TensorShape& shape) {
+    return {shape, dtype::Float32()};
+}
+
+/*!
+ * \brief run the shapes taken from real models for the main oprs
+ *
+ * \tparam T the timer of the backend, e.g. CUTimer for cuda
+ */
+template <typename T = Timer>
+void run(Handle* handle, const std::string& backend) {
+    Recorder recorder{backend};
+
+    // conv_bias: N, IC, OC, H, W, F, S, group
+    struct ConvCase {
+        const char* name;
+        size_t n, ic, oc, h, w, f, s, group;
+    };
+    ConvCase conv_cases[] = {
+            {"resnet50_conv1", 1, 3, 64, 224, 224, 7, 2, 1},
+            {"resnet50_res2_3x3", 1, 64, 64, 56, 56, 3, 1, 1},
+            {"resnet50_res3_1x1", 1, 512, 128, 28, 28, 1, 1, 1},
+            {"resnet50_res4_3x3", 1, 256, 256, 14, 14, 3, 1, 1},
+            {"resnet50_res5_1x1", 1, 512, 2048, 7, 7, 1, 1, 1},
+            {"mobilenetv2_dw3x3", 1, 144, 144, 56, 56, 3, 1, 144},
+            {"mobilenetv2_pw1x1", 1, 144, 24, 56, 56, 1, 1, 1},
+            {"resnet50_res2_3x3_bs32", 32, 64, 64, 56, 56, 3, 1, 1},
+    };
+    for (auto&& c : conv_cases) {
+        param::ConvBias param;
+        param.nonlineMode = param::ConvBias::NonlineMode::RELU;
+        param.pad_h = param.pad_w = c.f / 2;
+        param.stride_h = param.stride_w = c.s;
+        size_t oh = (c.h + c.f / 2 * 2 - c.f) / c.s + 1,
+               ow = (c.w + c.f / 2 * 2 - c.f) / c.s + 1;
+        TensorShape filter{c.oc, c.ic, c.f, c.f};
+        if (c.group > 1) {
+            param.sparse = param::ConvBias::Sparse::GROUP;
+            filter = {c.group, c.oc / c.group, c.ic / c.group, c.f, c.f};
+        }
+        TensorLayoutArray layouts{
+                contig({c.n, c.ic, c.h, c.w}), contig(filter), contig({1, c.oc, 1, 1}),
+                contig(TensorShape{}), contig({c.n, c.oc, oh, ow})};
+        double flops = 2.0 * c.n * c.oc * oh * ow * c.ic / c.group * c.f * c.f;
+        recorder.add(
+                "conv_bias", c.name, layouts,
+                run_case<ConvBias, T>(handle, param, layouts), flops);
+    }
+
+    // matrix_mul: M, K, N
+    struct MatMulCase {
+        const char* name;
+        size_t m, k, n;
+    };
+    MatMulCase matmul_cases[] = {
+            {"bert_base_qkv", 512, 768, 2304},
+            {"bert_base_ffn1", 512, 768, 3072},
+            {"bert_base_ffn2", 512, 3072, 768},
+            {"resnet50_fc", 32, 2048, 1000},
+            {"gemv", 1, 4096, 4096},
+    };
+    for (auto&& c : matmul_cases) {
+        TensorLayoutArray layouts{
+                contig({c.m, c.k}), contig({c.k, c.n}), contig({c.m, c.n})};
+        recorder.add(
+                "matrix_mul", c.name, layouts,
+                run_case<MatrixMul, T>(handle, {}, layouts), 2.0 * c.m * c.k * c.n);
+    }
+
+    // elemwise
+    using EMode = param::Elemwise::Mode;
+    struct ElemwiseCase {
+        const char* name;
+        EMode mode;
+        TensorShapeArray shapes;
+        //! arithmetic operations per output element
+        double ops;
+    };
+    ElemwiseCase elemwise_cases[] = {
+            {"relu", EMode::RELU, {{32, 64, 56, 56}, {}}, 1},
+            {"add_residual", EMode::ADD, {{32, 256, 56, 56}, {32, 256, 56, 56}, {}}, 1},
+            {"add_bias_bcast", EMode::ADD, {{32, 256, 56, 56}, {1, 256, 1, 1}, {}}, 1},
+            {"fma3",
+             EMode::FUSE_MUL_ADD3,
+             {{512, 3072}, {1, 3072}, {1, 3072}, {}},
+             2},
+            {"gelu", EMode::GELU, {{512, 3072}, {}}, 8},
+    };
+    for (auto&& c : elemwise_cases) {
+        param::Elemwise param{c.mode};
+        TensorLayoutArray layouts;
+        for (auto&& shape : c.shapes) {
+            layouts.push_back(contig(shape));
+        }
+        layouts.back() = layouts.front();
+        recorder.add(
+                "elemwise", c.name, layouts,
+                run_case<Elemwise, T>(handle, param, layouts),
+                c.ops * layouts.back().total_nr_elems());
+    }
+
+    // reduce: shape, axis
+    struct ReduceCase {
+        const char* name;
+        TensorShape shape;
+        int32_t axis;
+    };
+    ReduceCase reduce_cases[] = {
+            {"global_pool", {32, 2048, 49}, 2},
+            {"channel_sum", {32, 256, 3136}, 1},
+            {"row_sum", {512, 3072}, 1},
+            {"col_sum", {512, 3072}, 0},
+    };
+    for (auto&& c : reduce_cases) {
+        param::Reduce param{param::Reduce::Mode::SUM, c.axis};
+        TensorShape dst = c.shape;
+        dst[static_cast<size_t>(c.axis)] = 1;
+        TensorLayoutArray layouts{contig(c.shape), contig(dst)};
+        recorder.add(
+                "reduce", c.name, layouts,
+                run_case<Reduce, T>(handle, param, layouts),
+                c.shape.total_nr_elems());
+    }
+
+    // relayout: contiguous shape and the permutation of the source
+    struct RelayoutCase {
+        const char* name;
+        TensorShape shape;
+        std::vector<size_t> perm;
+    };
+    RelayoutCase relayout_cases[] = {
+            {"nchw_to_nhwc", {32, 64, 56, 56}, {0, 2, 3, 1}},
+            {"nhwc_to_nchw", {32, 56, 56, 64}, {0, 3, 1, 2}},
+            {"attention_heads", {8, 512, 12, 64}, {0, 2, 1, 3}},
+            {"transpose_2d", {4096, 4096}, {1, 0}},
+    };
+    for (auto&& c : relayout_cases) {
+        auto src = contig(c.shape).dimshuffle(c.perm);
+        TensorLayoutArray layouts{src, contig(src)};
+        recorder.add(
+                "relayout", c.name, layouts,
+                run_case<Relayout, T>(handle, {}, layouts), 0);
+    }
+
+    // softmax: shape, axis
+    struct SoftmaxCase {
+        const char* name;
+        TensorShape shape;
+        int32_t axis;
+    };
+    SoftmaxCase softmax_cases[] = {
+            {"bert_base_attention", {8, 12, 512, 512}, 3},
+            {"classifier", {32, 1000}, 1},
+    };
+    for (auto&& c : softmax_cases) {
+        TensorLayoutArray layouts{contig(c.shape), contig(c.shape)};
+        // max, sub, exp, sum and div
+        recorder.add(
+                "softmax", c.name, layouts,
+                run_case<SoftmaxForward, T>(handle, {c.axis}, layouts),
+                5.0 * c.shape.total_nr_elems());
+    }
+
+    // layer_norm: number of slices, slice length
+    struct NormCase {
+        const char* name;
+        size_t n, len;
+    };
+    NormCase norm_cases[] = {
+            {"bert_base", 4096, 768},
+            {"bert_large", 4096, 1024},
+            {"long_slice", 64, 65536},
+    };
+    for (auto&& c : norm_cases) {
+        LayerNormForward::Param param;
+        param.normalized_dim = 1;
+        param.normalized_size = c.len;
+        TensorLayoutArray layouts{
+                contig({c.n, c.len}), contig({c.len}), contig({c.len}),
+                contig({c.n, c.len}), contig({c.n}), contig({c.n})};
+        // mean, variance, normalize and affine
+        recorder.add(
+                "layer_norm", c.name, layouts,
+                run_case<LayerNormForward, T>(handle, param, layouts),
+                8.0 * c.n * c.len);
+    }
+
+    recorder.dump();
+}
+
+}  // namespace benchmark_suite
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -149,9 +149,10 @@ void copy_tensors(
         //! use QuantizedS16 dtype in winograd_filter_preprocess now.
         cb(::megdnn::dtype::QuantizedS16) MEGDNN_FOREACH_QUANTIZED_LOWBIT_DTYPE(cb)
                 cb(::megdnn::dtype::Uint16) cb(::megdnn::dtype::QuantizedS1)
-                        cb(::megdnn::dtype::Bool)
+                        cb(::megdnn::dtype::Bool) cb(::megdnn::dtype::Float8E4M3)
+                                cb(::megdnn::dtype::Float8E5M2)
 #undef cb
-                                default : megdnn_trap();
+                                        default : megdnn_trap();
     }
 }
 
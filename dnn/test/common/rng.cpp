@@ -119,6 +119,7 @@ void IIDRNG::gen(const TensorND& tensor) {
         return;                                                     \
     }
     MEGDNN_FOREACH_COMPUTING_DTYPE(cb);
+    cb(::megdnn::dtype::Float8E4M3) cb(::megdnn::dtype::Float8E5M2)
 #undef cb
 #define cb(DType)                                                              \
     if (tensor.layout.dtype.enumv() == DTypeTrait<DType>::enumv) {             \
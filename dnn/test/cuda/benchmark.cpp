@@ -1,10 +1,12 @@
 #include "test/cuda/fixture.h"
 
 #include "megdnn/oprs.h"
+#include "test/common/benchmark_suite.h"
 #include "test/common/benchmarker.h"
 #include "test/common/tensor.h"
 #include "test/common/timer.h"
 #include "test/common/workspace_wrapper.h"
+#include "test/cuda/benchmark.h"
 #include "test/cuda/utils.h"
 
 namespace megdnn {
@@ -175,6 +177,10 @@ TEST_F(CUDA, BENCHMARK_LOCAL) {
     };
     run(32, 64, 7, 7, 64, 5, 5, 3, 3);
 }
+
+TEST_F(CUDA, BENCHMARK_SUITE) {
+    benchmark_suite::run<CUTimer>(handle_cuda(), "cuda");
+}
 #endif
 
 }  // namespace test
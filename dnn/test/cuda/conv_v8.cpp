@@ -290,5 +290,56 @@ TEST_F(CUDA, CONV_BIAS_V8_IMMA) {
             {{2, 8, 12, 12, 32}, {512, 8, 1, 1, 32}, {1, 16, 1, 1, 32}, {}, {}});
 }
 
+#if CUDNN_VERSION >= 8400
+TEST_F(CUDA, CONV_BIAS_V8_PLAN_STORAGE) {
+    class Storage final : public CudnnPlanStorage {
+    public:
+        std::mutex mtx;
+        std::unordered_map<std::string, std::string> plans;
+        size_t nr_hit = 0;
+
+        std::string get(const std::string& key) override {
+            MEGDNN_LOCK_GUARD(mtx);
+            auto iter = plans.find(key);
+            if (iter == plans.end()) {
+                return {};
+            }
+            ++nr_hit;
+            return iter->second;
+        }
+
+        void put(const std::string& key, const std::string& plan) override {
+            MEGDNN_LOCK_GUARD(mtx);
+            plans[key] = plan;
+        }
+    };
+    auto storage = std::make_shared<Storage>();
+    auto orig = set_cudnn_plan_storage(storage);
+
+    Checker<ConvBiasForward> checker(handle_cuda());
+    checker.set_before_exec_callback(
+            conv_bias::ConvBiasAlgoChecker<ConvBiasForward>(ExecutionPolicyAlgoName{
+                    ConvBiasForward::algo_name<ConvBiasForward::DefaultParam>(
+                            "CUDNN:ConvBiasActivationV8", {})
+                            .c_str()}));
+    UniformFloatRNG rng(0.f, 1.f);
+    checker.set_rng(0, &rng).set_rng(1, &rng).set_rng(2, &rng).set_rng(3, &rng);
+    param::ConvBias param;
+    param.pad_h = param.pad_w = 1;
+    param.nonlineMode = param::ConvBias::NonlineMode::RELU;
+    checker.set_param(param).execs(
+            {{2, 16, 9, 9}, {16, 16, 3, 3}, {1, 16, 1, 1}, {2, 16, 9, 9}, {}});
+    set_cudnn_plan_storage(orig);
+
+    //! the plans are cached in process after they are built, so they are only
+    //! loaded from the storage in another process
+    ASSERT_EQ(0u, storage->nr_hit);
+    ASSERT_FALSE(storage->plans.empty());
+    for (auto&& i : storage->plans) {
+        ASSERT_FALSE(i.second.empty());
+    }
+}
+#endif
+
 #endif
 // vim: syntax=cpp.doxygen
@@ -15,7 +15,14 @@ TEST_F(CUDA, CUMSUM) {
     };
     std::vector<TestArg> args, args_int32;
     for (auto shape :
-         TensorShapeArray{{10000}, {33000, 33}, {100, 100, 100}, {30, 30, 30, 30}}) {
+         TensorShapeArray{
+                 {10000},
+                 {33000, 33},
+                 {100, 100, 100},
+                 {30, 30, 30, 30},
+                 // lines of more than one tile are scanned by look-back
+                 {3, 2049},
+                 {8, 100000}}) {
         for (size_t axis = 0; axis < shape.ndim; ++axis) {
             args.emplace_back(param::Cumsum(axis, true, true), shape);
             args.emplace_back(param::Cumsum(axis, true, false), shape);
@@ -286,6 +286,25 @@ TEST_F(CUDA, CUTLASS_GEMM_SPLIT_K_MULTI_BATCHSIZE) {
             [](const matrix_mul::TestArg& arg) { return arg.k <= arg.n; });
 }
 
+TEST_F(CUDA, CUTLASS_GEMM_SPLIT_K_SKINNY_HEURISTIC) {
+    auto opr = handle_cuda()->create_operator<MatrixMulForward>();
+    Checker<MatrixMulForward> checker(handle_cuda(), false);
+    UniformFloatRNG rng(-1, 1);
+    checker.set_rng(0, &rng).set_rng(1, &rng).set_epsilon(1e-3);
+    for (size_t m : {1, 4, 9, 16})
+        for (size_t n : {64, 1000})
+            for (size_t k : {4096, 5000}) {
+                TensorLayout A{{m, k}, dtype::Float32()},
+                        B{{k, n}, dtype::Float32()}, C{{m, n}, dtype::Float32()};
+                auto algo = opr->get_algorithm_info_heuristic(A, B, C);
+                ASSERT_EQ(0u, algo.desc.name.find("CUTLASS_FLOAT32_SIMT_SPLIT_K_"))
+                        << algo.desc.name;
+                checker.set_before_exec_callback(
+                        AlgoChecker<MatrixMulForward>(algo.desc.name.c_str()));
+                checker.execs({{m, k}, {k, n}, {}});
+            }
+}
+
 TEST_F(CUDA, CUTLASS_GEMV_BATCHED_STRIDED_128_MULTI_BATCHSIZE) {
     auto args = matrix_mul::get_matmul_args_no_mask();
     test_multibatchsize(
@@ -432,6 +451,44 @@ MEGDNN_FOREACH_CUTLASS_KERNEL(cb)
 #undef MEGDNN_FOREACH_CUTLASS_KERNEL
 #endif
 
+#if CUDA_VERSION >= 11000
+#define MEGDNN_FOREACH_CUTLASS_KERNEL(cb)          \
+    cb(1, 256, 128, 32, 64, 64, 32, 16, 8, 16, 3); \
+    cb(2, 128, 256, 32, 64, 64, 32, 16, 8, 16, 3); \
+    cb(3, 128, 128, 32, 64, 64, 32, 16, 8, 16, 4);
+
+#define cb(name, tbm, tbn, tbk, wm, wn, wk, im, in, ik, stage)                       \
+    TEST_F(CUDA, CUTLASS_F16_16816_GEMM_##name) {                                    \
+        require_compute_capability(8, 0);                                            \
+        matrix_mul::check_matrix_mul<MatrixMulForward>(                              \
+                dtype::Float16(), dtype::Float16(), dtype::Float16(), handle_cuda(), \
+                "CUTLASS_FLOAT16_TENSOR_OP_h" #im #in #ik "_" #tbm "X" #tbn "X" #tbk \
+                "_" #wm "X" #wn "X" #wk "_" #stage "stage",                          \
+                param::MatrixMul::Format::DEFAULT, 8, 1e-2,                          \
+                matrix_mul::get_matmul_args(), true,                                 \
+                param::MatrixMul::ComputeMode::FLOAT32);                             \
+    }
+MEGDNN_FOREACH_CUTLASS_KERNEL(cb)
+
+#undef cb
+
+#define cb(name, tbm, tbn, tbk, wm, wn, wk, im, in, ik, stage)                       \
+    TEST_F(CUDA, CUTLASS_F16_16816_GEMM_SPLIT_K_##name) {                            \
+        require_compute_capability(8, 0);                                            \
+        matrix_mul::check_matrix_mul<MatrixMulForward>(                              \
+                dtype::Float16(), dtype::Float16(), dtype::Float16(), handle_cuda(), \
+                "CUTLASS_FLOAT16_TENSOR_OP_SPLIT_K_h" #im #in #ik "_" #tbm "X" #tbn  \
+                "X" #tbk "_" #wm "X" #wn "X" #wk "_" #stage "stage",                 \
+                param::MatrixMul::Format::DEFAULT, 8, 1e-3,                          \
+                matrix_mul::get_matmul_args_split_k());                              \
+    }
+MEGDNN_FOREACH_CUTLASS_KERNEL(cb)
+
+#undef cb
+
+#undef MEGDNN_FOREACH_CUTLASS_KERNEL
+#endif
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(CUDA, BENCHMARK_CUTLASS_MATMUL) {
     benchmark_matrix_mul(
@@ -302,6 +302,49 @@ TEST_F(CUDA, ELEMWISE_BFLOAT16) {
 #undef BUILD_TERNARY_COMPLATE_TEST_CASE
 }
 
+TEST_F(CUDA, ELEMWISE_BCAST_VECT) {
+    using Mode = ElemwiseForward::Param::Mode;
+    Checker<ElemwiseForward> checker(handle_cuda());
+    auto run = [&](DType dtype, Mode mode) {
+        checker.set_param(mode).set_dtype(0, dtype).set_dtype(1, dtype).set_dtype(
+                2, dtype);
+        // contiguous and tail
+        checker.execs({{2, 3, 8, 8}, {2, 3, 8, 8}, {}});
+        checker.execs({{2, 3, 5, 7}, {2, 3, 5, 7}, {}});
+        // NCHW channel bias: BCAST_101
+        checker.execs({{2, 16, 8, 8}, {1, 16, 1, 1}, {}});
+        checker.execs({{1, 16, 1, 1}, {2, 16, 8, 8}, {}});
+        checker.execs({{2, 16, 7, 3}, {1, 16, 1, 1}, {}});
+        // NHWC channel bias: BCAST_10
+        checker.execs({{2, 8, 8, 16}, {1, 1, 1, 16}, {}});
+        checker.execs({{2, 8, 8, 15}, {1, 1, 1, 15}, {}});
+        // column vector: BCAST_01
+        checker.execs({{24, 32}, {24, 1}, {}});
+        checker.execs({{24, 30}, {24, 1}, {}});
+        // NCHW4 channel bias: BCAST_1010
+        checker.execs({{2, 4, 5, 5, 4}, {1, 4, 1, 1, 4}, {}});
+        // scalar
+        checker.execs({{2, 16, 8, 8}, {1}, {}});
+        checker.execs({{1}, {3, 5, 7}, {}});
+        // ternary
+        checker.set_param(Mode::FUSE_MUL_ADD3);
+        checker.execs({{2, 16, 8, 8}, {1, 16, 1, 1}, {1, 16, 1, 1}, {}});
+        checker.execs({{2, 8, 8, 16}, {1, 1, 1, 16}, {2, 8, 8, 16}, {}});
+    };
+    UniformIntRNG i_rng{-8, 8};
+    checker.set_rng(0, &i_rng).set_rng(1, &i_rng).set_rng(2, &i_rng);
+    for (auto mode : {Mode::ADD, Mode::MUL, Mode::MAX}) {
+        run(dtype::Int8(), mode);
+    }
+    UniformFloatRNG f_rng{-2.f, 2.f};
+    checker.set_rng(0, &f_rng).set_rng(1, &f_rng).set_rng(2, &f_rng);
+    checker.set_epsilon(1e-2);
+    for (auto mode : {Mode::ADD, Mode::MUL, Mode::MAX}) {
+        run(dtype::Float16(), mode);
+        run(dtype::BFloat16(), mode);
+    }
+}
+
 TEST_F(CUDA, ELEMWISE_ADD_BCAST_10_INT8_INPLACE) {
     constexpr size_t A = 2, B = 48, C0 = 14, C1 = 14, C = C0 * C1;
     SyncedTensor<dt_int8> t0(handle_cuda(), {TensorShape{A, B, C0, C1}, dtype::Int8()}),
@@ -0,0 +1,114 @@
+#include "test/cuda/fixture.h"
+
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+
+using Mode = param::EmbeddingBag::Mode;
+
+constexpr size_t NUM_EMBEDDINGS = 50, BATCH = 6, NR_INDICES = 40;
+//! the third bag is empty
+constexpr int32_t OFFSETS[BATCH] = {0, 5, 5, 17, 30, 38};
+
+//! fill the offsets, and indices with many repeated rows
+void fill_bags(TensorND& indices, TensorND& offsets) {
+    auto idx = indices.ptr<dt_int32>();
+    for (size_t i = 0; i < NR_INDICES; ++i) {
+        idx[i] = (i * i + 3) % 13 * 3;
+    }
+    std::copy(OFFSETS, OFFSETS + BATCH, offsets.ptr<dt_int32>());
+}
+
+//! pick a position in each bag as the argmax of each channel
+void fill_max_idx(TensorND& max_idx, size_t dim) {
+    auto ptr = max_idx.ptr<dt_int32>();
+    for (size_t b = 0; b < BATCH; ++b) {
+        int32_t begin = OFFSETS[b], end = b + 1 < BATCH ? OFFSETS[b + 1] : NR_INDICES;
+        for (size_t c = 0; c < dim; ++c) {
+            ptr[b * dim + c] = begin == end ? -1 : begin + c % (end - begin);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_F(CUDA, EMBEDDING_BAG_FORWARD) {
+    Checker<EmbeddingBagForward> checker(handle_cuda());
+    UniformFloatRNG rng(-1, 1);
+    checker.set_tensors_constraint([](CheckerHelper::TensorValueArray& tensors) {
+        fill_bags(tensors[1], tensors[2]);
+    });
+    for (auto mode : {Mode::SUM, Mode::MEAN, Mode::MAX}) {
+        for (size_t dim : {67, 300}) {
+            for (DType dtype : std::vector<DType>{dtype::Float32(), dtype::Float16()}) {
+                EmbeddingBagForward::Param param;
+                param.mode = mode;
+                size_t nr_psw = mode == Mode::SUM ? NR_INDICES : 0;
+                checker.set_param(param)
+                        .set_epsilon(dtype == dtype::Float16() ? 1e-2 : 1e-3)
+                        .set_dtype(0, dtype)
+                        .set_dtype(1, dtype::Int32())
+                        .set_dtype(2, dtype::Int32())
+                        .set_dtype(3, dtype)
+                        .set_dtype(4, dtype)
+                        .set_dtype(5, dtype::Int32())
+                        .set_rng(0, &rng)
+                        .set_rng(3, &rng)
+                        .execs({{NUM_EMBEDDINGS, dim},
+                                {NR_INDICES},
+                                {BATCH},
+                                {nr_psw},
+                                {},
+                                {}});
+            }
+        }
+    }
+}
+
+TEST_F(CUDA, EMBEDDING_BAG_BACKWARD) {
+    Checker<EmbeddingBagBackward> checker(handle_cuda());
+    UniformFloatRNG rng(-1, 1);
+    for (auto mode : {Mode::SUM, Mode::MEAN, Mode::MAX}) {
+        for (size_t dim : {67, 300}) {
+            checker.set_tensors_constraint(
+                    [mode, dim](CheckerHelper::TensorValueArray& tensors) {
+                        fill_bags(tensors[1], tensors[2]);
+                        if (mode == Mode::MAX) {
+                            fill_max_idx(tensors[4], dim);
+                        }
+                    });
+            for (DType dtype : std::vector<DType>{dtype::Float32(), dtype::Float16()}) {
+                EmbeddingBagBackward::Param param;
+                param.mode = mode;
+                size_t nr_psw = mode == Mode::SUM ? NR_INDICES : 0;
+                TensorShape max_idx = mode == Mode::MAX ? TensorShape{BATCH, dim}
+                                                        : TensorShape{0};
+                checker.set_param(param)
+                        .set_epsilon(dtype == dtype::Float16() ? 1e-2 : 1e-3)
+                        .set_dtype(0, dtype)
+                        .set_dtype(1, dtype::Int32())
+                        .set_dtype(2, dtype::Int32())
+                        .set_dtype(3, dtype)
+                        .set_dtype(4, dtype::Int32())
+                        .set_dtype(5, dtype)
+                        .set_rng(0, &rng)
+                        .set_rng(3, &rng)
+                        .execs({{BATCH, dim},
+                                {NR_INDICES},
+                                {BATCH},
+                                {nr_psw},
+                                max_idx,
+                                {NUM_EMBEDDINGS, dim}});
+            }
+        }
+    }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,60 @@
+#include "test/cuda/fixture.h"
+
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(CUDA, FUSED_OPTIMIZER_UPDATE) {
+    using Param = FusedOptimizerUpdate::Param;
+    using Mode = Param::Mode;
+    Checker<FusedOptimizerUpdate> checker(handle_cuda());
+    checker.set_epsilon(1e-3);
+    UniformFloatRNG rng(-1, 1), rng_pos(0, 1);
+
+    //! a few tensors of different sizes with an alignment gap between them
+    std::vector<size_t> sizes{1, 33, 300, 4097, 7};
+    std::vector<int32_t> offsets;
+    size_t total = 0;
+    for (auto size : sizes) {
+        total = (total + 3) / 4 * 4;
+        offsets.push_back(total);
+        total += size;
+        offsets.push_back(total);
+    }
+    TensorShape shape{total};
+    auto constraint = [&](CheckerHelper::TensorValueArray& tensors) {
+        auto ptr = tensors[4].ptr<dt_int32>();
+        std::copy(offsets.begin(), offsets.end(), ptr);
+    };
+
+    auto run = [&](Mode mode, DType grad_dtype, float weight_decay) {
+        Param param;
+        param.mode = mode;
+        param.lr = 1e-2;
+        param.weight_decay = weight_decay;
+        param.momentum = 0.9;
+        param.step = 3;
+        checker.set_param(param)
+                .set_tensors_constraint(constraint)
+                .set_rng(0, &rng)
+                .set_rng(1, &rng)
+                .set_rng(2, &rng)
+                .set_rng(3, &rng_pos)
+                .set_dtype(1, grad_dtype)
+                .set_dtype(4, dtype::Int32())
+                .execs({shape, shape, shape, shape, {offsets.size()}, {}, {}, {}});
+    };
+    for (auto mode : {Mode::SGD, Mode::ADAM, Mode::ADAMW, Mode::LAMB}) {
+        for (float weight_decay : {0.f, 0.1f}) {
+            run(mode, dtype::Float32(), weight_decay);
+            run(mode, dtype::Float16(), weight_decay);
+        }
+    }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,95 @@
+#include "test/cuda/fixture.h"
+
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+
+constexpr size_t BATCH = 3, NUM_HEADS = 4, HEAD_DIM = 64, BLOCK_SIZE = 16,
+                 MAX_NR_BLOCKS = 4, NR_BLOCKS = 16;
+
+//! fill the positions and a block table with shuffled and unshared blocks
+void fill_cache_desc(TensorND& positions, TensorND& block_table, size_t seqlen) {
+    int32_t pos[BATCH] = {0, 17, int32_t(BLOCK_SIZE * MAX_NR_BLOCKS - seqlen)};
+    std::copy(pos, pos + BATCH, positions.ptr<dt_int32>());
+    auto table = block_table.ptr<dt_int32>();
+    for (size_t i = 0; i < BATCH * MAX_NR_BLOCKS; ++i) {
+        table[i] = (i * 5 + 3) % NR_BLOCKS;
+    }
+}
+
+}  // namespace
+
+TEST_F(CUDA, KV_CACHE_APPEND) {
+    Checker<KVCacheAppend> checker(handle_cuda());
+    UniformFloatRNG rng(-1, 1);
+    TensorShape cache{NR_BLOCKS, NUM_HEADS, BLOCK_SIZE, HEAD_DIM};
+    for (size_t seqlen : {1, 7}) {
+        auto constraint = [&](CheckerHelper::TensorValueArray& tensors) {
+            fill_cache_desc(tensors[1], tensors[2], seqlen);
+        };
+        checker.set_tensors_constraint(constraint);
+        for (uint32_t rotary_dim : {0, 32, 64}) {
+            KVCacheAppend::Param param;
+            param.num_heads = NUM_HEADS;
+            param.rotary_dim = rotary_dim;
+            for (DType dtype : std::vector<DType>{dtype::Float32(), dtype::Float16()}) {
+                checker.set_param(param)
+                        .set_epsilon(dtype == dtype::Float16() ? 1e-2 : 1e-3)
+                        .set_dtype(0, dtype)
+                        .set_dtype(1, dtype::Int32())
+                        .set_dtype(2, dtype::Int32())
+                        .set_dtype(3, dtype)
+                        .set_dtype(4, dtype)
+                        .set_dtype(5, dtype)
+                        .set_rng(0, &rng)
+                        .set_rng(3, &rng)
+                        .set_rng(4, &rng)
+                        .execs({{BATCH, seqlen, 3 * NUM_HEADS * HEAD_DIM},
+                                {BATCH},
+                                {BATCH, MAX_NR_BLOCKS},
+                                cache,
+                                cache,
+                                {}});
+            }
+        }
+    }
+}
+
+TEST_F(CUDA, KV_CACHE_ATTENTION) {
+    Checker<KVCacheAttention> checker(handle_cuda());
+    UniformFloatRNG rng(-1, 1);
+    TensorShape cache{NR_BLOCKS, NUM_HEADS, BLOCK_SIZE, HEAD_DIM};
+    for (size_t seqlen : {1, 7}) {
+        auto constraint = [&](CheckerHelper::TensorValueArray& tensors) {
+            fill_cache_desc(tensors[3], tensors[4], seqlen);
+        };
+        checker.set_tensors_constraint(constraint);
+        for (DType dtype : std::vector<DType>{dtype::Float32(), dtype::Float16()}) {
+            checker.set_epsilon(dtype == dtype::Float16() ? 1e-2 : 1e-3)
+                    .set_dtype(0, dtype)
+                    .set_dtype(1, dtype)
+                    .set_dtype(2, dtype)
+                    .set_dtype(3, dtype::Int32())
+                    .set_dtype(4, dtype::Int32())
+                    .set_dtype(5, dtype)
+                    .set_rng(0, &rng)
+                    .set_rng(1, &rng)
+                    .set_rng(2, &rng)
+                    .execs({{BATCH, NUM_HEADS, seqlen, HEAD_DIM},
+                            cache,
+                            cache,
+                            {BATCH},
+                            {BATCH, MAX_NR_BLOCKS},
+                            {}});
+        }
+    }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
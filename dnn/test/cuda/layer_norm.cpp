@@ -39,6 +39,47 @@ TEST_F(CUDA, LAYERNORM_FORWARD) {
     run(dtype::BFloat16());
 }
 
+TEST_F(CUDA, RESIDUAL_LAYERNORM_FORWARD) {
+    using Param = ResidualLayerNormForward::Param;
+    Param param;
+    param.eps = 1e-6;
+    param.normalized_dim = 1;
+    Checker<ResidualLayerNormForward> checker(handle_cuda());
+    checker.set_epsilon(1e-2);
+
+    auto run = [&](DType d) {
+        for (bool affine : {false, true})
+            for (size_t n_slices : {10, 30})
+                // 10 falls back to the unfused kernels as it is not a multiple
+                // of the vector size
+                for (size_t slice_len : {10, 32, 1024}) {
+                    param.affine = affine;
+                    param.normalized_size = slice_len;
+                    checker.set_param(param)
+                            .set_dtype(0, d)
+                            .set_dtype(1, d)
+                            .set_dtype(2, d)
+                            .set_dtype(3, d)
+                            .set_dtype(4, d)
+                            .set_dtype(5, d)
+                            .set_dtype(6, dtype::Float32())
+                            .set_dtype(7, dtype::Float32())
+                            .execs({{n_slices, slice_len},
+                                    {n_slices, slice_len},
+                                    {slice_len},
+                                    {slice_len},
+                                    {n_slices, slice_len},
+                                    {n_slices, slice_len},
+                                    {n_slices},
+                                    {n_slices}});
+                }
+    };
+
+    run(dtype::Float32());
+    run(dtype::Float16());
+    run(dtype::BFloat16());
+}
+
 TEST_F(CUDA, LAYERNORM_BACKWARD) {
     using Param = LayerNormBackward::Param;
     Param param;
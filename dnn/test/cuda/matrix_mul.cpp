@@ -446,6 +446,35 @@ TEST_F(CUDA, MATRIX_MUL_CUBLASLT_F32) {
             .execs({A, B, {}});
 }
 
+#if CUDA_VERSION >= 11080
+TEST_F(CUDA, MATRIX_MUL_CUBLASLT_FLOAT8) {
+    require_compute_capability(8, 9);
+    Checker<MatrixMul> checker(handle_cuda());
+    checker.set_before_exec_callback(AlgoChecker<MatrixMulForward>("CUBLAS_LT"));
+    UniformFloatRNG rng(-1.f, 1.f);
+    using Param = MatrixMul::Param;
+
+    //! cublasLt only supports fp8 matmul with row-major A and transposed B
+    Param param;
+    param.transposeA = false;
+    param.transposeB = true;
+    for (DType dtype : {DType(dtype::Float32()), DType(dtype::Float16())}) {
+        for (size_t m : {16, 64, 128})
+            for (size_t n : {16, 48, 256})
+                for (size_t k : {32, 128, 512}) {
+                    checker.set_param(param)
+                            .set_rng(0, &rng)
+                            .set_rng(1, &rng)
+                            .set_dtype(0, dtype::Float8E4M3())
+                            .set_dtype(1, dtype::Float8E4M3())
+                            .set_dtype(2, dtype)
+                            .set_epsilon(dtype == dtype::Float16() ? 5e-2 : 1e-3)
+                            .execs({{m, k}, {n, k}, {}});
+                }
+    }
+}
+#endif
+
 TEST_F(CUDA, MATRIX_MUL_CUDNN_F32_uncont) {
     Checker<MatrixMul> checker(handle_cuda());
     checker.set_before_exec_callback(AlgoChecker<MatrixMulForward>("MATMUL_CONV1X1"));
@@ -2,10 +2,188 @@
 #include "test/cuda/fixture.h"
 
 #include "test/common/checker.h"
+#include "test/common/tensor.h"
+#include "test/common/workspace_wrapper.h"
+#include "test/cuda/utils.h"
+
+#include <random>
 
 namespace megdnn {
 namespace test {
 
+namespace {
+
+/*!
+ * run the forward and backward of a single head attention core on cuda and
+ * compare them with the reference computed on host in double
+ */
+template <typename ctype>
+void run_mha_fwd_bwd(
+        Handle* handle, size_t batch, size_t seq_q, size_t seq_k, size_t qk_dim,
+        size_t v_dim, bool causal, float eps) {
+    using Param = MultiHeadAttnForward::Param;
+    Param param;
+    param.training = true;
+    param.need_weights = false;
+    param.num_heads = 1;
+    param.embeding_size = qk_dim;
+    param.k_size = qk_dim;
+    param.v_size = v_dim;
+    param.sm_scaler = 1.f / std::sqrt(static_cast<float>(qk_dim));
+    param.attn_mask_type = causal ? param::MultiHeadAttn::AttnMaskType::DEFAULT_MASK
+                                  : param::MultiHeadAttn::AttnMaskType::NO_MASK;
+    param.tensor_combination_type = param::MultiHeadAttn::TensorCombinationType::NONE;
+    param.attn_prob = 0.f;
+    param.out_prob = 0.f;
+
+    DType dtype = typename DTypeTrait<ctype>::dtype();
+    TensorLayout query{{batch, seq_q, qk_dim}, dtype},
+            key{{batch, seq_k, qk_dim}, dtype}, value{{batch, seq_k, v_dim}, dtype},
+            weight{{0}, dtype}, empty{dtype}, out, attn_weight, mask_rs, othr_rs;
+
+    //! the inputs are rounded to ctype, the reference uses the rounded values
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    auto make_input = [&](const TensorLayout& layout) {
+        std::vector<ctype> host(layout.total_nr_elems());
+        for (auto&& i : host)
+            i = static_cast<ctype>(dist(gen));
+        return host;
+    };
+    auto hq = make_input(query), hk = make_input(key), hv = make_input(value),
+         hdo = make_input(TensorLayout{{batch, seq_q, v_dim}, dtype});
+
+    auto fwd = handle->create_operator<MultiHeadAttnForward>();
+    fwd->param() = param;
+    fwd->deduce_layout(
+            query, key, value, weight, empty, empty, empty, out, attn_weight, mask_rs,
+            othr_rs);
+    Tensor<ctype> dq_in(handle, query), dk_in(handle, key), dv_in(handle, value),
+            dw(handle, weight), dempty(handle, empty), dout(handle, out),
+            ddo(handle, out);
+    Tensor<> dattn_weight(handle, attn_weight), dmask_rs(handle, mask_rs),
+            dothr_rs(handle, othr_rs);
+    megdnn_memcpy_H2D(handle, dq_in.ptr(), hq.data(), hq.size() * sizeof(ctype));
+    megdnn_memcpy_H2D(handle, dk_in.ptr(), hk.data(), hk.size() * sizeof(ctype));
+    megdnn_memcpy_H2D(handle, dv_in.ptr(), hv.data(), hv.size() * sizeof(ctype));
+    megdnn_memcpy_H2D(handle, ddo.ptr(), hdo.data(), hdo.size() * sizeof(ctype));
+    {
+        WorkspaceWrapper workspace(
+                handle, fwd->get_workspace_in_bytes(
+                                query, key, value, weight, empty, empty, empty, out,
+                                attn_weight, mask_rs, othr_rs));
+        fwd->exec(
+                dq_in.tensornd(), dk_in.tensornd(), dv_in.tensornd(), dw.tensornd(),
+                dempty.tensornd(), dempty.tensornd(), dempty.tensornd(),
+                dout.tensornd(), dattn_weight.tensornd(), dmask_rs.tensornd(),
+                dothr_rs.tensornd(), workspace.workspace());
+    }
+
+    auto bwd = handle->create_operator<MultiHeadAttnBackward>();
+    bwd->param() = param;
+    TensorLayout dquery, dkey, dvalue, dweight, dbias_k, dbias_v;
+    bwd->deduce_layout(
+            out, query, key, value, weight, empty, attn_weight, mask_rs, othr_rs,
+            dquery, dkey, dvalue, dweight, dbias_k, dbias_v);
+    Tensor<ctype> ddq(handle, dquery), ddk(handle, dkey), ddv(handle, dvalue),
+            ddw(handle, dweight), ddbias_k(handle, dbias_k), ddbias_v(handle, dbias_v);
+    {
+        WorkspaceWrapper workspace(
+                handle, bwd->get_workspace_in_bytes(
+                                out, query, key, value, weight, empty, attn_weight,
+                                mask_rs, othr_rs, dquery, dkey, dvalue, dweight,
+                                dbias_k, dbias_v));
+        bwd->exec(
+                ddo.tensornd(), dq_in.tensornd(), dk_in.tensornd(), dv_in.tensornd(),
+                dw.tensornd(), dempty.tensornd(), dattn_weight.tensornd(),
+                dmask_rs.tensornd(), dothr_rs.tensornd(), ddq.tensornd(),
+                ddk.tensornd(), ddv.tensornd(), ddw.tensornd(), ddbias_k.tensornd(),
+                ddbias_v.tensornd(), workspace.workspace());
+    }
+    auto to_host = [&](Tensor<ctype>& t) {
+        std::vector<ctype> host(t.layout().total_nr_elems());
+        megdnn_memcpy_D2H(handle, host.data(), t.ptr(), host.size() * sizeof(ctype));
+        return host;
+    };
+    auto ho = to_host(dout), hdq = to_host(ddq), hdk = to_host(ddk),
+         hdv = to_host(ddv);
+    megdnn_sync(handle);
+
+    auto check = [&](const char* name, const std::vector<ctype>& actual,
+                     const std::vector<double>& expect) {
+        ASSERT_EQ(expect.size(), actual.size());
+        for (size_t i = 0; i < expect.size(); ++i) {
+            double a = static_cast<float>(actual[i]);
+            ASSERT_LE(std::abs(a - expect[i]), eps * std::max(1., std::abs(expect[i])))
+                    << name << "[" << i << "]: expect=" << expect[i]
+                    << " actual=" << a << " batch=" << batch << " seq_q=" << seq_q
+                    << " seq_k=" << seq_k << " qk_dim=" << qk_dim
+                    << " v_dim=" << v_dim << " causal=" << causal;
+        }
+    };
+    auto f = [](ctype x) { return static_cast<double>(static_cast<float>(x)); };
+    std::vector<double> eo(batch * seq_q * v_dim), edq(batch * seq_q * qk_dim),
+            edk(batch * seq_k * qk_dim), edv(batch * seq_k * v_dim);
+    std::vector<double> prob(seq_q * seq_k), dprob(seq_q * seq_k);
+    for (size_t b = 0; b < batch; ++b) {
+        auto q = &hq[b * seq_q * qk_dim], k = &hk[b * seq_k * qk_dim],
+             v = &hv[b * seq_k * v_dim], dy = &hdo[b * seq_q * v_dim];
+        auto o = &eo[b * seq_q * v_dim], dq = &edq[b * seq_q * qk_dim],
+             dk = &edk[b * seq_k * qk_dim], dv = &edv[b * seq_k * v_dim];
+        for (size_t i = 0; i < seq_q; ++i) {
+            //! the causal mask hides the keys after the query position
+            size_t nr_key = causal ? std::min(seq_k, i + 1) : seq_k;
+            double max_logit = -INFINITY, sum = 0;
+            for (size_t j = 0; j < seq_k; ++j) {
+                double logit = 0;
+                for (size_t d = 0; d < qk_dim; ++d)
+                    logit += f(q[i * qk_dim + d]) * f(k[j * qk_dim + d]);
+                prob[i * seq_k + j] = j < nr_key ? logit * param.sm_scaler : -INFINITY;
+                max_logit = std::max(max_logit, prob[i * seq_k + j]);
+            }
+            for (size_t j = 0; j < seq_k; ++j) {
+                auto&& p = prob[i * seq_k + j];
+                p = j < nr_key ? std::exp(p - max_logit) : 0.;
+                sum += p;
+            }
+            for (size_t j = 0; j < seq_k; ++j)
+                prob[i * seq_k + j] /= sum;
+            double delta = 0;
+            for (size_t d = 0; d < v_dim; ++d) {
+                double acc = 0;
+                for (size_t j = 0; j < seq_k; ++j)
+                    acc += prob[i * seq_k + j] * f(v[j * v_dim + d]);
+                o[i * v_dim + d] = acc;
+                delta += acc * f(dy[i * v_dim + d]);
+            }
+            for (size_t j = 0; j < seq_k; ++j) {
+                double dp = 0;
+                for (size_t d = 0; d < v_dim; ++d)
+                    dp += f(dy[i * v_dim + d]) * f(v[j * v_dim + d]);
+                //! the grad of the logit, including the softmax scaler
+                dprob[i * seq_k + j] =
+                        prob[i * seq_k + j] * (dp - delta) * param.sm_scaler;
+            }
+        }
+        for (size_t i = 0; i < seq_q; ++i)
+            for (size_t j = 0; j < seq_k; ++j) {
+                double p = prob[i * seq_k + j], ds = dprob[i * seq_k + j];
+                for (size_t d = 0; d < v_dim; ++d)
+                    dv[j * v_dim + d] += p * f(dy[i * v_dim + d]);
+                for (size_t d = 0; d < qk_dim; ++d) {
+                    dq[i * qk_dim + d] += ds * f(k[j * qk_dim + d]);
+                    dk[j * qk_dim + d] += ds * f(q[i * qk_dim + d]);
+                }
+            }
+    }
+    check("out", ho, eo);
+    check("dq", hdq, edq);
+    check("dk", hdk, edk);
+    check("dv", hdv, edv);
+}
+
+}  // anonymous namespace
+
 TEST_F(CUDA, MULTIHEADATTN_FORWARD) {
     using Param = MultiHeadAttnForward::Param;
     Param param;
@@ -150,6 +328,62 @@ TEST_F(CUDA, MULTIHEADATTN_FORWARD) {
     run(dtype::Float16());
 }
 
+TEST_F(CUDA, MULTIHEADATTN_FORWARD_FLASH) {
+    require_compute_capability(8, 0);
+    using Param = MultiHeadAttnForward::Param;
+    Param param;
+    param.training = false;
+    param.need_weights = false;
+    param.num_heads = 1;
+    param.attn_mask_type = param::MultiHeadAttn::AttnMaskType::NO_MASK;
+    param.tensor_combination_type = param::MultiHeadAttn::TensorCombinationType::NONE;
+    Checker<MultiHeadAttnForward> checker(handle_cuda(), false);
+    auto run = [&](DType d, size_t batch, size_t seq_q, size_t seq_k, size_t qk_dim,
+                   size_t v_dim) {
+        param.embeding_size = qk_dim;
+        param.k_size = qk_dim;
+        param.v_size = v_dim;
+        param.sm_scaler = 1.f / std::sqrt(static_cast<float>(qk_dim));
+        checker.set_param(param).set_bypass(8).set_bypass(9).set_bypass(10);
+        checker.set_dtype(0, d).set_dtype(1, d).set_dtype(2, d).set_dtype(3, d);
+        checker.execs(
+                {{batch, seq_q, qk_dim},
+                 {batch, seq_k, qk_dim},
+                 {batch, seq_k, v_dim},
+                 {0},
+                 {},
+                 {},
+                 {},
+                 {},
+                 {},
+                 {},
+                 {}});
+    };
+    checker.set_epsilon(1e-2);
+    for (size_t seq_q : {1, 63, 130})
+        for (size_t seq_k : {1, 31, 100})
+            for (size_t dim : {16, 64, 128}) {
+                run(dtype::Float16(), 3, seq_q, seq_k, dim, dim);
+            }
+    run(dtype::Float16(), 2, 77, 45, 40, 96);
+}
+
+TEST_F(CUDA, MULTIHEADATTN_FORWARD_BACKWARD_FLASH) {
+    require_compute_capability(8, 0);
+    for (bool causal : {false, true}) {
+        for (size_t seq_q : {1, 63, 130})
+            for (size_t seq_k : {1, 31, 100})
+                for (size_t dim : {16, 64, 128}) {
+                    run_mha_fwd_bwd<dt_float16>(
+                            handle_cuda(), 3, seq_q, seq_k, dim, dim, causal, 2e-2);
+                    run_mha_fwd_bwd<dt_bfloat16>(
+                            handle_cuda(), 3, seq_q, seq_k, dim, dim, causal, 6e-2);
+                }
+        run_mha_fwd_bwd<dt_float16>(handle_cuda(), 2, 77, 45, 40, 96, causal, 2e-2);
+        run_mha_fwd_bwd<dt_bfloat16>(handle_cuda(), 2, 77, 45, 40, 96, causal, 6e-2);
+    }
+}
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -976,4 +976,42 @@ TEST_F(CUDA, RELAYOUT_Q4) {
                      {3136, 224, 32, 1568, 1},
                      dtype::QuantizedS4{1.f}}});
 }
+
+TEST_F(CUDA, RELAYOUT_VECTORIZED) {
+    Checker<Relayout> checker(handle_cuda());
+    UniformIntRNG rng_int4{-7, 7};
+    auto q4 = dtype::QuantizedS4{1.f};
+    //! nchw64 <-> nhwc, tiled by 16 byte vectors
+    checker.set_rng(0, &rng_int4)
+            .set_rng(1, &rng_int4)
+            .set_dtype(0, q4)
+            .set_dtype(1, q4)
+            .execl(TensorLayoutArray{
+                    {{2, 33, 33, 4, 64}, {278784, 2112, 64, 69696, 1}, q4},
+                    {{2, 33, 33, 4, 64}, {278784, 8448, 256, 64, 1}, q4}})
+            .execl(TensorLayoutArray{
+                    {{2, 4, 15, 15, 64}, {57600, 64, 3840, 256, 1}, q4},
+                    {{2, 4, 15, 15, 64}, {57600, 14400, 960, 64, 1}, q4}});
+    //! nchw4 -> nchw32 and nchw4 -> nhwc of int8, by 4 byte vectors
+    checker.set_dtype(0, dtype::Int8()).set_dtype(1, dtype::Int8());
+    checker.execl(TensorLayoutArray{
+                          {{2, 8, 15, 15, 8, 4},
+                           {57600, 7200, 60, 4, 900, 1},
+                           dtype::Int8()},
+                          {{2, 8, 15, 15, 8, 4},
+                           {57600, 7200, 480, 32, 4, 1},
+                           dtype::Int8()}})
+            .execl(TensorLayoutArray{
+                    {{2, 15, 15, 64, 4}, {57600, 60, 4, 900, 1}, dtype::Int8()},
+                    {{2, 15, 15, 64, 4}, {57600, 3840, 256, 4, 1}, dtype::Int8()}});
+    //! float with runs of 8 elements, and with runs that can not be vectorized
+    checker.set_dtype(0, dtype::Float32()).set_dtype(1, dtype::Float32());
+    checker.execs({{3, 33, 256, 8}, {3, 256, 33, 8}})
+            .execl(TensorLayoutArray{
+                    {{3, 33, 256, 8}, {67584, 8, 264, 1}, dtype::Float32()},
+                    {{3, 33, 256, 8}, {67584, 2048, 8, 1}, dtype::Float32()}})
+            .execl(TensorLayoutArray{
+                    {{3, 33, 256, 3}, {25344, 3, 99, 1}, dtype::Float32()},
+                    {{3, 33, 256, 3}, {25344, 768, 3, 1}, dtype::Float32()}});
+}
 // vim: syntax=cpp.doxygen
@@ -398,20 +398,125 @@ void run_dropout(Handle* handle) {
         float real_drop = droped_cnt * 1.0 / inp.layout().total_nr_elems();
         ASSERT_LT(abs(drop_prob - real_drop), 1e-2);
 
-#if CUDNN_VERSION >= 7000
         bwd->exec(
                 doup.tensornd_dev(), mask.tensornd_dev(), dinp.tensornd_dev(),
                 {bwd_ws.ptr_mutable_dev(), bwd_ws.layout().total_nr_elems()});
         for (size_t i = 0; i < inp.layout().total_nr_elems(); ++i) {
             ASSERT_TRUE(oup.ptr_host()[i] == dinp.ptr_host()[i]);
         }
-#endif
     };
 
     run({32, 32, 32, 32}, 0.2);
     run({100000}, 0.3);
 }
 
+//! the philox streams of cuda and naive are the same for the same seed
+template <typename T>
+void run_dropout_same_as_naive(Handle* handle, Handle* handle_naive) {
+    using ctype = typename DTypeTrait<T>::ctype;
+    TensorShape shape{1001};
+    auto make_fwd = [&](Handle* h) {
+        auto opr = h->create_operator<DropoutForward>();
+        opr->param().drop_prob = 0.3;
+        opr->param().seed = 7;
+        return opr;
+    };
+    auto fwd = make_fwd(handle), fwd_naive = make_fwd(handle_naive);
+    TensorLayout lay{shape, T()};
+    TensorLayout mask_lay{{fwd->get_mask_size_in_bytes(lay)}, dtype::Byte()};
+    ASSERT_EQ(mask_lay.total_nr_elems(), fwd_naive->get_mask_size_in_bytes(lay));
+
+    SyncedTensor<ctype> inp(handle, lay), oup(handle, lay);
+    SyncedTensor<ctype> inp_naive(handle_naive, lay), oup_naive(handle_naive, lay);
+    SyncedTensor<dt_byte> mask(handle, mask_lay), mask_naive(handle_naive, mask_lay);
+    for (size_t i = 0; i < lay.total_nr_elems(); ++i) {
+        inp.ptr_mutable_host()[i] = inp_naive.ptr_mutable_host()[i] =
+                static_cast<ctype>(i % 13);
+    }
+    // the second exec continues the stream of the first one
+    for (int iter = 0; iter < 2; ++iter) {
+        fwd->exec(
+                inp.tensornd_dev(), oup.tensornd_dev(), mask.tensornd_dev(), {});
+        fwd_naive->exec(
+                inp_naive.tensornd_dev(), oup_naive.tensornd_dev(),
+                mask_naive.tensornd_dev(), {});
+        auto m = reinterpret_cast<const uint8_t*>(mask.ptr_host()),
+             m_naive = reinterpret_cast<const uint8_t*>(mask_naive.ptr_host());
+        for (size_t i = 0; i < lay.total_nr_elems(); ++i) {
+            ASSERT_EQ(m[i], m_naive[i]);
+            ASSERT_EQ(
+                    static_cast<float>(oup.ptr_host()[i]),
+                    static_cast<float>(oup_naive.ptr_host()[i]));
+        }
+    }
+}
+
+template <typename T>
+void run_logits_sampling(Handle* handle) {
+    using ctype = typename DTypeTrait<T>::ctype;
+    auto opr = handle->create_operator<LogitsSamplingRNG>();
+
+    //! the frequencies of many identical rows follow the filtered softmax
+    size_t num_groups = 20000, len_logits = 5;
+    TensorLayout ly_logits{TensorShape{num_groups, len_logits}, T()};
+    TensorLayout ly_out{TensorShape{num_groups}, dtype::Int32()};
+    SyncedTensor<ctype> logits(handle, ly_logits);
+    SyncedTensor<dt_int32> out(handle, ly_out);
+    float probs[] = {0.05, 0.1, 0.15, 0.3, 0.4};
+    auto logits_ptr = logits.ptr_mutable_host();
+    for (size_t i = 0; i < num_groups * len_logits; ++i) {
+        logits_ptr[i] = ctype(std::log(probs[i % len_logits]));
+    }
+    auto check = [&](uint32_t top_k, float top_p, std::vector<size_t> kept) {
+        opr->param().top_k = top_k;
+        opr->param().top_p = top_p;
+        opr->exec(logits.tensornd_dev(), out.tensornd_dev(), {});
+        std::vector<float> expected(len_logits, 0), freq(len_logits, 0);
+        float sum = 0;
+        for (auto i : kept) {
+            expected[i] = std::exp(static_cast<float>(logits_ptr[i]));
+            sum += expected[i];
+        }
+        auto ptr = out.ptr_mutable_host();
+        for (size_t i = 0; i < num_groups; ++i) {
+            ASSERT_LT(static_cast<size_t>(ptr[i]), len_logits);
+            freq[ptr[i]] += 1.f / num_groups;
+        }
+        for (size_t i = 0; i < len_logits; ++i) {
+            ASSERT_LE(std::abs(freq[i] - expected[i] / sum), 1e-2);
+        }
+    };
+    check(0, 1.f, {0, 1, 2, 3, 4});
+    check(3, 1.f, {2, 3, 4});
+    check(0, 0.6f, {3, 4});
+    //! 0.4 / 0.85 of the top 3 is less than 0.5, so the second one is kept
+    check(3, 0.5f, {3, 4});
+    check(1, 1.f, {4});
+
+    //! greedy decoding of a large vocabulary by a tiny top_p
+    num_groups = 4, len_logits = 128000;
+    ly_logits = TensorLayout{TensorShape{num_groups, len_logits}, T()};
+    ly_out = TensorLayout{TensorShape{num_groups}, dtype::Int32()};
+    SyncedTensor<ctype> large_logits(handle, ly_logits);
+    SyncedTensor<dt_int32> large_out(handle, ly_out);
+    auto large_ptr = large_logits.ptr_mutable_host();
+    for (size_t i = 0; i < num_groups * len_logits; ++i) {
+        large_ptr[i] = ctype(-static_cast<float>(i % 1000) / 100);
+    }
+    size_t argmax[] = {1, 5000, 64001, 127999};
+    for (size_t i = 0; i < num_groups; ++i) {
+        large_ptr[i * len_logits + argmax[i]] = ctype(1);
+    }
+    opr->param().top_k = 0;
+    opr->param().top_p = 1e-6;
+    opr->param().temperature = 0.5;
+    opr->exec(large_logits.tensornd_dev(), large_out.tensornd_dev(), {});
+    auto large_out_ptr = large_out.ptr_mutable_host();
+    for (size_t i = 0; i < num_groups; ++i) {
+        ASSERT_EQ(static_cast<size_t>(large_out_ptr[i]), argmax[i]);
+    }
+}
+
 }  // anonymous namespace
 
 TEST_F(CUDA, UNIFORM_RNG_F32) {
@@ -475,6 +580,14 @@ TEST_F(CUDA, MULTINOMIAL_RNG_F16) {
     run_multinomial_without_replacement<dtype::Float16>(handle_cuda());
 }
 
+TEST_F(CUDA, LOGITS_SAMPLING_RNG_F32) {
+    run_logits_sampling<dtype::Float32>(handle_cuda());
+}
+
+TEST_F(CUDA, LOGITS_SAMPLING_RNG_F16) {
+    run_logits_sampling<dtype::Float16>(handle_cuda());
+}
+
 TEST_F(CUDA, BETA_RNG_F32) {
     run_beta<dtype::Float32>(handle_cuda());
 }
@@ -527,6 +640,11 @@ TEST_F(CUDA, DROPOUT_F16) {
     run_dropout<dtype::Float16>(handle_cuda());
 }
 
+TEST_F(CUDA, DROPOUT_SAME_AS_NAIVE) {
+    run_dropout_same_as_naive<dtype::Float32>(handle_cuda(), handle_naive());
+    run_dropout_same_as_naive<dtype::Float16>(handle_cuda(), handle_naive());
+}
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -524,6 +524,51 @@ TEST_F(CUDA, WARP_PERSPECTIVE_NHWC_NCHW) {
     }
 }
 
+TEST_F(CUDA, WARP_PERSPECTIVE_U8_FLOAT16) {
+    using Param = WarpPerspective::Param;
+    WarpPerspective::Param param;
+    WarpPerspectiveMatRNG rng;
+    param.imode = Param::InterpolationMode::LINEAR;
+    param.border_val = 0.3f;
+    for (auto format : {Param::Format::NCHW, Param::Format::NHWC_NCHW}) {
+        bool is_nhwc = format == Param::Format::NHWC_NCHW;
+        auto src_shape = [is_nhwc](size_t n, size_t h, size_t w) {
+            return is_nhwc ? TensorShape{n, h, w, 3} : TensorShape{n, 3, h, w};
+        };
+        param.format = format;
+        Checker<WarpPerspectiveForward> checker(handle_cuda());
+        checker.set_rng(1, &rng);
+        checker.set_dtype(0, dtype::Uint8());
+        checker.set_dtype(2, dtype::Float16());
+        for (auto bmode :
+             {WarpPerspective::BorderMode::WRAP, WarpPerspective::BorderMode::REFLECT,
+              WarpPerspective::BorderMode::REPLICATE,
+              WarpPerspective::BorderMode::CONSTANT}) {
+            param.bmode = bmode;
+            checker.set_param(param);
+            checker.set_epsilon(1 + 1e-3);
+            checker.execs({src_shape(2, 10, 11), {2, 3, 3}, {2, 3, 11, 12}});
+            checker.execs({src_shape(1, 25, 25), {1, 3, 3}, {1, 3, 51, 51}});
+        }
+
+        // many ROIs cropped from a few images
+        Checker<WarpPerspective, WarpPerspectiveMatIdxProxy> checker_idx(
+                handle_cuda());
+        constexpr int N_SRC = 5;
+        UniformIntRNG mat_idx_rng{0, N_SRC - 1};
+        checker_idx.set_dtype(0, dtype::Quantized8Asymm(0.5f, (uint8_t)3));
+        checker_idx.set_rng(1, &rng);
+        checker_idx.set_dtype(2, dtype::Int32());
+        checker_idx.set_rng(2, &mat_idx_rng);
+        checker_idx.set_dtype(3, dtype::Float16());
+        param.bmode = WarpPerspective::Param::BorderMode::REFLECT;
+        checker_idx.set_param(param);
+        checker_idx.set_epsilon(1 + 1e-3);
+        checker_idx.execs(
+                {src_shape(N_SRC, 17, 13), {123, 3, 3}, {123}, {123, 3, 16, 15}});
+    }
+}
+
 TEST_F(CUDA, WARP_PERSPECTIVE_FORWARD_NCHW_INT8) {
     warp_perspective::run_int8_test(handle_cuda());
 }
@@ -25,6 +25,24 @@ TEST_F(FALLBACK, CONCAT) {
         }
     }
 }
+TEST_F(FALLBACK_MULTI_THREADS, CONCAT_SMALL_INNER) {
+    // concat along channels of NCHW44, where each copy is 4 elements and the
+    // copies are split into tasks
+    Checker<Concat> checker(handle());
+    using Param = Concat::Param;
+    for (auto dtype : std::vector<DType>{dtype::Float32(), dtype::Int8()}) {
+        Param param;
+        param.axis = 1;
+        TensorShapeArray shapes{
+                {64, 3, 1, 1, 4}, {64, 5, 1, 1, 4}, {64, 1, 1, 1, 4}, {}};
+        for (size_t i = 0; i < shapes.size(); ++i)
+            checker.set_dtype(i, dtype);
+        checker.set_param(param).exec(shapes);
+        param.axis = 4;
+        shapes = {{256, 8, 7, 7, 4}, {256, 8, 7, 7, 1}, {}};
+        checker.set_param(param).exec(shapes);
+    }
+}
 TEST_F(FALLBACK, CONCAT_RECORD) {
     TaskRecordChecker<Concat> checker(1);
     using Param = Concat::Param;
@@ -325,6 +325,28 @@ TEST_F(FALLBACK_MULTI_THREADS, CONV_BIAS_FORWARD_IM2COL_8X8X16) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, CONV_BIAS_GROUP_SMALL_CHANNEL) {
+    using namespace conv_bias;
+    std::vector<TestArg> im2col_args, conv1x1_args;
+    param::ConvBias param;
+    param.sparse = param::ConvBias::Sparse::GROUP;
+    //! many groups with few channels, which are split over threads by groups
+    //! instead of by tiles
+    for (size_t n : {1, 3})
+        for (size_t group : {2, 8, 32})
+            for (size_t cpg : {1, 4, 8})
+                for (size_t kernel : {1, 3}) {
+                    param.pad_h = param.pad_w = kernel / 2;
+                    auto& args = kernel == 1 ? conv1x1_args : im2col_args;
+                    args.emplace_back(
+                            param, TensorShape{n, group * cpg, 14, 13},
+                            TensorShape{group, cpg, cpg, kernel, kernel},
+                            TensorShape{1, group * cpg, 1, 1});
+                }
+    check_conv_bias(im2col_args, handle(), "IM2COLMATMUL:FB_F32_K8X12X1");
+    check_conv_bias(conv1x1_args, handle(), "CONV1x1:FB_F32_K8X12X1:24");
+}
+
 TEST_F(FALLBACK_MULTI_THREADS, CONV_BIAS_FORWARD) {
     using namespace conv_bias;
     param::ConvBias cur_param;
@@ -471,6 +493,38 @@ TEST_F(FALLBACK_MULTI_THREADS, CONVBIAS_GI_CHANNEL_WISE_STRIDE2_FP32_NCHW44) {
             "F32_CHANNEL_WISE_NCHW44");
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, CONVBIAS_GI_CHANNEL_WISE_LARGE_FP32_NCHW44) {
+    check_conv_bias(
+            get_nchw44_channel_wise_args({7}, 1, false, false, false), handle(),
+            "F32_CHANNEL_WISE_LARGE_NCHW44");
+    check_conv_bias(
+            get_nchw44_channel_wise_args({7}, 2, false, false, false), handle(),
+            "F32_CHANNEL_WISE_LARGE_NCHW44");
+
+    using NLMode = param::ConvBias::NonlineMode;
+    std::vector<conv_bias::TestArg> args;
+    for (size_t stride : {1, 2})
+        for (size_t kernel : {9, 13, 31})
+            for (size_t size : {5, 16, 37}) {
+                param::ConvBias param;
+                param.stride_h = param.stride_w = stride;
+                param.pad_h = param.pad_w = kernel / 2;
+                param.nonlineMode = NLMode::RELU;
+                param.format = param::ConvBias::Format::NCHW44;
+                param.sparse = param::ConvBias::Sparse::GROUP;
+                size_t oh = (size + kernel / 2 * 2 - kernel) / stride + 1;
+                args.emplace_back(
+                        param, TensorShape{2, 3, size, size + 3, 4},
+                        TensorShape{3, 1, 1, kernel, kernel, 4},
+                        TensorShape{1, 3, 1, 1, 4});
+                args.emplace_back(
+                        param, TensorShape{1, 2, size, size, 4},
+                        TensorShape{2, 1, 1, kernel, kernel, 4},
+                        TensorShape{1, 2, oh, oh, 4});
+            }
+    check_conv_bias(args, handle(), "F32_CHANNEL_WISE_LARGE_NCHW44");
+}
+
 TEST_F(FALLBACK_MULTI_THREADS, CONVBIAS_GI_DIRECT_FP32_NCHW44_S1_K7) {
     //! k=7 s=1
     check_conv_bias(
@@ -761,6 +761,96 @@ TEST_F(FALLBACK, CONVOLUTION_BACKWARD_DATA_NAIVE_ALGO) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, CONVOLUTION_BACKWARD_DATA_MATMUL) {
+    Checker<ConvolutionBackwardData> checker(handle());
+    using Param = ConvolutionBackwardData::Param;
+
+    Param param;
+    auto run = [&](size_t n, size_t ic, size_t oh, size_t ow, size_t oc, size_t fh,
+                   size_t fw, size_t stride, size_t padding, size_t group,
+                   size_t pack) {
+        param.pad_h = param.pad_w = padding;
+        param.stride_h = param.stride_w = stride;
+        param.format = pack == 1 ? Param::Format::NCHW : Param::Format::NCHW44;
+
+        TensorLayout diff, grad, filter;
+        if (pack == 1) {
+            diff = {{n, oc * group, oh, ow}, dtype::Float32()};
+            filter = {{group, oc, ic, fh, fw}, dtype::Float32()};
+        } else {
+            diff = {{n, oc / 4 * group, oh, ow, 4}, dtype::Float32()};
+            filter = {{group, oc / 4, ic / 4, fh, fw, 4, 4}, dtype::Float32()};
+        }
+        param.sparse = Param::Sparse::GROUP;
+        {
+            auto opr = handle()->create_operator<ConvolutionBackwardData>();
+            opr->param() = param;
+            opr->deduce_layout(filter, diff, grad);
+        }
+        checker.set_param(param).set_before_exec_callback(
+                AlgoChecker<ConvolutionBackwardData>(
+                        pack == 1 ? "DeconvMatmul" : "DeconvMatmulNchw44"));
+        checker.exec(TensorLayoutArray{filter, diff, grad});
+    };
+
+    for (size_t pack : {1, 4}) {
+        run(1, 4, 7, 9, 4, 3, 3, 1, 1, 1, pack);
+        run(3, 8, 10, 13, 4, 3, 3, 2, 1, 1, pack);
+        run(5, 4, 11, 6, 8, 1, 1, 1, 0, 2, pack);
+        run(8, 8, 6, 7, 4, 3, 3, 1, 0, 3, pack);
+    }
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, CONVOLUTION_BACKWARD_FILTER_MATMUL) {
+    Checker<ConvolutionBackwardFilter> checker(handle());
+    using Param = ConvolutionBackwardFilter::Param;
+
+    Param param;
+    auto run = [&](size_t n, size_t ic, size_t ih, size_t iw, size_t oc, size_t fh,
+                   size_t fw, size_t stride, size_t padding, size_t dilate,
+                   size_t group, size_t pack) {
+        param.pad_h = param.pad_w = padding;
+        param.stride_h = param.stride_w = stride;
+        param.dilate_h = param.dilate_w = dilate;
+        param.sparse = group == 1 ? Param::Sparse::DENSE : Param::Sparse::GROUP;
+        TensorLayout src, filter, diff;
+        if (pack == 1) {
+            param.format = Param::Format::NCHW;
+            src = {{n, ic * group, ih, iw}, dtype::Float32()};
+            if (group == 1) {
+                filter = {{oc, ic, fh, fw}, dtype::Float32()};
+            } else {
+                filter = {{group, oc, ic, fh, fw}, dtype::Float32()};
+            }
+        } else {
+            param.format =
+                    pack == 4 ? Param::Format::NCHW44 : Param::Format::NCHW88;
+            src = {{n, ic / pack, ih, iw, pack}, dtype::Float32()};
+            filter = {{oc / pack, ic / pack, fh, fw, pack, pack}, dtype::Float32()};
+        }
+        {
+            auto opr = handle()->create_operator<Convolution>();
+            opr->param() = param;
+            opr->deduce_layout(src, filter, diff);
+        }
+        checker.set_param(param).set_epsilon(1e-3).set_before_exec_callback(
+                AlgoChecker<ConvolutionBackwardFilter>("WgradMatmul"));
+        checker.exec(TensorLayoutArray{src, diff, filter});
+    };
+
+    for (auto mode : {Param::Mode::CONVOLUTION, Param::Mode::CROSS_CORRELATION}) {
+        param.mode = mode;
+        for (size_t pack : {1, 4, 8}) {
+            run(1, 8, 5, 5, 8, 1, 1, 1, 0, 1, 1, pack);
+            run(3, 8, 10, 13, 16, 3, 3, 1, 1, 1, 1, pack);
+            run(7, 16, 11, 9, 8, 3, 2, 2, 1, 1, 1, pack);
+            run(2, 8, 12, 12, 8, 3, 3, 1, 2, 2, 1, pack);
+        }
+        run(4, 3, 10, 13, 5, 3, 3, 1, 1, 1, 2, 1);
+        run(5, 2, 17, 12, 3, 5, 3, 2, 2, 1, 3, 1);
+    }
+}
+
 #if MEGDNN_WITH_BENCHMARK
 
 TEST_F(FALLBACK, BENCHMARK_CONVOLUTION_BACKWARD_DATA_NCHW44) {
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "src/fallback/cpu_dispatch.h"
+#include "src/fallback/handle.h"
+#include "test/fallback/fixture.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+int kern_generic() {
+    return 0;
+}
+int kern_avx() {
+    return 1;
+}
+int kern_avx2() {
+    return 2;
+}
+int kern_dotprod() {
+    return 3;
+}
+}  // anonymous namespace
+
+TEST_F(FALLBACK, CPU_DISPATCH_KERNEL_TABLE) {
+    using fallback::CpuIsaLevel;
+    fallback::KernelTable<int (*)()> kerns{
+            {CpuIsaLevel::X86_AVX2, kern_avx2},
+            {CpuIsaLevel::GENERIC, kern_generic},
+            {CpuIsaLevel::X86_AVX, kern_avx},
+            {CpuIsaLevel::ARM_V8_2_DOTPROD, kern_dotprod}};
+    ASSERT_EQ(0, kerns.get(CpuIsaLevel::GENERIC)());
+    ASSERT_EQ(0, kerns.get(CpuIsaLevel::X86_SSE4_2)());
+    ASSERT_EQ(1, kerns.get(CpuIsaLevel::X86_AVX)());
+    ASSERT_EQ(2, kerns.get(CpuIsaLevel::X86_AVX2)());
+    ASSERT_EQ(2, kerns.get(CpuIsaLevel::X86_AVX512)());
+    ASSERT_EQ(0, kerns.get(CpuIsaLevel::ARM_V8_0)());
+    ASSERT_EQ(3, kerns.get(CpuIsaLevel::ARM_V8_6_I8MM)());
+
+    fallback::KernelTable<int (*)()> no_generic{{CpuIsaLevel::X86_AVX, kern_avx}};
+    ASSERT_THROW(no_generic.get(CpuIsaLevel::X86_SSE4_2), MegDNNError);
+}
+
+TEST_F(FALLBACK, CPU_DISPATCH_HANDLE_LEVEL) {
+    //! only the handles of an arch detect their level
+    ASSERT_EQ(fallback::CpuIsaLevel::GENERIC, fallback::cpu_isa_level(handle()));
+    ASSERT_STREQ(
+            "generic", fallback::cpu_isa_level_name(fallback::CpuIsaLevel::GENERIC));
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
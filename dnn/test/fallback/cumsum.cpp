@@ -0,0 +1,41 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+
+namespace megdnn {
+namespace test {
+
+namespace {
+void run_cumsum(Handle* handle) {
+    Checker<Cumsum> checker(handle);
+    checker.set_epsilon(1e-2);
+    // {2, 40000} splits each line into chunks when there are multiple threads
+    for (auto shape : TensorShapeArray{
+                 {1}, {1000}, {2, 40000}, {30, 30, 30}, {7, 100, 65}, {100000}}) {
+        for (size_t axis = 0; axis < shape.ndim; ++axis) {
+            for (bool exclusive : {true, false}) {
+                for (bool reverse : {true, false}) {
+                    checker.set_param(param::Cumsum(axis, exclusive, reverse));
+                    checker.set_dtype(0, dtype::Float32()).execs({shape, {}});
+                    checker.set_dtype(0, dtype::Int32()).execs({shape, {}});
+                }
+            }
+        }
+    }
+    checker.set_dtype(0, dtype::Int16()).execs({{13, 17, 19}, {}});
+}
+}  // namespace
+
+TEST_F(FALLBACK, CUMSUM) {
+    run_cumsum(handle());
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, CUMSUM) {
+    run_cumsum(handle());
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
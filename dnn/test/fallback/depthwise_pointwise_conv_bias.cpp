@@ -0,0 +1,85 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, DEPTHWISE_POINTWISE_CONV_BIAS) {
+    using Param = DepthwisePointwiseConvBias::Param;
+    using NonlineMode = Param::NonlineMode;
+    Checker<DepthwisePointwiseConvBias> checker(handle());
+    checker.set_epsilon(1e-3);
+    auto run = [&](size_t n, size_t c, size_t oc, size_t ih, size_t iw, size_t f,
+                   size_t stride, Param param) {
+        param.pad_h = param.pad_w = f / 2;
+        param.stride_h = param.stride_w = stride;
+        checker.set_param(param).execs(
+                {{n, c / 4, ih, iw, 4},
+                 {c / 4, 1, 1, f, f, 4},
+                 {1, c / 4, 1, 1, 4},
+                 {oc / 4, c / 4, 1, 1, 4, 4},
+                 {1, oc / 4, 1, 1, 4},
+                 {}});
+    };
+    Param param;
+    for (auto dw_mode : {NonlineMode::IDENTITY, NonlineMode::RELU})
+        for (auto pw_mode : {NonlineMode::IDENTITY, NonlineMode::H_SWISH}) {
+            param.dw_nonline_mode = dw_mode;
+            param.pw_nonline_mode = pw_mode;
+            for (size_t stride : {1, 2})
+                for (size_t f : {3, 5}) {
+                    run(1, 8, 16, 7, 9, f, stride, param);
+                    run(2, 4, 4, 1, 1, f, stride, param);
+                    run(1, 32, 24, 45, 40, f, stride, param);
+                }
+        }
+    param.dw_nonline_mode = NonlineMode::SIGMOID;
+    param.pw_nonline_mode = NonlineMode::RELU;
+    run(3, 16, 8, 12, 12, 3, 1, param);
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_DEPTHWISE_POINTWISE_CONV_BIAS) {
+    TaskExecutorConfig config;
+    config.nr_thread = 4;
+    auto handle_multi = create_cpu_handle(0, true, &config);
+    auto run = [&](size_t c, size_t oc, size_t hw, size_t stride) {
+        constexpr size_t RUNS = 20;
+        DepthwisePointwiseConvBias::Param param;
+        param.pad_h = param.pad_w = 1;
+        param.stride_h = param.stride_w = stride;
+        param.dw_nonline_mode = param.pw_nonline_mode =
+                DepthwisePointwiseConvBias::Param::NonlineMode::RELU;
+        Benchmarker<DepthwisePointwiseConvBias> benchmarker(handle());
+        Benchmarker<DepthwisePointwiseConvBias> benchmarker_multi(handle_multi.get());
+        benchmarker.set_display(false).set_times(RUNS).set_param(param);
+        benchmarker_multi.set_display(false).set_times(RUNS).set_param(param);
+        TensorShapeArray shapes{
+                {1, c / 4, hw, hw, 4},
+                {c / 4, 1, 1, 3, 3, 4},
+                {1, c / 4, 1, 1, 4},
+                {oc / 4, c / 4, 1, 1, 4, 4},
+                {1, oc / 4, 1, 1, 4},
+                {}};
+        auto single = benchmarker.execs(shapes) / RUNS;
+        auto multi = benchmarker_multi.execs(shapes) / RUNS;
+        printf("dw+pw c=%zu oc=%zu hw=%zu stride=%zu: 1 thread %fms, 4 threads "
+               "%fms speedup=%f\n",
+               c, oc, hw, stride, single, multi, single / multi);
+    };
+    run(32, 64, 112, 1);
+    run(64, 128, 112, 2);
+    run(128, 128, 56, 1);
+    run(256, 256, 28, 1);
+    run(512, 512, 14, 1);
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,104 @@
+#include "test/fallback/fixture.h"
+
+#include "src/fallback/elemwise/gi_impl/fused/fused_elemwise.h"
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+#include "test/common/tensor.h"
+
+using namespace megdnn;
+using namespace test;
+using namespace fallback::fused_elemwise;
+
+namespace {
+
+//! run the chain by one elemwise opr for each mode as the reference
+void run_reference(
+        Handle* handle, const ChainDesc& desc, const TensorNDArray& srcs,
+        const TensorND& dst) {
+    auto elemwise = handle->create_operator<Elemwise>();
+    auto layout = srcs[0].layout;
+    auto src0 = srcs[0].ptr<float>();
+    std::vector<float> acc(src0, src0 + layout.total_nr_elems());
+    std::vector<float> tmp(acc.size());
+    size_t idx = 1;
+    for (auto mode : desc.modes) {
+        TensorNDArray inputs{TensorND{acc.data(), layout}};
+        auto arity = Elemwise::ModeTrait::from_mode(mode).arity;
+        for (size_t i = 1; i < arity; ++i) {
+            inputs.push_back(srcs[idx++]);
+        }
+        elemwise->param().mode = mode;
+        elemwise->exec(inputs, {tmp.data(), layout});
+        acc.swap(tmp);
+    }
+    auto type_cvt = handle->create_operator<TypeCvt>();
+    type_cvt->exec({acc.data(), layout}, dst);
+}
+
+}  // anonymous namespace
+
+TEST_F(FALLBACK, FUSED_ELEMWISE) {
+    using Mode = Elemwise::Mode;
+    std::vector<SmallVector<Mode>> chains = {
+            {Mode::FUSE_ADD_RELU},
+            {Mode::ADD, Mode::H_SWISH},
+            {Mode::FUSE_MUL_ADD3, Mode::RELU},
+            {Mode::ADD, Mode::MUL, Mode::RELU},
+            {Mode::ADD, Mode::ADD, Mode::RELU},
+            {Mode::MAX, Mode::MIN}};
+    //! the extra inputs are cycled over the bcast101, scalar and vec types
+    const InputType types[] = {InputType::BCAST101, InputType::SCALAR, InputType::VEC};
+    const size_t N = 2, C = 3, HW = 19;
+    TensorLayout vec{{N, C, HW}, dtype::Float32()};
+    UniformFloatRNG rng{-3.f, 3.f};
+
+    for (auto&& modes : chains) {
+        for (DType dst_dtype :
+             {DType(dtype::Float32()), DType(dtype::QuantizedS8(0.05f))}) {
+            ChainDesc desc{modes, dst_dtype};
+            auto kern = get_kern(desc);
+            ASSERT_NE(nullptr, kern);
+
+            KernParam param;
+            param.batch = N;
+            param.channel = C;
+            param.channel_size = HW;
+            param.dst_dtype = dst_dtype;
+            std::vector<std::unique_ptr<Tensor<>>> holders;
+            TensorNDArray ref_srcs;
+            for (size_t i = 0; i < desc.nr_inputs(); ++i) {
+                auto type = i ? types[(i - 1) % 3] : InputType::VEC;
+                TensorShape shape = vec;
+                if (type == InputType::SCALAR) {
+                    shape = {1, 1, 1};
+                } else if (type == InputType::BCAST101) {
+                    shape = {1, C, 1};
+                }
+                holders.emplace_back(new Tensor<>(handle(), {shape, dtype::Float32()}));
+                auto&& tensor = holders.back()->tensornd();
+                rng.gen(tensor);
+                param.srcs.push_back(tensor.ptr<float>());
+                param.src_types.push_back(type);
+                ref_srcs.push_back(tensor);
+            }
+
+            TensorLayout dst_layout{vec, dst_dtype};
+            std::vector<dt_float32> dst_buf(vec.total_nr_elems()),
+                    expect_buf(vec.total_nr_elems());
+            TensorND dst{dst_buf.data(), dst_layout},
+                    expect{expect_buf.data(), dst_layout};
+            param.dst = dst.raw_ptr();
+            kern(param, 0, param.nr_rows());
+            run_reference(handle(), desc, ref_srcs, expect);
+            if (dst_dtype.enumv() == DTypeEnum::Float32) {
+                MEGDNN_ASSERT_TENSOR_EQ_EPS(expect, dst, 1e-4);
+            } else {
+                //! the rounding may differ by one at the halves
+                MEGDNN_ASSERT_TENSOR_EQ_EPS_AVG(expect, dst, 1, 1, 0.1);
+            }
+        }
+    }
+    ASSERT_EQ(nullptr, get_kern({{Mode::SIN, Mode::COS}, dtype::Float32()}));
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,44 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, FUSED_PREPROCESS) {
+    using Param = FusedPreprocess::Param;
+    Checker<FusedPreprocess> checker(handle());
+    UniformIntRNG src_rng{0, 255};
+    checker.set_epsilon(1e-3)
+            .set_rng(0, &src_rng)
+            .set_dtype(0, dtype::Uint8())
+            .set_dtype(1, dtype::Float32())
+            .set_dtype(2, dtype::Float32());
+    auto run = [&](size_t n, size_t ih, size_t iw, size_t c, size_t oh, size_t ow) {
+        for (auto color : {Param::ColorMode::NONE, Param::ColorMode::REVERSE})
+            for (auto imode : {Param::InterpolationMode::INTER_NEAREST,
+                               Param::InterpolationMode::INTER_LINEAR})
+                for (auto format : {Param::Format::NCHW, Param::Format::NCHW44}) {
+                    checker.set_param(Param{
+                                    color, imode, format, static_cast<uint32_t>(oh),
+                                    static_cast<uint32_t>(ow)})
+                            .execs({{n, ih, iw, c}, {2, c}, {}});
+                }
+    };
+    for (size_t c : {1, 3, 4}) {
+        //! downscale, upscale and the identity
+        run(2, 37, 53, c, 24, 20);
+        run(1, 9, 7, c, 33, 40);
+        run(1, 16, 16, c, 16, 16);
+        //! a single source row or column
+        run(3, 1, 11, c, 5, 6);
+        run(1, 13, 1, c, 7, 3);
+    }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
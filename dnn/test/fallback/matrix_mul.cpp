@@ -1,5 +1,7 @@
 #include "test/common/matrix_mul.h"
+#include "megdnn/algorithm_cache.h"
 #include "src/fallback/general_intrinsic/gi_common.h"
+#include "test/common/benchmarker.h"
 #include "test/common/checker.h"
 #include "test/common/rng.h"
 #include "test/common/task_record_check.h"
@@ -37,6 +39,47 @@ TEST_F(FALLBACK, MATRIX_MUL) {
     }
 }
 
+TEST_F(FALLBACK, ALGORITHM_CACHE_LAST_ENTRY) {
+    auto opr = handle()->create_operator<MatrixMul>();
+    TensorLayoutArray layouts{
+            {{4, 8}, dtype::Float32()},
+            {{8, 16}, dtype::Float32()},
+            {{4, 16}, dtype::Float32()}};
+    auto&& cache = AlgorithmCache::instance();
+    cache.clear();
+    AlgorithmCache::Key key{opr->handle(),  opr->get_opr_type(),
+                            layouts.data(), layouts.size(),
+                            &opr->param(),  sizeof(opr->param())};
+    auto&& last = opr->algo_cache_last_entry();
+    auto rst = cache.get(key, last);
+    ASSERT_FALSE(rst.policy.algo.valid());
+    ASSERT_EQ(0u, last.generation);
+
+    rst.policy.algo =
+            opr->get_algorithm_info_heuristic(layouts[0], layouts[1], layouts[2])
+                    .desc;
+    rst.workspace = 233;
+    cache.put(key, rst);
+    for (int i = 0; i < 2; ++i) {
+        auto hit = cache.get(key, last);
+        ASSERT_EQ(rst.policy.algo, hit.policy.algo);
+        ASSERT_EQ(233u, hit.workspace);
+        ASSERT_NE(0u, last.generation);
+    }
+
+    // another shape misses both the entry of the opr and the cache
+    layouts[0] = {{8, 8}, dtype::Float32()};
+    layouts[2] = {{8, 16}, dtype::Float32()};
+    ASSERT_FALSE(cache.get(key, last).policy.algo.valid());
+    layouts[0] = {{4, 8}, dtype::Float32()};
+    layouts[2] = {{4, 16}, dtype::Float32()};
+    ASSERT_TRUE(cache.get(key, last).policy.algo.valid());
+
+    // the entry of the opr is outdated by clear()
+    cache.clear();
+    ASSERT_FALSE(cache.get(key, last).policy.algo.valid());
+}
+
 TEST_F(FALLBACK, MATRIX_MUL_MK4_GI) {
     matrix_mul::check_matrix_mul(
             dtype::Float32{}, dtype::Float32{}, dtype::Float32{}, handle(),
@@ -170,6 +213,62 @@ TEST_F(FALLBACK, BATCHED_MATRIX_MUL) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, BATCHED_MATRIX_MUL_SMALL_F32) {
+    Checker<BatchedMatrixMul> checker(handle());
+    checker.set_before_exec_callback(
+            AlgoChecker<BatchedMatrixMul>("FB_BATCHED_SMALL_F32"));
+    checker.set_epsilon(1e-3);
+    using Param = MatrixMul::Param;
+    for (size_t mask = 0; mask < 4; ++mask) {
+        Param param;
+        param.transposeA = mask & 1;
+        param.transposeB = mask & 2;
+        checker.set_param(param);
+        for (size_t b : {1, 7, 33})
+            for (size_t m : {1, 3, 8, 17, 64})
+                for (size_t n : {1, 4, 10, 64})
+                    for (size_t k : {1, 9, 128}) {
+                        TensorShape AS = param.transposeA ? TensorShape{b, k, m}
+                                                          : TensorShape{b, m, k};
+                        TensorShape BS = param.transposeB ? TensorShape{b, n, k}
+                                                          : TensorShape{b, k, n};
+                        checker.execs({AS, BS, {}});
+                    }
+    }
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, BATCHED_MATRIX_MUL_INT8X8X32) {
+    Checker<BatchedMatrixMul> checker(handle());
+    checker.set_before_exec_callback(
+            AlgoChecker<BatchedMatrixMul>("FB_BATCHED_INT8X8X32"));
+    UniformIntRNG rng{-128, 127};
+    checker.set_rng(0, &rng).set_rng(1, &rng);
+    using Param = MatrixMul::Param;
+    for (size_t mask = 0; mask < 4; ++mask) {
+        Param param;
+        param.transposeA = mask & 1;
+        param.transposeB = mask & 2;
+        checker.set_param(param);
+        for (size_t b : {1, 12})
+            for (size_t m : {1, 7, 16, 128})
+                for (size_t n : {1, 9, 64, 128})
+                    for (size_t k : {1, 33, 64, 512}) {
+                        TensorShape AS = param.transposeA ? TensorShape{b, k, m}
+                                                          : TensorShape{b, m, k};
+                        TensorShape BS = param.transposeB ? TensorShape{b, n, k}
+                                                          : TensorShape{b, k, n};
+                        checker.set_dtype(0, dtype::Int8())
+                                .set_dtype(1, dtype::Int8())
+                                .set_dtype(2, dtype::Int32())
+                                .execs({AS, BS, {}});
+                        checker.set_dtype(0, dtype::QuantizedS8(0.5f))
+                                .set_dtype(1, dtype::QuantizedS8(0.25f))
+                                .set_dtype(2, dtype::QuantizedS32(0.125f))
+                                .execs({AS, BS, {}});
+                    }
+    }
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_MATRIX_MUL_FB_GI_F32_4x12) {
     auto args = matrix_mul::get_benchmark_matmul_args();
@@ -192,6 +291,31 @@ TEST_F(FALLBACK, BENCHMARK_MATRIX_FB_GI_F32_MK4_4x8) {
             "FB_GI_F32_MK4_4x8", param::MatrixMul::Format::MK4);
 }
 
+TEST_F(FALLBACK, BENCHMARK_BATCHED_MATRIX_MUL_SMALL_F32) {
+    constexpr size_t RUNS = 50;
+    TaskExecutorConfig config;
+    config.nr_thread = 4;
+    auto handle_multi = create_cpu_handle(0, true, &config);
+    Benchmarker<BatchedMatrixMul> benchmarker_default(handle_multi.get());
+    Benchmarker<BatchedMatrixMul> benchmarker_small(handle_multi.get());
+    benchmarker_default.set_times(RUNS).set_display(false).set_before_exec_callback(
+            AlgoChecker<BatchedMatrixMul>("DEFAULT"));
+    benchmarker_small.set_times(RUNS).set_display(false).set_before_exec_callback(
+            AlgoChecker<BatchedMatrixMul>("FB_BATCHED_SMALL_F32"));
+    auto run = [&](size_t b, size_t m, size_t n, size_t k) {
+        TensorShape AS{b, m, k}, BS{b, k, n};
+        auto time_default = benchmarker_default.execs({AS, BS, {}}) / RUNS;
+        auto time_small = benchmarker_small.execs({AS, BS, {}}) / RUNS;
+        printf("b=%zu m=%zu n=%zu k=%zu: default %fms, small %fms, speedup=%f\n", b,
+               m, n, k, time_default, time_small, time_default / time_small);
+    };
+    //! per head attention and group convs lowered to batched matmul
+    run(96, 16, 16, 64);
+    run(96, 64, 64, 64);
+    run(256, 8, 8, 32);
+    run(1024, 4, 16, 9);
+}
+
 #if defined(GI_SUPPORT_F16)
 TEST_F(FALLBACK, BENCHMARK_MATRIX_FB_GI_F16_MK8_8x8) {
     auto args = matrix_mul::get_benchmark_matmul_args();
@@ -0,0 +1,86 @@
+#include "test/fallback/fixture.h"
+
+#include <cmath>
+#include "megdnn/oprs/nn.h"
+#include "test/common/checker.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK, MULTIHEADATTN_FORWARD_FUSED) {
+    using Param = MultiHeadAttnForward::Param;
+    Param param;
+    param.training = false;
+    param.need_weights = false;
+    Checker<MultiHeadAttnForward> checker(handle(), false);
+    auto run = [&](size_t batch, size_t seq_q, size_t seq_k, size_t num_heads,
+                   size_t size, size_t proj_size, bool bias, size_t mask_ndim) {
+        param.num_heads = num_heads;
+        param.embeding_size = size;
+        param.k_size = proj_size ? size : size / num_heads;
+        param.v_size = size;
+        param.qproj_size = proj_size;
+        param.kproj_size = proj_size;
+        param.vproj_size = proj_size;
+        param.oproj_size = proj_size;
+        param.qbias = param.kbias = param.vbias = param.obias = bias && proj_size;
+        if (!proj_size) {
+            param.embeding_size = param.k_size;
+        }
+        size_t head_dim = proj_size ? proj_size / num_heads : param.embeding_size;
+        param.sm_scaler = 1.f / std::sqrt(static_cast<float>(head_dim));
+        size_t weight_len = 0;
+        if (proj_size) {
+            weight_len = (param.embeding_size + param.k_size + param.v_size +
+                          proj_size) *
+                                 proj_size +
+                         (bias ? 4 * proj_size : 0);
+        }
+        TensorShape attn_mask{};
+        if (mask_ndim) {
+            param.attn_mask_type =
+                    param::MultiHeadAttn::AttnMaskType::USER_DEFINED_MASK;
+            param.tensor_combination_type =
+                    param::MultiHeadAttn::TensorCombinationType::ONLY_MASK;
+            if (mask_ndim == 3) {
+                attn_mask = {batch * num_heads, seq_q, seq_k};
+            } else {
+                attn_mask = {seq_q, seq_k};
+            }
+            checker.set_dtype(4, dtype::Float32());
+        } else {
+            param.attn_mask_type = param::MultiHeadAttn::AttnMaskType::NO_MASK;
+            param.tensor_combination_type =
+                    param::MultiHeadAttn::TensorCombinationType::NONE;
+        }
+        checker.set_param(param).set_bypass(8).set_bypass(9).set_bypass(10);
+        checker.execs(
+                {{batch, seq_q, param.embeding_size},
+                 {batch, seq_k, param.k_size},
+                 {batch, seq_k, param.v_size},
+                 {weight_len},
+                 attn_mask,
+                 {},
+                 {},
+                 {},
+                 {},
+                 {},
+                 {}});
+    };
+    checker.set_epsilon(1e-4);
+    for (size_t seq_q : {1, 9, 17})
+        for (size_t seq_k : {1, 13, 70})
+            for (size_t num_heads : {1, 2, 4})
+                for (size_t proj_size : {0, 8})
+                    for (size_t mask_ndim : {0, 2, 3}) {
+                        run(2, seq_q, seq_k, num_heads, 8, proj_size, false,
+                            mask_ndim);
+                    }
+    for (size_t num_heads : {1, 4})
+        run(3, 33, 130, num_heads, 16, 16, true, 0);
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,118 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, LAYERNORM_FORWARD) {
+    using Param = LayerNormForward::Param;
+    Param param;
+    param.eps = 1e-6;
+    param.normalized_dim = 1;
+    Checker<LayerNormForward> checker(handle());
+    checker.set_epsilon(1e-3);
+    //! a large offset checks that the single pass variance stays accurate
+    UniformFloatRNG rng(100.f, 101.f);
+    checker.set_rng(0, &rng);
+
+    for (bool affine : {false, true})
+        for (size_t n_slices : {1, 7, 30})
+            for (size_t slice_len : {1, 5, 16, 77, 4099}) {
+                param.affine = affine;
+                param.normalized_size = slice_len;
+                checker.set_param(param).execs(
+                        {{n_slices, slice_len},
+                         {slice_len},
+                         {slice_len},
+                         {n_slices, slice_len},
+                         {n_slices},
+                         {n_slices}});
+            }
+    checker.execs({{2, 3, 4099}, {4099}, {4099}, {}, {}, {}});
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, GROUPNORM_FORWARD) {
+    using Param = GroupNormForward::Param;
+    Param param;
+    param.eps = 1e-6;
+    Checker<GroupNormForward> checker(handle());
+    checker.set_epsilon(1e-3);
+
+    for (bool affine : {false, true})
+        for (size_t group : {1, 3})
+            for (size_t C : {6, 9})
+                for (size_t HW : {1, 5, 33}) {
+                    param.affine = affine;
+                    param.group = group;
+                    checker.set_param(param).execs(
+                            {{3, C, HW, HW},
+                             {C},
+                             {C},
+                             {3, C, HW, HW},
+                             {3, group},
+                             {3, group}});
+                }
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, GENERALNORM_FORWARD) {
+    using Param = GeneralNormForward::Param;
+    using Mode = Param::Mode;
+    Param param;
+    param.eps = 1e-5;
+    Checker<GeneralNormForward> checker(handle());
+    checker.set_epsilon(1e-3);
+
+    for (auto mode : {Mode::LAYER_NORM, Mode::RMS_NORM})
+        for (bool affine : {false, true}) {
+            param.mode = mode;
+            param.affine = affine;
+            param.axis_start = 2;
+            param.axis_end = 4;
+            checker.set_param(param).execs(
+                    {{2, 3, 17, 65}, {17, 65}, {17, 65}, {}, {}, {}});
+            param.axis_start = 0;
+            param.axis_end = 1;
+            checker.set_param(param).execs({{9, 3, 7}, {9}, {9}, {}, {}, {}});
+            param.axis_start = 1;
+            param.axis_end = 2;
+            checker.set_param(param).execs(
+                    {{4, 33, 2, 19}, {33}, {33}, {}, {}, {}});
+            checker.set_param(param).execs({{5, 1024, 1}, {1024}, {1024}, {}, {}, {}});
+        }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_LAYERNORM_FORWARD) {
+    TaskExecutorConfig config;
+    config.nr_thread = 4;
+    auto handle_multi = create_cpu_handle(0, true, &config);
+    auto run = [&](size_t n_slices, size_t slice_len) {
+        constexpr size_t RUNS = 50;
+        LayerNormForward::Param param;
+        param.normalized_dim = 1;
+        param.normalized_size = slice_len;
+        Benchmarker<LayerNormForward> benchmarker(handle());
+        Benchmarker<LayerNormForward> benchmarker_multi(handle_multi.get());
+        benchmarker.set_display(false).set_times(RUNS).set_param(param);
+        benchmarker_multi.set_display(false).set_times(RUNS).set_param(param);
+        TensorShapeArray shapes{
+                {n_slices, slice_len}, {slice_len}, {slice_len}, {}, {}, {}};
+        auto single = benchmarker.execs(shapes) / RUNS;
+        auto multi = benchmarker_multi.execs(shapes) / RUNS;
+        printf("layer norm %zux%zu: 1 thread %fms, 4 threads %fms speedup=%f\n",
+               n_slices, slice_len, single, multi, single / multi);
+    };
+    run(128, 768);
+    run(512, 4096);
+    run(64, 65536);
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -302,6 +302,34 @@ TEST_F(FALLBACK, REDUCE_RECORD) {
     }
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, REDUCE_MULTI_THREADS) {
+    using Param = Reduce::Param;
+    using Mode = Param::Mode;
+    Checker<Reduce> checker(handle());
+    UniformFloatRNG rng_float(-1, 1);
+    UniformIntRNG rng_int{INT8_MIN >> 1, INT8_MAX >> 1};
+    //! middle axes split by column tiles, last axis by rows, and a single row
+    //! long enough for the reduced axis to be split among threads
+    std::vector<std::pair<TensorShape, int32_t>> cases = {
+            {{2, 64, 7, 7}, 1},     {{1, 3, 300, 257}, 2}, {{4, 1000, 130}, 1},
+            {{300, 700}, 1},        {{97, 3}, 1},          {{1, 100003}, 1},
+            {{3, 70001, 1}, 1}};
+    for (auto mode : {Mode::SUM, Mode::MEAN, Mode::SUM_SQR, Mode::MIN, Mode::MAX}) {
+        for (auto&& c : cases) {
+            checker.set_rng(0, &rng_float)
+                    .set_epsilon(1e-3)
+                    .set_dtype(0, dtype::Float32())
+                    .set_param(Param(mode, c.second))
+                    .execs({c.first, {}});
+            if (mode == Mode::MEAN || mode == Mode::MIN || mode == Mode::MAX) {
+                checker.set_rng(0, &rng_int)
+                        .set_dtype(0, dtype::QuantizedS8(1.3f))
+                        .execs({c.first, {}});
+            }
+        }
+    }
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_REDUCE_VS_CONV) {
     auto run = [&]() {
@@ -88,6 +88,41 @@ TEST_F(FALLBACK, RELAYOUT_Q4) {
                      dtype::QuantizedS4{1.f}}});
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, RELAYOUT_STRIDED) {
+    Checker<Relayout> checker(handle());
+    auto run = [&](const TensorShape& shape, const std::vector<size_t>& pattern,
+                   DType dtype) {
+        TensorLayout src = TensorLayout{shape, dtype}.dimshuffle(pattern);
+        TensorLayout dst{src, dtype};
+        checker.set_dtype(0, dtype).set_dtype(1, dtype);
+        //! strided src with contiguous dst and the reverse
+        checker.execl({src, dst});
+        checker.execl({dst, src});
+    };
+    for (DType dtype :
+         std::vector<DType>{dtype::Int8(), dtype::Float16(), dtype::Float32()}) {
+        run({2, 16, 7, 9}, {0, 2, 3, 1}, dtype);
+        run({1, 3, 33, 65}, {0, 2, 3, 1}, dtype);
+        run({2, 65, 33, 3}, {0, 3, 1, 2}, dtype);
+        run({2, 3, 5, 7, 11}, {4, 2, 0, 3, 1}, dtype);
+        run({3, 8, 5, 4, 6}, {0, 3, 1, 4, 2}, dtype);
+        run({130, 70}, {1, 0}, dtype);
+    }
+    run({2, 4, 6, 5}, {2, 0, 3, 1}, dtype::Int32());
+
+    //! strided rows, a broadcast source and a padded destination
+    checker.set_dtype(0, dtype::Float32()).set_dtype(1, dtype::Float32());
+    checker.execl(
+            {{{5, 7, 6}, {120, 12, 2}, dtype::Float32()},
+             {{5, 7, 6}, dtype::Float32()}});
+    checker.execl(
+            {{{4, 9, 10}, {0, 1, 0}, dtype::Float32()},
+             {{4, 9, 10}, dtype::Float32()}});
+    checker.execl(
+            {{{6, 3, 20}, dtype::Float32()},
+             {{6, 3, 20}, {128, 32, 1}, dtype::Float32()}});
+}
+
 #if MEGDNN_WITH_BENCHMARK
 TEST_F(FALLBACK, BENCHMARK_RELAYOUT_CV) {
     relayout::run_cv_benchmark(handle());
@@ -3,6 +3,7 @@
 #include "megdnn/oprs.h"
 #include "test/common/benchmarker.h"
 #include "test/common/checker.h"
+#include "test/common/rng.h"
 #include "test/common/task_record_check.h"
 #include "test/common/tensor.h"
 #include "test/common/workspace_wrapper.h"
@@ -50,6 +51,43 @@ TEST_F(FALLBACK, SOFTMAX_FORWARD) {
     checker.set_param(param6).exec(TensorShapeArray{{11, 5, 5, 5, 5, 7, 7}, {}});
 }
 
+TEST_F(FALLBACK_MULTI_THREADS, SOFTMAX_FORWARD) {
+    Checker<Softmax> checker(handle());
+    //! rows far below zero used to underflow when the max started at FLT_MIN
+    UniformFloatRNG rng(-1000.f, -900.f);
+    checker.set_rng(0, &rng).set_epsilon(1e-4);
+    for (int32_t axis : {-1, 0, 1}) {
+        Softmax::Param param{axis};
+        checker.set_param(param).exec(TensorShapeArray{{3, 1}, {}});
+        checker.set_param(param).exec(TensorShapeArray{{7, 13}, {}});
+        checker.set_param(param).exec(TensorShapeArray{{64, 1027}, {}});
+        checker.set_param(param).exec(TensorShapeArray{{5, 3, 4099}, {}});
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(FALLBACK, BENCHMARK_SOFTMAX_FORWARD) {
+    TaskExecutorConfig config;
+    config.nr_thread = 4;
+    auto handle_multi = create_cpu_handle(0, true, &config);
+    auto run = [&](const TensorShape& shape, int32_t axis) {
+        constexpr size_t RUNS = 50;
+        Benchmarker<Softmax> benchmarker(handle());
+        Benchmarker<Softmax> benchmarker_multi(handle_multi.get());
+        benchmarker.set_display(false).set_times(RUNS).set_param({axis});
+        benchmarker_multi.set_display(false).set_times(RUNS).set_param({axis});
+        auto single = benchmarker.execs({shape, {}}) / RUNS;
+        auto multi = benchmarker_multi.execs({shape, {}}) / RUNS;
+        printf("softmax %s axis=%d: 1 thread %fms, 4 threads %fms speedup=%f\n",
+               shape.to_string().c_str(), axis, single, multi, single / multi);
+    };
+    //! attention scores of 12 heads, and a softmax over channels
+    run({12, 512, 512}, -1);
+    run({12, 128, 4096}, -1);
+    run({8, 64, 56, 56}, 1);
+}
+#endif
+
 }  // namespace test
 }  // namespace megdnn
 
@@ -19,6 +19,19 @@ TEST_F(FALLBACK, SPLIT) {
         checker.set_param(param).exec(shapes);
     }
 }
+TEST_F(FALLBACK_MULTI_THREADS, SPLIT_SMALL_INNER) {
+    Checker<Split> checker(handle());
+    using Param = Split::Param;
+    for (auto dtype : std::vector<DType>{dtype::Float32(), dtype::Int8()}) {
+        Param param;
+        param.axis = 1;
+        TensorShapeArray shapes{
+                {256, 9, 7, 4}, {256, 3, 7, 4}, {256, 5, 7, 4}, {256, 1, 7, 4}};
+        for (size_t i = 0; i < shapes.size(); ++i)
+            checker.set_dtype(i, dtype);
+        checker.set_param(param).exec(shapes);
+    }
+}
 TEST_F(FALLBACK, SPLIT_RECORD) {
     TaskRecordChecker<Split> checker(1);
     using Param = Split::Param;
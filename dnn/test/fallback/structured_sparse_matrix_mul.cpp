@@ -0,0 +1,72 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+#include "test/common/tensor.h"
+#include "test/common/workspace_wrapper.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK_MULTI_THREADS, STRUCTURED_SPARSE_MATRIX_MUL) {
+    using Param = StructuredSparseMatrixMul::Param;
+    Checker<StructuredSparseMatrixMul> checker(handle());
+    checker.set_epsilon(1e-3);
+    auto run = [&](TensorShape A, size_t n, size_t sparse_n, size_t sparse_m) {
+        size_t k = A[A.ndim - 1];
+        size_t nnz = k / sparse_m * sparse_n;
+        UniformIntRNG index_rng{0, static_cast<dt_int32>(sparse_m) - 1};
+        checker.set_param(Param{
+                              static_cast<uint32_t>(sparse_n),
+                              static_cast<uint32_t>(sparse_m)})
+                .set_rng(2, &index_rng)
+                .set_dtype(0, dtype::Float32())
+                .set_dtype(1, dtype::Float32())
+                .set_dtype(2, dtype::Uint8())
+                .set_dtype(3, dtype::Float32())
+                .execs({A, {n, nnz}, {n, nnz}, {}});
+    };
+    for (auto sparsity : {std::make_pair(2, 4), std::make_pair(1, 4),
+                          std::make_pair(4, 8)}) {
+        size_t sparse_n = sparsity.first, sparse_m = sparsity.second;
+        //! rows not filling a whole block take the gather path
+        for (size_t m : {1, 5, 32, 70})
+            for (size_t n : {1, 17, 80}) {
+                run({m, 64}, n, sparse_n, sparse_m);
+                run({m, 8 * sparse_m}, n, sparse_n, sparse_m);
+            }
+        // batched activations share the weights
+        run({2, 40, 128}, 33, sparse_n, sparse_m);
+    }
+}
+
+TEST_F(FALLBACK_MULTI_THREADS, STRUCTURED_SPARSE_MATRIX_MUL_BAD_INDEX) {
+    auto opr = handle()->create_operator<StructuredSparseMatrixMul>();
+    opr->param() = {2, 4};
+    TensorLayout A{{70, 64}, dtype::Float32()}, values{{17, 32}, dtype::Float32()},
+            indices{{17, 32}, dtype::Uint8()}, C;
+    opr->deduce_layout(A, values, indices, C);
+    Tensor<> a(handle(), A), v(handle(), values), c(handle(), C);
+    Tensor<dt_uint8> idx(handle(), indices);
+    memset(a.ptr(), 0, A.span().dist_byte());
+    memset(v.ptr(), 0, values.span().dist_byte());
+    memset(idx.ptr(), 0, indices.span().dist_byte());
+    WorkspaceWrapper workspace(
+            handle(), opr->get_workspace_in_bytes(A, values, indices, C));
+    opr->exec(
+            a.tensornd(), v.tensornd(), idx.tensornd(), c.tensornd(),
+            workspace.workspace());
+    //! an index past sparse_m would read outside its group of A
+    idx.ptr()[5 * 32 + 7] = 4;
+    ASSERT_THROW(
+            opr->exec(
+                    a.tensornd(), v.tensornd(), idx.tensornd(), c.tensornd(),
+                    workspace.workspace()),
+            MegDNNError);
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,14 @@
+#include "test/common/topk.h"
+#include "test/fallback/fixture.h"
+
+using namespace megdnn;
+using namespace test;
+
+TEST_F(FALLBACK, TOP_K) {
+    run_topk_test<dtype::Float32>(handle());
+}
+TEST_F(FALLBACK, TOP_K_I32) {
+    run_topk_test<dtype::Int32>(handle());
+}
+
+// vim: syntax=cpp.doxygen
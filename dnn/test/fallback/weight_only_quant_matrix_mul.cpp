@@ -0,0 +1,40 @@
+#include "test/fallback/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/common/rng.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(FALLBACK, WEIGHT_ONLY_QUANT_MATRIX_MUL) {
+    using Param = WeightOnlyQuantMatrixMul::Param;
+    Checker<WeightOnlyQuantMatrixMul> checker(handle());
+    UniformIntRNG int_rng{-8, 7};
+    UniformFloatRNG scale_rng{0.01f, 0.1f};
+    checker.set_rng(1, &int_rng).set_rng(2, &scale_rng).set_epsilon(1e-3);
+    auto run = [&](DType weight_dtype, TensorShape A, size_t n, size_t group_size) {
+        size_t k = A[A.ndim - 1];
+        checker.set_param(Param{static_cast<uint32_t>(group_size)})
+                .set_dtype(0, dtype::Float32())
+                .set_dtype(1, weight_dtype)
+                .set_dtype(2, dtype::Float32())
+                .set_dtype(3, dtype::Float32())
+                .execs({A, {n, k}, {n, k / group_size}, {}});
+    };
+    for (DType weight_dtype : {DType(dtype::Int8()), DType(dtype::QuantizedS4(0.5f))}) {
+        for (size_t m : {1, 3, 8})
+            for (size_t n : {1, 15, 33})
+                for (size_t group_size : {2, 32, 64}) {
+                    run(weight_dtype, {m, 128}, n, group_size);
+                    run(weight_dtype, {m, 6 * group_size}, n, group_size);
+                }
+        // batched activations share the weights
+        run(weight_dtype, {2, 5, 256}, 40, 64);
+    }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,106 @@
+#include "megdnn/dtype.h"
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/naive/fixture.h"
+
+using namespace megdnn;
+using namespace test;
+
+TEST_F(NAIVE, EMBEDDING_BAG_FORWARD) {
+    Checker<EmbeddingBagForward> checker(handle(), false);
+    EmbeddingBagForward::Param param;
+
+    //! the bags are rows {0, 2} and {1}, and the last bag is empty
+    TensorND weight = TensorValue({3, 2}, dtype::Float32(), {1, 6, 3, 4, 5, 2});
+    TensorND indices = TensorValue({3}, dtype::Int32(), {0, 2, 1});
+    TensorND offsets = TensorValue({3}, dtype::Int32(), {0, 2, 3});
+    TensorND psw = TensorValue({3}, dtype::Float32(), {1.f, 2.f, 0.5f});
+
+    param.mode = EmbeddingBagForward::Param::Mode::SUM;
+    checker.set_param(param).exect(
+            Testcase{weight, indices, offsets, psw, {}, {}},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    {},
+                    TensorValue(
+                            {3, 2}, dtype::Float32(),
+                            {11.f, 10.f, 1.5f, 2.f, 0.f, 0.f}),
+                    {}});
+
+    param.mode = EmbeddingBagForward::Param::Mode::MEAN;
+    checker.set_param(param).exect(
+            Testcase{weight, indices, offsets, {}, {}, {}},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    {},
+                    TensorValue({3, 2}, dtype::Float32(), {3, 4, 3, 4, 0, 0}),
+                    {}});
+
+    param.mode = EmbeddingBagForward::Param::Mode::MAX;
+    checker.set_param(param).exect(
+            Testcase{weight, indices, offsets, {}, {}, {}},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    {},
+                    TensorValue({3, 2}, dtype::Float32(), {5, 6, 3, 4, 0, 0}),
+                    TensorValue({3, 2}, dtype::Int32(), {1, 0, 2, 2, -1, -1})});
+}
+
+TEST_F(NAIVE, EMBEDDING_BAG_BACKWARD) {
+    Checker<EmbeddingBagBackward> checker(handle(), false);
+    EmbeddingBagBackward::Param param;
+
+    //! the bags are rows {0, 2} and {0}, so row 0 gathers from both bags and
+    //! row 1 gets zeros
+    TensorND diff = TensorValue({2, 2}, dtype::Float32(), {1, 2, 3, 4});
+    TensorND indices = TensorValue({3}, dtype::Int32(), {0, 2, 0});
+    TensorND offsets = TensorValue({2}, dtype::Int32(), {0, 2});
+    TensorND psw = TensorValue({3}, dtype::Float32(), {0.5f, 1.f, 2.f});
+    TensorND grad = TensorValue({3, 2}, dtype::Float32(), {0, 0, 0, 0, 0, 0});
+
+    param.mode = EmbeddingBagBackward::Param::Mode::SUM;
+    checker.set_param(param).exect(
+            Testcase{diff, indices, offsets, psw, {}, grad},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    TensorValue(
+                            {3, 2}, dtype::Float32(),
+                            {6.5f, 9.f, 0.f, 0.f, 1.f, 2.f})});
+
+    param.mode = EmbeddingBagBackward::Param::Mode::MEAN;
+    checker.set_param(param).exect(
+            Testcase{diff, indices, offsets, {}, {}, grad},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    TensorValue(
+                            {3, 2}, dtype::Float32(),
+                            {3.5f, 5.f, 0.f, 0.f, 0.5f, 1.f})});
+
+    param.mode = EmbeddingBagBackward::Param::Mode::MAX;
+    TensorND max_idx = TensorValue({2, 2}, dtype::Int32(), {1, 0, 2, 2});
+    checker.set_param(param).exect(
+            Testcase{diff, indices, offsets, {}, max_idx, grad},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    TensorValue({3, 2}, dtype::Float32(), {3, 6, 0, 0, 1, 0})});
+}
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,35 @@
+#include "megdnn/dtype.h"
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/naive/fixture.h"
+
+using namespace megdnn;
+using namespace test;
+
+TEST_F(NAIVE, FUSED_OPTIMIZER_UPDATE_LAMB) {
+    Checker<FusedOptimizerUpdate> checker(handle(), false);
+    FusedOptimizerUpdate::Param param;
+    param.mode = FusedOptimizerUpdate::Param::Mode::LAMB;
+    param.beta_1 = 0;
+    param.beta_2 = 0;
+    param.eps = 0;
+    param.weight_decay = 0.5;
+    param.lr = 1;
+    param.step = 1;
+
+    //! the updates are {3, 4} and {2}, so the trust ratios are 2 and 1
+    TensorND p = TensorValue({3}, dtype::Float32(), {8, 6, 2});
+    TensorND grad = TensorValue({3}, dtype::Float32(), {-1, 1, 1});
+    TensorND m = TensorValue({3}, dtype::Float32(), {5, 5, 5});
+    TensorND v = TensorValue({3}, dtype::Float32(), {5, 5, 5});
+    TensorND offsets = TensorValue({4}, dtype::Int32(), {0, 2, 2, 3});
+
+    TensorND new_p = TensorValue({3}, dtype::Float32(), {2, -2, 0});
+    TensorND new_m = TensorValue({3}, dtype::Float32(), {-1, 1, 1});
+    TensorND new_v = TensorValue({3}, dtype::Float32(), {1, 1, 1});
+    checker.set_param(param).exect(
+            Testcase{p, grad, m, v, offsets, {}, {}, {}},
+            Testcase{{}, {}, {}, {}, {}, new_p, new_m, new_v});
+}
+
+// vim: syntax=cpp.doxygen
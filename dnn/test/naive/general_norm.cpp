@@ -336,5 +336,34 @@ TEST_F(NAIVE, GENERALNORM_FORWARD_FP16) {
             });
 }
 
+TEST_F(NAIVE, GENERALNORM_FORWARD_RMS) {
+    Checker<GeneralNorm> checker(handle(), true);
+
+    GeneralNorm::Param param;
+    param.affine = true;
+    param.mode = GeneralNorm::Param::Mode::RMS_NORM;
+    param.axis_start = 1;
+    param.axis_end = 2;
+    checker.set_param(param).exect(
+            Testcase{
+                    TensorValue({2, 3}, dtype::Float32(), {1, 2, 3, -1, 0, 1}),
+                    TensorValue({3}, dtype::Float32(), {1., 1., 1.}),  // weight
+                    TensorValue({3}, dtype::Float32(), {0., 0., 0.}),  // bias
+                    {},
+                    {},
+                    {}},
+            Testcase{
+                    {},
+                    {},
+                    {},
+                    TensorValue(
+                            {2, 3}, dtype::Float32(),
+                            {0.462910, 0.925819, 1.388729, -1.224736, 0.000000,
+                             1.224736}),                                      // output
+                    TensorValue({2}, dtype::Float32(), {0., 0.}),             // mean
+                    TensorValue({2}, dtype::Float32(), {0.462910, 1.224736})  // rstd
+            });
+}
+
 }  // namespace test
 }  // namespace megdnn
@@ -0,0 +1,52 @@
+#include "megdnn/dtype.h"
+#include "megdnn/oprs.h"
+#include "test/common/checker.h"
+#include "test/naive/fixture.h"
+
+using namespace megdnn;
+using namespace test;
+
+TEST_F(NAIVE, KV_CACHE_APPEND) {
+    Checker<KVCacheAppend> checker(handle(), false);
+    KVCacheAppend::Param param;
+    param.num_heads = 1;
+    param.rotary_dim = 2;
+
+    //! the token at position 0 is not rotated and goes to the first slot of
+    //! the physical block 1
+    TensorND qkv = TensorValue({1, 1, 6}, dtype::Float32(), {1, 2, 3, 4, 5, 6});
+    TensorND positions = TensorValue({1}, dtype::Int32(), {0});
+    TensorND block_table = TensorValue({1, 2}, dtype::Int32(), {1, 0});
+    TensorND k_cache =
+            TensorValue({2, 1, 2, 2}, dtype::Float32(), {0, 0, 0, 0, 0, 0, 0, 0});
+    TensorND v_cache =
+            TensorValue({2, 1, 2, 2}, dtype::Float32(), {0, 0, 0, 0, 0, 0, 0, 0});
+
+    TensorND new_k_cache =
+            TensorValue({2, 1, 2, 2}, dtype::Float32(), {0, 0, 0, 0, 3, 4, 0, 0});
+    TensorND new_v_cache =
+            TensorValue({2, 1, 2, 2}, dtype::Float32(), {0, 0, 0, 0, 5, 6, 0, 0});
+    TensorND q = TensorValue({1, 1, 1, 2}, dtype::Float32(), {1, 2});
+    checker.set_param(param).exect(
+            Testcase{qkv, positions, block_table, k_cache, v_cache, {}},
+            Testcase{{}, {}, {}, new_k_cache, new_v_cache, q});
+}
+
+TEST_F(NAIVE, KV_CACHE_ATTENTION) {
+    Checker<KVCacheAttention> checker(handle(), false);
+
+    //! the query at position 1 attends to the tokens in the blocks 2 and 0
+    //! with equal scores, and the block 1 is not used by the sequence
+    TensorND q = TensorValue({1, 1, 1, 2}, dtype::Float32(), {1, 0});
+    TensorND k_cache = TensorValue({3, 1, 1, 2}, dtype::Float32(), {5, 1, 7, 7, 5, 2});
+    TensorND v_cache = TensorValue({3, 1, 1, 2}, dtype::Float32(), {2, 4, 9, 9, 4, 8});
+    TensorND positions = TensorValue({1}, dtype::Int32(), {1});
+    TensorND block_table = TensorValue({1, 3}, dtype::Int32(), {2, 0, 1});
+
+    TensorND dst = TensorValue({1, 1, 2}, dtype::Float32(), {3, 6});
+    checker.exect(
+            Testcase{q, k_cache, v_cache, positions, block_table, {}},
+            Testcase{{}, {}, {}, {}, {}, dst});
+}
+
+// vim: syntax=cpp.doxygen
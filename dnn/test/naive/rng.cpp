@@ -443,6 +443,72 @@ void run_dropout(Handle* handle) {
     run({100000}, 0.3);
 }
 
+template <typename T>
+void run_logits_sampling(Handle* handle) {
+    using ctype = typename DTypeTrait<T>::ctype;
+    auto opr = handle->create_operator<LogitsSamplingRNG>();
+
+    //! the frequencies of many identical rows follow the filtered softmax
+    size_t num_groups = 20000, len_logits = 5;
+    TensorLayout ly_logits{TensorShape{num_groups, len_logits}, T()};
+    TensorLayout ly_out{TensorShape{num_groups}, dtype::Int32()};
+    Tensor<ctype> logits(handle, ly_logits);
+    Tensor<dt_int32> out(handle, ly_out);
+    float probs[] = {0.05, 0.1, 0.15, 0.3, 0.4};
+    auto logits_ptr = logits.ptr();
+    for (size_t i = 0; i < num_groups * len_logits; ++i) {
+        logits_ptr[i] = ctype(std::log(probs[i % len_logits]));
+    }
+    auto check = [&](uint32_t top_k, float top_p, std::vector<size_t> kept) {
+        opr->param().top_k = top_k;
+        opr->param().top_p = top_p;
+        opr->exec(logits.tensornd(), out.tensornd(), {});
+        std::vector<float> expected(len_logits, 0), freq(len_logits, 0);
+        float sum = 0;
+        for (auto i : kept) {
+            expected[i] = std::exp(static_cast<float>(logits_ptr[i]));
+            sum += expected[i];
+        }
+        auto ptr = out.ptr();
+        for (size_t i = 0; i < num_groups; ++i) {
+            ASSERT_LT(static_cast<size_t>(ptr[i]), len_logits);
+            freq[ptr[i]] += 1.f / num_groups;
+        }
+        for (size_t i = 0; i < len_logits; ++i) {
+            ASSERT_LE(std::abs(freq[i] - expected[i] / sum), 1e-2);
+        }
+    };
+    check(0, 1.f, {0, 1, 2, 3, 4});
+    check(3, 1.f, {2, 3, 4});
+    check(0, 0.6f, {3, 4});
+    //! 0.4 / 0.85 of the top 3 is less than 0.5, so the second one is kept
+    check(3, 0.5f, {3, 4});
+    check(1, 1.f, {4});
+
+    //! greedy decoding of a large vocabulary by a tiny top_p
+    num_groups = 4, len_logits = 128000;
+    ly_logits = TensorLayout{TensorShape{num_groups, len_logits}, T()};
+    ly_out = TensorLayout{TensorShape{num_groups}, dtype::Int32()};
+    Tensor<ctype> large_logits(handle, ly_logits);
+    Tensor<dt_int32> large_out(handle, ly_out);
+    auto large_ptr = large_logits.ptr();
+    for (size_t i = 0; i < num_groups * len_logits; ++i) {
+        large_ptr[i] = ctype(-static_cast<float>(i % 1000) / 100);
+    }
+    size_t argmax[] = {1, 5000, 64001, 127999};
+    for (size_t i = 0; i < num_groups; ++i) {
+        large_ptr[i * len_logits + argmax[i]] = ctype(1);
+    }
+    opr->param().top_k = 0;
+    opr->param().top_p = 1e-6;
+    opr->param().temperature = 0.5;
+    opr->exec(large_logits.tensornd(), large_out.tensornd(), {});
+    auto large_out_ptr = large_out.ptr();
+    for (size_t i = 0; i < num_groups; ++i) {
+        ASSERT_EQ(static_cast<size_t>(large_out_ptr[i]), argmax[i]);
+    }
+}
+
 }  // namespace
 
 TEST_F(NAIVE, UNIFORM_RNG_F32) {
@@ -487,6 +553,14 @@ TEST_F(NAIVE, MULTINOMIAL_RNG_F16) {
     run_multinomial_without_replacement<dtype::Float16>(handle());
 }
 
+TEST_F(NAIVE, LOGITS_SAMPLING_RNG_F32) {
+    run_logits_sampling<dtype::Float32>(handle());
+}
+
+TEST_F(NAIVE, LOGITS_SAMPLING_RNG_F16) {
+    DNN_INC_FLOAT16(run_logits_sampling<dtype::Float16>(handle()));
+}
+
 TEST_F(NAIVE, BETA_RNG_F32) {
     run_beta<dtype::Float32>(handle());
 }
@@ -178,4 +178,45 @@ TEST_F(NAIVE, TYPECVT_BFLOAT16) {
     );
 }
 
+TEST_F(NAIVE, TYPECVT_FLOAT8) {
+    Checker<TypeCvt> checker(handle(), false);
+
+    //! round to nearest even and saturate to the max finite value
+    checker.exect(
+            Testcase{
+                    TensorValue(
+                            {1, 1, 2, 3}, dtype::Float32(),
+                            {0.f, 0.3f, -1.7f, 500.f, 1e-3f, -1e5f}),
+                    {}},
+            Testcase{
+                    {},
+                    TensorValue(
+                            {1, 1, 2, 3}, dtype::Float8E4M3(),
+                            {0.f, 0.3125f, -1.75f, 448.f, 0.001953125f, -448.f})});
+    checker.exect(
+            Testcase{
+                    TensorValue(
+                            {1, 1, 2, 3}, dtype::Float32(),
+                            {0.f, 0.3f, -1.7f, 500.f, 1e-3f, -1e5f}),
+                    {}},
+            Testcase{
+                    {},
+                    TensorValue(
+                            {1, 1, 2, 3}, dtype::Float8E5M2(),
+                            {0.f, 0.3125f, -1.75f, 512.f, 0.0009765625f, -57344.f})});
+
+    //! every finite value of fp8 is exact in float32
+    checker.exect(
+            Testcase{
+                    TensorValue(
+                            {4}, dtype::Float8E4M3(),
+                            {-448.f, 0.015625f, 0.875f, 240.f}),
+                    {}},
+            Testcase{
+                    {},
+                    TensorValue(
+                            {4}, dtype::Float32(),
+                            {-448.f, 0.015625f, 0.875f, 240.f})});
+}
+
 // vim: syntax=cpp.doxygen
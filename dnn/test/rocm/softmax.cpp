@@ -0,0 +1,42 @@
+#include "hcc_detail/hcc_defs_prologue.h"
+#include "test/rocm/fixture.h"
+
+#include "test/common/checker.h"
+#include "test/common/softmax.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(ROCM, SOFTMAX_FORWARD) {
+    auto args = softmax::get_args();
+    std::vector<DType> dtypes{DNN_INC_FLOAT16(dtype::Float16() MEGDNN_COMMA)
+                                      dtype::Float32()};
+    for (auto dtype : dtypes)
+        for (auto&& arg : args) {
+            Checker<Softmax> checker(handle_rocm());
+            checker.set_epsilon(1e-2);
+            checker.set_param(arg.param).set_dtype(0, dtype).set_dtype(1, dtype).exec(
+                    TensorShapeArray{arg.ishape, {}});
+        }
+}
+
+TEST_F(ROCM, SOFTMAX_BACKWARD) {
+    auto args = softmax::get_args();
+    for (auto&& arg : args) {
+        Checker<SoftmaxBackward> checker(handle_rocm());
+        TensorLayout ilayout = TensorLayout(arg.ishape, dtype::Float32());
+        TensorLayout olayout;
+        {
+            auto opr = handle_rocm()->create_operator<SoftmaxForward>();
+            opr->param() = arg.param;
+            opr->deduce_layout(ilayout, olayout);
+        }
+        checker.set_epsilon(1e-3).set_param(arg.param).exec(
+                TensorShapeArray{ilayout, olayout, ilayout});
+    }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
@@ -0,0 +1,39 @@
+#include "test/x86/fixture.h"
+
+#include "test/common/adaptive_pooling.h"
+#include "test/common/checker.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(X86_MULTI_THREADS, ADAPTIVE_POOLING_FORWARD) {
+    auto args = adaptive_pooling::get_args();
+    Checker<AdaptivePooling> checker(handle());
+    checker.set_epsilon(1e-4);
+    for (auto&& arg : args) {
+        checker.set_param(arg.param).exec(
+                TensorShapeArray{arg.ishape, arg.oshape, {}});
+    }
+}
+
+TEST_F(X86_MULTI_THREADS, ADAPTIVE_POOLING_FORWARD_NCHW88_NHWC) {
+    using Param = param::AdaptivePooling;
+    Checker<AdaptivePooling> checker(handle());
+    checker.set_epsilon(1e-4);
+    for (auto mode : {Param::Mode::MAX, Param::Mode::AVERAGE})
+        for (size_t oh : {1, 3, 7})
+            for (size_t ow : {1, 5}) {
+                Param param{mode};
+                param.format = Param::Format::NCHW88;
+                checker.set_param(param).exec(
+                        TensorShapeArray{{2, 3, 14, 11, 8}, {2, 3, oh, ow, 8}, {}});
+                param.format = Param::Format::NHWC;
+                checker.set_param(param).exec(
+                        TensorShapeArray{{2, 14, 11, 19}, {2, oh, ow, 19}, {}});
+            }
+}
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
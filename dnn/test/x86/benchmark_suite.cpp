@@ -0,0 +1,14 @@
+#include "test/x86/fixture.h"
+
+#include "test/common/benchmark_suite.h"
+
+using namespace megdnn;
+using namespace test;
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(X86, BENCHMARK_SUITE) {
+    benchmark_suite::run(handle(), "x86");
+}
+#endif
+
+// vim: syntax=cpp.doxygen
@@ -1294,6 +1294,23 @@ TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_FP32_6x16) {
     cb("IM2COLMATMUL:X86_F32_6x16:192");
 }
 
+#if !MEGDNN_DISABLE_FLOAT16
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_FP16_F16C) {
+    using namespace conv_bias;
+    if (!megdnn::x86::is_supported(x86::SIMDType::F16C)) {
+        return;
+    }
+    std::vector<TestArg> args =
+            get_conv_bias_args({2, 3, 4, 5, 6, 7}, 1, false, false, false);
+    std::vector<TestArg> args1 = get_conv_bias_args({1}, 2, false, false, false);
+    args.insert(args.begin(), args1.begin(), args1.end());
+    NormalRNG rng(1);
+    checker_conv_bias_common(
+            args, handle(), &rng, 0.03, dtype::Float16{}, dtype::Float16{},
+            dtype::Float16{}, dtype::Float16{}, "IM2COLMATMUL:X86_F16_F16C_6X16");
+}
+#endif
+
 #if MEGDNN_X86_WITH_MKL && SUPPORT_MKL_PACKED_GEMM
 TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_FP32_PACKA) {
     using namespace conv_bias;
@@ -1587,6 +1604,19 @@ TEST_F(X86_MULTI_THREADS, CONV_BIAS_CONV1X1_S1_FP32_6x16) {
     check_conv_bias(args, handle(), "CONV1x1:X86_F32_6x16:48");
 }
 
+TEST_F(X86_MULTI_THREADS, CONV_BIAS_CONV1X1_S1_FP32_AVX512_12X32) {
+    using namespace conv_bias;
+    if (!megdnn::x86::is_supported(x86::SIMDType::AVX512F)) {
+        return;
+    }
+    std::vector<conv_bias::TestArg> args = get_conv_bias_1x1_args(false, false);
+    check_conv_bias(args, handle(), "CONV1x1:X86_F32_AVX512_12X32:48");
+    NormalRNG rng;
+    check_conv_bias_preprocess(
+            args, handle(), &rng, 1e-3, dtype::Float32{}, dtype::Float32{},
+            dtype::Float32{}, dtype::Float32{}, "CONV1x1:X86_F32_AVX512_12X32:48");
+}
+
 TEST_F(X86_MULTI_THREADS, CONV_BIAS_IM2COLMATMUL_QINT8) {
     using namespace conv_bias;
     std::vector<TestArg> args;
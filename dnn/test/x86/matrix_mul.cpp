@@ -107,6 +107,53 @@ TEST_F(X86, MATRIX_MUL_AVX2_6x16) {
             "X86_F32_6x16", param::MatrixMul::Format::DEFAULT, 1, 1e-3, false);
 }
 
+#if !MEGDNN_DISABLE_FLOAT16
+TEST_F(X86, MATRIX_MUL_F16_F16C_6X16) {
+    if (!is_supported(SIMDType::F16C)) {
+        std::cout << "skip f16c matmul check for no f16c support" << std::endl;
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::Float16{}, dtype::Float16{}, dtype::Float16{}, handle(),
+            "X86_F16_F16C_6X16", param::MatrixMul::Format::DEFAULT, 1, 1e-2, false);
+    //! a long K checks that the partial sums are kept in fp32
+    std::vector<matrix_mul::TestArg> args;
+    for (size_t k : {1024, 4099})
+        args.emplace_back(7, 19, k, 0);
+    matrix_mul::check_matrix_mul(
+            dtype::Float16{}, dtype::Float16{}, dtype::Float16{}, handle(),
+            "X86_F16_F16C_6X16", param::MatrixMul::Format::DEFAULT, 1, 1e-2,
+            std::move(args), false, param::MatrixMul::ComputeMode::FLOAT32);
+}
+#endif
+
+TEST_F(X86, MATRIX_MUL_AVX512_12X32) {
+    if (!is_supported(SIMDType::AVX512F)) {
+        std::cout << "skip avx512 matmul check for no avx512f support" << std::endl;
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::Float32{}, dtype::Float32{}, dtype::Float32{}, handle(),
+            "X86_F32_AVX512_12X32", param::MatrixMul::Format::DEFAULT, 1, 1e-3, false);
+}
+
+#if MEGDNN_X86_WITH_AMX
+TEST_F(X86, MATRIX_MUL_AMX_8X8X32) {
+    if (!is_supported(SIMDType::AMX_INT8)) {
+        std::cout << "skip amx matmul check for no amx-int8 support" << std::endl;
+        return;
+    }
+    matrix_mul::check_matrix_mul(
+            dtype::Int8{}, dtype::Int8{}, dtype::Int32{}, handle(),
+            "X86_INT8X8X32_AMX_32X32X64", param::MatrixMul::Format::DEFAULT, 1, 1e-3,
+            false);
+    matrix_mul::check_matrix_mul(
+            dtype::QuantizedS8{2.5f}, dtype::QuantizedS8{2.5f},
+            dtype::QuantizedS32{6.25f}, handle(), "X86_INT8X8X32_AMX_32X32X64",
+            param::MatrixMul::Format::DEFAULT, 1, 1e-3, false);
+}
+#endif
+
 #if MEGDNN_WITH_BENCHMARK
 
 TEST_F(X86, BENCHMARK_MATRIX_MUL_AVX2_MK8_8X8) {
@@ -125,6 +172,43 @@ TEST_F(X86, BENCHMARK_MATRIX_MUL_AVX2_6x16) {
             dtype::Float32{}, dtype::Float32{}, "X86_F32_BLAS");
 }
 
+#if !MEGDNN_DISABLE_FLOAT16
+TEST_F(X86, BENCHMARK_MATRIX_MUL_F16_F16C_6X16) {
+    if (!is_supported(SIMDType::F16C)) {
+        return;
+    }
+    auto args = matrix_mul::get_benchmark_matmul_args();
+    matrix_mul::benchmark_with_contrast(
+            handle(), args, dtype::Float16{}, dtype::Float16{}, dtype::Float16{},
+            "X86_F16_F16C_6X16", param::MatrixMul::Format::DEFAULT, dtype::Float32{},
+            dtype::Float32{}, dtype::Float32{}, "X86_F32_6x16");
+}
+#endif
+
+TEST_F(X86, BENCHMARK_MATRIX_MUL_AVX512_12X32) {
+    if (!is_supported(SIMDType::AVX512F)) {
+        return;
+    }
+    auto args = matrix_mul::get_benchmark_matmul_args();
+    matrix_mul::benchmark_with_contrast(
+            handle(), args, dtype::Float32{}, dtype::Float32{}, dtype::Float32{},
+            "X86_F32_AVX512_12X32", param::MatrixMul::Format::DEFAULT,
+            dtype::Float32{}, dtype::Float32{}, dtype::Float32{}, "X86_F32_6x16");
+}
+
+#if MEGDNN_X86_WITH_AMX
+TEST_F(X86, BENCHMARK_MATRIX_MUL_AMX_8X8X32) {
+    if (!is_supported(SIMDType::AMX_INT8)) {
+        return;
+    }
+    auto args = matrix_mul::get_benchmark_matmul_args();
+    matrix_mul::benchmark_with_contrast(
+            handle(), args, dtype::Int8{}, dtype::Int8{}, dtype::Int32{},
+            "X86_INT8X8X32_AMX_32X32X64", param::MatrixMul::Format::DEFAULT,
+            dtype::Int8{}, dtype::Int8{}, dtype::Int32{}, "X86_INT8X8X32_AVX2_4X16X2");
+}
+#endif
+
 TEST_F(X86, BENCHMARK_MATRIX_MUL_8X8X32) {
     constexpr size_t RUNS = 50;
     auto rng = std::make_unique<UniformIntRNG>(-127, 127);
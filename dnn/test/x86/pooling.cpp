@@ -86,6 +86,33 @@ TEST_F(X86_MULTI_THREADS, S1POOLING88) {
     }
 }
 
+TEST_F(X86_MULTI_THREADS, POOLING_CHANNEL_VEC) {
+    Checker<Pooling> checker(handle());
+    checker.set_before_exec_callback(
+            AlgoChecker<PoolingForward>("ChannelVecAVX_POOLING"));
+    using Mode = param::Pooling::Mode;
+    using Format = param::Pooling::Format;
+    for (auto mode : {Mode::MAX, Mode::AVERAGE, Mode::AVERAGE_COUNT_EXCLUDE_PADDING})
+        for (auto format : {Format::NCHW88, Format::NHWC})
+            for (size_t window : {1, 2, 3, 5})
+                for (size_t stride : {1, 2, 3})
+                    for (size_t pad = 0; pad < window && pad < 3; ++pad) {
+                        Pooling::Param param;
+                        param.mode = mode;
+                        param.format = format;
+                        param.window_h = param.window_w = window;
+                        param.stride_h = param.stride_w = stride;
+                        param.pad_h = param.pad_w = pad;
+                        checker.set_param(param);
+                        if (format == Format::NCHW88) {
+                            checker.execs({{2, 3, 11, 9, 8}, {}});
+                        } else {
+                            checker.execs({{2, 11, 9, 8}, {}});
+                            checker.execs({{2, 11, 9, 21}, {}});
+                        }
+                    }
+}
+
 #if MEGDNN_X86_WITH_MKL_DNN
 TEST_F(X86, POOLING88) {
     Checker<Pooling> checker(handle());
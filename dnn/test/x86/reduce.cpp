@@ -0,0 +1,59 @@
+#include "test/x86/fixture.h"
+
+#include "megdnn/oprs.h"
+#include "test/common/benchmarker.h"
+#include "test/common/checker.h"
+
+namespace megdnn {
+namespace test {
+
+TEST_F(X86_MULTI_THREADS, REDUCE) {
+    using Param = Reduce::Param;
+    using Mode = Param::Mode;
+    Checker<Reduce> checker(handle());
+    UniformFloatRNG rng(-1, 1);
+    checker.set_rng(0, &rng).set_epsilon(1e-3);
+    for (auto mode : {Mode::SUM, Mode::MEAN, Mode::SUM_SQR, Mode::MAX}) {
+        checker.set_param(Param(mode, 1)).execs({{2, 64, 7, 7}, {}});
+        checker.set_param(Param(mode, 1)).execs({{4, 1000, 130}, {}});
+        checker.set_param(Param(mode, 2)).execs({{1, 3, 300, 257}, {}});
+        checker.set_param(Param(mode, 1)).execs({{1, 100003}, {}});
+    }
+}
+
+#if MEGDNN_WITH_BENCHMARK
+TEST_F(X86, BENCHMARK_REDUCE_MULTI_THREADS) {
+    using Mode = param::Reduce::Mode;
+    TaskExecutorConfig config;
+    config.nr_thread = 4;
+    auto handle_multi = create_cpu_handle(0, true, &config);
+    auto run = [&](const TensorShape& shape, int32_t axis, Mode mode) {
+        constexpr size_t RUNS = 50;
+        Benchmarker<Reduce> benchmarker(handle());
+        Benchmarker<Reduce> benchmarker_multi(handle_multi.get());
+        benchmarker.set_display(false).set_times(RUNS);
+        benchmarker_multi.set_display(false).set_times(RUNS);
+        param::Reduce param(mode, axis);
+        benchmarker.set_param(param);
+        benchmarker_multi.set_param(param);
+        auto single = benchmarker.execs({shape, {}}) / RUNS;
+        auto multi = benchmarker_multi.execs({shape, {}}) / RUNS;
+        printf("reduce %s axis=%d mode=%d: 1 thread %fms, 4 threads %fms "
+               "speedup=%f\n",
+               shape.to_string().c_str(), axis, static_cast<int>(mode), single, multi,
+               single / multi);
+    };
+    for (auto mode : {Mode::MEAN, Mode::SUM_SQR, Mode::MAX}) {
+        // over C and over H of NCHW, over HW, and a global reduce
+        run({1, 256, 56, 56}, 1, mode);
+        run({8, 64, 56, 56}, 2, mode);
+        run({8, 256, 3136}, 2, mode);
+        run({1, 3 * 224 * 224 * 10}, 1, mode);
+    }
+}
+#endif
+
+}  // namespace test
+}  // namespace megdnn
+
+// vim: syntax=cpp.doxygen
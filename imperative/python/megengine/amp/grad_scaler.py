@@ -73,6 +73,9 @@ class GradScaler:
 
         self._growth_tracker = 0
         self._found_non_finite = False
+        # set by the allreduce callback which has unscaled and checked the grads,
+        # accumulated over the backward passes until consumed by unscale
+        self._fused_non_finite = None
 
     def backward(
         self,
@@ -124,6 +127,17 @@ class GradScaler:
             grad_tensors: Tensors needed to unscale grads. Should be all tensors
                 that are affected by ``target`` tensor in GradManager's backward.
         """
+        if self._fused_non_finite is not None:
+            found_non_finite = self._fused_non_finite.numpy()
+            self._fused_non_finite = None
+            if found_non_finite and self.growth_interval != 0:
+                self._found_non_finite = True
+                for tensor in grad_tensors:
+                    if tensor is None or getattr(tensor, "grad", None) is None:
+                        continue
+                    tensor.grad = None
+            return self
+
         if self.growth_interval == 0:
             # use float64 for better precision
             inv_scale = Tensor(1.0 / self.scale_factor)
@@ -144,6 +158,17 @@ class GradScaler:
                 tensor.grad = None
         return self
 
+    def _accumulate_fused_non_finite(self, found_non_finite: Tensor) -> bool:
+        r"""Records whether the grads of a backward contain non-finite values.
+        Returns ``False`` if the grads of a previous backward have not been
+        unscaled yet, i.e. the grads are accumulated.
+        """
+        if self._fused_non_finite is None:
+            self._fused_non_finite = found_non_finite
+            return True
+        self._fused_non_finite = self._fused_non_finite + found_non_finite
+        return False
+
     def _check_gradients(self, grads, scale):
         if len(grads) == 0:
             return False
@@ -1,6 +1,8 @@
 import weakref
 from typing import Callable, Iterable, List, Union
 
+import numpy as np
+
 from ..core._imperative_rt.core2 import (
     get_auto_format_convert,
     pop_scope,
@@ -23,6 +25,26 @@ def get_backwarding_grad_manager():
     return backwarding_grad_manager
 
 
+def _accumulate_grad(tensor, grad):
+    # add to the buffer of .grad in place when accumulating over micro-batches,
+    # instead of allocating the sum and releasing the old buffer; InplaceAdd falls
+    # back to a copy if the buffer is shared with other tensors
+    dest = tensor.grad
+    if (
+        grad is None
+        or dest.dtype != grad.dtype
+        or dest.dtype not in (np.float32, np.float16)
+        or dest._tuple_shape != grad._tuple_shape
+        or dest.device != grad.device
+    ):
+        tensor.grad += grad
+        return
+    from ..functional.inplace import _inplace_add_
+
+    one = Tensor(1.0, dtype="float32", device=dest.device)
+    _inplace_add_(dest, grad, alpha=one, beta=one)
+
+
 class AttachSpec:
     __slots__ = "tensor", "callbacks"
 
@@ -300,7 +322,7 @@ class GradManager:
                     if tensor.grad is None:
                         tensor.grad = grad
                     else:
-                        tensor.grad += grad
+                        _accumulate_grad(tensor, grad)
         finally:
             self.release()
             backwarding_grad_manager = cache
@@ -225,6 +225,9 @@ def optimize_for_inference(dest_vars, **kwargs):
         * enable_ioc16 --
           whether to use float16 for both I/O and computation
           precision.
+        * enable_f16_mixed_precision: with enable_io16xc32 or enable_ioc16, keep
+          the oprs sensitive to float16, like softmax, normalizations and
+          reductions, in float32.
         * enable_hwcd4 --
           whether to use NHWCD4 data layout. This is faster on some
           OpenCL backend.
@@ -257,6 +260,10 @@ def optimize_for_inference(dest_vars, **kwargs):
           inference
         * enable_fuse_grain: fuse grain will be enable by default to fuse grain operator to huge operator, you can disable it.
           )
+        * enable_precompute_weight: whether to store transformed constant weights,
+          like the transposed weights of matmul, into the model.
+        * precompute_weight_size_budget: max bytes the model may grow by
+          enable_precompute_weight, unlimited by default.
     """
     inference_options = GraphOptimizeOptions()
     inference_optimize_layout_transform_map = {
@@ -278,6 +285,8 @@ def optimize_for_inference(dest_vars, **kwargs):
         inference_options.f16_io_f32_comp = True
     if kwargs.pop("enable_ioc16", False):
         inference_options.f16_io_comp = True
+    if kwargs.pop("enable_f16_mixed_precision", False):
+        inference_options.f16_mixed_precision = True
     if kwargs.pop("enable_fuse_conv_bias_nonlinearity", False):
         inference_options.fuse_conv_bias_nonlinearity = True
     if kwargs.pop("enable_fuse_conv_bias_with_z", False):
@@ -286,6 +295,12 @@ def optimize_for_inference(dest_vars, **kwargs):
         inference_options.fuse_preprocess = True
     if kwargs.pop("enable_fuse_grain", True):
         inference_options.fuse_grain = True
+    if kwargs.pop("enable_precompute_weight", False):
+        inference_options.precompute_weight = True
+    if "precompute_weight_size_budget" in kwargs:
+        inference_options.precompute_weight_size_budget = kwargs.pop(
+            "precompute_weight_size_budget"
+        )
 
     if kwargs:
         raise ValueError("unknown options: %s" % list(kwargs))
@@ -328,6 +343,8 @@ def deserialize_infer_option(x: int) -> Dict[str, bool]:
         ret["enable_io16xc32"] = True
     if inference_options.f16_io_comp:
         ret["enable_ioc16"] = True
+    if inference_options.f16_mixed_precision:
+        ret["enable_f16_mixed_precision"] = True
     if inference_options.fuse_conv_bias_nonlinearity:
         ret["enable_fuse_conv_bias_nonlinearity"] = True
     if inference_options.fuse_conv_bias_with_z:
@@ -336,6 +353,11 @@ def deserialize_infer_option(x: int) -> Dict[str, bool]:
         ret["enable_fuse_preprocess"] = True
     if inference_options.fuse_grain:
         ret["enable_fuse_grain"] = True
+    if inference_options.precompute_weight:
+        ret["enable_precompute_weight"] = True
+        budget = inference_options.precompute_weight_size_budget
+        if budget != GraphOptimizeOptions().precompute_weight_size_budget:
+            ret["precompute_weight_size_budget"] = budget
 
     return ret
 
@@ -13,6 +13,7 @@ import threading
 import time
 import traceback
 from multiprocessing import Array, Value
+from typing import Union
 
 import numpy as np
 
@@ -109,6 +110,8 @@ class DataLoader:
             batch from workers. Default: 0
         preload: whether to enable the preloading strategy of the dataloader. 
             When enabling, the dataloader will preload one batch to the device memory to speed up the whole training process.
+            An integer ``n`` preloads ``n`` batches ahead, so that the host2device copies
+            keep up with an uneven pace of loading, at the cost of more device memory.
         parallel_stream: whether to splitting workload across all workers when dataset is streamdataset and num_workers > 0.
             When enabling, each worker will collect data from different dataset in order to speed up the whole loading process.
             See ref:`streamdataset-example` for more details
@@ -138,12 +141,15 @@ class DataLoader:
         collator: Collator = None,
         num_workers: int = 0,
         timeout: int = 0,
-        preload: bool = False,
+        preload: Union[bool, int] = False,
         parallel_stream: bool = False,
     ):
         if num_workers < 0:
             raise ValueError("num_workers should not be negative")
 
+        if preload < 0:
+            raise ValueError("preload should not be negative")
+
         if timeout < 0:
             raise ValueError("timeout should not be negative")
 
@@ -257,8 +263,10 @@ class PreLoader:
         if preload:
             self.default_device = get_default_device()
             self.pre_load_device = self.default_device + ":" + str(_sh.get_next())
-            self.pre_load_device_cache = None
-        self.preload = preload
+            # the batches preloaded in order, whose h2d copies are in flight
+            self.pre_load_device_cache = collections.deque()
+        # the number of batches to preload ahead, ``True`` for one
+        self.preload = int(preload)
 
         if data_monitor:
             global monitor_num_workers, monitor_workers, put_time
@@ -305,9 +313,7 @@ class PreLoader:
             return data
 
     def _swap_out_cache(self):
-        out = self._load_cache(self.pre_load_device_cache)
-        self.pre_load_device_cache = None  # clean cache
-        return out
+        return self._load_cache(self.pre_load_device_cache.popleft())
 
 
 class _ParallelDataLoaderIter:
@@ -513,14 +519,14 @@ class _BaseMapDataLoaderIter(PreLoader):
 
     def __next__(self):
         if self.preload:
-            cached = self.pre_load_device_cache
-            if cached is None:  # first and last
-                if self.num_processed >= len(self):  # last
-                    raise StopIteration
-                elif self.num_processed == 0:  # first
-                    self._try_load_tensor(cached=False)  # first do the h2d
+            if self.num_processed == 0:  # first
+                self._try_load_tensor(cached=False)  # first do the h2d
+            if not self.pre_load_device_cache:  # last
+                raise StopIteration
             out = self._swap_out_cache()
-            self._try_load_tensor()
+            while len(self.pre_load_device_cache) < self.preload:
+                if not self._try_load_tensor():
+                    break
             return out
         else:
             data = self._get_next_batch()
@@ -528,11 +534,12 @@ class _BaseMapDataLoaderIter(PreLoader):
 
     def _try_load_tensor(self, cached=True):
         if self.num_processed >= len(self):
-            return
+            return False
         else:
             self.num_processed += 1
             batch = self._get_next_batch()
-            self.pre_load_device_cache = self._load_tensor(batch, cached)
+            self.pre_load_device_cache.append(self._load_tensor(batch, cached))
+            return True
 
 
 class _SerialMapDataLoaderIter(_BaseMapDataLoaderIter):
@@ -627,17 +634,18 @@ class _BaseStreamDataLoaderIter(PreLoader):
 
     def __next__(self):
         if self.preload:
-            if self.pre_load_device_cache is None:
+            if not self.pre_load_device_cache:
                 self._try_load_tensor(cached=False)  # load in current
             out = self._swap_out_cache()
-            self._try_load_tensor()  # load in cached
+            while len(self.pre_load_device_cache) < self.preload:
+                self._try_load_tensor()  # load in cached
             return out
         else:
             return self._get_next_batch()
 
     def _try_load_tensor(self, cached=True):
         batch = self._get_next_batch()
-        self.pre_load_device_cache = self._load_tensor(batch, cached)
+        self.pre_load_device_cache.append(self._load_tensor(batch, cached))
 
 
 class _SerialStreamDataLoaderIter(_BaseStreamDataLoaderIter):
@@ -1,2 +1,3 @@
 # -*- coding: utf-8 -*-
+from .batch_transform import *
 from .transform import *
@@ -0,0 +1,355 @@
+# -*- coding: utf-8 -*-
+import collections.abc
+from typing import Sequence, Tuple
+
+import numpy as np
+
+from megengine.data.transform import Transform
+from megengine.data.transform.vision.transform import RandomResizedCrop
+from megengine.functional import clip, transpose
+from megengine.functional.vision import cvt_color, warp_perspective
+from megengine.tensor import Tensor
+
+__all__ = [
+    "BatchTransform",
+    "BatchCompose",
+    "BatchResize",
+    "BatchCenterCrop",
+    "BatchRandomResizedCrop",
+    "BatchRandomHorizontalFlip",
+    "BatchRandomVerticalFlip",
+    "BatchNormalize",
+    "BatchCvtColor",
+    "BatchToMode",
+]
+
+
+class BatchTransform(Transform):
+    r"""Base class of the transforms applied to a batch of images at once.
+
+    The images of the batch, which must have the same shape, are stacked into one
+    ``(N, H, W, C)`` tensor and transformed by the operators of MegEngine. So the
+    work runs in the C++ runtime without holding the GIL, on the CPU or on the GPU
+    given by ``device``, instead of image by image in Python. Only the "image" of
+    the inputs is transformed, the other items are returned as is.
+
+    :meth:`apply_tensor` can also be called on a batch tensor directly, e.g. to
+    augment the batches from :class:`~.DataLoader` after they are copied to the
+    GPU.
+
+    Args:
+        order: the same with :class:`VisionTransform`, but only "image" is
+            transformed.
+        device: the device to run the transform on. Default: None, the default
+            device.
+    """
+
+    def __init__(self, order=None, device=None):
+        super().__init__()
+        if order is None:
+            order = ("image",)
+        elif not isinstance(order, collections.abc.Sequence):
+            raise ValueError(
+                "order should be a sequence, but got order={}".format(order)
+            )
+        if "image" not in order:
+            raise ValueError("order should contain image, but got {}".format(order))
+        self.order = tuple(order)
+        self.device = device
+
+    def apply_batch(self, inputs: Sequence[Tuple]):
+        r"""Apply transform on batch input data."""
+        idx = self.order.index("image")
+        inputs = [input if isinstance(input, tuple) else (input,) for input in inputs]
+        images = np.stack([input[idx] for input in inputs])
+        images = self.apply_tensor(Tensor(images, device=self.device)).numpy()
+        outputs = []
+        for input, image in zip(inputs, images):
+            output = input[:idx] + (image,) + input[idx + 1 :]
+            outputs.append(output[0] if len(output) == 1 else output)
+        return tuple(outputs)
+
+    def apply(self, input: Tuple):
+        r"""Apply transform on single input data."""
+        return self.apply_batch([input])[0]
+
+    def apply_tensor(self, images: Tensor) -> Tensor:
+        r"""Apply transform on a batch of images with shape of `(N, H, W, C)`."""
+        raise NotImplementedError
+
+
+class _GeometricBatchTransform(BatchTransform):
+    # the transform is given by the matrices mapping the coordinates of the output
+    # pixels to the input, so that consecutive ones in BatchCompose are multiplied
+    # into a single WarpPerspective
+
+    def _get_mats(self, n, height, width):
+        r"""Returns the ``(n, 3, 3)`` matrices and the output ``(height, width)``."""
+        raise NotImplementedError
+
+    def apply_tensor(self, images):
+        n, h, w = images._tuple_shape[:3]
+        mats, out_shape = self._get_mats(n, h, w)
+        return _warp(images, mats, out_shape)
+
+
+def _warp(images, mats, out_shape):
+    out = warp_perspective(
+        images.astype("float32"),
+        Tensor(mats, dtype="float32", device=images.device),
+        out_shape,
+        border_mode="replicate",
+        format="NHWC",
+    )
+    if images.dtype == np.uint8:
+        out = (clip(out, 0, 255) + 0.5).astype("uint8")
+    return out
+
+
+def _scale_mat(sx, sy):
+    # scales by (1 / sx, 1 / sy) around the centers of the pixels
+    return np.array(
+        [[sx, 0, 0.5 * sx - 0.5], [0, sy, 0.5 * sy - 0.5], [0, 0, 1]],
+        dtype=np.float32,
+    )
+
+
+def _translate_mat(x, y):
+    return np.array([[1, 0, x], [0, 1, y], [0, 0, 1]], dtype=np.float32)
+
+
+def _as_size(output_size):
+    if isinstance(output_size, int):
+        return (output_size, output_size)
+    return tuple(output_size)
+
+
+class BatchResize(_GeometricBatchTransform):
+    r"""Resize the images of the batch to the given size with bilinear
+    interpolation.
+
+    Args:
+        output_size: target size of images, with (height, width) shape.
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, output_size, *, order=None, device=None):
+        super().__init__(order, device)
+        self.output_size = _as_size(output_size)
+
+    def _get_mats(self, n, height, width):
+        th, tw = self.output_size
+        mat = _scale_mat(width / tw, height / th)
+        return np.broadcast_to(mat, (n, 3, 3)), (th, tw)
+
+
+class BatchCenterCrop(_GeometricBatchTransform):
+    r"""Crops the images of the batch at the center.
+
+    Args:
+        output_size: target size of output image, with (height, width) shape.
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, output_size, *, order=None, device=None):
+        super().__init__(order, device)
+        self.output_size = _as_size(output_size)
+
+    def _get_mats(self, n, height, width):
+        th, tw = self.output_size
+        assert th <= height and tw <= width, "output size is bigger than image size"
+        x = int(round((width - tw) / 2.0))
+        y = int(round((height - th) / 2.0))
+        return np.broadcast_to(_translate_mat(x, y), (n, 3, 3)), (th, tw)
+
+
+class BatchRandomResizedCrop(_GeometricBatchTransform):
+    r"""Crop each image of the batch to random size and aspect ratio, and resize
+    the crop to the given size, as :class:`RandomResizedCrop` does.
+
+    Args:
+        output_size: target size of output image, with (height, width) shape.
+        scale_range: range of size of the origin size cropped. Default: (0.08, 1.0)
+        ratio_range: range of aspect ratio of the origin aspect ratio cropped.
+            Default: (0.75, 1.33)
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(
+        self,
+        output_size,
+        scale_range=(0.08, 1.0),
+        ratio_range=(3.0 / 4, 4.0 / 3),
+        *,
+        order=None,
+        device=None
+    ):
+        super().__init__(order, device)
+        self.output_size = _as_size(output_size)
+        self._sampler = RandomResizedCrop(self.output_size, scale_range, ratio_range)
+
+    def _get_mats(self, n, height, width):
+        th, tw = self.output_size
+        # only the shape of the image is used to sample the crops
+        image = np.broadcast_to(np.uint8(0), (height, width, 1))
+        mats = np.empty((n, 3, 3), dtype=np.float32)
+        for i in range(n):
+            x, y, w, h = self._sampler._get_coord(image)
+            mats[i] = _translate_mat(x, y) @ _scale_mat(w / tw, h / th)
+        return mats, (th, tw)
+
+
+class BatchRandomHorizontalFlip(_GeometricBatchTransform):
+    r"""Horizontally flip each image of the batch randomly with a given probability.
+
+    Args:
+        prob: probability of the image being flipped. Default: 0.5
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, prob: float = 0.5, *, order=None, device=None):
+        super().__init__(order, device)
+        self.prob = prob
+
+    def _get_mats(self, n, height, width):
+        mats = np.broadcast_to(np.eye(3, dtype=np.float32), (n, 3, 3)).copy()
+        flipped = np.random.random(n) < self.prob
+        mats[flipped, 0, 0] = -1
+        mats[flipped, 0, 2] = width - 1
+        return mats, (height, width)
+
+
+class BatchRandomVerticalFlip(_GeometricBatchTransform):
+    r"""Vertically flip each image of the batch randomly with a given probability.
+
+    Args:
+        prob: probability of the image being flipped. Default: 0.5
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, prob: float = 0.5, *, order=None, device=None):
+        super().__init__(order, device)
+        self.prob = prob
+
+    def _get_mats(self, n, height, width):
+        mats = np.broadcast_to(np.eye(3, dtype=np.float32), (n, 3, 3)).copy()
+        flipped = np.random.random(n) < self.prob
+        mats[flipped, 1, 1] = -1
+        mats[flipped, 1, 2] = height - 1
+        return mats, (height, width)
+
+
+class BatchNormalize(BatchTransform):
+    r"""Normalize the images of the batch with mean and standard deviation, and
+    convert them to float32.
+
+    Args:
+        mean: sequence of means for each channel.
+        std: sequence of standard deviations for each channel.
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, mean=0.0, std=1.0, *, order=None, device=None):
+        super().__init__(order, device)
+        self.mean = np.array(mean, dtype=np.float32)
+        self.std = np.array(std, dtype=np.float32)
+
+    def apply_tensor(self, images):
+        mean = Tensor(self.mean, device=images.device)
+        std = Tensor(self.std, device=images.device)
+        return (images.astype("float32") - mean) / std
+
+
+class BatchCvtColor(BatchTransform):
+    r"""Convert the color format of the images of the batch with
+    :func:`~.functional.vision.cvt_color`.
+
+    Args:
+        mode: format mode, e.g. "RGB2BGR", see :func:`~.functional.vision.cvt_color`
+            for the modes supported by each device and dtype.
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, mode: str, *, order=None, device=None):
+        super().__init__(order, device)
+        self.mode = mode
+
+    def apply_tensor(self, images):
+        return cvt_color(images, mode=self.mode)
+
+
+class BatchToMode(BatchTransform):
+    r"""Change the images of the batch from `(N, H, W, C)` to `(N, C, H, W)`. It
+    should be the last transform, as the others take images in `(N, H, W, C)`.
+
+    Args:
+        mode: output mode of the images. Default: "CHW"
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+    """
+
+    def __init__(self, mode="CHW", *, order=None, device=None):
+        super().__init__(order, device)
+        assert mode in ["CHW"], "unsupported mode: {}".format(mode)
+        self.mode = mode
+
+    def apply_tensor(self, images):
+        return transpose(images, (0, 3, 1, 2))
+
+
+class BatchCompose(BatchTransform):
+    r"""Composes several batch transforms together. The images are copied to the
+    device once for all the transforms, and consecutive geometric transforms, i.e.
+    resize, crop and flip, are fused into a single warp, which also skips the
+    rounding of the intermediate images.
+
+    Args:
+        transforms: list of :class:`BatchTransform` to compose.
+        order: the same with :class:`BatchTransform`.
+        device: the same with :class:`BatchTransform`.
+
+    Examples:
+
+        .. code-block:: python
+
+            transform = BatchCompose([
+                BatchRandomResizedCrop(224),
+                BatchRandomHorizontalFlip(),
+                BatchNormalize(mean=[103.530, 116.280, 123.675],
+                               std=[57.375, 57.120, 58.395]),
+                BatchToMode("CHW"),
+            ])
+            dataloader = DataLoader(dataset, sampler, transform=transform)
+    """
+
+    def __init__(
+        self, transforms: Sequence[BatchTransform], *, order=None, device=None
+    ):
+        super().__init__(order, device)
+        for t in transforms:
+            assert isinstance(t, BatchTransform), "{} is not a BatchTransform".format(t)
+        self.transforms = list(transforms)
+
+    def apply_tensor(self, images):
+        mats, shape = None, None
+        for t in self.transforms:
+            if isinstance(t, _GeometricBatchTransform):
+                n = images._tuple_shape[0]
+                h, w = shape if shape is not None else images._tuple_shape[1:3]
+                m, shape = t._get_mats(n, h, w)
+                mats = m if mats is None else np.matmul(mats, m)
+                continue
+            if mats is not None:
+                images = _warp(images, mats, shape)
+                mats, shape = None, None
+            images = t.apply_tensor(images)
+        if mats is not None:
+            images = _warp(images, mats, shape)
+        return images
@@ -39,6 +39,7 @@ __all__ = [
     "get_max_allocated_memory",
     "reset_max_memory_stats",
     "set_prealloc_config",
+    "set_memory_limit",
     "coalesce_free_memory",
 ]
 
@@ -283,6 +284,32 @@ def set_prealloc_config(
     _set_prealloc_config(alignment, min_req, max_overhead, growth_factor, device_type)
 
 
+def set_memory_limit(
+    soft_limit: int = 0, hard_limit: int = 0, device: Optional[str] = None
+):
+    r"""Limits the memory reserved by the caching allocator on the computing device.
+
+    When the reserved memory would exceed the soft limit, the cached free memory is
+    released back to the device so that it could be used by others. Allocations that
+    can not be served under the hard limit fail.
+
+    Args:
+        soft_limit: soft limit in bytes, 0 means no limit.
+        hard_limit: hard limit in bytes, 0 means no limit.
+        device: the computing device, default device if it is None.
+
+    .. note::
+
+       The limits are shared by the computing devices on the same physical device,
+       and only take effect on the cuda and rocm devices using the default allocator.
+    """
+    assert soft_limit >= 0 and hard_limit >= 0
+    assert not soft_limit or not hard_limit or soft_limit <= hard_limit
+    if device is None:
+        device = get_default_device()
+    CompNode(device)._set_mem_limit(soft_limit, hard_limit)
+
+
 def what_is_xpu():
     r"""Return the precise device type like ``cpu``, ``cuda`` and so on."""
     return _what_is_xpu().name.lower()
@@ -20,7 +20,9 @@ from .group import (
 )
 from .helper import bcast_list_, make_allreduce_cb, synchronized
 from .launcher import launcher
+from .pipeline import PipelineParallel
 from .server import Client, Server
+from .sparse_embedding import ShardedEmbedding
 
 
 @mproperty
@@ -18,6 +18,7 @@ from ..core._imperative_rt.core2 import (
 )
 from ..core._trace_option import use_xla_backend
 from ..core.ops.builtin import ParamPackConcat, ParamPackSplit
+from ..functional.math import _check_non_finite
 from ..functional.tensor import copy
 from ..tensor import Tensor
 from ..utils.deprecation import deprecated_func
@@ -124,12 +125,22 @@ def _check_enable_p2p():
         return False
 
 
-def pack_allreduce_split(pack_list, shapes, group, reduce_method):
+def pack_allreduce_split(
+    pack_list, shapes, group, reduce_method, inv_scale=None, stats=None
+):
     offsets_val = get_offsets(shapes)
     offsets = Tensor(offsets_val)
     packed_grads = param_pack_concat(pack_list, offsets, offsets_val)
     packed_grads = all_reduce_sum(packed_grads, group, group.comp_node)
-    if reduce_method == "mean":
+    if inv_scale is not None:
+        # unscale and check non-finite values of the packed grads in one kernel,
+        # where the division of mean is fused into the unscaling
+        if reduce_method == "mean":
+            inv_scale /= group.size
+        found_non_finite = _check_non_finite([packed_grads], inv_scale)
+        if stats is not None:
+            stats.append((found_non_finite, (packed_grads * packed_grads).sum()))
+    elif reduce_method == "mean":
         packed_grads /= group.size
     grads = param_pack_split(packed_grads, offsets_val, shapes)
     return grads
@@ -209,6 +220,19 @@ class AllreduceCallback:
         reduce_method(str): the method to reduce gradiants. ``reduce_method`` should be "sum" or "mean".
         group(:attr:`.distributed.group.Group, optional): communication group. Default: WORLD.
         backend(str, optional): override distributed backend in allreduce. If ``backend`` is None, will use the backend set in ``dist.launcher``. Default: None.
+        bucket_size(int, optional): bytes of the gradients packed into one allreduce. Default: 10MB.
+        first_bucket_size(int, optional): bytes of the first bucket in each backward, which is
+            smaller so that the communication starts to overlap the backward earlier. Default: 1MB.
+        grad_scaler(:class:`~.amp.GradScaler`, optional): if given, the packed gradients are
+            unscaled by the scale factor of ``grad_scaler`` and checked for non-finite values right
+            after the allreduce, in a single kernel for each bucket, and the squared norm of each
+            bucket is summed up for :meth:`grad_norm`. :meth:`~.amp.GradScaler.unscale` then uses
+            the result instead of going through every gradient again, so all the tensors attached
+            to the GradManager should use this callback. Default: None
+
+    The gradients are packed into buckets in the order they are ready during backward, i.e. the
+    reverse topological order, and the allreduce of a bucket is issued to the communication
+    stream of ``group`` as soon as it is full, so it runs along with the rest of the backward.
 
     Examples:
 
@@ -222,13 +246,24 @@ class AllreduceCallback:
             gm.attach(linear_cls.parameters(), callbacks=[dist.make_allreduce_cb("sum")])
     """
 
-    def __init__(self, reduce_method: str, group: Group = WORLD, backend: str = None):
+    def __init__(
+        self,
+        reduce_method: str,
+        group: Group = WORLD,
+        backend: str = None,
+        bucket_size: int = 10 * 1024 * 1024,
+        first_bucket_size: int = 1024 * 1024,
+        grad_scaler=None,
+    ):
         reduce_method = reduce_method.lower()
         assert reduce_method in ["sum", "mean"], "reduce_method should be sum or mean"
         self._reduce_method = reduce_method
         self._group = group
         self._marked_gm = WeakSet()
-        self._param_pack_thd = 10 * 1024 * 1024
+        self._param_pack_thd = bucket_size
+        self._first_pack_thd = first_bucket_size
+        self._grad_scaler = grad_scaler
+        self._grad_sqnorm = None
         self._reset()
         if backend is None:
             assert _group._sd, "please call init_process_group first"
@@ -244,6 +279,8 @@ class AllreduceCallback:
         self._packing_list = defaultdict(list)
         self._packing_size = defaultdict(int)
         self._grad_origin_device = dict()
+        self._nr_packed = 0
+        self._pack_stats = []
 
     def _pack(self, dtype):
         if len(self._packing_list[dtype]) == 0:
@@ -251,14 +288,28 @@ class AllreduceCallback:
         grad_list = [self._gradients_dict[p] for p in self._packing_list[dtype]]
         shapes = [p._tuple_shape for p in self._packing_list[dtype]]
 
+        inv_scale = None
+        if self._grad_scaler is not None:
+            inv_scale = 1.0 / self._grad_scaler.scale_factor
         with override_backend(self._backend):
             reduced_grads = pack_allreduce_split(
-                grad_list, shapes, self._group, self._reduce_method
+                grad_list,
+                shapes,
+                self._group,
+                self._reduce_method,
+                inv_scale,
+                self._pack_stats,
             )
         for param, grad in zip(self._packing_list[dtype], reduced_grads):
             self._gradients_dict[param] = grad
         self._packing_list[dtype] = []
         self._packing_size[dtype] = 0
+        self._nr_packed += 1
+
+    def _pack_thd(self):
+        if self._nr_packed == 0:
+            return min(self._first_pack_thd, self._param_pack_thd)
+        return self._param_pack_thd
 
     def __call__(self, param, grad):
         if use_xla_backend():
@@ -284,7 +335,7 @@ class AllreduceCallback:
         dtype_size = np.dtype(param.dtype).itemsize
         self._packing_list[dtype_str].append(param)
         self._packing_size[dtype_str] += int(np.prod(param._tuple_shape)) * dtype_size
-        if self._packing_size[dtype_str] > self._param_pack_thd:
+        if self._packing_size[dtype_str] > self._pack_thd():
             self._pack(dtype_str)
         return self._futures_dict[param]
 
@@ -296,7 +347,24 @@ class AllreduceCallback:
             grad = self._gradients_dict[param]
             grad = copy(grad, self._grad_origin_device[param])
             self._futures_dict[param].set(grad)
+        if self._grad_scaler is not None and self._pack_stats:
+            found_non_finite = sum(stat[0] for stat in self._pack_stats)
+            # the norm of the accumulated grads can not be derived from the norms
+            # of each backward
+            if self._grad_scaler._accumulate_fused_non_finite(found_non_finite):
+                self._grad_sqnorm = sum(stat[1] for stat in self._pack_stats)
+            else:
+                self._grad_sqnorm = None
         self._reset()
 
+    def grad_norm(self) -> Tensor:
+        r"""Returns the 2-norm of all the gradients reduced in the last backward, which
+        can be passed to :func:`~.optimizer.clip_grad_norm` as ``total_norm``. Only
+        available if ``grad_scaler`` is given and the gradients are not accumulated
+        over several backward passes before :meth:`~.GradScaler.unscale`.
+        """
+        assert self._grad_sqnorm is not None, "grad norm is not computed"
+        return self._grad_sqnorm ** 0.5
+
 
 make_allreduce_cb = AllreduceCallback
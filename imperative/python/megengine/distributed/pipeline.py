@@ -0,0 +1,218 @@
+# -*- coding: utf-8 -*-
+from contextlib import contextmanager
+from typing import Callable, List, Optional
+
+from ..autodiff import GradManager
+from ..device import get_default_device
+from ..functional import copy, split
+from ..module import Module
+from ..tensor import Tensor
+from .functional import (
+    _bcast_shape_dtype,
+    _remote_recv_nobackward,
+    _remote_send_nobackward,
+    _SendRecvGroup,
+)
+from .group import get_rank, get_world_size
+
+
+class PipelineParallel:
+    r"""Runs a model partitioned into pipeline stages, one stage on each rank.
+
+    Each step splits the batch into ``num_microbatches`` micro-batches. The
+    activations of each micro-batch are sent to the next stage, and their gradients
+    are sent back to the previous stage, with point-to-point communication queued
+    asynchronously to the devices.
+
+    The ``"1f1b"`` schedule interleaves the forward and backward of the micro-batches
+    after a warmup of ``num_stages - stage - 1`` forwards. So each stage keeps the
+    activations of at most ``num_stages`` micro-batches, instead of all of them in
+    the ``"gpipe"`` schedule.
+
+    Args:
+        stage: the module of the stage on this rank.
+        num_microbatches: the number of micro-batches to split each batch into.
+        loss_fn: called by the last stage with the output and the labels of each
+            micro-batch to compute the loss.
+        schedule: ``"1f1b"`` or ``"gpipe"``. Default: ``"1f1b"``.
+        recompute: only keep the input of the stage for each micro-batch and
+            recompute the forward before its backward, to save the memory of
+            activations. Default: False.
+        ranks: the rank of each stage in order. Default: all the ranks.
+        comm_stream: the stream to send and receive the tensors on, so that the
+            communication overlaps the computation on the default stream. Default:
+            None, which uses the default stream.
+
+    Examples:
+
+        .. code-block:: python
+
+            stage = [Stage0, Stage1][dist.get_rank()]()
+            pipe = PipelineParallel(stage, 4, loss_fn=F.nn.cross_entropy)
+            opt = SGD(stage.parameters(), lr=0.1)
+            loss = pipe.train_step(inputs=data, labels=label)
+            opt.step().clear_grad()
+    """
+
+    def __init__(
+        self,
+        stage: Module,
+        num_microbatches: int,
+        loss_fn: Optional[Callable] = None,
+        schedule: str = "1f1b",
+        recompute: bool = False,
+        ranks: Optional[List[int]] = None,
+        comm_stream: Optional[int] = None,
+    ):
+        assert num_microbatches > 0, "num_microbatches should be positive"
+        assert schedule in ["1f1b", "gpipe"], "schedule should be 1f1b or gpipe"
+        self.stage = stage
+        self.num_microbatches = num_microbatches
+        self.loss_fn = loss_fn
+        self.schedule = schedule
+        self.recompute = recompute
+        if ranks is None:
+            ranks = list(range(get_world_size()))
+        assert get_rank() in ranks, "the rank is not in the pipeline"
+        self._ranks = ranks
+        self._stage_id = ranks.index(get_rank())
+        self._num_stages = len(ranks)
+        if self.is_last_stage:
+            assert loss_fn is not None, "the last stage requires loss_fn"
+        self._device = get_default_device()
+        self._comm_device = self._device
+        if comm_stream is not None:
+            self._comm_device = "{}:{}".format(self._device, comm_stream)
+
+    @property
+    def is_first_stage(self):
+        return self._stage_id == 0
+
+    @property
+    def is_last_stage(self):
+        return self._stage_id == self._num_stages - 1
+
+    def _schedule(self):
+        m = self.num_microbatches
+        if self.schedule == "gpipe":
+            return [("F", i) for i in range(m)] + [("B", i) for i in range(m)]
+        warmup = min(self._num_stages - self._stage_id - 1, m)
+        ops = [("F", i) for i in range(warmup)]
+        for i in range(m - warmup):
+            ops += [("F", warmup + i), ("B", i)]
+        ops += [("B", i) for i in range(m - warmup, m)]
+        return ops
+
+    def _send(self, x, stage_id):
+        dest = self._ranks[stage_id]
+        _bcast_shape_dtype(_SendRecvGroup(get_rank(), dest), x)
+        if self._comm_device != self._device:
+            x = copy(x, self._comm_device)
+        _remote_send_nobackward(x, dest)
+
+    def _recv(self, stage_id):
+        src = self._ranks[stage_id]
+        shape, dtype = _bcast_shape_dtype(_SendRecvGroup(src, get_rank()), None)
+        x = _remote_recv_nobackward(
+            src, device=self._comm_device, shape=shape, dtype=dtype
+        )
+        if self._comm_device != self._device:
+            x = copy(x, self._device)
+        return x
+
+    @contextmanager
+    def _exclusive(self, gm):
+        # the other micro-batches in flight must not record the ops of this one
+        others = [g for g in self._recording if g is not gm]
+        for g in others:
+            g._grad.suppress()
+        try:
+            yield
+        finally:
+            for g in others:
+                g._grad.resume()
+
+    def _run_forward(self, gm, x, label):
+        with self._exclusive(gm):
+            gm.attach(self.stage.parameters())
+            if not self.is_first_stage:
+                gm.attach(x)
+            gm.record()
+            out = self.stage(x)
+            if self.is_last_stage:
+                out = self.loss_fn(out, label) / self.num_microbatches
+        return out
+
+    def _send_pending_grad(self):
+        # the grad of the last backward is sent after the input of the next op is
+        # received, which is the order that the previous stage runs in
+        if self._pending_grad is not None:
+            self._send(self._pending_grad, self._stage_id - 1)
+            self._pending_grad = None
+
+    def _forward(self, i):
+        x = self._inputs[i] if self.is_first_stage else self._recv(self._stage_id - 1)
+        self._send_pending_grad()
+        label = self._labels[i] if self.is_last_stage else None
+        gm = GradManager()
+        if self.recompute:
+            out = self.stage(x)
+            if self.is_last_stage:
+                out = self.loss_fn(out, label) / self.num_microbatches
+            self._stash[i] = (gm, x, label, None)
+        else:
+            self._recording.append(gm)
+            out = self._run_forward(gm, x, label)
+            self._stash[i] = (gm, x, label, out)
+        if self.is_last_stage:
+            self._losses.append(out.detach())
+        else:
+            self._send(out.detach(), self._stage_id + 1)
+
+    def _backward(self, i):
+        gm, x, label, out = self._stash.pop(i)
+        dy = None if self.is_last_stage else self._recv(self._stage_id + 1)
+        self._send_pending_grad()
+        if out is None:
+            self._recording.append(gm)
+            out = self._run_forward(gm, x, label)
+        with self._exclusive(gm):
+            gm.backward(out, dy)
+        self._recording.remove(gm)
+        if not self.is_first_stage:
+            self._pending_grad = x.grad
+
+    def train_step(self, inputs: Tensor = None, labels: Tensor = None):
+        r"""Runs the forward and backward of one batch, and accumulates the
+        gradients into the parameters of the stage.
+
+        Args:
+            inputs: the batch, only used by the first stage.
+            labels: the labels of the batch, only used by the last stage.
+
+        Returns:
+            the loss summed over the micro-batches on the last stage, or None on
+            the other stages.
+        """
+        m = self.num_microbatches
+        if self.is_first_stage:
+            assert inputs is not None, "the first stage requires inputs"
+            self._inputs = split(inputs, m) if m > 1 else [inputs]
+        if self.is_last_stage:
+            assert labels is not None, "the last stage requires labels"
+            self._labels = split(labels, m) if m > 1 else [labels]
+        self._stash = dict()
+        self._recording = []
+        self._losses = []
+        self._pending_grad = None
+        for op, i in self._schedule():
+            if op == "F":
+                self._forward(i)
+            else:
+                self._backward(i)
+        self._send_pending_grad()
+        self._inputs = self._labels = self._stash = self._recording = None
+        losses, self._losses = self._losses, None
+        if self.is_last_stage:
+            return sum(losses[1:], losses[0])
+        return None
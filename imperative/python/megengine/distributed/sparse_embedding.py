@@ -0,0 +1,203 @@
+# -*- coding: utf-8 -*-
+from typing import Optional, Tuple
+
+import numpy as np
+
+from ..core._imperative_rt.core2 import apply
+from ..core.ops import builtin
+from ..functional import concat, sqrt, zeros
+from ..module import Module, init
+from ..tensor import Tensor
+from .functional import all_reduce_max, all_to_all
+from .group import WORLD, Group, is_distributed
+
+
+def _index_add(num_rows, index, value):
+    # the rows of the same index are summed, as in the grad of indexing
+    out = zeros((num_rows, value.shape[1]), dtype=value.dtype, device=value.device)
+    op = builtin.IndexingIncrMultiAxisVec(items=[(0, False, False, False, True)])
+    return apply(op, out, value, index)[0]
+
+
+class ShardedEmbedding(Module):
+    r"""An embedding table whose rows are sharded across the ranks of a group, for
+    tables too large to be replicated on every device.
+
+    Row ``i`` is kept by rank ``i % group.size``. A lookup pulls only the unique
+    rows touched by the batch from their owners, and the gradients are kept
+    row-sparse, i.e. only for the touched rows. :meth:`step` pushes them back to
+    the owners with ``ALL_TO_ALL``, which sum the gradients of the same row from
+    all the ranks and apply a sparse Adagrad or Adam update to those rows only,
+    so neither the table nor its dense gradients are ever all-reduced.
+
+    The table is not a :class:`~.Parameter`, so it is neither returned by
+    :meth:`parameters` nor updated by the optimizer of the dense model.
+
+    Args:
+        num_embeddings: size of the embedding dictionary.
+        embedding_dim: size of each embedding vector.
+        optimizer: ``"adagrad"`` or ``"adam"``. Default: ``"adagrad"``.
+        lr: learning rate. Default: 1e-2.
+        betas: coefficients of the running averages of Adam. Default: (0.9, 0.999)
+        eps: term added to the denominator to improve numerical stability.
+            Default: 1e-10 for Adagrad and 1e-8 for Adam.
+        group: the group to shard the table across. Default: WORLD.
+        comm_stream: the stream to exchange the rows and the gradients on.
+            Default: None, which uses the stream of the table.
+
+    Examples:
+
+        .. code-block:: python
+
+            emb = ShardedEmbedding(10 ** 8, 64, optimizer="adam", lr=1e-3)
+            gm = GradManager().attach(model.parameters())
+            with gm:
+                loss = model(emb(ids, gm))
+                gm.backward(loss)
+            opt.step().clear_grad()
+            emb.step()
+    """
+
+    def __init__(
+        self,
+        num_embeddings: int,
+        embedding_dim: int,
+        optimizer: str = "adagrad",
+        lr: float = 1e-2,
+        betas: Tuple[float, float] = (0.9, 0.999),
+        eps: Optional[float] = None,
+        group: Group = WORLD,
+        comm_stream: Optional[int] = None,
+        **kwargs
+    ):
+        super().__init__(**kwargs)
+        optimizer = optimizer.lower()
+        assert optimizer in ["adagrad", "adam"], "optimizer should be adagrad or adam"
+        self.num_embeddings = num_embeddings
+        self.embedding_dim = embedding_dim
+        self.optimizer = optimizer
+        self.lr = lr
+        self.betas = betas
+        if eps is None:
+            eps = 1e-10 if optimizer == "adagrad" else 1e-8
+        self.eps = eps
+        self._group = group
+        if is_distributed():
+            self._world_size, self._rank = group.size, group.rank
+        else:
+            self._world_size, self._rank = 1, 0
+
+        size = self._world_size
+        nr_rows = (num_embeddings - self._rank + size - 1) // size
+        self.weight = Tensor(np.zeros((nr_rows, embedding_dim), dtype=np.float32))
+        init.normal_(self.weight)
+        if optimizer == "adagrad":
+            self.square_avg = zeros(self.weight.shape)
+        else:
+            self.exp_avg = zeros(self.weight.shape)
+            self.exp_avg_sq = zeros(self.weight.shape)
+            self.nr_steps = 0
+        self._comm_device = None
+        if comm_stream is not None:
+            self._comm_device = "{}:{}".format(self.weight.device, comm_stream)
+        self._pending = []
+
+    def _all_to_all(self, x):
+        if self._world_size == 1:
+            return x
+        return all_to_all(x, self._group, self._comm_device)
+
+    def _plan(self, rows):
+        # buckets the unique rows by owner, each padded to the max bucket size over
+        # the group so that they are exchanged by one ALL_TO_ALL
+        size = self._world_size
+        owners = rows % size
+        counts = np.bincount(owners, minlength=size)
+        m = int(counts.max())
+        if size > 1:
+            m = int(all_reduce_max(Tensor([m], dtype="int32"), self._group).item())
+        send = np.zeros((size, m), dtype=np.int32)
+        pos = np.empty(len(rows), dtype=np.int32)
+        for p in range(size):
+            idx = np.nonzero(owners == p)[0]
+            send[p, : len(idx)] = rows[idx] // size
+            pos[idx] = p * m + np.arange(len(idx))
+        recv_counts = self._all_to_all(Tensor(counts.astype(np.int32))).numpy()
+        recv = self._all_to_all(Tensor(send.reshape(-1))).numpy()
+        # the local rows requested by all the ranks, and where they are in the
+        # exchanged buffer
+        valid = np.concatenate(
+            [p * m + np.arange(c, dtype=np.int32) for p, c in enumerate(recv_counts)]
+        )
+        return m, pos, recv, valid
+
+    def forward(self, indices, gm=None):
+        r"""Looks up the embeddings of ``indices``.
+
+        Args:
+            indices: tensor or array of indices.
+            gm: the recording :class:`~.GradManager` to compute the gradients of the
+                rows with. Default: None, which only looks up the rows.
+        """
+        if isinstance(indices, Tensor):
+            indices = indices.numpy()
+        indices = np.asarray(indices).astype(np.int64)
+        rows, inverse = np.unique(indices.reshape(-1), return_inverse=True)
+        m, pos, recv, valid = self._plan(rows)
+        dim = self.embedding_dim
+        local = self.weight[Tensor(recv)]
+        pulled = self._all_to_all(local.reshape(-1, m * dim)).reshape(-1, dim)
+        out = pulled[Tensor(pos[inverse])]
+        out = out.reshape(indices.shape + (dim,))
+        if gm is not None:
+
+            def callback(_, grad):
+                grad = grad.reshape(-1, dim)
+                grad = _index_add(len(rows), Tensor(inverse.astype(np.int32)), grad)
+                self._pending.append((grad, m, pos, recv, valid))
+
+            gm.attach(out, callbacks=callback)
+        return out
+
+    def step(self):
+        r"""Pushes the gradients of the rows looked up since the last step to their
+        owners, and updates those rows.
+        """
+        if not self._pending:
+            return self
+        dim = self.embedding_dim
+        rows, grads = [], []
+        for grad, m, pos, recv, valid in self._pending:
+            send = zeros((self._world_size * m, dim), device=grad.device)
+            send[Tensor(pos)] = grad
+            send = self._all_to_all(send.reshape(-1, m * dim)).reshape(-1, dim)
+            rows.append(recv[valid])
+            grads.append(send[Tensor(valid)])
+        self._pending = []
+        rows, inverse = np.unique(np.concatenate(rows), return_inverse=True)
+        grad = concat(grads) if len(grads) > 1 else grads[0]
+        grad = _index_add(len(rows), Tensor(inverse.astype(np.int32)), grad)
+        self._update(Tensor(rows.astype(np.int32)), grad)
+        return self
+
+    def _update(self, rows, grad):
+        lr, eps = self.lr, self.eps
+        weight = self.weight[rows]
+        if self.optimizer == "adagrad":
+            square_avg = self.square_avg[rows] + grad ** 2
+            self.square_avg[rows] = square_avg
+            self.weight[rows] = weight - lr * grad / (sqrt(square_avg) + eps)
+            return
+        # lazy Adam, which only decays the moments of the touched rows
+        beta0, beta1 = self.betas
+        self.nr_steps += 1
+        exp_avg = self.exp_avg[rows] * beta0 + grad * (1 - beta0)
+        exp_avg_sq = self.exp_avg_sq[rows] * beta1 + grad ** 2 * (1 - beta1)
+        self.exp_avg[rows] = exp_avg
+        self.exp_avg_sq[rows] = exp_avg_sq
+        bias_correction0 = 1 - beta0 ** self.nr_steps
+        bias_correction1 = 1 - beta1 ** self.nr_steps
+        delta = (exp_avg / bias_correction0) / (
+            sqrt(exp_avg_sq / bias_correction1) + eps
+        )
+        self.weight[rows] = weight - lr * delta
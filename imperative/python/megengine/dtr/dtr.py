@@ -8,6 +8,9 @@ from ..core._imperative_rt.core2 import clear_candidates as _clear_candidates
 _eviction_threshold = 0
 _evictee_minimum_size = 1024 ** 2
 _enable_sqrt_sampling = False
+_enable_swap = False
+_eviction_policies = ["dtr", "h_dtr_local", "lru", "profiled"]
+_eviction_policy = "dtr"
 
 
 def _str2bytes(text: str) -> int:
@@ -109,6 +112,68 @@ def enable_sqrt_sampling(mod, value: bool):
     _set_option("enable_dtr_sqrt_sampling", _enable_sqrt_sampling)
 
 
+@property
+def enable_swap(mod):
+    r"""Get or set whether the evicted tensors can be swapped to the host. If it is
+    enabled, an evicted tensor is copied to the pinned host memory on the copy
+    stream instead of being dropped when the copies are estimated to be cheaper
+    than recomputing it, and the swapped inputs of the next few dispatched ops are
+    prefetched to the device.
+
+    Examples:
+        .. code-block::
+
+           import megengine as mge
+           mge.dtr.enable_swap = True
+    """
+    return _enable_swap
+
+
+@enable_swap.setter
+def enable_swap(mod, value: bool):
+    global _enable_swap
+    _enable_swap = value
+    _set_option("enable_dtr_swap", _enable_swap)
+
+
+@property
+def eviction_policy(mod):
+    r"""Get or set the heuristic to select the tensor to evict. It can be one of
+
+    * ``"dtr"``: the cost of the evicted neighborhood of the tensor divided by its
+      memory and staleness, which is the default;
+    * ``"h_dtr_local"``: like ``"dtr"``, but only the cost of the tensor itself is
+      considered, which is cheaper to evaluate;
+    * ``"lru"``: the least recently used tensor weighted by its memory;
+    * ``"profiled"``: like ``"dtr"``, but the cost of the ops are read from the
+      table given by the environment variable ``MEGENGINE_DTR_OP_COST_TABLE``,
+      whose lines are ``<time in us> <op name>``.
+
+    Note:
+       The ops executed with DTR are written to the file given by the environment
+       variable ``MEGENGINE_DTR_TRACE_FILE`` if it is set, which can be replayed
+       offline to pick the policy and the threshold for a model.
+
+    Examples:
+        .. code-block::
+
+           import megengine as mge
+           mge.dtr.eviction_policy = "lru"
+    """
+    return _eviction_policy
+
+
+@eviction_policy.setter
+def eviction_policy(mod, value: str):
+    global _eviction_policy
+    if value not in _eviction_policies:
+        raise ValueError(
+            "`value` should be one of {}, got {}".format(_eviction_policies, value)
+        )
+    _eviction_policy = value
+    _set_option("dtr_eviction_policy", _eviction_policies.index(value))
+
+
 def enable():
     r"""Enable to record computing path of tensors and to perform DTR policy."""
     _set_option("enable_dtr_auto_drop", 1)
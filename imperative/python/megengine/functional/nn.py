@@ -74,6 +74,7 @@ __all__ = [
     "deformable_psroi_pooling",
     "dropout",
     "embedding",
+    "embedding_bag",
     "gelu",
     "general_norm",
     "group_norm",
@@ -109,6 +110,8 @@ __all__ = [
     "pixel_shuffle",
     "region_restricted_conv",
     "multi_head_attention",
+    "kv_cache_append",
+    "kv_cache_attention",
 ]
 
 
@@ -1160,6 +1163,7 @@ def general_norm(
     weight: Optional[Tensor] = None,
     bias: Optional[Tensor] = None,
     eps: float = 1e-5,
+    mode: str = "layer_norm",
 ):
     r"""Applies general normalization to the input.
 
@@ -1175,6 +1179,9 @@ def general_norm(
         bias: bias tensor in the learnable affine parameters.
             See :math:`\beta` in :class:`~.GeneralNorm`.
         eps: a value added to the denominator for numerical stability. Default: 1e-5
+        mode: ``"layer_norm"`` subtracts the mean and divides by the standard
+            deviation, ``"rms_norm"`` only divides by the root mean square.
+            Default: "layer_norm"
     """
     if not isinstance(normalized_axis, Sequence):
         normalized_axis = [normalized_axis]
@@ -1225,6 +1232,7 @@ def general_norm(
         eps=eps,
         axis_start=_builtins_min(normalized_axis),
         axis_end=_builtins_max(normalized_axis) + 1,
+        mode=mode,
     )
     if affine:
         assert weight is not None, "weight must be provided if affine is True"
@@ -1693,6 +1701,49 @@ def embedding(
     return weight[inp.reshape(-1)].reshape(dest_shp)
 
 
+def embedding_bag(
+    weight: Tensor,
+    indices: Tensor,
+    offsets: Tensor,
+    mode: str = "sum",
+    per_sample_weights: Optional[Tensor] = None,
+) -> Tensor:
+    r"""Looks up the rows of an embedding table for each bag of indices and pools
+    them, without materializing the looked up rows.
+
+    Bag ``b`` is ``indices[offsets[b]:offsets[b + 1]]``, and the last bag ends at
+    the end of ``indices``. An empty bag gives zeros.
+
+    Args:
+        weight: the embedding table with shape `(num_embeddings, dim)`.
+        indices: 1-D tensor with the indices of all the bags.
+        offsets: 1-D tensor with the start of each bag in ``indices``, in
+            ascending order.
+        mode: ``"sum"``, ``"mean"`` or ``"max"``. Default: ``"sum"``
+        per_sample_weights: optional weights of ``indices`` with the same shape,
+            only supported in ``"sum"`` mode. Its gradient is not computed.
+
+    Returns:
+        the pooled rows with shape `(len(offsets), dim)`.
+
+    Examples:
+        >>> weight = Tensor([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]])
+        >>> out = F.nn.embedding_bag(weight, Tensor([0, 2, 1]), Tensor([0, 2]))
+        >>> out.numpy()
+        array([[6., 8.],
+               [3., 4.]], dtype=float32)
+    """
+    mode = mode.upper()
+    if per_sample_weights is not None and mode != "SUM":
+        raise ValueError("per_sample_weights is only supported in sum mode")
+    indices = indices.astype("int32")
+    offsets = offsets.astype("int32")
+    if per_sample_weights is None:
+        per_sample_weights = Tensor([], dtype=weight.dtype, device=weight.device)
+    op = builtin.EmbeddingBag(mode=mode)
+    return apply(op, weight, indices, offsets, per_sample_weights)[0]
+
+
 def indexing_one_hot(
     src: Tensor, index: Tensor, axis: int = 1, keepdims=False
 ) -> Tensor:
@@ -2558,6 +2609,84 @@ def multi_head_attention(
         return out[0], None
 
 
+
+def kv_cache_append(
+    qkv: Tensor,
+    positions: Tensor,
+    block_table: Tensor,
+    k_cache: Tensor,
+    v_cache: Tensor,
+    num_heads: int,
+    rotary_dim: int = 0,
+    rotary_base: float = 10000.0,
+) -> Tensor:
+    r"""Splits the output of a fused qkv projection into heads, applies the rotary
+    position embedding to the queries and keys, and appends the keys and values
+    into the paged kv cache inplace.
+
+    The cache is stored in blocks of ``block_size`` tokens. The ``i``-th block of
+    sequence ``b`` is the block ``block_table[b, i]`` of the cache, and the
+    tokens of ``qkv`` are written after the ``positions[b]`` tokens already in
+    the cache. Refer to :class:`~.module.kv_cache.KVCache` which manages the
+    blocks.
+
+    Args:
+        qkv: the fused projection with shape `(batch, seqlen, 3 * num_heads * head_dim)`.
+        positions: int32 tensor with shape `(batch, )`, the number of tokens in
+            the cache of each sequence before this step.
+        block_table: int32 tensor with shape `(batch, max_nr_blocks)`.
+        k_cache: key cache with shape `(nr_blocks, num_heads, block_size, head_dim)`,
+            which is updated inplace.
+        v_cache: value cache with the same shape as ``k_cache``, which is updated
+            inplace.
+        num_heads: number of attention heads.
+        rotary_dim: number of leading channels of each head that are rotated, 0
+            means no rotary embedding. Default: 0
+        rotary_base: base of the rotary frequencies. Default: 10000.0
+
+    Returns:
+        the queries with shape `(batch, num_heads, seqlen, head_dim)`.
+    """
+    op = builtin.KVCacheAppend(
+        num_heads=num_heads, rotary_dim=rotary_dim, rotary_base=rotary_base
+    )
+    q, new_k_cache, new_v_cache = apply(
+        op, qkv, positions, block_table, k_cache, v_cache
+    )
+    k_cache._reset(new_k_cache)
+    v_cache._reset(new_v_cache)
+    return q
+
+
+def kv_cache_attention(
+    q: Tensor,
+    k_cache: Tensor,
+    v_cache: Tensor,
+    positions: Tensor,
+    block_table: Tensor,
+    scale: Optional[float] = None,
+) -> Tensor:
+    r"""Causal attention of the queries of a decode step over the paged kv cache
+    filled by :func:`~.kv_cache_append`.
+
+    The query at step ``t`` of sequence ``b`` attends to the first
+    ``positions[b] + t + 1`` tokens in the cache.
+
+    Args:
+        q: the queries with shape `(batch, num_heads, seqlen, head_dim)`.
+        k_cache: key cache with shape `(nr_blocks, num_heads, block_size, head_dim)`.
+        v_cache: value cache with the same shape as ``k_cache``.
+        positions: int32 tensor with shape `(batch, )`, the number of tokens in
+            the cache of each sequence before this step.
+        block_table: int32 tensor with shape `(batch, max_nr_blocks)`.
+        scale: scale of the attention scores. Default: ``1 / sqrt(head_dim)``
+
+    Returns:
+        the attention output with shape `(batch, seqlen, num_heads * head_dim)`.
+    """
+    op = builtin.KVCacheAttention(scale=0.0 if scale is None else scale)
+    return apply(op, q, k_cache, v_cache, positions, block_table)[0]
+
 from .loss import *  # isort:skip
 from .metric import *  # isort:skip
 from .vision import *  # isort:skip
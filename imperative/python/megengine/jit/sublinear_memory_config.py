@@ -22,6 +22,13 @@ class SublinearMemoryConfig:
             in sublinear memory optimization. Default: half of cpu number in the system.
             Note: the value must be greater or equal to one.
             It can also be set through the environmental variable 'MGB_SUBLINEAR_MEMORY_WORKERS'.
+        budget_memory_mb: hard budget of the bottleneck size in MB. If positive, the
+            checkpoints with the least estimated recomputation within the budget are
+            chosen rather than the ones with the least memory, and the expected
+            recompute overhead is logged. Default: 0.
+            It can also be set through the environmental variable 'MGB_SUBLINEAR_MEMORY_BUDGET_MB'.
+        budget_search_time_ms: time limit in milliseconds of searching around the best
+            checkpoints within the budget. Default: 1000.
     
     Note that the environmental variable MGB_COMP_GRAPH_OPT must be set to 'enable_sublinear_memory_opt=1'
     in order for the above environmental variable to be effective.
@@ -34,6 +41,8 @@ class SublinearMemoryConfig:
         genetic_pool_size: int = 20,
         lb_memory_mb: int = 0,
         num_worker: int = max(1, get_device_count("cpu") // 2),
+        budget_memory_mb: int = 0,
+        budget_search_time_ms: int = 1000,
     ):
         assert thresh_nr_try >= 0, "thresh_nr_try must be greater or equal to zero"
         self.thresh_nr_try = thresh_nr_try
@@ -46,3 +55,6 @@ class SublinearMemoryConfig:
         self.lb_memory_mb = lb_memory_mb
         assert num_worker > 0, "num_worker must be greater or equal to one"
         self.num_worker = num_worker
+        assert budget_memory_mb >= 0, "budget_memory_mb must be greater or equal to zero"
+        self.budget_memory_mb = budget_memory_mb
+        self.budget_search_time_ms = budget_search_time_ms
@@ -60,6 +60,18 @@ def _input_node_use_static_shape():
     return os.environ.get("MEGENGINE_INPUT_NODE_USE_STATIC_SHAPE") is not None
 
 
+def _flatten_tensors(value, tensors):
+    if isinstance(value, RawTensor):
+        tensors.append(value)
+    elif isinstance(value, (list, tuple)):
+        for i in value:
+            _flatten_tensors(i, tensors)
+    elif isinstance(value, dict):
+        for k in sorted(value.keys(), key=str):
+            _flatten_tensors(value[k], tensors)
+    return tensors
+
+
 active_trace = None
 skip_tracing = False
 
@@ -115,6 +127,16 @@ class trace:
             and run the compiled graph/function on subsequent calls. if False, will run python code every time.
             Default: False
         imperative(bool): if True, will use imperative runtime to execute captured op seq. Default: False
+        cache_size(int): if positive, keep the traces for up to so many input signatures (shapes,
+            dtypes and devices of the tensor arguments), and retrace when called with a new one, evicting
+            the least recently used trace. With ``symbolic_shape``, a trace is reused for the signatures
+            differing only in the sizes of dims, e.g. the batch size. Only used if ``without_host`` is
+            False. Default: 0
+        capture_step(bool): only used if ``without_host`` is True. If True, the compiled graph, e.g. a
+            whole training step with forward, backward and the optimizer update, is recorded on the
+            first runs and replayed in one launch afterwards (as a CUDA graph on cuda devices). Inputs
+            are copied into fixed device buffers, so input shapes should not change, and all the ops
+            should be on one device. Default: False
     """
 
     third_party_backend = False
@@ -139,6 +161,8 @@ class trace:
         symbolic_shape: bool = True,
         without_host: bool = False,
         imperative: bool = False,
+        cache_size: int = 0,
+        capture_step: bool = False,
     ):
         self.__wrapped__ = function
         self._capture_as_const = capture_as_const or record_only
@@ -194,8 +218,17 @@ class trace:
             graph_options[
                 "sublinear_mem_config.num_worker"
             ] = sublinear_memory_config.num_worker
+            graph_options[
+                "sublinear_mem_config.budget_memory_mb"
+            ] = sublinear_memory_config.budget_memory_mb
+            graph_options[
+                "sublinear_mem_config.budget_search_time_ms"
+            ] = sublinear_memory_config.budget_search_time_ms
         if int(os.getenv("MEGENGINE_INPLACE_UPDATE", "0")):
             graph_options["var_sanity_check_first_run"] = False
+        if capture_step:
+            assert without_host, "capture_step requires without_host"
+            graph_options["comp_node_seq_record_level"] = 1
 
         def apply_options(options):
             for k, v in graph_options.items():
@@ -215,6 +248,8 @@ class trace:
         self._trace.array_comparator = array_comparator
         self._trace.record_input_shapes = _input_node_use_static_shape()
         self._trace.without_host = without_host
+        self._trace.cache_capacity = cache_size
+        self._trace.shape_polymorphic = symbolic_shape
         self.check_external = True
         self.traced = False
         self.input_num = 0
@@ -355,6 +390,8 @@ class trace:
         outputs = None
         try:
             active_trace = self
+            if self._trace.cache_capacity:
+                self._trace.set_signature(_flatten_tensors((args, kwargs), []))
             self._trace.enter()
             if self._capture_as_const:
                 self._process_inputs(*args, **kwargs)
@@ -1133,6 +1170,9 @@ class trace:
         * enable_ioc16 --
           whether to use float16 for both I/O and computation
           precision.
+        * enable_f16_mixed_precision: with enable_io16xc32 or enable_ioc16, keep
+          the oprs sensitive to float16, like softmax, normalizations and
+          reductions, in float32.
         * enable_hwcd4 --
           whether to use NHWCD4 data layout. This is faster on some
           OpenCL backend.
@@ -1165,6 +1205,10 @@ class trace:
           inference)
         * enable_fuse_preprocess: whether to fuse astype\pad_channel\dimshuffle and
           etc opr
+        * enable_precompute_weight: whether to store transformed constant weights,
+          like the transposed weights of matmul, into the model.
+        * precompute_weight_size_budget: max bytes the model may grow by
+          enable_precompute_weight, unlimited by default.
         """
         if compat_older_version:
             compat_older_version = compat_older_version.strip()
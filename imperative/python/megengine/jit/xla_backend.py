@@ -132,7 +132,9 @@ class xla_trace(trace):
             0 if len(devices) == 0 else [d.id for d in devices].index(device_id)
         )
         device = devices[device_index]
-        # TODO: device -> host -> device
+        # the params and optimizer states are donated to xla in each step, so they
+        # should be buffers owned by xla rather than borrowed from megengine by
+        # dlpack. it is device -> host -> device, but only happens once.
         for attr, _ in self.attr_to_key.items():
             param = get_expand_structure(attr[0], attr[1])
             param._reset(param.to("cpux"))
@@ -154,6 +156,27 @@ class xla_trace(trace):
         for tensor, _ in self.opt_param_dict.items():
             as_xla_array(tensor, backend, device)
 
+    def get_donated_vars(self):
+        r"""the ids of the input vars of the params and optimizer states, which
+        are replaced by their updated values after each step, so their buffers can
+        be reused by the updated values rather than allocating new ones"""
+        if not self.overall:
+            return None
+        donated_marks = set()
+        for attr, key in self.attr_to_key.items():
+            if attr in self.update_param_dict:
+                donated_marks.add(key)
+        for state, key in self.opt_param_dict.items():
+            if state in self.update_opt_param_dict:
+                donated_marks.add(key)
+        donated_vars = set()
+        for var in self.vars:
+            # a var marked by several inputs is donated only if all of them are
+            if var.kind == "external" and var.inp_mark:
+                if all(mark in donated_marks for mark in var.inp_mark):
+                    donated_vars.add(var.id)
+        return donated_vars
+
     def compile(self):
         from ..xla import build_xla
         from ..tensor import Tensor
@@ -201,6 +224,7 @@ class xla_trace(trace):
 
         self.tr, self.xla_exec, self.inp_ids, self.out_ids = build_xla(
             self,
+            donate_invars=self.get_donated_vars(),
             return_with_io=True,
             return_device_array=True,
             ip=get_mm_server_addr()[0] if is_distributed() else None,
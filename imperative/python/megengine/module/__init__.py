@@ -24,6 +24,7 @@ from .dropout import Dropout
 from .elemwise import Elemwise
 from .embedding import Embedding
 from .identity import Identity
+from .kv_cache import KVCache
 from .linear import Linear, LinearRelu
 from .linear_bn import LinearBn1d, LinearBnRelu1d
 from .lrn import LocalResponseNorm
@@ -37,6 +38,12 @@ from .quant_dequant import DequantStub, QuantStub
 from .rnn import LSTM, RNN, LSTMCell, RNNCell
 from .sequential import Sequential
 from .sliding_window import SlidingWindow, SlidingWindowTranspose
+from .tensor_parallel import (
+    ColumnParallelLinear,
+    ParallelSelfAttention,
+    RowParallelLinear,
+    VocabParallelEmbedding,
+)
 from .vision import (
     ActiveBlur,
     AdditiveElemwise,
@@ -0,0 +1,127 @@
+from typing import Optional, Sequence
+
+import numpy as np
+
+from ..functional.nn import kv_cache_append, kv_cache_attention
+from ..functional.tensor import zeros
+from ..tensor import Tensor
+from .module import Module
+
+
+class KVCache(Module):
+    r"""Paged key/value cache for incremental decoding of multi-head attention.
+
+    The keys and values of all the sequences are stored in ``nr_blocks`` blocks of
+    ``block_size`` tokens, which are assigned to the sequences on demand and
+    returned by :meth:`remove_sequence`. Each call of :meth:`forward` splits the
+    output of a fused qkv projection into heads, rotates the queries and keys,
+    appends the keys and values of the new tokens into the cache inplace and
+    returns the causal attention of the new tokens over the cached ones.
+
+    Args:
+        nr_blocks: number of blocks in the cache.
+        num_heads: number of attention heads.
+        head_dim: number of channels of each head.
+        block_size: number of tokens in a block. Default: 16
+        rotary_dim: number of leading channels of each head that are rotated by
+            the rotary position embedding, 0 means no rotary embedding. Default: 0
+        rotary_base: base of the rotary frequencies. Default: 10000.0
+        scale: scale of the attention scores. Default: ``1 / sqrt(head_dim)``
+        dtype: data type of the cache. Default: ``"float32"``
+
+    Shape:
+        - qkv: `(batch, seqlen, 3 * num_heads * head_dim)`.
+        - output: `(batch, seqlen, num_heads * head_dim)`.
+
+    Examples:
+        >>> import numpy as np
+        >>> cache = M.KVCache(nr_blocks=8, num_heads=2, head_dim=4, block_size=4)
+        >>> cache.add_sequence(0)
+        >>> prompt = Tensor(np.random.rand(1, 5, 24).astype("float32"))
+        >>> cache(prompt, [0]).shape
+        (1, 5, 8)
+        >>> token = Tensor(np.random.rand(1, 1, 24).astype("float32"))
+        >>> cache(token, [0]).shape
+        (1, 1, 8)
+        >>> cache.length(0)
+        6
+    """
+
+    def __init__(
+        self,
+        nr_blocks: int,
+        num_heads: int,
+        head_dim: int,
+        block_size: int = 16,
+        rotary_dim: int = 0,
+        rotary_base: float = 10000.0,
+        scale: Optional[float] = None,
+        dtype: str = "float32",
+        **kwargs
+    ):
+        super().__init__(**kwargs)
+        self.num_heads = num_heads
+        self.head_dim = head_dim
+        self.block_size = block_size
+        self.rotary_dim = rotary_dim
+        self.rotary_base = rotary_base
+        self.scale = scale
+        shape = (nr_blocks, num_heads, block_size, head_dim)
+        self.k_cache = zeros(shape, dtype=dtype)
+        self.v_cache = zeros(shape, dtype=dtype)
+        self._free_blocks = list(range(nr_blocks - 1, -1, -1))
+        self._blocks = {}
+        self._lengths = {}
+
+    def add_sequence(self, seq_id):
+        r"""Starts an empty sequence identified by ``seq_id``."""
+        assert seq_id not in self._lengths, "sequence {} exists".format(seq_id)
+        self._blocks[seq_id] = []
+        self._lengths[seq_id] = 0
+
+    def remove_sequence(self, seq_id):
+        r"""Drops a sequence and returns its blocks to the cache."""
+        self._free_blocks.extend(reversed(self._blocks.pop(seq_id)))
+        del self._lengths[seq_id]
+
+    def length(self, seq_id) -> int:
+        r"""Number of tokens of a sequence in the cache."""
+        return self._lengths[seq_id]
+
+    def _reserve(self, seq_id, length):
+        blocks = self._blocks[seq_id]
+        while len(blocks) * self.block_size < length:
+            if not self._free_blocks:
+                raise RuntimeError("kv cache is out of blocks")
+            blocks.append(self._free_blocks.pop())
+
+    def forward(self, qkv: Tensor, seq_ids: Sequence) -> Tensor:
+        batch, seqlen = qkv.shape[0], qkv.shape[1]
+        assert batch == len(seq_ids), "one sequence id is required for each batch"
+        positions = np.array([self._lengths[s] for s in seq_ids], dtype="int32")
+        for seq_id, pos in zip(seq_ids, positions):
+            self._reserve(seq_id, int(pos) + seqlen)
+        max_nr_blocks = max(len(self._blocks[s]) for s in seq_ids)
+        block_table = np.zeros((batch, max_nr_blocks), dtype="int32")
+        for i, seq_id in enumerate(seq_ids):
+            blocks = self._blocks[seq_id]
+            block_table[i, : len(blocks)] = blocks
+        positions = Tensor(positions, device=qkv.device)
+        block_table = Tensor(block_table, device=qkv.device)
+
+        q = kv_cache_append(
+            qkv,
+            positions,
+            block_table,
+            self.k_cache,
+            self.v_cache,
+            self.num_heads,
+            self.rotary_dim,
+            self.rotary_base,
+        )
+        out = kv_cache_attention(
+            q, self.k_cache, self.v_cache, positions, block_table, self.scale
+        )
+        for seq_id in seq_ids:
+            self._lengths[seq_id] += seqlen
+        return out
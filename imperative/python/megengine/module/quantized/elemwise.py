@@ -1,20 +1,55 @@
-from ...functional.elemwise import _elemwise_multi_type
+import numpy as np
+
+from ... import functional as F
+from ...core.ops import builtin
+from ...core.tensor import dtype
+from ...functional.elemwise import _elemwise_multi_type, _elwise
 from ...tensor import Tensor
 from ..qat import elemwise as QAT
 from .module import QuantizedModule
 
 
 class Elemwise(QuantizedModule):
-    r"""Quantized version of :class:`~.qat.Elemwise`."""
+    r"""Quantized version of :class:`~.qat.Elemwise`.
+
+    The unary methods without a quantized mode of :class:`~.ElemwiseMultiType`,
+    e.g. ``gelu``, are computed by looking up a table of the 256 int8 values,
+    which only supports qint8 input.
+    """
 
     def __init__(self, method, dtype=None, **kwargs):
         super().__init__(**kwargs)
         self.method = "q" + method
         self.output_dtype = dtype
+        mode = self.method.upper()
+        self.use_table = not hasattr(builtin.ElemwiseMultiType.Mode, mode)
+        self._table = None
+        self._table_scale = None
+
+    def _get_table(self, inp_scale):
+        if self._table is None or self._table_scale != inp_scale:
+            grid = Tensor(np.arange(-128, 128, dtype="float32") * inp_scale)
+            # kept as numpy, not to be taken as a buffer of the module
+            self._table = _elwise(grid, mode=self.method[1:]).numpy()
+            self._table_scale = inp_scale
+        return self._table
+
+    def _forward_by_table(self, inp):
+        assert (
+            inp.dtype.metadata["mgb_dtype"]["name"] == "QuantizedS8"
+        ), "{} of quantized Elemwise only supports qint8 input".format(self.method)
+        inp_scale = dtype.get_scale(inp.dtype)
+        table = self._get_table(inp_scale)
+        index = F.round(inp.astype("float32") / inp_scale).astype("int32") + 128
+        ret = Tensor(table)[index.flatten()].reshape(inp.shape)
+        return ret if self.output_dtype is None else ret.astype(self.output_dtype)
 
     def forward(self, *inps):
         if self.training:
             raise ValueError("quantized module only support inference.")
+        if self.use_table:
+            assert len(inps) == 1, "{} is not supported".format(self.method)
+            return self._forward_by_table(inps[0])
         return _elemwise_multi_type(*inps, mode=self.method, dtype=self.output_dtype)
 
     @classmethod
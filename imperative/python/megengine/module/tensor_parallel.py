@@ -0,0 +1,477 @@
+# -*- coding: utf-8 -*-
+from typing import Optional
+
+import numpy as np
+
+from ..core.autodiff.grad import Function
+from ..device import get_default_device
+from ..distributed.functional import all_gather, all_reduce_sum, reduce_scatter_sum
+from ..distributed.group import WORLD, Group, is_distributed
+from ..functional import concat, expand_dims, matmul, split, where, zeros_like
+from ..functional.nn import embedding, linear, softmax
+from ..tensor import Parameter, Tensor
+from . import init
+from .module import Module
+
+# The autodiff of the collectives below follows the layout of the tensors in the
+# tensor-parallel region, e.g. the grad of a tensor gathered along the hidden axis
+# is split rather than reduce-scattered, since the grads of the replicated output
+# are the same on all the ranks.
+
+
+class _CopyToGroup(Function):
+    def __init__(self, group):
+        self.group = group
+
+    def forward(self, x):
+        return x.detach()
+
+    def backward(self, dy):
+        return all_reduce_sum(dy, self.group)
+
+
+class _ReduceFromGroup(Function):
+    def __init__(self, group, device):
+        self.group = group
+        self.device = device
+
+    def forward(self, x):
+        return all_reduce_sum(x, self.group, self.device)
+
+    def backward(self, dy):
+        return dy
+
+
+class _GatherFromGroup(Function):
+    # gather along the last axis, and split the grad
+    def __init__(self, group, device):
+        self.group = group
+        self.device = device
+
+    def forward(self, x):
+        self.axis = x.ndim - 1
+        return all_gather(x, self.group, self.device, axis=self.axis)
+
+    def backward(self, dy):
+        return split(dy, self.group.size, axis=self.axis)[self.group.rank]
+
+
+class _ScatterToGroup(Function):
+    # take the slice of this rank along the last axis, and gather the grad
+    def __init__(self, group):
+        self.group = group
+
+    def forward(self, x):
+        self.axis = x.ndim - 1
+        return split(x, self.group.size, axis=self.axis)[self.group.rank]
+
+    def backward(self, dy):
+        return all_gather(dy, self.group, axis=self.axis)
+
+
+class _GatherSequence(Function):
+    # gather along the first axis, and reduce-scatter the grad
+    def __init__(self, group, device):
+        self.group = group
+        self.device = device
+
+    def forward(self, x):
+        return all_gather(x, self.group, self.device)
+
+    def backward(self, dy):
+        return reduce_scatter_sum(dy, self.group, self.device)
+
+
+class _ReduceScatterSequence(Function):
+    # reduce-scatter along the first axis, and gather the grad
+    def __init__(self, group, device):
+        self.group = group
+        self.device = device
+
+    def forward(self, x):
+        return reduce_scatter_sum(x, self.group, self.device)
+
+    def backward(self, dy):
+        return all_gather(dy, self.group, self.device)
+
+
+def _interleave(x, n, m):
+    # reorder the first axis of x from (m, n, ...) to (n, m, ...)
+    shape = x._tuple_shape
+    x = x.reshape(m, n, shape[0] // (m * n), *shape[1:])
+    x = x.transpose(1, 0, *range(2, x.ndim))
+    return x.reshape(shape)
+
+
+class _TensorParallel(Module):
+    def __init__(
+        self,
+        group: Optional[Group],
+        sequence_parallel: bool,
+        num_chunks: int,
+        comm_stream: Optional[int],
+        **kwargs
+    ):
+        super().__init__(**kwargs)
+        assert num_chunks > 0, "num_chunks should be positive"
+        if group is not None and is_distributed() and group.size > 1:
+            self.group = group
+            self.world_size, self.rank = group.size, group.rank
+        else:
+            self.group = None
+            self.world_size, self.rank = 1, 0
+        self.sequence_parallel = sequence_parallel and self.group is not None
+        self.num_chunks = num_chunks
+        self.comm_device = None
+        if comm_stream is not None:
+            self.comm_device = "{}:{}".format(get_default_device(), comm_stream)
+
+    def _shard_size(self, size, name):
+        assert (
+            size % self.world_size == 0
+        ), "{} {} is not divisible by the size of the group {}".format(
+            name, size, self.world_size
+        )
+        return size // self.world_size
+
+    def _chunks(self, x):
+        if self.num_chunks == 1:
+            return [x]
+        return split(x, self.num_chunks)
+
+    def _module_info_string(self) -> str:
+        return "world_size={}, rank={}, sequence_parallel={}".format(
+            self.world_size, self.rank, self.sequence_parallel
+        )
+
+
+class ColumnParallelLinear(_TensorParallel):
+    r"""A linear layer whose weight is split along the output features across a
+    tensor-parallel group, i.e. :math:`W = [W_0; W_1; ...]` and rank :math:`i` keeps
+    :math:`W_i`, as in `Megatron-LM <https://arxiv.org/abs/1909.08053>`_.
+
+    The input is replicated on the ranks, and rank :math:`i` computes the output
+    features :math:`y_i = x W_i^T + b_i`. Usually followed by a
+    :class:`RowParallelLinear` which takes :math:`y_i` as its input, so that no
+    communication is needed between them.
+
+    With ``sequence_parallel``, the input is split along the first axis (the
+    sequence) across the ranks, and is all-gathered before the matmul. The input
+    is split into ``num_chunks`` chunks along the first axis, and the all-gather of
+    a chunk runs on ``comm_stream`` while the matmul of the previous chunk runs, so
+    that the communication is overlapped with the computation.
+
+    Args:
+        in_features: size of each input sample.
+        out_features: size of each output sample, which must be divisible by the
+            size of the group.
+        bias: whether to learn an additional bias. Default: True
+        group: the tensor-parallel group. Default: WORLD
+        gather_output: whether to all-gather the output features, so that the
+            output is replicated. Default: False
+        sequence_parallel: whether the input is split along the first axis.
+            Default: False
+        num_chunks: the number of chunks to pipeline the communication with the
+            matmul. Default: 1
+        comm_stream: the stream to run the communication on. Default: None, which
+            uses the default stream.
+    """
+
+    def __init__(
+        self,
+        in_features: int,
+        out_features: int,
+        bias: bool = True,
+        group: Optional[Group] = WORLD,
+        gather_output: bool = False,
+        sequence_parallel: bool = False,
+        num_chunks: int = 1,
+        comm_stream: Optional[int] = None,
+        compute_mode: str = "default",
+        **kwargs
+    ):
+        super().__init__(group, sequence_parallel, num_chunks, comm_stream, **kwargs)
+        self.in_features = in_features
+        self.out_features = out_features
+        self.gather_output = gather_output and self.group is not None
+        self.compute_mode = compute_mode
+        local_out = self._shard_size(out_features, "out_features")
+        self.weight = Parameter(np.zeros((local_out, in_features), dtype=np.float32))
+        self.bias = None
+        if bias:
+            self.bias = Parameter(np.zeros((local_out,), dtype=np.float32))
+        self.reset_parameters()
+
+    def reset_parameters(self) -> None:
+        init.normal_(self.weight, 0.0, np.sqrt(1 / self.in_features))
+        if self.bias is not None:
+            init.zeros_(self.bias)
+
+    def forward(self, x):
+        if self.group is None:
+            return linear(x, self.weight, self.bias, compute_mode=self.compute_mode)
+        if not self.sequence_parallel:
+            x = _CopyToGroup(self.group)(x)
+        chunks = self._chunks(x)
+        if self.sequence_parallel:
+            # issue the all-gather of each chunk ahead of its matmul
+            chunks = [_GatherSequence(self.group, self.comm_device)(c) for c in chunks]
+        outs = []
+        for c in chunks:
+            y = linear(c, self.weight, self.bias, compute_mode=self.compute_mode)
+            if self.gather_output:
+                y = _GatherFromGroup(self.group, self.comm_device)(y)
+            outs.append(y)
+        y = outs[0] if len(outs) == 1 else concat(outs)
+        if self.sequence_parallel and self.num_chunks > 1:
+            # the rows are gathered chunk by chunk, restore the order of the ranks
+            y = _interleave(y, self.world_size, self.num_chunks)
+        return y
+
+    def _module_info_string(self) -> str:
+        return "in_features={}, out_features={}, bias={}, {}".format(
+            self.in_features,
+            self.out_features,
+            self.bias is not None,
+            super()._module_info_string(),
+        )
+
+
+class RowParallelLinear(_TensorParallel):
+    r"""A linear layer whose weight is split along the input features across a
+    tensor-parallel group, i.e. :math:`W = [W_0, W_1, ...]` and rank :math:`i`
+    keeps :math:`W_i`, as in `Megatron-LM <https://arxiv.org/abs/1909.08053>`_.
+
+    Rank :math:`i` computes the partial sum :math:`x_i W_i^T` with the input
+    features :math:`x_i`, which are all-reduced across the group, or
+    reduce-scattered along the first axis with ``sequence_parallel``. The input is
+    split into ``num_chunks`` chunks along the first axis, and the reduction of a
+    chunk runs on ``comm_stream`` while the matmul of the next chunk runs, so that
+    the communication is overlapped with the computation.
+
+    Args:
+        in_features: size of each input sample, which must be divisible by the
+            size of the group.
+        out_features: size of each output sample.
+        bias: whether to learn an additional bias, which is replicated on the
+            ranks. Default: True
+        group: the tensor-parallel group. Default: WORLD
+        input_is_parallel: whether the input is already split along the features,
+            e.g. the output of :class:`ColumnParallelLinear`. Otherwise the input is
+            replicated and this rank takes its own features. Default: True
+        sequence_parallel: whether to split the output along the first axis.
+            Default: False
+        num_chunks: the number of chunks to pipeline the communication with the
+            matmul. Default: 1
+        comm_stream: the stream to run the communication on. Default: None, which
+            uses the default stream.
+    """
+
+    def __init__(
+        self,
+        in_features: int,
+        out_features: int,
+        bias: bool = True,
+        group: Optional[Group] = WORLD,
+        input_is_parallel: bool = True,
+        sequence_parallel: bool = False,
+        num_chunks: int = 1,
+        comm_stream: Optional[int] = None,
+        compute_mode: str = "default",
+        **kwargs
+    ):
+        super().__init__(group, sequence_parallel, num_chunks, comm_stream, **kwargs)
+        self.in_features = in_features
+        self.out_features = out_features
+        self.input_is_parallel = input_is_parallel
+        self.compute_mode = compute_mode
+        local_in = self._shard_size(in_features, "in_features")
+        self.weight = Parameter(np.zeros((out_features, local_in), dtype=np.float32))
+        self.bias = None
+        if bias:
+            self.bias = Parameter(np.zeros((out_features,), dtype=np.float32))
+        self.reset_parameters()
+
+    def reset_parameters(self) -> None:
+        init.normal_(self.weight, 0.0, np.sqrt(1 / self.in_features))
+        if self.bias is not None:
+            init.zeros_(self.bias)
+
+    def forward(self, x):
+        if self.group is None:
+            return linear(x, self.weight, self.bias, compute_mode=self.compute_mode)
+        if not self.input_is_parallel:
+            x = _ScatterToGroup(self.group)(x)
+        n, m = self.world_size, self.num_chunks
+        if self.sequence_parallel and m > 1:
+            # chunk c takes the c-th chunk of the rows of every rank, so that the
+            # concatenated outputs of the reduce-scatters are the rows of this rank
+            x = _interleave(x, m, n)
+        outs = []
+        for c in self._chunks(x):
+            y = linear(c, self.weight, compute_mode=self.compute_mode)
+            if self.sequence_parallel:
+                y = _ReduceScatterSequence(self.group, self.comm_device)(y)
+            else:
+                y = _ReduceFromGroup(self.group, self.comm_device)(y)
+            outs.append(y)
+        y = outs[0] if len(outs) == 1 else concat(outs)
+        if self.bias is not None:
+            bias = self.bias
+            if self.sequence_parallel:
+                # the rows are split, so the grads of the bias are partial
+                bias = _CopyToGroup(self.group)(bias)
+            y = y + bias
+        return y
+
+    def _module_info_string(self) -> str:
+        return "in_features={}, out_features={}, bias={}, {}".format(
+            self.in_features,
+            self.out_features,
+            self.bias is not None,
+            super()._module_info_string(),
+        )
+
+
+class VocabParallelEmbedding(_TensorParallel):
+    r"""An embedding whose table is split along the vocabulary across a
+    tensor-parallel group, so that rank :math:`i` keeps the embeddings of the
+    :math:`i`-th range of the indices.
+
+    Each rank looks up the indices in its own range, and the embeddings are
+    all-reduced across the group, or reduce-scattered along the first axis with
+    ``sequence_parallel``.
+
+    Args:
+        num_embeddings: size of the vocabulary, which must be divisible by the
+            size of the group.
+        embedding_dim: size of each embedding vector.
+        group: the tensor-parallel group. Default: WORLD
+        sequence_parallel: whether to split the output along the first axis.
+            Default: False
+    """
+
+    def __init__(
+        self,
+        num_embeddings: int,
+        embedding_dim: int,
+        group: Optional[Group] = WORLD,
+        sequence_parallel: bool = False,
+        **kwargs
+    ):
+        super().__init__(group, sequence_parallel, 1, None, **kwargs)
+        self.num_embeddings = num_embeddings
+        self.embedding_dim = embedding_dim
+        local_num = self._shard_size(num_embeddings, "num_embeddings")
+        self.vocab_start = self.rank * local_num
+        self.vocab_end = self.vocab_start + local_num
+        self.weight = Parameter(np.zeros((local_num, embedding_dim), dtype=np.float32))
+        self.reset_parameters()
+
+    def reset_parameters(self) -> None:
+        init.normal_(self.weight)
+
+    def forward(self, inputs):
+        if self.group is None:
+            return embedding(inputs, self.weight)
+        # the indices out of the range of this rank look up 0 and are masked out
+        keep = (inputs >= self.vocab_start) & (inputs < self.vocab_end)
+        local = where(keep, inputs - self.vocab_start, zeros_like(inputs))
+        out = embedding(local, self.weight)
+        out = out * expand_dims(keep.astype(out.dtype), -1)
+        if self.sequence_parallel:
+            return _ReduceScatterSequence(self.group, None)(out)
+        return _ReduceFromGroup(self.group, None)(out)
+
+    def _module_info_string(self) -> str:
+        return "num_embeddings={}, embedding_dim={}, {}".format(
+            self.num_embeddings, self.embedding_dim, super()._module_info_string()
+        )
+
+
+class ParallelSelfAttention(Module):
+    r"""Multi-head self-attention whose heads are split across a tensor-parallel
+    group.
+
+    The projection of the query, key and value is a :class:`ColumnParallelLinear`
+    so that each rank computes the attention of its own heads, and the output
+    projection is a :class:`RowParallelLinear`. So the attention needs one
+    all-reduce in the forward and one in the backward, or an all-gather and a
+    reduce-scatter with ``sequence_parallel``.
+
+    Args:
+        embed_dim: total dimension of the model.
+        num_heads: number of heads, which must be divisible by the size of the
+            group.
+        bias: whether to learn the biases of the projections. Default: True
+        group: the tensor-parallel group. Default: WORLD
+        sequence_parallel: whether the input and output are split along the first
+            axis. Default: False
+        num_chunks: the number of chunks to pipeline the communication with the
+            projections. Default: 1
+        comm_stream: the stream to run the communication on. Default: None, which
+            uses the default stream.
+
+    Shape:
+        - x: :math:`(L, N, E)`, where the sequence comes first so that it can be
+          split with ``sequence_parallel``.
+        - attn_mask: added to the attention scores, and broadcastable to
+          :math:`(N, H, L, L)`.
+        - output: :math:`(L, N, E)`.
+    """
+
+    def __init__(
+        self,
+        embed_dim: int,
+        num_heads: int,
+        bias: bool = True,
+        group: Optional[Group] = WORLD,
+        sequence_parallel: bool = False,
+        num_chunks: int = 1,
+        comm_stream: Optional[int] = None,
+        **kwargs
+    ):
+        super().__init__(**kwargs)
+        assert embed_dim % num_heads == 0, "embed_dim must be divisible by num_heads"
+        self.embed_dim = embed_dim
+        self.num_heads = num_heads
+        self.head_dim = embed_dim // num_heads
+        self.qkv_proj = ColumnParallelLinear(
+            embed_dim,
+            3 * embed_dim,
+            bias,
+            group,
+            sequence_parallel=sequence_parallel,
+            num_chunks=num_chunks,
+            comm_stream=comm_stream,
+        )
+        self.out_proj = RowParallelLinear(
+            embed_dim,
+            embed_dim,
+            bias,
+            group,
+            sequence_parallel=sequence_parallel,
+            num_chunks=num_chunks,
+            comm_stream=comm_stream,
+        )
+        self.local_heads = self.qkv_proj._shard_size(num_heads, "num_heads")
+
+    def forward(self, x, attn_mask: Optional[Tensor] = None):
+        qkv = self.qkv_proj(x)
+        seq_len, batch = qkv._tuple_shape[:2]
+        # (L, N, H, 3, D) -> (3, N, H, L, D), the features of each head are
+        # contiguous in the local output features
+        qkv = qkv.reshape(seq_len, batch, self.local_heads, 3, self.head_dim)
+        qkv = qkv.transpose(3, 1, 2, 0, 4)
+        q, k, v = qkv[0], qkv[1], qkv[2]
+        scores = matmul(q, k, transpose_b=True) / np.sqrt(self.head_dim)
+        if attn_mask is not None:
+            scores = scores + attn_mask
+        out = matmul(softmax(scores, axis=-1), v)
+        out = out.transpose(2, 0, 1, 3).reshape(
+            seq_len, batch, self.local_heads * self.head_dim
+        )
+        return self.out_proj(out)
+
+    def _module_info_string(self) -> str:
+        return "embed_dim={}, num_heads={}".format(self.embed_dim, self.num_heads)
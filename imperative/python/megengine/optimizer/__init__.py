@@ -9,3 +9,4 @@ from .lr_scheduler import LRScheduler
 from .multi_step_lr import MultiStepLR
 from .optimizer import Optimizer
 from .sgd import SGD
+from .sharded import ShardedOptimizer
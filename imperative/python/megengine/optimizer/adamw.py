@@ -2,6 +2,7 @@
 import os
 from typing import Iterable, Tuple, Union
 
+from ..core.ops.builtin import FusedOptimizerUpdate
 from ..functional.inplace import _inplace_add_
 from ..jit.tracing import is_tracing
 from ..tensor import Parameter, tensor
@@ -21,6 +22,8 @@ class AdamW(Optimizer):
             and its square. Default: (0.9, 0.999).
         eps (float, optional): Term added to the denominator to improve numerical stability. Default: 1e-8.
         weight_decay (float, optional): Weight decay (L2 penalty). Default: 1e-2.
+        fused (bool): Updates all the parameters of a group with one fused operator.
+            Default: False.
     
     Returns:
         An instance of the AdamW optimizer.
@@ -33,6 +36,7 @@ class AdamW(Optimizer):
         betas: Tuple[float, float] = (0.9, 0.999),
         eps: float = 1e-8,
         weight_decay: float = 1e-2,
+        fused: bool = False,
     ):
         if lr < 0.0:
             raise ValueError("Invalid learning rate: {}".format(lr))
@@ -45,6 +49,7 @@ class AdamW(Optimizer):
 
         defaults = dict(lr=lr, weight_decay=weight_decay, betas=betas, eps=eps)
         super().__init__(params, defaults)
+        self.fused = fused
         self._disable_type_convert = True
 
     def _create_state(self, param_group):
@@ -59,6 +64,21 @@ class AdamW(Optimizer):
         eps = param_group["eps"]
         beta0, beta1 = param_group["betas"]
 
+        if self.fused:
+            params = [p for p in param_group["params"] if p.grad is not None]
+            if params:
+                op = FusedOptimizerUpdate(
+                    mode=FusedOptimizerUpdate.Mode.ADAMW,
+                    lr=lr,
+                    weight_decay=weight_decay,
+                    beta_1=beta0,
+                    beta_2=beta1,
+                    eps=eps,
+                    step=self._fused_step(params),
+                )
+                self._fused_updates(params, op, ("exp_avg", "exp_avg_sq"))
+            return
+
         def make_scalar(val):
             return tensor(val, dtype="float32")
 
@@ -10,7 +10,10 @@ __all__ = ["clip_grad_norm", "clip_grad_value"]
 
 
 def clip_grad_norm(
-    tensors: Union[Tensor, Iterable[Tensor]], max_norm: float, ord: float = 2.0,
+    tensors: Union[Tensor, Iterable[Tensor]],
+    max_norm: float,
+    ord: float = 2.0,
+    total_norm: Tensor = None,
 ):
     r"""Clips gradient norm of an iterable of parameters.
     The norm is computed over all gradients together, as if they were
@@ -20,6 +23,9 @@ def clip_grad_norm(
         tensors: an iterable of Tensors or a single Tensor that will have gradients normalized.
         max_norm: max norm of the gradients.
         ord: type of the used p-norm. Can be ``'inf'`` for infinity norm. Default: 2.0
+        total_norm: the precomputed norm of the gradients, e.g. by
+            :meth:`~.distributed.helper.AllreduceCallback.grad_norm`, so that the
+            gradients are only read once for clipping. Default: None
 
     Returns:
         Return type: Tensor of an iterable of Tensors. Total norm of the parameter gradients (viewed as a single vector).
@@ -36,11 +42,14 @@ def clip_grad_norm(
     if len(tensors) == 0:
         pop_scope("clip_grad_norm")
         return Tensor(0.0)
-    norm_ = [norm(t.grad.flatten(), ord=ord) for t in tensors]
-    if len(norm_) > 1:
-        norm_ = norm(concat(norm_), ord=ord)
+    if total_norm is not None:
+        norm_ = total_norm
     else:
-        norm_ = norm_[0]
+        norm_ = [norm(t.grad.flatten(), ord=ord) for t in tensors]
+        if len(norm_) > 1:
+            norm_ = norm(concat(norm_), ord=ord)
+        else:
+            norm_ = norm_[0]
     scale = max_norm / (norm_ + 1e-6)
     scale = minimum(scale, 1)
     for tensor in tensors:
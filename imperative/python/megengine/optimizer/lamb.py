@@ -9,7 +9,7 @@ import os
 from typing import Iterable, Tuple, Union
 
 from megengine.core._imperative_rt.core2 import apply
-from megengine.core.ops.builtin import LAMBUpdate
+from megengine.core.ops.builtin import FusedOptimizerUpdate, LAMBUpdate
 
 from .. import Parameter, tensor
 from ..functional import sum
@@ -32,6 +32,8 @@ class LAMB(Optimizer):
         bias_correction: enables bias correction by ``1 - beta ** step``. Default: ``True``
         weight_decay: weight decay (L2 penalty). Default: ``0.0``
         always_adapt: apply adaptive lr to ``0.0`` weight decay parameter. Default: ``False``
+        fused: update all the parameters of a group with one fused operator, where the
+            trust ratio is still computed for each parameter. Default: ``False``
     """
 
     def __init__(
@@ -43,6 +45,7 @@ class LAMB(Optimizer):
         bias_correction: bool = True,
         weight_decay: float = 0.0,
         always_adapt: bool = False,
+        fused: bool = False,
     ):
         if lr < 0.0:
             raise ValueError("Invalid learning rate: {}".format(lr))
@@ -57,6 +60,7 @@ class LAMB(Optimizer):
         super().__init__(params, defaults)
         self.bias_correction = bias_correction
         self.always_adapt = always_adapt
+        self.fused = fused
         self._disable_type_convert = True
 
     def _create_state(self, param_group):
@@ -71,6 +75,23 @@ class LAMB(Optimizer):
         eps = param_group["eps"]
         beta0, beta1 = param_group["betas"]
 
+        if self.fused:
+            params = [p for p in param_group["params"] if p.grad is not None]
+            if params:
+                op = FusedOptimizerUpdate(
+                    mode=FusedOptimizerUpdate.Mode.LAMB,
+                    lr=lr,
+                    weight_decay=weight_decay,
+                    beta_1=beta0,
+                    beta_2=beta1,
+                    eps=eps,
+                    step=self._fused_step(params),
+                    bias_correction=self.bias_correction,
+                    always_adapt=self.always_adapt,
+                )
+                self._fused_updates(params, op, ("exp_avg", "exp_avg_sq"))
+            return
+
         # since `conver_inputs` is disabled for param updates,
         # scalar should be explicitly tansforred to tensor
         c1 = tensor(1.0)
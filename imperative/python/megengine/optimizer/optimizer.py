@@ -10,12 +10,14 @@ import numpy as np
 
 from ..core import _config
 from ..core._imperative_rt.core2 import (
+    apply,
     get_auto_format_convert,
     pop_scope,
     push_scope,
     set_auto_format_convert,
     set_option,
 )
+from ..core.ops.builtin import ParamPackConcat, ParamPackSplit
 from ..core.tensor.utils import set_convert_inputs
 from ..tensor import Parameter, Tensor
 from ..utils.deprecation import deprecated
@@ -42,6 +44,7 @@ class Optimizer(metaclass=ABCMeta):
     ):
         self._state = dict()
         self._defaults = defaults
+        self._fused_offsets = dict()
         self._disable_type_convert = False
 
         if isinstance(params, (Parameter, dict)):
@@ -136,6 +139,70 @@ class Optimizer(metaclass=ABCMeta):
     def _updates(self, param_group):
         pass
 
+    def _fused_step(self, params):
+        r"""Increases the step shared by ``params`` and returns its value.
+
+        The fused update keeps one step for all the parameters, so only the step
+        of the first parameter is increased and the others are reset to it.
+        """
+        steps = [self._state[param]["step"] for param in params]
+        steps[0] += Tensor(1.0)
+        for step in steps[1:]:
+            step._reset(steps[0])
+        return float(steps[0].item())
+
+    def _fused_updates(self, params, op, state_names=()):
+        r"""Updates ``params`` and their states named by ``state_names`` with one
+        fused ``op`` of :class:`~.FusedOptimizerUpdate`.
+
+        The parameters, gradients and states are packed into flat buffers in the
+        same way as ``ParamPackConcat``, and the parameters and states are reset to
+        the views of the updated buffers.
+        """
+        for param in params:
+            assert (
+                param.dtype == np.float32
+            ), "fused update only supports float32 parameters"
+        shapes = [param.shape for param in params]
+        key = tuple(map(id, params))
+        if key not in self._fused_offsets:
+            offsets_val = []
+            offset = 0
+            for shape in shapes:
+                offsets_val.append(offset)
+                offset += int(np.prod(shape))
+                offsets_val.append(offset)
+            self._fused_offsets[key] = (
+                offsets_val,
+                Tensor(offsets_val, dtype="int32", device=params[0].device),
+            )
+        offsets_val, offsets = self._fused_offsets[key]
+
+        concat = ParamPackConcat()
+        concat.offsets = offsets_val
+        split = ParamPackSplit()
+        split.offsets = offsets_val
+        split.shapes = [shape or (1,) for shape in shapes]
+
+        def pack(tensors):
+            return apply(concat, *tensors, offsets)[0]
+
+        def unpack(flat, tensors):
+            for tensor, value in zip(tensors, apply(split, flat)):
+                tensor._reset(value.reshape(tensor.shape))
+
+        grad = pack([param.grad for param in params])
+        states = [
+            [self._state[param][name] for param in params] for name in state_names
+        ]
+        flat_states = [pack(state) for state in states]
+        # the states not used by the mode only hold the place of inputs
+        flat_states += [grad] * (2 - len(flat_states))
+        outputs = apply(op, pack(params), grad, *flat_states, offsets)
+        unpack(outputs[0], params)
+        for flat, state in zip(outputs[1:], states):
+            unpack(flat, state)
+
     def _get_params(self):
         params = []
         for group in self.param_groups:
@@ -3,6 +3,7 @@ import os
 from typing import Iterable, Union
 
 from ..core import _config
+from ..core.ops.builtin import FusedOptimizerUpdate
 from ..functional import transpose
 from ..functional.inplace import _inplace_add_
 from ..jit.tracing import is_tracing
@@ -25,6 +26,8 @@ class SGD(Optimizer):
         momentum (float): Momentum factor. Default: 0.0.
         nesterov (bool): Enables Nesterov momentum. Default: False.
         weight_decay (float): Weight decay (L2 penalty). Default: 0.0.
+        fused (bool): Updates all the parameters of a group with one fused operator.
+            Default: False.
     
     Returns:
         An instance of the SGD optimizer.
@@ -41,6 +44,7 @@ class SGD(Optimizer):
         momentum: float = 0.0,
         nesterov: bool = False,
         weight_decay: float = 0.0,
+        fused: bool = False,
     ):
         assert lr >= 0.0, "Invalid learning rate: {}".format(lr)
         assert momentum >= 0.0, "Invalid momentum value: {}".format(momentum)
@@ -52,6 +56,7 @@ class SGD(Optimizer):
         defaults = dict(lr=lr, momentum=momentum, weight_decay=weight_decay)
         super().__init__(params, defaults)
         self.nesterov = nesterov
+        self.fused = fused
         self._disable_type_convert = True
 
     def _create_state(self, param_group):
@@ -64,6 +69,20 @@ class SGD(Optimizer):
         weight_decay = param_group["weight_decay"]
         momentum = param_group["momentum"]
 
+        if self.fused:
+            params = [p for p in param_group["params"] if p.grad is not None]
+            if params:
+                op = FusedOptimizerUpdate(
+                    mode=FusedOptimizerUpdate.Mode.SGD,
+                    lr=lr,
+                    weight_decay=weight_decay,
+                    momentum=momentum,
+                    nesterov=self.nesterov,
+                )
+                states = ("momentum_buffer",) if momentum != 0.0 else ()
+                self._fused_updates(params, op, states)
+            return
+
         # since `conver_inputs` is disabled for param updates,
         # scalar should be explicitly tansforred to tensor
 
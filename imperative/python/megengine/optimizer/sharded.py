@@ -0,0 +1,169 @@
+# -*- coding: utf-8 -*-
+from typing import Iterable, Type
+
+import numpy as np
+
+from ..distributed.functional import all_gather, all_reduce_sum, reduce_scatter_sum
+from ..distributed.group import WORLD, Group, is_distributed
+from ..distributed.helper import get_offsets, param_pack_concat, param_pack_split
+from ..functional import concat, zeros
+from ..tensor import Parameter, Tensor
+from .optimizer import Optimizer
+
+
+class ShardedOptimizer:
+    r"""Partitions the states of an optimizer across the ranks of a data-parallel
+    group, as stage 1 and 2 of `ZeRO <https://arxiv.org/abs/1910.02054>`_.
+
+    The parameters are flattened into one buffer, which is evenly split into
+    ``group.size`` shards. Each rank keeps the states of the inner optimizer only
+    for its own shard, so the memory of the states drops linearly with the size of
+    the group. In :meth:`step`, the gradients are reduced across the group, the
+    rank updates its shard, and the updated shards are gathered back into the
+    parameters with ``ALL_GATHER``.
+
+    Args:
+        optimizer_cls: the class of the inner optimizer, e.g. :class:`~.Adam`.
+        params: the parameters to optimize, which must be float32 and are
+            replicated on every rank.
+        group: the data-parallel group. Default: WORLD.
+        stage: 1 to all-reduce the gradients, which are kept in ``param.grad``
+            after :meth:`step`; 2 to reduce-scatter the gradients so that only the
+            shard of the gradients is reduced, and the gradients of the parameters
+            are released in :meth:`step`. Default: 2.
+        reduce_method: "sum" or "mean" to reduce the gradients. Default: "mean".
+        kwargs: the arguments of ``optimizer_cls``.
+
+    Note:
+        The gradients should not be reduced again by the callbacks of
+        :class:`~.GradManager`, e.g. :func:`~.distributed.make_allreduce_cb`.
+
+    Examples:
+
+        .. code-block:: python
+
+            opt = ShardedOptimizer(Adam, model.parameters(), lr=1e-3)
+            gm = GradManager().attach(model.parameters())
+            with gm:
+                loss = model(data)
+                gm.backward(loss)
+            opt.step().clear_grad()
+    """
+
+    def __init__(
+        self,
+        optimizer_cls: Type[Optimizer],
+        params: Iterable[Parameter],
+        group: Group = WORLD,
+        stage: int = 2,
+        reduce_method: str = "mean",
+        **kwargs
+    ):
+        assert stage in (1, 2), "only stage 1 and 2 are supported, got {}".format(
+            stage
+        )
+        reduce_method = reduce_method.lower()
+        assert reduce_method in ["sum", "mean"], "reduce_method should be sum or mean"
+        self._params = list(params)
+        assert len(self._params) > 0, "optimizer got an empty parameter list"
+        for param in self._params:
+            assert isinstance(
+                param, Parameter
+            ), "ShardedOptimizer can only optimize Parameters"
+            assert (
+                param.dtype == np.float32
+            ), "ShardedOptimizer only supports float32 parameters"
+        self._group = group
+        self._stage = stage
+        self._reduce_method = reduce_method
+        if is_distributed():
+            self._world_size, self._rank = group.size, group.rank
+        else:
+            self._world_size, self._rank = 1, 0
+
+        self._shapes = [param._tuple_shape for param in self._params]
+        self._offsets_val = get_offsets(self._shapes)
+        self._offsets = Tensor(
+            self._offsets_val, dtype="int32", device=self._params[0].device
+        )
+        total = self._offsets_val[-1]
+        self._shard_size = -(-total // self._world_size)
+        self._padding = self._shard_size * self._world_size - total
+
+        begin = self._rank * self._shard_size
+        shard = self._flatten(self._params)[begin : begin + self._shard_size]
+        self._shard = Parameter(shard)
+        self.optimizer = optimizer_cls([self._shard], **kwargs)
+
+    @property
+    def param_groups(self):
+        r"""The param groups of the inner optimizer, which hold the shard of this
+        rank, e.g. to be adjusted by the lr schedulers.
+        """
+        return self.optimizer.param_groups
+
+    def _flatten(self, tensors):
+        flat = param_pack_concat(tensors, self._offsets, self._offsets_val)
+        if self._padding:
+            flat = concat([flat, zeros(self._padding, device=flat.device)])
+        return flat
+
+    def _reduce_grad(self):
+        grads = [
+            param.grad if param.grad is not None else zeros(shape, device=param.device)
+            for param, shape in zip(self._params, self._shapes)
+        ]
+        flat = self._flatten(grads)
+        if self._world_size == 1:
+            return flat
+        if self._stage == 1:
+            flat = all_reduce_sum(flat, self._group)
+            if self._reduce_method == "mean":
+                flat /= self._world_size
+            for param, grad in zip(
+                self._params, param_pack_split(flat, self._offsets_val, self._shapes)
+            ):
+                if param.grad is not None:
+                    param.grad = grad.reshape(param._tuple_shape)
+            begin = self._rank * self._shard_size
+            return flat[begin : begin + self._shard_size]
+        grad = reduce_scatter_sum(flat, self._group)
+        if self._reduce_method == "mean":
+            grad /= self._world_size
+        return grad
+
+    def step(self):
+        r"""Reduces the gradients, updates the shard of this rank and gathers the
+        updated parameters.
+        """
+        self._shard.grad = self._reduce_grad()
+        if self._stage >= 2:
+            for param in self._params:
+                param.grad = None
+        self.optimizer.step()
+        self._shard.grad = None
+
+        flat = self._shard
+        if self._world_size > 1:
+            flat = all_gather(flat, self._group)
+        for param, value in zip(
+            self._params, param_pack_split(flat, self._offsets_val, self._shapes)
+        ):
+            param._reset(value.reshape(param._tuple_shape))
+        return self
+
+    def clear_grad(self):
+        r"""Set the grad attribute to None for all parameters."""
+        for param in self._params:
+            param.grad = None
+        self._shard.grad = None
+
+    def state_dict(self, keep_var=False):
+        r"""Exports the states of the shard of this rank, which can only be loaded
+        by the same rank of a group of the same size.
+        """
+        return self.optimizer.state_dict(keep_var)
+
+    def load_state_dict(self, state: dict):
+        r"""Loads the states exported by :meth:`state_dict`."""
+        self.optimizer.load_state_dict(state)
@@ -6,6 +6,7 @@ from .observer import (
     Observer,
     PassiveObserver,
     SyncExponentialMovingAverageObserver,
+    SyncHistogramObserver,
     SyncMinMaxObserver,
 )
 from .qconfig import (
@@ -16,6 +17,7 @@ from .qconfig import (
     ema_lowbit_fakequant_qconfig,
     min_max_fakequant_qconfig,
     passive_qconfig,
+    sync_calibration_qconfig,
     sync_ema_fakequant_qconfig,
     tqt_qconfig,
 )
@@ -6,9 +6,11 @@ from typing import Union
 import numpy as np
 
 from .. import functional as F
+from ..core._imperative_rt.core2 import apply
+from ..core.ops import builtin
 from ..core.tensor.dtype import QuantDtypeMeta, _builtin_quant_dtypes
 from ..distributed import WORLD, get_rank, is_distributed
-from ..functional.distributed import all_reduce_max, all_reduce_min
+from ..functional.distributed import all_reduce_max, all_reduce_min, all_reduce_sum
 from ..logger import get_logger
 from ..module import Module
 from ..tensor import Tensor
@@ -17,6 +19,20 @@ from .utils import QParams, QParamsModuleMixin, QuantMode, create_qparams
 logger = get_logger(__name__)
 
 
+def _histogram(x, bins, min_val, max_val):
+    # the same as np.histogram(x, bins, (min_val, max_val)) but computed on the
+    # device of x, where all the elements of x are in [min_val, max_val]
+    if min_val == max_val:
+        min_val, max_val = min_val - 0.5, max_val + 0.5
+    x = x.astype("float32").flatten()
+    idx = F.floor((x - min_val) * (bins / (max_val - min_val))).astype("int32")
+    idx = F.clip(idx, 0, bins - 1)
+    out = F.zeros((bins,), dtype="float32", device=x.device)
+    # the elements falling into the same bin are summed
+    op = builtin.IndexingIncrMultiAxisVec(items=[(0, False, False, False, True)])
+    return apply(op, out, F.ones_like(x), idx)[0]
+
+
 class Observer(Module, QParamsModuleMixin):
     r"""A base class for Observer Module. Used to record input tensor's statistics for
     quantization.
@@ -435,15 +451,23 @@ class HistogramObserver(MinMaxObserver):
 
         return combined_min, combined_max, downsample_rate, start_idx
 
+    def _reduce_min_max(self, x):
+        return x.min(), x.max()
+
+    def _reduce_histogram(self, histogram):
+        return histogram
+
     def sideeffect_forward(self, x_orig):
-        x = x_orig.numpy()
+        # the histogram of x is computed on device, and only its min and max are
+        # copied to host, which is much cheaper than copying x itself
+        x = x_orig.detach()
+        new_min, new_max = F.stack(self._reduce_min_max(x)).astype("float32").numpy()
         min_val = self.min_val.numpy()
         max_val = self.max_val.numpy()
-        histogram = self.histogram.numpy()
-        new_min = x.min()
-        new_max = x.max()
-        if histogram[0] == -1:
-            new_histogram, _ = np.histogram(x, self.bins, (new_min, new_max))
+        if min_val > max_val:
+            # the first batch
+            new_histogram = _histogram(x, self.bins, new_min, new_max)
+            new_histogram = self._reduce_histogram(new_histogram)
         else:
             new_min = min(new_min, min_val)
             new_max = max(new_max, max_val)
@@ -454,29 +478,57 @@ class HistogramObserver(MinMaxObserver):
                 new_min, new_max, self.upsample_rate
             )
 
-            new_histogram, _ = np.histogram(x, self.bins, (new_min, new_max))
-            new_histogram = new_histogram.astype(np.float64)
+            new_histogram = _histogram(x, self.bins, new_min, new_max)
+            new_histogram = self._reduce_histogram(new_histogram)
             if new_min == min_val and new_max == max_val:
-                new_histogram += histogram
+                new_histogram += self.histogram
             else:
+                # only the histograms of self.bins elements are copied to host
                 new_histogram = self._combine_histograms(
-                    new_histogram,
-                    histogram,
+                    new_histogram.numpy().astype(np.float64),
+                    self.histogram.numpy(),
                     self.upsample_rate,
                     downsample_rate,
                     start_idx,
                     self.bins,
                 )
+                new_histogram = Tensor(new_histogram, dtype="float32")
 
-        self.histogram = Tensor(new_histogram, dtype="float32")
+        self.histogram = new_histogram
         self.min_val = Tensor(new_min, dtype="float32")
         self.max_val = Tensor(new_max, dtype="float32")
 
     def forward(self, x_orig):
-        self.sideeffect_forward(x_orig)
+        if self.enabled:
+            self.sideeffect_forward(x_orig)
         return x_orig
 
 
+class SyncHistogramObserver(HistogramObserver):
+    r"""A distributed version of :class:`~.HistogramObserver`, which merges the
+    histograms of all the ranks so that the calibration data can be split across
+    the ranks.
+
+    Args:
+        bins: number of bins to use for the histogram.
+        upsample_rate: which ratio to interpolate histograms in.
+        mode: set quantization mode.
+        eps: a initial maximum value to avoid division by zero problem.
+        dtype: a string indicating which dtype to collect scale and zero_point of.
+    """
+
+    def _reduce_min_max(self, x):
+        # all the ranks use the same range, so that their histograms can be summed
+        if is_distributed():
+            return all_reduce_min(x.min(), WORLD), all_reduce_max(x.max(), WORLD)
+        return x.min(), x.max()
+
+    def _reduce_histogram(self, histogram):
+        if is_distributed():
+            return all_reduce_sum(histogram, WORLD)
+        return histogram
+
+
 class PassiveObserver(Observer):
     r"""An Observer that supports setting :attr:`scale` directly."""
 
@@ -9,6 +9,7 @@ from .observer import (
     MinMaxObserver,
     PassiveObserver,
     SyncExponentialMovingAverageObserver,
+    SyncHistogramObserver,
     SyncMinMaxObserver,
 )
 
@@ -101,6 +102,13 @@ calibration_qconfig = QConfig(
     act_fake_quant=None,
 )
 
+sync_calibration_qconfig = QConfig(
+    weight_observer=partial(MinMaxObserver, dtype="qint8_narrow"),
+    act_observer=partial(SyncHistogramObserver, dtype="qint8"),
+    weight_fake_quant=None,
+    act_fake_quant=None,
+)
+
 tqt_qconfig = QConfig(
     weight_observer=None,
     act_observer=None,
@@ -8,6 +8,7 @@ from .rng import (
     normal,
     permutation,
     poisson,
+    sample_logits,
     seed,
     shuffle,
     uniform,
@@ -25,6 +26,7 @@ __all__ = [
     "shuffle",
     "exponential",
     "multinomial",
+    "sample_logits",
 ]
 # pylint: disable=undefined-variable
 del rng  # type: ignore[name-defined]
@@ -20,6 +20,7 @@ from ..core.ops.builtin import (
     ExponentialRNG,
     GammaRNG,
     GaussianRNG,
+    LogitsSamplingRNG,
     MultinomialRNG,
     PermutationRNG,
     PoissonRNG,
@@ -38,6 +39,7 @@ __all__ = [
     "beta",
     "poisson",
     "multinomial",
+    "sample_logits",
     "permutation",
     "shuffle",
     "exponential",
@@ -246,6 +248,44 @@ def _multinomial(
     return output
 
 
+def _sample_logits(
+    logits: Tensor,
+    temperature: float,
+    top_k: int,
+    top_p: float,
+    seed: int,
+    handle: int,
+) -> Tensor:
+    handle_cn = None if handle == 0 else _get_rng_handle_compnode(handle)
+    assert (
+        logits.ndim == 1 or logits.ndim == 2
+    ), "sample_logits is not defined when ndim of logits is not 1 or 2"
+    assert logits.shape[-1] != 0, "sample_logits is not defined for empty logits"
+    assert temperature > 0, "sample_logits is not defined when temperature <= 0"
+    assert top_k >= 0, "sample_logits is not defined when top_k < 0"
+    assert 0 < top_p <= 1, "sample_logits is not defined when top_p is not in (0, 1]"
+    assert (
+        handle_cn is None or handle_cn == logits.device
+    ), "The logits ({}) must be the same device with handle ({})".format(
+        logits.device, handle_cn
+    )
+
+    require_one_dim = logits.ndim == 1
+    if require_one_dim:
+        logits = logits.reshape((1, logits.size))
+    op = LogitsSamplingRNG(
+        seed=seed,
+        top_k=top_k,
+        top_p=top_p,
+        temperature=temperature,
+        handle=handle,
+    )
+    (output,) = apply(op, logits)
+    if require_one_dim:
+        output = output.reshape(())
+    return output
+
+
 def _permutation(n: int, seed: int, device: str, handle: int, dtype: str) -> Tensor:
     assert isinstance(n, int)
     assert n >= 0, "Permutation is not defined when n < 0"
@@ -591,6 +631,54 @@ class RNG:
             handle=self._handle,
         )
 
+    def sample_logits(
+        self,
+        logits: Tensor,
+        temperature: float = 1.0,
+        top_k: int = 0,
+        top_p: float = 1.0,
+    ):
+        r"""Draw one token from each row of logits, as in the decoding of language
+        models.
+
+        The logits are divided by ``temperature``, only the ``top_k`` largest logits
+        are kept, and of these only the most probable tokens whose total probability
+        reaches ``top_p`` are kept. A token is then drawn from the softmax of the
+        kept logits. The filtering, the softmax and the sampling are done by a
+        single kernel without copying the logits to host.
+
+        Args:
+            logits: the logits of shape `(vocab,)` or `(batch, vocab)`.
+            temperature: the logits are divided by it. Must be positive. Default: 1.0
+            top_k: number of the largest logits to keep, 0 means all of them.
+                Default: 0
+            top_p: the probability kept by nucleus sampling, 1.0 means no
+                filtering. Default: 1.0
+
+        Returns:
+            the sampled indices in int32, of shape `()` or `(batch,)`.
+
+        Examples:
+            >>> import megengine.random as rand
+            >>> logits = mge.Tensor([[1, 2, 3, 4],
+            ...                      [4, 3, 2, 1]], dtype="float32")
+            >>> x = rand.sample_logits(logits, top_k=1)
+            >>> x.numpy()
+            array([3, 0], dtype=int32)
+            >>> x = rand.sample_logits(logits, temperature=0.7, top_p=0.9)
+            >>> x.numpy()   # doctest: +SKIP
+            array([3, 1], dtype=int32)
+        """
+        _seed = self._seed() if callable(self._seed) else self._seed
+        return _sample_logits(
+            logits=logits,
+            temperature=temperature,
+            top_k=top_k,
+            top_p=top_p,
+            seed=_seed,
+            handle=self._handle,
+        )
+
     def permutation(self, n: Union[int, Tensor], *, dtype: str = "int32"):
         r"""Randomly permute a sequence, or return a permuted range.
             If ``n`` is a multi-dimensional tensor, it is only shuffled along its first index.
@@ -722,6 +810,7 @@ gamma = _default_handle.gamma
 beta = _default_handle.beta
 poisson = _default_handle.poisson
 multinomial = _default_handle.multinomial
+sample_logits = _default_handle.sample_logits
 permutation = _default_handle.permutation
 shuffle = _default_handle.shuffle
 exponential = _default_handle.exponential
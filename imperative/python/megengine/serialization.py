@@ -1,8 +1,14 @@
 # -*- coding: utf-8 -*-
+import io
+import os
 import pickle
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
 
 from .device import _valid_device, get_default_device
-from .tensor import Tensor
+from .tensor import Parameter, Tensor
 from .utils.max_recursion_limit import max_recursion_limit
 
 
@@ -185,3 +191,251 @@ def load(f, map_location=None, pickle_module=pickle):
 
     with dmap(map_location) as dm:
         return pickle_module.load(f)
+
+
+_CHECKPOINT_META = "meta.pkl"
+_CHECKPOINT_ALIGNMENT = 64
+
+
+def _checkpoint_shard_name(idx):
+    return "data.{}".format(idx)
+
+
+class _CheckpointPickler:
+    r"""Pickles an object with the values of its tensors and arrays taken out
+    as records, which are written to the data shards of a checkpoint."""
+
+    def __init__(self, pickle_module, pickle_protocol):
+        self.records = []
+        self.pickle_module = pickle_module
+        self.pickle_protocol = pickle_protocol
+
+    def _add_record(self, value):
+        if not value.flags.c_contiguous:
+            value = np.ascontiguousarray(value)
+        self.records.append(value)
+        return len(self.records) - 1
+
+    def persistent_id(self, obj):
+        if type(obj) in (Tensor, Parameter):
+            value = obj.numpy()
+            # the host value may be shared with the tensor, which may be
+            # updated inplace by the following steps
+            if not value.flags.owndata:
+                value = value.copy()
+            return (
+                "tensor",
+                self._add_record(value),
+                type(obj),
+                obj.dtype,
+                obj.device.logical_name,
+                obj._qparams,
+            )
+        if type(obj) is np.ndarray and not obj.dtype.hasobject:
+            return ("ndarray", self._add_record(obj.copy()))
+        return None
+
+    def dumps(self, obj):
+        f = io.BytesIO()
+        pickler = self.pickle_module.Pickler(f, self.pickle_protocol)
+        pickler.persistent_id = self.persistent_id
+        with max_recursion_limit():
+            pickler.dump(obj)
+        return f.getvalue()
+
+
+class CheckpointWriter:
+    r"""The handle of a checkpoint being written by :func:`save_checkpoint`."""
+
+    def __init__(self, path, skeleton, records, num_shards, pickle_module):
+        self.path = path
+        self._skeleton = skeleton
+        self._records = records
+        self._num_shards = num_shards
+        self._pickle_module = pickle_module
+        self._error = None
+        self._thread = None
+
+    def _assign_shards(self):
+        # the largest values are assigned first to the least loaded shard
+        sizes = [0] * self._num_shards
+        shards = [[] for _ in range(self._num_shards)]
+        index = [None] * len(self._records)
+        order = sorted(
+            range(len(self._records)), key=lambda i: -self._records[i].nbytes
+        )
+        for i in order:
+            value = self._records[i]
+            shard = sizes.index(min(sizes))
+            offset = sizes[shard]
+            index[i] = (shard, offset, value.dtype.str, value.shape)
+            shards[shard].append(i)
+            align = _CHECKPOINT_ALIGNMENT
+            sizes[shard] += (value.nbytes + align - 1) // align * align
+        return index, shards
+
+    def _write_shard(self, idx, records, index):
+        with open(os.path.join(self.path, _checkpoint_shard_name(idx)), "wb") as f:
+            for i in records:
+                f.seek(index[i][1])
+                f.write(np.ravel(self._records[i]).view(np.uint8))
+                # release the snapshot as soon as it is written
+                self._records[i] = None
+            f.truncate()
+
+    def _write(self):
+        os.makedirs(self.path, exist_ok=True)
+        index, shards = self._assign_shards()
+        with ThreadPoolExecutor(self._num_shards) as executor:
+            futures = [
+                executor.submit(self._write_shard, i, shards[i], index)
+                for i in range(self._num_shards)
+            ]
+            for i in futures:
+                i.result()
+        # the checkpoint is complete once the meta file exists
+        meta = {
+            "version": 1,
+            "num_shards": self._num_shards,
+            "index": index,
+            "skeleton": self._skeleton,
+        }
+        tmp = os.path.join(self.path, _CHECKPOINT_META + ".tmp")
+        with open(tmp, "wb") as f:
+            self._pickle_module.dump(meta, f)
+        os.replace(tmp, os.path.join(self.path, _CHECKPOINT_META))
+
+    def _run(self):
+        try:
+            self._write()
+        except BaseException as exc:  # pylint: disable=broad-except
+            self._error = exc
+
+    def _start(self, async_write):
+        if async_write:
+            self._thread = threading.Thread(target=self._run, daemon=True)
+            self._thread.start()
+        else:
+            self._run()
+            self.wait()
+
+    def done(self):
+        r"""Returns whether the checkpoint has been written or failed."""
+        return self._thread is None or not self._thread.is_alive()
+
+    def wait(self):
+        r"""Waits until the checkpoint is written, and raises the error of the
+        writing if any."""
+        if self._thread is not None:
+            self._thread.join()
+        if self._error is not None:
+            raise self._error
+
+
+def save_checkpoint(
+    obj,
+    path,
+    num_shards=1,
+    async_write=True,
+    pickle_module=pickle,
+    pickle_protocol=pickle.DEFAULT_PROTOCOL,
+):
+    r"""Save an object to a checkpoint directory without blocking the training.
+
+    The values of the tensors and numpy arrays in ``obj`` are copied to host
+    memory when this function is called, and the rest of ``obj`` is pickled.
+    The values are then written to ``num_shards`` data files in parallel by a
+    background thread, so the following steps can run while the checkpoint is
+    being written. The checkpoint can be loaded by :func:`load_checkpoint`
+    once :meth:`CheckpointWriter.wait` returns.
+
+    Args:
+        obj: object to be saved, usually :attr:`.Module.state_dict` or
+            :attr:`.Optimizer.state_dict`.
+        path: the directory of the checkpoint, which is created if it does
+            not exist.
+        num_shards: number of data files written in parallel.
+        async_write: whether to write the files in a background thread.
+        pickle_module: the module to use for pickling.
+        pickle_protocol: the protocol to use for pickling.
+
+    Return:
+        a :class:`CheckpointWriter` to wait for the checkpoint.
+
+    Examples:
+
+        .. code-block:: python
+
+           import megengine as mge
+
+           writer = mge.serialization.save_checkpoint(model.state_dict(), "ckpt")
+           # ... run the following steps
+           writer.wait()
+           model.load_state_dict(mge.serialization.load_checkpoint("ckpt"))
+    """
+    assert num_shards >= 1, "invalid number of shards: {}".format(num_shards)
+    pickler = _CheckpointPickler(pickle_module, pickle_protocol)
+    skeleton = pickler.dumps(obj)
+    writer = CheckpointWriter(
+        path, skeleton, pickler.records, num_shards, pickle_module
+    )
+    writer._start(async_write)
+    return writer
+
+
+def load_checkpoint(path, map_location=None, mmap=True, pickle_module=pickle):
+    r"""Load an object saved with :func:`save_checkpoint` from a directory.
+
+    Args:
+        path: the directory of the checkpoint.
+        map_location: defines device mapping, see :func:`load`.
+        mmap: whether to map the data files into memory instead of reading
+            them, so the values are read on demand without an extra copy in
+            host memory; the numpy arrays loaded are copy-on-write views of
+            the files in this case.
+        pickle_module: the module to use for pickling.
+
+    Return:
+        the object saved.
+    """
+    with open(os.path.join(path, _CHECKPOINT_META), "rb") as f:
+        meta = pickle_module.load(f)
+    assert meta["version"] == 1, "unsupported checkpoint version: {}".format(
+        meta["version"]
+    )
+    index = meta["index"]
+    shards = {}
+
+    def get_shard(idx):
+        if idx not in shards:
+            fname = os.path.join(path, _checkpoint_shard_name(idx))
+            if mmap and os.path.getsize(fname) > 0:
+                shards[idx] = np.memmap(fname, dtype=np.uint8, mode="c")
+            else:
+                shards[idx] = np.fromfile(fname, dtype=np.uint8)
+        return shards[idx]
+
+    def get_value(idx):
+        shard, offset, dtype, shape = index[idx]
+        dtype = np.dtype(dtype)
+        count = int(np.prod(shape, dtype=np.int64))
+        if count == 0:
+            return np.empty(shape, dtype=dtype)
+        value = np.frombuffer(get_shard(shard), dtype, count, offset)
+        return value.reshape(shape)
+
+    map_location = _get_callable_map_location(map_location)
+
+    def persistent_load(pid):
+        if pid[0] == "ndarray":
+            return get_value(pid[1])
+        assert pid[0] == "tensor", "invalid checkpoint record: {}".format(pid[0])
+        _, idx, cls, dtype, device, qparams = pid
+        ret = cls(get_value(idx), dtype=dtype, device=map_location(device))
+        ret._qparams = qparams
+        return ret
+
+    unpickler = pickle_module.Unpickler(io.BytesIO(meta["skeleton"]))
+    unpickler.persistent_load = persistent_load
+    with max_recursion_limit():
+        return unpickler.load()
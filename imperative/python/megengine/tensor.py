@@ -7,7 +7,13 @@ import numpy as np
 from .core._imperative_rt import CompNode
 from .core._imperative_rt.core2 import FormatType
 from .core._imperative_rt.core2 import Tensor as _Tensor
-from .core._imperative_rt.core2 import _to_dlpack, apply, set_py_tensor_type
+from .core._imperative_rt.core2 import (
+    _cuda_array_interface,
+    _dlpack_device,
+    _to_dlpack,
+    apply,
+    set_py_tensor_type,
+)
 from .core._trace_option import use_symbolic_shape
 from .core._wrap import as_device
 from .core.ops.builtin import Borrow, Copy, GetVarShape
@@ -19,6 +25,32 @@ from .utils.deprecation import deprecated
 logger = get_logger(__name__)
 
 
+class TensorValueFuture:
+    r"""The value of a :class:`~.Tensor` being copied to the host, returned by
+    :meth:`~.Tensor.numpy_async`.
+    """
+
+    def __init__(self, tensor):
+        self._tensor = tensor
+        self._value = None
+        tensor._prefetch_value()
+
+    def done(self) -> bool:
+        r"""Returns whether :meth:`result` would not block."""
+        if self._value is not None:
+            return True
+        # None is returned for the tensors not evaluated by the interpreter, e.g.
+        # under symbolic tracing, which do not support prefetching
+        return bool(self._tensor._prefetch_value())
+
+    def result(self) -> np.ndarray:
+        r"""Waits for the copy and returns the value as a :class:`numpy.ndarray`."""
+        if self._value is None:
+            self._value = self._tensor.numpy()
+            self._tensor = None
+        return self._value
+
+
 class Tensor(_Tensor, ArrayMethodMixin):
     r"""A tensor object represents a multidimensional, homogeneous array of fixed-size items.
 
@@ -154,6 +186,16 @@ class Tensor(_Tensor, ArrayMethodMixin):
         r"""Returns self :class:`~.Tensor` as a :class:`numpy.ndarray`."""
         return super().numpy()
 
+    def numpy_async(self) -> TensorValueFuture:
+        r"""Queues the copy of the value to the host and returns without waiting.
+
+        The copy is issued into the pinned host memory after the ops already
+        queued, so reading the value later by
+        :meth:`TensorValueFuture.result` does not stall the device queue, e.g.
+        logging the loss of each step.
+        """
+        return TensorValueFuture(self)
+
     def detach(self):
         r"""Returns a new :class:`~.Tensor`, detached from the current graph."""
         return super().detach()
@@ -263,20 +305,44 @@ class Tensor(_Tensor, ArrayMethodMixin):
         self._qparams = qparams
 
     def __dlpack__(self, stream=None):
+        r"""Exports the tensor as a DLPack capsule sharing its memory.
+
+        Args:
+            stream: the CUDA stream of the consumer, as defined by the DLPack protocol
+                (1 for the legacy default stream, 2 for the per-thread default stream,
+                otherwise the value of ``cudaStream_t``). The stream waits for the work
+                producing the tensor. No synchronization is done if None or -1.
+        """
         if stream is not None and not isinstance(stream, int):
             raise TypeError("stream must be ``int`` or ``none``")
-        elif stream is not None and stream != -1:
-            mdevice, mrank, mstream = self.device.physical_locator
-            if mdevice == "gpu":
-                if mstream != stream:
-                    device = "gpu{}:{}".format(mrank, mstream)
-                    self.to(device, _borrow=True)
-            elif mdevice == "cpu":
-                device = "cpu{}:{}".format(mrank, mstream)
-                self.to(device, _borrow=True)
-            else:
-                raise ValueError("dlpack not support this device: {}!".format(mdevice))
-        return _to_dlpack(self)
+        mdevice = self.device.physical_locator[0]
+        if mdevice not in ("gpu", "cpu"):
+            raise ValueError("dlpack not support this device: {}!".format(mdevice))
+        return _to_dlpack(self, stream)
+
+    def __dlpack_device__(self):
+        return _dlpack_device(self)
+
+    @property
+    def __cuda_array_interface__(self):
+        r"""The CUDA Array Interface (version 3) sharing the memory of the tensor,
+        only available on gpu. The consumer should synchronize with ``stream``.
+        """
+        if self.device.physical_locator[0] != "gpu":
+            raise AttributeError(
+                "__cuda_array_interface__ is only available for tensors on gpu"
+            )
+        return _cuda_array_interface(self)
+
+    @staticmethod
+    def from_dlpack(ext_tensor, stream=None):
+        r"""Creates a tensor sharing the memory of ``ext_tensor`` without copy.
+
+        See :func:`~.utils.dlpack.from_dlpack` for details.
+        """
+        from .utils.dlpack import from_dlpack
+
+        return from_dlpack(ext_tensor, stream)
 
 
 set_py_tensor_type(Tensor)
@@ -1,4 +1,4 @@
-from . import const_pass, fold_scale_pass, fuse_pass
+from . import const_pass, cse_pass, fold_scale_pass, fuse_pass
 from .optimization import optimize
 
 __all__ = ["optimize"]
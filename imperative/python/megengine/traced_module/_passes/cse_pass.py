@@ -0,0 +1,169 @@
+from typing import Any, Dict, Hashable
+
+import numpy as np
+
+from ... import functional as F
+from ...module import Module
+from ...tensor import Tensor
+from ..expr import Apply, CallFunction, CallMethod, Constant, Expr, GetAttr, Input
+from ..node import ModuleNode
+from ..traced_module import InternalGraph
+from .pass_base import BasePass, register_pass
+
+# Tensor methods which modify their inputs inplace
+_INPLACE_METHODS = {
+    "__setitem__",
+    "_reset",
+    "__iadd__",
+    "__isub__",
+    "__imul__",
+    "__imatmul__",
+    "__itruediv__",
+    "__ifloordiv__",
+    "__imod__",
+    "__ipow__",
+    "__ilshift__",
+    "__irshift__",
+    "__iand__",
+    "__ior__",
+    "__ixor__",
+}
+
+
+def _is_random_func(func) -> bool:
+    module = getattr(func, "__module__", None) or ""
+    return "random" in module or func is F.nn.dropout
+
+
+def _is_random_op(opdef) -> bool:
+    name = type(opdef).__name__
+    return name.endswith("RNG") or name == "Dropout"
+
+
+def _const_key(val: Any) -> Hashable:
+    # const Tensors and arrays are compared by identity
+    if isinstance(val, (Tensor, np.ndarray, Module)):
+        return ("id", id(val))
+    try:
+        hash(val)
+    except TypeError:
+        return ("id", id(val))
+    return (type(val), val)
+
+
+@register_pass("EliminateCommonSubexpr")
+class EliminateCommonSubexpr(BasePass):
+    r"""Merge the exprs which compute the same values.
+
+    Two exprs are merged if they call the same function, method or opdef with
+    the same inputs and the same const arguments. The exprs calling random
+    functions and the inplace methods of Tensor are never merged, and a
+    submodule call is merged only if the submodule is in eval mode and its
+    graph is also free of random exprs.
+
+    For example, the following code
+
+    .. code-block::
+
+        y0 = F.relu(x) + 1
+        y1 = F.relu(x) + 1
+        y = y0 * y1
+
+    will be changed to
+
+    .. code-block::
+
+        y0 = F.relu(x) + 1
+        y = y0 * y0
+
+    The exprs in different submodule graphs can not reference each other, so
+    :meth:`.TracedModule.flatten` the module first to eliminate the common
+    subexpressions across submodules.
+    """
+
+    name = "EliminateCommonSubexpr"
+    run_once = True
+
+    def __init__(self):
+        super().__init__()
+        self._pure_graph = {}  # type: Dict[InternalGraph, bool]
+
+    def _is_pure_graph(self, graph: InternalGraph) -> bool:
+        if graph not in self._pure_graph:
+            self._pure_graph[graph] = True
+            self._pure_graph[graph] = all(
+                self._is_pure(expr) for expr in graph._exprs
+            )
+        return self._pure_graph[graph]
+
+    def _is_pure(self, expr: Expr) -> bool:
+        if isinstance(expr, CallFunction):
+            return not _is_random_func(expr.func)
+        if isinstance(expr, Apply):
+            return not _is_random_op(expr.opdef)
+        if isinstance(expr, CallMethod):
+            if not expr.inputs or not isinstance(expr.inputs[0], ModuleNode):
+                return expr.method not in _INPLACE_METHODS
+            owner = expr.inputs[0].owner
+            if owner is None or any(m.training for m in owner.modules()):
+                return False
+            return expr.graph is None or self._is_pure_graph(expr.graph)
+        return True
+
+    def _expr_key(self, expr: Expr) -> Hashable:
+        if isinstance(expr, Input) or not self._is_pure(expr):
+            return None
+        if isinstance(expr, Constant):
+            return (Constant, id(expr.value))
+        if isinstance(expr, GetAttr):
+            return (GetAttr, id(expr.inputs[0]), expr.name)
+        if isinstance(expr, CallFunction):
+            op = expr.func
+        elif isinstance(expr, CallMethod):
+            op = expr.method
+        elif isinstance(expr, Apply):
+            op = expr.opdef
+        else:
+            return None
+        const_val = tuple((idx, _const_key(val)) for idx, val in expr.const_val)
+        return (
+            type(expr),
+            op,
+            tuple(id(n) for n in expr.inputs),
+            const_val,
+            expr.arg_def,
+        )
+
+    def visit_graph(self, graph: InternalGraph):
+        graph_changed, local_changed = False, False
+        visited_graph = set()
+        exprs_map = {}  # type: Dict[Hashable, Expr]
+        repl_dict = {}
+        for expr in graph._exprs:
+            sub_graph = getattr(expr, "graph", None)
+            if sub_graph is not None and sub_graph not in visited_graph:
+                visited_graph.add(sub_graph)
+                graph_changed |= self.visit_graph(sub_graph)
+            # the inputs of expr refer to the merged nodes, so that the users
+            # of a merged expr can be merged transitively
+            for i, n in enumerate(expr.inputs):
+                if n in repl_dict:
+                    n.users.remove(expr)
+                    expr.inputs[i] = repl_dict[n]
+                    repl_dict[n].users.append(expr)
+            key = self._expr_key(expr)
+            if key is None:
+                continue
+            existed = exprs_map.setdefault(key, expr)
+            if existed is expr or len(existed.outputs) != len(expr.outputs):
+                continue
+            for old, new in zip(expr.outputs, existed.outputs):
+                repl_dict[old] = new
+            local_changed = True
+
+        if local_changed:
+            for i, n in enumerate(graph.outputs):
+                if n in repl_dict:
+                    graph.outputs[i] = repl_dict[n]
+            graph.compile()
+        return graph_changed or local_changed
@@ -15,6 +15,7 @@ def optimize(
 
     The following passes are currently supported:
 
+        * EliminateCommonSubexpr: merge the exprs which compute the same values
         * FuseConvBn: fuse BN layers into to conv2d
         * FuseAddMul: fold adjacent const add or mul binary operations
         * BackwardFoldScale: backward fold const scaling into weights of conv2d
@@ -29,6 +30,7 @@ def optimize(
     """
 
     defalut_passes_list = [
+        "EliminateCommonSubexpr",
         "FuseConvBn",
         "FuseAddMul",
     ]
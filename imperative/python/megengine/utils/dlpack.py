@@ -1,4 +1,10 @@
-from ..core._imperative_rt.core2 import _from_dlpack
+from ..core._imperative_rt.core2 import (
+    _from_cuda_array_interface,
+    _from_dlpack,
+    _get_cuda_stream,
+)
+
+_DL_CUDA = 2
 
 __all__ = [
     "to_dlpack",
@@ -14,9 +20,9 @@ def to_dlpack(tensor, stream=None):
         tensor (Tensor): The input tensor, and the data type can be `float16`, `float32`,
                     `int8`, `int16`, `int32`, `uint8`, `uint16`, `complex64`.
 
-        stream (Integer or None): An optional Python integer representing a CUDA stream,
-                    The current stream is synchronized with this stream before the capsule is created.
-                    If None or -1 is passed then no synchronization is performed.
+        stream (Integer or None): An optional Python integer representing a CUDA stream of the consumer,
+                    as defined by the DLPack protocol. The stream waits for the work producing the tensor
+                    before the capsule is created. If None or -1 is passed then no synchronization is performed.
     Returns:
         dltensor, and the data type is PyCapsule.
 
@@ -41,13 +47,17 @@ def to_dlpack(tensor, stream=None):
 
 def from_dlpack(ext_tensor, stream=None):
     """
-    Decodes a DLPack to a megengine tensor.
+    Decodes a DLPack to a megengine tensor, sharing the memory without copy.
 
     Args:
-        ext_tensor (PyCapsule): a PyCapsule object with the dltensor.
+        ext_tensor: a PyCapsule object with the dltensor, or an object implementing
+                    ``__dlpack__`` (e.g. tensors of PyTorch, CuPy or NumPy) or ``__cuda_array_interface__``.
+                    The producer is synchronized with the stream of the returned tensor if it
+                    supports the protocols with streams.
 
-        stream (Integer or None): An optional Python integer representing a CUDA stream,
-                    user needs to know which stream the dlpack is generated.
+        stream (Integer or None): An optional Python integer representing the stream index of megengine
+                    device the returned tensor is on, e.g. 1 for ``gpu0:1``.
+                    For a PyCapsule, user needs to know which stream the dlpack is generated.
                     If None then represent producers and consumers on the same stream.
 
     Returns:
@@ -70,4 +80,15 @@ def from_dlpack(ext_tensor, stream=None):
     if isinstance(stream, int):
         assert stream >= 0, "device stream should be a positive value"
     stream = 0 if stream is None else stream
+    if hasattr(ext_tensor, "__dlpack__"):
+        kwargs = {}
+        if hasattr(ext_tensor, "__dlpack_device__"):
+            device_type, device_id = ext_tensor.__dlpack_device__()
+            if device_type == _DL_CUDA:
+                # the producer makes our stream wait for the data
+                device = "gpu{}:{}".format(device_id, stream)
+                kwargs["stream"] = _get_cuda_stream(device)
+        ext_tensor = ext_tensor.__dlpack__(**kwargs)
+    elif hasattr(ext_tensor, "__cuda_array_interface__"):
+        return _from_cuda_array_interface(ext_tensor, stream)
     return _from_dlpack(ext_tensor, stream)
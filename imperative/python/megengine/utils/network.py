@@ -122,6 +122,9 @@ class Network:
         * enable_ioc16 --
           whether to use float16 for both I/O and computation
           precision.
+        * enable_f16_mixed_precision: with enable_io16xc32 or enable_ioc16, keep
+          the oprs sensitive to float16, like softmax, normalizations and
+          reductions, in float32.
         * enable_hwcd4 --
           whether to use NHWCD4 data layout. This is faster on some
           OpenCL backend.
@@ -154,6 +157,10 @@ class Network:
           inference
         * enable_fuse_grain: fuse grain will be enable by default to fuse grain operator to huge operator, you can disable it.  
         )
+        * enable_precompute_weight: whether to store transformed constant weights,
+          like the transposed weights of matmul, into the model.
+        * precompute_weight_size_budget: max bytes the model may grow by
+          enable_precompute_weight, unlimited by default.
         """
 
         if not isinstance(dest_vars, Sequence):
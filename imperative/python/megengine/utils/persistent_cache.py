@@ -18,7 +18,7 @@ class PersistentCacheOnServer(_PersistentCache):
     def __init__(self):
         super().__init__()
         cache_type = os.getenv("MGE_FASTRUN_CACHE_TYPE")
-        if cache_type not in ("FILE", "MEMORY"):
+        if cache_type not in ("FILE", "LOG_FILE", "MEMORY"):
             try:
                 redis_config = self.get_redis_config()
             except Exception as exc:
@@ -34,6 +34,16 @@ class PersistentCacheOnServer(_PersistentCache):
                         "fastrun use redis cache",
                         "failed to connect to cache server",
                     )
+        if cache_type == "LOG_FILE":
+            # an append-only file shared by concurrent processes without
+            # rewriting it as a whole on flush
+            path = os.path.join(self.get_cache_dir(), "cache.log")
+            self.add_config(
+                "log-file",
+                {"path": path},
+                "fastrun use log-file cache in {}".format(path),
+                "failed to create log cache file in {}".format(path),
+            )
         if cache_type != "MEMORY":
             path = self.get_cache_file(self.get_cache_dir())
             self.add_config(
@@ -37,6 +37,9 @@ class Profiler(ContextDecorator):
         path: default path prefix for profiler to dump.
         with_backtrace: Whether to record backtrace information for ops.
         with_scopes: Whether to keep more scopes to record record module/functional hierarchy. Enabling this option will slow down your program execution.
+        keep_recent_ms: If nonzero, only the records in the last ``keep_recent_ms``
+            milliseconds before :meth:`stop` are kept, so that the memory of profiling
+            a long running job is bounded. Default: 0
     
     Examples:
     
@@ -65,6 +68,8 @@ class Profiler(ContextDecorator):
         "profile_device": 1,
         "num_tensor_watch": 10,
         "enable_cupti": 0,
+        "profile_hw_counter": 0,
+        "keep_recent_ms": 0,
     }
     valid_formats = {"chrome_timeline.json", "memory_flow.svg"}
 
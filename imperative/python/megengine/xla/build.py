@@ -29,7 +29,6 @@ def build_xla(
 ):
     assert device == None, "cannot specify device now"
     assert keep_unused == True, "keep_unused error"
-    assert donate_invars == None, "donate_invars error"
 
     # normalize megengine trace result for lowering
     tr = TraceResult(mge_traced, func_name)
@@ -40,6 +39,11 @@ def build_xla(
         print("================ Mge Trace Result ================")
         print(tr)
 
+    # donate_invars are the ids of the traced input vars whose buffers are not used
+    # after the execution, so that xla can write the outputs into them
+    if donate_invars is not None:
+        donate_invars = tuple(vid in donate_invars for vid in tr.inputs)
+
     in_is_global = (True,) * len(tr.inputs)
     kept_var_idx = set(range(len(tr.inputs))) if keep_unused else set()
 
@@ -104,6 +108,7 @@ def build_xla(
             return_device_array=return_device_array,
             world_size=get_world_size(),
             rank=get_rank(),
+            donated_invars=donate_invars,
         )
 
     if verbose > 1 and get_rank() == 0:
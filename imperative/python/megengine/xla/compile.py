@@ -1,4 +1,5 @@
 import dataclasses
+import hashlib
 import os
 from typing import Any, Callable, Dict, List, Optional, Protocol, Sequence, Set, Union
 
@@ -6,6 +7,7 @@ import numpy as np
 
 from .. import tensor
 from ..distributed import is_distributed
+from ..logger import get_logger
 from ..utils.dlpack import from_dlpack, to_dlpack
 from . import ir_utils
 from .lib import xla_bridge as xb
@@ -26,6 +28,64 @@ from .utils import safe_zip, unzip2
 xla_extension = xc._xla
 xe = xla_extension
 
+logger = get_logger(__name__)
+
+# compiled executables of this process, keyed by _compilation_cache_key
+_executable_cache = {}
+
+
+def _compilation_cache_dir():
+    r"""the dir of the persistent compilation cache, which is disabled if
+    MGE_XLA_COMPILATION_CACHE_DIR is not set"""
+    return os.environ.get("MGE_XLA_COMPILATION_CACHE_DIR", None)
+
+
+def _compilation_cache_key(backend, module_bytecode, compile_options):
+    # the key is None if the compile options cannot be serialized, in which case the
+    # compilation is not cached
+    if not hasattr(compile_options, "SerializeAsString"):
+        return None
+    h = hashlib.sha256()
+    h.update(module_bytecode)
+    h.update(compile_options.SerializeAsString())
+    h.update(str(getattr(backend, "platform", "")).encode())
+    h.update(str(getattr(backend, "platform_version", "")).encode())
+    h.update(str(getattr(xc, "_version", "")).encode())
+    h.update(os.environ.get("XLA_FLAGS", "").encode())
+    return h.hexdigest()
+
+
+def _load_from_cache_dir(backend, key, compile_options):
+    cache_dir = _compilation_cache_dir()
+    if cache_dir is None or not hasattr(backend, "deserialize_executable"):
+        return None
+    path = os.path.join(cache_dir, "xla_exec_{}.bin".format(key))
+    if not os.path.isfile(path):
+        return None
+    try:
+        with open(path, "rb") as f:
+            return backend.deserialize_executable(f.read(), compile_options)
+    except Exception as e:  # pylint: disable=broad-except
+        logger.warning("failed to load xla executable from {}: {}".format(path, e))
+        return None
+
+
+def _dump_to_cache_dir(backend, key, executable):
+    cache_dir = _compilation_cache_dir()
+    if cache_dir is None or not hasattr(backend, "serialize_executable"):
+        return
+    path = os.path.join(cache_dir, "xla_exec_{}.bin".format(key))
+    try:
+        serialized = backend.serialize_executable(executable)
+        os.makedirs(cache_dir, exist_ok=True)
+        # write to a tmp file first, so other processes never read a partial file
+        tmp_path = "{}.tmp{}".format(path, os.getpid())
+        with open(tmp_path, "wb") as f:
+            f.write(serialized)
+        os.replace(tmp_path, path)
+    except Exception as e:  # pylint: disable=broad-except
+        logger.warning("failed to dump xla executable to {}: {}".format(path, e))
+
 
 def compile_impl(backend, computation: ir.Module, compile_options, host_callbacks):
     sym_name = computation.operation.attributes["sym_name"]
@@ -48,19 +108,51 @@ def compile_impl(backend, computation: ir.Module, compile_options, host_callback
             )
         return backend.compile(built_c, compile_options=options)
 
-    return backend_compile(
-        backend, serialized_computation, compile_options, host_callbacks
-    )
+    # the executables with host callbacks hold python objects, so they are not cached
+    key = None
+    if not host_callbacks:
+        # the module name is in the bytecode, but it is generated for each trace, so
+        # hash the module without it to share the executables of the same graph
+        with computation.context:
+            computation.operation.attributes["sym_name"] = ir.StringAttr.get("main")
+            key = _compilation_cache_key(
+                backend, ir_utils.module_to_bytecode(computation), compile_options
+            )
+            computation.operation.attributes["sym_name"] = sym_name
+    if key is None:
+        return backend_compile(
+            backend, serialized_computation, compile_options, host_callbacks
+        )
+
+    executable = _executable_cache.get(key, None)
+    if executable is None:
+        executable = _load_from_cache_dir(backend, key, compile_options)
+        if executable is None:
+            executable = backend_compile(
+                backend, serialized_computation, compile_options, host_callbacks
+            )
+            _dump_to_cache_dir(backend, key, executable)
+        else:
+            logger.debug("load xla executable of {} from cache".format(module_name))
+        _executable_cache[key] = executable
+    return executable
 
 
 class InputsHandler:
-    __slots__ = ("handler", "local_devices", "in_shardings", "input_indices")
+    __slots__ = (
+        "handler",
+        "local_devices",
+        "in_shardings",
+        "input_indices",
+        "donated_invars",
+    )
 
-    def __init__(self, local_devices, in_shardings, input_indices):
+    def __init__(self, local_devices, in_shardings, input_indices, donated_invars=None):
         self.handler = shard_args
         self.local_devices = local_devices
         self.in_shardings = in_shardings
         self.input_indices = input_indices
+        self.donated_invars = donated_invars
 
     def from_dlpack(self, dlpack):
         return xe.dlpack_managed_tensor_to_buffer(
@@ -75,6 +167,13 @@ class InputsHandler:
             else:
                 capsule = to_dlpack(i)
                 xla_array = self.from_dlpack(capsule)
+                if self.donated_invars is not None and self.donated_invars[idx]:
+                    # the memory borrowed from megengine cannot be reused by the
+                    # outputs, so a donated input gets a buffer owned by xla
+                    device = self.local_devices[0]
+                    xla_array = device.client.buffer_from_pyval(
+                        np.asarray(xla_array), device
+                    )
                 rst.append([xla_array])
         return rst
 
@@ -83,7 +182,8 @@ class InputsHandler:
             "InputsHandler(\n"
             f"local_devices={self.local_devices},\n"
             f"in_shardings={self.in_shardings},\n"
-            f"input_indices={self.input_indices})"
+            f"input_indices={self.input_indices},\n"
+            f"donated_invars={self.donated_invars})"
         )
 
 
@@ -311,6 +411,7 @@ class UnloadedMeshExecutable:
     kept_var_idx: Set[int]
     auto_spmd_lowering: bool
     return_device_array: bool = False
+    donated_invars: Optional[Sequence[bool]] = None
 
     def load(self):
         def _get_input_indices(avals, shardings):
@@ -331,7 +432,10 @@ class UnloadedMeshExecutable:
             self.trace_result._var_inputs, self.input_shardings
         )
         handle_inps = InputsHandler(
-            self.xla_executable.local_devices(), self.input_shardings, input_indices
+            self.xla_executable.local_devices(),
+            self.input_shardings,
+            input_indices,
+            self.donated_invars,
         )
         handle_oups = ResultsHandler(return_device_array=self.return_device_array)
 
@@ -386,6 +490,7 @@ class UnloadedMeshExecutable:
         committed: bool,
         pmap_nreps: int = 1,
         return_device_array: bool = False,
+        donated_invars: Optional[Sequence[bool]] = None,
     ):
         assert mesh == None
         assert spmd_lowering == False
@@ -484,6 +589,7 @@ class UnloadedMeshExecutable:
                 kept_var_idx=kept_var_idx,
                 auto_spmd_lowering=auto_spmd_lowering,
                 return_device_array=return_device_array,
+                donated_invars=donated_invars,
             )
 
 
@@ -613,6 +719,7 @@ class MeshComputation(XlaLowering):
             self._name,
             self._hlo,
             **self.compile_args,
+            donated_invars=self._donated_invars,
             _allow_propagation_to_outputs=_allow_propagation_to_outputs,
             _allow_compile_replicated=_allow_compile_replicated,
         )
@@ -689,6 +796,7 @@ class UnloadedPmapExecutable:
     kept_var_idx: Set[int]
     rank: int
     return_device_array: bool = False
+    donated_invars: Optional[Sequence[bool]] = None
 
     @staticmethod
     def from_hlo(
@@ -706,6 +814,7 @@ class UnloadedPmapExecutable:
         return_device_array,
         world_size,
         rank,
+        donated_invars=None,
     ):
         assert unordered_effects == []
         assert ordered_effects == []
@@ -771,6 +880,7 @@ class UnloadedPmapExecutable:
             kept_var_idx=kept_var_idx,
             rank=rank,
             return_device_array=return_device_array,
+            donated_invars=donated_invars,
         ).load()
 
     def build_execute_fun(self):
@@ -785,7 +895,10 @@ class UnloadedPmapExecutable:
                 ((tuple(slice(None, None, None) for _ in range(len(ishape)))),)
             )
         handle_inps = InputsHandler(
-            self.compiled.local_devices(), self.input_shardings, input_indices
+            self.compiled.local_devices(),
+            self.input_shardings,
+            input_indices,
+            self.donated_invars,
         )
         handle_oups = ResultsHandler(return_device_array=self.return_device_array)
 
@@ -34,6 +34,7 @@ def _is_rng_op(opr):
             mops.UniformRNG,
             mops.ExponentialRNG,
             mops.MultinomialRNG,
+            mops.LogitsSamplingRNG,
         ),
     )
 
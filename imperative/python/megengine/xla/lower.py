@@ -183,10 +183,6 @@ def make_xla_graph(
     assert (
         in_shardings is None and out_shardings is None
     ), "sharding when lowering is not supported yet"
-    assert (
-        input_output_aliases is None or input_output_aliases == []
-    ), "donated inputs are not supported yet"
-
     input_types = [
         mge_varinfo_to_ir_type_tuple(trace_result.vars[idx])
         for idx in trace_result.inputs
@@ -208,6 +204,20 @@ def make_xla_graph(
     )
     ctx.symbol_table.insert(func_op)
 
+    # input i shares its buffer with output input_output_aliases[i]
+    if input_output_aliases is not None and any(
+        a is not None for a in input_output_aliases
+    ):
+        assert len(input_output_aliases) == len(flat_input_types)
+        i32 = ir.IntegerType.get_signless(32)
+        arg_attrs = []
+        for alias in input_output_aliases:
+            attrs = {}
+            if alias is not None:
+                attrs["tf.aliasing_output"] = ir.IntegerAttr.get(i32, alias)
+            arg_attrs.append(ir.DictAttr.get(attrs))
+        func_op.arg_attrs = ir.ArrayAttr.get(arg_attrs)
+
     entry_block = func_op.add_entry_block()
     with ir.InsertionPoint(entry_block):
         flat_args = entry_block.arguments
@@ -218,6 +228,34 @@ def make_xla_graph(
     return func_op
 
 
+def _set_up_aliases(trace_result: TraceResult, donated_invars):
+    """
+    match each donated input with an output of the same shape and dtype, so that
+    the output is written into the buffer of the input. an output is aliased at
+    most once, and the donated inputs without a matched output are not aliased
+    """
+    if donated_invars is None:
+        return None
+    assert len(donated_invars) == len(trace_result.inputs)
+
+    def key_of(vid):
+        var = trace_result.vars[vid]
+        return tuple(var.shape), np.dtype(var.dtype)
+
+    out_candidates = {}
+    for oidx, vid in enumerate(trace_result.outputs):
+        # an output which is also an input is not computed, so it cannot be aliased
+        if vid in trace_result.inputs:
+            continue
+        out_candidates.setdefault(key_of(vid), []).append(oidx)
+
+    aliases = []
+    for vid, donated in zip(trace_result.inputs, donated_invars):
+        candidates = out_candidates.get(key_of(vid)) if donated else None
+        aliases.append(candidates.pop(0) if candidates else None)
+    return aliases
+
+
 def lower(
     trace_result: TraceResult,
     backend,
@@ -226,7 +264,6 @@ def lower(
     out_shardings=None,
     donated_invars=None,
 ):
-    assert donated_invars is None, "donated inputs are not supported yet"
     assert trace_result.effects == [], "effect of trace is not supported"
 
     if in_shardings is not None:
@@ -253,6 +290,6 @@ def lower(
             public=True,
             in_shardings=None,
             out_shardings=None,
-            input_output_aliases=[],
+            input_output_aliases=_set_up_aliases(trace_result, donated_invars),
         )
     return ctx.module, ctx.keepalives, ctx.host_callbacks
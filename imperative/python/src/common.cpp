@@ -139,6 +139,10 @@ void init_common(py::module m) {
                                 cn.reset_max_used_memory();
                                 cn.reset_max_reserved_memory();
                             })
+                    .def("_set_mem_limit",
+                         [](const CompNode& cn, size_t soft_limit, size_t hard_limit) {
+                             cn.set_mem_limit(soft_limit, hard_limit);
+                         })
                     .def("make_free_mem_block_device",
                          [](const CompNode& cn, int64_t size) {
                              cn.make_free_mem_block_device(static_cast<size_t>(size));
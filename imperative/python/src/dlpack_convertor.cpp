@@ -8,6 +8,7 @@
 
 using namespace mgb::imperative;
 using namespace mgb;
+namespace py = pybind11;
 
 DLDataType mgb::imperative::get_dl_datatype(const DeviceTensorND& dv) {
     DLDataType dtype;
@@ -221,6 +222,84 @@ DLManagedTensor* mgb::imperative::to_dlpack(const ValueRef src) {
     return &(TensorHandler->tensor);
 }
 
+namespace {
+
+/*!
+ * drop the reference to the python owner of the imported memory; the storage
+ * may be released on the worker thread of the interpreter, so take the GIL
+ * here instead of deferring the release
+ */
+void release_py_owner(PyObject* obj) {
+    //! the owner has been freed with the interpreter
+    if (!Py_IsInitialized()) {
+        return;
+    }
+    auto state = PyGILState_Ensure();
+    Py_DECREF(obj);
+    PyGILState_Release(state);
+}
+
+#if MGB_CUDA
+cudaStream_t as_cuda_stream(intptr_t stream) {
+    if (stream == 1) {
+        return cudaStreamLegacy;
+    }
+    if (stream == 2) {
+        return cudaStreamPerThread;
+    }
+    return reinterpret_cast<cudaStream_t>(stream);
+}
+
+//! make \p waiter wait for the work issued to \p waitee so far
+void cuda_stream_wait(cudaStream_t waiter, cudaStream_t waitee) {
+    if (waiter == waitee) {
+        return;
+    }
+    cudaEvent_t event;
+    MGB_CUDA_CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    MGB_CUDA_CHECK(cudaEventRecord(event, waitee));
+    MGB_CUDA_CHECK(cudaStreamWaitEvent(waiter, event, 0));
+    // the event is destroyed after the wait completes
+    MGB_CUDA_CHECK(cudaEventDestroy(event));
+}
+#endif
+
+}  // namespace
+
+void mgb::imperative::sync_to_external_stream(CompNode cn, intptr_t stream) {
+    if (cn.device_type() != CompNode::DeviceType::CUDA) {
+        return;
+    }
+#if MGB_CUDA
+    auto&& env = CompNodeEnv::from_comp_node(cn).cuda_env();
+    env.activate();
+    cuda_stream_wait(as_cuda_stream(stream), env.stream);
+#endif
+}
+
+void mgb::imperative::sync_from_external_stream(CompNode cn, intptr_t stream) {
+    if (cn.device_type() != CompNode::DeviceType::CUDA) {
+        return;
+    }
+#if MGB_CUDA
+    auto&& env = CompNodeEnv::from_comp_node(cn).cuda_env();
+    env.activate();
+    cuda_stream_wait(env.stream, as_cuda_stream(stream));
+#endif
+}
+
+intptr_t mgb::imperative::get_cuda_stream(CompNode cn) {
+    mgb_assert(
+            cn.device_type() == CompNode::DeviceType::CUDA,
+            "expect a cuda comp node, got %s", cn.to_string().c_str());
+#if MGB_CUDA
+    auto&& env = CompNodeEnv::from_comp_node(cn).cuda_env();
+    return reinterpret_cast<intptr_t>(env.stream);
+#else
+    mgb_throw(MegBrainError, "CUDA device is not available");
+#endif
+}
+
 TensorShape ptr2shape(const int64_t* ptr, size_t ndim) {
     TensorShape shape;
     mgb_assert(
@@ -256,10 +335,24 @@ ValueRef mgb::imperative::from_dlpack(DLManagedTensor* dlMTensor, int stream = 0
     size_t dtype_size = tensor_type.size();
     size_t ndim = dlMTensor->dl_tensor.ndim;
     TensorShape tensor_shape = ptr2shape(dlMTensor->dl_tensor.shape, ndim);
+    if (auto strides = dlMTensor->dl_tensor.strides) {
+        // tensors are created contiguous, so only the strides of the contiguous
+        // layout are accepted, ignoring those of the dims of size 1
+        int64_t expect = 1;
+        for (size_t i = ndim; i--;) {
+            mgb_throw_if(
+                    tensor_shape[i] != 1 && strides[i] != expect, MegBrainError,
+                    "non-contiguous dlpack tensor is not supported, make it "
+                    "contiguous before exporting");
+            expect *= tensor_shape[i];
+        }
+    }
+    auto data = static_cast<dt_byte*>(dlMTensor->dl_tensor.data) +
+                dlMTensor->dl_tensor.byte_offset;
 
     storage.reset(
             tensor_device, tensor_shape.total_nr_elems() * dtype_size,
-            {static_cast<dt_byte*>(dlMTensor->dl_tensor.data), deleter_dispatch});
+            {data, deleter_dispatch});
 
     ValueShape shapevalue = ValueShape::from(tensor_shape);
     ValueRef val = imperative::apply(
@@ -267,4 +360,138 @@ ValueRef mgb::imperative::from_dlpack(DLManagedTensor* dlMTensor, int stream = 0
                     CreateTensor::Common, tensor_device, tensor_type, shapevalue, {}),
             DeviceStorage::make(storage))[0];
     return val;
-};
\ No newline at end of file
+}
+
+namespace {
+
+DType dtype_from_typestr(const std::string& typestr) {
+    mgb_throw_if(
+            typestr.size() < 3 || typestr[0] == '>', MegBrainError,
+            "unsupported typestr in __cuda_array_interface__: %s", typestr.c_str());
+    auto kind = typestr.substr(1);
+    static const std::unordered_map<std::string, DTypeEnum> kind2dtype = {
+            {"f2", DTypeEnum::Float16}, {"f4", DTypeEnum::Float32},
+            {"i1", DTypeEnum::Int8},    {"i2", DTypeEnum::Int16},
+            {"i4", DTypeEnum::Int32},   {"u1", DTypeEnum::Uint8},
+            {"u2", DTypeEnum::Uint16},  {"b1", DTypeEnum::Bool},
+            {"c8", DTypeEnum::Complex64}};
+    auto iter = kind2dtype.find(kind);
+    mgb_throw_if(
+            iter == kind2dtype.end(), MegBrainError,
+            "unsupported typestr in __cuda_array_interface__: %s", typestr.c_str());
+    return DType::from_enum(iter->second);
+}
+
+std::string dtype_to_typestr(DType dtype) {
+    switch (dtype.enumv()) {
+        case DTypeEnum::Float16:
+            return "<f2";
+        case DTypeEnum::Float32:
+            return "<f4";
+        case DTypeEnum::Int8:
+            return "|i1";
+        case DTypeEnum::Int16:
+            return "<i2";
+        case DTypeEnum::Int32:
+            return "<i4";
+        case DTypeEnum::Uint8:
+        case DTypeEnum::Byte:
+            return "|u1";
+        case DTypeEnum::Uint16:
+            return "<u2";
+        case DTypeEnum::Bool:
+            return "|b1";
+        case DTypeEnum::Complex64:
+            return "<c8";
+        default:
+            mgb_throw(
+                    MegBrainError, "type %s is not supported by cuda array interface",
+                    dtype.name());
+    }
+}
+
+}  // namespace
+
+py::dict mgb::imperative::to_cuda_array_interface(const ValueRef src) {
+    DeviceTensorND dv = src.dev_tensor()->as_nd(true);
+    auto cn = dv.comp_node();
+    mgb_throw_if(
+            cn.device_type() != CompNode::DeviceType::CUDA, MegBrainError,
+            "__cuda_array_interface__ is only available on cuda, got %s",
+            cn.to_string().c_str());
+    auto shape = src.shape()->as_tensor_shape();
+    py::list py_shape;
+    for (size_t i = 0; i < shape.ndim; ++i) {
+        py_shape.append(shape[i]);
+    }
+    py::object py_strides = py::none();
+    auto&& layout = dv.layout();
+    if (shape.ndim && !layout.is_contiguous()) {
+        py::list strides;
+        for (size_t i = 0; i < layout.ndim; ++i) {
+            strides.append(layout.stride[i] * ptrdiff_t(layout.dtype.size()));
+        }
+        py_strides = py::tuple(strides);
+    }
+    py::dict ret;
+    ret["shape"] = py::tuple(py_shape);
+    ret["typestr"] = dtype_to_typestr(dv.dtype());
+    ret["data"] = py::make_tuple(reinterpret_cast<uintptr_t>(dv.raw_ptr()), false);
+    ret["strides"] = py_strides;
+    ret["version"] = 3;
+    // the consumer synchronizes with the stream on which the data is produced
+    ret["stream"] = get_cuda_stream(cn);
+    return ret;
+}
+
+ValueRef mgb::imperative::from_cuda_array_interface(py::object obj, int stream) {
+    py::dict desc = obj.attr("__cuda_array_interface__");
+    auto py_shape = desc["shape"].cast<std::vector<size_t>>();
+    TensorShape shape;
+    mgb_assert(
+            py_shape.size() <= TensorShape::MAX_NDIM, "dim too large: %zu",
+            py_shape.size());
+    shape.ndim = py_shape.size();
+    for (size_t i = 0; i < shape.ndim; ++i) {
+        shape[i] = py_shape[i];
+    }
+    auto dtype = dtype_from_typestr(desc["typestr"].cast<std::string>());
+    if (desc.contains("strides") && !desc["strides"].is_none()) {
+        auto strides = desc["strides"].cast<std::vector<ptrdiff_t>>();
+        ptrdiff_t expect = dtype.size();
+        for (size_t i = shape.ndim; i--;) {
+            mgb_throw_if(
+                    shape[i] != 1 && strides[i] != expect, MegBrainError,
+                    "non-contiguous cuda array is not supported, make it "
+                    "contiguous before exporting");
+            expect *= shape[i];
+        }
+    }
+    auto data = desc["data"].cast<py::tuple>()[0].cast<uintptr_t>();
+    int device = 0;
+#if MGB_CUDA
+    if (data) {
+        cudaPointerAttributes attr;
+        MGB_CUDA_CHECK(cudaPointerGetAttributes(&attr, reinterpret_cast<void*>(data)));
+        device = attr.device;
+    }
+#endif
+    DLDevice ctx;
+    ctx.device_type = DLDeviceType::kDLCUDA;
+    ctx.device_id = device;
+    CompNode cn = get_tensor_device(ctx, stream);
+    if (desc.contains("stream") && !desc["stream"].is_none()) {
+        sync_from_external_stream(cn, desc["stream"].cast<intptr_t>());
+    }
+
+    PyObject* owner = obj.inc_ref().ptr();
+    DeviceTensorStorage storage;
+    storage.reset(
+            cn, shape.total_nr_elems() * dtype.size(),
+            {reinterpret_cast<dt_byte*>(data),
+             [owner](void*) { release_py_owner(owner); }});
+    return imperative::apply(
+            CreateTensor(
+                    CreateTensor::Common, cn, dtype, ValueShape::from(shape), {}),
+            DeviceStorage::make(storage))[0];
+}
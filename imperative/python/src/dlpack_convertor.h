@@ -19,6 +19,30 @@ CompNode get_tensor_device(const DLDevice& ctx, int stream);
 
 mgb::DType get_tensor_type(const DLDataType& dtype);
 
+/*!
+ * \brief make the external CUDA stream wait for the work issued to the comp node
+ *
+ * The stream follows the DLPack convention: 1 for the legacy default stream, 2
+ * for the per-thread default stream, otherwise the value of a cudaStream_t.
+ */
+void sync_to_external_stream(CompNode cn, intptr_t stream);
+
+//! make the comp node wait for the work issued to the external CUDA stream
+void sync_from_external_stream(CompNode cn, intptr_t stream);
+
+//! the cudaStream_t of the comp node as an integer
+intptr_t get_cuda_stream(CompNode cn);
+
+//! the __cuda_array_interface__ (version 3) describing a tensor on CUDA
+pybind11::dict to_cuda_array_interface(const ValueRef src);
+
+/*!
+ * \brief wrap the memory exported by __cuda_array_interface__ of \p obj
+ *
+ * \p obj is kept alive until the storage is released.
+ */
+ValueRef from_cuda_array_interface(pybind11::object obj, int stream);
+
 }  // namespace imperative
 
 }  // namespace mgb
\ No newline at end of file
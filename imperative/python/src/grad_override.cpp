@@ -749,6 +749,49 @@ std::optional<ValueRefList> where_grad_rule(
     return imperative::apply(op, inputs);
 }
 
+std::optional<ValueRefList> embedding_bag_grad_rule(
+        const OpDef& op, Span<ValueRef> inputs, Span<bool> inputs_require_grad,
+        CustomBackward& backward) {
+    auto&& embedding_bag = op.cast_final_safe<EmbeddingBag>();
+    mgb_assert(inputs.size() == 4);
+    auto outputs = imperative::apply(op, inputs);
+    // only the table has grad, the per sample weights are treated as constants
+    SmallVector<ValueRef> inps;
+    if (inputs_require_grad[0]) {
+        inps.push_back(get_shape(inputs[0]));
+        inps.push_back(inputs[1]);
+        inps.push_back(inputs[2]);
+        inps.push_back(inputs[3]);
+        inps.push_back(outputs[1]);
+    }
+    auto maker = CustomGradMaker(backward, inputs.size());
+    maker.output_size(2).output_captured(0, false).output_captured(1, false);
+    maker.output_requires_grad(1, false);
+    for (size_t i = 1; i < inputs.size(); ++i) {
+        maker.input_has_grad(i, false);
+    }
+    maker.backward([inputs = std::move(inps),
+                    param = embedding_bag.param()](Span<ValueRef> grads) {
+        mgb_assert(grads.size() == 2);
+        ValueRef grad = grads[0];
+        SmallVector<ValueRef> ret(4);
+        if (!grad || !inputs.size()) {
+            return ret;
+        }
+        auto&& grad_op = EmbeddingBagBackward::make(param);
+        ValueRefList args_(6);
+        args_[0] = make_empty_tensor(grad.device(), inputs[0], grad.dtype());
+        args_[1] = grad;
+        for (size_t i = 1; i < inputs.size(); ++i) {
+            args_[i + 1] = inputs[i];
+        }
+        ret[0] = imperative::apply(*grad_op, args_)[0];
+        return ret;
+    });
+    maker.finalize();
+    return outputs;
+}
+
 struct Init {
     Init() {
         CustomBackward::register_grad_rule(Elemwise::typeinfo(), elemwise_grad_rule);
@@ -775,6 +818,8 @@ struct Init {
         CustomBackward::register_grad_rule(
                 WarpAffine::typeinfo(), warp_affine_grad_rule);
         CustomBackward::register_grad_rule(Where::typeinfo(), where_grad_rule);
+        CustomBackward::register_grad_rule(
+                EmbeddingBag::typeinfo(), embedding_bag_grad_rule);
     }
 } _;
 
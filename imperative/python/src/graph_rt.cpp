@@ -283,6 +283,9 @@ void init_graph_rt(py::module m) {
                             &_OptimizeForInferenceOptions::f16_io_f32_comp)
                     .def_readwrite(
                             "f16_io_comp", &_OptimizeForInferenceOptions::f16_io_comp)
+                    .def_readwrite(
+                            "f16_mixed_precision",
+                            &_OptimizeForInferenceOptions::f16_mixed_precision)
                     .def_readwrite(
                             "fuse_conv_bias_nonlinearity",
                             &_OptimizeForInferenceOptions::fuse_conv_bias_nonlinearity)
@@ -296,7 +299,14 @@ void init_graph_rt(py::module m) {
                             "layout_transform",
                             &_OptimizeForInferenceOptions::layout_transform)
                     .def_readwrite(
-                            "fuse_grain", &_OptimizeForInferenceOptions::fuse_grain);
+                            "fuse_grain", &_OptimizeForInferenceOptions::fuse_grain)
+                    .def_readwrite(
+                            "precompute_weight",
+                            &_OptimizeForInferenceOptions::precompute_weight)
+                    .def_readwrite(
+                            "precompute_weight_size_budget",
+                            &_OptimizeForInferenceOptions::
+                                    precompute_weight_size_budget);
 
     py::enum_<_LayoutTransform>(GraphOptimizeOptions, "LayoutTransform")
             .value("DEFAULT", _LayoutTransform::DEFAULT)
@@ -486,6 +496,7 @@ void init_graph_rt(py::module m) {
                 DEF_READWRITE(force_dynamic_alloc)
                 DEF_READWRITE(var_sanity_check_first_run)
                 DEF_READWRITE(allocate_static_mem_after_graph_compile)
+                DEF_READWRITE(enable_exec_timer)
                 DEF_READWRITE(fake_next_exec)
                 DEF_READWRITE(enable_sublinear_memory_opt)
                 DEF_READWRITE(enable_dtr_memory_opt)
@@ -509,7 +520,8 @@ void init_graph_rt(py::module m) {
 
     py::class_<cg::ComputingGraph::Options::SeqOpt>(PyComputingGraphOptions, "SeqOpt")
             DEF_READWRITE(enable_mem_plan_opt) DEF_READWRITE(enable_mem_reuse_alloc)
-                    DEF_READWRITE(enable_seq_comp_node_opt);
+                    DEF_READWRITE(enable_seq_comp_node_opt)
+                            DEF_READWRITE(enable_mem_fwd_out2in_slice);
 
 #undef CURRENT_CLASS
 #define CURRENT_CLASS cg::ComputingGraph::Options::GraphOpt
@@ -532,7 +544,9 @@ void init_graph_rt(py::module m) {
     py::class_<cg::ComputingGraph::Options::SublinearMemConfig>(
             PyComputingGraphOptions, "SublinearMemConfig") DEF_READWRITE(thresh_nr_try)
             DEF_READWRITE(genetic_nr_iter) DEF_READWRITE(genetic_pool_size)
-                    DEF_READWRITE(lb_memory_mb) DEF_READWRITE(num_worker);
+                    DEF_READWRITE(lb_memory_mb) DEF_READWRITE(num_worker)
+                            DEF_READWRITE(budget_memory_mb)
+                                    DEF_READWRITE(budget_search_time_ms);
 
 #undef CURRENT_CLASS
 
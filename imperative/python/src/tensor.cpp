@@ -46,6 +46,7 @@
 #include <pyerrors.h>
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <range/v3/all.hpp>
 #include <string>
 
@@ -179,18 +180,46 @@ py::handle py_type() {
     }
 }
 
+/*!
+ * The host storages of python scalars are never written after creation, so
+ * the ones with the same value, dtype and device are shared, which saves the
+ * allocations in per-sample loops.
+ */
 template <typename T>
 auto scalar2storage(T val, CompNode cn, DType dtype) {
     using max_ctype_t = DTypeScalar::max_ctype;
     DTypeScalar scalar(dtype);
     scalar.set_retain_dtype(val);
-    HostTensorStorage storage(cn);
-    auto* raw_ptr = reinterpret_cast<dt_byte*>(new max_ctype_t());
-    std::shared_ptr<dt_byte> raw_storage = {
-            raw_ptr, [](dt_byte* ptr) { delete reinterpret_cast<max_ctype_t*>(ptr); }};
-    storage.only_reset_raw_storage(cn, dtype.size(), raw_storage, 0);
-    std::memcpy(storage.ptr(), scalar.storage(), dtype.size());
-    return HostStorage::make(std::move(storage));
+    auto make_storage = [&]() {
+        HostTensorStorage storage(cn);
+        auto* raw_ptr = reinterpret_cast<dt_byte*>(new max_ctype_t());
+        std::shared_ptr<dt_byte> raw_storage = {
+                raw_ptr,
+                [](dt_byte* ptr) { delete reinterpret_cast<max_ctype_t*>(ptr); }};
+        storage.only_reset_raw_storage(cn, dtype.size(), raw_storage, 0);
+        std::memcpy(storage.ptr(), scalar.storage(), dtype.size());
+        return storage;
+    };
+    if (dtype.has_param()) {
+        return HostStorage::make(make_storage());
+    }
+
+    constexpr size_t max_cached = 1024;
+    thread_local struct {
+        CompNode cn;
+        std::map<std::pair<DTypeEnum, max_ctype_t>, HostTensorStorage> storages;
+    } cached;
+    if (cached.cn != cn || cached.storages.size() >= max_cached) {
+        cached.cn = cn;
+        cached.storages.clear();
+    }
+    max_ctype_t bits = 0;
+    std::memcpy(&bits, scalar.storage(), dtype.size());
+    auto&& storage = cached.storages[{dtype.enumv(), bits}];
+    if (!storage.comp_node_valid()) {
+        storage = make_storage();
+    }
+    return HostStorage::make(storage);
 }
 
 template <typename ctype>
@@ -311,6 +340,35 @@ bool pyseq2hval(seq_type obj, CompNode cn, DType dtype, HostTensorArgs& ret) {
     }
 }
 
+/*!
+ * whether the memory of a numpy array can never be modified, in which case it
+ * is borrowed by the tensor instead of copied; it includes the arrays returned
+ * by Tensor.numpy() and the ones viewing bytes objects
+ */
+bool is_immutable_array(PyObject* obj) {
+    if (!PyArray_Check(obj)) {
+        return false;
+    }
+    auto* arr = reinterpret_cast<PyArrayObject*>(obj);
+    while (true) {
+        if (PyArray_ISWRITEABLE(arr)) {
+            return false;
+        }
+        PyObject* base = PyArray_BASE(arr);
+        if (!base) {
+            // owns a read-only buffer, which may still be set writeable
+            return false;
+        }
+        if (PyArray_Check(base)) {
+            arr = reinterpret_cast<PyArrayObject*>(base);
+            continue;
+        }
+        return PyBytes_Check(base) ||
+               (PyCapsule_CheckExact(base) &&
+                PyCapsule_IsValid(base, "HostTensorND"));
+    }
+}
+
 bool pyarr2hval(py::array obj, CompNode cn, DType dtype, HostTensorArgs& ret) {
     auto data = obj.cast<py::array>();
     auto strides = data.strides();
@@ -330,7 +388,11 @@ bool pyarr2hval(py::array obj, CompNode cn, DType dtype, HostTensorArgs& ret) {
         data.resize(shape);
     }
     HostTensorND retnd(cn);
-    retnd = npy::np2tensor(data.ptr(), npy::Meth::copy_into(&retnd), dtype);
+    if (!need_squeeze && is_immutable_array(data.ptr())) {
+        retnd = npy::np2tensor(data.ptr(), npy::Meth::borrow(cn), dtype);
+    } else {
+        retnd = npy::np2tensor(data.ptr(), npy::Meth::copy_into(&retnd), dtype);
+    }
     if (!dtype.valid()) {
         dtype = retnd.dtype();
     }
@@ -741,6 +803,17 @@ void TensorWrapper::_drop() {
     imperative::apply(DTRCommand(DTRCommand::Drop), m_tensor->data());
 }
 
+PyObject* TensorWrapper::_prefetch_value() {
+    auto outputs = imperative::apply(PrefetchValue(), m_tensor->data());
+    if (outputs.empty()) {
+        Py_RETURN_NONE;
+    }
+    if (outputs[0].cast<BoolValue>()) {
+        Py_RETURN_TRUE;
+    }
+    Py_RETURN_FALSE;
+}
+
 PyObject* TensorWrapper::isscalar() {
     if (m_tensor->is_scalar()) {
         Py_RETURN_TRUE;
@@ -799,9 +872,19 @@ void dlpack_capsule_destructor(PyObject* data) {
     dlMTensor->deleter(const_cast<DLManagedTensor*>(dlMTensor));
 }
 
-PyObject* tensor_to_dlpack(PyObject* tensor) {
+PyObject* tensor_to_dlpack(PyObject* tensor, PyObject* stream) {
     TensorWrapper* wrapper = TensorWrapper::try_cast(tensor);
     DLManagedTensor* dlMTensor = to_dlpack(wrapper->m_tensor->data());
+    if (stream != Py_None) {
+        if (!PyLong_Check(stream)) {
+            throw py::type_error("expect int");
+        }
+        auto sid = PyLong_AsSsize_t(stream);
+        if (sid != -1) {
+            // the consumer reads the data on its own stream
+            sync_to_external_stream(wrapper->m_tensor->comp_node(), sid);
+        }
+    }
     return PyCapsule_New(dlMTensor, "dltensor", dlpack_capsule_destructor);
 }
 
@@ -962,6 +1045,7 @@ void init_tensor(py::module m) {
                     // TODO: remove this
                     .def<&TensorWrapper::_dev_tensor>("_dev_tensor")
                     .def<&TensorWrapper::_drop>("_drop")
+                    .def<&TensorWrapper::_prefetch_value>("_prefetch_value")
                     .def<&TensorWrapper::_detail>("_detail")
                     .def<&TensorWrapper::_set_format>("_set_format")
                     .def<&TensorWrapper::_as_format>("_as_format")
@@ -1212,19 +1296,55 @@ void init_tensor(py::module m) {
         bool check_external = true;
         bool remove_unused_data_required = true;
         bool imperative = false;
+        //! max number of signatures to keep traces for, or 0 to keep only one
+        //! trace and never retrace
+        size_t cache_capacity = 0;
+        //! whether a trace can be reused for the inputs of other shapes, which
+        //! holds when it is recorded with symbolic shapes
+        bool shape_polymorphic = false;
 
         py::function options_visitor;
         std::shared_ptr<TracingTransformation> tracing;
         std::shared_ptr<CompiledTransformation> compiled;
         std::shared_ptr<LazyEvalTransformation> lazy_eval;
         std::pair<size_t, std::shared_ptr<GraphProfiler>> profiler;
-        std::optional<TraceResult> trace_result;
+        std::shared_ptr<TraceResult> trace_result;
         std::function<bool(py::object, py::object)> array_comparator;
         std::unique_ptr<CleanupGuard<>> tracing_guard;
         std::unique_ptr<CleanupGuard<>> compiled_guard;
         std::unique_ptr<CleanupGuard<>> lazy_eval_guard;
         std::unordered_map<size_t, size_t> inpmark_to_id;
         std::unordered_map<size_t, size_t> outmark_to_id;
+        std::unique_ptr<TraceCache> cache;
+        TraceCache::Entry* cache_entry = nullptr;
+        TraceSignature signature;
+
+        void set_signature(std::vector<py::object> tensors) {
+            signature.inputs.clear();
+            for (auto&& tensor : tensors) {
+                auto* tw = TensorWrapper::try_cast(tensor.ptr());
+                mgb_assert(tw, "expect tensor in trace signature");
+                auto shape = tw->m_tensor->shape();
+                signature.inputs.push_back(
+                        {shape ? shape->as_tensor_shape() : TensorShape{},
+                         tw->m_tensor->dtype(), tw->m_tensor->comp_node()});
+            }
+        }
+
+        //! switch to the trace of the current signature
+        void select_cache_entry() {
+            auto& self = *this;
+            if (!self.cache || self.cache->capacity() != self.cache_capacity) {
+                self.cache = std::make_unique<TraceCache>(self.cache_capacity);
+            }
+            auto* entry = self.cache->lookup(self.signature, self.shape_polymorphic);
+            if (!entry) {
+                entry = &self.cache->insert(self.signature);
+            }
+            self.cache_entry = entry;
+            self.trace_result = entry->result;
+            self.compiled = entry->compiled;
+        }
 
         bool compare_value(ValueRef lhs, ValueRef rhs) {
             auto lvalue = lhs.cast_ref<HostValue>();
@@ -1263,6 +1383,12 @@ void init_tensor(py::module m) {
         }
         void enter() {
             auto& self = *this;
+            // the casts cached by autocast must be recorded by each trace
+            DTypePromoteCfg::clear_amp_cast_cache();
+            self.cache_entry = nullptr;
+            if (self.cache_capacity && !self.without_host) {
+                self.select_cache_entry();
+            }
             if (!self.trace_result) {  // untraced
                 self.tracing = std::make_shared<TracingTransformation>(
                         self.capture_as_const, self.record_input_shapes);
@@ -1275,8 +1401,12 @@ void init_tensor(py::module m) {
                 }
             } else if (!self.compiled) {  // traced but not compiled
                 using namespace std::placeholders;
+                // the graph of a generalized trace should accept any input shape
+                bool static_shape = self.record_input_shapes &&
+                                    !(self.cache_entry &&
+                                      self.cache_entry->signature.has_symbolic_dims());
                 self.compiled = std::make_shared<CompiledTransformation>(
-                        *self.trace_result, self.record_input_shapes, self.imperative);
+                        *self.trace_result, static_shape, self.imperative);
                 self.compiled->set_value_comparator(
                         std::bind(&Trace::compare_value, this, _1, _2));
                 self.options_visitor(py::cast(&self.compiled->options()));
@@ -1285,6 +1415,10 @@ void init_tensor(py::module m) {
                 } catch (const std::exception& e) {
                     mgb_log_error("error in trace: %s", e.what());
                 }
+                if (self.cache_entry) {
+                    self.cache_entry->compiled = self.compiled;
+                    self.cache_entry->static_shape = static_shape;
+                }
             }
             // register transformations
             if (self.compiled) {
@@ -1318,6 +1452,7 @@ void init_tensor(py::module m) {
 
         void exit() {
             auto& self = *this;
+            DTypePromoteCfg::clear_amp_cast_cache();
             if (self.tracing) {
                 tracing_guard.reset();
                 if (self.without_host) {
@@ -1325,7 +1460,11 @@ void init_tensor(py::module m) {
                     self.inpmark_to_id = self.tracing->inpmark_to_id;
                     self.outmark_to_id = self.tracing->outmark_to_id;
                 }
-                self.trace_result = self.tracing->get_result();
+                self.trace_result =
+                        std::make_shared<TraceResult>(self.tracing->get_result());
+                if (self.cache_entry) {
+                    self.cache_entry->result = self.trace_result;
+                }
                 if (self.without_host) {
                     for (auto&& var : self.trace_result->vars) {
                         var.shape_required = false;
@@ -1425,6 +1564,14 @@ void init_tensor(py::module m) {
             .def_readwrite("capture_as_const", &Trace::capture_as_const)
             .def_readwrite("no_exec", &Trace::no_exec)
             .def_readwrite("imperative", &Trace::imperative)
+            .def_readwrite("cache_capacity", &Trace::cache_capacity)
+            .def_readwrite("shape_polymorphic", &Trace::shape_polymorphic)
+            .def("set_signature", &Trace::set_signature)
+            .def_property_readonly(
+                    "cache_size",
+                    [](Trace& self) {
+                        return self.cache ? self.cache->size() : size_t(0);
+                    })
             .def_readwrite("options_visitor", &Trace::options_visitor)
             .def("enter", &Trace::enter)
             .def("exit", &Trace::exit)
@@ -1876,6 +2023,7 @@ void init_tensor(py::module m) {
     m.def("_set_amp_dtype_autocast", [](bool flag) -> bool {
         bool ret = DTypePromoteCfg::amp_dtype_autocast_enabled;
         DTypePromoteCfg::amp_dtype_autocast_enabled = flag;
+        DTypePromoteCfg::clear_amp_cast_cache();
         return ret;
     });
 
@@ -1935,8 +2083,33 @@ void init_tensor(py::module m) {
         return format_trans->get_bypass_format_transoformation();
     });
 
-    m.def("_to_dlpack", [](py::object tensor) {
-        return py::reinterpret_steal<py::object>(tensor_to_dlpack(tensor.ptr()));
+    m.def("_to_dlpack",
+          [](py::object tensor, py::object stream) {
+              return py::reinterpret_steal<py::object>(
+                      tensor_to_dlpack(tensor.ptr(), stream.ptr()));
+          },
+          py::arg("tensor"), py::arg("stream") = py::none());
+
+    m.def("_dlpack_device", [](py::object tensor) {
+        auto* tw = TensorWrapper::try_cast(tensor.ptr());
+        mgb_assert(tw, "expect tensor");
+        auto device = get_dl_device(DeviceTensorND{tw->m_tensor->comp_node()});
+        return py::make_tuple(int(device.device_type), device.device_id);
+    });
+
+    m.def("_cuda_array_interface", [](py::object tensor) {
+        auto* tw = TensorWrapper::try_cast(tensor.ptr());
+        mgb_assert(tw, "expect tensor");
+        return to_cuda_array_interface(tw->m_tensor->data());
+    });
+
+    m.def("_from_cuda_array_interface", [](py::object obj, int stream) {
+        return TensorWrapper::make(
+                py_tensor_type, from_cuda_array_interface(obj, stream));
+    });
+
+    m.def("_get_cuda_stream", [](std::string device) {
+        return get_cuda_stream(CompNode::load(device));
     });
 
     m.def("_from_dlpack", [](py::object data, py::object stream) {
@@ -138,6 +138,7 @@ public:
     PyObject* value_id();
     PyObject* _dev_tensor();
     void _drop();
+    PyObject* _prefetch_value();
     PyObject* varnode();
     PyObject* recording();
     PyObject* copied();
@@ -612,6 +612,13 @@ py::object _get_index(py::object tensor, py::object src) {
 }
 
 py::tuple _try_cond_take(py::handle tensor, py::handle index) {
+    // basic indexes are checked first, as a failed hasattr raises and clears
+    // an AttributeError
+    PyObject* obj = index.ptr();
+    if (PyTuple_Check(obj) || PySlice_Check(obj) || PyLong_Check(obj) ||
+        obj == Py_None || obj == Py_Ellipsis) {
+        return py::tuple();
+    }
     if (!hasattr(index, "dtype") || !hasattr(index, "shape")) {
         return py::tuple();
     }
@@ -1165,13 +1172,21 @@ py::object _fastpath_getitem_cpp(py::handle inp_hdl, py::tuple tuple_val) {
     }
 
     size_t ndim = 0;
-    try {
-        ndim = getattr(inp_hdl, "ndim").cast<size_t>();
-    } catch (py::error_already_set& err) {
-        if (use_ellipsis) {
-            throw py::index_error(
-                    "does not support Ellipsis when tensor's ndim is unknown.");
-        };
+    std::optional<ValueShape> shape;
+    if (auto* tw = TensorWrapper::try_cast(inp_hdl.ptr())) {
+        shape = tw->m_tensor->shape();
+    }
+    if (shape) {
+        ndim = shape->ndim;
+    } else {
+        try {
+            ndim = getattr(inp_hdl, "ndim").cast<size_t>();
+        } catch (py::error_already_set& err) {
+            if (use_ellipsis) {
+                throw py::index_error(
+                        "does not support Ellipsis when tensor's ndim is unknown.");
+            };
+        }
     }
 
     std::vector<std::tuple<int8_t, bool, bool, bool, bool>> cpp_items;
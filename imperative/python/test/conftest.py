@@ -55,6 +55,10 @@ def run_around_tests():
         "enable_dtr_sqrt_sampling": get_option("enable_dtr_sqrt_sampling"),
         "dtr_eviction_threshold": get_option("dtr_eviction_threshold"),
         "dtr_evictee_minimum_size": get_option("dtr_evictee_minimum_size"),
+        "dtr_eviction_policy": get_option("dtr_eviction_policy"),
+        "enable_dtr_swap": get_option("enable_dtr_swap"),
+        "enable_multi_worker": get_option("enable_multi_worker"),
+        "enable_op_fusion": get_option("enable_op_fusion"),
         "benchmark_kernel": config.benchmark_kernel,
         "deterministic_kernel": config.deterministic_kernel,
         "compute_mode": config._compute_mode,
@@ -78,6 +82,10 @@ def run_around_tests():
         "enable_dtr_sqrt_sampling": get_option("enable_dtr_sqrt_sampling"),
         "dtr_eviction_threshold": get_option("dtr_eviction_threshold"),
         "dtr_evictee_minimum_size": get_option("dtr_evictee_minimum_size"),
+        "dtr_eviction_policy": get_option("dtr_eviction_policy"),
+        "enable_dtr_swap": get_option("enable_dtr_swap"),
+        "enable_multi_worker": get_option("enable_multi_worker"),
+        "enable_op_fusion": get_option("enable_op_fusion"),
         "benchmark_kernel": config.benchmark_kernel,
         "deterministic_kernel": config.deterministic_kernel,
         "compute_mode": config._compute_mode,
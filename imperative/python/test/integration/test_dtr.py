@@ -102,6 +102,26 @@ def run_dtr_drop_copy_dev_tensor():
     mge._exit(0)
 
 
+def run_dtr_swap():
+    mge.dtr.eviction_threshold = "32MB"
+    mge.dtr.enable_swap = True
+    mge.dtr.enable()
+    x = np.random.rand(1024, 1024).astype("float32")
+    expect = [x]
+    for _ in range(16):
+        expect.append(np.exp(expect[-1] * 0.1))
+    xs = [mge.tensor(x)]
+    for _ in range(16):
+        xs.append(F.exp(xs[-1] * 0.1))
+    # read in reverse order, so the early ones are swapped in or recomputed
+    for i in reversed(range(17)):
+        np.testing.assert_allclose(xs[i].numpy(), expect[i], rtol=1e-5)
+    mge.dtr.disable()
+    mge.dtr.enable_swap = False
+    mge.dtr.eviction_threshold = 0
+    mge._exit(0)
+
+
 def run_dtr_resnet1202():
     batch_size = 6
     resnet1202 = ResNet(BasicBlock, [200, 200, 200])
@@ -163,3 +183,12 @@ def test_dtr_drop_copy_dev_tensor():
 def test_dtr_drop_tensor():
     for i in range(50):
         test_dtr_drop_copy_dev_tensor()
+
+
+@pytest.mark.require_ngpu(1)
+@pytest.mark.isolated_distributed
+def test_dtr_swap():
+    p = mp.Process(target=run_dtr_swap)
+    p.start()
+    p.join()
+    assert p.exitcode == 0
@@ -29,7 +29,9 @@ class Simple(Module):
 @pytest.mark.require_ngpu(2)
 @pytest.mark.isolated_distributed
 @pytest.mark.parametrize(
-    "threshold", [0, 128, None], ids=["no_pack", "small_pack", "large_pack"]
+    "threshold",
+    [0, 128, (128, 4096), None],
+    ids=["no_pack", "small_pack", "first_bucket", "large_pack"],
 )
 @pytest.mark.parametrize("param_shape", [(16,), (128, 256), (2, 1024, 1024)])
 def test_param_pack(param_shape, threshold, n_iters=100):
@@ -40,8 +42,16 @@ def test_param_pack(param_shape, threshold, n_iters=100):
         net = Simple(param_shape)
         opt = SGD(net.parameters(), lr=0.1)
 
-        allreduce_cb = dist.make_allreduce_cb("MEAN", dist.WORLD)
-        if threshold is not None:
+        if isinstance(threshold, tuple):
+            allreduce_cb = dist.make_allreduce_cb(
+                "MEAN",
+                dist.WORLD,
+                first_bucket_size=threshold[0],
+                bucket_size=threshold[1],
+            )
+        else:
+            allreduce_cb = dist.make_allreduce_cb("MEAN", dist.WORLD)
+        if isinstance(threshold, int):
             allreduce_cb._param_pack_thd = threshold
         gm = ad.GradManager().attach(net.parameters(), callbacks=[allreduce_cb])
 
@@ -60,3 +70,91 @@ def test_param_pack(param_shape, threshold, n_iters=100):
             np.testing.assert_equal(p.grad.numpy(), np.ones_like(p.grad.numpy()))
 
     worker()
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+def test_param_pack_grad_scaler():
+    from megengine.amp import GradScaler
+
+    param_shape = (128, 256)
+    data = np.ones(param_shape, dtype="float32")
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        net = Simple(param_shape)
+        scaler = GradScaler(init_scale=4.0)
+        allreduce_cb = dist.make_allreduce_cb("MEAN", dist.WORLD, grad_scaler=scaler)
+        allreduce_cb._param_pack_thd = 128 * 256 * 4 * 3
+        gm = ad.GradManager().attach(net.parameters(), callbacks=[allreduce_cb])
+
+        def run(x):
+            for p in net.params:
+                p.grad = None
+            with gm:
+                loss = net(tensor(x)).sum()
+                scaler.backward(gm, loss)
+
+        run(data)
+        for p in net.params:
+            np.testing.assert_equal(p.grad.numpy(), np.ones_like(p.grad.numpy()))
+        expected_norm = np.sqrt(data.size * len(net.params))
+        np.testing.assert_allclose(
+            allreduce_cb.grad_norm().numpy(), expected_norm, rtol=1e-5
+        )
+        assert scaler.scale_factor == 4.0
+
+        run(data * np.inf)
+        for p in net.params:
+            assert p.grad is None
+        assert scaler.scale_factor == 2.0
+
+    worker()
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+def test_param_pack_grad_scaler_accumulate():
+    from megengine.amp import GradScaler
+
+    param_shape = (128, 256)
+    data = np.ones(param_shape, dtype="float32")
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        net = Simple(param_shape)
+        scaler = GradScaler(init_scale=4.0)
+        allreduce_cb = dist.make_allreduce_cb("MEAN", dist.WORLD, grad_scaler=scaler)
+        allreduce_cb._param_pack_thd = 128 * 256 * 4 * 3
+        gm = ad.GradManager().attach(net.parameters(), callbacks=[allreduce_cb])
+
+        def run(*xs):
+            for p in net.params:
+                p.grad = None
+            for x in xs:
+                with gm:
+                    loss = net(tensor(x)).sum()
+                    scaler.backward(gm, loss, unscale_grad=False)
+            scaler.unscale(gm.attached_tensors())
+            scaler.update()
+
+        run(data, data)
+        for p in net.params:
+            np.testing.assert_equal(p.grad.numpy(), np.full_like(p.grad.numpy(), 2))
+        with pytest.raises(AssertionError):
+            allreduce_cb.grad_norm()
+        assert scaler.scale_factor == 4.0
+
+        # a non-finite grad of an earlier backward is not overwritten by later ones
+        run(data * np.inf, data)
+        for p in net.params:
+            assert p.grad is None
+        assert scaler.scale_factor == 2.0
+
+        run(data)
+        expected_norm = np.sqrt(data.size * len(net.params))
+        np.testing.assert_allclose(
+            allreduce_cb.grad_norm().numpy(), expected_norm, rtol=1e-5
+        )
+
+    worker()
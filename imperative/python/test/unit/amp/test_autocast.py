@@ -25,3 +25,50 @@ def test_autocast():
     amp.high_prec_dtype = origin_high
     amp.low_prec_dtype = origin_low
     check(origin_enabled, origin_low, origin_high)
+
+
+def test_autocast_cast_cache():
+    import numpy as np
+
+    import megengine.functional as F
+    from megengine import tensor
+    from megengine.functional.inplace import _inplace_add_
+
+    x = tensor(np.random.rand(4, 8).astype("float32"))
+    w = tensor(np.random.rand(8, 3).astype("float32"))
+    with amp.autocast():
+        y0 = F.matmul(x, w)
+        # the cast of w is reused
+        y1 = F.matmul(x, w)
+        np.testing.assert_equal(y0.numpy(), y1.numpy())
+        # the cached cast must not survive an inplace update
+        _inplace_add_(w, F.ones_like(w), alpha=1.0, beta=1.0)
+        y2 = F.matmul(x, w)
+        expect = np.matmul(x.numpy(), w.numpy())
+        np.testing.assert_allclose(y2.numpy(), expect, rtol=1e-2)
+        w = w + 1
+        y3 = F.matmul(x, w)
+        expect = np.matmul(x.numpy(), w.numpy())
+        np.testing.assert_allclose(y3.numpy(), expect, rtol=1e-2)
+
+
+def test_autocast_cast_cache_grad():
+    import numpy as np
+
+    import megengine.functional as F
+    from megengine import Parameter, tensor
+    from megengine.autodiff import GradManager
+
+    x = tensor(np.random.rand(4, 8).astype("float32"))
+    w = Parameter(np.random.rand(8, 3).astype("float32"))
+    gm = GradManager().attach([w])
+    expect = np.matmul(x.numpy().T, np.ones((4, 3), dtype="float32"))
+    with amp.autocast():
+        # the cast of w made in the first session must not be reused by the
+        # grad key of the second one
+        for _ in range(2):
+            with gm:
+                y = F.matmul(x, w)
+                gm.backward(y.sum())
+            np.testing.assert_allclose(w.grad.numpy(), expect, rtol=1e-2)
+            w.grad = None
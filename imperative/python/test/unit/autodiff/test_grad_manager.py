@@ -42,6 +42,22 @@ def test_basic():
     np.testing.assert_equal(b.grad.numpy(), [1])
 
 
+def test_accumulate_grad():
+    x = mge.tensor(np.random.randn(4, 3).astype("float32"))
+    w = mge.Parameter(np.random.randn(3, 2).astype("float32"))
+    gm = GradManager().attach(w)
+    expected = np.zeros((3, 2), dtype="float32")
+    for i in range(3):
+        with gm:
+            gm.backward(F.matmul(x * (i + 1), w).sum())
+        expected += x.numpy().T.sum(axis=1, keepdims=True) * (i + 1)
+        if i == 0:
+            grad = w.grad
+        # accumulated into the same tensor
+        assert w.grad is grad
+    np.testing.assert_allclose(w.grad.numpy(), expected, rtol=1e-5, atol=1e-5)
+
+
 def test_dy():
     x = mge.tensor([1.0, 3.0, 5.0]).reshape(1, 3)
     w = mge.tensor([2.0, 4.0, 6.0]).reshape(3, 1)
@@ -73,6 +73,40 @@ def test_drop_basic():
     set_option("enable_drop", False)
 
 
+def test_multi_worker():
+    set_option("enable_multi_worker", True)
+    x = mge.tensor(np.ones((3, 3)), dtype=np.float32, device="cpu0:0")
+    y = mge.tensor(np.ones((3, 3)), dtype=np.float32, device="cpu0:1")
+    # cross comp node dependency
+    z = F.matmul(x, x) + y.to("cpu0:0")
+    w = (z.to("cpu0:1") * y).sum()
+    del x, y
+    np.testing.assert_equal(z.numpy(), np.full((3, 3), 4, dtype=np.float32))
+    np.testing.assert_equal(w.numpy(), np.float32(36))
+    # the error of a worker is propagated to the users of its outputs
+    e = F.utils._simulate_error()
+    with pytest.raises(RuntimeError):
+        (e + 1).numpy()
+    set_option("enable_multi_worker", False)
+
+
+def test_op_fusion():
+    set_option("enable_op_fusion", True)
+    a = np.random.rand(64, 64).astype(np.float32)
+    b = np.random.rand(64, 64).astype(np.float32)
+    x = mge.tensor(a)
+    y = mge.tensor(b)
+    for _ in range(3):
+        # the intermediates are deleted before the worker executes them
+        z = F.relu(x * y + x) - y
+        w = F.exp(z) * 2
+    np.testing.assert_allclose(
+        w.numpy(), np.exp(np.maximum(a * b + a, 0) - b) * 2, rtol=1e-5
+    )
+    np.testing.assert_allclose(z.numpy(), np.maximum(a * b + a, 0) - b, rtol=1e-5)
+    set_option("enable_op_fusion", False)
+
+
 def test_finalize():
     prog = """
 import megengine
@@ -122,3 +156,18 @@ def test_async_error():
             F.utils._simulate_error()
     finally:
         mge.config.async_level = orig_lvl
+
+
+def test_numpy_async():
+    x = mge.tensor(np.arange(12, dtype="float32").reshape(3, 4))
+    y = F.exp(x) * 2
+    futures = [(y + i).numpy_async() for i in range(3)]
+    loss = F.sum(y).numpy_async()
+    for i, fut in enumerate(futures):
+        np.testing.assert_allclose(fut.result(), np.exp(x.numpy()) * 2 + i, rtol=1e-6)
+        assert fut.done()
+        # the value is kept after reading
+        assert fut.result() is fut.result()
+    mge._full_sync()
+    assert loss.done()
+    np.testing.assert_allclose(loss.result(), np.exp(x.numpy()).sum() * 2, rtol=1e-5)
@@ -4,6 +4,7 @@ import pickle
 from tempfile import TemporaryFile
 
 import numpy as np
+import pytest
 
 import megengine as mge
 from megengine import Parameter, Tensor
@@ -98,3 +99,35 @@ def test_compatibility():
     assert set(state.keys()) == set(
         ["qparams"]
     ), "Modify Tensor __getstate__ may break pickle serialization compatible"
+
+
+@pytest.mark.parametrize("num_shards", [1, 3])
+@pytest.mark.parametrize("mmap", [True, False])
+def test_checkpoint(tmpdir, num_shards, mmap):
+    path = str(tmpdir.join("ckpt"))
+    values = [np.random.random(size=(i + 1, 7)).astype(np.float32) for i in range(5)]
+    obj = {
+        "params": [Parameter(v) for v in values],
+        "step": 42,
+        "array": np.arange(10, dtype=np.int64),
+        "empty": Tensor(np.zeros((0, 3), dtype=np.float32)),
+        "int": Tensor(np.array([1, 2, 3], dtype=np.int32), device="cpu0"),
+    }
+    writer = mge.serialization.save_checkpoint(obj, path, num_shards=num_shards)
+    # the values are taken when the checkpoint is saved
+    obj["params"][0]._reset(Tensor(np.zeros_like(values[0])))
+    writer.wait()
+    assert writer.done()
+
+    loaded = mge.serialization.load_checkpoint(path, mmap=mmap)
+    assert loaded["step"] == 42
+    np.testing.assert_equal(loaded["array"], np.arange(10))
+    for v, p in zip(values, loaded["params"]):
+        assert isinstance(p, Parameter)
+        np.testing.assert_equal(v, p.numpy())
+    assert loaded["empty"].shape == (0, 3)
+    assert loaded["int"].dtype == np.int32
+    assert loaded["int"].device.logical_name == "cpu0:0"
+
+    loaded = mge.serialization.load_checkpoint(path, map_location="cpu1")
+    assert "cpu1" in str(loaded["params"][0].device)
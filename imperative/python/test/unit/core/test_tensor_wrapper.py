@@ -256,6 +256,42 @@ def test_tensor_construct_tensor():
     _full_sync()
 
 
+def test_tensor_from_readonly_array():
+    a = np.arange(6, dtype=np.float32).reshape(2, 3)
+    b = Tensor(a).numpy()
+    assert not b.flags.writeable
+    x = Tensor(b)
+    np.testing.assert_equal(x.numpy(), a)
+    c = np.frombuffer(a.tobytes(), dtype=np.float32).reshape(2, 3)
+    np.testing.assert_equal(Tensor(c).numpy(), a)
+    np.testing.assert_equal(Tensor(c[:, 1:]).numpy(), a[:, 1:])
+
+    # writeable arrays are still copied
+    d = a.copy()
+    y = Tensor(d)
+    d[:] = 0
+    np.testing.assert_equal(y.numpy(), a)
+    d.flags.writeable = False
+    z = Tensor(d)
+    d.flags.writeable = True
+    d[:] = 1
+    np.testing.assert_equal(z.numpy(), np.zeros_like(a))
+
+
+def test_tensor_from_scalar():
+    for i in range(3):
+        x = Tensor(1)
+        y = Tensor(1, dtype="float32")
+        z = Tensor(1.5, dtype="int32")
+        assert x.dtype == np.int32 and x.item() == 1
+        assert y.dtype == np.float32 and y.item() == 1.0
+        assert z.dtype == np.int32 and z.item() == 1
+        x += 1
+        assert x.item() == 2
+        assert Tensor(1).item() == 1
+    assert Tensor(2.5).item() == 2.5
+
+
 class TestElemwiseNone(unittest.TestCase):
     def test_elemementwise_and_with_none(self):
         with self.assertRaises(TypeError) as context:
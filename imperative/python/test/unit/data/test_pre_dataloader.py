@@ -131,6 +131,20 @@ def test_dataloader_serial():
         assert label._tuple_shape == (4,)
 
 
+@pytest.mark.parametrize("preload", [1, 3])
+@pytest.mark.parametrize("batch_size", [4, 7])
+def test_dataloader_preload_depth(preload, batch_size):
+    dataset = init_dataset()
+    sampler = SequentialSampler(dataset, batch_size=batch_size, drop_last=False)
+    expected = list(DataLoader(dataset, sampler=sampler))
+    dataloader = DataLoader(dataset, sampler=sampler, preload=preload)
+    batches = list(dataloader)
+    assert len(batches) == len(expected) == len(dataloader)
+    for (data, label), (data_expect, label_expect) in zip(batches, expected):
+        np.testing.assert_equal(data.numpy(), data_expect)
+        np.testing.assert_equal(label.numpy(), label_expect)
+
+
 @pytest.mark.skipif(
     np.__version__ >= "1.20.0",
     reason="pyarrow is incompatible with numpy vserion 1.20.0",
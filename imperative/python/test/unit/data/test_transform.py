@@ -100,3 +100,43 @@ def test_Compose():
     assert aug_data_shape == target_shape, "aug {}, target {}".format(
         aug_data_shape, target_shape
     )
+
+
+def test_BatchCompose():
+    data = generate_data()
+    t = BatchCompose(
+        [
+            BatchCenterCrop(output_size=CenterCrop_size),
+            BatchRandomHorizontalFlip(prob=1),
+            BatchToMode(mode="CHW"),
+        ]
+    )
+    aug_data = t.apply_batch(data)
+    # crop and flip move the pixels by integers, so the fused warp is exact
+    for (a, b), (image, label) in zip(aug_data, data):
+        target = image[5:95, 15:85][:, ::-1].transpose(2, 0, 1)
+        np.testing.assert_equal(a, target)
+        np.testing.assert_equal(b, label)
+
+
+def test_BatchNormalize():
+    data = generate_data()
+    mean, std = [103.530, 116.280, 123.675], [57.375, 57.120, 58.395]
+    aug_data = BatchNormalize(mean=mean, std=std).apply_batch(data)
+    target = Normalize(mean=mean, std=std).apply_batch(data)
+    for (a, _), (b, _) in zip(aug_data, target):
+        np.testing.assert_allclose(a, b, rtol=1e-5, atol=1e-5)
+
+
+def test_BatchRandomResizedCrop():
+    t = BatchCompose(
+        [
+            BatchRandomResizedCrop(output_size=RandomResizedCrop_size),
+            BatchRandomVerticalFlip(),
+        ]
+    )
+    aug_data = t.apply_batch(generate_data())
+    aug_data_shape = [(a.shape, b.shape) for a, b in aug_data]
+    target_shape = [(RandomResizedCrop_target_shape, label_shape)] * 4
+    assert aug_data_shape == target_shape
+    assert all(a.dtype == np.uint8 for a, _ in aug_data)
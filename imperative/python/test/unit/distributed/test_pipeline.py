@@ -0,0 +1,74 @@
+import numpy as np
+import pytest
+
+import megengine.autodiff as ad
+import megengine.distributed as dist
+import megengine.functional as F
+import megengine.module as M
+from megengine import tensor
+
+
+class Net(M.Module):
+    def __init__(self):
+        super().__init__()
+        self.fc0 = M.Linear(8, 6)
+        self.fc1 = M.Linear(6, 3)
+
+    def forward(self, x):
+        return self.fc1(F.relu(self.fc0(x)))
+
+
+def _loss_fn(out, label):
+    return ((out - label) ** 2).mean()
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+@pytest.mark.parametrize("schedule", ["1f1b", "gpipe"])
+@pytest.mark.parametrize("recompute", [False, True])
+def test_pipeline(schedule, recompute):
+    num_microbatches = 4
+    data = np.random.randn(16, 8).astype("float32")
+    label = np.random.randn(16, 3).astype("float32")
+    state = Net().state_dict()
+
+    net = Net()
+    net.load_state_dict(state)
+    gm = ad.GradManager().attach(net.parameters())
+    with gm:
+        # the mean of the losses of the micro-batches
+        loss = 0
+        for x, y in zip(
+            np.split(data, num_microbatches), np.split(label, num_microbatches)
+        ):
+            loss += _loss_fn(net(tensor(x)), tensor(y)) / num_microbatches
+        gm.backward(loss)
+    expected_loss = loss.numpy()
+    expected_grads = [
+        [net.fc0.weight.grad.numpy(), net.fc0.bias.grad.numpy()],
+        [net.fc1.weight.grad.numpy(), net.fc1.bias.grad.numpy()],
+    ]
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        rank = dist.get_rank()
+        model = Net()
+        model.load_state_dict(state)
+        stage = M.Sequential(model.fc0, M.ReLU()) if rank == 0 else model.fc1
+        pipe = dist.PipelineParallel(
+            stage,
+            num_microbatches,
+            loss_fn=_loss_fn,
+            schedule=schedule,
+            recompute=recompute,
+        )
+        loss = pipe.train_step(inputs=tensor(data), labels=tensor(label))
+        if rank == 1:
+            np.testing.assert_allclose(loss.numpy(), expected_loss, rtol=1e-5)
+        else:
+            assert loss is None
+        layer = model.fc0 if rank == 0 else model.fc1
+        for p, g in zip([layer.weight, layer.bias], expected_grads[rank]):
+            np.testing.assert_allclose(p.grad.numpy(), g, rtol=1e-5, atol=1e-6)
+
+    worker()
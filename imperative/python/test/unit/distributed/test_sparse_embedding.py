@@ -0,0 +1,71 @@
+import numpy as np
+import pytest
+
+import megengine.autodiff as ad
+import megengine.distributed as dist
+from megengine import tensor
+
+
+def _lookup_and_step(emb, indices, dy):
+    gm = ad.GradManager()
+    with gm:
+        out = emb(indices, gm)
+        gm.backward(out, tensor(dy))
+    emb.step()
+    return out.numpy()
+
+
+@pytest.mark.parametrize("optimizer", ["adagrad", "adam"])
+def test_sharded_embedding(optimizer):
+    emb = dist.ShardedEmbedding(10, 4, optimizer=optimizer, lr=0.1)
+    weight = emb.weight.numpy()
+    indices = np.array([[1, 3], [3, 7]], dtype=np.int32)
+    dy = np.random.randn(2, 2, 4).astype("float32")
+    out = _lookup_and_step(emb, indices, dy)
+    np.testing.assert_equal(out, weight[indices])
+
+    # the gradients of the duplicated row are summed
+    grad = np.zeros_like(weight)
+    np.add.at(grad, indices.reshape(-1), dy.reshape(-1, 4))
+    touched = np.unique(indices)
+    # the first step of both Adagrad and bias-corrected Adam
+    delta = grad / (np.sqrt(grad ** 2) + emb.eps)
+    expected = weight.copy()
+    expected[touched] -= 0.1 * delta[touched]
+    np.testing.assert_allclose(emb.weight.numpy(), expected, rtol=1e-5, atol=1e-5)
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+def test_sharded_embedding_distributed():
+    indices = [
+        np.array([0, 1, 2, 5], dtype=np.int32),
+        np.array([1, 4, 4, 6], dtype=np.int32),
+    ]
+    dy = [np.random.randn(4, 3).astype("float32") for _ in range(2)]
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        rank = dist.get_rank()
+        emb = dist.ShardedEmbedding(7, 3, lr=0.1)
+        # rank r keeps the rows r, r + 2, ...
+        weight = np.zeros((7, 3), dtype="float32")
+        weight[rank::2] = emb.weight.numpy()
+        weight = dist.functional.all_reduce_sum(tensor(weight)).numpy()
+
+        out = _lookup_and_step(emb, indices[rank], dy[rank])
+        np.testing.assert_equal(out, weight[indices[rank]])
+
+        grad = np.zeros_like(weight)
+        for i, d in zip(indices, dy):
+            np.add.at(grad, i, d)
+        touched = np.unique(np.concatenate(indices))
+        expected = weight.copy()
+        expected[touched] -= (
+            0.1 * grad[touched] / (np.sqrt(grad[touched] ** 2) + emb.eps)
+        )
+        np.testing.assert_allclose(
+            emb.weight.numpy(), expected[rank::2], rtol=1e-5, atol=1e-5
+        )
+
+    worker()
@@ -1748,3 +1748,46 @@ def test_cross():
     res = F.cross(mge.tensor(data11), mge.tensor(data12))
     dst = np.cross(data11, data12)
     np.testing.assert_allclose(res.numpy(), dst, rtol=1e-4)
+
+
+@pytest.mark.parametrize("mode", ["sum", "mean", "max"])
+def test_embedding_bag(mode):
+    np.random.seed(0)
+    weight = np.random.randn(10, 6).astype("float32")
+    indices = np.array([3, 1, 3, 0, 9, 3, 2], dtype="int32")
+    offsets = np.array([0, 3, 3, 5], dtype="int32")
+    psw = np.random.rand(len(indices)).astype("float32") if mode == "sum" else None
+    dy = np.random.randn(len(offsets), 6).astype("float32")
+
+    bounds = list(offsets) + [len(indices)]
+    expect = np.zeros((len(offsets), 6), dtype="float32")
+    expect_grad = np.zeros_like(weight)
+    for b in range(len(offsets)):
+        pos = np.arange(bounds[b], bounds[b + 1])
+        if not len(pos):
+            continue
+        rows = weight[indices[pos]]
+        if mode == "max":
+            arg = pos[np.argmax(rows, axis=0)]
+            expect[b] = rows.max(axis=0)
+            for c in range(6):
+                expect_grad[indices[arg[c]], c] += dy[b, c]
+            continue
+        coef = psw[pos] if mode == "sum" else np.full(len(pos), 1.0 / len(pos))
+        expect[b] = (rows * coef[:, None]).sum(axis=0)
+        for p, k in zip(pos, coef):
+            expect_grad[indices[p]] += dy[b] * k
+
+    w = Parameter(weight)
+    gm = GradManager().attach([w])
+    with gm:
+        out = F.nn.embedding_bag(
+            w,
+            tensor(indices),
+            tensor(offsets),
+            mode,
+            None if psw is None else tensor(psw),
+        )
+        gm.backward(out, tensor(dy))
+    _assert_allclose(out.numpy(), expect)
+    _assert_allclose(w.grad.numpy(), expect_grad)
@@ -25,7 +25,7 @@ from megengine.jit import (
     partial_trace,
     trace,
 )
-from megengine.module import Module
+from megengine.module import Linear, Module
 from megengine.random import normal, uniform
 from megengine.utils.naming import AutoNaming
 
@@ -464,6 +464,22 @@ def test_trace_reshape(trace_mode):
     f(x3)
 
 
+@pytest.mark.parametrize("symbolic_shape", [False, True])
+def test_trace_cache(symbolic_shape):
+    @trace(symbolic=True, symbolic_shape=symbolic_shape, cache_size=2)
+    def f(x):
+        return x.reshape(x.shape[0], -1) * 2
+
+    shapes = [(2, 10, 10), (4, 10, 10), (2, 10, 10), (8, 10, 10), (2, 5)]
+    for _ in range(2):
+        for shape in shapes:
+            x = np.random.randn(*shape).astype("float32")
+            y = f(tensor(x))
+            np.testing.assert_allclose(y.numpy(), x.reshape(shape[0], -1) * 2)
+    # the traces with symbolic shapes are shared by all the batch sizes
+    assert f._trace.cache_size == 2
+
+
 def test_trace_topk():
     x = tensor([5, 2, 7, 1, 0, 3, 2])
 
@@ -832,6 +848,36 @@ def test_trace_without_host(trace_mode):
     np.testing.assert_equal(rst[1], trace_rst[1])
 
 
+def test_trace_capture_step():
+    def run(capture):
+        np.random.seed(123)
+        data = np.random.randn(3, 4, 8).astype("float32")
+        model = Linear(8, 2)
+        gm = GradManager().attach(model.parameters())
+        opt = optim.SGD(model.parameters(), lr=0.1, momentum=0.9)
+
+        def step(model, opt, x):
+            with gm:
+                loss = (model(x) ** 2).mean()
+                gm.backward(loss)
+                opt.step().clear_grad()
+            return loss
+
+        if capture:
+            step = trace(
+                step, without_host=True, capture_as_const=True, capture_step=True
+            )
+        model.weight[...] = np.ones((2, 8), dtype="float32")
+        model.bias[...] = np.zeros((2,), dtype="float32")
+        losses = [step(model, opt, tensor(data[i % 3])).numpy() for i in range(6)]
+        return losses, model.weight.numpy()
+
+    expect_losses, expect_weight = run(False)
+    losses, weight = run(True)
+    np.testing.assert_allclose(losses, expect_losses, rtol=1e-5)
+    np.testing.assert_allclose(weight, expect_weight, rtol=1e-5)
+
+
 def test_trace_without_error():
     const = tensor([8.0])
 
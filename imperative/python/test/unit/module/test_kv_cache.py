@@ -0,0 +1,78 @@
+import numpy as np
+import pytest
+
+import megengine.module as M
+from megengine import tensor
+
+
+def _rotate(x, pos, rotary_dim, base):
+    # x: (num_heads, head_dim) of the token at position pos
+    x = x.copy()
+    half = rotary_dim // 2
+    inv_freq = base ** (-2.0 * np.arange(half) / rotary_dim)
+    c, s = np.cos(pos * inv_freq), np.sin(pos * inv_freq)
+    x1, x2 = x[:, :half].copy(), x[:, half:rotary_dim].copy()
+    x[:, :half] = x1 * c - x2 * s
+    x[:, half:rotary_dim] = x2 * c + x1 * s
+    return x
+
+
+def _reference(tokens, num_heads, head_dim, rotary_dim):
+    # tokens: (seqlen, 3 * num_heads * head_dim) of the whole sequence
+    qkv = tokens.reshape(len(tokens), 3, num_heads, head_dim)
+    q = np.stack([_rotate(t[0], i, rotary_dim, 10000.0) for i, t in enumerate(qkv)])
+    k = np.stack([_rotate(t[1], i, rotary_dim, 10000.0) for i, t in enumerate(qkv)])
+    v = qkv[:, 2]
+    out = np.zeros_like(q)
+    for t in range(len(tokens)):
+        score = np.einsum("hd,jhd->hj", q[t], k[: t + 1]) / np.sqrt(head_dim)
+        prob = np.exp(score - score.max(axis=1, keepdims=True))
+        prob /= prob.sum(axis=1, keepdims=True)
+        out[t] = np.einsum("hj,jhd->hd", prob, v[: t + 1])
+    return out.reshape(len(tokens), -1)
+
+
+@pytest.mark.parametrize("rotary_dim", [0, 4])
+def test_kv_cache(rotary_dim):
+    num_heads, head_dim, block_size = 2, 8, 4
+    cache = M.KVCache(
+        nr_blocks=16,
+        num_heads=num_heads,
+        head_dim=head_dim,
+        block_size=block_size,
+        rotary_dim=rotary_dim,
+    )
+    cache.add_sequence("a")
+    cache.add_sequence("b")
+    width = 3 * num_heads * head_dim
+    seqs = {
+        "a": np.random.randn(9, width).astype("float32"),
+        "b": np.random.randn(9, width).astype("float32"),
+    }
+    expected = {
+        s: _reference(x, num_heads, head_dim, rotary_dim) for s, x in seqs.items()
+    }
+
+    # prompts of different lengths, then decode steps of the two sequences
+    outs = {"a": [], "b": []}
+    for s, n in [("a", 5), ("b", 2)]:
+        outs[s].append(cache(tensor(seqs[s][None, :n]), [s]).numpy()[0])
+    for step in range(4):
+        x = np.stack([seqs["a"][5 + step], seqs["b"][2 + step]])[:, None]
+        out = cache(tensor(x), ["a", "b"]).numpy()
+        outs["a"].append(out[0])
+        outs["b"].append(out[1])
+    assert cache.length("a") == 9 and cache.length("b") == 6
+
+    np.testing.assert_allclose(
+        np.concatenate(outs["a"]), expected["a"], rtol=1e-4, atol=1e-4
+    )
+    np.testing.assert_allclose(
+        np.concatenate(outs["b"]), expected["b"][:6], rtol=1e-4, atol=1e-4
+    )
+
+    # the freed blocks are reused by a new sequence
+    cache.remove_sequence("a")
+    cache.add_sequence("c")
+    out = cache(tensor(seqs["a"][None, :3]), ["c"]).numpy()[0]
+    np.testing.assert_allclose(out, expected["a"][:3], rtol=1e-4, atol=1e-4)
@@ -0,0 +1,112 @@
+# -*- coding: utf-8 -*-
+import numpy as np
+import pytest
+
+import megengine.distributed as dist
+import megengine.functional as F
+from megengine import Tensor
+from megengine.autodiff import GradManager
+from megengine.module import (
+    ColumnParallelLinear,
+    ParallelSelfAttention,
+    RowParallelLinear,
+    VocabParallelEmbedding,
+)
+
+
+def _mlp(x, w1, b1, w2, b2):
+    return F.linear(F.relu(F.linear(x, w1, b1)), w2, b2)
+
+
+def test_tensor_parallel_single_rank():
+    # without distributed, the modules work as the unsplit ones
+    x = Tensor(np.random.randn(6, 2, 8).astype("float32"))
+    col = ColumnParallelLinear(8, 16)
+    row = RowParallelLinear(16, 8)
+    y = row(F.relu(col(x)))
+    expect = _mlp(x, col.weight, col.bias, row.weight, row.bias)
+    np.testing.assert_allclose(y.numpy(), expect.numpy(), rtol=1e-5, atol=1e-6)
+
+    emb = VocabParallelEmbedding(10, 4)
+    ids = Tensor(np.array([[1, 9], [0, 3]], dtype="int32"))
+    np.testing.assert_allclose(
+        emb(ids).numpy(), emb.weight.numpy()[ids.numpy()], rtol=1e-6
+    )
+
+    attn = ParallelSelfAttention(8, 2)
+    assert attn(x).shape == (6, 2, 8)
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+@pytest.mark.parametrize("sequence_parallel", [False, True])
+@pytest.mark.parametrize("num_chunks", [1, 2])
+def test_tensor_parallel_mlp(sequence_parallel, num_chunks):
+    seq_len, batch, hidden, ffn = 8, 2, 6, 12
+    x_np = np.random.randn(seq_len, batch, hidden).astype("float32")
+    w1_np = np.random.randn(ffn, hidden).astype("float32")
+    b1_np = np.random.randn(ffn).astype("float32")
+    w2_np = np.random.randn(hidden, ffn).astype("float32")
+    b2_np = np.random.randn(hidden).astype("float32")
+
+    params = [Tensor(v) for v in (w1_np, b1_np, w2_np, b2_np)]
+    x = Tensor(x_np)
+    gm = GradManager().attach([x] + params)
+    with gm:
+        y = _mlp(x, *params)
+        gm.backward((y ** 2).sum())
+    y_expect = y.numpy()
+    grads_expect = [t.grad.numpy() for t in [x] + params]
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        rank = dist.get_rank()
+        cols, rows = slice(rank * ffn // 2, (rank + 1) * ffn // 2), slice(None)
+        if sequence_parallel:
+            rows = slice(rank * seq_len // 2, (rank + 1) * seq_len // 2)
+        col = ColumnParallelLinear(
+            hidden, ffn, sequence_parallel=sequence_parallel, num_chunks=num_chunks
+        )
+        row = RowParallelLinear(
+            ffn, hidden, sequence_parallel=sequence_parallel, num_chunks=num_chunks
+        )
+        col.weight._reset(Tensor(w1_np[cols]))
+        col.bias._reset(Tensor(b1_np[cols]))
+        row.weight._reset(Tensor(w2_np[:, cols]))
+        row.bias._reset(Tensor(b2_np))
+
+        x = Tensor(x_np[rows])
+        gm = GradManager().attach([x] + list(col.parameters()) + list(row.parameters()))
+        with gm:
+            y = row(F.relu(col(x)))
+            gm.backward((y ** 2).sum())
+        np.testing.assert_allclose(y.numpy(), y_expect[rows], rtol=1e-5, atol=1e-5)
+        grads = [
+            (x.grad, grads_expect[0][rows]),
+            (col.weight.grad, grads_expect[1][cols]),
+            (col.bias.grad, grads_expect[2][cols]),
+            (row.weight.grad, grads_expect[3][:, cols]),
+            (row.bias.grad, grads_expect[4]),
+        ]
+        for g, e in grads:
+            np.testing.assert_allclose(g.numpy(), e, rtol=1e-4, atol=1e-4)
+
+    worker()
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+def test_vocab_parallel_embedding():
+    weight_np = np.random.randn(10, 4).astype("float32")
+    ids_np = np.array([[1, 9, 4], [0, 5, 7]], dtype="int32")
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        rank = dist.get_rank()
+        emb = VocabParallelEmbedding(10, 4)
+        assert emb.weight.shape == (5, 4)
+        emb.weight._reset(Tensor(weight_np[rank * 5 : rank * 5 + 5]))
+        out = emb(Tensor(ids_np))
+        np.testing.assert_allclose(out.numpy(), weight_np[ids_np], rtol=1e-6)
+
+    worker()
@@ -0,0 +1,53 @@
+import numpy as np
+import pytest
+
+import megengine.autodiff as ad
+import megengine.functional as F
+import megengine.module as M
+import megengine.optimizer as optim
+from megengine import tensor
+
+
+class Net(M.Module):
+    def __init__(self):
+        super().__init__()
+        self.fc0 = M.Linear(8, 16)
+        self.bn = M.BatchNorm1d(16)
+        self.fc1 = M.Linear(16, 4)
+
+    def forward(self, x):
+        return self.fc1(F.relu(self.bn(self.fc0(x))))
+
+
+def _train(make_opt, fused, state, data):
+    net = Net()
+    net.load_state_dict(state)
+    opt = make_opt(net.parameters(), fused)
+    gm = ad.GradManager().attach(net.parameters())
+    for x in data:
+        with gm:
+            loss = (net(tensor(x)) ** 2).mean()
+            gm.backward(loss)
+        opt.step().clear_grad()
+    return [p.numpy() for p in net.parameters()]
+
+
+@pytest.mark.parametrize(
+    "make_opt",
+    [
+        lambda p, fused: optim.SGD(p, lr=0.1, fused=fused),
+        lambda p, fused: optim.SGD(
+            p, lr=0.1, momentum=0.9, nesterov=True, weight_decay=1e-2, fused=fused
+        ),
+        lambda p, fused: optim.Adam(p, lr=1e-2, weight_decay=1e-2, fused=fused),
+        lambda p, fused: optim.AdamW(p, lr=1e-2, fused=fused),
+        lambda p, fused: optim.LAMB(p, lr=1e-2, weight_decay=1e-2, fused=fused),
+    ],
+)
+def test_fused_optimizer(make_opt):
+    data = [np.random.randn(4, 8).astype("float32") for _ in range(3)]
+    state = Net().state_dict()
+    expected = _train(make_opt, False, state, data)
+    actual = _train(make_opt, True, state, data)
+    for e, a in zip(expected, actual):
+        np.testing.assert_allclose(a, e, rtol=1e-4, atol=1e-5)
@@ -0,0 +1,73 @@
+import numpy as np
+import pytest
+
+import megengine.autodiff as ad
+import megengine.distributed as dist
+import megengine.functional as F
+import megengine.module as M
+import megengine.optimizer as optim
+from megengine import tensor
+
+
+class Net(M.Module):
+    def __init__(self):
+        super().__init__()
+        # odd sizes, so that the flattened parameters need padding
+        self.fc0 = M.Linear(7, 5)
+        self.fc1 = M.Linear(5, 3)
+
+    def forward(self, x):
+        return self.fc1(F.relu(self.fc0(x)))
+
+
+def _train(make_opt, state, data):
+    net = Net()
+    net.load_state_dict(state)
+    opt = make_opt(net.parameters())
+    gm = ad.GradManager().attach(net.parameters())
+    for x in data:
+        with gm:
+            loss = (net(tensor(x)) ** 2).mean()
+            gm.backward(loss)
+        opt.step().clear_grad()
+    return [p.numpy() for p in net.parameters()], opt
+
+
+@pytest.mark.parametrize("stage", [1, 2])
+def test_sharded_optimizer(stage):
+    data = [np.random.randn(4, 7).astype("float32") for _ in range(3)]
+    state = Net().state_dict()
+    expected, _ = _train(lambda p: optim.Adam(p, lr=1e-2), state, data)
+    actual, opt = _train(
+        lambda p: optim.ShardedOptimizer(optim.Adam, p, stage=stage, lr=1e-2),
+        state,
+        data,
+    )
+    for e, a in zip(expected, actual):
+        np.testing.assert_allclose(a, e, rtol=1e-5, atol=1e-6)
+    assert opt.param_groups[0]["lr"] == 1e-2
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+@pytest.mark.parametrize("stage", [1, 2])
+def test_sharded_optimizer_distributed(stage):
+    data = [np.random.randn(4, 7).astype("float32") for _ in range(3)]
+    state = Net().state_dict()
+    expected, _ = _train(lambda p: optim.Adam(p, lr=1e-2), state, data)
+    nr_params = sum(int(np.prod(v.shape)) for v in state.values())
+
+    @dist.launcher(n_gpus=2)
+    def worker():
+        actual, opt = _train(
+            lambda p: optim.ShardedOptimizer(optim.Adam, p, stage=stage, lr=1e-2),
+            state,
+            data,
+        )
+        for e, a in zip(expected, actual):
+            np.testing.assert_allclose(a, e, rtol=1e-5, atol=1e-6)
+        # each rank keeps the states of half of the parameters
+        for v in opt.optimizer._state.values():
+            assert v["exp_avg"].shape == ((nr_params + 1) // 2,)
+
+    worker()
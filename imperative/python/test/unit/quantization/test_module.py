@@ -133,7 +133,7 @@ def test_dequant_stub():
     np.testing.assert_allclose(q, fake_quant_normal.numpy())
 
 
-@pytest.mark.parametrize("kind", ["cos", "relu", "add", "mul", "fuse_add_relu"])
+@pytest.mark.parametrize("kind", ["cos", "relu", "gelu", "add", "mul", "fuse_add_relu"])
 def test_elemwise(kind):
     normal_net = Float.Elemwise(kind)
     normal_net.eval()
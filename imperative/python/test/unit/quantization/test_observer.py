@@ -14,6 +14,7 @@ from megengine.quantization.observer import (
     Observer,
     PassiveObserver,
     SyncExponentialMovingAverageObserver,
+    SyncHistogramObserver,
     SyncMinMaxObserver,
 )
 
@@ -56,6 +57,25 @@ def test_histogram_observer():
     np.testing.assert_allclose(m.max_val.numpy(), np_max)
 
 
+def test_histogram_observer_histogram():
+    # integers in [0, 15] are never on the edges of 16 bins
+    x = np.random.randint(0, 16, size=(4, 3, 8, 8)).astype("float32")
+    x[0, 0, 0, 0], x[0, 0, 0, 1] = 0, 15
+    m = HistogramObserver(bins=16)
+    m(mge.tensor(x))
+    expected, _ = np.histogram(x, 16, (0, 15))
+    np.testing.assert_equal(m.histogram.numpy(), expected)
+
+    m(mge.tensor(x * 2))
+    np.testing.assert_allclose(m.min_val.numpy(), 0, atol=1)
+    np.testing.assert_allclose(m.max_val.numpy(), 30, rtol=0.1)
+    np.testing.assert_allclose(m.histogram.numpy().sum(), x.size * 2, rtol=1e-5)
+
+    m.disable()
+    m(mge.tensor(x * 4))
+    np.testing.assert_allclose(m.max_val.numpy(), 30, rtol=0.1)
+
+
 def test_passive_observer():
     qparams = create_qparams(QuantMode.SYMMERTIC, "qint8", mge.tensor(1.0))
     m = PassiveObserver("qint8")
@@ -107,3 +127,23 @@ def test_sync_exponential_moving_average_observer():
         np.testing.assert_allclose(m.max_val.numpy(), expected_max, atol=1e-6)
 
     worker()
+
+
+@pytest.mark.require_ngpu(2)
+@pytest.mark.isolated_distributed
+def test_sync_histogram_observer():
+    word_size = get_device_count("gpu")
+    x = np.random.randint(0, 16, size=(3 * word_size, 3, 3, 3)).astype("float32")
+    x[0, 0, 0, 0], x[-1, 0, 0, 0] = 0, 15
+    expected, _ = np.histogram(x, 16, (0, 15))
+
+    @dist.launcher
+    def worker():
+        rank = dist.get_rank()
+        m = SyncHistogramObserver(bins=16)
+        y = mge.tensor(x[rank * 3 : (rank + 1) * 3])
+        m(y)
+        assert m.min_val == 0 and m.max_val == 15
+        np.testing.assert_equal(m.histogram.numpy(), expected)
+
+    worker()
@@ -656,6 +656,31 @@ def test_MultinomialRNG():
         assert all(out.shape.numpy() == np.array(expected_shape))
 
 
+def test_sample_logits():
+    probs = np.array([0.05, 0.1, 0.15, 0.3, 0.4], dtype="float32")
+    logits = Tensor(np.tile(np.log(probs), (20000, 1)))
+    m = RNG(seed=111)
+
+    def check(out, kept):
+        assert out.shape == (20000,) and out.dtype == np.int32
+        freq = np.bincount(out.numpy(), minlength=5) / 20000
+        expected = np.zeros(5)
+        expected[kept] = probs[kept] / probs[kept].sum()
+        np.testing.assert_allclose(freq, expected, atol=1e-2)
+
+    check(m.sample_logits(logits), [0, 1, 2, 3, 4])
+    check(m.sample_logits(logits, top_k=3), [2, 3, 4])
+    check(m.sample_logits(logits, top_p=0.6), [3, 4])
+    # the temperature 0.5 squares the probabilities
+    squared = probs ** 2 / (probs ** 2).sum()
+    out = m.sample_logits(logits, temperature=0.5)
+    freq = np.bincount(out.numpy(), minlength=5) / 20000
+    np.testing.assert_allclose(freq, squared, atol=1e-2)
+
+    out = m.sample_logits(Tensor([0.5, 3.0, -1.0, 2.0]), top_k=1)
+    assert out.shape == () and out.numpy() == 1
+
+
 @pytest.mark.skipif(
     get_device_count("xpu") <= 1, reason="xpu counts need > 1",
 )
@@ -96,3 +96,59 @@ def test_fuse_bn(conv_cls, bn_cls):
 
     bn_list = optimized_net.graph.get_module_by_type(M.BatchNorm2d).as_list()
     assert len(bn_list) == 0
+
+
+class MyCSEBlock(M.Module):
+    def __init__(self):
+        super().__init__()
+        self.conv = M.Conv2d(3, 3, 1)
+
+    def forward(self, x):
+        y0 = F.relu(x) * 2
+        y1 = F.relu(x) * 2
+        return self.conv(y0) + self.conv(y1)
+
+
+class MyCSEModule(M.Module):
+    def __init__(self):
+        super().__init__()
+        self.block_0 = MyCSEBlock()
+        self.block_1 = MyCSEBlock()
+
+    def forward(self, x):
+        y = self.block_0(x) + self.block_1(x)
+        z = F.relu(x) * 2 + F.relu(x) * 2
+        d0 = F.nn.dropout(x, 0.5, self.training)
+        d1 = F.nn.dropout(x, 0.5, self.training)
+        return y + z + d0 + d1
+
+
+@pytest.mark.parametrize("flatten", [True, False])
+def test_eliminate_common_subexpr(flatten):
+    module = MyCSEModule()
+    module.eval()
+    inp = mge.Tensor(np.random.random((1, 3, 8, 8)).astype("float32"))
+    traced_net = tm.trace_module(module, inp)
+    if flatten:
+        traced_net = traced_net.flatten()
+    optimized_net = tm.optimize(traced_net, "EliminateCommonSubexpr")
+
+    graph = optimized_net.graph
+    relu_list = graph.get_function_by_type(F.relu).as_list()
+    conv_calls = [
+        e for n in graph.get_module_by_type(M.Conv2d).as_list() for e in n.users
+    ]
+    dropout_list = graph.get_function_by_type(F.nn.dropout).as_list()
+    if flatten:
+        # the exprs of block_0 and block_1 are merged with the ones of the top graph
+        assert len(relu_list) == 1
+    else:
+        assert len(relu_list) == 3
+    # the two calls of conv in each block are merged
+    assert len(conv_calls) == 2
+    # random functions are never merged
+    assert len(dropout_list) == 2
+
+    np.testing.assert_allclose(
+        optimized_net(inp).numpy(), traced_net(inp).numpy(), atol=1e-5
+    )
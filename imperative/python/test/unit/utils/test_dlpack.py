@@ -0,0 +1,60 @@
+import gc
+import weakref
+
+import numpy as np
+import pytest
+
+import megengine as mge
+from megengine import is_cuda_available
+from megengine.utils.dlpack import from_dlpack, to_dlpack
+
+
+def test_dlpack_roundtrip():
+    x = mge.tensor(np.arange(12, dtype="float32").reshape(3, 4))
+    y = from_dlpack(to_dlpack(x))
+    np.testing.assert_equal(x.numpy(), y.numpy())
+    # objects implementing the protocol are accepted
+    z = mge.Tensor.from_dlpack(x)
+    np.testing.assert_equal(x.numpy(), z.numpy())
+    assert x.__dlpack_device__()[0] in (1, 2)
+
+
+def test_dlpack_numpy():
+    if not hasattr(np, "from_dlpack"):
+        pytest.skip("numpy does not support dlpack")
+    x = mge.tensor(np.arange(6, dtype="int32").reshape(2, 3), device="cpu0")
+    np.testing.assert_equal(np.from_dlpack(x), x.numpy())
+
+    a = np.arange(6, dtype="float32").reshape(2, 3)
+    np.testing.assert_equal(mge.Tensor.from_dlpack(a).numpy(), a)
+    with pytest.raises(Exception):
+        mge.Tensor.from_dlpack(a.T)
+
+
+@pytest.mark.skipif(not is_cuda_available(), reason="requires cuda")
+def test_cuda_array_interface():
+    x = mge.tensor(np.arange(6, dtype="float32").reshape(2, 3), device="gpu0")
+    desc = x.__cuda_array_interface__
+    assert desc["shape"] == (2, 3)
+    assert desc["typestr"] == "<f4"
+    assert desc["version"] == 3
+
+    class Wrapper:
+        def __init__(self, desc):
+            self.__cuda_array_interface__ = desc
+
+    y = from_dlpack(Wrapper(desc))
+    np.testing.assert_equal(y.numpy(), x.numpy())
+    assert not hasattr(mge.tensor([1.0], device="cpu0"), "__cuda_array_interface__")
+
+    # the owner is released once the imported tensor is gone, without waiting
+    # for another import
+    wrapper = Wrapper(desc)
+    ref = weakref.ref(wrapper)
+    y = from_dlpack(wrapper)
+    del wrapper
+    assert ref() is not None
+    del y
+    mge._full_sync()
+    gc.collect()
+    assert ref() is None
@@ -4,6 +4,7 @@ import os
 import sys
 import tempfile
 import threading
+import time
 
 import pytest
 
@@ -71,6 +72,33 @@ def test_profiler(format, trace_mode):
         assert scope_count > 0 and scope_count % 2 == 0
 
 
+@pytest.mark.require_ngpu(1)
+def test_profiler_keep_recent():
+    tempdir = tempfile.TemporaryDirectory()
+    profile_prefix = tempdir.name
+    format = "chrome_timeline.json"
+    profile_path = os.path.join(profile_prefix, "{}.{}".format(os.getpid(), format))
+
+    def run(name, n):
+        x = tensor([1.23], dtype="float32")
+        for _ in range(n):
+            with scope(name):
+                x = x * 1.0
+        x.numpy()
+
+    with Profiler(profile_prefix, format=format, keep_recent_ms=200):
+        run("old", 500)
+        time.sleep(0.5)
+        # enough records to trigger trimming
+        run("recent", 1500)
+
+    with open(profile_path, "r") as f:
+        events = json.load(f)["traceEvents"]
+    names = set(event.get("name") for event in events)
+    assert "recent" in names
+    assert "old" not in names
+
+
 @pytest.mark.parametrize("format", ["chrome_timeline.json", "memory_flow.svg"])
 @pytest.mark.parametrize(
     "trace_mode", [True, False, None], ids=["symbolic", "no-symbolic", "no-trace"]
@@ -1,3 +1,4 @@
+import os
 import platform
 
 import numpy as np
@@ -78,3 +79,37 @@ def test_xla_trace_random_seed_update():
     for _1st_rst, _2nd_rst, _3rd_rst in zip(_1st_rsts, _2nd_rsts, _3rd_rsts):
         assert np.all(_1st_rst.numpy() == _2nd_rst.numpy())
         assert not np.all(_1st_rst.numpy() == _3rd_rst.numpy())
+
+
+@pytest.mark.skipif(int(platform.python_version_tuple()[1]) < 8, reason="need py38")
+@pytest.mark.skipif(platform.system() != "Linux", reason="only support linux now")
+@pytest.mark.skipif(not is_cuda_available(), reason="only support cuda now")
+def test_xla_trace_compilation_cache(tmp_path, monkeypatch):
+    from megengine.xla import compile as xla_compile
+
+    monkeypatch.setenv("MGE_XLA_COMPILATION_CACHE_DIR", str(tmp_path))
+    monkeypatch.setattr(xla_compile, "_executable_cache", {})
+
+    def make_func():
+        @xla_trace(without_host=True)
+        def func(x, y):
+            return x * y + 1
+
+        return func
+
+    a = tensor(np.random.randn(4, 8), dtype="float32")
+    b = tensor(np.random.randn(4, 8), dtype="float32")
+    expect = a.numpy() * b.numpy() + 1
+
+    func0 = make_func()
+    for _ in range(2):
+        np.testing.assert_allclose(func0(a, b).numpy(), expect, rtol=1e-6)
+    dumped = [f for f in os.listdir(tmp_path) if f.startswith("xla_exec_")]
+    assert len(dumped) == 1
+
+    # a new trace of the same graph is loaded from the cache dir
+    xla_compile._executable_cache.clear()
+    func1 = make_func()
+    for _ in range(2):
+        np.testing.assert_allclose(func1(a, b).numpy(), expect, rtol=1e-6)
+    assert os.listdir(tmp_path) == dumped
@@ -16,7 +16,8 @@ MGE_WIN_DECLSPEC_FUC size_t setup_algo(
     megdnn::AlgorithmCache::Key cache_key(
             megdnn_opr->handle(), megdnn_opr->get_opr_type(), layouts.data(),
             layouts.size(), &megdnn_opr->param(), sizeof(megdnn_opr->param()));
-    auto rst = megdnn::AlgorithmCache::instance().get(cache_key);
+    auto rst = megdnn::AlgorithmCache::instance().get(
+            cache_key, megdnn_opr->algo_cache_last_entry());
     if (rst.policy.algo.valid()) {
         megdnn_opr->execution_policy() = rst.policy;
         return rst.workspace;
@@ -90,6 +90,10 @@ std::string DTRCommand::to_string() const {
     return ssprintf("DTRCommandValue{kind=%d}", (int)m_kind);
 }
 
+std::string PrefetchValue::to_string() const {
+    return "PrefetchValue";
+}
+
 std::string CreateNode::to_string() const {
     return "CreateNode";
 }
@@ -5,6 +5,38 @@
 namespace mgb {
 namespace imperative {
 
+namespace {
+
+/*!
+ * the deleter of the storages allocated for the size classes, which keeps the
+ * real storage so that it could be taken into the cache when the blob is freed
+ */
+struct CachedStorageDeleter {
+    DeviceTensorStorage::RawStorage storage;
+    size_t size;
+    void operator()(dt_byte*) {}
+};
+
+DeviceTensorStorage::RawStorage wrap_cached(
+        DeviceTensorStorage::RawStorage storage, size_t size) {
+    auto ptr = storage.get();
+    return {ptr, CachedStorageDeleter{std::move(storage), size}};
+}
+
+//! the bytes available in the storage of the blob
+size_t storage_size(const DeviceTensorStorage::RawStorage& storage, size_t size) {
+    auto deleter = std::get_deleter<CachedStorageDeleter>(storage);
+    return deleter ? deleter->size : size;
+}
+
+}  // namespace
+
+BlobManagerImpl::BlobManagerImpl() {
+    if (auto env = MGB_GETENV("MEGENGINE_BLOB_CACHE_LIMIT")) {
+        m_cache_limit = std::stoull(env);
+    }
+}
+
 BlobManagerImpl::BlobData::BlobData(OwnedBlob* in_blob) {
     blob = in_blob;
     DeviceTensorStorage d_storage;
@@ -22,8 +54,16 @@ void BlobManagerImpl::register_blob(OwnedBlob* blob) {
 
 void BlobManagerImpl::unregister_blob(OwnedBlob* blob) {
     // erase blob into the comp2blobs map
-    MGB_LOCK_GUARD(m_mtx);
-    mgb_assert(1 == m_comp2blobs_map[blob->m_comp_node].erase(blob));
+    auto& blobs_set_ptr = ([&]() -> auto& {
+        MGB_LOCK_GUARD(m_mtx);
+        return m_comp2blobs_map[blob->m_comp_node];
+    })();
+    {
+        // the blob set is also locked since it could be being compacted
+        MGB_LOCK_GUARD(blobs_set_ptr.mtx);
+        mgb_assert(1 == blobs_set_ptr.blobs_set.erase(blob));
+    }
+    cache_storage(blob);
 }
 
 void BlobManagerImpl::alloc_with_defrag(OwnedBlob* blob, size_t size) {
@@ -32,19 +72,179 @@ void BlobManagerImpl::alloc_with_defrag(OwnedBlob* blob, size_t size) {
         return;
     }
     // try alloc
-    // if fail, try defrag, alloc again
-    if (!try_alloc_direct(blob, size)) {
-        mgb_log_warn("memory allocation failed for blob; try defragmenting");
-        defrag(blob->m_comp_node);
-        alloc_direct(blob, size);
+    // if fail, merge the free memory, move a few blobs on the device, and
+    // defrag through the host at last
+    if (try_alloc_direct(blob, size)) {
+        return;
+    }
+    // the free chunks of the virtual memory allocator are remapped here, so
+    // no blob needs to be moved with it in most cases
+    CompNode::try_coalesce_all_free_memory();
+    if (try_alloc_direct(blob, size) || compact(blob, size)) {
+        return;
     }
+    mgb_log_warn("memory allocation failed for blob; try defragmenting");
+    defrag(blob->m_comp_node);
+    alloc_direct(blob, size);
 }
 
 void BlobManagerImpl::alloc_direct(OwnedBlob* blob, size_t size) {
-    mgb_assert(blob->m_comp_node.valid());
-    DeviceTensorStorage storage(blob->m_comp_node);
+    auto&& cn = blob->m_comp_node;
+    mgb_assert(cn.valid());
+    if (!m_cache_limit) {
+        DeviceTensorStorage storage(cn);
+        storage.ensure_size(size);
+        blob->m_storage = storage.raw_storage();
+        return;
+    }
+    size = size_class(size);
+    auto& cache = ([&]() -> auto& {
+        MGB_LOCK_GUARD(m_mtx);
+        return m_comp2cache_map[cn];
+    })();
+    {
+        MGB_LOCK_GUARD(cache.mtx);
+        auto iter = cache.buckets.find(size);
+        if (iter != cache.buckets.end() && !iter->second.empty()) {
+            blob->m_storage = wrap_cached(std::move(iter->second.back()), size);
+            iter->second.pop_back();
+            cache.size -= size;
+            return;
+        }
+    }
+    DeviceTensorStorage storage(cn);
     storage.ensure_size(size);
-    blob->m_storage = storage.raw_storage();
+    blob->m_storage = wrap_cached(storage.raw_storage(), size);
+}
+
+bool BlobManagerImpl::try_alloc_direct(OwnedBlob* blob, size_t size) {
+    if (BlobManager::try_alloc_direct(blob, size)) {
+        return true;
+    }
+    if (!m_cache_limit) {
+        return false;
+    }
+    // the cached storages of the other size classes may be merged by the
+    // device allocator
+    clear_cache(blob->m_comp_node);
+    return BlobManager::try_alloc_direct(blob, size);
+}
+
+size_t BlobManagerImpl::size_class(size_t size) {
+    constexpr size_t min_size = 512, nr_steps = 4;
+    if (size <= min_size) {
+        return min_size;
+    }
+    size_t base = min_size;
+    while (base * 2 < size) {
+        base *= 2;
+    }
+    size_t step = base / nr_steps;
+    return (size + step - 1) / step * step;
+}
+
+bool BlobManagerImpl::cache_storage(OwnedBlob* blob) {
+    if (!m_cache_limit || !blob->m_storage.unique()) {
+        return false;
+    }
+    auto deleter = std::get_deleter<CachedStorageDeleter>(blob->m_storage);
+    if (!deleter) {
+        return false;
+    }
+    auto size = deleter->size;
+    auto& cache = ([&]() -> auto& {
+        MGB_LOCK_GUARD(m_mtx);
+        return m_comp2cache_map[blob->m_comp_node];
+    })();
+    MGB_LOCK_GUARD(cache.mtx);
+    if (cache.size + size > m_cache_limit) {
+        return false;
+    }
+    cache.buckets[size].push_back(std::move(deleter->storage));
+    cache.size += size;
+    return true;
+}
+
+void BlobManagerImpl::clear_cache(const CompNode& cn) {
+    auto& cache = ([&]() -> auto& {
+        MGB_LOCK_GUARD(m_mtx);
+        return m_comp2cache_map[cn];
+    })();
+    decltype(cache.buckets) buckets;
+    {
+        MGB_LOCK_GUARD(cache.mtx);
+        buckets.swap(cache.buckets);
+        cache.size = 0;
+    }
+}
+
+bool BlobManagerImpl::compact(OwnedBlob* blob, size_t size) {
+    auto&& cn = blob->m_comp_node;
+    auto& blobs_set_ptr = ([&]() -> auto& {
+        MGB_LOCK_GUARD(m_mtx);
+        return m_comp2blobs_map[cn];
+    })();
+    MGB_LOCK_GUARD(blobs_set_ptr.mtx);
+    bool synced = false;
+    for (size_t step = 0; step < MAX_COMPACT_STEPS; ++step) {
+        OwnedBlob* best = nullptr;
+        size_t best_hole = 0, best_size = 0;
+        for (auto i : blobs_set_ptr.blobs_set) {
+            // the blobs borrowed by the other comp nodes may be being read on
+            // other streams, so only the ones used by their own stream move
+            if (i == blob || !i->m_storage || i->m_storage.use_count() > 1 ||
+                i->weak_from_this().use_count() != 1) {
+                continue;
+            }
+            auto begin = reinterpret_cast<size_t>(i->m_storage.get());
+            auto i_size = storage_size(i->m_storage, i->m_size);
+            auto side_info = cn.get_free_left_and_right(begin, begin + i_size);
+            if (!side_info.first && !side_info.second) {
+                continue;
+            }
+            // prefer the smallest blob to copy whose removal makes the hole
+            // large enough, otherwise the one leaving the largest hole
+            size_t hole = side_info.first + i_size + side_info.second;
+            bool better;
+            if (!best) {
+                better = true;
+            } else if (hole >= size) {
+                better = best_hole < size || i_size < best_size;
+            } else {
+                better = best_hole < size && hole > best_hole;
+            }
+            if (better) {
+                best = i;
+                best_hole = hole;
+                best_size = i_size;
+            }
+        }
+        if (!best) {
+            return false;
+        }
+        // wait all comp nodes before the first move, the same as defrag(),
+        // so that no kernel of other streams is still reading the blobs
+        if (!synced) {
+            CompNode::sync_all();
+            synced = true;
+        }
+        // the old storage is freed after the copy is issued, and it is
+        // reused in the stream order like other device memory
+        DeviceTensorStorage src, dst(cn);
+        src.reset(cn, best->m_size, best->m_storage);
+        MGB_TRY { dst.ensure_size(best_size); }
+        MGB_CATCH(MemAllocError&, { return false; })
+        dst.copy_from(src, best->m_size);
+        if (std::get_deleter<CachedStorageDeleter>(best->m_storage)) {
+            best->m_storage = wrap_cached(dst.raw_storage(), best_size);
+        } else {
+            best->m_storage = dst.raw_storage();
+        }
+        if (try_alloc_direct(blob, size)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void BlobManagerImpl::set_allocator(allocator_t allocator) {
@@ -25,15 +25,60 @@ class BlobManagerImpl final : public BlobManager {
         BlobData(OwnedBlob* in_blob);
     };
 
+    /*!
+     * \brief the storages of the freed blobs on a comp node, bucketed by size
+     *      class and reused by the blobs of the same class
+     *
+     * The storages are reused on the same comp node in stream order, so they
+     * need no synchronization, which is the same as the device allocator.
+     */
+    struct StorageCache {
+        std::mutex mtx;
+        std::unordered_map<size_t, std::vector<DeviceTensorStorage::RawStorage>>
+                buckets;
+        size_t size = 0;
+    };
+
+    //! max number of blobs moved on the device before falling back to defrag
+    static constexpr size_t MAX_COMPACT_STEPS = 4;
+
     std::mutex m_mtx;
     CompNode::UnorderedMap<BlobSetWithMux> m_comp2blobs_map;
+    CompNode::UnorderedMap<StorageCache> m_comp2cache_map;
     BlobManager::allocator_t m_custom_allocator;
+    //! max bytes cached on each comp node, set by MEGENGINE_BLOB_CACHE_LIMIT;
+    //! the blob cache is disabled if it is zero
+    size_t m_cache_limit = 0;
 
     void alloc_direct(OwnedBlob* blob, size_t size) override;
 
+    //! take the storage of the blob being unregistered into the cache
+    bool cache_storage(OwnedBlob* blob);
+
+    //! give the cached storages of the comp node back to the device allocator
+    void clear_cache(const CompNode& cn);
+
+    /*!
+     * \brief move a few blobs on the device to merge the free blocks around
+     *      them, until the blob could be allocated
+     *
+     * Unlike defrag(), the blobs are copied on the device rather than
+     * through the host, and each blob to move is the smallest one whose
+     * removal would make a large enough free block. All comp nodes are
+     * synchronized before the first move.
+     */
+    bool compact(OwnedBlob* blob, size_t size);
+
 public:
+    BlobManagerImpl();
+
     static BlobManager* inst();
 
+    //! round up to 4 classes between the powers of 2, at least 512 bytes
+    static size_t size_class(size_t size);
+
+    bool try_alloc_direct(OwnedBlob* blob, size_t size) override;
+
     void alloc_with_defrag(OwnedBlob* blob, size_t size) override;
 
     void register_blob(OwnedBlob* blob) override;
@@ -1,19 +1,50 @@
 #include "megbrain/imperative/dispatch.h"
 
+#include "megbrain/imperative/basic_operators.h"
 #include "megbrain/imperative/utils/debug.h"
 #include "megbrain/imperative/utils/helper.h"
 #include "megbrain/imperative/utils/map.h"
+#include "megbrain/utils/hash.h"
 namespace mgb {
 namespace imperative {
 namespace {
 
-ValueRefList apply_release(const Operator& op, Span<ValueRef> inputs) {
+uint64_t get_bypass_mask(
+        TransformationContext& context, const Operator& op, Span<ValueRef> inputs,
+        SmallVector<const IType*, 4> input_types) {
+    auto&& cache = context.dispatch_cache;
+    DispatchCache::Key key{op.typecode(), nullptr, std::move(input_types)};
+    if (auto* apply_op = op.as<ApplyOp>()) {
+        key.op_type = apply_op->op().dyn_typeinfo();
+    }
+    auto iter = cache.bypass_masks.find(key);
+    if (iter != cache.bypass_masks.end()) {
+        return iter->second;
+    }
+    uint64_t mask = 0;
+    auto&& transformations = context.transformations;
+    // the bottom transformation is the one that finally handles the request
+    for (size_t i = 0; i + 1 < transformations.size(); ++i) {
+        if (transformations[i]->bypass(op, inputs)) {
+            mask |= uint64_t(1) << i;
+        }
+    }
+    cache.bypass_masks.emplace(std::move(key), mask);
+    return mask;
+}
+
+ValueRefList apply_release(
+        const Operator& op, Span<ValueRef> inputs, uint64_t bypass_mask) {
     auto& context = Transformation::get_context();
     ValueRefList result;
     size_t& depth = context.next_transformation;
+    size_t saved_depth = depth;
+    while (depth < context.transformations.size() && (bypass_mask >> depth & 1)) {
+        ++depth;
+    }
     mgb_assert(depth < context.transformations.size());
     auto& transformation = *context.transformations[depth++];
-    CleanupGuard _{[&] { --depth; }};
+    CleanupGuard _{[&] { depth = saved_depth; }};
     if (context.bt != nullptr && context.record_trans_bt) {
         std::vector<std::string> types;
         for (size_t i = 0; i < inputs.size(); i++) {
@@ -63,9 +94,29 @@ ValueRefList apply(const Operator& op, Span<ValueRef> inputs) {
     static bool debug = MGB_GETENV("MGE_LOG_OP_DISPATCH");
     if (mgb_unlikely(debug)) {
         return apply_debug(op, inputs);
-    } else {
-        return apply_release(op, inputs);
     }
+    auto& context = Transformation::get_context();
+    // the skipped transformations should be recorded in backtrace
+    if (!context.dispatch_cache.enabled || context.bt != nullptr ||
+        context.transformations.size() > DispatchCache::MAX_NR_TRANSFORMATIONS) {
+        return apply_release(op, inputs, 0);
+    }
+    SmallVector<const IType*, 4> input_types(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i]) {
+            input_types[i] = &inputs[i].storage()->type();
+        }
+    }
+    return apply_release(
+            op, inputs, get_bypass_mask(context, op, inputs, std::move(input_types)));
+}
+
+size_t DispatchCache::Key::Hash::operator()(const Key& key) const {
+    size_t ret = hash_pair_combine(key.typecode, mgb::hash(key.op_type));
+    for (auto&& type : key.input_types) {
+        ret = hash_pair_combine(ret, mgb::hash(type));
+    }
+    return ret;
 }
 
 ValueRefList apply(const OpDef& def, Span<ValueRef> inputs) {
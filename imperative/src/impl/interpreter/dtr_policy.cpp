@@ -0,0 +1,401 @@
+#include "./dtr_policy.h"
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+
+#include "megbrain/exception.h"
+
+using namespace mgb;
+using namespace imperative;
+using namespace interpreter::intl;
+
+double interpreter::intl::eviction_score(
+        EvictionPolicy policy, const EvictionCandidate& cand) {
+    double cost = 1;
+    switch (policy) {
+        case EvictionPolicy::DTR:
+        case EvictionPolicy::PROFILED:
+            cost = cand.neighbor_cost;
+            break;
+        case EvictionPolicy::H_DTR_LOCAL:
+            cost = cand.compute_cost;
+            break;
+        case EvictionPolicy::LRU:
+            return 1 / ((cand.memory + cand.free_memory) / 1024.0 / 1024.0 *
+                        (cand.staleness + 1e-3));
+        default:
+            mgb_throw(MegBrainError, "invalid eviction policy: %zu", size_t(policy));
+    }
+    return (cost + 1e-3) * pow(1.0001, (double)cand.recompute_times) /
+           ((cand.memory + cand.free_memory) / 1024.0 / 1024.0 *
+            (cand.staleness + 1e-3));
+}
+
+double interpreter::intl::swap_cost(EvictionPolicy policy, double memory) {
+    double traffic = 2 * memory * HOST_LINK_SLOWDOWN;
+    if (policy == EvictionPolicy::PROFILED) {
+        return traffic / OpCostTable::BYTES_PER_US;
+    }
+    return traffic;
+}
+
+OpCostTable OpCostTable::load(const std::string& path) {
+    std::ifstream fin(path);
+    mgb_throw_if(
+            !fin, MegBrainError, "failed to open op cost table: %s", path.c_str());
+    OpCostTable table;
+    std::string line;
+    while (std::getline(fin, line)) {
+        std::istringstream sin(line);
+        double time;
+        std::string name;
+        if (!(sin >> time)) {
+            continue;
+        }
+        std::getline(sin >> std::ws, name);
+        table.set(name, time);
+    }
+    return table;
+}
+
+void DTRTrace::add_op(
+        std::string name, SmallVector<Tensor> inputs, SmallVector<Tensor> outputs) {
+    double traffic = 0;
+    for (auto&& i : inputs) {
+        traffic += i.size;
+    }
+    for (auto&& i : outputs) {
+        traffic += i.size;
+    }
+    records.push_back(
+            {std::move(name), traffic, std::move(inputs), std::move(outputs)});
+}
+
+void DTRTrace::dump(const std::string& path) const {
+    std::ofstream fout(path);
+    mgb_throw_if(!fout, MegBrainError, "failed to open trace file: %s", path.c_str());
+    fout.precision(std::numeric_limits<double>::max_digits10);
+    for (auto&& rec : records) {
+        if (rec.name.empty()) {
+            fout << "del " << rec.inputs[0].id << "\n";
+            continue;
+        }
+        fout << "op " << rec.traffic;
+        for (auto tensors : {&rec.inputs, &rec.outputs}) {
+            fout << " " << tensors->size();
+            for (auto&& i : *tensors) {
+                fout << " " << i.id << " " << i.size;
+            }
+        }
+        fout << " " << rec.name << "\n";
+    }
+}
+
+DTRTrace DTRTrace::load(const std::string& path) {
+    std::ifstream fin(path);
+    mgb_throw_if(!fin, MegBrainError, "failed to open trace file: %s", path.c_str());
+    DTRTrace trace;
+    std::string line;
+    while (std::getline(fin, line)) {
+        std::istringstream sin(line);
+        std::string kind;
+        if (!(sin >> kind)) {
+            continue;
+        }
+        Record rec;
+        if (kind == "del") {
+            uint64_t id;
+            mgb_throw_if(
+                    !(sin >> id), MegBrainError, "bad trace record: %s", line.c_str());
+            rec.inputs.push_back({id, 0});
+        } else {
+            mgb_throw_if(
+                    kind != "op", MegBrainError, "bad trace record: %s", line.c_str());
+            sin >> rec.traffic;
+            for (auto tensors : {&rec.inputs, &rec.outputs}) {
+                size_t nr = 0;
+                sin >> nr;
+                tensors->resize(nr);
+                for (auto&& i : *tensors) {
+                    sin >> i.id >> i.size;
+                }
+            }
+            mgb_throw_if(!sin, MegBrainError, "bad trace record: %s", line.c_str());
+            std::getline(sin >> std::ws, rec.name);
+            mgb_throw_if(
+                    rec.name.empty(), MegBrainError, "op without name in trace: %s",
+                    line.c_str());
+        }
+        trace.records.push_back(std::move(rec));
+    }
+    return trace;
+}
+
+namespace {
+
+class Replayer {
+public:
+    using Config = DTRSimulator::Config;
+    using Result = DTRSimulator::Result;
+
+    Replayer(const DTRTrace& trace, const Config& config)
+            : m_trace(trace), m_config(config) {}
+
+    Result run() {
+        for (size_t i = 0; i < m_trace.records.size(); ++i) {
+            auto&& rec = m_trace.records[i];
+            if (rec.name.empty()) {
+                auto iter = m_index.find(rec.inputs[0].id);
+                if (iter != m_index.end()) {
+                    auto&& t = m_tensors[iter->second];
+                    release(t);
+                    t.deleted = true;
+                }
+                continue;
+            }
+            execute(i, false);
+        }
+        return m_result;
+    }
+
+private:
+    struct TensorState {
+        size_t size;
+        //! index of the producer record, or -1 for the external inputs
+        ptrdiff_t producer = -1;
+        //! indices of the records that read the tensor
+        SmallVector<size_t> users;
+        bool resident = false, deleted = false;
+        size_t pinned = 0, recompute_times = 0;
+        double last_used = 0;
+    };
+
+    const DTRTrace& m_trace;
+    Config m_config;
+    Result m_result;
+    std::vector<TensorState> m_tensors;
+    std::unordered_map<uint64_t, size_t> m_index;
+    size_t m_memory = 0;
+    double m_clock = 0;
+
+    size_t get_tensor(const DTRTrace::Tensor& tensor) {
+        auto ins = m_index.emplace(tensor.id, m_tensors.size());
+        if (ins.second) {
+            m_tensors.push_back({});
+            m_tensors.back().size = tensor.size;
+        }
+        return ins.first->second;
+    }
+
+    double cost(size_t rec_idx) const {
+        auto&& rec = m_trace.records[rec_idx];
+        if (m_config.policy == EvictionPolicy::PROFILED && m_config.cost_table) {
+            return m_config.cost_table->get(rec.name, rec.traffic);
+        }
+        return rec.traffic;
+    }
+
+    void allocate(TensorState& t) {
+        if (!t.resident) {
+            t.resident = true;
+            m_memory += t.size;
+            m_result.peak_memory = std::max(m_result.peak_memory, m_memory);
+        }
+    }
+
+    void release(TensorState& t) {
+        if (t.resident) {
+            t.resident = false;
+            m_memory -= t.size;
+        }
+    }
+
+    bool evictable(const TensorState& t) const {
+        return t.resident && t.producer >= 0 && !t.pinned &&
+               t.size >= m_config.evictee_minimum_size;
+    }
+
+    //! sum of the costs of the evicted tensors connected to the tensor
+    double neighbor_cost(size_t idx) {
+        std::unordered_set<size_t> visited{idx};
+        SmallVector<size_t> stack{idx};
+        double ret = 0;
+        auto visit = [&](const SmallVector<DTRTrace::Tensor>& tensors) {
+            for (auto&& i : tensors) {
+                auto nbr = m_index.at(i.id);
+                auto&& t = m_tensors[nbr];
+                if (!t.resident && t.producer >= 0 && visited.insert(nbr).second) {
+                    ret += cost(t.producer);
+                    stack.push_back(nbr);
+                }
+            }
+        };
+        while (!stack.empty()) {
+            auto&& t = m_tensors[stack.back()];
+            stack.pop_back();
+            auto&& producer = m_trace.records[t.producer];
+            visit(producer.inputs);
+            visit(producer.outputs);
+            for (auto user : t.users) {
+                visit(m_trace.records[user].outputs);
+            }
+        }
+        return ret;
+    }
+
+    bool evict_one() {
+        ptrdiff_t best = -1;
+        double best_score = 0;
+        for (size_t i = 0; i < m_tensors.size(); ++i) {
+            auto&& t = m_tensors[i];
+            if (!evictable(t)) {
+                continue;
+            }
+            EvictionCandidate cand;
+            cand.memory = t.size;
+            cand.compute_cost = cost(t.producer);
+            cand.staleness = m_clock - t.last_used;
+            cand.recompute_times = t.recompute_times;
+            if (m_config.policy == EvictionPolicy::DTR ||
+                m_config.policy == EvictionPolicy::PROFILED) {
+                cand.neighbor_cost = neighbor_cost(i);
+            }
+            auto score = eviction_score(m_config.policy, cand);
+            if (best < 0 || score < best_score) {
+                best = i;
+                best_score = score;
+            }
+        }
+        if (best < 0) {
+            return false;
+        }
+        release(m_tensors[best]);
+        ++m_result.nr_evictions;
+        return true;
+    }
+
+    //! make the tensor resident, and pin it until the op reading it finishes
+    void require(size_t idx) {
+        auto&& t = m_tensors[idx];
+        ++t.pinned;
+        if (!t.resident) {
+            if (t.producer < 0) {
+                allocate(t);
+            } else {
+                ++t.recompute_times;
+                execute(t.producer, true);
+            }
+        }
+    }
+
+    //! the deleted tensors are only materialized when being required
+    bool needed(const TensorState& t) const { return !t.deleted || t.pinned; }
+
+    void execute(size_t rec_idx, bool recompute) {
+        auto&& rec = m_trace.records[rec_idx];
+        SmallVector<size_t> inputs, outputs;
+        for (auto&& i : rec.inputs) {
+            inputs.push_back(get_tensor(i));
+        }
+        for (auto&& i : rec.outputs) {
+            outputs.push_back(get_tensor(i));
+        }
+        for (auto i : inputs) {
+            if (!recompute) {
+                m_tensors[i].users.push_back(rec_idx);
+            }
+            require(i);
+        }
+        // the outputs are pinned, so the resident ones are not evicted for the
+        // others
+        size_t required = 0;
+        SmallVector<bool> allocated;
+        for (auto i : outputs) {
+            auto&& t = m_tensors[i];
+            if (!recompute) {
+                t.producer = rec_idx;
+            }
+            allocated.push_back(needed(t));
+            if (!t.resident && allocated.back()) {
+                required += t.size;
+            }
+            ++t.pinned;
+        }
+        while (m_config.eviction_threshold > 0 &&
+               m_memory + required > m_config.eviction_threshold) {
+            if (!evict_one()) {
+                m_result.exceeded = true;
+                break;
+            }
+        }
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            auto&& t = m_tensors[outputs[i]];
+            --t.pinned;
+            if (allocated[i]) {
+                allocate(t);
+                t.last_used = m_clock;
+            }
+        }
+        auto c = cost(rec_idx);
+        m_clock += c;
+        if (recompute) {
+            m_result.recompute_cost += c;
+            ++m_result.nr_recomputations;
+        } else {
+            m_result.compute_cost += c;
+        }
+        for (auto i : inputs) {
+            auto&& t = m_tensors[i];
+            t.last_used = m_clock;
+            if (!--t.pinned && t.deleted) {
+                release(t);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+DTRSimulator::Result DTRSimulator::run(const DTRTrace& trace, const Config& config) {
+    return Replayer{trace, config}.run();
+}
+
+std::pair<DTRSimulator::Config, DTRSimulator::Result> DTRSimulator::search(
+        const DTRTrace& trace, size_t memory_limit,
+        const std::vector<EvictionPolicy>& policies,
+        const std::vector<size_t>& thresholds, const OpCostTable* cost_table) {
+    mgb_assert(!policies.empty() && !thresholds.empty());
+    std::pair<Config, Result> best;
+    bool found = false, best_fits = false;
+    for (auto policy : policies) {
+        for (auto threshold : thresholds) {
+            Config config;
+            config.policy = policy;
+            config.eviction_threshold = threshold;
+            config.cost_table = cost_table;
+            auto result = run(trace, config);
+            bool fits = !result.exceeded && result.peak_memory <= memory_limit;
+            bool better;
+            if (!found || fits != best_fits) {
+                better = !found || fits;
+            } else if (fits) {
+                auto overhead = result.overhead(),
+                     best_overhead = best.second.overhead();
+                better = overhead < best_overhead ||
+                         (overhead == best_overhead &&
+                          threshold < best.first.eviction_threshold);
+            } else {
+                better = result.peak_memory < best.second.peak_memory;
+            }
+            if (better) {
+                best = {config, result};
+                found = true;
+                best_fits = fits;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "megbrain/utils/small_vector.h"
+
+namespace mgb::imperative::interpreter::intl {
+
+/*!
+ * \brief the heuristics to select the tensor to evict in DTR
+ *
+ * Each policy scores the candidates and the one with the lowest score is
+ * evicted. The value is taken by the option dtr_eviction_policy.
+ */
+enum class EvictionPolicy : size_t {
+    //! cost of the evicted neighborhood / (memory * staleness)
+    DTR = 0,
+    //! like DTR, but only the cost of the tensor itself is considered, so the
+    //! evicted components need not be tracked
+    H_DTR_LOCAL = 1,
+    //! the least recently used tensor weighted by its memory
+    LRU = 2,
+    //! like DTR, but the costs are taken from the table of profiled op times
+    PROFILED = 3,
+};
+
+//! the statistics of a candidate that the eviction policies score on
+struct EvictionCandidate {
+    //! bytes of the tensor, and the free bytes adjacent to its storage
+    double memory = 0, free_memory = 0;
+    //! cost to recompute the tensor itself and its evicted neighborhood
+    double compute_cost = 0, neighbor_cost = 0;
+    //! time elapsed since the tensor was last used
+    double staleness = 0;
+    size_t recompute_times = 0;
+};
+
+//! score of the candidate, where the one with the lowest score is evicted
+double eviction_score(EvictionPolicy policy, const EvictionCandidate& cand);
+
+/*!
+ * \brief cost of swapping a tensor out to the host and back, in the same unit
+ *      as the recompute cost given by the policy
+ *
+ * The copies are assumed to be HOST_LINK_SLOWDOWN times slower than accessing
+ * the same bytes in the device memory.
+ */
+double swap_cost(EvictionPolicy policy, double memory);
+constexpr double HOST_LINK_SLOWDOWN = 16;
+
+/*!
+ * \brief the time of the ops in microseconds, e.g. profiled by fastrun
+ *
+ * The table is loaded from a text file whose lines are "<time> <op name>",
+ * and the op name is the rest of the line.
+ */
+class OpCostTable {
+public:
+    //! throughput assumed to convert the memory traffic of an op missing in
+    //! the table to its time
+    static constexpr double BYTES_PER_US = 1e4;
+
+    static OpCostTable load(const std::string& path);
+
+    void set(const std::string& name, double time) { m_time[name] = time; }
+
+    //! time of the op, estimated from its memory traffic if not profiled
+    double get(const std::string& name, double traffic) const {
+        auto iter = m_time.find(name);
+        return iter == m_time.end() ? traffic / BYTES_PER_US : iter->second;
+    }
+
+    bool empty() const { return m_time.empty(); }
+
+private:
+    std::unordered_map<std::string, double> m_time;
+};
+
+/*!
+ * \brief the ops and deletions executed by the interpreter, which can be
+ *      replayed by DTRSimulator
+ *
+ * Tensors are identified by their ids. The inputs which are not produced by
+ * any op (e.g. parameters) stay in memory during the whole replay.
+ */
+struct DTRTrace {
+    struct Tensor {
+        uint64_t id;
+        size_t size;
+    };
+    struct Record {
+        //! an op if name is not empty, otherwise the deletion of inputs[0]
+        std::string name;
+        //! memory traffic of the op in bytes
+        double traffic = 0;
+        SmallVector<Tensor> inputs, outputs;
+    };
+
+    std::vector<Record> records;
+
+    void add_op(
+            std::string name, SmallVector<Tensor> inputs, SmallVector<Tensor> outputs);
+    void add_del(uint64_t id) { records.push_back({{}, 0, {{id, 0}}, {}}); }
+
+    //! one record per line: "op <traffic> <nr inputs> <id size>... <nr outputs>
+    //! <id size>... <name>" or "del <id>"
+    void dump(const std::string& path) const;
+    static DTRTrace load(const std::string& path);
+};
+
+/*!
+ * \brief replay a DTRTrace offline, to pick the eviction policy and threshold
+ *      for a model
+ *
+ * Tensors are evicted before each op until the memory usage plus the size of
+ * the outputs is within the threshold, and are recomputed recursively when
+ * needed. Different from the interpreter, the cost of the evicted neighborhood
+ * is computed exactly.
+ */
+class DTRSimulator {
+public:
+    struct Config {
+        EvictionPolicy policy = EvictionPolicy::DTR;
+        size_t eviction_threshold = 0;
+        size_t evictee_minimum_size = 1048576;
+        //! used by EvictionPolicy::PROFILED
+        const OpCostTable* cost_table = nullptr;
+    };
+
+    struct Result {
+        //! the cost of the ops in the trace, and of the recomputations
+        double compute_cost = 0, recompute_cost = 0;
+        size_t peak_memory = 0, nr_evictions = 0, nr_recomputations = 0;
+        //! whether the threshold is exceeded since no tensor can be evicted
+        bool exceeded = false;
+
+        //! ratio of the total cost to that without recomputation
+        double overhead() const {
+            return compute_cost > 0 ? (compute_cost + recompute_cost) / compute_cost
+                                    : 1;
+        }
+    };
+
+    static Result run(const DTRTrace& trace, const Config& config);
+
+    /*!
+     * \brief find the config with the least overhead whose peak memory does not
+     *      exceed \p memory_limit, preferring the lower thresholds on ties
+     *
+     * If no config fits in the limit, the one with the lowest peak memory is
+     * returned, so the caller should check the peak memory of the result.
+     */
+    static std::pair<Config, Result> search(
+            const DTRTrace& trace, size_t memory_limit,
+            const std::vector<EvictionPolicy>& policies,
+            const std::vector<size_t>& thresholds,
+            const OpCostTable* cost_table = nullptr);
+};
+
+}  // namespace mgb::imperative::interpreter::intl
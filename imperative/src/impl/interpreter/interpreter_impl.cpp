@@ -3,6 +3,7 @@
 #include "range/v3/all.hpp"
 
 #include "megbrain/common.h"
+#include "megbrain/comp_node_env.h"
 #include "megbrain/imperative/opr_utility.h"
 #include "megbrain/imperative/ops/autogen.h"
 #include "megbrain/imperative/ops/backward_graph.h"
@@ -27,6 +28,54 @@ auto tinfo_to_tid(SmallVector<TensorInfo*> tinfo) {
     }
     return tid;
 };
+
+//! the channel whose comp node worker runs on this thread
+thread_local ChannelImpl* tl_device_worker_owner = nullptr;
+
+//! the structure of a fused group, so that its compiled graph could be reused
+struct FusionGroupKey final : Hashable {
+    Subgraph graph;
+
+    explicit FusionGroupKey(Subgraph graph) : graph{std::move(graph)} {}
+
+    size_t hash() const override {
+        size_t ret = 0;
+        auto hash_vars = [&](const Subgraph::vars_t& vars) {
+            for (auto var : vars) {
+                ret = hash_pair_combine(ret, var);
+            }
+        };
+        hash_vars(graph.inputs);
+        for (auto&& expr : graph.exprs) {
+            ret = hash_pair_combine(ret, expr.op->hash());
+            hash_vars(expr.inputs);
+            hash_vars(expr.outputs);
+        }
+        hash_vars(graph.outputs);
+        return ret;
+    }
+
+protected:
+    bool is_same_st(const Hashable& rhs) const override {
+        auto&& rhs_graph = rhs.cast_final_safe<FusionGroupKey>().graph;
+        if (graph.inputs != rhs_graph.inputs || graph.outputs != rhs_graph.outputs ||
+            graph.exprs.size() != rhs_graph.exprs.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < graph.exprs.size(); ++i) {
+            auto &&lhs_expr = graph.exprs[i], &&rhs_expr = rhs_graph.exprs[i];
+            if (!lhs_expr.op->is_same(*rhs_expr.op) ||
+                lhs_expr.inputs != rhs_expr.inputs ||
+                lhs_expr.outputs != rhs_expr.outputs) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+};
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(FusionGroupKey);
 }  // namespace
 
 namespace mgb {
@@ -110,6 +159,17 @@ void ChannelImpl::WorkQueue::on_async_queue_worker_thread_start() {
     OpDef::set_allocator(custom_allocator);
 }
 
+void ChannelImpl::DeviceWorkQueue::on_async_queue_worker_thread_start() {
+    sys::set_thread_name("device_worker");
+    tl_device_worker_owner = m_owner;
+    auto custom_allocator = [owner = m_owner](CompNode device, size_t size) {
+        auto blob = Blob::make(device, size);
+        owner->alloc_tensor_with_evict(blob.get());
+        return blob->storage();
+    };
+    OpDef::set_allocator(custom_allocator);
+}
+
 // Do not use m_xxx_state directly
 #define m_channel_state
 #define m_worker_state
@@ -384,6 +444,10 @@ void ChannelImpl::dispatch_kernel(
     auto& bt = get_backtrace();
     ApplyOp cmd{Profiler::next_id(),     std::move(op), std::move(input_infos),
                 std::move(output_infos), validated,     bt};
+    if (options.enable_dtr_auto_drop && options.enable_dtr_swap) {
+        MGB_LOCK_GUARD(m_swap_lookahead.mtx);
+        m_swap_lookahead.inputs.emplace_back(cmd.id, cmd.inputs);
+    }
     if (Profiler::is_profiling()) {
         auto op_info_getter = [op = cmd.op, bt = cmd.bt] {
             std::unordered_map<std::string, std::string> op_info;
@@ -507,6 +571,40 @@ HostTensorND ChannelImpl::get_value(Handle handle) {
     return ret;
 }
 
+bool ChannelImpl::prefetch_value(Handle handle) {
+    MGB_LOCK_GUARD(m_spin);
+    assert_available();
+    mgb_assert(
+            m_valid_handle.find(handle) != m_valid_handle.end(), "invalid handle: %p",
+            handle);
+    auto info = reinterpret_cast<TensorInfo*>(handle);
+    mgb_assert(!info->invalid, "tensor is unusable due to previous error");
+    {
+        MGB_LOCK_GUARD(m_mutex);
+        check_worker_exc_unsafe();
+        if (info->ptr && info->ptr->value_fetched()) {
+            // the copy is queued on the device, check its event
+            return info->ptr->try_get_value() != nullptr;
+        }
+    }
+    if (!info->value_prefetched) {
+        // the worker copies the value into the host memory asynchronously, which
+        // is pinned on the devices supporting it
+        if (Profiler::is_profiling()) {
+            m_worker.add_task(
+                    {Profiler::next_id(), GetValue{info},
+                     get_channel_state().stack_manager.dump()});
+        } else {
+            m_worker.add_task({
+                    Profiler::next_id(),
+                    GetValue{info},
+            });
+        }
+        info->value_prefetched = true;
+    }
+    return false;
+}
+
 TensorShape ChannelImpl::get_shape(Handle handle) {
     MGB_LOCK_GUARD(m_spin);
     assert_available();
@@ -566,6 +664,10 @@ void ChannelImpl::sync() {
 
 void ChannelImpl::sync_impl() {
     m_worker.wait_all_task_finish();
+    // the main worker is idle, so no more commands would be routed
+    for (auto&& i : m_device_workers) {
+        i.second->wait_all_task_finish();
+    }
     MGB_LOCK_GUARD(m_mutex);
     check_worker_exc_unsafe();
 }
@@ -582,6 +684,9 @@ void ChannelImpl::close() {
     mgb_assert(m_valid_handle.empty());
     mgb_log_debug("%ld tensor exists before channel close", (long)valid_handles.size());
     sync_impl();
+    if (!m_dtr.trace.records.empty()) {
+        m_dtr.trace.dump(m_dtr.trace_path);
+    }
     m_status = ChannelRunningStatus::CLOSED;
 }
 
@@ -665,6 +770,95 @@ void ChannelImpl::do_drop(TensorInfo* ptr, bool user = false) {
     release_tensor(ptr);
 }
 
+bool ChannelImpl::should_swap(TensorInfo* ptr) {
+    auto& state = get_worker_state();
+    if (ptr->ptr->comp_node().device_type() == CompNode::DeviceType::CPU) {
+        return false;
+    }
+    auto limit = state.options.dtr_swap_host_limit;
+    if (limit > 0 && m_dtr.swapped_memory + ptr->memory > limit) {
+        return false;
+    }
+    auto policy = EvictionPolicy(state.options.dtr_eviction_policy);
+    double recompute_cost = ptr->compute_time + m_dtr.estimate_neighbor_cost(ptr);
+    return swap_cost(policy, ptr->memory) < recompute_cost;
+}
+
+void ChannelImpl::do_swap_out(TensorInfo* ptr) {
+    auto cn = ptr->ptr->comp_node();
+    auto copy_cn = cn.change_stream(CompNode::Stream::COPY);
+    // the copy stream waits for the producer of the tensor
+    device_wait_event(copy_cn, cn, record_event(cn, true));
+    auto dv = ptr->ptr->dev_tensor();
+    dv.comp_node(copy_cn);
+    // the host tensor on the device comp node is in the pinned memory
+    ptr->h_swap = HostTensorND{copy_cn, dv.layout()};
+    ptr->h_swap.copy_from_fixlayout(dv);
+    m_dtr.swapped_memory += ptr->h_swap.layout().span().dist_byte();
+    // the device memory is not reused until the copy finishes
+    async_release(copy_cn, record_event(copy_cn, true), ptr->ptr->blob());
+    ptr->evict_type = EvictType::SWAP;
+    ptr->status = TensorInfo::Swapped;
+    release_tensor(ptr);
+}
+
+void ChannelImpl::swap_in(TensorInfo* dest) {
+    mgb_assert(dest->evict_type == EvictType::SWAP && !dest->ptr);
+    auto&& host = dest->h_swap;
+    auto cn = dest->desc.comp_node;
+    auto copy_cn = cn.change_stream(CompNode::Stream::COPY);
+    auto tensor = Tensor::make(host.layout(), cn);
+    auto dv = tensor->dev_tensor();
+    // the memory may be just released by the kernels on the compute stream
+    device_wait_event(copy_cn, cn, record_event(cn, true));
+    dv.comp_node(copy_cn);
+    dv.copy_from_fixlayout(host);
+    auto event = record_event(copy_cn, true);
+    m_dtr.swapped_memory -= host.layout().span().dist_byte();
+    async_release(copy_cn, event, host);
+    host = {};
+    {
+        // the compute stream waits for the copy when the tensor is read, so the
+        // prefetched copies overlap with the kernels before it
+        MGB_LOCK_GUARD(m_mutex);
+        dest->swap_event = event;
+    }
+    produce_tensor(dest, std::move(tensor));
+}
+
+void ChannelImpl::wait_swap_in_unsafe(TensorInfo* dest) {
+    if (dest->swap_event && dest->ptr) {
+        auto cn = dest->ptr->comp_node();
+        device_wait_event(
+                cn, cn.change_stream(CompNode::Stream::COPY), dest->swap_event);
+        dest->swap_event = 0;
+    }
+}
+
+void ChannelImpl::prefetch_swapped(uint64_t apply_id) {
+    auto& state = get_worker_state();
+    SmallVector<TensorInfo*> swapped;
+    {
+        MGB_LOCK_GUARD(m_swap_lookahead.mtx);
+        auto&& inputs = m_swap_lookahead.inputs;
+        while (!inputs.empty() && inputs.front().first <= apply_id) {
+            inputs.pop_front();
+        }
+        size_t depth = std::min(inputs.size(), state.options.swap_prefetch_depth);
+        for (size_t i = 0; i < depth; ++i) {
+            for (auto input : inputs[i].second) {
+                if (!input->ptr && input->evict_type == EvictType::SWAP &&
+                    count(swapped, input) == 0) {
+                    swapped.push_back(input);
+                }
+            }
+        }
+    }
+    for (auto input : swapped) {
+        swap_in(input);
+    }
+}
+
 void ChannelImpl::free(TensorInfo* ptr) {
     auto& state = get_worker_state();
     if (state.options.enable_dtr_auto_drop) {
@@ -708,6 +902,12 @@ void ChannelImpl::real_free(TensorInfo* ptr) {
     }
     detach_users(ptr);
     ptr->detach_producer();
+    if (!ptr->h_swap.empty()) {
+        m_dtr.swapped_memory -= ptr->h_swap.layout().span().dist_byte();
+        // the host memory may be read by a pending swap in
+        async_release(ptr->h_swap);
+        ptr->h_swap = {};
+    }
     bool has_value = ptr->ptr != nullptr;
     if (has_value) {
         MGB_RECORD_EVENT(TensorReleaseEvent, ptr->id);
@@ -722,6 +922,12 @@ std::unordered_set<ChannelImpl*> ChannelImpl::m_all_active_channels{};
 MGB_MUTEX ChannelImpl::m_all_active_channels_mutex{};
 
 ChannelImpl::ChannelImpl() : m_worker(this) {
+    if (const char* path = MGB_GETENV("MEGENGINE_DTR_OP_COST_TABLE")) {
+        m_dtr.cost_table = OpCostTable::load(path);
+    }
+    if (const char* path = MGB_GETENV("MEGENGINE_DTR_TRACE_FILE")) {
+        m_dtr.trace_path = path;
+    }
     MGB_LOCK_GUARD(m_all_active_channels_mutex);
     m_all_active_channels.emplace(this);
 }
@@ -770,7 +976,9 @@ void ChannelImpl::release_tensor(TensorInfo* dest) {
 }
 
 void ChannelImpl::regenerate(TensorInfo* dest) {
-    if (dest->evict_type == EvictType::DROP) {
+    if (dest->evict_type == EvictType::SWAP) {
+        swap_in(dest);
+    } else if (dest->evict_type == EvictType::DROP) {
         auto&& path = dest->producer;
         m_apply_stack.push(
                 {ApplyOp{path->id, path->op, path->inputs, path->outputs}, 0, dest,
@@ -786,6 +994,8 @@ void ChannelImpl::do_apply_op(const ApplyOp& cmd, std::string reason) {
     auto& state = get_worker_state();
     bool profiling_device =
             Profiler::is_profiling() && Profiler::get_option("profile_device", 0);
+    bool profiling_hw_counter = Profiler::is_profiling() &&
+                                Profiler::get_option("profile_hw_counter", 0);
     uint64_t apply_id = cmd.id;
     SmallVector<TensorPtr> inputs;
     inputs.reserve(cmd.inputs.size());
@@ -796,6 +1006,12 @@ void ChannelImpl::do_apply_op(const ApplyOp& cmd, std::string reason) {
         // tensor_inputs.push_back(i->ptr);
         inputs.push_back(i->ptr);
     }
+    if (state.options.enable_dtr_swap) {
+        MGB_LOCK_GUARD(m_mutex);
+        for (auto i : cmd.inputs) {
+            wait_swap_in_unsafe(i);
+        }
+    }
     if (state.options.enable_dtr_auto_drop &&
         state.options.dtr_eviction_threshold > 0) {
         auto_evict(0);
@@ -845,7 +1061,7 @@ void ChannelImpl::do_apply_op(const ApplyOp& cmd, std::string reason) {
     };
     MGB_RECORD_EVENT(OpExecuteEvent, apply_id, {}, reason);
     SmallVector<std::pair<CompNode, uint64_t>> kernels;
-    if (profiling_device) {
+    if (profiling_device || profiling_hw_counter) {
         // Collecting devices
         SmallVector<CompNode> devices;
         for (auto&& i : concat(cmd.inputs, cmd.outputs)) {
@@ -864,11 +1080,25 @@ void ChannelImpl::do_apply_op(const ApplyOp& cmd, std::string reason) {
     // Before wait
     // TODO: split operator wait and execute so that OpWait could be corrected recorded.
     // Before execute
+    // the kernels on cpu run on the dispatcher thread of the comp node, so the
+    // hardware counters are read there
+    SmallVector<std::shared_ptr<HWCounter::Value>> hw_counter_starts;
     for (auto&& [device, kernel_id] : kernels) {
         MGB_RECORD_EVENT(KernelLaunchEvent, apply_id, kernel_id, device);
         MGB_RECORD_EVENT_IF(
                 (Profiler::get_option("profile_device", 0)), RecordDeviceEvent,
                 Timer::record_device(device));
+        std::shared_ptr<HWCounter::Value> start;
+        if (profiling_hw_counter &&
+            device.device_type() == CompNode::DeviceType::CPU) {
+            start = std::make_shared<HWCounter::Value>();
+            CompNodeEnv::from_comp_node(device).cpu_env().dispatch([start] {
+                if (auto counter = HWCounter::get()) {
+                    *start = counter->read();
+                }
+            });
+        }
+        hw_counter_starts.push_back(start);
     }
     // Apply op
     SmallVector<LogicalTensorDesc> output_descs;
@@ -889,6 +1119,19 @@ void ChannelImpl::do_apply_op(const ApplyOp& cmd, std::string reason) {
             apply_on_physical_tensor, *cmd.op, std::move(inputs), output_descs,
             validated);
     // After execute
+    for (size_t i = 0; i < kernels.size(); ++i) {
+        if (auto start = hw_counter_starts[i]) {
+            auto [device, kernel_id] = kernels[i];
+            CompNodeEnv::from_comp_node(device).cpu_env().dispatch(
+                    [start, device = device, kernel_id = kernel_id] {
+                        if (auto counter = HWCounter::get()) {
+                            MGB_RECORD_EVENT(
+                                    HWCounterEvent, kernel_id, device,
+                                    counter->read() - *start);
+                        }
+                    });
+        }
+    }
     for (auto&& [device, kernel_id] : kernels) {
         MGB_RECORD_EVENT_IF(
                 (Profiler::get_option("profile_device", 0)), RecordDeviceEvent,
@@ -922,9 +1165,12 @@ void ChannelImpl::do_apply_op(const ApplyOp& cmd, std::string reason) {
             estimate_compute_time += i->blob()->size();
         }
         m_dtr.estimate_timestamp += estimate_compute_time / 1e8;
+        auto compute_cost = m_dtr.estimate_compute_cost(
+                *cmd.op, estimate_compute_time,
+                EvictionPolicy(state.options.dtr_eviction_policy));
         for (auto i : cmd.outputs) {
             if (i != nullptr) {
-                i->compute_time = estimate_compute_time;
+                i->compute_time = compute_cost;
             }
         }
         auto& state = get_worker_state();
@@ -996,7 +1242,9 @@ bool ChannelImpl::auto_evict(size_t force_num) {
            force_num > 0) {
         MGB_RECORD_EVENT(AutoEvictEvent);
         sample_on_device(m_dtr.comp_node, false);
-        auto best = m_dtr.find_best_tensor(state.options.enable_dtr_sqrt_sampling);
+        auto best = m_dtr.find_best_tensor(
+                state.options.enable_dtr_sqrt_sampling,
+                EvictionPolicy(state.options.dtr_eviction_policy));
         if (!best) {
             MGB_RECORD_EVENT(AutoEvictFinishEvent);
             break;
@@ -1008,7 +1256,11 @@ bool ChannelImpl::auto_evict(size_t force_num) {
             }
             flag = true;
         }
-        do_drop(best);
+        if (state.options.enable_dtr_swap && should_swap(best)) {
+            do_swap_out(best);
+        } else {
+            do_drop(best);
+        }
         if (best->evict_type == EvictType::DROP) {
             m_dtr.update_dsu_after_evict(best);
         }
@@ -1112,6 +1364,7 @@ TensorPtr ChannelImpl::wait_tensor(TensorInfo* info, TensorProp prop) {
         });
     }
     auto ptr = info->ptr;
+    wait_swap_in_unsafe(info);
     MGB_RECORD_EVENT(
             TensorWaitPropFinishEvent, info->id, m_waitee_id, prop, backtrace_getter);
     m_waitee = nullptr;
@@ -1198,6 +1451,265 @@ void ChannelImpl::alloc_tensor_with_evict(OwnedBlob* x) {
     set_log_level(pre_level);
 }
 
+void ChannelImpl::dispatch_one_task(Command& icmd) {
+    if (fuse_one_task(icmd)) {
+        return;
+    }
+    auto& options = get_worker_state().options;
+    bool multi_worker = options.enable_multi_worker && !options.enable_drop &&
+                        !options.enable_dtr_auto_drop;
+    if (!multi_worker && m_device_workers.empty()) {
+        process_one_task(icmd);
+        return;
+    }
+    CompNode target;
+    SmallVector<TensorInfo*> uses;
+    std::visit(
+            [&](const auto& cmd) {
+                using T = std::decay_t<decltype(cmd)>;
+                if constexpr (std::is_same_v<T, ApplyOp>) {
+                    uses.append(cmd.inputs.begin(), cmd.inputs.end());
+                    uses.append(cmd.outputs.begin(), cmd.outputs.end());
+                    if (!cmd.outputs.empty() && cmd.outputs[0]) {
+                        target = cmd.outputs[0]->desc.comp_node;
+                    }
+                } else if constexpr (std::is_same_v<T, Put>) {
+                    uses.push_back(cmd.dest);
+                    target = cmd.dest->desc.comp_node;
+                } else if constexpr (
+                        std::is_same_v<T, Del> || std::is_same_v<T, GetValue> ||
+                        std::is_same_v<T, Drop> || std::is_same_v<T, StartRegen> ||
+                        std::is_same_v<T, StopRegen>) {
+                    uses.push_back(cmd.dest);
+                } else if constexpr (
+                        std::is_same_v<T, SetOption> ||
+                        std::is_same_v<T, StartProfile> ||
+                        std::is_same_v<T, StopProfile>) {
+                    // the comp node workers read the options and record events
+                    wait_all_routed_tasks();
+                }
+            },
+            icmd.data);
+    if (!multi_worker || !target.valid()) {
+        for (auto* info : uses) {
+            if (info) {
+                wait_routed_uses(info);
+            }
+        }
+        process_one_task(icmd);
+        return;
+    }
+    {
+        MGB_LOCK_GUARD(m_mutex);
+        for (auto* info : uses) {
+            if (info) {
+                ++info->nr_routed_uses;
+            }
+        }
+    }
+    auto&& worker = m_device_workers[target];
+    if (!worker) {
+        worker = std::make_unique<DeviceWorkQueue>(this);
+    }
+    worker->add_task(RoutedCommand{std::move(icmd), get_worker_state().scopes});
+}
+
+void ChannelImpl::process_routed_task(
+        RoutedCommand& routed, std::shared_ptr<const ScopeStack>& recorded_scopes) {
+    // record the scope changes since the previous command on this thread, so
+    // the profiler nests the routed command in the scopes it was issued in
+    auto&& scopes = routed.scopes;
+    if (recorded_scopes != scopes) {
+        static const ScopeStack empty_scopes;
+        auto&& prev = recorded_scopes ? *recorded_scopes : empty_scopes;
+        size_t nr_common = 0;
+        while (nr_common < prev.size() && nr_common < scopes->size() &&
+               prev[nr_common] == (*scopes)[nr_common]) {
+            ++nr_common;
+        }
+        if (Profiler::is_profiling()) {
+            for (size_t i = prev.size(); i > nr_common; --i) {
+                MGB_RECORD_EVENT(
+                        ScopeFinishEvent, prev[i - 1].first, prev[i - 1].second);
+            }
+            for (size_t i = nr_common; i < scopes->size(); ++i) {
+                MGB_RECORD_EVENT(ScopeEvent, (*scopes)[i].first, (*scopes)[i].second);
+            }
+        }
+        recorded_scopes = scopes;
+    }
+    auto& icmd = routed.cmd;
+    SmallVector<TensorInfo*> uses;
+    auto* apply = std::get_if<ApplyOp>(&icmd.data);
+    if (apply) {
+        // the inputs may be produced by the workers of other comp nodes
+        std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+        m_routed_cv.wait(lock, [&] {
+            for (auto* input : apply->inputs) {
+                if (!input->ptr && !input->invalid) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        uses.append(apply->inputs.begin(), apply->inputs.end());
+        uses.append(apply->outputs.begin(), apply->outputs.end());
+    } else {
+        uses.push_back(std::get<Put>(icmd.data).dest);
+    }
+    size_t nr_inputs = uses.size() - (apply ? apply->outputs.size() : 1);
+    auto finish = [&](bool failed) {
+        MGB_LOCK_GUARD(m_mutex);
+        for (size_t i = 0; i < uses.size(); ++i) {
+            if (uses[i]) {
+                --uses[i]->nr_routed_uses;
+                // so that the workers waiting on the outputs would not hang
+                uses[i]->invalid |= failed && i >= nr_inputs;
+            }
+        }
+        m_routed_cv.notify_all();
+    };
+    // the exception is not caught if catch_worker_execption is disabled
+    try {
+        process_one_task(icmd);
+    } catch (...) {
+        finish(true);
+        throw;
+    }
+    finish(false);
+}
+
+void ChannelImpl::wait_routed_uses(TensorInfo* info) {
+    std::unique_lock<decltype(m_mutex)> lock(m_mutex);
+    m_routed_cv.wait(lock, [&] { return info->nr_routed_uses == 0; });
+}
+
+void ChannelImpl::wait_all_routed_tasks() {
+    for (auto&& i : m_device_workers) {
+        i.second->wait_all_task_finish();
+    }
+}
+
+bool ChannelImpl::fuse_one_task(Command& icmd) {
+    auto& options = get_worker_state().options;
+    auto& group = m_fusion_group;
+    bool enabled = options.enable_op_fusion && !options.enable_drop &&
+                   !options.enable_dtr_auto_drop && !options.enable_multi_worker;
+    if (!enabled && group.cmds.empty()) {
+        return false;
+    }
+    if (enabled) {
+        if (auto* apply = std::get_if<ApplyOp>(&icmd.data)) {
+            if (is_fusible(*apply)) {
+                auto&& desc = apply->outputs[0]->desc;
+                if (!group.cmds.empty() &&
+                    (group.cmds.size() >= FusionGroup::MAX_NR_OPS ||
+                     desc.comp_node != group.comp_node ||
+                     !desc.layout.eq_shape(group.layout) ||
+                     desc.layout.dtype != group.layout.dtype)) {
+                    flush_fusion_group();
+                }
+                group.comp_node = desc.comp_node;
+                group.layout = desc.layout;
+                group.outputs.insert(apply->outputs[0]);
+                group.cmds.push_back(std::move(*apply));
+                return true;
+            }
+        } else if (auto* del = std::get_if<Del>(&icmd.data)) {
+            if (group.outputs.count(del->dest)) {
+                group.dead_outputs.push_back(del->dest);
+                return true;
+            }
+        }
+    }
+    flush_fusion_group();
+    return false;
+}
+
+bool ChannelImpl::is_fusible(const ApplyOp& cmd) {
+    if (!cmd.op->same_type<imperative::Elemwise>() || cmd.outputs.size() != 1 ||
+        !cmd.outputs[0]) {
+        return false;
+    }
+    auto&& desc = cmd.outputs[0]->desc;
+    // small tensors are computed on host, and their values are part of the key of
+    // compiled graph
+    if (!desc.layout.ndim || desc.layout.total_nr_elems() <= MEGDNN_MAX_NDIM) {
+        return false;
+    }
+    for (auto* input : cmd.inputs) {
+        if (input->desc.comp_node != desc.comp_node ||
+            !input->desc.layout.eq_shape(desc.layout) ||
+            input->desc.layout.dtype != desc.layout.dtype) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ChannelImpl::flush_fusion_group() {
+    auto& group = m_fusion_group;
+    if (group.cmds.empty()) {
+        return;
+    }
+    auto cmds = std::move(group.cmds);
+    auto dead_outputs = std::move(group.dead_outputs);
+    group.cmds.clear();
+    group.dead_outputs.clear();
+    group.outputs.clear();
+    std::unordered_set<TensorInfo*> dead_set(dead_outputs.begin(), dead_outputs.end());
+    if (cmds.size() == 1) {
+        Command cmd{cmds[0].id, std::move(cmds[0])};
+        process_one_task(cmd);
+    } else {
+        Subgraph graph;
+        std::unordered_map<TensorInfo*, Subgraph::var_t> info2var;
+        SmallVector<TensorInfo*> inputs, outputs;
+        Subgraph::var_t next_var = 1;
+        auto get_var = [&](TensorInfo* info) {
+            auto ins = info2var.insert({info, next_var});
+            if (ins.second) {
+                inputs.push_back(info);
+                graph.inputs.push_back(next_var++);
+            }
+            return ins.first->second;
+        };
+        for (auto&& cmd : cmds) {
+            Subgraph::vars_t input_vars;
+            for (auto* input : cmd.inputs) {
+                input_vars.push_back(get_var(input));
+            }
+            info2var[cmd.outputs[0]] = next_var;
+            graph.exprs.push_back({cmd.op, input_vars, {next_var++}});
+        }
+        for (auto&& cmd : cmds) {
+            if (!dead_set.count(cmd.outputs[0])) {
+                graph.outputs.push_back(info2var.at(cmd.outputs[0]));
+                outputs.push_back(cmd.outputs[0]);
+            }
+        }
+        // elemwise ops have no side effect, so nothing is computed if all the
+        // outputs are deleted
+        if (!outputs.empty()) {
+            auto key = std::make_shared<FusionGroupKey>(graph);
+            std::shared_ptr<OpDef> op = SubgraphOp::make(
+                    "FusedElemwise", std::make_shared<Subgraph>(std::move(graph)),
+                    SmallVector<bool>{}, key);
+#if MGB_JIT
+            op = CompiledOp::make(JITFusionOp::make(op));
+#else
+            op = CompiledOp::make(op);
+#endif
+            Command cmd{cmds[0].id, ApplyOp{cmds[0].id, op, inputs, outputs}};
+            process_one_task(cmd);
+        }
+    }
+    for (auto* info : dead_outputs) {
+        Command cmd{Profiler::next_id(), Del{info}};
+        process_one_task(cmd);
+    }
+}
+
 void ChannelImpl::process_one_task(Command& icmd) {
     using namespace ranges;
     using namespace ranges::views;
@@ -1240,9 +1752,26 @@ void ChannelImpl::process_one_task(Command& icmd) {
                     }
                     output->dsu_ptr = std::make_shared<DsuNode>(output->compute_time);
                 }
+                if (!m_dtr.trace_path.empty()) {
+                    SmallVector<DTRTrace::Tensor> inputs, outputs;
+                    for (auto i : cmd.inputs) {
+                        inputs.push_back({i->id, i->memory});
+                    }
+                    for (auto i : cmd.outputs) {
+                        if (i != nullptr && i->ptr) {
+                            outputs.push_back({i->id, i->memory});
+                        }
+                    }
+                    m_dtr.trace.add_op(cmd.op->make_name(), inputs, outputs);
+                }
             } else {
                 do_apply_op(cmd, "cmd");
             }
+            // after the op is executed, so its inputs are not evicted for the
+            // prefetched tensors
+            if (state.options.enable_dtr_auto_drop && state.options.enable_dtr_swap) {
+                prefetch_swapped(cmd.id);
+            }
             if (state.options.enable_drop && state.options.record_computing_path) {
                 auto is_inplace = [](std::tuple<TensorInfo*, TensorInfo*> tuple2) {
                     auto& input = std::get<0>(tuple2);
@@ -1298,6 +1827,9 @@ void ChannelImpl::process_one_task(Command& icmd) {
             MGB_RECORD_EVENT(TensorCommandEvent, cmd.dest->id, TensorCommandKind::Del);
             CompNode device = cmd.dest->desc.comp_node;
             uint64_t tensor_id = cmd.dest->id;
+            if (state.options.enable_dtr_auto_drop && !m_dtr.trace_path.empty()) {
+                m_dtr.trace.add_del(tensor_id);
+            }
             free(cmd.dest);
             MGB_RECORD_EVENT(
                     TensorCommandFinishEvent, tensor_id, TensorCommandKind::Del);
@@ -1309,6 +1841,10 @@ void ChannelImpl::process_one_task(Command& icmd) {
             if (!cmd.dest->ptr && cmd.dest->evict_type != EvictType::NONE) {
                 regenerate(cmd.dest);
             }
+            if (state.options.enable_dtr_swap) {
+                MGB_LOCK_GUARD(m_mutex);
+                wait_swap_in_unsafe(cmd.dest);
+            }
             cmd.dest->ptr->fetch_value();
             MGB_LOCK_GUARD(m_mutex);
             notify_tensor_unsafe(cmd.dest);
@@ -1357,8 +1893,19 @@ void ChannelImpl::process_one_task(Command& icmd) {
             MGB_RECORD_EVENT(StopStepEvent);
         } else if constexpr (std::is_same_v<T, PushScope>) {
             MGB_RECORD_EVENT(ScopeEvent, cmd.scope_name, cmd.type);
+            auto scopes = std::make_shared<ScopeStack>(*state.scopes);
+            scopes->emplace_back(cmd.scope_name, cmd.type);
+            state.scopes = std::move(scopes);
         } else if constexpr (std::is_same_v<T, PopScope>) {
             MGB_RECORD_EVENT(ScopeFinishEvent, cmd.scope_name);
+            auto scopes = std::make_shared<ScopeStack>(*state.scopes);
+            for (size_t i = scopes->size(); i > 0; --i) {
+                if ((*scopes)[i - 1].first == cmd.scope_name) {
+                    scopes->erase(scopes->begin() + i - 1);
+                    break;
+                }
+            }
+            state.scopes = std::move(scopes);
         } else if constexpr (std::is_same_v<T, StartRegen>) {
             if (cmd.dest->invalid)
                 return;
@@ -1542,7 +2089,8 @@ void ChannelImpl::assert_in_channel() {
 
 void ChannelImpl::assert_in_worker() {
     mgb_assert(
-            get_worker_tid() == std::this_thread::get_id(),
+            get_worker_tid() == std::this_thread::get_id() ||
+                    tl_device_worker_owner == this,
             "this method can only be called in worker thread");
 }
 
@@ -1623,8 +2171,16 @@ double ChannelImpl::DynamicSublinear::estimate_neighbor_cost(TensorInfo* ptr) {
     return cost;
 }
 
+double ChannelImpl::DynamicSublinear::estimate_compute_cost(
+        const OpDef& op, double traffic, EvictionPolicy policy) {
+    if (policy == EvictionPolicy::PROFILED) {
+        return cost_table.get(op.make_name(), traffic);
+    }
+    return traffic;
+}
+
 TensorInfo* ChannelImpl::DynamicSublinear::find_best_tensor(
-        bool enable_dtr_sqrt_sampling = false) {
+        bool enable_dtr_sqrt_sampling, EvictionPolicy policy) {
     if (candidates.empty())
         return nullptr;
 
@@ -1646,14 +2202,20 @@ TensorInfo* ChannelImpl::DynamicSublinear::find_best_tensor(
         }
         auto i = candidates[ti];
         if (i->producer && i->ptr && i->evict_type == EvictType::NONE) {
-            double neighbor_cost = estimate_neighbor_cost(i);
+            EvictionCandidate cand;
+            if (policy == EvictionPolicy::DTR || policy == EvictionPolicy::PROFILED) {
+                cand.neighbor_cost = estimate_neighbor_cost(i);
+            }
             size_t begin_ptr =
                     reinterpret_cast<size_t>(i->ptr->blob()->storage().get());
             auto side_info = i->ptr->comp_node().get_free_left_and_right(
                     begin_ptr, begin_ptr + i->ptr->blob()->size());
-            double free_mem = side_info.first + side_info.second;
-            double msps = i->eval_func(
-                    neighbor_cost, free_mem, estimate_timestamp, 1.0, 1.0, 1.0, 1.0001);
+            cand.memory = i->memory;
+            cand.free_memory = side_info.first + side_info.second;
+            cand.compute_cost = i->compute_time;
+            cand.staleness = estimate_timestamp - i->last_used_time;
+            cand.recompute_times = i->recompute_times;
+            double msps = eviction_score(policy, cand);
             if (min_msps < 0 || msps < min_msps) {
                 min_msps = msps;
                 best = i;
@@ -13,6 +13,7 @@
 #include "megbrain/utils/mempool.h"
 
 #include "./commands.h"
+#include "./dtr_policy.h"
 #include "./option_manager.h"
 #include "./stack_manager.h"
 #include "./tensor_info.h"
@@ -47,6 +48,7 @@ struct ChannelImpl : Interpreter::Channel, NonCopyableObj, NonMoveableObj {
             std::shared_ptr<OpDef> op, const SmallVector<Handle>& inputs) override;
 
     HostTensorND get_value(Handle) override;
+    bool prefetch_value(Handle) override;
     TensorShape get_shape(Handle) override;
     DType get_dtype(Handle) override;
     CompNode get_device(Handle) override;
@@ -81,7 +83,9 @@ struct ChannelImpl : Interpreter::Channel, NonCopyableObj, NonMoveableObj {
 
 private:
     struct WorkQueue;
+    struct DeviceWorkQueue;
     struct State;
+    using ScopeStack = SmallVector<std::pair<std::string, ScopeType>>;
 
     TensorInfo* alloc();
     void init(TensorInfo*, LogicalTensorDesc&& desc);
@@ -89,6 +93,14 @@ private:
     void real_free(TensorInfo*);
     void recursive_free(TensorInfo*);
     void do_drop(TensorInfo*, bool);
+    void do_swap_out(TensorInfo*);
+    void swap_in(TensorInfo*);
+    //! make the compute stream wait for the swap in of the tensor, with m_mutex held
+    void wait_swap_in_unsafe(TensorInfo*);
+    //! whether to swap the evicted tensor rather than dropping it
+    bool should_swap(TensorInfo*);
+    //! swap in the inputs of the ops dispatched after the given ApplyOp
+    void prefetch_swapped(uint64_t apply_id);
     void detach_users(TensorInfo*);
 
     TensorInfo* put_impl(const HostTensorND& value, bool no_cache);
@@ -102,6 +114,20 @@ private:
 
     void process_one_task(Command&);
 
+    //! route the command to the worker of its comp node, or process it here
+    void dispatch_one_task(Command&);
+    struct RoutedCommand;
+    //! \param recorded_scopes the scopes recorded on the worker thread
+    void process_routed_task(
+            RoutedCommand&, std::shared_ptr<const ScopeStack>& recorded_scopes);
+    void wait_routed_uses(TensorInfo* info);
+    void wait_all_routed_tasks();
+
+    //! defer the command into the fusion group, or flush the group before it
+    bool fuse_one_task(Command&);
+    bool is_fusible(const ApplyOp& cmd);
+    void flush_fusion_group();
+
     void check_worker_exc_unsafe();
 
     void produce_tensor(TensorInfo* dest, TensorPtr ptr);
@@ -136,6 +162,8 @@ private:
     std::mutex m_mutex;
     Spinlock m_spin;
     std::condition_variable m_cv;
+    //! notified when a routed command finishes
+    std::condition_variable m_routed_cv;
     MemPool<TensorInfo> m_pool;
     std::unordered_set<Handle> m_valid_handle;
     TensorInfo* m_waitee = nullptr;
@@ -153,13 +181,13 @@ private:
     enum class ChannelRunningStatus { RUNING, CLOSED, FORKED };
     ChannelRunningStatus m_status = ChannelRunningStatus::RUNING;
 
-    struct WorkQueue : AsyncQueueSC<Command, WorkQueue> {
+    struct WorkQueue : AsyncRingQueueSC<Command, WorkQueue> {
         // set max_spin=0 to prevent Queue fetch task in busy wait manner.
         // this won't affect throughput when python interpreter is sending enough task,
         // but will significantly save CPU time when waiting for task, e.g. wait for
         // data input limit pending tasks to 10000
         WorkQueue(ChannelImpl* owner)
-                : AsyncQueueSC<Command, WorkQueue>(0, 10000), m_owner(owner) {
+                : AsyncRingQueueSC<Command, WorkQueue>(0, 10000), m_owner(owner) {
             sys::set_thread_name("interpreter");
             if (const char* env_val = MGB_GETENV("MEGENGINE_ASYNC_QUEUE_SIZE")) {
                 int len = strlen(env_val);
@@ -173,13 +201,79 @@ private:
                 update_max_items(val);
             }
         }
-        void process_one_task(Command& icmd) { m_owner->process_one_task(icmd); }
+        void process_one_task(Command& icmd) { m_owner->dispatch_one_task(icmd); }
         void on_async_queue_worker_thread_start() override;
+        void on_async_queue_batch_finish() override { m_owner->flush_fusion_group(); }
 
     private:
         ChannelImpl* m_owner;
     } m_worker;
 
+    /*!
+     * \brief the consecutive elemwise ops deferred by the main worker when
+     * enable_op_fusion is set
+     *
+     * The ops have the same device, shape and dtype. The group is flushed as one
+     * compiled subgraph before any other command and at the end of each batch of
+     * the queue, and its outputs deleted in the meantime become intermediates of the
+     * subgraph, which need no blobs.
+     */
+    struct FusionGroup {
+        static constexpr size_t MAX_NR_OPS = 32;
+        SmallVector<ApplyOp> cmds;
+        std::unordered_set<TensorInfo*> outputs;
+        SmallVector<TensorInfo*> dead_outputs;
+        CompNode comp_node;
+        TensorLayout layout;
+    } m_fusion_group;
+
+    /*!
+     * \brief the inputs of the dispatched ApplyOps in order when enable_dtr_swap
+     * is set, tagged by the ids of the commands
+     *
+     * The main worker drops the entries up to the ApplyOp being processed, and
+     * the swapped tensors in the following swap_prefetch_depth entries are
+     * swapped in, so the copies overlap with the computation before their use.
+     * The tensors are alive since they are deleted after these ApplyOps.
+     */
+    struct SwapLookahead {
+        std::mutex mtx;
+        std::deque<std::pair<uint64_t, SmallVector<TensorInfo*>>> inputs;
+    } m_swap_lookahead;
+
+    /*!
+     * \brief the worker of a comp node when enable_multi_worker is set
+     *
+     * Put and ApplyOp commands are routed by the main worker to the worker of the
+     * target comp node. A routed ApplyOp waits on the host until its inputs are
+     * produced by the other workers, and the device side dependencies are tracked by
+     * the ready events of the tensors. Other commands on the main worker wait until
+     * the routed commands using their tensors finish.
+     */
+    //! a routed command with the scopes of the main worker when it was routed,
+    //! so the comp node workers never read the scopes changed by the main worker
+    struct RoutedCommand {
+        Command cmd;
+        std::shared_ptr<const ScopeStack> scopes;
+    };
+
+    struct DeviceWorkQueue : AsyncRingQueueSC<RoutedCommand, DeviceWorkQueue> {
+        DeviceWorkQueue(ChannelImpl* owner)
+                : AsyncRingQueueSC<RoutedCommand, DeviceWorkQueue>(0, 10000),
+                  m_owner(owner) {}
+        void process_one_task(RoutedCommand& icmd) {
+            m_owner->process_routed_task(icmd, m_scopes);
+        }
+        void on_async_queue_worker_thread_start() override;
+
+    private:
+        ChannelImpl* m_owner;
+        std::shared_ptr<const ScopeStack> m_scopes;
+    };
+    //! only accessed by the main worker, except that the channel waits on them
+    //! when the main worker is idle
+    CompNode::UnorderedMap<std::unique_ptr<DeviceWorkQueue>> m_device_workers;
+
     struct State {
         std::thread::id tid;
         OptionManager options;
@@ -189,7 +283,11 @@ private:
         StackManager stack_manager;
     };
 
-    struct WorkerState : State {};
+    struct WorkerState : State {
+        //! the scopes processed by the main worker; it is replaced rather than
+        //! modified, since the routed commands hold it as a snapshot
+        std::shared_ptr<const ScopeStack> scopes = std::make_shared<ScopeStack>();
+    };
 
     ChannelState m_channel_state;
     WorkerState m_worker_state;
@@ -203,16 +301,25 @@ private:
      */
     struct DynamicSublinear {
         /*!
-         * \brief find an available tensor with the largest evaluation function
+         * \brief find an available tensor with the lowest eviction score
          *
          * Note: An available tensor must satisfy: (1) has computing path,
-         * (2) is in memory, (3) is not pinned. Evaluation function refers to:
-         * @see: TensorInfo::eval_func.
+         * (2) is in memory, (3) is not pinned. The score is given by the
+         * policy, @see: eviction_score.
          *
          * \return the pointer of the best tensor; nullptr is returned if no
          * available tensor is found
          */
-        TensorInfo* find_best_tensor(bool);
+        TensorInfo* find_best_tensor(bool, EvictionPolicy);
+
+        /*!
+         * \brief estimate the cost of recomputing the outputs of an op
+         *
+         * The memory traffic of the op is used, except that the profiled time
+         * in cost_table is used by EvictionPolicy::PROFILED.
+         */
+        double estimate_compute_cost(
+                const OpDef& op, double traffic, EvictionPolicy policy);
 
         /*!
          * \brief estimate the cost of recomputing tensor ptr
@@ -293,6 +400,17 @@ private:
         //! store all tensors that may be evicted
         SmallVector<TensorInfo*> candidates;
 
+        //! bytes of the pinned host memory holding the swapped tensors
+        size_t swapped_memory = 0;
+
+        //! the profiled op times, loaded from MEGENGINE_DTR_OP_COST_TABLE
+        OpCostTable cost_table;
+
+        //! the executed ops, dumped to MEGENGINE_DTR_TRACE_FILE on close to be
+        //! replayed by DTRSimulator; nothing is recorded if the path is empty
+        DTRTrace trace;
+        std::string trace_path;
+
         bool is_bad_op(std::string op_name) {
             return std::find(op_blacklist.begin(), op_blacklist.end(), op_name) !=
                    op_blacklist.end();
@@ -303,7 +421,8 @@ private:
         std::vector<std::string> op_blacklist = {
                 "CollectiveComm", "InplaceAdd", "ParamPackSplit", "ParamPackConcat",
                 "GaussianRNG",    "UniformRNG", "GammaRNG",       "PermutationRNG",
-                "PoissonRNG",     "BetaRNG",    "ExponentialRNG", "MultinomialRNG"};
+                "PoissonRNG",     "BetaRNG",    "ExponentialRNG", "MultinomialRNG",
+                "LogitsSamplingRNG"};
     } m_dtr;
 
     //! automatically evict an optimal tensor
@@ -38,13 +38,40 @@ public:
             "disable memory forwarding, thus each tensor has its own storage.");
     DEF_OPTION(enable_dtr_auto_drop, "MEGENGINE_DTR_AUTO_DROP", 0, "");
     DEF_OPTION(enable_dtr_sqrt_sampling, "MEGENGINE_DTR_SQRT_SAMPLING", 0, "");
+    DEF_OPTION(
+            dtr_eviction_policy, "MEGENGINE_DTR_EVICTION_POLICY", 0,
+            "the heuristic to select the tensor to evict: 0 for dtr, 1 for h-dtr "
+            "local, 2 for lru weighted by memory, and 3 for dtr with the profiled op "
+            "times in MEGENGINE_DTR_OP_COST_TABLE.");
     DEF_OPTION(
             dtr_eviction_threshold, "MEGENGINE_DTR_EVICTION_THRESHOLD", 0,
             "auto drop will start whenever gpu memory usage exceeds this value.");
     DEF_OPTION(
             dtr_evictee_minimum_size, "MEGENGINE_DTR_EVICTEE_MINIMUM_SIZE", 1048576,
             "the minimum memory value of a tensor added to the candidate set");
+    DEF_OPTION(
+            enable_dtr_swap, "MEGENGINE_DTR_SWAP", 0,
+            "let dtr swap the evicted tensors to the pinned host memory on the copy "
+            "stream, instead of dropping them, if the copies are cheaper than the "
+            "recomputation.");
+    DEF_OPTION(
+            dtr_swap_host_limit, "MEGENGINE_DTR_SWAP_HOST_LIMIT", 0,
+            "the maximum bytes of the host memory used by swap, 0 for no limit.");
+    DEF_OPTION(
+            swap_prefetch_depth, "MEGENGINE_SWAP_PREFETCH_DEPTH", 4,
+            "the number of dispatched ops to look ahead for the swapped inputs, which "
+            "are swapped in before they are required.");
     DEF_OPTION(record_computing_path, "MEGENGINE_RECORD_COMPUTING_PATH", 0, "");
+    DEF_OPTION(
+            enable_multi_worker, "MEGENGINE_INTERP_MULTI_WORKER", 0,
+            "execute the commands of each comp node in its own worker thread, so that "
+            "host dispatch of different devices and streams overlaps; it is ignored "
+            "when drop or dtr is enabled.");
+    DEF_OPTION(
+            enable_op_fusion, "MEGENGINE_INTERP_OP_FUSION", 0,
+            "fuse the consecutive elemwise ops on the same device that are queued in "
+            "the worker, and skip the intermediates deleted before execution; it is "
+            "ignored when drop, dtr or multi worker is enabled.");
 
 #undef DEF_OPTION
 
@@ -11,6 +11,7 @@ namespace interpreter::intl {
 enum EvictType {
     NONE = 0,
     DROP = 1,
+    SWAP = 2,
 };
 
 /*!
@@ -38,6 +39,7 @@ struct TensorInfo {
         Allocated,
         Produced,
         Dropped,
+        Swapped,
         Deleted,
     };
 
@@ -65,6 +67,15 @@ struct TensorInfo {
     // Used by HostCompute
     HostTensorND h_value;
 
+    // Whether a GetValue is queued by prefetch_value, visited in main thread
+    bool value_prefetched = false;
+
+    // Used by swap, the value in the pinned host memory when swapped out, and
+    // the event on the copy stream to be waited on before the swapped in value
+    // is read, guarded by the interpreter mutex
+    HostTensorND h_swap;
+    uint64_t swap_event = 0;
+
     // reserved for auto drop
     size_t pinned = 0;
     size_t recompute_times = 0;
@@ -74,6 +85,10 @@ struct TensorInfo {
     // Not reference count, inc when used as input
     size_t ptr_use_count = 0;
 
+    // number of commands using this tensor that are routed to the comp node
+    // workers but not yet finished, guarded by the interpreter mutex
+    size_t nr_routed_uses = 0;
+
     // Used by `Drop` action
     struct ComputePath {
         uint64_t id;
@@ -118,15 +133,6 @@ struct TensorInfo {
         }
     }* producer = nullptr;
 
-    double eval_func(
-            double cost, double free_mem, double cur_time, double param_cost,
-            double param_mem, double param_time, double param_recompute_times) {
-        return pow(cost + 1e-3, param_cost) *
-               pow(param_recompute_times, (double)recompute_times) /
-               (pow((memory + free_mem) / 1024.0 / 1024.0, param_mem) *
-                pow((double)(cur_time - last_used_time + 1e-3), param_time));
-    }
-
     void pin() { ++pinned; }
 
     void unpin() { --pinned; }
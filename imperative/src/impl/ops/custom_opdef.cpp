@@ -178,8 +178,17 @@ SmallVector<TensorPtr> apply_on_physical_tensor(
         }
     }
 
+    auto&& custom_op = static_cast<const CustomOpDef&>(def).impl();
     for (size_t i = 0; i < outputs.size(); ++i) {
         auto& output = outputs[i];
+        int fwd = custom_op->forward_input(i);
+        if (fwd >= 0) {
+            // a view of the contiguous input, see CustomOp::set_forward
+            auto dv = inputs[fwd]->dev_tensor();
+            dv.reset(dv.storage(), output_descs[i].layout);
+            output = Tensor::make(dv);
+            continue;
+        }
         output = Tensor::make(output_descs[i].layout, output_descs[i].comp_node);
     }
 
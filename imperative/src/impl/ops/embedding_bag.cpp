@@ -0,0 +1,90 @@
+#include "megbrain/imperative/ops/autogen.h"
+
+#include "../dnn_op_helper.h"
+#include "../op_trait.h"
+
+namespace mgb {
+namespace imperative {
+
+namespace {
+namespace embedding_bag {
+
+std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible(
+        const OpDef& def, const SmallVector<LogicalTensorDesc>& inputs) {
+    auto&& op = def.cast_final_safe<EmbeddingBag>();
+    mgb_assert(inputs.size() == 4, "EmbeddingBag expects 4 inputs");
+    auto&& weight = inputs[0];
+    auto&& offsets = inputs[2];
+    TensorLayout dst_layout{weight.layout.dtype}, max_idx_layout{dtype::Int32()};
+    bool succeed = weight.layout.ndim != 0 && offsets.layout.ndim != 0;
+    if (succeed) {
+        DnnOprHelper<megdnn::EmbeddingBag> dnn_op(op.param());
+        auto layouts = dnn_op.deduce_layouts<2>(
+                weight.layout, inputs[1].layout, offsets.layout, inputs[3].layout);
+        dst_layout = layouts[0];
+        max_idx_layout = layouts[1];
+    }
+    return {{{dst_layout, weight.comp_node}, {max_idx_layout, weight.comp_node}},
+            succeed};
+}
+
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        SmallVector<LogicalTensorDesc>& output_descs, const bool& validated) {
+    auto&& op = def.cast_final_safe<EmbeddingBag>();
+    auto cn = inputs[0]->comp_node();
+    DnnOprCaller<megdnn::EmbeddingBag> dnn_op{cn, op.param()};
+    auto&& [dst_layout, max_idx_layout] = dnn_op.deduce_layouts<2>(
+            inputs[0]->layout(), inputs[1]->layout(), inputs[2]->layout(),
+            inputs[3]->layout());
+    auto dst = Tensor::make(dst_layout, cn);
+    auto max_idx = Tensor::make(max_idx_layout, cn);
+    dnn_op.exec_with_ws(inputs[0], inputs[1], inputs[2], inputs[3], dst, max_idx);
+    return {dst, max_idx};
+}
+
+OP_TRAIT_REG(EmbeddingBag, EmbeddingBag)
+        .infer_output_attrs_fallible(infer_output_attrs_fallible)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .fallback();
+
+}  // namespace embedding_bag
+
+namespace embedding_bag_backward {
+
+//! the inputs are (weight_like, diff, indices, offsets, per_sample_weights,
+//! max_idx), where only the shape of weight_like is used
+std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible(
+        const OpDef& def, const SmallVector<LogicalTensorDesc>& inputs) {
+    mgb_assert(inputs.size() == 6, "EmbeddingBagBackward expects 6 inputs");
+    auto&& like = inputs[0];
+    auto&& diff = inputs[1];
+    TensorLayout grad_layout{like.layout, diff.layout.dtype};
+    grad_layout.init_contiguous_stride();
+    return {{{grad_layout, diff.comp_node}}, like.layout.ndim != 0};
+}
+
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        SmallVector<LogicalTensorDesc>& output_descs, const bool& validated) {
+    auto&& op = def.cast_final_safe<EmbeddingBagBackward>();
+    auto&& diff = inputs[1];
+    auto cn = diff->comp_node();
+    TensorLayout grad_layout{inputs[0]->layout(), diff->layout().dtype};
+    grad_layout.init_contiguous_stride();
+    auto grad = Tensor::make(grad_layout, cn);
+    DnnOprCaller<megdnn::EmbeddingBagBackward> dnn_op{cn, op.param()};
+    dnn_op.exec_with_ws(diff, inputs[2], inputs[3], inputs[4], inputs[5], grad);
+    return {grad};
+}
+
+OP_TRAIT_REG(EmbeddingBagBackward, EmbeddingBagBackward)
+        .infer_output_attrs_fallible(infer_output_attrs_fallible)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .fallback();
+
+}  // namespace embedding_bag_backward
+}  // namespace
+
+}  // namespace imperative
+}  // namespace mgb
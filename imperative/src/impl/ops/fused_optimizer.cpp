@@ -0,0 +1,56 @@
+#include "megbrain/imperative/ops/autogen.h"
+
+#include "../dnn_op_helper.h"
+#include "../op_trait.h"
+
+namespace mgb {
+namespace imperative {
+
+namespace {
+namespace fused_optimizer {
+
+std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible(
+        const OpDef& def, const SmallVector<LogicalTensorDesc>& input_descs) {
+    mgb_assert(input_descs.size() == 5, "FusedOptimizerUpdate expects 5 inputs");
+    auto&& param = input_descs[0];
+    auto&& exp_avg = input_descs[2];
+    auto&& exp_avg_sq = input_descs[3];
+    return {{{param.layout, param.comp_node},
+             {exp_avg.layout, exp_avg.comp_node},
+             {exp_avg_sq.layout, exp_avg_sq.comp_node}},
+            true};
+}
+
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        SmallVector<LogicalTensorDesc>& output_descs, const bool& validated) {
+    auto&& op = def.cast_final_safe<FusedOptimizerUpdate>();
+    auto&& param = inputs[0];
+    auto&& exp_avg = inputs[2];
+    auto&& exp_avg_sq = inputs[3];
+    auto cn = param->comp_node();
+
+    auto new_param = Tensor::make(param->layout(), cn);
+    //! the states not used by the mode are passed through
+    using Mode = FusedOptimizerUpdate::Mode;
+    bool sgd = op.mode == Mode::SGD;
+    auto new_exp_avg = sgd && op.momentum == 0 ? exp_avg
+                                                : Tensor::make(exp_avg->layout(), cn);
+    auto new_exp_avg_sq = sgd ? exp_avg_sq : Tensor::make(exp_avg_sq->layout(), cn);
+
+    DnnOprCaller<megdnn::FusedOptimizerUpdate> dnn_opr{cn, op.param()};
+    dnn_opr.exec_with_ws(
+            param, inputs[1], exp_avg, exp_avg_sq, inputs[4], new_param, new_exp_avg,
+            new_exp_avg_sq);
+    return {new_param, new_exp_avg, new_exp_avg_sq};
+}
+
+OP_TRAIT_REG(FusedOptimizerUpdate, FusedOptimizerUpdate)
+        .infer_output_attrs_fallible(infer_output_attrs_fallible)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .fallback();
+
+}  // namespace fused_optimizer
+}  // namespace
+}  // namespace imperative
+}  // namespace mgb
@@ -0,0 +1,118 @@
+#include "megbrain/imperative/ops/autogen.h"
+
+#include "../dnn_op_helper.h"
+#include "../op_trait.h"
+
+namespace mgb {
+namespace imperative {
+
+namespace {
+namespace kv_cache_append {
+
+//! the caches are written inplace, unless their storage is shared
+TensorPtr get_inplace_cache(const TensorPtr& cache) {
+    if (cache->storage_is_unique()) {
+        return cache;
+    }
+    mgb_log_warn(
+            "The kv cache is shared with other tensors. Fallback to non-inplace "
+            "update.");
+    auto layout = cache->layout();
+    layout.init_contiguous_stride();
+    auto copy = Tensor::make(layout, cache->comp_node());
+    copy->dev_tensor().copy_from(cache->dev_tensor());
+    return copy;
+}
+
+std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible(
+        const OpDef& def, const SmallVector<LogicalTensorDesc>& inputs) {
+    auto&& op = def.cast_final_safe<KVCacheAppend>();
+    mgb_assert(inputs.size() == 5, "KVCacheAppend expects 5 inputs");
+    auto&& qkv = inputs[0];
+    auto&& k_cache = inputs[3];
+    auto&& v_cache = inputs[4];
+    TensorLayout q_layout{qkv.layout.dtype};
+    bool succeed = qkv.layout.ndim != 0;
+    if (succeed) {
+        DnnOprHelper<megdnn::KVCacheAppend> dnn_op(op.param());
+        q_layout = dnn_op.deduce_layout(
+                qkv.layout, inputs[1].layout, inputs[2].layout, k_cache.layout,
+                v_cache.layout);
+    }
+    return {{{q_layout, qkv.comp_node},
+             {k_cache.layout, k_cache.comp_node},
+             {v_cache.layout, v_cache.comp_node}},
+            succeed && k_cache.layout.ndim != 0};
+}
+
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        SmallVector<LogicalTensorDesc>& output_descs, const bool& validated) {
+    auto&& op = def.cast_final_safe<KVCacheAppend>();
+    auto&& qkv = inputs[0];
+    auto cn = qkv->comp_node();
+    auto k_cache = get_inplace_cache(inputs[3]);
+    auto v_cache = get_inplace_cache(inputs[4]);
+
+    DnnOprCaller<megdnn::KVCacheAppend> dnn_op{cn, op.param()};
+    auto q_layout = dnn_op.deduce_layout(
+            qkv->layout(), inputs[1]->layout(), inputs[2]->layout(),
+            k_cache->layout(), v_cache->layout());
+    auto q = Tensor::make(q_layout, cn);
+    dnn_op.exec_with_ws(qkv, inputs[1], inputs[2], k_cache, v_cache, q);
+    return {q,
+            std::make_shared<Tensor>(
+                    k_cache->blob(), k_cache->offset(), k_cache->layout()),
+            std::make_shared<Tensor>(
+                    v_cache->blob(), v_cache->offset(), v_cache->layout())};
+}
+
+OP_TRAIT_REG(KVCacheAppend, KVCacheAppend)
+        .infer_output_attrs_fallible(infer_output_attrs_fallible)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .fallback();
+
+}  // namespace kv_cache_append
+
+namespace kv_cache_attention {
+
+std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible(
+        const OpDef& def, const SmallVector<LogicalTensorDesc>& inputs) {
+    auto&& op = def.cast_final_safe<KVCacheAttention>();
+    mgb_assert(inputs.size() == 5, "KVCacheAttention expects 5 inputs");
+    auto&& q = inputs[0];
+    TensorLayout dst_layout{q.layout.dtype};
+    bool succeed = q.layout.ndim != 0;
+    if (succeed) {
+        DnnOprHelper<megdnn::KVCacheAttention> dnn_op(op.param());
+        dst_layout = dnn_op.deduce_layout(
+                q.layout, inputs[1].layout, inputs[2].layout, inputs[3].layout,
+                inputs[4].layout);
+    }
+    return {{{dst_layout, q.comp_node}}, succeed};
+}
+
+SmallVector<TensorPtr> apply_on_physical_tensor(
+        const OpDef& def, const SmallVector<TensorPtr>& inputs,
+        SmallVector<LogicalTensorDesc>& output_descs, const bool& validated) {
+    auto&& op = def.cast_final_safe<KVCacheAttention>();
+    auto cn = inputs[0]->comp_node();
+    DnnOprCaller<megdnn::KVCacheAttention> dnn_op{cn, op.param()};
+    auto dst_layout = dnn_op.deduce_layout(
+            inputs[0]->layout(), inputs[1]->layout(), inputs[2]->layout(),
+            inputs[3]->layout(), inputs[4]->layout());
+    auto dst = Tensor::make(dst_layout, cn);
+    dnn_op.exec_with_ws(inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], dst);
+    return {dst};
+}
+
+OP_TRAIT_REG(KVCacheAttention, KVCacheAttention)
+        .infer_output_attrs_fallible(infer_output_attrs_fallible)
+        .apply_on_physical_tensor(apply_on_physical_tensor)
+        .fallback();
+
+}  // namespace kv_cache_attention
+}  // namespace
+
+}  // namespace imperative
+}  // namespace mgb
@@ -240,6 +240,21 @@ struct OpMeth<MultinomialRNG> {
     }
 };
 
+template <>
+struct OpMeth<LogitsSamplingRNG> {
+    using DnnOp = megdnn::LogitsSamplingRNG;
+    using Param = DnnOp::Param;
+    using OpNode = mgb::opr::LogitsSamplingRNG;
+    static Param make_param(const LogitsSamplingRNG& rng) {
+        auto handle_seed = RNGDnnOpManager::get_seed(rng.handle);
+        mgb_assert(
+                handle_seed == rng.seed,
+                "inconsistent rng seed: rng op: %lu handle: %lu", handle_seed,
+                rng.seed);
+        return {handle_seed, rng.top_k, rng.top_p, rng.temperature};
+    }
+};
+
 template <>
 struct OpMeth<PermutationRNG> {
     using DnnOp = megdnn::PermutationRNG;
@@ -624,6 +639,31 @@ template <typename Op>
 std::tuple<SmallVector<LogicalTensorDesc>, bool> _infer_output_attrs(
         const OpDef& op, const SmallVector<TensorLayout>& inputs, const CompNode cn){};
 
+template <>
+SmallVector<LogicalTensorDesc> infer_output_attrs<LogitsSamplingRNG>(
+        const OpDef& op, const SmallVector<TensorPtr>& inputs) {
+    LogicalTensorDesc dest;
+    auto&& rng = op.cast_final_safe<LogitsSamplingRNG>();
+    auto handle = rng.handle;
+    if (handle) {
+        dest.comp_node = RNGDnnOpManager::get_comp_node(handle);
+    } else {
+        dest.comp_node = inputs[0]->comp_node();
+    }
+    mgb_assert(
+            inputs[0]->comp_node() == dest.comp_node,
+            "%s expects the device of inputs[0] to be same as the device of "
+            "handle; got %s and %s actually",
+            rng.dyn_typeinfo()->name, inputs[0]->comp_node().to_string().c_str(),
+            dest.comp_node.to_string().c_str());
+    mgb_assert(
+            inputs[0]->layout().ndim == 2,
+            "%s expects the ndim of inputs[0] to be 2; got %zu actually",
+            rng.dyn_typeinfo()->name, inputs[0]->layout().ndim);
+    dest.layout = TensorLayout({inputs[0]->layout().shape[0]}, dtype::Int32());
+    return {dest};
+}
+
 template <>
 std::tuple<SmallVector<LogicalTensorDesc>, bool> _infer_output_attrs<MultiHeadAttn>(
         const OpDef& op, const SmallVector<TensorLayout>& inputs, const CompNode cn) {
@@ -992,6 +1032,21 @@ std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible<
     return {{dest}, success};
 }
 
+template <>
+std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible<
+        LogitsSamplingRNG>(
+        const OpDef& def, const SmallVector<LogicalTensorDesc>& inputs) {
+    bool success = inputs[0].layout.ndim != 0;
+    LogicalTensorDesc dest;
+    dest.comp_node = inputs[0].comp_node;
+    if (success) {
+        dest.layout = TensorLayout({inputs[0].layout.shape[0]}, dtype::Int32());
+    } else {
+        dest.layout = TensorLayout(dtype::Int32());
+    }
+    return {{dest}, success};
+}
+
 template <typename Op>
 SmallVector<VarNode::LayoutConstraintCallback> get_input_layout_constraint(
         const OpDef& def, const SmallVector<TensorPtr>& inputs) {
@@ -1038,6 +1093,7 @@ REG_RNG_OP(PermutationRNG, SymbolVar)
 REG_RNG_OP(PoissonRNG, SymbolVar)
 REG_RNG_OP(BetaRNG, SymbolVar)
 REG_RNG_OP(MultinomialRNG, SymbolVar)
+REG_RNG_OP(LogitsSamplingRNG, SymbolVar)
 REG_RNG_OP(ShuffleRNG, SymbolVarArray)
 REG_RNG_OP(ExponentialRNG, SymbolVar)
 REG_RNG_OP(Dropout, SymbolVarArray)
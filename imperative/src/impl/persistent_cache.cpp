@@ -7,6 +7,7 @@
 #include "megbrain/imperative/persistent_cache.h"
 #include "megbrain/imperative/utils/base64.h"
 #include "megbrain/utils/infile_persistent_cache.h"
+#include "megbrain/utils/logfile_persistent_cache.h"
 
 namespace mgb::imperative::persistent_cache {
 
@@ -178,6 +179,34 @@ public:
     }
 };
 
+class ExtendedLogFilePersistentCache final : public ExtendedPersistentCache {
+private:
+    std::string m_path;
+    std::unique_ptr<mgb::LogFilePersistentCache> m_impl;
+
+public:
+    void open(std::string path) {
+        m_impl = std::make_unique<mgb::LogFilePersistentCache>(path.c_str());
+        m_path = path;
+    }
+
+    mgb::Maybe<Blob> get(const std::string& category, const Blob& key) override {
+        return m_impl->get(category, key);
+    }
+
+    void put(const std::string& category, const Blob& key, const Blob& value) override {
+        return m_impl->put(category, key, value);
+    }
+
+    //! the file is shared by other processes, so it can not be cleared here
+    std::optional<size_t> clear() override { return {}; }
+
+    bool valid() const override { return m_impl != nullptr; }
+
+    //! every put is written to the file immediately
+    void flush() override {}
+};
+
 std::shared_ptr<ExtendedPersistentCache> ExtendedPersistentCache::make_from_config(
         std::string type, std::unordered_map<std::string, std::string> args,
         std::string& err_msg) {
@@ -205,6 +234,11 @@ std::shared_ptr<ExtendedPersistentCache> ExtendedPersistentCache::make_from_conf
             auto cache = std::make_shared<ExtendedInFilePersistentCache>();
             cache->open(path);
             return cache;
+        } else if (type == "log-file") {
+            std::string path = args.at("path");
+            auto cache = std::make_shared<ExtendedLogFilePersistentCache>();
+            cache->open(path);
+            return cache;
         } else if (type == "in-memory") {
             auto cache = std::make_shared<ExtendedInFilePersistentCache>();
             cache->open();
@@ -1,5 +1,6 @@
 #include "megbrain/imperative/profiler.h"
 
+#include <algorithm>
 #include <chrono>
 #include <unordered_map>
 
@@ -37,16 +38,21 @@ Timer Profiler::sm_timer;
 profiler::HostTime Profiler::sm_start_at = profiler::HostTime::min();
 std::atomic_uint64_t Profiler::sm_last_id = 0;
 bool Profiler::sm_profiling = false;
+profiler::Duration Profiler::sm_keep_recent;
+uint64_t Profiler::sm_pinned_id = 0;
 thread_local Profiler* Profiler::tm_profiler = nullptr;
 std::atomic_size_t Profiler::sm_preferred_capacity;
 
 void Profiler::start_profile() {
     mgb_assert(!sm_profiling);
     sm_start_at = Timer::record_host();
+    sm_keep_recent = std::chrono::duration_cast<profiler::Duration>(
+            std::chrono::milliseconds(get_option("keep_recent_ms", 0)));
     sm_profiling = true;
     if (cupti::enabled()) {
         MGB_RECORD_EVENT(profiler::CUPTITimestampEvent, cupti::clock::now());
     }
+    sm_pinned_id = sm_last_id;
 }
 
 void Profiler::stop_profile() {
@@ -60,6 +66,17 @@ void Profiler::stop_step() {
     MGB_RECORD_EVENT(profiler::StopStepEvent);
 }
 
+void Profiler::trim_records(profiler::Time now) {
+    auto deadline = now - sm_keep_recent;
+    auto iter = std::remove_if(
+            m_records.begin(), m_records.end(), [&](const Record& record) {
+                return record.id >= sm_pinned_id && record.time < deadline;
+            });
+    m_records.erase(iter, m_records.end());
+    // trim again after the size doubles, so that the cost is amortized
+    m_trim_size = std::max(m_records.size() * 2, sm_min_trim_size);
+}
+
 auto Profiler::get_thread_dict() -> thread_dict_t {
     thread_dict_t thread_dict;
     for (auto&& [tid, profiler] : sm_profilers) {
@@ -6,10 +6,11 @@
 #error Unsupported platform
 #endif
 
+#include <fstream>
+
 #include "nlohmann/json.hpp"
 
 #include "megbrain/imperative/utils/platform.h"
-#include "megbrain/utils/debug.h"
 
 #include "./formats.h"
 #include "./states.h"
@@ -159,29 +160,25 @@ public:
 
     std::string& metadata(std::string key) { return m_metadata[key]; }
 
-    nlohmann::json to_json() const {
-        nlohmann::json result;
-        nlohmann::json event_list;
-        nlohmann::json metadata;
+    /*!
+     * write the events one by one, instead of building the json of all the
+     * events in memory, which takes several times the memory of the events
+     */
+    void write(std::ostream& os) const {
+        os << "{\"traceEvents\":[";
+        bool first = true;
         for (auto&& event : m_content) {
-            event_list.push_back(event.to_json());
+            if (!first) {
+                os << ",";
+            }
+            first = false;
+            os << event.to_json().dump();
         }
+        nlohmann::json metadata = nlohmann::json::object();
         for (auto&& [key, value] : m_metadata) {
             metadata[key] = value;
         }
-        result["traceEvents"] = event_list;
-        result["metadata"] = metadata;
-        return result;
-    }
-
-    std::string to_string() const {
-        auto json = to_json();
-        return "{"
-               "\"traceEvents\":" +
-               nlohmann::to_string(json["traceEvents"]) +
-               ","
-               "\"metadata\":" +
-               nlohmann::to_string(json["metadata"]) + "}";
+        os << "],\"metadata\":" << metadata.dump() << "}";
     }
 
 private:
@@ -295,6 +292,13 @@ struct ChromeTimelineEventVisitor : EventVisitor<ChromeTimelineEventVisitor> {
             new_device_event(current_op->name, 'E', event.device)
                     .cat("Kernel")
                     .args(current_op->detail());
+        } else if constexpr (std::is_same_v<TEvent, HWCounterEvent>) {
+            auto&& v = event.value;
+            new_device_event("ipc", 'C', event.device).arg("value", v.ipc());
+            new_device_event("cache_misses", 'C', event.device)
+                    .arg("value", v.cache_misses);
+            new_device_event("memory_bytes", 'C', event.device)
+                    .arg("value", v.memory_bytes());
         } else if constexpr (std::is_same_v<TEvent, TensorProduceEvent>) {
             if (current_tensor->living_time == profiler::Duration::zero()) {
                 new_host_event(pid_str, 's')
@@ -541,11 +545,14 @@ void dump_chrome_timeline(std::string filename, Profiler::bundle_t result) {
             .arg("value", train_time_ratio);
 
     visitor.name_threads(result.thread_dict);
+    // the records are no longer needed
+    std::vector<Profiler::entry_t>().swap(result.entries);
     auto trace_events = std::move(visitor.trace_events);
     trace_events.metadata("localTime") =
             std::to_string(result.start_at.time_since_epoch().count());
-    std::string json_repr = trace_events.to_string();
-    mgb::debug::write_to_file(filename.c_str(), json_repr);
+    std::ofstream os(filename, std::ios::binary);
+    mgb_assert(os.good(), "failed to open %s", filename.c_str());
+    trace_events.write(os);
 }
 
 }  // namespace mgb::imperative::profiler
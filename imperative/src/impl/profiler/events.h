@@ -1,6 +1,7 @@
 #pragma once
 
 #include "megbrain/imperative/profiler.h"
+#include "megbrain/utils/hw_counter.h"
 #include "megbrain/utils/small_vector.h"
 
 #include "../interpreter/stack_manager.h"
@@ -177,6 +178,13 @@ DEF_DUR_EVENT(HostToDevice, {
 
 DEF_EVENT(StopStep, { CompNode device; });
 
+// hardware counters of the dispatcher thread of a cpu comp node during a kernel
+DEF_EVENT(HWCounter, {
+    uint64_t kernel_id;
+    CompNode device;
+    HWCounter::Value value;
+});
+
 // cupti events
 DEF_EVENT(CUPTITimestamp, { cupti::clock::time_point timestamp; });
 
@@ -251,7 +251,13 @@ protected:
 
     size_t to_tid(std::thread::id host_tid) { return m_host_tid_table.at(host_tid); }
 
-    size_t to_tid(CompNode device) { return m_device_tid_table.at(device); }
+    size_t to_tid(CompNode device) {
+        // the TensorProduceEvent of device may have been trimmed
+        if (!m_device_tid_table.count(device)) {
+            m_device_tid_table[device] = next_tid();
+        }
+        return m_device_tid_table.at(device);
+    }
 
     size_t to_tid(cupti::stream_t cupti_stream) {
         return m_cupti_tid_table.at(cupti_stream);
@@ -311,7 +317,7 @@ public:
                 CUPTIKernelLaunchFinishEvent, CUPTIKernelExecuteEvent,
                 CUPTIMemcpyLaunchEvent, CUPTIMemcpyLaunchFinishEvent, CUPTIMemcpyEvent,
                 CUPTIRuntimeEvent, CUPTIRuntimeFinishEvent, CUPTIDriverEvent,
-                CUPTIDriverFinishEvent, CUPTIMemsetEvent>
+                CUPTIDriverFinishEvent, CUPTIMemsetEvent, HWCounterEvent>
                 converter;
 
         auto for_each_entry = [&](auto&& handler) {
@@ -445,7 +451,10 @@ public:
                 current_op->executions.back().reason = event.reason;
                 current_op->executions.back().begin = current->time;
             } else if constexpr (std::is_same_v<T, OpExecuteFinishEvent>) {
-                current_op->executions.back().end = current->time;
+                // the OpExecuteEvent may have been trimmed
+                if (!current_op->executions.empty()) {
+                    current_op->executions.back().end = current->time;
+                }
             }
             // update counters
             if constexpr (std::is_same_v<T, OpDispatchEvent>) {
@@ -467,23 +476,27 @@ public:
             } else if constexpr (std::is_same_v<T, WorkerExceptionEvent>) {
                 inc_counter("nr_exception", 1);
             } else if constexpr (std::is_same_v<T, KernelLaunchFinishEvent>) {
-                auto& execution = current_op->executions.back();
-                auto overhead = to_device_time(current->time, event.device) -
-                                to_device_time(execution.begin, event.device);
-
-                std::vector<profiler::HostTime> current_kernel_start_finish;
-                current_kernel_start_finish.emplace_back(
-                        to_device_time(execution.begin, event.device));
-                current_kernel_start_finish.emplace_back(
-                        to_device_time(current->time, event.device));
-                m_kernel_start_finish_time.emplace_back(current_kernel_start_finish);
-
-                if (execution.reason == "dtr") {
-                    inc_counter(
-                            "dtr_overhead_us",
-                            std::chrono::duration_cast<std::chrono::microseconds>(
-                                    overhead)
-                                    .count());
+                // the OpExecuteEvent may have been trimmed
+                if (!current_op->executions.empty()) {
+                    auto& execution = current_op->executions.back();
+                    auto overhead = to_device_time(current->time, event.device) -
+                                    to_device_time(execution.begin, event.device);
+
+                    std::vector<profiler::HostTime> current_kernel_start_finish;
+                    current_kernel_start_finish.emplace_back(
+                            to_device_time(execution.begin, event.device));
+                    current_kernel_start_finish.emplace_back(
+                            to_device_time(current->time, event.device));
+                    m_kernel_start_finish_time.emplace_back(
+                            current_kernel_start_finish);
+
+                    if (execution.reason == "dtr") {
+                        inc_counter(
+                                "dtr_overhead_us",
+                                std::chrono::duration_cast<
+                                        std::chrono::microseconds>(overhead)
+                                        .count());
+                    }
                 }
             }
             // visit_event_impl
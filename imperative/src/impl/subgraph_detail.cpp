@@ -26,14 +26,16 @@ VarNodeArray apply_on_var_node(const OpDef& def, const VarNodeArray& inputs) {
         return opr::ImmutableTensor::make(*inputs[0]->owner_graph(), value->get_value())
                 .node();
     };
-    auto subgraph = def.trait()->make_forward_graph(def, input_descs);
+    auto subgraph = OpDef::make_forward_graph(def, input_descs);
     auto outputs = subgraph.apply<VarNode*>(inputs, apply_functor, const_functor);
     return outputs;
 }
 
 std::tuple<SmallVector<LogicalTensorDesc>, bool> infer_output_attrs_fallible(
         const OpDef& def, const SmallVector<LogicalTensorDesc>& inputs) {
-    auto subgraph = def.trait()->make_forward_graph(def, inputs);
+    // the expanded graph is cached by OpDef::make_forward_graph, so that it is
+    // not built again on each call of a composite op
+    auto subgraph = OpDef::make_forward_graph(def, inputs);
     bool all_validated = true;
     auto apply_functor = [&](const std::shared_ptr<OpDef>& op,
                              const SmallVector<LogicalTensorDesc>& inputs,
@@ -59,7 +61,7 @@ SmallVector<TensorPtr> apply_on_physical_tensor(
     for (auto&& input : inputs) {
         input_descs.push_back({input->layout(), input->comp_node()});
     }
-    auto subgraph = def.trait()->make_forward_graph(def, input_descs);
+    auto subgraph = OpDef::make_forward_graph(def, input_descs);
     auto apply_functor = [&output_descs](
                                  const std::shared_ptr<OpDef>& op,
                                  const SmallVector<TensorPtr>& inputs,
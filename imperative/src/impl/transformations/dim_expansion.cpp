@@ -82,6 +82,13 @@ ValueRefList DimExpansionTransformation::apply_transformation(
     return imperative::apply(op, inputs);
 }
 
+bool DimExpansionTransformation::bypass(const Operator& op, Span<ValueRef> inputs) const {
+    if (auto apply_op = op.as<ApplyOp>()) {
+        return !dim_expansion_rules.count(apply_op->op().dyn_typeinfo());
+    }
+    return true;
+}
+
 ValueRef DimExpansionTransformation::unwrap(ValueRef value) {
     return value;
 }
@@ -1,5 +1,6 @@
 #include "megbrain/imperative/transformations/dtype_promote.h"
 #include "megbrain/imperative/ops/autogen.h"
+#include "megbrain/imperative/transformations/grad.h"
 
 namespace mgb::imperative {
 
@@ -42,6 +43,85 @@ SmallVector<DType> get_value_dtypes(const Span<ValueRef> inputs) {
     return dtypes;
 }
 
+/*!
+ * \brief the casts to amp_low_prec_dtype done by autocast
+ *
+ * Values are immutable, so the cast of a value (e.g. a parameter used by many
+ * convolutions or in each step of a loop) can be reused until the value dies.
+ * Values are keyed by id, and the entries of dead values are dropped lazily.
+ * The cache is cleared when autocast is switched, when a trace starts or ends,
+ * and on InplaceAdd, which is the only op that writes a value in place.
+ *
+ * The cache is bypassed and emptied while any grad transformation is
+ * registered: a cast recorded by one grad key must not be reused by the
+ * next one, and the cached copies of weights should not be kept alive during
+ * training. Inputs with grad attached imply a registered grad transformation.
+ */
+class AmpCastCache {
+    struct Entry {
+        ValueWeakRef input;
+        DType dtype;
+        ValueRef output;
+    };
+    std::unordered_map<uint64_t, Entry> m_entries;
+    //! size of m_entries at which the entries of dead values are dropped
+    size_t m_purge_size = 64;
+
+    void purge() {
+        for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+            if (!iter->second.input.lock()) {
+                iter = m_entries.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        m_purge_size = std::max<size_t>(64, m_entries.size() * 2);
+    }
+
+public:
+    ValueRef cast(const ValueRef& input, DType dtype) {
+        if (GradTransformation::any_registered()) {
+            clear();
+            return imperative::apply(ApplyOp(*TypeCvt::make(dtype)), input)[0];
+        }
+        auto iter = m_entries.find(input.id());
+        if (iter != m_entries.end() && iter->second.dtype == dtype &&
+            iter->second.input.lock()) {
+            return iter->second.output;
+        }
+        auto output = imperative::apply(ApplyOp(*TypeCvt::make(dtype)), input)[0];
+        if (m_entries.size() >= m_purge_size) {
+            purge();
+        }
+        m_entries[input.id()] = Entry{ValueWeakRef{input}, dtype, output};
+        return output;
+    }
+
+    void clear() { m_entries.clear(); }
+
+    static AmpCastCache& inst() {
+        static AmpCastCache cache;
+        return cache;
+    }
+};
+
+//! cast the inputs not of \p target_dtype; autocast reuses cached casts
+ValueRefList convert_inputs(
+        Span<ValueRef> inputs, const SmallVector<DType>& dtypes, DType target_dtype) {
+    ValueRefList converted(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (dtypes[i] == target_dtype) {
+            converted[i] = inputs[i];
+        } else if (DTypePromoteCfg::amp_dtype_autocast_enabled) {
+            converted[i] = AmpCastCache::inst().cast(inputs[i], target_dtype);
+        } else {
+            converted[i] = imperative::apply(
+                    ApplyOp(*TypeCvt::make(target_dtype)), inputs[i])[0];
+        }
+    }
+    return converted;
+}
+
 mgb::DType get_promoted_dtype(const SmallVector<DType>& dtypes) {
     if (dtypes.size() == 0) {
         mgb_assert(false, "there is no input for operator, dtype promote failed");
@@ -210,16 +290,7 @@ ValueRefList convolution_rule(const OpDef& op, Span<ValueRef> inputs) {
         target_dtype = get_promoted_dtype(dtypes);
     }
 
-    ValueRefList converted(inputs.size());
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        if (dtypes[i] != target_dtype) {
-            converted[i] = imperative::apply(
-                    ApplyOp(*TypeCvt::make(target_dtype)), inputs[i])[0];
-        } else {
-            converted[i] = inputs[i];
-        }
-    }
-
+    auto converted = convert_inputs(inputs, dtypes, target_dtype);
     return imperative::apply(op, converted);
 }
 
@@ -244,16 +315,7 @@ ValueRefList matmul_rule(const OpDef& op, Span<ValueRef> inputs) {
         target_dtype = get_promoted_dtype(dtypes);
     }
 
-    ValueRefList converted(inputs.size());
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        if (dtypes[i] != target_dtype) {
-            converted[i] = imperative::apply(
-                    ApplyOp(*TypeCvt::make(target_dtype)), inputs[i])[0];
-        } else {
-            converted[i] = inputs[i];
-        }
-    }
-
+    auto converted = convert_inputs(inputs, dtypes, target_dtype);
     return imperative::apply(op, converted);
 }
 
@@ -279,16 +341,7 @@ ValueRefList batch_matmul_rule(const OpDef& op, Span<ValueRef> inputs) {
         target_dtype = get_promoted_dtype(dtypes);
     }
 
-    ValueRefList converted(inputs.size());
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        if (dtypes[i] != target_dtype) {
-            converted[i] = imperative::apply(
-                    ApplyOp(*TypeCvt::make(target_dtype)), inputs[i])[0];
-        } else {
-            converted[i] = inputs[i];
-        }
-    }
-
+    auto converted = convert_inputs(inputs, dtypes, target_dtype);
     return imperative::apply(op, converted);
 }
 
@@ -311,16 +364,7 @@ ValueRefList convolution_backward_rule(const OpDef& op, Span<ValueRef> inputs) {
         target_dtype = get_promoted_dtype(dtypes);
     }
 
-    ValueRefList converted(inputs.size());
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        if (dtypes[i] != target_dtype) {
-            converted[i] = imperative::apply(
-                    ApplyOp(*TypeCvt::make(target_dtype)), inputs[i])[0];
-        } else {
-            converted[i] = inputs[i];
-        }
-    }
-
+    auto converted = convert_inputs(inputs, dtypes, target_dtype);
     return imperative::apply(op, converted);
 }
 
@@ -422,6 +466,12 @@ ValueRefList where_rule(const OpDef& op, Span<ValueRef> inputs) {
     return imperative::apply(op, converted);
 }
 
+ValueRefList inplace_add_rule(const OpDef& op, Span<ValueRef> inputs) {
+    // the cached casts of the updated value are stale
+    AmpCastCache::inst().clear();
+    return imperative::apply(op, inputs);
+}
+
 struct DTypePromoteRuleRegistry {
     DTypePromoteRuleRegistry() {
         register_dtype_promote_rule<Elemwise>(elemwise_rule);
@@ -442,11 +492,16 @@ struct DTypePromoteRuleRegistry {
         register_dtype_promote_rule<SetSubtensor>(setsubtensor_rule);
         register_dtype_promote_rule<IndexingSetMultiAxisVec>(setsubtensor_rule);
         register_dtype_promote_rule<Where>(where_rule);
+        register_dtype_promote_rule<InplaceAdd>(inplace_add_rule);
     }
 } register_helper;
 
 }  // namespace
 
+void DTypePromoteCfg::clear_amp_cast_cache() {
+    AmpCastCache::inst().clear();
+}
+
 ValueRefList DTypePromoteTransformation::apply_transformation(
         const Operator& op, Span<ValueRef> inputs) {
     if (auto apply_op = op.as<ApplyOp>()) {
@@ -461,6 +516,13 @@ ValueRefList DTypePromoteTransformation::apply_transformation(
     return imperative::apply(op, inputs);
 }
 
+bool DTypePromoteTransformation::bypass(const Operator& op, Span<ValueRef> inputs) const {
+    if (auto apply_op = op.as<ApplyOp>()) {
+        return !dtype_promotion_rules.count(apply_op->op().dyn_typeinfo());
+    }
+    return true;
+}
+
 ValueRef DTypePromoteTransformation::unwrap(ValueRef value) {
     return value;
 }
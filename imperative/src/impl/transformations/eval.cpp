@@ -120,6 +120,9 @@ ValueRefList InterpreterTransformation::apply_transformation(
                 mgb_throw(AssertionError, "unknown DTRCommand %d", dtr_command->kind());
         }
         return {};
+    } else if (op.is<PrefetchValue>()) {
+        auto handle = inputs[0].cast(m_value_type).handle()->handle();
+        return {BoolValue::make(m_channel->prefetch_value(handle))};
     } else if (auto* rename_value = op.as<RenameValue>()) {
         auto& input = inputs[0].cast(m_value_type);
         return {m_value_type.make(input.handle(), rename_value->name())};
@@ -580,7 +580,17 @@ GenericFunction GradTransformation::make_backward_closure(Span<ValueRef> ys) {
     return closure;
 }
 
+size_t& GradTransformation::nr_registered() {
+    thread_local size_t nr = 0;
+    return nr;
+}
+
+void GradTransformation::on_register() {
+    ++nr_registered();
+}
+
 void GradTransformation::on_unregister() noexcept {
+    --nr_registered();
     cleanup();
 }
 
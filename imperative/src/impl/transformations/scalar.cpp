@@ -409,5 +409,19 @@ ValueRefList ScalarTransformation::apply_transformation(
     }
 };
 
+bool ScalarTransformation::bypass(const Operator& op, Span<ValueRef> inputs) const {
+    auto* apply_op = op.as<ApplyOp>();
+    if (!apply_op || apply_op->op().same_type<FastpathCopy>() ||
+        scalar_rules.count(apply_op->op().dyn_typeinfo())) {
+        return false;
+    }
+    for (auto&& input : inputs) {
+        if (input.is(m_value_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace imperative
 }  // namespace mgb
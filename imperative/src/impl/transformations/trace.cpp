@@ -392,13 +392,29 @@ void CompiledTransformation::compile() {
     static std::unordered_set<Typeinfo*> mm_io_ops = {
             CollectiveComm::typeinfo(), RemoteSend::typeinfo(), RemoteRecv::typeinfo()};
     mgb_assert(!m_executable, "already compiled");
+    m_capture = !m_imperative && options().comp_node_seq_record_level > 0;
     // FIXME: mm_io_link and io_links should be merged
     SymbolVarArray io_links;
     SymbolVar mm_io_link;
+    SymbolVarArray capture_outputs;
     auto make_input = [&](VarInfo* var_info) {
         mgb_assert(
                 var_info->kind == VarKind::External, "input node should be external");
         VarAccessor accessor;
+        if (m_capture) {
+            // the recorded kernels read the inputs from the fixed addresses, and
+            // the scalars are fed as 1-dim tensors like the other inputs
+            auto shape = var_info->shape.ndim ? var_info->shape : TensorShape{1};
+            auto buffer = std::make_shared<DeviceTensorND>(
+                    *var_info->device, shape, *var_info->dtype);
+            accessor.node = opr::SharedDeviceTensor::make(*m_graph, buffer).node();
+            accessor.data_setter = [buffer](DeviceTensorND data) {
+                if (data.raw_ptr() != buffer->raw_ptr()) {
+                    buffer->copy_from_fixlayout(data);
+                }
+            };
+            return accessor;
+        }
         auto box = make_box<DeviceTensorND>();
         // TODO: attach ref count, release early
         auto outputs = opr::InputCallback::make(
@@ -430,6 +446,25 @@ void CompiledTransformation::compile() {
             // FIXME: compile should not change var_info in-place
             var_info->shape_required = false;
         }
+        if (m_capture) {
+            mgb_assert(
+                    !var_info->shape_required && !var_info->value_required,
+                    "shapes or values can not be read from a captured graph");
+            if (var_info->data_required) {
+                // the output is overwritten by the next replay, so it is copied
+                capture_outputs.push_back(node);
+                accessor.data_getter = [this, node]() -> DeviceTensorND {
+                    run_captured();
+                    DeviceTensorND ret;
+                    ret.copy_from(node.node()->dev_tensor());
+                    return ret;
+                };
+                accessor.shape_getter = [node]() -> TensorShape {
+                    return node.node()->shape();
+                };
+            }
+            return accessor;
+        }
         if (var_info->shape_required) {
             // TODO: use static infer manager for some vars?
             auto box = make_box<TensorShape>();
@@ -562,6 +597,9 @@ void CompiledTransformation::compile() {
     if (mm_io_link.node()) {
         output_specs.push_back({mm_io_link, {}});
     }
+    for (auto&& output : capture_outputs) {
+        output_specs.push_back({output, {}});
+    }
     {
         // set_priority_to_id
         // workaround for having mm_io_link and io_links separated
@@ -849,6 +887,10 @@ void CompiledTransformation::on_unregister() noexcept {
 
 void CompiledTransformation::execute() {
     mgb_assert(m_executable != nullptr);
+    if (m_capture) {
+        m_capture_pending = true;
+        return;
+    }
     {
         MGB_LOCK_GUARD(m_mutex);
         m_graph_status = 1;
@@ -856,12 +898,31 @@ void CompiledTransformation::execute() {
     m_cv.notify_all();
 }
 
+void CompiledTransformation::run_captured() {
+    if (!m_capture_pending) {
+        return;
+    }
+    m_capture_pending = false;
+    try {
+        m_executable->execute();
+    } catch (...) {
+        std::rethrow_exception(set_exception(std::current_exception()));
+    }
+}
+
 void CompiledTransformation::wait() {
     try {
         trace_assert(m_pc == m_seq.size(), "mismature end");
     } catch (...) {
     }
-    if (!m_imperative) {
+    if (m_capture) {
+        try {
+            run_captured();
+            m_executable->wait();
+        } catch (...) {
+            set_exception(std::current_exception());
+        }
+    } else if (!m_imperative) {
         wait_worker();
     }
     for (auto&& box : m_boxes) {
@@ -898,5 +959,131 @@ std::exception_ptr CompiledTransformation::set_exception(
     return m_graph_exc;
 }
 
+bool TraceSignature::has_symbolic_dims() const {
+    for (auto&& i : inputs) {
+        if (i.symbolic_dims) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TraceSignature::match(const TraceSignature& rhs) const {
+    if (inputs.size() != rhs.inputs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto&& lhs_inp = inputs[i];
+        auto&& rhs_inp = rhs.inputs[i];
+        if (lhs_inp.dtype != rhs_inp.dtype || lhs_inp.device != rhs_inp.device ||
+            lhs_inp.shape.ndim != rhs_inp.shape.ndim) {
+            return false;
+        }
+        for (size_t j = 0; j < lhs_inp.shape.ndim; ++j) {
+            if (!(lhs_inp.symbolic_dims >> j & 1) &&
+                lhs_inp.shape[j] != rhs_inp.shape[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::optional<TraceSignature> TraceSignature::generalize(
+        const TraceSignature& rhs) const {
+    if (inputs.size() != rhs.inputs.size()) {
+        return std::nullopt;
+    }
+    TraceSignature ret = *this;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto&& inp = ret.inputs[i];
+        auto&& rhs_inp = rhs.inputs[i];
+        if (inp.dtype != rhs_inp.dtype || inp.device != rhs_inp.device ||
+            inp.shape.ndim != rhs_inp.shape.ndim) {
+            return std::nullopt;
+        }
+        for (size_t j = 0; j < inp.shape.ndim; ++j) {
+            if (inp.shape[j] != rhs_inp.shape[j]) {
+                inp.symbolic_dims |= 1u << j;
+            }
+        }
+    }
+    return ret;
+}
+
+std::string TraceSignature::to_string() const {
+    std::string ret = "(";
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto&& inp = inputs[i];
+        if (i) {
+            ret += ", ";
+        }
+        ret += "{";
+        for (size_t j = 0; j < inp.shape.ndim; ++j) {
+            if (j) {
+                ret += ",";
+            }
+            if (inp.symbolic_dims >> j & 1) {
+                ret += "?";
+            } else {
+                ret += std::to_string(inp.shape[j]);
+            }
+        }
+        ret += ssprintf(
+                "} %s %s", inp.dtype.valid() ? inp.dtype.name() : "invalid",
+                inp.device.to_string().c_str());
+    }
+    return ret + ")";
+}
+
+TraceCache::Entry* TraceCache::lookup(
+        const TraceSignature& signature, bool polymorphic) {
+    auto found = m_entries.end();
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+        if (iter->signature.match(signature)) {
+            found = iter;
+            if (!iter->signature.has_symbolic_dims()) {
+                break;
+            }
+        }
+    }
+    if (found == m_entries.end() && polymorphic) {
+        for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+            if (!iter->result) {
+                continue;
+            }
+            if (auto generalized = iter->signature.generalize(signature)) {
+                mgb_log_debug(
+                        "generalize trace signature %s to %s",
+                        iter->signature.to_string().c_str(),
+                        generalized->to_string().c_str());
+                iter->signature = std::move(*generalized);
+                if (iter->static_shape) {
+                    iter->compiled.reset();
+                }
+                found = iter;
+                break;
+            }
+        }
+    }
+    if (found == m_entries.end()) {
+        return nullptr;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, found);
+    return &m_entries.front();
+}
+
+TraceCache::Entry& TraceCache::insert(TraceSignature signature) {
+    if (m_entries.size() >= m_capacity) {
+        mgb_log_debug(
+                "evict trace of signature %s",
+                m_entries.back().signature.to_string().c_str());
+        m_entries.pop_back();
+    }
+    m_entries.emplace_front();
+    m_entries.front().signature = std::move(signature);
+    return m_entries.front();
+}
+
 }  // namespace imperative
 }  // namespace mgb
@@ -1,5 +1,7 @@
 #include "megbrain/imperative/value.h"
 
+#include <array>
+
 #include "megbrain/imperative/basic_operators.h"
 #include "megbrain/imperative/dispatch.h"
 #include "megbrain/imperative/utils/map.h"
@@ -13,6 +15,53 @@ static /*thread_local*/ uint64_t nr_values = 0;
 static /*thread_local*/ bool recording_values = false;
 static /*thread_local*/ std::vector<ValueWeakRef> recorded_values;
 static WeakValueMap<uint64_t, ValueWeakRef> registered_values;
+
+/**
+ * \brief recycles the buffers of small ValueRefLists, which are created and
+ * destroyed in each dispatch
+ */
+class ValueRefListPool {
+private:
+    static constexpr size_t MAX_NR_ELEMS = 8;
+    static constexpr size_t MAX_NR_CACHED = 64;
+    std::array<std::vector<void*>, MAX_NR_ELEMS + 1> m_free;
+    static thread_local bool sm_destroyed;
+
+public:
+    ~ValueRefListPool() {
+        for (auto&& buffers : m_free) {
+            for (auto buffer : buffers) {
+                ::operator delete(buffer);
+            }
+        }
+        sm_destroyed = true;
+    }
+
+    void* alloc(size_t nr_elems) {
+        if (nr_elems <= MAX_NR_ELEMS && !m_free[nr_elems].empty()) {
+            auto buffer = m_free[nr_elems].back();
+            m_free[nr_elems].pop_back();
+            return buffer;
+        }
+        return ::operator new(nr_elems * sizeof(ValueRef));
+    }
+
+    void free(void* buffer, size_t nr_elems) {
+        if (nr_elems <= MAX_NR_ELEMS && m_free[nr_elems].size() < MAX_NR_CACHED) {
+            m_free[nr_elems].push_back(buffer);
+        } else {
+            ::operator delete(buffer);
+        }
+    }
+
+    //! nullptr if the pool of this thread has been destroyed on thread exit
+    static ValueRefListPool* inst() {
+        thread_local ValueRefListPool pool;
+        return sm_destroyed ? nullptr : &pool;
+    }
+};
+
+thread_local bool ValueRefListPool::sm_destroyed = false;
 }  // namespace
 
 ValueRef::storage_t& ValueRef::storage() const {
@@ -202,7 +251,13 @@ inline void ValueRefList::init(size_t nr_elems) {
         if (m_size == 1) {
             m_data = new (inline_storage()) ValueRef();
         } else {
-            m_data = new ValueRef[m_size];
+            auto pool = ValueRefListPool::inst();
+            void* buffer = pool ? pool->alloc(m_size)
+                                : ::operator new(m_size * sizeof(ValueRef));
+            m_data = static_cast<ValueRef*>(buffer);
+            for (size_t i = 0; i < m_size; ++i) {
+                new (m_data + i) ValueRef();
+            }
         }
     } else {
         m_data = nullptr;
@@ -268,7 +323,14 @@ ValueRefList::~ValueRefList() {
 void ValueRefList::clear() {
     if (m_data) {
         if (m_size != 1) {
-            delete[] m_data;
+            for (size_t i = 0; i < m_size; ++i) {
+                m_data[i].~ValueRef();
+            }
+            if (auto pool = ValueRefListPool::inst()) {
+                pool->free(m_data, m_size);
+            } else {
+                ::operator delete(m_data);
+            }
         } else {
             mgb_assert(m_data == inline_storage());
             m_data->~ValueRef();
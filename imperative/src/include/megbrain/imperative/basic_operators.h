@@ -132,6 +132,21 @@ public:
     ValueRefList fallback(Span<ValueRef> inputs) const override { return {}; }
 };
 
+/**
+ * \brief queue the copy of the value to the host without waiting for it
+ *
+ * The output is a BoolValue telling whether the value is ready to be read
+ * without blocking, and is empty if the input does not support prefetching.
+ */
+class PrefetchValue final
+        : public OperatorImpl<PrefetchValue, Operator::GetAttrLike> {
+public:
+    std::string to_string() const override;
+    std::string raw_type() const { return "PrefetchValue"; }
+
+    ValueRefList fallback(Span<ValueRef> inputs) const override { return {}; }
+};
+
 // deprecated
 class GetName final : public OperatorImpl<GetName, Operator::GetAttrLike> {
 public:
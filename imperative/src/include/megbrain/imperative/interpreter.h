@@ -46,6 +46,9 @@ struct Interpreter {
                 std::shared_ptr<OpDef> op, const SmallVector<Handle>& inputs) = 0;
 
         virtual HostTensorND get_value(Handle) = 0;
+        //! queue the copy of the value to the host if not yet, and return
+        //! whether get_value would not block
+        virtual bool prefetch_value(Handle) = 0;
         virtual TensorShape get_shape(Handle) = 0;
         virtual DType get_dtype(Handle) = 0;
         virtual CompNode get_device(Handle) = 0;
@@ -84,6 +84,8 @@ private:
     std::thread::id m_thread_id;
     std::vector<Record> m_records;
     std::atomic<Status> m_status = Running;
+    //! m_records is trimmed when its size reaches this
+    size_t m_trim_size = sm_min_trim_size;
 
     static std::vector<entry_t> sm_records;
     static std::vector<profiler::HostTime> sm_step_time;
@@ -96,6 +98,11 @@ private:
     static std::atomic_uint64_t sm_last_id;
     static std::atomic_size_t sm_preferred_capacity;
     static bool sm_profiling;
+    //! only keep the records in this duration before now if nonzero
+    static profiler::Duration sm_keep_recent;
+    //! the records whose id is less than this are never trimmed
+    static uint64_t sm_pinned_id;
+    static constexpr size_t sm_min_trim_size = 1024;
     static constexpr bool sm_debug = false;
     thread_local static Profiler* tm_profiler;
 
@@ -104,6 +111,9 @@ public:
         mgb_assert(tid == std::this_thread::get_id(), "thread id mismatch");
     }
 
+private:
+    void trim_records(profiler::Time now);
+
 public:
     static Profiler& get_instance() {
         if (!tm_profiler) {
@@ -131,6 +141,10 @@ public:
         profiler.m_records.emplace_back(
                 id, profiler.m_thread_id, time,
                 AnyPtr::make<T>(T{std::forward<TArgs&&>(args)...}));
+        if (sm_keep_recent.count() &&
+            profiler.m_records.size() >= profiler.m_trim_size) {
+            profiler.trim_records(time);
+        }
         if constexpr (sm_debug) {
             Status expected = Recording;
             mgb_assert(profiler.m_status.compare_exchange_strong(expected, Running));
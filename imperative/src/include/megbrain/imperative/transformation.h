@@ -3,9 +3,11 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "megbrain/common.h"
+#include "megbrain/utils/small_vector.h"
 #include "megbrain/imperative/backtrace.h"
 #include "megbrain/imperative/subgraph.h"
 #include "megbrain/imperative/utils/allocator.h"
@@ -19,6 +21,7 @@ class ValueRef;
 class ValueRefList;
 class Operator;
 class Transformation;
+class IType;
 
 /**
  * \brief args of dispatch action
@@ -29,6 +32,37 @@ struct TransformationFrame {
     const Span<ValueRef>& inputs;
 };
 
+/**
+ * \brief the transformations that a dispatch request can skip, cached by the type of
+ * the operator and the types of the input values
+ *
+ * Bit i of a mask is set if the i-th transformation in the stack would forward the
+ * request unchanged. The cache is cleared whenever the stack is modified.
+ */
+struct DispatchCache {
+    struct Key {
+        size_t typecode;
+        const void* op_type;  // typeinfo of OpDef for ApplyOp
+        SmallVector<const IType*, 4> input_types;
+
+        bool operator==(const Key& rhs) const {
+            return typecode == rhs.typecode && op_type == rhs.op_type &&
+                   input_types == rhs.input_types;
+        }
+        struct Hash {
+            size_t operator()(const Key& key) const;
+        };
+    };
+
+    //! the stack is too deep to be described by a mask if it exceeds this size
+    static constexpr size_t MAX_NR_TRANSFORMATIONS = 64;
+
+    std::unordered_map<Key, uint64_t, Key::Hash> bypass_masks;
+    bool enabled = true;
+
+    void clear() { bypass_masks.clear(); }
+};
+
 struct TransformationContext {
     std::vector<std::shared_ptr<Transformation>> transformations;
     std::vector<std::string> scopes;
@@ -39,6 +73,7 @@ struct TransformationContext {
     size_t record_bt_trans_id;
     bool record_trans_bt = false;
     BackTraceInfoPtr bt;
+    DispatchCache dispatch_cache;
 };
 
 /**
@@ -105,6 +140,19 @@ public:
      */
     virtual void on_unregister() noexcept {};
 
+    /**
+     * \brief whether this would forward the request to downstairs unchanged, so that
+     * dispatch could skip it.
+     *
+     * The result is cached, thus it should only depend on the type of \p op (and the
+     * OpDef type for ApplyOp) and the types of \p inputs. Transformations whose
+     * result also depends on their states should call invalidate_dispatch_cache when
+     * the states change.
+     */
+    virtual bool bypass(const Operator& op, Span<ValueRef> inputs) const {
+        return false;
+    }
+
 public:
     static auto top() { return get_context().transformations.begin(); }
     static auto bottom() { return get_context().transformations.end(); }
@@ -143,6 +191,7 @@ public:
         }
         m_priority = priority;
         context.transformations.insert(pos, shared_from_this());
+        context.dispatch_cache.clear();
         {
             TransformationGuard _{m_priority + 1};
             on_register();
@@ -168,6 +217,7 @@ public:
         }
         m_priority = std::numeric_limits<size_t>::max();
         context.transformations.erase(pos);
+        context.dispatch_cache.clear();
         // TODO: assert priority
     }
     // FIXME: deprecated
@@ -184,8 +234,12 @@ public:
         std::swap(context.scopes, current_context.scopes);
         std::swap(context.next_transformation, current_context.next_transformation);
         std::swap(context.allocator, current_context.allocator);
+        context.dispatch_cache.clear();
+        current_context.dispatch_cache.clear();
     }
 
+    static void invalidate_dispatch_cache() { get_context().dispatch_cache.clear(); }
+
     static TransformationContext& get_context();
 
     friend ValueRefList apply(const Operator& op, Span<ValueRef> inputs);
@@ -12,6 +12,7 @@ public:
             const Operator& op, Span<ValueRef> inputs) override;
     ValueRef unwrap(ValueRef value) override;
     std::string name() const override;
+    bool bypass(const Operator& op, Span<ValueRef> inputs) const override;
     void on_register() override;
     void on_unregister() noexcept override;
 };
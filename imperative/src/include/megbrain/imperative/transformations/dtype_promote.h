@@ -12,6 +12,7 @@ public:
             const Operator& op, Span<ValueRef> inputs) override;
     ValueRef unwrap(ValueRef value) override;
     std::string name() const override;
+    bool bypass(const Operator& op, Span<ValueRef> inputs) const override;
     void on_register() override;
     void on_unregister() noexcept override;
 };
@@ -21,6 +22,9 @@ struct DTypePromoteCfg {
     static bool amp_dtype_autocast_enabled;
     static DType amp_high_prec_dtype;
     static DType amp_low_prec_dtype;
+
+    //! drop the casts cached by autocast, which are reused until cleared
+    static void clear_amp_cast_cache();
 };
 
 }  // namespace mgb::imperative
@@ -268,9 +268,16 @@ private:
     std::vector<GradValue::weak_ref_t> m_weak_values;
     size_t m_suppressed = 0;
 
+    //! number of grad transformations registered on current thread
+    static size_t& nr_registered();
+
 public:
     GradTransformation() { m_key = std::make_shared<GradKey>(m_value_type); }
 
+    //! whether any grad transformation is registered, i.e. ops may be
+    //! recorded by a grad key
+    static bool any_registered() { return nr_registered(); }
+
     auto record_grad(GradValue::ref_t tensor) {
         m_weak_values.push_back(tensor);
         return tensor;
@@ -314,6 +321,8 @@ public:
 
     GenericFunction make_backward_closure(Span<ValueRef> ys);
 
+    void on_register() override;
+
     void on_unregister() noexcept override;
 
     void cleanup();
@@ -50,6 +50,8 @@ public:
 
     std::string name() const override { return "ScalarTransformation"; }
 
+    bool bypass(const Operator& op, Span<ValueRef> inputs) const override;
+
     const Type<ScalarValue>& value_type() const { return m_value_type; }
 };
 
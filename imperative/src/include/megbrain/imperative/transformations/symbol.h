@@ -40,6 +40,19 @@ private:
 
 public:
     SymbolTransformation() {}
+
+    bool bypass(const Operator& op, Span<ValueRef> inputs) const override {
+        if (op.is<CreateNode>()) {
+            return false;
+        }
+        for (auto&& input : inputs) {
+            if (input.is(m_value_type)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     ValueRefList apply_transformation(
             const Operator& op, Span<ValueRef> inputs) override {
         ComputingGraph* cg = nullptr;
@@ -2,6 +2,8 @@
 
 #include <chrono>
 #include <future>
+#include <list>
+#include <optional>
 #include <set>
 #include <variant>
 #include "megbrain/gopt/inference.h"
@@ -333,6 +335,11 @@ private:
     ObjectType<TracedValue> m_value_type{"TracedValue"};
     std::set<size_t> m_setted_extern;
     bool m_imperative = false;
+    //! whether the graph is compiled with comp_node_seq_record_level, so
+    //! that each execution replays the recorded sequence
+    bool m_capture = false;
+    //! whether execute() is called but the captured sequence not launched
+    bool m_capture_pending = false;
 
 public:
     CompiledTransformation(TraceResult result, bool input_shape_static, bool imperative)
@@ -438,6 +445,16 @@ public:
     void set_pc_to_end() { m_pc = m_seq.size(); }
     void execute();
 
+    /**
+     * \brief launch the captured sequence if it is pending
+     *
+     * The host code of the oprs is not replayed, so the inputs of a captured
+     * graph are copied into fixed device buffers, and the sequence is only
+     * launched after all of them are set, i.e. when an output is read or the
+     * trace exits.
+     */
+    void run_captured();
+
     void wait();
 
     void wait_worker();
@@ -467,4 +484,80 @@ public:
     }
 };
 
+/**
+ * \brief shapes, dtypes and comp nodes of the inputs a trace is called with
+ *
+ * A dim marked as symbolic matches any size, so a trace recorded with symbolic
+ * shapes can be reused for e.g. all the batch sizes.
+ */
+struct TraceSignature {
+    struct Input {
+        TensorShape shape;
+        DType dtype;
+        CompNode device;
+        //! bit i is set if shape[i] is symbolic
+        uint32_t symbolic_dims = 0;
+    };
+
+    SmallVector<Input> inputs;
+
+    bool has_symbolic_dims() const;
+
+    //! whether \p rhs is covered by this signature
+    bool match(const TraceSignature& rhs) const;
+
+    /**
+     * \brief the signature covering both this and \p rhs, where the dims they
+     * differ in are marked as symbolic
+     *
+     * \return nullopt if the inputs differ in number, ndim, dtype or comp node
+     */
+    std::optional<TraceSignature> generalize(const TraceSignature& rhs) const;
+
+    std::string to_string() const;
+};
+
+/**
+ * \brief the traces of a function and their compiled graphs, keyed by
+ * TraceSignature and evicted in LRU order
+ */
+class TraceCache {
+public:
+    struct Entry {
+        TraceSignature signature;
+        //! null until the function is traced with this signature
+        std::shared_ptr<TraceResult> result;
+        std::shared_ptr<CompiledTransformation> compiled;
+        //! whether the graph is compiled with static input shapes, so it has to
+        //! be recompiled after generalized
+        bool static_shape = false;
+    };
+
+    explicit TraceCache(size_t capacity) : m_capacity(capacity) {
+        mgb_assert(capacity > 0, "trace cache capacity should be positive");
+    }
+
+    /**
+     * \brief find the entry covering the signature and mark it as recently used
+     *
+     * The exactly matched entries are preferred to those with symbolic dims. If
+     * none is found and \p polymorphic is set, a traced entry differing only in
+     * the sizes of dims is generalized to cover the signature.
+     *
+     * \return nullptr if missed
+     */
+    Entry* lookup(const TraceSignature& signature, bool polymorphic);
+
+    //! add an untraced entry, evicting the least recently used one if full
+    Entry& insert(TraceSignature signature);
+
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    size_t m_capacity;
+    //! the most recently used entry is at the front
+    std::list<Entry> m_entries;
+};
+
 }  // namespace mgb::imperative
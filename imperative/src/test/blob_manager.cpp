@@ -0,0 +1,91 @@
+#include "../impl/blob_manager_impl.h"
+#include "./helper.h"
+
+using namespace mgb;
+using namespace imperative;
+
+TEST(TestBlobManager, SizeClass) {
+    auto size_class = &BlobManagerImpl::size_class;
+    ASSERT_EQ(512u, size_class(0));
+    ASSERT_EQ(512u, size_class(1));
+    ASSERT_EQ(512u, size_class(512));
+    ASSERT_EQ(640u, size_class(513));
+    ASSERT_EQ(1024u, size_class(1000));
+    ASSERT_EQ(1280u, size_class(1025));
+    ASSERT_EQ(3072u, size_class(3000));
+    ASSERT_EQ(4096u, size_class(4096));
+    for (size_t size = 1; size < (1u << 20); size = size * 5 / 4 + 1) {
+        auto cls = size_class(size);
+        // large enough, at most 1/4 of waste, and stable
+        ASSERT_GE(cls, size);
+        ASSERT_LT(cls - size, std::max<size_t>(cls / 4, 512));
+        ASSERT_EQ(cls, size_class(cls));
+    }
+}
+
+#if MGB_CUDA && MGB_ENABLE_EXCEPTION
+namespace {
+void run_compact(size_t mem_reserved) {
+    CompNode::try_coalesce_all_free_memory();
+    CompNode::finalize();
+
+    auto cn = CompNode::load("gpux");
+    cn.sync();  // wait for async init to finish
+
+    HostTensorGenerator<> gen;
+    constexpr size_t nr_tensor = 100;
+    size_t unit_size = mem_reserved / ((nr_tensor + 0.5) * 4);
+    std::shared_ptr<HostTensorND> host[nr_tensor];
+    std::shared_ptr<Tensor> dev[nr_tensor];
+    for (size_t i = 0; i < nr_tensor; ++i) {
+        host[i] = gen({unit_size});
+        dev[i] = Tensor::make(*host[i]);
+    }
+
+    // free half, so each free block holds a single tensor
+    for (size_t i = 0; i < nr_tensor; i += 2) {
+        dev[i].reset();
+    }
+
+    // a few tensors have to be moved to make the block for this
+    auto large = Tensor::make(*gen({unit_size * 3}));
+    ASSERT_EQ(TensorShape({unit_size * 3}), large->shape());
+
+    for (size_t i = 1; i < nr_tensor; i += 2) {
+        HostTensorND value;
+        value.copy_from(dev[i]->dev_tensor()).sync();
+        MGB_ASSERT_TENSOR_EQ(*host[i], value);
+    }
+}
+}  // anonymous namespace
+
+TEST(TestBlobManager, CompactKeepValue) {
+#if WIN32
+    //! FIXME, finalize on CUDA windows will be strip as windows CUDA101 DLL
+    //! issue
+    return;
+#endif
+    REQUIRE_GPU(1);
+    CompNode::load("gpux").activate();
+    size_t reserve;
+    {
+        size_t free, tot;
+        MGB_CUDA_CHECK(cudaMemGetInfo(&free, &tot));
+        reserve = free * 0.92;
+    }
+    auto reserve_setting = ssprintf("b:%zu", reserve);
+
+    // reserve memory explicitly to avoid uncontrollable factors
+    constexpr const char* KEY = "MGB_CUDA_RESERVE_MEMORY";
+    auto old_value = getenv(KEY);
+    setenv(KEY, reserve_setting.c_str(), 1);
+    MGB_TRY { run_compact(reserve); }
+    MGB_FINALLY(
+            if (old_value) { setenv(KEY, old_value, 1); } else {
+                unsetenv(KEY);
+            } CompNode::try_coalesce_all_free_memory();
+            CompNode::finalize(););
+}
+#endif  // MGB_CUDA && MGB_ENABLE_EXCEPTION
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
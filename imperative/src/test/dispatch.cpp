@@ -0,0 +1,133 @@
+#include "./helper.h"
+#include "megbrain/imperative/basic_operators.h"
+#include "megbrain/imperative/basic_values.h"
+#include "megbrain/imperative/dispatch.h"
+#include "megbrain/utils/timer.h"
+
+using namespace mgb;
+using namespace imperative;
+
+namespace {
+
+//! forwards the requests, and counts the ones it actually handles
+class ForwardTransformation final : public Transformation {
+private:
+    bool m_bypass;
+
+public:
+    size_t nr_applied = 0;
+
+    explicit ForwardTransformation(bool bypass) : m_bypass(bypass) {}
+
+    ValueRefList apply_transformation(
+            const Operator& op, Span<ValueRef> inputs) override {
+        ++nr_applied;
+        return imperative::apply(op, inputs);
+    }
+
+    ValueRef unwrap(ValueRef value) override { return value; }
+
+    std::string name() const override { return "ForwardTransformation"; }
+
+    bool bypass(const Operator& op, Span<ValueRef> inputs) const override {
+        return m_bypass && op.is<IsScalar>();
+    }
+};
+
+//! the bottom of the stack, which returns the inputs
+class EchoTransformation final : public Transformation {
+public:
+    size_t nr_applied = 0;
+
+    ValueRefList apply_transformation(
+            const Operator& op, Span<ValueRef> inputs) override {
+        ++nr_applied;
+        return ValueRefList(inputs.begin(), inputs.end());
+    }
+
+    ValueRef unwrap(ValueRef value) override { return value; }
+
+    std::string name() const override { return "EchoTransformation"; }
+};
+
+//! run with an empty transformation stack, and restore the current one on exit
+class ContextGuard : public NonCopyableObj {
+private:
+    TransformationContext m_context;
+
+public:
+    ContextGuard() { Transformation::swap_context(m_context); }
+    ~ContextGuard() { Transformation::swap_context(m_context); }
+};
+
+}  // namespace
+
+TEST(TestDispatch, Bypass) {
+    ContextGuard _;
+    auto echo = std::make_shared<EchoTransformation>();
+    auto fwd = std::make_shared<ForwardTransformation>(false);
+    auto skipped = std::make_shared<ForwardTransformation>(true);
+    echo->register_at(Transformation::bottom());
+    fwd->register_at(Transformation::top());
+    skipped->register_at(Transformation::top());
+
+    auto value = BoolValue::make(true);
+    auto outputs = imperative::apply(IsScalar(), value);
+    ASSERT_EQ(1u, outputs.size());
+    ASSERT_EQ(value, outputs[0]);
+    ASSERT_EQ(0u, skipped->nr_applied);
+    ASSERT_EQ(1u, fwd->nr_applied);
+    ASSERT_EQ(1u, echo->nr_applied);
+
+    // only the requests of the given operator type are skipped
+    imperative::apply(GetName(), value);
+    ASSERT_EQ(1u, skipped->nr_applied);
+    ASSERT_EQ(2u, fwd->nr_applied);
+    ASSERT_EQ(2u, echo->nr_applied);
+    auto&& cache = Transformation::get_context().dispatch_cache;
+    ASSERT_EQ(2u, cache.bypass_masks.size());
+
+    // the cache is cleared when the stack is modified
+    auto top = std::make_shared<ForwardTransformation>(false);
+    top->register_at(Transformation::top());
+    ASSERT_TRUE(cache.bypass_masks.empty());
+    imperative::apply(IsScalar(), value);
+    ASSERT_EQ(1u, top->nr_applied);
+    ASSERT_EQ(1u, skipped->nr_applied);
+    ASSERT_EQ(3u, fwd->nr_applied);
+
+    cache.enabled = false;
+    imperative::apply(IsScalar(), value);
+    ASSERT_EQ(2u, skipped->nr_applied);
+    ASSERT_EQ(4u, echo->nr_applied);
+}
+
+TEST(TestDispatch, BenchmarkBypass) {
+    ContextGuard _;
+    constexpr size_t nr_transformations = 6, nr_runs = 100000;
+    std::make_shared<EchoTransformation>()->register_at(Transformation::bottom());
+    for (size_t i = 0; i < nr_transformations; ++i) {
+        std::make_shared<ForwardTransformation>(true)->register_at(
+                Transformation::top());
+    }
+    SmallVector<ValueRef> inputs;
+    for (size_t i = 0; i < 3; ++i) {
+        inputs.push_back(BoolValue::make(true));
+    }
+    auto&& cache = Transformation::get_context().dispatch_cache;
+    auto run = [&](bool enabled) {
+        cache.enabled = enabled;
+        RealTimer timer;
+        for (size_t i = 0; i < nr_runs; ++i) {
+            auto outputs = imperative::apply(IsScalar(), inputs);
+            mgb_assert(outputs.size() == inputs.size());
+        }
+        return timer.get_msecs() * 1e3 / nr_runs;
+    };
+    auto time_cached = run(true), time_uncached = run(false);
+    printf("dispatch through %zu transformations: %.3fus with cache, %.3fus "
+           "without cache\n",
+           nr_transformations + 1, time_cached, time_uncached);
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,150 @@
+#include "../impl/interpreter/dtr_policy.h"
+#include "megbrain/test/helper.h"
+
+using namespace mgb;
+using namespace imperative;
+using namespace interpreter::intl;
+
+namespace {
+
+constexpr size_t MB = 1024 * 1024;
+
+/*!
+ * a chain of n ops in the forward pass, and the backward pass reading the
+ * activations in reverse order, which is the typical case of DTR
+ */
+DTRTrace make_chain_trace(size_t n) {
+    DTRTrace trace;
+    // id 0 is the input, 1~n are the activations and n+1~2n are the grads
+    for (size_t i = 1; i <= n; ++i) {
+        trace.add_op("Forward", {{i - 1, 4 * MB}}, {{i, 4 * MB}});
+    }
+    trace.add_op("Backward", {{n, 4 * MB}}, {{2 * n, 4 * MB}});
+    trace.add_del(n);
+    for (size_t i = n - 1; i >= 1; --i) {
+        trace.add_op(
+                "Backward", {{n + i + 1, 4 * MB}, {i, 4 * MB}}, {{n + i, 4 * MB}});
+        trace.add_del(n + i + 1);
+        trace.add_del(i);
+    }
+    return trace;
+}
+
+}  // namespace
+
+TEST(TestDTRPolicy, Score) {
+    EvictionCandidate stale, fresh;
+    stale.memory = fresh.memory = 4 * MB;
+    stale.compute_cost = fresh.compute_cost = 1;
+    stale.staleness = 10;
+    fresh.staleness = 1;
+    for (auto policy :
+         {EvictionPolicy::DTR, EvictionPolicy::H_DTR_LOCAL, EvictionPolicy::LRU}) {
+        ASSERT_LT(eviction_score(policy, stale), eviction_score(policy, fresh));
+    }
+    // only h-dtr local scores on the cost of the tensor itself
+    EvictionCandidate cheap = fresh, expensive = fresh;
+    expensive.compute_cost = 100;
+    ASSERT_LT(
+            eviction_score(EvictionPolicy::H_DTR_LOCAL, cheap),
+            eviction_score(EvictionPolicy::H_DTR_LOCAL, expensive));
+    ASSERT_EQ(
+            eviction_score(EvictionPolicy::LRU, cheap),
+            eviction_score(EvictionPolicy::LRU, expensive));
+}
+
+TEST(TestDTRPolicy, Simulate) {
+    auto trace = make_chain_trace(16);
+    DTRSimulator::Config config;
+    auto base = DTRSimulator::run(trace, config);
+    ASSERT_FALSE(base.exceeded);
+    ASSERT_EQ(0u, base.nr_evictions);
+    ASSERT_EQ(1.0, base.overhead());
+
+    OpCostTable table;
+    table.set("Forward", 10);
+    config.cost_table = &table;
+    config.eviction_threshold = base.peak_memory / 2;
+    for (auto policy :
+         {EvictionPolicy::DTR, EvictionPolicy::H_DTR_LOCAL, EvictionPolicy::LRU,
+          EvictionPolicy::PROFILED}) {
+        config.policy = policy;
+        auto result = DTRSimulator::run(trace, config);
+        ASSERT_FALSE(result.exceeded);
+        ASSERT_LE(result.peak_memory, config.eviction_threshold);
+        ASSERT_GT(result.nr_evictions, 0u);
+        ASSERT_GT(result.nr_recomputations, 0u);
+        ASSERT_GT(result.overhead(), 1.0);
+    }
+
+    // the input is never evicted, so it can not fit in 4MB
+    config.eviction_threshold = 4 * MB;
+    ASSERT_TRUE(DTRSimulator::run(trace, config).exceeded);
+}
+
+TEST(TestDTRPolicy, Search) {
+    auto trace = make_chain_trace(16);
+    auto peak = DTRSimulator::run(trace, {}).peak_memory;
+    std::vector<EvictionPolicy> policies{
+            EvictionPolicy::DTR, EvictionPolicy::H_DTR_LOCAL, EvictionPolicy::LRU};
+    std::vector<size_t> thresholds{peak / 4, peak / 2, peak};
+
+    auto best = DTRSimulator::search(trace, peak / 2, policies, thresholds);
+    ASSERT_LE(best.second.peak_memory, peak / 2);
+    ASSERT_FALSE(best.second.exceeded);
+    for (auto policy : policies) {
+        for (auto threshold : thresholds) {
+            DTRSimulator::Config config;
+            config.policy = policy;
+            config.eviction_threshold = threshold;
+            auto result = DTRSimulator::run(trace, config);
+            if (!result.exceeded && result.peak_memory <= peak / 2) {
+                ASSERT_LE(best.second.overhead(), result.overhead());
+            }
+        }
+    }
+
+    // nothing fits, so the one with the lowest peak memory is returned
+    best = DTRSimulator::search(trace, 1, policies, thresholds);
+    ASSERT_GT(best.second.peak_memory, 1u);
+    ASSERT_EQ(peak / 4, best.first.eviction_threshold);
+}
+
+TEST(TestDTRPolicy, TraceIO) {
+    auto trace = make_chain_trace(4);
+    trace.add_op("Op With Spaces", {{1, 2}}, {{3, 4}, {5, 6}});
+    auto path = output_file("dtr_trace.txt");
+    trace.dump(path);
+    auto loaded = DTRTrace::load(path);
+    ASSERT_EQ(trace.records.size(), loaded.records.size());
+    for (size_t i = 0; i < trace.records.size(); ++i) {
+        auto &&expect = trace.records[i], &&get = loaded.records[i];
+        ASSERT_EQ(expect.name, get.name);
+        ASSERT_EQ(expect.traffic, get.traffic);
+        ASSERT_EQ(expect.inputs.size(), get.inputs.size());
+        ASSERT_EQ(expect.outputs.size(), get.outputs.size());
+        for (size_t j = 0; j < expect.inputs.size(); ++j) {
+            ASSERT_EQ(expect.inputs[j].id, get.inputs[j].id);
+            if (!expect.name.empty()) {
+                ASSERT_EQ(expect.inputs[j].size, get.inputs[j].size);
+            }
+        }
+        for (size_t j = 0; j < expect.outputs.size(); ++j) {
+            ASSERT_EQ(expect.outputs[j].id, get.outputs[j].id);
+            ASSERT_EQ(expect.outputs[j].size, get.outputs[j].size);
+        }
+    }
+
+    auto table_path = output_file("dtr_op_cost.txt");
+    {
+        FILE* fout = fopen(table_path.c_str(), "w");
+        fprintf(fout, "12.5 Convolution\n\n3 Elemwise ADD\n");
+        fclose(fout);
+    }
+    auto table = OpCostTable::load(table_path);
+    ASSERT_EQ(12.5, table.get("Convolution", 0));
+    ASSERT_EQ(3.0, table.get("Elemwise ADD", 0));
+    ASSERT_EQ(2.0, table.get("Reduce", 2 * OpCostTable::BYTES_PER_US));
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -20,7 +20,10 @@
     cb(::megdnn::param::CvtColor::Mode); \
     cb(::megdnn::param::Elemwise::Mode); \
     cb(::megdnn::param::ElemwiseMultiType::Mode); \
+    cb(::megdnn::param::EmbeddingBag::Mode); \
+    cb(::megdnn::param::FusedOptimizerUpdate::Mode); \
     cb(::megdnn::param::WarpPerspectiveV1::BorderMode); \
+    cb(::megdnn::param::GeneralNorm::Mode); \
     cb(::megdnn::param::MultiHeadAttn::AttnMaskType); \
     cb(::megdnn::param::MultiHeadAttn::TensorCombinationType); \
     cb(::megdnn::param::Padding::PaddingMode); \
@@ -3441,6 +3441,106 @@ OP_TRAIT_REG(ElemwiseMultiType, ElemwiseMultiType)
     .props(ElemwiseMultiType_props_impl)
     .make_name(ElemwiseMultiType_make_name_impl);
 
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(EmbeddingBag);
+
+namespace {
+size_t EmbeddingBag_hash_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<EmbeddingBag>();
+    static_cast<void>(op_);
+    size_t val = mgb::hash(op_.dyn_typeinfo());
+    val = mgb::hash_pair_combine(val, mgb::enumhash()(op_.mode));
+    return val;
+}
+bool EmbeddingBag_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
+    auto &&a_ = lhs_.cast_final_safe<EmbeddingBag>(),
+         &&b_ = rhs_.cast_final_safe<EmbeddingBag>();
+    static_cast<void>(a_);
+    static_cast<void>(b_);
+    if (a_.mode != b_.mode) return false;
+    return true;
+}
+std::vector<std::pair<const char*, std::string>> EmbeddingBag_props_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<EmbeddingBag>();
+    static_cast<void>(op_);
+    std::vector<std::pair<const char*, std::string>> props_;
+    switch (op_.mode){
+    case EmbeddingBag::Mode::SUM:
+        props_.emplace_back("mode", "SUM");
+        break;
+    case EmbeddingBag::Mode::MEAN:
+        props_.emplace_back("mode", "MEAN");
+        break;
+    case EmbeddingBag::Mode::MAX:
+        props_.emplace_back("mode", "MAX");
+        break;
+    default:
+        props_.emplace_back("mode", "INVALID");
+        break;
+    }
+    return props_;
+}
+std::string EmbeddingBag_make_name_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<EmbeddingBag>();
+    static_cast<void>(op_);
+    return "EmbeddingBag";
+}
+} // anonymous namespace
+OP_TRAIT_REG(EmbeddingBag, EmbeddingBag)
+    .hash(EmbeddingBag_hash_impl)
+    .is_same_st(EmbeddingBag_is_same_st_impl)
+    .props(EmbeddingBag_props_impl)
+    .make_name(EmbeddingBag_make_name_impl);
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(EmbeddingBagBackward);
+
+namespace {
+size_t EmbeddingBagBackward_hash_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<EmbeddingBagBackward>();
+    static_cast<void>(op_);
+    size_t val = mgb::hash(op_.dyn_typeinfo());
+    val = mgb::hash_pair_combine(val, mgb::enumhash()(op_.mode));
+    return val;
+}
+bool EmbeddingBagBackward_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
+    auto &&a_ = lhs_.cast_final_safe<EmbeddingBagBackward>(),
+         &&b_ = rhs_.cast_final_safe<EmbeddingBagBackward>();
+    static_cast<void>(a_);
+    static_cast<void>(b_);
+    if (a_.mode != b_.mode) return false;
+    return true;
+}
+std::vector<std::pair<const char*, std::string>> EmbeddingBagBackward_props_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<EmbeddingBagBackward>();
+    static_cast<void>(op_);
+    std::vector<std::pair<const char*, std::string>> props_;
+    switch (op_.mode){
+    case EmbeddingBagBackward::Mode::SUM:
+        props_.emplace_back("mode", "SUM");
+        break;
+    case EmbeddingBagBackward::Mode::MEAN:
+        props_.emplace_back("mode", "MEAN");
+        break;
+    case EmbeddingBagBackward::Mode::MAX:
+        props_.emplace_back("mode", "MAX");
+        break;
+    default:
+        props_.emplace_back("mode", "INVALID");
+        break;
+    }
+    return props_;
+}
+std::string EmbeddingBagBackward_make_name_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<EmbeddingBagBackward>();
+    static_cast<void>(op_);
+    return "EmbeddingBagBackward";
+}
+} // anonymous namespace
+OP_TRAIT_REG(EmbeddingBagBackward, EmbeddingBagBackward)
+    .hash(EmbeddingBagBackward_hash_impl)
+    .is_same_st(EmbeddingBagBackward_is_same_st_impl)
+    .props(EmbeddingBagBackward_props_impl)
+    .make_name(EmbeddingBagBackward_make_name_impl);
+
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(ExponentialRNG);
 
 namespace {
@@ -3768,6 +3868,89 @@ OP_TRAIT_REG(Flip, Flip)
     .props(Flip_props_impl)
     .make_name(Flip_make_name_impl);
 
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(FusedOptimizerUpdate);
+
+namespace {
+size_t FusedOptimizerUpdate_hash_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<FusedOptimizerUpdate>();
+    static_cast<void>(op_);
+    size_t val = mgb::hash(op_.dyn_typeinfo());
+    val = mgb::hash_pair_combine(val, mgb::enumhash()(op_.mode));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.lr));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.weight_decay));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.momentum));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.nesterov));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.beta_1));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.beta_2));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.eps));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.step));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.bias_correction));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.always_adapt));
+    return val;
+}
+bool FusedOptimizerUpdate_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
+    auto &&a_ = lhs_.cast_final_safe<FusedOptimizerUpdate>(),
+         &&b_ = rhs_.cast_final_safe<FusedOptimizerUpdate>();
+    static_cast<void>(a_);
+    static_cast<void>(b_);
+    if (a_.mode != b_.mode) return false;
+    if (a_.lr != b_.lr) return false;
+    if (a_.weight_decay != b_.weight_decay) return false;
+    if (a_.momentum != b_.momentum) return false;
+    if (a_.nesterov != b_.nesterov) return false;
+    if (a_.beta_1 != b_.beta_1) return false;
+    if (a_.beta_2 != b_.beta_2) return false;
+    if (a_.eps != b_.eps) return false;
+    if (a_.step != b_.step) return false;
+    if (a_.bias_correction != b_.bias_correction) return false;
+    if (a_.always_adapt != b_.always_adapt) return false;
+    return true;
+}
+std::vector<std::pair<const char*, std::string>> FusedOptimizerUpdate_props_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<FusedOptimizerUpdate>();
+    static_cast<void>(op_);
+    std::vector<std::pair<const char*, std::string>> props_;
+    switch (op_.mode){
+    case FusedOptimizerUpdate::Mode::SGD:
+        props_.emplace_back("mode", "SGD");
+        break;
+    case FusedOptimizerUpdate::Mode::ADAM:
+        props_.emplace_back("mode", "ADAM");
+        break;
+    case FusedOptimizerUpdate::Mode::ADAMW:
+        props_.emplace_back("mode", "ADAMW");
+        break;
+    case FusedOptimizerUpdate::Mode::LAMB:
+        props_.emplace_back("mode", "LAMB");
+        break;
+    default:
+        props_.emplace_back("mode", "INVALID");
+        break;
+    }
+    props_.emplace_back("lr", std::to_string(op_.lr));
+    props_.emplace_back("weight_decay", std::to_string(op_.weight_decay));
+    props_.emplace_back("momentum", std::to_string(op_.momentum));
+    props_.emplace_back("nesterov", std::to_string(op_.nesterov));
+    props_.emplace_back("beta_1", std::to_string(op_.beta_1));
+    props_.emplace_back("beta_2", std::to_string(op_.beta_2));
+    props_.emplace_back("eps", std::to_string(op_.eps));
+    props_.emplace_back("step", std::to_string(op_.step));
+    props_.emplace_back("bias_correction", std::to_string(op_.bias_correction));
+    props_.emplace_back("always_adapt", std::to_string(op_.always_adapt));
+    return props_;
+}
+std::string FusedOptimizerUpdate_make_name_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<FusedOptimizerUpdate>();
+    static_cast<void>(op_);
+    return "FusedOptimizerUpdate";
+}
+} // anonymous namespace
+OP_TRAIT_REG(FusedOptimizerUpdate, FusedOptimizerUpdate)
+    .hash(FusedOptimizerUpdate_hash_impl)
+    .is_same_st(FusedOptimizerUpdate_is_same_st_impl)
+    .props(FusedOptimizerUpdate_props_impl)
+    .make_name(FusedOptimizerUpdate_make_name_impl);
+
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(GammaRNG);
 
 namespace {
@@ -3941,6 +4124,7 @@ size_t GeneralNorm_hash_impl(const OpDef& def_) {
     val = mgb::hash_pair_combine(val, mgb::hash(op_.eps));
     val = mgb::hash_pair_combine(val, mgb::hash(op_.axis_start));
     val = mgb::hash_pair_combine(val, mgb::hash(op_.axis_end));
+    val = mgb::hash_pair_combine(val, mgb::enumhash()(op_.mode));
     return val;
 }
 bool GeneralNorm_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
@@ -3952,6 +4136,7 @@ bool GeneralNorm_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
     if (a_.eps != b_.eps) return false;
     if (a_.axis_start != b_.axis_start) return false;
     if (a_.axis_end != b_.axis_end) return false;
+    if (a_.mode != b_.mode) return false;
     return true;
 }
 std::vector<std::pair<const char*, std::string>> GeneralNorm_props_impl(const OpDef& def_) {
@@ -3962,6 +4147,17 @@ std::vector<std::pair<const char*, std::string>> GeneralNorm_props_impl(const Op
     props_.emplace_back("eps", std::to_string(op_.eps));
     props_.emplace_back("axis_start", std::to_string(op_.axis_start));
     props_.emplace_back("axis_end", std::to_string(op_.axis_end));
+    switch (op_.mode){
+    case GeneralNorm::Mode::LAYER_NORM:
+        props_.emplace_back("mode", "LAYER_NORM");
+        break;
+    case GeneralNorm::Mode::RMS_NORM:
+        props_.emplace_back("mode", "RMS_NORM");
+        break;
+    default:
+        props_.emplace_back("mode", "INVALID");
+        break;
+    }
     return props_;
 }
 std::string GeneralNorm_make_name_impl(const OpDef& def_) {
@@ -4764,6 +4960,86 @@ OP_TRAIT_REG(InstanceNorm, InstanceNorm)
     .props(InstanceNorm_props_impl)
     .make_name(InstanceNorm_make_name_impl);
 
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(KVCacheAppend);
+
+namespace {
+size_t KVCacheAppend_hash_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<KVCacheAppend>();
+    static_cast<void>(op_);
+    size_t val = mgb::hash(op_.dyn_typeinfo());
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.num_heads));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.rotary_dim));
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.rotary_base));
+    return val;
+}
+bool KVCacheAppend_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
+    auto &&a_ = lhs_.cast_final_safe<KVCacheAppend>(),
+         &&b_ = rhs_.cast_final_safe<KVCacheAppend>();
+    static_cast<void>(a_);
+    static_cast<void>(b_);
+    if (a_.num_heads != b_.num_heads) return false;
+    if (a_.rotary_dim != b_.rotary_dim) return false;
+    if (a_.rotary_base != b_.rotary_base) return false;
+    return true;
+}
+std::vector<std::pair<const char*, std::string>> KVCacheAppend_props_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<KVCacheAppend>();
+    static_cast<void>(op_);
+    std::vector<std::pair<const char*, std::string>> props_;
+    props_.emplace_back("num_heads", std::to_string(op_.num_heads));
+    props_.emplace_back("rotary_dim", std::to_string(op_.rotary_dim));
+    props_.emplace_back("rotary_base", std::to_string(op_.rotary_base));
+    return props_;
+}
+std::string KVCacheAppend_make_name_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<KVCacheAppend>();
+    static_cast<void>(op_);
+    return "KVCacheAppend";
+}
+} // anonymous namespace
+OP_TRAIT_REG(KVCacheAppend, KVCacheAppend)
+    .hash(KVCacheAppend_hash_impl)
+    .is_same_st(KVCacheAppend_is_same_st_impl)
+    .props(KVCacheAppend_props_impl)
+    .make_name(KVCacheAppend_make_name_impl);
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(KVCacheAttention);
+
+namespace {
+size_t KVCacheAttention_hash_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<KVCacheAttention>();
+    static_cast<void>(op_);
+    size_t val = mgb::hash(op_.dyn_typeinfo());
+    val = mgb::hash_pair_combine(val, mgb::hash(op_.scale));
+    return val;
+}
+bool KVCacheAttention_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
+    auto &&a_ = lhs_.cast_final_safe<KVCacheAttention>(),
+         &&b_ = rhs_.cast_final_safe<KVCacheAttention>();
+    static_cast<void>(a_);
+    static_cast<void>(b_);
+    if (a_.scale != b_.scale) return false;
+    return true;
+}
+std::vector<std::pair<const char*, std::string>> KVCacheAttention_props_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<KVCacheAttention>();
+    static_cast<void>(op_);
+    std::vector<std::pair<const char*, std::string>> props_;
+    props_.emplace_back("scale", std::to_string(op_.scale));
+    return props_;
+}
+std::string KVCacheAttention_make_name_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<KVCacheAttention>();
+    static_cast<void>(op_);
+    return "KVCacheAttention";
+}
+} // anonymous namespace
+OP_TRAIT_REG(KVCacheAttention, KVCacheAttention)
+    .hash(KVCacheAttention_hash_impl)
+    .is_same_st(KVCacheAttention_is_same_st_impl)
+    .props(KVCacheAttention_props_impl)
+    .make_name(KVCacheAttention_make_name_impl);
+
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(LAMBUpdate);
 
 namespace {
@@ -5093,6 +5369,56 @@ OP_TRAIT_REG(Linspace, Linspace)
     .props(Linspace_props_impl)
     .make_name(Linspace_make_name_impl);
 
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(LogitsSamplingRNG);
+
+namespace {
+size_t LogitsSamplingRNG_hash_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<LogitsSamplingRNG>();
+    static_cast<void>(op_);
+
+    return mgb::hash_pair_combine(
+      mgb::hash(op_.dyn_typeinfo()),
+      mgb::hash_pair_combine(
+        mgb::hash(op_.handle),
+        mgb::hash_pair_combine(
+          mgb::hash(op_.top_k),
+          mgb::hash_pair_combine(
+            mgb::hash(op_.top_p),
+            mgb::hash(op_.temperature)
+          )
+        )
+      )
+    );
+  }
+bool LogitsSamplingRNG_is_same_st_impl(const OpDef& lhs_, const OpDef& rhs_) {
+    auto &&a_ = lhs_.cast_final_safe<LogitsSamplingRNG>(),
+         &&b_ = rhs_.cast_final_safe<LogitsSamplingRNG>();
+    static_cast<void>(a_);
+    static_cast<void>(b_);
+return a_.handle == b_.handle && a_.top_k == b_.top_k && a_.top_p == b_.top_p && a_.temperature == b_.temperature;}
+std::vector<std::pair<const char*, std::string>> LogitsSamplingRNG_props_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<LogitsSamplingRNG>();
+    static_cast<void>(op_);
+    std::vector<std::pair<const char*, std::string>> props_;
+    props_.emplace_back("seed", std::to_string(op_.seed));
+    props_.emplace_back("top_k", std::to_string(op_.top_k));
+    props_.emplace_back("top_p", std::to_string(op_.top_p));
+    props_.emplace_back("temperature", std::to_string(op_.temperature));
+    props_.emplace_back("handle", std::to_string(op_.handle));
+    return props_;
+}
+std::string LogitsSamplingRNG_make_name_impl(const OpDef& def_) {
+    auto&& op_ = def_.cast_final_safe<LogitsSamplingRNG>();
+    static_cast<void>(op_);
+    return "LogitsSamplingRNG";
+}
+} // anonymous namespace
+OP_TRAIT_REG(LogitsSamplingRNG, LogitsSamplingRNG)
+    .hash(LogitsSamplingRNG_hash_impl)
+    .is_same_st(LogitsSamplingRNG_is_same_st_impl)
+    .props(LogitsSamplingRNG_props_impl)
+    .make_name(LogitsSamplingRNG_make_name_impl);
+
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(MagicMindRuntime);
 
 namespace {
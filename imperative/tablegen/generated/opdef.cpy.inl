@@ -10031,6 +10031,314 @@ void _init_py_ElemwiseMultiType(py::module m) {
     mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(ElemwiseMultiType::typeinfo(), &py_type).second);
 }
 
+template<> struct EnumTrait<EmbeddingBag::Mode> {
+    static constexpr const char *name = "EmbeddingBag.Mode";
+    static constexpr std::underlying_type_t<EmbeddingBag::Mode> max = 3 - 1;
+};
+template<> PyTypeObject* EnumWrapper<EmbeddingBag::Mode>::type = nullptr;
+
+template<> const char*
+EnumWrapper<EmbeddingBag::Mode>::members[] = {"SUM", "MEAN", "MAX"};
+
+template<> std::unordered_map<std::string, EmbeddingBag::Mode>
+EnumWrapper<EmbeddingBag::Mode>::mem2value = {{normalize_enum("SUM"), EmbeddingBag::Mode::SUM}, {normalize_enum("MEAN"), EmbeddingBag::Mode::MEAN}, {normalize_enum("MAX"), EmbeddingBag::Mode::MAX}};
+template<> PyObject* EnumWrapper<EmbeddingBag::Mode>::pyobj_insts[3] = {nullptr};
+
+void _init_py_EmbeddingBag_Mode(PyTypeObject& py_type) {
+    auto& e_type = EnumWrapper<EmbeddingBag::Mode>::type;
+
+    static PyMethodDef tp_methods[] = {
+        {const_cast<char*>("dump"), (PyCFunction)EnumWrapper<EmbeddingBag::Mode>::py_dump, METH_NOARGS, NULL},
+        {NULL}  /* Sentinel */
+        };
+    
+    static PyType_Slot slots[] = {
+        {Py_tp_repr, (void*)EnumWrapper<EmbeddingBag::Mode>::py_repr},
+        {Py_tp_richcompare, (void*)EnumWrapper<EmbeddingBag::Mode>::tp_richcompare},
+        {Py_tp_methods, tp_methods},
+
+        {0, NULL}
+    };
+    static PyType_Spec spec = {
+        // name
+        "megengine.core._imperative_rt.ops.EmbeddingBag.Mode",
+        // basicsize
+        sizeof(EnumWrapper<EmbeddingBag::Mode>),
+        // itemsize
+        0,
+        // flags
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HEAPTYPE,
+        // slots
+        slots
+    };
+    e_type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&spec));
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__name__").release().ptr(),
+                    py::cast("Mode").release().ptr()) >= 0);
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__module__").release().ptr(),
+                    py::cast("megengine.core._imperative_rt.ops").release().ptr()) >= 0);
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__qualname__").release().ptr(),
+                    py::cast("EmbeddingBag.Mode").release().ptr()) >= 0);
+{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<EmbeddingBag::Mode>*>(inst)->value = EmbeddingBag::Mode::SUM;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "SUM", inst) >= 0);
+    EnumWrapper<EmbeddingBag::Mode>::pyobj_insts[0] = inst;
+}{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<EmbeddingBag::Mode>*>(inst)->value = EmbeddingBag::Mode::MEAN;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "MEAN", inst) >= 0);
+    EnumWrapper<EmbeddingBag::Mode>::pyobj_insts[1] = inst;
+}{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<EmbeddingBag::Mode>*>(inst)->value = EmbeddingBag::Mode::MAX;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "MAX", inst) >= 0);
+    EnumWrapper<EmbeddingBag::Mode>::pyobj_insts[2] = inst;
+}
+    Py_INCREF(e_type);
+    mgb_assert(PyDict_SetItemString(
+        py_type.tp_dict, "Mode", reinterpret_cast<PyObject*>(e_type)) >= 0);
+}
+
+PyOpDefBegin(EmbeddingBag) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(EmbeddingBag)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"mode", serialization<decltype(opdef.mode)>::dump(opdef.mode)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
+        auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
+        auto& opdef = reinterpret_cast<PyOp(EmbeddingBag)*>(self)->inst();
+        static_cast<void>(opdef);
+        
+        {
+        auto&& iter = state.find("mode");
+        if (iter != state.end()) {
+            opdef.mode = serialization<decltype(opdef.mode)>::load(iter->second);
+        }
+        }
+        Py_RETURN_NONE;
+    }
+    static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyMethodDef py_init_methoddef;
+// };
+PyOpDefEnd(EmbeddingBag)
+
+int PyOp(EmbeddingBag)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"mode", "scope", NULL};
+    PyObject *mode = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", const_cast<char**>(kwlist), &mode, &scope))
+    return -1;
+
+    if (mode) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(EmbeddingBag)*>(self)->inst().mode =
+                    py::cast<decltype(EmbeddingBag::mode)>(py::handle(mode));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
+
+    return 0;
+}
+
+PyGetSetDef PyOp(EmbeddingBag)::py_getsetters[] = {
+    {const_cast<char*>("mode"), py_get_generic(EmbeddingBag, mode), py_set_generic(EmbeddingBag, mode), const_cast<char*>("mode"), NULL},
+    {NULL}  /* Sentinel */
+};
+
+    PyMethodDef PyOp(EmbeddingBag)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(EmbeddingBag)::getstate, METH_NOARGS, "EmbeddingBag getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(EmbeddingBag)::setstate, METH_VARARGS, "EmbeddingBag setstate"},
+        {NULL}  /* Sentinel */
+    };
+    
+PyObject *PyOp(EmbeddingBag)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(EmbeddingBag)::py_init(self, args, kwds) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyOp(EmbeddingBag)::py_init_methoddef = {
+    "__init__",
+    (PyCFunction)PyOp(EmbeddingBag)::py_init_proxy,
+    METH_VARARGS | METH_KEYWORDS,
+    "__init__(self, mode: Union[str, Mode] = ...) -> None\n"
+};
+
+void _init_py_EmbeddingBag(py::module m) {
+    using py_op = PyOp(EmbeddingBag);
+    auto& py_type = PyOpType(EmbeddingBag);
+    py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+    py_type.tp_name = "megengine.core._imperative_rt.ops.EmbeddingBag";
+    py_type.tp_basicsize = sizeof(PyOp(EmbeddingBag));
+    py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    py_type.tp_doc = "EmbeddingBag";
+    py_type.tp_base = &PyOpType(OpDef);
+    py_type.tp_dealloc = py_dealloc_generic<py_op>;
+    py_type.tp_new = py_new_generic<py_op>;
+    py_type.tp_init = py_op::py_init;
+    py_type.tp_methods = py_op::tp_methods;
+    py_type.tp_getset = py_op::py_getsetters;
+
+    py_type.tp_dict = PyDict_New();
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(EmbeddingBag), &PyOp(EmbeddingBag)::py_init_methoddef);
+    PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
+    mgb_assert(PyType_Ready(&py_type) >= 0);
+        _init_py_EmbeddingBag_Mode(py_type);
+
+    PyType_Modified(&py_type);
+    m.add_object("EmbeddingBag", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(EmbeddingBag::typeinfo(), &py_type).second);
+}
+
+void _init_py_EmbeddingBagBackward_Mode(PyTypeObject& py_type) {
+    auto& e_type = EnumWrapper<EmbeddingBagBackward::Mode>::type;
+
+    Py_INCREF(e_type);
+    mgb_assert(PyDict_SetItemString(
+        py_type.tp_dict, "Mode", reinterpret_cast<PyObject*>(e_type)) >= 0);
+}
+
+PyOpDefBegin(EmbeddingBagBackward) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(EmbeddingBagBackward)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"mode", serialization<decltype(opdef.mode)>::dump(opdef.mode)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
+        auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
+        auto& opdef = reinterpret_cast<PyOp(EmbeddingBagBackward)*>(self)->inst();
+        static_cast<void>(opdef);
+        
+        {
+        auto&& iter = state.find("mode");
+        if (iter != state.end()) {
+            opdef.mode = serialization<decltype(opdef.mode)>::load(iter->second);
+        }
+        }
+        Py_RETURN_NONE;
+    }
+    static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyMethodDef py_init_methoddef;
+// };
+PyOpDefEnd(EmbeddingBagBackward)
+
+int PyOp(EmbeddingBagBackward)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"mode", "scope", NULL};
+    PyObject *mode = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", const_cast<char**>(kwlist), &mode, &scope))
+    return -1;
+
+    if (mode) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(EmbeddingBagBackward)*>(self)->inst().mode =
+                    py::cast<decltype(EmbeddingBagBackward::mode)>(py::handle(mode));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
+
+    return 0;
+}
+
+PyGetSetDef PyOp(EmbeddingBagBackward)::py_getsetters[] = {
+    {const_cast<char*>("mode"), py_get_generic(EmbeddingBagBackward, mode), py_set_generic(EmbeddingBagBackward, mode), const_cast<char*>("mode"), NULL},
+    {NULL}  /* Sentinel */
+};
+
+    PyMethodDef PyOp(EmbeddingBagBackward)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(EmbeddingBagBackward)::getstate, METH_NOARGS, "EmbeddingBagBackward getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(EmbeddingBagBackward)::setstate, METH_VARARGS, "EmbeddingBagBackward setstate"},
+        {NULL}  /* Sentinel */
+    };
+    
+PyObject *PyOp(EmbeddingBagBackward)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(EmbeddingBagBackward)::py_init(self, args, kwds) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyOp(EmbeddingBagBackward)::py_init_methoddef = {
+    "__init__",
+    (PyCFunction)PyOp(EmbeddingBagBackward)::py_init_proxy,
+    METH_VARARGS | METH_KEYWORDS,
+    "__init__(self, mode: Union[str, Mode] = ...) -> None\n"
+};
+
+void _init_py_EmbeddingBagBackward(py::module m) {
+    using py_op = PyOp(EmbeddingBagBackward);
+    auto& py_type = PyOpType(EmbeddingBagBackward);
+    py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+    py_type.tp_name = "megengine.core._imperative_rt.ops.EmbeddingBagBackward";
+    py_type.tp_basicsize = sizeof(PyOp(EmbeddingBagBackward));
+    py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    py_type.tp_doc = "EmbeddingBagBackward";
+    py_type.tp_base = &PyOpType(OpDef);
+    py_type.tp_dealloc = py_dealloc_generic<py_op>;
+    py_type.tp_new = py_new_generic<py_op>;
+    py_type.tp_init = py_op::py_init;
+    py_type.tp_methods = py_op::tp_methods;
+    py_type.tp_getset = py_op::py_getsetters;
+
+    py_type.tp_dict = PyDict_New();
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(EmbeddingBagBackward), &PyOp(EmbeddingBagBackward)::py_init_methoddef);
+    PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
+    mgb_assert(PyType_Ready(&py_type) >= 0);
+        _init_py_EmbeddingBagBackward_Mode(py_type);
+
+    PyType_Modified(&py_type);
+    m.add_object("EmbeddingBagBackward", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(EmbeddingBagBackward::typeinfo(), &py_type).second);
+}
+
 PyOpDefBegin(ExponentialRNG) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
@@ -11092,23 +11400,398 @@ void _init_py_Flip(py::module m) {
     mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(Flip::typeinfo(), &py_type).second);
 }
 
-PyOpDefBegin(GammaRNG) // {
-    static PyGetSetDef py_getsetters[];
-    static PyMethodDef tp_methods[];
-    
-    static PyObject* getstate(PyObject* self, PyObject*) {
-        auto& opdef = reinterpret_cast<PyOp(GammaRNG)*>(self)->inst();
-        static_cast<void>(opdef);
-        std::unordered_map<std::string, py::object> state {
-            
-            {"seed", serialization<decltype(opdef.seed)>::dump(opdef.seed)},
-            {"handle", serialization<decltype(opdef.handle)>::dump(opdef.handle)}
+template<> struct EnumTrait<FusedOptimizerUpdate::Mode> {
+    static constexpr const char *name = "FusedOptimizerUpdate.Mode";
+    static constexpr std::underlying_type_t<FusedOptimizerUpdate::Mode> max = 4 - 1;
+};
+template<> PyTypeObject* EnumWrapper<FusedOptimizerUpdate::Mode>::type = nullptr;
+
+template<> const char*
+EnumWrapper<FusedOptimizerUpdate::Mode>::members[] = {"SGD", "ADAM", "ADAMW", "LAMB"};
+
+template<> std::unordered_map<std::string, FusedOptimizerUpdate::Mode>
+EnumWrapper<FusedOptimizerUpdate::Mode>::mem2value = {{normalize_enum("SGD"), FusedOptimizerUpdate::Mode::SGD}, {normalize_enum("ADAM"), FusedOptimizerUpdate::Mode::ADAM}, {normalize_enum("ADAMW"), FusedOptimizerUpdate::Mode::ADAMW}, {normalize_enum("LAMB"), FusedOptimizerUpdate::Mode::LAMB}};
+template<> PyObject* EnumWrapper<FusedOptimizerUpdate::Mode>::pyobj_insts[4] = {nullptr};
+
+void _init_py_FusedOptimizerUpdate_Mode(PyTypeObject& py_type) {
+    auto& e_type = EnumWrapper<FusedOptimizerUpdate::Mode>::type;
+
+    static PyMethodDef tp_methods[] = {
+        {const_cast<char*>("dump"), (PyCFunction)EnumWrapper<FusedOptimizerUpdate::Mode>::py_dump, METH_NOARGS, NULL},
+        {NULL}  /* Sentinel */
         };
-        return py::cast(state).release().ptr();
-    }
-    static PyObject* setstate(PyObject* self, PyObject* args) {
-        PyObject* dict = PyTuple_GetItem(args, 0);
-        if (!dict) return NULL;
+    
+    static PyType_Slot slots[] = {
+        {Py_tp_repr, (void*)EnumWrapper<FusedOptimizerUpdate::Mode>::py_repr},
+        {Py_tp_richcompare, (void*)EnumWrapper<FusedOptimizerUpdate::Mode>::tp_richcompare},
+        {Py_tp_methods, tp_methods},
+
+        {0, NULL}
+    };
+    static PyType_Spec spec = {
+        // name
+        "megengine.core._imperative_rt.ops.FusedOptimizerUpdate.Mode",
+        // basicsize
+        sizeof(EnumWrapper<FusedOptimizerUpdate::Mode>),
+        // itemsize
+        0,
+        // flags
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HEAPTYPE,
+        // slots
+        slots
+    };
+    e_type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&spec));
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__name__").release().ptr(),
+                    py::cast("Mode").release().ptr()) >= 0);
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__module__").release().ptr(),
+                    py::cast("megengine.core._imperative_rt.ops").release().ptr()) >= 0);
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__qualname__").release().ptr(),
+                    py::cast("FusedOptimizerUpdate.Mode").release().ptr()) >= 0);
+{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<FusedOptimizerUpdate::Mode>*>(inst)->value = FusedOptimizerUpdate::Mode::SGD;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "SGD", inst) >= 0);
+    EnumWrapper<FusedOptimizerUpdate::Mode>::pyobj_insts[0] = inst;
+}{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<FusedOptimizerUpdate::Mode>*>(inst)->value = FusedOptimizerUpdate::Mode::ADAM;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "ADAM", inst) >= 0);
+    EnumWrapper<FusedOptimizerUpdate::Mode>::pyobj_insts[1] = inst;
+}{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<FusedOptimizerUpdate::Mode>*>(inst)->value = FusedOptimizerUpdate::Mode::ADAMW;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "ADAMW", inst) >= 0);
+    EnumWrapper<FusedOptimizerUpdate::Mode>::pyobj_insts[2] = inst;
+}{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<FusedOptimizerUpdate::Mode>*>(inst)->value = FusedOptimizerUpdate::Mode::LAMB;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "LAMB", inst) >= 0);
+    EnumWrapper<FusedOptimizerUpdate::Mode>::pyobj_insts[3] = inst;
+}
+    Py_INCREF(e_type);
+    mgb_assert(PyDict_SetItemString(
+        py_type.tp_dict, "Mode", reinterpret_cast<PyObject*>(e_type)) >= 0);
+}
+
+PyOpDefBegin(FusedOptimizerUpdate) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"mode", serialization<decltype(opdef.mode)>::dump(opdef.mode)},
+            {"lr", serialization<decltype(opdef.lr)>::dump(opdef.lr)},
+            {"weight_decay", serialization<decltype(opdef.weight_decay)>::dump(opdef.weight_decay)},
+            {"momentum", serialization<decltype(opdef.momentum)>::dump(opdef.momentum)},
+            {"nesterov", serialization<decltype(opdef.nesterov)>::dump(opdef.nesterov)},
+            {"beta_1", serialization<decltype(opdef.beta_1)>::dump(opdef.beta_1)},
+            {"beta_2", serialization<decltype(opdef.beta_2)>::dump(opdef.beta_2)},
+            {"eps", serialization<decltype(opdef.eps)>::dump(opdef.eps)},
+            {"step", serialization<decltype(opdef.step)>::dump(opdef.step)},
+            {"bias_correction", serialization<decltype(opdef.bias_correction)>::dump(opdef.bias_correction)},
+            {"always_adapt", serialization<decltype(opdef.always_adapt)>::dump(opdef.always_adapt)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
+        auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
+        auto& opdef = reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst();
+        static_cast<void>(opdef);
+        
+        {
+        auto&& iter = state.find("mode");
+        if (iter != state.end()) {
+            opdef.mode = serialization<decltype(opdef.mode)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("lr");
+        if (iter != state.end()) {
+            opdef.lr = serialization<decltype(opdef.lr)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("weight_decay");
+        if (iter != state.end()) {
+            opdef.weight_decay = serialization<decltype(opdef.weight_decay)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("momentum");
+        if (iter != state.end()) {
+            opdef.momentum = serialization<decltype(opdef.momentum)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("nesterov");
+        if (iter != state.end()) {
+            opdef.nesterov = serialization<decltype(opdef.nesterov)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("beta_1");
+        if (iter != state.end()) {
+            opdef.beta_1 = serialization<decltype(opdef.beta_1)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("beta_2");
+        if (iter != state.end()) {
+            opdef.beta_2 = serialization<decltype(opdef.beta_2)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("eps");
+        if (iter != state.end()) {
+            opdef.eps = serialization<decltype(opdef.eps)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("step");
+        if (iter != state.end()) {
+            opdef.step = serialization<decltype(opdef.step)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("bias_correction");
+        if (iter != state.end()) {
+            opdef.bias_correction = serialization<decltype(opdef.bias_correction)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("always_adapt");
+        if (iter != state.end()) {
+            opdef.always_adapt = serialization<decltype(opdef.always_adapt)>::load(iter->second);
+        }
+        }
+        Py_RETURN_NONE;
+    }
+    static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyMethodDef py_init_methoddef;
+// };
+PyOpDefEnd(FusedOptimizerUpdate)
+
+int PyOp(FusedOptimizerUpdate)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"mode", "lr", "weight_decay", "momentum", "nesterov", "beta_1", "beta_2", "eps", "step", "bias_correction", "always_adapt", "scope", NULL};
+    PyObject *mode = NULL, *lr = NULL, *weight_decay = NULL, *momentum = NULL, *nesterov = NULL, *beta_1 = NULL, *beta_2 = NULL, *eps = NULL, *step = NULL, *bias_correction = NULL, *always_adapt = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOOOOOOOO", const_cast<char**>(kwlist), &mode, &lr, &weight_decay, &momentum, &nesterov, &beta_1, &beta_2, &eps, &step, &bias_correction, &always_adapt, &scope))
+    return -1;
+
+    if (mode) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().mode =
+                    py::cast<decltype(FusedOptimizerUpdate::mode)>(py::handle(mode));
+        } CATCH_ALL(-1)
+    }
+
+    if (lr) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().lr =
+                    py::cast<decltype(FusedOptimizerUpdate::lr)>(py::handle(lr));
+        } CATCH_ALL(-1)
+    }
+
+    if (weight_decay) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().weight_decay =
+                    py::cast<decltype(FusedOptimizerUpdate::weight_decay)>(py::handle(weight_decay));
+        } CATCH_ALL(-1)
+    }
+
+    if (momentum) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().momentum =
+                    py::cast<decltype(FusedOptimizerUpdate::momentum)>(py::handle(momentum));
+        } CATCH_ALL(-1)
+    }
+
+    if (nesterov) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().nesterov =
+                    py::cast<decltype(FusedOptimizerUpdate::nesterov)>(py::handle(nesterov));
+        } CATCH_ALL(-1)
+    }
+
+    if (beta_1) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().beta_1 =
+                    py::cast<decltype(FusedOptimizerUpdate::beta_1)>(py::handle(beta_1));
+        } CATCH_ALL(-1)
+    }
+
+    if (beta_2) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().beta_2 =
+                    py::cast<decltype(FusedOptimizerUpdate::beta_2)>(py::handle(beta_2));
+        } CATCH_ALL(-1)
+    }
+
+    if (eps) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().eps =
+                    py::cast<decltype(FusedOptimizerUpdate::eps)>(py::handle(eps));
+        } CATCH_ALL(-1)
+    }
+
+    if (step) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().step =
+                    py::cast<decltype(FusedOptimizerUpdate::step)>(py::handle(step));
+        } CATCH_ALL(-1)
+    }
+
+    if (bias_correction) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().bias_correction =
+                    py::cast<decltype(FusedOptimizerUpdate::bias_correction)>(py::handle(bias_correction));
+        } CATCH_ALL(-1)
+    }
+
+    if (always_adapt) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(FusedOptimizerUpdate)*>(self)->inst().always_adapt =
+                    py::cast<decltype(FusedOptimizerUpdate::always_adapt)>(py::handle(always_adapt));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
+
+    return 0;
+}
+
+PyGetSetDef PyOp(FusedOptimizerUpdate)::py_getsetters[] = {
+    {const_cast<char*>("mode"), py_get_generic(FusedOptimizerUpdate, mode), py_set_generic(FusedOptimizerUpdate, mode), const_cast<char*>("mode"), NULL},
+    {const_cast<char*>("lr"), py_get_generic(FusedOptimizerUpdate, lr), py_set_generic(FusedOptimizerUpdate, lr), const_cast<char*>("lr"), NULL},
+    {const_cast<char*>("weight_decay"), py_get_generic(FusedOptimizerUpdate, weight_decay), py_set_generic(FusedOptimizerUpdate, weight_decay), const_cast<char*>("weight_decay"), NULL},
+    {const_cast<char*>("momentum"), py_get_generic(FusedOptimizerUpdate, momentum), py_set_generic(FusedOptimizerUpdate, momentum), const_cast<char*>("momentum"), NULL},
+    {const_cast<char*>("nesterov"), py_get_generic(FusedOptimizerUpdate, nesterov), py_set_generic(FusedOptimizerUpdate, nesterov), const_cast<char*>("nesterov"), NULL},
+    {const_cast<char*>("beta_1"), py_get_generic(FusedOptimizerUpdate, beta_1), py_set_generic(FusedOptimizerUpdate, beta_1), const_cast<char*>("beta_1"), NULL},
+    {const_cast<char*>("beta_2"), py_get_generic(FusedOptimizerUpdate, beta_2), py_set_generic(FusedOptimizerUpdate, beta_2), const_cast<char*>("beta_2"), NULL},
+    {const_cast<char*>("eps"), py_get_generic(FusedOptimizerUpdate, eps), py_set_generic(FusedOptimizerUpdate, eps), const_cast<char*>("eps"), NULL},
+    {const_cast<char*>("step"), py_get_generic(FusedOptimizerUpdate, step), py_set_generic(FusedOptimizerUpdate, step), const_cast<char*>("step"), NULL},
+    {const_cast<char*>("bias_correction"), py_get_generic(FusedOptimizerUpdate, bias_correction), py_set_generic(FusedOptimizerUpdate, bias_correction), const_cast<char*>("bias_correction"), NULL},
+    {const_cast<char*>("always_adapt"), py_get_generic(FusedOptimizerUpdate, always_adapt), py_set_generic(FusedOptimizerUpdate, always_adapt), const_cast<char*>("always_adapt"), NULL},
+    {NULL}  /* Sentinel */
+};
+
+    PyMethodDef PyOp(FusedOptimizerUpdate)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(FusedOptimizerUpdate)::getstate, METH_NOARGS, "FusedOptimizerUpdate getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(FusedOptimizerUpdate)::setstate, METH_VARARGS, "FusedOptimizerUpdate setstate"},
+        {NULL}  /* Sentinel */
+    };
+    
+PyObject *PyOp(FusedOptimizerUpdate)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(FusedOptimizerUpdate)::py_init(self, args, kwds) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyOp(FusedOptimizerUpdate)::py_init_methoddef = {
+    "__init__",
+    (PyCFunction)PyOp(FusedOptimizerUpdate)::py_init_proxy,
+    METH_VARARGS | METH_KEYWORDS,
+    "__init__(self, mode: Union[str, Mode] = ..., lr: float = ..., weight_decay: float = ..., momentum: float = ..., nesterov: bool = ..., beta_1: float = ..., beta_2: float = ..., eps: float = ..., step: float = ..., bias_correction: bool = ..., always_adapt: bool = ...) -> None\n"
+};
+
+void _init_py_FusedOptimizerUpdate(py::module m) {
+    using py_op = PyOp(FusedOptimizerUpdate);
+    auto& py_type = PyOpType(FusedOptimizerUpdate);
+    py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+    py_type.tp_name = "megengine.core._imperative_rt.ops.FusedOptimizerUpdate";
+    py_type.tp_basicsize = sizeof(PyOp(FusedOptimizerUpdate));
+    py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    py_type.tp_doc = "FusedOptimizerUpdate";
+    py_type.tp_base = &PyOpType(OpDef);
+    py_type.tp_dealloc = py_dealloc_generic<py_op>;
+    py_type.tp_new = py_new_generic<py_op>;
+    py_type.tp_init = py_op::py_init;
+    py_type.tp_methods = py_op::tp_methods;
+    py_type.tp_getset = py_op::py_getsetters;
+
+    py_type.tp_dict = PyDict_New();
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(FusedOptimizerUpdate), &PyOp(FusedOptimizerUpdate)::py_init_methoddef);
+    PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
+    mgb_assert(PyType_Ready(&py_type) >= 0);
+        _init_py_FusedOptimizerUpdate_Mode(py_type);
+
+    PyType_Modified(&py_type);
+    m.add_object("FusedOptimizerUpdate", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(FusedOptimizerUpdate::typeinfo(), &py_type).second);
+}
+
+PyOpDefBegin(GammaRNG) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(GammaRNG)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"seed", serialization<decltype(opdef.seed)>::dump(opdef.seed)},
+            {"handle", serialization<decltype(opdef.handle)>::dump(opdef.handle)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
         auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
         auto& opdef = reinterpret_cast<PyOp(GammaRNG)*>(self)->inst();
         static_cast<void>(opdef);
@@ -11682,6 +12365,81 @@ void _init_py_GaussianRNG(py::module m) {
     mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(GaussianRNG::typeinfo(), &py_type).second);
 }
 
+template<> struct EnumTrait<GeneralNorm::Mode> {
+    static constexpr const char *name = "GeneralNorm.Mode";
+    static constexpr std::underlying_type_t<GeneralNorm::Mode> max = 2 - 1;
+};
+template<> PyTypeObject* EnumWrapper<GeneralNorm::Mode>::type = nullptr;
+
+template<> const char*
+EnumWrapper<GeneralNorm::Mode>::members[] = {"LAYER_NORM", "RMS_NORM"};
+
+template<> std::unordered_map<std::string, GeneralNorm::Mode>
+EnumWrapper<GeneralNorm::Mode>::mem2value = {{normalize_enum("LAYER_NORM"), GeneralNorm::Mode::LAYER_NORM}, {normalize_enum("RMS_NORM"), GeneralNorm::Mode::RMS_NORM}};
+template<> PyObject* EnumWrapper<GeneralNorm::Mode>::pyobj_insts[2] = {nullptr};
+
+void _init_py_GeneralNorm_Mode(PyTypeObject& py_type) {
+    auto& e_type = EnumWrapper<GeneralNorm::Mode>::type;
+
+    static PyMethodDef tp_methods[] = {
+        {const_cast<char*>("dump"), (PyCFunction)EnumWrapper<GeneralNorm::Mode>::py_dump, METH_NOARGS, NULL},
+        {NULL}  /* Sentinel */
+        };
+    
+    static PyType_Slot slots[] = {
+        {Py_tp_repr, (void*)EnumWrapper<GeneralNorm::Mode>::py_repr},
+        {Py_tp_richcompare, (void*)EnumWrapper<GeneralNorm::Mode>::tp_richcompare},
+        {Py_tp_methods, tp_methods},
+
+        {0, NULL}
+    };
+    static PyType_Spec spec = {
+        // name
+        "megengine.core._imperative_rt.ops.GeneralNorm.Mode",
+        // basicsize
+        sizeof(EnumWrapper<GeneralNorm::Mode>),
+        // itemsize
+        0,
+        // flags
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HEAPTYPE,
+        // slots
+        slots
+    };
+    e_type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&spec));
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__name__").release().ptr(),
+                    py::cast("Mode").release().ptr()) >= 0);
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__module__").release().ptr(),
+                    py::cast("megengine.core._imperative_rt.ops").release().ptr()) >= 0);
+
+    mgb_assert(
+            e_type->tp_setattro(
+                    reinterpret_cast<PyObject*>(e_type),
+                    py::cast("__qualname__").release().ptr(),
+                    py::cast("GeneralNorm.Mode").release().ptr()) >= 0);
+{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<GeneralNorm::Mode>*>(inst)->value = GeneralNorm::Mode::LAYER_NORM;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "LAYER_NORM", inst) >= 0);
+    EnumWrapper<GeneralNorm::Mode>::pyobj_insts[0] = inst;
+}{
+    PyObject* inst = e_type->tp_alloc(e_type, 0);
+    reinterpret_cast<EnumWrapper<GeneralNorm::Mode>*>(inst)->value = GeneralNorm::Mode::RMS_NORM;
+    mgb_assert(PyDict_SetItemString(e_type->tp_dict, "RMS_NORM", inst) >= 0);
+    EnumWrapper<GeneralNorm::Mode>::pyobj_insts[1] = inst;
+}
+    Py_INCREF(e_type);
+    mgb_assert(PyDict_SetItemString(
+        py_type.tp_dict, "Mode", reinterpret_cast<PyObject*>(e_type)) >= 0);
+}
+
 PyOpDefBegin(GeneralNorm) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
@@ -11694,7 +12452,8 @@ PyOpDefBegin(GeneralNorm) // {
             {"affine", serialization<decltype(opdef.affine)>::dump(opdef.affine)},
             {"eps", serialization<decltype(opdef.eps)>::dump(opdef.eps)},
             {"axis_start", serialization<decltype(opdef.axis_start)>::dump(opdef.axis_start)},
-            {"axis_end", serialization<decltype(opdef.axis_end)>::dump(opdef.axis_end)}
+            {"axis_end", serialization<decltype(opdef.axis_end)>::dump(opdef.axis_end)},
+            {"mode", serialization<decltype(opdef.mode)>::dump(opdef.mode)}
         };
         return py::cast(state).release().ptr();
     }
@@ -11732,6 +12491,13 @@ PyOpDefBegin(GeneralNorm) // {
             opdef.axis_end = serialization<decltype(opdef.axis_end)>::load(iter->second);
         }
         }
+
+        {
+        auto&& iter = state.find("mode");
+        if (iter != state.end()) {
+            opdef.mode = serialization<decltype(opdef.mode)>::load(iter->second);
+        }
+        }
         Py_RETURN_NONE;
     }
     static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
@@ -11741,9 +12507,9 @@ PyOpDefBegin(GeneralNorm) // {
 PyOpDefEnd(GeneralNorm)
 
 int PyOp(GeneralNorm)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
-    static const char* kwlist[] = {"affine", "eps", "axis_start", "axis_end", "scope", NULL};
-    PyObject *affine = NULL, *eps = NULL, *axis_start = NULL, *axis_end = NULL, *scope = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", const_cast<char**>(kwlist), &affine, &eps, &axis_start, &axis_end, &scope))
+    static const char* kwlist[] = {"affine", "eps", "axis_start", "axis_end", "mode", "scope", NULL};
+    PyObject *affine = NULL, *eps = NULL, *axis_start = NULL, *axis_end = NULL, *mode = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOO", const_cast<char**>(kwlist), &affine, &eps, &axis_start, &axis_end, &mode, &scope))
     return -1;
 
     if (affine) {
@@ -11782,6 +12548,15 @@ int PyOp(GeneralNorm)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
         } CATCH_ALL(-1)
     }
 
+    if (mode) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(GeneralNorm)*>(self)->inst().mode =
+                    py::cast<decltype(GeneralNorm::mode)>(py::handle(mode));
+        } CATCH_ALL(-1)
+    }
+
     if (scope) {
         try {
             reinterpret_cast<PyOp(OpDef)*>(self)->op
@@ -11797,6 +12572,7 @@ PyGetSetDef PyOp(GeneralNorm)::py_getsetters[] = {
     {const_cast<char*>("eps"), py_get_generic(GeneralNorm, eps), py_set_generic(GeneralNorm, eps), const_cast<char*>("eps"), NULL},
     {const_cast<char*>("axis_start"), py_get_generic(GeneralNorm, axis_start), py_set_generic(GeneralNorm, axis_start), const_cast<char*>("axis_start"), NULL},
     {const_cast<char*>("axis_end"), py_get_generic(GeneralNorm, axis_end), py_set_generic(GeneralNorm, axis_end), const_cast<char*>("axis_end"), NULL},
+    {const_cast<char*>("mode"), py_get_generic(GeneralNorm, mode), py_set_generic(GeneralNorm, mode), const_cast<char*>("mode"), NULL},
     {NULL}  /* Sentinel */
 };
 
@@ -11817,7 +12593,7 @@ PyMethodDef PyOp(GeneralNorm)::py_init_methoddef = {
     "__init__",
     (PyCFunction)PyOp(GeneralNorm)::py_init_proxy,
     METH_VARARGS | METH_KEYWORDS,
-    "__init__(self, affine: bool = ..., eps: float = ..., axis_start: int = ..., axis_end: int = ...) -> None\n"
+    "__init__(self, affine: bool = ..., eps: float = ..., axis_start: int = ..., axis_end: int = ..., mode: Union[str, Mode] = ...) -> None\n"
 };
 
 void _init_py_GeneralNorm(py::module m) {
@@ -11839,7 +12615,8 @@ void _init_py_GeneralNorm(py::module m) {
     PyObject* descr = PyDescr_NewMethod(&PyOpType(GeneralNorm), &PyOp(GeneralNorm)::py_init_methoddef);
     PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
     mgb_assert(PyType_Ready(&py_type) >= 0);
-    
+        _init_py_GeneralNorm_Mode(py_type);
+
     PyType_Modified(&py_type);
     m.add_object("GeneralNorm", reinterpret_cast<PyObject*>(&py_type));
     mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(GeneralNorm::typeinfo(), &py_type).second);
@@ -13309,20 +14086,255 @@ void _init_py_IndexingOneHot(py::module m) {
     mgb_assert(PyType_Ready(&py_type) >= 0);
     
     PyType_Modified(&py_type);
-    m.add_object("IndexingOneHot", reinterpret_cast<PyObject*>(&py_type));
-    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(IndexingOneHot::typeinfo(), &py_type).second);
+    m.add_object("IndexingOneHot", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(IndexingOneHot::typeinfo(), &py_type).second);
+}
+
+PyOpDefBegin(IndexingSetMultiAxisVec) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(IndexingSetMultiAxisVec)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"items", serialization<decltype(opdef.items)>::dump(opdef.items)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
+        auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
+        auto& opdef = reinterpret_cast<PyOp(IndexingSetMultiAxisVec)*>(self)->inst();
+        static_cast<void>(opdef);
+        
+        {
+        auto&& iter = state.find("items");
+        if (iter != state.end()) {
+            opdef.items = serialization<decltype(opdef.items)>::load(iter->second);
+        }
+        }
+        Py_RETURN_NONE;
+    }
+    static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyMethodDef py_init_methoddef;
+// };
+PyOpDefEnd(IndexingSetMultiAxisVec)
+
+int PyOp(IndexingSetMultiAxisVec)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"items", "scope", NULL};
+    PyObject *items = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", const_cast<char**>(kwlist), &items, &scope))
+    return -1;
+
+    if (items) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(IndexingSetMultiAxisVec)*>(self)->inst().items =
+                    py::cast<decltype(IndexingSetMultiAxisVec::items)>(py::handle(items));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
+
+    return 0;
+}
+
+PyGetSetDef PyOp(IndexingSetMultiAxisVec)::py_getsetters[] = {
+    {const_cast<char*>("items"), py_get_generic(IndexingSetMultiAxisVec, items), py_set_generic(IndexingSetMultiAxisVec, items), const_cast<char*>("items"), NULL},
+    {NULL}  /* Sentinel */
+};
+
+    PyMethodDef PyOp(IndexingSetMultiAxisVec)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(IndexingSetMultiAxisVec)::getstate, METH_NOARGS, "IndexingSetMultiAxisVec getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(IndexingSetMultiAxisVec)::setstate, METH_VARARGS, "IndexingSetMultiAxisVec setstate"},
+        {NULL}  /* Sentinel */
+    };
+    
+PyObject *PyOp(IndexingSetMultiAxisVec)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(IndexingSetMultiAxisVec)::py_init(self, args, kwds) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyOp(IndexingSetMultiAxisVec)::py_init_methoddef = {
+    "__init__",
+    (PyCFunction)PyOp(IndexingSetMultiAxisVec)::py_init_proxy,
+    METH_VARARGS | METH_KEYWORDS,
+    "__init__(self, items: list[tuple[int, bool, bool, bool, bool]] = ...) -> None\n"
+};
+
+void _init_py_IndexingSetMultiAxisVec(py::module m) {
+    using py_op = PyOp(IndexingSetMultiAxisVec);
+    auto& py_type = PyOpType(IndexingSetMultiAxisVec);
+    py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+    py_type.tp_name = "megengine.core._imperative_rt.ops.IndexingSetMultiAxisVec";
+    py_type.tp_basicsize = sizeof(PyOp(IndexingSetMultiAxisVec));
+    py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    py_type.tp_doc = "IndexingSetMultiAxisVec";
+    py_type.tp_base = &PyOpType(OpDef);
+    py_type.tp_dealloc = py_dealloc_generic<py_op>;
+    py_type.tp_new = py_new_generic<py_op>;
+    py_type.tp_init = py_op::py_init;
+    py_type.tp_methods = py_op::tp_methods;
+    py_type.tp_getset = py_op::py_getsetters;
+
+    py_type.tp_dict = PyDict_New();
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(IndexingSetMultiAxisVec), &PyOp(IndexingSetMultiAxisVec)::py_init_methoddef);
+    PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
+    mgb_assert(PyType_Ready(&py_type) >= 0);
+    
+    PyType_Modified(&py_type);
+    m.add_object("IndexingSetMultiAxisVec", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(IndexingSetMultiAxisVec::typeinfo(), &py_type).second);
+}
+
+PyOpDefBegin(IndexingSetOneHot) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"axis", serialization<decltype(opdef.axis)>::dump(opdef.axis)},
+            {"ndim", serialization<decltype(opdef.ndim)>::dump(opdef.ndim)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
+        auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
+        auto& opdef = reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst();
+        static_cast<void>(opdef);
+        
+        {
+        auto&& iter = state.find("axis");
+        if (iter != state.end()) {
+            opdef.axis = serialization<decltype(opdef.axis)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("ndim");
+        if (iter != state.end()) {
+            opdef.ndim = serialization<decltype(opdef.ndim)>::load(iter->second);
+        }
+        }
+        Py_RETURN_NONE;
+    }
+    static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyMethodDef py_init_methoddef;
+// };
+PyOpDefEnd(IndexingSetOneHot)
+
+int PyOp(IndexingSetOneHot)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"axis", "ndim", "scope", NULL};
+    PyObject *axis = NULL, *ndim = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", const_cast<char**>(kwlist), &axis, &ndim, &scope))
+    return -1;
+
+    if (axis) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst().axis =
+                    py::cast<decltype(IndexingSetOneHot::axis)>(py::handle(axis));
+        } CATCH_ALL(-1)
+    }
+
+    if (ndim) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst().ndim =
+                    py::cast<decltype(IndexingSetOneHot::ndim)>(py::handle(ndim));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
+
+    return 0;
+}
+
+PyGetSetDef PyOp(IndexingSetOneHot)::py_getsetters[] = {
+    {const_cast<char*>("axis"), py_get_generic(IndexingSetOneHot, axis), py_set_generic(IndexingSetOneHot, axis), const_cast<char*>("axis"), NULL},
+    {const_cast<char*>("ndim"), py_get_generic(IndexingSetOneHot, ndim), py_set_generic(IndexingSetOneHot, ndim), const_cast<char*>("ndim"), NULL},
+    {NULL}  /* Sentinel */
+};
+
+    PyMethodDef PyOp(IndexingSetOneHot)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(IndexingSetOneHot)::getstate, METH_NOARGS, "IndexingSetOneHot getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(IndexingSetOneHot)::setstate, METH_VARARGS, "IndexingSetOneHot setstate"},
+        {NULL}  /* Sentinel */
+    };
+    
+PyObject *PyOp(IndexingSetOneHot)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(IndexingSetOneHot)::py_init(self, args, kwds) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyOp(IndexingSetOneHot)::py_init_methoddef = {
+    "__init__",
+    (PyCFunction)PyOp(IndexingSetOneHot)::py_init_proxy,
+    METH_VARARGS | METH_KEYWORDS,
+    "__init__(self, axis: int = ..., ndim: int = ...) -> None\n"
+};
+
+void _init_py_IndexingSetOneHot(py::module m) {
+    using py_op = PyOp(IndexingSetOneHot);
+    auto& py_type = PyOpType(IndexingSetOneHot);
+    py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+    py_type.tp_name = "megengine.core._imperative_rt.ops.IndexingSetOneHot";
+    py_type.tp_basicsize = sizeof(PyOp(IndexingSetOneHot));
+    py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    py_type.tp_doc = "IndexingSetOneHot";
+    py_type.tp_base = &PyOpType(OpDef);
+    py_type.tp_dealloc = py_dealloc_generic<py_op>;
+    py_type.tp_new = py_new_generic<py_op>;
+    py_type.tp_init = py_op::py_init;
+    py_type.tp_methods = py_op::tp_methods;
+    py_type.tp_getset = py_op::py_getsetters;
+
+    py_type.tp_dict = PyDict_New();
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(IndexingSetOneHot), &PyOp(IndexingSetOneHot)::py_init_methoddef);
+    PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
+    mgb_assert(PyType_Ready(&py_type) >= 0);
+    
+    PyType_Modified(&py_type);
+    m.add_object("IndexingSetOneHot", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(IndexingSetOneHot::typeinfo(), &py_type).second);
 }
 
-PyOpDefBegin(IndexingSetMultiAxisVec) // {
+PyOpDefBegin(InplaceAdd) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
     
     static PyObject* getstate(PyObject* self, PyObject*) {
-        auto& opdef = reinterpret_cast<PyOp(IndexingSetMultiAxisVec)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(InplaceAdd)*>(self)->inst();
         static_cast<void>(opdef);
         std::unordered_map<std::string, py::object> state {
             
-            {"items", serialization<decltype(opdef.items)>::dump(opdef.items)}
         };
         return py::cast(state).release().ptr();
     }
@@ -13330,81 +14342,55 @@ PyOpDefBegin(IndexingSetMultiAxisVec) // {
         PyObject* dict = PyTuple_GetItem(args, 0);
         if (!dict) return NULL;
         auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
-        auto& opdef = reinterpret_cast<PyOp(IndexingSetMultiAxisVec)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(InplaceAdd)*>(self)->inst();
         static_cast<void>(opdef);
         
-        {
-        auto&& iter = state.find("items");
-        if (iter != state.end()) {
-            opdef.items = serialization<decltype(opdef.items)>::load(iter->second);
-        }
-        }
         Py_RETURN_NONE;
     }
     static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
     static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
     static PyMethodDef py_init_methoddef;
 // };
-PyOpDefEnd(IndexingSetMultiAxisVec)
-
-int PyOp(IndexingSetMultiAxisVec)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
-    static const char* kwlist[] = {"items", "scope", NULL};
-    PyObject *items = NULL, *scope = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", const_cast<char**>(kwlist), &items, &scope))
-    return -1;
-
-    if (items) {
-        try {
-            // TODO: remove this guard which is used for pybind11 implicit conversion
-            py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(IndexingSetMultiAxisVec)*>(self)->inst().items =
-                    py::cast<decltype(IndexingSetMultiAxisVec::items)>(py::handle(items));
-        } CATCH_ALL(-1)
-    }
-
-    if (scope) {
-        try {
-            reinterpret_cast<PyOp(OpDef)*>(self)->op
-                ->set_scope(py::cast<std::string>(py::handle(scope)));
-        } CATCH_ALL(-1)
-    }
+PyOpDefEnd(InplaceAdd)
 
+int PyOp(InplaceAdd)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    
     return 0;
 }
 
-PyGetSetDef PyOp(IndexingSetMultiAxisVec)::py_getsetters[] = {
-    {const_cast<char*>("items"), py_get_generic(IndexingSetMultiAxisVec, items), py_set_generic(IndexingSetMultiAxisVec, items), const_cast<char*>("items"), NULL},
+PyGetSetDef PyOp(InplaceAdd)::py_getsetters[] = {
+    
     {NULL}  /* Sentinel */
 };
 
-    PyMethodDef PyOp(IndexingSetMultiAxisVec)::tp_methods[] = {
-        {const_cast<char*>("__getstate__"), PyOp(IndexingSetMultiAxisVec)::getstate, METH_NOARGS, "IndexingSetMultiAxisVec getstate"},
-    {const_cast<char*>("__setstate__"), PyOp(IndexingSetMultiAxisVec)::setstate, METH_VARARGS, "IndexingSetMultiAxisVec setstate"},
+    PyMethodDef PyOp(InplaceAdd)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(InplaceAdd)::getstate, METH_NOARGS, "InplaceAdd getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(InplaceAdd)::setstate, METH_VARARGS, "InplaceAdd setstate"},
         {NULL}  /* Sentinel */
     };
     
-PyObject *PyOp(IndexingSetMultiAxisVec)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
-    if (PyOp(IndexingSetMultiAxisVec)::py_init(self, args, kwds) < 0) {
+PyObject *PyOp(InplaceAdd)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(InplaceAdd)::py_init(self, args, kwds) < 0) {
         return NULL;
     }
     Py_RETURN_NONE;
 }
 
-PyMethodDef PyOp(IndexingSetMultiAxisVec)::py_init_methoddef = {
+PyMethodDef PyOp(InplaceAdd)::py_init_methoddef = {
     "__init__",
-    (PyCFunction)PyOp(IndexingSetMultiAxisVec)::py_init_proxy,
+    (PyCFunction)PyOp(InplaceAdd)::py_init_proxy,
     METH_VARARGS | METH_KEYWORDS,
-    "__init__(self, items: list[tuple[int, bool, bool, bool, bool]] = ...) -> None\n"
+    "__init__(self) -> None\n"
 };
 
-void _init_py_IndexingSetMultiAxisVec(py::module m) {
-    using py_op = PyOp(IndexingSetMultiAxisVec);
-    auto& py_type = PyOpType(IndexingSetMultiAxisVec);
+void _init_py_InplaceAdd(py::module m) {
+    using py_op = PyOp(InplaceAdd);
+    auto& py_type = PyOpType(InplaceAdd);
     py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
-    py_type.tp_name = "megengine.core._imperative_rt.ops.IndexingSetMultiAxisVec";
-    py_type.tp_basicsize = sizeof(PyOp(IndexingSetMultiAxisVec));
+    py_type.tp_name = "megengine.core._imperative_rt.ops.InplaceAdd";
+    py_type.tp_basicsize = sizeof(PyOp(InplaceAdd));
     py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
-    py_type.tp_doc = "IndexingSetMultiAxisVec";
+    py_type.tp_doc = "InplaceAdd";
     py_type.tp_base = &PyOpType(OpDef);
     py_type.tp_dealloc = py_dealloc_generic<py_op>;
     py_type.tp_new = py_new_generic<py_op>;
@@ -13413,26 +14399,36 @@ void _init_py_IndexingSetMultiAxisVec(py::module m) {
     py_type.tp_getset = py_op::py_getsetters;
 
     py_type.tp_dict = PyDict_New();
-    PyObject* descr = PyDescr_NewMethod(&PyOpType(IndexingSetMultiAxisVec), &PyOp(IndexingSetMultiAxisVec)::py_init_methoddef);
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(InplaceAdd), &PyOp(InplaceAdd)::py_init_methoddef);
     PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
     mgb_assert(PyType_Ready(&py_type) >= 0);
     
     PyType_Modified(&py_type);
-    m.add_object("IndexingSetMultiAxisVec", reinterpret_cast<PyObject*>(&py_type));
-    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(IndexingSetMultiAxisVec::typeinfo(), &py_type).second);
+    m.add_object("InplaceAdd", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(InplaceAdd::typeinfo(), &py_type).second);
 }
 
-PyOpDefBegin(IndexingSetOneHot) // {
+void _init_py_InstanceNorm_Format(PyTypeObject& py_type) {
+    auto& e_type = EnumWrapper<InstanceNorm::Format>::type;
+
+    Py_INCREF(e_type);
+    mgb_assert(PyDict_SetItemString(
+        py_type.tp_dict, "Format", reinterpret_cast<PyObject*>(e_type)) >= 0);
+}
+
+PyOpDefBegin(InstanceNorm) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
     
     static PyObject* getstate(PyObject* self, PyObject*) {
-        auto& opdef = reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst();
         static_cast<void>(opdef);
         std::unordered_map<std::string, py::object> state {
             
-            {"axis", serialization<decltype(opdef.axis)>::dump(opdef.axis)},
-            {"ndim", serialization<decltype(opdef.ndim)>::dump(opdef.ndim)}
+            {"affine", serialization<decltype(opdef.affine)>::dump(opdef.affine)},
+            {"eps", serialization<decltype(opdef.eps)>::dump(opdef.eps)},
+            {"group", serialization<decltype(opdef.group)>::dump(opdef.group)},
+            {"format", serialization<decltype(opdef.format)>::dump(opdef.format)}
         };
         return py::cast(state).release().ptr();
     }
@@ -13440,20 +14436,34 @@ PyOpDefBegin(IndexingSetOneHot) // {
         PyObject* dict = PyTuple_GetItem(args, 0);
         if (!dict) return NULL;
         auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
-        auto& opdef = reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst();
         static_cast<void>(opdef);
         
         {
-        auto&& iter = state.find("axis");
+        auto&& iter = state.find("affine");
         if (iter != state.end()) {
-            opdef.axis = serialization<decltype(opdef.axis)>::load(iter->second);
+            opdef.affine = serialization<decltype(opdef.affine)>::load(iter->second);
         }
         }
 
         {
-        auto&& iter = state.find("ndim");
+        auto&& iter = state.find("eps");
         if (iter != state.end()) {
-            opdef.ndim = serialization<decltype(opdef.ndim)>::load(iter->second);
+            opdef.eps = serialization<decltype(opdef.eps)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("group");
+        if (iter != state.end()) {
+            opdef.group = serialization<decltype(opdef.group)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("format");
+        if (iter != state.end()) {
+            opdef.format = serialization<decltype(opdef.format)>::load(iter->second);
         }
         }
         Py_RETURN_NONE;
@@ -13462,29 +14472,47 @@ PyOpDefBegin(IndexingSetOneHot) // {
     static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
     static PyMethodDef py_init_methoddef;
 // };
-PyOpDefEnd(IndexingSetOneHot)
+PyOpDefEnd(InstanceNorm)
 
-int PyOp(IndexingSetOneHot)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
-    static const char* kwlist[] = {"axis", "ndim", "scope", NULL};
-    PyObject *axis = NULL, *ndim = NULL, *scope = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", const_cast<char**>(kwlist), &axis, &ndim, &scope))
+int PyOp(InstanceNorm)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"affine", "eps", "group", "format", "scope", NULL};
+    PyObject *affine = NULL, *eps = NULL, *group = NULL, *format = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", const_cast<char**>(kwlist), &affine, &eps, &group, &format, &scope))
     return -1;
 
-    if (axis) {
+    if (affine) {
         try {
             // TODO: remove this guard which is used for pybind11 implicit conversion
             py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst().axis =
-                    py::cast<decltype(IndexingSetOneHot::axis)>(py::handle(axis));
+            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().affine =
+                    py::cast<decltype(InstanceNorm::affine)>(py::handle(affine));
         } CATCH_ALL(-1)
     }
 
-    if (ndim) {
+    if (eps) {
         try {
             // TODO: remove this guard which is used for pybind11 implicit conversion
             py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(IndexingSetOneHot)*>(self)->inst().ndim =
-                    py::cast<decltype(IndexingSetOneHot::ndim)>(py::handle(ndim));
+            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().eps =
+                    py::cast<decltype(InstanceNorm::eps)>(py::handle(eps));
+        } CATCH_ALL(-1)
+    }
+
+    if (group) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().group =
+                    py::cast<decltype(InstanceNorm::group)>(py::handle(group));
+        } CATCH_ALL(-1)
+    }
+
+    if (format) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().format =
+                    py::cast<decltype(InstanceNorm::format)>(py::handle(format));
         } CATCH_ALL(-1)
     }
 
@@ -13498,40 +14526,42 @@ int PyOp(IndexingSetOneHot)::py_init(PyObject *self, PyObject *args, PyObject *k
     return 0;
 }
 
-PyGetSetDef PyOp(IndexingSetOneHot)::py_getsetters[] = {
-    {const_cast<char*>("axis"), py_get_generic(IndexingSetOneHot, axis), py_set_generic(IndexingSetOneHot, axis), const_cast<char*>("axis"), NULL},
-    {const_cast<char*>("ndim"), py_get_generic(IndexingSetOneHot, ndim), py_set_generic(IndexingSetOneHot, ndim), const_cast<char*>("ndim"), NULL},
+PyGetSetDef PyOp(InstanceNorm)::py_getsetters[] = {
+    {const_cast<char*>("affine"), py_get_generic(InstanceNorm, affine), py_set_generic(InstanceNorm, affine), const_cast<char*>("affine"), NULL},
+    {const_cast<char*>("eps"), py_get_generic(InstanceNorm, eps), py_set_generic(InstanceNorm, eps), const_cast<char*>("eps"), NULL},
+    {const_cast<char*>("group"), py_get_generic(InstanceNorm, group), py_set_generic(InstanceNorm, group), const_cast<char*>("group"), NULL},
+    {const_cast<char*>("format"), py_get_generic(InstanceNorm, format), py_set_generic(InstanceNorm, format), const_cast<char*>("format"), NULL},
     {NULL}  /* Sentinel */
 };
 
-    PyMethodDef PyOp(IndexingSetOneHot)::tp_methods[] = {
-        {const_cast<char*>("__getstate__"), PyOp(IndexingSetOneHot)::getstate, METH_NOARGS, "IndexingSetOneHot getstate"},
-    {const_cast<char*>("__setstate__"), PyOp(IndexingSetOneHot)::setstate, METH_VARARGS, "IndexingSetOneHot setstate"},
+    PyMethodDef PyOp(InstanceNorm)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(InstanceNorm)::getstate, METH_NOARGS, "InstanceNorm getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(InstanceNorm)::setstate, METH_VARARGS, "InstanceNorm setstate"},
         {NULL}  /* Sentinel */
     };
     
-PyObject *PyOp(IndexingSetOneHot)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
-    if (PyOp(IndexingSetOneHot)::py_init(self, args, kwds) < 0) {
+PyObject *PyOp(InstanceNorm)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(InstanceNorm)::py_init(self, args, kwds) < 0) {
         return NULL;
     }
     Py_RETURN_NONE;
 }
 
-PyMethodDef PyOp(IndexingSetOneHot)::py_init_methoddef = {
+PyMethodDef PyOp(InstanceNorm)::py_init_methoddef = {
     "__init__",
-    (PyCFunction)PyOp(IndexingSetOneHot)::py_init_proxy,
+    (PyCFunction)PyOp(InstanceNorm)::py_init_proxy,
     METH_VARARGS | METH_KEYWORDS,
-    "__init__(self, axis: int = ..., ndim: int = ...) -> None\n"
+    "__init__(self, affine: bool = ..., eps: float = ..., group: int = ..., format: Union[str, Format] = ...) -> None\n"
 };
 
-void _init_py_IndexingSetOneHot(py::module m) {
-    using py_op = PyOp(IndexingSetOneHot);
-    auto& py_type = PyOpType(IndexingSetOneHot);
+void _init_py_InstanceNorm(py::module m) {
+    using py_op = PyOp(InstanceNorm);
+    auto& py_type = PyOpType(InstanceNorm);
     py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
-    py_type.tp_name = "megengine.core._imperative_rt.ops.IndexingSetOneHot";
-    py_type.tp_basicsize = sizeof(PyOp(IndexingSetOneHot));
+    py_type.tp_name = "megengine.core._imperative_rt.ops.InstanceNorm";
+    py_type.tp_basicsize = sizeof(PyOp(InstanceNorm));
     py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
-    py_type.tp_doc = "IndexingSetOneHot";
+    py_type.tp_doc = "InstanceNorm";
     py_type.tp_base = &PyOpType(OpDef);
     py_type.tp_dealloc = py_dealloc_generic<py_op>;
     py_type.tp_new = py_new_generic<py_op>;
@@ -13540,24 +14570,28 @@ void _init_py_IndexingSetOneHot(py::module m) {
     py_type.tp_getset = py_op::py_getsetters;
 
     py_type.tp_dict = PyDict_New();
-    PyObject* descr = PyDescr_NewMethod(&PyOpType(IndexingSetOneHot), &PyOp(IndexingSetOneHot)::py_init_methoddef);
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(InstanceNorm), &PyOp(InstanceNorm)::py_init_methoddef);
     PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
     mgb_assert(PyType_Ready(&py_type) >= 0);
-    
+        _init_py_InstanceNorm_Format(py_type);
+
     PyType_Modified(&py_type);
-    m.add_object("IndexingSetOneHot", reinterpret_cast<PyObject*>(&py_type));
-    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(IndexingSetOneHot::typeinfo(), &py_type).second);
+    m.add_object("InstanceNorm", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(InstanceNorm::typeinfo(), &py_type).second);
 }
 
-PyOpDefBegin(InplaceAdd) // {
+PyOpDefBegin(KVCacheAppend) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
     
     static PyObject* getstate(PyObject* self, PyObject*) {
-        auto& opdef = reinterpret_cast<PyOp(InplaceAdd)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(KVCacheAppend)*>(self)->inst();
         static_cast<void>(opdef);
         std::unordered_map<std::string, py::object> state {
             
+            {"num_heads", serialization<decltype(opdef.num_heads)>::dump(opdef.num_heads)},
+            {"rotary_dim", serialization<decltype(opdef.rotary_dim)>::dump(opdef.rotary_dim)},
+            {"rotary_base", serialization<decltype(opdef.rotary_base)>::dump(opdef.rotary_base)}
         };
         return py::cast(state).release().ptr();
     }
@@ -13565,55 +14599,115 @@ PyOpDefBegin(InplaceAdd) // {
         PyObject* dict = PyTuple_GetItem(args, 0);
         if (!dict) return NULL;
         auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
-        auto& opdef = reinterpret_cast<PyOp(InplaceAdd)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(KVCacheAppend)*>(self)->inst();
         static_cast<void>(opdef);
         
+        {
+        auto&& iter = state.find("num_heads");
+        if (iter != state.end()) {
+            opdef.num_heads = serialization<decltype(opdef.num_heads)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("rotary_dim");
+        if (iter != state.end()) {
+            opdef.rotary_dim = serialization<decltype(opdef.rotary_dim)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("rotary_base");
+        if (iter != state.end()) {
+            opdef.rotary_base = serialization<decltype(opdef.rotary_base)>::load(iter->second);
+        }
+        }
         Py_RETURN_NONE;
     }
     static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
     static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
     static PyMethodDef py_init_methoddef;
 // };
-PyOpDefEnd(InplaceAdd)
+PyOpDefEnd(KVCacheAppend)
+
+int PyOp(KVCacheAppend)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"num_heads", "rotary_dim", "rotary_base", "scope", NULL};
+    PyObject *num_heads = NULL, *rotary_dim = NULL, *rotary_base = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO", const_cast<char**>(kwlist), &num_heads, &rotary_dim, &rotary_base, &scope))
+    return -1;
+
+    if (num_heads) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(KVCacheAppend)*>(self)->inst().num_heads =
+                    py::cast<decltype(KVCacheAppend::num_heads)>(py::handle(num_heads));
+        } CATCH_ALL(-1)
+    }
+
+    if (rotary_dim) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(KVCacheAppend)*>(self)->inst().rotary_dim =
+                    py::cast<decltype(KVCacheAppend::rotary_dim)>(py::handle(rotary_dim));
+        } CATCH_ALL(-1)
+    }
+
+    if (rotary_base) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(KVCacheAppend)*>(self)->inst().rotary_base =
+                    py::cast<decltype(KVCacheAppend::rotary_base)>(py::handle(rotary_base));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
 
-int PyOp(InplaceAdd)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
-    
     return 0;
 }
 
-PyGetSetDef PyOp(InplaceAdd)::py_getsetters[] = {
-    
+PyGetSetDef PyOp(KVCacheAppend)::py_getsetters[] = {
+    {const_cast<char*>("num_heads"), py_get_generic(KVCacheAppend, num_heads), py_set_generic(KVCacheAppend, num_heads), const_cast<char*>("num_heads"), NULL},
+    {const_cast<char*>("rotary_dim"), py_get_generic(KVCacheAppend, rotary_dim), py_set_generic(KVCacheAppend, rotary_dim), const_cast<char*>("rotary_dim"), NULL},
+    {const_cast<char*>("rotary_base"), py_get_generic(KVCacheAppend, rotary_base), py_set_generic(KVCacheAppend, rotary_base), const_cast<char*>("rotary_base"), NULL},
     {NULL}  /* Sentinel */
 };
 
-    PyMethodDef PyOp(InplaceAdd)::tp_methods[] = {
-        {const_cast<char*>("__getstate__"), PyOp(InplaceAdd)::getstate, METH_NOARGS, "InplaceAdd getstate"},
-    {const_cast<char*>("__setstate__"), PyOp(InplaceAdd)::setstate, METH_VARARGS, "InplaceAdd setstate"},
+    PyMethodDef PyOp(KVCacheAppend)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(KVCacheAppend)::getstate, METH_NOARGS, "KVCacheAppend getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(KVCacheAppend)::setstate, METH_VARARGS, "KVCacheAppend setstate"},
         {NULL}  /* Sentinel */
     };
     
-PyObject *PyOp(InplaceAdd)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
-    if (PyOp(InplaceAdd)::py_init(self, args, kwds) < 0) {
+PyObject *PyOp(KVCacheAppend)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(KVCacheAppend)::py_init(self, args, kwds) < 0) {
         return NULL;
     }
     Py_RETURN_NONE;
 }
 
-PyMethodDef PyOp(InplaceAdd)::py_init_methoddef = {
+PyMethodDef PyOp(KVCacheAppend)::py_init_methoddef = {
     "__init__",
-    (PyCFunction)PyOp(InplaceAdd)::py_init_proxy,
+    (PyCFunction)PyOp(KVCacheAppend)::py_init_proxy,
     METH_VARARGS | METH_KEYWORDS,
-    "__init__(self) -> None\n"
+    "__init__(self, num_heads: int = ..., rotary_dim: int = ..., rotary_base: float = ...) -> None\n"
 };
 
-void _init_py_InplaceAdd(py::module m) {
-    using py_op = PyOp(InplaceAdd);
-    auto& py_type = PyOpType(InplaceAdd);
+void _init_py_KVCacheAppend(py::module m) {
+    using py_op = PyOp(KVCacheAppend);
+    auto& py_type = PyOpType(KVCacheAppend);
     py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
-    py_type.tp_name = "megengine.core._imperative_rt.ops.InplaceAdd";
-    py_type.tp_basicsize = sizeof(PyOp(InplaceAdd));
+    py_type.tp_name = "megengine.core._imperative_rt.ops.KVCacheAppend";
+    py_type.tp_basicsize = sizeof(PyOp(KVCacheAppend));
     py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
-    py_type.tp_doc = "InplaceAdd";
+    py_type.tp_doc = "KVCacheAppend";
     py_type.tp_base = &PyOpType(OpDef);
     py_type.tp_dealloc = py_dealloc_generic<py_op>;
     py_type.tp_new = py_new_generic<py_op>;
@@ -13622,36 +14716,25 @@ void _init_py_InplaceAdd(py::module m) {
     py_type.tp_getset = py_op::py_getsetters;
 
     py_type.tp_dict = PyDict_New();
-    PyObject* descr = PyDescr_NewMethod(&PyOpType(InplaceAdd), &PyOp(InplaceAdd)::py_init_methoddef);
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(KVCacheAppend), &PyOp(KVCacheAppend)::py_init_methoddef);
     PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
     mgb_assert(PyType_Ready(&py_type) >= 0);
     
     PyType_Modified(&py_type);
-    m.add_object("InplaceAdd", reinterpret_cast<PyObject*>(&py_type));
-    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(InplaceAdd::typeinfo(), &py_type).second);
-}
-
-void _init_py_InstanceNorm_Format(PyTypeObject& py_type) {
-    auto& e_type = EnumWrapper<InstanceNorm::Format>::type;
-
-    Py_INCREF(e_type);
-    mgb_assert(PyDict_SetItemString(
-        py_type.tp_dict, "Format", reinterpret_cast<PyObject*>(e_type)) >= 0);
+    m.add_object("KVCacheAppend", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(KVCacheAppend::typeinfo(), &py_type).second);
 }
 
-PyOpDefBegin(InstanceNorm) // {
+PyOpDefBegin(KVCacheAttention) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
     
     static PyObject* getstate(PyObject* self, PyObject*) {
-        auto& opdef = reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(KVCacheAttention)*>(self)->inst();
         static_cast<void>(opdef);
         std::unordered_map<std::string, py::object> state {
             
-            {"affine", serialization<decltype(opdef.affine)>::dump(opdef.affine)},
-            {"eps", serialization<decltype(opdef.eps)>::dump(opdef.eps)},
-            {"group", serialization<decltype(opdef.group)>::dump(opdef.group)},
-            {"format", serialization<decltype(opdef.format)>::dump(opdef.format)}
+            {"scale", serialization<decltype(opdef.scale)>::dump(opdef.scale)}
         };
         return py::cast(state).release().ptr();
     }
@@ -13659,34 +14742,13 @@ PyOpDefBegin(InstanceNorm) // {
         PyObject* dict = PyTuple_GetItem(args, 0);
         if (!dict) return NULL;
         auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
-        auto& opdef = reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst();
+        auto& opdef = reinterpret_cast<PyOp(KVCacheAttention)*>(self)->inst();
         static_cast<void>(opdef);
         
         {
-        auto&& iter = state.find("affine");
-        if (iter != state.end()) {
-            opdef.affine = serialization<decltype(opdef.affine)>::load(iter->second);
-        }
-        }
-
-        {
-        auto&& iter = state.find("eps");
-        if (iter != state.end()) {
-            opdef.eps = serialization<decltype(opdef.eps)>::load(iter->second);
-        }
-        }
-
-        {
-        auto&& iter = state.find("group");
-        if (iter != state.end()) {
-            opdef.group = serialization<decltype(opdef.group)>::load(iter->second);
-        }
-        }
-
-        {
-        auto&& iter = state.find("format");
+        auto&& iter = state.find("scale");
         if (iter != state.end()) {
-            opdef.format = serialization<decltype(opdef.format)>::load(iter->second);
+            opdef.scale = serialization<decltype(opdef.scale)>::load(iter->second);
         }
         }
         Py_RETURN_NONE;
@@ -13695,47 +14757,20 @@ PyOpDefBegin(InstanceNorm) // {
     static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
     static PyMethodDef py_init_methoddef;
 // };
-PyOpDefEnd(InstanceNorm)
+PyOpDefEnd(KVCacheAttention)
 
-int PyOp(InstanceNorm)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
-    static const char* kwlist[] = {"affine", "eps", "group", "format", "scope", NULL};
-    PyObject *affine = NULL, *eps = NULL, *group = NULL, *format = NULL, *scope = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", const_cast<char**>(kwlist), &affine, &eps, &group, &format, &scope))
+int PyOp(KVCacheAttention)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"scale", "scope", NULL};
+    PyObject *scale = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", const_cast<char**>(kwlist), &scale, &scope))
     return -1;
 
-    if (affine) {
-        try {
-            // TODO: remove this guard which is used for pybind11 implicit conversion
-            py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().affine =
-                    py::cast<decltype(InstanceNorm::affine)>(py::handle(affine));
-        } CATCH_ALL(-1)
-    }
-
-    if (eps) {
-        try {
-            // TODO: remove this guard which is used for pybind11 implicit conversion
-            py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().eps =
-                    py::cast<decltype(InstanceNorm::eps)>(py::handle(eps));
-        } CATCH_ALL(-1)
-    }
-
-    if (group) {
-        try {
-            // TODO: remove this guard which is used for pybind11 implicit conversion
-            py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().group =
-                    py::cast<decltype(InstanceNorm::group)>(py::handle(group));
-        } CATCH_ALL(-1)
-    }
-
-    if (format) {
+    if (scale) {
         try {
             // TODO: remove this guard which is used for pybind11 implicit conversion
             py::detail::loader_life_support guard{};
-            reinterpret_cast<PyOp(InstanceNorm)*>(self)->inst().format =
-                    py::cast<decltype(InstanceNorm::format)>(py::handle(format));
+            reinterpret_cast<PyOp(KVCacheAttention)*>(self)->inst().scale =
+                    py::cast<decltype(KVCacheAttention::scale)>(py::handle(scale));
         } CATCH_ALL(-1)
     }
 
@@ -13749,42 +14784,39 @@ int PyOp(InstanceNorm)::py_init(PyObject *self, PyObject *args, PyObject *kwds)
     return 0;
 }
 
-PyGetSetDef PyOp(InstanceNorm)::py_getsetters[] = {
-    {const_cast<char*>("affine"), py_get_generic(InstanceNorm, affine), py_set_generic(InstanceNorm, affine), const_cast<char*>("affine"), NULL},
-    {const_cast<char*>("eps"), py_get_generic(InstanceNorm, eps), py_set_generic(InstanceNorm, eps), const_cast<char*>("eps"), NULL},
-    {const_cast<char*>("group"), py_get_generic(InstanceNorm, group), py_set_generic(InstanceNorm, group), const_cast<char*>("group"), NULL},
-    {const_cast<char*>("format"), py_get_generic(InstanceNorm, format), py_set_generic(InstanceNorm, format), const_cast<char*>("format"), NULL},
+PyGetSetDef PyOp(KVCacheAttention)::py_getsetters[] = {
+    {const_cast<char*>("scale"), py_get_generic(KVCacheAttention, scale), py_set_generic(KVCacheAttention, scale), const_cast<char*>("scale"), NULL},
     {NULL}  /* Sentinel */
 };
 
-    PyMethodDef PyOp(InstanceNorm)::tp_methods[] = {
-        {const_cast<char*>("__getstate__"), PyOp(InstanceNorm)::getstate, METH_NOARGS, "InstanceNorm getstate"},
-    {const_cast<char*>("__setstate__"), PyOp(InstanceNorm)::setstate, METH_VARARGS, "InstanceNorm setstate"},
+    PyMethodDef PyOp(KVCacheAttention)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(KVCacheAttention)::getstate, METH_NOARGS, "KVCacheAttention getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(KVCacheAttention)::setstate, METH_VARARGS, "KVCacheAttention setstate"},
         {NULL}  /* Sentinel */
     };
     
-PyObject *PyOp(InstanceNorm)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
-    if (PyOp(InstanceNorm)::py_init(self, args, kwds) < 0) {
+PyObject *PyOp(KVCacheAttention)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(KVCacheAttention)::py_init(self, args, kwds) < 0) {
         return NULL;
     }
     Py_RETURN_NONE;
 }
 
-PyMethodDef PyOp(InstanceNorm)::py_init_methoddef = {
+PyMethodDef PyOp(KVCacheAttention)::py_init_methoddef = {
     "__init__",
-    (PyCFunction)PyOp(InstanceNorm)::py_init_proxy,
+    (PyCFunction)PyOp(KVCacheAttention)::py_init_proxy,
     METH_VARARGS | METH_KEYWORDS,
-    "__init__(self, affine: bool = ..., eps: float = ..., group: int = ..., format: Union[str, Format] = ...) -> None\n"
+    "__init__(self, scale: float = ...) -> None\n"
 };
 
-void _init_py_InstanceNorm(py::module m) {
-    using py_op = PyOp(InstanceNorm);
-    auto& py_type = PyOpType(InstanceNorm);
+void _init_py_KVCacheAttention(py::module m) {
+    using py_op = PyOp(KVCacheAttention);
+    auto& py_type = PyOpType(KVCacheAttention);
     py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
-    py_type.tp_name = "megengine.core._imperative_rt.ops.InstanceNorm";
-    py_type.tp_basicsize = sizeof(PyOp(InstanceNorm));
+    py_type.tp_name = "megengine.core._imperative_rt.ops.KVCacheAttention";
+    py_type.tp_basicsize = sizeof(PyOp(KVCacheAttention));
     py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
-    py_type.tp_doc = "InstanceNorm";
+    py_type.tp_doc = "KVCacheAttention";
     py_type.tp_base = &PyOpType(OpDef);
     py_type.tp_dealloc = py_dealloc_generic<py_op>;
     py_type.tp_new = py_new_generic<py_op>;
@@ -13793,14 +14825,13 @@ void _init_py_InstanceNorm(py::module m) {
     py_type.tp_getset = py_op::py_getsetters;
 
     py_type.tp_dict = PyDict_New();
-    PyObject* descr = PyDescr_NewMethod(&PyOpType(InstanceNorm), &PyOp(InstanceNorm)::py_init_methoddef);
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(KVCacheAttention), &PyOp(KVCacheAttention)::py_init_methoddef);
     PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
     mgb_assert(PyType_Ready(&py_type) >= 0);
-        _init_py_InstanceNorm_Format(py_type);
-
+    
     PyType_Modified(&py_type);
-    m.add_object("InstanceNorm", reinterpret_cast<PyObject*>(&py_type));
-    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(InstanceNorm::typeinfo(), &py_type).second);
+    m.add_object("KVCacheAttention", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(KVCacheAttention::typeinfo(), &py_type).second);
 }
 
 PyOpDefBegin(LAMBUpdate) // {
@@ -14926,6 +15957,187 @@ void _init_py_Linspace(py::module m) {
     mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(Linspace::typeinfo(), &py_type).second);
 }
 
+PyOpDefBegin(LogitsSamplingRNG) // {
+    static PyGetSetDef py_getsetters[];
+    static PyMethodDef tp_methods[];
+    
+    static PyObject* getstate(PyObject* self, PyObject*) {
+        auto& opdef = reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst();
+        static_cast<void>(opdef);
+        std::unordered_map<std::string, py::object> state {
+            
+            {"seed", serialization<decltype(opdef.seed)>::dump(opdef.seed)},
+            {"top_k", serialization<decltype(opdef.top_k)>::dump(opdef.top_k)},
+            {"top_p", serialization<decltype(opdef.top_p)>::dump(opdef.top_p)},
+            {"temperature", serialization<decltype(opdef.temperature)>::dump(opdef.temperature)},
+            {"handle", serialization<decltype(opdef.handle)>::dump(opdef.handle)}
+        };
+        return py::cast(state).release().ptr();
+    }
+    static PyObject* setstate(PyObject* self, PyObject* args) {
+        PyObject* dict = PyTuple_GetItem(args, 0);
+        if (!dict) return NULL;
+        auto state = py::cast<std::unordered_map<std::string, py::object>>(dict);
+        auto& opdef = reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst();
+        static_cast<void>(opdef);
+        
+        {
+        auto&& iter = state.find("seed");
+        if (iter != state.end()) {
+            opdef.seed = serialization<decltype(opdef.seed)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("top_k");
+        if (iter != state.end()) {
+            opdef.top_k = serialization<decltype(opdef.top_k)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("top_p");
+        if (iter != state.end()) {
+            opdef.top_p = serialization<decltype(opdef.top_p)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("temperature");
+        if (iter != state.end()) {
+            opdef.temperature = serialization<decltype(opdef.temperature)>::load(iter->second);
+        }
+        }
+
+        {
+        auto&& iter = state.find("handle");
+        if (iter != state.end()) {
+            opdef.handle = serialization<decltype(opdef.handle)>::load(iter->second);
+        }
+        }
+        Py_RETURN_NONE;
+    }
+    static int py_init(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyObject* py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds);
+    static PyMethodDef py_init_methoddef;
+// };
+PyOpDefEnd(LogitsSamplingRNG)
+
+int PyOp(LogitsSamplingRNG)::py_init(PyObject *self, PyObject *args, PyObject *kwds) {
+    static const char* kwlist[] = {"seed", "top_k", "top_p", "temperature", "handle", "scope", NULL};
+    PyObject *seed = NULL, *top_k = NULL, *top_p = NULL, *temperature = NULL, *handle = NULL, *scope = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOO", const_cast<char**>(kwlist), &seed, &top_k, &top_p, &temperature, &handle, &scope))
+    return -1;
+
+    if (seed) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst().seed =
+                    py::cast<decltype(LogitsSamplingRNG::seed)>(py::handle(seed));
+        } CATCH_ALL(-1)
+    }
+
+    if (top_k) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst().top_k =
+                    py::cast<decltype(LogitsSamplingRNG::top_k)>(py::handle(top_k));
+        } CATCH_ALL(-1)
+    }
+
+    if (top_p) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst().top_p =
+                    py::cast<decltype(LogitsSamplingRNG::top_p)>(py::handle(top_p));
+        } CATCH_ALL(-1)
+    }
+
+    if (temperature) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst().temperature =
+                    py::cast<decltype(LogitsSamplingRNG::temperature)>(py::handle(temperature));
+        } CATCH_ALL(-1)
+    }
+
+    if (handle) {
+        try {
+            // TODO: remove this guard which is used for pybind11 implicit conversion
+            py::detail::loader_life_support guard{};
+            reinterpret_cast<PyOp(LogitsSamplingRNG)*>(self)->inst().handle =
+                    py::cast<decltype(LogitsSamplingRNG::handle)>(py::handle(handle));
+        } CATCH_ALL(-1)
+    }
+
+    if (scope) {
+        try {
+            reinterpret_cast<PyOp(OpDef)*>(self)->op
+                ->set_scope(py::cast<std::string>(py::handle(scope)));
+        } CATCH_ALL(-1)
+    }
+
+    return 0;
+}
+
+PyGetSetDef PyOp(LogitsSamplingRNG)::py_getsetters[] = {
+    {const_cast<char*>("seed"), py_get_generic(LogitsSamplingRNG, seed), py_set_generic(LogitsSamplingRNG, seed), const_cast<char*>("seed"), NULL},
+    {const_cast<char*>("top_k"), py_get_generic(LogitsSamplingRNG, top_k), py_set_generic(LogitsSamplingRNG, top_k), const_cast<char*>("top_k"), NULL},
+    {const_cast<char*>("top_p"), py_get_generic(LogitsSamplingRNG, top_p), py_set_generic(LogitsSamplingRNG, top_p), const_cast<char*>("top_p"), NULL},
+    {const_cast<char*>("temperature"), py_get_generic(LogitsSamplingRNG, temperature), py_set_generic(LogitsSamplingRNG, temperature), const_cast<char*>("temperature"), NULL},
+    {const_cast<char*>("handle"), py_get_generic(LogitsSamplingRNG, handle), py_set_generic(LogitsSamplingRNG, handle), const_cast<char*>("handle"), NULL},
+    {NULL}  /* Sentinel */
+};
+
+    PyMethodDef PyOp(LogitsSamplingRNG)::tp_methods[] = {
+        {const_cast<char*>("__getstate__"), PyOp(LogitsSamplingRNG)::getstate, METH_NOARGS, "LogitsSamplingRNG getstate"},
+    {const_cast<char*>("__setstate__"), PyOp(LogitsSamplingRNG)::setstate, METH_VARARGS, "LogitsSamplingRNG setstate"},
+        {NULL}  /* Sentinel */
+    };
+    
+PyObject *PyOp(LogitsSamplingRNG)::py_init_proxy(PyObject *self, PyObject *args, PyObject *kwds) {
+    if (PyOp(LogitsSamplingRNG)::py_init(self, args, kwds) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef PyOp(LogitsSamplingRNG)::py_init_methoddef = {
+    "__init__",
+    (PyCFunction)PyOp(LogitsSamplingRNG)::py_init_proxy,
+    METH_VARARGS | METH_KEYWORDS,
+    "__init__(self, seed: int = ..., top_k: int = ..., top_p: float = ..., temperature: float = ..., handle: int = ...) -> None\n"
+};
+
+void _init_py_LogitsSamplingRNG(py::module m) {
+    using py_op = PyOp(LogitsSamplingRNG);
+    auto& py_type = PyOpType(LogitsSamplingRNG);
+    py_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+    py_type.tp_name = "megengine.core._imperative_rt.ops.LogitsSamplingRNG";
+    py_type.tp_basicsize = sizeof(PyOp(LogitsSamplingRNG));
+    py_type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    py_type.tp_doc = "LogitsSamplingRNG";
+    py_type.tp_base = &PyOpType(OpDef);
+    py_type.tp_dealloc = py_dealloc_generic<py_op>;
+    py_type.tp_new = py_new_generic<py_op>;
+    py_type.tp_init = py_op::py_init;
+    py_type.tp_methods = py_op::tp_methods;
+    py_type.tp_getset = py_op::py_getsetters;
+
+    py_type.tp_dict = PyDict_New();
+    PyObject* descr = PyDescr_NewMethod(&PyOpType(LogitsSamplingRNG), &PyOp(LogitsSamplingRNG)::py_init_methoddef);
+    PyDict_SetItemString(py_type.tp_dict, "__init__", descr);
+    mgb_assert(PyType_Ready(&py_type) >= 0);
+    
+    PyType_Modified(&py_type);
+    m.add_object("LogitsSamplingRNG", reinterpret_cast<PyObject*>(&py_type));
+    mgb_assert(PyOp(OpDef)::ctype2pytype.emplace(LogitsSamplingRNG::typeinfo(), &py_type).second);
+}
+
 PyOpDefBegin(MagicMindRuntime) // {
     static PyGetSetDef py_getsetters[];
     static PyMethodDef tp_methods[];
@@ -24538,6 +25750,8 @@ void _init_py_WhereBackward(py::module m) {
     _init_py_Dropout(m); \
     _init_py_Elemwise(m); \
     _init_py_ElemwiseMultiType(m); \
+    _init_py_EmbeddingBag(m); \
+    _init_py_EmbeddingBagBackward(m); \
     _init_py_ExponentialRNG(m); \
     _init_py_ExternOpr(m); \
     _init_py_Eye(m); \
@@ -24546,6 +25760,7 @@ void _init_py_WhereBackward(py::module m) {
     _init_py_Fill(m); \
     _init_py_FillLike(m); \
     _init_py_Flip(m); \
+    _init_py_FusedOptimizerUpdate(m); \
     _init_py_GammaRNG(m); \
     _init_py_GaussianBlur(m); \
     _init_py_GaussianRNG(m); \
@@ -24564,6 +25779,8 @@ void _init_py_WhereBackward(py::module m) {
     _init_py_IndexingSetOneHot(m); \
     _init_py_InplaceAdd(m); \
     _init_py_InstanceNorm(m); \
+    _init_py_KVCacheAppend(m); \
+    _init_py_KVCacheAttention(m); \
     _init_py_LAMBUpdate(m); \
     _init_py_LRN(m); \
     _init_py_LSQ(m); \
@@ -24571,6 +25788,7 @@ void _init_py_WhereBackward(py::module m) {
     _init_py_LSTMCell(m); \
     _init_py_LayerNorm(m); \
     _init_py_Linspace(m); \
+    _init_py_LogitsSamplingRNG(m); \
     _init_py_MagicMindRuntime(m); \
     _init_py_MaskedFill(m); \
     _init_py_MatrixInverse(m); \
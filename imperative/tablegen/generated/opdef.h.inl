@@ -914,6 +914,34 @@ case ElemwiseMultiType::Mode::ISINF: return "ISINF";
         }
     }
 };
+class EmbeddingBag : public OpDefImplBase<EmbeddingBag> {
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+
+public:
+    using Mode = ::megdnn::param::EmbeddingBag::Mode;
+    Mode mode = ::megdnn::param::EmbeddingBag::Mode::SUM;
+    EmbeddingBag() = default;
+    EmbeddingBag(Mode mode_, std::string scope_ = {}): mode(mode_) { set_scope(scope_); }
+    EmbeddingBag(::megdnn::param::EmbeddingBag packed_param_0): mode(packed_param_0.mode) {}
+    ::megdnn::param::EmbeddingBag param() const {
+        return {mode};
+    }
+};
+
+class EmbeddingBagBackward : public OpDefImplBase<EmbeddingBagBackward> {
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+
+public:
+    using Mode = ::megdnn::param::EmbeddingBag::Mode;
+    Mode mode = ::megdnn::param::EmbeddingBag::Mode::SUM;
+    EmbeddingBagBackward() = default;
+    EmbeddingBagBackward(Mode mode_, std::string scope_ = {}): mode(mode_) { set_scope(scope_); }
+    EmbeddingBagBackward(::megdnn::param::EmbeddingBag packed_param_0): mode(packed_param_0.mode) {}
+    ::megdnn::param::EmbeddingBag param() const {
+        return {mode};
+    }
+};
+
 class ExponentialRNG : public OpDefImplBase<ExponentialRNG> {
     MGB_DYN_TYPE_OBJ_FINAL_DECL;
 
@@ -1016,6 +1044,30 @@ public:
     }
 };
 
+class FusedOptimizerUpdate : public OpDefImplBase<FusedOptimizerUpdate> {
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+
+public:
+    using Mode = ::megdnn::param::FusedOptimizerUpdate::Mode;
+    Mode mode = ::megdnn::param::FusedOptimizerUpdate::Mode::SGD;
+    float lr = 1.f;
+    float weight_decay = 0.f;
+    float momentum = 0.f;
+    bool nesterov = false;
+    float beta_1 = 0.9f;
+    float beta_2 = 0.999f;
+    float eps = 1e-8f;
+    float step = 1.f;
+    bool bias_correction = true;
+    bool always_adapt = false;
+    FusedOptimizerUpdate() = default;
+    FusedOptimizerUpdate(Mode mode_, float lr_, float weight_decay_, float momentum_, bool nesterov_, float beta_1_, float beta_2_, float eps_, float step_, bool bias_correction_, bool always_adapt_, std::string scope_ = {}): mode(mode_), lr(lr_), weight_decay(weight_decay_), momentum(momentum_), nesterov(nesterov_), beta_1(beta_1_), beta_2(beta_2_), eps(eps_), step(step_), bias_correction(bias_correction_), always_adapt(always_adapt_) { set_scope(scope_); }
+    FusedOptimizerUpdate(::megdnn::param::FusedOptimizerUpdate packed_param_0): mode(packed_param_0.mode), lr(packed_param_0.lr), weight_decay(packed_param_0.weight_decay), momentum(packed_param_0.momentum), nesterov(packed_param_0.nesterov), beta_1(packed_param_0.beta_1), beta_2(packed_param_0.beta_2), eps(packed_param_0.eps), step(packed_param_0.step), bias_correction(packed_param_0.bias_correction), always_adapt(packed_param_0.always_adapt) {}
+    ::megdnn::param::FusedOptimizerUpdate param() const {
+        return {mode, lr, weight_decay, momentum, nesterov, beta_1, beta_2, eps, step, bias_correction, always_adapt};
+    }
+};
+
 class GammaRNG : public OpDefImplBase<GammaRNG> {
     MGB_DYN_TYPE_OBJ_FINAL_DECL;
 
@@ -1065,15 +1117,17 @@ class GeneralNorm : public OpDefImplBase<GeneralNorm> {
     MGB_DYN_TYPE_OBJ_FINAL_DECL;
 
 public:
+    using Mode = ::megdnn::param::GeneralNorm::Mode;
     bool affine = true;
     float eps = 1e-5f;
     uint64_t axis_start = 0;
     uint64_t axis_end = 0;
+    Mode mode = ::megdnn::param::GeneralNorm::Mode::LAYER_NORM;
     GeneralNorm() = default;
-    GeneralNorm(bool affine_, float eps_, uint64_t axis_start_, uint64_t axis_end_, std::string scope_ = {}): affine(affine_), eps(eps_), axis_start(axis_start_), axis_end(axis_end_) { set_scope(scope_); }
-    GeneralNorm(::megdnn::param::GeneralNorm packed_param_0): affine(packed_param_0.affine), eps(packed_param_0.eps), axis_start(packed_param_0.axis_start), axis_end(packed_param_0.axis_end) {}
+    GeneralNorm(bool affine_, float eps_, uint64_t axis_start_, uint64_t axis_end_, Mode mode_, std::string scope_ = {}): affine(affine_), eps(eps_), axis_start(axis_start_), axis_end(axis_end_), mode(mode_) { set_scope(scope_); }
+    GeneralNorm(::megdnn::param::GeneralNorm packed_param_0): affine(packed_param_0.affine), eps(packed_param_0.eps), axis_start(packed_param_0.axis_start), axis_end(packed_param_0.axis_end), mode(packed_param_0.mode) {}
     ::megdnn::param::GeneralNorm param() const {
-        return {affine, eps, axis_start, axis_end};
+        return {affine, eps, axis_start, axis_end, mode};
     }
 };
 
@@ -1261,6 +1315,34 @@ public:
     }
 };
 
+class KVCacheAppend : public OpDefImplBase<KVCacheAppend> {
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+
+public:
+    uint32_t num_heads = 1;
+    uint32_t rotary_dim = 0;
+    float rotary_base = 10000.f;
+    KVCacheAppend() = default;
+    KVCacheAppend(uint32_t num_heads_, uint32_t rotary_dim_, float rotary_base_, std::string scope_ = {}): num_heads(num_heads_), rotary_dim(rotary_dim_), rotary_base(rotary_base_) { set_scope(scope_); }
+    KVCacheAppend(::megdnn::param::KVCacheAppend packed_param_0): num_heads(packed_param_0.num_heads), rotary_dim(packed_param_0.rotary_dim), rotary_base(packed_param_0.rotary_base) {}
+    ::megdnn::param::KVCacheAppend param() const {
+        return {num_heads, rotary_dim, rotary_base};
+    }
+};
+
+class KVCacheAttention : public OpDefImplBase<KVCacheAttention> {
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+
+public:
+    float scale = 0.f;
+    KVCacheAttention() = default;
+    KVCacheAttention(float scale_, std::string scope_ = {}): scale(scale_) { set_scope(scope_); }
+    KVCacheAttention(::megdnn::param::KVCacheAttention packed_param_0): scale(packed_param_0.scale) {}
+    ::megdnn::param::KVCacheAttention param() const {
+        return {scale};
+    }
+};
+
 class LAMBUpdate : public OpDefImplBase<LAMBUpdate> {
     MGB_DYN_TYPE_OBJ_FINAL_DECL;
 
@@ -1372,6 +1454,23 @@ public:
     }
 };
 
+class LogitsSamplingRNG : public OpDefImplBase<LogitsSamplingRNG> {
+    MGB_DYN_TYPE_OBJ_FINAL_DECL;
+
+public:
+    uint64_t seed = 0;
+    uint32_t top_k = 0;
+    float top_p = 1.f;
+    float temperature = 1.f;
+    size_t handle;
+    LogitsSamplingRNG() = default;
+    LogitsSamplingRNG(uint64_t seed_, uint32_t top_k_, float top_p_, float temperature_, size_t handle_, std::string scope_ = {}): seed(seed_), top_k(top_k_), top_p(top_p_), temperature(temperature_), handle(handle_) { set_scope(scope_); }
+    LogitsSamplingRNG(::megdnn::param::LogitsSamplingRNG packed_param_0, size_t handle_): seed(packed_param_0.seed), top_k(packed_param_0.top_k), top_p(packed_param_0.top_p), temperature(packed_param_0.temperature), handle(handle_) {}
+    ::megdnn::param::LogitsSamplingRNG param() const {
+        return {seed, top_k, top_p, temperature};
+    }
+};
+
 class MagicMindRuntime : public OpDefImplBase<MagicMindRuntime> {
     MGB_DYN_TYPE_OBJ_FINAL_DECL;
 
@@ -1165,6 +1165,33 @@ ElemwiseMultiTypeInst
     .def_readwrite("mode", &ElemwiseMultiType::mode)
     .def_readwrite("dtype", &ElemwiseMultiType::dtype);
 
+py::class_<EmbeddingBag, std::shared_ptr<EmbeddingBag>, OpDef> EmbeddingBagInst(m, "EmbeddingBag");
+
+py::enum_<EmbeddingBag::Mode>(EmbeddingBagInst, "Mode")
+    .value("SUM", EmbeddingBag::Mode::SUM)
+    .value("MEAN", EmbeddingBag::Mode::MEAN)
+    .value("MAX", EmbeddingBag::Mode::MAX)
+    .def(py::init([](const std::string& in) {
+        auto&& str = normalize_enum(in);
+        if (str == "SUM") return EmbeddingBag::Mode::SUM;
+        if (str == "MEAN") return EmbeddingBag::Mode::MEAN;
+        if (str == "MAX") return EmbeddingBag::Mode::MAX;
+        throw py::cast_error("invalid enum value " + in);
+    }));
+py::implicitly_convertible<std::string, EmbeddingBag::Mode>();
+
+EmbeddingBagInst
+    .def(py::init<::megdnn::param::EmbeddingBag::Mode, std::string>(), py::arg("mode") = ::megdnn::param::EmbeddingBag::Mode::SUM, py::arg("scope") = {})
+    .def_readwrite("mode", &EmbeddingBag::mode);
+
+py::class_<EmbeddingBagBackward, std::shared_ptr<EmbeddingBagBackward>, OpDef> EmbeddingBagBackwardInst(m, "EmbeddingBagBackward");
+
+EmbeddingBagBackwardInst.attr("Mode") = EmbeddingBagInst.attr("Mode");
+
+EmbeddingBagBackwardInst
+    .def(py::init<::megdnn::param::EmbeddingBag::Mode, std::string>(), py::arg("mode") = ::megdnn::param::EmbeddingBag::Mode::SUM, py::arg("scope") = {})
+    .def_readwrite("mode", &EmbeddingBagBackward::mode);
+
 py::class_<ExponentialRNG, std::shared_ptr<ExponentialRNG>, OpDef> ExponentialRNGInst(m, "ExponentialRNG");
 
 ExponentialRNGInst
@@ -1229,6 +1256,37 @@ FlipInst
     .def_readwrite("vertical", &Flip::vertical)
     .def_readwrite("horizontal", &Flip::horizontal);
 
+py::class_<FusedOptimizerUpdate, std::shared_ptr<FusedOptimizerUpdate>, OpDef> FusedOptimizerUpdateInst(m, "FusedOptimizerUpdate");
+
+py::enum_<FusedOptimizerUpdate::Mode>(FusedOptimizerUpdateInst, "Mode")
+    .value("SGD", FusedOptimizerUpdate::Mode::SGD)
+    .value("ADAM", FusedOptimizerUpdate::Mode::ADAM)
+    .value("ADAMW", FusedOptimizerUpdate::Mode::ADAMW)
+    .value("LAMB", FusedOptimizerUpdate::Mode::LAMB)
+    .def(py::init([](const std::string& in) {
+        auto&& str = normalize_enum(in);
+        if (str == "SGD") return FusedOptimizerUpdate::Mode::SGD;
+        if (str == "ADAM") return FusedOptimizerUpdate::Mode::ADAM;
+        if (str == "ADAMW") return FusedOptimizerUpdate::Mode::ADAMW;
+        if (str == "LAMB") return FusedOptimizerUpdate::Mode::LAMB;
+        throw py::cast_error("invalid enum value " + in);
+    }));
+py::implicitly_convertible<std::string, FusedOptimizerUpdate::Mode>();
+
+FusedOptimizerUpdateInst
+    .def(py::init<::megdnn::param::FusedOptimizerUpdate::Mode, float, float, float, bool, float, float, float, float, bool, bool, std::string>(), py::arg("mode") = ::megdnn::param::FusedOptimizerUpdate::Mode::SGD, py::arg("lr") = 1.f, py::arg("weight_decay") = 0.f, py::arg("momentum") = 0.f, py::arg("nesterov") = false, py::arg("beta_1") = 0.9f, py::arg("beta_2") = 0.999f, py::arg("eps") = 1e-8f, py::arg("step") = 1.f, py::arg("bias_correction") = true, py::arg("always_adapt") = false, py::arg("scope") = {})
+    .def_readwrite("mode", &FusedOptimizerUpdate::mode)
+    .def_readwrite("lr", &FusedOptimizerUpdate::lr)
+    .def_readwrite("weight_decay", &FusedOptimizerUpdate::weight_decay)
+    .def_readwrite("momentum", &FusedOptimizerUpdate::momentum)
+    .def_readwrite("nesterov", &FusedOptimizerUpdate::nesterov)
+    .def_readwrite("beta_1", &FusedOptimizerUpdate::beta_1)
+    .def_readwrite("beta_2", &FusedOptimizerUpdate::beta_2)
+    .def_readwrite("eps", &FusedOptimizerUpdate::eps)
+    .def_readwrite("step", &FusedOptimizerUpdate::step)
+    .def_readwrite("bias_correction", &FusedOptimizerUpdate::bias_correction)
+    .def_readwrite("always_adapt", &FusedOptimizerUpdate::always_adapt);
+
 py::class_<GammaRNG, std::shared_ptr<GammaRNG>, OpDef> GammaRNGInst(m, "GammaRNG");
 
 GammaRNGInst
@@ -1281,12 +1339,24 @@ GaussianRNGInst
 
 py::class_<GeneralNorm, std::shared_ptr<GeneralNorm>, OpDef> GeneralNormInst(m, "GeneralNorm");
 
+py::enum_<GeneralNorm::Mode>(GeneralNormInst, "Mode")
+    .value("LAYER_NORM", GeneralNorm::Mode::LAYER_NORM)
+    .value("RMS_NORM", GeneralNorm::Mode::RMS_NORM)
+    .def(py::init([](const std::string& in) {
+        auto&& str = normalize_enum(in);
+        if (str == "LAYER_NORM") return GeneralNorm::Mode::LAYER_NORM;
+        if (str == "RMS_NORM") return GeneralNorm::Mode::RMS_NORM;
+        throw py::cast_error("invalid enum value " + in);
+    }));
+py::implicitly_convertible<std::string, GeneralNorm::Mode>();
+
 GeneralNormInst
-    .def(py::init<bool, float, uint64_t, uint64_t, std::string>(), py::arg("affine") = true, py::arg("eps") = 1e-5f, py::arg("axis_start") = 0, py::arg("axis_end") = 0, py::arg("scope") = {})
+    .def(py::init<bool, float, uint64_t, uint64_t, ::megdnn::param::GeneralNorm::Mode, std::string>(), py::arg("affine") = true, py::arg("eps") = 1e-5f, py::arg("axis_start") = 0, py::arg("axis_end") = 0, py::arg("mode") = ::megdnn::param::GeneralNorm::Mode::LAYER_NORM, py::arg("scope") = {})
     .def_readwrite("affine", &GeneralNorm::affine)
     .def_readwrite("eps", &GeneralNorm::eps)
     .def_readwrite("axis_start", &GeneralNorm::axis_start)
-    .def_readwrite("axis_end", &GeneralNorm::axis_end);
+    .def_readwrite("axis_end", &GeneralNorm::axis_end)
+    .def_readwrite("mode", &GeneralNorm::mode);
 
 py::class_<GetVarShape, std::shared_ptr<GetVarShape>, OpDef> GetVarShapeInst(m, "GetVarShape");
 
@@ -1413,6 +1483,20 @@ InstanceNormInst
     .def_readwrite("group", &InstanceNorm::group)
     .def_readwrite("format", &InstanceNorm::format);
 
+py::class_<KVCacheAppend, std::shared_ptr<KVCacheAppend>, OpDef> KVCacheAppendInst(m, "KVCacheAppend");
+
+KVCacheAppendInst
+    .def(py::init<uint32_t, uint32_t, float, std::string>(), py::arg("num_heads") = 1, py::arg("rotary_dim") = 0, py::arg("rotary_base") = 10000.f, py::arg("scope") = {})
+    .def_readwrite("num_heads", &KVCacheAppend::num_heads)
+    .def_readwrite("rotary_dim", &KVCacheAppend::rotary_dim)
+    .def_readwrite("rotary_base", &KVCacheAppend::rotary_base);
+
+py::class_<KVCacheAttention, std::shared_ptr<KVCacheAttention>, OpDef> KVCacheAttentionInst(m, "KVCacheAttention");
+
+KVCacheAttentionInst
+    .def(py::init<float, std::string>(), py::arg("scale") = 0.f, py::arg("scope") = {})
+    .def_readwrite("scale", &KVCacheAttention::scale);
+
 py::class_<LAMBUpdate, std::shared_ptr<LAMBUpdate>, OpDef> LAMBUpdateInst(m, "LAMBUpdate");
 
 LAMBUpdateInst
@@ -1478,6 +1562,17 @@ LinspaceInst
     .def_readwrite("endpoint", &Linspace::endpoint)
     .def_readwrite("comp_node", &Linspace::comp_node);
 
+py::class_<LogitsSamplingRNG, std::shared_ptr<LogitsSamplingRNG>, OpDef> LogitsSamplingRNGInst(m, "LogitsSamplingRNG");
+
+LogitsSamplingRNGInst
+    .def(py::init<uint64_t, uint32_t, float, float, size_t, std::string>(), py::arg("seed") = 0, py::arg("top_k") = 0, py::arg("top_p") = 1.f, py::arg("temperature") = 1.f, py::arg("handle"), py::arg("scope") = {})
+    .def(py::init<>())
+    .def_readwrite("seed", &LogitsSamplingRNG::seed)
+    .def_readwrite("top_k", &LogitsSamplingRNG::top_k)
+    .def_readwrite("top_p", &LogitsSamplingRNG::top_p)
+    .def_readwrite("temperature", &LogitsSamplingRNG::temperature)
+    .def_readwrite("handle", &LogitsSamplingRNG::handle);
+
 py::class_<MagicMindRuntime, std::shared_ptr<MagicMindRuntime>, OpDef> MagicMindRuntimeInst(m, "MagicMindRuntime");
 
 MagicMindRuntimeInst
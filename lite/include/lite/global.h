@@ -168,6 +168,16 @@ LITE_API void set_loader_lib_path(const std::string& loader_path);
 LITE_API void set_persistent_cache(
         const std::string& cache_path, bool always_sync = false);
 
+/**
+ * @brief Set the algo policy cache file which can be shared by multiple processes;
+ * the cache produced by fast-run is appended to the file immediately and the cache
+ * appended by other processes is read when needed
+ *
+ * @param cache_path  the file path which store the cache, it is not compatible with
+ * the file of set_persistent_cache
+ */
+LITE_API void set_shared_persistent_cache(const std::string& cache_path);
+
 /**
  * @brief dump the PersistentCache policy cache to the specific file, if the network is
  * set to profile when forward, though this the algo policy will dump to file
@@ -188,6 +198,27 @@ LITE_API void set_tensor_rt_cache(std::string tensorrt_cache_path);
  */
 LITE_API void dump_tensor_rt_cache();
 
+/**
+ * @brief set the directory where the artifacts of the costly one-time optimizations
+ * are kept for this device, they are loaded transparently when available
+ *
+ * The artifacts are kept in a sub directory named by the fingerprint of the device,
+ * which covers the megengine version, the CPU model and the CUDA devices, so a
+ * directory can be shared by different devices. The algo policy cache is set with
+ * set_shared_persistent_cache, the TensorRT engine cache is set with
+ * set_tensor_rt_cache when TensorRT is enabled, and the models optimized by global
+ * layout transform are dumped when they are loaded for the first time.
+ *
+ * @param dir  the directory to keep the artifacts, it is created if not exist
+ */
+LITE_API void set_artifact_dir(const std::string& dir);
+
+/**
+ * @brief get the fingerprint sub directory of set_artifact_dir, where other
+ * artifacts of this device can be kept, empty if it is not set
+ */
+LITE_API std::string get_artifact_dir();
+
 /**
  * @brief register the physical and virtual address pair to the mge, some device
  * need the map from physical to virtual
@@ -4,10 +4,12 @@
 #include "tensor.h"
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace lite {
 
@@ -24,6 +26,11 @@ LITE_API inline LiteAlgoSelectStrategy operator|(
  * @param weight_preprocess is the option which optimize the inference performance
  * with processing the weights of the network ahead
  *
+ * @param share_preprocessed_weight share the weights processed by weight_preprocess
+ * between networks in this process, networks loaded from the same model (or sharing
+ * weights with shared_weight_with_network) keep only one copy of them, only works
+ * on cpu
+ *
  * @param fuse_preprocess fuse preprocess patten, like astype + pad_channel +
  * dimshuffle
  *
@@ -73,9 +80,14 @@ LITE_API inline LiteAlgoSelectStrategy operator|(
  * 1: dispatch async if there are more than one comp node with limited queue
  * mask 0b10: async if there are multiple comp nodes with
  * mask 0b100: always async
+ *
+ * @param nr_compute_stream number of the streams the independent branches of
+ * the network are spread over on the device with multiple streams like CUDA,
+ * 1 means all the computing is on one stream
  */
 struct LITE_API Options {
     bool weight_preprocess = false;
+    bool share_preprocessed_weight = false;
     bool fuse_preprocess = false;
     bool fake_next_exec = false;
     bool var_sanity_check_first_run = true;
@@ -88,6 +100,7 @@ struct LITE_API Options {
     uint8_t comp_node_seq_record_level = 0;
     uint8_t graph_opt_level = 2;
     uint16_t async_exec_level = 1;
+    uint8_t nr_compute_stream = 1;
 
     //! layout transform options
     bool enable_nchw44 = false;
@@ -121,6 +134,13 @@ struct LITE_API Options {
  *
  * @param discrete_input_name configure which input is composed of discrete
  * multiple tensors
+ *
+ * @param mem_soft_limit soft limit in bytes of the device memory reserved by the
+ * network device, cached free memory is released when it is crossed, 0 means no limit
+ *
+ * @param mem_hard_limit hard limit in bytes of the device memory reserved by the
+ * network device, allocations beyond it fail, 0 means no limit. Both limits are
+ * shared by the networks on the same device, and only take effect on CUDA and ROCm
  */
 struct LITE_API Config {
     bool has_compression = false;
@@ -131,6 +151,8 @@ struct LITE_API Config {
     Options options = {};
     bool auto_optimize_inference = false;
     std::string discrete_input_name = {};
+    size_t mem_soft_limit = 0;
+    size_t mem_hard_limit = 0;
 };
 
 /*!
@@ -195,6 +217,25 @@ struct LITE_API NetworkIO {
     std::vector<IO> outputs = {};
 };
 
+/**
+ * @brief the summary of a model that can be read without loading the model, see
+ * Runtime::get_model_info
+ *
+ * @param io the input and output tensors, the shapes of the outputs are empty if
+ * they are unknown when the model is dumped
+ * @param nr_operators the number of operators in the model
+ * @param flops the computation of the operators whose shapes are known when the
+ * model is dumped
+ * @param operator_types the names of the operator types used in ascending order,
+ * which can be checked against the operators supported by the runtime
+ */
+struct LITE_API ModelInfo {
+    NetworkIO io;
+    size_t nr_operators = 0;
+    uint64_t flops = 0;
+    std::vector<std::string> operator_types;
+};
+
 /**
  * @brief A user-implemented allocator interface, user can register an allocator
  * to the megengine, then all the runtime memory will allocate by this allocator
@@ -230,6 +271,50 @@ public:
  */
 using ThreadAffinityCallback = std::function<void(int thread_id)>;
 
+/**
+ * @brief statistics of the idle cpu worker threads in hybrid wait mode
+ *
+ * @param nr_wakeup number of times that a sleeping worker is woken up
+ * @param wakeup_latency_us total wakeup latency in microseconds
+ * @param spin_time_us total time in microseconds that idle workers spin
+ */
+struct LITE_API ThreadWaitStats {
+    size_t nr_wakeup = 0;
+    double wakeup_latency_us = 0;
+    double spin_time_us = 0;
+};
+
+/**
+ * @brief a device that the operators of a network can be placed on
+ *
+ * @param device_type the type of the device
+ * @param device_id the id of the device
+ * @param flops_per_usec the computing throughput of the device, which is used to
+ * estimate the latency of the operators
+ * @param unsupported_oprs the type names of the operators that should not run on
+ * the device, such as those without fast kernels on it
+ */
+struct LITE_API PartitionDevice {
+    LiteDeviceType device_type = LiteDeviceType::LITE_CPU;
+    int device_id = 0;
+    float flops_per_usec = 1e3f;
+    std::vector<std::string> unsupported_oprs;
+};
+
+/**
+ * @brief the config to partition a network across devices
+ *
+ * @param devices the devices to place the operators on, the device of the
+ * network should be included if its operators can be kept on it
+ * @param copy_bytes_per_usec the bandwidth of the copies between the devices
+ * @param copy_latency_usec the fixed latency of a copy between the devices
+ */
+struct LITE_API PartitionConfig {
+    std::vector<PartitionDevice> devices;
+    float copy_bytes_per_usec = 1e3f;
+    float copy_latency_usec = 10.f;
+};
+
 /**
  * @brief the network async callback function type
  */
@@ -360,6 +445,19 @@ public:
     //! enable profile the network, a file will be generated to the given path
     void enable_profile_performance(std::string profile_file_path);
 
+    /** @brief enable the sampling profiler, which only profiles one in every
+     * period forwards and aggregates the device time of the operators into
+     * histograms, so that it can be kept on in production
+     *
+     * @param period profile one in every period forwards
+     * @param opr_ratio the ratio of the operators profiled in a sampled forward
+     */
+    void enable_sampling_profile(size_t period = 100, float opr_ratio = 1.f);
+
+    //! get the histograms of the sampling profiler in the text format of
+    //! Prometheus, it can be called while the network is forwarding
+    std::string get_sampling_profile() const;
+
     //! get model extra info, the extra information is packed into model by user
     const std::string& get_model_extra_info();
 
@@ -369,6 +467,27 @@ public:
     //! get static peak memory info showed by Graph visualization
     void get_static_memory_alloc_info(const std::string& log_dir = "logs/test") const;
 
+    /** @brief dump the warm runtime state of the loaded network to a file
+     *
+     * The state includes the algo policy cache, which is only available when
+     * set_persistent_cache is called or the cache is packed in the model, and
+     * the graph after global layout transform. Loading it with
+     * load_runtime_state in a new process skips the profiling, so the network
+     * runs at full speed from the first forward. The memory plan is derived
+     * from the graph, so it is not stored.
+     *
+     * @param path the file to write the state to
+     */
+    void dump_runtime_state(const std::string& path) const;
+
+    /** @brief load the runtime state dumped by dump_runtime_state, it should
+     * be called before the model is loaded, and the model must be the same as
+     * the one the state is dumped from
+     *
+     * @param path the file to read the state from
+     */
+    void load_runtime_state(const std::string& path);
+
     /** @brief the extra configuration
      *
      * @param extra_config the extra configuration to set into the network
@@ -414,6 +533,17 @@ public:
     static size_t get_cpu_threads_number(std::shared_ptr<Network> dst_network);
     //@}
 
+    /** @brief bind the network to a NUMA node when device is CPU
+     *
+     * The worker threads are pinned to the cpus of the node and the runtime
+     * memory is allocated on it. Together with set_cpu_threads_number, a
+     * process can run one network replica per socket.
+     *
+     * @param dst_network the target network to bind
+     * @param numa_node the NUMA node id
+     */
+    static void set_cpu_numa_node(std::shared_ptr<Network> dst_network, int numa_node);
+
     /** @brief set threads affinity callback
      *
      * @param dst_network the target network to set the thread affinity callback
@@ -424,6 +554,64 @@ public:
             std::shared_ptr<Network> network,
             const ThreadAffinityCallback& thread_affinity_callback);
 
+    /** @brief create an execution context of a loaded network
+     *
+     * The returned network shares the weights, the configuration and the
+     * algorithm choices of src_network, but owns its own runtime memory, IO
+     * tensors and stream (worker thread on CPU). So several threads can
+     * forward the contexts of one model concurrently without loading it
+     * again.
+     *
+     * @param src_network the loaded network to create the context from
+     */
+    static std::shared_ptr<Network> create_execution_context(
+            std::shared_ptr<Network> src_network);
+
+    /** @brief set the spin budget of the idle cpu worker threads
+     *
+     * An idle worker spins for at most spin_us microseconds before sleeping,
+     * which trades CPU occupation for wakeup latency; a negative value restores
+     * the default behavior.
+     *
+     * @param dst_network the target network, which should be loaded and run
+     * in multi thread mode
+     * @param spin_us the spin budget in microseconds
+     */
+    static void set_cpu_thread_spin_budget(
+            std::shared_ptr<Network> dst_network, int64_t spin_us);
+
+    /** @brief get the wait statistics of the cpu worker threads, only
+     * collected when the spin budget is set
+     *
+     * @param dst_network the target network
+     * @param reset whether to reset the statistics after reading
+     */
+    static ThreadWaitStats get_cpu_thread_wait_stats(
+            std::shared_ptr<Network> dst_network, bool reset = false);
+
+    /** @brief weight the sub tasks of the cpu threads by their measured speed
+     *
+     * The speed of each thread is measured while running and the sub tasks of
+     * the next runs are split accordingly, so the threads bound to the big
+     * cores of a big.LITTLE cpu get more work than those on the little cores,
+     * and the work moves off the cores which are throttled at runtime.
+     *
+     * @param dst_network the target network, which should be loaded and run
+     * in multi thread mode
+     * @param enable whether to enable the speed weighted schedule, otherwise
+     * the sub tasks are split evenly
+     */
+    static void set_cpu_thread_speed_weighted(
+            std::shared_ptr<Network> dst_network, bool enable);
+
+    /** @brief get the relative speeds of the cpu threads measured in speed
+     * weighted schedule, whose mean is 1; the last one is the main thread
+     *
+     * @param dst_network the target network
+     */
+    static std::vector<float> get_cpu_thread_speeds(
+            std::shared_ptr<Network> dst_network);
+
     /** @brief Set cpu default mode when device is CPU, in some low computation
      * device or single core device, this mode will get good performace
      *
@@ -521,6 +709,57 @@ public:
             std::shared_ptr<Network> dst_network,
             const std::shared_ptr<Network> src_network);
 
+    /** @brief update the weights of a loaded network from a model with the same
+     * topology, the weights are copied into their memory in place, so the
+     * compiled graph, the runtime memory and the fastrun results are all kept,
+     * and the networks sharing weights with it see the new weights
+     *
+     * To switch to a model with a different topology, load it into a new network
+     * in the background, which can reuse the runtime memory of the old network
+     * by share_runtime_memory_with once the old network stops running.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     *
+     *  .. warning::
+     *
+     *     the network should not be running when the weights are updated, and
+     *     it is not supported when the weights are transformed when the network
+     *     is loaded, such as by weight_preprocess or layout transform. On CPU the
+     *     weights may be read directly from the model memory given to
+     *     load_model, which is then overwritten.
+     *
+     * \endverbatim
+     *
+     * @param network the network which loads the model
+     * @param model_path the path of the new model
+     */
+    static void update_weights(
+            std::shared_ptr<Network> network, const std::string& model_path);
+
+    /** @brief update the weights of a loaded network from a model in memory
+     *
+     * @param network the network which loads the model
+     * @param model_mem the memory of the new model, which is only read in this
+     * call
+     * @param size the size of the model memory
+     */
+    static void update_weights(
+            std::shared_ptr<Network> network, const void* model_mem, size_t size);
+
+    /** @brief partition the network across devices, each operator is placed on
+     * the device that supports it with the least estimated latency, including
+     * the latency of copying its inputs from other devices
+     *
+     * The copies between the devices are inserted into the graph and run
+     * asynchronously, so the computing of the devices overlaps. The inputs and
+     * the outputs of the network are kept on the device of the network.
+     *
+     * @param network the network to partition, which should not be loaded
+     * @param config the devices and the cost of the copies
+     */
+    static void enable_heterogeneous_partition(
+            std::shared_ptr<Network> network, const PartitionConfig& config);
+
     /** @brief set global layout transform optimization for network, global
      * layout optimization can auto determine the layout of every operator in
      * the network by profile, thus it can improve the performance of the
@@ -554,6 +793,454 @@ public:
      */
     static NetworkIO get_model_io_info(
             const void* model_mem, size_t size, const Config& config = {});
+
+    /** @brief get the model summary embedded in the model without loading it,
+     * which only reads a small part of the model file
+     *
+     * @param model_path the model path to get the model summary
+     * @param config the model configuration
+     *
+     * @return the model summary, an exception is thrown if the model is not dumped
+     * with the summary
+     */
+    static ModelInfo get_model_info(
+            const std::string& model_path, const Config& config = {});
+
+    /** @brief get the model summary embedded in the model memory without loading
+     * the model
+     *
+     * @param model_mem the model memory to get the model summary
+     * @param size model memory size in byte
+     * @param config the model configuration
+     *
+     * @return the model summary
+     */
+    static ModelInfo get_model_info(
+            const void* model_mem, size_t size, const Config& config = {});
+};
+
+/**
+ * @brief the configuration of the BatchedNetwork
+ *
+ * @param max_batch_size the max number of samples merged into one forward
+ *
+ * @param max_delay_us the max time in microseconds the first request of a
+ * batch waits for other requests before the batch is forwarded
+ */
+struct LITE_API BatchConfig {
+    size_t max_batch_size = 8;
+    size_t max_delay_us = 1000;
+};
+
+/**
+ * @brief A dynamic batching front end of a loaded network, the requests
+ * submitted from different threads are queued and merged along the batch axis
+ * (the first dim of every input), forwarded once, and the outputs are split
+ * back to the requests
+ *
+ * @note the network should be loaded with
+ * Options::no_profiling_on_shape_change set, otherwise every new merged batch
+ * size may trigger algo profiling again
+ */
+class LITE_API BatchedNetwork {
+public:
+    using Outputs = std::vector<std::shared_ptr<Tensor>>;
+
+    /** @brief construct the batcher, a worker thread is started to forward
+     * the merged requests
+     *
+     * @param network the loaded network, it should not be forwarded by others
+     * while owned by the batcher
+     * @param config the batching configuration
+     */
+    BatchedNetwork(std::shared_ptr<Network> network, const BatchConfig& config = {});
+
+    //! stop the worker thread after all the queued requests are done
+    ~BatchedNetwork();
+
+    /** @brief submit one request
+     *
+     * @param inputs the input tensors ordered as the network inputs, the first
+     * dim of each is the batch dim of the request, others must be the same
+     * between requests
+     *
+     * @return the future of the output tensors ordered as the network outputs,
+     * which own their memory
+     */
+    std::future<Outputs> submit(const Outputs& inputs);
+
+    //! get the number of forwards run by the batcher
+    size_t get_nr_forward() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief the configuration of the BucketedNetwork
+ *
+ * @param capacity the max number of execution contexts kept, the least
+ * recently used one is dropped when a new shape bucket comes
+ *
+ * @param pad_axis the axis of the inputs which is padded to the bucket
+ *
+ * @param buckets the sorted sizes the pad_axis of the inputs is padded to with
+ * zero, the inputs are not padded if it is empty or the size is larger than
+ * all the buckets
+ */
+struct LITE_API BucketConfig {
+    size_t capacity = 4;
+    size_t pad_axis = 0;
+    std::vector<size_t> buckets = {};
+};
+
+/**
+ * @brief A shape bucketed front end of a loaded network for dynamic shape
+ * inputs, each bucket of input shapes owns an execution context with its own
+ * memory plan and chosen algos, so switching between the recently seen shapes
+ * does not plan the memory or profile the algos again
+ */
+class LITE_API BucketedNetwork {
+public:
+    using Outputs = std::vector<std::shared_ptr<Tensor>>;
+
+    /** @brief construct the bucketed network
+     *
+     * @param network the loaded network
+     * @param config the bucket configuration
+     */
+    BucketedNetwork(std::shared_ptr<Network> network, const BucketConfig& config = {});
+
+    ~BucketedNetwork();
+
+    /** @brief forward the inputs with the execution context of their bucket
+     *
+     * @param inputs the input tensors ordered as the network inputs
+     *
+     * @return the output tensors ordered as the network outputs, they are
+     * sliced back to the input size along the first axis when pad_axis is 0,
+     * and are valid until the next forward of the same bucket
+     */
+    Outputs forward(const Outputs& inputs);
+
+    //! get the number of the execution contexts cached now
+    size_t get_nr_cached() const;
+
+    //! get the number of the execution contexts created since constructed
+    size_t get_nr_created() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief A double buffered input stager of a loaded network
+ *
+ * The inputs of the next batch are written into a set of pinned host tensors
+ * allocated from the host memory pool of the network device, while the
+ * current batch is forwarded with the other set. The host to device copy of
+ * pinned memory is asynchronous, so filling the next batch overlaps the copy
+ * and the forward of the current one.
+ *
+ * @note the inputs of the network should be host inputs, which is the
+ * default of the IO config
+ */
+class LITE_API StagedNetwork {
+public:
+    using Outputs = std::vector<std::shared_ptr<Tensor>>;
+
+    /** @brief construct the stager, two sets of pinned input tensors are
+     * allocated with the input layouts of the network
+     *
+     * @param network the loaded network, it should not be forwarded by others
+     * while owned by the stager
+     */
+    StagedNetwork(std::shared_ptr<Network> network);
+
+    //! wait for the running forward
+    ~StagedNetwork();
+
+    /** @brief get the pinned tensors to write the inputs of the next batch
+     * into, ordered as the network inputs
+     *
+     * The layouts could be changed by set_layout before writing; the tensors
+     * should not be written after forward until the next wait.
+     */
+    Outputs get_staging_inputs() const;
+
+    /** @brief forward the staged inputs asynchronously and switch the staging
+     * inputs to the other set, the running forward is waited first if any
+     */
+    void forward();
+
+    /** @brief wait for the running forward
+     *
+     * @return the output tensors ordered as the network outputs, which are
+     * valid until the next forward
+     */
+    Outputs wait();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief A pipelined asynchronous front end of a loaded network for streaming
+ * inference
+ *
+ * The requests are forwarded round robin by depth execution contexts of the
+ * network, each of which runs on its own stream. So the input copy of request
+ * k + 1, the compute of request k and the output copy of request k - 1 are
+ * issued to different streams and overlap on the device, while the order of
+ * the stages of one request is kept by its stream. The submitting thread only
+ * blocks when all the contexts are in flight.
+ *
+ * @note only cpu and cuda devices are supported, as the completion relies on
+ * the async mode of the network
+ */
+class LITE_API PipelinedNetwork {
+public:
+    using Outputs = std::vector<std::shared_ptr<Tensor>>;
+
+    /** @brief the function called when a request completes
+     *
+     * It is called from the callback thread of the device with the id returned
+     * by submit and the output tensors ordered as the network outputs, which
+     * are only valid until it returns. It should not throw.
+     */
+    using CompletionCallback =
+            std::function<void(size_t request_id, const Outputs& outputs)>;
+
+    /** @brief construct the pipeline
+     *
+     * @param network the loaded network, the execution contexts are created
+     * from it and it is not forwarded by the pipeline
+     * @param callback the function called when a request completes
+     * @param depth the number of requests in flight at most
+     */
+    PipelinedNetwork(
+            std::shared_ptr<Network> network, CompletionCallback callback,
+            size_t depth = 3);
+
+    //! wait for all the submitted requests
+    ~PipelinedNetwork();
+
+    /** @brief get the tensors to write the inputs of the next request into,
+     * ordered as the network inputs, blocks until the context of the next
+     * request completes its previous request
+     */
+    Outputs get_next_inputs();
+
+    /** @brief submit the inputs returned by get_next_inputs
+     *
+     * @return the id of the request, which counts from 0
+     */
+    size_t submit();
+
+    //! wait until all the submitted requests complete
+    void wait_all();
+
+    //! get the number of the completed requests
+    size_t get_nr_completed() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief A manager of the runtime memory arenas shared by several networks
+ *
+ * The networks registered to the same arena share one static runtime memory,
+ * whose size is the max of their memory plans, so they can not run at the same
+ * time. The forward of the manager runs the network after the running forward of
+ * the other networks of its arena, while the networks of different arenas can
+ * run concurrently. So the networks that may be requested at the same time
+ * should be registered to different arenas.
+ *
+ * @note the networks of an arena should only be forwarded by the manager
+ */
+class LITE_API RuntimeArenaManager {
+public:
+    struct MemoryInfo {
+        //! the total size of the arenas
+        size_t arena_size = 0;
+        //! the total size of the memory plans of the networks, which is the
+        //! memory used when no memory is shared
+        size_t required_size = 0;
+
+        size_t saved_size() const { return required_size - arena_size; }
+    };
+
+    /** @brief construct the manager
+     *
+     * @param nr_arena the number of arenas, which is the number of the networks
+     * that can run concurrently
+     */
+    explicit RuntimeArenaManager(size_t nr_arena = 1);
+
+    ~RuntimeArenaManager();
+
+    /** @brief register a network to an arena, which should be done before the
+     * network loads the model
+     *
+     * @param network the network to share the runtime memory of the arena
+     * @param arena the index of the arena
+     */
+    void add_network(std::shared_ptr<Network> network, size_t arena = 0);
+
+    /** @brief forward the network and wait for it, which waits for the running
+     * forward of the other networks of the same arena first
+     */
+    void forward(std::shared_ptr<Network> network);
+
+    //! get the memory info of the loaded networks
+    MemoryInfo get_memory_info() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief A block allocator of a paged kv cache
+ *
+ * The cache is made of nr_blocks blocks of block_size tokens. Each sequence
+ * owns the blocks listed by its block table, which are taken from the free
+ * blocks when the sequence grows and given back when it is removed.
+ */
+class LITE_API KVBlockAllocator {
+public:
+    KVBlockAllocator(size_t nr_blocks, size_t block_size);
+
+    //! start an empty sequence
+    void add_sequence(size_t seq_id);
+
+    //! give the blocks of the sequence back to the free blocks
+    void remove_sequence(size_t seq_id);
+
+    bool has_sequence(size_t seq_id) const;
+
+    /** @brief make the sequence own enough blocks for length tokens
+     *
+     * @return false if there are not enough free blocks, in which case no
+     * block is taken
+     */
+    bool reserve(size_t seq_id, size_t length);
+
+    //! get the physical blocks of the sequence in the logical order
+    const std::vector<int>& get_block_table(size_t seq_id) const;
+
+    size_t get_nr_free_blocks() const { return m_free_blocks.size(); }
+
+    size_t get_block_size() const { return m_block_size; }
+
+private:
+    size_t m_block_size;
+    //! the next block to take is at the back
+    std::vector<int> m_free_blocks;
+    std::unordered_map<size_t, std::vector<int>> m_block_tables;
+};
+
+/**
+ * @brief the configuration of the DecodeNetwork
+ *
+ * @param nr_blocks the number of blocks of the kv cache
+ *
+ * @param block_size the number of tokens in a block, which must match the
+ * third dim of the cache inputs of the model
+ *
+ * @param max_batch_size the max number of sequences decoded in one step
+ *
+ * @param eos_token the token which ends a sequence, negative for none
+ *
+ * @param cache_prefix the model inputs whose names start with it are the caches
+ */
+struct LITE_API DecodeConfig {
+    size_t nr_blocks = 256;
+    size_t block_size = 16;
+    size_t max_batch_size = 8;
+    int eos_token = -1;
+    std::string tokens_name = "tokens";
+    std::string positions_name = "positions";
+    std::string block_table_name = "block_table";
+    std::string logits_name = "logits";
+    std::string cache_prefix = "kv_cache";
+};
+
+/**
+ * @brief A stateful autoregressive decoding runtime over a paged kv cache
+ *
+ * The model takes the int32 tokens of shape (batch, seqlen), the int32
+ * positions of shape (batch) which are the numbers of cached tokens of the
+ * sequences, the int32 block table of shape (batch, max number of blocks) and
+ * the caches of shape (nr_blocks, num_heads, block_size, head_dim). It writes
+ * the keys and values of the tokens into the caches inplace, e.g. with the
+ * kv cache append and attention oprs, and outputs the float32 logits of shape
+ * (batch, seqlen, vocab).
+ *
+ * Each step either prefills the prompt of the first waiting sequence, or
+ * decodes one token of every running sequence in one batch. So sequences of
+ * different lengths join and leave the batch between steps. The next token is
+ * chosen greedily. When the cache is out of blocks, the latest admitted
+ * sequence is preempted, and its tokens are prefilled again later.
+ *
+ * @note the prefill and decode networks can be one network, or two networks of
+ * the prefill and decode graph variants, where the decode one shares the
+ * weights of the prefill one by Runtime::shared_weight_with_network. The caches
+ * are allocated by the runtime and shared by both networks, so the cache
+ * inputs should be device inputs (is_host false in the IO config).
+ */
+class LITE_API DecodeNetwork {
+public:
+    /** @brief construct the runtime after the networks loaded
+     *
+     * @param prefill the network to run the prompts
+     * @param decode the network to run one token of each sequence
+     * @param config the decode configuration
+     */
+    DecodeNetwork(
+            std::shared_ptr<Network> prefill, std::shared_ptr<Network> decode,
+            const DecodeConfig& config = {});
+
+    ~DecodeNetwork();
+
+    /** @brief queue a sequence to be prefilled
+     *
+     * @param prompt the tokens of the prompt, which must not be empty
+     * @param max_new_tokens the max number of tokens to generate
+     *
+     * @return the id of the sequence
+     */
+    size_t submit(const std::vector<int>& prompt, size_t max_new_tokens);
+
+    /** @brief run one step of the scheduler
+     *
+     * @return the ids of the sequences finished in this step
+     */
+    std::vector<size_t> step();
+
+    //! whether there is no waiting or running sequence
+    bool idle() const;
+
+    //! get the tokens generated by the sequence so far
+    std::vector<int> get_generated(size_t seq_id) const;
+
+    //! forget a finished sequence
+    void release(size_t seq_id);
+
+    //! get the number of the sequences being decoded
+    size_t get_nr_running() const;
+
+    //! get the number of the free blocks of the cache
+    size_t get_nr_free_blocks() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
 };
 
 }  // namespace lite
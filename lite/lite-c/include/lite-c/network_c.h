@@ -637,6 +637,84 @@ LITE_API int LITE_get_model_io_info_by_memory(
  */
 LITE_API int LITE_extra_configure(LiteNetwork network, LiteExtraConfig extra_config);
 
+/*!
+ * \brief the kind of an external buffer bound to a network IO
+ *
+ * \param LITE_BUFFER_HOST_PTR host memory, bound to a host IO
+ * \param LITE_BUFFER_DEVICE_PTR memory of the device of the network, such as a
+ * CUDA device pointer, bound to a device IO (is_host of the IO is false)
+ * \param LITE_BUFFER_DMA_BUF a dma-buf file descriptor, which is mapped into
+ * the host address space once when bound, bound to a host IO of a cpu network
+ */
+typedef enum {
+    LITE_BUFFER_HOST_PTR = 0,
+    LITE_BUFFER_DEVICE_PTR = 1,
+    LITE_BUFFER_DMA_BUF = 2,
+} LiteBufferType;
+
+/*!
+ * \brief an external buffer owned by the user
+ *
+ * \param ptr the address of the buffer of pointer kinds
+ * \param fd the file descriptor of the buffer of LITE_BUFFER_DMA_BUF
+ * \param offset the offset in bytes of the data in the buffer
+ * \param size the size in bytes of the buffer after offset
+ */
+typedef struct LiteExternalBuffer {
+    LiteBufferType type;
+    void* ptr;
+    int fd;
+    size_t offset;
+    size_t size;
+} LiteExternalBuffer;
+
+//! a set of external buffers bound to the IO tensors of a loaded network
+typedef void* LiteIOBinding;
+
+/**
+ * \brief create an empty IO binding of a loaded network
+ * \param[in] network The loaded network
+ * \param[out] binding The created IO binding
+ */
+LITE_API int LITE_make_io_binding(LiteNetwork network, LiteIOBinding* binding);
+
+/**
+ * \brief bind an external buffer to an IO tensor of the network
+ *
+ * The buffer is validated against the IO and the layout here once, and the IO
+ * tensor is reset to the buffer, so the network reads the input from and
+ * writes the output to it without host copies. The buffer must outlive the
+ * binding, and it is not freed by lite.
+ *
+ * \param[in] binding The IO binding
+ * \param[in] io_name The name of the IO tensor
+ * \param[in] phase The phase of the IO tensor
+ * \param[in] buffer The external buffer
+ * \param[in] layout The layout of the data in the buffer
+ */
+LITE_API int LITE_io_binding_bind(
+        LiteIOBinding binding, const char* io_name, LiteTensorPhase phase,
+        const LiteExternalBuffer* buffer, const LiteLayout layout);
+
+/**
+ * \brief reset the IO tensors to the buffers of the binding before forward
+ *
+ * Only the tensors reset to other memory since bound, such as by another
+ * binding of the network, are reset again, without validation or allocation.
+ * So several bindings can be switched between forwards, e.g. one for each
+ * frame buffer of a video stream.
+ *
+ * \param[in] binding The IO binding
+ */
+LITE_API int LITE_io_binding_apply(LiteIOBinding binding);
+
+/**
+ * \brief destroy the IO binding, the dma-buf mappings are released, and the
+ * IO tensors should be reset before the next forward
+ * \param[in] binding The IO binding
+ */
+LITE_API int LITE_destroy_io_binding(LiteIOBinding binding);
+
 #ifdef __cplusplus
 }
 #endif
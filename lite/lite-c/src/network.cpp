@@ -5,10 +5,16 @@
 #include "../../src/network_impl_base.h"
 
 #include <string.h>
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
 
+#if __linux__ || __ANDROID__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 //! define a default Options
 const LiteOptions default_option = {
         .weight_preprocess = false,
@@ -765,4 +771,193 @@ LITE_API int LITE_extra_configure(LiteNetwork network, LiteExtraConfig extra_con
     LITE_CAPI_END();
 }
 
+namespace {
+/*!
+ * \brief the external buffers bound to the IO tensors of a network, which
+ * keeps the network alive
+ */
+class IOBinding {
+public:
+    explicit IOBinding(std::shared_ptr<lite::Network> network)
+            : m_network{std::move(network)} {}
+
+    ~IOBinding() {
+        for (auto&& i : m_entries) {
+            unmap(i);
+        }
+    }
+
+    void bind(
+            const char* io_name, LiteTensorPhase phase,
+            const LiteExternalBuffer& buffer, const lite::Layout& layout);
+
+    void apply() {
+        for (auto&& i : m_entries) {
+            if (i.tensor->get_layout() == i.layout &&
+                i.tensor->get_memory_ptr() == i.ptr) {
+                continue;
+            }
+            i.tensor->reset(i.ptr, i.layout);
+        }
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<lite::Tensor> tensor;
+        void* ptr;
+        lite::Layout layout;
+        //! the mapping of a dma-buf
+        void* mapped = nullptr;
+        size_t mapped_size = 0;
+    };
+
+    static void unmap(Entry& entry) {
+#if __linux__ || __ANDROID__
+        if (entry.mapped) {
+            munmap(entry.mapped, entry.mapped_size);
+            entry.mapped = nullptr;
+        }
+#endif
+    }
+
+    std::shared_ptr<lite::Network> m_network;
+    std::vector<Entry> m_entries;
+};
+
+void IOBinding::bind(
+        const char* io_name, LiteTensorPhase phase, const LiteExternalBuffer& buffer,
+        const lite::Layout& layout) {
+    auto tensor = m_network->get_io_tensor(io_name, phase);
+    auto device_type = m_network->get_device_type();
+    bool host_io = device_type == LiteDeviceType::LITE_CPU || tensor->is_pinned_host();
+    LITE_ASSERT(
+            layout.ndim > 0, "the layout bound to %s of the network is empty.",
+            io_name);
+    size_t nr_elems = 1;
+    for (size_t i = 0; i < layout.ndim; i++) {
+        nr_elems *= layout.shapes[i];
+    }
+    size_t nr_bytes = nr_elems * layout.get_elem_size();
+    LITE_ASSERT(
+            buffer.size >= nr_bytes,
+            "the buffer bound to %s of the network is %zu bytes, but %zu bytes are "
+            "needed.",
+            io_name, buffer.size, nr_bytes);
+
+    Entry entry;
+    entry.tensor = tensor;
+    entry.layout = layout;
+    switch (buffer.type) {
+        case LITE_BUFFER_HOST_PTR:
+        case LITE_BUFFER_DEVICE_PTR: {
+            bool host_buffer = buffer.type == LITE_BUFFER_HOST_PTR;
+            LITE_ASSERT(buffer.ptr, "the buffer bound to %s is null.", io_name);
+            LITE_ASSERT(
+                    host_buffer == host_io || device_type == LiteDeviceType::LITE_CPU,
+                    "a %s buffer can not be bound to %s, which is a %s IO.",
+                    host_buffer ? "host" : "device", io_name,
+                    host_io ? "host" : "device");
+            entry.ptr = static_cast<uint8_t*>(buffer.ptr) + buffer.offset;
+            break;
+        }
+        case LITE_BUFFER_DMA_BUF: {
+#if __linux__ || __ANDROID__
+            LITE_ASSERT(
+                    device_type == LiteDeviceType::LITE_CPU,
+                    "dma-buf can only be bound to the IO of cpu network, but %s is "
+                    "of a device network.",
+                    io_name);
+            //! mmap needs the offset aligned to the page
+            size_t page = sysconf(_SC_PAGESIZE);
+            size_t aligned_offset = buffer.offset / page * page;
+            entry.mapped_size = buffer.offset - aligned_offset + buffer.size;
+            auto mapped =
+                    mmap(nullptr, entry.mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         buffer.fd, aligned_offset);
+            LITE_ASSERT(
+                    mapped != MAP_FAILED, "failed to map the dma-buf bound to %s: %s",
+                    io_name, strerror(errno));
+            entry.mapped = mapped;
+            entry.ptr = static_cast<uint8_t*>(mapped) + buffer.offset - aligned_offset;
+            break;
+#else
+            LITE_THROW("dma-buf is only supported on linux.");
+#endif
+        }
+        default:
+            LITE_THROW(lite::ssprintf("unknown buffer type %d.", buffer.type));
+    }
+    //! do not leak the new mapping if the tensor rejects it
+    struct UnmapGuard {
+        Entry* entry;
+        ~UnmapGuard() {
+            if (entry)
+                unmap(*entry);
+        }
+    } unmap_guard{&entry};
+    entry.tensor->reset(entry.ptr, entry.layout);
+    unmap_guard.entry = nullptr;
+    //! binding an IO again replaces its entry, and the tensor no longer refers
+    //! to the previous dma-buf mapping once reset above
+    auto iter = std::find_if(m_entries.begin(), m_entries.end(), [&](const Entry& i) {
+        return i.tensor == entry.tensor;
+    });
+    if (iter != m_entries.end()) {
+        unmap(*iter);
+        *iter = std::move(entry);
+    } else {
+        m_entries.emplace_back(std::move(entry));
+    }
+}
+
+LITE_MUTEX mtx_io_binding;
+std::unordered_map<void*, std::unique_ptr<IOBinding>>& get_global_io_binding_holder() {
+    static std::unordered_map<void*, std::unique_ptr<IOBinding>> holder;
+    return holder;
+}
+}  // namespace
+
+int LITE_make_io_binding(LiteNetwork network, LiteIOBinding* binding) {
+    LITE_CAPI_BEGIN();
+    LITE_ASSERT(network && binding, "The network pass to LITE api is null");
+    std::shared_ptr<lite::Network> lite_network;
+    {
+        LITE_LOCK_GUARD(mtx_network);
+        auto&& holder = get_gloabl_network_holder();
+        auto iter = holder.find(network);
+        LITE_ASSERT(iter != holder.end(), "The network is not created by LITE api");
+        lite_network = iter->second;
+    }
+    auto io_binding = std::make_unique<IOBinding>(std::move(lite_network));
+    *binding = io_binding.get();
+    LITE_LOCK_GUARD(mtx_io_binding);
+    get_global_io_binding_holder()[*binding] = std::move(io_binding);
+    LITE_CAPI_END();
+}
+
+int LITE_io_binding_bind(
+        LiteIOBinding binding, const char* io_name, LiteTensorPhase phase,
+        const LiteExternalBuffer* buffer, const LiteLayout layout) {
+    LITE_CAPI_BEGIN();
+    LITE_ASSERT(binding && io_name && buffer, "The binding pass to LITE api is null");
+    static_cast<IOBinding*>(binding)->bind(
+            io_name, phase, *buffer, convert_to_layout(layout));
+    LITE_CAPI_END();
+}
+
+int LITE_io_binding_apply(LiteIOBinding binding) {
+    LITE_CAPI_BEGIN();
+    LITE_ASSERT(binding, "The binding pass to LITE api is null");
+    static_cast<IOBinding*>(binding)->apply();
+    LITE_CAPI_END();
+}
+
+int LITE_destroy_io_binding(LiteIOBinding binding) {
+    LITE_CAPI_BEGIN();
+    LITE_ASSERT(binding, "The binding pass to LITE api is null");
+    LITE_LOCK_GUARD(mtx_io_binding);
+    get_global_io_binding_holder().erase(binding);
+    LITE_CAPI_END();
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -53,6 +53,12 @@ void ModelMdl::load_model() {
             std::move(m_model_file), m_format.val());
     m_load_result = m_loader->load(m_load_config, false);
     m_load_config.comp_graph.reset();
+    if (m_format.val() == mgb::serialization::GraphDumpFormat::FLATBUFFERS_V2) {
+        auto&& time = m_load_result.stage_time;
+        mgb_log("load stages: read %.3fms, decode %.3fms, build %.3fms, upload "
+                "%.3fms",
+                time.read, time.decode, time.build, time.upload);
+    }
 
     // get testcase input generated by dump_with_testcase.py
     if (testcase_num) {
@@ -1,10 +1,20 @@
 #include <gflags/gflags.h>
+#include <cstdio>
+
+#include <cstring>
 
 #if defined(_WIN32)
+#include <fcntl.h>
 #include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#include <windows.h>
 #define F_OK         0
 #define access(a, b) _access(a, b)
+#define getpid       _getpid
 #elif __linux__ || __unix__ || __APPLE__
+#include <fcntl.h>
+#include <sys/file.h>
 #include <unistd.h>
 #endif
 #include "fastrun_options.h"
@@ -14,6 +24,83 @@
 #include "models/model_lite.h"
 #include "models/model_mdl.h"
 
+namespace {
+mgb::InFilePersistentCache& current_cache() {
+    return static_cast<mgb::InFilePersistentCache&>(mgb::PersistentCache::inst());
+}
+
+//! fill the entries missing in the current cache from the shared cache
+void pull_shared_cache(const std::string& path) {
+    if (access(path.c_str(), F_OK))
+        return;
+    mgb::InFilePersistentCache shared{path.c_str()};
+    auto nr_entries = current_cache().merge(shared);
+    mgb_log("load %zu entries from fast-run shared cache %s", nr_entries, path.c_str());
+}
+
+//! exclusive advisory lock on \p path, held by the writers of the shared cache
+class SharedCacheLock : public mgb::NonCopyableObj {
+    int m_fd;
+
+public:
+    explicit SharedCacheLock(const std::string& path) {
+#if defined(_WIN32)
+        m_fd = _open(
+                path.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+#endif
+        mgb_assert(m_fd >= 0, "failed to open %s: %s", path.c_str(), strerror(errno));
+#if defined(_WIN32)
+        OVERLAPPED overlapped = {};
+        auto ok = LockFileEx(
+                reinterpret_cast<HANDLE>(_get_osfhandle(m_fd)), LOCKFILE_EXCLUSIVE_LOCK,
+                0, MAXDWORD, MAXDWORD, &overlapped);
+        mgb_assert(ok, "failed to lock %s: %lu", path.c_str(), GetLastError());
+#else
+        int ret;
+        do {
+            ret = flock(m_fd, LOCK_EX);
+        } while (ret && errno == EINTR);
+        mgb_assert(!ret, "failed to lock %s: %s", path.c_str(), strerror(errno));
+#endif
+    }
+
+    //! closing the fd releases the lock
+    ~SharedCacheLock() {
+#if defined(_WIN32)
+        _close(m_fd);
+#else
+        close(m_fd);
+#endif
+    }
+};
+
+/*!
+ * the shared cache is read again before being updated, so that the entries
+ * written by other processes since it was pulled are kept, and it is replaced
+ * by rename to never expose a partial file to the readers; the writers hold a
+ * lock on a side file from the re-read to the rename, otherwise the entries
+ * another process renamed in between would be lost
+ */
+void push_shared_cache(const std::string& path) {
+    SharedCacheLock lock{path + ".lock"};
+    mgb::InFilePersistentCache shared;
+    if (!access(path.c_str(), F_OK))
+        shared.merge(mgb::InFilePersistentCache{path.c_str()});
+    auto nr_entries = shared.merge(current_cache());
+    if (!nr_entries)
+        return;
+    auto tmp_path =
+            mgb::ssprintf("%s.%d.tmp", path.c_str(), static_cast<int>(getpid()));
+    shared.dump_cache(tmp_path.c_str());
+    mgb_assert(
+            !std::rename(tmp_path.c_str(), path.c_str()), "failed to update %s: %s",
+            path.c_str(), strerror(errno));
+    mgb_log("add %zu entries to fast-run shared cache %s", nr_entries, path.c_str());
+}
+}  // namespace
+
 namespace lar {
 
 template <>
@@ -31,8 +118,10 @@ void FastRunOption::config_model_internel<ModelLite>(
             LITE_LOG("enable fast-run strategy for algo profile");
             strategy = static_cast<uint32_t>(Strategy::LITE_ALGO_PROFILE) |
                        static_cast<uint32_t>(Strategy::LITE_ALGO_OPTIMIZED) | strategy;
-        } else if ((!m_fast_run_cache.empty() &&
-                    !access(m_fast_run_cache.c_str(), F_OK))) {
+        } else if (
+                (!m_fast_run_cache.empty() &&
+                 !access(m_fast_run_cache.c_str(), F_OK)) ||
+                (!m_shared_cache.empty() && !access(m_shared_cache.c_str(), F_OK))) {
             LITE_LOG(
                     "detect fast-run cache usable set LITE_ALGO_PROFILE for algo "
                     "profile");
@@ -63,12 +152,22 @@ void FastRunOption::config_model_internel<ModelLite>(
                 lite::set_persistent_cache(m_fast_run_cache, true);
             }
         }
+        if (!m_shared_cache.empty()) {
+            if (m_fast_run_cache.empty()) {
+                mgb::PersistentCache::set_impl(
+                        std::make_shared<mgb::InFilePersistentCache>());
+            }
+            pull_shared_cache(m_shared_cache);
+        }
     } else if (runtime_param.stage == RunStage::AFTER_MODEL_RUNNING) {
 #if MGB_ENABLE_FASTRUN
         //! dump algo cache
         if (!m_fast_run_cache.empty()) {
             lite::dump_persistent_cache(m_fast_run_cache);
         }
+        if (!m_shared_cache.empty()) {
+            push_shared_cache(m_shared_cache);
+        }
 #endif
     }
 }
@@ -117,8 +216,8 @@ void FastRunOption::config_model_internel<ModelMdl>(
         auto&& strategy = model->get_mdl_strategy();
         mgb::gopt::modify_opr_algo_strategy_inplace(vars, strategy);
         // set algo cache path
-        if (!m_fast_run_cache.empty()) {
-            if (!access(m_fast_run_cache.c_str(), F_OK)) {
+        if (!m_fast_run_cache.empty() || !m_shared_cache.empty()) {
+            if (!m_fast_run_cache.empty() && !access(m_fast_run_cache.c_str(), F_OK)) {
                 mgb::PersistentCache::set_impl(
                         std::make_shared<mgb::InFilePersistentCache>(
                                 m_fast_run_cache.c_str()));
@@ -126,6 +225,9 @@ void FastRunOption::config_model_internel<ModelMdl>(
                 mgb::PersistentCache::set_impl(
                         std::make_shared<mgb::InFilePersistentCache>());
             }
+            if (!m_shared_cache.empty()) {
+                pull_shared_cache(m_shared_cache);
+            }
 #if MGB_ENABLE_FASTRUN
             if (!enable_full_run && !enable_fast_run)
 #endif
@@ -135,8 +237,10 @@ void FastRunOption::config_model_internel<ModelMdl>(
 #if MGB_ENABLE_FASTRUN
         //! dump algo cache
         if (!m_fast_run_cache.empty()) {
-            static_cast<mgb::InFilePersistentCache&>(mgb::PersistentCache::inst())
-                    .dump_cache(m_fast_run_cache.c_str());
+            current_cache().dump_cache(m_fast_run_cache.c_str());
+        }
+        if (!m_shared_cache.empty()) {
+            push_shared_cache(m_shared_cache);
         }
 #endif
     }
@@ -155,6 +259,7 @@ void FastRunOption::update() {
     batch_binary_equal = FLAGS_binary_equal_between_batch;
     enable_reproducible = FLAGS_reproducible;
     m_fast_run_cache = FLAGS_fast_run_algo_policy;
+    m_shared_cache = FLAGS_fast_run_shared_cache;
     share_batch_size = FLAGS_fast_run_shared_batch_size;
     m_option = {
 #if MGB_ENABLE_FASTRUN
@@ -184,9 +289,11 @@ void FastRunOption::update() {
     }
     if (share_batch_size) {
         mgb_assert(
-                enable_full_run || enable_fast_run || !m_fast_run_cache.empty(),
+                enable_full_run || enable_fast_run || !m_fast_run_cache.empty() ||
+                        !m_shared_cache.empty(),
                 "--fast-run-shared-batch-size should be used with "
-                "--fast-run|--full-run|--fast-run-algo-policy");
+                "--fast-run|--full-run|--fast-run-algo-policy|"
+                "--fast-run-shared-cache");
     }
 #endif
 }
@@ -201,6 +308,7 @@ bool FastRunOption::is_valid() {
     ret = ret || FLAGS_fast_run_shared_batch_size > 0;
     ret = ret || FLAGS_reproducible;
     ret = ret || FLAGS_fast_run_algo_policy.size() > 0;
+    ret = ret || FLAGS_fast_run_shared_cache.size() > 0;
 
     return ret || m_valid;
 }
@@ -254,6 +362,13 @@ DEFINE_bool(
         "for more details.");
 DEFINE_int32(fast_run_shared_batch_size, 0, "Set the batch size used during fastrun");
 DEFINE_string(fast_run_algo_policy, "", "fast-run cache path.");
+DEFINE_string(
+        fast_run_shared_cache, "",
+        "fast-run cache shared by the runs on a fleet of devices. The entries "
+        "missing in the local cache are taken from it before the model runs, so "
+        "that only the missing ones are profiled, and the new entries are added "
+        "to it after the model runs. The cache categories record the traits of "
+        "the device, so one file can serve different devices.");
 
 REGIST_OPTION_CREATOR(fastrun, lar::FastRunOption::create_option);
 REGIST_OPTION_VALIDATER(fastrun, lar::FastRunOption::set_valid);
@@ -12,6 +12,7 @@ DECLARE_bool(reproducible);
 DECLARE_bool(binary_equal_between_batch);
 DECLARE_int32(fast_run_shared_batch_size);
 DECLARE_string(fast_run_algo_policy);
+DECLARE_string(fast_run_shared_cache);
 
 namespace lar {
 class FastRunOption final : public OptionBase {
@@ -49,6 +50,7 @@ private:
     bool enable_reproducible;      //! enable reproducible strategy
     size_t share_batch_size;       //! fast run strategy share batch size setting
     std::string m_fast_run_cache;  //! fast run cache file path
+    std::string m_shared_cache;    //! fast run cache shared by the devices
     std::string m_option_name;     //! option name
 
     static bool m_valid;
@@ -1,4 +1,5 @@
 #include "plugin_options.h"
+#include <algorithm>
 #include <map>
 #include "misc.h"
 #include "models/model_lite.h"
@@ -6,6 +7,94 @@
 ///////////////////// Plugin options///////////////////////////
 namespace lar {
 
+#if MGB_ENABLE_JSON
+namespace {
+//! an opr taking at least this ratio of the total time is a bottleneck if it
+//! reaches less than BOTTLENECK_ROOF_RATIO of its roofline, or any ratio if
+//! the roofline is not given
+constexpr double BOTTLENECK_TIME_RATIO = 0.05;
+constexpr double BOTTLENECK_ROOF_RATIO = 0.5;
+
+void print_profile_summary(
+        const mgb::GraphProfiler& profiler, double peak_gflops, double peak_gbps) {
+    auto summary = profiler.summary();
+    std::sort(summary.begin(), summary.end(), [](const auto& a, const auto& b) {
+        return a.device_time > b.device_time;
+    });
+    double total_time = 0;
+    for (auto&& i : summary) {
+        total_time += i.device_time;
+    }
+
+    mgb::TextTable table("Operator Profile Summary");
+    table.padding(1);
+    table.align(mgb::TextTable::Align::Mid)
+            .add("name")
+            .add("type")
+            .add("time(ms)")
+            .add("ratio(%)")
+            .add("MFLOPs")
+            .add("MB")
+            .add("GFLOPS")
+            .add("GB/s")
+            .add("bound")
+            .add("roof(%)")
+            .add("algo")
+            .add("bottleneck")
+            .eor();
+    size_t nr_bottleneck = 0;
+    for (auto&& i : summary) {
+        double ratio = total_time > 0 ? i.device_time / total_time : 0;
+        double gflops = 0, gbps = 0;
+        if (i.device_time > 0) {
+            gflops = i.computation / i.device_time / 1e9;
+            gbps = i.memory / i.device_time / 1e9;
+        }
+        //! the attainable performance is limited by the compute peak or by
+        //! the bandwidth times the arithmetic intensity, whichever is lower
+        std::string bound = "-";
+        double roof = -1;
+        if (i.computation && peak_gflops > 0 &&
+            (peak_gbps <= 0 || !i.memory ||
+             double(i.computation) / i.memory >= peak_gflops / peak_gbps)) {
+            bound = "compute";
+            roof = gflops / peak_gflops;
+        } else if (i.memory && peak_gbps > 0) {
+            bound = "memory";
+            roof = gbps / peak_gbps;
+        }
+        bool bottleneck =
+                ratio >= BOTTLENECK_TIME_RATIO &&
+                (roof < 0 ? peak_gflops <= 0 && peak_gbps <= 0
+                          : roof < BOTTLENECK_ROOF_RATIO);
+        nr_bottleneck += bottleneck;
+        auto name = i.opr->name();
+        if (name.size() > 40) {
+            name = name.substr(0, 37) + "...";
+        }
+        table.align(mgb::TextTable::Align::Mid)
+                .add(name)
+                .add(i.opr->dyn_typeinfo()->name)
+                .add(mgb::ssprintf("%.3f", i.device_time * 1e3))
+                .add(mgb::ssprintf("%.2f", ratio * 100))
+                .add(mgb::ssprintf("%.2f", i.computation / 1e6))
+                .add(mgb::ssprintf("%.2f", i.memory / 1e6))
+                .add(mgb::ssprintf("%.2f", gflops))
+                .add(mgb::ssprintf("%.2f", gbps))
+                .add(bound)
+                .add(roof < 0 ? std::string("-") : mgb::ssprintf("%.1f", roof * 100))
+                .add(i.algo.empty() ? std::string("-") : i.algo)
+                .add(bottleneck ? "*" : "")
+                .eor();
+    }
+    std::stringstream ss;
+    ss << table;
+    mgb_log("\n%s\ntotal device time: %.3fms, %zu bottleneck oprs\n", ss.str().c_str(),
+            total_time * 1e3, nr_bottleneck);
+}
+}  // namespace
+#endif
+
 template <>
 void PluginOption::config_model_internel<ModelLite>(
         RuntimeParam& runtime_param, std::shared_ptr<ModelLite> model) {
@@ -17,6 +106,10 @@ void PluginOption::config_model_internel<ModelLite>(
         LITE_ASSERT(
                 var_value_check_str.empty(),
                 "lite model don't support VarValueChecker plugin");
+#if MGB_ENABLE_JSON
+        LITE_ASSERT(
+                !enable_profile_summary, "lite model don't support profiling summary");
+#endif
     }
 #if MGB_ENABLE_JSON
     else if (runtime_param.stage == RunStage::AFTER_MODEL_LOAD) {
@@ -71,6 +164,11 @@ void PluginOption::config_model_internel<ModelMdl>(
             } else {
                 mgb_log("enable profiling for host");
             }
+        }
+        if (enable_profile_summary) {
+            mgb_log("enable profiling summary");
+        }
+        if (!profile_path.empty() || enable_profile_summary) {
             model->set_profiler();
         }
 #endif
@@ -86,6 +184,10 @@ void PluginOption::config_model_internel<ModelMdl>(
                 mgb_log("profiling result written to %s", profile_path.c_str());
             }
         }
+        if (enable_profile_summary && model->get_profiler()) {
+            print_profile_summary(
+                    *model->get_profiler(), roofline_gflops, roofline_gbps);
+        }
 #endif
     }
 }
@@ -107,6 +209,9 @@ void PluginOption::update() {
         enable_profile_host = !FLAGS_profile_host.empty();
         profile_path = FLAGS_profile_host;
     }
+    enable_profile_summary = FLAGS_profile_summary;
+    roofline_gflops = FLAGS_roofline_gflops;
+    roofline_gbps = FLAGS_roofline_gbps;
 #endif
 }
 
@@ -117,6 +222,7 @@ bool PluginOption::is_valid() {
 #if MGB_ENABLE_JSON
     ret = ret || !FLAGS_profile.empty();
     ret = ret || !FLAGS_profile_host.empty();
+    ret = ret || FLAGS_profile_summary;
 #endif
     return ret;
 }
@@ -402,6 +508,19 @@ DEFINE_string(
 DEFINE_string(
         profile_host, "",
         "focus on host time profiling For some backends(such as openCL)");
+DEFINE_bool(
+        profile_summary, false,
+        "print a per-operator table of the last run with time, FLOPs, bytes moved, "
+        "achieved GFLOPS and GB/s, the roofline bound and the chosen algo, and mark "
+        "the bottleneck operators");
+DEFINE_double(
+        roofline_gflops, 0,
+        "peak GFLOPS of the device, used by --profile_summary for roofline "
+        "analysis");
+DEFINE_double(
+        roofline_gbps, 0,
+        "peak memory bandwidth of the device in GB/s, used by --profile_summary "
+        "for roofline analysis");
 #endif
 
 ///////////////////// Debug gflags///////////////////////////
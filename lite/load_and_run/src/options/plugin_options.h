@@ -18,6 +18,9 @@ DECLARE_string(check_var_value);
 #if MGB_ENABLE_JSON
 DECLARE_string(profile);
 DECLARE_string(profile_host);
+DECLARE_bool(profile_summary);
+DECLARE_double(roofline_gflops);
+DECLARE_double(roofline_gbps);
 #endif
 
 DECLARE_bool(model_info);
@@ -55,6 +58,10 @@ private:
 #if MGB_ENABLE_JSON
     bool enable_profile_host;
     std::string profile_path;
+    bool enable_profile_summary;
+    //! peak compute and memory bandwidth of the device for roofline analysis
+    double roofline_gflops;
+    double roofline_gbps;
 #endif
 
     std::string var_value_check_str;
@@ -29,6 +29,10 @@ void StrategyOption::config_model(
         RuntimeParam& runtime_param, std::shared_ptr<ModelBase> model) {
     if (runtime_param.stage == RunStage::BEFORE_MODEL_LOAD) {
         model->set_shared_mem(FLAGS_share_param_mem);
+        if (model->type() == ModelType::MEGDL_MODEL) {
+            auto model_ptr = std::static_pointer_cast<ModelMdl>(model);
+            model_ptr->get_mdl_config().nr_load_threads = FLAGS_load_thread;
+        }
         runtime_param.warmup_iter = warmup_iter;
         runtime_param.run_iter = run_iter;
         runtime_param.threads = threads;
@@ -111,6 +115,26 @@ DEFINE_int32(
 
 DEFINE_bool(share_param_mem, false, "load model from shared memeory");
 
+DEFINE_int32(
+        load_thread, 1,
+        "thread number for decoding the param values while loading the model, "
+        "only used by the v2 model format");
+
+DEFINE_int32(
+        concurrency, 0,
+        "number of model instances run concurrently to measure the throughput "
+        "and the latency distribution, each of which runs --iter iterations");
+
+DEFINE_double(
+        qps, 0,
+        "total queries per second sent to the model instances with "
+        "--concurrency, the instances run in closed loop if it is 0");
+
+DEFINE_string(
+        concurrency_cores, "",
+        "core sets that the model instances with --concurrency are bound to in "
+        "turn, such as \"0-3;4-7\" or \"0,1;2,3\"");
+
 REGIST_OPTION_CREATOR(run_strategy, lar::StrategyOption::create_option);
 
 REGIST_OPTION_CREATOR(run_testcase, lar::TestcaseOption::create_option);
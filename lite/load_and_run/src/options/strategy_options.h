@@ -5,6 +5,10 @@ DECLARE_int32(iter);
 DECLARE_int32(warmup_iter);
 DECLARE_int32(thread);
 DECLARE_bool(share_param_mem);
+DECLARE_int32(load_thread);
+DECLARE_int32(concurrency);
+DECLARE_double(qps);
+DECLARE_string(concurrency_cores);
 
 namespace lar {
 /*!
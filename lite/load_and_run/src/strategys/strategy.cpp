@@ -2,12 +2,16 @@
 #include <iostream>
 #include "strategy_fitting.h"
 #include "strategy_normal.h"
+#include "strategy_throughput.h"
 
 using namespace lar;
 DECLARE_bool(fitting);
+DECLARE_int32(concurrency);
 std::shared_ptr<StrategyBase> StrategyBase::create_strategy(std::string model_path) {
     if (FLAGS_fitting) {
         return std::make_shared<FittingStrategy>(model_path);
+    } else if (FLAGS_concurrency > 0) {
+        return std::make_shared<ThroughputStrategy>(model_path);
     } else {
         return std::make_shared<NormalStrategy>(model_path);
     }
@@ -0,0 +1,259 @@
+#include "strategy_throughput.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include "megbrain/common.h"
+#include "options/strategy_options.h"
+
+using namespace lar;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+//! parse the core sets such as "0-3;4,5", the sets are separated by ';'
+std::vector<std::vector<int>> parse_core_sets(const std::string& str) {
+    std::vector<std::vector<int>> ret;
+    std::stringstream sets{str};
+    std::string set;
+    while (std::getline(sets, set, ';')) {
+        std::vector<int> cores;
+        std::stringstream items{set};
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            if (item.empty())
+                continue;
+            auto pos = item.find('-');
+            int begin = std::stoi(item.substr(0, pos)), end = begin;
+            if (pos != std::string::npos)
+                end = std::stoi(item.substr(pos + 1));
+            mgb_assert(begin <= end, "invalid core range: %s", item.c_str());
+            for (int i = begin; i <= end; ++i)
+                cores.push_back(i);
+        }
+        if (!cores.empty())
+            ret.emplace_back(std::move(cores));
+    }
+    return ret;
+}
+
+//! bind the calling thread to the cores, so that the threads created by it
+//! such as the workers of the comp nodes are bound to them too
+void bind_cores(const std::vector<int>& cores) {
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto i : cores)
+        CPU_SET(i, &mask);
+    if (sched_setaffinity(0, sizeof(mask), &mask))
+        mgb_log_warn("failed to bind the thread to the cores");
+#else
+    MGB_MARK_USED_VAR(cores);
+    mgb_log_warn("binding threads to cores is not supported on this platform");
+#endif
+}
+
+//! busy and total time of each core
+struct CoreTimes {
+    std::vector<uint64_t> busy, total;
+
+    static CoreTimes get() {
+        CoreTimes ret;
+#if defined(__linux__)
+        std::ifstream fin{"/proc/stat"};
+        std::string line;
+        while (std::getline(fin, line)) {
+            // the lines of the cores start with "cpu<N>"
+            if (line.compare(0, 3, "cpu") || line.size() < 4 || !isdigit(line[3]))
+                continue;
+            std::stringstream ss{line};
+            std::string name;
+            ss >> name;
+            uint64_t val, idle = 0, total = 0;
+            for (size_t i = 0; ss >> val; ++i) {
+                // the fourth and the fifth fields are idle and iowait
+                if (i == 3 || i == 4)
+                    idle += val;
+                total += val;
+            }
+            ret.busy.push_back(total - idle);
+            ret.total.push_back(total);
+        }
+#endif
+        return ret;
+    }
+};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    size_t idx = std::ceil(p * sorted.size());
+    return sorted[std::min(std::max<size_t>(idx, 1), sorted.size()) - 1];
+}
+}  // namespace
+
+ThroughputStrategy::ThroughputStrategy(std::string model_path) {
+    m_options = std::make_shared<OptionMap>();
+    m_model_path = model_path;
+    auto option_creator_map = OptionFactory::get_Instance().get_option_creator_map();
+    for (auto& creator : *option_creator_map) {
+        auto name = creator.first;
+        if (m_options->count(name) == 0) {
+            auto option = creator.second();
+            if (option) {
+                m_options->insert({name, option});
+            }
+        }
+    }
+}
+
+void ThroughputStrategy::config_model(std::shared_ptr<ModelBase> model) {
+    for (auto& option : *m_options) {
+        option.second->config_model(m_runtime_param, model);
+    }
+}
+
+std::shared_ptr<ModelBase> ThroughputStrategy::setup_model() {
+    auto model = ModelBase::create_model(m_model_path);
+    mgb_assert(model != nullptr, "create model failed!!");
+    m_runtime_param.stage = RunStage::BEFORE_MODEL_LOAD;
+    config_model(model);
+    m_runtime_param.stage = RunStage::AFTER_NETWORK_CREATED;
+    model->create_network();
+    config_model(model);
+    model->load_model();
+    for (auto stage :
+         {RunStage::AFTER_MODEL_LOAD, RunStage::UPDATE_IO,
+          RunStage::GLOBAL_OPTIMIZATION, RunStage::BEFORE_OUTSPEC_SET,
+          RunStage::AFTER_OUTSPEC_SET, RunStage::MODEL_RUNNING}) {
+        m_runtime_param.stage = stage;
+        config_model(model);
+    }
+    for (size_t i = 0; i < m_runtime_param.warmup_iter; i++) {
+        model->run_model();
+        model->wait();
+    }
+    return model;
+}
+
+void ThroughputStrategy::run() {
+#if MGB_HAVE_THREAD
+    size_t nr_workers = FLAGS_concurrency;
+    double qps = FLAGS_qps;
+    auto core_sets = parse_core_sets(FLAGS_concurrency_cores);
+    mgb_log("run %zu model instances concurrently, %s", nr_workers,
+            qps > 0 ? mgb::ssprintf("at %.3f qps in total", qps).c_str()
+                    : "in closed loop");
+
+    // the models are set up one by one, since the options are shared
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t nr_ready = 0;
+    bool started = false;
+    Clock::time_point start;
+    std::vector<std::shared_ptr<ModelBase>> models(nr_workers);
+    std::vector<std::vector<double>> latencies(nr_workers);
+    std::vector<Clock::time_point> finish(nr_workers);
+    auto worker = [&](size_t idx) {
+        if (!core_sets.empty())
+            bind_cores(core_sets[idx % core_sets.size()]);
+        {
+            std::unique_lock<std::mutex> lock{mtx};
+            models[idx] = setup_model();
+            ++nr_ready;
+            cv.notify_all();
+            cv.wait(lock, [&]() { return started; });
+        }
+        auto&& model = models[idx];
+        auto&& latency = latencies[idx];
+        auto run_num = m_runtime_param.run_iter;
+        // the requests of the workers are interleaved evenly at the fixed qps
+        auto interval = std::chrono::duration<double>(qps > 0 ? nr_workers / qps : 0);
+        auto offset = interval * (static_cast<double>(idx) / nr_workers);
+        for (size_t i = 0; i < run_num; ++i) {
+            auto begin = Clock::now();
+            if (qps > 0) {
+                auto target = start + std::chrono::duration_cast<Clock::duration>(
+                                              interval * i + offset);
+                std::this_thread::sleep_until(target);
+                // the latency includes the time behind the schedule
+                begin = target;
+            }
+            model->run_model();
+            model->wait();
+            latency.push_back(
+                    std::chrono::duration<double, std::milli>(Clock::now() - begin)
+                            .count());
+        }
+        finish[idx] = Clock::now();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nr_workers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    CoreTimes core_begin;
+    {
+        std::unique_lock<std::mutex> lock{mtx};
+        cv.wait(lock, [&]() { return nr_ready == nr_workers; });
+        core_begin = CoreTimes::get();
+        start = Clock::now();
+        started = true;
+        cv.notify_all();
+    }
+    for (auto&& i : threads) {
+        i.join();
+    }
+    auto core_end = CoreTimes::get();
+
+    std::vector<double> all;
+    for (auto&& i : latencies) {
+        all.insert(all.end(), i.begin(), i.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto end = *std::max_element(finish.begin(), finish.end());
+    double time = std::chrono::duration<double, std::milli>(end - start).count();
+    double sum = 0;
+    for (auto i : all) {
+        sum += i;
+    }
+    mgb_log("=== concurrency=%zu requests=%zu time=%.3f ms throughput=%.3f qps",
+            nr_workers, all.size(), time, time > 0 ? all.size() * 1e3 / time : 0.);
+    if (!all.empty()) {
+        mgb_log("=== latency: avg=%.3f ms p50=%.3f ms p90=%.3f ms p99=%.3f ms "
+                "max=%.3f ms",
+                sum / all.size(), percentile(all, 0.5), percentile(all, 0.9),
+                percentile(all, 0.99), all.back());
+    }
+    if (core_begin.total.size() == core_end.total.size()) {
+        std::string util;
+        for (size_t i = 0; i < core_end.total.size(); ++i) {
+            auto total = core_end.total[i] - core_begin.total[i];
+            auto busy = core_end.busy[i] - core_begin.busy[i];
+            util += mgb::ssprintf(
+                    " cpu%zu=%.1f%%", i, total ? busy * 100. / total : 0.);
+        }
+        if (!util.empty())
+            mgb_log("=== core utilization:%s", util.c_str());
+    }
+
+    m_runtime_param.stage = RunStage::AFTER_MODEL_RUNNING;
+    for (auto&& i : models) {
+        config_model(i);
+    }
+#else
+    mgb_log_error(
+            "--concurrency requested, but load_and_run was compiled without "
+            "<thread> support.");
+#endif
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "strategy.h"
+
+namespace lar {
+/*!
+ * \brief: strategy for measuring the throughput of concurrent model instances
+ */
+class ThroughputStrategy : public StrategyBase {
+public:
+    ThroughputStrategy(std::string model_path);
+
+    //! run the model instances concurrently and report the statistics
+    void run() override;
+
+private:
+    //! create, load and warm up a model instance
+    std::shared_ptr<ModelBase> setup_model();
+
+    //! configure the model for the current runtime stage
+    void config_model(std::shared_ptr<ModelBase> model);
+
+    std::string m_model_path;
+};
+}  // namespace lar
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
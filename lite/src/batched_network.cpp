@@ -0,0 +1,249 @@
+#include "lite_build_config.h"
+
+#include "lite/network.h"
+#include "misc.h"
+#include "network_impl_base.h"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+
+#if !__DEPLOY_ON_XP_SP2__
+#include <condition_variable>
+#include <thread>
+#endif
+
+using namespace lite;
+
+#if !__DEPLOY_ON_XP_SP2__
+
+class BatchedNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network> network, const BatchConfig& config);
+    ~Impl();
+
+    std::future<Outputs> submit(const Outputs& inputs);
+
+    size_t nr_forward() const { return m_nr_forward.load(); }
+
+private:
+    struct Request {
+        Outputs inputs;
+        size_t batch;
+        std::promise<Outputs> promise;
+    };
+
+    //! the worker thread loop, which collects the requests and forwards them
+    void worker();
+
+    //! merge the inputs of the requests, forward the network and split the
+    //! outputs to the requests
+    void run_batch(std::vector<Request>& requests);
+
+    std::shared_ptr<Network> m_network;
+    BatchConfig m_config;
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::deque<Request> m_queue;
+    bool m_stop = false;
+    std::atomic_size_t m_nr_forward{0};
+    std::thread m_worker;
+};
+
+BatchedNetwork::Impl::Impl(std::shared_ptr<Network> network, const BatchConfig& config)
+        : m_network{std::move(network)}, m_config{config} {
+    LITE_ASSERT(m_network, "BatchedNetwork is constructed with an empty network.");
+    LITE_ASSERT(
+            NetworkHelper::loaded(m_network),
+            "BatchedNetwork should be constructed after the network loaded.");
+    LITE_ASSERT(m_config.max_batch_size > 0, "max_batch_size of BatchedNetwork is 0.");
+    if (!NetworkHelper::config(m_network).options.no_profiling_on_shape_change) {
+        LITE_WARN(
+                "the network of BatchedNetwork is not loaded with "
+                "no_profiling_on_shape_change, each new batch size may be "
+                "profiled again.");
+    }
+    m_worker = std::thread{[this]() { worker(); }};
+}
+
+BatchedNetwork::Impl::~Impl() {
+    {
+        LITE_LOCK_GUARD(m_mtx);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_worker.join();
+}
+
+std::future<BatchedNetwork::Outputs> BatchedNetwork::Impl::submit(
+        const Outputs& inputs) {
+    size_t nr_input = m_network->get_all_input_name().size();
+    LITE_ASSERT(
+            inputs.size() == nr_input,
+            "the request has %zu inputs, but the network has %zu inputs.",
+            inputs.size(), nr_input);
+    size_t batch = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        auto layout = inputs[i]->get_layout();
+        LITE_ASSERT(layout.ndim > 0, "the %zu-th input of the request is empty.", i);
+        if (i == 0) {
+            batch = layout.shapes[0];
+        }
+        LITE_ASSERT(
+                layout.shapes[0] == batch,
+                "the batch dim of the inputs in one request must be the same.");
+    }
+    LITE_ASSERT(
+            batch > 0 && batch <= m_config.max_batch_size,
+            "the request batch %zu is not in (0, %zu].", batch,
+            m_config.max_batch_size);
+
+    Request request{inputs, batch, {}};
+    auto future = request.promise.get_future();
+    {
+        LITE_LOCK_GUARD(m_mtx);
+        LITE_ASSERT(!m_stop, "submit to a stopped BatchedNetwork.");
+        m_queue.emplace_back(std::move(request));
+    }
+    m_cv.notify_one();
+    return future;
+}
+
+void BatchedNetwork::Impl::worker() {
+    auto has_request = [this]() { return m_stop || !m_queue.empty(); };
+    while (true) {
+        std::vector<Request> requests;
+        size_t nr_batch = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_cv.wait(lock, has_request);
+            if (m_queue.empty()) {
+                return;
+            }
+            //! move the queued requests into the batch until it is full,
+            //! return false when the next request does not fit
+            auto take = [&]() {
+                while (!m_queue.empty()) {
+                    auto&& front = m_queue.front();
+                    if (nr_batch + front.batch > m_config.max_batch_size) {
+                        return false;
+                    }
+                    nr_batch += front.batch;
+                    requests.emplace_back(std::move(front));
+                    m_queue.pop_front();
+                }
+                return true;
+            };
+            auto deadline = std::chrono::steady_clock::now() +
+                            std::chrono::microseconds(m_config.max_delay_us);
+            while (take() && nr_batch < m_config.max_batch_size && !m_stop) {
+                if (!m_cv.wait_until(lock, deadline, has_request)) {
+                    break;
+                }
+            }
+        }
+        run_batch(requests);
+    }
+}
+
+void BatchedNetwork::Impl::run_batch(std::vector<Request>& requests) {
+#if LITE_ENABLE_EXCEPTION
+    try {
+#endif
+        auto&& first = requests[0].inputs;
+        size_t nr_batch = 0;
+        for (auto&& request : requests) {
+            nr_batch += request.batch;
+        }
+        for (size_t i = 0; i < first.size(); i++) {
+            auto layout = first[i]->get_layout();
+            for (auto&& request : requests) {
+                auto request_layout = request.inputs[i]->get_layout();
+                bool same = request_layout.ndim == layout.ndim &&
+                            request_layout.data_type == layout.data_type;
+                for (size_t dim = 1; same && dim < layout.ndim; dim++) {
+                    same = request_layout.shapes[dim] == layout.shapes[dim];
+                }
+                LITE_ASSERT(
+                        same,
+                        "the %zu-th inputs of the merged requests differ besides "
+                        "the batch dim.",
+                        i);
+            }
+            layout.shapes[0] = nr_batch;
+            auto input = m_network->get_input_tensor(i);
+            input->set_layout(layout);
+            size_t offset = 0;
+            for (auto&& request : requests) {
+                input->slice({offset}, {offset + request.batch})
+                        ->copy_from(*request.inputs[i]);
+                offset += request.batch;
+            }
+        }
+
+        m_network->forward();
+        m_network->wait();
+        m_nr_forward++;
+
+        size_t nr_output = m_network->get_all_output_name().size();
+        std::vector<Outputs> results(requests.size());
+        for (size_t i = 0; i < nr_output; i++) {
+            auto output = m_network->get_output_tensor(i);
+            LITE_ASSERT(
+                    output->get_layout().ndim > 0 &&
+                            output->get_layout().shapes[0] == nr_batch,
+                    "the %zu-th output does not have the batch dim of the inputs.",
+                    i);
+            size_t offset = 0;
+            for (size_t r = 0; r < requests.size(); r++) {
+                auto result = std::make_shared<Tensor>();
+                result->copy_from(*output->slice({offset}, {offset + requests[r].batch}));
+                results[r].emplace_back(std::move(result));
+                offset += requests[r].batch;
+            }
+        }
+        for (size_t r = 0; r < requests.size(); r++) {
+            requests[r].promise.set_value(std::move(results[r]));
+        }
+#if LITE_ENABLE_EXCEPTION
+    } catch (...) {
+        for (auto&& request : requests) {
+            request.promise.set_exception(std::current_exception());
+        }
+    }
+#endif
+}
+
+#else
+
+class BatchedNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network>, const BatchConfig&) {
+        LITE_THROW("BatchedNetwork is not supported without thread.");
+    }
+    std::future<Outputs> submit(const Outputs&) { return {}; }
+    size_t nr_forward() const { return 0; }
+};
+
+#endif
+
+BatchedNetwork::BatchedNetwork(
+        std::shared_ptr<Network> network, const BatchConfig& config) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl = std::make_unique<Impl>(std::move(network), config);
+    LITE_ERROR_HANDLER_END
+}
+
+BatchedNetwork::~BatchedNetwork() = default;
+
+std::future<BatchedNetwork::Outputs> BatchedNetwork::submit(const Outputs& inputs) {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->submit(inputs);
+    LITE_ERROR_HANDLER_END
+}
+
+size_t BatchedNetwork::get_nr_forward() const {
+    return m_impl->nr_forward();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
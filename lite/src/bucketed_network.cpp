@@ -0,0 +1,148 @@
+#include "lite_build_config.h"
+
+#include "lite/network.h"
+#include "misc.h"
+#include "network_impl_base.h"
+
+#include <algorithm>
+#include <list>
+
+using namespace lite;
+
+class BucketedNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network> network, const BucketConfig& config);
+
+    Outputs forward(const Outputs& inputs);
+
+    size_t nr_cached() const { return m_contexts.size(); }
+
+    size_t nr_created() const { return m_nr_created; }
+
+private:
+    //! the padded input shapes, ndim followed by the shape of each input
+    using Key = std::vector<size_t>;
+
+    //! get the context of the key, create it if it is not cached
+    std::shared_ptr<Network> get_context(const Key& key);
+
+    std::shared_ptr<Network> m_network;
+    BucketConfig m_config;
+    //! the most recently used context is at the front
+    std::list<std::pair<Key, std::shared_ptr<Network>>> m_contexts;
+    size_t m_nr_created = 0;
+};
+
+BucketedNetwork::Impl::Impl(std::shared_ptr<Network> network, const BucketConfig& config)
+        : m_network{std::move(network)}, m_config{config} {
+    LITE_ASSERT(m_network, "BucketedNetwork is constructed with an empty network.");
+    LITE_ASSERT(
+            NetworkHelper::loaded(m_network),
+            "BucketedNetwork should be constructed after the network loaded.");
+    LITE_ASSERT(m_config.capacity > 0, "capacity of BucketedNetwork is 0.");
+    LITE_ASSERT(
+            std::is_sorted(m_config.buckets.begin(), m_config.buckets.end()),
+            "the buckets of BucketedNetwork must be sorted.");
+}
+
+std::shared_ptr<Network> BucketedNetwork::Impl::get_context(const Key& key) {
+    for (auto iter = m_contexts.begin(); iter != m_contexts.end(); iter++) {
+        if (iter->first == key) {
+            m_contexts.splice(m_contexts.begin(), m_contexts, iter);
+            return m_contexts.front().second;
+        }
+    }
+    if (m_contexts.size() >= m_config.capacity) {
+        m_contexts.pop_back();
+    }
+    m_contexts.emplace_front(key, Runtime::create_execution_context(m_network));
+    m_nr_created++;
+    return m_contexts.front().second;
+}
+
+BucketedNetwork::Outputs BucketedNetwork::Impl::forward(const Outputs& inputs) {
+    size_t nr_input = m_network->get_all_input_name().size();
+    LITE_ASSERT(
+            inputs.size() == nr_input,
+            "the forward has %zu inputs, but the network has %zu inputs.",
+            inputs.size(), nr_input);
+    auto axis = m_config.pad_axis;
+    std::vector<Layout> padded_layouts;
+    Key key;
+    //! the size of the first padded input along the pad axis before padding
+    size_t origin_size = 0;
+    for (auto&& input : inputs) {
+        auto layout = input->get_layout();
+        if (layout.ndim > axis) {
+            auto size = layout.shapes[axis];
+            auto bucket = std::lower_bound(
+                    m_config.buckets.begin(), m_config.buckets.end(), size);
+            if (bucket != m_config.buckets.end() && *bucket != size) {
+                if (!origin_size) {
+                    origin_size = size;
+                }
+                layout.shapes[axis] = *bucket;
+            }
+        }
+        key.push_back(layout.ndim);
+        key.insert(key.end(), layout.shapes, layout.shapes + layout.ndim);
+        padded_layouts.push_back(layout);
+    }
+
+    auto context = get_context(key);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        auto dst = context->get_input_tensor(i);
+        auto&& layout = padded_layouts[i];
+        if (layout.ndim <= axis ||
+            layout.shapes[axis] == inputs[i]->get_layout().shapes[axis]) {
+            dst->copy_from(*inputs[i]);
+            continue;
+        }
+        dst->set_layout(layout);
+        dst->fill_zero();
+        std::vector<size_t> start(axis + 1, 0), end(layout.shapes, layout.shapes + axis);
+        end.push_back(inputs[i]->get_layout().shapes[axis]);
+        dst->slice(start, end)->copy_from(*inputs[i]);
+    }
+
+    context->forward();
+    context->wait();
+
+    Outputs outputs;
+    size_t nr_output = m_network->get_all_output_name().size();
+    for (size_t i = 0; i < nr_output; i++) {
+        auto output = context->get_output_tensor(i);
+        auto&& layout = output->get_layout();
+        if (axis == 0 && origin_size && layout.ndim > 0 &&
+            layout.shapes[0] > origin_size) {
+            output = output->slice({0}, {origin_size});
+        }
+        outputs.emplace_back(std::move(output));
+    }
+    return outputs;
+}
+
+BucketedNetwork::BucketedNetwork(
+        std::shared_ptr<Network> network, const BucketConfig& config) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl = std::make_unique<Impl>(std::move(network), config);
+    LITE_ERROR_HANDLER_END
+}
+
+BucketedNetwork::~BucketedNetwork() = default;
+
+BucketedNetwork::Outputs BucketedNetwork::forward(const Outputs& inputs) {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->forward(inputs);
+    LITE_ERROR_HANDLER_END
+}
+
+size_t BucketedNetwork::get_nr_cached() const {
+    return m_impl->nr_cached();
+}
+
+size_t BucketedNetwork::get_nr_created() const {
+    return m_impl->nr_created();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
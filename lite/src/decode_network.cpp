@@ -0,0 +1,401 @@
+#include "lite_build_config.h"
+
+#include "lite/network.h"
+#include "misc.h"
+#include "network_impl_base.h"
+
+#include <algorithm>
+#include <deque>
+
+using namespace lite;
+
+/* ===================== KVBlockAllocator ===================== */
+
+KVBlockAllocator::KVBlockAllocator(size_t nr_blocks, size_t block_size)
+        : m_block_size{block_size} {
+    LITE_ASSERT(block_size > 0, "block_size of KVBlockAllocator is 0.");
+    for (size_t i = nr_blocks; i > 0; i--) {
+        m_free_blocks.push_back(static_cast<int>(i - 1));
+    }
+}
+
+void KVBlockAllocator::add_sequence(size_t seq_id) {
+    LITE_ASSERT(
+            m_block_tables.emplace(seq_id, std::vector<int>{}).second,
+            "sequence %zu is already in the kv cache.", seq_id);
+}
+
+void KVBlockAllocator::remove_sequence(size_t seq_id) {
+    auto iter = m_block_tables.find(seq_id);
+    LITE_ASSERT(iter != m_block_tables.end(), "sequence %zu is not found.", seq_id);
+    //! the first block of the sequence is taken again first
+    m_free_blocks.insert(
+            m_free_blocks.end(), iter->second.rbegin(), iter->second.rend());
+    m_block_tables.erase(iter);
+}
+
+bool KVBlockAllocator::has_sequence(size_t seq_id) const {
+    return m_block_tables.count(seq_id);
+}
+
+bool KVBlockAllocator::reserve(size_t seq_id, size_t length) {
+    auto iter = m_block_tables.find(seq_id);
+    LITE_ASSERT(iter != m_block_tables.end(), "sequence %zu is not found.", seq_id);
+    auto&& blocks = iter->second;
+    size_t nr_needed = (length + m_block_size - 1) / m_block_size;
+    if (nr_needed <= blocks.size()) {
+        return true;
+    }
+    if (nr_needed - blocks.size() > m_free_blocks.size()) {
+        return false;
+    }
+    while (blocks.size() < nr_needed) {
+        blocks.push_back(m_free_blocks.back());
+        m_free_blocks.pop_back();
+    }
+    return true;
+}
+
+const std::vector<int>& KVBlockAllocator::get_block_table(size_t seq_id) const {
+    auto iter = m_block_tables.find(seq_id);
+    LITE_ASSERT(iter != m_block_tables.end(), "sequence %zu is not found.", seq_id);
+    return iter->second;
+}
+
+/* ===================== DecodeNetwork ===================== */
+
+class DecodeNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network> prefill, std::shared_ptr<Network> decode,
+         const DecodeConfig& config);
+
+    size_t submit(const std::vector<int>& prompt, size_t max_new_tokens);
+
+    std::vector<size_t> step();
+
+    bool idle() const { return m_waiting.empty() && m_running.empty(); }
+
+    std::vector<int> get_generated(size_t seq_id) const;
+
+    void release(size_t seq_id);
+
+    size_t nr_running() const { return m_running.size(); }
+
+    size_t nr_free_blocks() const { return m_allocator.get_nr_free_blocks(); }
+
+private:
+    struct Sequence {
+        //! the prompt followed by the generated tokens
+        std::vector<int> tokens;
+        size_t prompt_len;
+        size_t max_new_tokens;
+        //! the number of tokens whose keys and values are in the cache
+        size_t nr_cached = 0;
+        bool finished = false;
+    };
+
+    //! allocate the caches and bind them to the cache inputs of both networks
+    void init_caches();
+
+    //! prefill the first waiting sequence, return false if it does not fit
+    bool try_prefill(std::vector<size_t>& finished);
+
+    //! decode one token of each running sequence
+    void decode(std::vector<size_t>& finished);
+
+    //! forward the tokens of the sequences starting from their cached tokens,
+    //! and append the greedy next token of each sequence
+    void forward(
+            const std::shared_ptr<Network>& network, const std::vector<size_t>& seqs,
+            size_t seqlen);
+
+    //! drop the cache of the latest admitted running sequence and queue it to
+    //! be prefilled again
+    void preempt_last();
+
+    //! check the sequence after a token is generated, the finished ones are
+    //! removed from the cache
+    bool check_finished(size_t seq_id);
+
+    Sequence& get_seq(size_t seq_id);
+
+    std::shared_ptr<Network> m_prefill, m_decode;
+    DecodeConfig m_config;
+    KVBlockAllocator m_allocator;
+    std::vector<std::shared_ptr<Tensor>> m_caches;
+    std::unordered_map<size_t, Sequence> m_seqs;
+    std::deque<size_t> m_waiting;
+    //! in the order of admission
+    std::vector<size_t> m_running;
+    size_t m_next_id = 0;
+};
+
+DecodeNetwork::Impl::Impl(
+        std::shared_ptr<Network> prefill, std::shared_ptr<Network> decode,
+        const DecodeConfig& config)
+        : m_prefill{std::move(prefill)},
+          m_decode{std::move(decode)},
+          m_config{config},
+          m_allocator{config.nr_blocks, config.block_size} {
+    LITE_ASSERT(
+            m_prefill && m_decode,
+            "DecodeNetwork is constructed with an empty network.");
+    LITE_ASSERT(
+            NetworkHelper::loaded(m_prefill) && NetworkHelper::loaded(m_decode),
+            "DecodeNetwork should be constructed after the networks loaded.");
+    LITE_ASSERT(m_config.max_batch_size > 0, "max_batch_size of DecodeNetwork is 0.");
+    init_caches();
+}
+
+void DecodeNetwork::Impl::init_caches() {
+    auto&& prefix = m_config.cache_prefix;
+    for (auto&& name : m_prefill->get_all_input_name()) {
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        auto input = m_prefill->get_io_tensor(name, LiteTensorPhase::LITE_INPUT);
+        auto layout = input->get_layout();
+        LITE_ASSERT(
+                layout.ndim == 4 && layout.shapes[2] == m_config.block_size,
+                "the cache input %s should be (nr_blocks, num_heads, %zu, head_dim).",
+                name.c_str(), m_config.block_size);
+        layout.shapes[0] = m_config.nr_blocks;
+        auto cache = std::make_shared<Tensor>(
+                m_prefill->get_device_id(), m_prefill->get_device_type(), layout);
+        cache->fill_zero();
+        input->share_memory_with(*cache);
+        if (m_decode != m_prefill) {
+            m_decode->get_io_tensor(name, LiteTensorPhase::LITE_INPUT)
+                    ->share_memory_with(*cache);
+        }
+        m_caches.emplace_back(std::move(cache));
+    }
+    LITE_ASSERT(
+            !m_caches.empty(), "the model of DecodeNetwork has no input named %s*.",
+            prefix.c_str());
+}
+
+DecodeNetwork::Impl::Sequence& DecodeNetwork::Impl::get_seq(size_t seq_id) {
+    auto iter = m_seqs.find(seq_id);
+    LITE_ASSERT(iter != m_seqs.end(), "sequence %zu is not found.", seq_id);
+    return iter->second;
+}
+
+size_t DecodeNetwork::Impl::submit(
+        const std::vector<int>& prompt, size_t max_new_tokens) {
+    LITE_ASSERT(!prompt.empty(), "the prompt of a sequence is empty.");
+    size_t seq_id = m_next_id++;
+    auto&& seq = m_seqs[seq_id];
+    seq.tokens = prompt;
+    seq.prompt_len = prompt.size();
+    seq.max_new_tokens = max_new_tokens;
+    seq.finished = !max_new_tokens;
+    if (!seq.finished) {
+        m_waiting.push_back(seq_id);
+    }
+    return seq_id;
+}
+
+std::vector<size_t> DecodeNetwork::Impl::step() {
+    std::vector<size_t> finished;
+    if (m_running.size() < m_config.max_batch_size && !m_waiting.empty() &&
+        try_prefill(finished)) {
+        return finished;
+    }
+    if (!m_running.empty()) {
+        decode(finished);
+    }
+    return finished;
+}
+
+bool DecodeNetwork::Impl::try_prefill(std::vector<size_t>& finished) {
+    size_t seq_id = m_waiting.front();
+    auto&& seq = get_seq(seq_id);
+    m_allocator.add_sequence(seq_id);
+    if (!m_allocator.reserve(seq_id, seq.tokens.size())) {
+        m_allocator.remove_sequence(seq_id);
+        LITE_ASSERT(
+                !m_running.empty(),
+                "the kv cache of %zu blocks is too small for a sequence of %zu "
+                "tokens.",
+                m_config.nr_blocks, seq.tokens.size());
+        return false;
+    }
+    m_waiting.pop_front();
+    forward(m_prefill, {seq_id}, seq.tokens.size());
+    if (check_finished(seq_id)) {
+        finished.push_back(seq_id);
+    } else {
+        m_running.push_back(seq_id);
+    }
+    return true;
+}
+
+void DecodeNetwork::Impl::preempt_last() {
+    size_t seq_id = m_running.back();
+    m_running.pop_back();
+    m_allocator.remove_sequence(seq_id);
+    get_seq(seq_id).nr_cached = 0;
+    m_waiting.push_front(seq_id);
+}
+
+void DecodeNetwork::Impl::decode(std::vector<size_t>& finished) {
+    for (size_t i = 0; i < m_running.size(); i++) {
+        size_t seq_id = m_running[i];
+        while (!m_allocator.reserve(seq_id, get_seq(seq_id).nr_cached + 1)) {
+            LITE_ASSERT(
+                    m_running.size() > 1,
+                    "the kv cache of %zu blocks is too small for a sequence of "
+                    "%zu tokens.",
+                    m_config.nr_blocks, get_seq(seq_id).nr_cached + 1);
+            bool self = m_running.back() == seq_id;
+            preempt_last();
+            if (self) {
+                break;
+            }
+        }
+    }
+    if (m_running.empty()) {
+        return;
+    }
+    forward(m_decode, m_running, 1);
+    std::vector<size_t> running;
+    for (auto seq_id : m_running) {
+        if (check_finished(seq_id)) {
+            finished.push_back(seq_id);
+        } else {
+            running.push_back(seq_id);
+        }
+    }
+    m_running.swap(running);
+}
+
+void DecodeNetwork::Impl::forward(
+        const std::shared_ptr<Network>& network, const std::vector<size_t>& seqs,
+        size_t seqlen) {
+    size_t batch = seqs.size(), max_nr_blocks = 0;
+    for (auto seq_id : seqs) {
+        max_nr_blocks = std::max(
+                max_nr_blocks, m_allocator.get_block_table(seq_id).size());
+    }
+    std::vector<int> tokens, positions, block_table(batch * max_nr_blocks, 0);
+    for (size_t i = 0; i < batch; i++) {
+        auto&& seq = get_seq(seqs[i]);
+        LITE_ASSERT(
+                seq.nr_cached + seqlen == seq.tokens.size(),
+                "the uncached tokens of sequence %zu are not %zu.", seqs[i], seqlen);
+        tokens.insert(tokens.end(), seq.tokens.end() - seqlen, seq.tokens.end());
+        positions.push_back(static_cast<int>(seq.nr_cached));
+        auto&& blocks = m_allocator.get_block_table(seqs[i]);
+        std::copy(
+                blocks.begin(), blocks.end(), block_table.begin() + i * max_nr_blocks);
+    }
+
+    auto set_input = [&](const std::string& name, std::vector<int>& data,
+                         const Layout& layout) {
+        Tensor host{LiteDeviceType::LITE_CPU};
+        host.reset(data.data(), layout);
+        network->get_io_tensor(name, LiteTensorPhase::LITE_INPUT)->copy_from(host);
+    };
+    set_input(
+            m_config.tokens_name, tokens,
+            Layout{{batch, seqlen}, 2, LiteDataType::LITE_INT});
+    set_input(
+            m_config.positions_name, positions,
+            Layout{{batch}, 1, LiteDataType::LITE_INT});
+    set_input(
+            m_config.block_table_name, block_table,
+            Layout{{batch, max_nr_blocks}, 2, LiteDataType::LITE_INT});
+    network->forward();
+    network->wait();
+
+    Tensor logits{LiteDeviceType::LITE_CPU};
+    logits.copy_from(*network->get_io_tensor(
+            m_config.logits_name, LiteTensorPhase::LITE_OUTPUT));
+    auto&& layout = logits.get_layout();
+    LITE_ASSERT(
+            layout.data_type == LiteDataType::LITE_FLOAT && layout.ndim >= 2 &&
+                    layout.shapes[0] == batch,
+            "the logits should be float32 of shape (batch, seqlen, vocab).");
+    size_t vocab = layout.shapes[layout.ndim - 1],
+           rows = layout.get_elem_size() / (batch * vocab);
+    auto ptr = static_cast<const float*>(logits.get_memory_ptr());
+    for (size_t i = 0; i < batch; i++) {
+        //! only the logits of the last token are used
+        auto row = ptr + (i * rows + rows - 1) * vocab;
+        auto&& seq = get_seq(seqs[i]);
+        auto next = std::max_element(row, row + vocab) - row;
+        seq.tokens.push_back(static_cast<int>(next));
+        seq.nr_cached += seqlen;
+    }
+}
+
+bool DecodeNetwork::Impl::check_finished(size_t seq_id) {
+    auto&& seq = get_seq(seq_id);
+    bool eos = m_config.eos_token >= 0 && seq.tokens.back() == m_config.eos_token;
+    if (eos || seq.tokens.size() - seq.prompt_len >= seq.max_new_tokens) {
+        seq.finished = true;
+        m_allocator.remove_sequence(seq_id);
+    }
+    return seq.finished;
+}
+
+std::vector<int> DecodeNetwork::Impl::get_generated(size_t seq_id) const {
+    auto iter = m_seqs.find(seq_id);
+    LITE_ASSERT(iter != m_seqs.end(), "sequence %zu is not found.", seq_id);
+    auto&& tokens = iter->second.tokens;
+    return {tokens.begin() + iter->second.prompt_len, tokens.end()};
+}
+
+void DecodeNetwork::Impl::release(size_t seq_id) {
+    LITE_ASSERT(get_seq(seq_id).finished, "sequence %zu is not finished.", seq_id);
+    m_seqs.erase(seq_id);
+}
+
+DecodeNetwork::DecodeNetwork(
+        std::shared_ptr<Network> prefill, std::shared_ptr<Network> decode,
+        const DecodeConfig& config) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl = std::make_unique<Impl>(std::move(prefill), std::move(decode), config);
+    LITE_ERROR_HANDLER_END
+}
+
+DecodeNetwork::~DecodeNetwork() = default;
+
+size_t DecodeNetwork::submit(const std::vector<int>& prompt, size_t max_new_tokens) {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->submit(prompt, max_new_tokens);
+    LITE_ERROR_HANDLER_END
+}
+
+std::vector<size_t> DecodeNetwork::step() {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->step();
+    LITE_ERROR_HANDLER_END
+}
+
+bool DecodeNetwork::idle() const {
+    return m_impl->idle();
+}
+
+std::vector<int> DecodeNetwork::get_generated(size_t seq_id) const {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->get_generated(seq_id);
+    LITE_ERROR_HANDLER_END
+}
+
+void DecodeNetwork::release(size_t seq_id) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl->release(seq_id);
+    LITE_ERROR_HANDLER_END
+}
+
+size_t DecodeNetwork::get_nr_running() const {
+    return m_impl->nr_running();
+}
+
+size_t DecodeNetwork::get_nr_free_blocks() const {
+    return m_impl->nr_free_blocks();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -1,10 +1,18 @@
 #include "./mbedtls/aes.h"
 #include "decrypt_base.h"
 
+#include <algorithm>
+#if !__DEPLOY_ON_XP_SP2__
+#include <thread>
+#endif
+
 namespace lite {
 
 class AESDcryption {
 public:
+    //! the least number of bytes decrypted by one thread
+    static constexpr size_t MIN_BYTES_PER_THREAD = 1 << 20;
+
     static std::vector<uint8_t> decrypt_model(
             const void* model_mem, size_t size, const std::vector<uint8_t>& key) {
         mbedtls_aes_context ctx;
@@ -12,18 +20,45 @@ public:
         mbedtls_aes_setkey_dec(&ctx, key.data(), 256);
 
         auto data = static_cast<const uint8_t*>(model_mem);
-        //! first 16 bytes is IV
-        uint8_t iv[16];
         //! last 8 bytes is file size(length)
         auto length_ptr = data + size - 8;
         size_t length = 0;
         for (int i = 0; i < 8; i++) {
-            length |= length_ptr[i] << (8 * (7 - i));
+            length |= static_cast<size_t>(length_ptr[i]) << (8 * (7 - i));
         }
-        std::copy(data, data + 16, iv);
         auto output = std::vector<uint8_t>(size - 24);
-        mbedtls_aes_crypt_cbc(
-                &ctx, MBEDTLS_AES_DECRYPT, size - 24, iv, data + 16, output.data());
+
+        //! each plain block of CBC only depends on two cipher blocks, so the
+        //! chunks can be decrypted in parallel, where the IV of a chunk is the
+        //! last cipher block before it and the first 16 bytes is the IV of the
+        //! whole model
+        size_t nr_blocks = (size - 24) / 16;
+        size_t nr_threads = std::max<size_t>(
+                std::min<size_t>(
+                        nr_blocks * 16 / MIN_BYTES_PER_THREAD, max_nr_threads()),
+                1);
+        size_t blocks_per_thread = (nr_blocks + nr_threads - 1) / nr_threads;
+        auto decrypt_chunk = [&](size_t idx) {
+            size_t begin = std::min(idx * blocks_per_thread, nr_blocks),
+                   end = std::min(begin + blocks_per_thread, nr_blocks);
+            uint8_t iv[16];
+            std::copy(data + begin * 16, data + begin * 16 + 16, iv);
+            mbedtls_aes_crypt_cbc(
+                    &ctx, MBEDTLS_AES_DECRYPT, (end - begin) * 16, iv,
+                    data + 16 + begin * 16, output.data() + begin * 16);
+        };
+#if !__DEPLOY_ON_XP_SP2__
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < nr_threads; ++i) {
+            workers.emplace_back(decrypt_chunk, i);
+        }
+        decrypt_chunk(0);
+        for (auto&& i : workers) {
+            i.join();
+        }
+#else
+        decrypt_chunk(0);
+#endif
         mbedtls_aes_free(&ctx);
         output.erase(output.begin() + length, output.end());
         return output;
@@ -36,6 +71,15 @@ public:
                0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F};
         return key;
     }
+
+private:
+    static size_t max_nr_threads() {
+#if !__DEPLOY_ON_XP_SP2__
+        return std::max(std::thread::hardware_concurrency(), 1u);
+#else
+        return 1;
+#endif
+    }
 };
 }  // namespace lite
 
@@ -14,15 +14,28 @@
 #include "megbrain/comp_node.h"
 #include "megbrain/serialization/extern_c_opr.h"
 #include "megbrain/version.h"
+#include "megbrain/utils/hash.h"
 #include "megbrain/utils/infile_persistent_cache.h"
+#include "megbrain/utils/logfile_persistent_cache.h"
 #include "mge/common.h"
 #if MGB_ENABLE_TENSOR_RT
 #include "megbrain/tensorrt/tensorrt_engine_cache.h"
 #endif
 #endif
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <mutex>
+#include <set>
+#include <thread>
 #include <unordered_map>
+#if LITE_BUILD_WITH_MGE
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <direct.h>
+#endif
+#endif
 
 using namespace lite;
 
@@ -130,8 +143,51 @@ struct CacheControl {
     std::string cache_type = "file";
     std::atomic_size_t config_algo_times{0};
     std::atomic_size_t config_trt_times{0};
+    //! the fingerprint sub directory of set_artifact_dir
+    std::string artifact_dir;
 };
 CacheControl cache_control;
+
+//! the traits of this device which the optimized artifacts depend on
+std::string device_fingerprint() {
+    auto version = mgb::get_version();
+    std::string ret = ssprintf(
+            "mge=%d.%d.%d%s\n", version.major, version.minor, version.patch,
+            version.is_dev ? "-dev" : "");
+    //! the cores of big.LITTLE are listed as different parts
+    std::set<std::string> cpu_info;
+    std::ifstream fin("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(fin, line)) {
+        for (auto key : {"model name", "CPU implementer", "CPU part", "Hardware"}) {
+            if (!line.compare(0, strlen(key), key)) {
+                cpu_info.insert(line);
+            }
+        }
+    }
+    for (auto&& info : cpu_info) {
+        ret += info + "\n";
+    }
+    ret += ssprintf("nr_cpus=%u\n", std::thread::hardware_concurrency());
+    auto nr_cuda =
+            mgb::CompNode::get_device_count(mgb::CompNode::DeviceType::CUDA, false);
+    for (size_t i = 0; i < nr_cuda; ++i) {
+        auto cn = mgb::CompNode::load(ssprintf("gpu%zu", i));
+        ret += mgb::PersistentCache::make_category_from_comp_node(cn) + "\n";
+    }
+    return ret;
+}
+
+void make_dir(const std::string& dir) {
+#if defined(_WIN32)
+    int ret = _mkdir(dir.c_str());
+#else
+    int ret = mkdir(dir.c_str(), 0755);
+#endif
+    LITE_ASSERT(
+            !ret || errno == EEXIST, "failed to create %s: %s", dir.c_str(),
+            strerror(errno));
+}
 }  // namespace
 
 void lite::try_coalesce_all_free_memory() {
@@ -164,11 +220,37 @@ void lite::set_persistent_cache(const std::string& cache_path, bool always_sync)
             cache_path.c_str(), always_sync));
 }
 
+void lite::set_shared_persistent_cache(const std::string& cache_path) {
+    LITE_LOCK_GUARD(cache_control.cache_mutex);
+    cache_control.cache_type = "log_file";
+    if (cache_control.config_algo_times >= 1) {
+        LITE_WARN(
+                "The cache has been set，maybe some model is using now, change "
+                "it now may cause unknow error!!");
+    }
+    cache_control.config_algo_times++;
+    mgb::PersistentCache::set_impl(
+            std::make_shared<mgb::LogFilePersistentCache>(cache_path.c_str()));
+}
+
 void lite::dump_persistent_cache(const std::string& cache_path) {
     LITE_LOCK_GUARD(cache_control.cache_mutex);
     LITE_ASSERT(
-            cache_control.cache_type == "file",
+            cache_control.cache_type == "file" ||
+                    cache_control.cache_type == "log_file",
             "now cache type not correct, it can't be dumped.");
+    if (cache_control.cache_type == "log_file") {
+        //! dump in the format of set_persistent_cache
+        auto buf = static_cast<mgb::LogFilePersistentCache&>(
+                           mgb::PersistentCache::inst())
+                           .dump_cache();
+        FILE* fp = fopen(cache_path.c_str(), "wb");
+        LITE_ASSERT(fp, "failed to open %s", cache_path.c_str());
+        auto ret = fwrite(buf.data(), buf.size(), 1, fp);
+        fclose(fp);
+        LITE_ASSERT(buf.empty() || ret == 1, "failed to write %s", cache_path.c_str());
+        return;
+    }
     static_cast<mgb::InFilePersistentCache&>(mgb::PersistentCache::inst())
             .dump_cache(cache_path.c_str());
 }
@@ -202,6 +284,55 @@ void lite::dump_tensor_rt_cache() {
 #endif
 }
 
+void lite::set_artifact_dir(const std::string& dir) {
+    auto fingerprint = device_fingerprint();
+    auto hash = mgb::XXHash{}.update(fingerprint.data(), fingerprint.size()).digest();
+    auto sub_dir = ssprintf(
+            "%s/%016llx", dir.c_str(), static_cast<unsigned long long>(hash));
+    make_dir(dir);
+    make_dir(sub_dir);
+
+    //! the fingerprint is kept in the directory to validate the hash, it is
+    //! written to a temp file and renamed as other processes may read it
+    auto fingerprint_path = sub_dir + "/fingerprint";
+    std::ifstream fin(fingerprint_path, std::ios::binary);
+    if (fin.is_open()) {
+        std::string saved{
+                std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>()};
+        LITE_ASSERT(
+                saved == fingerprint,
+                "the artifacts in %s are produced on a different device.",
+                sub_dir.c_str());
+    } else {
+        auto tmp_path = make_tmp_path(fingerprint_path);
+        {
+            std::ofstream fout(tmp_path, std::ios::binary);
+            fout << fingerprint;
+            LITE_ASSERT(fout.good(), "failed to write %s", tmp_path.c_str());
+        }
+        if (rename(tmp_path.c_str(), fingerprint_path.c_str())) {
+            remove(tmp_path.c_str());
+        }
+    }
+
+    set_shared_persistent_cache(sub_dir + "/algo_cache");
+    LITE_LOCK_GUARD(cache_control.cache_mutex);
+#if MGB_ENABLE_TENSOR_RT
+    //! each engine is kept in a file, so no dump is needed
+    cache_control.config_trt_times++;
+    mgb::TensorRTEngineCache::enable_engine_cache(true);
+    mgb::TensorRTEngineCache::set_impl(
+            std::make_shared<mgb::TensorRTEngineCacheDir>(sub_dir));
+#endif
+    cache_control.artifact_dir = sub_dir;
+    LITE_LOG("use artifact dir: %s", sub_dir.c_str());
+}
+
+std::string lite::get_artifact_dir() {
+    LITE_LOCK_GUARD(cache_control.cache_mutex);
+    return cache_control.artifact_dir;
+}
+
 bool lite::register_memory_pair(
         void* vir_ptr, void* phy_ptr, size_t length, LiteDeviceType device,
         LiteBackend backend) {
@@ -241,6 +372,10 @@ void lite::set_persistent_cache(const std::string&, bool) {
     LITE_THROW("mge is disbale at build time, please build with mge");
 }
 
+void lite::set_shared_persistent_cache(const std::string&) {
+    LITE_THROW("mge is disbale at build time, please build with mge");
+}
+
 void lite::dump_persistent_cache(const std::string&) {
     LITE_THROW("mge is disbale at build time, please build with mge");
 }
@@ -254,6 +389,14 @@ void lite::dump_tensor_rt_cache() {
     LITE_THROW("mge is disbale at build time, please build with mge");
 }
 
+void lite::set_artifact_dir(const std::string&) {
+    LITE_THROW("mge is disbale at build time, please build with mge");
+}
+
+std::string lite::get_artifact_dir() {
+    return {};
+}
+
 bool lite::register_memory_pair(
         void* vir_ptr, void* phy_ptr, size_t length, LiteDeviceType device,
         LiteBackend beckend) {
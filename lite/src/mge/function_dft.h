@@ -98,6 +98,8 @@ inline void call_func<NetworkImplDft, void>(
         CALL_FUNC(set_cpu_threads_number, num);
     } else if (func_name == "set_network_algo_workspace_limit") {
         CALL_FUNC(set_network_algo_workspace_limit, num);
+    } else if (func_name == "set_cpu_numa_node") {
+        CALL_FUNC(set_cpu_numa_node, num);
     } else {
         THROW_FUNC_ERROR(func_name);
     }
@@ -122,6 +124,8 @@ inline size_t call_func<NetworkImplDft, size_t>(
         std::string func_name, Network::NetworkImplBase* network_impl) {
     if (func_name == "get_cpu_threads_number") {
         return CALL_FUNC(get_cpu_threads_number);
+    } else if (func_name == "get_static_memory_size") {
+        return CALL_FUNC(get_static_memory_size);
     }
     THROW_FUNC_ERROR(func_name);
 }
@@ -135,6 +139,45 @@ inline bool call_func<NetworkImplDft, bool>(
     THROW_FUNC_ERROR(func_name);
 }
 
+template <>
+inline void call_func<NetworkImplDft, void>(
+        std::string func_name, Network::NetworkImplBase* network_impl,
+        int64_t spin_us) {
+    if (func_name == "set_cpu_thread_spin_budget") {
+        CALL_FUNC(set_cpu_thread_spin_budget, spin_us);
+    } else {
+        THROW_FUNC_ERROR(func_name);
+    }
+}
+
+template <>
+inline std::vector<float> call_func<NetworkImplDft, std::vector<float>>(
+        std::string func_name, Network::NetworkImplBase* network_impl) {
+    if (func_name == "get_cpu_thread_speeds") {
+        return CALL_FUNC(get_cpu_thread_speeds);
+    }
+    THROW_FUNC_ERROR(func_name);
+}
+
+template <>
+inline void call_func<NetworkImplDft, void>(
+        std::string func_name, Network::NetworkImplBase* network_impl, bool enable) {
+    if (func_name == "set_cpu_thread_speed_weighted") {
+        CALL_FUNC(set_cpu_thread_speed_weighted, enable);
+    } else {
+        THROW_FUNC_ERROR(func_name);
+    }
+}
+
+template <>
+inline ThreadWaitStats call_func<NetworkImplDft, ThreadWaitStats>(
+        std::string func_name, Network::NetworkImplBase* network_impl, bool reset) {
+    if (func_name == "get_cpu_thread_wait_stats") {
+        return CALL_FUNC(get_cpu_thread_wait_stats, reset);
+    }
+    THROW_FUNC_ERROR(func_name);
+}
+
 template <>
 inline void call_func<NetworkImplDft, void>(
         std::string func_name, Network::NetworkImplBase* network_impl,
@@ -191,6 +234,30 @@ inline void call_func<NetworkImplDft, void>(
         CALL_FUNC(share_runtime_memory_with, src_network_impl);
     } else if (func_name == "shared_weight_with") {
         CALL_FUNC(shared_weight_with, src_network_impl);
+    } else if (func_name == "init_execution_context") {
+        CALL_FUNC(init_execution_context, src_network_impl);
+    } else {
+        THROW_FUNC_ERROR(func_name);
+    }
+}
+
+template <>
+inline void call_func<NetworkImplDft, void>(
+        std::string func_name, Network::NetworkImplBase* network_impl,
+        PartitionConfig config) {
+    if (func_name == "enable_heterogeneous_partition") {
+        CALL_FUNC(enable_heterogeneous_partition, config);
+    } else {
+        THROW_FUNC_ERROR(func_name);
+    }
+}
+
+template <>
+inline void call_func<NetworkImplDft, void>(
+        std::string func_name, Network::NetworkImplBase* network_impl,
+        std::shared_ptr<void> model_mem, size_t size) {
+    if (func_name == "update_weights") {
+        CALL_FUNC(update_weights, model_mem, size);
     } else {
         THROW_FUNC_ERROR(func_name);
     }
@@ -215,6 +282,25 @@ inline NetworkIO call_func<NetworkImplDft, NetworkIO>(
         THROW_FUNC_ERROR(func_name);
     }
 }
+template <>
+inline ModelInfo call_func<NetworkImplDft, ModelInfo>(
+        std::string func_name, std::string model_path, Config config) {
+    if (func_name == "get_model_info") {
+        return get_model_info_dft(model_path, config);
+    } else {
+        THROW_FUNC_ERROR(func_name);
+    }
+}
+
+template <>
+inline ModelInfo call_func<NetworkImplDft, ModelInfo>(
+        std::string func_name, const void* model_mem, size_t size, Config config) {
+    if (func_name == "get_model_info") {
+        return get_model_info_dft(model_mem, size, config);
+    } else {
+        THROW_FUNC_ERROR(func_name);
+    }
+}
 #undef THROW_FUNC_ERROR
 
 }  // namespace lite
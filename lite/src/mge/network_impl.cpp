@@ -2,6 +2,7 @@
 
 #if LITE_BUILD_WITH_MGE
 #include "common.h"
+#include "lite/global.h"
 #include "lite/network.h"
 #include "memory_allocator.h"
 #include "network_impl.h"
@@ -11,12 +12,15 @@
 #include "megbrain/common.h"
 #include "megbrain/comp_node.h"
 #include "megbrain/comp_node_env.h"
+#include "megbrain/gopt/misc.h"
 #include "megbrain/graph.h"
 #include "megbrain/graph/cg.h"
 #include "megbrain/opr/imgproc.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/tensor.h"
+#include "megbrain/utils/hash.h"
+#include "megbrain/utils/infile_persistent_cache.h"
 
 #if MGB_OPENCL
 #include "megcore_opencl.h"
@@ -26,9 +30,13 @@
 #include "cpuinfo.h"
 #endif
 
+#include <cerrno>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 using namespace lite;
 using namespace mgb;
@@ -50,6 +58,51 @@ void NetworkImplDft::shared_weight_with(const NetworkImplBase* src_network) {
     configure_after_loaded();
 }
 
+std::shared_ptr<const int> ExecutionContextIds::acquire(
+        const std::shared_ptr<ExecutionContextIds>& ids) {
+    LITE_LOCK_GUARD(ids->m_mtx);
+    int id;
+    if (ids->m_free_ids.empty()) {
+        id = ++ids->m_nr_id;
+    } else {
+        id = *ids->m_free_ids.begin();
+        ids->m_free_ids.erase(ids->m_free_ids.begin());
+    }
+    return {new int{id}, [ids](const int* ptr) {
+                LITE_LOCK_GUARD(ids->m_mtx);
+                ids->m_free_ids.insert(*ptr);
+                delete ptr;
+            }};
+}
+
+void NetworkImplDft::init_execution_context(const NetworkImplBase* src_network) {
+    auto&& src_impl = const_cast<NetworkImplDft&>(
+            src_network->cast_final_safe<NetworkImplDft>());
+    LITE_ASSERT(
+            !src_impl.m_is_cpu_inplace_mode,
+            "execution context is not supported in cpu inplace mode.");
+    m_nr_threads = src_impl.m_nr_threads;
+    m_execution_policy = src_impl.m_execution_policy;
+    m_load_config.comp_graph->options().fast_run_config =
+            src_impl.m_load_config.comp_graph->options().fast_run_config;
+    m_compnode_locator.numa_node = src_impl.m_compnode_locator.numa_node;
+    //! every context runs on its own stream, so the contexts run concurrently
+    //! instead of being serialized on the same worker, the multithread
+    //! compnode uses the stream field as thread number, so it is separated by
+    //! the device id
+    m_execution_context_id =
+            ExecutionContextIds::acquire(src_impl.m_execution_context_ids);
+    int context_id = *m_execution_context_id;
+    if (m_nr_threads > 1 && m_user_config->device_type == LiteDeviceType::LITE_CPU) {
+        int device = std::max(src_impl.m_compnode_locator.device, 0);
+        m_compnode_locator.device = device + context_id;
+    } else {
+        m_compnode_locator.device = src_impl.m_compnode_locator.device;
+        m_compnode_locator.stream = src_impl.m_compnode_locator.stream + context_id;
+    }
+    shared_weight_with(src_network);
+}
+
 void NetworkImplDft::application_config() {
     auto device_type = m_user_config->device_type;
     m_compnode_locator.type = to_compnode_locator(device_type).type;
@@ -69,6 +122,7 @@ void NetworkImplDft::application_config() {
 
     auto&& options = m_load_config.comp_graph->options();
     ConfigOption(graph_opt.weight_preprocess, weight_preprocess);
+    ConfigOption(share_preprocessed_weight, share_preprocessed_weight);
     ConfigOption(graph_opt.fuse_preprocess, fuse_preprocess);
     ConfigOption(fake_next_exec, fake_next_exec);
     ConfigOption(var_sanity_check_first_run, var_sanity_check_first_run);
@@ -83,6 +137,7 @@ void NetworkImplDft::application_config() {
     ConfigOption(comp_node_seq_record_level, comp_node_seq_record_level);
     ConfigOption(graph_opt_level, graph_opt_level);
     ConfigOption(async_exec_level, async_exec_level);
+    ConfigOption(seq_opt.nr_compute_stream, nr_compute_stream);
 
 #undef ConfigOption
 #define ConfigOptionLayoutTransform(name) \
@@ -131,6 +186,10 @@ void NetworkImplDft::application_config() {
             } else {
                 loc.stream = m_compnode_locator.stream;
             }
+            if (loc.type == mgb::CompNode::DeviceType::CPU ||
+                loc.type == mgb::CompNode::DeviceType::MULTITHREAD) {
+                loc.numa_node = m_compnode_locator.numa_node;
+            }
         };
     }
 }
@@ -149,6 +208,75 @@ void NetworkImplDft::share_runtime_memory_with(Network::NetworkImplBase* network
             network_impl->cast_final_safe<NetworkImplDft>().m_load_config.comp_graph));
 }
 
+void NetworkImplDft::update_weights(std::shared_ptr<void> model_mem, size_t size) {
+    LITE_ASSERT(
+            m_loader && m_execute_func,
+            "update_weights should be used on the network which loads the model.");
+    LITE_ASSERT(
+            !m_weights_transformed && !m_load_config.share_identical_params &&
+                    !m_load_config.lazy_device_value,
+            "update_weights is not supported when the weights are transformed by "
+            "the optimization options or shared between models.");
+    auto input_file =
+            mgb::serialization::InputFile::make_mem_proxy(model_mem, size, false);
+    auto format =
+            mgb::serialization::GraphLoader::identify_graph_dump_format(*input_file);
+    LITE_ASSERT(format.valid(), "invalid model format");
+    auto loader =
+            mgb::serialization::GraphLoader::make(std::move(input_file), format.val());
+
+    //! the new weights are staged on cpu, so no device memory is allocated
+    mgb::serialization::GraphLoadConfig load_config;
+    load_config.comp_graph = mgb::ComputingGraph::make();
+    load_config.tensor_value_loader = m_load_config.tensor_value_loader;
+    load_config.comp_node_mapper = [](mgb::CompNode::Locator& loc) {
+        loc.type = mgb::CompNode::DeviceType::CPU;
+        loc.device = mgb::CompNode::Locator::DEVICE_CPU_DEFAULT;
+        loc.stream = 0;
+    };
+    loader->load(load_config, false);
+
+    //! check all the weights before any of them is modified
+    auto&& dst_map = m_loader->shared_tensor_id_map();
+    auto&& src_map = loader->shared_tensor_id_map();
+    LITE_ASSERT(
+            dst_map.size() == src_map.size(),
+            "the new model has %zu weights, but the network has %zu.",
+            src_map.size(), dst_map.size());
+    std::vector<std::pair<DeviceTensorND*, const DeviceTensorND*>> copies;
+    for (size_t i = 0; i < dst_map.size(); ++i) {
+        auto&& dst = dst_map[i];
+        auto&& src = src_map[i];
+        LITE_ASSERT(
+                dst.first == src.first && src.second.size() == 1,
+                "weight %zu of the new model is %s, but it is %s in the network.", i,
+                src.first.c_str(), dst.first.c_str());
+        auto&& src_value = *src.second.begin()->second;
+        for (auto&& j : dst.second) {
+            auto&& dst_value = *j.second;
+            LITE_ASSERT(
+                    dst_value.shape().eq_shape(src_value.shape()) &&
+                            dst_value.dtype() == src_value.dtype(),
+                    "weight %s changes from %s(%s) to %s(%s) in the new model.",
+                    dst.first.c_str(), dst_value.shape().to_string().c_str(),
+                    dst_value.dtype().name(), src_value.shape().to_string().c_str(),
+                    src_value.dtype().name());
+            copies.emplace_back(j.second.get(), &src_value);
+        }
+    }
+
+    //! the copies are ordered after the running computing on the same comp
+    //! node, and the staged values should be alive until they are finished
+    mgb::CompNode::UnorderedSet comp_nodes;
+    for (auto&& i : copies) {
+        i.first->copy_from_fixlayout(HostTensorND::make_proxy(*i.second));
+        comp_nodes.insert(i.first->comp_node());
+    }
+    for (auto&& cn : comp_nodes) {
+        cn.sync();
+    }
+}
+
 void NetworkImplDft::set_cpu_inplace_mode() {
     LITE_ASSERT(
             m_user_config->device_type == LiteDeviceType::LITE_CPU,
@@ -183,6 +311,13 @@ void NetworkImplDft::set_cpu_threads_number(size_t nr_threads) {
     }
 }
 
+void NetworkImplDft::set_cpu_numa_node(size_t numa_node) {
+    LITE_ASSERT(
+            m_user_config->device_type == LiteDeviceType::LITE_CPU,
+            "numa binding is only avaliable in CPU.");
+    m_compnode_locator.numa_node = static_cast<int>(numa_node);
+}
+
 void NetworkImplDft::set_runtime_thread_affinity(
         const ThreadAffinityCallback& thread_affinity_callback) {
     LITE_ASSERT(
@@ -200,6 +335,54 @@ void NetworkImplDft::set_runtime_thread_affinity(
     }
 }
 
+mgb::ThreadPool* NetworkImplDft::get_cpu_thread_pool() {
+    LITE_ASSERT(
+            m_user_config->device_type == LiteDeviceType::LITE_CPU,
+            "thread pool is only avaliable in CPU.");
+    mgb::CompNode::Locator loc;
+    m_load_config.comp_node_mapper(loc);
+    auto cn = mgb::CompNode::load(loc);
+    return mgb::CompNodeEnv::from_comp_node(cn).cpu_env().thread_pool();
+}
+
+void NetworkImplDft::set_cpu_thread_spin_budget(int64_t spin_us) {
+    auto thread_pool = get_cpu_thread_pool();
+    LITE_ASSERT(thread_pool, "spin budget is only avaliable in multi thread mode.");
+    thread_pool->set_spin_budget(spin_us);
+}
+
+ThreadWaitStats NetworkImplDft::get_cpu_thread_wait_stats(bool reset) {
+    ThreadWaitStats ret;
+    if (auto thread_pool = get_cpu_thread_pool()) {
+        auto stats = thread_pool->wait_stats();
+        ret.nr_wakeup = stats.nr_wakeup;
+        ret.wakeup_latency_us = stats.wakeup_latency_us;
+        ret.spin_time_us = stats.spin_time_us;
+        if (reset) {
+            thread_pool->reset_wait_stats();
+        }
+    }
+    return ret;
+}
+
+void NetworkImplDft::set_cpu_thread_speed_weighted(bool enable) {
+    auto thread_pool = get_cpu_thread_pool();
+    LITE_ASSERT(
+            thread_pool,
+            "speed weighted schedule is only avaliable in multi thread mode.");
+    thread_pool->reset_thread_speeds();
+    thread_pool->set_schedule_mode(
+            enable ? mgb::ThreadPool::ScheduleMode::SPEED_WEIGHTED
+                   : mgb::ThreadPool::ScheduleMode::SHARED_COUNTER);
+}
+
+std::vector<float> NetworkImplDft::get_cpu_thread_speeds() {
+    if (auto thread_pool = get_cpu_thread_pool()) {
+        return thread_pool->thread_speeds();
+    }
+    return {1.f};
+}
+
 void NetworkImplDft::set_device_id(int device_id) {
     m_compnode_locator.device = device_id;
     m_user_config->device_id = device_id;
@@ -445,7 +628,44 @@ void NetworkImplDft::cross_compnode_model_detect() {
     m_nr_device_type = nr_used_device_type.size();
 }
 
+void NetworkImplDft::heterogeneous_partition() {
+    if (m_partition_config.devices.empty()) {
+        return;
+    }
+    using Device = mgb::gopt::CompNodePartitionPass::Device;
+    std::vector<Device> devices;
+    for (auto&& i : m_partition_config.devices) {
+        //! the oprs are kept on the comp node of the network if it is selected
+        auto locator = m_compnode_locator;
+        if (i.device_type != m_user_config->device_type ||
+            i.device_id != m_user_config->device_id) {
+            locator = to_compnode_locator(i.device_type);
+            locator.device = i.device_id;
+        }
+        std::unordered_set<std::string> unsupported{
+                i.unsupported_oprs.begin(), i.unsupported_oprs.end()};
+        auto supports = [unsupported](mgb::cg::OperatorNodeBase* opr) {
+            return !unsupported.count(opr->dyn_typeinfo()->name);
+        };
+        devices.push_back({mgb::CompNode::load(locator), i.flops_per_usec, supports});
+    }
+    mgb::gopt::CompNodePartitionPass::CopyCost copy_cost{
+            m_partition_config.copy_bytes_per_usec,
+            m_partition_config.copy_latency_usec};
+    auto output_var_array =
+            mgb::gopt::GraphOptimizer{}
+                    .add_pass<mgb::gopt::CompNodePartitionPass>(
+                            std::move(devices), copy_cost)
+                    .apply({{m_load_result.output_var_list}})
+                    .endpoint_vars();
+    m_load_result.update_output_var_list(output_var_array);
+}
+
 void NetworkImplDft::layout_transform_optimization() {
+    if (m_graph_from_state) {
+        //! the graph of the runtime state is already optimized
+        return;
+    }
     if (m_set_layout_transform) {
         mgb::ThinHashMap<mgb::SymbolVar, mgb::SymbolVar> out_var_map;
         auto output_var_array = mgb::gopt::layout_transform(
@@ -554,6 +774,42 @@ void NetworkImplDft::layout_transform_optimization() {
 void NetworkImplDft::load_model(
         std::shared_ptr<void> model_mem, size_t size,
         std::unordered_map<std::string, LiteAny> separate_config_map) {
+    m_model_hash = mgb::XXHash{}.update(model_mem.get(), size).digest();
+    LITE_ASSERT(
+            !m_state_model_hash || m_state_model_hash == m_model_hash,
+            "the runtime state is dumped from a different model.");
+    if (!m_loader && m_state_graph) {
+        //! the aliasing pointer keeps the graph alive with the loader
+        model_mem = std::shared_ptr<void>(m_state_graph, &(*m_state_graph)[0]);
+        size = m_state_graph->size();
+        m_state_graph.reset();
+        m_graph_from_state = true;
+    }
+    auto artifact_dir = get_artifact_dir();
+    std::string artifact_graph_path;
+    if (!m_loader && !m_graph_from_state && m_set_layout_transform &&
+        !artifact_dir.empty()) {
+        //! the transformed graph is kept per model and target in the artifact
+        //! dir, which is already scoped by the device and megengine version
+        artifact_graph_path = ssprintf(
+                "%s/%016llx_%d.layout_transform.mge", artifact_dir.c_str(),
+                static_cast<unsigned long long>(m_model_hash),
+                static_cast<int>(m_layout_transform_target));
+        std::ifstream fin(artifact_graph_path, std::ios::binary);
+        if (fin.is_open()) {
+            auto graph = std::make_shared<std::string>(
+                    std::istreambuf_iterator<char>(fin),
+                    std::istreambuf_iterator<char>());
+            if (!graph->empty()) {
+                LITE_LOG(
+                        "load layout transformed model %s",
+                        artifact_graph_path.c_str());
+                model_mem = std::shared_ptr<void>(graph, &(*graph)[0]);
+                size = graph->size();
+                m_graph_from_state = true;
+            }
+        }
+    }
     if (!m_loader) {
         m_input_file =
                 mgb::serialization::InputFile::make_mem_proxy(model_mem, size, false);
@@ -587,8 +843,26 @@ void NetworkImplDft::load_model(
         use_tensorrt();
     }
 
+    if (m_user_config->mem_soft_limit || m_user_config->mem_hard_limit) {
+        mgb::CompNode::load(m_compnode_locator)
+                .set_mem_limit(
+                        m_user_config->mem_soft_limit, m_user_config->mem_hard_limit);
+    }
+
     m_load_result = m_loader->load(m_load_config, true);
     configure_after_loaded();
+
+    if (!artifact_graph_path.empty() && !m_graph_from_state) {
+        //! written to a temp file and renamed as other processes may read it
+        auto tmp_path = make_tmp_path(artifact_graph_path);
+        dump_layout_transform_model(tmp_path);
+        if (rename(tmp_path.c_str(), artifact_graph_path.c_str())) {
+            LITE_WARN(
+                    "failed to save layout transformed model %s: %s",
+                    artifact_graph_path.c_str(), strerror(errno));
+            remove(tmp_path.c_str());
+        }
+    }
 }
 
 void NetworkImplDft::configure_after_loaded() {
@@ -596,6 +870,8 @@ void NetworkImplDft::configure_after_loaded() {
 
     layout_transform_optimization();
 
+    heterogeneous_partition();
+
     //! find how many compnode the model has, this should call before update_io
     cross_compnode_model_detect();
 
@@ -613,6 +889,16 @@ void NetworkImplDft::configure_after_loaded() {
 
 void NetworkImplDft::compile_graph() {
     make_output_spec();
+    //! the options are reset when the graph is compiled, and the weights
+    //! transformed by them are not updated with update_weights
+    auto&& opt = m_load_config.comp_graph->options().graph_opt;
+    m_weights_transformed =
+            m_set_layout_transform || opt.weight_preprocess ||
+            opt.layout_transform != mgb::cg::GraphCommonOptimizeOptions::DEFAULT ||
+            opt.f16_io_comp || opt.f16_io_f32_comp || opt.fuse_conv_bias_nonlinearity ||
+            opt.fuse_conv_bias_with_z || opt.fuse_preprocess || opt.fuse_grain ||
+            opt.fuse_depthwise_pointwise_conv_bias || opt.fuse_residual_layer_norm ||
+            opt.precompute_weight;
     m_execute_func = m_load_result.graph_compile(m_output_spec);
 }
 
@@ -1143,6 +1429,21 @@ void NetworkImplDft::enable_profile_performance(std::string profile_json_file) {
 #endif
 }
 
+void NetworkImplDft::enable_sampling_profile(size_t period, float opr_ratio) {
+    mgb::SamplingProfiler::Options options;
+    options.period = period;
+    options.opr_ratio = opr_ratio;
+    m_sampling_profiler = std::make_unique<mgb::SamplingProfiler>(
+            m_load_config.comp_graph.get(), options);
+}
+
+std::string NetworkImplDft::get_sampling_profile() const {
+    LITE_ASSERT(
+            m_sampling_profiler,
+            "get_sampling_profile should be called after enable_sampling_profile.");
+    return m_sampling_profiler->to_prometheus();
+}
+
 void NetworkImplDft::enable_io_txt_dump(std::string io_txt_out_file) {
     auto iodump = std::make_unique<mgb::TextOprIODump>(
             m_load_config.comp_graph.get(), io_txt_out_file.c_str());
@@ -1174,6 +1475,17 @@ void NetworkImplDft::get_static_memory_alloc_info(const std::string& log_dir) co
     LITE_MARK_USED_VAR(log_dir);
 }
 
+size_t NetworkImplDft::get_static_memory_size() {
+    LITE_ASSERT(
+            m_execute_func,
+            "get_static_memory_size should be used after the model loaded.");
+    size_t size = 0;
+    for (auto&& i : m_execute_func->update_static_alloc_plan_and_get_size()) {
+        size += i.second;
+    }
+    return size;
+}
+
 void NetworkImplDft::enable_global_layout_transform() {
     m_layout_transform_target = mgb::gopt::GraphTuningOptions::Target::UNSPEC;
 
@@ -1210,8 +1522,149 @@ void NetworkImplDft::dump_layout_transform_model(std::string optimized_model_pat
     }
 }
 
+namespace {
+constexpr char RUNTIME_STATE_MAGIC[8] = {'L', 'I', 'T', 'E', 'S', 'T', 'A', 'T'};
+constexpr uint32_t RUNTIME_STATE_VERSION = 1;
+}  // namespace
+
+/*
+ * the runtime state file is laid out as
+ *
+ *      magic, version, model hash,
+ *      algo cache size, algo cache, graph size, graph
+ *
+ * where the sizes are uint64_t, and an empty algo cache or graph means it is
+ * not available when dumping
+ */
+void NetworkImplDft::dump_runtime_state(const std::string& path) const {
+    LITE_ASSERT(m_execute_func, "dump_runtime_state must be called after loaded.");
+    std::vector<uint8_t> cache;
+    auto&& persistent_cache = mgb::PersistentCache::inst();
+    if (persistent_cache.support_dump_cache()) {
+        cache = static_cast<mgb::InFilePersistentCache&>(persistent_cache)
+                        .dump_cache();
+    } else {
+        LITE_WARN(
+                "the algo cache can not be dumped, call set_persistent_cache before "
+                "loading the model to include it in the runtime state.");
+    }
+    std::vector<uint8_t> graph;
+    if (m_set_layout_transform || m_graph_from_state) {
+        auto out_file = mgb::serialization::OutputFile::make_vector_proxy(&graph);
+        using DumpConfig = mgb::serialization::GraphDumper::DumpConfig;
+        DumpConfig config{1, false, false};
+        auto dumper = mgb::serialization::GraphDumper::make(
+                std::move(out_file), m_format.val());
+        dumper->dump(m_load_result.output_var_list, config);
+    }
+
+    FILE* fout = fopen(path.c_str(), "wb");
+    LITE_ASSERT(fout, "failed to open %s: %s", path.c_str(), strerror(errno));
+    std::unique_ptr<FILE, int (*)(FILE*)> fout_guard{fout, ::fclose};
+    auto write = [&](const void* data, size_t size) {
+        LITE_ASSERT(
+                fwrite(data, 1, size, fout) == size, "failed to write %s",
+                path.c_str());
+    };
+    auto write_blob = [&](const std::vector<uint8_t>& blob) {
+        uint64_t size = blob.size();
+        write(&size, sizeof(size));
+        write(blob.data(), blob.size());
+    };
+    write(RUNTIME_STATE_MAGIC, sizeof(RUNTIME_STATE_MAGIC));
+    write(&RUNTIME_STATE_VERSION, sizeof(RUNTIME_STATE_VERSION));
+    write(&m_model_hash, sizeof(m_model_hash));
+    write_blob(cache);
+    write_blob(graph);
+}
+
+void NetworkImplDft::load_runtime_state(const std::string& path) {
+    std::ifstream fin(path, std::ios::binary);
+    LITE_ASSERT(fin.is_open(), "failed to open %s", path.c_str());
+    auto read = [&](void* data, size_t size) {
+        fin.read(static_cast<char*>(data), size);
+        LITE_ASSERT(fin.good(), "the runtime state %s is truncated.", path.c_str());
+    };
+    char magic[sizeof(RUNTIME_STATE_MAGIC)];
+    uint32_t version;
+    read(magic, sizeof(magic));
+    read(&version, sizeof(version));
+    LITE_ASSERT(
+            !memcmp(magic, RUNTIME_STATE_MAGIC, sizeof(magic)) &&
+                    version == RUNTIME_STATE_VERSION,
+            "%s is not a runtime state of version %u.", path.c_str(),
+            RUNTIME_STATE_VERSION);
+    read(&m_state_model_hash, sizeof(m_state_model_hash));
+    auto read_blob = [&]() {
+        uint64_t size;
+        read(&size, sizeof(size));
+        auto blob = std::make_shared<std::string>(size, '\0');
+        if (size) {
+            read(&(*blob)[0], size);
+        }
+        return blob;
+    };
+    auto cache = read_blob();
+    if (!cache->empty()) {
+        mgb::PersistentCache::set_impl(std::make_shared<mgb::InFilePersistentCache>(
+                reinterpret_cast<const uint8_t*>(cache->data()), cache->size()));
+    }
+    m_state_graph = read_blob();
+    if (m_state_graph->empty()) {
+        m_state_graph.reset();
+    }
+}
+
+namespace {
+//! read the summary embedded in the model by the v2 format
+bool read_model_info(mgb::serialization::InputFile& file, ModelInfo& info) {
+    auto rst = mgb::serialization::GraphLoader::read_model_info(file);
+    if (!rst.valid())
+        return false;
+    auto to_io = [](const mgb::serialization::GraphLoader::ModelInfo::Var& var) {
+        IO io;
+        io.name = var.name;
+        io.config_layout = to_lite_layout(mgb::TensorLayout{var.shape, var.dtype});
+        return io;
+    };
+    for (auto&& i : rst->inputs) {
+        info.io.inputs.push_back(to_io(i));
+    }
+    for (auto&& i : rst->outputs) {
+        info.io.outputs.push_back(to_io(i));
+    }
+    info.nr_operators = rst->nr_opr;
+    info.flops = rst->flops;
+    info.operator_types = rst->opr_types;
+    return true;
+}
+}  // namespace
+
+ModelInfo lite::get_model_info_dft(const std::string& model_path, const Config&) {
+    auto input_file = mgb::serialization::InputFile::make_mmap(model_path.c_str());
+    ModelInfo info;
+    LITE_ASSERT(
+            read_model_info(*input_file, info), "no model info in %s",
+            model_path.c_str());
+    return info;
+}
+
+ModelInfo lite::get_model_info_dft(const void* model_mem, size_t size, const Config&) {
+    std::shared_ptr<void> model{const_cast<void*>(model_mem), [](void*) {}};
+    auto input_file = mgb::serialization::InputFile::make_mem_proxy(model, size, false);
+    ModelInfo info;
+    LITE_ASSERT(read_model_info(*input_file, info), "no model info in the model");
+    return info;
+}
+
 NetworkIO lite::get_model_io_info_dft(
         const std::string& model_path, const Config& config) {
+    {
+        auto input_file = mgb::serialization::InputFile::make_mmap(model_path.c_str());
+        ModelInfo info;
+        if (read_model_info(*input_file, info))
+            return info.io;
+    }
     FILE* fin = fopen(model_path.c_str(), "rb");
     LITE_ASSERT(fin, "failed to open %s: %s", model_path.c_str(), strerror(errno));
     fseek(fin, 0, SEEK_END);
@@ -1234,6 +1687,10 @@ NetworkIO lite::get_model_io_info_dft(
     if (!format.valid()) {
         LITE_THROW("invalid model format");
     }
+    ModelInfo info;
+    if (read_model_info(*input_file, info)) {
+        return info.io;
+    }
     auto loader =
             mgb::serialization::GraphLoader::make(std::move(input_file), format.val());
 
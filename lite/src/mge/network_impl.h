@@ -9,19 +9,42 @@
 #include "tensor_impl.h"
 
 #include <memory>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include "megbrain/gopt/inference.h"
 #include "megbrain/graph/bases.h"
 #include "megbrain/plugin/opr_io_dump.h"
 #include "megbrain/plugin/profiler.h"
+#include "megbrain/plugin/sampling_profiler.h"
 #include "megbrain/serialization/extern_c_opr.h"
 #include "megbrain/serialization/file.h"
 #include "megbrain/serialization/load_dump_config.h"
 #include "megbrain/serialization/serializer.h"
 #include "megbrain/utils/thin/hash_table.h"
+#include "megbrain/utils/thread_pool.h"
 
 namespace lite {
 
+/*!
+ * \brief the ids of the execution contexts created from a network
+ *
+ * The id selects the stream (thread pool on CPU) of a context, and the comp
+ * nodes are cached by locator, so the id of a destructed context is handed
+ * to the next context instead of growing with every context created.
+ */
+class ExecutionContextIds {
+public:
+    //! get an unused id which is released when the returned holder is freed
+    static std::shared_ptr<const int> acquire(
+            const std::shared_ptr<ExecutionContextIds>& ids);
+
+private:
+    std::mutex m_mtx;
+    int m_nr_id = 0;
+    std::set<int> m_free_ids;
+};
+
 /*!
  * \brief implement the Network, contain the mgb related member
  */
@@ -124,6 +147,27 @@ public:
     void set_cpu_threads_number(size_t nr_threads);
     size_t get_cpu_threads_number() const { return m_nr_threads; }
 
+    //! load the network as an execution context of src_network, which shares
+    //! the weights and runtime options of src_network but runs on its own
+    //! stream with its own runtime memory
+    void init_execution_context(const NetworkImplBase* src_network);
+
+    //! set the spin budget of the idle worker threads of the thread pool
+    void set_cpu_thread_spin_budget(int64_t spin_us);
+
+    //! get the wait statistics of the worker threads of the thread pool
+    ThreadWaitStats get_cpu_thread_wait_stats(bool reset);
+
+    //! split the sub tasks of the thread pool by the measured thread speeds
+    void set_cpu_thread_speed_weighted(bool enable);
+
+    //! get the relative speeds of the threads of the thread pool
+    std::vector<float> get_cpu_thread_speeds();
+
+    //! When device is CPU, bind the worker threads and the runtime memory of
+    //! the to be loaded model to the given numa node
+    void set_cpu_numa_node(size_t numa_node);
+
     //! set device id, default device id = 0
     void set_device_id(int device_id) override;
     int get_device_id() const override { return m_compnode_locator.device; };
@@ -145,6 +189,10 @@ public:
 
     //! share the runtime memory with other network, the weights is not shared
     void share_runtime_memory_with(NetworkImplBase* network);
+
+    //! update the weights in place from a model with the same topology, the
+    //! networks sharing weights with this network also see the new weights
+    void update_weights(std::shared_ptr<void> model_mem, size_t size);
     //! set threads affinity callback;
     void set_runtime_thread_affinity(
             const ThreadAffinityCallback& thread_affinity_callback);
@@ -173,9 +221,30 @@ public:
     void get_static_memory_alloc_info(
             const std::string& log_dir = "logs/test") const override;
 
+    //! profile one in every period forwards and aggregate the time of oprs
+    void enable_sampling_profile(size_t period, float opr_ratio) override;
+
+    //! the histograms of the sampling profiler in the Prometheus text format
+    std::string get_sampling_profile() const override;
+
+    //! get the size of the static runtime memory planned for the network
+    size_t get_static_memory_size();
+
+    //! dump the algo cache and the layout transformed graph of the network
+    void dump_runtime_state(const std::string& path) const override;
+
+    //! install the algo cache of the state, and keep its graph to be loaded
+    //! in place of the model
+    void load_runtime_state(const std::string& path) override;
+
     //! set global layout transform optimization for network
     void enable_global_layout_transform();
 
+    //! partition the network across the devices in the config
+    void enable_heterogeneous_partition(const PartitionConfig& config) {
+        m_partition_config = config;
+    }
+
     //! dump network after global layout transform optimization
     void dump_layout_transform_model(std::string optimized_model_path);
 
@@ -184,6 +253,9 @@ public:
     }
 
 private:
+    //! get the thread pool of the cpu comp node, nullptr if not multithread
+    mgb::ThreadPool* get_cpu_thread_pool();
+
     //! construct the outputspec according to the m_network_io, and set the
     //! call_back to the outputspec
     void make_output_spec();
@@ -193,6 +265,9 @@ private:
     //! the device information
     void layout_transform_optimization();
 
+    //! place the oprs on the devices of the partition config
+    void heterogeneous_partition();
+
     //! modify the execution policy
     void modify_exection_policy();
 
@@ -249,7 +324,22 @@ private:
     size_t m_nr_threads = 1;
     bool m_compute_configured_output_only = false;
     bool m_set_layout_transform = false;
+    //! whether the weights are transformed when the graph is compiled
+    bool m_weights_transformed = false;
+    //! hash of the loaded model, which identifies the runtime state
+    uint64_t m_model_hash = 0;
+    //! the model hash and the graph of the runtime state to be loaded
+    uint64_t m_state_model_hash = 0;
+    std::shared_ptr<std::string> m_state_graph;
+    //! whether the graph is loaded from the runtime state
+    bool m_graph_from_state = false;
     mgb::CompNode::Locator m_compnode_locator;
+    //! ids of the execution contexts created from this network, used to
+    //! assign them different streams
+    std::shared_ptr<ExecutionContextIds> m_execution_context_ids =
+            std::make_shared<ExecutionContextIds>();
+    //! id of this network if it is an execution context of another network
+    std::shared_ptr<const int> m_execution_context_id;
 
     AsyncCallback m_async_callback = nullptr;
     std::unique_ptr<NetworkIOInner> m_network_io;
@@ -261,6 +351,7 @@ private:
     std::unique_ptr<mgb::serialization::InputFile> m_input_file;
     mgb::Maybe<mgb::serialization::GraphDumpFormat> m_format;
     mgb::gopt::GraphTuningOptions::Target m_layout_transform_target;
+    PartitionConfig m_partition_config;
 
     mgb::serialization::GraphLoadConfig m_load_config;
     mgb::serialization::GraphLoader::LoadResult m_load_result;
@@ -277,6 +368,7 @@ private:
     std::string m_profiler_output_file;
 #endif
     std::unique_ptr<mgb::OprIODumpBase> m_iodump;
+    std::unique_ptr<mgb::SamplingProfiler> m_sampling_profiler;
 };
 //! get the model information before model loaded by Network
 NetworkIO get_model_io_info_dft(const std::string& model_path, const Config& config);
@@ -286,6 +378,12 @@ NetworkIO get_model_io_info_dft(const std::string& model_path, const Config& con
 NetworkIO get_model_io_info_dft(
         const void* model_mem, size_t size, const Config& config);
 
+//! get the model summary embedded in the model without loading it
+ModelInfo get_model_info_dft(const std::string& model_path, const Config& config);
+
+//! get the model summary embedded in the model memory without loading it
+ModelInfo get_model_info_dft(const void* model_mem, size_t size, const Config& config);
+
 }  // namespace lite
 
 #endif
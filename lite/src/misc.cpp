@@ -4,6 +4,14 @@
 #include <time.h>
 #include <chrono>
 #include <cstdarg>
+#include <random>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 #if LITE_BUILD_WITH_MGE
 #include "megbrain/common.h"
@@ -102,6 +110,13 @@ std::string lite::ssprintf(const char* format, ...) {
     return ret;
 }
 
+std::string lite::make_tmp_path(const std::string& path) {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    return ssprintf(
+            "%s.%d.%016llx.tmp", path.c_str(), static_cast<int>(getpid()),
+            static_cast<unsigned long long>(rng()));
+}
+
 void lite::print_log(LiteLogLevel level, const char* format, ...) {
     if (!format)
         return;
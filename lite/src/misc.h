@@ -31,6 +31,14 @@ private:
 LITE_API std::string ssprintf(const char* fmt = 0, ...)
         __attribute__((format(printf, 1, 2)));
 
+/*!
+ * \brief a temp path next to \p path to write it and then rename over it
+ *
+ * The path is made unique across processes and threads by the pid and a random
+ * suffix, so that concurrent writers never share a temp file.
+ */
+std::string make_tmp_path(const std::string& path);
+
 /*!
  * \brief Print a message.
  *
@@ -284,6 +284,19 @@ void Network::enable_profile_performance(std::string profile_file_path) {
     LITE_ERROR_HANDLER_END
 }
 
+void Network::enable_sampling_profile(size_t period, float opr_ratio) {
+    LITE_ERROR_HANDLER_BEGIN
+    LITE_ASSERT(period > 0, "the sampling period should be positive.");
+    m_impl->enable_sampling_profile(period, opr_ratio);
+    LITE_ERROR_HANDLER_END
+}
+
+std::string Network::get_sampling_profile() const {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->get_sampling_profile();
+    LITE_ERROR_HANDLER_END
+}
+
 const std::string& Network::get_model_extra_info() {
     LITE_ERROR_HANDLER_BEGIN
     return m_extra_info;
@@ -310,6 +323,20 @@ void Network::get_static_memory_alloc_info(const std::string& log_dir) const {
     LITE_ERROR_HANDLER_END
 }
 
+void Network::dump_runtime_state(const std::string& path) const {
+    LITE_ERROR_HANDLER_BEGIN
+    LITE_ASSERT(m_loaded, "dump_runtime_state should be used after model loaded.");
+    m_impl->dump_runtime_state(path);
+    LITE_ERROR_HANDLER_END
+}
+
+void Network::load_runtime_state(const std::string& path) {
+    LITE_ERROR_HANDLER_BEGIN
+    LITE_ASSERT(!m_loaded, "load_runtime_state should be used before model loaded.");
+    m_impl->load_runtime_state(path);
+    LITE_ERROR_HANDLER_END
+}
+
 void Network::extra_configure(const ExtraConfig& extra_config) {
     LITE_ERROR_HANDLER_BEGIN
     if (!extra_config.disable_configure_by_model_info) {
@@ -340,6 +367,22 @@ void Runtime::set_cpu_threads_number(
     LITE_ERROR_HANDLER_END
 }
 
+void Runtime::set_cpu_numa_node(std::shared_ptr<Network> network, int numa_node) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                !NetworkHelper::loaded(network),
+                "set_cpu_numa_node should be used before model loaded.");
+        LITE_ASSERT(numa_node >= 0, "invalid numa node: %d", numa_node);
+        call_func<NetworkImplDft, void>(
+                "set_cpu_numa_node", network_impl, static_cast<size_t>(numa_node));
+        return;
+    }
+    LITE_THROW("set_cpu_numa_node is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 void Runtime::use_tensorrt(std::shared_ptr<Network> network) {
     LITE_ERROR_HANDLER_BEGIN
     auto network_impl = NetworkHelper::implement(network);
@@ -384,6 +427,89 @@ void Runtime::set_runtime_thread_affinity(
     LITE_ERROR_HANDLER_END
 }
 
+std::shared_ptr<Network> Runtime::create_execution_context(
+        std::shared_ptr<Network> src_network) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto src_impl = NetworkHelper::implement(src_network);
+    if (src_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(src_network),
+                "create_execution_context should be used after the src network "
+                "loaded.");
+        auto dst_network = std::make_shared<Network>(
+                NetworkHelper::config(src_network),
+                NetworkHelper::network_io(src_network));
+        call_func<NetworkImplDft, void>(
+                "init_execution_context", NetworkHelper::implement(dst_network),
+                src_impl);
+        NetworkHelper::loaded(dst_network, true);
+        return dst_network;
+    }
+    LITE_THROW("create_execution_context is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
+void Runtime::set_cpu_thread_spin_budget(
+        std::shared_ptr<Network> network, int64_t spin_us) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(network),
+                "set_cpu_thread_spin_budget should be used after model loaded.");
+        call_func<NetworkImplDft, void>(
+                "set_cpu_thread_spin_budget", network_impl, spin_us);
+        return;
+    }
+    LITE_THROW("set_cpu_thread_spin_budget is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
+ThreadWaitStats Runtime::get_cpu_thread_wait_stats(
+        std::shared_ptr<Network> network, bool reset) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(network),
+                "get_cpu_thread_wait_stats should be used after model loaded.");
+        return call_func<NetworkImplDft, ThreadWaitStats>(
+                "get_cpu_thread_wait_stats", network_impl, reset);
+    }
+    LITE_THROW("get_cpu_thread_wait_stats is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
+void Runtime::set_cpu_thread_speed_weighted(
+        std::shared_ptr<Network> network, bool enable) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(network),
+                "set_cpu_thread_speed_weighted should be used after model loaded.");
+        call_func<NetworkImplDft, void>(
+                "set_cpu_thread_speed_weighted", network_impl, enable);
+        return;
+    }
+    LITE_THROW("set_cpu_thread_speed_weighted is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
+std::vector<float> Runtime::get_cpu_thread_speeds(std::shared_ptr<Network> network) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(network),
+                "get_cpu_thread_speeds should be used after model loaded.");
+        return call_func<NetworkImplDft, std::vector<float>>(
+                "get_cpu_thread_speeds", network_impl);
+    }
+    LITE_THROW("get_cpu_thread_speeds is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 void Runtime::set_cpu_inplace_mode(std::shared_ptr<Network> network) {
     LITE_ERROR_HANDLER_BEGIN
     auto network_impl = NetworkHelper::implement(network);
@@ -526,6 +652,50 @@ void Runtime::shared_weight_with_network(
     LITE_ERROR_HANDLER_END
 }
 
+void Runtime::update_weights(
+        std::shared_ptr<Network> network, const std::string& model_path) {
+    LITE_ERROR_HANDLER_BEGIN
+    FILE* fin = fopen(model_path.c_str(), "rb");
+    LITE_ASSERT(fin, "failed to open %s: %s", model_path.c_str(), strerror(errno));
+    fseek(fin, 0, SEEK_END);
+    size_t size = ftell(fin);
+    fseek(fin, 0, SEEK_SET);
+    std::shared_ptr<void> buf{malloc(size), ::free};
+    auto nr = fread(buf.get(), 1, size, fin);
+    fclose(fin);
+    LITE_ASSERT(nr == size);
+    update_weights(network, buf.get(), size);
+    LITE_ERROR_HANDLER_END
+}
+
+void Runtime::update_weights(
+        std::shared_ptr<Network> network, const void* model_mem, size_t size) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                NetworkHelper::loaded(network),
+                "update_weights should be used after the network loaded.");
+        //! the packed and encrypted models are parsed in the same way as
+        //! load_model, but the network is not configured again
+        std::shared_ptr<void> model{const_cast<void*>(model_mem), [](void*) {}};
+        Config config = NetworkHelper::config(network);
+        NetworkIO network_io;
+        std::unordered_map<std::string, LiteAny> separate_config_map;
+        std::string extra_info;
+        ModelParser model_parser(model, size);
+        model_parser.parse_model_info(
+                config, network_io, separate_config_map, extra_info, false);
+        size_t model_length;
+        auto&& model_shared_ptr = model_parser.parse_model(model_length, config);
+        call_func<NetworkImplDft, void>(
+                "update_weights", network_impl, model_shared_ptr, model_length);
+        return;
+    }
+    LITE_THROW("update_weights is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 void Runtime::enable_global_layout_transform(std::shared_ptr<Network> network) {
     LITE_ERROR_HANDLER_BEGIN
     auto network_impl = NetworkHelper::implement(network);
@@ -540,6 +710,23 @@ void Runtime::enable_global_layout_transform(std::shared_ptr<Network> network) {
     LITE_ERROR_HANDLER_END
 }
 
+void Runtime::enable_heterogeneous_partition(
+        std::shared_ptr<Network> network, const PartitionConfig& config) {
+    LITE_ERROR_HANDLER_BEGIN
+    auto network_impl = NetworkHelper::implement(network);
+    if (network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT) {
+        LITE_ASSERT(
+                !NetworkHelper::loaded(network),
+                "enable_heterogeneous_partition should be used before model "
+                "loaded.");
+        call_func<NetworkImplDft, void>(
+                "enable_heterogeneous_partition", network_impl, config);
+        return;
+    }
+    LITE_THROW("enable_heterogeneous_partition is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
 void Runtime::dump_layout_transform_model(
         std::shared_ptr<Network> network, std::string optimized_model_path) {
     LITE_ERROR_HANDLER_BEGIN
@@ -577,4 +764,25 @@ NetworkIO Runtime::get_model_io_info(
     LITE_THROW("get_model_io_info is not aviliable in the backend.");
     LITE_ERROR_HANDLER_END
 }
+
+ModelInfo Runtime::get_model_info(const std::string& model_path, const Config& config) {
+    LITE_ERROR_HANDLER_BEGIN
+    if (config.backend == LiteBackend::LITE_DEFAULT) {
+        return call_func<NetworkImplDft, ModelInfo>(
+                "get_model_info", model_path, config);
+    }
+    LITE_THROW("get_model_info is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
+
+ModelInfo Runtime::get_model_info(
+        const void* model_mem, size_t size, const Config& config) {
+    LITE_ERROR_HANDLER_BEGIN
+    if (config.backend == LiteBackend::LITE_DEFAULT) {
+        return call_func<NetworkImplDft, ModelInfo>(
+                "get_model_info", model_mem, size, config);
+    }
+    LITE_THROW("get_model_info is not aviliable in the backend.");
+    LITE_ERROR_HANDLER_END
+}
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -158,6 +158,21 @@ public:
     //! enable profile the network, a file will be generated
     virtual void enable_profile_performance(std::string profile_file_path) = 0;
 
+    //! enable the low-overhead sampling profiler
+    virtual void enable_sampling_profile(size_t period, float opr_ratio) {
+        LITE_MARK_USED_VAR(period);
+        LITE_MARK_USED_VAR(opr_ratio);
+        LITE_THROW(
+                "This nerworkimpl doesn't support enable_sampling_profile() "
+                "function.");
+    }
+
+    //! the histograms of the sampling profiler in the Prometheus text format
+    virtual std::string get_sampling_profile() const {
+        LITE_THROW(
+                "This nerworkimpl doesn't support get_sampling_profile() function.");
+    }
+
     //! get static peak memory info showed by Graph visualization
     virtual void get_static_memory_alloc_info(const std::string& log_dir) const {
         LITE_MARK_USED_VAR(log_dir);
@@ -165,6 +180,18 @@ public:
                 "This nerworkimpl doesn't support get_static_memory_alloc_info() "
                 "function.");
     }
+
+    //! dump the warm runtime state of the loaded network
+    virtual void dump_runtime_state(const std::string& path) const {
+        LITE_MARK_USED_VAR(path);
+        LITE_THROW("This nerworkimpl doesn't support dump_runtime_state() function.");
+    }
+
+    //! read the runtime state to be used when the model is loaded
+    virtual void load_runtime_state(const std::string& path) {
+        LITE_MARK_USED_VAR(path);
+        LITE_THROW("This nerworkimpl doesn't support load_runtime_state() function.");
+    }
 };
 
 /******************************** friend class *****************************/
@@ -195,6 +222,14 @@ public:
         LITE_ASSERT(network);
         network->m_impl = std::move(impl);
     }
+    static const Config& config(const std::shared_ptr<Network> network) {
+        LITE_ASSERT(network);
+        return network->m_config;
+    }
+    static const NetworkIO& network_io(const std::shared_ptr<Network> network) {
+        LITE_ASSERT(network);
+        return network->m_network_io;
+    }
 };
 
 }  // namespace lite
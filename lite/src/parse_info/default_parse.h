@@ -91,6 +91,9 @@ bool default_parse_info(
         auto options = info["options"];
         if (options.contains("weight_preprocess"))
             config.options.weight_preprocess = options["weight_preprocess"];
+        if (options.contains("share_preprocessed_weight"))
+            config.options.share_preprocessed_weight =
+                    options["share_preprocessed_weight"];
         if (options.contains("fuse_preprocess"))
             config.options.fuse_preprocess = options["fuse_preprocess"];
         if (options.contains("fake_next_exec"))
@@ -117,6 +120,8 @@ bool default_parse_info(
             config.options.graph_opt_level = options["graph_opt_level"];
         if (options.contains("async_exec_level"))
             config.options.async_exec_level = options["async_exec_level"];
+        if (options.contains("nr_compute_stream"))
+            config.options.nr_compute_stream = options["nr_compute_stream"];
     }
     //! IO
     auto get_io_type = [](std::string type) -> LiteIOType {
@@ -0,0 +1,187 @@
+#include "lite_build_config.h"
+
+#include "lite/network.h"
+#include "misc.h"
+#include "network_impl_base.h"
+
+#if !__DEPLOY_ON_XP_SP2__
+#include <condition_variable>
+#endif
+
+using namespace lite;
+
+#if !__DEPLOY_ON_XP_SP2__
+
+class PipelinedNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network> network, CompletionCallback callback, size_t depth);
+    ~Impl() { wait_all(); }
+
+    Outputs get_next_inputs();
+
+    size_t submit();
+
+    void wait_all();
+
+    size_t nr_completed() const {
+        LITE_LOCK_GUARD(m_mtx);
+        return m_nr_completed;
+    }
+
+private:
+    struct Slot {
+        std::shared_ptr<Network> context;
+        Outputs inputs, outputs;
+        size_t request_id = 0;
+        //! whether a request is in flight on the context
+        bool busy = false;
+    };
+
+    //! called from the callback thread of the device of the slot
+    void on_complete(Slot& slot);
+
+    CompletionCallback m_callback;
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    size_t m_nr_submitted = 0, m_nr_completed = 0;
+    //! whether the inputs of the next request are handed out
+    bool m_acquired = false;
+    mutable std::mutex m_mtx;
+    std::condition_variable m_cv;
+};
+
+PipelinedNetwork::Impl::Impl(
+        std::shared_ptr<Network> network, CompletionCallback callback, size_t depth)
+        : m_callback{std::move(callback)} {
+    LITE_ASSERT(network, "PipelinedNetwork is constructed with an empty network.");
+    LITE_ASSERT(
+            NetworkHelper::loaded(network),
+            "PipelinedNetwork should be constructed after the network loaded.");
+    LITE_ASSERT(m_callback, "the completion callback of PipelinedNetwork is empty.");
+    LITE_ASSERT(depth > 0, "depth of PipelinedNetwork is 0.");
+    auto device_type = network->get_device_type();
+    for (size_t i = 0; i < depth; i++) {
+        auto slot = std::make_unique<Slot>();
+        slot->context = Runtime::create_execution_context(network);
+        size_t nr_input = slot->context->get_all_input_name().size();
+        for (size_t j = 0; j < nr_input; j++) {
+            auto input = slot->context->get_input_tensor(j);
+            LITE_ASSERT(
+                    device_type == LiteDeviceType::LITE_CPU || input->is_pinned_host(),
+                    "the %zu-th input of PipelinedNetwork should be a host input.",
+                    j);
+            slot->inputs.emplace_back(input);
+        }
+        size_t nr_output = slot->context->get_all_output_name().size();
+        for (size_t j = 0; j < nr_output; j++) {
+            slot->outputs.emplace_back(slot->context->get_output_tensor(j));
+        }
+        auto slot_ptr = slot.get();
+        slot->context->set_async_callback(
+                [this, slot_ptr]() { on_complete(*slot_ptr); });
+        m_slots.emplace_back(std::move(slot));
+    }
+}
+
+PipelinedNetwork::Outputs PipelinedNetwork::Impl::get_next_inputs() {
+    std::unique_lock<std::mutex> lock(m_mtx);
+    auto&& slot = *m_slots[m_nr_submitted % m_slots.size()];
+    m_cv.wait(lock, [&slot]() { return !slot.busy; });
+    m_acquired = true;
+    return slot.inputs;
+}
+
+size_t PipelinedNetwork::Impl::submit() {
+    Slot* slot;
+    {
+        LITE_LOCK_GUARD(m_mtx);
+        LITE_ASSERT(m_acquired, "submit of PipelinedNetwork without get_next_inputs.");
+        m_acquired = false;
+        slot = m_slots[m_nr_submitted % m_slots.size()].get();
+        slot->busy = true;
+        slot->request_id = m_nr_submitted++;
+    }
+    try {
+        //! only waits for the previous request of the same context on host,
+        //! which has completed
+        slot->context->forward();
+    } catch (...) {
+        {
+            LITE_LOCK_GUARD(m_mtx);
+            slot->busy = false;
+            m_nr_completed++;
+        }
+        m_cv.notify_all();
+        throw;
+    }
+    return slot->request_id;
+}
+
+void PipelinedNetwork::Impl::on_complete(Slot& slot) {
+    try {
+        m_callback(slot.request_id, slot.outputs);
+    } catch (std::exception& e) {
+        LITE_WARN(
+                "the completion callback of request %zu of PipelinedNetwork "
+                "throws: %s",
+                slot.request_id, e.what());
+    }
+    {
+        LITE_LOCK_GUARD(m_mtx);
+        slot.busy = false;
+        m_nr_completed++;
+    }
+    m_cv.notify_all();
+}
+
+void PipelinedNetwork::Impl::wait_all() {
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_cv.wait(lock, [this]() { return m_nr_completed == m_nr_submitted; });
+}
+
+#else
+
+class PipelinedNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network>, CompletionCallback, size_t) {
+        LITE_THROW("PipelinedNetwork is not supported without thread.");
+    }
+    Outputs get_next_inputs() { return {}; }
+    size_t submit() { return 0; }
+    void wait_all() {}
+    size_t nr_completed() const { return 0; }
+};
+
+#endif
+
+PipelinedNetwork::PipelinedNetwork(
+        std::shared_ptr<Network> network, CompletionCallback callback, size_t depth) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl = std::make_unique<Impl>(std::move(network), std::move(callback), depth);
+    LITE_ERROR_HANDLER_END
+}
+
+PipelinedNetwork::~PipelinedNetwork() = default;
+
+PipelinedNetwork::Outputs PipelinedNetwork::get_next_inputs() {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->get_next_inputs();
+    LITE_ERROR_HANDLER_END
+}
+
+size_t PipelinedNetwork::submit() {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->submit();
+    LITE_ERROR_HANDLER_END
+}
+
+void PipelinedNetwork::wait_all() {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl->wait_all();
+    LITE_ERROR_HANDLER_END
+}
+
+size_t PipelinedNetwork::get_nr_completed() const {
+    return m_impl->nr_completed();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
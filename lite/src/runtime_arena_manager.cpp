@@ -0,0 +1,143 @@
+#include "lite_build_config.h"
+
+#include "lite/network.h"
+#include "misc.h"
+#include "network_impl_base.h"
+
+#include "mge/function_dft.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace lite;
+
+#if !__DEPLOY_ON_XP_SP2__
+
+class RuntimeArenaManager::Impl {
+public:
+    explicit Impl(size_t nr_arena) : m_arenas(nr_arena) {
+        LITE_ASSERT(nr_arena > 0, "RuntimeArenaManager needs at least one arena.");
+    }
+
+    void add_network(std::shared_ptr<Network> network, size_t arena) {
+        LITE_ASSERT(
+                arena < m_arenas.size(), "arena %zu out of range, there are %zu.",
+                arena, m_arenas.size());
+        LITE_ASSERT(
+                !NetworkHelper::loaded(network),
+                "the network should be added before the model loaded.");
+        LITE_LOCK_GUARD(m_mtx);
+        LITE_ASSERT(
+                !m_network2arena.count(network.get()),
+                "the network is already added.");
+        auto&& networks = m_arenas[arena].networks;
+        if (!networks.empty()) {
+            Runtime::share_runtime_memory_with(network, networks.front());
+        }
+        networks.push_back(network);
+        m_network2arena[network.get()] = arena;
+    }
+
+    void forward(const std::shared_ptr<Network>& network) {
+        auto&& arena = get_arena(network);
+        //! the static memory is only bound to the running graph when it
+        //! executes, so the networks of an arena only need to be serialized
+        LITE_LOCK_GUARD(arena.mtx);
+        network->forward();
+        network->wait();
+    }
+
+    MemoryInfo get_memory_info() const {
+        MemoryInfo info;
+        for (auto&& arena : m_arenas) {
+            std::vector<std::shared_ptr<Network>> networks;
+            {
+                LITE_LOCK_GUARD(m_mtx);
+                networks = arena.networks;
+            }
+            size_t arena_size = 0;
+            LITE_LOCK_GUARD(arena.mtx);
+            for (auto&& network : networks) {
+                auto size = static_memory_size(network);
+                arena_size = std::max(arena_size, size);
+                info.required_size += size;
+            }
+            info.arena_size += arena_size;
+        }
+        return info;
+    }
+
+private:
+    struct Arena {
+        //! the first network holds the memory shared by the others
+        std::vector<std::shared_ptr<Network>> networks;
+        mutable std::mutex mtx;
+    };
+
+    Arena& get_arena(const std::shared_ptr<Network>& network) {
+        LITE_LOCK_GUARD(m_mtx);
+        auto iter = m_network2arena.find(network.get());
+        LITE_ASSERT(
+                iter != m_network2arena.end(),
+                "the network is not added to the RuntimeArenaManager.");
+        return m_arenas[iter->second];
+    }
+
+    static size_t static_memory_size(const std::shared_ptr<Network>& network) {
+        if (!NetworkHelper::loaded(network)) {
+            return 0;
+        }
+        auto network_impl = NetworkHelper::implement(network);
+        LITE_ASSERT(
+                network_impl->get_backend_type() == LiteBackend::LITE_DEFAULT,
+                "RuntimeArenaManager is not aviliable in the backend.");
+        return call_func<NetworkImplDft, size_t>(
+                "get_static_memory_size", network_impl);
+    }
+
+    std::vector<Arena> m_arenas;
+    std::unordered_map<Network*, size_t> m_network2arena;
+    mutable std::mutex m_mtx;
+};
+
+#else
+
+class RuntimeArenaManager::Impl {
+public:
+    explicit Impl(size_t) {
+        LITE_THROW("RuntimeArenaManager is not supported without thread.");
+    }
+    void add_network(std::shared_ptr<Network>, size_t) {}
+    void forward(const std::shared_ptr<Network>&) {}
+    MemoryInfo get_memory_info() const { return {}; }
+};
+
+#endif
+
+RuntimeArenaManager::RuntimeArenaManager(size_t nr_arena) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl = std::make_unique<Impl>(nr_arena);
+    LITE_ERROR_HANDLER_END
+}
+
+RuntimeArenaManager::~RuntimeArenaManager() = default;
+
+void RuntimeArenaManager::add_network(std::shared_ptr<Network> network, size_t arena) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl->add_network(std::move(network), arena);
+    LITE_ERROR_HANDLER_END
+}
+
+void RuntimeArenaManager::forward(std::shared_ptr<Network> network) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl->forward(network);
+    LITE_ERROR_HANDLER_END
+}
+
+RuntimeArenaManager::MemoryInfo RuntimeArenaManager::get_memory_info() const {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->get_memory_info();
+    LITE_ERROR_HANDLER_END
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
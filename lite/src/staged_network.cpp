@@ -0,0 +1,110 @@
+#include "lite_build_config.h"
+
+#include "lite/network.h"
+#include "misc.h"
+#include "network_impl_base.h"
+
+using namespace lite;
+
+class StagedNetwork::Impl {
+public:
+    Impl(std::shared_ptr<Network> network);
+    ~Impl();
+
+    Outputs get_staging_inputs() const { return m_slots[m_cur]; }
+
+    void forward();
+
+    Outputs wait();
+
+private:
+    static constexpr size_t NR_SLOT = 2;
+
+    std::shared_ptr<Network> m_network;
+    //! the pinned input tensors of each slot
+    Outputs m_slots[NR_SLOT];
+    //! the slot the next batch is staged into
+    size_t m_cur = 0;
+    bool m_running = false;
+};
+
+StagedNetwork::Impl::Impl(std::shared_ptr<Network> network)
+        : m_network{std::move(network)} {
+    LITE_ASSERT(m_network, "StagedNetwork is constructed with an empty network.");
+    LITE_ASSERT(
+            NetworkHelper::loaded(m_network),
+            "StagedNetwork should be constructed after the network loaded.");
+    auto device_type = m_network->get_device_type();
+    auto device_id = m_network->get_device_id();
+    size_t nr_input = m_network->get_all_input_name().size();
+    for (size_t i = 0; i < nr_input; i++) {
+        auto input = m_network->get_input_tensor(i);
+        LITE_ASSERT(
+                device_type == LiteDeviceType::LITE_CPU || input->is_pinned_host(),
+                "the %zu-th input of StagedNetwork should be a host input.", i);
+        for (auto&& slot : m_slots) {
+            slot.emplace_back(std::make_shared<Tensor>(
+                    device_id, device_type, input->get_layout(), true));
+        }
+    }
+}
+
+StagedNetwork::Impl::~Impl() {
+    if (m_running) {
+        m_network->wait();
+    }
+}
+
+void StagedNetwork::Impl::forward() {
+    if (m_running) {
+        wait();
+    }
+    auto&& slot = m_slots[m_cur];
+    for (size_t i = 0; i < slot.size(); i++) {
+        //! the input shares the pinned memory, so the copy in the graph reads
+        //! the slot asynchronously
+        m_network->get_input_tensor(i)->reset(
+                slot[i]->get_memory_ptr(), slot[i]->get_layout());
+    }
+    m_network->forward();
+    m_running = true;
+    m_cur = (m_cur + 1) % NR_SLOT;
+}
+
+StagedNetwork::Outputs StagedNetwork::Impl::wait() {
+    LITE_ASSERT(m_running, "wait for StagedNetwork without forward.");
+    m_network->wait();
+    m_running = false;
+    Outputs outputs;
+    size_t nr_output = m_network->get_all_output_name().size();
+    for (size_t i = 0; i < nr_output; i++) {
+        outputs.emplace_back(m_network->get_output_tensor(i));
+    }
+    return outputs;
+}
+
+StagedNetwork::StagedNetwork(std::shared_ptr<Network> network) {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl = std::make_unique<Impl>(std::move(network));
+    LITE_ERROR_HANDLER_END
+}
+
+StagedNetwork::~StagedNetwork() = default;
+
+StagedNetwork::Outputs StagedNetwork::get_staging_inputs() const {
+    return m_impl->get_staging_inputs();
+}
+
+void StagedNetwork::forward() {
+    LITE_ERROR_HANDLER_BEGIN
+    m_impl->forward();
+    LITE_ERROR_HANDLER_END
+}
+
+StagedNetwork::Outputs StagedNetwork::wait() {
+    LITE_ERROR_HANDLER_BEGIN
+    return m_impl->wait();
+    LITE_ERROR_HANDLER_END
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
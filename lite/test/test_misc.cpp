@@ -1,6 +1,7 @@
 #include "lite_build_config.h"
 
 #if LITE_BUILD_WITH_MGE
+#include "../src/decryption/aes_decrypt.h"
 #include "../src/decryption/decrypt_base.h"
 #include "../src/network_impl_base.h"
 #include "test_common.h"
@@ -45,6 +46,35 @@ TEST(TestMisc, DecryptionUpdate) {
             3);
 }
 
+TEST(TestMisc, AESDecryptionParallel) {
+    auto key = AESDcryption::get_decrypt_key();
+    //! the chunks of a large model are decrypted by multiple threads
+    size_t length = AESDcryption::MIN_BYTES_PER_THREAD * 3 + 5,
+           padded_length = (length + 15) / 16 * 16;
+    std::mt19937 rng(42);
+    std::vector<uint8_t> plain(length), padded_plain(padded_length, 0),
+            model(16 + padded_length + 8);
+    for (auto& i : plain) {
+        i = rng();
+    }
+    std::copy(plain.begin(), plain.end(), padded_plain.begin());
+    uint8_t iv[16];
+    for (size_t i = 0; i < 16; ++i) {
+        model[i] = iv[i] = rng();
+    }
+    mbedtls_aes_context ctx;
+    mbedtls_aes_init(&ctx);
+    mbedtls_aes_setkey_enc(&ctx, key.data(), 256);
+    mbedtls_aes_crypt_cbc(
+            &ctx, MBEDTLS_AES_ENCRYPT, padded_length, iv, padded_plain.data(),
+            model.data() + 16);
+    mbedtls_aes_free(&ctx);
+    for (size_t i = 0; i < 8; ++i) {
+        model[16 + padded_length + i] = static_cast<uint8_t>(length >> (8 * (7 - i)));
+    }
+    ASSERT_EQ(plain, AESDcryption::decrypt_model(model.data(), model.size(), key));
+}
+
 TEST(TestMisc, SharedSameDeviceTensor) {
     using namespace mgb;
     serialization::GraphLoader::LoadConfig mgb_config;
@@ -3,15 +3,21 @@
 
 #if LITE_BUILD_WITH_MGE
 #include "./test_common.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/io.h"
+#include "megbrain/opr/tensor_manip.h"
 #include "megbrain/tensor.h"
 
 #ifndef WIN32
 #include <dirent.h>
 #include <string.h>
+#include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
+#include <numeric>
 #include <random>
 #include <unordered_map>
 using namespace lite;
@@ -379,6 +385,87 @@ TEST(TestNetWork, SharedRuntimeMem) {
     network_dst->load_model(model_path);
 }
 
+TEST(TestNetWork, RuntimeArenaManager) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    constexpr size_t nr_network = 4, nr_arena = 2;
+    RuntimeArenaManager manager{nr_arena};
+    std::vector<std::shared_ptr<Network>> networks;
+    for (size_t i = 0; i < nr_network; i++) {
+        networks.push_back(std::make_shared<Network>(config));
+        manager.add_network(networks.back(), i % nr_arena);
+    }
+    ASSERT_THROW(manager.add_network(networks[0]), std::exception);
+    for (auto&& network : networks) {
+        network->load_model(model_path);
+        network->get_input_tensor(0)->copy_from(*lite_tensor);
+    }
+    std::shared_ptr<Network> loaded = std::make_shared<Network>(config);
+    loaded->load_model(model_path);
+    ASSERT_THROW(manager.add_network(loaded), std::exception);
+    ASSERT_THROW(manager.forward(loaded), std::exception);
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < nr_network; i++) {
+        workers.emplace_back([&, i]() {
+            for (size_t j = 0; j < 3; j++) {
+                manager.forward(networks[i]);
+            }
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    for (auto&& network : networks) {
+        compare_lite_tensor<float>(network->get_output_tensor(0), result_mgb);
+    }
+
+    auto info = manager.get_memory_info();
+    ASSERT_GT(info.arena_size, 0u);
+    ASSERT_EQ(info.arena_size * nr_network / nr_arena, info.required_size);
+    ASSERT_EQ(info.required_size - info.arena_size, info.saved_size());
+}
+
+TEST(TestNetWork, UpdateWeights) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    ASSERT_THROW(Runtime::update_weights(network, model_path), std::exception);
+    network->load_model(model_path);
+    auto context = Runtime::create_execution_context(network);
+    ASSERT_THROW(Runtime::update_weights(context, model_path), std::exception);
+
+    auto run = [&](std::shared_ptr<Network> net) {
+        net->get_input_tensor(0)->copy_from(*lite_tensor);
+        net->forward();
+        net->wait();
+        return net->get_output_tensor(0);
+    };
+    auto output = run(network);
+    void* output_ptr = output->get_memory_ptr();
+    compare_lite_tensor<float>(output, result_mgb);
+
+    Runtime::update_weights(network, model_path);
+    output = run(network);
+    ASSERT_EQ(output_ptr, output->get_memory_ptr());
+    compare_lite_tensor<float>(output, result_mgb);
+    compare_lite_tensor<float>(run(context), result_mgb);
+
+    //! the preprocessed weights are not updated
+    config.options.weight_preprocess = true;
+    std::shared_ptr<Network> network2 = std::make_shared<Network>(config);
+    network2->load_model(model_path);
+    ASSERT_THROW(Runtime::update_weights(network2, model_path), std::exception);
+}
+
 TEST(TestNetWork, UserAllocator) {
     auto allocator = std::make_shared<CheckAllocator>();
     {
@@ -469,6 +556,430 @@ TEST(TestNetWork, ThreadAffinity) {
     compare_lite_tensor<float>(output_tensor, result_mgb);
 }
 
+TEST(TestNetWork, ThreadSpinBudget) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    Runtime::set_cpu_threads_number(network, 4);
+    ASSERT_THROW(Runtime::set_cpu_thread_spin_budget(network, 100), std::exception);
+    network->load_model(model_path);
+    Runtime::set_cpu_thread_spin_budget(network, 100);
+
+    std::shared_ptr<Tensor> input_tensor = network->get_input_tensor(0);
+    input_tensor->reset(lite_tensor->get_memory_ptr(), lite_tensor->get_layout());
+    for (size_t i = 0; i < 3; i++) {
+        network->forward();
+        network->wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto stats = Runtime::get_cpu_thread_wait_stats(network, true);
+    ASSERT_GT(stats.spin_time_us, 0);
+    stats = Runtime::get_cpu_thread_wait_stats(network);
+    ASSERT_EQ(stats.nr_wakeup, 0u);
+
+    std::shared_ptr<Tensor> output_tensor = network->get_output_tensor(0);
+    compare_lite_tensor<float>(output_tensor, result_mgb);
+}
+
+TEST(TestNetWork, ThreadSpeedWeighted) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    Runtime::set_cpu_threads_number(network, 4);
+    ASSERT_THROW(
+            Runtime::set_cpu_thread_speed_weighted(network, true), std::exception);
+    network->load_model(model_path);
+    Runtime::set_cpu_thread_speed_weighted(network, true);
+
+    std::shared_ptr<Tensor> input_tensor = network->get_input_tensor(0);
+    input_tensor->reset(lite_tensor->get_memory_ptr(), lite_tensor->get_layout());
+    for (size_t i = 0; i < 3; i++) {
+        network->forward();
+        network->wait();
+        std::shared_ptr<Tensor> output_tensor = network->get_output_tensor(0);
+        compare_lite_tensor<float>(output_tensor, result_mgb);
+    }
+    auto speeds = Runtime::get_cpu_thread_speeds(network);
+    ASSERT_EQ(speeds.size(), 4u);
+    float total = 0;
+    for (auto speed : speeds) {
+        ASSERT_GT(speed, 0.f);
+        total += speed;
+    }
+    ASSERT_NEAR(total, 4.f, 1e-3);
+
+    Runtime::set_cpu_thread_speed_weighted(network, false);
+    network->forward();
+    network->wait();
+    std::shared_ptr<Tensor> output_tensor = network->get_output_tensor(0);
+    compare_lite_tensor<float>(output_tensor, result_mgb);
+}
+
+TEST(TestNetWork, ExecutionContext) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    ASSERT_THROW(Runtime::create_execution_context(network), std::exception);
+    network->load_model(model_path);
+
+    constexpr size_t nr_context = 3;
+    std::vector<std::shared_ptr<Network>> contexts{network};
+    for (size_t i = 1; i < nr_context; i++) {
+        contexts.push_back(Runtime::create_execution_context(network));
+    }
+    std::vector<std::shared_ptr<Tensor>> outputs(nr_context);
+    auto run = [&](size_t idx) {
+        auto&& ctx = contexts[idx];
+        std::shared_ptr<Tensor> input_tensor = ctx->get_input_tensor(0);
+        input_tensor->copy_from(*lite_tensor);
+        for (size_t i = 0; i < 3; i++) {
+            ctx->forward();
+            ctx->wait();
+        }
+        outputs[idx] = ctx->get_output_tensor(0);
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < nr_context; i++) {
+        workers.emplace_back(run, i);
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    for (auto&& output : outputs) {
+        compare_lite_tensor<float>(output, result_mgb);
+    }
+}
+
+TEST(TestNetWork, BatchedNetwork) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    config.options.no_profiling_on_shape_change = true;
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    ASSERT_THROW(BatchedNetwork{network}, std::exception);
+    network->load_model(model_path);
+
+    BatchConfig batch_config;
+    batch_config.max_batch_size = 4;
+    batch_config.max_delay_us = 100000;
+    BatchedNetwork batcher{network, batch_config};
+
+    constexpr size_t nr_request = 6;
+    std::vector<std::future<BatchedNetwork::Outputs>> futures;
+    for (size_t i = 0; i < nr_request; i++) {
+        futures.emplace_back(batcher.submit({lite_tensor}));
+    }
+    for (auto&& future : futures) {
+        auto outputs = future.get();
+        ASSERT_EQ(outputs.size(), 1u);
+        compare_lite_tensor<float>(outputs[0], result_mgb);
+    }
+    ASSERT_LT(batcher.get_nr_forward(), nr_request);
+}
+
+TEST(TestNetWork, BucketedNetwork) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    network->load_model(model_path);
+
+    BucketConfig bucket_config;
+    bucket_config.capacity = 1;
+    bucket_config.buckets = {2, 4};
+    BucketedNetwork padded{network, bucket_config};
+    for (size_t i = 0; i < 2; i++) {
+        auto outputs = padded.forward({lite_tensor});
+        compare_lite_tensor<float>(outputs[0], result_mgb);
+    }
+    ASSERT_EQ(padded.get_nr_created(), 1u);
+
+    BucketedNetwork exact{network, {}};
+    exact.forward({lite_tensor});
+    auto outputs = exact.forward({lite_tensor});
+    compare_lite_tensor<float>(outputs[0], result_mgb);
+    ASSERT_EQ(exact.get_nr_created(), 1u);
+    ASSERT_EQ(exact.get_nr_cached(), 1u);
+}
+
+TEST(TestNetWork, BucketedNetworkEvict) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    network->load_model(model_path);
+    int stream_id = network->get_stream_id();
+
+    //! the two shapes evict the context of each other
+    auto layout = lite_tensor->get_layout();
+    layout.shapes[0] = 2;
+    auto batched = std::make_shared<Tensor>(LiteDeviceType::LITE_CPU, layout);
+    batched->fill_zero();
+    batched->slice({0}, {1})->copy_from(*lite_tensor);
+
+    BucketConfig bucket_config;
+    bucket_config.capacity = 1;
+    BucketedNetwork bucketed{network, bucket_config};
+    constexpr size_t nr_iter = 8;
+    for (size_t i = 0; i < nr_iter; i++) {
+        auto outputs = bucketed.forward({i % 2 ? batched : lite_tensor});
+        compare_lite_tensor<float>(outputs[0]->slice({0}, {1}), result_mgb);
+    }
+    ASSERT_EQ(bucketed.get_nr_created(), nr_iter);
+    ASSERT_EQ(bucketed.get_nr_cached(), 1u);
+
+    //! the ids of the evicted contexts are reused, so only the cached context
+    //! and the new one occupy a stream
+    auto context = Runtime::create_execution_context(network);
+    ASSERT_EQ(context->get_stream_id(), stream_id + 2);
+    context.reset();
+    context = Runtime::create_execution_context(network);
+    ASSERT_EQ(context->get_stream_id(), stream_id + 2);
+}
+
+namespace {
+/*!
+ * a toy model with the IO of DecodeNetwork, whose greedy next token is always
+ * the last token plus one; the positions, block table and cache are read but
+ * do not change the logits
+ */
+std::vector<uint8_t> make_toy_decode_model(
+        size_t vocab, size_t block_size, size_t nr_blocks) {
+    using namespace mgb;
+    auto graph = ComputingGraph::make();
+    auto cn = CompNode::load("cpu0");
+    auto make_input = [&](const char* name, const TensorShape& shape, DType dtype) {
+        auto host = std::make_shared<HostTensorND>(cn, shape, dtype);
+        memset(host->raw_ptr(), 0, host->layout().span().dist_byte());
+        return opr::Host2DeviceCopy::make(*graph, host, {name});
+    };
+    auto tokens = make_input("tokens", {1, 1}, dtype::Int32()),
+         positions = make_input("positions", {1}, dtype::Int32()),
+         block_table = make_input("block_table", {1, 1}, dtype::Int32()),
+         cache = make_input("kv_cache0", {nr_blocks, 1, block_size, 1},
+                            dtype::Float32());
+
+    HostTensorND host_iota{cn, {1, 1, vocab}, dtype::Float32()};
+    for (size_t i = 0; i < vocab; ++i) {
+        host_iota.ptr<float>()[i] = i;
+    }
+    auto iota = opr::ImmutableTensor::make(*graph, host_iota);
+    auto next = opr::TypeCvt::make(tokens, dtype::Float32()).add_axis(2) + 1.f;
+    auto sum = [](SymbolVar x) {
+        auto xf = opr::TypeCvt::make(x, dtype::Float32());
+        return opr::reduce_sum(xf, xf.make_scalar(1));
+    };
+    auto unused = (sum(positions) + sum(block_table) + sum(cache)) * 0.f;
+    auto logits = -opr::abs(next - iota) + unused;
+    logits.rename("logits");
+
+    std::vector<uint8_t> buf;
+    auto dumper = serialization::GraphDumper::make(
+            serialization::OutputFile::make_vector_proxy(&buf));
+    dumper->dump(SymbolVarArray{logits});
+    return buf;
+}
+
+std::shared_ptr<Network> load_toy_decode_model(const DecodeConfig& config) {
+    NetworkIO io;
+    io.inputs.push_back({"kv_cache0", false});
+    auto network = std::make_shared<Network>(Config{}, io);
+    auto model = make_toy_decode_model(64, config.block_size, config.nr_blocks);
+    network->load_model(model.data(), model.size());
+    return network;
+}
+
+std::vector<int> next_tokens(int last, size_t nr) {
+    std::vector<int> ret(nr);
+    std::iota(ret.begin(), ret.end(), last + 1);
+    return ret;
+}
+}  // namespace
+
+TEST(TestNetWork, DecodeNetworkBatching) {
+    DecodeConfig config;
+    config.nr_blocks = 16;
+    config.block_size = 4;
+    config.max_batch_size = 4;
+    config.eos_token = 12;
+    auto network = load_toy_decode_model(config);
+    DecodeNetwork runtime{network, network, config};
+
+    std::vector<std::vector<int>> prompts{{1, 2, 3}, {10}, {20, 21, 22, 23, 24}};
+    std::vector<size_t> max_new_tokens{5, 3, 6};
+    std::vector<size_t> ids;
+    for (size_t i = 0; i < prompts.size(); ++i) {
+        ids.push_back(runtime.submit(prompts[i], max_new_tokens[i]));
+    }
+    //! finishes at once without being queued
+    auto empty_id = runtime.submit({5}, 0);
+
+    size_t max_running = 0, nr_steps = 0;
+    std::vector<size_t> finished;
+    while (!runtime.idle()) {
+        ASSERT_LT(++nr_steps, 100u);
+        auto ret = runtime.step();
+        finished.insert(finished.end(), ret.begin(), ret.end());
+        max_running = std::max(max_running, runtime.get_nr_running());
+    }
+    //! the sequences admitted one by one are decoded in one batch
+    ASSERT_EQ(prompts.size(), max_running);
+    ASSERT_EQ(prompts.size(), finished.size());
+    ASSERT_EQ(config.nr_blocks, runtime.get_nr_free_blocks());
+
+    ASSERT_EQ(next_tokens(3, 5), runtime.get_generated(ids[0]));
+    //! stops at the eos token
+    ASSERT_EQ(next_tokens(10, 2), runtime.get_generated(ids[1]));
+    ASSERT_EQ(next_tokens(24, 6), runtime.get_generated(ids[2]));
+    ASSERT_TRUE(runtime.get_generated(empty_id).empty());
+    for (auto id : ids) {
+        runtime.release(id);
+        ASSERT_THROW(runtime.get_generated(id), std::exception);
+    }
+}
+
+TEST(TestNetWork, DecodeNetworkPreempt) {
+    DecodeConfig config;
+    config.nr_blocks = 3;
+    config.block_size = 2;
+    config.max_batch_size = 2;
+    auto network = load_toy_decode_model(config);
+    DecodeNetwork runtime{network, network, config};
+
+    auto first = runtime.submit({1, 2}, 4);
+    auto second = runtime.submit({30, 31}, 4);
+    size_t nr_preempted = 0, nr_steps = 0, last_running = 0;
+    std::vector<size_t> finished;
+    while (!runtime.idle()) {
+        ASSERT_LT(++nr_steps, 100u);
+        auto ret = runtime.step();
+        //! a running sequence leaves the batch without finishing
+        if (runtime.get_nr_running() + ret.size() < last_running) {
+            ++nr_preempted;
+        }
+        last_running = runtime.get_nr_running();
+        finished.insert(finished.end(), ret.begin(), ret.end());
+    }
+    ASSERT_GT(nr_preempted, 0u);
+    //! the preempted sequence is prefilled again with its generated tokens
+    ASSERT_EQ((std::vector<size_t>{first, second}), finished);
+    ASSERT_EQ(next_tokens(2, 4), runtime.get_generated(first));
+    ASSERT_EQ(next_tokens(31, 4), runtime.get_generated(second));
+    ASSERT_EQ(config.nr_blocks, runtime.get_nr_free_blocks());
+
+    //! a prompt that can never fit in the cache
+    runtime.submit({1, 2, 3, 4, 5, 6, 7}, 1);
+    ASSERT_THROW(runtime.step(), std::exception);
+}
+
+TEST(TestNetWork, KVBlockAllocator) {
+    KVBlockAllocator allocator{4, 16};
+    allocator.add_sequence(0);
+    allocator.add_sequence(1);
+    ASSERT_THROW(allocator.add_sequence(0), std::exception);
+
+    ASSERT_TRUE(allocator.reserve(0, 17));
+    ASSERT_EQ(allocator.get_block_table(0), (std::vector<int>{0, 1}));
+    ASSERT_TRUE(allocator.reserve(1, 16));
+    ASSERT_EQ(allocator.get_block_table(1), (std::vector<int>{2}));
+    //! no block is taken when the reservation fails
+    ASSERT_FALSE(allocator.reserve(1, 48));
+    ASSERT_EQ(allocator.get_nr_free_blocks(), 1u);
+    ASSERT_TRUE(allocator.reserve(0, 32));
+    ASSERT_EQ(allocator.get_block_table(0).size(), 2u);
+
+    allocator.remove_sequence(0);
+    ASSERT_FALSE(allocator.has_sequence(0));
+    ASSERT_EQ(allocator.get_nr_free_blocks(), 3u);
+    ASSERT_TRUE(allocator.reserve(1, 64));
+    ASSERT_EQ(allocator.get_block_table(1), (std::vector<int>{2, 0, 1, 3}));
+}
+
+TEST(TestNetWork, StagedNetwork) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    network->load_model(model_path);
+
+    StagedNetwork staged{network};
+    ASSERT_THROW(staged.wait(), std::exception);
+    auto inputs = staged.get_staging_inputs();
+    ASSERT_EQ(inputs.size(), 1u);
+    inputs[0]->copy_from(*lite_tensor);
+    staged.forward();
+    for (size_t i = 0; i < 3; i++) {
+        //! the other set is staged while forwarding
+        auto next = staged.get_staging_inputs();
+        ASSERT_NE(next[0]->get_memory_ptr(), inputs[0]->get_memory_ptr());
+        next[0]->copy_from(*lite_tensor);
+        auto outputs = staged.wait();
+        compare_lite_tensor<float>(outputs[0], result_mgb);
+        staged.forward();
+        inputs = next;
+    }
+    auto outputs = staged.wait();
+    compare_lite_tensor<float>(outputs[0], result_mgb);
+}
+
+TEST(TestNetWork, PipelinedNetwork) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    network->load_model(model_path);
+
+    std::mutex mtx;
+    std::vector<size_t> completed;
+    auto callback = [&](size_t request_id, const PipelinedNetwork::Outputs& outputs) {
+        compare_lite_tensor<float>(outputs[0], result_mgb);
+        std::lock_guard<std::mutex> lock(mtx);
+        completed.push_back(request_id);
+    };
+    PipelinedNetwork pipeline{network, callback, 2};
+    ASSERT_THROW(pipeline.submit(), std::exception);
+    constexpr size_t nr_request = 6;
+    for (size_t i = 0; i < nr_request; i++) {
+        auto inputs = pipeline.get_next_inputs();
+        ASSERT_EQ(inputs.size(), 1u);
+        inputs[0]->copy_from(*lite_tensor);
+        ASSERT_EQ(pipeline.submit(), i);
+    }
+    pipeline.wait_all();
+    ASSERT_EQ(pipeline.get_nr_completed(), nr_request);
+    std::sort(completed.begin(), completed.end());
+    for (size_t i = 0; i < nr_request; i++) {
+        ASSERT_EQ(completed[i], i);
+    }
+}
+
 TEST(TestNetWork, BasicCryptAes) {
     Config config;
     auto lite_tensor = get_input_data("./input_data.npy");
@@ -1125,6 +1636,135 @@ TEST(TestNetWork, GlabalLayoutTransform) {
     remove(dump_model_name.c_str());
 }
 
+TEST(TestNetWork, RuntimeState) {
+    auto tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+    std::string state_path = "./shufflenet_runtime_state.bin";
+    set_persistent_cache("./algo_cache_runtime_state.txt");
+
+    Config config;
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    Runtime::enable_global_layout_transform(network);
+    ASSERT_THROW(network->dump_runtime_state(state_path), std::exception);
+    network->load_model(model_path);
+    network->get_input_tensor(0)->copy_from(*tensor);
+    network->forward();
+    network->wait();
+    network->dump_runtime_state(state_path);
+    ASSERT_THROW(network->load_runtime_state(state_path), std::exception);
+
+    //! the transformed graph is loaded without enabling layout transform
+    std::shared_ptr<Network> network2 = std::make_shared<Network>(config);
+    network2->load_runtime_state(state_path);
+    network2->load_model(model_path);
+    network2->get_input_tensor(0)->copy_from(*tensor);
+    network2->forward();
+    network2->wait();
+    compare_lite_tensor<float>(
+            network2->get_output_tensor(0), network->get_output_tensor(0));
+
+    //! the state can be dumped again from the network loaded with it
+    std::string state_path2 = "./shufflenet_runtime_state2.bin";
+    network2->dump_runtime_state(state_path2);
+    std::shared_ptr<Network> network3 = std::make_shared<Network>(config);
+    network3->load_runtime_state(state_path2);
+    network3->load_model(model_path);
+
+    std::shared_ptr<Network> network4 = std::make_shared<Network>(config);
+    network4->load_runtime_state(state_path);
+    ASSERT_THROW(
+            network4->load_model("./test_pack_cache_to_model.lite"), std::exception);
+
+    remove(state_path.c_str());
+    remove(state_path2.c_str());
+    remove("./algo_cache_runtime_state.txt");
+}
+
+#ifndef WIN32
+TEST(TestNetWork, ArtifactDir) {
+    auto tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+    std::string artifact_dir = "./lite_artifacts";
+    set_artifact_dir(artifact_dir);
+    auto sub_dir = get_artifact_dir();
+    ASSERT_EQ(0u, sub_dir.find(artifact_dir + "/"));
+    //! the fingerprint is validated when it is set again on the same device
+    set_artifact_dir(artifact_dir);
+    ASSERT_EQ(sub_dir, get_artifact_dir());
+
+    auto list_artifacts = [&]() {
+        std::vector<std::string> file_names;
+        DIR* dirptr = opendir(sub_dir.c_str());
+        struct dirent* dirp;
+        while (dirptr != NULL && (dirp = readdir(dirptr)) != NULL) {
+            std::string file_name(dirp->d_name);
+            if (file_name != "." && file_name != "..") {
+                file_names.push_back(sub_dir + "/" + file_name);
+            }
+        }
+        if (dirptr) {
+            closedir(dirptr);
+        }
+        std::sort(file_names.begin(), file_names.end());
+        return file_names;
+    };
+    auto run = [&]() {
+        Config config;
+        std::shared_ptr<Network> network = std::make_shared<Network>(config);
+        Runtime::enable_global_layout_transform(network);
+        network->load_model(model_path);
+        network->get_input_tensor(0)->copy_from(*tensor);
+        network->forward();
+        network->wait();
+        return network;
+    };
+
+    auto network = run();
+    auto artifacts = list_artifacts();
+    //! the fingerprint, the algo cache and the transformed model
+    ASSERT_EQ(3u, artifacts.size());
+
+    //! the transformed model is loaded from the artifact dir
+    auto network2 = run();
+    compare_lite_tensor<float>(
+            network2->get_output_tensor(0), network->get_output_tensor(0));
+    ASSERT_EQ(artifacts, list_artifacts());
+
+    for (auto&& file_name : artifacts) {
+        remove(file_name.c_str());
+    }
+    rmdir(sub_dir.c_str());
+    rmdir(artifact_dir.c_str());
+}
+#endif
+
+TEST(TestNetWork, HeterogeneousPartition) {
+    Config config;
+    auto lite_tensor = get_input_data("./input_data.npy");
+    std::string model_path = "./shufflenet.mge";
+
+    auto result_mgb = mgb_lar(model_path, config, "data", lite_tensor);
+
+    //! the convolutions are moved to another cpu comp node
+    PartitionConfig partition_config;
+    PartitionDevice device0, device1;
+    device0.unsupported_oprs = {"ConvolutionForward", "ConvBiasForward"};
+    device1.device_id = 1;
+    partition_config.devices = {device0, device1};
+
+    std::shared_ptr<Network> network = std::make_shared<Network>(config);
+    Runtime::enable_heterogeneous_partition(network, partition_config);
+    network->load_model(model_path);
+    ASSERT_THROW(
+            Runtime::enable_heterogeneous_partition(network, partition_config),
+            std::exception);
+    std::shared_ptr<Tensor> input_tensor = network->get_input_tensor(0);
+    input_tensor->copy_from(*lite_tensor);
+    network->forward();
+    network->wait();
+    compare_lite_tensor<float>(network->get_output_tensor(0), result_mgb);
+}
+
 TEST(TestNetWork, GetDeviceType) {
     auto tensor = get_input_data("./input_data.npy");
     std::string model_path = "./shufflenet.mge";
@@ -13,6 +13,7 @@
 #include "megbrain/tensor.h"
 
 #include <string.h>
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <random>
@@ -721,6 +722,70 @@ TEST(TestCapiNetWork, BasicResetOutput) {
     LITE_CAPI_CHECK(LITE_destroy_network(c_network));
 }
 
+TEST(TestCapiNetWork, IOBinding) {
+    ForwardMgb;
+    MakeNetwork;
+    LoadNetwork;
+    const char* output_name;
+    LITE_CAPI_CHECK(LITE_get_output_name(c_network, 0, &output_name));
+    LiteLayout input_layout{{1, 3, 224, 224}, 4, LiteDataType::LITE_FLOAT};
+    LiteLayout output_layout{{1, 1000}, 2, LiteDataType::LITE_FLOAT};
+
+    //! two bindings share the input and write to their own outputs
+    std::vector<std::shared_ptr<float>> outputs;
+    LiteIOBinding bindings[2];
+    for (auto&& binding : bindings) {
+        outputs.emplace_back(new float[1000], [](float* ptr) { delete[] ptr; });
+        LITE_CAPI_CHECK(LITE_make_io_binding(c_network, &binding));
+        LiteExternalBuffer input{
+                LITE_BUFFER_HOST_PTR, lite_tensor->get_memory_ptr(), -1, 0,
+                data_length_in_byte};
+        LITE_CAPI_CHECK(LITE_io_binding_bind(
+                binding, "data", LITE_INPUT, &input, input_layout));
+        LiteExternalBuffer output{
+                LITE_BUFFER_HOST_PTR, outputs.back().get(), -1, 0,
+                1000 * sizeof(float)};
+        LITE_CAPI_CHECK(LITE_io_binding_bind(
+                binding, output_name, LITE_OUTPUT, &output, output_layout));
+    }
+    //! the buffer is validated when bound
+    LiteExternalBuffer small{
+            LITE_BUFFER_HOST_PTR, outputs.back().get(), -1, 0, sizeof(float)};
+    ASSERT_NE(
+            0, LITE_io_binding_bind(
+                       bindings[0], output_name, LITE_OUTPUT, &small, output_layout));
+
+    for (size_t i = 0; i < 4; i++) {
+        LITE_CAPI_CHECK(LITE_io_binding_apply(bindings[i % 2]));
+        ForwardNetwork;
+        EXPECT_TRUE(lite::compare_memory<float>(
+                outputs[i % 2].get(), result_mgb->get_memory_ptr(),
+                result_mgb->get_tensor_total_size_in_byte() / sizeof(float)));
+        std::fill_n(outputs[i % 2].get(), 1000, 0.f);
+    }
+
+    //! binding an IO again replaces the buffer bound before
+    std::shared_ptr<float> rebound{new float[1000], [](float* ptr) { delete[] ptr; }};
+    LiteExternalBuffer rebound_output{
+            LITE_BUFFER_HOST_PTR, rebound.get(), -1, 0, 1000 * sizeof(float)};
+    LITE_CAPI_CHECK(LITE_io_binding_bind(
+            bindings[0], output_name, LITE_OUTPUT, &rebound_output, output_layout));
+    LITE_CAPI_CHECK(LITE_io_binding_apply(bindings[1]));
+    LITE_CAPI_CHECK(LITE_io_binding_apply(bindings[0]));
+    ForwardNetwork;
+    EXPECT_TRUE(lite::compare_memory<float>(
+            rebound.get(), result_mgb->get_memory_ptr(),
+            result_mgb->get_tensor_total_size_in_byte() / sizeof(float)));
+    EXPECT_TRUE(std::all_of(outputs[0].get(), outputs[0].get() + 1000, [](float v) {
+        return v == 0.f;
+    }));
+
+    for (auto&& binding : bindings) {
+        LITE_CAPI_CHECK(LITE_destroy_io_binding(binding));
+    }
+    LITE_CAPI_CHECK(LITE_destroy_network(c_network));
+}
+
 TEST(TestCapiNetWork, BasicInplaceAndSingleThreadAffinity) {
     ForwardMgb;
     MakeNetwork;
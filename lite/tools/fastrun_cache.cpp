@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+
+#include "megbrain/utils/infile_persistent_cache.h"
+
+using namespace mgb;
+
+typedef int (*CommandHandler)(int, char**);
+
+const char* usage =
+        "Usage:\n"
+        " fastrun_cache info <cache file>\n"
+        " fastrun_cache diff <cache file> <other cache file>\n"
+        " fastrun_cache merge [--overwrite] <output file> <input file>...\n"
+        " fastrun_cache prune <input file> <output file> <category prefix>...\n"
+        "\n"
+        "The category of a cache entry starts with the traits of the device it is\n"
+        "profiled on, such as plat=cuda;dev=<name>;cap=<major>.<minor>, so prune\n"
+        "keeps the entries of the devices matching any of the given prefixes.\n";
+
+int command_info(int argc, char** argv) {
+    if (argc != 3) {
+        printf("Invalid info arguments.\n");
+        return 1;
+    }
+    InFilePersistentCache cache{argv[2]};
+    size_t nr_entries = 0;
+    for (auto&& i : cache.summary()) {
+        printf("%8zu %s\n", i.second, i.first.c_str());
+        nr_entries += i.second;
+    }
+    printf("%8zu entries in total\n", nr_entries);
+    return 0;
+}
+
+int command_diff(int argc, char** argv) {
+    if (argc != 4) {
+        printf("Invalid diff arguments.\n");
+        return 1;
+    }
+    InFilePersistentCache cache0{argv[2]}, cache1{argv[3]};
+    auto diff = cache0.diff(cache1);
+    if (diff.empty()) {
+        printf("The caches are identical.\n");
+        return 0;
+    }
+    printf("  only in first / only in second / different  category\n");
+    for (auto&& i : diff) {
+        printf(
+                "%15zu %17zu %11zu  %s\n", i.nr_only_self, i.nr_only_other,
+                i.nr_different, i.category.c_str());
+    }
+    return 2;
+}
+
+int command_merge(int argc, char** argv) {
+    int arg = 2;
+    bool overwrite = false;
+    if (arg < argc && std::string{argv[arg]} == "--overwrite") {
+        overwrite = true;
+        ++arg;
+    }
+    if (argc - arg < 2) {
+        printf("Invalid merge arguments.\n");
+        return 1;
+    }
+    const char* output_file_path = argv[arg++];
+    InFilePersistentCache cache;
+    for (; arg < argc; ++arg) {
+        auto nr_entries = cache.merge(InFilePersistentCache{argv[arg]}, overwrite);
+        printf("%zu entries merged from %s\n", nr_entries, argv[arg]);
+    }
+    cache.dump_cache(output_file_path);
+    printf("Done.\n");
+    return 0;
+}
+
+int command_prune(int argc, char** argv) {
+    if (argc < 5) {
+        printf("Invalid prune arguments.\n");
+        return 1;
+    }
+    InFilePersistentCache cache{argv[2]};
+    std::vector<std::string> prefixes(argv + 4, argv + argc);
+    auto nr_entries = cache.prune([&](const std::string& category) {
+        for (auto&& i : prefixes) {
+            if (!category.compare(0, i.size(), i))
+                return true;
+        }
+        return false;
+    });
+    cache.dump_cache(argv[3]);
+    printf("%zu entries pruned.\n", nr_entries);
+    return 0;
+}
+
+std::unordered_map<std::string, CommandHandler> commands = {
+        {"info", command_info},
+        {"diff", command_diff},
+        {"merge", command_merge},
+        {"prune", command_prune},
+};
+
+int main(int argc, char** argv) {
+    if (argc == 1) {
+        printf("%s", usage);
+        return 1;
+    }
+
+    auto it = commands.find(argv[1]);
+    if (it == commands.end()) {
+        printf("Invalid command arguments.\n");
+        printf("%s", usage);
+        return 1;
+    }
+    return it->second(argc, argv);
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
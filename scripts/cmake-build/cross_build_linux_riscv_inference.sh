@@ -1,7 +1,7 @@
 #!/usr/bin/env bash
 set -e
 
-ARCHS=("rv64gcv0p7" "rv64norvv")
+ARCHS=("rv64gcv0p7" "rv64gcv" "rv64norvv")
 BUILD_TYPE=Release
 ARCH=rv64gcv0p7
 REMOVE_OLD_BUILD=false
@@ -140,6 +140,8 @@ build_flatc $SRC_DIR $REMOVE_OLD_BUILD
 toolchain=null
 if [ "$ARCH" = "rv64gcv0p7" ]; then
     toolchain="riscv64-rvv-linux-gnu.toolchain.cmake"
+elif [ "$ARCH" = "rv64gcv" ]; then
+    toolchain="riscv64-rvv1p0-linux-gnu.toolchain.cmake"
 elif [ "$ARCH" = "rv64norvv" ]; then
     toolchain="riscv64-linux-gnu.toolchain.cmake"
 else
@@ -5,6 +5,8 @@
 #if CNRT_MAJOR_VERSION >= 5
 #include "megbrain/cambricon/magicmind_runtime_opr.h"
 
+#include <algorithm>
+
 using namespace mgb;
 using namespace opr;
 using namespace magicmind;
@@ -157,9 +159,7 @@ MagicMindRuntimeOpr::MagicMindRuntimeOpr(
         : Super(inputs[0]->owner_graph(), config, "magic_runtime", inputs),
           m_allocator{std::move(allocator)},
           m_engine{nullptr},
-          m_context{nullptr},
-          m_model{std::move(model)},
-          m_current_ptr{nullptr} {
+          m_model{std::move(model)} {
     mgb_assert(
             inputs[0]->comp_node().device_type() == CompNode::DeviceType::CAMBRICON,
             "MagicMindRuntimeOpr can only be used on cambricon comp node; "
@@ -191,114 +191,137 @@ MagicMindRuntimeOpr::MagicMindRuntimeOpr(
     add_equivalence_component<mgb::ScalarHash<void*>>(m_model.get());
 };
 
-void MagicMindRuntimeOpr::scn_do_execute() {
-    mgb_assert(m_engine != nullptr);
-    mgb_assert(m_context != nullptr);
-    auto&& cnrt_env = CompNodeEnv::from_comp_node(input(0)->comp_node()).cnrt_env();
-    cnrt_env.activate();
-    std::vector<IRTTensor*> inputs, outputs;
-    MM_CHECK(CreateInputTensors(m_context.get(), &inputs));
-    MM_CHECK(CreateOutputTensors(m_context.get(), &outputs));
+void MagicMindRuntimeOpr::ShapeContext::destroy_tensors() {
+    for (auto&& i : inputs) {
+        i->Destroy();
+    }
+    for (auto&& o : outputs) {
+        o->Destroy();
+    }
+    inputs.clear();
+    outputs.clear();
+}
+
+void MagicMindRuntimeOpr::init_context(ShapeContext& ctx) const {
+    ctx.destroy_tensors();
+    ctx.context = {
+            m_engine->CreateIContext(), magicmind_intl::MagicMindDeleter<IContext>()};
+    mgb_assert(
+            ctx.context != nullptr,
+            "failed to create IContext, corresponding MagicMindRuntimeOpr(%s)",
+            cname());
+    ctx.workspace_ptr = nullptr;
+    MM_CHECK(CreateInputTensors(ctx.context.get(), &ctx.inputs));
+    MM_CHECK(CreateOutputTensors(ctx.context.get(), &ctx.outputs));
     size_t nr_inputs = input().size();
-    mgb_assert(nr_inputs == inputs.size());
+    mgb_assert(nr_inputs == ctx.inputs.size());
+    // keep the tensors in the order of the vars, so that they can be bound by
+    // index on execution
+    std::vector<IRTTensor*> inputs(nr_inputs);
     for (size_t i = 0; i < nr_inputs; ++i) {
         auto&& iname = m_model->GetInputName(i);
-        auto tensor = FindIRTTensorByName(inputs, iname);
+        inputs[i] = FindIRTTensorByName(ctx.inputs, iname);
         mgb_assert(
-                tensor != nullptr, "failed to find input tensor(name:%s)",
+                inputs[i] != nullptr, "failed to find input tensor(name:%s)",
                 iname.c_str());
-        MM_CHECK(tensor->SetDimensions(mgb_shape_to_mm_dims(input(i)->shape())));
-        MM_CHECK(tensor->SetData(input(i)->dev_tensor().raw_ptr()));
+        MM_CHECK(inputs[i]->SetDimensions(mgb_shape_to_mm_dims(ctx.inp_shapes[i])));
     }
-    size_t nr_outputs = output().size();
-    mgb_assert(nr_outputs == outputs.size() + 1);
-    for (size_t i = 0; i < nr_outputs - 1; ++i) {
+    ctx.inputs = std::move(inputs);
+    mgb_assert(
+            Status::OK() == ctx.context->InferOutputShape(ctx.inputs, ctx.outputs),
+            "static shape infer for MagicMindRuntimeOpr(%s) failed", cname());
+    size_t nr_outputs = output().size() - 1;
+    mgb_assert(nr_outputs == ctx.outputs.size());
+    std::vector<IRTTensor*> outputs(nr_outputs);
+    ctx.out_shapes.resize(nr_outputs + 1);
+    for (size_t i = 0; i < nr_outputs; ++i) {
         auto&& oname = m_model->GetOutputName(i);
-        auto tensor = FindIRTTensorByName(outputs, oname);
+        outputs[i] = FindIRTTensorByName(ctx.outputs, oname);
         mgb_assert(
-                tensor != nullptr, "failed to find output tensor(name:%s)",
+                outputs[i] != nullptr, "failed to find output tensor(name:%s)",
                 oname.c_str());
-        MM_CHECK(tensor->SetDimensions(mgb_shape_to_mm_dims(output(i)->shape())));
-        MM_CHECK(tensor->SetData(output(i)->dev_tensor().raw_ptr()));
-    }
-    if (m_current_ptr == nullptr) {
-        auto size = output().back()->dev_tensor().layout().span().dist_byte();
-        m_current_ptr = output().back()->dev_tensor().raw_ptr();
-        MM_CHECK(m_context->SetWorkspace(m_current_ptr, size));
-    } else {
-        auto current_ptr = output().back()->dev_tensor().raw_ptr();
-        mgb_assert(
-                current_ptr == m_current_ptr,
-                "workspace has been changed, the execution context should be "
-                "reconstructed, but now this is not supported (got:%p,prev:%p)",
-                current_ptr, m_current_ptr);
+        ctx.out_shapes[i] = mm_dims_to_mgb_shape(outputs[i]->GetDimensions());
     }
-    MM_CHECK(m_context->Enqueue(inputs, outputs, cnrt_env.queue));
-    for (auto&& i : inputs) {
-        i->Destroy();
+    ctx.outputs = std::move(outputs);
+    std::vector<Dims> shape(nr_inputs);
+    for (size_t i = 0; i < nr_inputs; ++i) {
+        shape[i] = mgb_shape_to_mm_dims(ctx.inp_shapes[i]);
     }
-    for (auto&& o : outputs) {
-        o->Destroy();
+    MM_CHECK(m_engine->QueryContextMaxWorkspaceSize(shape, &ctx.workspace_size));
+    ctx.out_shapes.back() = {ctx.workspace_size};
+}
+
+MagicMindRuntimeOpr::ShapeContext* MagicMindRuntimeOpr::get_context(
+        const TensorShapeArray& inp_shapes) const {
+    auto match = [&](const std::unique_ptr<ShapeContext>& ctx) {
+        if (ctx->inp_shapes.size() != inp_shapes.size())
+            return false;
+        for (size_t i = 0; i < inp_shapes.size(); ++i) {
+            if (!ctx->inp_shapes[i].eq_shape(inp_shapes[i]))
+                return false;
+        }
+        return true;
+    };
+    auto iter = std::find_if(m_contexts.begin(), m_contexts.end(), match);
+    if (iter == m_contexts.end()) {
+        if (m_contexts.size() >= MAX_NR_CACHED_CONTEXT) {
+            m_contexts.pop_back();
+        }
+        auto ctx = std::make_unique<ShapeContext>();
+        ctx->inp_shapes = inp_shapes;
+        init_context(*ctx);
+        m_contexts.insert(m_contexts.begin(), std::move(ctx));
+    } else if (iter != m_contexts.begin()) {
+        std::rotate(m_contexts.begin(), iter, iter + 1);
     }
+    return m_contexts.front().get();
 }
 
-void MagicMindRuntimeOpr::get_output_var_shape(
-        const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
+void MagicMindRuntimeOpr::scn_do_execute() {
     mgb_assert(m_engine != nullptr);
-    mgb_assert(input().size() == inp_shape.size());
     auto&& cnrt_env = CompNodeEnv::from_comp_node(input(0)->comp_node()).cnrt_env();
     cnrt_env.activate();
-    if (m_context == nullptr) {
-        m_context = {
-                m_engine->CreateIContext(),
-                magicmind_intl::MagicMindDeleter<IContext>()};
-        mgb_assert(
-                m_context != nullptr,
-                "failed to create IContext, corresponding MagicMindRuntimeOpr(%s)",
-                cname());
-    }
-    std::vector<IRTTensor*> inputs, outputs;
-    MM_CHECK(CreateInputTensors(m_context.get(), &inputs));
-    MM_CHECK(CreateOutputTensors(m_context.get(), &outputs));
-    size_t nr_inputs = input().size();
-    mgb_assert(nr_inputs == inputs.size());
+    size_t nr_inputs = input().size(), nr_outputs = output().size() - 1;
+    TensorShapeArray inp_shapes(nr_inputs);
     for (size_t i = 0; i < nr_inputs; ++i) {
-        auto&& iname = m_model->GetInputName(i);
-        auto tensor = FindIRTTensorByName(inputs, iname);
-        mgb_assert(
-                tensor != nullptr, "failed to find input tensor(name:%s)",
-                iname.c_str());
-        MM_CHECK(tensor->SetDimensions(mgb_shape_to_mm_dims(inp_shape[i])));
+        inp_shapes[i] = input(i)->shape();
     }
-    if (Status::OK() == m_context->InferOutputShape(inputs, outputs)) {
-        size_t nr_outputs = output().size();
-        mgb_assert(nr_outputs == outputs.size() + 1);
-        for (size_t i = 0; i < nr_outputs - 1; ++i) {
-            auto&& oname = m_model->GetOutputName(i);
-            auto tensor = FindIRTTensorByName(outputs, oname);
-            mgb_assert(
-                    tensor != nullptr, "failed to find output tensor(name:%s)",
-                    oname.c_str());
-            auto&& dims = tensor->GetDimensions();
-            out_shape[i] = mm_dims_to_mgb_shape(dims);
-        }
-        std::vector<Dims> shape(inp_shape.size());
-        for (size_t i = 0; i < nr_inputs; ++i) {
-            shape[i] = mgb_shape_to_mm_dims(inp_shape[i]);
+    MGB_LOCK_GUARD(m_context_mtx);
+    auto ctx = get_context(inp_shapes);
+    auto&& workspace = output().back()->dev_tensor();
+    void* workspace_ptr = workspace.raw_ptr();
+    if (ctx->workspace_ptr != workspace_ptr) {
+        // a context can not be rebound to another workspace, so it is
+        // reconstructed when the workspace var has been reallocated
+        if (ctx->workspace_ptr != nullptr) {
+            init_context(*ctx);
         }
-        size_t wk_size = 0;
-        MM_CHECK(m_engine->QueryContextMaxWorkspaceSize(shape, &wk_size));
-        out_shape.back() = {wk_size};
-    } else {
-        mgb_assert(
-                false, "static shape infer for MagicMindRuntimeOpr(%s) failed",
-                cname());
+        MM_CHECK(ctx->context->SetWorkspace(
+                workspace_ptr, workspace.layout().span().dist_byte()));
+        ctx->workspace_ptr = workspace_ptr;
     }
-    for (auto&& i : inputs) {
-        i->Destroy();
+    for (size_t i = 0; i < nr_inputs; ++i) {
+        MM_CHECK(ctx->inputs[i]->SetData(input(i)->dev_tensor().raw_ptr()));
     }
-    for (auto&& o : outputs) {
-        o->Destroy();
+    for (size_t i = 0; i < nr_outputs; ++i) {
+        MM_CHECK(ctx->outputs[i]->SetData(output(i)->dev_tensor().raw_ptr()));
+    }
+    // the engine runs asynchronously on the queue of the comp node, which is
+    // synchronized with other oprs by the events of the comp node
+    MM_CHECK(ctx->context->Enqueue(ctx->inputs, ctx->outputs, cnrt_env.queue));
+}
+
+void MagicMindRuntimeOpr::get_output_var_shape(
+        const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
+    mgb_assert(m_engine != nullptr);
+    mgb_assert(input().size() == inp_shape.size());
+    auto&& cnrt_env = CompNodeEnv::from_comp_node(input(0)->comp_node()).cnrt_env();
+    cnrt_env.activate();
+    MGB_LOCK_GUARD(m_context_mtx);
+    auto ctx = get_context(inp_shape);
+    mgb_assert(out_shape.size() == ctx->out_shapes.size());
+    for (size_t i = 0; i < out_shape.size(); ++i) {
+        out_shape[i] = ctx->out_shapes[i];
     }
 }
 
@@ -6,6 +6,7 @@
 #if MGB_CAMBRICON
 #if CNRT_MAJOR_VERSION >= 5
 
+#include <mutex>
 #include <sstream>
 #include "mm_runtime.h"
 
@@ -78,12 +79,39 @@ public:
         return {model, magicmind_intl::MagicMindDeleter<magicmind::IModel>()};
     }
 
+    //! max number of input shapes whose execution context is kept
+    static constexpr size_t MAX_NR_CACHED_CONTEXT = 8;
+
 private:
+    /*!
+     * \brief execution context of one group of input shapes
+     *
+     * The runtime tensors are created once and bound to the device tensors of
+     * the vars in place on each execution, so that switching between cached
+     * shapes needs neither shape inference nor context creation.
+     */
+    struct ShapeContext {
+        TensorShapeArray inp_shapes, out_shapes;
+        IContextPtr context;
+        std::vector<magicmind::IRTTensor*> inputs, outputs;
+        size_t workspace_size = 0;
+        void* workspace_ptr = nullptr;
+
+        ~ShapeContext() { destroy_tensors(); }
+        void destroy_tensors();
+    };
+
     CambriconAllocatorPtr m_allocator;
     IEnginePtr m_engine;
-    mutable IContextPtr m_context;
     IModelPtr m_model;
-    dt_byte* m_current_ptr;
+    mutable std::mutex m_context_mtx;
+    //! cached contexts, the most recently used first
+    mutable std::vector<std::unique_ptr<ShapeContext>> m_contexts;
+
+    //! find or create the context of given input shapes; m_context_mtx must
+    //! be held by the caller
+    ShapeContext* get_context(const TensorShapeArray& inp_shapes) const;
+    void init_context(ShapeContext& ctx) const;
 };
 
 }  // namespace opr
@@ -649,6 +649,45 @@ TEST(TestMagicMindRuntimeOpr, GraphShapeMutable) {
     check(Dims{{7, 64, 16, 16}}, Dims{{7, 64, 16, 16}});
 }
 
+TEST(TestMagicMindRuntimeOpr, ShapeContextCache) {
+    REQUIRE_CAMBRICON_DEVICE(1);
+    auto cn = CompNode::load("cambricon0");
+    MMNetwork network(cn, magicmind::DataType::FLOAT32, true);
+    auto buf = network.get_serialized_model(true);
+
+    HostTensorGenerator<dtype::Float32, RandomDistribution::GAUSSIAN> gen(0, 1);
+    auto x = gen({1, 32, 32, 64}, cn);
+    auto add = gen({1, 32, 32, 64}, cn);
+    auto graph = ComputingGraph::make();
+    auto x_ = opr::Host2DeviceCopy::make(*graph, x);
+    auto add_ = opr::Host2DeviceCopy::make(*graph, add);
+    auto outs = opr::MagicMindRuntimeOpr::make(
+            reinterpret_cast<const void*>(buf.data()), buf.size(), {x_, add_});
+    HostTensorND o1, o2;
+    auto func = graph->compile(
+            {make_callback_copy(outs[0], o1), make_callback_copy(outs[1], o2)});
+
+    // switch back and forth between the shapes, which are served by the cached
+    // contexts after their first execution
+    auto run = [&](size_t n, size_t h) {
+        *x = *gen({n, h, h, 64}, cn);
+        *add = *gen({n, h, h, 64}, cn);
+        func->execute();
+        HostTensorND e1, e2;
+        e1.copy_from(o1);
+        e2.copy_from(o2);
+        func->execute();
+        MGB_ASSERT_TENSOR_EQ(e1, o1);
+        MGB_ASSERT_TENSOR_EQ(e2, o2);
+        ASSERT_EQ(TensorShape({n, h, h, 64}), o1.shape());
+    };
+    for (size_t i = 0; i < 2; ++i) {
+        run(1, 32);
+        run(8, 32);
+        run(3, 16);
+    }
+}
+
 TEST(TestMagicMindRuntimeOpr, Serialization) {
     using namespace serialization;
     REQUIRE_CAMBRICON_DEVICE(1);
@@ -12,6 +12,7 @@
 
 #include <atomic>
 #include <cstring>
+#include <unordered_map>
 
 using namespace mgb;
 
@@ -55,6 +56,8 @@ std::string get_stream_str(int stream) {
             return "REMOTE_SEND";
         case S::LOOP_SWAP:
             return "LOOP_SWAP";
+        case S::ASYNC_PROFILE:
+            return "ASYNC_PROFILE";
         default:
             return std::to_string(stream);
     }
@@ -81,6 +84,72 @@ CompNode::DeviceType resolve_device_type(CompNode::DeviceType type) {
 }
 }  // namespace
 
+/* ==================== PooledEvent ==================== */
+
+namespace {
+/*!
+ * \brief free events of all comp nodes, keyed by comp node and creation flags
+ *
+ * Pooling is disabled after CompNode::finalize(), and events released after
+ * that are destroyed directly.
+ */
+class SharedEventPool final : public CompNodeDepedentObject {
+    using EventList = std::vector<std::unique_ptr<CompNode::Event>>;
+
+    Spinlock m_lock;
+    CompNode::UnorderedMap<std::unordered_map<size_t, EventList>> m_free;
+
+    std::shared_ptr<void> on_comp_node_finalize() override {
+        MGB_LOCK_GUARD(m_lock);
+        m_free.clear();
+        return {};
+    }
+
+public:
+    static SharedEventPool& inst() {
+        // never destructed, since pooled events may be released after the
+        // static objects have been destructed
+        static SharedEventPool* pool = new SharedEventPool;
+        return *pool;
+    }
+
+    CompNode::Event* alloc(CompNode cn, size_t flags) {
+        {
+            MGB_LOCK_GUARD(m_lock);
+            if (!is_finalized()) {
+                auto iter = m_free.find(cn);
+                if (iter != m_free.end()) {
+                    auto&& list = iter->second[flags];
+                    if (!list.empty()) {
+                        auto event = list.back().release();
+                        list.pop_back();
+                        return event;
+                    }
+                }
+            }
+        }
+        return cn.create_event(flags).release();
+    }
+
+    void free(CompNode::Event* event) {
+        std::unique_ptr<CompNode::Event> ptr{event};
+        MGB_LOCK_GUARD(m_lock);
+        if (!is_finalized()) {
+            m_free[event->comp_node()][event->create_flags()].emplace_back(
+                    std::move(ptr));
+        }
+    }
+};
+}  // anonymous namespace
+
+void CompNode::PooledEventDeleter::operator()(Event* event) const {
+    SharedEventPool::inst().free(event);
+}
+
+CompNode::PooledEvent CompNode::create_pooled_event(size_t flags) const {
+    return PooledEvent{SharedEventPool::inst().alloc(*this, flags)};
+}
+
 /* ==================== EventPool ==================== */
 
 CompNode::EventPool::EventPool(CompNode cn, size_t flags) : m_cn{cn}, m_flags{flags} {}
@@ -96,7 +165,7 @@ CompNode::Event* CompNode::EventPool::alloc() {
         m_free.pop_back();
         return rst;
     }
-    m_allocated.push_back(m_cn.create_event(m_flags));
+    m_allocated.push_back(m_cn.create_pooled_event(m_flags));
     return m_allocated.back().get();
 }
 
@@ -125,6 +194,27 @@ CompNode::Locator CompNode::Locator::parse(const std::string& id) {
     };
     if (id.size() < 3)
         err();
+    {
+        //! strip the :numa<k> suffix and parse the remaining part
+        auto numa_pos = id.rfind(":numa");
+        if (numa_pos != std::string::npos) {
+            auto numa_str = id.substr(numa_pos + 5);
+            if (numa_str.empty() ||
+                numa_str.find_first_not_of("0123456789") != std::string::npos) {
+                err();
+            }
+            auto base = id.substr(0, numa_pos);
+            if (base == "cpu") {
+                base = "cpux";
+            }
+            auto ret = parse(base);
+            if (ret.type != DeviceType::CPU && ret.type != DeviceType::MULTITHREAD) {
+                err();
+            }
+            ret.numa_node = std::stoi(numa_str);
+            return ret;
+        }
+    }
     // current parsing location
     const char* ptr = id.data();
     if (id == "cpu:default") {
@@ -279,31 +369,36 @@ CompNode::Locator CompNode::Locator::to_physical() const {
             stream_physical = 1023;
         }
     }
-    return {type_physical, device_physical, {stream_physical}};
+    Locator ret{type_physical, device_physical, {stream_physical}};
+    ret.numa_node = numa_node;
+    return ret;
 }
 
 std::string CompNode::Locator::to_string() const {
+    std::string ret;
     if (device == DEVICE_CPU_DEFAULT) {
-        return "cpu:default";
+        ret = "cpu:default";
     } else if (device == DEVICE_MULTITHREAD_DEFAULT) {
-        std::string ret = "multithread:default:";
+        ret = "multithread:default:";
         ret.append(get_stream_str(stream));
-        return ret;
     } else if (type == DeviceType::MULTITHREAD) {
-        std::string ret("multithread");
+        ret = "multithread";
         ret.append(get_stream_str(stream)).append(":").append(get_stream_str(device));
-        return ret;
-    }
-    char numstr[32];
-    if (device == -1) {
-        numstr[0] = 'x';
-        numstr[1] = 0;
     } else {
-        mgb_assert(device >= 0);
-        sprintf(numstr, "%d", device);
+        char numstr[32];
+        if (device == -1) {
+            numstr[0] = 'x';
+            numstr[1] = 0;
+        } else {
+            mgb_assert(device >= 0);
+            sprintf(numstr, "%d", device);
+        }
+        ret = device_type2str(type);
+        ret.append(numstr).append(":").append(get_stream_str(stream));
+    }
+    if (numa_node >= 0) {
+        ret.append(":numa").append(std::to_string(numa_node));
     }
-    std::string ret(device_type2str(type));
-    ret.append(numstr).append(":").append(get_stream_str(stream));
     return ret;
 }
 
@@ -669,6 +764,21 @@ size_t CompNode::ImplBase::get_mem_padding() {
     return 0;
 }
 
+void CompNode::ImplBase::set_mem_limit(size_t, size_t) {
+    mgb_log_warn(
+            "memory limit is not supported on comp node %s",
+            locator().to_string().c_str());
+}
+
+size_t CompNode::ImplBase::add_mem_pressure_callback(MemPressureCallback) {
+    mgb_log_warn(
+            "memory pressure callback is not supported on comp node %s",
+            locator().to_string().c_str());
+    return 0;
+}
+
+void CompNode::ImplBase::remove_mem_pressure_callback(size_t) {}
+
 void CompNode::ImplBase::add_callback(megdnn::thin_function<void()>&&) {
     mgb_throw(
             MegBrainError,
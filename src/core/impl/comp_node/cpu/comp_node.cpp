@@ -2,6 +2,7 @@
 
 #include "megbrain/common.h"
 #include "megbrain/comp_node_env.h"
+#include "megbrain/graph/cg.h"
 #include "megbrain/system.h"
 #include "megbrain/utils/arith_helper.h"
 #include "megbrain/utils/thread.h"
@@ -31,23 +32,38 @@ struct TaskElem {
     //! number of the parallelism
     size_t nr_parallelism;
 };
+
+//! get the cpus of a numa node, or empty if the node is not available
+std::vector<int> get_numa_cpus_checked(int numa_node) {
+    auto cpus = sys::get_numa_node_cpus(numa_node);
+    if (cpus.empty()) {
+        mgb_log_warn(
+                "numa node %d is not available, cpu affinity is not set", numa_node);
+    }
+    return cpus;
+}
 }  // anonymous namespace
 
 void CpuCompNode::CpuDispatchableBase::add_callback(Task&& task) {
     dispatch(std::move(task));
 }
 
-class CpuCompNode::WorkerQueue final : public AsyncQueueSC<TaskElem, WorkerQueue> {
+class CpuCompNode::WorkerQueue final : public AsyncRingQueueSC<TaskElem, WorkerQueue> {
     const Locator m_locator;
     std::shared_ptr<ThreadPool> m_thread_pool = nullptr;
 
     void on_async_queue_worker_thread_start() override {
         mgb_assert(m_locator.device >= 0);
-        if (enable_affinity) {
 #if !defined(ANDROID) && !defined(__ANDROID__) && !defined(__OHOS__)
+        if (enable_affinity) {
             sys::set_cpu_affinity({m_locator.device});
-#endif
+        } else if (m_locator.numa_node >= 0) {
+            auto cpus = get_numa_cpus_checked(m_locator.numa_node);
+            if (!cpus.empty()) {
+                sys::set_cpu_affinity(cpus);
+            }
         }
+#endif
 #if __DEPLOY_ON_XP_SP2__
         __builtin_trap();
 #else
@@ -89,6 +105,8 @@ class CpuCompNode::SeqRecorderImpl final : public CompNodeSeqRecorder {
     using CpuEnv = CompNodeEnv::CpuEnv;
     bool m_fake_exec = false, m_synchronized = false, m_stopped = false,
          m_first_replay = true;
+    //! whether to record again when tensor pointers change (for lean_exec)
+    const bool m_update_on_reset;
     SeqRecorderImpl** const m_self_pointer;
 
     std::vector<TaskElem> m_tasks;
@@ -111,8 +129,9 @@ class CpuCompNode::SeqRecorderImpl final : public CompNodeSeqRecorder {
 public:
     SeqRecorderImpl(
             SeqRecorderImpl** self_pointer, std::shared_ptr<ThreadPool> thread_pool,
-            const CompNode& comp_node)
-            : m_self_pointer{self_pointer},
+            const CompNode& comp_node, bool update_on_reset = false)
+            : m_update_on_reset{update_on_reset},
+              m_self_pointer{self_pointer},
               m_thread_pool{thread_pool},
               m_record_compnode{comp_node} {
         mgb_assert(!*m_self_pointer);
@@ -180,6 +199,18 @@ public:
         });
     }
 
+    bool support_update() const override { return m_update_on_reset; }
+
+    void begin_update(const CompNode& comp_node) override {
+        check_the_same_comp_node(comp_node);
+        mgb_assert(m_stopped && !*m_self_pointer);
+        *m_self_pointer = this;
+        m_tasks.clear();
+        m_stopped = false;
+        m_synchronized = false;
+        m_first_replay = true;
+    }
+
     void on_alloc(const CompNode& comp_node) {
         check_the_same_comp_node(comp_node);
         mgb_assert(m_fake_exec, "alloc is disallowed during comp node seq recording");
@@ -275,7 +306,14 @@ public:
 #endif
     }
 
-    void* alloc_device(size_t size) override { return mgb_aligned_alloc(size); }
+    void* alloc_device(size_t size) override {
+        auto ptr = mgb_aligned_alloc(size);
+        if (m_locator.numa_node >= 0) {
+            //! pages not touched yet would be placed on the numa node
+            sys::bind_memory_to_numa_node(ptr, size, m_locator.numa_node);
+        }
+        return ptr;
+    }
 
     void* alloc_host(size_t size) override { return mgb_aligned_alloc(size); }
 
@@ -400,6 +438,8 @@ public:
 
     size_t get_nr_dispatched_tasks() const override { return m_nr_task; }
 
+    ThreadPool* get_thread_pool() override { return m_queue->get_thread_pool(); }
+
     void set_affinity(AffinityCallBack&& affinity_cb) override {
         auto thread_pool = m_queue->get_thread_pool();
         if (thread_pool) {
@@ -466,6 +506,8 @@ public:
 
     size_t get_nr_dispatched_tasks() const override { return m_nr_task; }
 
+    ThreadPool* get_thread_pool() override { return m_thread_pool.get(); }
+
     void set_affinity(AffinityCallBack&& affinity_cb) override {
         if (auto recorder = m_comp_node->cur_recorder()) {
             recorder->get_thread_pool()->set_affinity(affinity_cb);
@@ -648,6 +690,15 @@ public:
             m_thread_pool = std::shared_ptr<ThreadPool>(
                     new ThreadPool(static_cast<size_t>(locator.nr_threads)));
             mgb_assert(m_thread_pool, "ThradPool create failed");
+#if !defined(ANDROID) && !defined(__ANDROID__) && !defined(__OHOS__)
+            if (locator.numa_node >= 0) {
+                auto cpus = get_numa_cpus_checked(locator.numa_node);
+                if (!cpus.empty()) {
+                    m_thread_pool->set_affinity(
+                            [cpus](size_t) { sys::set_cpu_affinity(cpus); });
+                }
+            }
+#endif
         }
         if (locator.type == DeviceType::CPU) {
             if (locator.device == Locator::DEVICE_CPU_DEFAULT) {
@@ -882,8 +933,10 @@ public:
     }
 
     std::unique_ptr<CompNodeSeqRecorder> create_seq_recorder(
-            cg::ComputingGraph*) override {
-        return std::make_unique<SeqRecorderImpl>(&sm_cur_recorder, m_thread_pool, this);
+            cg::ComputingGraph* cg) override {
+        return std::make_unique<SeqRecorderImpl>(
+                &sm_cur_recorder, m_thread_pool, this,
+                cg && cg->options().lean_exec);
     }
 
     SeqRecorderImpl* cur_recorder() const override { return sm_cur_recorder; }
@@ -921,13 +974,19 @@ struct CpuCompNode::Pool {
             std::unique_ptr<CompNodeRecorderImpl, CompNodeRecorderImplDeleter>,
             CompNode::LocatorPairHashKey::Hash>
             locator2impl;
-    ThinHashMap<std::pair<int, int>, std::weak_ptr<WorkerQueue>> physical2queue;
+    //! worker queues keyed by physical locator
+    std::unordered_map<
+            CompNode::Locator, std::weak_ptr<WorkerQueue>,
+            StdHashAdaptor<CompNode::Locator>>
+            physical2queue;
     std::unordered_map<
             CompNode::LocatorPairHashKey,
             std::unique_ptr<CompNodeRecorderImpl, CompNodeRecorderImplDeleter>,
             CompNode::LocatorPairHashKey::Hash>
             locator2impl_multi_thread;
-    ThinHashMap<std::pair<int, int>, std::weak_ptr<WorkerQueue>>
+    std::unordered_map<
+            CompNode::Locator, std::weak_ptr<WorkerQueue>,
+            StdHashAdaptor<CompNode::Locator>>
             physical2queue_multithead;
 };
 CpuCompNode::Pool* CpuCompNode::sm_pool;
@@ -999,7 +1058,7 @@ CpuCompNode::Impl* CpuCompNode::load_cpu(Locator locator, Locator locator_logica
                 locator_logical.type == CompNode::DeviceType::MULTITHREAD);
     }
     if (locator.type == DeviceType::CPU) {
-        auto&& pqueue_weak = sm_pool->physical2queue[{locator.device, locator.stream}];
+        auto&& pqueue_weak = sm_pool->physical2queue[locator];
         auto pqueue = pqueue_weak.lock();
         if (!pqueue) {
             pqueue = std::make_shared<WorkerQueue>(locator);
@@ -1017,8 +1076,7 @@ CpuCompNode::Impl* CpuCompNode::load_cpu(Locator locator, Locator locator_logica
         return pimpl.get();
     } else {
         mgb_assert(locator.type == DeviceType::MULTITHREAD);
-        auto&& pqueue_weak = sm_pool->physical2queue_multithead[{
-                locator.device, locator.nr_threads}];
+        auto&& pqueue_weak = sm_pool->physical2queue_multithead[locator];
         auto pqueue = pqueue_weak.lock();
         if (!pqueue) {
             pqueue = std::make_shared<WorkerQueue>(locator);
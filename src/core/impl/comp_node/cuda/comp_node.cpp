@@ -1,5 +1,6 @@
 #include "./comp_node.h"
 #include "megbrain/comp_node_env.h"
+#include "megbrain/graph/cg.h"
 #include "megbrain/utils/thread.h"
 
 #include <string>
@@ -13,9 +14,11 @@ using namespace mgb;
 #endif
 
 #include "megbrain/comp_node/alloc.h"
+#include "megbrain/utils/arith_helper.h"
 
 #include <cctype>
 #include <cstdio>
+#include <map>
 #include <regex>
 
 #include <thread>
@@ -145,10 +148,348 @@ public:
     }
 };
 
+#if CUDA_VERSION >= 10020
+/*!
+ * \brief raw allocator that maps physical memory into a reserved virtual
+ *      address range by the virtual memory management API of CUDA
+ *
+ * Chunks are mapped at the lowest free address of the range, so chunks
+ * allocated one after another are adjacent and DevMemAllocImpl can merge
+ * free blocks across their boundaries. A chunk is unmapped and its physical
+ * memory released on free, leaving a hole in the range to be mapped again.
+ */
+class CudaVirtualMemAllocator final : public RawAllocator {
+    const int m_device;
+    size_t m_granularity = 0, m_va_size = 0;
+    CUdeviceptr m_va_base = 0;
+    CUmemAllocationProp m_prop;
+    std::mutex m_mtx;
+    //! address => size of the unmapped ranges in the reserved range
+    std::map<size_t, size_t> m_free_va;
+    //! address => (size, handle) of the mapped chunks
+    std::unordered_map<size_t, std::pair<size_t, CUmemGenericAllocationHandle>>
+            m_chunks;
+
+    //! take a free range of given size at the lowest address
+    size_t take_va_unsafe(size_t size) {
+        for (auto iter = m_free_va.begin(); iter != m_free_va.end(); ++iter) {
+            if (iter->second >= size) {
+                auto addr = iter->first, rest = iter->second - size;
+                m_free_va.erase(iter);
+                if (rest) {
+                    m_free_va.emplace(addr + size, rest);
+                }
+                return addr;
+            }
+        }
+        return 0;
+    }
+
+    //! put a range back and merge it with its neighbours
+    void put_va_unsafe(size_t addr, size_t size) {
+        auto next = m_free_va.lower_bound(addr);
+        if (next != m_free_va.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == addr) {
+                addr = prev->first;
+                size += prev->second;
+                m_free_va.erase(prev);
+            }
+        }
+        if (next != m_free_va.end() && addr + size == next->first) {
+            size += next->second;
+            m_free_va.erase(next);
+        }
+        m_free_va.emplace(addr, size);
+    }
+
+public:
+    CudaVirtualMemAllocator(int device, size_t va_size) : m_device{device} {
+        memset(&m_prop, 0, sizeof(m_prop));
+        m_prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+        m_prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+        m_prop.location.id = device;
+        MGB_CUDA_CU_CHECK(cuMemGetAllocationGranularity(
+                &m_granularity, &m_prop, CU_MEM_ALLOC_GRANULARITY_MINIMUM));
+        if (!va_size) {
+            size_t free, tot;
+            MGB_CUDA_CHECK(cudaMemGetInfo(&free, &tot));
+            // leave room for the holes left by released chunks
+            va_size = tot * 2;
+        }
+        m_va_size = get_aligned_power2(va_size, m_granularity);
+        MGB_CUDA_CU_CHECK(cuMemAddressReserve(&m_va_base, m_va_size, 0, 0, 0));
+        m_free_va.emplace(static_cast<size_t>(m_va_base), m_va_size);
+    }
+
+    ~CudaVirtualMemAllocator() {
+        for (auto&& i : m_chunks) {
+            cuMemUnmap(static_cast<CUdeviceptr>(i.first), i.second.first);
+            cuMemRelease(i.second.second);
+        }
+        cuMemAddressFree(m_va_base, m_va_size);
+    }
+
+    size_t granularity() const { return m_granularity; }
+
+    bool contiguous_chunks() const override { return true; }
+
+    void* alloc(size_t size) override {
+        size = get_aligned_power2(size, m_granularity);
+        MGB_LOCK_GUARD(m_mtx);
+        auto addr = take_va_unsafe(size);
+        if (!addr) {
+            mgb_log_error(
+                    "cuda vmm: no virtual address range for %zu bytes in the "
+                    "reserved %zu bytes",
+                    size, m_va_size);
+            return nullptr;
+        }
+        CUmemGenericAllocationHandle handle;
+        auto err = cuMemCreate(&handle, size, &m_prop, 0);
+        if (err == CUDA_ERROR_OUT_OF_MEMORY) {
+            put_va_unsafe(addr, size);
+            return nullptr;
+        }
+        MGB_CUDA_CU_CHECK(err);
+        auto ptr = static_cast<CUdeviceptr>(addr);
+        MGB_CUDA_CU_CHECK(cuMemMap(ptr, size, 0, handle, 0));
+        CUmemAccessDesc access;
+        access.location = m_prop.location;
+        access.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+        MGB_CUDA_CU_CHECK(cuMemSetAccess(ptr, size, &access, 1));
+        m_chunks.emplace(addr, std::make_pair(size, handle));
+        return reinterpret_cast<void*>(addr);
+    }
+
+    void free(void* ptr) override {
+        MGB_LOCK_GUARD(m_mtx);
+        auto iter = m_chunks.find(reinterpret_cast<size_t>(ptr));
+        mgb_assert(iter != m_chunks.end(), "cuda vmm: free unknown chunk %p", ptr);
+        auto size = iter->second.first;
+        MGB_CUDA_CU_CHECK(cuMemUnmap(static_cast<CUdeviceptr>(iter->first), size));
+        MGB_CUDA_CU_CHECK(cuMemRelease(iter->second.second));
+        put_va_unsafe(iter->first, size);
+        m_chunks.erase(iter);
+    }
+
+    void get_mem_info(size_t& free, size_t& tot) override {
+        MGB_CUDA_CHECK(cudaMemGetInfo(&free, &tot));
+    }
+};
+#endif
+
+#if CUDART_VERSION >= 11020
+/*!
+ * \brief device allocator on the stream-ordered allocator of CUDA
+ *
+ * All streams of a device allocate from one memory pool, and memory freed by
+ * cudaFreeAsync can be reused by later allocations without device
+ * synchronization. Unlike DevMemAllocImpl, the free memory held by the pool
+ * is released to the driver on synchronization once it exceeds the release
+ * threshold, so it could be used by other processes on the same device.
+ */
+class CudaAsyncDevMemAlloc final : public DevMemAlloc {
+    class StreamMemAllocImpl final : public StreamMemAlloc {
+        CudaAsyncDevMemAlloc* const m_par_alloc;
+        const cudaStream_t m_stream;
+        MGB_MUTEX m_mtx;
+        std::unordered_map<void*, size_t> m_allocated_blocks;
+        size_t m_used_size = 0;
+
+        void* alloc(size_t size) override {
+            void* ptr;
+            auto pool = m_par_alloc->m_pool;
+            cudaError_t cuda_error =
+                    cudaMallocFromPoolAsync(&ptr, size, pool, m_stream);
+            if (cuda_error == cudaErrorMemoryAllocation) {
+                // memory freed on other streams is returned to the pool
+                // after synchronization
+                cudaGetLastError();
+                m_par_alloc->m_runtime_policy->device_synchronize(
+                        m_par_alloc->m_device);
+                cuda_error = cudaMallocFromPoolAsync(&ptr, size, pool, m_stream);
+            }
+            if (cuda_error != cudaSuccess) {
+                auto msg = mgb_ssprintf_log(
+                        "cudaMallocFromPoolAsync failed while requesting %zd bytes "
+                        "(%.3fMiB) of memory; error: %s",
+                        size, size / (1024.0 * 1024), cudaGetErrorString(cuda_error));
+                msg.append(CudaError::get_cuda_extra_info());
+                cudaGetLastError();
+                mgb_throw_raw(MemAllocError{msg});
+            }
+            {
+                MGB_LOCK_GUARD(m_mtx);
+                m_allocated_blocks[ptr] = size;
+                m_used_size += size;
+            }
+            m_par_alloc->add_used_size(size);
+            return ptr;
+        }
+
+        void free(void* addr) override {
+            size_t size;
+            {
+                MGB_LOCK_GUARD(m_mtx);
+                auto iter = m_allocated_blocks.find(addr);
+                mgb_assert(
+                        iter != m_allocated_blocks.end(), "releasing bad pointer: %p",
+                        addr);
+                size = iter->second;
+                m_used_size -= size;
+                m_allocated_blocks.erase(iter);
+            }
+            MGB_CUDA_CHECK(cudaFreeAsync(addr, m_stream));
+            m_par_alloc->m_used_size -= size;
+        }
+
+        void get_mem_info(size_t& free, size_t& tot) override {
+            MGB_CUDA_CHECK(cudaMemGetInfo(&free, &tot));
+            free += m_par_alloc->get_pool_free_size();
+        }
+
+        void print_memory_state() override { m_par_alloc->print_memory_state(); }
+
+        size_t get_used_memory() override {
+            MGB_LOCK_GUARD(m_mtx);
+            return m_used_size;
+        }
+
+        FreeMemStat get_free_memory() override {
+            return m_par_alloc->get_free_memory();
+        }
+
+        FreeMemStat get_free_memory_dev() override {
+            return m_par_alloc->get_free_memory_dev();
+        }
+
+    public:
+        StreamMemAllocImpl(CudaAsyncDevMemAlloc* par_alloc, cudaStream_t stream)
+                : m_par_alloc(par_alloc), m_stream(stream) {}
+    };
+
+    const int m_device;
+    cudaMemPool_t m_pool;
+    std::mutex m_mtx;
+    std::shared_ptr<RawAllocator> m_raw_alloc = std::make_shared<CudaRawAllocator>();
+    std::shared_ptr<DeviceRuntimePolicy> m_runtime_policy =
+            std::make_shared<CudaDeviceRuntimePolicy>();
+    ThinHashMap<StreamKey, std::unique_ptr<StreamMemAllocImpl>> m_stream_alloc;
+    std::atomic_size_t m_used_size{0}, m_max_used_size{0};
+
+    void add_used_size(size_t size) {
+        auto cur = m_used_size += size;
+        auto max = m_max_used_size.load();
+        while (cur > max && !m_max_used_size.compare_exchange_weak(max, cur))
+            ;
+    }
+
+    //! memory reserved by the pool from the driver
+    size_t get_pool_reserved_size() {
+#if CUDART_VERSION >= 11030
+        cuuint64_t size;
+        MGB_CUDA_CHECK(cudaMemPoolGetAttribute(
+                m_pool, cudaMemPoolAttrReservedMemCurrent, &size));
+        return size;
+#else
+        return m_used_size.load();
+#endif
+    }
+
+    //! memory reserved by the pool but not allocated
+    size_t get_pool_free_size() {
+        auto reserved = get_pool_reserved_size(), used = m_used_size.load();
+        return reserved > used ? reserved - used : 0;
+    }
+
+    void print_memory_state() override {
+        mgb_log("cuda async allocator %d: used=%zu reserved=%zu", m_device,
+                m_used_size.load(), get_pool_reserved_size());
+    }
+
+    size_t get_used_memory() override { return m_used_size.load(); }
+
+    size_t get_max_used_memory() override { return m_max_used_size.load(); }
+
+    void reset_max_used_memory() override { m_max_used_size = 0; }
+
+    FreeMemStat get_free_memory() override {
+        auto free = get_pool_free_size();
+        return {free, free, free, free ? 1u : 0u};
+    }
+
+    FreeMemStat get_free_memory_dev() override { return get_free_memory(); }
+
+    StreamMemAlloc* add_stream(StreamKey stream) override {
+        MGB_LOCK_GUARD(m_mtx);
+        auto&& v = m_stream_alloc[stream];
+        if (!v)
+            v = std::make_unique<StreamMemAllocImpl>(
+                    this, static_cast<cudaStream_t>(stream));
+        return v.get();
+    }
+
+    const std::shared_ptr<RawAllocator>& raw_allocator() const override {
+        return m_raw_alloc;
+    }
+
+    const std::shared_ptr<DeviceRuntimePolicy>& device_runtime_policy() const override {
+        return m_runtime_policy;
+    }
+
+    size_t gather_stream_free_blk_and_release_full() override {
+        auto before = get_pool_reserved_size();
+        // memory could only be trimmed after the pending frees are done
+        m_runtime_policy->device_synchronize(m_device);
+        MGB_CUDA_CHECK(cudaMemPoolTrimTo(m_pool, 0));
+        auto after = get_pool_reserved_size();
+        return before > after ? before - after : 0;
+    }
+
+public:
+    CudaAsyncDevMemAlloc(int device, size_t release_threshold) : m_device{device} {
+        cudaMemPoolProps props = {};
+        props.allocType = cudaMemAllocationTypePinned;
+        props.handleTypes = cudaMemHandleTypeNone;
+        props.location.type = cudaMemLocationTypeDevice;
+        props.location.id = device;
+        MGB_CUDA_CHECK(cudaMemPoolCreate(&m_pool, &props));
+        cuuint64_t threshold = release_threshold;
+        MGB_CUDA_CHECK(cudaMemPoolSetAttribute(
+                m_pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+    }
+
+    ~CudaAsyncDevMemAlloc() {
+        m_stream_alloc.clear();
+        cudaMemPoolDestroy(m_pool);
+    }
+};
+#endif
+
 /* ===================== DevMemAlloc  ===================== */
 std::unique_ptr<DevMemAlloc> DevMemAlloc::make_cuda_alloc() {
     return std::make_unique<FwdDevMemAlloc>(std::make_shared<CudaRawAllocator>());
 }
+
+std::unique_ptr<DevMemAlloc> DevMemAlloc::make_cuda_async_alloc(
+        int device, size_t release_threshold) {
+#if CUDART_VERSION >= 11020
+    int supported = 0;
+    MGB_CUDA_CHECK(cudaDeviceGetAttribute(
+            &supported, cudaDevAttrMemoryPoolsSupported, device));
+    mgb_throw_if(
+            !supported, MemAllocError,
+            "memory pools are not supported on cuda device %d", device);
+    return std::make_unique<CudaAsyncDevMemAlloc>(device, release_threshold);
+#else
+    MGB_MARK_USED_VAR(device);
+    MGB_MARK_USED_VAR(release_threshold);
+    mgb_throw(
+            MemAllocError, "cudaMallocAsync requires CUDA 11.2, but got %d",
+            CUDART_VERSION);
+#endif
+}
 }  // namespace mem_alloc
 }  // namespace mgb
 
@@ -158,6 +499,7 @@ class CudaCompNode::CompNodeImpl final : public CompNode::Impl {
 
     friend class EventImpl;
     friend class CudaCompNode;
+    friend class CudaCompNode::SeqRecorderImpl;
 
     struct DeviceInfo;
     struct StaticData;
@@ -177,6 +519,9 @@ class CudaCompNode::CompNodeImpl final : public CompNode::Impl {
     std::unique_ptr<Event> m_sync_event;
     Spinlock m_sync_event_mtx;
 
+    //! the recorder capturing on the current thread
+    static MGB_THREAD_LOCAL_PTR(StreamCaptureSeqRecorder) sm_cur_recorder;
+
     void activate() { m_env.cuda_env().activate(); }
 
     void init(const Locator& locator, const Locator& locator_logical);
@@ -245,6 +590,12 @@ public:
         return {tot, free};
     }
 
+    void set_mem_limit(size_t soft_limit, size_t hard_limit) override;
+
+    size_t add_mem_pressure_callback(MemPressureCallback cb) override;
+
+    void remove_mem_pressure_callback(size_t handle) override;
+
 #if !MGB_BUILD_SLIM_SERVING
     std::pair<size_t, size_t> get_free_left_and_right(
             size_t begin_ptr, size_t end_ptr) override {
@@ -292,6 +643,9 @@ public:
 
     uint64_t get_uid() override { return m_uid; }
 
+    std::unique_ptr<CompNodeSeqRecorder> create_seq_recorder(
+            cg::ComputingGraph*) override;
+
 #if !MGB_BUILD_SLIM_SERVING
     void log_mem_pool_details() override;
 
@@ -314,6 +668,112 @@ private:
 #endif
 };
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(CudaCompNode::CompNodeImpl);
+MGB_THREAD_LOCAL_PTR(CompNodeImplHelper::StreamCaptureSeqRecorder)
+CudaCompNodeImpl::sm_cur_recorder = nullptr;
+
+/* ===================== SeqRecorderImpl  ===================== */
+#if CUDART_VERSION >= 10020
+/*!
+ * \brief seq recorder on CUDA Graph
+ *
+ * It is only used when the graph option comp_node_seq_record_device_graph is
+ * set. The instantiated graph is updated in place by cudaGraphExecUpdate,
+ * which is much cheaper than instantiating it again.
+ */
+class CudaCompNode::SeqRecorderImpl final : public StreamCaptureSeqRecorder {
+    cudaGraphExec_t m_graph_exec = nullptr;
+
+    CudaCompNodeImpl* comp_node() const {
+        return static_cast<CudaCompNodeImpl*>(m_comp_node_impl);
+    }
+
+    cudaStream_t stream() const { return comp_node()->m_env.cuda_env().stream; }
+
+    void do_begin_capture() override {
+        comp_node()->activate();
+        // other threads may allocate memory of the device concurrently
+        MGB_CUDA_CHECK(
+                cudaStreamBeginCapture(stream(), cudaStreamCaptureModeRelaxed));
+    }
+
+    void do_drop_capture() override {
+        cudaGraph_t graph = nullptr;
+        MGB_CUDA_CHECK(cudaStreamEndCapture(stream(), &graph));
+        MGB_CUDA_CHECK(cudaGraphDestroy(graph));
+    }
+
+    void do_end_capture() override {
+        cudaGraph_t graph = nullptr;
+        MGB_CUDA_CHECK(cudaStreamEndCapture(stream(), &graph));
+        MGB_TRY { instantiate_or_update(graph); }
+        MGB_FINALLY({ cudaGraphDestroy(graph); });
+    }
+
+    void do_replay() override {
+        comp_node()->activate();
+        MGB_CUDA_CHECK(cudaGraphLaunch(m_graph_exec, stream()));
+    }
+
+    void instantiate_or_update(cudaGraph_t graph) {
+        if (m_graph_exec) {
+#if CUDART_VERSION >= 12000
+            cudaGraphExecUpdateResultInfo info;
+            auto err = cudaGraphExecUpdate(m_graph_exec, graph, &info);
+#else
+            cudaGraphNode_t error_node;
+            cudaGraphExecUpdateResult result;
+            auto err = cudaGraphExecUpdate(m_graph_exec, graph, &error_node, &result);
+#endif
+            if (err == cudaSuccess) {
+                return;
+            }
+            // the topology or node types changed, instantiate again
+            mgb_log_debug("cuda graph can not be updated in place, re-instantiate");
+            cudaGetLastError();
+            MGB_CUDA_CHECK(cudaGraphExecDestroy(m_graph_exec));
+            m_graph_exec = nullptr;
+        }
+#if CUDART_VERSION >= 11040
+        MGB_CUDA_CHECK(cudaGraphInstantiateWithFlags(&m_graph_exec, graph, 0));
+#else
+        MGB_CUDA_CHECK(
+                cudaGraphInstantiate(&m_graph_exec, graph, nullptr, nullptr, 0));
+#endif
+    }
+
+public:
+    SeqRecorderImpl(CudaCompNodeImpl* comp_node)
+            : StreamCaptureSeqRecorder{comp_node, &CudaCompNodeImpl::sm_cur_recorder} {
+        begin_capture();
+    }
+
+    ~SeqRecorderImpl() {
+        if (capturing()) {
+            cudaGraph_t graph = nullptr;
+            cudaStreamEndCapture(stream(), &graph);
+            if (graph) {
+                cudaGraphDestroy(graph);
+            }
+        }
+        if (m_graph_exec) {
+            cudaGraphExecDestroy(m_graph_exec);
+        }
+    }
+};
+#endif
+
+std::unique_ptr<CompNodeSeqRecorder> CudaCompNodeImpl::create_seq_recorder(
+        cg::ComputingGraph* cg) {
+    if (!cg || !cg->options().comp_node_seq_record_device_graph) {
+        return {};
+    }
+#if CUDART_VERSION >= 10020
+    return std::make_unique<SeqRecorderImpl>(this);
+#else
+    mgb_log_error("recording on cuda comp node requires CUDA 10.2");
+    return {};
+#endif
+}
 
 struct CudaCompNodeImpl::DeviceInfo {
     int dev_num = -1;
@@ -354,6 +814,47 @@ struct CudaCompNodeImpl::StaticData {
             dev_info[i].fini();
     }
 
+    /*!
+     * \brief whether to use the stream-ordered allocator of CUDA, and get
+     *      its release threshold
+     *
+     * It is enabled by setting MGB_CUDA_MEM_ALLOC to "async"; the release
+     * threshold could be set by MGB_CUDA_ASYNC_ALLOC_RELEASE_THRESHOLD in
+     * bytes, and it defaults to 0 so the free memory is always returned to
+     * the driver on synchronization.
+     */
+    static bool use_async_mem_alloc(size_t& release_threshold) {
+        auto setting = MGB_GETENV("MGB_CUDA_MEM_ALLOC");
+        if (!setting || strcmp(setting, "async")) {
+            return false;
+        }
+        release_threshold = 0;
+        if (auto threshold = MGB_GETENV("MGB_CUDA_ASYNC_ALLOC_RELEASE_THRESHOLD")) {
+            release_threshold = std::stoull(threshold);
+        }
+        return true;
+    }
+
+    /*!
+     * \brief whether to back the device memory by the virtual memory
+     *      management API, and get the size of the virtual address range
+     *
+     * It is enabled by setting MGB_CUDA_MEM_ALLOC to "vmm"; the range to
+     * reserve could be set by MGB_CUDA_VMM_RESERVE_VA in bytes, and it
+     * defaults to twice the device memory.
+     */
+    static bool use_vmm_mem_alloc(size_t& va_size) {
+        auto setting = MGB_GETENV("MGB_CUDA_MEM_ALLOC");
+        if (!setting || strcmp(setting, "vmm")) {
+            return false;
+        }
+        va_size = 0;
+        if (auto size = MGB_GETENV("MGB_CUDA_VMM_RESERVE_VA")) {
+            va_size = std::stoull(size);
+        }
+        return true;
+    }
+
     static size_t get_mem_reserve_size() {
         if (auto setting = MGB_GETENV("MGB_CUDA_RESERVE_MEMORY")) {
             if (!strncmp(setting, "b:", 2)) {
@@ -495,6 +996,9 @@ void CudaCompNodeImpl::fini() {
 }
 
 void* CudaCompNodeImpl::alloc_device(size_t size) {
+    if (auto rec = sm_cur_recorder) {
+        rec->on_alloc();
+    }
     activate();
 #if MGB_BUILD_SLIM_SERVING
     return m_mem_alloc->alloc(size);
@@ -515,6 +1019,9 @@ void* CudaCompNodeImpl::alloc_device(size_t size) {
 void CudaCompNodeImpl::free_device(void* ptr) {
     if (check_global_finalized())
         return;
+    if (auto rec = sm_cur_recorder) {
+        rec->on_free();
+    }
 
     activate();
 #if !MGB_BUILD_SLIM_SERVING
@@ -559,6 +1066,22 @@ void CudaCompNodeImpl::reset_max_reserved_memory() {
 }
 #endif
 
+void CudaCompNodeImpl::set_mem_limit(size_t soft_limit, size_t hard_limit) {
+    // explicitly call cuda_env() to ensure async init is finished
+    m_env.cuda_env();
+    m_device_info->mem_alloc->limit_config({soft_limit, hard_limit});
+}
+
+size_t CudaCompNodeImpl::add_mem_pressure_callback(MemPressureCallback cb) {
+    m_env.cuda_env();
+    return m_device_info->mem_alloc->add_pressure_callback(std::move(cb));
+}
+
+void CudaCompNodeImpl::remove_mem_pressure_callback(size_t handle) {
+    m_env.cuda_env();
+    m_device_info->mem_alloc->remove_pressure_callback(handle);
+}
+
 void* CudaCompNodeImpl::alloc_host(size_t size) {
     // need activate because it create cuda cuda context in current device
     activate();
@@ -608,6 +1131,13 @@ MemNode CudaCompNodeImpl::mem_node() {
 }
 
 void CudaCompNodeImpl::sync() {
+    if (auto rec = sm_cur_recorder) {
+        mgb_assert(
+                !rec->capturing(),
+                "can not sync %s while capturing cuda graph; oprs that wait "
+                "for device results on host can not be recorded",
+                m_locator.to_string().c_str());
+    }
     activate();
 
     // do not use MGB_CUDA_CHECK(cudaStreamSynchronize(m_env->stream)) since
@@ -685,11 +1215,40 @@ void CudaCompNodeImpl::DeviceInfo::init(const CompNodeEnv& env) {
     auto&& cuenv = env.cuda_env();
     cuenv.activate();
     dev_num = cuenv.device;
+    size_t release_threshold;
+    if (StaticData::use_async_mem_alloc(release_threshold)) {
+        mem_alloc = mem_alloc::DevMemAlloc::make_cuda_async_alloc(
+                dev_num, release_threshold);
+        mgb_log_debug(
+                "cuda: gpu%d: name=`%s' async mem alloc release_threshold=%.2fMiB",
+                dev_num, cuenv.device_prop.name, release_threshold / 1024.0 / 1024);
+        return;
+    }
     auto reserve_size = StaticData::get_mem_reserve_size();
+    std::shared_ptr<mem_alloc::RawAllocator> raw_alloc;
+    auto prealloc_config = sd->prealloc_config;
+    size_t va_size;
+    if (StaticData::use_vmm_mem_alloc(va_size)) {
+#if CUDA_VERSION >= 10020
+        auto vmm_alloc =
+                std::make_shared<mem_alloc::CudaVirtualMemAllocator>(dev_num, va_size);
+        // chunks are mapped in units of the granularity
+        prealloc_config.alignment =
+                std::max(prealloc_config.alignment, vmm_alloc->granularity());
+        reserve_size = get_aligned_power2(reserve_size, vmm_alloc->granularity());
+        raw_alloc = std::move(vmm_alloc);
+#else
+        mgb_throw(
+                MegBrainError, "cuda virtual memory requires CUDA 10.2, but got %d",
+                CUDA_VERSION);
+#endif
+    } else {
+        raw_alloc = std::make_shared<mem_alloc::CudaRawAllocator>();
+    }
     mem_alloc = mem_alloc::DevMemAlloc::make(
-            dev_num, reserve_size, std::make_shared<mem_alloc::CudaRawAllocator>(),
+            dev_num, reserve_size, std::move(raw_alloc),
             std::make_shared<mem_alloc::CudaDeviceRuntimePolicy>());
-    mem_alloc->prealloc_config(sd->prealloc_config);
+    mem_alloc->prealloc_config(prealloc_config);
     auto align = env.property().mem_alignment;
     mem_alloc->alignment(align);
     mgb_log_debug(
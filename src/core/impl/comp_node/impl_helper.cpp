@@ -83,4 +83,80 @@ CompNode CompNodeImplHelper::EventImplHelper::comp_node() const {
     return CompNodeImplHelper::make_comp_node_from_impl(m_comp_node_impl);
 }
 
+/* ===================== StreamCaptureSeqRecorder  ===================== */
+
+CompNodeImplHelper::StreamCaptureSeqRecorder::StreamCaptureSeqRecorder(
+        CompNode::Impl* comp_node_impl, StreamCaptureSeqRecorder** self_pointer)
+        : m_self_pointer{self_pointer}, m_comp_node_impl{comp_node_impl} {
+    set_self_pointer();
+}
+
+CompNodeImplHelper::StreamCaptureSeqRecorder::~StreamCaptureSeqRecorder() {
+    if (*m_self_pointer == this) {
+        *m_self_pointer = nullptr;
+    }
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::check_the_same_comp_node(
+        const CompNode& comp_node) const {
+    if (mgb_unlikely(comp_node.valid())) {
+        mgb_assert(
+                make_comp_node_from_impl(m_comp_node_impl) == comp_node,
+                "CompNode %s can't hook in CompNode %s when recording",
+                comp_node.locator().to_string().c_str(),
+                m_comp_node_impl->locator().to_string().c_str());
+    }
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::set_self_pointer() {
+    mgb_assert(!*m_self_pointer, "another seq recorder is recording on this thread");
+    *m_self_pointer = this;
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::begin_capture() {
+    do_begin_capture();
+    m_capturing = true;
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::enter_fake_exec(
+        const CompNode& comp_node) {
+    check_the_same_comp_node(comp_node);
+    mgb_assert(!m_stopped && !m_fake_exec);
+    // work in fake exec is executed rather than recorded
+    m_capturing = false;
+    do_drop_capture();
+    m_fake_exec = true;
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::exit_fake_exec(
+        const CompNode& comp_node) {
+    check_the_same_comp_node(comp_node);
+    mgb_assert(!m_stopped && m_fake_exec);
+    m_fake_exec = false;
+    begin_capture();
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::stop(const CompNode& comp_node) {
+    check_the_same_comp_node(comp_node);
+    mgb_assert(*m_self_pointer == this && !m_fake_exec);
+    *m_self_pointer = nullptr;
+    m_stopped = true;
+    m_capturing = false;
+    do_end_capture();
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::replay() {
+    mgb_assert(m_stopped, "not stopped yet");
+    do_replay();
+}
+
+void CompNodeImplHelper::StreamCaptureSeqRecorder::begin_update(
+        const CompNode& comp_node) {
+    check_the_same_comp_node(comp_node);
+    mgb_assert(m_stopped);
+    set_self_pointer();
+    m_stopped = false;
+    begin_capture();
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
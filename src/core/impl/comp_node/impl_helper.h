@@ -11,6 +11,7 @@ namespace mgb {
 class CompNodeImplHelper : public CompNode {
 protected:
     class EventImplHelper;
+    class StreamCaptureSeqRecorder;
 
     static inline CompNode make_comp_node_from_impl(Impl* imp) { return {imp}; }
 
@@ -74,6 +75,82 @@ public:
     CompNode comp_node() const override final;
 };
 
+/*!
+ * \brief helper for implementing CompNodeSeqRecorder by capturing the stream
+ *      of the comp node into a device graph, e.g. CUDA graph or HIP graph
+ *
+ * The work issued to the stream between construction and stop() is captured
+ * instead of being executed, and replay() launches the captured graph at once.
+ * Like the recorder of the cpu comp node, shapes and memory should not change,
+ * and no memory could be allocated or freed while recording. Host code run by
+ * the oprs, e.g. the output callbacks, is not replayed; only the copies and
+ * kernels it issues to the stream are. The comp node can not be synchronized
+ * while capturing.
+ *
+ * Kernel parameters are captured by value, so when the computing graph finds
+ * that the tensor pointers have changed, the sequence is captured again by
+ * begin_update(), and the impl may update the instantiated graph in place.
+ *
+ * The impl should call begin_capture() at the end of its constructor, and
+ * drop the pending capture and the instantiated graph in its destructor.
+ */
+class CompNodeImplHelper::StreamCaptureSeqRecorder : public CompNodeSeqRecorder {
+    bool m_fake_exec = false, m_stopped = false, m_capturing = false;
+
+    //! the thread local pointer to the recorder capturing on current thread
+    StreamCaptureSeqRecorder** const m_self_pointer;
+
+    void check_the_same_comp_node(const CompNode& comp_node) const;
+
+    void set_self_pointer();
+
+protected:
+    CompNode::Impl* const m_comp_node_impl;
+
+    //! start capturing the stream
+    virtual void do_begin_capture() = 0;
+
+    //! stop capturing and instantiate the captured graph, or update the
+    //! instantiated graph with it
+    virtual void do_end_capture() = 0;
+
+    //! stop capturing and discard the captured graph
+    virtual void do_drop_capture() = 0;
+
+    //! launch the instantiated graph
+    virtual void do_replay() = 0;
+
+    void begin_capture();
+
+public:
+    StreamCaptureSeqRecorder(
+            CompNode::Impl* comp_node_impl, StreamCaptureSeqRecorder** self_pointer);
+
+    ~StreamCaptureSeqRecorder();
+
+    bool capturing() const { return m_capturing; }
+
+    void enter_fake_exec(const CompNode& comp_node) override final;
+
+    void exit_fake_exec(const CompNode& comp_node) override final;
+
+    void stop(const CompNode& comp_node) override final;
+
+    void replay() override final;
+
+    bool support_update() const override final { return true; }
+
+    void begin_update(const CompNode& comp_node) override final;
+
+    void on_alloc() {
+        mgb_assert(m_fake_exec, "alloc is disallowed during comp node seq recording");
+    }
+
+    void on_free() {
+        mgb_assert(m_fake_exec, "free is disallowed during comp node seq recording");
+    }
+};
+
 }  // namespace mgb
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -183,6 +183,122 @@ std::string MemAllocImplHelper::str_free_info(size_t threshold) {
 }
 
 /* ===================== StreamMemAllocImpl ===================== */
+namespace {
+//! size of the smallest slab size class
+constexpr size_t SLAB_MIN_SIZE = 512;
+}  // anonymous namespace
+
+StreamMemAllocImpl::StreamMemAllocImpl(DevMemAllocImpl* dev_alloc, int stream_id)
+        : m_dev_alloc(dev_alloc), m_stream_id(stream_id) {
+    auto&& conf = dev_alloc->slab_config();
+    if (!conf.max_size || !conf.nr_blk_per_class) {
+        return;
+    }
+    m_slab_min_size = std::max(SLAB_MIN_SIZE, dev_alloc->alignment());
+    while (slab_size(m_slab_nr_class) <= conf.max_size) {
+        ++m_slab_nr_class;
+    }
+    if (!m_slab_nr_class) {
+        return;
+    }
+    m_slab_nr_slot = conf.nr_blk_per_class;
+    m_slab_slots.reset(new std::atomic_size_t[m_slab_nr_class * m_slab_nr_slot]);
+    m_slab_nr_cached.reset(new std::atomic_size_t[m_slab_nr_class]);
+    for (size_t i = 0; i < m_slab_nr_class * m_slab_nr_slot; ++i) {
+        m_slab_slots[i].store(0);
+    }
+    for (size_t i = 0; i < m_slab_nr_class; ++i) {
+        m_slab_nr_cached[i].store(0);
+    }
+}
+
+int StreamMemAllocImpl::slab_class(size_t size) const {
+    if (!m_slab_nr_class || !size) {
+        return -1;
+    }
+    for (size_t cls = 0; cls < m_slab_nr_class; ++cls) {
+        if (slab_size(cls) >= size) {
+            return cls;
+        }
+    }
+    return -1;
+}
+
+void* StreamMemAllocImpl::slab_pop(int cls) {
+    if (!m_slab_nr_cached[cls].load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    auto slots = &m_slab_slots[cls * m_slab_nr_slot];
+    for (size_t i = 0; i < m_slab_nr_slot; ++i) {
+        auto addr = slots[i].load(std::memory_order_relaxed);
+        if (addr && slots[i].compare_exchange_strong(addr, 0)) {
+            --m_slab_nr_cached[cls];
+            return reinterpret_cast<void*>(addr);
+        }
+    }
+    return nullptr;
+}
+
+bool StreamMemAllocImpl::slab_push(int cls, void* addr) {
+    // count before filling the slot, so the count never falls below the
+    // number of filled slots when slab_pop() runs concurrently
+    auto&& nr_cached = m_slab_nr_cached[cls];
+    if (nr_cached.fetch_add(1) < m_slab_nr_slot) {
+        auto slots = &m_slab_slots[cls * m_slab_nr_slot];
+        for (size_t i = 0; i < m_slab_nr_slot; ++i) {
+            size_t empty = 0;
+            if (!slots[i].load(std::memory_order_relaxed) &&
+                slots[i].compare_exchange_strong(
+                        empty, reinterpret_cast<size_t>(addr))) {
+                return true;
+            }
+        }
+    }
+    --nr_cached;
+    return false;
+}
+
+size_t StreamMemAllocImpl::slab_held_size() const {
+    size_t size = 0;
+    for (size_t i = 0; i < m_slab_nr_class; ++i) {
+        size += m_slab_nr_cached[i].load() * slab_size(i);
+    }
+    return size;
+}
+
+StreamMemAlloc::SlabCacheStat StreamMemAllocImpl::get_slab_cache_stat() {
+    SlabCacheStat stat;
+    stat.nr_hit = m_slab_nr_hit.load();
+    stat.nr_miss = m_slab_nr_miss.load();
+    for (size_t i = 0; i < m_slab_nr_class; ++i) {
+        stat.nr_held_blk += m_slab_nr_cached[i].load();
+    }
+    stat.held_size = slab_held_size();
+    stat.req_size = m_slab_req_size.load();
+    stat.alloc_size = m_slab_alloc_size.load();
+    return stat;
+}
+
+size_t StreamMemAllocImpl::flush_slab_cache_unsafe() {
+    size_t flushed = 0;
+    for (size_t i = 0; i < m_slab_nr_class * m_slab_nr_slot; ++i) {
+        auto addr = reinterpret_cast<void*>(m_slab_slots[i].exchange(0));
+        if (!addr) {
+            continue;
+        }
+        --m_slab_nr_cached[i / m_slab_nr_slot];
+        auto iter = m_allocated_blocks.find(addr);
+        mgb_assert(iter != m_allocated_blocks.end());
+        FreeBlock fb{
+                MemAddr{iter->second.is_head, reinterpret_cast<size_t>(addr)},
+                iter->second.size};
+        flushed += fb.size;
+        m_allocated_blocks.erase(iter);
+        merge_free_unsafe(fb);
+    }
+    return flushed;
+}
+
 std::string StreamMemAllocImpl::get_name() const {
     return ssprintf("stream allocator %d@%d", m_stream_id, m_dev_alloc->device());
 }
@@ -234,10 +350,33 @@ void StreamMemAllocImpl::print_memory_state() {
     mgb_log("%s: free %zu block, total size %zu KB, list free block as below\n%s\n",
             get_name().c_str(), m_allocated_blocks.size(), total_used_size / 1024,
             mem_info_to_str(used_info).c_str());
+    if (m_slab_nr_class) {
+        auto stat = get_slab_cache_stat();
+        auto nr_req = stat.nr_hit + stat.nr_miss;
+        mgb_log("%s: slab cache hit rate %.2f%% (%zu/%zu), held %zu blocks of "
+                "%zu KB, wasted %.2f%% by size classes",
+                get_name().c_str(), nr_req ? stat.nr_hit * 100.0 / nr_req : 0.,
+                stat.nr_hit, nr_req, stat.nr_held_blk, stat.held_size / 1024,
+                stat.alloc_size
+                        ? (stat.alloc_size - stat.req_size) * 100.0 / stat.alloc_size
+                        : 0.);
+    }
 }
 
 void* StreamMemAllocImpl::alloc(size_t size) {
     size = get_aligned_power2(size, m_dev_alloc->alignment());
+    auto cls = slab_class(size);
+    if (cls >= 0) {
+        auto cls_size = slab_size(cls);
+        m_slab_req_size += size;
+        m_slab_alloc_size += cls_size;
+        if (auto ptr = slab_pop(cls)) {
+            ++m_slab_nr_hit;
+            return ptr;
+        }
+        ++m_slab_nr_miss;
+        size = cls_size;
+    }
     auto addr = do_alloc(size, true);
     MGB_LOCK_GUARD(m_mutex);
     m_allocated_blocks[addr.addr_ptr()] = {addr.is_head, size};
@@ -255,6 +394,10 @@ void StreamMemAllocImpl::free(void* addr) {
     MGB_LOCK_GUARD(m_mutex);
     auto iter = m_allocated_blocks.find(addr);
     mgb_assert(iter != m_allocated_blocks.end(), "releasing bad pointer: %p", addr);
+    auto cls = slab_class(iter->second.size);
+    if (cls >= 0 && slab_size(cls) == iter->second.size && slab_push(cls, addr)) {
+        return;
+    }
     FreeBlock fb{
             MemAddr{iter->second.is_head, reinterpret_cast<size_t>(addr)},
             iter->second.size};
@@ -264,7 +407,7 @@ void StreamMemAllocImpl::free(void* addr) {
 
 void StreamMemAllocImpl::get_mem_info(size_t& free, size_t& tot) {
     auto&& stat = get_free_memory();
-    free = stat.tot;
+    free = stat.tot + slab_held_size();
     auto used = get_used_memory();
     tot = free + used;
 }
@@ -274,7 +417,7 @@ size_t StreamMemAllocImpl::get_used_memory() {
     size_t size = 0;
     for (auto&& i : m_allocated_blocks)
         size += i.second.size;
-    return size;
+    return size - slab_held_size();
 }
 
 FreeMemStat StreamMemAllocImpl::get_free_memory_dev() {
@@ -309,6 +452,31 @@ MemAllocImplHelper::MemAddr DevMemAllocImpl::alloc_from_parent(size_t size) {
     size_upper = std::min(size_upper, size + prconf.max_overhead);
     size_upper = get_aligned_power2(size_upper, prconf.alignment);
 
+    auto&& limit = limit_config();
+    if (limit.soft_limit) {
+        relieve_pressure(size, limit.soft_limit);
+    }
+    if (limit.hard_limit && !relieve_pressure(size, limit.hard_limit)) {
+        bool fit;
+        {
+            MGB_LOCK_GUARD(m_mutex);
+            fit = m_free_blk_size.lower_bound(FreeBlock{MemAddr{0, 0}, size}) !=
+                  m_free_blk_size.end();
+        }
+        mgb_throw_if(
+                !fit, MemAllocError,
+                "can not allocate %zu bytes on device %d under the hard memory "
+                "limit of %zu bytes, with %zu bytes reserved",
+                size, m_device, limit.hard_limit, reserved_size());
+        return do_alloc(size, false, true);
+    }
+    // do not pre-allocate across the limits
+    for (auto lim : {limit.soft_limit, limit.hard_limit}) {
+        if (lim && reserved_size() + size_upper > lim) {
+            size_upper = size;
+        }
+    }
+
     auto ptr = m_raw_allocator->alloc(size_upper);
 
     if (!ptr && size_upper > size) {
@@ -377,7 +545,7 @@ MemAllocImplHelper::MemAddr DevMemAllocImpl::alloc_from_parent(size_t size) {
         insert_free_unsafe({MemAddr{false, ptr_int + size}, size_upper - size});
     }
     m_tot_allocated_from_raw += size_upper;
-    return {true, ptr_int};
+    return {!m_contiguous_raw, ptr_int};
 }
 
 size_t DevMemAllocImpl::gather_stream_free_blk_and_release_full() {
@@ -385,7 +553,53 @@ size_t DevMemAllocImpl::gather_stream_free_blk_and_release_full() {
     std::vector<void*> to_free_by_raw;
 
     MGB_LOCK_GUARD(m_mutex);
+
+    // release the raw chunks covered by free blocks, and keep the remaining
+    // parts of the blocks
+    auto return_covered_chunk_unsafe = [&](MemAllocImplHelper* alloc) {
+        std::vector<FreeBlock> blocks;
+        for (auto&& i : alloc->m_free_blk_size) {
+            blocks.push_back(i.first);
+        }
+        for (auto&& blk : blocks) {
+            auto riter = m_alloc_from_raw.lower_bound(blk.addr.addr_ptr());
+            size_t begin = blk.addr.addr;
+            std::vector<FreeBlock> remain;
+            bool released = false;
+            while (riter != m_alloc_from_raw.end() &&
+                   reinterpret_cast<size_t>(riter->first) + riter->second <=
+                           blk.end()) {
+                auto chunk_begin = reinterpret_cast<size_t>(riter->first);
+                if (chunk_begin > begin) {
+                    remain.push_back({MemAddr{false, begin}, chunk_begin - begin});
+                }
+                to_free_by_raw.push_back(riter->first);
+                free_size += riter->second;
+                begin = chunk_begin + riter->second;
+                riter = m_alloc_from_raw.erase(riter);
+                released = true;
+            }
+            if (!released) {
+                continue;
+            }
+            if (blk.end() > begin) {
+                remain.push_back({MemAddr{false, begin}, blk.end() - begin});
+            }
+            auto aiter = alloc->m_free_blk_addr.find(blk.addr.addr);
+            mgb_assert(aiter != alloc->m_free_blk_addr.end());
+            alloc->m_free_blk_size.erase(aiter->second.siter);
+            alloc->m_free_blk_addr.erase(aiter);
+            for (auto&& i : remain) {
+                alloc->MemAllocImplHelper::insert_free_unsafe(i);
+            }
+        }
+    };
+
     auto return_full_free_blk_unsafe = [&](MemAllocImplHelper* alloc) {
+        if (m_contiguous_raw) {
+            return_covered_chunk_unsafe(alloc);
+            return;
+        }
         auto&& free_blk_size = alloc->m_free_blk_size;
         auto&& free_blk_addr = alloc->m_free_blk_addr;
         using Iter = decltype(m_free_blk_size.begin());
@@ -412,6 +626,7 @@ size_t DevMemAllocImpl::gather_stream_free_blk_and_release_full() {
 
     if (auto child = get_single_child_stream_unsafe()) {
         MGB_LOCK_GUARD(child->m_mutex);
+        child->flush_slab_cache_unsafe();
         return_full_free_blk_unsafe(child);
         mgb_assert(free_size <= m_used_size.load());
         m_used_size -= free_size;
@@ -422,6 +637,7 @@ size_t DevMemAllocImpl::gather_stream_free_blk_and_release_full() {
             auto&& chmtx = ch->m_mutex;
 
             MGB_LOCK_GUARD(chmtx);
+            ch->flush_slab_cache_unsafe();
             for (auto&& i : ch->m_free_blk_size) {
                 merge_free_unsafe(i.first);
                 gathered_size += i.first.size;
@@ -446,20 +662,45 @@ size_t DevMemAllocImpl::gather_stream_free_blk_and_release_full() {
     return free_size;
 }
 
+bool DevMemAllocImpl::relieve_pressure(size_t size, size_t limit) {
+    if (reserved_size() + size <= limit) {
+        return true;
+    }
+    auto get = gather_stream_free_blk_and_release_full();
+    MGB_MARK_USED_VAR(get);
+    mgb_log_debug(
+            "device %d: memory limit %zu bytes exceeded, released %zu bytes of "
+            "cached chunks",
+            m_device, limit, get);
+    if (reserved_size() + size <= limit) {
+        return true;
+    }
+    call_pressure_callbacks(reserved_size() + size, limit);
+    gather_stream_free_blk_and_release_full();
+    return reserved_size() + size <= limit;
+}
+
 DevMemAllocImpl::DevMemAllocImpl(
         int device, size_t reserve_size,
         const std::shared_ptr<mem_alloc::RawAllocator>& raw_allocator,
         const std::shared_ptr<mem_alloc::DeviceRuntimePolicy>& runtime_policy)
         : m_device(device),
           m_raw_allocator(raw_allocator),
-          m_runtime_policy(runtime_policy) {
+          m_runtime_policy(runtime_policy),
+          m_contiguous_raw(raw_allocator->contiguous_chunks()) {
+    if (auto setting = MGB_GETENV("MGB_MEM_ALLOC_SLAB_MAX_SIZE")) {
+        SlabConfig conf;
+        conf.max_size = std::stoull(setting);
+        slab_config(conf);
+    }
     if (reserve_size) {
         auto ptr = m_raw_allocator->alloc(reserve_size);
         mgb_throw_if(
                 !ptr, MemAllocError, "failed to reserve memory for %zu bytes",
                 reserve_size);
         insert_free_unsafe(
-                {MemAddr{true, reinterpret_cast<size_t>(ptr)}, reserve_size});
+                {MemAddr{!m_contiguous_raw, reinterpret_cast<size_t>(ptr)},
+                 reserve_size});
 
         m_alloc_from_raw[ptr] = reserve_size;
         m_tot_allocated_from_raw += reserve_size;
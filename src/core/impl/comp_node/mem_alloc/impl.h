@@ -124,9 +124,34 @@ class StreamMemAllocImpl final : public StreamMemAlloc, public MemAllocImplHelpe
     DevMemAllocImpl* m_dev_alloc;
     int m_stream_id;
 
-    //! map from address to block info
+    //! map from address to block info; blocks in the slab cache are kept
     std::unordered_map<void*, AllocatedBlock> m_allocated_blocks;
 
+    //! size of the smallest size class, and the number of classes
+    size_t m_slab_min_size = 0, m_slab_nr_class = 0;
+    //! max number of cached blocks of each class
+    size_t m_slab_nr_slot = 0;
+    //! cached addresses of size class i are in slots [i * m_slab_nr_slot,
+    //! (i + 1) * m_slab_nr_slot), and 0 means an empty slot
+    std::unique_ptr<std::atomic_size_t[]> m_slab_slots;
+    //! number of cached blocks of each class
+    std::unique_ptr<std::atomic_size_t[]> m_slab_nr_cached;
+    std::atomic_size_t m_slab_nr_hit{0}, m_slab_nr_miss{0}, m_slab_req_size{0},
+            m_slab_alloc_size{0};
+
+    //! get the size class to serve given size, or -1 if it is not cached
+    int slab_class(size_t size) const;
+
+    size_t slab_size(int cls) const { return m_slab_min_size << cls; }
+
+    //! take a cached block of given class; return nullptr if none
+    void* slab_pop(int cls);
+
+    //! put a block of given class into the cache; return false if full
+    bool slab_push(int cls, void* addr);
+
+    size_t slab_held_size() const;
+
     void* alloc(size_t size) override;
 
     void free(void* addr) override;
@@ -141,8 +166,16 @@ class StreamMemAllocImpl final : public StreamMemAlloc, public MemAllocImplHelpe
 
 public:
     void print_memory_state() override;
-    StreamMemAllocImpl(DevMemAllocImpl* dev_alloc, int stream_id)
-            : m_dev_alloc(dev_alloc), m_stream_id(stream_id) {}
+    StreamMemAllocImpl(DevMemAllocImpl* dev_alloc, int stream_id);
+
+    SlabCacheStat get_slab_cache_stat() override;
+
+    /*!
+     * \brief return all blocks in the slab cache to the free block tree,
+     *      without locking
+     * \return total size of the returned blocks
+     */
+    size_t flush_slab_cache_unsafe();
 };
 
 /*!
@@ -159,7 +192,11 @@ class DevMemAllocImpl final : public DevMemAlloc, public MemAllocImplHelper {
     ThinHashMap<StreamKey, std::unique_ptr<StreamMemAllocImpl>> m_stream_alloc;
 
     //!< blocks allocated from raw alloc, addr to size
-    std::unordered_map<void*, size_t> m_alloc_from_raw;
+    std::map<void*, size_t> m_alloc_from_raw;
+
+    //! whether adjacent chunks from raw alloc could be merged, see
+    //! RawAllocator::contiguous_chunks()
+    const bool m_contiguous_raw;
 
     size_t m_tot_allocated_from_raw = 0;
     std::atomic_size_t m_used_size{0};
@@ -196,6 +233,19 @@ class DevMemAllocImpl final : public DevMemAlloc, public MemAllocImplHelper {
 
     void insert_free_unsafe(const FreeBlock& block) override;
 
+    //! total size of memory allocated from raw alloc
+    size_t reserved_size() {
+        MGB_LOCK_GUARD(m_mutex);
+        return m_tot_allocated_from_raw;
+    }
+
+    /*!
+     * \brief release cached chunks and call the pressure callbacks if
+     *      reserving another \p size bytes would exceed \p limit
+     * \return whether the size could be reserved under the limit
+     */
+    bool relieve_pressure(size_t size, size_t limit);
+
     /*!
      * \brief return stream allocator if DevMemAlloc has single child,
      * otherwise return nullptr
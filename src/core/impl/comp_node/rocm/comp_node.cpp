@@ -1,5 +1,6 @@
 #include "./comp_node.h"
 #include "megbrain/comp_node_env.h"
+#include "megbrain/graph/cg.h"
 #include "megbrain/utils/thread.h"
 
 #include <string>
@@ -17,6 +18,13 @@ using namespace mgb;
 
 #include "hip_header.h"
 
+//! hip graph with in place update of instantiated graphs
+#if defined(HIP_VERSION) && HIP_VERSION >= 50300000
+#define MGB_ROCM_HAS_GRAPH 1
+#else
+#define MGB_ROCM_HAS_GRAPH 0
+#endif
+
 using ROCmCompNodeImpl = ROCmCompNode::CompNodeImpl;
 
 namespace {
@@ -100,6 +108,7 @@ class ROCmCompNode::CompNodeImpl final : public CompNode::Impl {
 
     friend class EventImpl;
     friend class ROCmCompNode;
+    friend class ROCmCompNode::SeqRecorderImpl;
 
     struct DeviceInfo;
     struct StaticData;
@@ -116,6 +125,9 @@ class ROCmCompNode::CompNodeImpl final : public CompNode::Impl {
     std::unique_ptr<Event> m_sync_event;
     Spinlock m_sync_event_mtx;
 
+    //! the recorder capturing on the current thread
+    static MGB_THREAD_LOCAL_PTR(StreamCaptureSeqRecorder) sm_cur_recorder;
+
     void activate() { m_env.rocm_env().activate(); }
 
     void init(const Locator& locator, const Locator& locator_logical);
@@ -138,10 +150,7 @@ class ROCmCompNode::CompNodeImpl final : public CompNode::Impl {
 public:
     CompNodeImpl() : Impl(static_free_device, static_free_host) {}
 
-    void* alloc_device(size_t size) override {
-        activate();
-        return m_mem_alloc->alloc(size);
-    }
+    void* alloc_device(size_t size) override;
 
     void free_device(void* ptr);
 
@@ -193,16 +202,115 @@ public:
         return {tot, free};
     }
 
+    void set_mem_limit(size_t soft_limit, size_t hard_limit) override;
+
+    size_t add_mem_pressure_callback(MemPressureCallback cb) override;
+
+    void remove_mem_pressure_callback(size_t handle) override;
+
     Locator locator() override { return m_locator; }
 
     Locator locator_logical() override { return m_locator_logical; }
 
     uint64_t get_uid() override { return m_uid; }
 
+    std::unique_ptr<CompNodeSeqRecorder> create_seq_recorder(
+            cg::ComputingGraph*) override;
+
 private:
     uint64_t m_uid;
 };
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(ROCmCompNode::CompNodeImpl);
+MGB_THREAD_LOCAL_PTR(CompNodeImplHelper::StreamCaptureSeqRecorder)
+ROCmCompNodeImpl::sm_cur_recorder = nullptr;
+
+/* ===================== SeqRecorderImpl  ===================== */
+#if MGB_ROCM_HAS_GRAPH
+/*!
+ * \brief seq recorder on HIP Graph, which works the same as that of the cuda
+ *      comp node
+ */
+class ROCmCompNode::SeqRecorderImpl final : public StreamCaptureSeqRecorder {
+    hipGraphExec_t m_graph_exec = nullptr;
+
+    ROCmCompNodeImpl* comp_node() const {
+        return static_cast<ROCmCompNodeImpl*>(m_comp_node_impl);
+    }
+
+    hipStream_t stream() const { return comp_node()->m_env.rocm_env().stream; }
+
+    void do_begin_capture() override {
+        comp_node()->activate();
+        MGB_ROCM_CHECK(hipStreamBeginCapture(stream(), hipStreamCaptureModeRelaxed));
+    }
+
+    void do_drop_capture() override {
+        hipGraph_t graph = nullptr;
+        MGB_ROCM_CHECK(hipStreamEndCapture(stream(), &graph));
+        MGB_ROCM_CHECK(hipGraphDestroy(graph));
+    }
+
+    void do_end_capture() override {
+        hipGraph_t graph = nullptr;
+        MGB_ROCM_CHECK(hipStreamEndCapture(stream(), &graph));
+        MGB_TRY { instantiate_or_update(graph); }
+        MGB_FINALLY({ hipGraphDestroy(graph); });
+    }
+
+    void do_replay() override {
+        comp_node()->activate();
+        MGB_ROCM_CHECK(hipGraphLaunch(m_graph_exec, stream()));
+    }
+
+    void instantiate_or_update(hipGraph_t graph) {
+        if (m_graph_exec) {
+            hipGraphNode_t error_node;
+            hipGraphExecUpdateResult result;
+            if (hipGraphExecUpdate(m_graph_exec, graph, &error_node, &result) ==
+                hipSuccess) {
+                return;
+            }
+            mgb_log_debug("hip graph can not be updated in place, re-instantiate");
+            hipGetLastError();
+            MGB_ROCM_CHECK(hipGraphExecDestroy(m_graph_exec));
+            m_graph_exec = nullptr;
+        }
+        MGB_ROCM_CHECK(hipGraphInstantiate(&m_graph_exec, graph, nullptr, nullptr, 0));
+    }
+
+public:
+    SeqRecorderImpl(ROCmCompNodeImpl* comp_node)
+            : StreamCaptureSeqRecorder{comp_node, &ROCmCompNodeImpl::sm_cur_recorder} {
+        begin_capture();
+    }
+
+    ~SeqRecorderImpl() {
+        if (capturing()) {
+            hipGraph_t graph = nullptr;
+            hipStreamEndCapture(stream(), &graph);
+            if (graph) {
+                hipGraphDestroy(graph);
+            }
+        }
+        if (m_graph_exec) {
+            hipGraphExecDestroy(m_graph_exec);
+        }
+    }
+};
+#endif
+
+std::unique_ptr<CompNodeSeqRecorder> ROCmCompNodeImpl::create_seq_recorder(
+        cg::ComputingGraph* cg) {
+    if (!cg || !cg->options().comp_node_seq_record_device_graph) {
+        return {};
+    }
+#if MGB_ROCM_HAS_GRAPH
+    return std::make_unique<SeqRecorderImpl>(this);
+#else
+    mgb_log_error("recording on rocm comp node requires hip graph of ROCm 5.3");
+    return {};
+#endif
+}
 
 struct ROCmCompNodeImpl::DeviceInfo {
     int dev_num = -1;
@@ -315,9 +423,36 @@ void ROCmCompNodeImpl::fini() {
     m_initialized = false;
 }
 
+void ROCmCompNodeImpl::set_mem_limit(size_t soft_limit, size_t hard_limit) {
+    // explicitly call rocm_env() to ensure async init is finished
+    m_env.rocm_env();
+    m_device_info->mem_alloc->limit_config({soft_limit, hard_limit});
+}
+
+size_t ROCmCompNodeImpl::add_mem_pressure_callback(MemPressureCallback cb) {
+    m_env.rocm_env();
+    return m_device_info->mem_alloc->add_pressure_callback(std::move(cb));
+}
+
+void ROCmCompNodeImpl::remove_mem_pressure_callback(size_t handle) {
+    m_env.rocm_env();
+    m_device_info->mem_alloc->remove_pressure_callback(handle);
+}
+
+void* ROCmCompNodeImpl::alloc_device(size_t size) {
+    if (auto rec = sm_cur_recorder) {
+        rec->on_alloc();
+    }
+    activate();
+    return m_mem_alloc->alloc(size);
+}
+
 void ROCmCompNodeImpl::free_device(void* ptr) {
     if (check_global_finalized())
         return;
+    if (auto rec = sm_cur_recorder) {
+        rec->on_free();
+    }
 
     activate();
     m_mem_alloc->free(ptr);
@@ -357,6 +492,13 @@ MemNode ROCmCompNodeImpl::mem_node() {
 }
 
 void ROCmCompNodeImpl::sync() {
+    if (auto rec = sm_cur_recorder) {
+        mgb_assert(
+                !rec->capturing(),
+                "can not sync %s while capturing hip graph; oprs that wait "
+                "for device results on host can not be recorded",
+                m_locator.to_string().c_str());
+    }
     activate();
 
     // same behavior as cuda
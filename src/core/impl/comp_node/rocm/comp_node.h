@@ -6,10 +6,12 @@ namespace mgb {
 class ROCmCompNode final : public CompNodeImplHelper {
 public:
     static constexpr Flag sm_flag =
-            Flag::QUEUE_LIMITED | Flag::HAS_COPY_STREAM | Flag::SUPPORT_UNIFIED_ADDRESS;
+            Flag::RECORDER_SUPPORT_DYNAMIC_ALLOC | Flag::QUEUE_LIMITED |
+            Flag::HAS_COPY_STREAM | Flag::SUPPORT_UNIFIED_ADDRESS;
 
     class CompNodeImpl;
     class EventImpl;
+    class SeqRecorderImpl;
 
     //! whether rocm comp node is available
     static bool available();
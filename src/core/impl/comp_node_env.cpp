@@ -9,7 +9,9 @@
 #include "megcore_cambricon.h"
 #endif
 #if MGB_CUDA
+#include "megbrain/utils/persistent_cache.h"
 #include "megcore_cuda.h"
+#include "megdnn/cuda.h"
 #if MGB_ENABLE_DEBUG_UTIL
 #include <nvToolsExtCudaRt.h>
 #endif
@@ -27,6 +29,29 @@
 using namespace mgb;
 
 /* =================== MegDNNHandle =================== */
+#if MGB_CUDA
+namespace {
+//! keep the cudnn execution plans built by megdnn in the PersistentCache
+class CudnnPlanPersistentStorage final : public megdnn::CudnnPlanStorage {
+    static constexpr const char* CATEGORY = "cudnn_frontend_plan";
+
+public:
+    std::string get(const std::string& key) override {
+        auto val = PersistentCache::inst().get(CATEGORY, {key.data(), key.size()});
+        if (!val.valid()) {
+            return {};
+        }
+        return {static_cast<const char*>(val->ptr), val->size};
+    }
+
+    void put(const std::string& key, const std::string& plan) override {
+        PersistentCache::inst().put(
+                CATEGORY, {key.data(), key.size()}, {plan.data(), plan.size()});
+    }
+};
+}  // anonymous namespace
+#endif
+
 MGB_TYPEINFO_OBJ_IMPL(MegDNNHandle);
 
 int MegDNNHandle::sm_default_dbg_level = 0;
@@ -53,6 +78,11 @@ MegDNNHandle::MegDNNHandle(const CompNodeEnv& env) {
         megcore::createComputingHandleWithCUDAContext(
                 &m_comp_hdl, m_dev_hdl, 0,
                 {env.cuda_env().stream, make_async_error_info(env)});
+        static std::once_flag plan_storage_flag;
+        std::call_once(plan_storage_flag, []() {
+            megdnn::set_cudnn_plan_storage(
+                    std::make_shared<CudnnPlanPersistentStorage>());
+        });
         init = true;
     }
 #endif
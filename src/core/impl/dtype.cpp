@@ -126,6 +126,7 @@ void mgb::static_cast_dtype(
         MEGDNN_FOREACH_COMPUTING_DTYPE(cb)
         MEGDNN_FOREACH_QUANTIZED_DTYPE(cb)
         cb(::megdnn::dtype::Bool) cb(::megdnn::dtype::Uint16)
+                cb(::megdnn::dtype::Float8E4M3) cb(::megdnn::dtype::Float8E5M2)
 #undef cb
 #define cb(_name, _bits)                                                             \
     case DTypeTrait<dtype::_name##_bits>::enumv:                                     \
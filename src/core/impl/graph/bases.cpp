@@ -12,4 +12,10 @@ GraphNodeBase::GraphNodeBase(ComputingGraph* owner_graph) : m_owner_graph{owner_
 
 AsyncExecutable::~AsyncExecutable() noexcept = default;
 
+const AsyncExecutable::CompilePhaseTime& AsyncExecutable::get_compile_phase_time()
+        const {
+    static const CompilePhaseTime empty;
+    return empty;
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -11,6 +11,7 @@
 #include "megbrain/graph/exc_extra_info.h"
 #include "megbrain/graph/helper.h"
 #include "megbrain/opr/utility.h"
+#include "megbrain/utils/timer.h"
 
 #if MGB_ENABLE_TENSOR_RT
 #include "megbrain/tensorrt/opr_replace.h"
@@ -75,6 +76,21 @@ void update_output_shapes(
     }
 }
 
+
+//! record the time of consecutive phases in graph compiling
+class CompilePhaseTimer {
+    RealTimer m_timer;
+    AsyncExecutable::CompilePhaseTime& m_dest;
+
+public:
+    explicit CompilePhaseTimer(AsyncExecutable::CompilePhaseTime& dest)
+            : m_dest{dest} {}
+
+    //! finish current phase and start the next one
+    void finish(const char* name) {
+        m_dest.emplace_back(name, m_timer.get_secs_reset());
+    }
+};
 }  // anonymous namespace
 
 /* ========================== global helpers ========================== */
@@ -174,7 +190,8 @@ MGB_DEFINE_OPR_CLASS(
     }
 
     void add_input_layout_constraint() override {
-        if (owner_graph()->options().comp_node_seq_record_level) {
+        if (owner_graph()->options().comp_node_seq_record_level ||
+            owner_graph()->options().lean_exec) {
             // the user callback usually copies from device to host, which
             // involves tmp alloc if input is not contiguous
             for (auto&& inp : input()) {
@@ -506,6 +523,9 @@ ComputingGraphImpl::CompileState ComputingGraphImpl::compile_prepare(
     topo_sorter().restore_opr_prop();
     cmpnt.seq_comp_node_opt.restore_comp_nodes();
 
+    AsyncExecutable::CompilePhaseTime phase_time;
+    CompilePhaseTimer phase_timer{phase_time};
+
     SpecialOprStat sopr_stat;
     auto dest_vars = get_dest_vars_from_out_spec(out_spec, sopr_stat);
 
@@ -608,10 +628,12 @@ ComputingGraphImpl::CompileState ComputingGraphImpl::compile_prepare(
         opt.add_pass<gopt::RemoveShapeHintPass>();
         opt.apply_inplace(dest_vars);
     }
+    phase_timer.finish("graph_opt");
 
     const OprNodeArray* opr_seq = nullptr;
     CompSeqExtraInfo extra_info;
     cmpnt.seq_comp_node_opt.optimize_comp_nodes(dest_vars);
+    phase_timer.finish("comp_node_opt");
 
     bool init_flag = false;
     auto init_opr_seq = [&]() {
@@ -703,6 +725,8 @@ ComputingGraphImpl::CompileState ComputingGraphImpl::compile_prepare(
     if (!init_flag) {
         init_opr_seq();
     }
+    phase_timer.finish("topo_sort");
+    extra_info.compile_phase_time = std::move(phase_time);
 
     return {std::move(extra_info), opr_seq, std::move(dest_vars)};
 }
@@ -711,6 +735,8 @@ std::unique_ptr<AsyncExecutable> ComputingGraphImpl::compile_commit(
         CompileState state) {
     auto comp_seq = std::make_unique<ComputingSequence>(shared_from_this());
     comp_seq->extra_info = std::move(state.extra_info);
+    auto&& phase_time = comp_seq->extra_info.compile_phase_time;
+    CompilePhaseTimer phase_timer{phase_time};
     comp_seq->set_output_vars(state.dest_vars);
     auto opr_seq = state.opr_seq;
     auto&& cmpnt = components();
@@ -724,17 +750,34 @@ std::unique_ptr<AsyncExecutable> ComputingGraphImpl::compile_commit(
         }
     }
     comp_seq->attach_to_graph();
+    phase_timer.finish("setup_opr_seq");
 
     MGB_TRY {
         var_node_mem_manager().reset_opr_seq(comp_seq->extra_info, opr_seq);
+        phase_timer.finish("mem_plan_init");
         static_infer_comp_seq_manager().reset_dest(comp_seq->extra_info);
+        phase_timer.finish("static_infer_init");
         cmpnt.seq_comp_node_opt.init_ready_event(comp_seq->extra_info, *opr_seq);
+        phase_timer.finish("ready_event_init");
 
-        if (options().allocate_static_mem_after_graph_compile)
+        if (options().allocate_static_mem_after_graph_compile) {
             var_node_mem_manager().alloc_var_node_mem_static();
+            phase_timer.finish("static_mem_alloc");
+        }
     }
     MGB_FINALLY({ var_node_mem_manager().on_graph_compile_finished(); });
 
+    if (options().log_compile_phase_time) {
+        double tot = 0;
+        std::string msg;
+        for (auto&& i : phase_time) {
+            tot += i.second;
+            msg += ssprintf(" %s=%.3fms", i.first, i.second * 1e3);
+        }
+        mgb_log("graph compiled with %zu oprs in %.3fms:%s", opr_seq->size(),
+                tot * 1e3, msg.c_str());
+    }
+
     event().signal_inplace<event::CompSeqOrderDetermined>(this, comp_seq.get());
 
     if (options().comp_node_seq_record_level > 1) {
@@ -11,6 +11,7 @@
 #include "./topo_sort.h"
 #include "./var_node_mem_mgr.h"
 
+#include "megbrain/utils/arena_allocator.h"
 #include "megbrain/utils/mempool.h"
 
 namespace mgb {
@@ -86,6 +87,10 @@ class ComputingGraphImpl final : public ComputingGraph {
 
     MemPool<VarNode> m_var_node_pool;
 
+    //! storage of operators created with node_arena() activated; must be
+    //! declared before m_opr_refkeeper to be destructed after the operators
+    std::unique_ptr<ArenaAllocator> m_node_arena;
+
     //! if not null, this graph is set as subgraph of it by set_as_subgraph()
     ComputingGraphImpl* m_parent_graph = nullptr;
     std::vector<ComputingGraphImpl*> m_subgraphs;
@@ -268,6 +273,13 @@ public:
 
     size_t nr_oprs_in_graph() const override { return m_opr_refkeeper.size(); }
 
+    ArenaAllocator* node_arena() override {
+        if (!m_node_arena) {
+            m_node_arena = std::make_unique<ArenaAllocator>();
+        }
+        return m_node_arena.get();
+    }
+
     //! memory pool for the var nodes; used by OperatorNodeBase
     auto&& var_node_pool() { return m_var_node_pool; }
 };
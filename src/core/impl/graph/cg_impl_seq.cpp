@@ -1,5 +1,6 @@
 #include "./cg_impl_seq.h"
 #include "megbrain/graph/exc_extra_info.h"
+#include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/utils/arith_helper.h"
 #include "megbrain/utils/visable_data_set.h"
@@ -51,11 +52,22 @@ class ComputingGraphImpl::ComputingSequence::ExecContext {
             // clear recorded sequence because memory has been reallocated
             m_comp_seq->m_comp_node_seq_recorder.reset();
         }
-        if (m_comp_seq->m_comp_node_seq_recorder) {
-            return;
-        }
         // get first comp node to be used with recorder
         auto comp_node = *(m_comp_seq->m_used_comp_node.begin());
+        if (auto&& rec = m_comp_seq->m_comp_node_seq_recorder) {
+            if (!m_fake_next_exec && rec->support_update()) {
+                auto&& ptrs = m_comp_seq->m_recorded_tensor_ptrs;
+                std::vector<const void*> cur_ptrs;
+                m_comp_seq->get_tensor_ptrs(cur_ptrs);
+                if (cur_ptrs != ptrs) {
+                    // record again by a normal exec and update in place
+                    ptrs = std::move(cur_ptrs);
+                    m_recorder = std::move(rec);
+                    m_recorder->begin_update(comp_node);
+                }
+            }
+            return;
+        }
         // note: if m_first_exec or m_mem_reallocated is true, we can not record
         // because there might be dynamic memory allocations for temp storage in
         // the operators
@@ -84,6 +96,9 @@ class ComputingGraphImpl::ComputingSequence::ExecContext {
     void stop_and_move_recorder() {
         auto comp_node = *(m_comp_seq->m_used_comp_node.begin());
         m_recorder->stop(comp_node);
+        if (m_recorder->support_update()) {
+            m_comp_seq->get_tensor_ptrs(m_comp_seq->m_recorded_tensor_ptrs);
+        }
         if (m_fake_next_exec) {
             m_owner_graph->options().fake_next_exec = false;
         } else {
@@ -218,36 +233,38 @@ ComputingGraphImpl::ComputingSequence::ExecContext::~ExecContext() noexcept {
 
 std::unique_ptr<CompNodeSeqRecorder> ComputingGraphImpl::ComputingSequence::
         check_enable_comp_node_seq_recorder() {
-    if (!m_owner_graph->options().comp_node_seq_record_level)
+    auto&& options = m_owner_graph->options();
+    // lean_exec records whenever possible and falls back to normal execution
+    // without complaint
+    bool lean = !options.comp_node_seq_record_level && options.lean_exec;
+    if (!options.comp_node_seq_record_level && !lean)
         return {};
+    auto fail = [lean](const std::string& msg) {
+        if (lean) {
+            mgb_log_debug("lean exec disabled: %s", msg.c_str());
+        } else {
+            mgb_log_error("can not enable CompNodeSeqRecorder %s", msg.c_str());
+        }
+        return std::unique_ptr<CompNodeSeqRecorder>{};
+    };
     if (m_used_comp_node.size() != 1) {
-        mgb_log_error(
-                "can not enable CompNodeSeqRecorder because more than one comp "
-                "nodes are involved: %zu",
-                m_used_comp_node.size());
-        return {};
+        return fail(ssprintf(
+                "because more than one comp nodes are involved: %zu",
+                m_used_comp_node.size()));
     }
-    if (m_owner_graph->options().force_dynamic_alloc) {
-        mgb_log_error(
-                "can not enable CompNodeSeqRecorder due to "
-                "force_dynamic_alloc");
-        return {};
+    if (options.force_dynamic_alloc) {
+        return fail("due to force_dynamic_alloc");
     }
     if (m_owner_graph->m_parent_graph) {
-        mgb_log_error(
-                "can not enable CompNodeSeqRecorder because it has parent "
-                "graph.");
-        return {};
+        return fail("because it has parent graph.");
     }
 
     for (auto i : *m_opr_seq) {
         for (auto j : i->output()) {
             if (!is_static_var_storage(j) && !j->is_graph_dest_varnode()) {
-                mgb_log_error(
-                        "can not enable CompNodeSeqRecorder because var "
-                        "storage not static: %s",
-                        dump_var_info({j}).c_str());
-                return {};
+                return fail(ssprintf(
+                        "because var storage not static: %s",
+                        dump_var_info({j}).c_str()));
             }
         }
     }
@@ -265,21 +282,44 @@ std::unique_ptr<CompNodeSeqRecorder> ComputingGraphImpl::ComputingSequence::
             }
         }
     };
-    check_const_shape();
+    // shape changes reallocate the static memory, which makes lean exec
+    // record again
+    if (!lean) {
+        check_const_shape();
+    }
 
     auto cn = *m_used_comp_node.begin();
+    // the default cpu executes in the caller thread and can not record
+    if (lean && (!cn.contain_flag(CompNode::Flag::SUPPORT_RECORDER) ||
+                 cn == CompNode::default_cpu())) {
+        return fail(ssprintf("on comp node %s", cn.to_string().c_str()));
+    }
     auto rec = cn.create_seq_recorder(m_owner_graph);
     if (!rec) {
-        mgb_log_error(
-                "can not enable CompNodeSeqRecorder on unsupported comp node "
-                "%s",
-                cn.to_string().c_str());
-        return {};
+        return fail(ssprintf("on unsupported comp node %s", cn.to_string().c_str()));
     }
     m_enable_comp_node_seq_recorder = true;
     return rec;
 }
 
+void ComputingGraphImpl::ComputingSequence::get_tensor_ptrs(
+        std::vector<const void*>& dest) const {
+    dest.clear();
+    for (auto opr : *m_opr_seq) {
+        if (auto h2d = opr->try_cast_final<opr::Host2DeviceCopy>()) {
+            // the host tensor may be assigned with another buffer
+            dest.push_back(*h2d->host_data()->storage().get_ref_ptr());
+        } else if (auto vsdt = opr->try_cast_final<opr::VolatileSharedDeviceTensor>()) {
+            dest.push_back(*vsdt->dev_data()->storage().get_ref_ptr());
+        }
+        for (auto var : opr->output()) {
+            if (var->dev_tensor_valid()) {
+                dest.push_back(*var->dev_tensor().storage().get_ref_ptr());
+            }
+        }
+    }
+}
+
 void ComputingGraphImpl::ComputingSequence::do_execute(MegDNNDtorCheck* dtor_check) {
     ExecContext exec_ctx{this};
 
@@ -299,6 +339,7 @@ void ComputingGraphImpl::ComputingSequence::preprocess(ExecContext* ctx) {
     assert_latest_comp_seq();
     ++m_run_id;
     m_prev_exec_time = None;
+    m_host_timer.reset();
 
     ctx->m_mem_reallocated =
             m_owner_graph->var_node_mem_manager().alloc_var_node_mem_static();
@@ -315,7 +356,8 @@ void ComputingGraphImpl::ComputingSequence::preprocess(ExecContext* ctx) {
             m_owner_graph, this, &ctx->m_cleanup_callback, &m_used_comp_node,
             m_owner_graph->event().version());
 
-    if (first_exec || m_cg_event_version != m_owner_graph->event().version()) {
+    if (first_exec || m_cg_event_version != m_owner_graph->event().version() ||
+        need_exec_timer() == m_event_start.empty()) {
         init_for_exec();
     }
     ctx->m_enable_comp_node_seq_recorder = m_enable_comp_node_seq_recorder;
@@ -386,6 +428,7 @@ void ComputingGraphImpl::ComputingSequence::do_wait(bool explicit_user_wait) {
             m_event_end.at(cn)->host_wait();
         }
     }
+    m_host_exec_time = m_host_timer.get_secs();
     m_wait_finished = true;
 #if MGB_NEED_MEGDNN_ASYNC_ERROR
     // FIXME: It CAN NOT work well if more than one ComputingSequnces has been
@@ -450,9 +493,8 @@ void ComputingGraphImpl::ComputingSequence::init_for_exec() {
 
     // add all tasks into exec env
     m_exec_env.clear();
-    if (!m_have_parent_graph) {
-        record_all_event(m_event_start);
-    }
+    init_events();
+    record_all_event(m_event_start);
     for (auto i : *m_opr_seq) {
         m_exec_env.set_active_opr(i);
         i->execute(m_exec_env);
@@ -463,6 +505,32 @@ void ComputingGraphImpl::ComputingSequence::init_for_exec() {
     m_cg_event_version = m_owner_graph->event().version();
 }
 
+bool ComputingGraphImpl::ComputingSequence::need_exec_timer() const {
+    // events recorded by the seq recorder could not be replaced later
+    return !m_have_parent_graph &&
+           (m_need_exec_timer || m_enable_comp_node_seq_recorder ||
+            m_owner_graph->options().enable_exec_timer);
+}
+
+void ComputingGraphImpl::ComputingSequence::init_events() {
+    bool timer = need_exec_timer();
+    if (m_event_end.size() == m_used_comp_node.size() &&
+        timer != m_event_start.empty()) {
+        return;
+    }
+    // events are taken from the shared pool, so recompiling the graph or
+    // turning on the timer does not create new device events each time
+    m_event_start.clear();
+    m_event_end.clear();
+    size_t flag = timer ? CompNode::Event::NEED_TIMER : 0;
+    for (auto&& i : m_used_comp_node) {
+        if (timer) {
+            m_event_start[i] = i.create_pooled_event(flag);
+        }
+        m_event_end[i] = i.create_pooled_event(flag);
+    }
+}
+
 void ComputingGraphImpl::ComputingSequence::on_first_exec() {
     mgb_assert(m_first_exec);
     for (auto i : *m_opr_seq) {
@@ -485,16 +553,6 @@ void ComputingGraphImpl::ComputingSequence::on_first_exec() {
         for (auto i : m_used_comp_node)
             m_exec_env.add_comp_node(i);
     }
-
-    // create events for timing and sync
-    for (auto&& i : m_used_comp_node) {
-        size_t flag = 0;
-        if (!m_have_parent_graph) {
-            flag = CompNode::Event::NEED_TIMER;
-            m_event_start[i] = i.create_event(flag);
-        }
-        m_event_end[i] = i.create_event(flag);
-    }
     m_first_exec = false;
 }
 
@@ -559,6 +617,12 @@ double ComputingGraphImpl::ComputingSequence::get_prev_exec_time() const {
         return m_prev_exec_time.val();
     }
     if (!m_have_parent_graph) {
+        if (m_event_start.empty()) {
+            // timing events would be recorded from the next run on
+            m_need_exec_timer = true;
+            m_prev_exec_time = m_host_exec_time;
+            return m_host_exec_time;
+        }
         double max_time = 0;
         for (auto cn : m_used_comp_node) {
             update_max(
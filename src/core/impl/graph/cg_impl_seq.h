@@ -6,6 +6,7 @@
 #include "megbrain/plugin/static_mem_record.h"
 #include "megbrain/plugin/var_sanity_check.h"
 #include "megbrain/utils/arith_helper.h"
+#include "megbrain/utils/timer.h"
 
 namespace mgb {
 namespace cg {
@@ -19,10 +20,18 @@ class ComputingGraphImpl::ComputingSequence final : public AsyncExecutable {
     size_t m_run_id = 0;
     size_t m_cg_event_version = 0;
     mutable Maybe<double> m_prev_exec_time;
+    //! set by get_prev_exec_time() to create timing events for later runs
+    mutable bool m_need_exec_timer = false;
+    //! host time from preprocess() to do_wait() of the previous run
+    double m_host_exec_time = 0;
+    RealTimer m_host_timer;
 #if !__DEPLOY_ON_XP_SP2__
     std::unique_ptr<VarSanityCheck> m_var_sanity_check;
 #endif
     std::unique_ptr<CompNodeSeqRecorder> m_comp_node_seq_recorder;
+    //! tensor pointers when m_comp_node_seq_recorder was recorded, for
+    //! recorders that support update
+    std::vector<const void*> m_recorded_tensor_ptrs;
 
     NormalExecEnv m_exec_env;
 
@@ -31,7 +40,8 @@ class ComputingGraphImpl::ComputingSequence final : public AsyncExecutable {
 
     CompNode::UnorderedSet m_used_comp_node;
 
-    using EventArray = CompNode::UnorderedMap<std::unique_ptr<CompNode::Event>>;
+    using EventArray = CompNode::UnorderedMap<CompNode::PooledEvent>;
+    //! m_event_start is empty if timing events are not needed
     EventArray m_event_start, m_event_end;
 
     class ExecContext;
@@ -49,6 +59,16 @@ class ComputingGraphImpl::ComputingSequence final : public AsyncExecutable {
      */
     std::unique_ptr<CompNodeSeqRecorder> check_enable_comp_node_seq_recorder();
 
+    /*!
+     * \brief get raw pointers of the tensors that the oprs use, i.e. the
+     *      output vars, the host tensors of Host2DeviceCopy and the device
+     *      tensors of VolatileSharedDeviceTensor
+     *
+     * The pointers are read through the ref ptr of the storages, so they
+     * reflect TensorStorage::only_reset_raw_storage() on any copy of them.
+     */
+    void get_tensor_ptrs(std::vector<const void*>& dest) const;
+
     void record_all_event(const EventArray& arr) {
         for (auto&& i : arr) {
             auto runner = [ev = i.second.get()]() { ev->record(); };
@@ -58,6 +78,12 @@ class ComputingGraphImpl::ComputingSequence final : public AsyncExecutable {
 
     void init_for_exec();
 
+    //! whether timing events should be recorded in the next run
+    bool need_exec_timer() const;
+
+    //! (re)create the events for timing and sync; called from init_for_exec()
+    void init_events();
+
     //! called from init_for_exec() when m_first_exec is true
     void on_first_exec();
 
@@ -122,6 +148,10 @@ public:
 
     double get_prev_exec_time() const override;
 
+    const CompilePhaseTime& get_compile_phase_time() const override {
+        return extra_info.compile_phase_time;
+    }
+
     AsyncExecutable& iter_opr_seq(thin_function<bool(OperatorNodeBase*)> cb) override;
 
 #if MGB_ENABLE_JSON
@@ -218,7 +248,7 @@ class ComputingGraphImpl::RecordedComputingSequence final : public AsyncExecutab
     UserDataContainer m_graph_user_data;
     DeviceTensorStorage m_static_mem;
     std::unique_ptr<CompNodeSeqRecorder> m_recorder;
-    std::unique_ptr<CompNode::Event> m_event_start, m_event_end;
+    CompNode::PooledEvent m_event_start, m_event_end;
     //! valid if owner graph is not destroyed
     ComputingGraphImpl* m_owner_graph;
     mutable Maybe<double> m_prev_exec_time;
@@ -205,7 +205,7 @@ void EagerEvalManager::prepare_for_exec(OperatorNodeBase* opr) {
         for (auto j : i.dev_ready) {
             auto mgr = VarNodeMemManager::var_node_cn_sync_manager(j);
             if (!mgr->m_ready_event) {
-                mgr->m_ready_event = mgr->m_comp_node.create_event();
+                mgr->m_ready_event = mgr->m_comp_node.create_pooled_event();
                 mgr->m_ready_event->record();
             }
         }
@@ -28,6 +28,9 @@ struct CompSeqExtraInfo {
     //! source nodes needed for static infer; may contain nodes not in
     //! computing sequence; initialized by CompSeqManager::reset_dest()
     static_infer::DepVal rt_static_infer_src;
+
+    //! time of each phase in graph compiling; filled by ComputingGraphImpl
+    AsyncExecutable::CompilePhaseTime compile_phase_time;
 };
 
 }  // namespace cg
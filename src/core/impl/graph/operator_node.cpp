@@ -8,6 +8,7 @@
 #include "megbrain/graph/helper.h"
 #include "megbrain/graph/operator_node.h"
 
+#include "megbrain/utils/arena_allocator.h"
 #include "megbrain/utils/hash.h"
 #include "megbrain/utils/metahelper.h"
 
@@ -84,6 +85,34 @@ OperatorNodeBase::~OperatorNodeBase() noexcept {
     }
 }
 
+namespace {
+//! header before each operator recording whether it is from an arena
+constexpr size_t OPR_ALLOC_HEADER_SIZE = alignof(std::max_align_t);
+}  // anonymous namespace
+
+void* OperatorNodeBase::operator new(size_t size) {
+    uint8_t* ptr;
+    auto arena = ArenaAllocator::current();
+    if (arena) {
+        ptr = static_cast<uint8_t*>(
+                arena->alloc(size + OPR_ALLOC_HEADER_SIZE, OPR_ALLOC_HEADER_SIZE));
+    } else {
+        ptr = static_cast<uint8_t*>(::operator new(size + OPR_ALLOC_HEADER_SIZE));
+    }
+    *reinterpret_cast<bool*>(ptr) = arena;
+    return ptr + OPR_ALLOC_HEADER_SIZE;
+}
+
+void OperatorNodeBase::operator delete(void* ptr) noexcept {
+    if (!ptr)
+        return;
+    auto base = static_cast<uint8_t*>(ptr) - OPR_ALLOC_HEADER_SIZE;
+    // storage from arena is released with the arena
+    if (!*reinterpret_cast<bool*>(base)) {
+        ::operator delete(base);
+    }
+}
+
 void OperatorNodeBase::execute(ExecEnv& env) {
     if (owner_graph()->options().imperative_proxy_graph) {
         do_execute(env);
@@ -12,6 +12,7 @@ void SeqCompNodeOptimizerImpl::optimize_comp_nodes(const VarNodeArray& endpoints
             m_comp_node_to_restore.empty() && m_comp_node_changed_oprs.empty(),
             "restore_comp_nodes not called");
     change_to_specific_stream(endpoints);
+    assign_compute_streams(endpoints);
 
     for (auto&& i : m_comp_node_to_restore) {
         auto opr = i.first->owner_opr();
@@ -162,6 +163,105 @@ void SeqCompNodeOptimizerImpl::change_to_specific_stream(
     }
 }
 
+void SeqCompNodeOptimizerImpl::assign_compute_streams(const VarNodeArray& endpoints) {
+    auto&& seq_opt = m_owner_graph->options().seq_opt;
+    size_t nr_stream = seq_opt.nr_compute_stream;
+    if (!seq_opt.enable_seq_comp_node_opt || nr_stream < 2) {
+        return;
+    }
+
+    struct OprStream {
+        CompNode cn;  //!< comp node before assignment
+        size_t stream;
+        //! whether a consumer has continued on the stream of this opr
+        bool continued;
+    };
+    ThinHashMap<OperatorNodeBase*, OprStream> opr2stream;
+    //! number of oprs assigned to each stream of the pool
+    CompNode::UnorderedMap<std::vector<size_t>> cn2load;
+    //! whether an opr without assigned producer has taken stream 0
+    CompNode::UnorderedSet root_taken;
+
+    auto get_comp_node = [](OperatorNodeBase* opr) {
+        CompNode cn = opr->output(0)->comp_node();
+        for (auto i : opr->output()) {
+            if (i->comp_node() != cn) {
+                return CompNode{};
+            }
+        }
+        if (cn.locator().stream != 0 ||
+            !cn.contain_flag(CompNode::Flag::HAS_COPY_STREAM)) {
+            return CompNode{};
+        }
+        return cn;
+    };
+
+    auto cb = [&](OperatorNodeBase* opr) {
+        if (opr->node_prop().contain(
+                    OperatorNodeBase::NodeProp::Flag::DISALLOW_COMP_NODE_OPTIMIZE)) {
+            return;
+        }
+        auto cn = get_comp_node(opr);
+        if (!cn.valid()) {
+            return;
+        }
+        auto&& dep_map = opr->node_prop().dep_map();
+        bool has_dev_input = false;
+        OprStream* cont = nullptr;
+        for (auto i : opr->input()) {
+            if (!need_device_computing_on_var(i, dep_map.at(i))) {
+                continue;
+            }
+            has_dev_input = true;
+            auto iter = opr2stream.find(i->owner_opr());
+            if (!cont && iter != opr2stream.end() && iter->second.cn == cn &&
+                !iter->second.continued) {
+                cont = &iter->second;
+            }
+        }
+        if (!has_dev_input) {
+            // oprs like Host2DeviceCopy and SharedDeviceTensor are kept
+            return;
+        }
+
+        auto&& load = cn2load[cn];
+        load.resize(nr_stream);
+        size_t stream = 0;
+        if (cont) {
+            // continue the chain of the producer
+            cont->continued = true;
+            stream = cont->stream;
+        } else if (!root_taken.insert(cn).second) {
+            // a new branch goes to the least loaded stream
+            stream = std::min_element(load.begin(), load.end()) - load.begin();
+        }
+        ++load[stream];
+        opr2stream[opr] = {cn, stream, false};
+        if (stream) {
+            auto new_cn = cn.change_stream(stream);
+            for (auto i : opr->output()) {
+                m_comp_node_to_restore.emplace_back(i, cn);
+                i->comp_node(new_cn);
+            }
+        }
+    };
+
+    DepOprIter dep_iter{cb};
+    for (auto i : endpoints) {
+        dep_iter.add(i->owner_opr());
+    }
+
+    for (auto&& i : cn2load) {
+        std::string msg;
+        for (auto j : i.second) {
+            msg.append(ssprintf(" %zu", j));
+        }
+        mgb_log_debug(
+                "compute streams of %s: nr_opr=[%s ]", i.first.to_string().c_str(),
+                msg.c_str());
+    }
+}
+
 void SeqCompNodeOptimizerImpl::register_stream_var(
         VarNode* var, StreamPropType stream_prop_type) {
     int stream = stream_prop_type.stream;
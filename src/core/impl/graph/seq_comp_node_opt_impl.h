@@ -33,6 +33,10 @@ class SeqCompNodeOptimizerImpl final : public SeqCompNodeOptimizer {
     //! m_comp_node_to_restore
     void var_to_specific_stream(VarNode* var, const int stream);
 
+    //! spread the independent branches on stream 0 of each comp node over
+    //! the compute stream pool given by seq_opt.nr_compute_stream
+    void assign_compute_streams(const VarNodeArray& endpoints);
+
 public:
     SeqCompNodeOptimizerImpl(ComputingGraphImpl* graph) : m_owner_graph(graph) {}
 
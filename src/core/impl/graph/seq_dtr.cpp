@@ -1,4 +1,5 @@
 #include "./seq_dtr.h"
+#include "megbrain/plugin/opr_footprint.h"
 
 #if MGB_ENABLE_DTR
 
@@ -23,6 +24,12 @@ public:
 
     SeqModifyAction perform_dtr(
             CompNode comp_node, const OprNodeArray& seq, Config* config);
+
+    //! peak memory usage in the simulation of the last perform_dtr()
+    size_t peak_usage() const { return m_peak_usage; }
+
+private:
+    size_t m_peak_usage = 0;
 };
 
 SeqModifierForDTR::SeqModifierForDTR(ComputingGraphImpl* owner, Config* config_g)
@@ -30,6 +37,7 @@ SeqModifierForDTR::SeqModifierForDTR(ComputingGraphImpl* owner, Config* config_g
 
 void SeqModifierForDTR::modify_endpoint_vars(VarNodeArray& endpoints) {
     var_map().clear();
+    m_prev_peak_usage.clear();
     auto comp_seq = MemoryOptimizerHelper::CompSeq(owner_graph(), endpoints);
     auto config =
             MemoryOptimizerHelper::SubGraphConfig()
@@ -52,9 +60,20 @@ void SeqModifierForDTR::modify_endpoint_vars(VarNodeArray& endpoints) {
         return;
     }
     SeqModifyAction action;
-    ModifyActionPlanner* planner = new ModifyActionPlanner(this);
+    ModifyActionPlanner planner{this};
     for (auto&& i : *cn2oprseq) {
-        auto&& cur = planner->perform_dtr(i.first, i.second, m_config);
+        auto&& cur = planner.perform_dtr(i.first, i.second, m_config);
+        size_t nr_recomp = 0;
+        for (auto&& j : cur) {
+            nr_recomp += j.second.size();
+        }
+        m_prev_peak_usage[i.first] = planner.peak_usage();
+        mgb_log_debug(
+                "DTR plan on %s: %zu oprs, %zu recomputed, simulated peak "
+                "usage %.2fMiB (threshold %.2fMiB)",
+                i.first.to_string().c_str(), i.second.size(), nr_recomp,
+                planner.peak_usage() / 1024.0 / 1024,
+                m_config->eviction_threshold / 1024.0 / 1024);
         action.insert(cur.begin(), cur.end());
     }
     apply_action(action, *comp_seq.m_seq);
@@ -66,9 +85,16 @@ void SeqModifierForDTR::modify_endpoint_vars(VarNodeArray& endpoints) {
     }
 }
 
+const CompNode::UnorderedMap<size_t>& SeqModifierForDTR::prev_peak_usage() {
+    return m_prev_peak_usage;
+}
+
 void SeqModifierForDTR::ModifyActionPlanner::prepare(const OprNodeArray& opr_seq) {
     init_seq(opr_seq, false);
 
+    // no time is measured before the graph runs, so the cost of an opr is
+    // the larger one of its computation and its memory traffic
+    OprFootprint footprint;
     for (size_t i = 0; i < seq().size(); ++i) {
         auto opr = seq()[i].get();
         size_t est = 0;
@@ -78,6 +104,7 @@ void SeqModifierForDTR::ModifyActionPlanner::prepare(const OprNodeArray& opr_seq
         for (auto i : opr->output) {
             est += i->size;
         }
+        est = std::max<size_t>(est, footprint.get_computation(opr->orig_opr));
         opr->estimate_compute_time = static_cast<double>(est) / 1e8;
     }
 }
@@ -86,6 +113,7 @@ SeqModifierForDTR::SeqModifyAction SeqModifierForDTR::ModifyActionPlanner::perfo
         CompNode comp_node, const OprNodeArray& opr_seq, Config* config) {
     prepare(opr_seq);
     SeqModifyAction action;
+    m_peak_usage = 0;
 
     if (comp_node.locator().stream < 0) {
         // do not modify system stream oprs
@@ -329,6 +357,7 @@ SeqModifierForDTR::SeqModifyAction SeqModifierForDTR::ModifyActionPlanner::perfo
                         new_var->access_rec.push_back(lo->access_rec[i]);
                     }
                     add_alive(new_var);
+                    m_peak_usage = std::max(m_peak_usage, cur_usage);
                     latest_var[o->orig_var] = new_var;
                 }
             }
@@ -365,6 +394,7 @@ SeqModifierForDTR::SeqModifyAction SeqModifierForDTR::ModifyActionPlanner::perfo
             o = get_latest(o);
             add_alive(o);
         }
+        m_peak_usage = std::max(m_peak_usage, cur_usage);
         for (auto i : opr->input) {
             pin[i->orig_var]--;
         }
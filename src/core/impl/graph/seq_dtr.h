@@ -16,11 +16,25 @@ class SeqModifierForDTR : public SeqModifierBase {
 
     class ModifyActionPlanner;
 
+    //! peak memory usage of each comp node in the simulated execution of the
+    //! last plan
+    CompNode::UnorderedMap<size_t> m_prev_peak_usage;
+
 public:
     SeqModifierForDTR(ComputingGraphImpl* owner, Config* config_g);
 
+    /*!
+     * \brief plan the evictions by simulating the execution under
+     *      Config::eviction_threshold, and bake the recomputation into the
+     *      opr sequence
+     *
+     * The plan is made once when the graph is compiled, so no eviction is
+     * decided while the graph is executed.
+     */
     void modify_endpoint_vars(VarNodeArray& endpoints);
 
+    const CompNode::UnorderedMap<size_t>& prev_peak_usage();
+
     void apply_action(SeqModifyAction& action, const OprNodeArray& oprseq);
 };
 
@@ -14,6 +14,7 @@ using namespace cg;
 #include "megbrain/utils/timer.h"
 
 #include <cmath>
+#include <numeric>
 #include <random>
 
 namespace {
@@ -43,6 +44,9 @@ public:
     }
 };
 
+//! estimated cost of computing each opr
+using OprCostMap = ThinHashMap<OperatorNodeBase*, double>;
+
 bool is_bad_opr(OperatorNodeBase* opr) {
     using F = OperatorNodeBase::NodeProp::Flag;
     return opr->node_prop().contain(
@@ -98,8 +102,21 @@ public:
 
     //! get action for previous get_memory_bottleneck() call
     void get_prev_action(SeqModifyAction& action);
+
+    //! cost of the oprs inserted by previous get_memory_bottleneck() call
+    double get_prev_recomp_cost(const OprCostMap& opr_cost);
 };
 
+double SeqModifierForSublinearMemory::ModifyActionPlanner::get_prev_recomp_cost(
+        const OprCostMap& opr_cost) {
+    double cost = 0;
+    for (auto&& opr : seq()) {
+        for (auto&& i : opr->oprs_insert_before)
+            cost += opr_cost.at(i->orig_opr);
+    }
+    return cost;
+}
+
 void SeqModifierForSublinearMemory::ModifyActionPlanner::get_prev_action(
         SeqModifyAction& action) {
     action.clear();
@@ -494,6 +511,23 @@ class SeqModifierForSublinearMemory::ActionSearcherSingleCN {
     std::vector<std::future<void>> m_futures;
     std::mutex m_mtx;
 
+    //! budget of the bottleneck in bytes, or 0 if not set
+    size_t m_budget = 0;
+    OprCostMap m_opr_cost;
+    //! recompute cost of the best plan and total cost of the sequence
+    double m_best_cost, m_total_cost;
+
+    /*!
+     * \brief compare a plan with the best one
+     *
+     * Without a budget, the plan with less bottleneck is better. With a budget,
+     * a plan within the budget is better than one exceeding it, and among the
+     * plans within the budget, the one with less recompute cost is better.
+     *
+     * \return positive if better, 0 if equal and negative if worse
+     */
+    int compare_with_best(size_t bottleneck, double cost) const;
+
     /*!
      * \brief check given thresh, and update states
      * \return bottleneck value for given thresh
@@ -513,6 +547,8 @@ class SeqModifierForSublinearMemory::ActionSearcherSingleCN {
     //! genetic algorithm
     void search_genetic();
     void search_refine();
+    //! local search around the best plan within the budget
+    void search_budget();
 
     static inline bool cmp_sps(const SplitPointSet& a, const SplitPointSet& b) {
         if (a->size() != b->size()) {
@@ -547,6 +583,12 @@ public:
         if (auto env = MGB_GETENV("MGB_SUBLINEAR_MEMORY_LOWER_BOUND_MB")) {
             m_config->lb_memory_mb = std::stoi(env);
         }
+        if (auto env = MGB_GETENV("MGB_SUBLINEAR_MEMORY_BUDGET_MB")) {
+            m_config->budget_memory_mb = std::stoi(env);
+        }
+        if (m_config->budget_memory_mb > 0) {
+            m_budget = static_cast<size_t>(m_config->budget_memory_mb) << 20;
+        }
     }
 
     const SeqModifyAction& search(CompNode comp_node, const OprNodeArray* seq);
@@ -560,11 +602,14 @@ void SeqModifierForSublinearMemory::ActionSearcherSingleCN::do_search_update_thr
     planner->init_seq(*m_cur_opr_seq);
     SplitPointSet split_point_set = planner->get_split_point_set(thresh);
     auto cur = planner->get_memory_bottleneck(split_point_set);
+    auto cost = planner->get_prev_recomp_cost(m_opr_cost);
 
     MGB_LOCK_GUARD(m_mtx);
-    if (cur < m_min_bottleneck || (cur == m_min_bottleneck && m_best_thresh < thresh)) {
+    auto cmp = compare_with_best(cur, cost);
+    if (cmp > 0 || (!cmp && m_best_thresh < thresh)) {
         m_best_thresh = thresh;
         m_min_bottleneck = cur;
+        m_best_cost = cost;
         m_best_sps = split_point_set;
         planner->get_prev_action(m_action);
     }
@@ -579,17 +624,33 @@ void SeqModifierForSublinearMemory::ActionSearcherSingleCN::
 
     planner->init_seq(*m_cur_opr_seq);
     auto cur = planner->get_memory_bottleneck(split_point_set);
+    auto cost = planner->get_prev_recomp_cost(m_opr_cost);
 
     MGB_LOCK_GUARD(m_mtx);
-    if (cur < m_min_bottleneck ||
-        (cur == m_min_bottleneck && cmp_sps(split_point_set, m_best_sps))) {
+    auto cmp = compare_with_best(cur, cost);
+    if (cmp > 0 || (!cmp && cmp_sps(split_point_set, m_best_sps))) {
         m_min_bottleneck = cur;
+        m_best_cost = cost;
         m_best_sps = split_point_set;
         planner->get_prev_action(m_action);
     }
     m_cur_records.emplace_back(std::move(split_point_set), cur);
 }
 
+int SeqModifierForSublinearMemory::ActionSearcherSingleCN::compare_with_best(
+        size_t bottleneck, double cost) const {
+    if (m_budget) {
+        bool fit = bottleneck <= m_budget, best_fit = m_min_bottleneck <= m_budget;
+        if (fit != best_fit)
+            return fit ? 1 : -1;
+        if (fit && cost != m_best_cost)
+            return cost < m_best_cost ? 1 : -1;
+    }
+    if (bottleneck != m_min_bottleneck)
+        return bottleneck < m_min_bottleneck ? 1 : -1;
+    return 0;
+}
+
 void SeqModifierForSublinearMemory::ActionSearcherSingleCN::invoke_search(
         size_t thresh) {
     m_futures.emplace_back(m_par_modifier->m_planner_thread_pool.launch(
@@ -764,7 +825,8 @@ void SeqModifierForSublinearMemory::ActionSearcherSingleCN::search_genetic() {
 void SeqModifierForSublinearMemory::ActionSearcherSingleCN::search_refine() {
     size_t lower_bound = static_cast<size_t>(m_par_modifier->m_config->lb_memory_mb)
                       << 20;
-    if (m_min_bottleneck >= lower_bound)
+    // the budget already trades memory for less recomputation
+    if (m_budget || m_min_bottleneck >= lower_bound)
         return;
     OprFootprint footprint;
     ThinHashSet<OperatorNodeBase*> dup_oprs_set;
@@ -800,6 +862,7 @@ void SeqModifierForSublinearMemory::ActionSearcherSingleCN::search_refine() {
             auto cur = planner->get_memory_bottleneck(split_point_set);
             if (cur >= lower_bound) {
                 planner->get_prev_action(m_action);
+                m_best_cost = planner->get_prev_recomp_cost(m_opr_cost);
                 flag = false;
             }
         };
@@ -809,6 +872,61 @@ void SeqModifierForSublinearMemory::ActionSearcherSingleCN::search_refine() {
     }
 }
 
+void SeqModifierForSublinearMemory::ActionSearcherSingleCN::search_budget() {
+    if (!m_budget)
+        return;
+    // a block for each opr discards nothing, so the unmodified sequence is
+    // chosen if it is within the budget
+    auto each_opr = make_split_point_set(m_cur_opr_seq->size());
+    std::iota(each_opr->begin(), each_opr->end(), 0);
+    invoke_search(std::move(each_opr));
+    wait_all();
+    if (m_min_bottleneck > m_budget)
+        return;
+
+    // evaluating a plan needs the discard plan of its neighbouring blocks, so
+    // the plans are searched by hill climbing from the best one rather than
+    // solved block by block
+    RealTimer timer;
+    auto time_limit = m_par_modifier->m_config->budget_search_time_ms;
+    while (timer.get_msecs() < time_limit) {
+        auto base = m_best_sps;
+        auto&& s = *base;
+        for (size_t i = 0; i < s.size(); ++i) {
+            size_t begin = i ? s[i - 1] + 1 : 0;
+            if (s[i] > begin) {
+                // split the block in the middle
+                auto added = make_split_point_set(s);
+                added->insert(added->begin() + i, begin + (s[i] - begin) / 2);
+                invoke_search(std::move(added));
+            }
+            // the last split point is the end of the sequence
+            if (i + 1 == s.size())
+                continue;
+            // merge with the next block
+            auto removed = make_split_point_set(s);
+            removed->erase(removed->begin() + i);
+            invoke_search(std::move(removed));
+            // move the split point
+            if (s[i] > begin) {
+                auto moved = make_split_point_set(s);
+                --moved->at(i);
+                invoke_search(std::move(moved));
+            }
+            if (s[i] + 1 < s[i + 1]) {
+                auto moved = make_split_point_set(s);
+                ++moved->at(i);
+                invoke_search(std::move(moved));
+            }
+        }
+        wait_all();
+        if (m_best_sps == base) {
+            // local optimum
+            break;
+        }
+    }
+}
+
 const SeqModifierForSublinearMemory::SeqModifyAction& SeqModifierForSublinearMemory::
         ActionSearcherSingleCN::search(CompNode comp_node, const OprNodeArray* seq) {
     m_action.clear();
@@ -825,6 +943,18 @@ const SeqModifierForSublinearMemory::SeqModifyAction& SeqModifierForSublinearMem
 
     RealTimer timer;
     m_best_thresh = m_min_bottleneck = std::numeric_limits<size_t>::max();
+    m_best_cost = std::numeric_limits<double>::max();
+
+    // computation is the estimated cost of an opr, and each opr costs at least
+    // one for its launch
+    OprFootprint footprint;
+    m_opr_cost.clear();
+    m_total_cost = 0;
+    for (auto opr : *seq) {
+        auto cost = std::max<double>(footprint.get_computation(opr), 1);
+        m_opr_cost[opr] = cost;
+        m_total_cost += cost;
+    }
 
     //! init search
     invoke_search(m_best_thresh);
@@ -835,20 +965,39 @@ const SeqModifierForSublinearMemory::SeqModifyAction& SeqModifierForSublinearMem
     search_genetic();
     auto t1 = timer.get_msecs_reset();
     search_refine();
+    search_budget();
     auto t2 = timer.get_msecs_reset();
 
     std::sort(m_history.begin(), m_history.end());
     m_par_modifier->m_prev_min_bottleneck.at(comp_node) = m_min_bottleneck;
+    double overhead = m_best_cost / m_total_cost;
+    m_par_modifier->m_prev_recomp_overhead.at(comp_node) = overhead;
+    if (m_budget) {
+        constexpr double SIZE2MB = 1.0 / 1024 / 1024;
+        if (m_min_bottleneck <= m_budget) {
+            mgb_log("sublinear memory on %s: bottleneck %.2fMB within budget "
+                    "%.2fMB, estimated recompute overhead %.2f%%",
+                    comp_node.to_string().c_str(), m_min_bottleneck * SIZE2MB,
+                    m_budget * SIZE2MB, overhead * 100);
+        } else {
+            mgb_log_warn(
+                    "sublinear memory on %s: no plan within budget %.2fMB, use the "
+                    "least bottleneck %.2fMB",
+                    comp_node.to_string().c_str(), m_budget * SIZE2MB,
+                    m_min_bottleneck * SIZE2MB);
+        }
+    }
 
 #if MGB_ENABLE_LOGGING
     constexpr double SIZE2MB = 1.0 / 1024 / 1024;
     std::string msg{ssprintf(
             "finished searching for sublinear memory: "
             "comp_node=%s seq_len=%zu nr_search=%zu "
-            "time=%.1fms(init%.2f genetic%.2f refine%.2f)\n"
+            "time=%.1fms(init%.2f genetic%.2f refine%.2f) "
+            "recompute_overhead=%.2f%%\n"
             "thresh     bottleneck",
             comp_node.to_string().c_str(), seq->size(), m_history.size(), t0 + t1 + t2,
-            t0, t1, t2)};
+            t0, t1, t2, overhead * 100)};
     for (auto&& i : m_history) {
         msg.push_back('\n');
         msg.append(ssprintf("%-10.2f %-10.2f", i.first * SIZE2MB, i.second * SIZE2MB));
@@ -951,8 +1100,10 @@ SeqModifierForSublinearMemory::SeqModifyAction SeqModifierForSublinearMemory::
     workers.start(cn2oprseq->size());
 
     m_prev_min_bottleneck.clear();
+    m_prev_recomp_overhead.clear();
     for (auto&& i : *cn2oprseq) {
         m_prev_min_bottleneck[i.first] = 0;
+        m_prev_recomp_overhead[i.first] = 0;
     }
 
     std::vector<WorkerPool::Future> futures;
@@ -1095,6 +1246,11 @@ const CompNode::UnorderedMap<size_t>& SeqModifierForSublinearMemory::
     return m_prev_min_bottleneck;
 }
 
+const CompNode::UnorderedMap<double>& SeqModifierForSublinearMemory::
+        prev_recomp_overhead() {
+    return m_prev_recomp_overhead;
+}
+
 SeqModifierForSublinearMemory::SeqModifierForSublinearMemory(
         ComputingGraphImpl* owner, Config* config_p)
         : SeqModifierBase(owner), m_config(config_p) {}
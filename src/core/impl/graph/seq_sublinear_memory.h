@@ -29,6 +29,13 @@ public:
 
     const CompNode::UnorderedMap<size_t>& prev_min_bottleneck();
 
+    /*!
+     * \brief estimated computation of the recomputed oprs relative to the
+     *      whole sequence of each comp node, for the plan chosen by the last
+     *      search
+     */
+    const CompNode::UnorderedMap<double>& prev_recomp_overhead();
+
 private:
     using SplitPointSet = std::shared_ptr<std::vector<size_t>>;
 
@@ -60,6 +67,7 @@ private:
     FutureThreadPool<void> m_planner_thread_pool;
 
     CompNode::UnorderedMap<size_t> m_prev_min_bottleneck;
+    CompNode::UnorderedMap<double> m_prev_recomp_overhead;
 
     //! restore computing sequence and modify operator priority
     void reset_opr_seq(const OprNodeArray& oprseq);
@@ -13,6 +13,7 @@
 #include "megbrain/tensor_iter.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <deque>
 
@@ -29,6 +30,37 @@ constexpr bool is_static_infer_type(InferType::Flag t) {
     return t & (InferType::RT_STATIC | InferType::CONST);
 }
 
+/*!
+ * \brief infer results of the most recent distinct inputs
+ *
+ * The entries are kept in most-recently-used order and the least recently used
+ * one is dropped when the capacity is exceeded.
+ */
+template <typename T>
+class InferMemo {
+    SmallVector<std::pair<std::string, T>, 4> m_items;
+
+public:
+    const T* get(const std::string& key) {
+        for (size_t i = 0; i < m_items.size(); ++i) {
+            if (m_items[i].first == key) {
+                std::rotate(m_items.begin(), m_items.begin() + i,
+                            m_items.begin() + i + 1);
+                return &m_items[0].second;
+            }
+        }
+        return nullptr;
+    }
+
+    T& put(std::string key, size_t capacity) {
+        if (m_items.size() >= capacity) {
+            m_items.resize(capacity - 1);
+        }
+        m_items.insert(m_items.begin(), {std::move(key), T{}});
+        return m_items[0].second;
+    }
+};
+
 #if MGB_ENABLE_EXCEPTION
 [[noreturn]] void update_rethrow_exc(VarNode* var, MegBrainError& exc) {
     if (var && !exc.extra_info()) {
@@ -223,6 +255,19 @@ protected:
     //! current infer result, to be used by dependents
     InpElement m_inp_element;
 
+    //! capacity of the infer result memo; 0 if it should not be used
+    size_t memo_capacity() const {
+        return m_deps.empty() ? 0
+                              : tag()->owner_graph()->options().static_infer_memo_size;
+    }
+
+    /*!
+     * \brief the memo key of an input, which consists of the shapes and the
+     *      small contiguous values of the deps
+     * \return false if the input can not be memoized
+     */
+    static bool make_memo_key(const InpVal& inp, std::string& key);
+
     enum class InferResult { UNCHANGED, CHANGED, FAILED };
 
     /*!
@@ -283,6 +328,7 @@ MGB_DEFINE_CLS_WITH_SUPER(
         StaticInferManagerImpl::TagShapeTrait final, TagTraitMutableBase) // {
     TensorShape m_shape;
     ShapeInferDesc m_desc;
+    InferMemo<TensorShape> m_memo;
 
     const DepVal& raw_deps() override { return m_desc.deps; }
 
@@ -313,6 +359,8 @@ MGB_DEFINE_CLS_WITH_SUPER(
 
     DeviceTensorND m_cur_value;
     ValueInferDesc m_desc;
+    //! only small results are memoized
+    InferMemo<DeviceTensorND> m_memo;
 
     const DepVal& raw_deps() override { return m_desc.deps; }
 
@@ -628,6 +676,34 @@ void StaticInferManagerImpl::TagTraitMutableBase::sync_from_var() {
     }
 }
 
+bool StaticInferManagerImpl::TagTraitMutableBase::make_memo_key(
+        const InpVal& inp, std::string& key) {
+    key.clear();
+    auto append = [&key](const void* ptr, size_t size) {
+        key.append(static_cast<const char*>(ptr), size);
+    };
+    for (auto&& i : inp.val) {
+        if (!i.m_value) {
+            auto&& shp = i.shape();
+            append(&shp.ndim, sizeof(shp.ndim));
+            append(shp.shape, sizeof(shp.shape[0]) * shp.ndim);
+            continue;
+        }
+        auto&& val = *i.m_value;
+        auto&& layout = val.layout();
+        if (!layout.is_contiguous() ||
+            layout.total_nr_elems() > INFER_VALUE_CHECK_UNCHANGE_MAX_SIZE) {
+            return false;
+        }
+        auto dtype = layout.dtype.enumv();
+        append(&dtype, sizeof(dtype));
+        append(&layout.ndim, sizeof(layout.ndim));
+        append(layout.shape, sizeof(layout.shape[0]) * layout.ndim);
+        append(val.raw_ptr(), layout.span().dist_byte());
+    }
+    return true;
+}
+
 void StaticInferManagerImpl::TagTraitMutableBase::reset_inp_element_synced() {
     if (!m_inp_element_synced) {
         return;
@@ -674,12 +750,22 @@ StaticInferManagerImpl::TagShapeTrait::InferResult StaticInferManagerImpl::
         }
         return InferResult::UNCHANGED;
     }
+    std::string key;
+    bool memo = memo_capacity() && make_memo_key(inp, key);
+    if (memo) {
+        if (auto shp = m_memo.get(key)) {
+            return set_shape(*shp);
+        }
+    }
     TensorShape dest;
     bool succ = m_desc.infer_func(dest, inp);
     if (!succ) {
         mgb_assert(is_mutable_src(), "infer failed for non-mutable src tag");
         return InferResult::FAILED;
     }
+    if (memo) {
+        m_memo.put(std::move(key), memo_capacity()) = dest;
+    }
     return set_shape(dest);
 }
 
@@ -747,6 +833,18 @@ StaticInferManagerImpl::TagValueTrait::InferResult StaticInferManagerImpl::
         }
         return InferResult::UNCHANGED;
     }
+    std::string key;
+    bool memo = memo_capacity() && make_memo_key(inp, key);
+    if (memo) {
+        if (auto val = m_memo.get(key)) {
+            // m_cur_value may share the storage of other values, so it is
+            // replaced rather than written
+            DeviceTensorND tmp;
+            tmp.copy_from(*val);
+            m_cur_value = tmp;
+            return update_value();
+        }
+    }
     bool succ = m_desc.infer_func(m_cur_value, inp);
     if (!succ) {
         mgb_assert(
@@ -754,6 +852,10 @@ StaticInferManagerImpl::TagValueTrait::InferResult StaticInferManagerImpl::
                 cg::dump_var_info({tag()}).c_str());
         return InferResult::FAILED;
     }
+    if (memo && m_cur_value.shape().total_nr_elems() <=
+                        INFER_VALUE_CHECK_UNCHANGE_MAX_SIZE) {
+        m_memo.put(std::move(key), memo_capacity()).copy_from(m_cur_value);
+    }
     return update_value();
 }
 
@@ -5,8 +5,10 @@
 
 #include "megbrain/gopt/framework.h"
 #include "megbrain/opr/io.h"
+#include "megbrain/plugin/opr_footprint.h"
 #include "megbrain/serialization/opr_shallow_copy.h"
 #include "megbrain/serialization/serializer.h"
+#include "megbrain/utils/timer.h"
 
 #include <queue>
 
@@ -137,6 +139,63 @@ MemorySwap::MemorySwap(ComputingGraph* graph) : m_owner_graph(graph){};
 
 MemorySwap::~MemorySwap() noexcept = default;
 
+double MemorySwap::measure_bandwidth(CompNode comp_node) {
+    constexpr size_t SIZE = 32 << 20;
+    // host tensors on a cuda comp node are pinned, as the swapped out vars
+    HostTensorND host{comp_node, {SIZE}, dtype::Byte()};
+    DeviceTensorND dev{comp_node, {SIZE}, dtype::Byte()};
+    dev.copy_from_fixlayout(host);
+    comp_node.sync();
+    RealTimer timer;
+    dev.copy_from_fixlayout(host);
+    comp_node.sync();
+    double h2d = timer.get_secs_reset();
+    host.copy_from_fixlayout(dev).sync();
+    double d2h = timer.get_secs();
+    return SIZE / std::max({h2d, d2h, 1e-9});
+}
+
+void MemorySwap::estimate_opr_time(const cg::OprNodeArray& opr_seq) {
+    auto&& infer_mgr = m_owner_graph->static_infer_manager();
+    OprFootprint footprint;
+    m_time_prefix.assign(opr_seq.size() + 1, 0);
+    for (size_t i = 0; i < opr_seq.size(); ++i) {
+        auto opr = opr_seq[i];
+        double nr_bytes = 0;
+        auto add_bytes = [&](VarNode* var) {
+            auto shp = infer_mgr.infer_shape_fallible(var);
+            if (shp && var->dtype().valid())
+                nr_bytes += var->dtype().size(shp->total_nr_elems());
+        };
+        for (auto var : opr->input())
+            add_bytes(var);
+        for (auto var : opr->output())
+            add_bytes(var);
+        double time = std::max(
+                footprint.get_computation(opr) / m_device_flops,
+                nr_bytes / m_device_mem_bandwidth);
+        m_time_prefix[i + 1] = m_time_prefix[i] + time;
+    }
+}
+
+size_t MemorySwap::swap_in_lead(size_t size, size_t pos) const {
+    // the copy of serial swap-in blocks the computation, so starting it early
+    // only holds the memory longer
+    if (!m_bucket_implement)
+        return 1;
+    size_t lead = m_swap_in_prev;
+    double need = transfer_time(size);
+    while (lead < pos && m_time_prefix[pos] - m_time_prefix[pos - lead] < need)
+        ++lead;
+    return std::min(lead, pos);
+}
+
+bool MemorySwap::recompute_cheaper(size_t var_id, size_t size) {
+    auto pos = m_opr_seq_dist[var_id];
+    double recomp_time = m_time_prefix[pos + 1] - m_time_prefix[pos];
+    return recomp_time < transfer_time(size) * 2;
+}
+
 void MemorySwap::determine_swap_edge(
         PIPSet& heap, size_t loss_idx, const cg::OprNodeArray& opr_seq,
         std::vector<std::vector<size_t>>& g, std::vector<std::vector<size_t>>& tg) {
@@ -240,6 +299,9 @@ void MemorySwap::determine_swap_edge(
                 continue;
             if (m_opr_seq_dist[v] - m_opr_seq_dist[u] <= m_swap_in_prev)
                 continue;
+            // such vars are left to the recomputation of sublinear memory
+            if (recompute_cheaper(u, m_segmentToRace[x]->m_mem))
+                continue;
 
             tmp_vec_weak.push_back(x);
             /*!
@@ -478,6 +540,30 @@ void MemorySwap::modify_dest_var_inplace(VarNodeArray& vars) {
     if (!m_bucket_implement)
         m_swap_in_prev = 1;
 
+    auto env_bandwidth = MGB_GETENV("MGB_MEMORY_SWAP_PARAM_BANDWIDTH");
+    if (env_bandwidth) {
+        sscanf(env_bandwidth, "%lf", &m_cpu_gpu_bandwidth);
+        mgb_assert(m_cpu_gpu_bandwidth > 0);
+    } else if (!m_cpu_gpu_bandwidth) {
+        m_cpu_gpu_bandwidth = measure_bandwidth(vars[0]->comp_node());
+        mgb_log_debug(
+                "measured host-device bandwidth of memory swap: %.2fGB/s",
+                m_cpu_gpu_bandwidth / 1e9);
+    }
+
+    auto env_device_flops = MGB_GETENV("MGB_MEMORY_SWAP_PARAM_DEVICE_FLOPS");
+    if (env_device_flops) {
+        sscanf(env_device_flops, "%lf", &m_device_flops);
+        mgb_assert(m_device_flops > 0);
+    }
+
+    auto env_device_mem_bandwidth =
+            MGB_GETENV("MGB_MEMORY_SWAP_PARAM_DEVICE_MEM_BANDWIDTH");
+    if (env_device_mem_bandwidth) {
+        sscanf(env_device_mem_bandwidth, "%lf", &m_device_mem_bandwidth);
+        mgb_assert(m_device_mem_bandwidth > 0);
+    }
+
     std::queue<OperatorNodeBase*> rst;
     std::queue<VarNode*> lst;
     SymbolVarArray sva;
@@ -498,6 +584,7 @@ void MemorySwap::modify_dest_var_inplace(VarNodeArray& vars) {
             std::numeric_limits<int>::max())
             opr_seq[i]->node_prop().attribute().priority++;
     }
+    estimate_opr_time(opr_seq);
 
     while (!lst.empty() || !rst.empty()) {
         while (!lst.empty()) {
@@ -692,18 +779,23 @@ void MemorySwap::modify_dest_var_inplace(VarNodeArray& vars) {
     }
 
     int fail_counter = 0;
+    auto&& infer_mgr = m_owner_graph->static_infer_manager();
     for (auto x : fuse_swap) {
+        auto swap_var = m_var_map[x.first];
+        auto swap_size = swap_var->dtype().size(
+                infer_mgr.infer_shape(swap_var).total_nr_elems());
         sort((x.second).begin(), (x.second).end(),
              [&](const size_t& lhs, const size_t& rhs) {
                  return m_opr_seq_dist[lhs] < m_opr_seq_dist[rhs];
              });
         for (size_t i = 0; i < x.second.size(); ++i) {
             int dep_idx = 0;
-            if (m_opr_seq_dist[x.second[i]] >= m_swap_in_prev)
-                dep_idx = opr_seq[m_opr_seq_dist[x.second[i]] - m_swap_in_prev]
-                                  ->output(0)
-                                  ->id() +
-                          1;
+            size_t pos = m_opr_seq_dist[x.second[i]];
+            // start the swap-in early enough to hide the copy behind the oprs
+            // before its consumer
+            auto lead = swap_in_lead(swap_size, pos);
+            if (pos >= (size_t)m_swap_in_prev)
+                dep_idx = opr_seq[pos - lead]->output(0)->id() + 1;
             if (dep_idx > 0) {
                 size_t j = i;
                 for (; j < x.second.size(); ++j) {
@@ -80,6 +80,9 @@ class MemorySwap {
      * this param controls it; increaseing this param may improve parallelism
      * but increase memory usage
      *
+     * in bucket mode it is the minimum, and the swap-in of a large var starts
+     * earlier according to the bandwidth and the estimated time of oprs
+     *
      * in serial mode, this will be modified to 1
      *
      * TODO :: in tensorflow, there is a method named
@@ -117,7 +120,20 @@ class MemorySwap {
      */
     size_t m_max_swap_out_var_size = 0;
 
-    const double m_cpu_gpu_bandwidth = 10000000000.0;
+    /*!
+     * bandwidth between host and device in bytes per second; measured on the
+     * comp node of the graph unless given by env var
+     */
+    double m_cpu_gpu_bandwidth = 0;
+
+    /*!
+     * throughput of the device in flops and bytes per second, only used to
+     * estimate the time of oprs before they are executed
+     */
+    double m_device_flops = 1e13, m_device_mem_bandwidth = 5e11;
+
+    //! m_time_prefix[i] is the estimated time of the first i oprs in opr seq
+    std::vector<double> m_time_prefix;
 
     ComputingGraph* m_owner_graph;
     /*!
@@ -150,6 +166,27 @@ class MemorySwap {
     ThinHashMap<size_t, int> m_color;
     PSSSet m_swapped_pair;
 
+    //! time to copy given bytes once between host and device
+    double transfer_time(size_t size) const { return size / m_cpu_gpu_bandwidth; }
+
+    //! bandwidth of the slower direction between host and device
+    static double measure_bandwidth(CompNode comp_node);
+
+    void estimate_opr_time(const cg::OprNodeArray& opr_seq);
+
+    /*!
+     * the number of oprs that a swap-in starts before its consumer at
+     * position pos in opr seq, such that the copy of size bytes overlaps with
+     * the computation of these oprs
+     */
+    size_t swap_in_lead(size_t size, size_t pos) const;
+
+    /*!
+     * whether the owner of the var is estimated to be recomputed faster than
+     * the var is swapped out and in
+     */
+    bool recompute_cheaper(size_t var_id, size_t size);
+
     void determine_swap_edge(
             PIPSet& edges, size_t loss_idx, const cg::OprNodeArray& opr_seq,
             std::vector<std::vector<size_t>>&, std::vector<std::vector<size_t>>&);
@@ -248,6 +248,15 @@ VarNode& VarNode::set_fwd_in2out_writable(VarNode* input) {
     return *this;
 }
 
+VarNode& VarNode::set_fwd_out2in_slice(VarNode* input, const SubTensorSpec& sub) {
+    if (!owner_graph()->options().imperative_proxy_graph) {
+        ComputingGraphImpl::downcast(owner_graph())
+                ->var_node_mem_manager()
+                .fwd_out2in_slice(this, sub, input);
+    }
+    return *this;
+}
+
 VarNode& VarNode::set_fwd_in2out_writable_force(VarNode* input) {
     mgb_assert(!owner_graph()->options().imperative_proxy_graph);
     ComputingGraphImpl::downcast(owner_graph())
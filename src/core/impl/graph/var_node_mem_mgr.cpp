@@ -352,6 +352,19 @@ VarNodeMemManager::DynamicAllocOprInfo::DynamicAllocOprInfo(OperatorNodeBase* op
 }
 
 bool VarNodeMemManager::alloc_var_node_mem_static() {
+    if (m_sys_alloc_static_vars.empty() &&
+        m_owner_graph->eager_eval_manager().enabled()) {
+        // eager evaluation allocates the outputs of a single opr dynamically
+        // in most cases, so there is nothing to plan; the static storage of
+        // previous oprs is kept rather than reallocated
+        if (m_first_static_plan_run) {
+            free_combine_memory_no_need_var();
+            init_dynamic_alloc_opr_info();
+            m_first_static_plan_run = false;
+        }
+        return false;
+    }
+
     RealTimer timer;
 
     if (!update_static_alloc_plan()) {
@@ -1209,6 +1222,44 @@ void VarNodeMemManager::fwd_in2out_writable(VarNode* src, VarNode* dest) {
     m_seq_mem_opt.add_writable_fwd_mem_plan_pair(plan0, &dest->m_mem_plan);
 }
 
+void VarNodeMemManager::fwd_out2in_slice(
+        VarNode* src, const SubTensorSpec& sub, VarNode* dest) {
+    /*
+     * the slice is assigned by seq mem optimizer after all the writable
+     * forward requests are known
+     */
+
+    mgb_assert(
+            src != dest && dest->m_mem_plan.layout().eq_shape(sub.layout()) &&
+            src->dtype() == dest->dtype());
+    auto&& seq_opt = m_owner_graph->options().seq_opt;
+    if (!seq_opt.enable_mem_plan_opt || !seq_opt.enable_mem_fwd_out2in_slice ||
+        m_owner_graph->eager_eval_manager().enabled())
+        return;
+    assert_in_mem_opt_phase(SeqMemOptimizer::Status::ALLOW_FWD_IN2OUT_WRITABLE);
+
+    if (src->comp_node() != dest->comp_node() || !is_static_var_storage(src) ||
+        !is_static_var_storage(dest) ||
+        dest->contain_flag(VarNode::Flag::PERSISTENT_DEVICE_VALUE) ||
+        dest->contain_flag(VarNode::Flag::NO_MEM_RECLAIM))
+        return;
+
+    auto&& dest_spec = m_node_mem_trait.at(dest);
+    if (dest_spec.readonly_src || dest_spec.force_update_src ||
+        dest_spec.seq_force_update_dest ||
+        m_node_mem_trait.at(src).seq_force_update_dest)
+        return;
+
+    // the producer of dest writes a contiguous tensor at an aligned address
+    if (!sub.layout().is_contiguous() || !dest_spec.check_layout(sub.layout()) ||
+        sub.offset_byte() < 0 ||
+        static_cast<size_t>(sub.offset_byte()) %
+                src->comp_node().get_mem_addr_alignment())
+        return;
+
+    m_seq_mem_opt.add_slice_fwd_mem_plan(&src->m_mem_plan, sub, &dest->m_mem_plan);
+}
+
 void VarNodeMemManager::fwd_in2out_writable_force(VarNode* src, VarNode* dest) {
     /*
      * this functin must be called during operator init, and actual forwarding
@@ -277,6 +277,11 @@ public:
      */
     void fwd_in2out_writable_force(VarNode* src, VarNode* dest);
 
+    /*!
+     * \brief see VarNode::set_fwd_out2in_slice
+     */
+    void fwd_out2in_slice(VarNode* src, const SubTensorSpec& sub, VarNode* dest);
+
     void add_layout_constraint(
             VarNode* dest, VarNode::LayoutConstraintCallback callback);
 
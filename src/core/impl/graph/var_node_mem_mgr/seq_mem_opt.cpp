@@ -13,6 +13,50 @@ using namespace cg;
 
 constexpr double BYTE2MB = 1.0 / 1024.0 / 1024;
 
+namespace {
+/*!
+ * \brief lower bound of peak memory: max total size of the chunks alive at
+ *      the same time, the overwrite srcs are excluded since they live in
+ *      their dests
+ */
+template <typename Chunks, typename GetSize>
+size_t static_mem_lower_bound(
+        const Chunks& chunks, const std::vector<bool>& is_overwrite_src,
+        GetSize&& get_size) {
+    // pair of (time, size delta), free before alloc at the same time
+    std::vector<std::pair<size_t, ptrdiff_t>> events;
+    events.reserve(chunks.size() * 2);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (is_overwrite_src[i])
+            continue;
+        auto size = static_cast<ptrdiff_t>(get_size(i));
+        events.emplace_back(chunks[i].begin, size);
+        events.emplace_back(chunks[i].end, -size);
+    }
+    std::sort(events.begin(), events.end());
+    ptrdiff_t cur = 0, peak = 0;
+    for (auto&& i : events) {
+        cur += i.second;
+        peak = std::max(peak, cur);
+    }
+    return peak;
+}
+
+//! the allocator algo can be changed by env var MGB_STATIC_MEM_ALLOC_ALGO
+StaticMemAlloc::AllocatorAlgo static_mem_alloc_algo() {
+    static StaticMemAlloc::AllocatorAlgo algo = []() {
+        auto algo = StaticMemAlloc::AllocatorAlgo::PUSHDOWN;
+        if (auto name = MGB_GETENV("MGB_STATIC_MEM_ALLOC_ALGO")) {
+            mgb_assert(
+                    StaticMemAlloc::algo_from_name(name, algo),
+                    "unknown static mem alloc algo: %s", name);
+        }
+        return algo;
+    }();
+    return algo;
+}
+}  // anonymous namespace
+
 class SeqMemOptimizer::StaticMemAllocLogger {
 public:
     virtual ~StaticMemAllocLogger() = default;
@@ -77,6 +121,7 @@ void SeqMemOptimizer::optimize_mem_plan() {
     OperatorNodeBase* opr = nullptr;
     MGB_TRY {
         m_writable_fwd_mem_plans.clear();
+        m_slice_fwd_mem_plans.clear();
         m_status = Status::ALLOW_FWD_IN2OUT_READONLY;
         OprNodeArray oprs_to_run;
         for (auto i : *m_cur_seq_sys_alloc) {
@@ -96,6 +141,8 @@ void SeqMemOptimizer::optimize_mem_plan() {
             opr->mem_plan_fwd_in2out_writable();
         }
         m_status = 0;
+        opr = nullptr;
+        apply_slice_fwd();
     }
     MGB_CATCH(MegBrainError & exc, {
         if (opr && !exc.extra_info())
@@ -104,6 +151,35 @@ void SeqMemOptimizer::optimize_mem_plan() {
     })
 }
 
+void SeqMemOptimizer::apply_slice_fwd() {
+    m_slice_fwd_vars.clear();
+    m_slice_fwd_chunks.clear();
+    if (m_slice_fwd_mem_plans.empty())
+        return;
+
+    ThinHashSet<MemAllocPlan*> writable_fwd_dest;
+    for (auto&& i : m_writable_fwd_mem_plans) {
+        writable_fwd_dest.insert(i.second);
+    }
+    // requests are in the order of the oprs, so an output containing slices
+    // is never placed in another output later
+    for (auto&& i : m_slice_fwd_mem_plans) {
+        auto from = std::get<0>(i), to = std::get<2>(i);
+        auto var = to->owner_var();
+        if (!should_static_alloc_var(var) ||
+            !should_static_alloc_var(from->owner_var()) ||
+            to->chunk().owner_var != var || to->next_readonly_fwd_reader() ||
+            m_slice_fwd_chunks.count(&to->chunk()) || m_slice_fwd_vars.count(var) ||
+            writable_fwd_dest.count(to) ||
+            from->chunk().owner_var != from->owner_var() ||
+            writable_fwd_dest.count(from))
+            continue;
+        to->assign_for_forward(*from, std::get<1>(i));
+        m_slice_fwd_vars.insert(var);
+        m_slice_fwd_chunks.insert(&from->chunk());
+    }
+}
+
 bool SeqMemOptimizer::should_static_alloc_var(VarNode* var) {
     if (!m_cur_static_alloc_var->count(var)) {
         return false;
@@ -191,12 +267,14 @@ bool SeqMemOptimizer::run_static_mem_alloc() {
                     dest.begin = idx;
                     dest.chunk = cur_chk;
                     dest.comp_node = i->comp_node();
-                    mgb_assert(cur_chk->owner_var == i);
+                    // a chunk containing slices starts at its first slice
+                    mgb_assert(cur_chk->owner_var == i || m_slice_fwd_vars.count(i));
                 } else {
-                    // forwarded from another var
+                    // forwarded from another var, or the owner of slices
                     mgb_assert(
                             i->comp_node() == dest.comp_node &&
-                            cur_chk->owner_var != i);
+                            (cur_chk->owner_var != i ||
+                             m_slice_fwd_chunks.count(cur_chk)));
                 }
 
                 if (i->contain_flag(VarNode::Flag::NO_MEM_RECLAIM)) {
@@ -288,7 +366,7 @@ bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
         StaticMemAllocLogger& static_mem_alloc_logger) {
     size_t size_ub = 0;
 
-    auto allocator = StaticMemAlloc::make(StaticMemAlloc::AllocatorAlgo::PUSHDOWN);
+    auto allocator = StaticMemAlloc::make(static_mem_alloc_algo());
     allocator->alignment(comp_node.get_mem_addr_alignment());
     allocator->padding(comp_node.get_mem_padding());
 #if MGB_ENABLE_DEBUG_UTIL
@@ -304,6 +382,7 @@ bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
         size_ub += chk.chunk->size();
     }
 
+    OverwriteSpec overwrite_spec;
     for (auto&& i : m_writable_fwd_mem_plans) {
         auto from_iter = chunk2allocatorid.find(&i.first->chunk()),
              to_iter = chunk2allocatorid.find(&i.second->chunk());
@@ -311,7 +390,7 @@ bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
         // ignore mem fwd specs that involve other chunks
         if (from_iter != chunk2allocatorid.end() &&
             to_iter != chunk2allocatorid.end()) {
-            allocator->add_overwrite_spec(
+            overwrite_spec.emplace_back(
                     to_iter->second, from_iter->second,
                     i.first->offset_in_chunk_byte());
         }
@@ -321,8 +400,27 @@ bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
         chunk2allocatorid.swap(v);
     }
 
-    allocator->solve();
-    size_t size = allocator->tot_alloc(), size_lb = allocator->tot_alloc_lower_bound();
+    size_t size, size_lb;
+    std::vector<size_t> addrs;
+    if (m_graph->options().seq_opt.enable_incremental_mem_plan &&
+        incremental_static_mem_alloc(comp_node, chunks, overwrite_spec, addrs, size)) {
+        size_lb = size;
+    } else {
+        for (auto&& i : overwrite_spec) {
+            allocator->add_overwrite_spec(
+                    std::get<0>(i), std::get<1>(i), std::get<2>(i));
+        }
+        allocator->solve();
+        size = allocator->tot_alloc();
+        size_lb = allocator->tot_alloc_lower_bound();
+        addrs.reserve(chunks.size());
+        for (auto&& chk : chunks) {
+            addrs.push_back(allocator->get_start_addr(&chk));
+        }
+        if (m_graph->options().seq_opt.enable_incremental_mem_plan) {
+            update_static_plan_cache(comp_node, chunks, overwrite_spec, addrs, size);
+        }
+    }
 
     static_mem_alloc_logger.push(comp_node, size, size_lb, size_ub);
 
@@ -332,9 +430,8 @@ bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
 
     if (!should_realloc) {
         m_static_mem_usage.val()[comp_node] = size;
-        for (auto&& chk : chunks) {
-            chk.chunk->mem_alloc_status.set_static_offset(
-                    allocator->get_start_addr(&chk));
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunks[i].chunk->mem_alloc_status.set_static_offset(addrs[i]);
         }
 #ifndef __IN_TEE_ENV__
         auto& recorder = StaticMemRecorder::Instance();
@@ -351,6 +448,141 @@ bool SeqMemOptimizer::run_static_mem_alloc_on_comp_node(
     return should_realloc;
 }
 
+void SeqMemOptimizer::update_static_plan_cache(
+        CompNode cn, const std::vector<MemChunkLifeInterval>& chunks,
+        const OverwriteSpec& overwrite_spec, const std::vector<size_t>& addrs,
+        size_t tot_alloc) {
+    auto&& cache = m_static_plan_cache[cn];
+    auto padding = cn.get_mem_padding();
+    cache.chunks.clear();
+    std::vector<bool> is_overwrite_src(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto&& chk = chunks[i];
+        cache.chunks[chk.chunk->owner_var] = {
+                chk.begin, chk.end, chk.chunk->size() + padding, addrs[i]};
+    }
+    cache.overwrite_spec.clear();
+    for (auto&& i : overwrite_spec) {
+        is_overwrite_src[std::get<0>(i)] = true;
+        cache.overwrite_spec.emplace_back(
+                chunks[std::get<0>(i)].chunk->owner_var,
+                chunks[std::get<1>(i)].chunk->owner_var, std::get<2>(i));
+    }
+    auto lb = static_mem_lower_bound(chunks, is_overwrite_src, [&](size_t i) {
+        return chunks[i].chunk->size() + padding;
+    });
+    cache.full_plan_frag = lb ? static_cast<double>(tot_alloc) / lb : 1;
+}
+
+bool SeqMemOptimizer::incremental_static_mem_alloc(
+        CompNode cn, const std::vector<MemChunkLifeInterval>& chunks,
+        const OverwriteSpec& overwrite_spec, std::vector<size_t>& addrs,
+        size_t& tot_alloc) {
+    auto cache_iter = m_static_plan_cache.find(cn);
+    if (cache_iter == m_static_plan_cache.end()) {
+        return false;
+    }
+    auto&& cache = cache_iter->second;
+    if (cache.chunks.size() != chunks.size() ||
+        cache.overwrite_spec.size() != overwrite_spec.size()) {
+        return false;
+    }
+
+    // the chunks and their lifetime must be unchanged
+    std::vector<StaticMemPlanCache::Chunk> plan;
+    plan.reserve(chunks.size());
+    for (auto&& chk : chunks) {
+        auto iter = cache.chunks.find(chk.chunk->owner_var);
+        if (iter == cache.chunks.end() || iter->second.begin != chk.begin ||
+            iter->second.end != chk.end) {
+            return false;
+        }
+        plan.push_back(iter->second);
+    }
+
+    std::vector<bool> is_overwrite_src(chunks.size()), in_overwrite(chunks.size());
+    for (size_t i = 0; i < overwrite_spec.size(); ++i) {
+        size_t src, dest, offset;
+        std::tie(src, dest, offset) = overwrite_spec[i];
+        if (std::make_tuple(
+                    chunks[src].chunk->owner_var, chunks[dest].chunk->owner_var,
+                    offset) != cache.overwrite_spec[i]) {
+            return false;
+        }
+        is_overwrite_src[src] = true;
+        in_overwrite[src] = in_overwrite[dest] = true;
+    }
+
+    // chunks that do not fit in their previous place
+    auto padding = cn.get_mem_padding();
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto size = chunks[i].chunk->size() + padding;
+        if (size > plan[i].size) {
+            if (in_overwrite[i]) {
+                // overwrite relations are resolved by the allocator
+                return false;
+            }
+            plan[i].size = size;
+            changed.push_back(i);
+        }
+    }
+
+    // place the changed chunks from large to small at the lowest address
+    // that does not conflict with the placed chunks alive at the same time
+    std::vector<bool> placed(chunks.size(), true);
+    for (auto i : changed) {
+        placed[i] = false;
+    }
+    std::sort(changed.begin(), changed.end(), [&](size_t a, size_t b) {
+        return plan[a].size > plan[b].size;
+    });
+    auto alignment = cn.get_mem_addr_alignment();
+    std::vector<size_t> conflict;
+    for (auto i : changed) {
+        auto&& cur = plan[i];
+        conflict.clear();
+        for (size_t j = 0; j < chunks.size(); ++j) {
+            if (placed[j] && plan[j].begin < cur.end && cur.begin < plan[j].end) {
+                conflict.push_back(j);
+            }
+        }
+        std::sort(conflict.begin(), conflict.end(), [&](size_t a, size_t b) {
+            return plan[a].addr < plan[b].addr;
+        });
+        size_t addr = 0;
+        for (auto j : conflict) {
+            if (addr + cur.size <= plan[j].addr) {
+                break;
+            }
+            addr = std::max(
+                    addr, get_aligned_power2(plan[j].addr + plan[j].size, alignment));
+        }
+        cur.addr = addr;
+        placed[i] = true;
+    }
+
+    size_t tot = 0;
+    for (auto&& i : plan) {
+        tot = std::max(tot, i.addr + i.size);
+    }
+    auto lb = static_mem_lower_bound(chunks, is_overwrite_src, [&](size_t i) {
+        return chunks[i].chunk->size() + padding;
+    });
+    auto threshold = m_graph->options().seq_opt.incremental_mem_plan_frag_threshold;
+    if (tot > lb * cache.full_plan_frag * (1 + threshold)) {
+        return false;
+    }
+
+    addrs.resize(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        addrs[i] = plan[i].addr;
+        cache.chunks[chunks[i].chunk->owner_var] = plan[i];
+    }
+    tot_alloc = tot;
+    return true;
+}
+
 void SeqMemOptimizer::reset_opr_seq(
         const OprNodeArray* seq, const OprNodeArray* seq_sys_alloc,
         const VarNodeSet* static_alloc_var, SmallVector<CompNode> all_comp_nodes) {
@@ -360,6 +592,13 @@ void SeqMemOptimizer::reset_opr_seq(
     m_cur_static_alloc_var = static_alloc_var;
     m_all_comp_nodes = std::move(all_comp_nodes);
     m_static_mem_usage.invalidate();
+    m_static_plan_cache.clear();
+}
+
+void SeqMemOptimizer::add_slice_fwd_mem_plan(
+        MemAllocPlan* from, const SubTensorSpec& sub, MemAllocPlan* to) {
+    mgb_assert(from != to);
+    m_slice_fwd_mem_plans.emplace_back(from, sub, to);
 }
 
 void SeqMemOptimizer::add_writable_fwd_mem_plan_pair(
@@ -24,6 +24,26 @@ class SeqMemOptimizer {
 
     using CompNode2Chunkset = CompNode::UnorderedMap<ThinHashSet<MemAllocPlan::Chunk*>>;
 
+    //! tuple of (src chunk index, dest chunk index, offset) for overwrite
+    using OverwriteSpec = std::vector<std::tuple<size_t, size_t, size_t>>;
+
+    /*!
+     * \brief static memory plan of the last run on a comp node, used to
+     *      update the plan incrementally
+     */
+    struct StaticMemPlanCache {
+        struct Chunk {
+            //! size is the reserved size including padding
+            size_t begin, end, size, addr;
+        };
+        //! keyed by the owner var of the chunk
+        ThinHashMap<VarNode*, Chunk> chunks;
+        //! (src owner var, dest owner var, offset) of the overwrite specs
+        std::vector<std::tuple<VarNode*, VarNode*, size_t>> overwrite_spec;
+        //! ratio of peak memory to its lower bound of the last full plan
+        double full_plan_frag = 1;
+    };
+
     ComputingGraphImpl* m_graph;
     const OprNodeArray* m_cur_seq_full;
     const OprNodeArray* m_cur_seq_sys_alloc;
@@ -34,9 +54,26 @@ class SeqMemOptimizer {
 
     size_t m_status = 0;
     std::vector<std::pair<MemAllocPlan*, MemAllocPlan*>> m_writable_fwd_mem_plans;
+    //! (output plan, slice of output, input plan) of the slice forward requests
+    std::vector<std::tuple<MemAllocPlan*, SubTensorSpec, MemAllocPlan*>>
+            m_slice_fwd_mem_plans;
+    //! vars placed in slices of other chunks and the chunks containing them
+    ThinHashSet<VarNode*> m_slice_fwd_vars;
+    ThinHashSet<MemAllocPlan::Chunk*> m_slice_fwd_chunks;
+    CompNode::UnorderedMap<StaticMemPlanCache> m_static_plan_cache;
 
     bool should_static_alloc_var(VarNode* var);
 
+    /*!
+     * \brief assign the inputs of the slice forward requests as views of
+     *      the outputs
+     *
+     * An input is only placed in the output if it owns its chunk alone and
+     * is not a dest of writable forwarding, and the output chunk is not
+     * placed in another chunk.
+     */
+    void apply_slice_fwd();
+
     bool in_sys_alloc(OperatorNodeBase* opr) const {
         return m_cur_seq_sys_alloc_set.count(opr);
     }
@@ -49,6 +86,26 @@ class SeqMemOptimizer {
             CompNode cn, const std::vector<MemChunkLifeInterval>& chunks,
             StaticMemAllocLogger& static_mem_alloc_logger);
 
+    /*!
+     * \brief update the cached plan of the comp node to the new chunks by
+     *      only re-placing the chunks that grow; the cache is updated on
+     *      success
+     *
+     * \param[out] addrs address of each chunk
+     * \param[out] tot_alloc peak memory usage of the plan
+     * \return false if a full plan is needed
+     */
+    bool incremental_static_mem_alloc(
+            CompNode cn, const std::vector<MemChunkLifeInterval>& chunks,
+            const OverwriteSpec& overwrite_spec, std::vector<size_t>& addrs,
+            size_t& tot_alloc);
+
+    //! record the full plan of the comp node for incremental update
+    void update_static_plan_cache(
+            CompNode cn, const std::vector<MemChunkLifeInterval>& chunks,
+            const OverwriteSpec& overwrite_spec, const std::vector<size_t>& addrs,
+            size_t tot_alloc);
+
 public:
     SeqMemOptimizer(ComputingGraphImpl* graph) : m_graph(graph) {}
 
@@ -73,6 +130,13 @@ public:
      */
     void add_writable_fwd_mem_plan_pair(MemAllocPlan* from, MemAllocPlan* to);
 
+    /*!
+     * \brief add a request that the memory of \p to should be the slice \p sub
+     *      of \p from; used to implement VarNode::set_fwd_out2in_slice
+     */
+    void add_slice_fwd_mem_plan(
+            MemAllocPlan* from, const SubTensorSpec& sub, MemAllocPlan* to);
+
     /*!
      * \brief optimize mem_plan for var nodes by performing
      *      readonly/writable forwarding
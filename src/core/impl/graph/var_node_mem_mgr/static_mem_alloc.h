@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 
 namespace mgb {
 namespace cg {
@@ -29,10 +30,20 @@ public:
 
         //! O(n log n) allocator with better performance
         PUSHDOWN,
+
+        //! O(n^2) allocator that places large intervals first into the best
+        //! fitting gap of conflicting ones; usually closest to lower bound
+        GREEDY_BY_SIZE,
     };
 
     static std::unique_ptr<StaticMemAlloc> make(AllocatorAlgo algo);
 
+    /*!
+     * \brief get allocator algo by its name, e.g. "PUSHDOWN"
+     * \return whether the name is valid
+     */
+    static bool algo_from_name(const std::string& name, AllocatorAlgo& algo);
+
     virtual ~StaticMemAlloc() = default;
 
     /*!
@@ -0,0 +1,166 @@
+#include "./greedy_by_size.h"
+#include "./pushdown.h"
+
+#if !MGB_BUILD_SLIM_SERVING
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace mgb;
+using namespace cg;
+
+void StaticMemAllocGreedyBySize::do_solve() {
+    // extend overwritten intervals and align sizes, so only overwrite roots
+    // need to be placed
+    IntervalPtrArray roots;
+    for (auto i : m_interval) {
+        if (i->is_overwrite_root()) {
+            i->size = align(i->size);
+            roots.push_back(i);
+        } else {
+            update_max(i->overwrite_dest_root()->time_end, i->time_end);
+        }
+    }
+
+    using Cmp = bool (*)(const Interval*, const Interval*);
+    // ties are broken by id for a deterministic result
+    Cmp orders[] = {
+            [](const Interval* a, const Interval* b) {
+                return a->size > b->size || (a->size == b->size && a->id < b->id);
+            },
+            [](const Interval* a, const Interval* b) {
+                auto t0 = a->time_length(), t1 = b->time_length();
+                return t0 > t1 || (t0 == t1 && (a->size > b->size ||
+                                                (a->size == b->size && a->id < b->id)));
+            },
+            [](const Interval* a, const Interval* b) {
+                auto s0 = a->size * a->time_length(), s1 = b->size * b->time_length();
+                return s0 > s1 || (s0 == s1 && a->id < b->id);
+            },
+    };
+
+    m_peak = 0;
+    std::vector<size_t> best_addr(roots.size());
+    auto save_best = [&](size_t peak) {
+        if (peak < m_peak) {
+            m_peak = peak;
+            for (size_t i = 0; i < roots.size(); ++i) {
+                best_addr[i] = roots[i]->addr_begin;
+            }
+            return true;
+        }
+        return false;
+    };
+    if (roots.empty()) {
+        return;
+    }
+
+    // only the size order is tried for large graphs to bound the solve time
+    constexpr size_t MAX_NR_MULTI_ORDER = 4096;
+    size_t nr_order = roots.size() > MAX_NR_MULTI_ORDER ? 1 : sizeof(orders) / sizeof(orders[0]);
+    m_peak = std::numeric_limits<size_t>::max();
+    IntervalPtrArray order, best_order;
+    for (size_t i = 0; i < nr_order; ++i) {
+        order = roots;
+        std::sort(order.begin(), order.end(), orders[i]);
+        if (save_best(place(order))) {
+            best_order = order;
+        }
+    }
+
+    // local search on the placement order: move a random interval earlier,
+    // and keep the new order if peak does not increase; the number of steps
+    // is bounded by MAX_SEARCH_STEP and total cost of about MAX_SEARCH_COST
+    // interval pairs
+    constexpr size_t MAX_SEARCH_STEP = 1024, MAX_SEARCH_COST = 16 << 20;
+    size_t nr_step = std::min<size_t>(
+            MAX_SEARCH_STEP, MAX_SEARCH_COST / (roots.size() * roots.size()));
+    std::mt19937 rng(roots.size());
+    size_t best_order_peak = m_peak;
+    for (size_t step = 0; step < nr_step && roots.size() > 1; ++step) {
+        order = best_order;
+        size_t j = rng() % (order.size() - 1) + 1, i = rng() % j;
+        std::rotate(order.begin() + i, order.begin() + j, order.begin() + j + 1);
+        auto peak = place(order);
+        if (peak <= best_order_peak) {
+            best_order_peak = peak;
+            best_order.swap(order);
+            save_best(peak);
+        }
+    }
+
+    save_best(solve_pushdown(roots));
+
+    for (size_t i = 0; i < roots.size(); ++i) {
+        roots[i]->addr_begin = best_addr[i];
+    }
+
+    for (auto i : m_interval) {
+        if (!i->is_overwrite_root()) {
+            i->addr_begin = i->overwrite_dest_root()->addr_begin +
+                            i->offset_in_overwrite_dest_root();
+        }
+    }
+}
+
+size_t StaticMemAllocGreedyBySize::solve_pushdown(const IntervalPtrArray& roots) {
+    // intervals have been padded, and overwrite specs are the ones accepted
+    // by init_overwrite_dest()
+    StaticMemAllocPushdown pushdown;
+    pushdown.alignment(alignment());
+    for (auto i : m_interval) {
+        pushdown.add(i->time_begin_orig, i->time_end_orig, i->size_orig, i);
+    }
+    for (auto i : m_interval) {
+        if (auto dest = i->overwrite_dest()) {
+            pushdown.add_overwrite_spec(i->id, dest->id, i->offset_in_overwrite_dest());
+        }
+    }
+    pushdown.solve();
+    for (auto i : roots) {
+        i->addr_begin = pushdown.get_start_addr(i);
+    }
+    return pushdown.tot_alloc();
+}
+
+size_t StaticMemAllocGreedyBySize::place(const IntervalPtrArray& order) {
+    size_t peak = 0;
+    // placed intervals sorted by address, so the conflicting ones are
+    // visited in address order
+    IntervalPtrArray placed;
+    placed.reserve(order.size());
+    for (auto cur : order) {
+        size_t prev_end = 0, best_addr = INVALID,
+               best_space = std::numeric_limits<size_t>::max();
+        for (auto i : placed) {
+            if (!i->time_overlap(*cur))
+                continue;
+            if (i->addr_begin > prev_end) {
+                auto space = i->addr_begin - prev_end;
+                if (space >= cur->size && space < best_space) {
+                    best_space = space;
+                    best_addr = prev_end;
+                }
+            }
+            update_max(prev_end, i->addr_end());
+        }
+        if (best_addr == INVALID) {
+            best_addr = prev_end;
+        }
+        cur->addr_begin = best_addr;
+        update_max(peak, cur->addr_end());
+
+        auto pos = std::upper_bound(
+                placed.begin(), placed.end(), cur,
+                [](const Interval* a, const Interval* b) {
+                    return a->addr_begin < b->addr_begin;
+                });
+        placed.insert(pos, cur);
+    }
+    return peak;
+}
+
+#endif  // !MGB_BUILD_SLIM_SERVING
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
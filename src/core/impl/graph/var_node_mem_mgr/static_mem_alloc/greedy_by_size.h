@@ -0,0 +1,39 @@
+#pragma once
+
+#include "./impl.h"
+
+namespace mgb {
+namespace cg {
+
+/*!
+ * \brief allocator that places large intervals first, each into the best
+ *      fitting gap among the placed intervals that it conflicts with in the
+ *      interval graph
+ *
+ * Several placement orders are tried, and for small graphs the order is
+ * further refined by a local search with bounded number of steps. The plan of
+ * the pushdown allocator is kept if it is better, so the result is never worse
+ * than PUSHDOWN.
+ */
+class StaticMemAllocGreedyBySize final : public StaticMemAllocImplHelper {
+    size_t m_peak = 0;
+
+    /*!
+     * \brief place the intervals in given order and write addr_begin
+     * \return peak memory usage
+     */
+    size_t place(const IntervalPtrArray& order);
+
+    //! solve by pushdown allocator, return peak and write addr_begin
+    size_t solve_pushdown(const IntervalPtrArray& roots);
+
+public:
+    void do_solve() override;
+
+    size_t tot_alloc() const override { return m_peak; }
+};
+
+}  // namespace cg
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
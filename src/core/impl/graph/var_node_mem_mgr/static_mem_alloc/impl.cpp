@@ -1,5 +1,6 @@
 #include "./impl.h"
 #include "./best_fit.h"
+#include "./greedy_by_size.h"
 #include "./interval_move.h"
 #include "./pushdown.h"
 
@@ -374,6 +375,8 @@ std::unique_ptr<StaticMemAlloc> StaticMemAlloc::make(AllocatorAlgo algo) {
             return std::make_unique<StaticMemAllocIntervalMove>();
         case AllocatorAlgo::BEST_FIT:
             return std::make_unique<StaticMemAllocBestFit>();
+        case AllocatorAlgo::GREEDY_BY_SIZE:
+            return std::make_unique<StaticMemAllocGreedyBySize>();
 #endif
         case AllocatorAlgo::PUSHDOWN:
             return std::make_unique<StaticMemAllocPushdown>();
@@ -382,4 +385,15 @@ std::unique_ptr<StaticMemAlloc> StaticMemAlloc::make(AllocatorAlgo algo) {
     }
 }
 
+bool StaticMemAlloc::algo_from_name(const std::string& name, AllocatorAlgo& algo) {
+#define cb(_algo)                      \
+    if (name == #_algo) {              \
+        algo = AllocatorAlgo::_algo;   \
+        return true;                   \
+    }
+    cb(INTERVAL_MOVE) cb(BEST_FIT) cb(PUSHDOWN) cb(GREEDY_BY_SIZE)
+#undef cb
+    return false;
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -57,6 +57,8 @@ protected:
      */
     size_t align(size_t addr) { return get_aligned_power2(addr, m_alignment); }
 
+    size_t alignment() const { return m_alignment; }
+
 private:
     size_t m_alignment = 1, m_padding = 0, m_peak_lower_bound = 0;
 
@@ -126,6 +126,83 @@ std::pair<size_t, size_t> sys::get_ram_status_bytes() {
 }
 #endif  // WIN32
 
+#if defined(__linux__) && !defined(__OHOS__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <fstream>
+
+std::vector<int> sys::get_numa_node_cpus(int node) {
+    std::vector<int> ret;
+    if (node < 0) {
+        return ret;
+    }
+    std::ifstream fin{ssprintf("/sys/devices/system/node/node%d/cpulist", node)};
+    std::string cpulist;
+    if (!(fin >> cpulist)) {
+        return ret;
+    }
+    //! the format is like 0-15,32-47
+    const char* ptr = cpulist.c_str();
+    while (*ptr) {
+        char* end;
+        int begin_id = strtol(ptr, &end, 10), end_id = begin_id;
+        if (*end == '-') {
+            end_id = strtol(end + 1, &end, 10);
+        }
+        for (int i = begin_id; i <= end_id; ++i) {
+            ret.push_back(i);
+        }
+        ptr = *end == ',' ? end + 1 : end;
+        if (ptr == end && *end) {
+            mgb_log_warn(
+                    "failed to parse cpulist of numa node %d: %s", node,
+                    cpulist.c_str());
+            ret.clear();
+            break;
+        }
+    }
+    return ret;
+}
+
+bool sys::bind_memory_to_numa_node(void* ptr, size_t size, int node) {
+#ifdef SYS_mbind
+    constexpr int MPOL_BIND = 2;
+    constexpr size_t MAX_NODE = 64;
+    if (node < 0 || static_cast<size_t>(node) >= MAX_NODE) {
+        return false;
+    }
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(ptr), end = begin + size;
+    begin = (begin + page_size - 1) / page_size * page_size;
+    end = end / page_size * page_size;
+    if (begin >= end) {
+        return true;
+    }
+    unsigned long nodemask = 1ul << node;
+    auto err = syscall(
+            SYS_mbind, reinterpret_cast<void*>(begin), end - begin, MPOL_BIND,
+            &nodemask, MAX_NODE + 1, 0);
+    if (err) {
+        mgb_log_warn(
+                "failed to mbind memory to numa node %d: %s (error ignored)", node,
+                strerror(errno));
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+#else
+std::vector<int> sys::get_numa_node_cpus(int) {
+    return {};
+}
+
+bool sys::bind_memory_to_numa_node(void*, size_t, int) {
+    return false;
+}
+#endif
+
 #if !MGB_BUILD_SLIM_SERVING && defined(__linux)
 #include <unistd.h>
 bool sys::stderr_ansi_color() {
@@ -0,0 +1,50 @@
+#include "megbrain/utils/arena_allocator.h"
+#include "megbrain/common.h"
+#include "megbrain/utils/thread_local.h"
+
+#include <algorithm>
+
+using namespace mgb;
+
+namespace {
+MGB_THREAD_LOCAL_PTR(ArenaAllocator) tl_cur_arena = nullptr;
+}  // anonymous namespace
+
+ArenaAllocator::ArenaAllocator() noexcept = default;
+ArenaAllocator::~ArenaAllocator() noexcept = default;
+
+void* ArenaAllocator::alloc(size_t size, size_t alignment) {
+    constexpr size_t MIN_BUF_SIZE = 4 * 1024, MAX_BUF_SIZE = 256 * 1024;
+    mgb_assert(
+            !(alignment & (alignment - 1)) && alignment <= alignof(std::max_align_t),
+            "bad arena alignment: %zu", alignment);
+    auto pos = (m_cur_buf_pos + alignment - 1) & ~(alignment - 1);
+    if (m_buf.empty() || pos + size > m_cur_buf_size) {
+        // grow geometrically so the number of buffers stays small; large
+        // requests get their own buffer
+        auto buf_size =
+                std::min(std::max(m_cur_buf_size * 2, MIN_BUF_SIZE), MAX_BUF_SIZE);
+        buf_size = std::max(buf_size, size);
+        m_buf.emplace_back(new uint8_t[buf_size]);
+        m_cur_buf_size = buf_size;
+        pos = 0;
+    }
+    auto ptr = m_buf.back().get() + pos;
+    m_cur_buf_pos = pos + size;
+    m_nr_alloc_bytes += size;
+    return ptr;
+}
+
+ArenaAllocator* ArenaAllocator::current() {
+    return tl_cur_arena;
+}
+
+ArenaAllocator::Scope::Scope(ArenaAllocator* arena) : m_prev{tl_cur_arena} {
+    tl_cur_arena = arena;
+}
+
+ArenaAllocator::Scope::~Scope() {
+    tl_cur_arena = m_prev;
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
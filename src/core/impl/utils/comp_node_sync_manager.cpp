@@ -22,7 +22,7 @@ CompNodeSyncManager& CompNodeSyncManager::add_waiter_record(
         bool need_ready_event, size_t nr_waiter) {
     mgb_assert(!m_have_been_waited && m_comp_node.valid() && nr_waiter);
     if (need_ready_event && !m_ready_event) {
-        m_ready_event = m_comp_node.create_event();
+        m_ready_event = m_comp_node.create_pooled_event();
     }
     m_nr_waiter += nr_waiter;
     return *this;
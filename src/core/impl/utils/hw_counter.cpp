@@ -0,0 +1,100 @@
+#include "megbrain/utils/hw_counter.h"
+#include "megbrain/common.h"
+
+#include <memory>
+
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(__OHOS__)
+#define MGB_HAVE_PERF_EVENT 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define MGB_HAVE_PERF_EVENT 0
+#endif
+
+using namespace mgb;
+
+namespace {
+#if MGB_HAVE_PERF_EVENT
+constexpr uint64_t EVENTS[] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+
+int perf_event_open(uint64_t config, int group_fd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+}  // anonymous namespace
+
+HWCounter* HWCounter::get() {
+    thread_local std::unique_ptr<HWCounter> counter;
+    thread_local bool opened = false;
+    if (!opened) {
+        opened = true;
+        counter.reset(new HWCounter);
+        if (!counter->open()) {
+            counter.reset();
+        }
+    }
+    return counter.get();
+}
+
+bool HWCounter::open() {
+#if MGB_HAVE_PERF_EVENT
+    for (size_t i = 0; i < 4; ++i) {
+        m_fds[i] = perf_event_open(EVENTS[i], m_group_fd);
+        if (m_fds[i] < 0) {
+            if (!i) {
+                mgb_log_warn(
+                        "failed to open perf_event, hardware counters are "
+                        "unavailable; check /proc/sys/kernel/perf_event_paranoid");
+            }
+            return false;
+        }
+        if (!i) {
+            m_group_fd = m_fds[0];
+        }
+    }
+    ioctl(m_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+}
+
+HWCounter::Value HWCounter::read() const {
+    Value ret;
+#if MGB_HAVE_PERF_EVENT
+    // nr, then the values in the order of opening
+    uint64_t buf[5];
+    if (::read(m_group_fd, buf, sizeof(buf)) == sizeof(buf)) {
+        ret.cycles = buf[1];
+        ret.instructions = buf[2];
+        ret.cache_references = buf[3];
+        ret.cache_misses = buf[4];
+    }
+#endif
+    return ret;
+}
+
+HWCounter::~HWCounter() {
+#if MGB_HAVE_PERF_EVENT
+    for (int fd : m_fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
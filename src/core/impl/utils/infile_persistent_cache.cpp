@@ -1,5 +1,8 @@
 #include "megbrain/utils/infile_persistent_cache.h"
 
+#include <algorithm>
+#include <mutex>
+
 #if defined(_WIN32)
 #include <io.h>
 #define F_OK         0
@@ -133,15 +136,12 @@ template <typename Input>
 void InFilePersistentCache::read_cache(Input& inp) {
     uint32_t nr_category;
     inp.read(nr_category);
-    char category_buf[256];
     for (uint32_t i = 0; i < nr_category; i++) {
         uint32_t category_size;
         inp.read(category_size);
-        inp.read(category_buf, category_size);
-        category_buf[category_size] = '\0';
-
-        std::string category(category_buf);
-        mgb_log_debug("load new category: %s", category_buf);
+        std::string category(category_size, '\0');
+        inp.read(&category[0], category_size);
+        mgb_log_debug("load new category: %s", category.c_str());
 
         // read bobs
         uint32_t nr_bobs;
@@ -276,4 +276,106 @@ void InFilePersistentCache::put(
     }
 }
 
+size_t InFilePersistentCache::merge(
+        const InFilePersistentCache& other, bool overwrite) {
+    mgb_assert(&other != this);
+    size_t nr_changed = 0;
+#if !__DEPLOY_ON_XP_SP2__
+    //! a.merge(b) may run along with b.merge(a), so take both locks at once
+    auto&& other_mtx = const_cast<InFilePersistentCache&>(other).m_mtx;
+    std::lock(m_mtx, other_mtx);
+    std::lock_guard<MGB_MUTEX> lock_self{m_mtx, std::adopt_lock},
+            lock_other{other_mtx, std::adopt_lock};
+#endif
+    for (auto&& category : other.m_cache) {
+        auto&& dst = m_cache[category.first];
+        for (auto&& item : category.second) {
+            auto iter = dst.find(item.first);
+            if (iter != dst.end()) {
+                if (!overwrite || iter->second == item.second)
+                    continue;
+                iter->second.init_data_ref(item.second);
+            } else {
+                BlobStorage key_storage;
+                key_storage.init_data_ref(item.first).init_hash();
+                dst[std::move(key_storage)].init_data_ref(item.second);
+            }
+            ++nr_changed;
+        }
+    }
+    if (nr_changed && m_always_open_file) {
+        m_always_open_file->set_head();
+        dump_cache(m_always_open_file.get());
+        m_always_open_file->flush();
+    }
+    return nr_changed;
+}
+
+std::vector<InFilePersistentCache::CategoryDiff> InFilePersistentCache::diff(
+        const InFilePersistentCache& other) const {
+    auto count_missing = [](const CacheMap::mapped_type& src,
+                            const CacheMap::mapped_type* dst) {
+        size_t ret = 0;
+        for (auto&& item : src) {
+            ret += !dst || !dst->count(item.first);
+        }
+        return ret;
+    };
+    std::vector<CategoryDiff> ret;
+    MGB_LOCK_GUARD(const_cast<InFilePersistentCache*>(this)->m_mtx);
+    MGB_LOCK_GUARD(const_cast<InFilePersistentCache&>(other).m_mtx);
+    for (auto&& category : m_cache) {
+        CategoryDiff cur;
+        cur.category = category.first;
+        auto iter = other.m_cache.find(category.first);
+        auto other_items = iter == other.m_cache.end() ? nullptr : &iter->second;
+        cur.nr_only_self = count_missing(category.second, other_items);
+        if (other_items) {
+            cur.nr_only_other = count_missing(*other_items, &category.second);
+            for (auto&& item : category.second) {
+                auto other_item = other_items->find(item.first);
+                cur.nr_different += other_item != other_items->end() &&
+                                    !(other_item->second == item.second);
+            }
+        }
+        if (cur.nr_only_self || cur.nr_only_other || cur.nr_different)
+            ret.emplace_back(std::move(cur));
+    }
+    for (auto&& category : other.m_cache) {
+        if (!m_cache.count(category.first)) {
+            CategoryDiff cur;
+            cur.category = category.first;
+            cur.nr_only_other = category.second.size();
+            ret.emplace_back(std::move(cur));
+        }
+    }
+    return ret;
+}
+
+size_t InFilePersistentCache::prune(
+        thin_function<bool(const std::string& category)> keep) {
+    size_t nr_removed = 0;
+    MGB_LOCK_GUARD(m_mtx);
+    for (auto iter = m_cache.begin(); iter != m_cache.end();) {
+        if (keep(iter->first)) {
+            ++iter;
+        } else {
+            mgb_log_debug("prune cache category: %s", iter->first.c_str());
+            nr_removed += iter->second.size();
+            iter = m_cache.erase(iter);
+        }
+    }
+    return nr_removed;
+}
+
+std::vector<std::pair<std::string, size_t>> InFilePersistentCache::summary() const {
+    std::vector<std::pair<std::string, size_t>> ret;
+    MGB_LOCK_GUARD(const_cast<InFilePersistentCache*>(this)->m_mtx);
+    for (auto&& category : m_cache) {
+        ret.emplace_back(category.first, category.second.size());
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
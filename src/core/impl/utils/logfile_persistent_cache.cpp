@@ -0,0 +1,309 @@
+#include "megbrain/utils/logfile_persistent_cache.h"
+#include "megbrain/utils/infile_persistent_cache.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#elif __linux__ || __unix__ || __APPLE__
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace mgb;
+
+namespace {
+constexpr char MAGIC[8] = {'M', 'G', 'B', 'C', 'L', 'O', 'G', '1'};
+}  // anonymous namespace
+
+//////////////////////// LogFilePersistentCache::LogFile ///////////////
+
+/*!
+ * A file opened for reading and appending, with an advisory lock shared by
+ * all the processes. The lock is taken on the open file description, so that
+ * two caches opened on the same file in one process also exclude each other;
+ * the threads of one cache are serialized by its m_mtx.
+ */
+class LogFilePersistentCache::LogFile {
+    int m_fd;
+
+public:
+    LogFile(const char* path) {
+#if defined(_WIN32)
+        m_fd = _open(path, _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        m_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+#endif
+        mgb_assert(m_fd >= 0, "failed to open %s: %s", path, strerror(errno));
+    }
+
+    ~LogFile() {
+#if defined(_WIN32)
+        _close(m_fd);
+#else
+        close(m_fd);
+#endif
+    }
+
+    void lock(bool exclusive) {
+#if defined(_WIN32)
+        OVERLAPPED overlapped = {};
+        auto ok = LockFileEx(
+                reinterpret_cast<HANDLE>(_get_osfhandle(m_fd)),
+                exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, MAXDWORD, MAXDWORD,
+                &overlapped);
+        mgb_assert(ok, "failed to lock cache file: %lu", GetLastError());
+#else
+        int ret;
+        do {
+            ret = flock(m_fd, exclusive ? LOCK_EX : LOCK_SH);
+        } while (ret && errno == EINTR);
+        mgb_assert(!ret, "failed to lock cache file: %s", strerror(errno));
+#endif
+    }
+
+    void unlock() {
+#if defined(_WIN32)
+        OVERLAPPED overlapped = {};
+        UnlockFileEx(
+                reinterpret_cast<HANDLE>(_get_osfhandle(m_fd)), 0, MAXDWORD, MAXDWORD,
+                &overlapped);
+#else
+        flock(m_fd, LOCK_UN);
+#endif
+    }
+
+    //! hold the file lock in a scope
+    class LockGuard : public NonCopyableObj {
+        LogFile& m_file;
+
+    public:
+        LockGuard(LogFile& file, bool exclusive) : m_file{file} {
+            m_file.lock(exclusive);
+        }
+        ~LockGuard() { m_file.unlock(); }
+    };
+
+    size_t size() {
+#if defined(_WIN32)
+        auto ret = _filelengthi64(m_fd);
+        mgb_assert(ret >= 0, "failed to get size of cache file");
+        return ret;
+#else
+        struct stat st;
+        mgb_assert(!fstat(m_fd, &st), "failed to stat cache file: %s", strerror(errno));
+        return st.st_size;
+#endif
+    }
+
+    void read(size_t offset, void* buf, size_t size) {
+        auto ptr = static_cast<uint8_t*>(buf);
+#if defined(_WIN32)
+        mgb_assert(_lseeki64(m_fd, offset, SEEK_SET) >= 0);
+#endif
+        while (size) {
+#if defined(_WIN32)
+            auto ret = _read(m_fd, ptr, static_cast<unsigned>(size));
+#else
+            auto ret = pread(m_fd, ptr, size, offset);
+            if (ret < 0 && errno == EINTR)
+                continue;
+#endif
+            mgb_assert(ret > 0, "failed to read cache file: %s", strerror(errno));
+            ptr += ret;
+            offset += ret;
+            size -= ret;
+        }
+    }
+
+    //! write at the end of the file, which must be locked exclusively
+    void append(const void* buf, size_t size) {
+        auto ptr = static_cast<const uint8_t*>(buf);
+#if defined(_WIN32)
+        mgb_assert(_lseeki64(m_fd, 0, SEEK_END) >= 0);
+#else
+        mgb_assert(lseek(m_fd, 0, SEEK_END) >= 0);
+#endif
+        while (size) {
+#if defined(_WIN32)
+            auto ret = _write(m_fd, ptr, static_cast<unsigned>(size));
+#else
+            auto ret = write(m_fd, ptr, size);
+            if (ret < 0 && errno == EINTR)
+                continue;
+#endif
+            mgb_assert(ret > 0, "failed to write cache file: %s", strerror(errno));
+            ptr += ret;
+            size -= ret;
+        }
+    }
+
+    void truncate(size_t size) {
+#if defined(_WIN32)
+        auto ret = _chsize_s(m_fd, size);
+#else
+        auto ret = ftruncate(m_fd, size);
+#endif
+        mgb_assert(!ret, "failed to truncate cache file");
+    }
+};
+
+//////////////////////// LogFilePersistentCache //////////////////////
+
+LogFilePersistentCache::LogFilePersistentCache(const char* path)
+        : m_file{std::make_unique<LogFile>(path)} {
+    LogFile::LockGuard lock{*m_file, true};
+    if (m_file->size() < sizeof(MAGIC)) {
+        // a new file, or one whose magic was not completely written
+        m_file->truncate(0);
+        m_file->append(MAGIC, sizeof(MAGIC));
+    } else {
+        char magic[sizeof(MAGIC)];
+        m_file->read(0, magic, sizeof(magic));
+        mgb_assert(
+                !memcmp(magic, MAGIC, sizeof(MAGIC)), "%s is not a log cache file",
+                path);
+    }
+    m_offset = sizeof(MAGIC);
+    mgb_log_debug("use log file cache: %s", path);
+}
+
+LogFilePersistentCache::~LogFilePersistentCache() = default;
+
+size_t LogFilePersistentCache::read_tail() {
+    size_t file_size = m_file->size();
+    if (file_size <= m_offset)
+        return 0;
+    std::vector<uint8_t> buf(file_size - m_offset);
+    m_file->read(m_offset, buf.data(), buf.size());
+
+    size_t pos = 0, nr_records = 0;
+    auto take = [&](Blob& blob) {
+        uint32_t size;
+        if (pos + sizeof(size) > buf.size())
+            return false;
+        memcpy(&size, buf.data() + pos, sizeof(size));
+        if (pos + sizeof(size) + size > buf.size())
+            return false;
+        blob = {buf.data() + pos + sizeof(size), size};
+        pos += sizeof(size) + size;
+        return true;
+    };
+    for (;;) {
+        size_t begin = pos;
+        Blob category, key, value;
+        if (!take(category) || !take(key) || !take(value)) {
+            // an incomplete record is being written or was left by a crash
+            pos = begin;
+            break;
+        }
+        BlobStorage key_storage;
+        key_storage.init_data_ref(key).init_hash();
+        m_cache[{static_cast<const char*>(category.ptr), category.size}]
+               [std::move(key_storage)]
+                       .init_data_ref(value);
+        ++nr_records;
+    }
+    m_offset += pos;
+    return nr_records;
+}
+
+size_t LogFilePersistentCache::sync() {
+    MGB_LOCK_GUARD(m_mtx);
+    LogFile::LockGuard lock{*m_file, false};
+    return read_tail();
+}
+
+Maybe<LogFilePersistentCache::Blob> LogFilePersistentCache::get(
+        const std::string& category, const Blob& key) {
+    BlobStorage key_storage;
+    key_storage.Blob::operator=(key);
+    key_storage.init_hash();
+
+    MGB_LOCK_GUARD(m_mtx);
+    auto find = [&]() -> Maybe<Blob> {
+        auto iter0 = m_cache.find(category);
+        if (iter0 == m_cache.end())
+            return None;
+        auto iter1 = iter0->second.find(key_storage);
+        if (iter1 == iter0->second.end())
+            return None;
+        return iter1->second;
+    };
+    auto ret = find();
+    if (ret.valid())
+        return ret;
+
+    // the entry may have been appended by another process
+    {
+        LogFile::LockGuard lock{*m_file, false};
+        if (!read_tail())
+            return None;
+    }
+    return find();
+}
+
+void LogFilePersistentCache::put(
+        const std::string& category, const Blob& key, const Blob& value) {
+    std::vector<uint8_t> record;
+    auto append = [&record](const void* ptr, size_t size) {
+        uint32_t u_size = size;
+        auto u_ptr = static_cast<const uint8_t*>(ptr);
+        record.insert(
+                record.end(), reinterpret_cast<const uint8_t*>(&u_size),
+                reinterpret_cast<const uint8_t*>(&u_size) + sizeof(u_size));
+        record.insert(record.end(), u_ptr, u_ptr + size);
+    };
+    append(category.data(), category.size());
+    append(key.ptr, key.size);
+    append(value.ptr, value.size);
+
+    BlobStorage key_storage;
+    key_storage.init_data_ref(key).init_hash();
+
+    MGB_LOCK_GUARD(m_mtx);
+    LogFile::LockGuard lock{*m_file, true};
+    read_tail();
+    auto&& dst = m_cache[category];
+    auto iter = dst.find(key_storage);
+    if (iter != dst.end() && iter->second.size == value.size &&
+        !memcmp(iter->second.ptr, value.ptr, value.size)) {
+        return;
+    }
+    // no other writer holds the lock, so the bytes after m_offset are an
+    // incomplete record left by a crashed process
+    size_t file_size = m_file->size();
+    if (file_size > m_offset) {
+        mgb_log_warn(
+                "drop %zu bytes of incomplete record in cache file",
+                file_size - m_offset);
+        m_file->truncate(m_offset);
+    }
+    m_file->append(record.data(), record.size());
+    m_offset += record.size();
+    dst[std::move(key_storage)].init_data_ref(value);
+}
+
+std::vector<uint8_t> LogFilePersistentCache::dump_cache() {
+    InFilePersistentCache cache;
+    {
+        MGB_LOCK_GUARD(m_mtx);
+        {
+            LogFile::LockGuard lock{*m_file, false};
+            read_tail();
+        }
+        for (auto&& category : m_cache) {
+            for (auto&& item : category.second) {
+                cache.put(category.first, item.first, item.second);
+            }
+        }
+    }
+    return cache.dump_cache();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
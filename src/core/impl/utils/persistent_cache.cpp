@@ -161,7 +161,20 @@ AlgoChooserProfileCache::AlgoChooserProfileCache(CompNode cn, const char* opr_ty
 
 #define ENTRY_FMT ":%d;%lg;%zu:"
 
+namespace {
+/*!
+ * the blob returned by PersistentCache::get refers to the storage in the cache,
+ * which is freed by a put to the same key; fastrun async profiling puts from a
+ * worker thread, so a lookup holds this lock until the blob has been parsed
+ */
+MGB_MUTEX& profile_cache_mtx() {
+    static MGB_MUTEX mtx;
+    return mtx;
+}
+}  // anonymous namespace
+
 Maybe<AlgoChooserProfileCache::Result> AlgoChooserProfileCache::get(const Key& key) {
+    MGB_LOCK_GUARD(profile_cache_mtx());
     auto raw_buf = PersistentCache::inst().get(m_category, key.build_blob());
     if (!raw_buf.valid())
         return None;
@@ -253,6 +266,7 @@ void AlgoChooserProfileCache::put(const Key& key, Result& result) {
         val.resize(pos + nr);
     }
 
+    MGB_LOCK_GUARD(profile_cache_mtx());
     PersistentCache::inst().put(m_category, key.build_blob(), {val.data(), val.size()});
 }
 
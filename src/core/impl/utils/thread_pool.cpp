@@ -1,17 +1,65 @@
 #include "megbrain/utils/thread_pool.h"
 #include <chrono>
+#include <limits>
+#include <numeric>
 
 using namespace mgb;
 
 #if MGB_HAVE_THREAD
+namespace {
+constexpr uint64_t pack_range(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | end;
+}
+constexpr uint32_t range_begin(uint64_t range) {
+    return static_cast<uint32_t>(range >> 32);
+}
+constexpr uint32_t range_end(uint64_t range) {
+    return static_cast<uint32_t>(range);
+}
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+//! weight of the latest measurement when updating the thread speeds
+constexpr float SPEED_UPDATE_RATE = 0.25f;
+
+int64_t default_spin_budget() {
+    static int64_t spin_us = MGB_GETENV("MGB_THREAD_POOL_SPIN_US")
+                                   ? std::stoll(MGB_GETENV("MGB_THREAD_POOL_SPIN_US"))
+                                   : -1;
+    return spin_us;
+}
+
+ThreadPool::ScheduleMode default_schedule_mode() {
+    static ThreadPool::ScheduleMode mode =
+            MGB_GETENV("MGB_THREAD_POOL_SPEED_WEIGHTED")
+                    ? ThreadPool::ScheduleMode::SPEED_WEIGHTED
+                    : (MGB_GETENV("MGB_THREAD_POOL_WORK_STEALING")
+                               ? ThreadPool::ScheduleMode::WORK_STEALING
+                               : ThreadPool::ScheduleMode::SHARED_COUNTER);
+    return mode;
+}
+}  // anonymous namespace
+
 ThreadPool::ThreadPool(size_t threads_num)
+        : ThreadPool(threads_num, default_schedule_mode()) {}
+
+ThreadPool::ThreadPool(size_t threads_num, ScheduleMode mode)
         : m_nr_threads(threads_num),
           m_main_affinity_flag{false},
           m_stop{false},
-          m_active{false} {
+          m_active{false},
+          m_schedule_mode{mode},
+          m_spin_budget_us{default_spin_budget()} {
     if (threads_num < 1) {
         m_nr_threads = 1;
     }
+    m_steal_ranges.reset(new StealRange[m_nr_threads]);
+    m_thread_stats.reset(new ThreadStat[m_nr_threads]);
+    m_thread_speeds.assign(m_nr_threads, 1.f);
     if (m_nr_threads > 1) {
         if (m_nr_threads > static_cast<uint32_t>(sys::get_cpu_count())) {
             mgb_log_debug(
@@ -22,7 +70,12 @@ ThreadPool::ThreadPool(size_t threads_num)
         for (uint32_t i = 0; i < m_nr_threads - 1; i++) {
             m_workers.push_back(new Worker([this, i]() {
                 while (!m_stop) {
-                    while (m_active) {
+                    if (m_spin_budget_us.load(std::memory_order_relaxed) >= 0) {
+                        hybrid_wait_loop(i);
+                        continue;
+                    }
+                    while (m_active &&
+                           m_spin_budget_us.load(std::memory_order_relaxed) < 0) {
                         if (m_workers[i]->affinity_flag &&
                             m_core_binding_function != nullptr) {
                             m_core_binding_function(i);
@@ -30,17 +83,7 @@ ThreadPool::ThreadPool(size_t threads_num)
                         }
                         //! if the thread should work
                         if (m_workers[i]->work_flag.load(std::memory_order_acquire)) {
-                            int index = -1;
-                            //! Get one task and execute
-                            while ((index = m_task_iter.fetch_sub(
-                                            1, std::memory_order_acq_rel)) &&
-                                   index > 0) {
-                                //! index is decrease, use
-                                //! m_all_task_number - index to get the
-                                //! increase id which will pass to task
-                                m_task(static_cast<size_t>(m_nr_parallelism - index),
-                                       i);
-                            }
+                            run_tasks(i);
                             //! Flag worker is finished
                             m_workers[i]->work_flag.store(
                                     false, std::memory_order_release);
@@ -51,7 +94,9 @@ ThreadPool::ThreadPool(size_t threads_num)
                     {
                         std::unique_lock<std::mutex> lock(m_mutex);
                         if (!m_stop && !m_active) {
-                            m_cv.wait(lock, [this] { return m_stop || m_active; });
+                            m_cv.wait(lock, [this] {
+                                return m_stop || m_active || m_spin_budget_us >= 0;
+                            });
                         }
                     }
                 }
@@ -81,7 +126,15 @@ void ThreadPool::add_task(const TaskElem& task_elem) {
         active();
         //! Set the task number, task iter and task
         m_nr_parallelism = parallelism;
-        m_task_iter.exchange(parallelism, std::memory_order_relaxed);
+        if (m_schedule_mode != ScheduleMode::SHARED_COUNTER) {
+            mgb_assert(
+                    parallelism <= std::numeric_limits<uint32_t>::max(),
+                    "too many sub tasks for work stealing: %zu", parallelism);
+            split_ranges(
+                    parallelism, m_schedule_mode == ScheduleMode::SPEED_WEIGHTED);
+        } else {
+            m_task_iter.exchange(parallelism, std::memory_order_relaxed);
+        }
         m_task = [&task_elem](size_t index, size_t thread_id) {
             task_elem.task(index, thread_id);
         };
@@ -89,17 +142,87 @@ void ThreadPool::add_task(const TaskElem& task_elem) {
         for (uint32_t i = 0; i < m_nr_threads - 1; i++) {
             m_workers[i]->work_flag = true;
         }
-        //! Main thread working
-        int index = -1;
-        while ((index = m_task_iter.fetch_sub(1, std::memory_order_acq_rel)) &&
-               (index > 0)) {
-            m_task(static_cast<size_t>(m_nr_parallelism - index), m_nr_threads - 1);
+        //! wake up the workers sleeping in hybrid wait mode, the flags above
+        //! and m_nr_sleeping are seq_cst so either the worker sees its flag
+        //! before sleeping or we see it sleeping here
+        if (m_nr_sleeping.load() > 0) {
+            m_notify_time_ns.store(now_ns(), std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_all();
         }
+        //! Main thread working
+        run_tasks(m_nr_threads - 1);
         //! make sure all threads done
         sync();
+        //! too few sub tasks per thread give a noisy measurement
+        if (m_schedule_mode == ScheduleMode::SPEED_WEIGHTED &&
+            parallelism >= 2 * m_nr_threads) {
+            update_thread_speeds();
+        }
+    }
+}
+
+void ThreadPool::split_ranges(size_t parallelism, bool weighted) {
+    if (!weighted) {
+        //! split the sub tasks evenly into contiguous ranges
+        size_t chunk = parallelism / m_nr_threads,
+               remain = parallelism % m_nr_threads, begin = 0;
+        for (size_t i = 0; i < m_nr_threads; i++) {
+            size_t end = begin + chunk + (i < remain);
+            m_steal_ranges[i].range.store(
+                    pack_range(begin, end), std::memory_order_relaxed);
+            begin = end;
+        }
+        return;
+    }
+    //! round the cumulative weights so the ranges cover all the sub tasks
+    float total = std::accumulate(
+                  m_thread_speeds.begin(), m_thread_speeds.end(), 0.f),
+          acc = 0;
+    size_t begin = 0;
+    for (size_t i = 0; i < m_nr_threads; i++) {
+        acc += m_thread_speeds[i];
+        size_t end = i + 1 == m_nr_threads
+                           ? parallelism
+                           : static_cast<size_t>(parallelism * acc / total + 0.5f);
+        end = std::min(std::max(end, begin), parallelism);
+        m_steal_ranges[i].range.store(pack_range(begin, end), std::memory_order_relaxed);
+        m_thread_stats[i] = {};
+        begin = end;
+    }
+}
+
+void ThreadPool::update_thread_speeds() {
+    //! the workers have published their stats by releasing work_flag, which
+    //! is acquired by sync()
+    std::vector<float> speeds(m_nr_threads, 0.f);
+    float total = 0;
+    for (size_t i = 0; i < m_nr_threads; i++) {
+        auto&& stat = m_thread_stats[i];
+        if (!stat.nr_executed || stat.busy_ns <= 0) {
+            //! a thread that fetched nothing, e.g. woken up too late, tells
+            //! nothing about its speed
+            return;
+        }
+        speeds[i] = static_cast<float>(stat.nr_executed) / stat.busy_ns;
+        total += speeds[i];
+    }
+    for (size_t i = 0; i < m_nr_threads; i++) {
+        float speed = speeds[i] * m_nr_threads / total;
+        m_thread_speeds[i] += SPEED_UPDATE_RATE * (speed - m_thread_speeds[i]);
     }
 }
 
+std::vector<float> ThreadPool::thread_speeds() const {
+    std::lock_guard<std::mutex> lock(m_mutex_task);
+    return m_thread_speeds;
+}
+
+void ThreadPool::reset_thread_speeds() {
+    std::lock_guard<std::mutex> lock(m_mutex_task);
+    m_thread_speeds.assign(m_nr_threads, 1.f);
+}
+
 void ThreadPool::set_affinity(AffinityCallBack affinity_cb) {
     mgb_assert(affinity_cb, "The affinity callback must not be nullptr");
     std::lock_guard<std::mutex> lock(m_mutex_task);
@@ -110,6 +233,154 @@ void ThreadPool::set_affinity(AffinityCallBack affinity_cb) {
     m_main_affinity_flag = true;
 }
 
+void ThreadPool::set_schedule_mode(ScheduleMode mode) {
+    std::lock_guard<std::mutex> lock(m_mutex_task);
+    m_schedule_mode = mode;
+}
+
+void ThreadPool::set_spin_budget(int64_t spin_us) {
+    std::lock_guard<std::mutex> lock_task(m_mutex_task);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_spin_budget_us = spin_us;
+    m_cv.notify_all();
+}
+
+ThreadPool::WaitStats ThreadPool::wait_stats() const {
+    WaitStats ret;
+    ret.nr_wakeup = m_stat_nr_wakeup.load(std::memory_order_relaxed);
+    ret.wakeup_latency_us = m_stat_wakeup_ns.load(std::memory_order_relaxed) / 1e3;
+    ret.spin_time_us = m_stat_spin_ns.load(std::memory_order_relaxed) / 1e3;
+    return ret;
+}
+
+void ThreadPool::reset_wait_stats() {
+    m_stat_nr_wakeup = 0;
+    m_stat_wakeup_ns = 0;
+    m_stat_spin_ns = 0;
+}
+
+void ThreadPool::hybrid_wait_loop(size_t i) {
+    auto worker = m_workers[i];
+    int64_t spin_start = now_ns();
+    while (!m_stop) {
+        int64_t budget_us = m_spin_budget_us.load(std::memory_order_relaxed);
+        if (budget_us < 0) {
+            return;
+        }
+        if (worker->affinity_flag && m_core_binding_function != nullptr) {
+            m_core_binding_function(i);
+            worker->affinity_flag = false;
+        }
+        if (worker->work_flag.load(std::memory_order_acquire)) {
+            m_stat_spin_ns.fetch_add(now_ns() - spin_start, std::memory_order_relaxed);
+            run_tasks(i);
+            worker->work_flag.store(false, std::memory_order_release);
+            spin_start = now_ns();
+            continue;
+        }
+        int64_t now = now_ns();
+        if (now - spin_start < budget_us * 1000) {
+            std::this_thread::yield();
+            continue;
+        }
+        m_stat_spin_ns.fetch_add(now - spin_start, std::memory_order_relaxed);
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_nr_sleeping.fetch_add(1);
+            m_cv.wait(lock, [this, worker] {
+                return m_stop || worker->work_flag.load() || m_spin_budget_us < 0;
+            });
+            m_nr_sleeping.fetch_sub(1);
+        }
+        spin_start = now_ns();
+        if (worker->work_flag.load(std::memory_order_acquire)) {
+            m_stat_nr_wakeup.fetch_add(1, std::memory_order_relaxed);
+            m_stat_wakeup_ns.fetch_add(
+                    std::max<int64_t>(
+                            spin_start -
+                                    m_notify_time_ns.load(std::memory_order_relaxed),
+                            0),
+                    std::memory_order_relaxed);
+        }
+    }
+}
+
+void ThreadPool::run_tasks(size_t thread_id) {
+    if (m_schedule_mode == ScheduleMode::SPEED_WEIGHTED) {
+        auto&& stat = m_thread_stats[thread_id];
+        int64_t start = now_ns();
+        size_t index;
+        do {
+            while (pop_local_task(thread_id, index)) {
+                m_task(index, thread_id);
+                stat.nr_executed++;
+            }
+        } while (steal_tasks(thread_id));
+        stat.busy_ns = now_ns() - start;
+        return;
+    }
+    if (m_schedule_mode == ScheduleMode::WORK_STEALING) {
+        size_t index;
+        do {
+            while (pop_local_task(thread_id, index)) {
+                m_task(index, thread_id);
+            }
+        } while (steal_tasks(thread_id));
+        return;
+    }
+    int index = -1;
+    //! Get one task and execute
+    while ((index = m_task_iter.fetch_sub(1, std::memory_order_acq_rel)) &&
+           index > 0) {
+        //! index is decrease, use m_all_task_number - index to get the
+        //! increase id which will pass to task
+        m_task(static_cast<size_t>(m_nr_parallelism - index), thread_id);
+    }
+}
+
+bool ThreadPool::pop_local_task(size_t thread_id, size_t& index) {
+    auto& range = m_steal_ranges[thread_id].range;
+    uint64_t cur = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t begin = range_begin(cur), end = range_end(cur);
+        if (begin >= end) {
+            return false;
+        }
+        if (range.compare_exchange_weak(
+                    cur, pack_range(begin + 1, end), std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::steal_tasks(size_t thread_id) {
+    //! a range never becomes non-empty with the same value again during one
+    //! task, because sub task ids are handed out only once, so there is no
+    //! ABA problem on the CAS below
+    for (size_t i = 1; i < m_nr_threads; i++) {
+        auto& victim = m_steal_ranges[(thread_id + i) % m_nr_threads].range;
+        uint64_t cur = victim.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t begin = range_begin(cur), end = range_end(cur);
+            if (begin >= end) {
+                break;
+            }
+            //! the thief takes the upper half, rounded up
+            uint32_t mid = end - (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(
+                        cur, pack_range(begin, mid), std::memory_order_acq_rel,
+                        std::memory_order_acquire)) {
+                m_steal_ranges[thread_id].range.store(
+                        pack_range(mid, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 size_t ThreadPool::nr_threads() const {
     return m_nr_threads;
 }
@@ -126,11 +126,20 @@ public:
             int nr_threads;
         };
 
+        /*!
+         * NUMA node that the worker threads and the memory of a cpu or
+         * multithread comp node are bound to; -1 means no binding
+         */
+        int numa_node = -1;
+
         /*!
          * \brief parse a string identifier
          *
          * currently supported ID format: (gpu|cpu)<n>[:m] where n is the
          * device number, possibly with m as the stream id.
+         *
+         * cpu and multithread comp nodes accept an extra :numa<k> suffix to
+         * bind them to NUMA node k, such as cpu0:numa1 or cpu:numa1
          */
         MGE_WIN_DECLSPEC_FUC static Locator parse(const std::string& id);
 
@@ -161,7 +170,8 @@ public:
         MGE_WIN_DECLSPEC_FUC std::string to_string() const;
 
         bool operator==(const Locator& rhs) const {
-            return type == rhs.type && device == rhs.device && stream == rhs.stream;
+            return type == rhs.type && device == rhs.device && stream == rhs.stream &&
+                   numa_node == rhs.numa_node;
         }
     };
 
@@ -182,7 +192,8 @@ public:
 
     //! predefined special streams
     struct Stream {
-        static constexpr int COPY = -1, REMOTE_SEND = -2, LOOP_SWAP = -3;
+        static constexpr int COPY = -1, REMOTE_SEND = -2, LOOP_SWAP = -3,
+                             ASYNC_PROFILE = -4;
     };
 
     CompNode() = default;
@@ -355,6 +366,22 @@ public:
         return m_impl->create_event(flags);
     }
 
+    struct PooledEventDeleter {
+        MGE_WIN_DECLSPEC_FUC void operator()(Event* event) const;
+    };
+
+    //! an event that is given back to the process-wide pool when released
+    using PooledEvent = std::unique_ptr<Event, PooledEventDeleter>;
+
+    /*!
+     * \brief get an event with given flags from the process-wide event pool
+     *
+     * A new event is created if there is no free one. The pool is shared by
+     * all backends, so graphs recompiled frequently (e.g. on shape change)
+     * do not create and destroy events each time.
+     */
+    MGE_WIN_DECLSPEC_FUC PooledEvent create_pooled_event(size_t flags = 0) const;
+
     //! wait for an event created on another CompNode
     inline void device_wait_event(Event& event) const;
 
@@ -388,6 +415,37 @@ public:
         return m_impl->get_mem_status_bytes();
     }
 
+    //! called under memory pressure with the size of memory that would be
+    //! reserved and the limit exceeded, see set_mem_limit()
+    using MemPressureCallback = thin_function<void(size_t reserved, size_t limit)>;
+
+    /*!
+     * \brief set soft and hard limits in bytes of the memory reserved by the
+     *      allocator of this comp node; 0 means no limit
+     *
+     * Cached free memory is released when the soft limit is crossed, and
+     * allocations beyond the hard limit fail. Comp nodes sharing the same
+     * device allocator share the limits.
+     *
+     * \see mem_alloc::DevMemAlloc::LimitConfig
+     */
+    void set_mem_limit(size_t soft_limit, size_t hard_limit) const {
+        m_impl->set_mem_limit(soft_limit, hard_limit);
+    }
+
+    /*!
+     * \brief register a callback to be called when the memory limits are
+     *      exceeded after releasing cached memory
+     * \return handle to remove the callback
+     */
+    size_t add_mem_pressure_callback(MemPressureCallback cb) const {
+        return m_impl->add_mem_pressure_callback(std::move(cb));
+    }
+
+    void remove_mem_pressure_callback(size_t handle) const {
+        m_impl->remove_mem_pressure_callback(handle);
+    }
+
 #if !MGB_BUILD_SLIM_SERVING
     std::pair<size_t, size_t> get_free_left_and_right(
             size_t begin_ptr, size_t end_ptr) {
@@ -619,6 +677,10 @@ protected:
         virtual MemNode mem_node() = 0;
         virtual std::pair<size_t, size_t> get_mem_status_bytes() = 0;
 
+        virtual void set_mem_limit(size_t soft_limit, size_t hard_limit);
+        virtual size_t add_mem_pressure_callback(MemPressureCallback cb);
+        virtual void remove_mem_pressure_callback(size_t handle);
+
 #if !MGB_BUILD_SLIM_SERVING
         virtual std::pair<size_t, size_t> get_free_left_and_right(size_t x, size_t y) {
             return {x - x, y - y};
@@ -709,6 +771,27 @@ public:
     virtual void stop(const CompNode& comp_node) = 0;
 
     virtual void replay() = 0;
+
+    /*!
+     * \brief whether the stopped recorder can record the sequence again by
+     *      begin_update()
+     *
+     * The computing graph does so when the raw pointers of the tensors used
+     * by the sequence have changed since it was recorded, since the recorded
+     * kernels might take the pointers by value.
+     */
+    virtual bool support_update() const { return false; }
+
+    /*!
+     * \brief start recording again for update after stopped
+     *
+     * The sequence is then executed normally, and stop() updates the
+     * recorded sequence in place.
+     */
+    virtual void begin_update(const CompNode& comp_node) {
+        MGB_MARK_USED_VAR(comp_node);
+        mgb_throw(MegBrainError, "seq recorder does not support update");
+    }
 };
 
 /*!
@@ -774,7 +857,7 @@ public:
  */
 class CompNode::EventPool {
     CompNode m_cn;
-    std::vector<std::unique_ptr<CompNode::Event>> m_allocated;
+    std::vector<PooledEvent> m_allocated;
     std::vector<CompNode::Event*> m_free;
     Spinlock m_lock;
     size_t m_flags;
@@ -807,7 +890,8 @@ template <>
 struct HashTrait<CompNode::Locator> {
     static size_t eval(const CompNode::Locator& val) {
         return static_cast<size_t>(val.device) + (static_cast<size_t>(val.type) << 4) +
-               (static_cast<size_t>(val.stream) << 8);
+               (static_cast<size_t>(val.stream) << 8) +
+               (static_cast<size_t>(val.numa_node + 1) << 24);
     }
 };
 
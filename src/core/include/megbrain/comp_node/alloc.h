@@ -33,6 +33,17 @@ public:
      */
     virtual void get_mem_info(size_t& free, size_t& tot) = 0;
 
+    /*!
+     * \brief whether any two chunks adjacent in address are both valid
+     *      memory that could be used as a whole
+     *
+     * This is true for allocators that map physical memory into a reserved
+     * virtual address range. Free blocks of DevMemAlloc could then be merged
+     * across chunk boundaries, and a chunk could be released once it is
+     * covered by a free block.
+     */
+    virtual bool contiguous_chunks() const { return false; }
+
     virtual ~RawAllocator() = default;
 };
 
@@ -140,6 +151,16 @@ public:
 class StreamMemAlloc : virtual public NonFallibleRawAllocator,
                        virtual public MemAllocBase {
 public:
+    //! statistics of the slab cache, see DevMemAlloc::SlabConfig
+    struct SlabCacheStat {
+        size_t nr_hit = 0, nr_miss = 0;
+        //! number and total size of the free blocks held by the cache
+        size_t nr_held_blk = 0, held_size = 0;
+        //! total requested and allocated size of the requests served by the
+        //! cache; the difference is wasted by rounding up to size classes
+        size_t req_size = 0, alloc_size = 0;
+    };
+
     /*!
      * \brief allocate memory
      *
@@ -149,6 +170,9 @@ public:
     virtual void* alloc(size_t size) = 0;
 
     virtual void free(void* addr) = 0;
+
+    //! get statistics of the slab cache; all zero if it is disabled
+    virtual SlabCacheStat get_slab_cache_stat() { return {}; }
 };
 
 /*!
@@ -176,6 +200,45 @@ public:
                 alignment = 1024;         //! alignment
     };
 
+    /*!
+     * \brief specifies the slab cache of the stream allocators
+     *
+     * Small blocks freed on a stream are kept in per-size-class lock-free
+     * caches, so they can be reused without locking and updating the free
+     * block tree. Request sizes are rounded up to powers of 2 to get their
+     * size classes. The cached blocks are returned to the free block tree
+     * when gather_stream_free_blk_and_release_full() is called.
+     */
+    struct SlabConfig {
+        //! max size of the blocks to be cached; 0 to disable the cache
+        size_t max_size = 0;
+        //! max number of cached blocks of each size class
+        size_t nr_blk_per_class = 64;
+    };
+
+    /*!
+     * \brief limits of the memory reserved from the raw allocator; 0 means no
+     *      limit
+     *
+     * When the reserved memory would exceed soft_limit, cached free chunks are
+     * released back to the raw allocator, and the pressure callbacks are
+     * called if it is still above the limit. The same is tried before an
+     * allocation exceeds hard_limit, and the allocation fails if it can not
+     * be served by the memory under the limit.
+     */
+    struct LimitConfig {
+        size_t soft_limit = 0, hard_limit = 0;
+    };
+
+    /*!
+     * \brief callback called under memory pressure, with the size of memory
+     *      that would be reserved and the limit exceeded
+     *
+     * The callback could release memory owned by the user, which would be
+     * reclaimed after it returns. It must not allocate from this allocator.
+     */
+    using PressureCallback = thin_function<void(size_t reserved, size_t limit)>;
+
     /*!
      * \brief create a new allocator for a device
      * \param[in] device device id
@@ -194,6 +257,18 @@ public:
      *      cudaMalloc and cudaFree, so no custom algorithm is involved
      */
     static std::unique_ptr<DevMemAlloc> make_cuda_alloc();
+
+    /*!
+     * \brief create a new allocator for a device on top of the
+     *      stream-ordered allocator of CUDA (cudaMallocAsync), which
+     *      requires CUDA 11.2 or later
+     * \param[in] device device id
+     * \param[in] release_threshold free memory held by the memory pool
+     *      beyond this size is released to the driver on synchronization,
+     *      so it could be used by other processes
+     */
+    static std::unique_ptr<DevMemAlloc> make_cuda_async_alloc(
+            int device, size_t release_threshold);
 #endif
 
 #if MGB_ROCM
@@ -257,6 +332,49 @@ public:
         return *this;
     }
 
+    /*!
+     * \brief set slab cache config; it only takes effect on the stream
+     *      allocators added after this call
+     */
+    DevMemAlloc& slab_config(const SlabConfig& conf) {
+        m_slab_config = conf;
+        return *this;
+    }
+
+    /*!
+     * \brief set memory limits; only the allocators created by make() honor
+     *      the limits
+     */
+    DevMemAlloc& limit_config(const LimitConfig& conf) {
+        mgb_assert(
+                !conf.soft_limit || !conf.hard_limit ||
+                        conf.soft_limit <= conf.hard_limit,
+                "soft memory limit %zu exceeds hard limit %zu", conf.soft_limit,
+                conf.hard_limit);
+        m_limit_config = conf;
+        return *this;
+    }
+
+    /*!
+     * \brief register a callback to be called under memory pressure
+     * \return handle to remove the callback
+     */
+    size_t add_pressure_callback(PressureCallback cb) {
+        MGB_LOCK_GUARD(m_pressure_cb_mtx);
+        m_pressure_cb.emplace_back(++m_pressure_cb_id, std::move(cb));
+        return m_pressure_cb_id;
+    }
+
+    void remove_pressure_callback(size_t handle) {
+        MGB_LOCK_GUARD(m_pressure_cb_mtx);
+        for (auto iter = m_pressure_cb.begin(); iter != m_pressure_cb.end(); ++iter) {
+            if (iter->first == handle) {
+                m_pressure_cb.erase(iter);
+                return;
+            }
+        }
+    }
+
     /*!
      * \brief get current alignment
      */
@@ -264,13 +382,38 @@ public:
 
     const PreAllocConfig& prealloc_config() { return m_prealloc_config; }
 
+    const SlabConfig& slab_config() const { return m_slab_config; }
+
+    const LimitConfig& limit_config() const { return m_limit_config; }
+
     virtual size_t get_used_memory() { return 0; }
     virtual size_t get_max_used_memory() { return 0; }
     virtual void reset_max_used_memory() {}
 
+protected:
+    //! call the pressure callbacks, without holding any lock of the allocator
+    void call_pressure_callbacks(size_t reserved, size_t limit) {
+        std::vector<PressureCallback> callbacks;
+        {
+            MGB_LOCK_GUARD(m_pressure_cb_mtx);
+            for (auto&& i : m_pressure_cb) {
+                callbacks.push_back(i.second);
+            }
+        }
+        for (auto&& cb : callbacks) {
+            cb(reserved, limit);
+        }
+    }
+
 private:
     size_t m_alignment = 1;
     PreAllocConfig m_prealloc_config;
+    SlabConfig m_slab_config;
+    LimitConfig m_limit_config;
+
+    std::mutex m_pressure_cb_mtx;
+    size_t m_pressure_cb_id = 0;
+    std::vector<std::pair<size_t, PressureCallback>> m_pressure_cb;
 };
 
 /* ===================== FwdDevMemAlloc  ===================== */
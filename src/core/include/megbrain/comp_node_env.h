@@ -229,6 +229,8 @@ const char* cnml_get_error_string(cnmlStatus_t err);
 #endif
 #endif
 
+class ThreadPool;
+
 class CPUDispatcher : public MegcoreCPUDispatcher {
 public:
     using AffinityCallBack = thin_function<void(size_t)>;
@@ -239,6 +241,9 @@ public:
     virtual void set_affinity(AffinityCallBack&& /*affinity_cb*/) {
         mgb_assert(0, "The CompNode set_affinity is not implement");
     }
+    //! the thread pool that runs multithreading tasks, or nullptr if the
+    //! dispatcher is single threaded
+    virtual ThreadPool* get_thread_pool() { return nullptr; }
 };
 using AtlasDispatcher = CPUDispatcher;
 
@@ -547,6 +552,8 @@ public:
         void set_affinity(AffinityCallBack&& cb) const {
             dispatcher->set_affinity(std::move(cb));
         }
+
+        ThreadPool* thread_pool() const { return dispatcher->get_thread_pool(); }
     };
 
     const CpuEnv& cpu_env() const {
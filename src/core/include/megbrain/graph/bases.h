@@ -158,6 +158,16 @@ public:
     //! get the graph that owns this executable; nullptr if no owner graph
     virtual ComputingGraph* owner_graph() const = 0;
 
+    //! name and time in seconds of each phase of graph compiling
+    using CompilePhaseTime = SmallVector<std::pair<const char*, double>>;
+
+    /*!
+     * \brief time spent on each phase when this executable was compiled, in
+     *      the order of the phases; empty if not available
+     */
+    MGE_WIN_DECLSPEC_FUC virtual const CompilePhaseTime& get_compile_phase_time()
+            const;
+
     //! user data associated with a compiled executable
     UserDataContainer& user_data() { return m_user_data; }
 
@@ -12,6 +12,8 @@
 #endif
 
 namespace mgb {
+class ArenaAllocator;
+
 namespace cg {
 
 /*!
@@ -80,6 +82,9 @@ struct GraphCommonOptimizeOptions {
     bool f16_io_f32_comp = false;
     //! whether to enable tranform to pure float16 model
     bool f16_io_comp = false;
+    //! keep the oprs sensitive to float16, like softmax, normalizations and
+    //! reductions, in float32 when f16_io_f32_comp or f16_io_comp is enabled
+    bool f16_mixed_precision = false;
     //! whether to enable conv bias nonlinearity fusion
     bool fuse_conv_bias_nonlinearity = false;
     //! fuse pattern like ReLU(conv_bias(x, w, b) + z) or conv_bias(x, w, b)
@@ -93,6 +98,17 @@ struct GraphCommonOptimizeOptions {
     bool fuse_preprocess = false;
     //! fuse_grain patten, replace grain ir with huge ir
     bool fuse_grain = false;
+    //! fuse a NCHW44 channel wise conv_bias followed by a 1x1 conv_bias into
+    //! one DepthwisePointwiseConvBias
+    bool fuse_depthwise_pointwise_conv_bias = false;
+    //! fuse layer_norm(x + residual) into one ResidualLayerNorm
+    bool fuse_residual_layer_norm = false;
+    //! store transformed constant weights (e.g. transposed matmul operands)
+    //! into the model, so that they need not be transformed at runtime
+    bool precompute_weight = false;
+    //! max bytes the model may grow by precompute_weight, since a weight that
+    //! is also read elsewhere has to be kept along with its transformed copy
+    size_t precompute_weight_size_budget = std::numeric_limits<size_t>::max();
 
     enum LayoutTransform : uint32_t {
         DEFAULT,
@@ -112,11 +128,16 @@ struct GraphCommonOptimizeOptions {
     void clear() {
         f16_io_f32_comp = false;
         f16_io_comp = false;
+        f16_mixed_precision = false;
         fuse_conv_bias_nonlinearity = false;
         fuse_conv_bias_with_z = false;
         weight_preprocess = false;
         fuse_preprocess = false;
         fuse_grain = false;
+        fuse_depthwise_pointwise_conv_bias = false;
+        fuse_residual_layer_norm = false;
+        precompute_weight = false;
+        precompute_weight_size_budget = std::numeric_limits<size_t>::max();
         layout_transform = LayoutTransform::DEFAULT;
     }
 
@@ -133,11 +154,15 @@ struct GraphCommonOptimizeOptions {
 
     SET(f16_io_f32_comp);
     SET(f16_io_comp);
+    SET(f16_mixed_precision);
     SET(fuse_conv_bias_nonlinearity);
     SET(fuse_conv_bias_with_z);
     SET(fuse_preprocess);
     SET(weight_preprocess);
     SET(fuse_grain);
+    SET(fuse_depthwise_pointwise_conv_bias);
+    SET(fuse_residual_layer_norm);
+    SET(precompute_weight);
 #undef SET
 #define SET(_trans, _trans_capital)                                 \
     GraphCommonOptimizeOptions& enable_##_trans() {                 \
@@ -330,6 +355,27 @@ public:
             //! whether to enable comp node optimization (e.g. using copy
             //! stream for I/O operators)
             bool enable_seq_comp_node_opt = true;
+
+            //! whether to update the static memory plan incrementally on
+            //! shape change, which only re-places the chunks that grow
+            //! instead of solving the whole plan again
+            bool enable_incremental_mem_plan = false;
+
+            //! incremental plan falls back to a full plan when its peak
+            //! memory over the lower bound exceeds that of the last full
+            //! plan by this ratio
+            float incremental_mem_plan_frag_threshold = 0.1f;
+
+            //! whether to let the producers of some inputs write into a
+            //! slice of the output of an opr (e.g. Concat), so that the
+            //! copy of the inputs is skipped
+            bool enable_mem_fwd_out2in_slice = true;
+
+            //! number of compute streams the independent branches on a
+            //! comp node with multiple streams are spread over; stream k of
+            //! the pool is the stream k of the comp node, and values less
+            //! than 2 keep the computing on the streams given by the oprs
+            uint8_t nr_compute_stream = 1;
         } seq_opt;
 
         //! graph optimization options
@@ -432,6 +478,22 @@ public:
         //! whether to allocate static memory just after compiling graph
         bool allocate_static_mem_after_graph_compile = false;
 
+        /*!
+         * whether to log the time of each phase in graph compiling; the
+         * time is always available by
+         * AsyncExecutable::get_compile_phase_time()
+         */
+        bool log_compile_phase_time = false;
+
+        /*!
+         * whether to record timing events in each execution for
+         * AsyncExecutable::get_prev_exec_time(); it is turned on by
+         * GraphProfiler. When it is false, the timing events are only
+         * created after get_prev_exec_time() has been called, and that
+         * first call returns the time measured on host.
+         */
+        bool enable_exec_timer = false;
+
         /*!
          * whether only to perform non-computing tasks (like memory
          * allocation and queue initialization) for next exec. This would be
@@ -449,6 +511,12 @@ public:
             int genetic_pool_size = 20;
             int lb_memory_mb = 0;
             int num_worker = sys::get_cpu_count() / 2;
+            //! hard budget of the memory bottleneck in MB; if positive, the
+            //! plan with the least recomputation within the budget is chosen
+            //! rather than the one with the least memory
+            int budget_memory_mb = 0;
+            //! time limit of the local search within the budget in ms
+            int budget_search_time_ms = 1000;
         } sublinear_mem_config;
 
         //! whether to enable DTR memory optimization
@@ -466,6 +534,17 @@ public:
         //! changes (use previous algo)
         bool no_profiling_on_shape_change = false;
 
+        /*!
+         * whether to share preprocessed weights (see
+         * GraphCommonOptimizeOptions::weight_preprocess) between graphs in
+         * this process
+         *
+         * Oprs with equal weight values, param, algo, layouts and comp node
+         * would use a single copy of the preprocessed weights. Only const
+         * weights on cpu comp nodes are shared.
+         */
+        bool share_preprocessed_weight = false;
+
         //! whether to perform defragmenting when memory allocation for a
         //! dynamic var fails
         bool enable_var_mem_defragment = true;
@@ -508,6 +587,48 @@ public:
          */
         uint8_t comp_node_seq_record_level = 0;
 
+        /*!
+         * whether to capture the sequence recorded by
+         * comp_node_seq_record_level=1 into a CUDA graph on cuda comp nodes
+         * (or a HIP graph on rocm comp nodes); recording is not supported on
+         * them otherwise
+         *
+         * Only the work issued to the stream is replayed. Host code run by
+         * the oprs (e.g. the callbacks of output specs) only runs in the
+         * executions that record, so the outputs should be read from the
+         * device tensors of the dest vars, and oprs that sync the comp node
+         * can not be recorded. The sequence is captured again when the
+         * pointer of any tensor used by it changes.
+         */
+        bool comp_node_seq_record_device_graph = false;
+
+        /*!
+         * whether to replay the kernels of fully static graphs, which cuts
+         * the per-opr host cost for graphs of many small oprs
+         *
+         * It works like comp_node_seq_record_level=1 when all its
+         * constraints except the one on host buffer pointers are met, and
+         * falls back to normal execution silently otherwise. The sequence is
+         * recorded again before replay once the pointer of a tensor it uses
+         * has changed (e.g. the user binds new input/output memory, or
+         * assigns another buffer to the host tensor of a Host2DeviceCopy),
+         * so kernels that bind raw pointers at dispatch remain correct. Per-opr graph
+         * events are only emitted by the executions that record.
+         */
+        bool lean_exec = false;
+
+        /*!
+         * number of distinct inputs whose results are memoized for each
+         * statically inferred intermediate shape or value; 0 to disable
+         *
+         * The results are keyed by the input shapes and small input
+         * values, so the infer funcs (e.g. of the arithmetic on
+         * GetVarShape) are not called again when the input shapes switch
+         * among a few values. The infer funcs of the intermediate nodes
+         * must be pure.
+         */
+        uint8_t static_infer_memo_size = 0;
+
 #if !MGB_BUILD_SLIM_SERVING
         //! whether to evaulate var node values as they are inserted
         bool eager_evaluation = false;
@@ -553,6 +674,16 @@ public:
              * equal
              */
             bool binary_equal_between_batch = false;
+
+            /*!
+             * \brief whether to choose the heuristic algo at once and run
+             *      the profiling of PROFILE strategy in a background thread
+             *
+             * The profiling result is written to the persistent cache, and
+             * the profiled algo is used when the algo of the opr is set up
+             * again. Only CUDA comp nodes are profiled asynchronously.
+             */
+            bool async_profile = false;
         } fast_run_config;
 
     };  // Options
@@ -626,6 +757,13 @@ public:
     //! get number of operators inserted in this graph
     virtual size_t nr_oprs_in_graph() const = 0;
 
+    /*!
+     * \brief get the arena that lives as long as this graph, which can be
+     *      activated by ArenaAllocator::Scope to allocate operators of this
+     *      graph; nullptr if not supported
+     */
+    virtual ArenaAllocator* node_arena() { return nullptr; }
+
 #if !MGB_THREAD_SAFE
     /*!
      * \brief pre-allocate static storage used for internal states of
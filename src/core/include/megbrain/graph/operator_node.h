@@ -479,6 +479,20 @@ public:
 
     MGE_WIN_DECLSPEC_FUC virtual ~OperatorNodeBase() noexcept;
 
+    /*!
+     * \brief allocate operators from the arena activated by
+     *      ArenaAllocator::Scope if there is one, and from heap otherwise
+     *
+     * Operators allocated from an arena are not freed individually; the
+     * arena (e.g. the one of the owner graph) must outlive them.
+     */
+    //! \{
+    MGE_WIN_DECLSPEC_FUC static void* operator new(size_t size);
+    MGE_WIN_DECLSPEC_FUC static void operator delete(void* ptr) noexcept;
+    static void* operator new(size_t, void* ptr) noexcept { return ptr; }
+    static void operator delete(void*, void*) noexcept {}
+    //! \}
+
 #if MGB_ENABLE_JSON
     /* ===================== json io ===================== */
     MGE_WIN_DECLSPEC_FUC std::shared_ptr<json::Value> to_json() const override;
@@ -300,6 +300,19 @@ public:
      */
     MGE_WIN_DECLSPEC_FUC VarNode& set_fwd_in2out_writable(VarNode* input);
 
+    /*!
+     * \brief request that the memory of an input var be a slice of this var,
+     *      so that the producer of the input writes into this var directly
+     *
+     * The request may be ignored, so the opr must check whether the input is
+     * already in place on execution. Note that this function must be called
+     * from OperatorNodeBase::mem_plan_fwd_in2out_writable.
+     *
+     * \param sub the slice of this var
+     */
+    MGE_WIN_DECLSPEC_FUC VarNode& set_fwd_out2in_slice(
+            VarNode* input, const SubTensorSpec& sub);
+
     /*!
      * \brief require this var to share memory from another var; only used
      * for operators that have an explicit updating semantics
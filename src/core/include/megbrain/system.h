@@ -30,6 +30,23 @@ MGE_WIN_DECLSPEC_FUC int get_cpu_count();
 //! set cpu affinity for caller thread
 MGE_WIN_DECLSPEC_FUC void set_cpu_affinity(const std::vector<int>& cpuset);
 
+/*!
+ * \brief get the CPU IDs belonging to a NUMA node
+ *
+ * \return empty vector if NUMA info is unavailable or node does not exist
+ */
+MGE_WIN_DECLSPEC_FUC std::vector<int> get_numa_node_cpus(int node);
+
+/*!
+ * \brief bind the pages fully contained in [ptr, ptr + size) to a NUMA node
+ *
+ * The binding is a hint: pages that have not been touched will be allocated
+ * on the node, and failures are logged and ignored.
+ *
+ * \return whether the binding succeeded
+ */
+MGE_WIN_DECLSPEC_FUC bool bind_memory_to_numa_node(void* ptr, size_t size, int node);
+
 //! whether stderr supports ansi color code
 MGE_WIN_DECLSPEC_FUC bool stderr_ansi_color();
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "megbrain_build_config.h"
+
+namespace mgb {
+
+/*!
+ * \brief a bump allocator whose memory is only released in bulk when it is
+ *      destructed
+ *
+ * It is used to allocate abundant small objects that live as long as the
+ * arena, such as the operators of a ComputingGraph. The objects are not
+ * destructed by the arena.
+ */
+class ArenaAllocator {
+    size_t m_cur_buf_pos = 0, m_cur_buf_size = 0, m_nr_alloc_bytes = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> m_buf;
+
+public:
+    class Scope;
+
+    MGE_WIN_DECLSPEC_FUC ArenaAllocator() noexcept;
+    MGE_WIN_DECLSPEC_FUC ~ArenaAllocator() noexcept;
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    /*!
+     * \brief allocate storage of given size
+     * \param alignment address alignment, must be power of 2 and not
+     *      greater than alignof(std::max_align_t)
+     */
+    MGE_WIN_DECLSPEC_FUC void* alloc(size_t size, size_t alignment);
+
+    //! total size of the allocated storage in bytes
+    size_t nr_alloc_bytes() const { return m_nr_alloc_bytes; }
+
+    //! get the arena activated by Scope on current thread, or nullptr
+    MGE_WIN_DECLSPEC_FUC static ArenaAllocator* current();
+};
+
+/*!
+ * \brief activate an arena on current thread during the lifespan of this
+ *      object, so the objects that support arena allocation (e.g.
+ *      OperatorNodeBase) created on this thread are allocated from it
+ *
+ * Scopes can be nested, and a null arena deactivates the outer one.
+ */
+class ArenaAllocator::Scope {
+    ArenaAllocator* m_prev;
+
+public:
+    MGE_WIN_DECLSPEC_FUC explicit Scope(ArenaAllocator* arena);
+    MGE_WIN_DECLSPEC_FUC ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -19,7 +19,7 @@ class EagerEvalManager;
 class CompNodeSyncManager : public NonCopyableObj {
     friend class cg::EagerEvalManager;
     CompNode m_comp_node;
-    std::unique_ptr<CompNode::Event> m_ready_event;
+    CompNode::PooledEvent m_ready_event;
     bool m_have_been_waited = false;
     size_t m_nr_waiter = 0;
 
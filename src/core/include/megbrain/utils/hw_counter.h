@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include "megbrain_build_config.h"
+
+namespace mgb {
+
+/*!
+ * \brief hardware counters of the calling thread
+ *
+ * The counters are read through perf_event on Linux, counting only in user mode
+ * so that they are available to unprivileged processes. On other platforms, or
+ * if perf_event is not permitted, get() returns nullptr.
+ */
+class HWCounter {
+public:
+    struct Value {
+        uint64_t cycles = 0, instructions = 0;
+        //! references to and misses of the last level cache
+        uint64_t cache_references = 0, cache_misses = 0;
+
+        Value operator-(const Value& rhs) const {
+            return {cycles - rhs.cycles, instructions - rhs.instructions,
+                    cache_references - rhs.cache_references,
+                    cache_misses - rhs.cache_misses};
+        }
+
+        Value& operator+=(const Value& rhs) {
+            cycles += rhs.cycles;
+            instructions += rhs.instructions;
+            cache_references += rhs.cache_references;
+            cache_misses += rhs.cache_misses;
+            return *this;
+        }
+
+        //! instructions per cycle
+        double ipc() const { return cycles ? double(instructions) / cycles : 0; }
+
+        double cache_miss_rate() const {
+            return cache_references ? double(cache_misses) / cache_references : 0;
+        }
+
+        //! memory traffic estimated from the misses of the last level cache
+        uint64_t memory_bytes() const { return cache_misses * 64; }
+    };
+
+    //! counters of the calling thread, opened on the first call; nullptr if
+    //! they are not supported
+    MGE_WIN_DECLSPEC_FUC static HWCounter* get();
+
+    //! current values of the counters since they were opened
+    MGE_WIN_DECLSPEC_FUC Value read() const;
+
+    ~HWCounter();
+
+private:
+    int m_group_fd = -1;
+    int m_fds[4] = {-1, -1, -1, -1};
+
+    HWCounter() = default;
+    bool open();
+};
+
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -41,6 +41,42 @@ public:
     MGE_WIN_DECLSPEC_FUC void put(
             const std::string& category, const Blob& key, const Blob& value) override;
     bool support_dump_cache() override { return true; }
+
+    //! difference of the entries in one category between two caches
+    struct CategoryDiff {
+        std::string category;
+        size_t nr_only_self = 0, nr_only_other = 0, nr_different = 0;
+    };
+
+    /*!
+     * \brief merge the entries of another cache into this one
+     *
+     * \param overwrite whether to replace the existing entries with the
+     *      values in \p other; otherwise only the missing entries are added
+     * \return number of entries added or replaced
+     */
+    MGE_WIN_DECLSPEC_FUC size_t
+    merge(const InFilePersistentCache& other, bool overwrite = false);
+
+    //! compare the entries with another cache; equal categories are omitted
+    MGE_WIN_DECLSPEC_FUC std::vector<CategoryDiff> diff(
+            const InFilePersistentCache& other) const;
+
+    /*!
+     * \brief remove the categories for which \p keep returns false
+     *
+     * The category names start with the traits of the device (see
+     * PersistentCache::make_category_from_comp_node), so the entries of other
+     * devices can be dropped by the prefix.
+     *
+     * \return number of entries removed
+     */
+    MGE_WIN_DECLSPEC_FUC size_t
+    prune(thin_function<bool(const std::string& category)> keep);
+
+    //! number of entries of each category
+    MGE_WIN_DECLSPEC_FUC std::vector<std::pair<std::string, size_t>> summary()
+            const;
 };
 }  // namespace mgb
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "megbrain/utils/persistent_cache.h"
+
+namespace mgb {
+
+/**
+ * \brief persistent cache backed by an append-only log file which can be shared
+ * by multiple processes
+ *
+ * Each put appends a single record to the file under an exclusive file lock,
+ * and the records appended by other processes are read incrementally from the
+ * last known offset when a lookup misses, so the cache file is neither loaded
+ * nor rewritten as a whole. A later record of the same key overrides the
+ * earlier ones. An incomplete record left by a crashed writer is dropped by
+ * the next writer.
+ *
+ * file format (integers in local endian):
+ * <magic|8 bytes>
+ *  [<category_size|uint32_t><category|uint8_t*><key_size|uint32_t><key|uint8_t*>
+ *   <data_size|uint32_t><data|uint8_t*>]*
+ */
+class LogFilePersistentCache final : public PersistentCache {
+    class LogFile;
+    std::unique_ptr<LogFile> m_file;
+    //! end of the records that have been read into m_cache
+    size_t m_offset = 0;
+
+    //! read the records appended since m_offset; return number of records read
+    size_t read_tail();
+
+public:
+    MGE_WIN_DECLSPEC_FUC LogFilePersistentCache(const char* path);
+    MGE_WIN_DECLSPEC_FUC ~LogFilePersistentCache();
+
+    MGE_WIN_DECLSPEC_FUC Maybe<Blob> get(
+            const std::string& category, const Blob& key) override;
+    MGE_WIN_DECLSPEC_FUC void put(
+            const std::string& category, const Blob& key, const Blob& value) override;
+
+    /*!
+     * \brief read the records appended by other processes
+     *
+     * It is called by get on a miss, so there is no need to call it before
+     * lookups.
+     *
+     * \return number of records read
+     */
+    MGE_WIN_DECLSPEC_FUC size_t sync();
+
+    //! dump all the entries in the format of InFilePersistentCache
+    MGE_WIN_DECLSPEC_FUC std::vector<uint8_t> dump_cache();
+};
+
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
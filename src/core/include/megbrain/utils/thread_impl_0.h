@@ -69,6 +69,9 @@ protected:
     virtual void on_sync_all_task_finish() {}
     virtual void on_async_queue_worker_thread_start() {}
 };
+
+template <typename Param, class TaskImpl>
+using AsyncRingQueueSC = AsyncQueueSC<Param, TaskImpl>;
 }  // namespace mgb
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
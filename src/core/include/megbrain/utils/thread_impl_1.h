@@ -5,6 +5,7 @@
 #include "megbrain/utils/metahelper.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <limits>
@@ -420,6 +421,264 @@ private:
     }
 };
 
+/*!
+ * \brief bounded multi producer, single consumer asynchronous queue on a ring
+ *      buffer
+ *
+ * It has the same interface as AsyncQueueSC. Each producer takes a ticket
+ * by an atomic increment and writes the task into its slot without locking;
+ * producers wait when the ring is full. The consumer fetches and commits the
+ * tasks in batches to reduce synchronization per task.
+ *
+ * Tasks added from the worker itself when the ring is full are kept in a
+ * local overflow list of the worker, so they never block.
+ *
+ * \tparam Param single param for a task
+ * \tparam TaskImpl a subclass that provides the following public method:
+ *
+ *      void process_one_task(Param &);
+ *
+ *      Note that add_task() can be called within this callback
+ */
+template <typename Param, class TaskImpl>
+class AsyncRingQueueSC : public NonCopyableObj {
+    struct Slot {
+        //! equals to the ticket of the next task to be written when the slot
+        //! is empty, and the ticket plus one when the task is ready
+        std::atomic_size_t seq;
+        typename std::aligned_storage<sizeof(Param), alignof(Param)>::type m_storage;
+
+        Param* get() { return aliased_ptr<Param>(&m_storage); }
+    };
+
+public:
+    //! \param max_spin see AsyncQueueSC
+    //! \param max_items capacity of the ring, which would be rounded up to
+    //!     a power of 2; a default capacity is used if it is negative
+    AsyncRingQueueSC(ptrdiff_t max_spin = -1, ptrdiff_t max_items = -1)
+            : m_synchronizer(
+                      max_spin >= 0 ? max_spin
+                                    : SCQueueSynchronizer::get_default_max_spin()) {
+        init_slots(max_items);
+    }
+
+    void add_task(const Param& param) { emplace_task(param); }
+
+    void add_task(Param&& param) { emplace_task(std::move(param)); }
+
+    //! see AsyncQueueSC::wait_all_task_finish
+    void wait_all_task_finish() {
+        auto tgt = m_queue_tail_tid.load(std::memory_order_acquire);
+        do {
+            m_synchronizer.producer_wait();
+        } while (m_finished_task.load(std::memory_order_acquire) < tgt);
+        check_exception();
+        on_sync_all_task_finish();
+    }
+
+    //! see AsyncQueueSC::wait_task_queue_empty
+    void wait_task_queue_empty() {
+        size_t tgt, done;
+        do {
+            m_synchronizer.producer_wait();
+            done = m_finished_task.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            tgt = m_queue_tail_tid.load(std::memory_order_relaxed);
+        } while (tgt != done);
+        m_synchronizer.producer_wait();
+    }
+
+    void check_exception() {
+#if MGB_ENABLE_EXCEPTION
+        if (m_worker_exc) {
+            std::exception_ptr exc;
+            std::swap(m_worker_exc, exc);
+            std::rethrow_exception(exc);
+        }
+#endif
+    }
+
+    MGB_WARN_UNUSED_RESULT bool all_task_finished() const {
+        return m_synchronizer.check_finished();
+    }
+
+    //! change the capacity; it could only be called before any task is added
+    void update_max_items(ptrdiff_t max_items) {
+        mgb_assert(
+                !worker_started(),
+                "capacity of the ring queue can not be changed after started");
+        init_slots(max_items);
+    }
+
+    inline bool worker_started() const { return m_synchronizer.worker_started(); }
+
+protected:
+    ~AsyncRingQueueSC() noexcept = default;
+
+    virtual void on_async_queue_worker_thread_start() {}
+
+    virtual void on_sync_all_task_finish() {}
+
+    //! called in the worker after the last task of a fetched batch is
+    //! processed but before the batch is committed, so the tasks deferred by
+    //! process_one_task() could be finished here
+    virtual void on_async_queue_batch_finish() {}
+
+private:
+    static constexpr size_t DEFAULT_CAPACITY = 1024, MAX_BATCH = 64,
+                            MAX_SPIN_ON_SLOT = 256, MAX_YIELD_ON_SLOT = 4096;
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    std::atomic_size_t m_queue_tail_tid{0},  //!< ticket of next task
+            m_finished_task{0};
+
+    //! following members are only accessed by the worker
+    size_t m_head = 0, m_nr_batch_done = 0;
+    bool m_has_cur_task = false, m_cur_task_spilled = false;
+    std::deque<std::pair<size_t, Param>> m_spill;
+
+    std::thread::id m_worker_tid;
+    std::atomic_bool m_worker_tid_ready{false};
+    Spinlock m_mutex;
+    SCQueueSynchronizer m_synchronizer;
+#if MGB_ENABLE_EXCEPTION
+    std::exception_ptr m_worker_exc;  //!< exception caught in worker
+#endif
+
+    void init_slots(ptrdiff_t max_items) {
+        size_t cap = 1;
+        size_t req = max_items < 0 ? DEFAULT_CAPACITY
+                                   : std::max<size_t>(max_items, 1);
+        while (cap < req) {
+            cap <<= 1;
+        }
+        m_slots.reset(new Slot[cap]);
+        for (size_t i = 0; i < cap; ++i) {
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+        m_mask = cap - 1;
+    }
+
+    MGB_NOINLINE void start_worker() {
+        MGB_LOCK_GUARD(m_mutex);
+        if (!m_synchronizer.worker_started()) {
+            std::thread worker{&AsyncRingQueueSC::worker_thread_impl, this};
+            m_worker_tid = worker.get_id();
+            m_worker_tid_ready.store(true, std::memory_order_release);
+            m_synchronizer.start_worker(std::move(worker));
+        }
+    }
+
+    //! spin, then yield, then sleep until the slot reaches \p seq
+    static void wait_slot(const Slot& slot, size_t seq) {
+        for (size_t spin = 0; slot.seq.load(std::memory_order_acquire) != seq;
+             ++spin) {
+            if (spin >= MAX_SPIN_ON_SLOT + MAX_YIELD_ON_SLOT) {
+                std::this_thread::sleep_for(std::chrono::microseconds(20));
+            } else if (spin >= MAX_SPIN_ON_SLOT) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template <typename T>
+    void emplace_task(T&& param) {
+        if (mgb_unlikely(!m_worker_tid_ready.load(std::memory_order_acquire))) {
+            start_worker();
+        }
+        const size_t tid = m_queue_tail_tid.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = m_slots[tid & m_mask];
+        if (mgb_unlikely(slot.seq.load(std::memory_order_acquire) != tid)) {
+            if (std::this_thread::get_id() == m_worker_tid) {
+                // the worker would never consume the slot if it waits here
+                m_spill.emplace_back(tid, std::forward<T>(param));
+                m_synchronizer.producer_add();
+                return;
+            }
+            // the slot is released by finish_task() of its previous task,
+            // which has a smaller ticket than the one the worker is waiting
+            // for, so waiting on the slot never blocks the worker; waiting
+            // for the previous task to be committed would, since the worker
+            // commits a batch only after all its tasks are written
+            wait_slot(slot, tid);
+        }
+        new (slot.get()) Param(std::forward<T>(param));
+        slot.seq.store(tid + 1, std::memory_order_release);
+        m_synchronizer.producer_add();
+    }
+
+    //! get the task at m_head, which must have been counted by the
+    //! synchronizer
+    Param* fetch_task() {
+        m_has_cur_task = true;
+        if (!m_spill.empty() && m_spill.front().first == m_head) {
+            m_cur_task_spilled = true;
+            return &m_spill.front().second;
+        }
+        m_cur_task_spilled = false;
+        Slot& slot = m_slots[m_head & m_mask];
+        // the producer holding the ticket may be waiting for a full ring
+        wait_slot(slot, m_head + 1);
+        return slot.get();
+    }
+
+    //! destroy the task at m_head and release its slot to the next round
+    void finish_task() {
+        Slot& slot = m_slots[m_head & m_mask];
+        if (m_cur_task_spilled) {
+            m_spill.pop_front();
+        } else {
+            slot.get()->~Param();
+        }
+        slot.seq.store(m_head + m_mask + 1, std::memory_order_release);
+        ++m_head;
+        m_has_cur_task = false;
+    }
+
+    void commit(size_t nr) {
+        m_synchronizer.consumer_commit(nr);
+        m_finished_task.fetch_add(nr, std::memory_order_release);
+    }
+
+    void worker_thread_impl() {
+        while (!m_worker_tid_ready.load(std::memory_order_acquire))
+            ;
+        on_async_queue_worker_thread_start();
+
+        for (;;) {
+            MGB_TRY {
+                worker_thread_impl_no_exc();
+                return;
+            }
+            MGB_CATCH_ALL_EXCEPTION("AsyncRingQueueSC", m_worker_exc);
+
+            if (m_has_cur_task) {
+                finish_task();
+            }
+            commit(m_nr_batch_done + 1);
+        }
+    }
+
+    void worker_thread_impl_no_exc() {
+        for (;;) {
+            auto nr = m_synchronizer.consumer_fetch(MAX_BATCH);
+            if (!nr)
+                return;
+            for (m_nr_batch_done = 0; m_nr_batch_done < nr; ++m_nr_batch_done) {
+                auto task = fetch_task();
+                static_cast<TaskImpl*>(this)->process_one_task(*task);
+                if (m_nr_batch_done + 1 == nr) {
+                    // an exception here is accounted to the last task
+                    on_async_queue_batch_finish();
+                }
+                finish_task();
+            }
+            commit(nr);
+        }
+    }
+};
+
 //! a thread would block until all threads reach this barrier
 class Barrier {
     bool m_need_clear = false;
@@ -47,8 +47,44 @@ public:
  */
 class ThreadPool : public NonCopyableObj {
 public:
-    //! Create thread-pool nr_threads thread_pool
+    /*!
+     * \brief how the sub tasks of one add_task() call are distributed
+     *
+     * SHARED_COUNTER: all the threads fetch sub task from one global atomic
+     * counter.
+     *
+     * WORK_STEALING: the sub tasks are split into contiguous ranges, one for
+     * each thread; a thread which finishes its own range steals half of the
+     * remaining range of another thread, so uneven sub tasks are balanced
+     * dynamically while each thread still runs mostly adjacent sub tasks.
+     *
+     * SPEED_WEIGHTED: like WORK_STEALING, but the initial ranges are sized by
+     * the measured speed of each thread, so big cores of a big.LITTLE cpu get
+     * more sub tasks than little ones. The speeds are updated after each
+     * add_task() with enough sub tasks, so the work migrates off the cores
+     * that become slower at runtime, e.g. by thermal throttling.
+     */
+    enum class ScheduleMode : uint32_t {
+        SHARED_COUNTER = 0,
+        WORK_STEALING = 1,
+        SPEED_WEIGHTED = 2
+    };
+
+    //! statistics of the idle workers, only collected in hybrid wait mode
+    struct WaitStats {
+        //! number of times that a sleeping worker is woken up by add_task()
+        size_t nr_wakeup = 0;
+        //! total time from add_task() notifying to the workers running
+        double wakeup_latency_us = 0;
+        //! total time that idle workers spend on spinning
+        double spin_time_us = 0;
+    };
+
+    //! Create thread-pool nr_threads thread_pool, the schedule mode is
+    //! SPEED_WEIGHTED if env MGB_THREAD_POOL_SPEED_WEIGHTED is set, or
+    //! WORK_STEALING if env MGB_THREAD_POOL_WORK_STEALING is set
     ThreadPool(size_t nr_threads);
+    ThreadPool(size_t nr_threads, ScheduleMode mode);
     //! The main thread set the task, parallelism and worker flag to
     //! notify other thread.
     void add_task(const TaskElem& task_elem);
@@ -58,6 +94,37 @@ public:
     //! Set the affinity of all the threads
     void set_affinity(AffinityCallBack affinity_cb);
 
+    //! change the schedule mode, it takes effect from the next add_task()
+    void set_schedule_mode(ScheduleMode mode);
+
+    ScheduleMode schedule_mode() const { return m_schedule_mode; }
+
+    /*!
+     * \brief the relative speed of each thread measured in SPEED_WEIGHTED
+     * mode, whose mean is 1; the last one is the main thread
+     */
+    std::vector<float> thread_speeds() const;
+
+    //! forget the measured speeds, all the threads are weighted equally
+    void reset_thread_speeds();
+
+    /*!
+     * \brief enable hybrid wait: an idle worker spins for at most spin_us
+     * microseconds before sleeping on the condition variable, whether the
+     * pool is active or not
+     *
+     * A negative value restores the default wait, where workers spin while
+     * the pool is active and sleep after deactive(). The initial value is
+     * read from env MGB_THREAD_POOL_SPIN_US.
+     */
+    void set_spin_budget(int64_t spin_us);
+
+    int64_t spin_budget() const { return m_spin_budget_us.load(); }
+
+    WaitStats wait_stats() const;
+
+    void reset_wait_stats();
+
     void sync();
     //! wake up all the threads from cv.wait(), when the thread pool is not
     //! active, all the threads will go to sleep.
@@ -67,6 +134,38 @@ public:
     ~ThreadPool();
 
 private:
+    /*!
+     * \brief sub task range [begin, end) owned by one thread, packed as
+     * (begin << 32 | end) so the owner and thieves can update it by CAS
+     */
+    struct alignas(64) StealRange {
+        std::atomic<uint64_t> range{0};
+    };
+
+    //! sub tasks run by one thread in one add_task(), written only by the
+    //! thread itself
+    struct alignas(64) ThreadStat {
+        size_t nr_executed = 0;
+        int64_t busy_ns = 0;
+    };
+
+    //! the main loop of worker i in hybrid wait mode, return when the wait
+    //! mode is changed or the pool is stopped
+    void hybrid_wait_loop(size_t i);
+
+    //! run sub tasks of the current task on thread thread_id, until no
+    //! sub task can be fetched
+    void run_tasks(size_t thread_id);
+    //! fetch the next sub task from the range owned by thread_id
+    bool pop_local_task(size_t thread_id, size_t& index);
+    //! steal half of the remaining range of another thread into the range
+    //! of thread_id, return false if all ranges are empty
+    bool steal_tasks(size_t thread_id);
+    //! split the sub tasks into the ranges of the threads by m_thread_speeds
+    void split_ranges(size_t parallelism, bool weighted);
+    //! update m_thread_speeds by m_thread_stats of the finished task
+    void update_thread_speeds();
+
     size_t m_nr_threads = 1;
     //! Indicate whether the main thread have binding
     bool m_main_affinity_flag;
@@ -82,10 +181,22 @@ private:
     std::vector<Worker*> m_workers;
     //! The task iter, when finished one, the m_all_task_iter sub 1
     std::atomic_int m_task_iter{0};
+    ScheduleMode m_schedule_mode = ScheduleMode::SHARED_COUNTER;
+    //! per-thread sub task ranges used in WORK_STEALING mode
+    std::unique_ptr<StealRange[]> m_steal_ranges;
+    //! per-thread statistics and speeds used in SPEED_WEIGHTED mode
+    std::unique_ptr<ThreadStat[]> m_thread_stats;
+    std::vector<float> m_thread_speeds;
+    //! hybrid wait related states, see set_spin_budget()
+    std::atomic<int64_t> m_spin_budget_us{-1};
+    std::atomic_size_t m_nr_sleeping{0};
+    std::atomic<int64_t> m_notify_time_ns{0};
+    std::atomic<uint64_t> m_stat_nr_wakeup{0}, m_stat_wakeup_ns{0},
+            m_stat_spin_ns{0};
     //! The cv and mutex for threading activity
     std::condition_variable m_cv;
     std::mutex m_mutex;
-    std::mutex m_mutex_task;
+    mutable std::mutex m_mutex_task;
 };
 #else
 /**
@@ -93,9 +204,29 @@ private:
  */
 class ThreadPool : public NonCopyableObj {
 public:
+    enum class ScheduleMode : uint32_t {
+        SHARED_COUNTER = 0,
+        WORK_STEALING = 1,
+        SPEED_WEIGHTED = 2
+    };
+
     ThreadPool(size_t) {}
+    ThreadPool(size_t, ScheduleMode) {}
     void add_task(const TaskElem& task_elem);
     void set_affinity(AffinityCallBack affinity_cb);
+    void set_schedule_mode(ScheduleMode) {}
+    ScheduleMode schedule_mode() const { return ScheduleMode::SHARED_COUNTER; }
+    std::vector<float> thread_speeds() const { return {1.f}; }
+    void reset_thread_speeds() {}
+    struct WaitStats {
+        size_t nr_wakeup = 0;
+        double wakeup_latency_us = 0;
+        double spin_time_us = 0;
+    };
+    void set_spin_budget(int64_t) {}
+    int64_t spin_budget() const { return -1; }
+    WaitStats wait_stats() const { return {}; }
+    void reset_wait_stats() {}
     void active() {}
     void deactive() {}
     void sync() {}
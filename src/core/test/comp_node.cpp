@@ -68,6 +68,55 @@ TEST(TestCompNode, Parse) {
     ASSERT_THROW(L::parse("multithread1:default:0"), MegBrainError);
 }
 
+TEST(TestCompNode, ParseNuma) {
+    using L = CompNode::Locator;
+    using D = CompNode::DeviceType;
+    auto make_lc = [](D t, int dev, int s, int numa) -> L {
+        L ret{t, dev, {s}};
+        ret.numa_node = numa;
+        return ret;
+    };
+
+    ASSERT_EQ(L::parse("cpu:numa1"), make_lc(D::CPU, -1, 0, 1));
+    ASSERT_EQ(L::parse("cpu2:numa0"), make_lc(D::CPU, 2, 0, 0));
+    ASSERT_EQ(L::parse("cpu2:3:numa12"), make_lc(D::CPU, 2, 3, 12));
+    ASSERT_EQ(L::parse("multithread4:1:numa1"), make_lc(D::MULTITHREAD, 1, 4, 1));
+    ASSERT_EQ(
+            L::parse("multithread:default:2:numa1"),
+            make_lc(D::MULTITHREAD, L::DEVICE_MULTITHREAD_DEFAULT, 2, 1));
+    ASSERT_FALSE(L::parse("cpu2:numa1") == L::parse("cpu2"));
+
+    for (auto&& id :
+         {"cpu2:3:numa12", "multithread4:1:numa1", "multithread:default:2:numa1"}) {
+        ASSERT_EQ(L::parse(id).to_string(), id);
+    }
+    ASSERT_EQ(L::parse("cpu:numa1").to_physical().numa_node, 1);
+
+    ASSERT_THROW(L::parse("cpu0:numa"), MegBrainError);
+    ASSERT_THROW(L::parse("cpu0:numa1x"), MegBrainError);
+    ASSERT_THROW(L::parse("gpu0:numa1"), MegBrainError);
+    ASSERT_THROW(L::parse("xpu0:numa1"), MegBrainError);
+}
+
+TEST(TestCompNode, NumaCpu) {
+    if (sys::get_numa_node_cpus(0).empty()) {
+        printf("skip testcase due to no numa info\n");
+        return;
+    }
+    HostTensorGenerator<> gen;
+    auto host_x = gen({1024});
+    for (auto&& id : {"cpu0", "multithread2:0"}) {
+        auto cn = CompNode::load(std::string{id} + ":numa0");
+        ASSERT_EQ(cn.locator().numa_node, 0);
+        ASSERT_NE(cn, CompNode::load(id));
+        DeviceTensorND dev_x{cn};
+        dev_x.copy_from(*host_x);
+        HostTensorND host_y;
+        host_y.copy_from(dev_x).sync();
+        MGB_ASSERT_TENSOR_EQ(*host_x, host_y);
+    }
+}
+
 TEST(TestCompNode, SetDefaultDev) {
     REQUIRE_GPU(3);
 
@@ -393,6 +442,27 @@ TEST(TestCompNodeCPU, EventWait) {
     ASSERT_TRUE(succ);
 }
 
+TEST(TestCompNodeCPU, PooledEvent) {
+    auto cn = CompNode::load("cpu0");
+    CompNode::Event* ptr;
+    {
+        auto ev = cn.create_pooled_event();
+        ev->record();
+        ev->host_wait();
+        ptr = ev.get();
+    }
+    // event with same flags is reused
+    auto ev0 = cn.create_pooled_event();
+    ASSERT_EQ(ptr, ev0.get());
+    auto ev1 = cn.create_pooled_event();
+    ASSERT_NE(ptr, ev1.get());
+    auto ev2 = cn.create_pooled_event(CompNode::Event::NEED_TIMER);
+    ASSERT_NE(ptr, ev2.get());
+    ASSERT_EQ(size_t(CompNode::Event::NEED_TIMER), ev2->create_flags());
+    ev2->record();
+    ev2->host_wait();
+}
+
 TEST(TestCompNodeCPU, EventRecOverwrite) {
     REQUIRE_THREAD();
     auto cn = CompNode::load("cpu0");
@@ -805,6 +875,7 @@ TYPED_TEST(TestCPUCompSeqRec, run_multi_thread_default) {
 }
 }  // anonymous namespace
 
+#include "megbrain/graph/event.h"
 #include "megbrain/opr/basic_arith_wrapper.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/opr/tensor_manip.h"
@@ -880,4 +951,185 @@ TEST(TestCPUCompSeqRec, run_dyn_ptr) {
     }
 }
 
+TEST(TestCPUCompSeqRec, lean_exec_dyn_ptr) {
+    CompNode cn = CompNode::load("cpux");
+
+    HostTensorGenerator<> gen;
+    auto host_x0 = gen({4, 1}, cn), host_y0 = gen({4, 1}, cn);
+    auto host_x1 = gen({4, 1}, cn), host_y1 = gen({4, 1}, cn);
+
+    auto dev_x0 = std::make_shared<DeviceTensorND>(cn);
+    auto dev_y0 = std::make_shared<DeviceTensorND>(cn);
+    auto dev_x1 = std::make_shared<DeviceTensorND>(cn);
+    auto dev_y1 = std::make_shared<DeviceTensorND>(cn);
+
+    (*dev_x0).comp_node(cn).copy_from(*host_x0).sync();
+    (*dev_y0).comp_node(cn).copy_from(*host_y0).sync();
+    (*dev_x1).comp_node(cn).copy_from(*host_x1).sync();
+    (*dev_y1).comp_node(cn).copy_from(*host_y1).sync();
+
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    graph->options().lean_exec = true;
+
+    // kernels are only issued by the graph in the runs that record
+    size_t nr_kern = 0;
+    auto hdl = graph->event().register_receiver<cg::event::AfterKernel>(
+            [&nr_kern](const cg::event::AfterKernel&) { ++nr_kern; });
+
+    auto x = opr::VolatileSharedDeviceTensor::make(*graph, dev_x0),
+         y = opr::VolatileSharedDeviceTensor::make(*graph, dev_y0), w = x * y + 1;
+
+    HostTensorND host_w;
+    auto func = graph->compile({make_callback_copy(w, host_w)});
+
+    std::vector<size_t> nr_kern_of_run;
+    for (int i = 0; i < 5; ++i) {
+        if (i == 3) {
+            *host_x0 = *host_x1;
+            *host_y0 = *host_y1;
+            dev_x0->only_reset_raw_storage(dev_x1->storage());
+            dev_y0->only_reset_raw_storage(dev_y1->storage());
+        }
+        size_t prev = nr_kern;
+        func->execute().wait();
+        nr_kern_of_run.push_back(nr_kern - prev);
+        auto px = host_x0->ptr<float>(), py = host_y0->ptr<float>(),
+             pw = host_w.ptr<float>();
+        for (size_t j = 0; j < 4; ++j) {
+            MGB_ASSERT_FLOAT_EQ(px[j] * py[j] + 1, pw[j]) << "iter " << i;
+        }
+    }
+    // warm up, record, replay, record again for the new pointers, replay
+    ASSERT_GT(nr_kern_of_run[0], 0u);
+    ASSERT_EQ(nr_kern_of_run[0], nr_kern_of_run[1]);
+    ASSERT_EQ(0u, nr_kern_of_run[2]);
+    ASSERT_EQ(nr_kern_of_run[0], nr_kern_of_run[3]);
+    ASSERT_EQ(0u, nr_kern_of_run[4]);
+}
+
+TEST(TestCPUCompSeqRec, lean_exec_h2d_host_ptr) {
+    CompNode cn = CompNode::load("cpux");
+
+    HostTensorGenerator<> gen;
+    auto host_x = gen({4, 1}, cn);
+
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    graph->options().lean_exec = true;
+
+    size_t nr_kern = 0;
+    auto hdl = graph->event().register_receiver<cg::event::AfterKernel>(
+            [&nr_kern](const cg::event::AfterKernel&) { ++nr_kern; });
+
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x), w = x * x + 1;
+    HostTensorND host_w;
+    auto func = graph->compile({make_callback_copy(w, host_w)});
+
+    std::vector<size_t> nr_kern_of_run;
+    for (int i = 0; i < 6; ++i) {
+        if (i == 3) {
+            // the replayed copy must read from the new host buffer
+            *host_x = *gen({4, 1}, cn);
+        } else if (i == 5) {
+            auto new_x = gen({4, 1}, cn);
+            host_x->reset(new_x->storage(), new_x->layout());
+        }
+        size_t prev = nr_kern;
+        func->execute().wait();
+        nr_kern_of_run.push_back(nr_kern - prev);
+        auto px = host_x->ptr<float>(), pw = host_w.ptr<float>();
+        for (size_t j = 0; j < 4; ++j) {
+            MGB_ASSERT_FLOAT_EQ(px[j] * px[j] + 1, pw[j]) << "iter " << i;
+        }
+    }
+    ASSERT_EQ(0u, nr_kern_of_run[2]);
+    ASSERT_GT(nr_kern_of_run[3], 0u);
+    ASSERT_EQ(0u, nr_kern_of_run[4]);
+    ASSERT_GT(nr_kern_of_run[5], 0u);
+}
+
+TEST(TestCudaCompSeqRec, run_dyn_ptr) {
+    REQUIRE_GPU(1);
+    CompNode cn = CompNode::load("gpu0");
+
+    HostTensorGenerator<> gen;
+    auto host_x0 = gen({4, 1}, cn), host_y0 = gen({4, 1}, cn);
+    auto host_x1 = gen({4, 1}, cn), host_y1 = gen({4, 1}, cn);
+
+    auto dev_x0 = std::make_shared<DeviceTensorND>(cn);
+    auto dev_y0 = std::make_shared<DeviceTensorND>(cn);
+    auto dev_x1 = std::make_shared<DeviceTensorND>(cn);
+    auto dev_y1 = std::make_shared<DeviceTensorND>(cn);
+
+    (*dev_x0).comp_node(cn).copy_from(*host_x0).sync();
+    (*dev_y0).comp_node(cn).copy_from(*host_y0).sync();
+    (*dev_x1).comp_node(cn).copy_from(*host_x1).sync();
+    (*dev_y1).comp_node(cn).copy_from(*host_y1).sync();
+
+    auto graph = ComputingGraph::make();
+    graph->options().var_sanity_check_first_run = false;
+    graph->options().graph_opt_level = 0;
+    graph->options().comp_node_seq_record_level = 1;
+    graph->options().comp_node_seq_record_device_graph = true;
+
+    auto x = opr::VolatileSharedDeviceTensor::make(*graph, dev_x0),
+         y = opr::VolatileSharedDeviceTensor::make(*graph, dev_y0), w = x * y + 1;
+
+    // output callbacks are not replayed, so read the dest var instead
+    HostTensorND host_w;
+    auto func = graph->compile({{w, {}}});
+
+    for (int i = 0; i < 5; ++i) {
+        if (i == 3) {
+            // the captured graph is updated with the new pointers
+            *host_x0 = *host_x1;
+            *host_y0 = *host_y1;
+            dev_x0->only_reset_raw_storage(dev_x1->storage());
+            dev_y0->only_reset_raw_storage(dev_y1->storage());
+        }
+        func->execute().wait();
+        host_w.copy_from(w.node()->dev_tensor()).sync();
+        auto px = host_x0->ptr<float>(), py = host_y0->ptr<float>(),
+             pw = host_w.ptr<float>();
+        for (size_t j = 0; j < 4; ++j) {
+            MGB_ASSERT_FLOAT_EQ(px[j] * py[j] + 1, pw[j]) << "iter " << i;
+        }
+    }
+}
+
+TEST(TestCudaCompSeqRec, need_opt_in) {
+    REQUIRE_GPU(1);
+    CompNode cn = CompNode::load("gpu0");
+
+    HostTensorGenerator<> gen;
+    auto host_x = gen({4, 1}, cn);
+
+    auto graph = ComputingGraph::make();
+    graph->options().var_sanity_check_first_run = false;
+    graph->options().graph_opt_level = 0;
+    graph->options().comp_node_seq_record_level = 1;
+
+    size_t nr_kern = 0;
+    auto hdl = graph->event().register_receiver<cg::event::AfterKernel>(
+            [&nr_kern](const cg::event::AfterKernel&) { ++nr_kern; });
+
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x), w = x * x + 1;
+    HostTensorND host_w;
+    auto func = graph->compile({make_callback_copy(w, host_w)});
+
+    // without comp_node_seq_record_device_graph, every run executes the
+    // oprs and the output callback
+    for (int i = 0; i < 3; ++i) {
+        *host_x = *gen({4, 1}, cn);
+        size_t prev = nr_kern;
+        func->execute().wait();
+        ASSERT_GT(nr_kern, prev);
+        auto px = host_x->ptr<float>(), pw = host_w.ptr<float>();
+        for (size_t j = 0; j < 4; ++j) {
+            MGB_ASSERT_FLOAT_EQ(px[j] * px[j] + 1, pw[j]) << "iter " << i;
+        }
+    }
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
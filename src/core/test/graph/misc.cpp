@@ -256,6 +256,32 @@ TEST(TestGraph, APlusBOnCPU) {
         MGB_ASSERT_FLOAT_EQ(px[i] + py[i], pz[i]);
 }
 
+TEST(TestGraph, CompilePhaseTime) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({23});
+    auto graph = ComputingGraph::make();
+    graph->options().log_compile_phase_time = true;
+    graph->options().allocate_static_mem_after_graph_compile = true;
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    auto y = x * 2 + 1;
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+    auto&& phase_time = func->get_compile_phase_time();
+    std::vector<std::string> names;
+    for (auto&& i : phase_time) {
+        ASSERT_GE(i.second, 0.);
+        names.emplace_back(i.first);
+    }
+    std::vector<std::string> expected{
+            "graph_opt", "comp_node_opt", "topo_sort", "setup_opr_seq", "mem_plan_init",
+            "static_infer_init", "ready_event_init", "static_mem_alloc"};
+    ASSERT_EQ(expected, names);
+    func->execute();
+    auto px = host_x->ptr<float>(), py = host_y.ptr<float>();
+    for (size_t i = 0; i < 23; ++i)
+        MGB_ASSERT_FLOAT_EQ(px[i] * 2 + 1, py[i]);
+}
+
 TEST(TestGraph, DeDup) {
     auto t0 = std::make_shared<DeviceTensorND>(
                  CompNode::load("xpu0"), TensorShape{2, 2}),
@@ -382,6 +408,27 @@ TEST(TestGraph, AsyncExec) {
     }
 }
 
+TEST(TestGraph, LazyExecTimer) {
+    static constexpr double SLEEP_TIME = 0.05;
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    graph->options().var_sanity_check_first_run = false;
+    auto host_x = gen({1});
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+         y = opr::Sleep::make(x, SLEEP_TIME);
+    auto func = graph->compile({{y, [](DeviceTensorND&) {}}});
+
+    // the first call falls back to host time, which covers the sleep
+    func->execute().wait();
+    ASSERT_GE(func->get_prev_exec_time(), SLEEP_TIME * 0.9);
+
+    // timing events are recorded from then on
+    func->execute().wait();
+    auto time = func->get_prev_exec_time();
+    ASSERT_GT(time, 0);
+    ASSERT_EQ(time, func->get_prev_exec_time());
+}
+
 TEST(TestGraph, VSizeTensor) {
     HostTensorGenerator<> gen;
     auto host_x = gen({1}), host_y = gen({1});
@@ -1784,6 +1831,27 @@ TEST(TestGraph, In2OutOpStreamPropagate) {
         }
 }
 
+TEST(TestGraph, ComputeStreamAssign) {
+    REQUIRE_GPU(1);  // compute streams are assigned on comp_node with HAS_COPY_STREAM
+    HostTensorGenerator<> gen;
+    auto host_x = gen({23}, CompNode::load("gpu0"));
+    auto graph = ComputingGraph::make();
+    graph->options().seq_opt.nr_compute_stream = 2;
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x), a = x * 2, b = x + 1,
+         y = a * b;
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+    func->execute();
+    auto px = host_x->ptr<float>(), py = host_y.ptr<float>();
+    for (size_t i = 0; i < 23; ++i) {
+        MGB_ASSERT_FLOAT_EQ(px[i] * 2 * (px[i] + 1), py[i]);
+    }
+    // the two branches of x go to different streams
+    ASSERT_NE(
+            a.node()->comp_node().locator().stream,
+            b.node()->comp_node().locator().stream);
+}
+
 TEST(TestGraph, OperatorNodeConfigInstanceID) {
     OperatorNodeConfig config0, config1;
     void *p0 = &config0, *p1 = &config1;
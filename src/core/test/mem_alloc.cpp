@@ -27,6 +27,7 @@ public:
 
 class DummyAllocator final : public RawAllocator {
     const size_t m_tot_size;
+    const bool m_contiguous;
     bool m_ever_failed = false;
     size_t m_next_addr = 1, m_cur_usage = 0, m_peak_usage = 0, m_nr_alloc = 0,
            m_nr_free = 0;
@@ -34,7 +35,8 @@ class DummyAllocator final : public RawAllocator {
     std::mutex m_mtx;
 
 public:
-    explicit DummyAllocator(size_t tot_size) : m_tot_size(tot_size) {}
+    explicit DummyAllocator(size_t tot_size, bool contiguous = false)
+            : m_tot_size(tot_size), m_contiguous(contiguous) {}
 
     ~DummyAllocator() {
         auto run = [this]() { ASSERT_EQ(0u, m_addr2size.size()); };
@@ -70,6 +72,8 @@ public:
         free = free_size();
     }
 
+    bool contiguous_chunks() const override { return m_contiguous; }
+
     size_t free_size() const { return m_tot_size - m_cur_usage; }
 
     bool ever_failed() const { return m_ever_failed; }
@@ -316,6 +320,137 @@ TEST(TestMemAlloc, GrowByGather) {
     salloc->alloc_shared(10);
 }
 
+TEST(TestMemAlloc, SlabCache) {
+    using StreamKey = DevMemAlloc::StreamKey;
+    auto raw_alloc = std::make_shared<DummyAllocator>(1 << 20);
+    auto runtime_policy = std::make_shared<DummyRuntimePolicy>(0);
+    auto dev_alloc = DevMemAlloc::make(0, 0, raw_alloc, runtime_policy);
+    DevMemAlloc::SlabConfig slab_conf;
+    slab_conf.max_size = 4096;
+    slab_conf.nr_blk_per_class = 2;
+    dev_alloc->slab_config(slab_conf);
+
+    StreamKey stream_key = nullptr;
+    auto salloc = dev_alloc->add_stream(static_cast<StreamKey>(&stream_key));
+    auto p0 = salloc->alloc(1000), p1 = salloc->alloc(1000), p2 = salloc->alloc(1000);
+    // size is rounded up to the size class
+    ASSERT_EQ(1024u * 3, salloc->get_used_memory());
+    salloc->free(p0);
+    salloc->free(p1);
+    // the cache of this class is full
+    salloc->free(p2);
+    auto stat = salloc->get_slab_cache_stat();
+    ASSERT_EQ(0u, stat.nr_hit);
+    ASSERT_EQ(3u, stat.nr_miss);
+    ASSERT_EQ(2u, stat.nr_held_blk);
+    ASSERT_EQ(2048u, stat.held_size);
+    ASSERT_EQ(3000u, stat.req_size);
+    ASSERT_EQ(3072u, stat.alloc_size);
+    ASSERT_EQ(0u, salloc->get_used_memory());
+
+    auto p3 = salloc->alloc(800), p4 = salloc->alloc(1024);
+    ASSERT_TRUE((p3 == p0 && p4 == p1) || (p3 == p1 && p4 == p0));
+    ASSERT_EQ(2u, salloc->get_slab_cache_stat().nr_hit);
+    ASSERT_EQ(0u, salloc->get_slab_cache_stat().nr_held_blk);
+
+    // large blocks are not cached
+    auto p5 = salloc->alloc(8192);
+    salloc->free(p5);
+    ASSERT_EQ(0u, salloc->get_slab_cache_stat().nr_held_blk);
+
+    salloc->free(p3);
+    salloc->free(p4);
+    ASSERT_EQ(2u, salloc->get_slab_cache_stat().nr_held_blk);
+    dev_alloc->gather_stream_free_blk_and_release_full();
+    ASSERT_EQ(0u, salloc->get_slab_cache_stat().nr_held_blk);
+    ASSERT_EQ(0u, salloc->get_used_memory());
+}
+
+TEST(TestMemAlloc, ContiguousChunks) {
+    using StreamKey = DevMemAlloc::StreamKey;
+    constexpr size_t TOT = 4000;
+    auto raw_alloc = std::make_shared<DummyAllocator>(TOT, true);
+    auto runtime_policy = std::make_shared<DummyRuntimePolicy>(0);
+    auto dev_alloc = DevMemAlloc::make(0, 0, raw_alloc, runtime_policy);
+    auto conf = dev_alloc->prealloc_config();
+    conf.max_overhead = 0;
+    conf.alignment = 1;
+    dev_alloc->prealloc_config(conf);
+
+    StreamKey stream_key = nullptr;
+    auto salloc = dev_alloc->add_stream(static_cast<StreamKey>(&stream_key));
+    auto p0 = salloc->alloc(1000), p1 = salloc->alloc(1000);
+    ASSERT_EQ(2u, raw_alloc->nr_alloc());
+    salloc->free(p0);
+    salloc->free(p1);
+    // free blocks are merged across the chunk boundary
+    auto p2 = salloc->alloc(2000);
+    ASSERT_EQ(p0, p2);
+    ASSERT_EQ(2u, raw_alloc->nr_alloc());
+
+    auto p3 = salloc->alloc(1000);
+    ASSERT_EQ(3u, raw_alloc->nr_alloc());
+    salloc->free(p2);
+    // the first two chunks are covered by the free block and released
+    dev_alloc->gather_stream_free_blk_and_release_full();
+    ASSERT_EQ(2u, raw_alloc->nr_free());
+    ASSERT_EQ(TOT - 1000, raw_alloc->free_size());
+    ASSERT_EQ(1000u, salloc->get_used_memory());
+    salloc->free(p3);
+    dev_alloc->gather_stream_free_blk_and_release_full();
+    ASSERT_EQ(TOT, raw_alloc->free_size());
+}
+
+TEST(TestMemAlloc, Limit) {
+    using StreamKey = DevMemAlloc::StreamKey;
+    constexpr size_t TOT = 10000;
+    auto raw_alloc = std::make_shared<DummyAllocator>(TOT);
+    auto runtime_policy = std::make_shared<DummyRuntimePolicy>(0);
+    auto dev_alloc = DevMemAlloc::make(0, 0, raw_alloc, runtime_policy);
+    auto conf = dev_alloc->prealloc_config();
+    conf.max_overhead = 0;
+    conf.alignment = 1;
+    dev_alloc->prealloc_config(conf);
+    dev_alloc->limit_config({2000, 3000});
+
+    StreamKey stream_key = nullptr;
+    auto salloc = dev_alloc->add_stream(static_cast<StreamKey>(&stream_key));
+    size_t nr_cb = 0;
+    void* to_release = nullptr;
+    dev_alloc->add_pressure_callback([&](size_t reserved, size_t limit) {
+        ASSERT_GT(reserved, limit);
+        ++nr_cb;
+        if (to_release) {
+            salloc->free(to_release);
+            to_release = nullptr;
+        }
+    });
+
+    auto p0 = salloc->alloc(1000), p1 = salloc->alloc(1000);
+    ASSERT_EQ(0u, nr_cb);
+    salloc->free(p0);
+    // the cached chunk of p0 is released when the soft limit is crossed
+    auto p2 = salloc->alloc(1500);
+    ASSERT_EQ(1u, raw_alloc->nr_free());
+    ASSERT_EQ(1u, nr_cb);
+    ASSERT_EQ(TOT - 2500, raw_alloc->free_size());
+
+    // memory released by the callback is reclaimed
+    to_release = p1;
+    auto p3 = salloc->alloc(1000);
+    ASSERT_EQ(2u, nr_cb);
+    ASSERT_EQ(2u, raw_alloc->nr_free());
+    ASSERT_EQ(TOT - 2500, raw_alloc->free_size());
+
+    ASSERT_THROW(salloc->alloc(1000), MemAllocError);
+    ASSERT_EQ(TOT - 2500, raw_alloc->free_size());
+
+    salloc->free(p2);
+    salloc->free(p3);
+    dev_alloc->gather_stream_free_blk_and_release_full();
+    ASSERT_EQ(TOT, raw_alloc->free_size());
+}
+
 TEST(TestMemAlloc, RandomOprs) {
     const size_t DEALLOC_PROB = std::mt19937::max() * 0.4;
     constexpr size_t NR_THREAD = 4, NR_RUN = 2000, MIN_REQ = 1, MAX_REQ = 513,
@@ -620,6 +755,48 @@ TEST(TestCudaMemAlloc, FreeMem) {
     };
     test_free_mem(loc0, loc1, policy.get(), reserve, restore);
 }
+
+#if CUDART_VERSION >= 11020
+TEST(TestCudaMemAlloc, AsyncAlloc) {
+    REQUIRE_GPU(1);
+    int supported = 0;
+    MGB_CUDA_CHECK(
+            cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported, 0));
+    if (!supported) {
+        printf("skip testcase due to memory pools not supported\n");
+        return;
+    }
+    CompNode::finalize();
+    constexpr const char* KEY = "MGB_CUDA_MEM_ALLOC";
+    auto old_value = getenv(KEY);
+    setenv(KEY, "async", 1);
+    auto run = []() {
+        auto cn0 = CompNode::load("gpu0"), cn1 = CompNode::load("gpu0:1");
+        HostTensorGenerator<> gen;
+        auto host_x = gen({1234});
+        {
+            DeviceTensorND x0{cn0}, x1{cn1};
+            x0.copy_from(*host_x);
+            x1.copy_from(x0);
+            ASSERT_GE(cn0.get_used_memory(), host_x->layout().span().dist_byte() * 2);
+            HostTensorND host_y;
+            host_y.copy_from(x1).sync();
+            MGB_ASSERT_TENSOR_EQ(*host_x, host_y);
+        }
+        ASSERT_EQ(0u, cn0.get_used_memory());
+        CompNode::try_coalesce_all_free_memory();
+    };
+    MGB_TRY { run(); }
+    MGB_FINALLY({
+        if (old_value) {
+            setenv(KEY, old_value, 1);
+        } else {
+            unsetenv(KEY);
+        }
+        CompNode::finalize();
+    });
+}
+#endif
 #endif  // MGB_CUDA
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
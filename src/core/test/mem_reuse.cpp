@@ -289,6 +289,41 @@ TEST(TestMemReuse, RtDynamicMemFwdSubgraph) {
     }
 }
 
+TEST(TestMemReuse, IncrementalPlan) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({8, 4}), host_w = gen({64, 4});
+    auto graph = ComputingGraph::make();
+    graph->options().seq_opt.enable_incremental_mem_plan = true;
+    // always take the incremental plan to check its correctness
+    graph->options().seq_opt.incremental_mem_plan_frag_threshold = 100;
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+         w = opr::SharedDeviceTensor::make(*graph, *host_w), a = x * 2 + 1,
+         b = opr::Concat::make({a, w * 3}, 0), c = b + b;
+    HostTensorND host_c;
+    size_t nr_alloc = 0;
+    auto hdl = graph->event().register_receiver<cg::event::StaticMemAlloc>(
+            [&](const cg::event::StaticMemAlloc& s) {
+                if (s.comp_node.valid()) {
+                    ++nr_alloc;
+                }
+            });
+    auto func = graph->compile({make_callback_copy(c, host_c)});
+    for (size_t n : {8, 16, 4, 32, 8}) {
+        *host_x = *gen({n, 4});
+        func->execute();
+        ASSERT_EQ(TensorShape({n + 64, 4}), host_c.shape());
+        auto px = host_x->ptr<float>(), pw = host_w->ptr<float>(),
+             pc = host_c.ptr<float>();
+        for (size_t i = 0; i < n * 4; ++i) {
+            MGB_ASSERT_FLOAT_EQ((px[i] * 2 + 1) * 2, pc[i]);
+        }
+        for (size_t i = 0; i < 64 * 4; ++i) {
+            MGB_ASSERT_FLOAT_EQ(pw[i] * 6, pc[n * 4 + i]);
+        }
+    }
+    ASSERT_EQ(5u, nr_alloc);
+}
+
 TEST(TestMemReuse, FwdNoSysMemAlloc) {
     HostTensorGenerator<> gen;
     auto host_x = gen({8, 4});
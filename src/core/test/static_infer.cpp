@@ -250,6 +250,44 @@ TEST(TestStaticInfer, SrcChangeDetection) {
     ASSERT_EQ(0, tshp_mid.reset_prev_val()->layout().stride[0]);
 }
 
+TEST(TestStaticInfer, Memo) {
+    HostTensorGenerator<> gen;
+
+    HostTensorND host_tshp(CompNode::default_cpu());
+    host_tshp.dtype(dtype::Int32()).resize({1});
+    host_tshp.ptr<int>()[0] = 2;
+
+    auto graph = ComputingGraph::make();
+    graph->options().static_infer_memo_size = 2;
+    auto x0 = opr::Host2DeviceCopy::make(*graph, gen({1}));
+    auto&& tshp_src = StaticInferSrcValueInjector::make(
+            graph.get(), host_tshp, x0.node()->comp_node());
+    auto&& tshp_mid = StaticInferMidValueInjector::make(tshp_src.output(0));
+
+    auto y = x0.broadcast(tshp_mid.output(0));
+    tshp_src.reset_infer_called();
+    tshp_mid.reset_prev_val();
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+
+    // whether the infer func of the mid value is called
+    auto run = [&](int size) {
+        host_tshp.ptr<int>()[0] = size;
+        func->execute();
+        EXPECT_EQ(TensorShape({static_cast<size_t>(size)}), host_y.shape());
+        EXPECT_TRUE(tshp_src.reset_infer_called());
+        return tshp_mid.reset_prev_val() != nullptr;
+    };
+    run(2);
+    ASSERT_TRUE(run(3));
+    ASSERT_FALSE(run(2));
+    ASSERT_FALSE(run(3));
+    ASSERT_TRUE(run(4));
+    // 2 has been dropped by the more recent 3 and 4
+    ASSERT_TRUE(run(2));
+    ASSERT_FALSE(run(4));
+}
+
 TEST(TestStaticInfer, AsImmutableScalar) {
     auto graph = ComputingGraph::make();
     HostTensorGenerator<dtype::Int32> gen;
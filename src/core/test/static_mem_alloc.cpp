@@ -3,6 +3,8 @@
 #include "megbrain/utils/arith_helper.h"
 #include "megbrain/utils/timer.h"
 
+#include <dirent.h>
+#include <fstream>
 #include <random>
 
 using namespace mgb;
@@ -13,7 +15,7 @@ using namespace cg;
         "static_mem_alloc disabled because it causes the program to crash at startup"
 #else
 
-#define ITER_ALGO(cb) cb(INTERVAL_MOVE) cb(BEST_FIT) cb(PUSHDOWN)
+#define ITER_ALGO(cb) cb(INTERVAL_MOVE) cb(BEST_FIT) cb(PUSHDOWN) cb(GREEDY_BY_SIZE)
 
 namespace {
 
@@ -234,6 +236,77 @@ TEST(TestStaticMemAllocAlgo, PushdownConsistence) {
         ASSERT_EQ(NR + NR - 1, allocator->tot_alloc());
     }
 }
+TEST(TestStaticMemAllocAlgo, GreedyBySizeChain) {
+    auto allocator =
+            StaticMemAlloc::make(StaticMemAlloc::AllocatorAlgo::GREEDY_BY_SIZE);
+    constexpr size_t NR = 100;
+    for (size_t i = 0; i < NR; ++i)
+        allocator->add(i, i + 2, i + 1, makeuk(i));
+    allocator->solve();
+    ASSERT_EQ(NR + NR - 1, allocator->tot_alloc_lower_bound());
+    ASSERT_EQ(NR + NR - 1, allocator->tot_alloc());
+}
+
+/*!
+ * replay the interval lists dumped by MGB_DUMP_INTERVAL_LIST_DIR from real
+ * models with every allocator algo, and report the peak over lower bound with
+ * the solve time; the dump dir is given by
+ * MGB_STATIC_MEM_ALLOC_BENCHMARK_DIR and the alignment by
+ * MGB_STATIC_MEM_ALLOC_BENCHMARK_ALIGN (default 64)
+ */
+TEST(TestStaticMemAllocAlgo, BenchmarkIntervalDump) {
+    auto dir = MGB_GETENV("MGB_STATIC_MEM_ALLOC_BENCHMARK_DIR");
+    if (!dir)
+        return;
+    size_t alignment = 64;
+    if (auto env = MGB_GETENV("MGB_STATIC_MEM_ALLOC_BENCHMARK_ALIGN"))
+        alignment = std::stoul(env);
+
+    std::vector<std::string> files;
+    auto dp = opendir(dir);
+    ASSERT_TRUE(dp) << "failed to open " << dir;
+    while (auto ent = readdir(dp)) {
+        std::string name = ent->d_name;
+        if (name.find("mgb-interval-") == 0)
+            files.push_back(std::string{dir} + "/" + name);
+    }
+    closedir(dp);
+    std::sort(files.begin(), files.end());
+
+    for (auto&& fpath : files) {
+        auto run = [&](StaticMemAlloc::AllocatorAlgo algo, const char* algo_name) {
+            std::ifstream fin(fpath);
+            ASSERT_TRUE(fin.good()) << "failed to open " << fpath;
+            auto allocator = StaticMemAlloc::make(algo);
+            allocator->alignment(alignment);
+            size_t nr_interval, nr_overwrite;
+            fin >> nr_interval;
+            for (size_t i = 0; i < nr_interval; ++i) {
+                size_t begin, end, size;
+                fin >> begin >> end >> size;
+                allocator->add(begin, end, size, makeuk(i));
+            }
+            fin >> nr_overwrite;
+            for (size_t i = 0; i < nr_overwrite; ++i) {
+                size_t src, dest, offset;
+                fin >> src >> dest >> offset;
+                allocator->add_overwrite_spec(src, dest, offset);
+            }
+            RealTimer timer;
+            allocator->solve();
+            auto time = timer.get_msecs();
+            auto sz_tot = allocator->tot_alloc(),
+                 sz_lower = allocator->tot_alloc_lower_bound();
+            mgb_log("%s: algo=%s nr_interval=%zu time=%.3fms size=%zu/%zu "
+                    "cost=%.3f",
+                    fpath.c_str(), algo_name, nr_interval, time, sz_tot, sz_lower,
+                    double(sz_tot) / sz_lower - 1);
+        };
+#define itcb(algo) run(StaticMemAlloc::AllocatorAlgo::algo, #algo);
+        ITER_ALGO(itcb)
+#undef itcb
+    }
+}
 #endif  // WIN32
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
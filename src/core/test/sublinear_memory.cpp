@@ -19,11 +19,22 @@ namespace cg {
 class SeqModifierForSublinearMemory {
 public:
     const CompNode::UnorderedMap<size_t>& prev_min_bottleneck();
+    const CompNode::UnorderedMap<double>& prev_recomp_overhead();
 };
 
+#if MGB_ENABLE_DTR
+class SeqModifierForDTR {
+public:
+    const CompNode::UnorderedMap<size_t>& prev_peak_usage();
+};
+#endif
+
 class ComputingGraphImpl : public ComputingGraph {
 public:
     SeqModifierForSublinearMemory& seq_modifier_for_sublinear_memory();
+#if MGB_ENABLE_DTR
+    SeqModifierForDTR& seq_modifier_for_dtr();
+#endif
 };
 
 };  // namespace cg
@@ -563,6 +574,106 @@ TEST(TestSublinearMemory, BadOpr) {
     }
 }
 
+TEST(TestSublinearMemory, Budget) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("xpu0");
+    constexpr size_t N = 1 << 16, NR_LAYER = 16;
+    auto host_x = gen({N}, cn);
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make_no_fwd(*graph, host_x), y = x;
+    for (size_t i = 0; i < NR_LAYER; ++i) {
+        y = opr::sin(y);
+    }
+    auto loss = opr::reduce_sum(y, y.make_scalar(1));
+    HostTensorND host_gx, expect_gx;
+    ComputingGraph::OutputSpec out_spec{
+            make_callback_copy(cg::grad(loss, x), host_gx)};
+    graph->options().graph_opt_level = 0;
+
+    auto run = [&](bool sublinear, int budget_mb) {
+        graph->options().enable_sublinear_memory_opt = sublinear;
+        graph->options().sublinear_mem_config.budget_memory_mb = budget_mb;
+        auto func = graph->compile(out_spec);
+        func->execute();
+        size_t nr_opr = 0;
+        func->iter_opr_seq([&nr_opr](cg::OperatorNodeBase*) {
+            ++nr_opr;
+            return true;
+        });
+        return nr_opr;
+    };
+    auto&& modifier = static_cast<cg::ComputingGraphImpl*>(graph.get())
+                              ->seq_modifier_for_sublinear_memory();
+
+    auto nr_opr_expect = run(false, 0);
+    expect_gx.copy_from(host_gx);
+
+    // the unmodified sequence fits in a large budget, so nothing is recomputed
+    auto nr_opr = run(true, 1024);
+    MGB_ASSERT_TENSOR_EQ(expect_gx, host_gx);
+    ASSERT_EQ(0., modifier.prev_recomp_overhead().at(cn));
+    ASSERT_EQ(nr_opr_expect, nr_opr);
+    ASSERT_LE(modifier.prev_min_bottleneck().at(cn), 1024u << 20);
+
+    // without a budget the bottleneck is minimized by recomputation
+    run(true, 0);
+    MGB_ASSERT_TENSOR_EQ(expect_gx, host_gx);
+    size_t min_bottleneck = modifier.prev_min_bottleneck().at(cn);
+    ASSERT_LT(min_bottleneck, N * NR_LAYER * sizeof(dt_float32));
+}
+
+#if MGB_ENABLE_DTR
+TEST(TestSublinearMemory, DTRStaticPlan) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("xpu0");
+    constexpr size_t N = 1 << 16, NR_LAYER = 16;
+    auto host_x = gen({N}, cn);
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make_no_fwd(*graph, host_x), y = x;
+    for (size_t i = 0; i < NR_LAYER; ++i) {
+        y = opr::sin(y);
+    }
+    auto loss = opr::reduce_sum(y, y.make_scalar(1));
+    HostTensorND host_gx, expect_gx;
+    ComputingGraph::OutputSpec out_spec{
+            make_callback_copy(cg::grad(loss, x), host_gx)};
+    graph->options().graph_opt_level = 0;
+    graph->options().dtr_config.evictee_minimum_size = 0;
+
+    size_t nr_opr = 0;
+    auto run = [&](bool dtr, size_t threshold) {
+        graph->options().enable_dtr_memory_opt = dtr;
+        graph->options().dtr_config.eviction_threshold = threshold;
+        auto func = graph->compile(out_spec);
+        // the plan is fixed at compile time, so every execution is the same
+        for (int i = 0; i < 2; ++i) {
+            func->execute();
+            MGB_ASSERT_TENSOR_EQ(expect_gx, host_gx);
+        }
+        nr_opr = 0;
+        func->iter_opr_seq([&](cg::OperatorNodeBase*) {
+            ++nr_opr;
+            return true;
+        });
+    };
+    auto&& modifier = static_cast<cg::ComputingGraphImpl*>(graph.get())
+                              ->seq_modifier_for_dtr();
+
+    graph->options().enable_dtr_memory_opt = false;
+    graph->compile(out_spec)->execute();
+    expect_gx.copy_from(host_gx);
+
+    run(true, 1ULL << 30);
+    auto nr_opr_expect = nr_opr;
+    size_t peak_no_evict = modifier.prev_peak_usage().at(cn);
+    ASSERT_GT(peak_no_evict, N * NR_LAYER * sizeof(dt_float32) / 2);
+
+    run(true, peak_no_evict / 2);
+    ASSERT_GT(nr_opr, nr_opr_expect);
+    ASSERT_LT(modifier.prev_peak_usage().at(cn), peak_no_evict);
+}
+#endif  // MGB_ENABLE_DTR
+
 #else
 #pragma message "tests are disabled as Sublinear is not enabled."
 #endif  // MGB_ENABLE_SUBLINEAR
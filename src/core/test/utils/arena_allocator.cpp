@@ -0,0 +1,73 @@
+#include "megbrain/utils/arena_allocator.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/io.h"
+#include "megbrain/test/helper.h"
+
+using namespace mgb;
+
+TEST(TestArenaAllocator, Alloc) {
+    ArenaAllocator arena;
+    std::vector<uint8_t*> ptrs;
+    for (size_t i = 1; i < 1000; i += 7) {
+        auto ptr = static_cast<uint8_t*>(arena.alloc(i, 8));
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 8);
+        memset(ptr, i & 0xff, i);
+        ptrs.push_back(ptr);
+    }
+    // large request gets its own buffer
+    auto large = static_cast<uint8_t*>(arena.alloc(1 << 20, 16));
+    memset(large, 0, 1 << 20);
+    for (size_t i = 1, j = 0; i < 1000; i += 7, ++j) {
+        for (size_t k = 0; k < i; ++k) {
+            ASSERT_EQ(i & 0xff, ptrs[j][k]);
+        }
+    }
+    ASSERT_GE(arena.nr_alloc_bytes(), size_t(1 << 20));
+}
+
+TEST(TestArenaAllocator, Scope) {
+    ArenaAllocator a0, a1;
+    ASSERT_EQ(nullptr, ArenaAllocator::current());
+    {
+        ArenaAllocator::Scope s0{&a0};
+        ASSERT_EQ(&a0, ArenaAllocator::current());
+        {
+            ArenaAllocator::Scope s1{&a1};
+            ASSERT_EQ(&a1, ArenaAllocator::current());
+            ArenaAllocator::Scope s2{nullptr};
+            ASSERT_EQ(nullptr, ArenaAllocator::current());
+        }
+        ASSERT_EQ(&a0, ArenaAllocator::current());
+    }
+    ASSERT_EQ(nullptr, ArenaAllocator::current());
+}
+
+TEST(TestArenaAllocator, GraphOpr) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({23});
+    HostTensorND host_y;
+    auto graph = ComputingGraph::make();
+    auto arena = graph->node_arena();
+    ASSERT_NE(nullptr, arena);
+    SymbolVar y;
+    {
+        ArenaAllocator::Scope scope{arena};
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+        y = x + x * 2;
+        ASSERT_GT(arena->nr_alloc_bytes(), 0u);
+    }
+    auto size = arena->nr_alloc_bytes();
+    // oprs created out of the scope come from heap
+    auto z = y + 1;
+    ASSERT_EQ(size, arena->nr_alloc_bytes());
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+    func->execute();
+    auto px = host_x->ptr<float>();
+    auto py = host_y.ptr<float>();
+    for (size_t i = 0; i < 23; ++i) {
+        MGB_ASSERT_FLOAT_EQ(px[i] * 3, py[i]);
+    }
+    MGB_MARK_USED_VAR(z);
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,96 @@
+#include "megbrain/utils/infile_persistent_cache.h"
+#include "megbrain/test/helper.h"
+
+#include <thread>
+
+using namespace mgb;
+
+namespace {
+PersistentCache::Blob blob(const std::string& str) {
+    return {str.data(), str.size()};
+}
+
+std::string get(
+        InFilePersistentCache& cache, const std::string& category,
+        const std::string& key) {
+    auto ret = cache.get(category, blob(key));
+    if (!ret.valid())
+        return {};
+    return {static_cast<const char*>(ret->ptr), ret->size};
+}
+}  // namespace
+
+TEST(TestInFilePersistentCache, MergeDiffPrune) {
+    InFilePersistentCache cache0, cache1;
+    cache0.put("plat=cpu:conv", blob("k0"), blob("v0"));
+    cache0.put("plat=cpu:conv", blob("k1"), blob("v1"));
+    cache1.put("plat=cpu:conv", blob("k1"), blob("v1_new"));
+    cache1.put("plat=cpu:conv", blob("k2"), blob("v2"));
+    cache1.put("plat=cuda;dev=x:conv", blob("k0"), blob("v3"));
+
+    auto diff = cache0.diff(cache1);
+    ASSERT_EQ(2u, diff.size());
+    ASSERT_EQ("plat=cpu:conv", diff[0].category);
+    ASSERT_EQ(1u, diff[0].nr_only_self);
+    ASSERT_EQ(1u, diff[0].nr_only_other);
+    ASSERT_EQ(1u, diff[0].nr_different);
+    ASSERT_EQ("plat=cuda;dev=x:conv", diff[1].category);
+    ASSERT_EQ(0u, diff[1].nr_only_self);
+    ASSERT_EQ(1u, diff[1].nr_only_other);
+
+    // only the missing entries are added by default
+    ASSERT_EQ(2u, cache0.merge(cache1));
+    ASSERT_EQ("v1", get(cache0, "plat=cpu:conv", "k1"));
+    ASSERT_EQ("v2", get(cache0, "plat=cpu:conv", "k2"));
+    ASSERT_EQ("v3", get(cache0, "plat=cuda;dev=x:conv", "k0"));
+    ASSERT_EQ(0u, cache0.merge(cache1));
+    ASSERT_EQ(1u, cache0.merge(cache1, true));
+    ASSERT_EQ("v1_new", get(cache0, "plat=cpu:conv", "k1"));
+
+    auto diff1 = cache1.diff(cache0);
+    ASSERT_EQ(1u, diff1.size());
+    ASSERT_EQ(1u, diff1[0].nr_only_other);
+
+    ASSERT_EQ(1u, cache0.prune([](const std::string& category) {
+        return category.find("plat=cpu") == 0;
+    }));
+    auto summary = cache0.summary();
+    ASSERT_EQ(1u, summary.size());
+    ASSERT_EQ("plat=cpu:conv", summary[0].first);
+    ASSERT_EQ(3u, summary[0].second);
+
+    // the merged cache survives a dump round trip
+    auto buf = cache0.dump_cache();
+    InFilePersistentCache cache2{buf.data(), buf.size()};
+    ASSERT_TRUE(cache2.diff(cache0).empty());
+    ASSERT_EQ("v0", get(cache2, "plat=cpu:conv", "k0"));
+}
+
+TEST(TestInFilePersistentCache, LongCategory) {
+    InFilePersistentCache cache0;
+    std::string category(1000, 'c');
+    cache0.put(category, blob("k"), blob("v"));
+    auto buf = cache0.dump_cache();
+    InFilePersistentCache cache1{buf.data(), buf.size()};
+    ASSERT_EQ("v", get(cache1, category, "k"));
+}
+
+TEST(TestInFilePersistentCache, MergeEachOther) {
+    InFilePersistentCache cache0, cache1;
+    cache0.put("plat=cpu:conv", blob("k0"), blob("v0"));
+    cache1.put("plat=cpu:conv", blob("k1"), blob("v1"));
+    //! would deadlock if each merge locked its own cache first
+    auto merge = [](InFilePersistentCache* dst, InFilePersistentCache* src) {
+        for (int i = 0; i < 10000; ++i)
+            dst->merge(*src, true);
+    };
+    std::thread worker{merge, &cache1, &cache0};
+    merge(&cache0, &cache1);
+    worker.join();
+    for (auto cache : {&cache0, &cache1}) {
+        ASSERT_EQ("v0", get(*cache, "plat=cpu:conv", "k0"));
+        ASSERT_EQ("v1", get(*cache, "plat=cpu:conv", "k1"));
+    }
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,86 @@
+#include "megbrain/utils/logfile_persistent_cache.h"
+#include "megbrain/test/helper.h"
+#include "megbrain/utils/infile_persistent_cache.h"
+
+#include <cstdio>
+
+using namespace mgb;
+
+namespace {
+PersistentCache::Blob blob(const std::string& str) {
+    return {str.data(), str.size()};
+}
+
+std::string get(
+        PersistentCache& cache, const std::string& category, const std::string& key) {
+    auto ret = cache.get(category, blob(key));
+    if (!ret.valid())
+        return {};
+    return {static_cast<const char*>(ret->ptr), ret->size};
+}
+
+size_t file_size(const std::string& path) {
+    FILE* fp = fopen(path.c_str(), "rb");
+    mgb_assert(fp);
+    fseek(fp, 0, SEEK_END);
+    size_t ret = ftell(fp);
+    fclose(fp);
+    return ret;
+}
+}  // namespace
+
+TEST(TestLogFilePersistentCache, SharedFile) {
+    auto path = output_file("TestLogFilePersistentCache.SharedFile");
+    remove(path.c_str());
+    // two caches on one file act like two processes
+    LogFilePersistentCache cache0{path.c_str()}, cache1{path.c_str()};
+    cache0.put("plat=cpu:conv", blob("k0"), blob("v0"));
+    cache1.put("plat=cpu:conv", blob("k1"), blob("v1"));
+    ASSERT_EQ("v1", get(cache0, "plat=cpu:conv", "k1"));
+    ASSERT_EQ("v0", get(cache1, "plat=cpu:conv", "k0"));
+    ASSERT_EQ("", get(cache1, "plat=cpu:conv", "k2"));
+
+    // the later record overrides, and an unchanged value is not appended
+    cache1.put("plat=cpu:conv", blob("k0"), blob("v0_new"));
+    auto size = file_size(path);
+    cache1.put("plat=cpu:conv", blob("k0"), blob("v0_new"));
+    ASSERT_EQ(size, file_size(path));
+    ASSERT_EQ(1u, cache0.sync());
+    ASSERT_EQ("v0_new", get(cache0, "plat=cpu:conv", "k0"));
+
+    LogFilePersistentCache cache2{path.c_str()};
+    ASSERT_EQ("v0_new", get(cache2, "plat=cpu:conv", "k0"));
+    ASSERT_EQ("v1", get(cache2, "plat=cpu:conv", "k1"));
+
+    auto buf = cache2.dump_cache();
+    InFilePersistentCache cache3{buf.data(), buf.size()};
+    ASSERT_EQ("v0_new", get(cache3, "plat=cpu:conv", "k0"));
+    ASSERT_EQ(2u, cache3.summary()[0].second);
+}
+
+TEST(TestLogFilePersistentCache, IncompleteRecord) {
+    auto path = output_file("TestLogFilePersistentCache.IncompleteRecord");
+    remove(path.c_str());
+    {
+        LogFilePersistentCache cache{path.c_str()};
+        cache.put("cat", blob("k0"), blob("v0"));
+    }
+    // simulate a writer crashed in the middle of a record
+    size_t size = file_size(path);
+    FILE* fp = fopen(path.c_str(), "ab");
+    uint32_t category_size = 3;
+    fwrite(&category_size, sizeof(category_size), 1, fp);
+    fwrite("ca", 2, 1, fp);
+    fclose(fp);
+
+    LogFilePersistentCache cache{path.c_str()};
+    ASSERT_EQ("v0", get(cache, "cat", "k0"));
+    cache.put("cat", blob("k1"), blob("v1"));
+    ASSERT_EQ(size * 2 - 8, file_size(path));
+
+    LogFilePersistentCache cache1{path.c_str()};
+    ASSERT_EQ("v0", get(cache1, "cat", "k0"));
+    ASSERT_EQ("v1", get(cache1, "cat", "k1"));
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -21,6 +21,39 @@ public:
     void process_one_task(const thin_function<void()>& task) { task(); }
 };
 
+class RingFuncExecutor final
+        : public AsyncRingQueueSC<thin_function<void()>, RingFuncExecutor> {
+public:
+    RingFuncExecutor(ptrdiff_t max_items = -1)
+            : AsyncRingQueueSC<thin_function<void()>, RingFuncExecutor>(
+                      -1, max_items) {}
+
+    void process_one_task(const thin_function<void()>& task) { task(); }
+};
+
+/*!
+ * \brief time to add and finish N tasks through given queue, in nanoseconds
+ *      per task
+ */
+template <class Queue>
+std::pair<double, double> benchmark_queue(Queue& queue, int N) {
+    int nr_call = 0;
+    auto func = [&nr_call](int i) __attribute__((noinline)) {
+        asm volatile("" : : "r"(i / 12345));
+        ++nr_call;
+    };
+    RealTimer timer;
+    for (int i = 0; i < N; ++i) {
+        auto g = [func, i]() { func(i); };
+        queue.add_task(g);
+    }
+    auto t_add = timer.get_secs() * 1e9 / N;
+    queue.wait_all_task_finish();
+    auto t_all = timer.get_secs() * 1e9 / N;
+    mgb_assert(nr_call == N);
+    return {t_add, t_all};
+}
+
 template <int producer_sleep, int consumer_sleep>
 void test_scq_sync_multi_producer() {
     size_t nr_worker_call = 0;
@@ -400,6 +433,163 @@ TEST(TestAsyncQueue, Benchmark) {
     ASSERT_EQ(N * 5, nr_call);
 }
 
+TEST(TestAsyncQueue, RingCorrectness) {
+    class Adder final : public AsyncRingQueueSC<int, Adder> {
+        int m_sum = 0;
+        std::mt19937 m_rng;
+
+    public:
+        //! use a small ring to cover waiting on full ring and adding tasks
+        //! from the worker into a full ring; do not spin so the producers
+        //! could make progress on a single core
+        Adder() : AsyncRingQueueSC<int, Adder>(0, 16) {}
+
+        void process_one_task(int val) {
+            if ((m_rng() & 2)) {
+                add_task(val);
+            } else {
+                m_sum += val;
+            }
+        }
+
+        int sum() const { return m_sum; }
+    };
+    Adder adder;
+    std::atomic_size_t nr_started{0};
+    auto worker = [&](bool neg) {
+        ++nr_started;
+        while (nr_started != 2)
+            ;
+        for (int i = 0; i < 10000; ++i)
+            adder.add_task(neg ? i : -i);
+        adder.add_task(neg);
+    };
+
+    std::thread th0(worker, false), th1(worker, true);
+    th0.join();
+    th1.join();
+    adder.wait_task_queue_empty();
+    ASSERT_EQ(1, adder.sum());
+    ASSERT_TRUE(adder.all_task_finished());
+}
+
+TEST(TestAsyncQueue, RingMultiProducerFull) {
+    //! a tiny ring keeps it full, so most producers wait for a slot while the
+    //! worker is in the middle of a batch; the tasks re-added by the worker
+    //! are spilled, which makes a batch cover more tickets than the ring
+    class Counter final : public AsyncRingQueueSC<size_t, Counter> {
+        std::mt19937 m_rng;
+
+    public:
+        size_t sum = 0, nr_task = 0;
+
+        Counter() : AsyncRingQueueSC<size_t, Counter>(0, 4) {}
+
+        void process_one_task(size_t val) {
+            if (m_rng() & 1) {
+                add_task(val);
+                return;
+            }
+            sum += val;
+            ++nr_task;
+        }
+    };
+    constexpr size_t nr_producer = 8, nr_task_per_producer = 20000;
+    Counter counter;
+    std::atomic_size_t nr_started{0};
+    auto producer = [&](size_t idx) {
+        ++nr_started;
+        while (nr_started != nr_producer)
+            ;
+        for (size_t i = 0; i < nr_task_per_producer; ++i) {
+            counter.add_task(idx * nr_task_per_producer + i);
+            if (i % 5000 == 4999) {
+                counter.wait_all_task_finish();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nr_producer; ++i) {
+        threads.emplace_back(producer, i);
+    }
+    for (auto&& i : threads) {
+        i.join();
+    }
+    counter.wait_all_task_finish();
+    constexpr size_t tot = nr_producer * nr_task_per_producer;
+    ASSERT_EQ(tot, counter.nr_task);
+    ASSERT_EQ(tot * (tot - 1) / 2, counter.sum);
+    ASSERT_TRUE(counter.all_task_finished());
+}
+
+#if MGB_ENABLE_EXCEPTION
+TEST(TestAsyncQueue, RingException) {
+    class ExcMaker final : public AsyncRingQueueSC<int, ExcMaker> {
+    public:
+        int sum = 0;
+        void process_one_task(int val) {
+            if (val < 0) {
+                throw std::runtime_error("test");
+            }
+            sum += val;
+        }
+    };
+    ExcMaker exc_maker;
+    exc_maker.wait_all_task_finish();
+    for (int i = 0; i < 10; ++i) {
+        exc_maker.add_task(i == 5 ? -1 : i);
+    }
+    ASSERT_THROW(exc_maker.wait_all_task_finish(), std::runtime_error);
+    exc_maker.wait_all_task_finish();
+    // the tasks after the failed one are still processed
+    ASSERT_EQ(40, exc_maker.sum);
+}
+#endif
+
+TEST(TestAsyncQueue, RingBatchFinish) {
+    //! sums the tasks lazily, and publishes the sum when the batch finishes
+    class LazyAdder final : public AsyncRingQueueSC<int, LazyAdder> {
+        int m_pending = 0;
+
+    public:
+        int sum = 0;
+
+        LazyAdder() : AsyncRingQueueSC<int, LazyAdder>(0, 16) {}
+
+        void process_one_task(int val) { m_pending += val; }
+
+        void on_async_queue_batch_finish() override {
+            sum += m_pending;
+            m_pending = 0;
+        }
+    };
+    LazyAdder adder;
+    for (int i = 0; i < 100; ++i) {
+        adder.add_task(i);
+        if (i % 30 == 0) {
+            // no task is finished before its batch
+            adder.wait_all_task_finish();
+            ASSERT_EQ(i * (i + 1) / 2, adder.sum);
+        }
+    }
+    adder.wait_all_task_finish();
+    ASSERT_EQ(4950, adder.sum);
+}
+
+TEST(TestAsyncQueue, BenchmarkRing) {
+    constexpr int N = 100000;
+    FuncExecutor queue;
+    // the producer never waits for a full ring in the first case
+    RingFuncExecutor ring_queue{N}, small_ring_queue;
+    auto t0 = benchmark_queue(queue, N);
+    auto t1 = benchmark_queue(ring_queue, N);
+    auto t2 = benchmark_queue(small_ring_queue, N);
+    printf("time_per_iter: queue=(add=%.3f,all=%.3f) "
+           "ring_queue=(add=%.3f,all=%.3f) small_ring_queue=(add=%.3f,all=%.3f) "
+           "[ns]\n",
+           t0.first, t0.second, t1.first, t1.second, t2.first, t2.second);
+}
+
 TEST(TestThread, Spinlock) {
     Spinlock lock;
     int cnt = 0;
@@ -52,6 +52,111 @@ TEST(TestThreadPool, BASIC) {
     }
 }
 
+TEST(TestThreadPool, WORK_STEALING) {
+    auto thread_pool = std::make_shared<ThreadPool>(
+            4u, ThreadPool::ScheduleMode::WORK_STEALING);
+    ASSERT_EQ(thread_pool->schedule_mode(), ThreadPool::ScheduleMode::WORK_STEALING);
+    for (size_t total_task : {1, 3, 4, 37, 1000}) {
+        std::vector<std::atomic_size_t> visit(total_task);
+        for (auto&& i : visit) {
+            i = 0;
+        }
+        //! the first quarter of tasks is much heavier than the others, so the
+        //! thread owning them should be helped by the other threads
+        auto func = [&](size_t index, size_t thread_id) {
+            ASSERT_LT(thread_id, 4u);
+            visit[index]++;
+            if (index < total_task / 4) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        };
+        thread_pool->active();
+        thread_pool->add_task({func, total_task});
+        thread_pool->deactive();
+        for (size_t i = 0; i < total_task; i++) {
+            ASSERT_EQ(visit[i], 1u) << "task " << i << " of " << total_task;
+        }
+    }
+
+    //! switch back to shared counter and make sure it still works
+    thread_pool->set_schedule_mode(ThreadPool::ScheduleMode::SHARED_COUNTER);
+    std::atomic_size_t count{0};
+    thread_pool->active();
+    thread_pool->add_task({[&](size_t, size_t) { count++; }, 100});
+    thread_pool->deactive();
+    ASSERT_EQ(count, 100u);
+}
+
+TEST(TestThreadPool, SPEED_WEIGHTED) {
+    auto thread_pool = std::make_shared<ThreadPool>(
+            4u, ThreadPool::ScheduleMode::SPEED_WEIGHTED);
+    ASSERT_EQ(thread_pool->thread_speeds(), std::vector<float>(4, 1.f));
+    size_t total_task = 200;
+    for (size_t run = 0; run < 20; run++) {
+        std::vector<std::atomic_size_t> visit(total_task);
+        for (auto&& i : visit) {
+            i = 0;
+        }
+        //! thread 0 acts as a little core which is 4 times slower
+        auto func = [&](size_t index, size_t thread_id) {
+            visit[index]++;
+            std::this_thread::sleep_for(
+                    std::chrono::microseconds(thread_id == 0 ? 400 : 100));
+        };
+        thread_pool->active();
+        thread_pool->add_task({func, total_task});
+        thread_pool->deactive();
+        for (size_t i = 0; i < total_task; i++) {
+            ASSERT_EQ(visit[i], 1u) << "task " << i << " of run " << run;
+        }
+    }
+    auto speeds = thread_pool->thread_speeds();
+    ASSERT_EQ(speeds.size(), 4u);
+    for (size_t i = 1; i < 4; i++) {
+        ASSERT_LT(speeds[0], speeds[i]);
+    }
+
+    //! too few sub tasks to measure, the speeds are kept
+    thread_pool->active();
+    thread_pool->add_task({[](size_t, size_t) {}, 4});
+    thread_pool->deactive();
+    ASSERT_EQ(thread_pool->thread_speeds(), speeds);
+
+    thread_pool->reset_thread_speeds();
+    ASSERT_EQ(thread_pool->thread_speeds(), std::vector<float>(4, 1.f));
+}
+
+TEST(TestThreadPool, HYBRID_WAIT) {
+    auto thread_pool = std::make_shared<ThreadPool>(4u);
+    for (int64_t spin_us : {0, 50, 1000}) {
+        thread_pool->set_spin_budget(spin_us);
+        ASSERT_EQ(thread_pool->spin_budget(), spin_us);
+        thread_pool->reset_wait_stats();
+        for (size_t run = 0; run < 20; run++) {
+            std::atomic_size_t count{0};
+            thread_pool->active();
+            thread_pool->add_task({[&](size_t, size_t) { count++; }, 37});
+            thread_pool->deactive();
+            ASSERT_EQ(count, 37u);
+            //! let the workers fall asleep from time to time
+            if (run % 5 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(3));
+            }
+        }
+        auto stats = thread_pool->wait_stats();
+        ASSERT_GT(stats.nr_wakeup, 0u);
+        ASSERT_GE(stats.wakeup_latency_us, 0);
+    }
+    thread_pool->set_spin_budget(-1);
+    thread_pool->reset_wait_stats();
+    std::atomic_size_t count{0};
+    thread_pool->active();
+    thread_pool->add_task({[&](size_t, size_t) { count++; }, 37});
+    thread_pool->deactive();
+    ASSERT_EQ(count, 37u);
+    ASSERT_EQ(thread_pool->wait_stats().nr_wakeup, 0u);
+}
+
 TEST(TestGraph, ParallelRunMultithreadMode) {
     // check race conditions when graphs are executed on multple threads
     std::atomic_size_t sync_counter{0};
@@ -134,6 +134,10 @@ class CustomOpImpl {
     std::unordered_map<std::string, Process> preprocess_funcs;
     std::unordered_map<std::string, Process> postprocess_funcs;
 
+    //! output index => input index
+    std::unordered_map<size_t, size_t> m_inplace_map;
+    std::unordered_map<size_t, size_t> m_forward_map;
+
 public:
     CustomOpImpl(const std::string&, uint32_t version);
     PREVENT_COPY_AND_ASSIGN(CustomOpImpl);
@@ -302,6 +306,38 @@ CustomOp& CustomOp::set_compute(const std::string& device, ProcessFuncPtr func)
     return *this;
 }
 
+CustomOp& CustomOp::set_inplace(size_t output_idx, size_t input_idx) {
+    auto impl = OpImplRef(m_impl.get());
+    mgb_assert(
+            output_idx < output_num() && input_idx < input_num(),
+            "invalid inplace pair of op %s: output %zu, input %zu", op_type().c_str(),
+            output_idx, input_idx);
+    mgb_assert(
+            !impl->m_forward_map.count(output_idx),
+            "output %zu of op %s has been forwarded", output_idx, op_type().c_str());
+    for (auto&& i : impl->m_inplace_map) {
+        mgb_assert(
+                i.first == output_idx || i.second != input_idx,
+                "input %zu of op %s has been inplaced by output %zu", input_idx,
+                op_type().c_str(), i.first);
+    }
+    impl->m_inplace_map[output_idx] = input_idx;
+    return *this;
+}
+
+CustomOp& CustomOp::set_forward(size_t output_idx, size_t input_idx) {
+    auto impl = OpImplRef(m_impl.get());
+    mgb_assert(
+            output_idx < output_num() && input_idx < input_num(),
+            "invalid forward pair of op %s: output %zu, input %zu", op_type().c_str(),
+            output_idx, input_idx);
+    mgb_assert(
+            !impl->m_inplace_map.count(output_idx),
+            "output %zu of op %s has been inplaced", output_idx, op_type().c_str());
+    impl->m_forward_map[output_idx] = input_idx;
+    return *this;
+}
+
 CustomOp& CustomOp::set_description(const std::string& op_desc) {
     OpImplRef(m_impl.get())->m_op_desc = op_desc;
     return *this;
@@ -439,6 +475,18 @@ const std::vector<ArgInfo>& CustomOp::outputs_info(void) const {
     return OpImplRef(m_impl.get())->m_output_infos;
 }
 
+int CustomOp::inplace_input(size_t output_idx) const {
+    auto&& map = OpImplRef(m_impl.get())->m_inplace_map;
+    auto iter = map.find(output_idx);
+    return iter == map.end() ? -1 : static_cast<int>(iter->second);
+}
+
+int CustomOp::forward_input(size_t output_idx) const {
+    auto&& map = OpImplRef(m_impl.get())->m_forward_map;
+    auto iter = map.find(output_idx);
+    return iter == map.end() ? -1 : static_cast<int>(iter->second);
+}
+
 std::vector<Device> CustomOp::infer_output_device(
         const std::vector<Device>& inputs, const Param& param) const {
     assert_inputs_size_right(inputs);
@@ -541,9 +589,12 @@ void CustomOp::compute(
             Device::is_legal(device_str), "unsupported device type: %s",
             device_str.c_str());
 
-    auto preprocess_func = OpImplRef(m_impl.get())->preprocess_funcs[device_str];
-    auto forward_func = OpImplRef(m_impl.get())->compute_funcs[device_str];
-    auto postprocess_func = OpImplRef(m_impl.get())->postprocess_funcs[device_str];
+    // the funcs of all legal devices are set in the ctor, so no one is copied
+    // or inserted here
+    auto impl = OpImplRef(m_impl.get());
+    auto&& preprocess_func = impl->preprocess_funcs.at(device_str);
+    auto&& forward_func = impl->compute_funcs.at(device_str);
+    auto&& postprocess_func = impl->postprocess_funcs.at(device_str);
 
     RuntimeArgs rt_args(device);
 
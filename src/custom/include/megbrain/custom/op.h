@@ -48,6 +48,52 @@ public:
     const Device& device() const { return m_device; }
 };
 
+/*!
+ * \brief dispatch to Kernel<T>::compute by the dtype of the first input (or of
+ * the first output if the op has no input), where T is the ctype of one of the
+ * given dtypes
+ *
+ * The kernels are instantiated for each dtype at compile time, so only one
+ * switch of the dtype happens in each call.
+ */
+template <template <typename> class Kernel, DTypeEnum... dtypes>
+struct TypedKernelDispatcher;
+
+template <template <typename> class Kernel>
+struct TypedKernelDispatcher<Kernel> {
+    static void run(
+            DTypeEnum dtype, const std::vector<Tensor>&, const Param&,
+            std::vector<Tensor>&, const RuntimeArgs&) {
+        custom_assert(
+                false, "no kernel is registered for dtype %s",
+                DType(dtype).str().c_str());
+    }
+};
+
+template <template <typename> class Kernel, DTypeEnum dtype, DTypeEnum... rest>
+struct TypedKernelDispatcher<Kernel, dtype, rest...> {
+    static void run(
+            DTypeEnum real_dtype, const std::vector<Tensor>& inputs,
+            const Param& param, std::vector<Tensor>& outputs,
+            const RuntimeArgs& rt_args) {
+        if (real_dtype == dtype) {
+            using ctype = typename DTypeTrait<dtype>::type;
+            Kernel<ctype>::compute(inputs, param, outputs, rt_args);
+        } else {
+            TypedKernelDispatcher<Kernel, rest...>::run(
+                    real_dtype, inputs, param, outputs, rt_args);
+        }
+    }
+
+    static void compute(
+            const std::vector<Tensor>& inputs, const Param& param,
+            std::vector<Tensor>& outputs, const RuntimeArgs& rt_args) {
+        auto&& tensors = inputs.empty() ? outputs : inputs;
+        custom_assert(!tensors.empty(), "op without inputs and outputs");
+        run(tensors[0].dtype().enumv(), inputs, param, outputs, rt_args);
+    }
+};
+
 class MGE_WIN_DECLSPEC_FUC CustomOp {
     std::unique_ptr<void, void_deleter> m_impl;
 
@@ -93,6 +139,41 @@ public:
     CustomOp& set_compute(
             const std::string& device, ProcessFuncPtrWithoutRuntimeArgs func);
 
+    /*!
+     * \brief set the compute function of a device as a kernel template, which is
+     * instantiated for each of the dtypes, e.g.
+     *
+     *   template <typename T>
+     *   struct AddKernel {
+     *       static void compute(
+     *               const std::vector<Tensor>& inputs, const Param& param,
+     *               std::vector<Tensor>& outputs, const RuntimeArgs& rt_args);
+     *   };
+     *   op.set_compute<AddKernel, DTypeEnum::float32, DTypeEnum::int32>("x86");
+     */
+    template <template <typename> class Kernel, DTypeEnum... dtypes>
+    CustomOp& set_compute(const std::string& device) {
+        static_assert(sizeof...(dtypes) > 0, "no dtype is given");
+        ProcessFuncPtr func = &TypedKernelDispatcher<Kernel, dtypes...>::compute;
+        return set_compute(device, func);
+    }
+
+    /*!
+     * \brief let an output reuse the memory of an input of the same shape and
+     * dtype, so the compute function must also be correct when they are the
+     * same tensor
+     */
+    CustomOp& set_inplace(size_t output_idx, size_t input_idx);
+
+    /*!
+     * \brief let an output be the value of an input viewed in the shape of the
+     * output, e.g. a reshape
+     *
+     * The output shares the memory of the input if possible, or the input is
+     * copied to it before the compute function, which must not write it.
+     */
+    CustomOp& set_forward(size_t output_idx, size_t input_idx);
+
     CustomOp& set_description(const std::string& op_desc);
     CustomOp& add_input(
             const std::string& name, const std::string& desc,
@@ -130,6 +211,10 @@ public:
     ArgInfo output_info(size_t idx) const;
     const std::vector<ArgInfo>& inputs_info(void) const;
     const std::vector<ArgInfo>& outputs_info(void) const;
+    //! the input whose memory may be reused by the output, or -1
+    int inplace_input(size_t output_idx) const;
+    //! the input forwarded to the output, or -1
+    int forward_input(size_t output_idx) const;
 
     // use
     std::vector<Device> infer_output_device(
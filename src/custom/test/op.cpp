@@ -6,6 +6,8 @@
 #include "megbrain/comp_node.h"
 #include "megbrain/custom/adaptor.h"
 #include "megbrain/custom/op.h"
+#include "megbrain/opr/custom_opnode.h"
+#include "megbrain/opr/io.h"
 #include "megbrain/tensor.h"
 #include "megbrain/test/helper.h"
 #include "megbrain_build_config.h"
@@ -243,6 +245,109 @@ TEST(TestCustomOp, TestCustomOpCompute) {
     MGB_ASSERT_TENSOR_NEAR(*expect_o1, host_o1, 1e-6);
 }
 
+template <typename T>
+struct AddOneKernel {
+    static void compute(
+            const std::vector<Tensor>& inputs, const Param&,
+            std::vector<Tensor>& outputs, const RuntimeArgs& rt_args) {
+        ASSERT_TRUE(rt_args.device() == "x86");
+        auto src = inputs[0].data<T>();
+        auto dst = outputs[0].data<T>();
+        for (size_t i = 0; i < inputs[0].size(); ++i) {
+            dst[i] = src[i] + 1;
+        }
+    }
+};
+
+TEST(TestCustomOp, TestCustomOpTypedCompute) {
+    std::shared_ptr<CustomOp> op =
+            std::make_shared<CustomOp>("AddOne", CUSTOM_OP_VERSION);
+    op->add_input("inp", {"float32", "int32", "int8"})
+            .add_output("out", {"float32", "int32", "int8"})
+            .set_compute<AddOneKernel, DTypeEnum::float32, DTypeEnum::int32>("x86");
+    Param param(op->param_info());
+
+    auto cn = CompNode::load("cpux");
+    auto run = [&](const HostTensorND& host_x) {
+        auto inps = std::make_shared<SmallVector<DeviceTensorND>>(1);
+        auto oups = std::make_shared<SmallVector<DeviceTensorND>>(1);
+        inps->at(0) = DeviceTensorND{cn};
+        inps->at(0).copy_from(host_x).sync();
+        oups->at(0) = DeviceTensorND{cn, host_x.shape(), host_x.dtype()};
+        dispatch_custom_op(op, param, inps, oups);
+        HostTensorND ret;
+        ret.copy_from(oups->at(0)).sync();
+        return ret;
+    };
+
+    HostTensorGenerator<dtype::Float32> gen_f;
+    HostTensorGenerator<dtype::Int32> gen_i;
+    auto host_f = gen_f({3, 4}), host_i = gen_i({5});
+    auto out_f = run(*host_f), out_i = run(*host_i);
+    for (size_t i = 0; i < 12; ++i) {
+        ASSERT_EQ(host_f->ptr<float>()[i] + 1, out_f.ptr<float>()[i]);
+    }
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(host_i->ptr<int>()[i] + 1, out_i.ptr<int>()[i]);
+    }
+    // int8 is legal for the op but has no kernel
+    HostTensorGenerator<dtype::Int8> gen_i8;
+    ASSERT_ANY_THROW(run(*gen_i8({5})));
+}
+
+void fwd_shape_infer(
+        const std::vector<Shape>& inputs, const Param&, std::vector<Shape>& outputs) {
+    size_t nr_elems = 1;
+    for (size_t i = 0; i < inputs[0].ndim(); ++i) {
+        nr_elems *= inputs[0][i];
+    }
+    outputs[0] = Shape({nr_elems});
+    outputs[1] = inputs[0];
+}
+
+void fwd_cpu_kernel(
+        const std::vector<Tensor>& inputs, const Param&, std::vector<Tensor>& outputs) {
+    // outputs[0] is forwarded by the system, and outputs[1] may be inputs[0]
+    auto src = inputs[0].data<float>();
+    auto dst = outputs[1].data<float>();
+    for (size_t i = 0; i < inputs[0].size(); ++i) {
+        dst[i] = src[i] * 2;
+    }
+}
+
+TEST(TestCustomOp, TestCustomOpMemFwd) {
+    std::shared_ptr<CustomOp> op =
+            std::make_shared<CustomOp>("FlattenAndDouble", CUSTOM_OP_VERSION);
+    op->add_input("inp")
+            .add_output("flatten")
+            .add_output("double")
+            .set_shape_infer(fwd_shape_infer)
+            .set_compute("x86", fwd_cpu_kernel)
+            .set_forward(0, 0)
+            .set_inplace(1, 0);
+    ASSERT_EQ(op->forward_input(0), 0);
+    ASSERT_EQ(op->inplace_input(0), -1);
+    ASSERT_EQ(op->inplace_input(1), 0);
+    ASSERT_ANY_THROW(op->set_inplace(0, 0));
+
+    HostTensorGenerator<> gen;
+    auto host_x = gen({3, 4}, CompNode::load("cpux"));
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    auto outs =
+            opr::CustomOpNode::make(op, {x}, Param(op->param_info()), {"custom"});
+    HostTensorND host_flatten, host_double;
+    auto func = graph->compile(
+            {make_callback_copy(outs[0], host_flatten),
+             make_callback_copy(outs[1], host_double)});
+    func->execute();
+    ASSERT_EQ(TensorShape({12}), host_flatten.shape());
+    for (size_t i = 0; i < 12; ++i) {
+        ASSERT_EQ(host_x->ptr<float>()[i], host_flatten.ptr<float>()[i]);
+        ASSERT_EQ(host_x->ptr<float>()[i] * 2, host_double.ptr<float>()[i]);
+    }
+}
+
 }  // namespace custom
 
 #endif
@@ -613,6 +613,9 @@ GraphOptimizer& GraphOptimizer::add_preset_passes(
     if (!after_grad || inference_opt) {
         add_pass<CondExecConstPredicateFolding>();
     }
+    if (inference_opt) {
+        add_pass<CondExecCSEPass>();
+    }
     if (after_grad || inference_opt) {
         add_pass<RemoveNonComputingOprPass>();
     }
@@ -731,8 +734,12 @@ const GraphOptimizer& GraphOptimizer::add_passes_for_optimize_options(
         add_pass(FuseNCHW4Int8Preprocess::make());
         add_pass<FuseWarpPerspectiveDimshufflePass>();
     });
-    cb(f16_io_comp, { add_pass(ConvertF32ToF16Pass::make(false)); });
-    cb(f16_io_f32_comp, { add_pass(ConvertF32ToF16Pass::make(true)); });
+    cb(f16_io_comp, {
+        add_pass(ConvertF32ToF16Pass::make(false, options.f16_mixed_precision));
+    });
+    cb(f16_io_f32_comp, {
+        add_pass(ConvertF32ToF16Pass::make(true, options.f16_mixed_precision));
+    });
 
     cb(nchw4, {
         add_pass<FuseConvBiasNonlinPass>();
@@ -809,6 +816,12 @@ const GraphOptimizer& GraphOptimizer::add_passes_for_optimize_options(
         add_pass<FuseConvBiasNonlinPass>();
         add_pass<FuseConvBiasZPass>();
     });
+    cb(fuse_depthwise_pointwise_conv_bias,
+       { add_pass<FuseDepthwisePointwiseConvBiasPass>(); });
+    cb(fuse_residual_layer_norm, { add_pass<FuseResidualLayerNormPass>(); });
+    cb(precompute_weight, {
+        add_pass<PrecomputeWeightPass>(options.precompute_weight_size_budget);
+    });
 
 #undef cb
 
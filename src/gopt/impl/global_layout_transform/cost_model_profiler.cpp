@@ -0,0 +1,153 @@
+#include "./opr_format_modifier.h"
+#include "./utils.h"
+#include "megbrain/gopt/profiler.h"
+
+using namespace mgb;
+using namespace gopt;
+using ReformatKey = ReformatManager::ReformatKey;
+
+namespace {
+uint64_t efficiency_key(CostModel::OprFormatConfigID config_id, uint32_t dtype) {
+    return static_cast<uint64_t>(config_id) << 32 | dtype;
+}
+
+float nr_bytes(const TensorShape& shape, DType dtype) {
+    return TensorLayout{shape, dtype}.span().dist_byte();
+}
+
+float nr_elems(const TensorShape& shape) {
+    return shape.total_nr_elems();
+}
+}  // namespace
+
+/* ================== CostModel =================*/
+CostModel& CostModel::set_efficiency(OprFormatConfigID config_id, float efficiency) {
+    m_efficiency[efficiency_key(config_id, 0)] = efficiency;
+    return *this;
+}
+
+CostModel& CostModel::set_efficiency(
+        OprFormatConfigID config_id, DTypeEnum dtype, float efficiency) {
+    m_efficiency[efficiency_key(config_id, static_cast<uint32_t>(dtype) + 1)] =
+            efficiency;
+    return *this;
+}
+
+float CostModel::efficiency(OprFormatConfigID config_id, DTypeEnum dtype) const {
+    auto iter = m_efficiency.find(
+            efficiency_key(config_id, static_cast<uint32_t>(dtype) + 1));
+    if (iter != m_efficiency.end())
+        return iter->second;
+    iter = m_efficiency.find(efficiency_key(config_id, 0));
+    if (iter != m_efficiency.end())
+        return iter->second;
+    return default_efficiency;
+}
+
+/* ================== CostModelProfiler =================*/
+CostModelProfiler::CostModelProfiler(
+        const CostModel& cost_model, float opr_threshold, float var_node_threshold)
+        : ProfilerImpl(1, opr_threshold, var_node_threshold),
+          m_cost_model{cost_model} {}
+
+float CostModelProfiler::estimate(
+        const OperatorNodeBase* opr, OprFormatConfigID config_id,
+        float computation_ratio, float bytes) const {
+    /// the same as the computation threshold of the opr filter of ProfilerImpl
+    if (computation_ratio > m_opr_threshold)
+        return PROFILE_TIME_OUT;
+    float efficiency =
+            m_cost_model.efficiency(config_id, opr->input(0)->dtype().enumv());
+    if (efficiency <= 0.f)
+        return PROFILE_TIME_OUT;
+    float computation =
+            m_footprint.get_computation(const_cast<OperatorNodeBase*>(opr)) *
+            computation_ratio;
+    return (computation / m_cost_model.flops_per_usec +
+            bytes / m_cost_model.bytes_per_usec) /
+           efficiency;
+}
+
+float CostModelProfiler::profile_operator(
+        const OperatorNodeBase* opr, TensorFormats base_format,
+        TensorFormats tensor_format, ReformatAttribute extra_attribute) const {
+    bool allow_aligned = intl::allow_aligned_layout(opr);
+    float bytes = 0.f;
+    for (auto&& i : opr->input()) {
+        auto shape = ReformatManager::try_make_tensor_shape(
+                i, base_format, tensor_format, extra_attribute, allow_aligned);
+        if (shape.ndim == 0)
+            return PROFILE_TIME_OUT;
+        bytes += nr_bytes(shape, i->dtype());
+    }
+    float computation_ratio = 1.f;
+    for (auto&& o : opr->usable_output()) {
+        auto shape = ReformatManager::try_make_tensor_shape(
+                o, base_format, tensor_format, extra_attribute, allow_aligned);
+        if (shape.ndim == 0)
+            return PROFILE_TIME_OUT;
+        bytes += nr_bytes(shape, o->dtype());
+        if (o == opr->output(0))
+            computation_ratio = nr_elems(shape) / nr_elems(o->shape());
+    }
+    return estimate(
+            opr, tensor_formats_to_config_id(tensor_format), computation_ratio, bytes);
+}
+
+float CostModelProfiler::profile_operator(
+        const OperatorNodeBase* opr, const OprTensorFormatsConfiguration& base_config,
+        const OprTensorFormatsConfiguration& config,
+        ReformatAttribute extra_attribute) const {
+    float bytes = 0.f, computation_ratio = 0.f;
+    size_t i = 0;
+    size_t nr_input_tensor =
+            std::min(config.input_tensor_formats.size(), opr->input().size());
+    for (; i < nr_input_tensor; ++i) {
+        auto&& var = opr->input(i);
+        TensorShape aligned_shape;
+        if (config.input_tensor_types[i] == TensorType::WEIGHT) {
+            aligned_shape = ReformatManager::make_aligned_weight_shape(
+                    var, base_config.input_tensor_formats[i],
+                    config.input_tensor_formats[i], config.output_tensor_formats[0],
+                    extra_attribute);
+            /// the computation grows with the padded channels of the weight
+            computation_ratio = nr_elems(aligned_shape) / nr_elems(var->shape());
+        } else {
+            aligned_shape = ReformatManager::make_aligned_tensor_shape(
+                    var, base_config.input_tensor_formats[i],
+                    config.input_tensor_formats[i], extra_attribute);
+        }
+        bytes += nr_bytes(aligned_shape, var->dtype());
+    }
+    for (; i < opr->input().size(); ++i) {
+        auto&& var = opr->input(i);
+        bytes += nr_bytes(var->shape(), var->dtype());
+    }
+    auto&& out = opr->output(0);
+    auto out_shape = ReformatManager::make_aligned_tensor_shape(
+            out, base_config.output_tensor_formats[0],
+            config.output_tensor_formats[0], extra_attribute);
+    bytes += nr_bytes(out_shape, out->dtype());
+    if (computation_ratio == 0.f)
+        computation_ratio = nr_elems(out_shape) / nr_elems(out->shape());
+    return estimate(opr, config.config_id, computation_ratio, bytes);
+}
+
+float CostModelProfiler::profile_var_node(
+        const VarNode* var, TensorFormats base_format, const ReformatKey& key) const {
+    auto from = ReformatManager::make_aligned_tensor_shape(
+            var, base_format, key.input_format, key.attribute);
+    auto to = ReformatManager::make_aligned_tensor_shape(
+            var, base_format, key.output_format, key.attribute);
+    if (!m_var_node_filter(var, from, to, key))
+        return PROFILE_TIME_OUT;
+    float bytes = nr_bytes(from, var->dtype()) + nr_bytes(to, var->dtype());
+    return bytes / m_cost_model.bytes_per_usec / m_cost_model.reformat_efficiency;
+}
+
+std::unique_ptr<ProfilerBase> ProfilerBase::make_cost_model_profiler(
+        const CostModel& cost_model) {
+    return std::make_unique<CostModelProfiler>(cost_model);
+}
+
+// vim: syntax=cpp.doxygen
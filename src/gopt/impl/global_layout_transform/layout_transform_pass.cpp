@@ -185,7 +185,9 @@ void LayoutTransformPass::apply(OptState& opt) const {
 std::unique_ptr<LayoutTransformPass> LayoutTransformPass::make(
         GraphTuningOptions::Target target) {
     MIDOUT_B("make")
-    auto profiler = ProfilerBase::make_profiler();
+    //! the profiling results are cached by the signatures of the oprs, so that
+    //! the repeated oprs in this graph and in other graphs are profiled only once
+    auto profiler = ProfilerBase::make_cached_profiler();
     std::unique_ptr<SolverBase> solver{
             new DynamicProgrammingSolver(std::move(profiler))};
     auto ctx = LayoutTransformContext::make(target);
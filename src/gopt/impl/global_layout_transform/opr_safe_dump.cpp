@@ -86,6 +86,12 @@ std::string opr_safe_dump(const cg::OperatorNodeBase* opr) {
 #undef cb
 }
 
+bool has_opr_safe_dump(const cg::OperatorNodeBase* opr) {
+#define cb(_Opr) opr->dyn_typeinfo() == _Opr::typeinfo() ||
+    return FOREACH_SUPPORTED_OPR(cb) false;
+#undef cb
+}
+
 }  // namespace intl
 }  // namespace gopt
 }  // namespace mgb
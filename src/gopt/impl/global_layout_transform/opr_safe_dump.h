@@ -17,6 +17,9 @@ namespace intl {
 
 std::string opr_safe_dump(const cg::OperatorNodeBase* opr);
 
+//! whether the operator can be dumped by opr_safe_dump()
+bool has_opr_safe_dump(const cg::OperatorNodeBase* opr);
+
 }  // namespace intl
 }  // namespace gopt
 }  // namespace mgb
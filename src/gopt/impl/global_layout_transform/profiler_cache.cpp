@@ -2,10 +2,60 @@
 #include "megbrain/comp_node_env.h"
 #include "megbrain/gopt/profiler.h"
 
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <thread>
+
 using namespace mgb;
 using namespace gopt;
 using ReformatKey = ReformatManager::ReformatKey;
 
+namespace {
+//! the architecture, the model and the number of cores of the host cpu, which
+//! tell apart the profiling results of different machines
+const std::string& cpu_fingerprint() {
+    static std::string ret = [] {
+#if defined(__x86_64__) || defined(_M_X64)
+        std::string fp = "arch=x86_64";
+#elif defined(__i386__) || defined(_M_IX86)
+        std::string fp = "arch=x86";
+#elif defined(__aarch64__)
+        std::string fp = "arch=aarch64";
+#elif defined(__arm__)
+        std::string fp = "arch=armv7";
+#elif defined(__riscv)
+        std::string fp = "arch=riscv";
+#else
+        std::string fp = "arch=unknown";
+#endif
+#if defined(__linux__) || defined(__ANDROID__)
+        // x86 reports the model name, and arm reports the implementer and
+        // the part number instead
+        std::ifstream fin("/proc/cpuinfo");
+        std::string line;
+        std::set<std::string> seen;
+        while (std::getline(fin, line)) {
+            for (const char* name : {"model name", "CPU implementer", "CPU part"}) {
+                if (line.compare(0, strlen(name), name) || !seen.insert(name).second)
+                    continue;
+                auto pos = line.find(':');
+                if (pos != std::string::npos) {
+                    auto begin = line.find_first_not_of(" \t", pos + 1);
+                    fp += ssprintf(
+                            ";%s=%s", name,
+                            begin == std::string::npos ? "" : line.c_str() + begin);
+                }
+            }
+        }
+#endif
+        fp += ssprintf(";cores=%u", std::thread::hardware_concurrency());
+        return fp;
+    }();
+    return ret;
+}
+}  // anonymous namespace
+
 // =================== ProfilerCache ======================
 void ProfilerCache::Key::build_blob_from_opr() {
     auto&& opr = m_key_impl.opr_key.opr;
@@ -67,16 +117,28 @@ void ProfilerCache::Key::build_category(CompNode cn) {
         case CompNode::DeviceType::CUDA: {
             m_category += "plat=cuda";
             if (ProfilerCache::inst().enable_device_info()) {
+                int cuda_rt = -1;
+                MGB_CUDA_CHECK(cudaRuntimeGetVersion(&cuda_rt));
                 auto&& prop = env.cuda_env().device_prop;
                 m_category += ssprintf(
-                        ";dev=%s;cap=%d.%d", prop.name, prop.major, prop.minor);
+                        ";dev=%s;cap=%d.%d;runtime=%d", prop.name, prop.major,
+                        prop.minor, cuda_rt / 1000);
             }
             break;
         }
 #endif
-        case CompNode::DeviceType::CPU:
+        case CompNode::DeviceType::CPU: {
             m_category += "plat=cpu";
+            if (ProfilerCache::inst().enable_device_info()) {
+                auto&& loc = cn.locator();
+                int nr_threads = loc.type == CompNode::DeviceType::MULTITHREAD
+                                       ? loc.nr_threads
+                                       : 1;
+                m_category += ssprintf(
+                        ";%s;threads=%d", cpu_fingerprint().c_str(), nr_threads);
+            }
             break;
+        }
         default:
             mgb_throw(
                     MegBrainError,
@@ -130,14 +192,13 @@ ProfilerCache& ProfilerCache::inst() {
 }
 
 ProfilerCache& ProfilerCache::set_impl(std::unique_ptr<PersistentCache> impl) {
-    mgb_assert(impl != nullptr);
     m_impl.swap(impl);
     return *this;
 }
 
 void ProfilerCache::dump_cache(const char* path) {
     mgb_assert(
-            m_impl->support_dump_cache(),
+            m_impl && m_impl->support_dump_cache(),
             "current impl of ProfilerCache does not support dump cache to "
             "file.");
     auto cache = static_cast<InFilePersistentCache*>(m_impl.get());
@@ -145,7 +206,7 @@ void ProfilerCache::dump_cache(const char* path) {
 }
 
 Maybe<ProfilerCache::Result> ProfilerCache::get(const Key& key) {
-    auto raw_buf = m_impl->get(key.category(), key.blob());
+    auto raw_buf = impl().get(key.category(), key.blob());
     if (!raw_buf.valid())
         return None;
     // data type of cost is float
@@ -165,7 +226,7 @@ Maybe<ProfilerCache::Result> ProfilerCache::get(const Key& key) {
 void ProfilerCache::put(const Key& key, Result& result) {
     std::string val;
     megdnn::Algorithm::serialize_write_pod(result, val);
-    m_impl->put(key.category(), key.blob(), {val.data(), val.size()});
+    impl().put(key.category(), key.blob(), {val.data(), val.size()});
 }
 
 // vim: syntax=cpp.doxygen
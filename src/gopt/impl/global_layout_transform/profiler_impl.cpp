@@ -1,4 +1,5 @@
 #include "./opr_format_modifier.h"
+#include "./opr_safe_dump.h"
 #include "./utils.h"
 #include "megbrain/gopt/framework.h"
 #include "megbrain/gopt/profiler.h"
@@ -627,6 +628,10 @@ CachedProfiler::ProfilingResult CachedProfiler::profile(const Problem& problem)
 float CachedProfiler::profile_operator(
         const OperatorNodeBase* opr, TensorFormats base_format,
         TensorFormats tensor_format, ReformatAttribute extra_attribute) const {
+    if (!intl::has_opr_safe_dump(opr)) {
+        return ProfilerImpl::profile_operator(
+                opr, base_format, tensor_format, extra_attribute);
+    }
     ProfilerCache::Key key{
             opr, tensor_formats_to_config_id(tensor_format), extra_attribute};
     auto ret = ProfilerCache::inst().get(key);
@@ -642,6 +647,10 @@ float CachedProfiler::profile_operator(
         const OperatorNodeBase* opr, const OprTensorFormatsConfiguration& base_config,
         const OprTensorFormatsConfiguration& config,
         ReformatAttribute extra_attribute) const {
+    if (!intl::has_opr_safe_dump(opr)) {
+        return ProfilerImpl::profile_operator(
+                opr, base_config, config, extra_attribute);
+    }
     ProfilerCache::Key key{opr, config.config_id, extra_attribute};
     auto ret = ProfilerCache::inst().get(key);
     if (ret.valid())
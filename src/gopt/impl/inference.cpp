@@ -6,7 +6,11 @@
 #include "megbrain/opr/blas.h"
 #include "megbrain/opr/dnn/batch_norm.h"
 #include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/dnn/general_norm.h"
+#include "megbrain/opr/dnn/group_norm.h"
 #include "megbrain/opr/dnn/images2neibs.h"
+#include "megbrain/opr/dnn/instance_norm.h"
+#include "megbrain/opr/dnn/layer_norm.h"
 #include "megbrain/opr/dnn/local.h"
 #include "megbrain/opr/dnn/pooling.h"
 #include "megbrain/opr/dnn/softmax.h"
@@ -604,6 +608,90 @@ void ParamFusePass::apply(OptState& state) const {
     MIDOUT_E
 }
 
+/* ================ PrecomputeWeightPass ================ */
+
+namespace {
+/*!
+ * replace the transposed operands of a matmul opr accepted by \p take_weight
+ * by their explicit transposes, which are folded by ParamFusePass later
+ */
+template <class Opr>
+VarNode* untranspose_weight(
+        Opr& opr, const VarNodeArray& new_inp, const std::vector<int>& pattern,
+        const thin_function<bool(VarNode*)>& take_weight) {
+    auto param = opr.param();
+    if (param.format != megdnn::param::MatrixMul::Format::DEFAULT)
+        return nullptr;
+    SymbolVar a = new_inp[0], b = new_inp[1];
+    bool changed = false;
+    if (param.transposeA && take_weight(opr.input(0))) {
+        a = opr::Dimshuffle::make(a, pattern);
+        param.transposeA = false;
+        changed = true;
+    }
+    if (param.transposeB && take_weight(opr.input(1))) {
+        b = opr::Dimshuffle::make(b, pattern);
+        param.transposeB = false;
+        changed = true;
+    }
+    if (!changed)
+        return nullptr;
+    return Opr::make(a, b, param, opr.execution_policy(), opr.config()).node();
+}
+}  // namespace
+
+const char* PrecomputeWeightPass::name() const {
+    return mgb_cstr_log("precompute_weight");
+}
+
+void PrecomputeWeightPass::apply(OptState& state) const {
+    MIDOUT_B("PrecomputeWeightPass::apply")
+    auto rewriter = state.graph().make_rewriter();
+    ConstVarPropogate cvprop{ConstVarType::IMMUTABLE_AND_PARAM};
+    UniqReaderCheck uniq_reader_check{state.graph()};
+    size_t size_used = 0;
+
+    //! a weight read by other oprs is kept, so its copy is charged to the budget
+    auto take_weight = [&](VarNode* var) {
+        if (!cvprop.is_const(var))
+            return false;
+        if (uniq_reader_check(var))
+            return true;
+        if (!var->shape().ndim)
+            return false;
+        auto size = ConstVarPropogate::var_mem_size(var);
+        if (size > m_size_budget - size_used)
+            return false;
+        size_used += size;
+        return true;
+    };
+
+    VarNodeArray new_inp;
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        cvprop.add_opr(opr);
+        new_inp.clear();
+        for (auto i : opr->input())
+            new_inp.push_back(rewriter.get_var(i));
+
+        VarNode* new_var = nullptr;
+        if (auto matmul = try_cast_as_op<opr::MatrixMul>(opr)) {
+            new_var = untranspose_weight(*matmul, new_inp, {1, 0}, take_weight);
+        } else if (auto matmul = try_cast_as_op<opr::BatchedMatrixMul>(opr)) {
+            new_var = untranspose_weight(*matmul, new_inp, {0, 2, 1}, take_weight);
+        }
+        if (new_var) {
+            rewriter.replace_var(
+                    opr->output(0), new_var,
+                    mgb_cstr_log("store transposed weight of matmul"));
+            return;
+        }
+        rewriter.auto_replace_outputs(opr);
+    };
+    state.graph().iter(on_opr);
+    rewriter.apply_inplace();
+    MIDOUT_E
+}
+
 /* ================ One2OneOprReplacePass ================ */
 const char* ConvertF32ToF16Pass::name() const {
     return mgb_cstr_log("convert_f32_to_f16");
@@ -622,9 +710,45 @@ void ConvertF32ToF16Pass::apply(OptState& state) const {
         dtypes.push_back(vars[i].node()->dtype());
     }
 
-    auto on_opr = [this, &rewriter, &new_inp_cache](OperatorNodeBase* opr) {
+    // compute opr in float32 between TypeCvts
+    auto keep_f32 = [&rewriter, &new_inp_cache](OperatorNodeBase* opr) {
+        auto&& new_inp = new_inp_cache;
+        new_inp.clear();
+        new_inp.reserve(opr->input().size());
+        for (auto i : opr->input()) {
+            auto new_var = rewriter.get_var(i);
+            if (i->dtype() == dtype::Float32() &&
+                new_var->dtype() != dtype::Float32()) {
+                auto src = new_var->owner_opr();
+                if (src->same_type<opr::TypeCvt>() &&
+                    src->input(0)->dtype() == dtype::Float32()) {
+                    new_var = src->input(0);
+                } else {
+                    new_var = opr::TypeCvt::make(new_var, dtype::Float32()).node();
+                }
+            }
+            new_inp.push_back(new_var);
+        }
+        auto new_opr = serialization::copy_opr_shallow(*opr, new_inp, opr->config());
+        auto &&origin_out = opr->output(), &&cur_out = new_opr->output();
+        mgb_assert(origin_out.size() == cur_out.size());
+        for (size_t i = 0; i < origin_out.size(); i++) {
+            auto new_var = cur_out[i];
+            if (!new_var->contain_flag(VarNode::Flag::VOLATILE_CONTENT) &&
+                new_var->dtype() == dtype::Float32()) {
+                new_var = opr::TypeCvt::make(new_var, dtype::Float16()).node();
+            }
+            rewriter.replace_var(
+                    origin_out[i], new_var, mgb_cstr_log("keep opr in float32"));
+        }
+    };
+
+    auto on_opr = [this, &rewriter, &new_inp_cache,
+                   &keep_f32](OperatorNodeBase* opr) {
         auto it = m_opr_replace_func.find(opr->dyn_typeinfo());
-        if (it != m_opr_replace_func.end()) {
+        if (m_keep_f32 && m_keep_f32(opr)) {
+            keep_f32(opr);
+        } else if (it != m_opr_replace_func.end()) {
             auto&& new_inp = new_inp_cache;
             new_inp.clear();
             new_inp.reserve(opr->input().size());
@@ -684,7 +808,23 @@ void ConvertF32ToF16Pass::apply(OptState& state) const {
     MIDOUT_E
 }
 
-std::unique_ptr<ConvertF32ToF16Pass> ConvertF32ToF16Pass::make(bool use_f32_comp) {
+bool ConvertF32ToF16Pass::is_f16_sensitive(OperatorNodeBase* opr) {
+    if (auto reduce = try_cast_as_op<opr::Reduce>(opr)) {
+        using Mode = opr::Reduce::Param::Mode;
+        auto mode = reduce->param().mode;
+        return mode == Mode::SUM || mode == Mode::SUM_SQR || mode == Mode::MEAN ||
+               mode == Mode::PRODUCT;
+    }
+    auto type = opr->dyn_typeinfo();
+    return type == opr::Softmax::typeinfo() || type == opr::LayerNorm::typeinfo() ||
+           type == opr::ResidualLayerNorm::typeinfo() ||
+           type == opr::GroupNorm::typeinfo() ||
+           type == opr::GeneralNorm::typeinfo() ||
+           type == opr::InstanceNorm::typeinfo() || type == opr::BatchNorm::typeinfo();
+}
+
+std::unique_ptr<ConvertF32ToF16Pass> ConvertF32ToF16Pass::make(
+        bool use_f32_comp, bool keep_sensitive_f32) {
 #if MEGDNN_DISABLE_FLOAT16
     mgb_throw(SystemError, "float16 disabled at compile time.");
 #else
@@ -999,6 +1139,9 @@ std::unique_ptr<ConvertF32ToF16Pass> ConvertF32ToF16Pass::make(bool use_f32_comp
             replace_multi_sdt_opr;
     tensor_replace_func[opr::MultipleDeviceTensorWithFormatHolder::typeinfo()] =
             replace_multi_sdt_with_format_opr;
+    if (keep_sensitive_f32) {
+        ret->keep_f32(is_f16_sensitive);
+    }
     return ret;
 #endif
 }
@@ -2329,6 +2472,147 @@ void FuseDeconvCvtPass::apply(OptState& state) const {
     MIDOUT_E
 }
 
+/* ================ FuseDepthwisePointwiseConvBiasPass ================ */
+const char* FuseDepthwisePointwiseConvBiasPass::name() const {
+    return "combine_depthwise_and_pointwise_conv_bias";
+}
+
+void FuseDepthwisePointwiseConvBiasPass::apply(OptState& state) const {
+    MIDOUT_B("FuseDepthwisePointwiseConvBiasPass::apply")
+    UniqReaderCheck uniq_reader_check{state.graph()};
+    auto rewriter = state.graph().make_rewriter();
+    using Param = opr::ConvBias::Param;
+
+    //! float32 NCHW44 conv_bias with a broadcast bias and no z
+    auto check_common = [](opr::ConvBias* conv_bias) {
+        auto&& param = conv_bias->param();
+        if (param.format != Param::Format::NCHW44 ||
+            param.mode != Param::Mode::CROSS_CORRELATION ||
+            param.compute_mode != Param::ComputeMode::DEFAULT ||
+            param.dilate_h != 1 || param.dilate_w != 1 ||
+            conv_bias->input().size() != 3 ||
+            conv_bias->output(0)->dtype().enumv() != DTypeEnum::Float32) {
+            return false;
+        }
+        for (auto i : conv_bias->input()) {
+            if (i->dtype().enumv() != DTypeEnum::Float32)
+                return false;
+        }
+        auto&& bias = conv_bias->input(2)->shape();
+        return bias.ndim == 5 && bias[0] == 1 && bias[2] == 1 && bias[3] == 1;
+    };
+    //! filter of shape (c / 4, 1, 1, fh, fw, 4)
+    auto is_channel_wise = [&](opr::ConvBias* conv_bias) {
+        auto&& filter = conv_bias->input(1)->shape();
+        return check_common(conv_bias) &&
+               conv_bias->param().sparse == Param::Sparse::GROUP &&
+               filter.ndim == 6 && filter[1] == 1 && filter[2] == 1;
+    };
+    //! filter of shape (oc / 4, c / 4, 1, 1, 4, 4)
+    auto is_pointwise = [&](opr::ConvBias* conv_bias) {
+        auto&& param = conv_bias->param();
+        auto&& filter = conv_bias->input(1)->shape();
+        return check_common(conv_bias) && param.sparse == Param::Sparse::DENSE &&
+               param.pad_h == 0 && param.pad_w == 0 && param.stride_h == 1 &&
+               param.stride_w == 1 && filter.ndim == 6 && filter[2] == 1 &&
+               filter[3] == 1;
+    };
+
+    auto try_fuse = [&](OperatorNodeBase* opr) -> VarNode* {
+        auto pw = try_cast_as_op<opr::ConvBias>(opr);
+        if (!pw || !is_pointwise(pw))
+            return nullptr;
+        auto dw = try_cast_as_op<opr::ConvBias>(
+                rewriter.get_var(pw->input(0))->owner_opr());
+        if (!dw || !is_channel_wise(dw) || !uniq_reader_check(pw->input(0)))
+            return nullptr;
+        auto&& dw_param = dw->param();
+        opr::DepthwisePointwiseConvBias::Param param;
+        param.dw_nonline_mode = dw_param.nonlineMode;
+        param.pw_nonline_mode = pw->param().nonlineMode;
+        param.pad_h = dw_param.pad_h;
+        param.pad_w = dw_param.pad_w;
+        param.stride_h = dw_param.stride_h;
+        param.stride_w = dw_param.stride_w;
+        return opr::DepthwisePointwiseConvBias::make(
+                       dw->input(0), dw->input(1), dw->input(2),
+                       rewriter.get_var(pw->input(1)),
+                       rewriter.get_var(pw->input(2)), param, pw->config())
+                .node();
+    };
+
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        if (auto new_var = try_fuse(opr)) {
+            rewriter.replace_var(
+                    opr->output(0), new_var,
+                    mgb_cstr_log("replace conv_bias(conv_bias(x, dw, b0), pw, b1) "
+                                 "-> depthwise_pointwise_conv_bias(x, dw, b0, pw, "
+                                 "b1)"));
+            uniq_reader_check.update_on_opr_auto_replace(opr, new_var->owner_opr());
+            return;
+        }
+        auto new_opr = rewriter.auto_replace_outputs(opr);
+        uniq_reader_check.update_on_opr_auto_replace(opr, new_opr);
+    };
+    state.graph().iter(on_opr);
+
+    rewriter.apply_inplace();
+    MIDOUT_E
+}
+
+/* ================ FuseResidualLayerNormPass ================ */
+const char* FuseResidualLayerNormPass::name() const {
+    return "fuse_residual_layer_norm";
+}
+
+void FuseResidualLayerNormPass::apply(OptState& state) const {
+    MIDOUT_B("FuseResidualLayerNormPass::apply")
+    auto rewriter = state.graph().make_rewriter();
+
+    auto is_float = [](VarNode* var) {
+        auto enumv = var->dtype().enumv();
+        return enumv == DTypeEnum::Float32 || enumv == DTypeEnum::Float16 ||
+               enumv == DTypeEnum::BFloat16;
+    };
+
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        auto new_opr = rewriter.auto_replace_outputs(opr);
+        auto ln = try_cast_as_op<opr::LayerNorm>(new_opr);
+        if (!ln)
+            return;
+        auto add = try_cast_as_op<opr::Elemwise>(ln->input(0)->owner_opr());
+        if (!add || add->param().mode != opr::Elemwise::Mode::ADD ||
+            add->input().size() != 2)
+            return;
+        auto x = add->input(0), r = add->input(1);
+        if (!is_float(x) || x->dtype() != r->dtype() ||
+            !x->shape().eq_shape(r->shape()) ||
+            !x->shape().eq_shape(ln->input(0)->shape()))
+            return;
+        SymbolVarArray outs;
+        if (ln->param().affine) {
+            outs = opr::ResidualLayerNorm::make(
+                    x, r, ln->input(1), ln->input(2), ln->param(), ln->config());
+        } else {
+            outs = opr::ResidualLayerNorm::make(x, r, ln->param(), ln->config());
+        }
+        //! the sum replaces the elemwise output for its readers after the
+        //! layer norm; the ones before keep the unfused elemwise
+        rewriter.replace_var(
+                opr->input(0), outs[1].node(),
+                mgb_cstr_log("replace x + r -> residual_layer_norm(x, r).sum"));
+        const char* msg = mgb_cstr_log(
+                "replace layer_norm(x + r) -> residual_layer_norm(x, r)");
+        rewriter.replace_var(opr->output(0), outs[0].node(), msg);
+        rewriter.replace_var(opr->output(1), outs[2].node(), msg);
+        rewriter.replace_var(opr->output(2), outs[3].node(), msg);
+    };
+    state.graph().iter(on_opr);
+
+    rewriter.apply_inplace();
+    MIDOUT_E
+}
+
 /* ================ ParamMergePass ================ */
 const char* ParamMergePass::name() const {
     return mgb_cstr_log("param_merge");
@@ -2,9 +2,13 @@
 #include "../../core/impl/graph/cg_impl.h"
 #include "megbrain/graph/grad_impl.h"
 #include "megbrain/opr/cond.h"
+#include "megbrain/opr/dnn/batch_norm.h"
+#include "megbrain/opr/dnn/softmax.h"
 #include "megbrain/opr/io.h"
+#include "megbrain/opr/misc.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
+#include "megbrain/plugin/opr_footprint.h"
 #include "megbrain/serialization/opr_shallow_copy.h"
 #include "megbrain/serialization/serializer.h"
 
@@ -624,6 +628,135 @@ void CondExecConstPredicateFolding::apply(OptState& opt) const {
 #endif  // MGB_ENABLE_COND_EXEC
 }
 
+/* ================ CondExecCSEPass ================ */
+const char* CondExecCSEPass::name() const {
+    return "cond_exec_cse";
+}
+
+void CondExecCSEPass::apply(OptState& opt) const {
+#if MGB_ENABLE_COND_EXEC
+    MIDOUT_B("CondExecCSEPass::apply")
+    if (!cg::ExecutionMask::have_alive_instance()) {
+        return;
+    }
+
+    // the var computes the same value as the unmasked var marked by the mark
+    struct Unmasked {
+        VarNode* var;
+        OperatorNodeBase* mark;
+    };
+    // the unmasked version of a conditional opr and the mark of its inputs
+    struct Hoisted {
+        OperatorNodeBase* opr;
+        OperatorNodeBase* mark;
+    };
+    ThinHashMap<VarNode*, Unmasked> unmasked;
+    ThinHashMap<OperatorNodeBase*, Hoisted> hoisted;
+    // masks of the branches where the unmasked opr is computed
+    ThinHashMap<OperatorNodeBase*, ThinHashSet<cg::ExecutionMask*>> branch_masks;
+    ThinHashSet<OperatorNodeBase*> orig_oprs;
+
+    auto is_cond_exec_opr = [](OperatorNodeBase* opr) {
+        auto type = opr->dyn_typeinfo();
+        return type == opr::CondExecPred::typeinfo() ||
+               type == opr::CondExecPredLogical::typeinfo() ||
+               type == opr::CondExecMark::typeinfo() ||
+               type == opr::CondExecMerge::typeinfo();
+    };
+    auto is_pure = [](OperatorNodeBase* opr) {
+        using F = OperatorNodeBase::NodeProp::Flag;
+        auto&& prop = opr->node_prop();
+        return !prop.contain(F::IMPURE_FUNC) &&
+               !prop.contain(F::FORCE_UPDATE_INPUT_VAR) &&
+               !opr->usable_output().empty();
+    };
+
+    auto on_opr_find = [&](OperatorNodeBase* opr) {
+        orig_oprs.insert(opr);
+        if (opr->same_type<opr::CondExecMark>()) {
+            for (size_t i = 0; i + 1 < opr->input().size(); ++i) {
+                unmasked[opr->output(i)] = {opr->input(i), opr};
+            }
+            return;
+        }
+        if (is_cond_exec_opr(opr) || !is_pure(opr)) {
+            return;
+        }
+        OperatorNodeBase* mark = nullptr;
+        VarNodeArray inputs;
+        for (auto i : opr->input()) {
+            auto iter = unmasked.find(i);
+            if (iter != unmasked.end()) {
+                auto imark = iter->second.mark;
+                if (mark && cg::ExecutionMask::get_from_opr(mark) !=
+                                    cg::ExecutionMask::get_from_opr(imark)) {
+                    return;
+                }
+                mark = imark;
+                inputs.push_back(iter->second.var);
+            } else if (cg::ExecutionMask::get_from_opr(i->owner_opr())) {
+                return;
+            } else {
+                inputs.push_back(i);
+            }
+        }
+        if (!mark) {
+            return;
+        }
+        // identical oprs from different branches are deduplicated on insertion
+        auto new_opr = serialization::copy_opr_shallow(*opr, inputs, opr->config());
+        auto &&out = opr->usable_output(), &&new_out = new_opr->usable_output();
+        mgb_assert(out.size() == new_out.size());
+        for (size_t i = 0; i < out.size(); ++i) {
+            unmasked[out[i]] = {new_out[i], mark};
+        }
+        hoisted[opr] = {new_opr, mark};
+        branch_masks[new_opr].insert(cg::ExecutionMask::get_from_opr(mark));
+    };
+    opt.graph().iter(on_opr_find);
+
+    auto should_hoist = [&](OperatorNodeBase* new_opr) {
+        return branch_masks.at(new_opr).size() >= 2 || orig_oprs.count(new_opr);
+    };
+
+    auto rewriter = opt.graph().make_rewriter();
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        auto iter = hoisted.find(opr);
+        if (iter == hoisted.end() || !should_hoist(iter->second.opr)) {
+            rewriter.auto_replace_outputs(opr);
+            return;
+        }
+        // inputs of the unmasked opr might have been hoisted from outer branches
+        auto new_opr = iter->second.opr;
+        VarNodeArray inputs;
+        bool changed = false;
+        for (auto i : new_opr->input()) {
+            inputs.push_back(rewriter.get_var(i));
+            changed |= inputs.back() != i;
+        }
+        if (changed) {
+            new_opr = serialization::copy_opr_shallow(
+                    *new_opr, inputs, new_opr->config());
+        }
+        auto&& mark = iter->second.mark->cast_final<opr::CondExecMark>();
+        auto&& out = opr->usable_output();
+        auto new_out = opr::CondExecMark::make_opr(
+                               rewriter.get_var(mark.input().back()),
+                               new_opr->usable_output(), mark.param(),
+                               OperatorNodeConfig{out[0]->comp_node()})
+                               ->output();
+        for (size_t i = 0; i < out.size(); ++i) {
+            rewriter.replace_var(
+                    out[i], new_out[i],
+                    mgb_cstr_log("hoist common subexpression of branches"));
+        }
+    };
+    opt.graph().iter(on_opr);
+    rewriter.apply_inplace();
+    MIDOUT_E
+#endif  // MGB_ENABLE_COND_EXEC
+}
+
 /* ======================= RemoveRedundantTypeCvtPass ====================== */
 
 const char* RemoveRedundantTypeCvtPass::name() const {
@@ -1078,4 +1211,327 @@ void RemoveShapeHintPass::apply(OptState& opt) const {
     MIDOUT_E
 }
 
+/* ======================= CompNodePartitionPass ====================== */
+
+namespace {
+//! whether the device value of \p var is read by \p opr
+bool is_dev_value_input(OperatorNodeBase* opr, VarNode* var) {
+    return cg::OperatorNodeProp::is_device_value_dep(
+            opr->node_prop().dep_map().at(var));
+}
+
+bool is_placeable(OperatorNodeBase* opr) {
+    if (opr->input().empty() || opr->same_type<opr::Copy>() ||
+        opr->config().comp_node().size() > 1)
+        return false;
+    auto cn = opr->output(0)->comp_node();
+    for (auto i : opr->output()) {
+        if (i->comp_node() != cn)
+            return false;
+    }
+    return true;
+}
+}  // anonymous namespace
+
+CompNodePartitionPass::CompNodePartitionPass(std::vector<Device> devices)
+        : CompNodePartitionPass(std::move(devices), CopyCost{}) {}
+
+CompNodePartitionPass::CompNodePartitionPass(
+        std::vector<Device> devices, CopyCost copy_cost)
+        : m_devices{std::move(devices)}, m_copy_cost{copy_cost} {
+    mgb_assert(!m_devices.empty(), "no device to place the oprs on");
+    for (auto&& i : m_devices) {
+        mgb_assert(
+                i.comp_node.valid() && i.flops_per_usec > 0,
+                "invalid device to place the oprs on");
+    }
+}
+
+const char* CompNodePartitionPass::name() const {
+    return "comp_node_partition";
+}
+
+ThinHashMap<OperatorNodeBase*, CompNode> CompNodePartitionPass::place(
+        OptState& opt) const {
+    ThinHashMap<OperatorNodeBase*, CompNode> opr2cn;
+    ThinHashMap<VarNode*, CompNode> var2cn;
+    OprFootprint footprint;
+    auto comp_node_of = [&](VarNode* var) {
+        auto iter = var2cn.find(var);
+        return iter == var2cn.end() ? var->comp_node() : iter->second;
+    };
+    auto copy_latency = [&](VarNode* var) {
+        size_t bytes = 0;
+        if (var->shape().ndim)
+            bytes = var->dtype().size(var->shape().total_nr_elems());
+        return m_copy_cost.latency_usec + bytes / m_copy_cost.bytes_per_usec;
+    };
+
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        if (!is_placeable(opr))
+            return;
+        auto cur_cn = opr->output(0)->comp_node();
+        float computation = footprint.get_computation(opr);
+        CompNode best_cn;
+        float best_latency = std::numeric_limits<float>::infinity();
+        for (auto&& dev : m_devices) {
+            if (dev.supports && !dev.supports(opr))
+                continue;
+            float latency = computation / dev.flops_per_usec;
+            for (auto i : opr->input()) {
+                if (is_dev_value_input(opr, i) && comp_node_of(i) != dev.comp_node)
+                    latency += copy_latency(i);
+            }
+            // keep the opr on its comp node if it is not slower
+            if (latency < best_latency ||
+                (latency == best_latency && dev.comp_node == cur_cn)) {
+                best_cn = dev.comp_node;
+                best_latency = latency;
+            }
+        }
+        if (!best_cn.valid())
+            return;
+        opr2cn[opr] = best_cn;
+        for (auto i : opr->output())
+            var2cn[i] = best_cn;
+    };
+    opt.graph().iter(on_opr);
+    return opr2cn;
+}
+
+void CompNodePartitionPass::apply(OptState& opt) const {
+    MIDOUT_B("CompNodePartitionPass::apply")
+    auto opr2cn = place(opt);
+    auto rewriter = opt.graph().make_rewriter();
+    //! the outputs of the placed oprs before they are copied back for the
+    //! endpoints, and the copies of the vars to other comp nodes
+    ThinHashMap<VarNode*, VarNode*> placed_vars;
+    ThinHashMap<VarNode*, CompNode::UnorderedMap<VarNode*>> copied_vars;
+    auto get_var = [&](VarNode* var, CompNode cn) {
+        auto iter = placed_vars.find(var);
+        auto new_var = iter == placed_vars.end() ? rewriter.get_var(var) : iter->second;
+        if (new_var->comp_node() == cn)
+            return new_var;
+        auto&& copy = copied_vars[new_var][cn];
+        if (!copy)
+            copy = opr::Copy::make(new_var, OperatorNodeConfig{cn}).node();
+        return copy;
+    };
+
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        auto iter = opr2cn.find(opr);
+        bool placed = iter != opr2cn.end();
+        auto cn = placed ? iter->second : opr->output(0)->comp_node();
+        // the device values are copied to the comp node of the opr, and the
+        // inputs of the oprs not placed are copied back to where they were
+        VarNodeArray inputs;
+        bool changed = placed && cn != opr->output(0)->comp_node();
+        for (auto i : opr->input()) {
+            if (!placed)
+                inputs.push_back(get_var(i, i->comp_node()));
+            else if (is_dev_value_input(opr, i))
+                inputs.push_back(get_var(i, cn));
+            else
+                inputs.push_back(rewriter.get_var(i));
+            changed |= inputs.back() != rewriter.get_var(i);
+        }
+        if (!changed) {
+            rewriter.auto_replace_outputs(opr);
+            return;
+        }
+        auto config = opr->config();
+        if (placed)
+            config.comp_node(cn);
+        auto new_opr = serialization::copy_opr_shallow(*opr, inputs, config);
+        auto &&out0 = opr->output(), &&out1 = new_opr->output();
+        mgb_assert(out0.size() == out1.size());
+        for (size_t i = 0; i < out0.size(); ++i) {
+            auto var = out1[i];
+            if (var->comp_node() != out0[i]->comp_node()) {
+                placed_vars[out0[i]] = var;
+                if (opt.graph().endpoint_contain(out0[i])) {
+                    var = opr::Copy::make(var, OperatorNodeConfig{out0[i]->comp_node()})
+                                  .node();
+                }
+            }
+            rewriter.replace_var(
+                    out0[i], var,
+                    mgb_ssprintf_log("place on %s", cn.to_string().c_str()).c_str());
+        }
+    };
+    opt.graph().iter(on_opr);
+    rewriter.apply_inplace();
+    MIDOUT_E
+}
+
+/* ======================= MicroBatchPipelinePass ====================== */
+
+namespace {
+//! whether \p axis of a var with \p ndim dims is the batch axis; the axes out
+//! of range, such as the INT_MAX for a flattened input, cover it as well
+bool on_batch_axis(int axis, size_t ndim) {
+    if (axis < 0)
+        axis += static_cast<int>(ndim);
+    return axis <= 0 || static_cast<size_t>(axis) >= ndim;
+}
+
+//! the reason why the samples of \p opr can not be split into micro-batches,
+//! or empty if they are computed independently
+std::string cross_batch_reason(OperatorNodeBase* opr) {
+    using F = cg::OperatorNodeProp::Flag;
+    auto&& prop = opr->node_prop();
+    if (prop.contain(F::IMPURE_FUNC))
+        return "it is not a pure function";
+    if (prop.contain(F::FORCE_UPDATE_INPUT_VAR))
+        return "it updates its input";
+    if (auto bn = opr->try_cast_final<opr::BatchNorm>()) {
+        if (bn->param().fwd_mode == opr::BatchNorm::Param::FwdMode::TRAINING)
+            return "the statistics are computed over the batch";
+    } else if (auto sm = opr->try_cast_final<opr::Softmax>()) {
+        if (on_batch_axis(sm->param().axis, opr->input(0)->shape().ndim))
+            return "it is computed along the batch axis";
+    } else if (auto cs = opr->try_cast_final<opr::Cumsum>()) {
+        if (on_batch_axis(cs->param().axis, opr->input(0)->shape().ndim))
+            return "it is computed along the batch axis";
+    }
+    return {};
+}
+}  // anonymous namespace
+
+MicroBatchPipelinePass::MicroBatchPipelinePass(size_t nr_micro_batch)
+        : m_nr_micro_batch{nr_micro_batch} {
+    mgb_assert(nr_micro_batch, "number of micro-batches must be positive");
+}
+
+const char* MicroBatchPipelinePass::name() const {
+    return "micro_batch_pipeline";
+}
+
+bool MicroBatchPipelinePass::find_batched_vars(
+        OptState& opt, ThinHashSet<VarNode*>& batched) const {
+    size_t batch = 0;
+    std::string reason;
+    auto check_batch = [&](VarNode* var) {
+        auto&& shape = var->shape();
+        if (shape.ndim && shape[0] == batch)
+            return true;
+        reason = ssprintf(
+                "%s{%s} does not have the batch size %zu", var->cname(),
+                shape.to_string().c_str(), batch);
+        return false;
+    };
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        if (!reason.empty())
+            return;
+        if (opr->same_type<opr::Host2DeviceCopy>()) {
+            auto var = opr->output(0);
+            if (!batch && var->shape().ndim)
+                batch = var->shape()[0];
+            if (!check_batch(var))
+                return;
+            if (!batch || batch % m_nr_micro_batch) {
+                reason = ssprintf(
+                        "batch size %zu can not be split into %zu micro-batches",
+                        batch, m_nr_micro_batch);
+                return;
+            }
+            batched.insert(var);
+            return;
+        }
+        bool depend = false, dev_depend = false;
+        for (auto i : opr->input()) {
+            if (batched.count(i)) {
+                depend = true;
+                dev_depend |= is_dev_value_input(opr, i);
+            }
+        }
+        if (!depend)
+            return;
+        if (dev_depend) {
+            auto why = cross_batch_reason(opr);
+            if (!why.empty()) {
+                reason = ssprintf(
+                        "%s{%s}: %s", opr->cname(), opr->dyn_typeinfo()->name,
+                        why.c_str());
+                return;
+            }
+        }
+        for (auto i : opr->output()) {
+            batched.insert(i);
+            // the oprs only reading the shapes, such as GetVarShape, are
+            // replicated as well, but their outputs are not split
+            if (dev_depend && !i->contain_flag(VarNode::Flag::VOLATILE_CONTENT) &&
+                !check_batch(i))
+                return;
+        }
+    };
+    opt.graph().iter(on_opr);
+    for (auto i : opt.graph().endpoint_vars()) {
+        if (!reason.empty())
+            break;
+        if (batched.count(i.node()) &&
+            !i.node()->owner_opr()->same_type<opr::Host2DeviceCopy>())
+            check_batch(i.node());
+    }
+    if (!reason.empty()) {
+        mgb_log_warn("micro-batch pipeline is not applied: %s", reason.c_str());
+        return false;
+    }
+    return !batched.empty();
+}
+
+void MicroBatchPipelinePass::apply(OptState& opt) const {
+    MIDOUT_B("MicroBatchPipelinePass::apply")
+    ThinHashSet<VarNode*> batched;
+    if (m_nr_micro_batch == 1 || !find_batched_vars(opt, batched))
+        return;
+
+    auto rewriter = opt.graph().make_rewriter();
+    //! the vars of each micro-batch that replace a batched var
+    ThinHashMap<VarNode*, VarNodeArray> var2parts;
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        if (opr->same_type<opr::Host2DeviceCopy>()) {
+            rewriter.auto_replace_outputs(opr);
+            auto var = opr->output(0);
+            if (batched.count(var)) {
+                auto parts = opr::Split::make(
+                        rewriter.get_var(var),
+                        opr::Split::Options::make_average(0, m_nr_micro_batch));
+                var2parts[var] = cg::to_var_node_array(parts);
+            }
+            return;
+        }
+        if (!batched.count(opr->output(0))) {
+            rewriter.auto_replace_outputs(opr);
+            return;
+        }
+        for (size_t i = 0; i < m_nr_micro_batch; ++i) {
+            VarNodeArray inputs;
+            for (auto inp : opr->input()) {
+                auto iter = var2parts.find(inp);
+                inputs.push_back(
+                        iter == var2parts.end() ? rewriter.get_var(inp)
+                                                : iter->second[i]);
+            }
+            auto config = opr->config();
+            config.name(ssprintf("%s:mb%zu", opr->cname(), i));
+            auto new_opr = serialization::copy_opr_shallow(*opr, inputs, config);
+            mgb_assert(new_opr->output().size() == opr->output().size());
+            for (size_t j = 0; j < opr->output().size(); ++j)
+                var2parts[opr->output(j)].push_back(new_opr->output(j));
+        }
+        for (auto i : opr->output()) {
+            if (opt.graph().endpoint_contain(i)) {
+                auto var = opr::Concat::make(
+                        var2parts.at(i), 0, OperatorNodeConfig{i->comp_node()});
+                rewriter.replace_var(
+                        i, var.node(), mgb_cstr_log("concat micro-batches"));
+            }
+        }
+    };
+    opt.graph().iter(on_opr);
+    rewriter.apply_inplace();
+    MIDOUT_E
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
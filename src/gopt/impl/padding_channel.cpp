@@ -36,27 +36,24 @@ using ReformatKey = ReformatManager::ReformatKey;
 /* ==================== PaddingChannelPass ================= */
 namespace {
 
-size_t padding_int4(size_t in_channel, bool) {
-    if (in_channel <= 32) {
-        return (8 - (in_channel % 8)) % 8;
-    } else {
-        return (64 - (in_channel % 64)) % 64;
+/*!
+ * pad to the large alignment of the faster kernel only if its speedup over the
+ * kernel of the small alignment pays back the computation of the extra padding
+ */
+size_t padding_for_speedup(
+        size_t in_channel, size_t small_alignment, size_t large_alignment,
+        float speedup) {
+    auto round_up = [in_channel](size_t alignment) {
+        return (in_channel + alignment - 1) / alignment * alignment;
+    };
+    size_t small_padded = round_up(small_alignment),
+           large_padded = round_up(large_alignment);
+    if (large_padded < small_padded * speedup) {
+        return large_padded - in_channel;
     }
+    return small_padded - in_channel;
 }
 
-//! flag is used by user to identify some case, such as in nchw64, flag is used
-//! to identify the convbias and convolution backward
-size_t padding_int8(size_t in_channel, bool flag) {
-    if (flag) {
-        if (in_channel <= 16) {
-            return (4 - (in_channel % 4)) % 4;
-        } else {
-            return (32 - (in_channel % 32)) % 32;
-        }
-    } else {
-        return (4 - (in_channel % 4)) % 4;
-    }
-}
 size_t padding_4(size_t in_channel, bool) {
     return (4 - (in_channel % 4)) % 4;
 };
@@ -69,13 +66,25 @@ size_t padding_8(size_t in_channel, bool) {
 
 std::unique_ptr<PaddingChannelPass> PaddingChannelPass::make(
         cg::GraphCommonOptimizeOptions::LayoutTransform layout_transform,
-        bool only_padding_weights) {
+        bool only_padding_weights, float large_alignment_speedup) {
     MIDOUT_B("PaddingChannelPass::make")
     using LayoutTrans = cg::GraphCommonOptimizeOptions::LayoutTransform;
     auto ret = std::unique_ptr<PaddingChannelPass>(
             new PaddingChannelPass(only_padding_weights));
     auto& alignment_map = ret->m_alignment_map;
     if (layout_transform == LayoutTrans::NCHW64) {
+        //! int4 is computed by NCHW64 or NHWC kernels
+        auto padding_int4 = [large_alignment_speedup](size_t in_channel, bool) {
+            return padding_for_speedup(in_channel, 8, 64, large_alignment_speedup);
+        };
+        //! int8 is computed by NCHW32 or NCHW4 kernels, and flag is used to
+        //! identify the convbias and convolution backward
+        auto padding_int8 = [large_alignment_speedup](size_t in_channel, bool flag) {
+            if (!flag) {
+                return padding_4(in_channel, flag);
+            }
+            return padding_for_speedup(in_channel, 4, 32, large_alignment_speedup);
+        };
         alignment_map[DTypeEnum::QuantizedS4] = padding_int4;
         alignment_map[DTypeEnum::Quantized4Asymm] = padding_int4;
         alignment_map[DTypeEnum::QuantizedS8] = padding_int8;
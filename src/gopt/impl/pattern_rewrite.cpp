@@ -0,0 +1,150 @@
+#include "megbrain/gopt/pattern_rewrite.h"
+
+#include "megbrain/utils/hash_ct.h"
+#include "midout.h"
+
+MIDOUT_DECL(megbrain_pattern_rewrite)
+#define MIDOUT_B(tag) \
+    MIDOUT_BEGIN(megbrain_pattern_rewrite, midout_iv(MGB_HASH_STR(tag))) {
+#define MIDOUT_E \
+    }            \
+    MIDOUT_END();
+
+using namespace mgb;
+using namespace gopt;
+
+/* ================ PatternRewritePass::Matcher ================ */
+
+class PatternRewritePass::Matcher {
+    const UniqReaderCheck& m_uniq_reader_check;
+
+    static bool bind(const Pattern& pattern, VarNode* var, PatternMatch& match) {
+        if (pattern.m_name.empty())
+            return true;
+        auto ins = match.m_vars.insert({pattern.m_name, var});
+        return ins.second || ins.first->second == var;
+    }
+
+    static bool check_constraints(const Pattern& pattern, VarNode* var) {
+        for (auto&& i : pattern.m_constraints) {
+            if (!i(var))
+                return false;
+        }
+        return true;
+    }
+
+    //! match the inputs in order; \p match is only modified on success
+    bool match_inputs_ordered(
+            const std::vector<Pattern>& patterns, const VarNodeArray& inputs,
+            bool swap, PatternMatch& match) const {
+        PatternMatch ret = match;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            size_t idx = swap ? patterns.size() - 1 - i : i;
+            if (!match_var(patterns[i], inputs[idx], ret))
+                return false;
+        }
+        match = std::move(ret);
+        return true;
+    }
+
+    bool match_inputs(
+            const Pattern& pattern, const VarNodeArray& inputs,
+            PatternMatch& match) const {
+        if (pattern.m_inputs.empty())
+            return true;
+        if (pattern.m_inputs.size() != inputs.size())
+            return false;
+        if (match_inputs_ordered(pattern.m_inputs, inputs, false, match))
+            return true;
+        return pattern.m_commutative && inputs.size() == 2 &&
+               match_inputs_ordered(pattern.m_inputs, inputs, true, match);
+    }
+
+    //! \p var is in the rewritten graph
+    bool match_var(const Pattern& pattern, VarNode* var, PatternMatch& match) const {
+        if (pattern.m_type) {
+            auto opr = var->owner_opr();
+            if (opr->dyn_typeinfo() != pattern.m_type ||
+                opr->usable_output().size() != 1 || !m_uniq_reader_check(var))
+                return false;
+            if (!check_constraints(pattern, var) ||
+                !match_inputs(pattern, opr->input(), match))
+                return false;
+        } else if (!check_constraints(pattern, var)) {
+            return false;
+        }
+        return bind(pattern, var, match);
+    }
+
+public:
+    explicit Matcher(const UniqReaderCheck& uniq_reader_check)
+            : m_uniq_reader_check{uniq_reader_check} {}
+
+    /*!
+     * \brief match the pattern rooted at \p opr in the original graph, whose
+     *      inputs are given by \p inputs in the rewritten graph
+     */
+    bool match_root(
+            const Pattern& pattern, OperatorNodeBase* opr, const VarNodeArray& inputs,
+            PatternMatch& match) const {
+        mgb_assert(pattern.m_type, "the root of a pattern must be an operator");
+        if (opr->dyn_typeinfo() != pattern.m_type ||
+            opr->usable_output().size() != 1)
+            return false;
+        auto var = opr->output(0);
+        return check_constraints(pattern, var) &&
+               match_inputs(pattern, inputs, match) && bind(pattern, var, match);
+    }
+};
+
+/* ================ PatternRewritePass ================ */
+
+PatternRewritePass& PatternRewritePass::add_rule(
+        std::string name, Pattern pattern, Builder builder) {
+    m_rules.push_back({std::move(name), std::move(pattern), std::move(builder)});
+    return *this;
+}
+
+const char* PatternRewritePass::name() const {
+    return "pattern_rewrite";
+}
+
+void PatternRewritePass::apply(OptState& opt) const {
+    MIDOUT_B("PatternRewritePass::apply")
+    UniqReaderCheck uniq_reader_check{opt.graph()};
+    Matcher matcher{uniq_reader_check};
+    auto rewriter = opt.graph().make_rewriter();
+
+    auto try_rewrite = [&](OperatorNodeBase* opr) -> bool {
+        VarNodeArray inputs;
+        for (auto i : opr->input())
+            inputs.push_back(rewriter.get_var(i));
+        for (auto&& rule : m_rules) {
+            PatternMatch match;
+            if (!matcher.match_root(rule.pattern, opr, inputs, match))
+                continue;
+            auto new_var = rule.builder(match);
+            if (!new_var)
+                continue;
+            rewriter.replace_var(
+                    opr->output(0), new_var,
+                    mgb_ssprintf_log("pattern rewrite: %s", rule.name.c_str())
+                            .c_str());
+            uniq_reader_check.update_on_opr_auto_replace(opr, new_var->owner_opr());
+            return true;
+        }
+        return false;
+    };
+
+    auto on_opr = [&](OperatorNodeBase* opr) {
+        if (try_rewrite(opr))
+            return;
+        auto new_opr = rewriter.auto_replace_outputs(opr);
+        uniq_reader_check.update_on_opr_auto_replace(opr, new_opr);
+    };
+    opt.graph().iter(on_opr);
+    rewriter.apply_inplace();
+    MIDOUT_E
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
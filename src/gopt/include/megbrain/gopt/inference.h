@@ -65,6 +65,30 @@ public:
     void apply(OptState& opt) const override;
 };
 
+/*!
+ * \brief move the transforms of constant weights out of the oprs, so that the
+ *      transformed weights are folded into params by ParamFusePass
+ *
+ * Currently the transposed constant operands of MatrixMul and
+ * BatchedMatrixMul are stored transposed, so the oprs can use the kernels for
+ * non-transposed operands, which are the fastest on most platforms.
+ */
+class PrecomputeWeightPass final : public Pass {
+    size_t m_size_budget;
+
+public:
+    /*!
+     * \param size_budget max bytes of the transformed weights whose original
+     *      weights are also read by other oprs and have to be kept
+     */
+    explicit PrecomputeWeightPass(
+            size_t size_budget = std::numeric_limits<size_t>::max())
+            : m_size_budget{size_budget} {}
+
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+};
+
 /*!
  * \brief replace the dtype of opr from float32 to float16.
  */
@@ -78,6 +102,7 @@ class ConvertF32ToF16Pass : public Pass {
             thin_function<VarNodeArray(OperatorNodeBase*, const VarNodeArray&)>>
             m_multi_tensor_replace_func;
     VarReplaceCheckFlag m_var_replace_check_flag = VarReplaceCheckFlag::CHECK_ALL;
+    thin_function<bool(OperatorNodeBase*)> m_keep_f32;
 
 public:
     const char* name() const override;
@@ -87,9 +112,30 @@ public:
         return *this;
     }
 
+    /*!
+     * \brief keep the oprs for which \p pred returns true in float32
+     *
+     * The float16 inputs of such oprs are converted to float32 and their
+     * float32 outputs are converted back to float16, so the rest of the graph
+     * is still computed in float16.
+     */
+    ConvertF32ToF16Pass& keep_f32(thin_function<bool(OperatorNodeBase*)> pred) {
+        m_keep_f32 = std::move(pred);
+        return *this;
+    }
+
+    //! whether \p opr loses too much accuracy in float16, like softmax,
+    //! normalizations and accumulating reductions
+    static bool is_f16_sensitive(OperatorNodeBase* opr);
+
     void apply(OptState& opt) const override;
 
-    static std::unique_ptr<ConvertF32ToF16Pass> make(bool use_f32_comp);
+    /*!
+     * \param keep_sensitive_f32 whether to keep the oprs that satisfy
+     *      is_f16_sensitive() in float32
+     */
+    static std::unique_ptr<ConvertF32ToF16Pass> make(
+            bool use_f32_comp, bool keep_sensitive_f32 = false);
 };
 
 /*!
@@ -145,6 +191,26 @@ public:
     void apply(OptState& opt) const override;
 };
 
+/*!
+ * \brief fuse a NCHW44 float32 channel wise ConvBias and the 1x1 ConvBias
+ *      reading it into a DepthwisePointwiseConvBias opr
+ */
+class FuseDepthwisePointwiseConvBiasPass : public Pass {
+public:
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+};
+
+/*!
+ * \brief fuse a LayerNorm reading the sum of two same shaped vars into a
+ *      ResidualLayerNorm opr, which also provides the sum to its other readers
+ */
+class FuseResidualLayerNormPass : public Pass {
+public:
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+};
+
 /*!
  * \brief fuse preprocess, like pad channel, quint8 to qint8
  */
@@ -322,6 +388,12 @@ struct OptimizeForInferenceOptions : cg::GraphCommonOptimizeOptions {
     OptimizeForInferenceOptions() = default;
     OptimizeForInferenceOptions(const cg::GraphCommonOptimizeOptions& opt)
             : cg::GraphCommonOptimizeOptions(opt){};
+
+    //! precompute_weight_size_budget is stored in bits [11, 32) as its KiB
+    //! (rounded up) plus one; zero, as in models dumped before the field was
+    //! added, and budgets too large for the field mean unlimited
+    static constexpr uint64_t SIZE_BUDGET_SHIFT = 11, SIZE_BUDGET_MASK = (1u << 21) - 1;
+
     uint64_t serialize() {
         uint64_t ret = 0;
         ret |= (uint64_t)layout_transform << 32;
@@ -339,6 +411,18 @@ struct OptimizeForInferenceOptions : cg::GraphCommonOptimizeOptions {
             ret |= 1u << 5;
         if (fuse_grain)
             ret |= 1u << 6;
+        if (fuse_depthwise_pointwise_conv_bias)
+            ret |= 1u << 7;
+        if (fuse_residual_layer_norm)
+            ret |= 1u << 8;
+        if (precompute_weight)
+            ret |= 1u << 9;
+        if (f16_mixed_precision)
+            ret |= 1u << 10;
+        if (precompute_weight_size_budget / 1024 < SIZE_BUDGET_MASK - 1) {
+            uint64_t budget_kb = (precompute_weight_size_budget + 1023) / 1024;
+            ret |= (budget_kb + 1) << SIZE_BUDGET_SHIFT;
+        }
         return ret;
     }
 
@@ -351,6 +435,13 @@ struct OptimizeForInferenceOptions : cg::GraphCommonOptimizeOptions {
         ret.weight_preprocess = buf & 1u << 4;
         ret.fuse_preprocess = buf & 1u << 5;
         ret.fuse_grain = buf & 1u << 6;
+        ret.fuse_depthwise_pointwise_conv_bias = buf & 1u << 7;
+        ret.fuse_residual_layer_norm = buf & 1u << 8;
+        ret.precompute_weight = buf & 1u << 9;
+        ret.f16_mixed_precision = buf & 1u << 10;
+        if (uint64_t budget = buf >> SIZE_BUDGET_SHIFT & SIZE_BUDGET_MASK) {
+            ret.precompute_weight_size_budget = (budget - 1) * 1024;
+        }
         ret.layout_transform = (LayoutTransform)(buf >> 32);
         return ret;
     }
@@ -529,9 +620,18 @@ public:
 
     void fill_opr_convert_fun(LayoutTrans layout_trans);
 
-    //! make channel padding opt pass with given tensor format
+    /*!
+     * \brief make channel padding opt pass with given tensor format
+     *
+     * \param large_alignment_speedup for the formats with kernels of different
+     *      channel alignments (e.g. NCHW64 and NHWC for int4), the estimated
+     *      speedup of the kernel of the large alignment; channels are padded to
+     *      the large alignment only if the speedup pays back the computation of
+     *      the extra padding
+     */
     static std::unique_ptr<PaddingChannelPass> make(
-            LayoutTrans layout_transform, bool only_padding_weights = false);
+            LayoutTrans layout_transform, bool only_padding_weights = false,
+            float large_alignment_speedup = 2.f);
 
 private:
     PaddingChannelPass(bool only_padding_weights = false)
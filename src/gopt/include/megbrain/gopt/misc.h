@@ -93,6 +93,26 @@ public:
     void apply(OptState& opt) const override;
 };
 
+/*!
+ * \brief share the computation that is repeated in conditional branches
+ *
+ * An operator whose inputs are the marked versions of the same vars in
+ * different branches (i.e. CondExecMark outputs of the same inputs under
+ * different PPVs) computes the same value in each branch where it is
+ * executed. Such operators are hoisted out of the branches and computed once
+ * on the unmarked vars, and their outputs are marked again before being
+ * consumed by the branch-specific operators.
+ *
+ * An operator is hoisted only if it appears in at least two branches, or its
+ * unmarked version is already computed unconditionally. Note that a hoisted
+ * operator is executed even if none of the branches is active.
+ */
+class CondExecCSEPass final : public Pass {
+public:
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+};
+
 //! scan allreduces of param grads
 class PackAllReduceScanPass final : public Pass {
 public:
@@ -137,6 +157,84 @@ public:
     void apply(OptState& opt) const override;
 };
 
+/*!
+ * \brief place the oprs on comp nodes by the op support and a latency cost model
+ *
+ * The oprs are visited in topological order, and each of them is placed on the
+ * device that supports it with the least latency, which is its computation
+ * divided by the throughput of the device plus the latency of copying its
+ * inputs from the devices of their producers. The copies are inserted as
+ * opr::Copy, which run asynchronously on the comp nodes and overlap with the
+ * computing of other devices.
+ *
+ * The source oprs (i.e. the inputs and the params), the copies and the oprs on
+ * multiple comp nodes keep their comp nodes, and the endpoint vars are copied
+ * back to their original comp nodes, so the IO of the graph is not changed.
+ */
+class CompNodePartitionPass final : public Pass {
+public:
+    struct Device {
+        CompNode comp_node;
+        //! computing throughput used to estimate the latency of the oprs
+        float flops_per_usec = 1e3f;
+        //! whether an opr can be placed on the device; all the oprs are
+        //! supported if it is not set
+        thin_function<bool(OperatorNodeBase*)> supports;
+    };
+
+    struct CopyCost {
+        float bytes_per_usec = 1e3f;
+        //! the fixed latency of a copy, such as the launch and the sync
+        float latency_usec = 10.f;
+    };
+
+    explicit CompNodePartitionPass(std::vector<Device> devices);
+    CompNodePartitionPass(std::vector<Device> devices, CopyCost copy_cost);
+
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+
+private:
+    std::vector<Device> m_devices;
+    CopyCost m_copy_cost;
+
+    //! the comp nodes of the oprs whose comp nodes can be changed
+    ThinHashMap<OperatorNodeBase*, CompNode> place(OptState& opt) const;
+};
+
+/*!
+ * \brief split the batch of the graph into micro-batches to pipeline them over
+ *      the comp nodes
+ *
+ * The outputs of Host2DeviceCopy are taken as the batched inputs and split into
+ * \p nr_micro_batch parts along the first axis. The oprs depending on them are
+ * replicated for each micro-batch, and the batched endpoint vars are
+ * concatenated from the micro-batches. The cross comp node copies of different
+ * micro-batches are synchronized by their own events, so a stage on one comp
+ * node works on a micro-batch while the next stage works on the previous one.
+ *
+ * The samples must be computed independently, i.e. each var computed from the
+ * device value of the batched vars must have the batch size as its first
+ * dimension. The graph is not changed if the shapes can not be inferred
+ * statically or do not satisfy this, or if the batched vars are used by impure
+ * oprs (e.g. RNG), oprs updating their inputs (e.g. AddUpdate) or oprs mixing
+ * the samples (e.g. BatchNorm in training mode, Softmax or Cumsum on axis 0).
+ */
+class MicroBatchPipelinePass final : public Pass {
+public:
+    explicit MicroBatchPipelinePass(size_t nr_micro_batch);
+
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+
+private:
+    size_t m_nr_micro_batch;
+
+    //! find the vars depending on the batched inputs; return false if the
+    //! graph can not be split
+    bool find_batched_vars(OptState& opt, ThinHashSet<VarNode*>& batched) const;
+};
+
 }  // namespace gopt
 }  // namespace mgb
 
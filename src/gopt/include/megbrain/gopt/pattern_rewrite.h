@@ -0,0 +1,140 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "megbrain/gopt/framework.h"
+
+namespace mgb {
+namespace gopt {
+
+/*!
+ * \brief a pattern of the subgraph that computes a var
+ *
+ * A pattern is either a leaf that matches any var, or an operator of a given
+ * type whose inputs match the input patterns in order. For example,
+ * relu(x + b) is described by
+ *
+ *      Pattern::op<opr::Elemwise>({Pattern::op<opr::Elemwise>(
+ *              {Pattern::any("x"), Pattern::any("b")}).where(is_add).bind("add")})
+ *              .where(is_relu)
+ *
+ * A name bound to more than one pattern requires them to match the same var,
+ * so x * sigmoid(x) can be described by binding both leaves to "x".
+ */
+class Pattern {
+public:
+    using Constraint = thin_function<bool(VarNode*)>;
+
+    //! a leaf pattern that matches any var
+    static Pattern any(std::string name = {}) {
+        Pattern ret;
+        ret.m_name = std::move(name);
+        return ret;
+    }
+
+    /*!
+     * \brief a pattern of operator of type \p Opr
+     *
+     * \param inputs patterns of the inputs; the inputs are not checked if it
+     *      is empty
+     */
+    template <class Opr>
+    static Pattern op(std::vector<Pattern> inputs = {}) {
+        Pattern ret;
+        ret.m_type = Opr::typeinfo();
+        ret.m_inputs = std::move(inputs);
+        return ret;
+    }
+
+    //! add a constraint on the matched var
+    Pattern& where(Constraint constraint) {
+        m_constraints.emplace_back(std::move(constraint));
+        return *this;
+    }
+
+    //! bind the matched var to a name, so it can be accessed by the builder
+    Pattern& bind(std::string name) {
+        m_name = std::move(name);
+        return *this;
+    }
+
+    //! allow the two inputs of the operator to be matched in either order
+    Pattern& commutative() {
+        m_commutative = true;
+        return *this;
+    }
+
+private:
+    friend class PatternRewritePass;
+
+    Typeinfo* m_type = nullptr;
+    std::vector<Pattern> m_inputs;
+    SmallVector<Constraint> m_constraints;
+    std::string m_name;
+    bool m_commutative = false;
+};
+
+/*!
+ * \brief the vars bound to the names of a matched pattern
+ *
+ * The vars are in the rewritten graph, except that the root is bound to the
+ * original output var, whose params are valid but whose inputs should be taken
+ * from the bound input patterns.
+ */
+class PatternMatch {
+    std::unordered_map<std::string, VarNode*> m_vars;
+    friend class PatternRewritePass;
+
+public:
+    VarNode* var(const std::string& name) const {
+        auto iter = m_vars.find(name);
+        mgb_assert(iter != m_vars.end(), "unbound name in pattern: %s", name.c_str());
+        return iter->second;
+    }
+
+    template <class Opr>
+    Opr& opr(const std::string& name) const {
+        return var(name)->owner_opr()->cast_final_safe<Opr>();
+    }
+};
+
+/*!
+ * \brief rewrite the subgraphs matching the patterns of the rules
+ *
+ * The rules are tried in the order they are added on each operator as the root
+ * of the patterns, and all the rules are applied in one sweep of the graph in
+ * topological order. Since the patterns are matched against the rewritten
+ * graph, the root of a rule can be the result of a previous rewrite. The
+ * non-root operators of a pattern must have a single output that is read only
+ * by the matched subgraph, so that no computation is duplicated.
+ */
+class PatternRewritePass final : public Pass {
+public:
+    /*!
+     * \brief build the replacement of the output var of the root operator;
+     *      return nullptr to skip the rewrite
+     */
+    using Builder = thin_function<VarNode*(const PatternMatch&)>;
+
+    PatternRewritePass& add_rule(std::string name, Pattern pattern, Builder builder);
+
+    const char* name() const override;
+    void apply(OptState& opt) const override;
+
+private:
+    struct Rule {
+        std::string name;
+        Pattern pattern;
+        Builder builder;
+    };
+    class Matcher;
+
+    std::vector<Rule> m_rules;
+};
+
+}  // namespace gopt
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -14,6 +14,44 @@ namespace gopt {
 class Problem;
 class CachedProfiler;
 
+/*!
+ * \brief an analytic cost model of the target device, with which the layout
+ * transform problem can be solved without running on the device
+ *
+ * The cost (in microseconds) of an operator in an opr format configuration is
+ * estimated by (flops / flops_per_usec + bytes / bytes_per_usec) / efficiency,
+ * where the efficiency table of the configurations (and dtypes) should be
+ * calibrated offline, e.g. from the profiling results of load_and_run on the
+ * target device. A configuration whose efficiency is zero is not supported.
+ */
+class CostModel {
+public:
+    using OprFormatConfigID = Problem::OprFormatConfigID;
+
+    //! peak computation, 1 TFLOPS by default
+    float flops_per_usec = 1e6f;
+    //! memory bandwidth, 100 GB/s by default
+    float bytes_per_usec = 1e5f;
+    //! efficiency of the layout transforms of var nodes
+    float reformat_efficiency = 1.f;
+    //! efficiency of the configs that are not in the table
+    float default_efficiency = 1.f;
+
+    //! set the efficiency of the config for all the dtypes
+    CostModel& set_efficiency(OprFormatConfigID config_id, float efficiency);
+
+    //! set the efficiency of the config for the dtype of the first input
+    CostModel& set_efficiency(
+            OprFormatConfigID config_id, DTypeEnum dtype, float efficiency);
+
+    float efficiency(OprFormatConfigID config_id, DTypeEnum dtype) const;
+
+private:
+    //! key: config id in the high 32 bits, dtype enum + 1 (0 for all the dtypes)
+    //! in the low 32 bits
+    std::unordered_map<uint64_t, float> m_efficiency;
+};
+
 /*!
  * \brief A profiler that collects all the performance data to describe the
  * global layout transform problem.
@@ -85,6 +123,8 @@ public:
     static std::unique_ptr<ProfilerBase> make_profiler();
     static std::unique_ptr<ProfilerBase> make_cached_profiler(
             const char* path = nullptr);
+    static std::unique_ptr<ProfilerBase> make_cost_model_profiler(
+            const CostModel& cost_model);
 
 protected:
     OprFilter m_opr_filter;
@@ -213,9 +253,14 @@ protected:
 /*!
  * \brief a ProfilerCache that manages the profiling results of operator in
  * different layouts and of layout transform of var nodes.
+ *
+ * The results are keyed by the signature of the operator (param and layouts) or
+ * the var node, so that the same operators in different graphs are profiled only
+ * once. Unless an impl is set, the results are kept in the global
+ * PersistentCache, which can be shared across processes by the user.
  */
 class ProfilerCache : public NonCopyableObj {
-    ProfilerCache() : m_impl{std::make_unique<InMemoryPersistentCache>()} {};
+    ProfilerCache() = default;
 
 public:
     using ReformatKey = ReformatManager::ReformatKey;
@@ -279,6 +324,7 @@ public:
 public:
     static ProfilerCache& inst();
 
+    //! set the cache impl, the global PersistentCache is used if impl is null
     ProfilerCache& set_impl(std::unique_ptr<PersistentCache> impl);
 
     void dump_cache(const char* path);
@@ -292,6 +338,10 @@ public:
     void enable_device_info(bool flag) { m_enable_device_info = flag; }
 
 private:
+    PersistentCache& impl() {
+        return m_impl ? *m_impl : PersistentCache::inst();
+    }
+
     std::unique_ptr<PersistentCache> m_impl;
     // whether to save platform information into the cache.
     bool m_enable_device_info = true;
@@ -322,6 +372,43 @@ private:
     const char* m_path;
 };
 
+/*!
+ * \brief a profiler that estimates the costs by the CostModel instead of
+ * running the operators, so it works without the target device
+ *
+ * The computation of an operator in an opr format configuration is scaled from
+ * the original one by the padding of the weight (or the output if the operator
+ * has no weight), and the bytes are those of the aligned tensors.
+ */
+class CostModelProfiler final : public ProfilerImpl {
+public:
+    CostModelProfiler(
+            const CostModel& cost_model, float opr_threshold = 2.f,
+            float var_node_threshold = 2.f);
+
+private:
+    float profile_operator(
+            const OperatorNodeBase* opr, TensorFormats base_format,
+            TensorFormats tensor_format,
+            ReformatAttribute extra_attribute =
+                    ReformatAttribute::DEFAULT) const override;
+    float profile_operator(
+            const OperatorNodeBase* opr,
+            const OprTensorFormatsConfiguration& base_config,
+            const OprTensorFormatsConfiguration& config,
+            ReformatAttribute extra_attribute =
+                    ReformatAttribute::DEFAULT) const override;
+    float profile_var_node(
+            const VarNode* var, TensorFormats base_format,
+            const ReformatKey& key) const override;
+    float estimate(
+            const OperatorNodeBase* opr, OprFormatConfigID config_id,
+            float computation_ratio, float bytes) const;
+
+    CostModel m_cost_model;
+    mutable OprFootprint m_footprint;
+};
+
 }  // namespace gopt
 }  // namespace mgb
 
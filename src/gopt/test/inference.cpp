@@ -11,6 +11,7 @@
 #include "megbrain/opr/dnn/adaptive_pooling.h"
 #include "megbrain/opr/dnn/batch_norm.h"
 #include "megbrain/opr/dnn/convolution.h"
+#include "megbrain/opr/dnn/layer_norm.h"
 #include "megbrain/opr/dnn/pooling.h"
 #include "megbrain/opr/dnn/softmax.h"
 #include "megbrain/opr/imgproc.h"
@@ -1116,6 +1117,41 @@ TEST(TestGoptInference, Float32TOFloat16Endpoints) {
     ASSERT_EQ(out[1].node()->owner_opr()->input(0)->dtype(), dtype::Float16());
 }
 
+TEST(TestGoptInference, Float32TOFloat16MixedPrecision) {
+    HostTensorGenerator<> gen(0, 1, 0);
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({4, 16})),
+         w = opr::SharedDeviceTensor::make(*graph, *gen({16, 32}));
+    opr::Softmax::Param param;
+    param.axis = 1;
+    auto h = opr::MatrixMul::make(x, w), s = opr::Softmax::make(h, param),
+         y = s * 2.f;
+
+    SymbolVar y_opt;
+    auto options = gopt::OptimizeForInferenceOptions{};
+    options.enable_f16_io_comp().enable_f16_mixed_precision();
+    unpack_vector(gopt::optimize_for_inference({y}, options), y_opt);
+
+    SymbolVar s_opt;
+    cg::DepOprIter{[&](cg::OperatorNodeBase* opr) {
+        if (opr->same_type<opr::Softmax>())
+            s_opt = opr->output(0);
+    }}.add(y_opt.node()->owner_opr());
+    ASSERT_EQ(dtype::Float32(), s_opt.dtype());
+    //! the matmul is still computed in float16
+    auto cvt = s_opt.node()->owner_opr()->input(0)->owner_opr();
+    ASSERT_TRUE(cvt->same_type<opr::TypeCvt>());
+    ASSERT_EQ(dtype::Float16(), cvt->input(0)->dtype());
+
+    HostTensorND host_y, host_y_opt;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y, host_y_opt, 1e-2);
+}
+
 TEST(TestGoptInference, ConvertFormatNHWCD4) {
     // hwcd4 is only supported in naive handle
     NaiveMegDNNHandleScope naive_megdnn_handle;
@@ -4241,6 +4277,149 @@ TEST(TestGoptInference, ConvertFormatNCHW44Reshape) {
     MGB_ASSERT_TENSOR_NEAR(host_y, host_y_opt, 1e-1);
 }
 
+TEST(TestGoptInference, FuseDepthwisePointwiseConvBiasNCHW44) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("cpu0");
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    auto mkcvar = [&](const char* name, const TensorShape& shp) {
+        return opr::SharedDeviceTensor::make(*graph, *gen(shp, cn)).rename(name);
+    };
+
+    auto host_x = gen({2, 16, 15, 17}, cn);
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    opr::ConvBias::Param param_dw;
+    param_dw.sparse = opr::ConvBias::Param::Sparse::GROUP;
+    param_dw.pad_h = param_dw.pad_w = 1;
+    param_dw.stride_h = param_dw.stride_w = 2;
+    param_dw.nonlineMode = opr::ConvBias::Param::NonlineMode::RELU;
+    auto w_dw = mkcvar("w_dw", {16, 1, 1, 3, 3}), b_dw = mkcvar("b_dw", {1, 16, 1, 1});
+    auto dw = opr::ConvBias::make(x, w_dw, b_dw, param_dw);
+
+    opr::ConvBias::Param param_pw;
+    param_pw.nonlineMode = opr::ConvBias::Param::NonlineMode::H_SWISH;
+    auto w_pw = mkcvar("w_pw", {24, 16, 1, 1}), b_pw = mkcvar("b_pw", {1, 24, 1, 1});
+    auto y = opr::ConvBias::make(dw, w_pw, b_pw, param_pw);
+
+    SymbolVar y_opt;
+    auto options = gopt::OptimizeForInferenceOptions{};
+    options.enable_nchw44().enable_fuse_depthwise_pointwise_conv_bias();
+    unpack_vector(gopt::optimize_for_inference({y}, options), y_opt);
+
+    auto&& fused = find_opr<opr::DepthwisePointwiseConvBias>(y_opt);
+    ASSERT_EQ(2u, fused.param().stride_h);
+    ASSERT_EQ(
+            opr::ConvBias::Param::NonlineMode::H_SWISH,
+            fused.param().pw_nonline_mode);
+    ASSERT_EQ(0u, find_opr_num<opr::ConvBias>(y_opt));
+
+    HostTensorND host_y_opt, host_y;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y, host_y_opt, 1e-3);
+}
+
+TEST(TestGoptInference, FuseResidualLayerNorm) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("cpu0");
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    auto mkvar = [&](const char* name, const TensorShape& shp) {
+        return opr::Host2DeviceCopy::make(*graph, gen(shp, cn)).rename(name);
+    };
+    auto mkcvar = [&](const char* name, const TensorShape& shp) {
+        return opr::SharedDeviceTensor::make(*graph, *gen(shp, cn)).rename(name);
+    };
+
+    auto x = mkvar("x", {2, 5, 64}), r = mkvar("r", {2, 5, 64});
+    opr::LayerNorm::Param param;
+    param.normalized_dim = 1;
+    param.normalized_size = 64;
+    auto sum = x + r;
+    auto ln = opr::LayerNorm::make(
+            sum, mkcvar("w", {64}), mkcvar("b", {64}), param)[0];
+    //! the sum is also read by the next residual branch
+    auto y = ln * 2.f + sum;
+
+    SymbolVar y_opt;
+    auto options = gopt::OptimizeForInferenceOptions{};
+    options.enable_fuse_residual_layer_norm();
+    unpack_vector(gopt::optimize_for_inference({y}, options), y_opt);
+
+    ASSERT_EQ(1u, find_opr_num<opr::ResidualLayerNorm>(y_opt));
+    ASSERT_EQ(0u, find_opr_num<opr::LayerNorm>(y_opt));
+
+    HostTensorND host_y_opt, host_y;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y, host_y_opt, 1e-5);
+}
+
+TEST(TestGoptInference, PrecomputeWeight) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("cpu0");
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    auto mkcvar = [&](const char* name, const TensorShape& shp) {
+        return opr::SharedDeviceTensor::make(*graph, *gen(shp, cn)).rename(name);
+    };
+
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({4, 16}, cn));
+    auto w0 = mkcvar("w0", {32, 16}), w1 = mkcvar("w1", {32, 32});
+    opr::MatrixMul::Param param;
+    param.transposeB = true;
+    auto h = opr::MatrixMul::make(x, w0, param);
+    //! w1 is also read by the second matmul, so it has to be kept
+    auto y = opr::MatrixMul::make(h, w1, param) + opr::MatrixMul::make(h, w1);
+
+    auto nr_transposed = [](SymbolVar var) {
+        size_t nr = 0;
+        cg::DepOprIter{[&](cg::OperatorNodeBase* opr) {
+            if (auto matmul = opr->try_cast_final<opr::MatrixMul>())
+                nr += matmul->param().transposeB;
+        }}.add(var.node()->owner_opr());
+        return nr;
+    };
+    auto run = [&](size_t size_budget) {
+        SymbolVar y_opt;
+        auto options = gopt::OptimizeForInferenceOptions{};
+        options.enable_precompute_weight();
+        options.precompute_weight_size_budget = size_budget;
+        unpack_vector(gopt::optimize_for_inference({y}, options), y_opt);
+        return y_opt;
+    };
+
+    auto y_opt = run(0);
+    ASSERT_EQ(1u, nr_transposed(y_opt));
+    y_opt = run(32 * 32 * sizeof(float));
+    ASSERT_EQ(0u, nr_transposed(y_opt));
+
+    HostTensorND host_y_opt, host_y;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_y, host_y_opt, 1e-5);
+
+    //! the budget is kept in the options serialized into the model
+    auto round_trip = [](size_t size_budget) {
+        gopt::OptimizeForInferenceOptions options;
+        options.enable_precompute_weight();
+        options.precompute_weight_size_budget = size_budget;
+        auto ret = gopt::OptimizeForInferenceOptions::deserialize(options.serialize());
+        EXPECT_TRUE(ret.precompute_weight);
+        return ret.precompute_weight_size_budget;
+    };
+    ASSERT_EQ(0u, round_trip(0));
+    ASSERT_EQ(4096u, round_trip(4096));
+    ASSERT_EQ(2048u, round_trip(1025));
+    constexpr size_t unlimited = std::numeric_limits<size_t>::max();
+    ASSERT_EQ(unlimited, round_trip(unlimited));
+    ASSERT_EQ(unlimited, gopt::OptimizeForInferenceOptions::deserialize(0)
+                                 .precompute_weight_size_budget);
+}
+
 TEST(TestGoptInference, ConvertFormatNCHW44GlobalPooling) {
     HostTensorGenerator<> gen;
     auto cn = CompNode::load("cpu0");
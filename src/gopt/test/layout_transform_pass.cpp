@@ -58,8 +58,8 @@ public:
         ProfilerCache::inst().enable_device_info(false);
     }
     ~ProfilerMock() {
-        // reset in memory cache
-        ProfilerCache::inst().set_impl(std::make_unique<InMemoryPersistentCache>());
+        // reset to the global cache
+        ProfilerCache::inst().set_impl(nullptr);
     }
 
 private:
@@ -5,7 +5,11 @@
 #include "megbrain/opr/basic_arith_wrapper.h"
 #include "megbrain/opr/blas.h"
 #include "megbrain/opr/cond.h"
+#include "megbrain/opr/dnn/batch_norm.h"
+#include "megbrain/opr/dnn/softmax.h"
 #include "megbrain/opr/io.h"
+#include "megbrain/opr/misc.h"
+#include "megbrain/opr/rand.h"
 #include "megbrain/opr/tensor_manip.h"
 #include "megbrain/opr/utility.h"
 
@@ -391,6 +395,50 @@ TEST(TestCondExec, GoptRemoveConstMask) {
     }
 }
 
+TEST(TestCondExec, GoptCSE) {
+    using MergeMode = opr::CondExecMerge::Mode;
+    HostTensorGenerator<> gen;
+    auto host_x = gen({2, 3}), host_pred0 = gen({1}), host_pred1 = gen({1});
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    auto make_mark = [&](const std::shared_ptr<HostTensorND>& host_pred) {
+        auto pred = opr::Host2DeviceCopy::make(*graph, host_pred);
+        SymbolVar ppv, ret;
+        unpack_vector(opr::CondExecPred::make(pred, {pred.make_scalar_dt(1)}), ppv);
+        unpack_vector(opr::CondExecMark::make(ppv, {x}), ret);
+        return ret;
+    };
+    auto xmark0 = make_mark(host_pred0), xmark1 = make_mark(host_pred1);
+    auto y0 = opr::exp(xmark0 * xmark0) + 1.2f,
+         y1 = opr::exp(xmark1 * xmark1) * 2.3f,
+         y = opr::CondExecMerge::make({y0, y1}, {1, MergeMode::SUM}, {x.symshape()})[0];
+    VarNodeArray y_opt_arr{y.node()};
+    gopt::GraphOptimizer{}.add_pass<gopt::CondExecCSEPass>().apply_inplace(y_opt_arr);
+    SymbolVar y_opt = y_opt_arr[0];
+
+    size_t nr_exp = 0, nr_mul = 0;
+    cg::DepOprIter{[&](cg::OperatorNodeBase* opr) {
+        if (auto elem = opr->try_cast_final<opr::Elemwise>()) {
+            nr_exp += elem->param().mode == opr::Elemwise::Mode::EXP;
+            nr_mul += elem->param().mode == opr::Elemwise::Mode::MUL;
+        }
+    }}.add(y_opt.node()->owner_opr());
+    ASSERT_EQ(1u, nr_exp);
+    //! one shared x * x and the branch-specific multiplication
+    ASSERT_EQ(2u, nr_mul);
+
+    HostTensorND host_y, host_y_opt;
+    graph->options().graph_opt_level = 0;
+    auto func = graph->compile(
+            {make_callback_copy(y, host_y), make_callback_copy(y_opt, host_y_opt)});
+    for (int pmask = 0; pmask < 4; ++pmask) {
+        host_pred0->ptr<float>()[0] = pmask & 1;
+        host_pred1->ptr<float>()[0] = pmask >> 1;
+        func->execute();
+        MGB_ASSERT_TENSOR_EQ(host_y, host_y_opt);
+    }
+}
+
 #endif  // MGB_ENABLE_COND_EXEC
 
 TEST_PASS(RemoveRedundantTypeCvtPass, Basic) {
@@ -815,4 +863,164 @@ TEST_PASS(PackAllReduceReplacePass, Equivalence) {
 
 #endif  // MGB_ENABLE_OPR_MM
 
+TEST(TestGoptCompNodePartitionPass, Basic) {
+    HostTensorGenerator<> gen;
+    auto cn0 = CompNode::load("cpu0"), cn1 = CompNode::load("cpu1");
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({4, 8}, cn0)),
+         w = opr::SharedDeviceTensor::make(*graph, *gen({8, 6}, cn0));
+    auto y = opr::relu(x), z = opr::relu(opr::MatrixMul::make(y, w));
+
+    //! the matmul is not supported on cn0, and the relu after it stays on cn1
+    //! to avoid a copy, while the output is copied back to cn0
+    using Device = gopt::CompNodePartitionPass::Device;
+    auto no_matmul = [](cg::OperatorNodeBase* opr) {
+        return !opr->same_type<opr::MatrixMul>();
+    };
+    std::vector<Device> devices{{cn0, 1e3f, no_matmul}, {cn1, 1e3f, {}}};
+    SymbolVar z_opt;
+    unpack_vector(
+            gopt::GraphOptimizer{}
+                    .add_pass<gopt::CompNodePartitionPass>(devices)
+                    .apply({{z}})
+                    .endpoint_vars(),
+            z_opt);
+    ASSERT_EQ(cn0, z_opt.node()->comp_node());
+    auto copy = z_opt.node()->owner_opr();
+    ASSERT_TRUE(copy->same_type<opr::Copy>());
+    auto relu = copy->input(0)->owner_opr();
+    ASSERT_EQ(cn1, relu->output(0)->comp_node());
+    auto matmul = relu->input(0)->owner_opr();
+    ASSERT_TRUE(matmul->same_type<opr::MatrixMul>());
+    ASSERT_EQ(cn1, matmul->output(0)->comp_node());
+    for (auto i : matmul->input()) {
+        ASSERT_TRUE(i->owner_opr()->same_type<opr::Copy>());
+        ASSERT_EQ(cn1, i->comp_node());
+    }
+    //! the relu before the matmul is not moved
+    ASSERT_EQ(y.node(), matmul->input(0)->owner_opr()->input(0));
+
+    HostTensorND host_z, host_z_opt;
+    auto func = graph->compile(
+            {make_callback_copy(z, host_z), make_callback_copy(z_opt, host_z_opt)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_z, host_z_opt, 1e-5);
+}
+
+TEST(TestGoptCompNodePartitionPass, CostModel) {
+    HostTensorGenerator<> gen;
+    auto cn0 = CompNode::load("cpu0"), cn1 = CompNode::load("cpu1");
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({32, 32}, cn0));
+    auto y = opr::MatrixMul::make(x, x), z = y + 1.f;
+
+    using Device = gopt::CompNodePartitionPass::Device;
+    auto run = [&](float flops1, float bytes_per_usec) {
+        std::vector<Device> devices{{cn0, 1e3f, {}}, {cn1, flops1, {}}};
+        gopt::CompNodePartitionPass::CopyCost copy_cost{bytes_per_usec, 0.f};
+        return gopt::GraphOptimizer{}
+                .add_pass<gopt::CompNodePartitionPass>(devices, copy_cost)
+                .apply({{z}})
+                .endpoint_vars()[0];
+    };
+    //! a slower device is not used
+    ASSERT_EQ(z, run(1e2f, 1e6f));
+    //! a faster device is used if the copies are cheap enough
+    auto z_opt = run(1e6f, 1e6f);
+    ASSERT_NE(z.node(), z_opt.node());
+    ASSERT_EQ(cn0, z_opt.node()->comp_node());
+    ASSERT_EQ(z, run(1e6f, 1e-3f));
+}
+
+TEST(TestGoptMicroBatchPipelinePass, Basic) {
+    HostTensorGenerator<> gen;
+    auto cn0 = CompNode::load("cpu0"), cn1 = CompNode::load("cpu1");
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({8, 6}, cn0)),
+         w = opr::SharedDeviceTensor::make(*graph, *gen({6, 5}, cn1));
+    auto y = opr::Copy::make(opr::relu(x), cn1),
+         z = opr::relu(opr::MatrixMul::make(y, w)) + 1.f;
+
+    SymbolVar z_opt;
+    unpack_vector(
+            gopt::GraphOptimizer{}
+                    .add_pass<gopt::MicroBatchPipelinePass>(4)
+                    .apply({{z}})
+                    .endpoint_vars(),
+            z_opt);
+    auto concat = z_opt.node()->owner_opr();
+    ASSERT_TRUE(concat->same_type<opr::Concat>());
+    ASSERT_EQ(4u, concat->input().size());
+    size_t nr_copy = 0;
+    cg::DepOprIter{[&](cg::OperatorNodeBase* opr) {
+        if (opr->same_type<opr::Copy>()) {
+            ASSERT_EQ(TensorShape({2, 6}), opr->output(0)->shape());
+            ++nr_copy;
+        }
+    }}.add(z_opt);
+    //! each micro-batch is copied across the comp nodes separately
+    ASSERT_EQ(4u, nr_copy);
+
+    HostTensorND host_z, host_z_opt;
+    auto func = graph->compile(
+            {make_callback_copy(z, host_z), make_callback_copy(z_opt, host_z_opt)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_z, host_z_opt, 1e-5);
+}
+
+TEST(TestGoptMicroBatchPipelinePass, NotSplittable) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({8, 6}));
+    auto run = [](SymbolVar y, size_t nr_micro_batch) {
+        return gopt::GraphOptimizer{}
+                .add_pass<gopt::MicroBatchPipelinePass>(nr_micro_batch)
+                .apply({{y}})
+                .endpoint_vars()[0];
+    };
+    //! the samples are not computed independently
+    auto y = opr::reduce_sum(x, x.make_scalar(1));
+    ASSERT_EQ(y, run(y, 2));
+    //! the batch size is not a multiple of the number of micro-batches
+    auto z = opr::relu(x);
+    ASSERT_EQ(z, run(z, 3));
+    ASSERT_NE(z.node(), run(z, 2).node());
+}
+
+TEST(TestGoptMicroBatchPipelinePass, CrossBatchOpr) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({8, 6})),
+         x4 = opr::Host2DeviceCopy::make(*graph, gen({8, 3, 2, 2}));
+    auto run = [](SymbolVar y) {
+        return gopt::GraphOptimizer{}
+                .add_pass<gopt::MicroBatchPipelinePass>(2)
+                .apply({{y}})
+                .endpoint_vars()[0];
+    };
+    auto check = [&](SymbolVar y) { ASSERT_EQ(y, run(y)); };
+    //! the oprs mixing the samples keep the shape of the batch
+    check(opr::Softmax::make(x, {0}));
+    check(opr::Softmax::make(x, {-2}));
+    check(opr::Cumsum::make(x, {0}));
+    check(opr::Cumsum::make(x, {}));
+    {
+        auto scale = opr::SharedDeviceTensor::make(*graph, *gen({1, 3, 1, 1})),
+             bias = opr::SharedDeviceTensor::make(*graph, *gen({1, 3, 1, 1}));
+        opr::BatchNorm::Param param;
+        param.fwd_mode = opr::BatchNorm::Param::FwdMode::TRAINING;
+        check(opr::BatchNorm::make(x4, scale, bias, param).back());
+    }
+    //! the oprs with side effects
+    check(opr::PoissonRNG::make(opr::relu(x)));
+    check(opr::AddUpdate::make(
+            opr::SharedDeviceTensor::make(*graph, *gen({8, 6})), x));
+
+    //! the oprs computing each sample independently are still split
+    auto y = opr::Softmax::make(x, {1});
+    ASSERT_NE(y.node(), run(y).node());
+    y = opr::Cumsum::make(x, {-1});
+    ASSERT_NE(y.node(), run(y).node());
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -191,6 +191,46 @@ TEST(TestGoptInference, ChannelPaddingNCHW88) {
     check_channel_padding_conv<opr::Convolution::Param::Format::NCHW88>();
 }
 
+TEST(TestGoptInference, ChannelPaddingLargeAlignmentSpeedup) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("cpu0");
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    auto mkcvar = [&](const char* name, const TensorShape& shp, const DType& dtype) {
+        return opr::TypeCvt::make(
+                opr::SharedDeviceTensor::make(*graph, *gen(shp, cn)).rename(name),
+                dtype);
+    };
+
+    auto x = opr::TypeCvt::make(
+            opr::Host2DeviceCopy::make(*graph, gen({2, 64, 8, 8}, cn)),
+            dtype::QuantizedS4(1.f));
+    opr::ConvBias::Param param;
+    param.pad_h = param.pad_w = 1;
+    auto w = mkcvar("w", {40, 64, 3, 3}, dtype::QuantizedS4(1.f)),
+         b = mkcvar("b", {1, 40, 1, 1}, dtype::QuantizedS32(1.f));
+    auto y = opr::ConvBias::make(
+            x, w, b, param, {}, OperatorNodeConfig{dtype::QuantizedS4(1.f)});
+
+    auto padded_channels = [&](float speedup) {
+        SymbolVar y_pad;
+        unpack_vector(
+                gopt::GraphOptimizer{}
+                        .add_pass(gopt::PaddingChannelPass::make(
+                                cg::GraphCommonOptimizeOptions::LayoutTransform::
+                                        NCHW64,
+                                false, speedup))
+                        .apply({{y}})
+                        .endpoint_vars(),
+                y_pad);
+        return find_opr<opr::ConvBias>(y_pad)->output(0)->shape()[1];
+    };
+    //! padding 40 channels to 64 for the NCHW64 kernels costs 1.6 times the
+    //! computation of the NHWC kernels
+    ASSERT_EQ(64u, padded_channels(2.f));
+    ASSERT_EQ(40u, padded_channels(1.5f));
+}
+
 TEST(TestGoptInference, ChannelPaddingSubtensor) {
     HostTensorGenerator<> gen;
     auto cn = CompNode::load("cpu0");
@@ -0,0 +1,112 @@
+#include "./helper.h"
+
+#include "megbrain/gopt/pattern_rewrite.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/io.h"
+
+using namespace mgb;
+
+namespace {
+using Mode = opr::Elemwise::Param::Mode;
+
+gopt::Pattern::Constraint is_mode(Mode mode) {
+    return [mode](VarNode* var) {
+        return var->owner_opr()->cast_final_safe<opr::Elemwise>().param().mode ==
+               mode;
+    };
+}
+
+gopt::Pattern elemwise(Mode mode, std::vector<gopt::Pattern> inputs) {
+    return gopt::Pattern::op<opr::Elemwise>(std::move(inputs)).where(is_mode(mode));
+}
+
+//! relu(x + y) -> fuse_add_relu(x, y)
+std::unique_ptr<gopt::PatternRewritePass> make_add_relu_pass() {
+    auto pass = std::make_unique<gopt::PatternRewritePass>();
+    pass->add_rule(
+            "fuse_add_relu",
+            elemwise(
+                    Mode::RELU,
+                    {elemwise(Mode::ADD, {gopt::Pattern::any("x"),
+                                          gopt::Pattern::any("y")})}),
+            [](const gopt::PatternMatch& m) {
+                return opr::Elemwise::make(
+                               {m.var("x"), m.var("y")}, Mode::FUSE_ADD_RELU)
+                        .node();
+            });
+    return pass;
+}
+
+SymbolVarArray run_opt(
+        std::unique_ptr<gopt::PatternRewritePass> pass, const SymbolVarArray& inp) {
+    return gopt::GraphOptimizer{}
+            .add_pass(std::move(pass))
+            .apply({{inp}})
+            .endpoint_vars();
+}
+}  // namespace
+
+TEST(TestGoptPatternRewrite, FuseAddRelu) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto mkvar = [&](const char* name) {
+        return opr::Host2DeviceCopy::make(*graph, gen({2, 3})).rename(name);
+    };
+    auto x = mkvar("x"), y = mkvar("y"), z = mkvar("z");
+    auto out = opr::relu(opr::relu(x + y) + z);
+
+    SymbolVar out_opt;
+    unpack_vector(run_opt(make_add_relu_pass(), {out}), out_opt);
+    //! the outer pattern is matched against the result of the inner rewrite
+    auto expect = opr::Elemwise::make(
+            {opr::Elemwise::make({x, y}, Mode::FUSE_ADD_RELU), z},
+            Mode::FUSE_ADD_RELU);
+    ASSERT_EQ(expect, out_opt);
+}
+
+TEST(TestGoptPatternRewrite, SharedIntermediate) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({2, 3})),
+         y = opr::Host2DeviceCopy::make(*graph, gen({2, 3}));
+    auto sum = x + y, out0 = opr::relu(sum), out1 = sum * x;
+
+    SymbolVar out0_opt, out1_opt;
+    unpack_vector(run_opt(make_add_relu_pass(), {out0, out1}), out0_opt, out1_opt);
+    ASSERT_EQ(out0, out0_opt);
+    ASSERT_EQ(out1, out1_opt);
+}
+
+TEST(TestGoptPatternRewrite, RepeatedBinding) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({2, 3})),
+         y = opr::Host2DeviceCopy::make(*graph, gen({2, 3}));
+    //! x * sigmoid(x) -> silu(x), where the operands can be swapped
+    auto pass = std::make_unique<gopt::PatternRewritePass>();
+    pass->add_rule(
+            "fuse_silu",
+            elemwise(
+                    Mode::MUL,
+                    {gopt::Pattern::any("x"),
+                     elemwise(Mode::SIGMOID, {gopt::Pattern::any("x")})})
+                    .commutative(),
+            [](const gopt::PatternMatch& m) {
+                return opr::Elemwise::make({m.var("x")}, Mode::SILU).node();
+            });
+    auto out0 = opr::sigmoid(x) * x, out1 = y * opr::sigmoid(x + y);
+
+    SymbolVar out0_opt, out1_opt;
+    unpack_vector(run_opt(std::move(pass), {out0, out1}), out0_opt, out1_opt);
+    ASSERT_EQ(opr::Elemwise::make({x}, Mode::SILU), out0_opt);
+    ASSERT_EQ(out1, out1_opt);
+
+    HostTensorND host_out, host_expect;
+    auto func = graph->compile(
+            {make_callback_copy(out0_opt, host_out),
+             make_callback_copy(out0, host_expect)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_expect, host_out, 1e-5);
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
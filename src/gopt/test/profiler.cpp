@@ -316,6 +316,118 @@ TEST(TestProfiler, Elemwise) {
     EXPECT_TRUE(var_rst.count(q8a.node()) > 0);
     EXPECT_TRUE(var_rst.count(q8b.node()) > 0);
 }
+
+TEST(TestProfiler, CostModel) {
+    //! the cost model profiler does not run on the target device
+    auto cn = CompNode::load("cpu0");
+    auto ctx = make_ctx();
+    using OprFormatConfigID = ProfilerBase::OprFormatConfigID;
+
+    HostTensorGenerator<dtype::Int8> gen;
+    auto graph = ComputingGraph::make();
+    graph->options().graph_opt_level = 0;
+    auto mkvar = [&](const char* name, const TensorShape& shp, const DType& dtype) {
+        return opr::TypeCvt::make(
+                opr::Host2DeviceCopy::make(*graph, gen(shp, cn)).rename(name), dtype);
+    };
+    auto mkcvar = [&](const char* name, const TensorShape& shp, const DType& dtype) {
+        return opr::TypeCvt::make(
+                opr::SharedDeviceTensor::make(*graph, *gen(shp, cn)).rename(name),
+                dtype);
+    };
+    auto x = mkvar("x", {16, 64, 14, 14}, dtype::QuantizedS8(2.5f));
+    auto w = mkcvar("w", {64, 64, 3, 3}, dtype::QuantizedS8(2.5f));
+    auto b = mkcvar("b", {1, 64, 1, 1}, dtype::QuantizedS32(6.25f));
+    opr::ConvBias::Param param;
+    param.nonlineMode = opr::ConvBias::Param::NonlineMode::RELU;
+    param.pad_h = param.pad_w = 1;
+    auto y = opr::ConvBias::make(
+            x, w, b, param, {}, OperatorNodeConfig(dtype::QuantizedS8(2.5f)));
+
+    SubGraphExtractor extractor(ctx->opr_list());
+    auto partitions = extractor.extract({y});
+    ASSERT_EQ(partitions.size(), 1u);
+    Problem problem(partitions[0], *ctx);
+    CostModel cost_model;
+    cost_model.set_efficiency(OprFormatConfigID::NCHW4, DTypeEnum::QuantizedS8, 4.f)
+            .set_efficiency(OprFormatConfigID::NCHW32, 0.f);
+    auto profiler = ProfilerBase::make_cost_model_profiler(cost_model);
+    auto rst = profiler->profile(problem);
+    auto&& costs = rst.opr_record.at(y.node()->owner_opr()).costs;
+    float nchw = costs.at(OprFormatConfigID::NCHW),
+          nchw4 = costs.at(OprFormatConfigID::NCHW4),
+          nchw32 = costs.at(OprFormatConfigID::NCHW32);
+    ASSERT_GT(nchw, 0.f);
+    ASSERT_NEAR(nchw / 4, nchw4, nchw * 1e-4);
+    ASSERT_GT(nchw32, 1e6f);
+    auto&& var_costs = rst.var_record.at(x.node()).costs;
+    ASSERT_GT(var_costs.at({TensorFormats::NCHW, TensorFormats::NCHWc4}), 0.f);
+}
+
+TEST(TestProfiler, CachedInGlobalPersistentCache) {
+    REQUIRE_GPU(1);
+    auto cn = CompNode::load("gpu0");
+    cn.activate();
+    auto ctx = make_ctx();
+    using OprFormatConfigID = ProfilerBase::OprFormatConfigID;
+
+    class CountingCache final : public PersistentCache {
+        std::unique_ptr<PersistentCache> m_impl =
+                std::make_unique<InMemoryPersistentCache>();
+
+    public:
+        size_t nr_put = 0;
+        Maybe<Blob> get(const std::string& category, const Blob& key) override {
+            return m_impl->get(category, key);
+        }
+        void put(const std::string& category, const Blob& key, const Blob& value)
+                override {
+            ++nr_put;
+            m_impl->put(category, key, value);
+        }
+    };
+    auto cache = std::make_shared<CountingCache>();
+    auto orig_impl = PersistentCache::set_impl(cache);
+    ProfilerCache::inst().set_impl(nullptr);
+
+    HostTensorGenerator<> gen;
+    auto profile = [&]() {
+        auto graph = ComputingGraph::make();
+        graph->options().graph_opt_level = 0;
+        auto mkvar = [&](const char* name, const TensorShape& shp) {
+            return opr::Host2DeviceCopy::make(*graph, gen(shp, cn)).rename(name);
+        };
+        auto a = mkvar("a", {16, 32, 14, 14});
+        auto b = mkvar("b", {1, 32, 1, 1});
+        //! the two elemwise oprs have the same signature
+        auto c = opr::Elemwise::make({a, b}, {opr::Elemwise::Param::Mode::ADD});
+        auto d = opr::Elemwise::make({c, b}, {opr::Elemwise::Param::Mode::ADD});
+        SubGraphExtractor extractor(ctx->opr_list());
+        auto partitions = extractor.extract({d});
+        EXPECT_EQ(partitions.size(), 1u);
+        Problem problem(partitions.at(0), *ctx);
+        auto rst = ProfilerBase::make_cached_profiler()->profile(problem);
+        auto&& c_costs = rst.opr_record.at(c.node()->owner_opr()).costs;
+        auto&& d_costs = rst.opr_record.at(d.node()->owner_opr()).costs;
+        std::map<OprFormatConfigID, float> ret;
+        for (auto&& i : c_costs) {
+            ret[i.first] = i.second;
+        }
+        EXPECT_EQ(ret.size(), d_costs.size());
+        for (auto&& i : d_costs) {
+            EXPECT_EQ(ret.at(i.first), i.second);
+        }
+        return ret;
+    };
+    auto costs = profile();
+    size_t nr_put = cache->nr_put;
+    ASSERT_GT(nr_put, 0u);
+    //! profiling a similar graph again does not run any profiling
+    ASSERT_EQ(costs, profile());
+    ASSERT_EQ(nr_put, cache->nr_put);
+
+    PersistentCache::set_impl(orig_impl);
+}
 #endif
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
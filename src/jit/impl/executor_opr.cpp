@@ -234,7 +234,18 @@ void JITExecutor::update_args() {
         do_dimshuffle();
     }
 
-    if (m_compiler->property().contain_flag(CPFlag::NEED_INPUT_COLLAPSE)) {
+    if (m_compiler->property().contain_flag(CPFlag::NEED_INPUT_COLLAPSE) &&
+        has_reduce()) {
+        // the output is reduced from the broadcasted inputs, so the inputs are
+        // broadcasted rather than collapsed to keep the reduced axis
+        auto shape = broadcasted_input_shape();
+        for (size_t i = 0; i < m_args.inputs.size(); i++) {
+            if (!is_host_value_shape_input(i)) {
+                auto&& layout = m_args.inputs[i].layout;
+                layout = layout.broadcast(shape);
+            }
+        }
+    } else if (m_compiler->property().contain_flag(CPFlag::NEED_INPUT_COLLAPSE)) {
         // collective collapse datum layout, try to reduce the output ndim
         opr::Elemwise::TensorLayoutPtrArray inp_layouts;
         inp_layouts.reserve(m_args.inputs.size());
@@ -549,7 +560,8 @@ MGB_IMPL_OPR_GRAD(JITExecutor) {
         rewriter.auto_replace_outputs(opr);
     };
 
-    if (opr.compiler()->property().feature_bits & JITFeatureBits::REDUCE) {
+    if ((opr.compiler()->property().feature_bits & JITFeatureBits::REDUCE) ||
+        opr.has_reduce()) {
         // expand the gradient graph into the original graph to handle bcast
         // oprs
         using namespace std::placeholders;
@@ -19,6 +19,28 @@ using namespace mgb;
 using namespace gopt;
 using namespace jit;
 
+namespace {
+/*!
+ * \brief whether the reduce keeps ndim and reduces at most one axis, which is
+ *      required by the compilers supporting only OUTPUT_REDUCE
+ *
+ * The input layouts are not collapsed for such reduce, so the ndim is also
+ * limited.
+ */
+bool is_single_axis_reduce(OperatorNodeBase* opr) {
+    if (!cg::is_static_var_shape(opr->input(0)))
+        return false;
+    auto &&ishp = opr->input(0)->shape(), &&oshp = opr->output(0)->shape();
+    if (ishp.ndim != oshp.ndim || ishp.ndim > 4)
+        return false;
+    size_t nr_axis = 0;
+    for (size_t i = 0; i < ishp.ndim; ++i) {
+        nr_axis += ishp[i] != oshp[i];
+    }
+    return nr_axis <= 1;
+}
+}  // anonymous namespace
+
 //! default is null string
 std::string JITFusionPass::jit_backend_str = "";
 
@@ -47,6 +69,12 @@ class JITFusionPass::Impl final {
 
     size_t max_nr_input(CompNode cn);
 
+    //! features supported by the compiler on given comp node
+    JITFeatureBits compiler_feature_bits(CompNode cn) const;
+
+    //! whether the opr has a reduce that can only be the output of a subgraph
+    bool has_output_only_reduce(OperatorNodeBase* opr) const;
+
     //! check whether all oprs which depend on the var are in i_graph
     bool test_all_readers_in_the_graph(VarNode* var, InternalGraphGenerator* i_graph);
 
@@ -336,9 +364,11 @@ void JITFusionPass::Impl::process_opr(OperatorNodeBase* opr) {
              cond_cn = opr->output(0)->comp_node() == ig_gen->output()->comp_node(),
              cond_shp = check_shape(opr, ig_gen),
              cond_nr_inp = ig_gen->get_cnt_input_if_add(opr) <= max_nr_input,
+             cond_reduce = !has_output_only_reduce(opr),
              cond_mlir_specific = true;
 
-        if (cond_readers && cond_cn && cond_shp && cond_nr_inp && cond_mlir_specific) {
+        if (cond_readers && cond_cn && cond_shp && cond_nr_inp && cond_reduce &&
+            cond_mlir_specific) {
             ig_gen->add_opr(opr);
         } else {
             if (opr->same_type<opr::Dimshuffle>()) {
@@ -347,9 +377,9 @@ void JITFusionPass::Impl::process_opr(OperatorNodeBase* opr) {
             // create a new sub graph starting from this opr
             mgb_log_debug(
                     "JIT graph stopped at opr %s{%s}: cond: readers=%d cn=%d "
-                    "shp=%d nr_inp=%d",
+                    "shp=%d nr_inp=%d reduce=%d",
                     opr->cname(), opr->dyn_typeinfo()->name, cond_readers, cond_cn,
-                    cond_shp, cond_nr_inp);
+                    cond_shp, cond_nr_inp, cond_reduce);
             ig_gen = create_new_igraph_gen(opr);
         }
     }
@@ -382,6 +412,20 @@ size_t JITFusionPass::Impl::max_nr_input(CompNode cn) {
     return ret;
 }
 
+JITFeatureBits JITFusionPass::Impl::compiler_feature_bits(CompNode cn) const {
+    return Compiler::get(*m_opt_state.graph().comp_graph(), cn)
+            ->property()
+            .feature_bits;
+}
+
+bool JITFusionPass::Impl::has_output_only_reduce(OperatorNodeBase* opr) const {
+    if (compiler_feature_bits(opr->output(0)->comp_node()) & JITFeatureBits::REDUCE)
+        return false;
+    if (auto jit = gopt::try_cast_as_op<JITExecutor>(opr))
+        return jit->has_reduce();
+    return opr->same_type<opr::Reduce>();
+}
+
 bool JITFusionPass::Impl::can_be_fused(cg::OperatorNodeBase* opr) const {
     if (!Compiler::is_supported_device(opr->output(0)->comp_node().device_type())) {
         return false;
@@ -455,7 +499,13 @@ bool JITFusionPass::Impl::can_be_fused(cg::OperatorNodeBase* opr) const {
         // float reduce
         if ((m_feature_bits & JITFeatureBits::REDUCE) &&
             opr->same_type<opr::Reduce>()) {
-            return opr->output(0)->dtype().category() == DTypeCategory::FLOAT;
+            if (opr->output(0)->dtype().category() != DTypeCategory::FLOAT)
+                return false;
+            auto bits = compiler_feature_bits(opr->output(0)->comp_node());
+            if (bits & JITFeatureBits::REDUCE)
+                return true;
+            return (bits & JITFeatureBits::OUTPUT_REDUCE) &&
+                   is_single_axis_reduce(opr);
         }
 
         // dimshuffle
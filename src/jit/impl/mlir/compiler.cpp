@@ -10,6 +10,7 @@
 #include "megbrain/comp_node_env.h"
 #include "megbrain/jit/mlir/ir/dialect.h"
 #include "megbrain/jit/mlir/ir/passes.h"
+#include "megbrain/utils/persistent_cache.h"
 #include "megbrain/utils/timer.h"
 
 #include <mlir/Conversion/GPUCommon/GPUCommonPass.h>
@@ -26,6 +27,7 @@
 #include <mlir/Target/NVVMIR.h>
 #include <mlir/Transforms/Passes.h>
 
+#include <llvm/Config/llvm-config.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Linker/Linker.h>
 #include <llvm/Pass.h>
@@ -212,6 +214,33 @@ std::unique_ptr<Executable> MLIRCompiler::do_compile(
     mgb_assert(res.second, "failed to generate module");
 
     CompNode cn = args.owner->comp_node();
+#if MGB_CUDA
+    if (cn.device_type() == CompNode::DeviceType::CUDA) {
+        // the lowered kernel is cached by the module before lowering, so the
+        // lowering passes are not run again in another process
+        std::string source;
+        llvm::raw_string_ostream os{source};
+        res.second->print(os);
+        os.flush();
+        auto category = "jit:mlir" LLVM_VERSION_STRING ":" +
+                        PersistentCache::make_category_from_comp_node(cn);
+        auto&& cache = PersistentCache::inst();
+        PersistentCache::Blob key{source.data(), source.size()};
+        auto kernel_cache = cache.get(category, key);
+        if (kernel_cache.valid()) {
+            return std::make_unique<MLIRCUDAExecutable>(
+                    std::string{
+                            static_cast<const char*>(kernel_cache->ptr),
+                            kernel_cache->size},
+                    res.first.str());
+        }
+        run_lowering_pass(res.second, cn);
+        auto ret = std::make_unique<MLIRCUDAExecutable>(res.second, res.first.str());
+        auto&& kernel_data = ret->kernel_data();
+        cache.put(category, key, {kernel_data.data(), kernel_data.size()});
+        return ret;
+    }
+#endif
     run_lowering_pass(res.second, cn);
     switch (cn.device_type()) {
         case CompNode::DeviceType::CPU:
@@ -4,8 +4,11 @@
 #include "./executable_cpu.h"
 #include "./ir/types.h"
 
+#include "megbrain/comp_node_env.h"
 #include "megbrain/jit/mlir/ir/utils.h"
 
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/Support/Host.h>
 #include <mlir/ExecutionEngine/CRunnerUtils.h>
 #include <mlir/ExecutionEngine/OptUtils.h>
 
@@ -64,7 +67,15 @@ void* tensor2memref(const megdnn::TensorND& tensor) {
 MLIRCPUExecutable::MLIRCPUExecutable(
         mlir::OwningModuleRef& module, const std::string& kernel_name)
         : m_kernel_name{kernel_name} {
-    auto opt_pipeline = mlir::makeOptimizingTransformer(3, 3, 0);
+    //! the target machine of the host is needed by the loop vectorizer of llvm
+    //! to emit the SIMD instructions of the host
+    auto tm_builder = llvm::orc::JITTargetMachineBuilder::detectHost();
+    mgb_assert(tm_builder, "failed to detect the host target");
+    tm_builder->setCPU(llvm::sys::getHostCPUName().str());
+    auto tm = tm_builder->createTargetMachine();
+    mgb_assert(tm, "failed to create the host target machine");
+
+    auto opt_pipeline = mlir::makeOptimizingTransformer(3, 3, tm->get());
     std::vector<std::string> libs;
     auto&& engine = mlir::ExecutionEngine::create(
             *module, nullptr, opt_pipeline, llvm::None,
@@ -75,47 +86,68 @@ MLIRCPUExecutable::MLIRCPUExecutable(
 
 void MLIRCPUExecutable::execute(JITExecutor* fusion_opr) {
     auto&& args = fusion_opr->args();
-    std::vector<void*> args_array(args.inputs.size() + args.outputs.size());
-    std::vector<void*> args_array_pointer(args.inputs.size() + args.outputs.size());
-    size_t idx = 0;
-    for (size_t i = 0; i < args.inputs.size(); i++) {
-        args_array[idx] = tensor2memref(
-                {args.inputs[i].from->dev_tensor().raw_ptr(), args.inputs[i].layout});
-        args_array_pointer[idx] = &args_array[idx];
-        idx++;
+    std::vector<megdnn::TensorND> tensors;
+    tensors.reserve(args.inputs.size() + args.outputs.size());
+    for (auto&& i : args.inputs) {
+        tensors.emplace_back(i.from->dev_tensor().raw_ptr(), i.layout);
     }
-    int64_t nr_elements = 0;
-    for (size_t i = 0; i < args.outputs.size(); i++) {
+    size_t nr_elements = 0;
+    for (auto&& i : args.outputs) {
         if (nr_elements == 0) {
-            nr_elements = args.outputs[i].layout.total_nr_elems();
+            nr_elements = i.layout.total_nr_elems();
         } else {
             mgb_assert(
-                    static_cast<size_t>(nr_elements) ==
-                            args.outputs[i].layout.total_nr_elems(),
+                    nr_elements == i.layout.total_nr_elems(),
                     "The number of elements of outputs mismatch, expected: "
                     "%zu got: %zu(%s)",
-                    static_cast<size_t>(nr_elements),
-                    args.outputs[i].layout.total_nr_elems(),
-                    args.outputs[i].layout.to_string().c_str());
+                    nr_elements, i.layout.total_nr_elems(),
+                    i.layout.to_string().c_str());
         }
-        args_array[idx] = tensor2memref(
-                {args.outputs[i].from->dev_tensor().raw_ptr(), args.outputs[i].layout});
-        args_array_pointer[idx] = &args_array[idx];
-        idx++;
+        tensors.emplace_back(i.from->dev_tensor().raw_ptr(), i.layout);
     }
 
-    args_array_pointer.push_back(&nr_elements);
-    std::string adapter_name = std::string("_mlir_ciface_") + m_kernel_name;
-    auto err = m_engine->invoke(
-            adapter_name, llvm::MutableArrayRef<void*>(args_array_pointer));
-    if (err) {
-        mgb_throw(
-                InternalError, "failed to run MLIR kernel %s\n", m_kernel_name.c_str());
+    //! the kernel computes the rows in [begin, end) of the outermost dim of the
+    //! outputs, and the rows are split evenly across the threads
+    size_t nr_rows = args.outputs[0].layout[0];
+    if (!nr_rows) {
+        return;
     }
-
-    for (size_t i = 0; i < args_array.size(); i++) {
-        free(args_array[i]);
+    auto&& env = CompNodeEnv::from_comp_node(fusion_opr->comp_node()).cpu_env();
+    size_t nr_threads = env.thread_pool() ? env.thread_pool()->nr_threads() : 1;
+    //! the dimshuffled inputs are not read by the rows of the outputs
+    if (fusion_opr->has_dimshuffle()) {
+        nr_threads = 1;
     }
+    nr_threads = std::min(nr_threads, nr_rows);
+    size_t rows_per_task = (nr_rows + nr_threads - 1) / nr_threads;
+    size_t nr_tasks = (nr_rows + rows_per_task - 1) / rows_per_task;
+
+    auto kern = [this, tensors, nr_rows, rows_per_task](size_t index, size_t) {
+        int64_t begin = index * rows_per_task,
+                end = std::min((index + 1) * rows_per_task, nr_rows);
+        std::vector<void*> args_array(tensors.size());
+        std::vector<void*> args_array_pointer(tensors.size());
+        for (size_t i = 0; i < tensors.size(); i++) {
+            args_array[i] = tensor2memref(tensors[i]);
+            args_array_pointer[i] = &args_array[i];
+        }
+        args_array_pointer.push_back(&begin);
+        args_array_pointer.push_back(&end);
+
+        std::string adapter_name = std::string("_mlir_ciface_") + m_kernel_name;
+        auto err = m_engine->invoke(
+                adapter_name, llvm::MutableArrayRef<void*>(args_array_pointer));
+        if (err) {
+            mgb_throw(
+                    InternalError, "failed to run MLIR kernel %s\n",
+                    m_kernel_name.c_str());
+        }
+
+        for (size_t i = 0; i < args_array.size(); i++) {
+            free(args_array[i]);
+        }
+    };
+    env.dispatch(kern, nr_tasks);
 }
 
 MLIRCPUExecutable::~MLIRCPUExecutable() {}
@@ -132,6 +132,11 @@ MLIRCUDAExecutable::MLIRCUDAExecutable(
     m_kernel_data = binary_attr.getValue().str();
 }
 
+MLIRCUDAExecutable::MLIRCUDAExecutable(
+        std::string kernel_data, const std::string& kernel_name)
+        : m_kernel_name{kernel_name + "_kernel"},
+          m_kernel_data{std::move(kernel_data)} {}
+
 void MLIRCUDAExecutable::execute(JITExecutor* fusion_opr) {
     FuncCache* func;
     auto cn = fusion_opr->comp_node();
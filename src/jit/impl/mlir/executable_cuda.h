@@ -19,6 +19,10 @@ namespace jit {
 class MLIRCUDAExecutable final : public Executable {
 public:
     MLIRCUDAExecutable(mlir::OwningModuleRef& module, const std::string& kernel_name);
+
+    //! create from the kernel data of a lowered module, e.g. from the cache
+    MLIRCUDAExecutable(std::string kernel_data, const std::string& kernel_name);
+
     ~MLIRCUDAExecutable();
 
     /*!
@@ -29,6 +33,9 @@ public:
 
     const static std::string sm_blob_annotation;
 
+    //! the compiled kernel (in ptx) to be loaded by cuModuleLoadData
+    const std::string& kernel_data() const { return m_kernel_data; }
+
 private:
     //! cache for a func on a specific device
     struct FuncCache {
@@ -23,6 +23,53 @@ namespace {
 using LoopIterationFn = function_ref<Value(
         OpBuilder& rewriter, ValueRange memRefOperands, ValueRange loopIvs)>;
 
+using LoopBodyFn = function_ref<void(OpBuilder&, Location, ValueRange)>;
+
+/*!
+ * \brief build the loop nest over the shape of \p type
+ *
+ * The last two arguments of the function are the range of the outermost dim
+ * of the outputs to be computed, so that the kernel can be split across the
+ * threads of the comp node. The outermost loop over a memref whose rows match
+ * the rows of the outputs is bounded by the range, and other memrefs, which
+ * are only read by broadcasting, are computed in full.
+ */
+void build_loop_nest(
+        OpBuilder& builder, Location loc, Operation* op, MemRefType type,
+        LoopBodyFn body) {
+    llvm::SmallVector<int64_t, 4> lower_bounds(type.getRank(), 0);
+    llvm::SmallVector<int64_t, 4> steps(type.getRank(), 1);
+    auto func = op->getParentOfType<FuncOp>();
+    unsigned nr_args = func.getNumArguments();
+    auto out_type = func.getArgument(nr_args - 3).getType().cast<MemRefType>();
+    if (type.getRank() == 0 || type.getRank() != out_type.getRank() ||
+        type.getDimSize(0) != out_type.getDimSize(0)) {
+        buildAffineLoopNest(builder, loc, lower_bounds, type.getShape(), steps, body);
+        return;
+    }
+
+    auto map = builder.getSymbolIdentityMap();
+    auto outer = builder.create<AffineForOp>(
+            loc, ValueRange{func.getArgument(nr_args - 2)}, map,
+            ValueRange{func.getArgument(nr_args - 1)}, map);
+    OpBuilder::InsertionGuard guard(builder);
+    builder.setInsertionPointToStart(outer.getBody());
+    Value outer_iv = outer.getInductionVar();
+    auto inner_body = [&](OpBuilder& nested_builder, Location loc, ValueRange ivs) {
+        llvm::SmallVector<Value, 4> all_ivs{outer_iv};
+        all_ivs.append(ivs.begin(), ivs.end());
+        body(nested_builder, loc, all_ivs);
+    };
+    if (type.getRank() == 1) {
+        inner_body(builder, loc, llvm::None);
+        return;
+    }
+    buildAffineLoopNest(
+            builder, loc, llvm::makeArrayRef(lower_bounds).drop_front(),
+            type.getShape().drop_front(), llvm::makeArrayRef(steps).drop_front(),
+            inner_body);
+}
+
 void lower_op_to_loops(
         Operation* op, ValueRange operands, PatternRewriter& rewriter,
         LoopIterationFn process_iteration) {
@@ -31,10 +78,8 @@ void lower_op_to_loops(
 
     auto alloc = jit::insert_alloc_and_dealloc(memref_type, loc, rewriter);
 
-    llvm::SmallVector<int64_t, 4> lower_bounds(memref_type.getRank(), 0);
-    llvm::SmallVector<int64_t, 4> steps(memref_type.getRank(), 1);
-    buildAffineLoopNest(
-            rewriter, loc, lower_bounds, memref_type.getShape(), steps,
+    build_loop_nest(
+            rewriter, loc, op, memref_type,
             [&](OpBuilder& nested_builder, Location loc, ValueRange ivs) {
                 Value value_to_store = process_iteration(nested_builder, operands, ivs);
                 nested_builder.create<AffineStoreOp>(loc, value_to_store, alloc, ivs);
@@ -138,10 +183,8 @@ struct AssignOpLowering : public ConversionPattern {
         auto memref_type = operands[0].getType().cast<MemRefType>();
         dialect::AssignOpAdaptor assign_adaptor(operands);
 
-        llvm::SmallVector<int64_t, 4> lower_bounds(memref_type.getRank(), 0);
-        llvm::SmallVector<int64_t, 4> steps(memref_type.getRank(), 1);
-        buildAffineLoopNest(
-                rewriter, loc, lower_bounds, memref_type.getShape(), steps,
+        build_loop_nest(
+                rewriter, loc, op, memref_type,
                 [&](OpBuilder& nested_builder, Location loc, ValueRange ivs) {
                     auto loaded_lhs = nested_builder.create<AffineLoadOp>(
                             loc, assign_adaptor.lhs(), ivs);
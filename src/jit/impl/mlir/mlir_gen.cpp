@@ -66,9 +66,9 @@ private:
         for (auto&& arg : args.outputs) {
             func_args.push_back(get_type(arg.from->layout()));
         }
-        //! nr_elements
+        //! nr_elements on CUDA, or the begin of the outermost dim on CPU
         func_args.push_back(m_builder.getIndexType());
-        //! nr_threads
+        //! nr_threads on CUDA, or the end of the outermost dim on CPU
         func_args.push_back(m_builder.getIndexType());
 
         auto func_type = m_builder.getFunctionType(func_args, llvm::None);
@@ -80,6 +80,14 @@ void gen_input_code(
         const JITExecutor::Args& args, const PlaceholderArray& placeholders) {
     std::string decl_exps_str, assign_exps_str, decl_fastdiv_offset_str;
     for (size_t i = 0; i < args.inputs.size(); i++) {
+        ASTPtr offset_var = ASTPtr::make<VariableAST>("offset_" + std::to_string(i));
+        ASTPtr offset_decl = ASTPtr::make<DeclIntAST>(offset_var);
+        decl_fastdiv_offset_str += offset_decl->code_gen();
+        if (placeholders[args.inputs[i].idx]->is_host_value_shape_input()) {
+            // target shape of reduce, whose value is not accessed in the kernel
+            continue;
+        }
+
         ASTPtr elem_var = ASTPtr::make<VariableAST>("x" + std::to_string(i));
         ASTPtr elem_val = gen_data_ast(i, args.inputs[i]);
         ASTPtr elem_decl =
@@ -88,10 +96,6 @@ void gen_input_code(
         var2ast[placeholders[args.inputs[i].idx]->output(0)] = elem_var;
         decl_exps_str += elem_decl->code_gen();
         assign_exps_str += elem_assign->code_gen();
-
-        ASTPtr offset_var = ASTPtr::make<VariableAST>("offset_" + std::to_string(i));
-        ASTPtr offset_decl = ASTPtr::make<DeclIntAST>(offset_var);
-        decl_fastdiv_offset_str += offset_decl->code_gen();
     }
     str_util::append_replace_map(
             replace_map, {{"{{DECL_fastdiv_offset}}", decl_fastdiv_offset_str},
@@ -112,6 +116,40 @@ ASTPtr gen_opr_ast(cg::OperatorNodeBase* opr, const VarNode2AST& var2ast) {
 
     return opr2AST(opr, cur_inputs, CompNode::DeviceType::CUDA).at(0);
 }
+
+//! code snippets to reduce the values of the input expression
+struct ReduceCode {
+    //! initial value of the accumulator
+    const char* init;
+    //! combine two partial results a and b
+    const char* combine;
+    //! the value to be accumulated from input expression val
+    const char* map;
+    //! the output value from the accumulator acc
+    const char* out;
+};
+
+ReduceCode get_reduce_code(opr::Reduce::Mode mode) {
+    using Mode = opr::Reduce::Mode;
+    switch (mode) {
+        case Mode::SUM:
+            return {"0.f", "a + b", "val", "acc"};
+        case Mode::SUM_SQR:
+            return {"0.f", "a + b", "val * val", "acc"};
+        case Mode::PRODUCT:
+            return {"1.f", "a * b", "val", "acc"};
+        case Mode::MIN:
+            return {"__int_as_float(0x7f800000)", "fminf(a, b)", "val", "acc"};
+        case Mode::MAX:
+            return {"-__int_as_float(0x7f800000)", "fmaxf(a, b)", "val", "acc"};
+        case Mode::MEAN:
+            return {"0.f", "a + b", "val", "acc / reduce_len"};
+        default:
+            mgb_throw(
+                    GraphError, "unsupported reduce mode %d in JIT fusion",
+                    static_cast<int>(mode));
+    }
+}
 }  // anonymous namespace
 
 std::pair<std::string, std::string> mgb::jit::codegen_cuda(
@@ -155,16 +193,83 @@ static __forceinline__ __device__ T jit_log_sum_exp(T x, T y) {
 
 )";
 
+    auto reduce = internal_graph.output()->owner_opr()->try_cast_final<opr::Reduce>();
+    if (reduce) {
+        cuda_kernel += R"(
+static __forceinline__ __device__ float jit_reduce_op(float a, float b) {
+    return {{REDUCE_COMBINE}};
+}
+
+//! reduce in a block whose size is a multiple of warp size; the result is
+//! valid in the first thread
+static __device__ float jit_block_reduce(float acc, float* warp_acc) {
+    unsigned int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+#pragma unroll
+    for (int offset = 16; offset; offset >>= 1) {
+        acc = jit_reduce_op(acc, __shfl_down_sync(0xffffffffu, acc, offset));
+    }
+    if (!lane) {
+        warp_acc[warp] = acc;
+    }
+    __syncthreads();
+    if (!warp) {
+        acc = lane < (blockDim.x >> 5) ? warp_acc[lane] : {{REDUCE_INIT}};
+#pragma unroll
+        for (int offset = 16; offset; offset >>= 1) {
+            acc = jit_reduce_op(acc, __shfl_down_sync(0xffffffffu, acc, offset));
+        }
+    }
+    __syncthreads();
+    return acc;
+}
+
+)";
+    }
+
+    //! for reduce, num_elements is the number of outputs, each of which is
+    //! reduced from reduce_len inputs at the distance of reduce_stride
     cuda_kernel += copy_param_to_dev ? R"(
-extern "C" __global__ void {{KERNEL_NAME}} (Data* data_ptr, size_t num_elements, PEVisitors* visitors_ptr) {
+extern "C" __global__ void {{KERNEL_NAME}} (Data* data_ptr, size_t num_elements, PEVisitors* visitors_ptr,
+ unsigned int reduce_len, unsigned int reduce_stride) {
     Data data = *data_ptr;
     PEVisitors visitors = *visitors_ptr;
 )"
                                      : R"(
 extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
- PEVisitors visitors) { )";
+ PEVisitors visitors, unsigned int reduce_len, unsigned int reduce_stride) { )";
+
+    if (reduce) {
+        cuda_kernel += R"(
+    __shared__ float warp_acc[32];
+    unsigned int global_idx;
+    unsigned int tmp_idx;
+
+    {{DECL_EXPRS}}
+    {{INTERNAL_DECL_EXPRS}}
+    {{DECL_fastdiv_offset}}
 
-    cuda_kernel += R"(
+    for (unsigned int out_idx = blockIdx.x; out_idx < num_elements;
+         out_idx += gridDim.x) {
+        unsigned int base = out_idx / reduce_stride * reduce_len * reduce_stride +
+                            out_idx % reduce_stride;
+        float acc = {{REDUCE_INIT}};
+        for (unsigned int i = threadIdx.x; i < reduce_len; i += blockDim.x) {
+            global_idx = base + i * reduce_stride;
+            {{fastdiv_offset}}
+            {{ASSIGN_EXPRS}}
+            {{INTERNAL_ASSIGN_EXPRS}}
+            float val = {{EXP}};
+            acc = jit_reduce_op(acc, {{REDUCE_MAP}});
+        }
+        acc = jit_block_reduce(acc, warp_acc);
+        if (!threadIdx.x) {
+            data.output[out_idx] = {{REDUCE_OUT}};
+        }
+    }
+}
+)";
+    } else {
+        cuda_kernel += R"(
     unsigned int global_idx = blockIdx.x * blockDim.x + threadIdx.x;
     unsigned int delta = blockDim.x * gridDim.x;
     unsigned int tmp_idx;
@@ -197,6 +302,7 @@ extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
     }
 }
 )";
+    }
 
     VarNode2AST var2ast;
     str_util::StrReplaceMap source_replace_map;
@@ -204,7 +310,8 @@ extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
     // add inputs to the replace map
     gen_input_code(source_replace_map, var2ast, args, internal_graph.placeholders());
 
-    // add other oprs
+    // add other oprs; the reduce is handled by the kernel template
+    VarNode* expr_var = reduce ? reduce->input(0) : internal_graph.output();
     std::string internal_decl_exps_str, internal_assign_exps_str;
     size_t cur_opr_cnt = 0;
     cg::DepOprIter{[&](cg::OperatorNodeBase* opr) {
@@ -220,7 +327,16 @@ extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
         var2ast[opr->output(0)] = elem_var;
         internal_decl_exps_str += elem_decl->code_gen();
         internal_assign_exps_str += elem_assign->code_gen();
-    }}.add(internal_graph.output());
+    }}.add(expr_var);
+
+    if (reduce) {
+        auto code = get_reduce_code(reduce->param().mode);
+        str_util::append_replace_map(
+                source_replace_map, {{"{{REDUCE_INIT}}", code.init},
+                                     {"{{REDUCE_COMBINE}}", code.combine},
+                                     {"{{REDUCE_MAP}}", code.map},
+                                     {"{{REDUCE_OUT}}", code.out}});
+    }
 
     str_util::append_replace_map(
             source_replace_map,
@@ -229,7 +345,7 @@ extern "C" __global__ void {{KERNEL_NAME}} (Data data, size_t num_elements,
              {"{{fastdiv_offset}}", gen_fastdiv_offset(args.inputs.size())},
              {"{{INTERNAL_DECL_EXPRS}}", internal_decl_exps_str},
              {"{{INTERNAL_ASSIGN_EXPRS}}", internal_assign_exps_str},
-             {"{{EXP}}", var2ast.at(internal_graph.output())->code_gen()},
+             {"{{EXP}}", var2ast.at(expr_var)->code_gen()},
              {"{{OUTPUT_DTYPE}}", dtype_to_cstr(args.outputs[0].layout.dtype)}});
 
     str_util::replace_all_pairs_inplace(cuda_kernel, source_replace_map);
@@ -116,8 +116,11 @@ void setup_and_launch(const JITExecutor* fusion_opr, CUfunction func, int block_
     pvisitors.reserve(nr_inps);
 
     for (size_t i = 0; i < args.inputs.size(); i++) {
-        datum[i] = reinterpret_cast<CUdeviceptr>(
-                args.inputs[i].from->dev_tensor().raw_ptr());
+        // the value of target shape of reduce is not used by the kernel
+        if (args.inputs[i].layout.dtype.valid()) {
+            datum[i] = reinterpret_cast<CUdeviceptr>(
+                    args.inputs[i].from->dev_tensor().raw_ptr());
+        }
         host_init_pvisitor<out_dim>(pvisitors[i], args.inputs[i].layout);
     }
     datum[nr_inps] = reinterpret_cast<CUdeviceptr>(
@@ -129,8 +132,38 @@ void setup_and_launch(const JITExecutor* fusion_opr, CUfunction func, int block_
             "performance");
     int num_block = (num_elements - 1) / (block_size * 3) + 1;
 
-    void* exec_args[3];
+    uint32_t reduce_len = 1, reduce_stride = 1;
+    if (fusion_opr->has_reduce()) {
+        // the inputs are broadcasted to the shape before reduce, and the
+        // reduced axis is found by comparing it with the output shape
+        auto ishp = fusion_opr->broadcasted_input_shape();
+        auto&& oshp = args.outputs[0].layout;
+        mgb_assert(ishp.ndim == oshp.ndim);
+        for (size_t i = 0; i < ishp.ndim; ++i) {
+            if (ishp[i] != oshp[i]) {
+                mgb_assert(
+                        reduce_len == 1 && oshp[i] == 1,
+                        "JIT reduce on more than one axis: %s -> %s",
+                        ishp.to_string().c_str(), oshp.to_string().c_str());
+                reduce_len = ishp[i];
+                reduce_stride = 1;
+            } else {
+                reduce_stride *= ishp[i];
+            }
+        }
+        if (reduce_len == 1) {
+            reduce_stride = 1;
+        }
+        // one block for each output, whose size must be a multiple of warp size
+        block_size = std::min<int>(
+                block_size, std::max<int>(32, (reduce_len + 31) / 32 * 32));
+        num_block = std::min<size_t>(num_elements, 65535);
+    }
+
+    void* exec_args[5];
     exec_args[1] = &num_elements;
+    exec_args[3] = &reduce_len;
+    exec_args[4] = &reduce_stride;
 
     void* datum_dev = nullptr;
     void* p_visitors_dev = nullptr;
@@ -183,8 +216,12 @@ void CudaExecutable::execute(JITExecutor* fusion_opr) {
     {
         MGB_LOCK_GUARD(func->mtx);
         if (func->ptx.empty()) {
+            // ptx from a different nvrtc version should not be reused
+            int nvrtc_major, nvrtc_minor;
+            MGB_NVRTC_CHECK(nvrtcVersion(&nvrtc_major, &nvrtc_minor));
             func->compile(
-                    "jit:nvrtc:" + PersistentCache::make_category_from_comp_node(cn),
+                    ssprintf("jit:nvrtc%d.%d:", nvrtc_major, nvrtc_minor) +
+                            PersistentCache::make_category_from_comp_node(cn),
                     prop.major, prop.minor, this);
         }
     }
@@ -84,7 +84,8 @@ public:
     Property property() const override {
         using F = Property::Flag;
         return Property{
-                F::NEED_INPUT_COLLAPSE | F::BIND_NDIM, JITFeatureBits::NONE, 64};
+                F::NEED_INPUT_COLLAPSE | F::BIND_NDIM, JITFeatureBits::OUTPUT_REDUCE,
+                64};
     }
 
     size_t get_nr_workspace_outputs(JITExecutor* opr) const override;
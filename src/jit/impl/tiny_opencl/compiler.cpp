@@ -9,6 +9,7 @@
 #include "megbrain/common.h"
 #include "megbrain/comp_node_env.h"
 #include "megbrain/rdnn/management.h"
+#include "megbrain/utils/persistent_cache.h"
 #include "megbrain/utils/timer.h"
 
 using namespace mgb;
@@ -46,10 +47,102 @@ void OpenCLTinyCompiler::init_workspace_size_infer(JITExecutor* opr) {
 
 /* =================== OpenCLExecutable ==================== */
 
+namespace {
+//! candidates of the launch config to be tuned on the device
+constexpr uint32_t TUNE_BLOCK_W[] = {1, 2, 4};
+constexpr uint32_t TUNE_DIMX[] = {32, 64, 96, 128, 256};
+constexpr uint32_t TUNE_DIMY[] = {1, 2, 4};
+constexpr int TUNE_NR_RUNS = 3;
+
+std::string get_device_info(cl_device_id device, cl_device_info param) {
+    size_t size = 0;
+    mgb_assert(clGetDeviceInfo(device, param, 0, nullptr, &size) == CL_SUCCESS);
+    std::string ret(size, '\0');
+    mgb_assert(clGetDeviceInfo(device, param, size, &ret[0], nullptr) == CL_SUCCESS);
+    //! strip the trailing null character
+    return ret.c_str();
+}
+}  // anonymous namespace
+
 OpenCLExecutable::OpenCLExecutable(std::string source, std::string name, bool is_debug)
         : m_source{std::move(source)}, m_name{std::move(name)}, m_is_debug{is_debug} {}
 
 void OpenCLExecutable::execute(JITExecutor* fusion_opr) {
+    MGB_LOCK_GUARD(m_mtx);
+    if (!m_config.valid()) {
+        m_config = get_launch_config(fusion_opr);
+    }
+    run(fusion_opr, m_config.val());
+}
+
+OpenCLExecutable::LaunchConfig OpenCLExecutable::get_launch_config(
+        JITExecutor* fusion_opr) {
+    auto&& cn = fusion_opr->comp_node();
+    auto& env = CompNodeEnv::from_comp_node(cn).opencl_env();
+    auto mgr = env.opencl_mgr;
+    auto& args = fusion_opr->args();
+    auto prop = megcore::opencl::OpenCLPropCache::instance().get(mgr->device());
+
+    //! the default config
+    LaunchConfig config{1, prop->is_mali() ? 96u : 64u, 1};
+    if (dtype::Float16() == args.inputs[0].layout.dtype) {
+        config.dimx *= 2;
+    }
+
+    //! the kernel can not be rerun for tuning if the output is forwarded from
+    //! an input
+    auto out_ptr = args.outputs[0].from->dev_tensor().raw_ptr();
+    for (auto&& i : args.inputs) {
+        if (i.from->dev_tensor().raw_ptr() == out_ptr) {
+            return config;
+        }
+    }
+
+    auto category = ssprintf(
+            "jit:opencl:dev=%s;drv=%s",
+            get_device_info(mgr->device(), CL_DEVICE_NAME).c_str(),
+            get_device_info(mgr->device(), CL_DRIVER_VERSION).c_str());
+    auto key = m_name + args.outputs[0].layout.to_string();
+    PersistentCache::Blob key_blob{key.data(), key.size()};
+    auto cached = PersistentCache::inst().get(category, key_blob);
+    if (cached.valid() && cached->size == sizeof(LaunchConfig)) {
+        memcpy(&config, cached->ptr, sizeof(LaunchConfig));
+        return config;
+    }
+
+    auto profile = [&](const LaunchConfig& cur) {
+        //! warm up
+        run(fusion_opr, cur);
+        cn.sync();
+        RealTimer timer;
+        for (int i = 0; i < TUNE_NR_RUNS; ++i) {
+            run(fusion_opr, cur);
+        }
+        cn.sync();
+        return timer.get_msecs();
+    };
+    double best_time = profile(config);
+    for (auto block_w : TUNE_BLOCK_W) {
+        for (auto dimx : TUNE_DIMX) {
+            for (auto dimy : TUNE_DIMY) {
+                LaunchConfig cur{block_w, dimx, dimy};
+                auto time = profile(cur);
+                if (time < best_time) {
+                    best_time = time;
+                    config = cur;
+                }
+            }
+        }
+    }
+    mgb_log_debug(
+            "OpenCL jit kernel %s tuned: block_w: %u, lws: (%u %u), time: %.3fms",
+            m_name.c_str(), config.block_w, config.dimx, config.dimy,
+            best_time / TUNE_NR_RUNS);
+    PersistentCache::inst().put(category, key_blob, {&config, sizeof(LaunchConfig)});
+    return config;
+}
+
+void OpenCLExecutable::run(JITExecutor* fusion_opr, const LaunchConfig& config) {
     auto&& cn = fusion_opr->comp_node();
     auto& env = CompNodeEnv::from_comp_node(cn).opencl_env();
     auto handle = mgb::opr::intl::get_megdnn_handle(cn);
@@ -60,8 +153,6 @@ void OpenCLExecutable::execute(JITExecutor* fusion_opr) {
     auto& args = fusion_opr->args();
 
     auto prop = megcore::opencl::OpenCLPropCache::instance().get(mgr->device());
-    bool is_adreno = prop->is_adreno();
-    bool is_mali = prop->is_mali();
     auto max_work_group = static_cast<uint32_t>(prop->max_work_group_size());
     mgb_assert(
             prop->is_support_image(),
@@ -133,37 +224,15 @@ void OpenCLExecutable::execute(JITExecutor* fusion_opr) {
     kernel.add_tensor_image_args(
             {{args.outputs[0].from->dev_tensor().raw_ptr(), args.outputs[0].layout}});
 
-    uint32_t block_w = 1, block_h = 1, dimx = 1, dimy = 1;
-    auto config_super_parameter = [&] {
-        if (is_adreno) {
-            block_w = 1;
-            dimx = 64;
-            dimy = 1;
-        } else if (is_mali) {
-            block_w = 1;
-            dimx = 96;
-            dimy = 1;
-        } else {
-            //! unknown gpu case
-            block_w = 1;
-            dimx = 64;
-            dimy = 1;
-        }
-        //! float16 case
-        if (dtype::Float16() == args.inputs[0].layout.dtype) {
-            dimx *= 2;
-        }
-
-        //! scaling dimx less than gws0, dimy less than gws1
-        dimx = std::min(dimx, static_cast<uint32_t>((WGSX + block_w - 1) / block_w));
-        dimy = std::min(dimy, static_cast<uint32_t>((WGSY + block_h - 1) / block_h));
-
-        //! scaling dimx * dimy less than device max_work_group
-        dimx = std::min(
-                dimx, std::max(static_cast<uint32_t>(1), max_work_group / dimy));
-    };
+    uint32_t block_w = config.block_w, block_h = 1, dimx = config.dimx,
+             dimy = config.dimy;
+    //! scaling dimx less than gws0, dimy less than gws1
+    dimx = std::min(dimx, static_cast<uint32_t>((WGSX + block_w - 1) / block_w));
+    dimy = std::min(dimy, static_cast<uint32_t>((WGSY + block_h - 1) / block_h));
 
-    config_super_parameter();
+    //! scaling dimx * dimy less than device max_work_group
+    dimy = std::min(dimy, max_work_group);
+    dimx = std::min(dimx, std::max(static_cast<uint32_t>(1), max_work_group / dimy));
 
     //! set other args and config lws and gws
     int wc_size = WGSX;
@@ -5,6 +5,8 @@
 
 #include "megbrain/jit/compiler.h"
 
+#include <mutex>
+
 namespace mgb {
 namespace jit {
 
@@ -23,9 +25,21 @@ public:
     void execute(JITExecutor* fusion_opr) override final;
 
 private:
+    //! launch config of the kernel, which is tuned for the device and shape
+    struct LaunchConfig {
+        uint32_t block_w, dimx, dimy;
+    };
+
+    //! load the tuned config from PersistentCache, or tune it on the device
+    LaunchConfig get_launch_config(JITExecutor* fusion_opr);
+
+    void run(JITExecutor* fusion_opr, const LaunchConfig& config);
+
     const std::string m_source;
     const std::string m_name;
     bool m_is_debug;
+    std::mutex m_mtx;
+    Maybe<LaunchConfig> m_config;
 };
 
 /*!
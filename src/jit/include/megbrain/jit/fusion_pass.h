@@ -14,7 +14,11 @@ enum class JITFeatureBits : uint32_t {
     REDUCE = 1,
     //! whether to fuse dimshuffle oprs
     //! DIMSHUFFLE and REDUCE can not coexsit
-    DIMSHUFFLE = 2
+    DIMSHUFFLE = 2,
+    //! whether to fuse a reduce on a single axis as the output opr of the
+    //! fused subgraph; it is a subset of REDUCE and only used as a feature
+    //! of the compilers
+    OUTPUT_REDUCE = 4
 };
 
 MGB_DEF_ENUM_CLASS_BIT_OPR(JITFeatureBits);
@@ -317,6 +317,13 @@ TEST(TestJITMlirCodeGen, Basic) {
     run_mlir_different_shape(cn);
 }
 
+TEST(TestJITMlirCodeGen, BasicMultithread) {
+    auto cn = CompNode::load("multithread4:0");
+    run_mlir(cn);
+    run_mlir_broadcast(cn);
+    run_mlir_different_shape(cn);
+}
+
 TEST(TestJITMlirCodeGen, BasicGPU) {
     REQUIRE_GPU(1);
     auto cn = CompNode::load("gpu0");
@@ -1213,6 +1213,25 @@ TEST(TestJITNvrtcFusion, SourceCache) {
     }
 }
 
+TEST(TestJITNvrtcFusion, Reduce) {
+    REQUIRE_GPU(1);
+    set_backend(Backend::NVRTC);
+
+    using Mode = opr::Reduce::Mode;
+    for (auto mode : {Mode::SUM, Mode::SUM_SQR, Mode::MIN, Mode::MAX, Mode::MEAN}) {
+        for (int axis : {0, 1, 2}) {
+            FusionChecker checker{
+                    2,
+                    [mode, axis](const SymbolVarArray& inp) -> SymbolVar {
+                        return opr::Reduce::make(
+                                opr::tanh(inp[0]) * inp[1] + 1.f, {mode, axis});
+                    },
+                    CompNode::load("gpu0")};
+            checker.disable_inp_grad().run({TensorShape{3, 70, 5}, {3, 1, 5}});
+        }
+    }
+}
+
 TEST(TestJITNvrtc, DimshuffleFusion) {
     REQUIRE_GPU(1);
     set_backend(Backend::NVRTC);
@@ -1675,6 +1694,41 @@ TEST(TestJITExecutor, TestJITMlirFusionGpu) {
     run_mlir(CompNode::load("gpu0"));
 }
 
+TEST(TestJITExecutor, TestJITMlirKernelCacheGpu) {
+    REQUIRE_GPU(1);
+    set_backend(Backend::MLIR);
+
+    size_t nr_get = 0;
+    bool hit = false;
+    auto on_cache_get = [&](const std::string& category, const void*, size_t,
+                            const void* val, size_t) {
+        if (category.find("jit:mlir") == 0) {
+            ++nr_get;
+            hit = val != nullptr;
+        }
+    };
+    PersistentCacheHook cache_hook{on_cache_get};
+
+    auto cn = CompNode::load("gpu0");
+    HostTensorGenerator<> gen;
+    auto host_x = gen({23, 42}, cn);
+    auto make_dst = [&](ComputingGraph& graph) {
+        auto x = opr::Host2DeviceCopy::make(graph, host_x);
+        return x * 2.f + opr::exp(x);
+    };
+    //! the compilers are owned by the graphs, so the kernel of the second
+    //! graph can only come from the persistent cache
+    for (size_t i = 0; i < 2; ++i) {
+        HostTensorND host_y1, host_y2;
+        auto funcs = make_func_pair(host_y1, host_y2, make_dst, 2);
+        funcs.first->execute();
+        funcs.second->execute();
+        MGB_ASSERT_TENSOR_EQ(host_y1, host_y2);
+        ASSERT_EQ(i + 1, nr_get);
+    }
+    ASSERT_TRUE(hit);
+}
+
 #endif  // MGB_JIT_MLIR
 
 #endif  // MGB_JIT
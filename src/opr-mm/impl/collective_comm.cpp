@@ -233,12 +233,58 @@ class CollectiveComm::ModeTrait::AllReduceBase : public ReducedBasedTrait,
         auto ivar = opr->input(0), ovar = opr->output(0);
         auto &&iv = ivar->dev_tensor(), &&ov = ovar->dev_tensor();
         mgb_assert(ivar->comp_node().mem_node() == ovar->comp_node().mem_node());
+        auto&& hierarchy = opr->m_megray_hierarchy;
+        if (hierarchy && iv.shape().total_nr_elems() % hierarchy->local_size == 0) {
+            exec_hierarchical(opr, *hierarchy, iv, ov);
+            return;
+        }
         auto status = opr->m_megray_comm->all_reduce(
                 (void*)iv.raw_ptr(), (void*)ov.raw_ptr(), iv.shape().total_nr_elems(),
                 get_megray_dtype(iv.dtype()), op(), opr->megray_ctx());
         mgb_assert(status == MegRay::MEGRAY_OK, "MegRay all_reduce failed");
     }
 
+    //! the shard of each local rank is reduced in place in the output, which is
+    //! the in-place form of reduce_scatter and all_gather of NCCL
+    void exec_hierarchical(
+            CollectiveComm* opr, const MegRayHierarchy& hierarchy,
+            const DeviceTensorND& iv, const DeviceTensorND& ov) {
+        size_t shard_len = iv.shape().total_nr_elems() / hierarchy.local_size;
+        auto dtype = iv.dtype();
+        auto shard = (void*)(ov.raw_ptr() +
+                             dtype.size(shard_len * hierarchy.local_rank));
+        auto ctx = opr->megray_ctx();
+        auto status = hierarchy.local->reduce_scatter(
+                (void*)iv.raw_ptr(), shard, shard_len, get_megray_dtype(dtype), op(),
+                ctx);
+        mgb_assert(status == MegRay::MEGRAY_OK, "MegRay reduce_scatter failed");
+#if !MEGDNN_DISABLE_FLOAT16
+        if (hierarchy.compress_fp16 && dtype == dtype::Float32()) {
+            auto cn = ov.comp_node();
+            auto typecvt = intl::get_megdnn_handle(cn)
+                                   ->create_operator<megdnn::TypeCvt>();
+            DeviceTensorND shard_f32, shard_f16{cn, {shard_len}, dtype::Float16()};
+            shard_f32.reset(
+                    ov.storage().sub(dtype.size(shard_len * hierarchy.local_rank)),
+                    {{shard_len}, dtype});
+            typecvt->exec(shard_f32.as_megdnn(), shard_f16.as_megdnn());
+            status = hierarchy.cross->all_reduce(
+                    shard_f16.raw_ptr(), shard_f16.raw_ptr(), shard_len,
+                    MegRay::DType::MEGRAY_FLOAT16, op(), ctx);
+            mgb_assert(status == MegRay::MEGRAY_OK, "MegRay all_reduce failed");
+            typecvt->exec(shard_f16.as_megdnn(), shard_f32.as_megdnn());
+        } else
+#endif
+        {
+            status = hierarchy.cross->all_reduce(
+                    shard, shard, shard_len, get_megray_dtype(dtype), op(), ctx);
+            mgb_assert(status == MegRay::MEGRAY_OK, "MegRay all_reduce failed");
+        }
+        status = hierarchy.local->all_gather(
+                shard, (void*)ov.raw_ptr(), shard_len, get_megray_dtype(dtype), ctx);
+        mgb_assert(status == MegRay::MEGRAY_OK, "MegRay all_gather failed");
+    }
+
     Mode grad_mode() override { return Mode::ALL_REDUCE_SUM; }
 
 public:
@@ -584,6 +630,14 @@ void CollectiveComm::opr_register() {
             reg_info.hash, m_key, m_nr_devices, m_rank, get_megray_backend(m_backend),
             m_group_client);
 
+    if (m_param.mode == Param::Mode::ALL_REDUCE_SUM ||
+        m_param.mode == Param::Mode::ALL_REDUCE_MAX ||
+        m_param.mode == Param::Mode::ALL_REDUCE_MIN) {
+        m_megray_hierarchy = MegRayCommBuilder::get_megray_hierarchy(
+                reg_info.hash, m_key, m_nr_devices, m_rank,
+                get_megray_backend(m_backend), m_group_client);
+    }
+
     m_megray_ctx = get_megray_context(output(0)->comp_node());
 
     m_init = true;
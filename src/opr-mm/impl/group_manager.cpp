@@ -173,6 +173,33 @@ void GroupManager::bcast_nccluniqueid(
     }
 }
 
+std::vector<std::string> GroupManager::all_gather(
+        const std::string& key, const std::string& value, uint32_t size,
+        uint32_t rank) {
+    std::unique_lock<std::mutex> lk{m_key2gather_info_mtx};
+    auto&& slot = m_key2gather_info[key];
+    if (!slot) {
+        slot = std::make_shared<GatherInfo>();
+        slot->values.resize(size);
+    }
+    //! the ranks still waiting for this round hold it after the key is cleared
+    auto info = slot;
+    mgb_assert(
+            info->values.size() == size && rank < size,
+            "bad all_gather with key %s: size %u, rank %u, expected size %zu",
+            key.c_str(), size, rank, info->values.size());
+    info->values[rank] = value;
+    if (++info->nr_arrived == size) {
+        info->done = true;
+        //! clear the key at once, so that reusing it starts a new round
+        m_key2gather_info.erase(key);
+        m_gather_cv.notify_all();
+    } else {
+        m_gather_cv.wait(lk, [&] { return info->done; });
+    }
+    return info->values;
+}
+
 void GroupManager::set_output_shape(const std::string& key, const TensorShape& shape) {
     auto&& group = get_group(key);
     group.set_output_shape(key, shape);
@@ -1,7 +1,11 @@
 #include "megbrain/opr/megray_helper.h"
 #include "megbrain/comp_node_env.h"
+#include "megbrain/utils/hash.h"
 #include "megray/common.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace mgb;
 using namespace opr;
 
@@ -79,16 +83,19 @@ void MegRayCommBuilder::remove(
     }
 }
 
+MegRayCommBuilder* MegRayCommBuilder::instance() {
+    // singleton pattern
+    std::unique_lock<std::mutex> lk(sm_instance_mtx);
+    if (sm_instance == nullptr) {
+        sm_instance = new MegRayCommBuilder();
+    }
+    return sm_instance;
+}
+
 std::shared_ptr<MegRay::Communicator> MegRayCommBuilder::get_megray_comm(
         uint64_t hash, std::string key, uint32_t size, uint32_t rank,
         MegRay::Backend backend, std::shared_ptr<mgb::opr::GroupClient> group_client) {
-    {
-        // singleton pattern
-        std::unique_lock<std::mutex> lk(sm_instance_mtx);
-        if (sm_instance == nullptr) {
-            sm_instance = new MegRayCommBuilder();
-        }
-    }
+    instance();
 
     std::shared_ptr<MegRay::Communicator> comm;
     if (!sm_instance->find(hash, comm)) {
@@ -113,6 +120,99 @@ std::shared_ptr<MegRay::Communicator> MegRayCommBuilder::get_megray_comm(
     return comm;
 }
 
+namespace {
+
+//! the host ip of each rank
+std::vector<std::string> gather_hosts(
+        const std::string& key, uint32_t size, uint32_t rank,
+        const std::shared_ptr<GroupClient>& group_client) {
+    char* c = MegRay::get_host_ip();
+    std::string host_ip(c);
+    delete[] c;
+    return group_client->all_gather(key + ":host", host_ip, size, rank);
+}
+
+uint64_t sub_comm_hash(const std::string& key, uint32_t rank) {
+    return XXHash{}
+            .update(key.data(), key.size())
+            .update(&rank, sizeof(rank))
+            .digest();
+}
+
+}  // anonymous namespace
+
+std::shared_ptr<MegRayHierarchy> MegRayCommBuilder::get_megray_hierarchy(
+        uint64_t hash, const std::string& key, uint32_t size, uint32_t rank,
+        MegRay::Backend backend, std::shared_ptr<mgb::opr::GroupClient> group_client) {
+    auto inst = instance();
+    {
+        std::unique_lock<std::mutex> lk(inst->m_map_mtx);
+        auto it = inst->m_hierarchies.find(hash);
+        if (it != inst->m_hierarchies.end()) {
+            return it->second;
+        }
+    }
+
+    std::shared_ptr<MegRayHierarchy> hierarchy;
+    auto enabled = MGB_GETENV("MGB_HIERARCHICAL_ALLREDUCE");
+    if (size >= 4 && !(enabled && !strcmp(enabled, "0"))) {
+        // the hosts can be given by the number of consecutive ranks on each host,
+        // in case that the ip is not able to tell the hosts, e.g. in containers
+        std::vector<std::string> hosts;
+        if (auto local_size = MGB_GETENV("MGB_HIERARCHICAL_ALLREDUCE_LOCAL_SIZE")) {
+            uint32_t n = std::max(std::atoi(local_size), 1);
+            for (uint32_t i = 0; i < size; ++i) {
+                hosts.push_back(std::to_string(i / n));
+            }
+        } else {
+            hosts = gather_hosts(key, size, rank, group_client);
+        }
+        // the ranks of each host, in the order the hosts first appear
+        std::vector<std::string> host_list;
+        std::vector<std::vector<uint32_t>> host_ranks;
+        size_t my_host = 0;
+        for (uint32_t i = 0; i < size; ++i) {
+            auto it = std::find(host_list.begin(), host_list.end(), hosts[i]);
+            size_t idx = it - host_list.begin();
+            if (it == host_list.end()) {
+                host_list.push_back(hosts[i]);
+                host_ranks.emplace_back();
+            }
+            host_ranks[idx].push_back(i);
+            if (i == rank) {
+                my_host = idx;
+            }
+        }
+        uint32_t local_size = host_ranks[0].size();
+        bool uniform = true;
+        for (auto&& ranks : host_ranks) {
+            uniform &= ranks.size() == local_size;
+        }
+        if (host_list.size() > 1 && local_size > 1 && uniform) {
+            auto&& ranks = host_ranks[my_host];
+            uint32_t local_rank = std::find(ranks.begin(), ranks.end(), rank) -
+                                  ranks.begin();
+            hierarchy = std::make_shared<MegRayHierarchy>();
+            hierarchy->local_size = local_size;
+            hierarchy->local_rank = local_rank;
+            auto local_key = ssprintf("%s:local:%zu", key.c_str(), my_host);
+            hierarchy->local = get_megray_comm(
+                    sub_comm_hash(local_key, local_rank), local_key, local_size,
+                    local_rank, backend, group_client);
+            auto cross_key = ssprintf("%s:cross:%u", key.c_str(), local_rank);
+            hierarchy->cross = get_megray_comm(
+                    sub_comm_hash(cross_key, my_host), cross_key, host_list.size(),
+                    my_host, backend, group_client);
+            auto compress = MGB_GETENV("MGB_HIERARCHICAL_ALLREDUCE_COMPRESS");
+            hierarchy->compress_fp16 = compress && !strcmp(compress, "fp16");
+        }
+    }
+
+    std::unique_lock<std::mutex> lk(inst->m_map_mtx);
+    inst->m_hierarchies.emplace(hash, hierarchy);
+    return hierarchy;
+}
+
 MegRayCommBuilder* MegRayCommBuilder::sm_instance = nullptr;
 
 std::mutex MegRayCommBuilder::sm_instance_mtx;
@@ -46,6 +46,7 @@ public:
         RUNSERVER(bcast_addr);
         RUNSERVER(group_barrier);
         RUNSERVER(bcast_nccluniqueid);
+        RUNSERVER(all_gather);
         mgb_assert(false, "invalid rpc request");
     }
 
@@ -56,6 +57,7 @@ private:
     void bcast_addr(void* input_ptr, size_t input_len, std::string* output);
     void bcast_nccluniqueid(void* input_ptr, size_t input_len, std::string* output);
     void group_barrier(void* input_ptr, size_t input_len, std::string* output);
+    void all_gather(void* input_ptr, size_t input_len, std::string* output);
 
 private:
     GroupManager m_mgr;
@@ -134,6 +136,16 @@ void GroupServerProxy::group_barrier(
     rsp.set_size(rsp_size);
     rsp.SerializeToString(output);
 }
+
+void GroupServerProxy::all_gather(
+        void* input_ptr, size_t input_len, std::string* output) {
+    INFO_INIT(mm_handler, AllGather);
+    auto values = m_mgr.all_gather(req.key(), req.value(), req.size(), req.rank());
+    for (auto&& i : values) {
+        rsp.add_values(i);
+    }
+    rsp.SerializeToString(output);
+}
 #undef INFO_INIT
 
 /* ======================== GroupClientProxy ========================== */
@@ -225,6 +237,18 @@ void GroupClientProxy::bcast_nccluniqueid(
     id = rsp.id();
 }
 
+std::vector<std::string> GroupClientProxy::all_gather(
+        const std::string& key, const std::string& value, uint32_t size,
+        uint32_t rank) {
+    INFO_INIT(mm_handler, all_gather, AllGather);
+    req.set_key(key.data(), key.size());
+    req.set_value(value.data(), value.size());
+    req.set_size(size);
+    req.set_rank(rank);
+    SOLVE_REQUEST(func_name, req, rsp);
+    return {rsp.values().begin(), rsp.values().end()};
+}
+
 uint32_t GroupClientProxy::group_barrier(uint32_t size, uint32_t rank) {
     INFO_INIT(mm_handler, group_barrier, GroupBarrier);
     req.set_size(size);
@@ -39,6 +39,10 @@ void ZmqRpcWorker::work(string uid) {
     // req work pattern: send recv send recv ...
     zmq::socket_t socket(*m_ctx, ZMQ_REQ);
     socket.setsockopt(ZMQ_IDENTITY, uid.data(), uid.size());
+    // block in recv rather than polling, since there is a worker for each pending
+    // request and hundreds of them may be waiting in a rendezvous; the timeout
+    // only bounds the delay to observe m_stop
+    socket.setsockopt(ZMQ_RCVTIMEO, 100);
     socket.connect("inproc://workers");
 
     // send READY to notify server that worker is ready
@@ -51,11 +55,9 @@ void ZmqRpcWorker::work(string uid) {
         message_t address;
         recv_result_t ret_code;
         while (!m_stop) {
-            ret_code = socket.recv(address, recv_flags::dontwait);
+            ret_code = socket.recv(address);
             if (ret_code.has_value() && ret_code.value() > 0)
                 break;
-            // retry after 10 usec
-            usleep(10);
         }
         if (m_stop)
             break;
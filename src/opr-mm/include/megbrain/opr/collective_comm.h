@@ -2,6 +2,7 @@
 
 #include "megbrain/graph.h"
 #include "megbrain/opr/group_manager.h"
+#include "megbrain/opr/megray_helper.h"
 #include "megbrain/opr/param_defs.h"
 #include "megray.h"
 
@@ -120,6 +121,8 @@ private:
 
     std::shared_ptr<MegRay::Context> m_megray_ctx;
     std::shared_ptr<MegRay::Communicator> m_megray_comm;
+    //! set for the all-reduce modes if the group spans multiple hosts
+    std::shared_ptr<MegRayHierarchy> m_megray_hierarchy;
     bool m_init = false;
     bool m_debug_mode = false;
 
@@ -82,6 +82,16 @@ public:
             const std::string& key, std::string& id, uint32_t size, uint32_t rank,
             uint32_t root);
 
+    /*!
+     * \brief gather a string from each rank of the group in one round, so that
+     *      the ranks need not broadcast their own values in turn
+     *
+     * \return the values of all the ranks, indexed by the rank
+     */
+    std::vector<std::string> all_gather(
+            const std::string& key, const std::string& value, uint32_t size,
+            uint32_t rank);
+
     //! Set output shape of this key
     void set_output_shape(const std::string& key, const TensorShape& shape);
 
@@ -112,6 +122,16 @@ private:
     std::unordered_map<std::string, bool> m_key2nccl_id_flag;
     std::mutex m_key2nccl_id_mtx;
 
+    //! key -> values gathered from the ranks in the ongoing round
+    struct GatherInfo {
+        std::vector<std::string> values;
+        uint32_t nr_arrived = 0;
+        bool done = false;
+    };
+    std::unordered_map<std::string, std::shared_ptr<GatherInfo>> m_key2gather_info;
+    std::mutex m_key2gather_info_mtx;
+    std::condition_variable m_gather_cv;
+
     //! barrier
     uint32_t m_barrier_size;
     std::set<uint32_t> m_barrier_set;
@@ -143,6 +163,10 @@ public:
             const std::string& key, std::string& id, uint32_t size, uint32_t rank,
             uint32_t root) = 0;
 
+    virtual std::vector<std::string> all_gather(
+            const std::string& key, const std::string& value, uint32_t size,
+            uint32_t rank) = 0;
+
     virtual void set_output_shape(const std::string& key, const TensorShape& shape) = 0;
 
     virtual TensorShape get_output_shape(const std::string& key) = 0;
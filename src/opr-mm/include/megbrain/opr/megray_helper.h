@@ -16,6 +16,22 @@ MegRay::Backend get_megray_backend(const std::string& backend);
 
 std::shared_ptr<MegRay::Context> get_megray_context(CompNode comp_node);
 
+/*!
+ * \brief communicators of the hierarchical all-reduce across hosts
+ *
+ * The buffer is reduce-scattered among the ranks on the same host, the shards
+ * are all-reduced across the hosts by the ranks with the same local rank, and
+ * then all-gathered on each host. So only 1/local_size of the data goes through
+ * the inter-host links, which are usually much slower than those in a host.
+ */
+struct MegRayHierarchy {
+    std::shared_ptr<MegRay::Communicator> local, cross;
+    uint32_t local_size, local_rank;
+    //! whether to all-reduce the float32 shards across the hosts in float16,
+    //! set by MGB_HIERARCHICAL_ALLREDUCE_COMPRESS=fp16
+    bool compress_fp16;
+};
+
 /*!
  * gather MegRay unique ids and build communicator, use hash for deduplication
  */
@@ -26,16 +42,36 @@ private:
     void remove(uint64_t hash, std::shared_ptr<MegRay::Communicator> comm);
 
     std::unordered_map<uint64_t, std::shared_ptr<MegRay::Communicator>> m_megray_comms;
+    //! null if the group is not split into hosts
+    std::unordered_map<uint64_t, std::shared_ptr<MegRayHierarchy>> m_hierarchies;
     std::mutex m_map_mtx;
 
     static MegRayCommBuilder* sm_instance;
     static std::mutex sm_instance_mtx;
 
+    static MegRayCommBuilder* instance();
+
 public:
     static std::shared_ptr<MegRay::Communicator> get_megray_comm(
             uint64_t hash, std::string key, uint32_t size, uint32_t rank,
             MegRay::Backend backend,
             std::shared_ptr<mgb::opr::GroupClient> group_client);
+
+    /*!
+     * \brief get the communicators of the hierarchical all-reduce, or null if
+     *      the flat one should be used
+     *
+     * The hosts of the ranks are exchanged through \p group_client, and the
+     * hierarchy is used when the group spans more than one host and every host
+     * has the same number (more than one) of ranks. It can be disabled by
+     * MGB_HIERARCHICAL_ALLREDUCE=0, and the hosts can be given by
+     * MGB_HIERARCHICAL_ALLREDUCE_LOCAL_SIZE=n, so that every n consecutive ranks
+     * are on one host. All the ranks must call it collectively.
+     */
+    static std::shared_ptr<MegRayHierarchy> get_megray_hierarchy(
+            uint64_t hash, const std::string& key, uint32_t size, uint32_t rank,
+            MegRay::Backend backend,
+            std::shared_ptr<mgb::opr::GroupClient> group_client);
 };
 
 }  // namespace opr
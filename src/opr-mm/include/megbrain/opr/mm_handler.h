@@ -43,6 +43,10 @@ public:
             const std::string& key, std::string& id, uint32_t size, uint32_t rank,
             uint32_t root) override;
 
+    std::vector<std::string> all_gather(
+            const std::string& key, const std::string& value, uint32_t size,
+            uint32_t rank) override;
+
     void set_output_shape(const std::string& key, const TensorShape& shape) override;
 
     TensorShape get_output_shape(const std::string& key) override;
@@ -1793,4 +1793,129 @@ TEST(TestOprCollectiveComm, AllToAllWithGradThisNodeOnly) {
     MGB_ASSERT_TENSOR_EQ(host_expect_grad1, host_grad1);
 }
 
+
+TEST(TestOprCollectiveComm, AllReduceHierarchical) {
+    REQUIRE_GPU(4);
+    // two fake hosts of two ranks each
+    setenv("MGB_HIERARCHICAL_ALLREDUCE_LOCAL_SIZE", "2", 1);
+    constexpr size_t nr_ranks = 4;
+
+    auto run_mode = [&](const Mode mode, const char* key) {
+        HostTensorGenerator<> gen;
+        std::vector<std::shared_ptr<HostTensorND>> host_x;
+        for (size_t i = 0; i < nr_ranks; ++i) {
+            host_x.push_back(gen({28, 28}));
+        }
+        std::vector<HostTensorND> host_y(nr_ranks);
+        HostTensorND host_y_expect;
+
+        auto client = std::make_shared<test::MockGroupClient>();
+
+        auto run = [&](size_t rank) {
+            auto cn = CompNode::load(ssprintf("gpu%zu", rank));
+            auto graph = ComputingGraph::make();
+            auto x = opr::Host2DeviceCopy::make(*graph, host_x[rank], cn);
+            auto y = opr::CollectiveComm::make(
+                    {x}, graph.get(), key, nr_ranks, false, rank, false, client,
+                    {mode}, dtype::Float32(), "nccl")[0];
+            auto func = graph->compile({make_callback_copy(y, host_y[rank])});
+            func->execute();
+        };
+
+        auto run_expect = [&]() {
+            auto graph = ComputingGraph::make();
+            SymbolVarArray xs;
+            for (auto&& i : host_x) {
+                xs.push_back(opr::Host2DeviceCopy::make(
+                        *graph, i, CompNode::load("gpu0")));
+            }
+            auto y_expect = make_all_reduce_output(mode, xs);
+            auto func = graph->compile({make_callback_copy(y_expect, host_y_expect)});
+            func->execute();
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < nr_ranks; ++i) {
+            threads.emplace_back(run, i);
+        }
+        threads.emplace_back(run_expect);
+        for (auto&& t : threads) {
+            t.join();
+        }
+
+        for (auto&& y : host_y) {
+            MGB_ASSERT_TENSOR_NEAR(host_y_expect, y, 1e-6);
+        }
+    };
+
+    run_mode(Mode::ALL_REDUCE_MAX, "all_reduce_hierarchical_max");
+    run_mode(Mode::ALL_REDUCE_SUM, "all_reduce_hierarchical_sum");
+    unsetenv("MGB_HIERARCHICAL_ALLREDUCE_LOCAL_SIZE");
+}
+
 #endif
+
+TEST(TestOprCollectiveComm, GroupManagerAllGather) {
+    const uint32_t nr_ranks = 8;
+    auto client = std::make_shared<test::MockGroupClient>();
+    std::vector<std::vector<std::string>> results(nr_ranks);
+
+    auto run = [&](uint32_t rank) {
+        // the keys of the rounds are different, as those used by the oprs
+        for (int round = 0; round < 2; ++round) {
+            auto key = ssprintf("all_gather_%d", round);
+            results[rank] = client->all_gather(
+                    key, ssprintf("value%d:%u", round, rank), nr_ranks, rank);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < nr_ranks; ++i) {
+        threads.emplace_back(run, i);
+    }
+    for (auto&& t : threads) {
+        t.join();
+    }
+
+    for (auto&& values : results) {
+        ASSERT_EQ(nr_ranks, values.size());
+        for (uint32_t i = 0; i < nr_ranks; ++i) {
+            ASSERT_EQ(ssprintf("value1:%u", i), values[i]);
+        }
+    }
+}
+
+TEST(TestOprCollectiveComm, GroupManagerAllGatherReuseKey) {
+    const uint32_t nr_ranks = 4, nr_rounds = 50;
+    auto client = std::make_shared<test::MockGroupClient>();
+    //! results[rank][round]
+    std::vector<std::vector<std::vector<std::string>>> results(
+            nr_ranks, std::vector<std::vector<std::string>>(nr_rounds));
+
+    auto run = [&](uint32_t rank) {
+        // a rank may enter the next round before the others leave this one
+        for (uint32_t round = 0; round < nr_rounds; ++round) {
+            results[rank][round] = client->all_gather(
+                    "all_gather_reused", ssprintf("value%u:%u", round, rank),
+                    nr_ranks, rank);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < nr_ranks; ++i) {
+        threads.emplace_back(run, i);
+    }
+    for (auto&& t : threads) {
+        t.join();
+    }
+
+    for (uint32_t rank = 0; rank < nr_ranks; ++rank) {
+        for (uint32_t round = 0; round < nr_rounds; ++round) {
+            auto&& values = results[rank][round];
+            ASSERT_EQ(nr_ranks, values.size());
+            for (uint32_t i = 0; i < nr_ranks; ++i) {
+                ASSERT_EQ(ssprintf("value%u:%u", round, i), values[i]);
+            }
+        }
+    }
+}
@@ -32,6 +32,12 @@ public:
         return m_mgr.bcast_nccluniqueid(key, id, size, rank, root);
     }
 
+    std::vector<std::string> all_gather(
+            const std::string& key, const std::string& value, uint32_t size,
+            uint32_t rank) override {
+        return m_mgr.all_gather(key, value, size, rank);
+    }
+
     void set_output_shape(const std::string& key, const TensorShape& shape) override {
         m_mgr.set_output_shape(key, shape);
     }
@@ -1,4 +1,5 @@
 #include "megbrain/opr/atlas_runtime_op.h"
+#include <algorithm>
 #include <memory>
 #include "megbrain/common.h"
 #include "megbrain/graph/operator_node.h"
@@ -130,6 +131,23 @@ SmallVector<size_t> gen_batch_vec(
     return ret;
 }
 
+/**
+ * \brief axes of height and width in the input of an om model
+ */
+std::pair<size_t, size_t> acl_hw_axis(aclFormat om_format) {
+    switch (om_format) {
+        case ACL_FORMAT_NCHW:
+            return {2, 3};
+        case ACL_FORMAT_NHWC:
+            return {1, 2};
+        default:
+            mgb_throw(
+                    MegBrainError,
+                    "dynamic image size requires NCHW or NHWC input, got format %d",
+                    static_cast<int>(om_format));
+    }
+}
+
 class PtrGetter {
 public:
     PtrGetter(const VarNodeArray& vars) {
@@ -238,18 +256,26 @@ AtlasRuntimeOpr::AtlasRuntimeOpr(
     if (errcode == ACL_ERROR_NONE) {
         aclmdlHW hw_info;
         MGB_ATLAS_CHECK(aclmdlGetDynamicHW(m_model_desc, dynamic_index, &hw_info));
-        mgb_assert(hw_info.hwCount == 0, "Currently not support dynamic HW");
+        for (size_t i = 0; i < hw_info.hwCount; ++i) {
+            m_dyn_hw_choices.emplace_back(
+                    static_cast<size_t>(hw_info.hw[i][0]),
+                    static_cast<size_t>(hw_info.hw[i][1]));
+        }
     }
 
     //! dynamic batch size
     aclmdlBatch acl_batch;
     MGB_ATLAS_CHECK(aclmdlGetDynamicBatch(m_model_desc, &acl_batch));
-    if (acl_batch.batchCount) {
+    mgb_assert(
+            !acl_batch.batchCount || m_dyn_hw_choices.empty(),
+            "dynamic batch and dynamic image size can not be both enabled");
+    if (acl_batch.batchCount || !m_dyn_hw_choices.empty()) {
         size_t dynamic_data_size;
         dynamic_data_size = aclmdlGetInputSizeByIndex(m_model_desc, dynamic_index);
         m_dyn_batch_tensor = DeviceTensorND(
                 inputs[0]->comp_node(), {{dynamic_data_size}, dtype::Uint8()});
-
+    }
+    if (acl_batch.batchCount) {
         for (size_t i = 0; i < acl_batch.batchCount; ++i) {
             m_dyn_batch_choices.push_back(static_cast<size_t>(acl_batch.batch[i]));
         }
@@ -268,10 +294,10 @@ AtlasRuntimeOpr::AtlasRuntimeOpr(
             add_output(ssprintf("o%zu", i));
         }
     }
-    if (!m_dyn_batch_choices.empty()) {
+    if (dyn_input()) {
         /**
-         * \warning If enable dynamic batchsize, the memory of output
-         * should be the largest be the size with the largest batch_size, so we
+         * \warning If enable dynamic batchsize or image size, the memory of
+         * output should be the largest be the size with the largest gear, so we
          * set the flag to SYS_MEM_ALLOC.
          */
         for (size_t i = 0; i < nr_outputs; ++i) {
@@ -282,17 +308,51 @@ AtlasRuntimeOpr::AtlasRuntimeOpr(
 };
 
 AtlasRuntimeOpr::~AtlasRuntimeOpr() {
+    release_pending_execs();
     if (m_is_model_holder) {
         MGB_ATLAS_CHECK(aclmdlUnload(m_model_id));
         MGB_ATLAS_CHECK(aclmdlDestroyDesc(m_model_desc));
     }
 }
 
+void AtlasRuntimeOpr::release_exec(PendingExec& exec) {
+    if (exec.event != nullptr) {
+        MGB_ATLAS_CHECK(aclrtSynchronizeEvent(exec.event));
+        MGB_ATLAS_CHECK(aclrtDestroyEvent(exec.event));
+    }
+    for (auto dataset : {exec.inputs, exec.outputs}) {
+        if (dataset == nullptr)
+            continue;
+        size_t nr_buffers = aclmdlGetDatasetNumBuffers(dataset);
+        for (size_t i = 0; i < nr_buffers; ++i) {
+            MGB_ATLAS_CHECK(aclDestroyDataBuffer(aclmdlGetDatasetBuffer(dataset, i)));
+        }
+        MGB_ATLAS_CHECK(aclmdlDestroyDataset(dataset));
+    }
+    for (auto desc : exec.tensor_descs) {
+        if (desc != nullptr) {
+            aclDestroyTensorDesc(desc);
+        }
+    }
+    exec = {};
+}
+
+void AtlasRuntimeOpr::release_pending_execs() {
+    if (m_pending_execs.empty())
+        return;
+    CompNodeEnv::from_comp_node(comp_node()).atlas_env().activate();
+    for (auto&& i : m_pending_execs) {
+        release_exec(i);
+    }
+    m_pending_execs.clear();
+}
+
 void AtlasRuntimeOpr::scn_do_execute() {
     auto&& acl_env = CompNodeEnv::from_comp_node(input(0)->comp_node()).atlas_env();
     acl_env.activate();
+    release_pending_execs();
 
-    if (!m_dyn_batch_choices.empty()) {
+    if (dyn_input()) {
         for (size_t i = 0; i < output().size(); i++) {
             auto output_size = aclmdlGetOutputSizeByIndex(m_model_desc, i);
             auto ovar = output(i);
@@ -306,11 +366,12 @@ void AtlasRuntimeOpr::scn_do_execute() {
     PtrGetter output_getter(output());
 
     bool enable_dynamic_batch = !m_dyn_batch_choices.empty();
+    bool enable_dynamic_hw = !m_dyn_hw_choices.empty();
     size_t nr_inputs = aclmdlGetNumInputs(m_model_desc);
     size_t nr_outputs = aclmdlGetNumOutputs(m_model_desc);
     size_t input_batch = input(0)->layout()[0];
 
-    if (enable_dynamic_batch) {
+    if (dyn_input()) {
         mgb_assert(
                 nr_inputs == input().size() + 1,
                 "nr inputs got from om model should be one more than got "
@@ -322,11 +383,26 @@ void AtlasRuntimeOpr::scn_do_execute() {
     } else {
         batches_each_run.push_back(input_batch);
     }
+    std::pair<size_t, size_t> hw;
+    if (enable_dynamic_hw) {
+        auto axis = acl_hw_axis(aclmdlGetInputFormat(m_model_desc, 0));
+        hw = {input(0)->shape()[axis.first], input(0)->shape()[axis.second]};
+    }
+
+    //! the shapes of the outputs are only known after execution, which has to
+    //! be waited for; the runs split from a dynamic batch share the dynamic
+    //! batch tensor, so they are serialized as well
+    bool need_sync = enable_dynamic_hw || batches_each_run.size() > 1;
+    for (size_t i = 0; i < nr_outputs; ++i) {
+        need_sync |= m_dyn_batch_output[i];
+    }
 
     for (auto&& batch : batches_each_run) {
+        PendingExec exec;
         //! prepare input
         auto model_inputs = aclmdlCreateDataset();
         mgb_assert(model_inputs != nullptr, "failed to create atlas input dataset.");
+        exec.inputs = model_inputs;
         for (size_t i = 0; i < input().size(); i++) {
             auto value_pair = input_getter.get(batch, i);
             auto input_size = aclmdlGetInputSizeByIndex(m_model_desc, i);
@@ -348,8 +424,8 @@ void AtlasRuntimeOpr::scn_do_execute() {
                     i, input(i)->cname());
             aclmdlAddDatasetBuffer(model_inputs, input_db);
         }
-        //! append unit tensor for dynamic batch
-        if (enable_dynamic_batch) {
+        //! append unit tensor for dynamic batch or image size
+        if (dyn_input()) {
             aclDataBuffer* input_db = aclCreateDataBuffer(
                     reinterpret_cast<void*>(m_dyn_batch_tensor.raw_ptr()),
                     m_dyn_batch_tensor.layout().span().dist_byte());
@@ -358,20 +434,26 @@ void AtlasRuntimeOpr::scn_do_execute() {
                     "failed to create atlas input data buffer for dynamic "
                     "batch tensor.");
             MGB_ATLAS_CHECK(aclmdlAddDatasetBuffer(model_inputs, input_db));
-
+        }
+        if (enable_dynamic_batch) {
             MGB_ATLAS_CHECK(aclmdlSetDynamicBatchSize(
                     m_model_id, model_inputs, input().size(),
                     static_cast<uint64_t>(batch)));
+        } else if (enable_dynamic_hw) {
+            MGB_ATLAS_CHECK(aclmdlSetDynamicHWSize(
+                    m_model_id, model_inputs, input().size(),
+                    static_cast<uint64_t>(hw.first), static_cast<uint64_t>(hw.second)));
         }
 
         //! prepare output
         auto model_outputs = aclmdlCreateDataset();
         mgb_assert(model_outputs != nullptr, "failed to create atlas output dataset.");
-        std::vector<aclTensorDesc*> tensor_desc_holder(nr_outputs, nullptr);
+        exec.outputs = model_outputs;
+        exec.tensor_descs.resize(nr_outputs, nullptr);
         for (size_t i = 0; i < nr_outputs; i++) {
             auto value_pair = output_getter.get(batch, i);
             size_t output_size = value_pair.second;
-            if (enable_dynamic_batch || m_dyn_batch_output[i]) {
+            if (dyn_input() || m_dyn_batch_output[i]) {
                 output_size = aclmdlGetOutputSizeByIndex(m_model_desc, i);
             }
             aclDataBuffer* output_db =
@@ -393,57 +475,61 @@ void AtlasRuntimeOpr::scn_do_execute() {
                         aclmdlGetOutputDataType(m_model_desc, i), tensor_ndim,
                         tensor_shape.data(), aclmdlGetOutputFormat(m_model_desc, i));
                 aclmdlSetDatasetTensorDesc(model_outputs, tensorDesc, i);
-                tensor_desc_holder[i] = tensorDesc;
+                exec.tensor_descs[i] = tensorDesc;
             }
         }
 
 #if MGB_USE_ATLAS_ASYNC_API
         MGB_ATLAS_CHECK(aclmdlExecuteAsync(
                 m_model_id, model_inputs, model_outputs, acl_env.stream));
+        if (!need_sync) {
+            //! release the resources at the next execution instead of waiting
+            //! for the device here
+            MGB_ATLAS_CHECK(aclrtCreateEvent(&exec.event));
+            MGB_ATLAS_CHECK(aclrtRecordEvent(exec.event, acl_env.stream));
+            m_pending_execs.emplace_back(std::move(exec));
+            continue;
+        }
         MGB_ATLAS_CHECK(aclrtSynchronizeStream(acl_env.stream));
 #else
+        MGB_MARK_USED_VAR(need_sync);
         MGB_ATLAS_CHECK(aclmdlExecute(m_model_id, model_inputs, model_outputs));
 #endif
-        for (size_t i = 0; i < nr_inputs; ++i) {
-            aclDataBuffer* db_ptr = aclmdlGetDatasetBuffer(model_inputs, i);
-            MGB_ATLAS_CHECK(aclDestroyDataBuffer(db_ptr));
-        }
         for (size_t i = 0; i < nr_outputs; ++i) {
-            if (m_dyn_batch_output[i]) {
-                const DeviceTensorND old_dev_tensor = output(i)->dev_tensor();
-
+            TensorShape new_shape;
+            if (enable_dynamic_hw) {
+                aclmdlIODims cur_dims;
+                MGB_ATLAS_CHECK(aclmdlGetCurOutputDims(m_model_desc, i, &cur_dims));
+                new_shape.ndim = cur_dims.dimCount;
+                for (size_t j = 0; j < new_shape.ndim; j++) {
+                    new_shape.shape[j] = cur_dims.dims[j];
+                }
+            } else if (m_dyn_batch_output[i]) {
                 auto new_output_desc = aclmdlGetDatasetTensorDesc(model_outputs, i);
-
-                TensorShape new_shape;
                 new_shape.ndim = aclGetTensorDescNumDims(new_output_desc);
-                mgb_assert(
-                        new_shape.ndim == old_dev_tensor.layout().ndim,
-                        "for static input batch and dynamic output batch, the output "
-                        "ndim should be consistent with the one before calling "
-                        "aclmdlExecute(), so expect %zu, but got %zu",
-                        old_dev_tensor.layout().ndim, new_shape.ndim);
                 for (size_t j = 0; j < new_shape.ndim; j++) {
                     new_shape.shape[j] = aclGetTensorDescDim(new_output_desc, j);
                 }
-
-                TensorLayout new_layout{
-                        new_shape, old_dev_tensor.dtype(), old_dev_tensor.format()};
-                DeviceTensorND new_dev_tensor{
-                        old_dev_tensor.comp_node(), new_layout, old_dev_tensor.dtype(),
-                        old_dev_tensor.format()};
-                new_dev_tensor.reset(old_dev_tensor.storage(), new_layout);
-                output(i)->force_assign_dev_tensor_from_tensor(new_dev_tensor);
-            }
-            aclDataBuffer* db_ptr = aclmdlGetDatasetBuffer(model_outputs, i);
-            MGB_ATLAS_CHECK(aclDestroyDataBuffer(db_ptr));
-        }
-        for (size_t i = 0; i < tensor_desc_holder.size(); ++i) {
-            if (tensor_desc_holder[i] != nullptr) {
-                aclDestroyTensorDesc(tensor_desc_holder[i]);
+            } else {
+                continue;
             }
+            const DeviceTensorND old_dev_tensor = output(i)->dev_tensor();
+            mgb_assert(
+                    new_shape.ndim == old_dev_tensor.layout().ndim,
+                    "for dynamic output shape, the output ndim should be "
+                    "consistent with the one before calling aclmdlExecute(), so "
+                    "expect %zu, but got %zu",
+                    old_dev_tensor.layout().ndim, new_shape.ndim);
+
+            TensorLayout new_layout{
+                    new_shape, old_dev_tensor.dtype(), old_dev_tensor.format()};
+            DeviceTensorND new_dev_tensor{
+                    old_dev_tensor.comp_node(), new_layout, old_dev_tensor.dtype(),
+                    old_dev_tensor.format()};
+            new_dev_tensor.reset(old_dev_tensor.storage(), new_layout);
+            output(i)->force_assign_dev_tensor_from_tensor(new_dev_tensor);
         }
-        MGB_ATLAS_CHECK(aclmdlDestroyDataset(model_inputs));
-        MGB_ATLAS_CHECK(aclmdlDestroyDataset(model_outputs));
+        release_exec(exec);
     }
 }
 
@@ -459,6 +545,21 @@ void AtlasRuntimeOpr::get_output_var_shape(
                 "nr inputs got from om model should be one more than got "
                 "from megbrain");
     }
+    //! enable dynamic image size
+    if (!m_dyn_hw_choices.empty()) {
+        mgb_assert(
+                nr_inputs == inp_shape.size() + 1,
+                "nr inputs got from om model should be one more than got "
+                "from megbrain");
+        auto axis = acl_hw_axis(aclmdlGetInputFormat(m_model_desc, 0));
+        std::pair<size_t, size_t> hw{
+                inp_shape[0][axis.first], inp_shape[0][axis.second]};
+        mgb_assert(
+                std::find(m_dyn_hw_choices.begin(), m_dyn_hw_choices.end(), hw) !=
+                        m_dyn_hw_choices.end(),
+                "image size %zux%zu of input %s is not a gear of the om model",
+                hw.first, hw.second, inp_shape[0].to_string().c_str());
+    }
     for (size_t i = 0; i < inp_shape.size(); ++i) {
         batch_size = inp_shape[i][0];
         aclmdlIODims input_dims;
@@ -761,4 +761,26 @@ MGB_IMPL_OPR_GRAD(Cross) {
 }
 #endif
 
+/* ================= WeightOnlyQuantMatrixMul =================  */
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(WeightOnlyQuantMatrixMul);
+MEGDNN_OPR_INIT3(WeightOnlyQuantMatrixMul, "weight_only_quant_matmul")
+
+void WeightOnlyQuantMatrixMul::add_input_layout_constraint() {
+    for (auto i : input()) {
+        i->add_layout_constraint_contiguous();
+    }
+}
+
+/* ================= StructuredSparseMatrixMul =================  */
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(StructuredSparseMatrixMul);
+MEGDNN_OPR_INIT3(StructuredSparseMatrixMul, "structured_sparse_matmul")
+
+void StructuredSparseMatrixMul::add_input_layout_constraint() {
+    for (auto i : input()) {
+        i->add_layout_constraint_contiguous();
+    }
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
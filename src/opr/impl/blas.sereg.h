@@ -93,6 +93,8 @@ MGB_SEREG_OPR(Dot, 2);
 MGB_SEREG_OPR(MatrixInverse, 1);
 MGB_SEREG_OPR(SVD, 1);
 MGB_SEREG_OPR(Cross, 2);
+MGB_SEREG_OPR(WeightOnlyQuantMatrixMul, 3);
+MGB_SEREG_OPR(StructuredSparseMatrixMul, 3);
 }  // namespace opr
 
 }  // namespace mgb
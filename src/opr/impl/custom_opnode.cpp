@@ -124,6 +124,14 @@ void CustomOpNode::do_execute(ExecEnv& env) {
         for (size_t i = 0; i < output_num(); i++) {
             outputs->emplace_back(output(i)->dev_tensor());
         }
+        for (size_t i = 0; i < output_num(); ++i) {
+            int inp = m_op->forward_input(i);
+            bool fwd_success = i < m_rofwd_success.size() && m_rofwd_success[i];
+            if (inp >= 0 && !fwd_success && !output(i)->shape().is_empty()) {
+                auto spec = SubTensorSpec::make_from_layout(rofwd_layout(i));
+                outputs->at(i).copy_from_fixlayout(input(inp)->dev_tensor().sub(spec));
+            }
+        }
 
         this->owner_graph()->event().signal_inplace<cg::event::BeforeKernel>(
                 this, m_comp_node);
@@ -175,9 +183,48 @@ void CustomOpNode::add_input_layout_constraint() {
     }
 }
 
-void CustomOpNode::mem_plan_fwd_in2out_readonly() {}
+TensorLayout CustomOpNode::rofwd_layout(size_t out_idx) const {
+    auto inp = input(m_op->forward_input(out_idx));
+    auto out = output(out_idx);
+    mgb_assert(
+            inp->dtype() == out->dtype() &&
+                    inp->shape().total_nr_elems() == out->shape().total_nr_elems(),
+            "can not forward input %s to output %s of custom op %s",
+            inp->layout().to_string().c_str(), out->layout().to_string().c_str(),
+            cname());
+    return TensorLayout{out->shape(), out->dtype()};
+}
+
+void CustomOpNode::mem_plan_fwd_in2out_readonly() {
+    m_rofwd_success.assign(output_num(), false);
+    for (size_t i = 0; i < output_num(); ++i) {
+        if (m_op->forward_input(i) < 0)
+            continue;
+        auto spec = SubTensorSpec::make_from_layout(rofwd_layout(i));
+        m_rofwd_success[i] =
+                output(i)->set_fwd_in2out_readonly(input(m_op->forward_input(i)), spec);
+    }
+}
 
-void CustomOpNode::mem_plan_fwd_in2out_writable() {}
+void CustomOpNode::mem_plan_fwd_in2out_writable() {
+    for (size_t i = 0; i < output_num(); ++i) {
+        int idx = m_op->inplace_input(i);
+        if (idx < 0)
+            continue;
+        // the input must not be modified if another output is its view
+        bool viewed = false;
+        for (size_t j = 0; j < output_num(); ++j) {
+            viewed |= m_op->forward_input(j) == idx;
+        }
+        if (viewed)
+            continue;
+        auto inp = input(idx), out = output(i);
+        if (out->shape().eq_shape(inp->shape()) &&
+            out->dtype().enumv() == inp->dtype().enumv() &&
+            inp->layout().is_contiguous())
+            out->set_fwd_in2out_writable(inp);
+    }
+}
 
 cg::OperatorNodeBase::OprEventCallback CustomOpNode::get_opr_event_callback() {
     return {};
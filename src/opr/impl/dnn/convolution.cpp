@@ -17,7 +17,9 @@
 #include <array>
 #include <chrono>
 #include <cstring>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 
 using namespace mgb;
 using namespace opr;
@@ -137,19 +139,139 @@ void mixin::ConvolutionBackwardDataMixin::init_output_static_infer_desc_for_bwd_
 
 #define IMPL_CONV(_cls) MGB_DYN_TYPE_OBJ_FINAL_IMPL(_cls)
 
+namespace {
+void append_key(std::string& key, const void* data, size_t size) {
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(static_cast<const char*>(data), size);
+}
+
+void append_key(std::string& key, const std::string& str) {
+    append_key(key, str.data(), str.size());
+}
+
+void append_key(std::string& key, const megdnn::ExecutionPolicy& policy) {
+    auto&& desc = policy.algo;
+    append_key(key, &desc.handle_type, sizeof(desc.handle_type));
+    append_key(key, &desc.type, sizeof(desc.type));
+    append_key(key, desc.param);
+    append_key(key, desc.name);
+    size_t nr_sub_policy = policy.sub_policy.size();
+    append_key(key, &nr_sub_policy, sizeof(nr_sub_policy));
+    for (auto&& sub : policy.sub_policy) {
+        append_key(key, sub);
+    }
+}
+
+template <typename Param>
+std::string make_preprocess_config_key(
+        const Param& param, const megdnn::ExecutionPolicy& policy) {
+    std::string key;
+    append_key(key, &param, sizeof(Param));
+    append_key(key, policy);
+    return key;
+}
+}  // anonymous namespace
+
 class mixin::WeightPreprocessExecutor::PreprocessedFilterExecDep final
         : public cg::GraphExecutable::ExecDependency {
-    std::unique_ptr<PreprocessedFilter> m_pf;
-    SmallVector<DeviceTensorND> m_filter_storage;
+    std::shared_ptr<PreprocessedFilterStorage> m_storage;
 
 public:
     explicit PreprocessedFilterExecDep(
-            std::unique_ptr<PreprocessedFilter> preprocessed_filter,
-            SmallVector<DeviceTensorND> filter_storage)
-            : m_pf(std::move(preprocessed_filter)),
-              m_filter_storage(std::move(filter_storage)) {}
+            std::shared_ptr<PreprocessedFilterStorage> storage)
+            : m_storage(std::move(storage)) {}
 };
 
+/*!
+ * process-wide content addressed cache of preprocessed filters
+ *
+ * The cache only holds weak references, the storage is released when the last
+ * opr (or the exec dependency of the last compiled func) using it is gone. The
+ * lock is not held while preprocessing, so two graphs racing on one key may
+ * both preprocess it; insert() then keeps the first one.
+ */
+class mixin::WeightPreprocessExecutor::PreprocessedFilterCache final
+        : public NonCopyableObj {
+    MGB_MUTEX m_mtx;
+    std::unordered_map<std::string, std::weak_ptr<PreprocessedFilterStorage>>
+            m_storage;
+
+public:
+    static PreprocessedFilterCache& inst() {
+        static PreprocessedFilterCache cache;
+        return cache;
+    }
+
+    //! get the live storage of \p key, or nullptr if there is none
+    std::shared_ptr<PreprocessedFilterStorage> find(const std::string& key) {
+        MGB_LOCK_GUARD(m_mtx);
+        auto iter = m_storage.find(key);
+        if (iter != m_storage.end()) {
+            return iter->second.lock();
+        }
+        return {};
+    }
+
+    //! insert \p storage for \p key unless another live storage has been
+    //! inserted meanwhile; return the storage that should be used
+    std::shared_ptr<PreprocessedFilterStorage> insert(
+            const std::string& key,
+            std::shared_ptr<PreprocessedFilterStorage> storage) {
+        MGB_LOCK_GUARD(m_mtx);
+        for (auto it = m_storage.begin(); it != m_storage.end();) {
+            if (it->second.expired()) {
+                it = m_storage.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        auto&& entry = m_storage[key];
+        if (auto ret = entry.lock()) {
+            return ret;
+        }
+        entry = storage;
+        return storage;
+    }
+};
+
+bool mixin::WeightPreprocessExecutor::make_shared_filter_key(
+        const cg::OperatorNodeBase& opr, std::string& key) {
+    if (!opr.owner_graph()->options().share_preprocessed_weight) {
+        return false;
+    }
+    //! const weights are synced to the comp node when the graph is loaded, so
+    //! on cpu their values can be read here directly
+    auto cn = opr.output(0)->comp_node();
+    auto device_type = cn.device_type();
+    if (device_type != CompNode::DeviceType::CPU &&
+        device_type != CompNode::DeviceType::MULTITHREAD) {
+        return false;
+    }
+    key.clear();
+    append_key(key, std::string{opr.dyn_typeinfo()->name});
+    append_key(key, cn.to_string());
+    append_key(key, preprocess_config_key());
+    for (auto&& inp : opr.input()) {
+        append_key(key, inp->layout().serialize());
+    }
+    append_key(key, opr.output(0)->layout().serialize());
+    //! filter and bias are the inputs read by preprocess
+    for (size_t i = 1; i < std::min<size_t>(opr.input().size(), 3); ++i) {
+        auto var = opr.input(i);
+        if (!var->contain_flag(VarNode::Flag::PERSISTENT_DEVICE_VALUE)) {
+            return false;
+        }
+        auto&& value = var->dev_tensor();
+        if (!value.layout().is_contiguous()) {
+            return false;
+        }
+        //! the values themselves, not a digest of them: a hash collision
+        //! would silently run the opr with another model's weights
+        append_key(key, value.raw_ptr(), value.layout().span().dist_byte());
+    }
+    return true;
+}
+
 void mixin::WeightPreprocessExecutor::mixin_update_preprocessed_filter(
         cg::OperatorNodeBase& opr) {
     if (!mixin_allow_weight_preprocess(opr)) {
@@ -175,29 +297,48 @@ void mixin::WeightPreprocessExecutor::mixin_update_preprocessed_filter(
     if (m_preprocessed_filter) {
         for (size_t i = 0; i < new_size; i++) {
             mgb_assert(
-                    new_layout[i].eq_layout(m_preprocessed_filter->tensors[i].layout),
+                    new_layout[i].eq_layout(
+                            m_preprocessed_filter->filter.tensors[i].layout),
                     "weight preprocess layout changed, please keep input "
                     "shape unchanged when weight preprocess is enabled");
         }
         return;
     }
-    m_preprocessed_filter.reset(new PreprocessedFilter{});
-    m_preprocessed_filter->tensors.resize(new_size);
-    m_filter_storage.resize(new_size);
-    m_preprocessed_filter->algorithm_id = nullptr;
-    for (size_t i = 0; i < new_size; i++) {
-        m_filter_storage[i] = {
-                opr.output(0)->comp_node(), new_layout[i], new_layout[i].dtype,
-                new_layout[i].format};
-        m_preprocessed_filter->tensors[i] = m_filter_storage[i].as_megdnn();
+    auto make_storage = [&]() {
+        m_preprocessed_filter = std::make_shared<PreprocessedFilterStorage>();
+        auto&& filter = m_preprocessed_filter->filter;
+        auto&& storage = m_preprocessed_filter->tensors;
+        filter.tensors.resize(new_size);
+        storage.resize(new_size);
+        filter.algorithm_id = nullptr;
+        for (size_t i = 0; i < new_size; i++) {
+            storage[i] = {
+                    opr.output(0)->comp_node(), new_layout[i], new_layout[i].dtype,
+                    new_layout[i].format};
+            filter.tensors[i] = storage[i].as_megdnn();
+        }
+        scn_do_execute_preprocess();
+        return m_preprocessed_filter;
+    };
+    std::string key;
+    if (!make_shared_filter_key(opr, key)) {
+        make_storage();
+        return;
     }
-    scn_do_execute_preprocess();
+    auto&& cache = PreprocessedFilterCache::inst();
+    if (auto storage = cache.find(key)) {
+        //! reuse the filter preprocessed by another opr
+        m_preprocessed_filter = std::move(storage);
+        mark_preprocessed_input_no_need();
+        return;
+    }
+    //! preprocess outside of the cache lock, which is only taken to publish it
+    m_preprocessed_filter = cache.insert(key, make_storage());
 }
 
 void mixin::WeightPreprocessExecutor::record_preprocessed_weight(
         cg::GraphExecutable::ExecDependencyArray& deps) {
-    deps.emplace_back(new PreprocessedFilterExecDep{
-            std::move(m_preprocessed_filter), std::move(m_filter_storage)});
+    deps.emplace_back(new PreprocessedFilterExecDep{std::move(m_preprocessed_filter)});
 }
 
 bool mixin::WeightPreprocessExecutor::mixin_allow_weight_preprocess(
@@ -343,6 +484,15 @@ void ConvolutionForward::scn_do_execute_preprocess() {
             input(0)->layout(), input(1)->dev_tensor().as_megdnn(), output(0)->layout(),
             preprocessed_filter(),
             intl::get_megdnn_workspace_from_var(output().back()));
+    mark_preprocessed_input_no_need();
+}
+
+std::string ConvolutionForward::preprocess_config_key() {
+    return make_preprocess_config_key(
+            megdnn_opr()->param(), megdnn_opr()->execution_policy());
+}
+
+void ConvolutionForward::mark_preprocessed_input_no_need() {
     //! Flag the input(1) no use later, which can be freed when no other
     //! var depend on its dev_value, host_value and shape.
     auto receiver_info =
@@ -981,6 +1131,15 @@ void ConvBiasForward::scn_do_execute_preprocess() {
                 z_layout, output(0)->layout(), preprocessed_filter(),
                 intl::get_megdnn_workspace_from_var(output().back()));
     }
+    mark_preprocessed_input_no_need();
+}
+
+std::string ConvBiasForward::preprocess_config_key() {
+    return make_preprocess_config_key(
+            megdnn_opr()->param(), megdnn_opr()->execution_policy());
+}
+
+void ConvBiasForward::mark_preprocessed_input_no_need() {
     //! Flag the weight and bias no use later, which can be freed when no other
     //! var depend on its dev_value, host_value and shape.
     auto receiver_info_weight =
@@ -991,8 +1150,12 @@ void ConvBiasForward::scn_do_execute_preprocess() {
     }
     //! if bias is preprocessd
     if (input().size() > 2) {
+        TensorLayout z_layout(output(0)->dtype());
+        if (input().size() > 3) {
+            z_layout = input(3)->layout();
+        }
         auto preprocessed_layouts = megdnn_opr()->deduce_preprocessed_filter_layout(
-                input(0)->layout(), input(1)->layout(), bias_layout, z_layout,
+                input(0)->layout(), input(1)->layout(), input(2)->layout(), z_layout,
                 output(0)->layout());
         if (preprocessed_layouts.size() > 1 && !preprocessed_layouts[1].is_empty()) {
             auto receiver_info_bias =
@@ -1848,6 +2011,33 @@ MGB_IMPL_OPR_GRAD(RegionRestrictedConvolutionBackwardFilter) {
 }
 #endif
 
+/* ==================== DepthwisePointwiseConvBias  ==================== */
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(DepthwisePointwiseConvBias);
+
+DepthwisePointwiseConvBias::DepthwisePointwiseConvBias(
+        VarNode* src, VarNode* dw_filter, VarNode* dw_bias, VarNode* pw_filter,
+        VarNode* pw_bias, const Param& param, const OperatorNodeConfig& config)
+        : Super({src->owner_graph(),
+                 config,
+                 "depthwise_pointwise_conv_bias",
+                 {src, dw_filter, dw_bias, pw_filter, pw_bias}}) {
+    init_megdnn_opr(*this, param);
+    add_input({src, dw_filter, dw_bias, pw_filter, pw_bias});
+    intl::MegDNNOprInitPostCtor<DepthwisePointwiseConvBias>::apply(*this);
+}
+
+SymbolVar DepthwisePointwiseConvBias::make(
+        SymbolVar src, SymbolVar dw_filter, SymbolVar dw_bias, SymbolVar pw_filter,
+        SymbolVar pw_bias, const Param& param, const OperatorNodeConfig& config) {
+    return src.insert_single_output_opr<DepthwisePointwiseConvBias>(
+            src.node(), dw_filter.node(), dw_bias.node(), pw_filter.node(),
+            pw_bias.node(), param, config);
+}
+
+void DepthwisePointwiseConvBias::add_input_layout_constraint() {
+    mixin::megdnn_utils::add_input_layout_constraint_contig(*this);
+}
+
 #undef IMPL_CONV
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -509,6 +509,27 @@ struct OprMaker<opr::LayerNorm, 0> {
     }
 };
 
+template <>
+struct OprMaker<opr::ResidualLayerNorm, 0> {
+    using Param = opr::ResidualLayerNorm::Param;
+    static cg::OperatorNodeBase* make(
+            const Param& param, const cg::VarNodeArray& i, ComputingGraph& graph,
+            const OperatorNodeConfig& config) {
+        MGB_MARK_USED_VAR(graph);
+        if (i.size() == 4) {
+            return opr::ResidualLayerNorm::make(
+                           i[0], i[1], i[2], i[3], param, config)[0]
+                    .node()
+                    ->owner_opr();
+        } else {
+            mgb_assert(i.size() == 2);
+            return opr::ResidualLayerNorm::make(i[0], i[1], param, config)[0]
+                    .node()
+                    ->owner_opr();
+        }
+    }
+};
+
 // OprMaker in MGB_SEREG_OPR only support unique output opr
 template <>
 struct OprMaker<opr::LayerNormBackward, 0> {
@@ -1317,6 +1338,7 @@ MGB_SEREG_OPR(DeformablePSROIPoolingBackward, 5);
 
 using BatchConvBiasForwardV1 = BatchConvBiasForward;
 MGB_SEREG_OPR_AND_REG_SHALLOW_COPY(BatchConvBiasForwardV1, 0, opr_shallow_copy_conv);
+MGB_SEREG_OPR(DepthwisePointwiseConvBias, 5);
 MGB_SEREG_OPR(FakeQuant, 3);
 MGB_SEREG_OPR(FakeQuantBackward, 4);
 MGB_SEREG_OPR(TQT, 2);
@@ -1327,6 +1349,7 @@ MGB_SEREG_OPR_WITH_CONVERTER(
         LayerNorm, 0,
         (mgb::serialization::OprLoadDumpImpl<opr::LayerNorm, 0>::replace_opr));
 MGB_SEREG_OPR(LayerNormBackward, 0);
+MGB_SEREG_OPR(ResidualLayerNorm, 0);
 MGB_SEREG_OPR(GeneralNorm, 0);
 MGB_SEREG_OPR(GeneralNormBackward, 0);
 MGB_SEREG_OPR(RNNCellForward, 6);
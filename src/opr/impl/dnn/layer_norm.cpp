@@ -145,6 +145,113 @@ MGB_IMPL_OPR_GRAD(LayerNormForward) {
 }
 #endif
 
+/* ==================== ResidualLayerNormForward ==================== */
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(ResidualLayerNormForward);
+
+ResidualLayerNormForward::ResidualLayerNormForward(
+        VarNode* data, VarNode* residual, VarNode* weight, VarNode* bias,
+        const Param& param, const OperatorNodeConfig& config)
+        : Super{data->owner_graph(),
+                config,
+                "residual_layer_norm",
+                {data, residual, weight, bias}} {
+    init_megdnn_opr(*this, param);
+
+    add_input({data, residual, weight, bias});
+    output(0)->dtype(data->dtype());
+    output(1)->dtype(data->dtype());
+    output(2)->dtype(dtype::Float32());
+    output(3)->dtype(dtype::Float32());
+}
+
+ResidualLayerNormForward::ResidualLayerNormForward(
+        VarNode* data, VarNode* residual, const Param& param,
+        const OperatorNodeConfig& config)
+        : Super{data->owner_graph(), config, "residual_layer_norm", {data, residual}} {
+    init_megdnn_opr(*this, param);
+
+    add_input({data, residual});
+    output(0)->dtype(data->dtype());
+    output(1)->dtype(data->dtype());
+    output(2)->dtype(dtype::Float32());
+    output(3)->dtype(dtype::Float32());
+}
+
+SymbolVarArray ResidualLayerNormForward::make(
+        SymbolVar data, SymbolVar residual, SymbolVar weight, SymbolVar bias,
+        const Param& param, const OperatorNodeConfig& config) {
+    auto outs = data.node()
+                        ->owner_graph()
+                        ->insert_opr(std::make_unique<ResidualLayerNormForward>(
+                                data.node(), residual.node(), weight.node(),
+                                bias.node(), param, config))
+                        ->output();
+    SymbolVarArray ret;
+    for (auto&& out : outs) {
+        ret.emplace_back(out);
+    }
+    return ret;
+}
+
+SymbolVarArray ResidualLayerNormForward::make(
+        SymbolVar data, SymbolVar residual, const Param& param,
+        const OperatorNodeConfig& config) {
+    auto outs = data.node()
+                        ->owner_graph()
+                        ->insert_opr(std::make_unique<ResidualLayerNormForward>(
+                                data.node(), residual.node(), param, config))
+                        ->output();
+    SymbolVarArray ret;
+    for (auto&& out : outs) {
+        ret.emplace_back(out);
+    }
+    return ret;
+}
+
+void ResidualLayerNormForward::get_output_var_shape(
+        const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
+    mgb_assert(
+            inp_shape[0].eq_shape(inp_shape[1]),
+            "data and residual of residual_layer_norm should have the same shape: "
+            "%s vs %s",
+            inp_shape[0].to_string().c_str(), inp_shape[1].to_string().c_str());
+    uint64_t normalized_dim = param().normalized_dim;
+    out_shape[0] = inp_shape[0];
+    out_shape[1] = inp_shape[0];
+    TensorShape unnormalized_shape;
+    unnormalized_shape.ndim = inp_shape[0].ndim - normalized_dim;
+    for (size_t i = 0; i < unnormalized_shape.ndim; ++i) {
+        unnormalized_shape.shape[i] = inp_shape[0].shape[i];
+    }
+    out_shape[2] = unnormalized_shape;
+    out_shape[3] = unnormalized_shape;
+}
+
+size_t ResidualLayerNormForward::get_workspace_size_bytes(
+        const TensorShapeArray& input_shapes,
+        const TensorShapeArray& output_shapes) const {
+    return 0;
+}
+
+void ResidualLayerNormForward::scn_do_execute() {
+    if (param().affine) {
+        megdnn_opr()->exec(
+                input(0)->dev_tensor().as_megdnn(), input(1)->dev_tensor().as_megdnn(),
+                input(2)->dev_tensor().as_megdnn(), input(3)->dev_tensor().as_megdnn(),
+                output(0)->dev_tensor().as_megdnn(),
+                output(1)->dev_tensor().as_megdnn(),
+                output(2)->dev_tensor().as_megdnn(),
+                output(3)->dev_tensor().as_megdnn(), {});
+    } else {
+        megdnn_opr()->exec(
+                input(0)->dev_tensor().as_megdnn(), input(1)->dev_tensor().as_megdnn(),
+                {}, {}, output(0)->dev_tensor().as_megdnn(),
+                output(1)->dev_tensor().as_megdnn(),
+                output(2)->dev_tensor().as_megdnn(),
+                output(3)->dev_tensor().as_megdnn(), {});
+    }
+}
+
 /* ==================== LayerNormBackward ==================== */
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(LayerNormBackward);
 
@@ -789,4 +789,19 @@ SymbolVar DctChannelSelectForward::make(
 
 MEGDNN_OPR_INIT1(DctChannelSelectForward, "dct_channel_select")
 
+/* ======================= FusedPreprocess ======================= */
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(FusedPreprocess);
+MEGDNN_OPR_INIT2(FusedPreprocess, "fused_preprocess")
+
+void FusedPreprocess::init_output_dtype() {
+    output(0)->dtype(dtype::Float32());
+}
+
+void FusedPreprocess::add_input_layout_constraint() {
+    for (auto i : input()) {
+        i->add_layout_constraint_contiguous();
+    }
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -6,6 +6,9 @@
 #include "megbrain/opr/internal/megdnn_opr_wrapper.h"
 #include "megbrain/serialization/opr_load_dump.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace mgb;
 using namespace opr;
 
@@ -124,6 +127,7 @@ void intl::DeviceTensorHolder::init_output_mem_plan(bool dynamic) {
 }
 
 void intl::DeviceTensorHolder::scn_do_execute() {
+    prepare_dev_tensor();
     dv_helper::check_in_exec(get_dev_tensor(), output(0));
 }
 
@@ -160,6 +164,13 @@ public:
     }
 };
 
+struct Host2DeviceCopy::Staging {
+    HostTensorND buf[2];
+    std::unique_ptr<CompNode::Event> event[2];
+    //! execution i reads buf[i % 2], which is submitted by the i-th submit
+    std::atomic_size_t nr_submit{0}, nr_exec{0};
+};
+
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(Host2DeviceCopy);
 Host2DeviceCopy::Host2DeviceCopy(
         ComputingGraph& graph, const std::shared_ptr<HostTensorND>& host_data,
@@ -212,12 +223,71 @@ void Host2DeviceCopy::scn_do_execute() {
         if (m_host_data_dev_cont_need_sync)
             m_host_data_dev_cont.copy_from_fixlayout(*m_host_data);
         dv_helper::check_in_exec(get_dev_tensor_in_mem_fwd(), output(0));
+    } else if (m_staging) {
+        auto&& staging = *m_staging;
+        // the options may have been changed after enable_staging()
+        mgb_assert(
+                !owner_graph()->options().comp_node_seq_record_level &&
+                        !owner_graph()->options().lean_exec,
+                "staging of %s can not be recorded", cname());
+        size_t nr_exec = staging.nr_exec.load();
+        mgb_assert(
+                nr_exec < staging.nr_submit.load(),
+                "staging buffer of %s is not submitted", cname());
+        size_t idx = nr_exec % 2;
+        output(0)->dev_tensor().copy_from_fixlayout(staging.buf[idx]);
+        staging.event[idx]->record();
+        staging.nr_exec.store(nr_exec + 1);
     } else {
         auto&& od = output(0)->dev_tensor();
         od.copy_from_fixlayout(*m_host_data);
     }
 }
 
+void Host2DeviceCopy::enable_staging() {
+    mgb_assert(!m_fwd_host_mem, "host memory of %s is forwarded", cname());
+    auto&& options = owner_graph()->options();
+    mgb_assert(
+            !options.comp_node_seq_record_level && !options.lean_exec,
+            "staging can not be used with comp node seq record or lean exec");
+    if (m_staging) {
+        return;
+    }
+    m_staging = std::make_shared<Staging>();
+    for (int i = 0; i < 2; ++i) {
+        m_staging->buf[i]
+                .comp_node(comp_node())
+                .dtype(m_host_data->dtype())
+                .resize(m_host_data->shape());
+        m_staging->event[i] = comp_node().create_event();
+    }
+}
+
+HostTensorND& Host2DeviceCopy::staging_buffer() {
+    mgb_assert(m_staging, "staging of %s is not enabled", cname());
+    auto&& staging = *m_staging;
+    size_t nr_submit = staging.nr_submit.load();
+    size_t idx = nr_submit % 2;
+    if (nr_submit >= 2) {
+        // wait for the execution which reads this buffer to be dispatched, and
+        // then for its copy to finish
+        while (staging.nr_exec.load() + 2 <= nr_submit) {
+            std::this_thread::yield();
+        }
+        staging.event[idx]->host_wait();
+    }
+    return staging.buf[idx];
+}
+
+void Host2DeviceCopy::submit_staging_buffer() {
+    mgb_assert(m_staging, "staging of %s is not enabled", cname());
+    auto&& staging = *m_staging;
+    size_t nr_submit = staging.nr_submit.load();
+    // the shape and value are inferred from m_host_data
+    *m_host_data = staging.buf[nr_submit % 2];
+    staging.nr_submit.store(nr_submit + 1);
+}
+
 void Host2DeviceCopy::init_output_mem_plan(bool dynamic) {
     if (m_fwd_host_mem) {
         dv_helper::init_output_mem_plan(get_dev_tensor_in_mem_fwd(), *this, dynamic);
@@ -293,6 +363,34 @@ void intl::SharedDeviceTensorBase::init_output_comp_node() {
     comp_node(m_dev_data->comp_node());
 }
 
+void intl::SharedDeviceTensorBase::prepare_dev_tensor() {
+    if (m_lazy_value) {
+        m_lazy_value->apply(*m_dev_data);
+    }
+}
+
+const std::shared_ptr<DeviceTensorND>& intl::SharedDeviceTensorBase::dev_data() const {
+    if (m_lazy_value) {
+        m_lazy_value->apply(*m_dev_data);
+    }
+    return m_dev_data;
+}
+
+void intl::SharedDeviceTensorBase::LazyValue::apply(DeviceTensorND& dest) {
+    MGB_LOCK_GUARD(m_mtx);
+    if (!m_applied) {
+        dest.copy_from_fixlayout(m_value);
+        m_applied = true;
+        // the copy may still read the host value, so it is released by a
+        // callback on the stream; it is kept on devices without callbacks
+        auto cn = dest.comp_node();
+        if (cn.device_type() == CompNode::DeviceType::CUDA) {
+            cn.add_callback([value = std::move(m_value)]() {});
+            m_value = {};
+        }
+    }
+}
+
 cg::static_infer::SourceType SharedDeviceTensor::static_infer_src_type() const {
     return cg::static_infer::SourceType::CONSTANT;
 }
@@ -402,6 +402,10 @@ cg::OperatorNodeBase::NodeProp* Loop::do_make_node_prop() const {
                     break;
                 case DTypeEnum::Complex64:
                     break;
+                case DTypeEnum::Float8E4M3:
+                    break;
+                case DTypeEnum::Float8E5M2:
+                    break;
 
 #define cb(x)          \
     case DTypeEnum::x: \
@@ -237,6 +237,10 @@ public:
                 break;
             case DTypeEnum::Complex64:
                 break;
+            case DTypeEnum::Float8E4M3:
+                break;
+            case DTypeEnum::Float8E5M2:
+                break;
 #define cb(_dt)          \
     case DTypeEnum::_dt: \
         break;
@@ -122,6 +122,11 @@ class OutputRecorderAll final : public OutputRecorderBase {
     VarNode *m_src_var, *m_dest_var;
     TensorShape m_element_shape;
 
+    //! layout of an element slot in the output and the stride between slots,
+    //! computed at the first iteration of each exec
+    TensorLayout m_slot_layout;
+    ptrdiff_t m_slot_stride;
+
     void bind_var(VarNode* var_sub, VarNode* var_out) override {
         m_src_var = var_sub;
         m_dest_var = var_out;
@@ -174,10 +179,15 @@ class OutputRecorderAll final : public OutputRecorderBase {
             grow_output_storage(val.shape());
 
         auto&& dest = m_dest_var->dev_tensor();
-        auto subs = Slice(m_used_size, m_used_size + 1).apply(dest.layout(), 0);
-        subs = SubTensorSpec::make_from_offset_elem(
-                subs.layout().remove_axis(0), subs.offset_elem());
-        dest.sub(subs).copy_from_fixlayout(val);
+        if (!m_used_size) {
+            // growing the storage only changes shape[0], so the slot layout
+            // is kept for the whole exec
+            m_slot_layout = dest.layout().remove_axis(0);
+            m_slot_stride = dest.layout().stride[0];
+        }
+        dest.sub(SubTensorSpec::make_from_offset_elem(
+                         m_slot_layout, m_used_size * m_slot_stride))
+                .copy_from_fixlayout(val);
         m_used_size++;
     }
 
@@ -192,6 +192,7 @@ template class RNGOprBase<::megdnn::PermutationRNG>;
 template class RNGOprBase<::megdnn::BetaRNG>;
 template class RNGOprBase<::megdnn::PoissonRNG>;
 template class RNGOprBase<::megdnn::MultinomialRNG>;
+template class RNGOprBase<::megdnn::LogitsSamplingRNG>;
 template class RNGOprBase<::megdnn::ShuffleRNGForward>;
 template class RNGOprBase<::megdnn::ShuffleRNGBackward>;
 template class RNGOprBase<::megdnn::ExponentialRNG>;
@@ -205,6 +206,7 @@ IMPL(UniformRNG);
 IMPL(GammaRNG);
 IMPL(PoissonRNG);
 IMPL(MultinomialRNG);
+IMPL(LogitsSamplingRNG);
 IMPL(PermutationRNG);
 IMPL(BetaRNG);
 IMPL(ExponentialRNG);
@@ -281,6 +283,76 @@ cg::OperatorNodeBase::NodeProp* MultinomialRNG::do_make_node_prop() const {
     return prop;
 }
 
+/* ================= LogitsSamplingRNG =================  */
+
+MGB_DYN_TYPE_OBJ_FINAL_IMPL(LogitsSamplingRNG);
+
+LogitsSamplingRNG::LogitsSamplingRNG(
+        VarNode* logits, const Param& param, const OperatorNodeConfig& config)
+        : Super({logits->owner_graph(), config, "logits_sampling_rng", {logits}},
+                param) {
+    add_input({logits});
+    add_output(None)->dtype(dtype::Int32()).add_flag(VarNode::Flag::ALLOW_EMPTY_SHAPE);
+    cg::add_workspace_output(this);
+    add_equivalence_component<ScalarHash<void*>>(this);
+}
+
+SymbolVar LogitsSamplingRNG::make(
+        SymbolVar logits, const Param& param, const OperatorNodeConfig& config) {
+    return logits.insert_single_output_opr<LogitsSamplingRNG>(
+            logits.node(), param, config);
+}
+
+void LogitsSamplingRNG::init_output_static_infer_desc() {
+    using namespace cg::static_infer;
+    auto&& mgr = owner_graph()->static_infer_manager();
+
+    auto infer_oshp = [this](TensorShape& dest, const InpVal& iv) {
+        ensure_megdnn_opr();
+        TensorLayout o0;
+        m_dnn_opr->deduce_layout({iv.val[0].shape(), input(0)->dtype()}, o0);
+        dest = o0;
+        return true;
+    };
+    mgr.register_shape_infer(
+            output(0), {SourceType::DEP, {{input(0), DepType::SHAPE}}, infer_oshp});
+
+    auto infer_wk = [this](TensorShape& dest, const InpVal& inp) {
+        ensure_megdnn_opr();
+        dest.ndim = 1;
+        dest.shape[0] = m_dnn_opr->get_workspace_in_bytes(
+                {inp.val.at(0).shape(), input(0)->dtype()},
+                {output(0)->shape(), output(0)->dtype()});
+        return true;
+    };
+    mgr.register_shape_infer(
+            output(1), {SourceType::DEP, {{input(0), DepType::SHAPE}}, infer_wk});
+}
+
+void LogitsSamplingRNG::add_input_layout_constraint() {
+    input(0)->add_layout_constraint_contiguous();
+};
+
+void LogitsSamplingRNG::scn_do_execute() {
+    auto&& ret = output(0);
+    if (ret->layout().is_empty()) {
+        mgb_assert(ret->dev_tensor().empty());
+        return;
+    }
+    m_dnn_opr->exec(
+            input(0)->dev_tensor().as_megdnn(), output(0)->dev_tensor().as_megdnn(),
+            get_megdnn_workspace_from_var(output(1)));
+}
+
+cg::OperatorNodeBase::NodeProp* LogitsSamplingRNG::do_make_node_prop() const {
+    auto prop = Super::do_make_node_prop();
+    prop->add_flag(NodeProp::Flag::IMPURE_FUNC);
+    for (auto i : input()) {
+        prop->add_dep_type_existing_var(i, NodeProp::DepType::VALUE_ALLOW_EMPTY);
+    }
+    return prop;
+}
+
 /* ================= ShuffleRNGForward =================  */
 
 MGB_DYN_TYPE_OBJ_FINAL_IMPL(ShuffleRNGForward);
@@ -144,6 +144,7 @@ MGB_SEREG_OPR(PoissonRNG, 1);
 MGB_SEREG_OPR(PermutationRNG, 1);
 MGB_SEREG_OPR(BetaRNG, 2);
 MGB_SEREG_OPR(MultinomialRNG, 1);
+MGB_SEREG_OPR(LogitsSamplingRNG, 1);
 MGB_SEREG_OPR(ShuffleRNG, 1);
 MGB_SEREG_OPR(ShuffleRNGBackward, 3);
 MGB_SEREG_OPR(ExponentialRNG, 1);
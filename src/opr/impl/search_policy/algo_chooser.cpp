@@ -25,7 +25,8 @@ size_t AlgoChooser<Opr>::setup_algo(
     AlgorithmCache::Key cache_key(
             megdnn_opr->handle(), megdnn_opr->get_opr_type(), layouts.data(),
             layouts.size(), &megdnn_opr->param(), sizeof(megdnn_opr->param()));
-    auto rst = AlgorithmCache::instance().get(cache_key);
+    auto rst = AlgorithmCache::instance().get(
+            cache_key, megdnn_opr->algo_cache_last_entry());
     if (rst.policy.algo.valid()) {
         megdnn_opr->execution_policy() = rst.policy;
         return rst.workspace;
@@ -46,6 +47,7 @@ size_t AlgoChooser<Opr>::setup_algo(
     desc.binary_equal_between_batch =
             cg->options().fast_run_config.binary_equal_between_batch;
     desc.no_profiling_on_shape_change = cg->options().no_profiling_on_shape_change;
+    desc.async_profile = cg->options().fast_run_config.async_profile;
     desc.get_workspace_limit = [&](CompNode cn, size_t old_limit) {
         return WorkspaceLimitGetter::get_workspace_limit(cg, cn, old_limit);
     };
@@ -88,6 +90,11 @@ size_t AlgoChooser<Opr>::setup_algo(
 
     megdnn_opr->execution_policy() = policy;
 
+    //! the heuristic algo is not cached while profiling in background, so
+    //! the profiled one is taken on the next setup
+    if (Base::is_profiling_async(helper)) {
+        return workspace;
+    }
     AlgorithmCache::Result cache_result{policy, workspace, buf, param_buf};
     AlgorithmCache::instance().put(cache_key, cache_result);
     return workspace;
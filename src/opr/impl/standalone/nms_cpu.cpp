@@ -8,23 +8,60 @@ struct Box {
     float x0, y0, x1, y1;
 };
 
-bool box_iou(Box a, Box b, float thresh) {
-    using std::max;
-    using std::min;
-    float left = max(a.x0, b.x0), right = min(a.x1, b.x1);
-    float top = max(a.y0, b.y0), bottom = min(a.y1, b.y1);
-    float width = max(right - left, 0.f), height = max(bottom - top, 0.f);
-    float interS = width * height;
-    float Sa = (a.x1 - a.x0) * (a.y1 - a.y0);
-    float Sb = (b.x1 - b.x0) * (b.y1 - b.y0);
-    return interS > (Sa + Sb - interS) * thresh;
-}
+//! kept boxes are checked in blocks, so the inner loop has no branches
+constexpr size_t KEPT_BLOCK = 8;
+
+//! the kept boxes in SoA layout, so the IoU of a block can be vectorized
+struct KeptBoxes {
+    float *x0, *y0, *x1, *y1, *area;
+    size_t size = 0;
+
+    KeptBoxes(void* workspace, size_t nr_boxes) {
+        auto ptr = static_cast<float*>(workspace);
+        x0 = ptr;
+        y0 = ptr + nr_boxes;
+        x1 = ptr + nr_boxes * 2;
+        y1 = ptr + nr_boxes * 3;
+        area = ptr + nr_boxes * 4;
+    }
+
+    void add(Box b) {
+        x0[size] = b.x0;
+        y0[size] = b.y0;
+        x1[size] = b.x1;
+        y1[size] = b.y1;
+        area[size] = (b.x1 - b.x0) * (b.y1 - b.y0);
+        ++size;
+    }
+
+    //! whether the IoU of b and any kept box in [begin, end) exceeds thresh
+    bool overlap(Box b, float area_b, size_t begin, size_t end, float thresh) const {
+        using std::max;
+        using std::min;
+        bool ret = false;
+        for (size_t j = begin; j < end; ++j) {
+            float left = max(x0[j], b.x0), right = min(x1[j], b.x1);
+            float top = max(y0[j], b.y0), bottom = min(y1[j], b.y1);
+            float width = max(right - left, 0.f), height = max(bottom - top, 0.f);
+            float interS = width * height;
+            ret |= interS > (area_b + area[j] - interS) * thresh;
+        }
+        return ret;
+    }
+
+    bool suppress(Box b, float thresh) const {
+        float area_b = (b.x1 - b.x0) * (b.y1 - b.y0);
+        for (size_t begin = 0; begin < size; begin += KEPT_BLOCK) {
+            if (overlap(b, area_b, begin, std::min(begin + KEPT_BLOCK, size), thresh))
+                return true;
+        }
+        return false;
+    }
+};
 }  // anonymous namespace
 
 size_t mgb::opr::standalone::nms::cpu_kern_workspace(size_t nr_boxes) {
-    if (nr_boxes == 0)
-        return 0;
-    return (((nr_boxes - 1) / sizeof(size_t)) + 1) * sizeof(size_t);
+    return nr_boxes * 5 * sizeof(float);
 }
 
 void mgb::opr::standalone::nms::cpu_kern(
@@ -32,24 +69,13 @@ void mgb::opr::standalone::nms::cpu_kern(
         uint32_t* out_idx, uint32_t* out_size, void* workspace) {
     size_t out_pos = 0, last_out = 0;
     auto boxes_bptr = reinterpret_cast<const Box*>(boxes);
-    auto kept_mask = static_cast<size_t*>(workspace);
-    memset(kept_mask, 0, cpu_kern_workspace(nr_boxes));
-    for (size_t i = 0; i < nr_boxes; ++i) {
-        bool supressed = false;
+    KeptBoxes kept{workspace, nr_boxes};
+    for (size_t i = 0; i < nr_boxes && out_pos < max_output; ++i) {
         auto ibox = boxes_bptr[i];
-        for (size_t j = 0; j < i; ++j) {
-            bool j_kept = (kept_mask[j / sizeof(size_t)] >> (j % sizeof(size_t))) & 1;
-            if (j_kept && box_iou(ibox, boxes_bptr[j], overlap_thresh)) {
-                supressed = true;
-                break;
-            }
-        }
-        if (!supressed) {
-            kept_mask[i / sizeof(size_t)] |= size_t(1) << (i % sizeof(size_t));
+        if (!kept.suppress(ibox, overlap_thresh)) {
+            kept.add(ibox);
             last_out = i;
             out_idx[out_pos++] = i;
-            if (out_pos == max_output)
-                break;
         }
     }
     *out_size = out_pos;
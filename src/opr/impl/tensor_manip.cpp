@@ -1297,8 +1297,30 @@ void Concat::scn_do_execute() {
             real_axis += in.shape().ndim;
         end = begin + in.shape().shape[real_axis];
         if (!in.layout().is_empty()) {
-            out.sub(Slice(begin, end).apply(out.layout(), real_axis))
-                    .copy_from_fixlayout(in);
+            auto dest = out.sub(Slice(begin, end).apply(out.layout(), real_axis));
+            // skip the inputs written into the output by their producers
+            if (dest.raw_ptr() != in.raw_ptr() ||
+                !dest.layout().eq_layout(in.layout())) {
+                dest.copy_from_fixlayout(in);
+            }
+        }
+    }
+}
+
+void Concat::mem_plan_fwd_in2out_writable() {
+    auto out = output(0);
+    auto real_axis = m_axis;
+    if (real_axis < 0)
+        real_axis += out->shape().ndim;
+    ThinHashSet<VarNode*> visited;
+    size_t end = 0;
+    for (auto input : this->input()) {
+        auto begin = end;
+        end = begin + input->shape().shape[real_axis];
+        // a var concatenated more than once can not be in both slices
+        if (visited.insert(input).second && !input->shape().is_empty()) {
+            out->set_fwd_out2in_slice(
+                    input, Slice(begin, end).apply(out->layout(), real_axis));
         }
     }
 }
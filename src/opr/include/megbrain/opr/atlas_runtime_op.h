@@ -61,12 +61,36 @@ private:
     //! if set true, it will release model
     bool m_is_model_holder = false;
     SmallVector<AippInputFormat> m_aipp_input_format;
-    //! Atlas need a 64bit device tensor to hold dynamic batch state
+    //! Atlas need a 64bit device tensor to hold dynamic batch or image size state
     DeviceTensorND m_dyn_batch_tensor;
     SmallVector<size_t> m_dyn_batch_choices;
+    //! (height, width) gears of the dynamic image size
+    SmallVector<std::pair<size_t, size_t>> m_dyn_hw_choices;
     //! Used when the input batch is static and the output batch is dynamic. Different
     //! from the case where the input batch is dynamic and the output batch is dynamic
     mutable SmallVector<bool> m_dyn_batch_output;
+
+    /*!
+     * \brief resources of an execution launched by aclmdlExecuteAsync
+     *
+     * They must be kept until the execution finishes, which is checked by the
+     * event recorded after it, so that the opr returns without waiting for the
+     * device and the following oprs on other comp nodes overlap with it.
+     */
+    struct PendingExec {
+        aclmdlDataset* inputs = nullptr;
+        aclmdlDataset* outputs = nullptr;
+        SmallVector<aclTensorDesc*> tensor_descs;
+        aclrtEvent event = nullptr;
+    };
+    SmallVector<PendingExec> m_pending_execs;
+
+    bool dyn_input() const {
+        return !m_dyn_batch_choices.empty() || !m_dyn_hw_choices.empty();
+    }
+    //! wait for the pending executions and release their resources
+    void release_pending_execs();
+    static void release_exec(PendingExec& exec);
 };
 
 }  // namespace opr
@@ -135,6 +135,44 @@ private:
     void add_input_layout_constraint() override;
 };
 
+/*!
+ * \brief C = A * dequant(B)^T, with B an (n, k) Int8 or QuantizedS4 weight
+ *      and scales of shape (n, k / group_size)
+ */
+MGB_DEFINE_OPR_CLASS(
+        WeightOnlyQuantMatrixMul,
+        intl::MegDNNOprWrapperFwd<megdnn::WeightOnlyQuantMatrixMul>) // {
+public:
+    MGE_WIN_DECLSPEC_FUC WeightOnlyQuantMatrixMul(
+            VarNode* A, VarNode* B, VarNode* scales, const Param& param,
+            const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar A, SymbolVar B, SymbolVar scales, const Param& param = {},
+            const OperatorNodeConfig& config = {});
+
+private:
+    void add_input_layout_constraint() override;
+};
+
+/*!
+ * \brief C = A * B^T, with B an (n, k) N:M structured sparse weight stored as
+ *      its kept values and their positions in each group
+ */
+MGB_DEFINE_OPR_CLASS(
+        StructuredSparseMatrixMul,
+        intl::MegDNNOprWrapperFwd<megdnn::StructuredSparseMatrixMul>) // {
+public:
+    MGE_WIN_DECLSPEC_FUC StructuredSparseMatrixMul(
+            VarNode* A, VarNode* values, VarNode* indices, const Param& param,
+            const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar A, SymbolVar values, SymbolVar indices, const Param& param = {},
+            const OperatorNodeConfig& config = {});
+
+private:
+    void add_input_layout_constraint() override;
+};
+
 }  // namespace opr
 }  // namespace mgb
 
@@ -28,6 +28,9 @@ MGB_DEFINE_OPR_CLASS(CustomOpNode, cg::OperatorNodeBase) // {
     custom::Param m_param;
     CompNode m_comp_node;
     TensorShapeArray m_out_shape;
+    //! whether each output declared by CustomOp::set_forward shares the memory
+    //! of its input
+    std::vector<bool> m_rofwd_success;
 
     void infer_output_comp_node(void);
     void infer_output_dtype(void);
@@ -54,12 +57,15 @@ MGB_DEFINE_OPR_CLASS(CustomOpNode, cg::OperatorNodeBase) // {
     // [TODO] only contiguous input is supported
     void add_input_layout_constraint() override final;
 
-    // [TODO] ignore it for now
+    // forward the outputs declared by CustomOp::set_forward
     void mem_plan_fwd_in2out_readonly() override final;
 
-    // [TODO] ignore it for now
+    // reuse the inputs declared by CustomOp::set_inplace
     void mem_plan_fwd_in2out_writable() override final;
 
+    //! the layout of input to be forwarded to given output
+    TensorLayout rofwd_layout(size_t out_idx) const;
+
     // [TODO] return default ctor obj
     OprEventCallback get_opr_event_callback() override final;
 
@@ -26,10 +26,20 @@ protected:
 
 class WeightPreprocessExecutor : public cg::OperatorNodeMixinBase {
     class PreprocessedFilterExecDep;
+    class PreprocessedFilterCache;
 
     using PreprocessedFilter = megdnn::detail::PreprocessedFilter;
-    std::unique_ptr<PreprocessedFilter> m_preprocessed_filter;
-    SmallVector<DeviceTensorND> m_filter_storage;
+    //! preprocessed filter together with the device tensors holding it, it
+    //! may be shared by oprs in different graphs, see
+    //! ComputingGraph::Options::share_preprocessed_weight
+    struct PreprocessedFilterStorage {
+        PreprocessedFilter filter;
+        SmallVector<DeviceTensorND> tensors;
+    };
+    std::shared_ptr<PreprocessedFilterStorage> m_preprocessed_filter;
+
+    //! key of the shared filter cache, return false if it can not be shared
+    bool make_shared_filter_key(const OperatorNodeBase& opr, std::string& key);
 
 protected:
     //! this should only be called in scn_do_execute or similar functions (i.e.
@@ -37,12 +47,17 @@ protected:
     void mixin_update_preprocessed_filter(OperatorNodeBase& opr);
     void record_preprocessed_weight(cg::GraphExecutable::ExecDependencyArray& deps);
     PreprocessedFilter* preprocessed_filter() const {
-        return m_preprocessed_filter.get();
+        return m_preprocessed_filter ? &m_preprocessed_filter->filter : nullptr;
     }
 
     bool mixin_allow_weight_preprocess(const OperatorNodeBase& opr) const;
     virtual SmallVector<TensorLayout> deduce_preprocessed_filter_layout() = 0;
     virtual void scn_do_execute_preprocess() = 0;
+    //! flag the preprocessed inputs MEMORY_NO_NEED if nothing else reads them
+    virtual void mark_preprocessed_input_no_need() = 0;
+    //! serialized megdnn param and execution policy, part of the key of
+    //! shared preprocessed filters
+    virtual std::string preprocess_config_key() = 0;
     virtual ~WeightPreprocessExecutor() = default;
 };
 
@@ -180,6 +195,8 @@ MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
     void record_execute_deps(cg::GraphExecutable::ExecDependencyArray& deps) override;
     SmallVector<TensorLayout> deduce_preprocessed_filter_layout() override;
     void scn_do_execute_preprocess() override;
+    void mark_preprocessed_input_no_need() override;
+    std::string preprocess_config_key() override;
     NodeProp* do_make_node_prop() const override;
 
     friend testing::ConvolutionTestingPeer;
@@ -215,6 +232,8 @@ MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
     }
     SmallVector<TensorLayout> deduce_preprocessed_filter_layout() override;
     void scn_do_execute_preprocess() override;
+    void mark_preprocessed_input_no_need() override;
+    std::string preprocess_config_key() override;
 
 public:
     //! src * filter
@@ -610,6 +629,28 @@ public:
 };
 using BatchConvBias = BatchConvBiasForward;
 
+/*!
+ * \brief channel wise conv_bias followed by a 1x1 conv_bias in NCHW44, without
+ *      writing the intermediate tensor
+ *
+ * Created by gopt::FuseDepthwisePointwiseConvBiasPass.
+ */
+MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
+        DepthwisePointwiseConvBias,
+        intl::MegDNNOprWrapperFwd<megdnn::DepthwisePointwiseConvBias>) // {
+public:
+    MGE_WIN_DECLSPEC_FUC DepthwisePointwiseConvBias(
+            VarNode* src, VarNode* dw_filter, VarNode* dw_bias, VarNode* pw_filter,
+            VarNode* pw_bias, const Param& param, const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar src, SymbolVar dw_filter, SymbolVar dw_bias, SymbolVar pw_filter,
+            SymbolVar pw_bias, const Param& param = {},
+            const OperatorNodeConfig& config = {});
+
+private:
+    void add_input_layout_constraint() override;
+};
+
 }  // namespace opr
 }  // namespace mgb
 
@@ -34,6 +34,42 @@ private:
 };
 using LayerNorm = LayerNormForward;
 
+/*!
+ * \brief layer norm of data + residual, whose outputs are dst, sum, mean and
+ *      rstd
+ *
+ * It is produced by the FuseResidualLayerNormPass for inference, so no grad is
+ * defined.
+ */
+MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
+        ResidualLayerNormForward,
+        intl::MegDNNOprWrapperFwd<megdnn::ResidualLayerNormForward>) // {
+public:
+    MGE_WIN_DECLSPEC_FUC ResidualLayerNormForward(
+            VarNode* data, VarNode* residual, VarNode* weight, VarNode* bias,
+            const Param& param, const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC ResidualLayerNormForward(
+            VarNode* data, VarNode* residual, const Param& param,
+            const OperatorNodeConfig& config);
+
+    MGE_WIN_DECLSPEC_FUC static SymbolVarArray make(
+            SymbolVar data, SymbolVar residual, SymbolVar weight, SymbolVar bias,
+            const Param& param = {}, const OperatorNodeConfig& config = {});
+    MGE_WIN_DECLSPEC_FUC static SymbolVarArray make(
+            SymbolVar data, SymbolVar residual, const Param& param = {},
+            const OperatorNodeConfig& config = {});
+
+private:
+    void get_output_var_shape(
+            const TensorShapeArray& inp_shape,
+            TensorShapeArray& out_shape) const override;
+    size_t get_workspace_size_bytes(
+            const TensorShapeArray& input_shapes,
+            const TensorShapeArray& output_shapes) const override;
+    void scn_do_execute() override;
+};
+using ResidualLayerNorm = ResidualLayerNormForward;
+
 MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
         LayerNormBackward, intl::MegDNNOprWrapperBwd<megdnn::LayerNormBackward>) // {
 public:
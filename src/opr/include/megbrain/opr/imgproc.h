@@ -369,6 +369,27 @@ public:
 
 using DctChannelSelect = DctChannelSelectForward;
 
+/*!
+ * \brief reorder channels, resize, normalize and convert the layout of uint8
+ *      NHWC images into a float32 network input in one pass
+ *
+ * See megdnn::FusedPreprocess for the meaning of the inputs.
+ */
+MGB_DEFINE_OPR_CLASS(
+        FusedPreprocess, intl::MegDNNOprWrapperFwd<megdnn::FusedPreprocess>) // {
+public:
+    MGE_WIN_DECLSPEC_FUC FusedPreprocess(
+            VarNode* src, VarNode* norm, const Param& param,
+            const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar src, SymbolVar norm, const Param& param = {},
+            const OperatorNodeConfig& config = {});
+
+private:
+    void init_output_dtype() override;
+    void add_input_layout_constraint() override;
+};
+
 }  // namespace opr
 }  // namespace mgb
 
@@ -51,6 +51,8 @@ protected:
     using HostIONodeBase::HostIONodeBase;
 
     virtual const DeviceTensorND& get_dev_tensor() const = 0;
+    //! called before the value is forwarded to the output in each execution
+    virtual void prepare_dev_tensor() {}
     void add_output(DType dtype);
 };
 
@@ -64,7 +66,12 @@ protected:
  *    classes rather than add meta-parameters.
  */
 MGB_DEFINE_CLS_WITH_SUPER(SharedDeviceTensorBase, DeviceTensorHolder) // {
+public:
+    class LazyValue;
+
+private:
     std::shared_ptr<DeviceTensorND> m_dev_data;
+    std::shared_ptr<LazyValue> m_lazy_value;
     bool m_const_value;
 
     MGE_WIN_DECLSPEC_FUC const TensorShape& get_output_shape() override;
@@ -75,6 +82,7 @@ MGB_DEFINE_CLS_WITH_SUPER(SharedDeviceTensorBase, DeviceTensorHolder) // {
     }
 
     MGE_WIN_DECLSPEC_FUC void init_output_comp_node() override;
+    MGE_WIN_DECLSPEC_FUC void prepare_dev_tensor() override;
 
 public:
     //! const_value marks whether the device value of this operator should
@@ -84,16 +92,52 @@ public:
             ComputingGraph& graph, const std::shared_ptr<DeviceTensorND>& dev_data,
             bool const_value, const OperatorNodeConfig& config);
 
-    const DeviceTensorND& get_dev_tensor() const override { return *m_dev_data; }
+    //! the value is copied from the lazy value first if it has not been
+    const DeviceTensorND& get_dev_tensor() const override { return *dev_data(); }
 
     void free_dev_data() {
         m_dev_data->reset(
                 DeviceTensorStorage{m_dev_data->comp_node()}, m_dev_data->layout());
     }
 
-    const std::shared_ptr<DeviceTensorND>& dev_data() const { return m_dev_data; }
+    //! the value is copied from the lazy value first if it has not been
+    MGE_WIN_DECLSPEC_FUC const std::shared_ptr<DeviceTensorND>& dev_data() const;
 
     bool const_value() const { return m_const_value; }
+
+    /*!
+     * \brief set a host value to be copied to dev_data on the first use
+     *
+     * The copy is issued before the first execution of this operator or the
+     * first call of dev_data(), so the device value can be left uninitialized
+     * when the operator is created. It is used by the graph loader to avoid
+     * waiting for the copies of all the params at load time.
+     */
+    void set_lazy_value(std::shared_ptr<LazyValue> value) {
+        m_lazy_value = std::move(value);
+    }
+};
+
+/*!
+ * \brief a host value to be copied to a device tensor of SharedDeviceTensorBase
+ *
+ * A lazy value can be shared by multiple operators holding the same device
+ * tensor, and the copy is only issued once.
+ */
+class SharedDeviceTensorBase::LazyValue {
+    std::mutex m_mtx;
+    bool m_applied = false;
+    HostTensorND m_value;
+
+public:
+    explicit LazyValue(HostTensorND value) : m_value{std::move(value)} {}
+
+    /*!
+     * \brief copy the value to \p dest if it has not been copied
+     *
+     * The host value is released after the copy finishes on the device.
+     */
+    MGE_WIN_DECLSPEC_FUC void apply(DeviceTensorND& dest);
 };
 
 /*!
@@ -204,13 +248,47 @@ public:
 
     const Param& param() const { return m_param; }
 
+    /*!
+     * \brief let this opr own two pinned host buffers to stage the input
+     *
+     * The buffers are allocated on the output comp node, so the copy to the
+     * device does not block. After enabled, the input of each execution must
+     * be written into staging_buffer() and then submitted by
+     * submit_staging_buffer(). Since the two buffers are used alternately, the
+     * input of the next execution can be written while the current one is
+     * running.
+     *
+     * It can not be used if the host memory is forwarded, or if the comp node
+     * seq is recorded (by comp_node_seq_record_level or lean_exec).
+     */
+    MGE_WIN_DECLSPEC_FUC void enable_staging();
+
+    /*!
+     * \brief get the host buffer to be written for the next execution
+     *
+     * It waits until the buffer is no longer read by the execution before the
+     * current one. The buffer can be resized.
+     */
+    MGE_WIN_DECLSPEC_FUC HostTensorND& staging_buffer();
+
+    /*!
+     * \brief use the buffer returned by staging_buffer() as the input of the
+     *      next execution
+     *
+     * host_data() would share the storage of the buffer.
+     */
+    MGE_WIN_DECLSPEC_FUC void submit_staging_buffer();
+
     void record_execute_deps(ExecDependencyArray& deps) override;
 
 private:
+    struct Staging;
+
     //! whether to forward memory in HostTensorND; used on CPU
     bool m_fwd_host_mem;
     const Param m_param;
     std::shared_ptr<HostTensorND> m_host_data;
+    std::shared_ptr<Staging> m_staging;
 
     //! whether need to sync  to m_host_data_dev_cont in next exec
     mutable bool m_host_data_dev_cont_need_sync = false;
@@ -105,6 +105,21 @@ public:
     void scn_do_execute() override;
 };
 
+MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
+        LogitsSamplingRNG, RNGOprBase<megdnn::LogitsSamplingRNG>) // {
+    void add_input_layout_constraint() override;
+    cg::OperatorNodeBase::NodeProp* do_make_node_prop() const override;
+
+public:
+    LogitsSamplingRNG(
+            VarNode* logits, const Param& param, const OperatorNodeConfig& config);
+    MGE_WIN_DECLSPEC_FUC static SymbolVar make(
+            SymbolVar logits, const Param& param = {},
+            const OperatorNodeConfig& config = {});
+    void init_output_static_infer_desc() override;
+    void scn_do_execute() override;
+};
+
 MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
         MultiHeadAttnForward, RNGOprBase<megdnn::MultiHeadAttnForward>) // {
     void add_input_layout_constraint() override;
@@ -156,6 +171,7 @@ using PermutationRNG = intl::PermutationRNG;
 using PoissonRNG = intl::PoissonRNG;
 using BetaRNG = intl::BetaRNG;
 using MultinomialRNG = intl::MultinomialRNG;
+using LogitsSamplingRNG = intl::LogitsSamplingRNG;
 using ShuffleRNG = intl::ShuffleRNGForward;
 using ExponentialRNG = intl::ExponentialRNG;
 using Dropout = intl::DropoutForward;
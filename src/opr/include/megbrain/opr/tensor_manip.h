@@ -502,6 +502,7 @@ private:
     MGE_WIN_DECLSPEC_FUC void init_output_static_infer_desc() override;
     MGE_WIN_DECLSPEC_FUC void add_input_layout_constraint() override;
     MGE_WIN_DECLSPEC_FUC void init_output_comp_node() override;
+    MGE_WIN_DECLSPEC_FUC void mem_plan_fwd_in2out_writable() override;
 
     MGE_WIN_DECLSPEC_FUC void get_output_var_shape(
             const TensorShapeArray& inp_shape,
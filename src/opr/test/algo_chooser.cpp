@@ -15,8 +15,11 @@
 #include "megdnn/dtype.h"
 #include "megdnn/oprs/base.h"
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <random>
+#include <thread>
 #include <utility>
 
 using namespace mgb;
@@ -359,6 +362,48 @@ TEST(TestOprDNN, NoProfileWhenShapeChange) {
     ASSERT_EQ(cache_set_history.size(), 2);
 }
 
+TEST(TestOprDNN, AsyncProfile) {
+    REQUIRE_GPU(1);
+    using Policy = opr::Convolution::ExecutionPolicy;
+    using S = Policy::Strategy;
+    std::atomic_size_t nr_cache_set{0};
+    auto on_get = [](const std::string&, const void*, size_t, const void*, size_t) {};
+    auto on_set = [&nr_cache_set](
+                          const std::string&, const void*, size_t, const void*,
+                          size_t) { ++nr_cache_set; };
+    PersistentCacheHook cache_hook{on_get, on_set};
+
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("gpu0");
+    auto host_x = gen({2, 4, 16, 16}, cn), host_w = gen({8, 4, 3, 3}, cn);
+    opr::Convolution::Param param;
+    param.pad_h = param.pad_w = 1;
+
+    auto run = [&](S strategy, bool async_profile) {
+        auto graph = ComputingGraph::make();
+        graph->options().fast_run_config.async_profile = async_profile;
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+             w = opr::Host2DeviceCopy::make(*graph, host_w);
+        Policy policy;
+        policy.strategy = strategy;
+        auto y = opr::Convolution::make(x, w, param, policy);
+        HostTensorND host_y;
+        auto func = graph->compile({make_callback_copy(y, host_y)});
+        func->execute().wait();
+        return host_y;
+    };
+
+    //! the first run takes the heuristic algo without waiting for profiling
+    auto host_y = run(S::PROFILE, true);
+    MGB_ASSERT_TENSOR_NEAR(run(S::HEURISTIC, false), host_y, 1e-3);
+
+    for (int i = 0; i < 600 && !nr_cache_set; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_GT(nr_cache_set.load(), 0u);
+    MGB_ASSERT_TENSOR_NEAR(host_y, run(S::PROFILE, true), 1e-3);
+}
+
 #endif  // MGB_ENABLE_FASTRUN
 #endif  // MGB_CUDA
 
@@ -445,4 +490,38 @@ TEST(TestOprDNN, ExecutionPolicyShallowCopyPooling) {
              TensorShape{1, 20, 12, 12}});
 }
 
+TEST(TestOprDNN, ProfileCacheConcurrentGetPut) {
+    //! fastrun async profiling puts results from a worker thread while the
+    //! graph thread looks them up
+    auto old_impl =
+            PersistentCache::set_impl(std::make_shared<InMemoryPersistentCache>());
+    AlgoChooserProfileCache cache(CompNode::load("xpu0"), "concurrent");
+    TensorLayout layout{{2, 3}, dtype::Float32()};
+    AlgoChooserProfileCache::Key key{&layout, 1};
+    std::atomic_bool stop{false};
+    std::thread writer([&]() {
+        for (size_t i = 0; !stop; ++i) {
+            AlgoChooserProfileCache::Result result;
+            for (size_t j = 0; j <= i % 3; ++j) {
+                //! slower entries take less workspace, so put() keeps them
+                result.push_back(
+                        {std::string(64, 'a' + j), 0, 1e-3 * (j + 1), 3 - j});
+            }
+            cache.put(key, result);
+        }
+    });
+    for (int i = 0; i < 20000; ++i) {
+        auto result = cache.get(key);
+        if (!result.valid())
+            continue;
+        EXPECT_FALSE(result->empty());
+        for (size_t j = 0; j < result->size(); ++j) {
+            EXPECT_EQ(std::string(64, 'a' + j), result->at(j).algo);
+        }
+    }
+    stop = true;
+    writer.join();
+    PersistentCache::set_impl(old_impl);
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
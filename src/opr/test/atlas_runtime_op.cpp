@@ -83,6 +83,38 @@ TEST(TestOprAtlas, DynamicBatch) {
     }
 }
 
+TEST(TestOprAtlas, RepeatedExecution) {
+    HostTensorGenerator<> gen;
+    const auto& graph = ComputingGraph::make();
+    auto host_x = gen({4, 3, 16, 16});
+
+    //! the om model is executed asynchronously, with its buffers released at
+    //! the next execution
+    const auto& om_buffer = ATLAS_MODEL.at("model_om");
+    auto cn = CompNode::load("atlas0");
+    auto x = Host2DeviceCopy::make(*graph, host_x, cn);
+    auto y = opr::AtlasRuntimeOpr::make(om_buffer.first, om_buffer.second, {x})[0];
+    HostTensorND host_om;
+    auto om_func = graph->compile({make_callback_copy(y, host_om, true)});
+
+    const auto& mdl_buffer = ATLAS_MODEL.at("model_mdl");
+    auto loader = GraphLoader::make(
+            InputFile::make_mem_proxy(mdl_buffer.first, mdl_buffer.second));
+    auto rst = loader->load();
+    auto input = rst.tensor_map.at("d");
+    HostTensorND host_mdl;
+    auto mgb_func =
+            rst.graph_compile({make_callback_copy(rst.output_var_list[0], host_mdl)});
+
+    for (size_t i = 0; i < 4; ++i) {
+        *host_x = *gen({4, 3, 16, 16});
+        om_func->execute().wait();
+        input->copy_from(*host_x).sync();
+        mgb_func->execute().wait();
+        MGB_ASSERT_TENSOR_NEAR(host_mdl, host_om, 1e-3);
+    }
+}
+
 TEST(TestOprAtlas, Rgb888) {
     HostTensorGenerator<dtype::Uint8, RandomDistribution::UNIFORM> gen;
     const auto& graph = ComputingGraph::make();
@@ -2676,6 +2676,98 @@ TEST_F(TestNoWeightPreprocess, NoPreprocess) {
     }
 }
 
+TEST(TestOprDNN, ConvolutionSharePreprocessedWeight) {
+    megdnn::AlgorithmCache::instance().clear();
+    using ::testing::_;
+    using ::testing::Invoke;
+    using ::testing::Return;
+    using PF = MockConvolutionForward::PreprocessedFilter;
+    using Param = opr::ConvolutionForward::Param;
+
+    auto cn = CompNode::load("cpux");
+    HostTensorGenerator<> gen;
+    auto w_host = gen({32, 16, 2, 2}, cn);
+    SmallVector<TensorLayout> filter_layout{{{1, 2, 3, 4}, dtype::Float32()}};
+    MockAlgorithm algo;
+
+    struct Network {
+        std::shared_ptr<ComputingGraph> graph;
+        std::shared_ptr<HostTensorND> x_host;
+        MockConvolutionForward* mock;
+        HostTensorND y_host;
+        std::unique_ptr<cg::AsyncExecutable> func;
+    };
+    auto make_network = [&](const HostTensorND& w_val) {
+        Network net;
+        net.graph = ComputingGraph::make();
+        net.graph->options().graph_opt.weight_preprocess = true;
+        net.graph->options().share_preprocessed_weight = true;
+        net.x_host = gen({1, 16, 10, 10}, cn);
+        auto x = opr::Host2DeviceCopy::make(*net.graph, net.x_host);
+        auto w = opr::ImmutableTensor::make(*net.graph, w_val);
+        auto y = opr::ConvolutionForward::make(x, w, Param{});
+        auto& opr = y.node()->owner_opr()->cast_final<opr::ConvolutionForward>();
+        auto mock = std::make_unique<MockConvolutionForward>(
+                opr.megdnn_opr(),
+                ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        net.mock = mock.get();
+        ConvolutionTestingPeer{&opr}.set_megdnn_opr(std::move(mock));
+        EXPECT_CALL(*net.mock, deduce_preprocessed_filter_layout(_, _, _))
+                .WillRepeatedly(Return(filter_layout));
+        EXPECT_CALL(*net.mock, get_algorithm_from_desc(_))
+                .WillRepeatedly(Return(&algo));
+        EXPECT_CALL(*net.mock, get_algorithm_heuristic(_, _, _, _, _, _))
+                .WillRepeatedly(Return(&algo));
+        EXPECT_CALL(*net.mock, get_workspace_in_bytes(_, _, _, _))
+                .WillRepeatedly(Return(0));
+        EXPECT_CALL(*net.mock, get_preprocess_workspace_in_bytes(_, _, _))
+                .WillRepeatedly(Return(0));
+        net.func = net.graph->compile({make_callback_copy(y, net.y_host)});
+        return net;
+    };
+
+    const void* shared_ptr = nullptr;
+    auto expect_exec = [&](Network& net) {
+        EXPECT_CALL(*net.mock, exec(_, _, _, _, _))
+                .WillOnce(Invoke([&](_megdnn_tensor_in, _megdnn_tensor_in,
+                                     _megdnn_tensor_out, const PF* pf,
+                                     _megdnn_workspace) {
+                    ASSERT_NE(pf, nullptr);
+                    ASSERT_EQ(pf->tensors[0].ptr<float>()[0], 114.514f);
+                    shared_ptr = pf->tensors[0].raw_ptr();
+                }));
+    };
+
+    auto net0 = make_network(*w_host);
+    EXPECT_CALL(*net0.mock, exec_preprocess(_, _, _, _, _))
+            .WillOnce(Invoke([&](const TensorLayout&, _megdnn_tensor_in,
+                                 const TensorLayout&, PF* pf, _megdnn_workspace) {
+                pf->tensors[0].ptr<float>()[0] = 114.514f;
+            }));
+    expect_exec(net0);
+    net0.func->execute().wait();
+    auto ptr0 = shared_ptr;
+
+    // equal weights: reuse the filter preprocessed by net0
+    auto net1 = make_network(*w_host);
+    EXPECT_CALL(*net1.mock, exec_preprocess(_, _, _, _, _)).Times(0);
+    expect_exec(net1);
+    net1.func->execute().wait();
+    ASSERT_EQ(ptr0, shared_ptr);
+
+    // different weights are preprocessed again
+    auto w_other = gen({32, 16, 2, 2}, cn);
+    auto net2 = make_network(*w_other);
+    EXPECT_CALL(*net2.mock, exec_preprocess(_, _, _, _, _))
+            .WillOnce(Invoke([&](const TensorLayout&, _megdnn_tensor_in,
+                                 const TensorLayout&, PF* pf, _megdnn_workspace) {
+                pf->tensors[0].ptr<float>()[0] = 114.514f;
+            }));
+    expect_exec(net2);
+    net2.func->execute().wait();
+    ASSERT_NE(ptr0, shared_ptr);
+}
+
 }  // anonymous namespace
 
 #endif
@@ -100,6 +100,58 @@ TEST(TestOprIO, H2DFwd) {
     MGB_ASSERT_TENSOR_EQ(*t0, host_y);
 }
 
+TEST(TestOprIO, H2DStaging) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("xpu0");
+    auto host_x = gen({23, 4}, cn);
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make_no_fwd(*graph, host_x);
+    auto&& h2d = x.node()->owner_opr()->cast_final_safe<opr::Host2DeviceCopy>();
+    h2d.enable_staging();
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(x * 2, host_y)});
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 4; ++i) {
+        auto src = gen({23, 4 + i % 2}, cn);
+        auto&& buf = h2d.staging_buffer();
+        buf.resize(src->shape()).copy_from_fixlayout(*src);
+        ptrs.push_back(buf.raw_ptr());
+        h2d.submit_staging_buffer();
+        func->execute().wait();
+        ASSERT_EQ(h2d.host_data()->raw_ptr(), buf.raw_ptr());
+        ASSERT_EQ(src->shape(), host_y.shape());
+        auto py = host_y.ptr<float>();
+        auto psrc = src->ptr<float>();
+        for (size_t j = 0; j < src->shape().total_nr_elems(); ++j) {
+            ASSERT_EQ(psrc[j] * 2, py[j]);
+        }
+    }
+    // the two buffers are used alternately
+    ASSERT_NE(ptrs[0], ptrs[1]);
+    ASSERT_EQ(ptrs[0], ptrs[2]);
+    ASSERT_EQ(ptrs[1], ptrs[3]);
+
+    // the buffer must be submitted before each execution
+    ASSERT_THROW(func->execute().wait(), MegBrainError);
+}
+
+TEST(TestOprIO, H2DStagingRecord) {
+    HostTensorGenerator<> gen;
+    auto cn = CompNode::load("cpu0");
+    auto host_x = gen({23, 4}, cn);
+    auto graph = ComputingGraph::make();
+    graph->options().lean_exec = true;
+    auto x = opr::Host2DeviceCopy::make_no_fwd(*graph, host_x);
+    auto&& h2d = x.node()->owner_opr()->cast_final_safe<opr::Host2DeviceCopy>();
+    // the replayed copy would always read the same buffer
+    ASSERT_THROW(h2d.enable_staging(), MegBrainError);
+
+    graph->options().lean_exec = false;
+    graph->options().comp_node_seq_record_level = 1;
+    ASSERT_THROW(h2d.enable_staging(), MegBrainError);
+}
+
 TEST(TestOprIO, H2DCrossDev) {
     REQUIRE_GPU(1);
 
@@ -701,6 +701,25 @@ TEST(TestOprRand, MultinomialWithoutReplacementReprod) {
             });
 }
 
+TEST(TestOprRand, LogitsSamplingReprod) {
+    static constexpr size_t NUM_GROUPS = 1000;
+    static constexpr size_t LEN_LOGITS = 16;
+
+    std::shared_ptr<HostTensorND> logits_host(new HostTensorND{
+            CompNode::load("xpux"), TensorShape{NUM_GROUPS, LEN_LOGITS},
+            dtype::Float32()});
+    auto logits_ptr = logits_host->ptr<float>();
+    for (size_t i = 0; i < NUM_GROUPS * LEN_LOGITS; ++i) {
+        logits_ptr[i] = i % LEN_LOGITS;
+    }
+    auto graph = ComputingGraph::make();
+    auto logits_sym = opr::Host2DeviceCopy::make(*graph, logits_host);
+    check_reproducibility_with_int32_output(
+            graph, NUM_GROUPS, [&logits_sym](uint64_t seed) {
+                return opr::LogitsSamplingRNG::make(logits_sym, {seed, 8, 0.9f, 4.f});
+            });
+}
+
 TEST(TestOprRand, PermutationReprod) {
     static constexpr size_t SIZE = 123;
     auto graph = ComputingGraph::make();
@@ -1406,6 +1406,40 @@ TEST(TestTensorManip, ConcatWithNegativeAxis) {
             .run({TensorShape{5, 10}, {5, 3}, {5, 4}});
 }
 
+TEST(TestTensorManip, ConcatSliceFwd) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({16, 16}), host_y = gen({16, 16});
+    HostTensorND host_z[2], host_w[2];
+    for (int enable = 0; enable < 2; ++enable) {
+        auto graph = ComputingGraph::make();
+        graph->options().graph_opt_level = 0;
+        graph->options().seq_opt.enable_mem_fwd_out2in_slice = enable;
+        auto x = opr::Host2DeviceCopy::make(*graph, host_x),
+             y = opr::Host2DeviceCopy::make(*graph, host_y),
+             a = opr::MatrixMul::make(x, y), b = opr::MatrixMul::make(y, x),
+             c = opr::MatrixMul::make(x, x), z = opr::Concat::make({a, b, a}, 0),
+             w = opr::Concat::make({z, c}, 0);
+        auto func = graph->compile(
+                {make_callback_copy(z, host_z[enable]),
+                 make_callback_copy(w, host_w[enable])});
+        func->execute();
+
+        auto ptr = [](SymbolVar var) {
+            return var.node()->dev_tensor().raw_ptr();
+        };
+        auto row_bytes = 16 * sizeof(float);
+        bool a_fwd = ptr(a) == ptr(z), b_fwd = ptr(b) == ptr(z) + row_bytes * 16,
+             c_fwd = ptr(c) == ptr(w) + row_bytes * 48;
+        ASSERT_EQ(static_cast<bool>(enable), a_fwd);
+        ASSERT_EQ(static_cast<bool>(enable), b_fwd);
+        // z contains slices, so it is not placed in w
+        ASSERT_NE(ptr(z), ptr(w));
+        ASSERT_EQ(static_cast<bool>(enable), c_fwd);
+    }
+    MGB_ASSERT_TENSOR_EQ(host_z[0], host_z[1]);
+    MGB_ASSERT_TENSOR_EQ(host_w[0], host_w[1]);
+}
+
 TEST(TestTensorManip, ConcatEmpty) {
     HostTensorGenerator<> gen;
     auto host_x = gen({2, 3, 5}), host_y = gen({2, 0, 5});
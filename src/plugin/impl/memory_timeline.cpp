@@ -0,0 +1,270 @@
+#include "megbrain/plugin/memory_timeline.h"
+
+#if MGB_ENABLE_JSON
+#include "megbrain/graph/event.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace mgb;
+using namespace cg;
+
+namespace {
+//! the var whose memory chunk is used by given var
+VarNode* chunk_owner(VarNode* var) {
+    auto&& plan = var->mem_plan();
+    return plan.valid() ? plan.chunk().owner_var : var;
+}
+}  // anonymous namespace
+
+MemoryTimeline::MemoryTimeline(cg::ComputingGraph* graph) : PluginBase(graph) {
+    using namespace cg::event;
+    auto on_seq_start = [this](CompSeqExecBeforeStart const&) {
+        MGB_LOCK_GUARD(m_mtx);
+        m_var_idx.clear();
+        m_vars.clear();
+        m_samples.clear();
+        m_timer.reset();
+    };
+    auto on_static_mem_alloc = [this](StaticMemAlloc const& event) {
+        if (!event.comp_node.valid())
+            return;
+        MGB_LOCK_GUARD(m_mtx);
+        m_static_size[event.comp_node] = event.alloc_size;
+    };
+    auto on_opr_exec_finish = [this](OprExecFinished const& event) {
+        auto opr = event.opr;
+        for (auto&& comp_node : get_opr_comp_node_set(opr)) {
+            // run after the kernels of the opr, before its inputs are released
+            auto runner = [this, opr, comp_node]() { on_opr_finish(opr, comp_node); };
+            event.env->dispatch_on_comp_node(comp_node, runner);
+        }
+    };
+    auto&& ev = graph->event();
+    add_event_handler(ev.register_receiver<CompSeqExecBeforeStart>(on_seq_start));
+    add_event_handler(ev.register_receiver<StaticMemAlloc>(on_static_mem_alloc));
+    add_event_handler(ev.register_receiver<OprExecFinished>(on_opr_exec_finish));
+}
+
+void MemoryTimeline::on_opr_finish(OperatorNodeBase* opr, CompNode comp_node) {
+    double now = m_timer.get_secs();
+    MGB_LOCK_GUARD(m_mtx);
+    for (auto&& dep : opr->node_prop().dep_map()) {
+        if (!OperatorNodeProp::is_device_value_dep(dep.second) ||
+            dep.first->comp_node() != comp_node)
+            continue;
+        auto iter = m_var_idx.find(chunk_owner(dep.first));
+        if (iter != m_var_idx.end()) {
+            auto&& rec = m_vars[iter->second];
+            rec.free_time = std::max(rec.free_time, now);
+        }
+    }
+    for (auto var : opr->output()) {
+        // persistent values such as the params are not execution memory
+        if (var->comp_node() != comp_node ||
+            var->contain_flag(VarNode::Flag::PERSISTENT_DEVICE_VALUE) ||
+            !var->mem_plan().valid())
+            continue;
+        auto&& chunk = var->mem_plan().chunk();
+        if (chunk.owner_var != var || chunk.mem_alloc_status.is_invalid() ||
+            !chunk.size())
+            continue;
+        Kind kind = Kind::DYNAMIC;
+        if (var->contain_flag(VarNode::Flag::VOLATILE_CONTENT) &&
+            var->dtype() == dtype::Byte()) {
+            kind = Kind::WORKSPACE;
+        } else if (chunk.mem_alloc_status.is_static_offset()) {
+            kind = Kind::STATIC;
+        }
+        m_var_idx[var] = m_vars.size();
+        m_vars.push_back(
+                {var->id(), var->name(), opr->name(), comp_node, kind, chunk.size(),
+                 now, now});
+    }
+    m_samples.push_back(
+            {now, comp_node, comp_node.get_used_memory(),
+             comp_node.get_reserved_memory()});
+}
+
+const char* MemoryTimeline::kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::STATIC:
+            return "static";
+        case Kind::DYNAMIC:
+            return "dynamic";
+        case Kind::WORKSPACE:
+            return "workspace";
+    }
+    return "unknown";
+}
+
+std::vector<MemoryTimeline::VarRecord> MemoryTimeline::vars() const {
+    MGB_LOCK_GUARD(m_mtx);
+    return m_vars;
+}
+
+namespace {
+//! (time, is alloc, index of var)
+using Step = std::tuple<double, bool, size_t>;
+
+std::vector<Step> sorted_steps(
+        const std::vector<MemoryTimeline::VarRecord>& vars, CompNode comp_node) {
+    std::vector<Step> steps;
+    for (size_t i = 0; i < vars.size(); ++i) {
+        if (vars[i].comp_node != comp_node)
+            continue;
+        steps.emplace_back(vars[i].alloc_time, true, i);
+        // a chunk not read by others is freed right after its owner
+        steps.emplace_back(vars[i].free_time, false, i);
+    }
+    std::stable_sort(steps.begin(), steps.end(), [](const Step& a, const Step& b) {
+        if (std::get<0>(a) != std::get<0>(b))
+            return std::get<0>(a) < std::get<0>(b);
+        // at the end of an opr its outputs are allocated before its inputs are
+        // released
+        return std::get<1>(a) && !std::get<1>(b);
+    });
+    return steps;
+}
+
+CompNode::UnorderedSet comp_nodes_of(
+        const std::vector<MemoryTimeline::VarRecord>& vars) {
+    CompNode::UnorderedSet ret;
+    for (auto&& i : vars) {
+        ret.insert(i.comp_node);
+    }
+    return ret;
+}
+}  // anonymous namespace
+
+std::vector<MemoryTimeline::PeakInfo> MemoryTimeline::peak() const {
+    auto all_vars = vars();
+    std::vector<PeakInfo> ret;
+    for (auto&& comp_node : comp_nodes_of(all_vars)) {
+        PeakInfo cur, best;
+        std::vector<bool> live(all_vars.size());
+        for (auto&& step : sorted_steps(all_vars, comp_node)) {
+            double time;
+            bool alloc;
+            size_t idx;
+            std::tie(time, alloc, idx) = step;
+            auto&& var = all_vars[idx];
+            auto kind = static_cast<size_t>(var.kind);
+            live[idx] = alloc;
+            if (alloc) {
+                cur.total += var.size;
+                cur.by_kind[kind] += var.size;
+            } else {
+                cur.total -= var.size;
+                cur.by_kind[kind] -= var.size;
+            }
+            if (alloc && cur.total > best.total) {
+                best = cur;
+                best.time = time;
+                best.vars.clear();
+                for (size_t i = 0; i < live.size(); ++i) {
+                    if (live[i])
+                        best.vars.push_back(all_vars[i]);
+                }
+            }
+        }
+        best.comp_node = comp_node;
+        std::sort(
+                best.vars.begin(), best.vars.end(),
+                [](const VarRecord& a, const VarRecord& b) { return a.size > b.size; });
+        ret.emplace_back(std::move(best));
+    }
+    std::sort(ret.begin(), ret.end(), [](const PeakInfo& a, const PeakInfo& b) {
+        return a.comp_node.to_string() < b.comp_node.to_string();
+    });
+    return ret;
+}
+
+std::shared_ptr<json::Object> MemoryTimeline::to_chrome_trace() const {
+    using namespace json;
+    auto all_vars = vars();
+    std::vector<Sample> samples;
+    std::vector<std::pair<CompNode, size_t>> static_size;
+    {
+        MGB_LOCK_GUARD(m_mtx);
+        samples = m_samples;
+        for (auto&& i : m_static_size) {
+            static_size.emplace_back(i.first, i.second);
+        }
+    }
+
+    auto events = Array::make();
+    CompNode::UnorderedMap<size_t> pids;
+    auto pid_of = [&](CompNode comp_node) {
+        auto ins = pids.emplace(comp_node, pids.size());
+        if (ins.second) {
+            events->add(Object::make(
+                    {{"name", String::make("process_name")},
+                     {"ph", String::make("M")},
+                     {"pid", Number::make(ins.first->second)},
+                     {"args", Object::make(
+                                      {{"name",
+                                        String::make(comp_node.to_string())}})}}));
+        }
+        return ins.first->second;
+    };
+    auto us = [](double secs) { return Number::make(secs * 1e6); };
+    auto counter = [&](const char* name, CompNode comp_node, double time,
+                       std::shared_ptr<Object> args) {
+        events->add(Object::make(
+                {{"name", String::make(name)},
+                 {"ph", String::make("C")},
+                 {"pid", Number::make(pid_of(comp_node))},
+                 {"ts", us(time)},
+                 {"args", args}}));
+    };
+
+    for (auto&& comp_node : comp_nodes_of(all_vars)) {
+        size_t by_kind[3] = {0, 0, 0};
+        for (auto&& step : sorted_steps(all_vars, comp_node)) {
+            auto&& var = all_vars[std::get<2>(step)];
+            bool alloc = std::get<1>(step);
+            auto kind = static_cast<size_t>(var.kind);
+            if (alloc) {
+                by_kind[kind] += var.size;
+            } else {
+                by_kind[kind] -= var.size;
+            }
+            auto args = Object::make();
+            for (size_t i = 0; i < 3; ++i) {
+                (*args)[kind_name(static_cast<Kind>(i))] = Number::make(by_kind[i]);
+            }
+            counter("live_memory", comp_node, std::get<0>(step), args);
+
+            auto slice = Object::make(
+                    {{"name", String::make(var.var_name)},
+                     {"cat", String::make(kind_name(var.kind))},
+                     {"ph", String::make(alloc ? "b" : "e")},
+                     {"id", Number::make(var.var_id)},
+                     {"pid", Number::make(pid_of(comp_node))},
+                     {"tid", Number::make(0)},
+                     {"ts", us(std::get<0>(step))}});
+            if (alloc) {
+                (*slice)["args"] = Object::make(
+                        {{"size", Number::make(var.size)},
+                         {"opr", String::make(var.opr_name)}});
+            }
+            events->add(slice);
+        }
+    }
+    for (auto&& i : static_size) {
+        counter("static_buffer", i.first, 0,
+                Object::make({{"size", Number::make(i.second)}}));
+    }
+    for (auto&& i : samples) {
+        counter("allocator", i.comp_node, i.time,
+                Object::make(
+                        {{"used", Number::make(i.used)},
+                         {"reserved", Number::make(i.reserved)}}));
+    }
+    return Object::make({{"traceEvents", events}});
+}
+
+#endif  // MGB_ENABLE_JSON
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -9,7 +9,7 @@
 
 using namespace mgb;
 
-void NumRangeChecker::Checker::init(VarNode* var, float range) {
+void NumRangeChecker::Checker::init(VarNode* var, float range, bool async) {
     if (m_func)
         return;
 
@@ -19,11 +19,17 @@ void NumRangeChecker::Checker::init(VarNode* var, float range) {
     cg->options().log_level = 0;
     auto vi = opr::VolatileSharedDeviceTensor::make(*cg, m_inp),
          chk = opr::abs(vi) < range, good = opr::reduce_min(chk, chk.make_scalar(1));
-    auto cb = [d = m_out.get()](DeviceTensorND& dv) { d->copy_from(dv).sync(); };
+    auto cb = [d = m_out.get(), async](DeviceTensorND& dv) {
+        d->copy_from(dv);
+        if (!async)
+            d->sync();
+    };
     m_func = cg->compile({{good, cb}});
+    if (async)
+        m_event = var->comp_node().create_event();
 }
 
-bool NumRangeChecker::Checker::check(VarNode* var) {
+void NumRangeChecker::Checker::exec(VarNode* var) {
     auto&& val = var->dev_tensor();
     if (val.layout().is_contiguous()) {
         *m_inp = var->dev_tensor();
@@ -32,20 +38,73 @@ bool NumRangeChecker::Checker::check(VarNode* var) {
         m_inp->copy_from(val);
     }
     m_func->execute();
+}
+
+bool NumRangeChecker::Checker::result() {
     mgb_assert(m_out->shape().is_scalar());
     return m_out->ptr<float>()[0] >= 0.5;
 }
 
+bool NumRangeChecker::Checker::check(VarNode* var) {
+    exec(var);
+    return result();
+}
+
+VarNode* NumRangeChecker::Checker::check_async(VarNode* var) {
+    // the result buffer is reused, and the previous execution of m_func would
+    // be waited by execute() anyway
+    auto failed = fetch();
+    exec(var);
+    m_event->record();
+    m_pending = var;
+    return failed;
+}
+
+VarNode* NumRangeChecker::Checker::fetch() {
+    if (!m_pending)
+        return nullptr;
+    m_event->host_wait();
+    auto var = m_pending;
+    m_pending = nullptr;
+    return result() ? nullptr : var;
+}
+
 NumRangeChecker::NumRangeChecker(cg::ComputingGraph* graph, float range)
-        : PluginBase(graph), m_range{range} {
+        : NumRangeChecker(graph, range, {}) {}
+
+NumRangeChecker::NumRangeChecker(
+        cg::ComputingGraph* graph, float range, Options options)
+        : PluginBase(graph), m_range{range}, m_options{std::move(options)} {
+    add_member_func_as_event_handler(&NumRangeChecker::on_exec_start);
+    add_member_func_as_event_handler(&NumRangeChecker::on_exec_finished);
     add_member_func_as_event_handler(&NumRangeChecker::on_kern_end);
     add_member_func_as_event_handler(&NumRangeChecker::on_subgraph_associated);
 }
 
+void NumRangeChecker::on_exec_start(const cg::event::CompSeqExecBeforeStart&) {
+    // the vars of the previous execution are checked in turn
+    m_sample_idx = m_nr_var ? m_nr_exec % m_nr_var : 0;
+    m_nr_var = 0;
+    ++m_nr_exec;
+}
+
+void NumRangeChecker::on_exec_finished(const cg::event::CompSeqExecFinished& event) {
+    if (!m_options.on_error || !event.device_actually_finished)
+        return;
+    for (auto&& i : m_cn2dt2checker) {
+        for (auto&& j : i.second) {
+            if (auto var = j.second.fetch())
+                m_options.on_error(var);
+        }
+    }
+}
+
 void NumRangeChecker::on_kern_end(const cg::event::OprExecKernelEnd& event) {
     for (VarNode* var : event.opr->output()) {
         if (!var->contain_flag(VarNode::Flag::VOLATILE_CONTENT) &&
             var->dtype().category() == DTypeCategory::FLOAT) {
+            if (m_nr_var++ != m_sample_idx && m_options.sampled)
+                continue;
             event.env->dispatch_on_comp_node(
                     var->comp_node(), [this, var]() { on_var_computed(var); });
         }
@@ -56,7 +115,7 @@ void NumRangeChecker::on_subgraph_associated(
         const cg::event::SubgraphAssociated& event) {
     mgb_assert(event.par_graph == m_owner_graph);
     m_sub_graph_checkers.emplace_back(
-            std::make_unique<NumRangeChecker>(event.sub_graph, m_range));
+            std::make_unique<NumRangeChecker>(event.sub_graph, m_range, m_options));
 }
 
 void NumRangeChecker::on_var_computed(VarNode* var) {
@@ -64,7 +123,12 @@ void NumRangeChecker::on_var_computed(VarNode* var) {
         return;
 
     auto&& checker = m_cn2dt2checker[var->comp_node()][var->dtype().enumv()];
-    checker.init(var, m_range);
+    checker.init(var, m_range, static_cast<bool>(m_options.on_error));
+    if (m_options.on_error) {
+        if (auto failed = checker.check_async(var))
+            m_options.on_error(failed);
+        return;
+    }
     if (!checker.check(var)) {
         HostTensorND hv;
         hv.copy_from(var->dev_tensor()).sync();
@@ -2,21 +2,47 @@
 #include "megbrain/plugin/opr_footprint.h"
 
 #if MGB_ENABLE_JSON
+#include "megbrain/comp_node_env.h"
 #include "megbrain/graph/event.h"
 #include "megbrain/opr/io.h"
+#include "megbrain/opr/search_policy/algo_chooser.h"
 #include "megbrain/system.h"
 
+#include <algorithm>
+
 using namespace mgb;
 using namespace cg;
 
+namespace {
+template <class MegDNNOpr>
+std::string algo_name(OperatorNodeBase* opr) {
+    using MGBOpr = typename MegDNNOpr2MGBOpr<MegDNNOpr>::MGBOpr;
+    auto dnn_opr = static_cast<MegDNNOpr*>(opr->cast_final<MGBOpr>().megdnn_opr());
+    return dnn_opr ? dnn_opr->execution_policy().algo.name : std::string{};
+}
+
+std::string chosen_algo_name(OperatorNodeBase* opr) {
+    static const ThinHashMap<Typeinfo*, std::string (*)(OperatorNodeBase*)> getters = {
+#define cb(_Opr) {opr::_Opr::typeinfo(), &algo_name<megdnn::_Opr>},
+            MGB_FOREACH_FASTRUN_OPR(cb)
+#undef cb
+    };
+    auto iter = getters.find(opr->dyn_typeinfo());
+    return iter == getters.end() ? std::string{} : iter->second(opr);
+}
+}  // anonymous namespace
+
 MGB_TYPEINFO_OBJ_IMPL(opr_profile::OprProfileHolder);
 
 GraphProfiler::GraphProfiler(cg::ComputingGraph* graph) : PluginBase(graph) {
     graph->options().user_data.get_user_data_or_create<opr_profile::OprProfileHolder>();
+    graph->options().enable_exec_timer = true;
 
     using namespace cg::event;
     auto on_seq_start = [this](CompSeqExecBeforeStart const& event) {
         m_used_comp_node = event.used_comp_node;
+        MGB_LOCK_GUARD(m_mtx);
+        m_hw_counter.clear();
     };
     auto on_opr_start = [this](OprExecStart const& event) {
         ensure_start_time();
@@ -68,11 +94,36 @@ GraphProfiler::GraphProfiler(cg::ComputingGraph* graph) : PluginBase(graph) {
         }
 
         record_event(*evptr, event.comp_node);
+        if (hw_counter_enabled(event.comp_node)) {
+            auto key = std::make_pair(event.opr, event.comp_node);
+            auto read = [this, key]() {
+                if (auto counter = HWCounter::get()) {
+                    auto value = counter->read();
+                    MGB_LOCK_GUARD(m_mtx);
+                    m_hw_counter_start[key] = value;
+                }
+            };
+            CompNodeEnv::from_comp_node(event.comp_node).cpu_env().dispatch(read);
+        }
     };
     auto on_after_kern = [this](AfterKernel const& event) {
         if (!opr_filter(event.opr))
             return;
 
+        if (hw_counter_enabled(event.comp_node)) {
+            auto key = std::make_pair(event.opr, event.comp_node);
+            auto read = [this, key]() {
+                if (auto counter = HWCounter::get()) {
+                    auto value = counter->read();
+                    MGB_LOCK_GUARD(m_mtx);
+                    auto iter = m_hw_counter_start.find(key);
+                    if (iter != m_hw_counter_start.end()) {
+                        m_hw_counter[key.first] += value - iter->second;
+                    }
+                }
+            };
+            CompNodeEnv::from_comp_node(event.comp_node).cpu_env().dispatch(read);
+        }
         CompNodeEventPtr* evptr;
         {
             MGB_LOCK_GUARD(m_mtx);
@@ -85,6 +136,8 @@ GraphProfiler::GraphProfiler(cg::ComputingGraph* graph) : PluginBase(graph) {
         m_host_time.clear();
         m_kern_event.clear();
         m_opr_fp_rst.clear();
+        m_hw_counter_start.clear();
+        m_hw_counter.clear();
         m_start_of_time = None;
     };
     auto&& ev = graph->event();
@@ -130,6 +183,18 @@ void GraphProfiler::record_event(CompNodeEventPtr& dest, CompNode comp_node) {
     dest->record();
 }
 
+void GraphProfiler::enable_hw_counter(bool flag) {
+    m_hw_counter_enabled = flag;
+}
+
+bool GraphProfiler::hw_counter_enabled(CompNode comp_node) const {
+    // the events are issued on the thread dispatching the kernels, while the
+    // kernels run on the worker thread of the cpu comp node, so the counters
+    // must be read by tasks dispatched to that thread
+    return m_hw_counter_enabled &&
+           comp_node.device_type() == CompNode::DeviceType::CPU;
+}
+
 bool GraphProfiler::opr_filter(cg::OperatorNodeBase* opr) {
     static bool only_wait = MGB_GETENV("MGB_PROFILE_ONLY_WAIT");
     if (!only_wait)
@@ -186,6 +251,18 @@ std::shared_ptr<json::Object> GraphProfiler::to_json() const {
         opr_fp_item[tpair.first->id_str()] = tpair.second.to_json();
     }
 
+    auto hw_counter = Object::make();
+    for (auto&& tpair : m_hw_counter) {
+        auto&& v = tpair.second;
+        (*hw_counter)[tpair.first->id_str()] = Object::make(
+                {{"cycles", Number::make(v.cycles)},
+                 {"instructions", Number::make(v.instructions)},
+                 {"cache_references", Number::make(v.cache_references)},
+                 {"cache_misses", Number::make(v.cache_misses)},
+                 {"ipc", Number::make(v.ipc())},
+                 {"memory_bytes", Number::make(v.memory_bytes())}});
+    }
+
     auto pf_holder_pair =
             m_owner_graph->options()
                     .user_data.get_user_data<opr_profile::OprProfileHolder>();
@@ -201,7 +278,44 @@ std::shared_ptr<json::Object> GraphProfiler::to_json() const {
             {{"device", dev_prof},
              {"host", host_prof},
              {"opr_footprint", opr_fp},
-             {"opr_internal_pf", opr_internal_pf}});
+             {"opr_internal_pf", opr_internal_pf},
+             {"hw_counter", hw_counter}});
+}
+
+std::vector<GraphProfiler::OprSummary> GraphProfiler::summary() const {
+    ThinHashMap<OperatorNodeBase*, OprSummary> opr2summary;
+    for (auto&& kern_ev : m_kern_event) {
+        auto&& event = kern_ev.second;
+        if (!event.kern || !event.end)
+            continue;
+        event.end->host_wait();
+#if MGB_ATLAS
+        event.kern->host_wait();
+#endif
+        auto&& item = opr2summary[kern_ev.first.first];
+        item.device_time += event.kern->elapsed_time_until(*event.end);
+    }
+    std::vector<OprSummary> ret;
+    ret.reserve(opr2summary.size());
+    for (auto&& i : opr2summary) {
+        auto&& item = i.second;
+        item.opr = i.first;
+        auto fp = m_opr_fp_rst.find(i.first);
+        if (fp != m_opr_fp_rst.end()) {
+            item.computation = fp->second.computation;
+            item.memory = fp->second.memory;
+        }
+        item.algo = chosen_algo_name(i.first);
+        auto hw = m_hw_counter.find(i.first);
+        if (hw != m_hw_counter.end()) {
+            item.hw_counter = hw->second;
+        }
+        ret.emplace_back(std::move(item));
+    }
+    std::sort(ret.begin(), ret.end(), [](const OprSummary& a, const OprSummary& b) {
+        return a.opr->id() < b.opr->id();
+    });
+    return ret;
 }
 
 #endif  // MGB_ENABLE_JSON
@@ -0,0 +1,228 @@
+#include "megbrain/plugin/sampling_profiler.h"
+#include "megbrain/graph/event.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace mgb;
+using namespace cg;
+
+namespace {
+//! the finalizer of splitmix64, to choose the oprs in each sampled execution
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::string escape_label(const std::string& value) {
+    std::string ret;
+    ret.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            ret += '\\';
+            ret += c;
+        } else if (c == '\n') {
+            ret += "\\n";
+        } else {
+            ret += c;
+        }
+    }
+    return ret;
+}
+}  // anonymous namespace
+
+SamplingProfiler::SamplingProfiler(ComputingGraph* graph, const Options& options)
+        : PluginBase(graph), m_options(options) {
+    mgb_assert(options.period > 0, "sampling period should be positive");
+
+    using namespace cg::event;
+    auto on_seq_start = [this](CompSeqExecBeforeStart const&) {
+        bool sampled = m_nr_execs++ % m_options.period == 0;
+        if (sampled) {
+            m_nr_sampled.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_sampled.store(sampled, std::memory_order_relaxed);
+    };
+    auto on_seq_finish = [this](CompSeqExecFinished const& event) {
+        if (!m_sampled.load(std::memory_order_relaxed))
+            return;
+        // the comp nodes have been waited, so the events are finished
+        if (event.device_actually_finished) {
+            collect();
+        }
+        m_sampled.store(false, std::memory_order_relaxed);
+    };
+    auto on_seq_error = [this](CompSeqExecError const&) {
+        m_sampled.store(false, std::memory_order_relaxed);
+        MGB_LOCK_GUARD(m_event_mtx);
+        for (auto&& i : m_kern_event) {
+            i.second.finished = false;
+        }
+    };
+    auto on_before_kern = [this](BeforeKernel const& event) {
+        if (!m_sampled.load(std::memory_order_relaxed) || !opr_filter(event.opr))
+            return;
+        record_event(event.opr, event.comp_node, false);
+    };
+    auto on_after_kern = [this](AfterKernel const& event) {
+        if (!m_sampled.load(std::memory_order_relaxed) || !opr_filter(event.opr))
+            return;
+        record_event(event.opr, event.comp_node, true);
+    };
+    auto on_graph_compile = [this](const CompSeqOrderDetermined&) {
+        // the oprs may be destroyed after recompilation
+        MGB_LOCK_GUARD(m_event_mtx);
+        for (auto&& i : m_kern_event) {
+            i.second.start->host_wait();
+            if (i.second.end) {
+                i.second.end->host_wait();
+            }
+        }
+        m_kern_event.clear();
+    };
+    auto&& ev = graph->event();
+    add_event_handler(ev.register_receiver<CompSeqExecBeforeStart>(on_seq_start));
+    add_event_handler(ev.register_receiver<CompSeqExecFinished>(on_seq_finish));
+    add_event_handler(ev.register_receiver<CompSeqExecError>(on_seq_error));
+    add_event_handler(ev.register_receiver<BeforeKernel>(on_before_kern));
+    add_event_handler(ev.register_receiver<AfterKernel>(on_after_kern));
+    add_event_handler(ev.register_receiver<CompSeqOrderDetermined>(on_graph_compile));
+}
+
+SamplingProfiler::~SamplingProfiler() noexcept {
+    for (auto&& i : m_kern_event) {
+        i.second.start->host_wait();
+        if (i.second.end) {
+            i.second.end->host_wait();
+        }
+    }
+}
+
+bool SamplingProfiler::opr_filter(OperatorNodeBase* opr) const {
+    if (m_options.opr_ratio >= 1)
+        return true;
+    // a different subset is chosen in each sampled execution
+    uint64_t key = (static_cast<uint64_t>(opr->id()) << 32) ^
+                   m_nr_sampled.load(std::memory_order_relaxed) ^
+                   mix(m_options.seed);
+    return (mix(key) >> 11) * 0x1.0p-53 < m_options.opr_ratio;
+}
+
+void SamplingProfiler::record_event(
+        OperatorNodeBase* opr, CompNode comp_node, bool end) {
+    CompNodeEventPtr* evptr;
+    {
+        MGB_LOCK_GUARD(m_event_mtx);
+        if (!end) {
+            auto&& kern_ev = m_kern_event[{opr, comp_node}];
+            evptr = &kern_ev.start;
+            kern_ev.finished = false;
+        } else {
+            auto iter = m_kern_event.find({opr, comp_node});
+            if (iter == m_kern_event.end())
+                return;
+            evptr = &iter->second.end;
+            iter->second.finished = true;
+        }
+    }
+    // the kernels on a comp node are dispatched by one thread, so the events are
+    // recorded without locking
+    if (!*evptr)
+        *evptr = comp_node.create_event(CompNode::Event::NEED_TIMER);
+    (*evptr)->record();
+}
+
+void SamplingProfiler::collect() {
+    MGB_LOCK_GUARD(m_event_mtx);
+    for (auto&& i : m_kern_event) {
+        auto&& kern_ev = i.second;
+        if (!kern_ev.finished)
+            continue;
+        kern_ev.finished = false;
+        kern_ev.end->host_wait();
+        double us = kern_ev.start->elapsed_time_until(*kern_ev.end) * 1e6;
+
+        auto opr = i.first.first;
+        Stat* stat;
+        {
+            MGB_LOCK_GUARD(m_stat_mtx);
+            auto&& ptr = m_stats[opr->name()];
+            if (!ptr) {
+                ptr = std::make_unique<Stat>();
+                ptr->name = opr->name();
+                ptr->type = opr->dyn_typeinfo()->name;
+            }
+            stat = ptr.get();
+        }
+        stat->buckets[bucket_of(us)].fetch_add(1, std::memory_order_relaxed);
+        stat->count.fetch_add(1, std::memory_order_relaxed);
+        stat->sum_ns.fetch_add(
+                static_cast<uint64_t>(std::max(us, 0.) * 1e3),
+                std::memory_order_relaxed);
+    }
+}
+
+size_t SamplingProfiler::bucket_of(double us) {
+    if (!(us >= 1))
+        return 0;
+    return std::min<size_t>(std::floor(std::log2(us)) + 1, NR_BUCKETS - 1);
+}
+
+std::vector<SamplingProfiler::OprStat> SamplingProfiler::stats() const {
+    std::vector<const Stat*> stats;
+    {
+        MGB_LOCK_GUARD(m_stat_mtx);
+        stats.reserve(m_stats.size());
+        for (auto&& i : m_stats) {
+            stats.push_back(i.second.get());
+        }
+    }
+    std::vector<OprStat> ret;
+    ret.reserve(stats.size());
+    for (auto stat : stats) {
+        OprStat item;
+        item.name = stat->name;
+        item.type = stat->type;
+        for (size_t i = 0; i < NR_BUCKETS; ++i) {
+            item.device_time.buckets[i] =
+                    stat->buckets[i].load(std::memory_order_relaxed);
+        }
+        item.device_time.count = stat->count.load(std::memory_order_relaxed);
+        item.device_time.sum = stat->sum_ns.load(std::memory_order_relaxed) / 1e3;
+        ret.emplace_back(std::move(item));
+    }
+    std::sort(ret.begin(), ret.end(), [](const OprStat& a, const OprStat& b) {
+        return a.name < b.name;
+    });
+    return ret;
+}
+
+std::string SamplingProfiler::to_prometheus(const std::string& metric) const {
+    std::ostringstream out;
+    out << "# HELP " << metric
+        << " device time of the operators in microseconds, sampled\n"
+        << "# TYPE " << metric << " histogram\n";
+    for (auto&& stat : stats()) {
+        auto labels = ssprintf(
+                "opr=\"%s\",type=\"%s\"", escape_label(stat.name).c_str(),
+                escape_label(stat.type).c_str());
+        auto&& hist = stat.device_time;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < NR_BUCKETS; ++i) {
+            cumulative += hist.buckets[i];
+            std::string le = i + 1 == NR_BUCKETS ? "+Inf" : std::to_string(1ULL << i);
+            out << metric << "_bucket{" << labels << ",le=\"" << le << "\"} "
+                << cumulative << "\n";
+        }
+        out << metric << "_sum{" << labels << "} " << hist.sum << "\n"
+            << metric << "_count{" << labels << "} " << hist.count << "\n";
+    }
+    return out.str();
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
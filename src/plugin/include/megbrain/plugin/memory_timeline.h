@@ -0,0 +1,90 @@
+#pragma once
+
+#include "megbrain/graph.h"
+#include "megbrain/plugin/base.h"
+#include "megbrain/utils/timer.h"
+
+#if MGB_ENABLE_JSON
+
+#include <mutex>
+#include <unordered_map>
+
+namespace mgb {
+
+/*!
+ * \brief record the memory of the vars in the last execution of a graph
+ *
+ * Each memory chunk is attributed to the var that owns it, and lives from the
+ * end of its owner opr to the end of its last reader (or of its owner, if it is
+ * not read). Static, dynamic and workspace chunks are told apart, so that the
+ * timeline shows which vars drive the peak memory. The statically planned
+ * buffer size and the memory used and reserved by the comp node allocator are
+ * also sampled after each opr.
+ */
+class MemoryTimeline final : public PluginBase {
+public:
+    enum class Kind { STATIC, DYNAMIC, WORKSPACE };
+
+    struct VarRecord {
+        size_t var_id;
+        std::string var_name, opr_name;
+        CompNode comp_node;
+        Kind kind;
+        size_t size;
+        //! seconds since the start of the execution
+        double alloc_time, free_time;
+    };
+
+    //! live memory on a comp node when it reaches the peak
+    struct PeakInfo {
+        CompNode comp_node;
+        double time = 0;
+        size_t total = 0;
+        //! bytes of live memory of each Kind
+        size_t by_kind[3] = {0, 0, 0};
+        //! the live vars at the peak, in descending order of size
+        std::vector<VarRecord> vars;
+    };
+
+    MGE_WIN_DECLSPEC_FUC MemoryTimeline(cg::ComputingGraph* graph);
+
+    //! vars of the last execution, in the order of allocation
+    MGE_WIN_DECLSPEC_FUC std::vector<VarRecord> vars() const;
+
+    //! peak of each comp node in the last execution
+    MGE_WIN_DECLSPEC_FUC std::vector<PeakInfo> peak() const;
+
+    /*!
+     * \brief the last execution in the chrome trace event format
+     *
+     * Each comp node is a process, where the vars are async slices and the
+     * live memory of each kind, the static buffer size and the allocator status
+     * are counters.
+     */
+    MGE_WIN_DECLSPEC_FUC std::shared_ptr<json::Object> to_chrome_trace() const;
+
+    static const char* kind_name(Kind kind);
+
+private:
+    struct Sample {
+        double time;
+        CompNode comp_node;
+        size_t used, reserved;
+    };
+
+    mutable std::mutex m_mtx;
+    RealTimer m_timer;
+    //! chunk owner var => index in m_vars
+    ThinHashMap<VarNode*, size_t> m_var_idx;
+    std::vector<VarRecord> m_vars;
+    std::vector<Sample> m_samples;
+    CompNode::UnorderedMap<size_t> m_static_size;
+
+    void on_opr_finish(cg::OperatorNodeBase* opr, CompNode comp_node);
+};
+
+}  // namespace mgb
+
+#endif  // MGB_ENABLE_JSON
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
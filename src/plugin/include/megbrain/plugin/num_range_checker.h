@@ -17,22 +17,66 @@ namespace mgb {
 /*!
  * \brief check that the absolute values of all numbers in a computing graph
  *      do not exceed some threshold
+ *
+ * NaN and Inf are always out of range. By default the outputs of all the oprs
+ * are checked synchronously and Error is thrown on the first violation; see
+ * Options for the cheaper modes to be used in production.
  */
 class NumRangeChecker final : public PluginBase {
+public:
+    struct Options {
+        //! check the outputs of only one opr in each execution, which goes
+        //! through all the oprs in turn over the executions
+        bool sampled = false;
+
+        /*!
+         * if set, the check results are copied to host asynchronously and
+         * the vars out of range are passed to this callback when the device
+         * has finished the check (at latest when the execution is waited),
+         * rather than throwing Error in the execution
+         *
+         * A check waits for the previous one on the same comp node and dtype,
+         * so this is best used with sampled.
+         */
+        thin_function<void(VarNode*)> on_error;
+    };
+
+private:
     class Checker {
         std::shared_ptr<DeviceTensorND> m_inp;
         std::unique_ptr<HostTensorND> m_out;
         std::unique_ptr<cg::AsyncExecutable> m_func;
+        //! recorded after the result is copied in async mode
+        std::unique_ptr<CompNode::Event> m_event;
+        //! the var whose result has not been read in async mode
+        VarNode* m_pending = nullptr;
+
+        void exec(VarNode* var);
+        bool result();
 
     public:
-        void init(VarNode* var, float range);
+        void init(VarNode* var, float range, bool async);
         bool check(VarNode* var);
+
+        //! start checking \p var; return the previous var failed the check
+        //! or nullptr
+        VarNode* check_async(VarNode* var);
+
+        //! wait for the pending check; return the var if it failed
+        VarNode* fetch();
     };
 
     const float m_range;
+    const Options m_options;
     CompNode::UnorderedMap<ThinHashMap<megdnn::DTypeEnum, Checker>> m_cn2dt2checker;
     std::vector<std::unique_ptr<NumRangeChecker>> m_sub_graph_checkers;
 
+    //! number of vars seen in current execution, and index of the var to be
+    //! checked in sampled mode
+    size_t m_nr_var = 0, m_sample_idx = 0, m_nr_exec = 0;
+
+    void on_exec_start(const cg::event::CompSeqExecBeforeStart& event);
+    void on_exec_finished(const cg::event::CompSeqExecFinished& event);
     void on_kern_end(const cg::event::OprExecKernelEnd& event);
     void on_subgraph_associated(const cg::event::SubgraphAssociated& event);
 
@@ -44,6 +88,8 @@ class NumRangeChecker final : public PluginBase {
 public:
     using Error = NumRangeCheckerError;
     MGE_WIN_DECLSPEC_FUC NumRangeChecker(cg::ComputingGraph* graph, float range);
+    MGE_WIN_DECLSPEC_FUC NumRangeChecker(
+            cg::ComputingGraph* graph, float range, Options options);
 };
 }  // namespace mgb
 
@@ -3,6 +3,7 @@
 #include "megbrain/graph.h"
 #include "megbrain/plugin/base.h"
 #include "megbrain/plugin/opr_footprint.h"
+#include "megbrain/utils/hw_counter.h"
 #include "megbrain/utils/small_vector.h"
 #include "megbrain/utils/timer.h"
 
@@ -60,6 +61,15 @@ class GraphProfiler final : public PluginBase {
 
     std::unique_ptr<OprFootprint> m_opr_footprint_ptr{std::make_unique<OprFootprint>()};
 
+    //! whether to read the hardware counters around the kernels on cpu
+    bool m_hw_counter_enabled = false;
+    //! (opr, comp node) => hardware counters before the kernel
+    std::unordered_map<
+            std::pair<cg::OperatorNodeBase*, CompNode>, HWCounter::Value, pairhash>
+            m_hw_counter_start;
+    //! (opr) => hardware counters of the kernels in the last execution
+    std::unordered_map<cg::OperatorNodeBase*, HWCounter::Value> m_hw_counter;
+
     //! first event on each comp node
     Maybe<CompNode::UnorderedMap<CompNodeEventPtr>> m_start_of_time;
     std::mutex m_mtx;
@@ -71,15 +81,49 @@ class GraphProfiler final : public PluginBase {
     void ensure_start_time();
     void record_event(CompNodeEventPtr& dest, CompNode comp_node);
 
+    //! whether the hardware counters should be read around the kernels on
+    //! the comp node
+    bool hw_counter_enabled(CompNode comp_node) const;
+
 public:
+    //! profiling result of one operator in the last execution
+    struct OprSummary {
+        cg::OperatorNodeBase* opr = nullptr;
+        //! kernel time summed over the comp nodes, in seconds
+        double device_time = 0;
+        //! number of arithmetic computations and bytes of inputs/outputs given
+        //! by OprFootprint; zero computation means no trait function available
+        uint64_t computation = 0;
+        size_t memory = 0;
+        //! name of the chosen algorithm, empty if the opr has only one
+        std::string algo;
+        //! hardware counters of the kernels on cpu, all zero if not enabled
+        HWCounter::Value hw_counter;
+    };
+
     MGE_WIN_DECLSPEC_FUC GraphProfiler(cg::ComputingGraph* graph);
     MGE_WIN_DECLSPEC_FUC ~GraphProfiler() noexcept;
 
+    /*!
+     * \brief read the hardware counters of the worker thread around the
+     *      kernels on cpu comp nodes
+     *
+     * It has no effect if the counters are not supported, see HWCounter. The
+     * kernels split to the worker threads of a multi-thread comp node are not
+     * counted.
+     */
+    MGE_WIN_DECLSPEC_FUC void enable_hw_counter(bool flag = true);
+
     /*!
      * \brief convert only profiling result to json
      */
     MGE_WIN_DECLSPEC_FUC std::shared_ptr<json::Object> to_json() const;
 
+    /*!
+     * \brief per-operator summary of the last execution, ordered by opr id
+     */
+    MGE_WIN_DECLSPEC_FUC std::vector<OprSummary> summary() const;
+
     /*!
      * \brief dump to visualizer format
      */
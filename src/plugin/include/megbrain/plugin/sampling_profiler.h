@@ -0,0 +1,114 @@
+#pragma once
+
+#include "megbrain/graph.h"
+#include "megbrain/plugin/base.h"
+#include "megbrain/utils/hash.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace mgb {
+
+/*!
+ * \brief low-overhead profiler for graphs running in production
+ *
+ * Only one in every Options::period executions is profiled, and in a sampled
+ * execution each opr is profiled with probability Options::opr_ratio. The device
+ * time of the profiled oprs is aggregated over all the sampled executions into
+ * fixed-size histograms, which can be pulled at any time by stats() or
+ * to_prometheus(). On the unsampled executions the event handlers return after
+ * checking a flag.
+ */
+class SamplingProfiler final : public PluginBase {
+public:
+    struct Options {
+        //! profile one in every period executions
+        size_t period = 100;
+        //! probability of each opr to be profiled in a sampled execution
+        double opr_ratio = 1;
+        //! seed to choose the random subset of oprs in each sampled execution
+        uint64_t seed = 0;
+    };
+
+    //! bucket i counts the times in [2^(i-1), 2^i) microseconds; bucket 0 counts
+    //! the times below 1us and the last one also counts all the longer ones
+    static constexpr size_t NR_BUCKETS = 32;
+
+    //! histogram of the device time of an opr, in microseconds
+    struct Histogram {
+        std::array<uint64_t, NR_BUCKETS> buckets{};
+        uint64_t count = 0;
+        double sum = 0;
+    };
+
+    struct OprStat {
+        std::string name, type;
+        Histogram device_time;
+    };
+
+    MGE_WIN_DECLSPEC_FUC SamplingProfiler(
+            cg::ComputingGraph* graph, const Options& options);
+    MGE_WIN_DECLSPEC_FUC SamplingProfiler(cg::ComputingGraph* graph)
+            : SamplingProfiler(graph, Options{}) {}
+    MGE_WIN_DECLSPEC_FUC ~SamplingProfiler() noexcept;
+
+    /*!
+     * \brief snapshot of the histograms of the oprs ordered by name; it can be
+     *      called from any thread while the graph is running
+     */
+    MGE_WIN_DECLSPEC_FUC std::vector<OprStat> stats() const;
+
+    //! the histograms in the text exposition format of Prometheus
+    MGE_WIN_DECLSPEC_FUC std::string to_prometheus(
+            const std::string& metric = "megbrain_opr_device_time_us") const;
+
+    //! number of the executions that have been sampled
+    size_t nr_sampled() const { return m_nr_sampled.load(std::memory_order_relaxed); }
+
+    //! index of the bucket of a time in microseconds
+    MGE_WIN_DECLSPEC_FUC static size_t bucket_of(double us);
+
+private:
+    using CompNodeEventPtr = std::unique_ptr<CompNode::Event>;
+    struct KernEvent {
+        CompNodeEventPtr start, end;
+        //! whether both events are recorded in the current sampled execution
+        bool finished = false;
+    };
+    //! histogram updated with atomics, so that it is read without locking
+    struct Stat {
+        std::string name, type;
+        std::array<std::atomic_uint64_t, NR_BUCKETS> buckets{};
+        std::atomic_uint64_t count{0};
+        //! sum in nanoseconds, to be accumulated atomically
+        std::atomic_uint64_t sum_ns{0};
+    };
+
+    const Options m_options;
+    size_t m_nr_execs = 0;
+    std::atomic_size_t m_nr_sampled{0};
+    std::atomic_bool m_sampled{false};
+
+    std::mutex m_event_mtx;
+    std::unordered_map<
+            std::pair<cg::OperatorNodeBase*, CompNode>, KernEvent, pairhash>
+            m_kern_event;
+
+    mutable std::mutex m_stat_mtx;
+    std::unordered_map<std::string, std::unique_ptr<Stat>> m_stats;
+
+    //! return whether given opr should be profiled in the current execution
+    bool opr_filter(cg::OperatorNodeBase* opr) const;
+
+    void record_event(cg::OperatorNodeBase* opr, CompNode comp_node, bool end);
+
+    //! add the times of the finished sampled execution to the histograms
+    void collect();
+};
+
+}  // namespace mgb
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,56 @@
+#include "megbrain/plugin/memory_timeline.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/blas.h"
+#include "megbrain/opr/io.h"
+#include "megbrain/test/helper.h"
+
+using namespace mgb;
+
+TEST(TestMemoryTimeline, Basic) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({32, 64})).rename("x"),
+         w = opr::SharedDeviceTensor::make(*graph, *gen({64, 128})).rename("w"),
+         y = opr::MatrixMul::make(x, w).rename("y"), z = (y * 2).rename("z"),
+         u = (z + y).rename("u");
+
+    HostTensorND host_u;
+    auto func = graph->compile({make_callback_copy(u, host_u)});
+    MemoryTimeline timeline{graph.get()};
+    func->execute().wait();
+
+    auto vars = timeline.vars();
+    ASSERT_FALSE(vars.empty());
+    size_t y_size = 0;
+    for (auto&& i : vars) {
+        ASSERT_LE(i.alloc_time, i.free_time);
+        ASSERT_GT(i.size, 0u);
+        // the params are not recorded
+        ASSERT_NE("w", i.var_name);
+        if (i.var_name == "y") {
+            y_size = i.size;
+        }
+    }
+    ASSERT_GE(y_size, 32u * 128 * sizeof(float));
+
+    auto peak = timeline.peak();
+    ASSERT_EQ(1u, peak.size());
+    auto&& p = peak[0];
+    ASSERT_EQ(p.total, p.by_kind[0] + p.by_kind[1] + p.by_kind[2]);
+    size_t sum = 0;
+    for (auto&& i : p.vars) {
+        sum += i.size;
+        ASSERT_LE(i.alloc_time, p.time);
+        ASSERT_GE(i.free_time, p.time);
+    }
+    ASSERT_EQ(p.total, sum);
+    // y is alive until u is computed
+    ASSERT_GE(p.total, 2 * y_size);
+
+    auto trace = timeline.to_chrome_trace();
+    auto&& events = (*trace)["traceEvents"];
+    ASSERT_TRUE(events);
+    ASSERT_FALSE(static_cast<json::Array&>(*events).get_impl().empty());
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -23,6 +23,31 @@ TEST(TestNumRangeChecker, Simple) {
     ASSERT_THROW(func->execute(), NumRangeChecker::Error);
 }
 
+TEST(TestNumRangeChecker, AsyncSampled) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    VarNodeArray failed;
+    NumRangeChecker::Options options;
+    options.sampled = true;
+    options.on_error = [&failed](VarNode* var) { failed.push_back(var); };
+    NumRangeChecker checker{graph.get(), 1e30f, options};
+    auto av = gen({3}), bv = gen({3});
+    auto a = opr::Host2DeviceCopy::make(*graph, av),
+         b = opr::Host2DeviceCopy::make(*graph, bv), c = a / b;
+    auto func = graph->compile({{c, {}}});
+    auto pb = bv->ptr<float>();
+    pb[0] = 2;
+    pb[1] = 0;
+    pb[2] = 3;
+    // one of a, b and c is checked in each execution, and c comes last
+    func->execute().wait();
+    ASSERT_TRUE(failed.empty());
+    for (int i = 0; i < 3; ++i) {
+        func->execute().wait();
+    }
+    ASSERT_EQ(VarNodeArray{c.node()}, failed);
+}
+
 TEST(TestNumRangeChecker, MultiDType) {
     HostTensorGenerator<dtype::Int32> gen;
     auto graph = ComputingGraph::make();
@@ -1,6 +1,7 @@
 #include "megbrain/plugin/profiler.h"
 #include <sstream>
 #include "megbrain/opr/basic_arith.h"
+#include "megbrain/opr/blas.h"
 #include "megbrain/opr/io.h"
 #include "megbrain/test/helper.h"
 
@@ -35,4 +36,73 @@ TEST(TestGraphProfiler, APlusBCPU) {
     run_test(CompNode::load("cpu0"), "test_profiler_cpu.json");
 }
 
+TEST(TestGraphProfiler, Summary) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({8, 16})).rename("x"),
+         y = opr::Host2DeviceCopy::make(*graph, gen({16, 4})).rename("y"),
+         z = opr::MatrixMul::make(x, y), w = z + z;
+
+    HostTensorND host_w;
+    auto func = graph->compile({make_callback_copy(w, host_w)});
+    auto profiler = std::make_shared<GraphProfiler>(graph.get());
+    func->execute().wait();
+
+    auto summary = profiler->summary();
+    ASSERT_FALSE(summary.empty());
+    bool found_matmul = false, found_add = false;
+    for (size_t i = 0; i < summary.size(); ++i) {
+        auto&& item = summary[i];
+        if (i) {
+            ASSERT_LT(summary[i - 1].opr->id(), item.opr->id());
+        }
+        ASSERT_GE(item.device_time, 0);
+        if (item.opr == z.node()->owner_opr()) {
+            found_matmul = true;
+            ASSERT_GT(item.computation, 0u);
+            ASSERT_GT(item.memory, 0u);
+            ASSERT_FALSE(item.algo.empty());
+        } else if (item.opr == w.node()->owner_opr()) {
+            found_add = true;
+            ASSERT_TRUE(item.algo.empty());
+        }
+    }
+    ASSERT_TRUE(found_matmul);
+    ASSERT_TRUE(found_add);
+}
+
+TEST(TestGraphProfiler, HWCounter) {
+    if (!HWCounter::get()) {
+        printf("skip testcase due to perf_event unavailable\n");
+        return;
+    }
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({64, 64}), {"cpu0"}),
+         y = opr::Host2DeviceCopy::make(*graph, gen({64, 64}), {"cpu0"}),
+         z = opr::MatrixMul::make(x, y);
+
+    HostTensorND host_z;
+    auto func = graph->compile({make_callback_copy(z, host_z)});
+    auto profiler = std::make_shared<GraphProfiler>(graph.get());
+    profiler->enable_hw_counter();
+    func->execute().wait();
+
+    bool found_matmul = false;
+    for (auto&& item : profiler->summary()) {
+        if (item.opr == z.node()->owner_opr()) {
+            found_matmul = true;
+            //! 64^3 multiply-adds: even with wide simd there are thousands of
+            //! instructions, and far fewer than a hundred per multiply-add
+            size_t nr_mac = 64 * 64 * 64;
+            ASSERT_GT(item.hw_counter.instructions, nr_mac / 64);
+            ASSERT_LT(item.hw_counter.instructions, nr_mac * 100);
+            ASSERT_GT(item.hw_counter.cycles, 0u);
+        }
+    }
+    ASSERT_TRUE(found_matmul);
+    auto json = profiler->to_json();
+    ASSERT_TRUE((*json)["hw_counter"]);
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,91 @@
+#include "megbrain/plugin/sampling_profiler.h"
+#include "megbrain/opr/basic_arith_wrapper.h"
+#include "megbrain/opr/blas.h"
+#include "megbrain/opr/io.h"
+#include "megbrain/test/helper.h"
+
+using namespace mgb;
+
+TEST(TestSamplingProfiler, Period) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({8, 16})).rename("x"),
+         y = opr::Host2DeviceCopy::make(*graph, gen({16, 4})).rename("y"),
+         z = opr::MatrixMul::make(x, y).rename("z"), w = (z + z).rename("w");
+
+    HostTensorND host_w;
+    auto func = graph->compile({make_callback_copy(w, host_w)});
+    SamplingProfiler::Options options;
+    options.period = 3;
+    SamplingProfiler profiler{graph.get(), options};
+    for (size_t i = 0; i < 7; ++i) {
+        func->execute().wait();
+    }
+    // the 1st, 4th and 7th executions
+    ASSERT_EQ(3u, profiler.nr_sampled());
+
+    auto stats = profiler.stats();
+    bool found_matmul = false;
+    for (auto&& stat : stats) {
+        auto&& hist = stat.device_time;
+        uint64_t count = 0;
+        for (auto i : hist.buckets) {
+            count += i;
+        }
+        ASSERT_EQ(hist.count, count);
+        ASSERT_LE(hist.count, 3u);
+        if (stat.name == "z") {
+            found_matmul = true;
+            ASSERT_EQ(3u, hist.count);
+            ASSERT_EQ("MatrixMul", stat.type);
+        }
+    }
+    ASSERT_TRUE(found_matmul);
+
+    auto text = profiler.to_prometheus("t");
+    ASSERT_NE(
+            std::string::npos,
+            text.find("t_bucket{opr=\"z\",type=\"MatrixMul\",le=\"+Inf\"} 3\n"));
+    ASSERT_NE(
+            std::string::npos, text.find("t_count{opr=\"z\",type=\"MatrixMul\"} 3\n"));
+}
+
+TEST(TestSamplingProfiler, OprRatio) {
+    HostTensorGenerator<> gen;
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, gen({4, 4})).rename("x");
+    SymbolVar y = x;
+    for (int i = 0; i < 32; ++i) {
+        y = (y + x).rename(ssprintf("y%d", i));
+    }
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(y, host_y)});
+    SamplingProfiler::Options options;
+    options.period = 1;
+    options.opr_ratio = 0.25;
+    SamplingProfiler profiler{graph.get(), options};
+    size_t nr_runs = 16;
+    for (size_t i = 0; i < nr_runs; ++i) {
+        func->execute().wait();
+    }
+    uint64_t total = 0;
+    for (auto&& stat : profiler.stats()) {
+        ASSERT_LE(stat.device_time.count, nr_runs);
+        total += stat.device_time.count;
+    }
+    // about a quarter of the oprs in each execution, with a loose bound
+    ASSERT_GT(total, 32 * nr_runs / 8);
+    ASSERT_LT(total, 34 * nr_runs / 2);
+}
+
+TEST(TestSamplingProfiler, Bucket) {
+    ASSERT_EQ(0u, SamplingProfiler::bucket_of(0));
+    ASSERT_EQ(0u, SamplingProfiler::bucket_of(0.5));
+    ASSERT_EQ(1u, SamplingProfiler::bucket_of(1));
+    ASSERT_EQ(2u, SamplingProfiler::bucket_of(3));
+    ASSERT_EQ(11u, SamplingProfiler::bucket_of(1024));
+    ASSERT_EQ(
+            SamplingProfiler::NR_BUCKETS - 1, SamplingProfiler::bucket_of(1e300));
+}
+
+// vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -3,6 +3,7 @@
 
 #include "megbrain/exception.h"
 #include "megbrain/rdnn/algo_chooser.h"
+#include "megbrain/utils/async_worker.h"
 #include "megbrain/utils/invoke.h"
 
 //! TODO: here has to be know some megdnn::opr when there is produced midout.h
@@ -320,6 +321,48 @@ static Algorithm::Info::Desc deserialize_read_pod(
     return ret;
 }
 
+/*!
+ * \brief the worker thread to profile oprs for AlgoChooserDesc::async_profile
+ *
+ * Profiling tasks are run one by one, and a task is not launched again if the
+ * same opr is still pending.
+ */
+class AsyncProfiler final : public NonCopyableObj {
+    std::mutex m_mtx;
+    std::unordered_set<std::string> m_pending;
+    FutureThreadPool<void> m_pool{"async_profile"};
+
+    AsyncProfiler() { m_pool.start(1); }
+
+public:
+    static AsyncProfiler& inst() {
+        static AsyncProfiler ins;
+        return ins;
+    }
+
+    bool is_pending(const std::string& key) {
+        MGB_LOCK_GUARD(m_mtx);
+        return m_pending.count(key);
+    }
+
+    void launch(const std::string& key, thin_function<void()> task) {
+        {
+            MGB_LOCK_GUARD(m_mtx);
+            if (!m_pending.insert(key).second) {
+                return;
+            }
+        }
+        m_pool.launch([this, key, task]() {
+            MGB_TRY { task(); }
+            MGB_CATCH(std::exception & exc, {
+                mgb_log_warn("async profiling failed: %s", exc.what());
+            });
+            MGB_LOCK_GUARD(m_mtx);
+            m_pending.erase(key);
+        });
+    }
+};
+
 }  // namespace
 
 namespace megdnn {
@@ -1152,6 +1195,55 @@ DNN_FOREACH_FASTRUN_OPR(INST)
 #undef INST
 
 //////////////////////////////// AlgoChoose /////////////////////////////
+namespace {
+template <typename Opr>
+std::string async_profile_key(
+        const typename AlgoChooser<Opr>::AlgoChooserHelper& helper) {
+    std::string ret = profile_name(helper.megdnn_opr());
+    ret.append(AlgoChooser<Opr>::format_fixlayouts(helper.incache_layouts()));
+    ret.append(helper.param());
+    ret.append(helper.comp_node().to_string());
+    return ret;
+}
+
+//! profile the opr of \p helper with its own megdnn opr on a side stream
+template <typename Opr>
+void profile_async(
+        const typename AlgoChooser<Opr>::AlgoChooserHelper& helper,
+        const ExecutionStrategy& strategy) {
+    using Helper = typename AlgoChooser<Opr>::AlgoChooserHelper;
+    auto&& layouts = helper.fastrun_layouts();
+    auto&& param = helper.param();
+    auto cn = helper.comp_node().change_stream(CompNode::Stream::ASYNC_PROFILE);
+    auto&& policy = helper.execution_policy();
+    bool allow_weight_preprocess = helper.allow_weight_preprocess();
+    //! the workspace limit getter of the graph can not be called from the
+    //! profiling thread, so the limit is decided here
+    AlgoChooserDesc desc = helper.desc();
+    size_t workspace_limit =
+            desc.get_workspace_limit(helper.comp_node(), policy.workspace_limit);
+    desc.get_workspace_limit = [workspace_limit](CompNode, size_t) {
+        return workspace_limit;
+    };
+    desc.async_profile = false;
+    AsyncProfiler::inst().launch(async_profile_key<Opr>(helper), [=]() {
+        auto megdnn_opr = opr::intl::create_megdnn_opr<Opr>(cn);
+        megdnn_opr->param() =
+                Algorithm::deserialize_read_pod<typename Opr::Param>(param);
+        Helper bg_helper(
+                layouts, megdnn_opr.get(), param, cn, policy, allow_weight_preprocess,
+                desc);
+        bg_helper.choose_by_profile(strategy, true);
+    });
+}
+}  // anonymous namespace
+
+template <typename Opr>
+bool AlgoChooser<Opr>::is_profiling_async(const AlgoChooserHelper& helper) {
+    return helper.desc().async_profile &&
+           AsyncProfiler::inst().is_pending(async_profile_key<Opr>(helper));
+}
+
 template <typename Opr>
 typename AlgoChooser<Opr>::ImplExecutionPolicy AlgoChooser<Opr>::get_policy(
         const AlgoChooserHelper& helper) {
@@ -1188,6 +1280,17 @@ typename AlgoChooser<Opr>::ImplExecutionPolicy AlgoChooser<Opr>::get_policy(
     }
 #if MGB_ENABLE_FASTRUN
     else if (opr_strategy & ExecutionStrategy::PROFILE) {
+        if (helper.desc().async_profile &&
+            helper.comp_node().device_type() == CompNode::DeviceType::CUDA) {
+            //! use the cached result if any, otherwise run with the heuristic
+            //! algo until the background profiling is done
+            ImplExecutionPolicy policy = helper.choose_by_profile(opr_strategy, false);
+            if (!policy.algo.valid()) {
+                policy = helper.choose_by_heuristic(opr_strategy);
+                profile_async<Opr>(helper, opr_strategy);
+            }
+            return policy;
+        }
         return helper.choose_by_profile(opr_strategy, true);
     }
 #endif
@@ -1204,6 +1307,8 @@ std::string AlgoChooser<Opr>::format_fixlayouts(const FixedTensorLayouts& layout
 #define INST(Opr)                                                         \
     template AlgoChooser<megdnn::Opr>::ImplExecutionPolicy                \
     AlgoChooser<megdnn::Opr>::get_policy(const AlgoChooserHelper& proxy); \
+    template bool AlgoChooser<megdnn::Opr>::is_profiling_async(            \
+            const AlgoChooserHelper& proxy);                                \
     template std::string AlgoChooser<Opr>::format_fixlayouts(             \
             const FixedTensorLayouts& layout);
 
@@ -30,6 +30,9 @@ struct AlgoChooserDesc {
     uint32_t shared_batch_size = 0;
     bool binary_equal_between_batch = false;
     bool no_profiling_on_shape_change = false;
+    //! choose by heuristic at once and profile in a background thread on
+    //! cache miss, see ComputingGraph::Options::FastRunConfig::async_profile
+    bool async_profile = false;
     using WorkspaceLimitGetter = std::function<size_t(CompNode, size_t)>;
     WorkspaceLimitGetter get_workspace_limit;
 };
@@ -169,6 +172,13 @@ public:
     MGE_WIN_DECLSPEC_FUC static ImplExecutionPolicy get_policy(
             const AlgoChooserHelper& helper);
 
+    /*!
+     * \brief whether the opr of \p helper is being profiled in background,
+     *      so the policy returned by get_policy() is only a temporary one
+     */
+    MGE_WIN_DECLSPEC_FUC static bool is_profiling_async(
+            const AlgoChooserHelper& helper);
+
     //! format given layouts to string
     static std::string format_fixlayouts(const FixedTensorLayouts& layout);
 };
@@ -4,6 +4,7 @@
 #include "megbrain/serialization/extern_c_opr_io.h"
 #include "megbrain/serialization/opr_load_dump.h"
 
+#include <cstddef>
 #include <cstdlib>
 
 using namespace mgb;
@@ -273,15 +274,22 @@ ExternCOprRunner::ExternCOprRunner(
           m_desc{std::move(desc)},
           m_dump_name{name},
           m_param{nullptr} {
-    auto size_diff = sizeof(MGBOprDesc) - m_desc->size;
-    is_loader_support_dynamic_param = (0 == size_diff) ? true : false;
+    // the descs of loaders built with older headers are prefixes of MGBOprDesc
+    constexpr size_t size_v23 = offsetof(MGBOprDesc, dynamic_param),
+                     size_v24 = offsetof(MGBOprDesc, execute_device);
+    auto desc_size = m_desc->size;
+    is_loader_support_dynamic_param = desc_size >= size_v24;
     mgb_assert(
-            0 == size_diff || sizeof(ExternCOprParam*) == size_diff,
+            desc_size == sizeof(MGBOprDesc) || desc_size == size_v24 ||
+                    desc_size == size_v23,
             "invalid OprDesc size: expect=%zu got=%u, may caused by "
             "extern_c_opr.h mismatch, please confirm that the "
             "extern_c_opr.h used when compiling the loader is consistent "
             "with the runtime caller build used",
             sizeof(MGBOprDesc), m_desc->size);
+    bool has_v25 = desc_size == sizeof(MGBOprDesc);
+    m_execute_on_device = has_v25 && m_desc->execute_device;
+    bool has_workspace = m_execute_on_device && m_desc->get_workspace_size;
     for (auto i : inputs) {
         add_input({i});
     }
@@ -295,19 +303,35 @@ ExternCOprRunner::ExternCOprRunner(
                 cname());
         add_output(None);
     }
+    if (has_workspace) {
+        cg::add_workspace_output(this);
+    }
     add_equivalence_component<MGBOprDescHash>(m_desc.get());
 }
 
 void ExternCOprRunner::get_output_var_shape(
         const TensorShapeArray& inp_shape, TensorShapeArray& out_shape) const {
-    SmallVector<MGBTensorShape> c_inp(inp_shape.size()), c_out(out_shape.size());
+    size_t nr_out = m_desc->nr_output;
+    SmallVector<MGBTensorShape> c_inp(inp_shape.size()), c_out(nr_out);
     for (size_t i = 0; i < inp_shape.size(); ++i) {
         c_inp[i] = tensor_shape_to_c(inp_shape[i]);
     }
     m_desc->infer_shape(m_desc.get(), c_inp.data(), c_out.data());
-    for (size_t i = 0; i < out_shape.size(); ++i) {
+    for (size_t i = 0; i < nr_out; ++i) {
         out_shape[i] = tensor_shape_from_c(c_out[i]);
     }
+    if (out_shape.size() > nr_out) {
+        // the workspace of execute_device
+        SmallVector<MGBTensorLayout> inp_layout(c_inp.size()), out_layout(nr_out);
+        for (size_t i = 0; i < c_inp.size(); ++i) {
+            inp_layout[i] = {dtype_cpp2c(input(i)->dtype()), c_inp[i]};
+        }
+        for (size_t i = 0; i < nr_out; ++i) {
+            out_layout[i] = {dtype_cpp2c(output(i)->dtype()), c_out[i]};
+        }
+        out_shape[nr_out] = {m_desc->get_workspace_size(
+                m_desc.get(), inp_layout.data(), out_layout.data())};
+    }
 }
 
 void ExternCOprRunner::init_output_dtype() {
@@ -315,7 +339,7 @@ void ExternCOprRunner::init_output_dtype() {
         Super::init_output_dtype();
         return;
     }
-    SmallVector<MGBDType> inp_dtypes, out_dtypes(output().size());
+    SmallVector<MGBDType> inp_dtypes, out_dtypes(m_desc->nr_output);
     inp_dtypes.reserve(input().size());
     for (auto i : input()) {
         inp_dtypes.push_back(dtype_cpp2c(i->dtype()));
@@ -376,21 +400,75 @@ void ExternCOprRunner::check_param() {
     }
 
     if (m_param && m_param->nr_output > 0) {
-        check(m_param->nr_output, output().size(), m_param->output, output(), "output");
+        check(
+                m_param->nr_output, m_desc->nr_output, m_param->output, output(),
+                "output");
     }
 }
 
+bool ExternCOprRunner::execute_on_device() {
+    if (!m_execute_on_device)
+        return false;
+    auto cn = comp_node();
+    MGBExecEnv env;
+    memset(&env, 0, sizeof(env));
+    env.device_id = cn.locator().device;
+    switch (cn.device_type()) {
+        case CompNode::DeviceType::CPU:
+            env.device_type = MGB_DEVICE_CPU;
+            break;
+#if MGB_CUDA
+        case CompNode::DeviceType::CUDA:
+            env.device_type = MGB_DEVICE_CUDA;
+            env.stream = CompNodeEnv::from_comp_node(cn).cuda_env().stream;
+            break;
+#endif
+        default:
+            return false;
+    }
+
+    size_t nr_out = m_desc->nr_output;
+    SmallVector<MGBTensor> c_inp(input().size()), c_out(nr_out);
+    for (size_t i = 0; i < input().size(); ++i) {
+        c_inp[i] = tensor_to_c(input(i)->dev_tensor());
+    }
+    for (size_t i = 0; i < nr_out; ++i) {
+        c_out[i] = tensor_to_c(output(i)->dev_tensor());
+    }
+    if (output().size() > nr_out) {
+        auto&& ws = output().back()->dev_tensor();
+        env.workspace = ws.raw_ptr();
+        env.workspace_size = ws.shape()[0];
+    }
+
+    if (env.device_type == MGB_DEVICE_CPU) {
+        CompNodeEnv::from_comp_node(cn).cpu_env().dispatch(
+                [this, c_inp, c_out, env]() mutable {
+                    m_desc->execute_device(
+                            m_desc.get(), c_inp.data(), c_out.data(), &env);
+                });
+    } else {
+        // the work is enqueued on the stream, so no sync is needed
+        m_desc->execute_device(m_desc.get(), c_inp.data(), c_out.data(), &env);
+    }
+    return true;
+}
+
 void ExternCOprRunner::scn_do_execute() {
-    SmallVector<MGBTensor> c_inp(input().size()), c_out(output().size());
-    SmallVector<HostTensorND> cpu_inp, cpu_out;
     check_param();
+    if (execute_on_device())
+        return;
+
+    size_t nr_out = m_desc->nr_output;
+    SmallVector<MGBTensor> c_inp(input().size()), c_out(nr_out);
+    SmallVector<HostTensorND> cpu_inp, cpu_out;
 
     bool need_copy = false;
     if (comp_node().device_type() == CompNode::DeviceType::CPU) {
         for (size_t i = 0; i < input().size(); ++i) {
             c_inp[i] = tensor_to_c(input(i)->dev_tensor());
         }
-        for (size_t i = 0; i < output().size(); ++i) {
+        for (size_t i = 0; i < nr_out; ++i) {
             c_out[i] = tensor_to_c(output(i)->dev_tensor());
         }
     } else {
@@ -400,12 +478,12 @@ void ExternCOprRunner::scn_do_execute() {
                 "opr `%s' on comp node `%s'",
                 cname(), comp_node().to_string().c_str());
         cpu_inp.resize(input().size());
-        cpu_out.resize(output().size());
+        cpu_out.resize(nr_out);
         for (size_t i = 0; i < input().size(); ++i) {
             cpu_inp[i].copy_from(input(i)->dev_tensor());
             c_inp[i] = tensor_to_c(cpu_inp[i]);
         }
-        for (size_t i = 0; i < output().size(); ++i) {
+        for (size_t i = 0; i < nr_out; ++i) {
             cpu_out[i]
                     .comp_node(comp_node())
                     .dtype(output(i)->dtype())
@@ -418,7 +496,7 @@ void ExternCOprRunner::scn_do_execute() {
         comp_node().sync();
         m_desc->execute(m_desc.get(), c_inp.data(), c_out.data());
 
-        for (size_t i = 0; i < output().size(); ++i)
+        for (size_t i = 0; i < nr_out; ++i)
             output(i)->dev_tensor().copy_from_fixlayout(cpu_out[i]).sync();
     } else {
         CompNodeEnv::from_comp_node(comp_node())
@@ -628,7 +706,8 @@ const MGBExternCOprApi* mgb_get_extern_c_opr_api_versioned(int version) {
         static const MGBExternCOprApi ret = {reg23, unreg};
         return &ret;
     }
-    if (version != MGB_EXTERN_C_OPR_VERSION)
+    // the desc of 0x24 is a prefix of the current one
+    if (version != 0x24 && version != MGB_EXTERN_C_OPR_VERSION)
         return nullptr;
 
     auto reg = [](const MGBOprLoader* loader) -> int {
@@ -1,5 +1,12 @@
 #include "megbrain/serialization/file.h"
 
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace mgb {
 namespace serialization {
 
@@ -233,6 +240,31 @@ std::unique_ptr<InputFile> InputFile::make_mem_proxy(
     return std::make_unique<SharedMemProxyImpl>(std::move(ptr), size, writable);
 }
 
+std::unique_ptr<InputFile> InputFile::make_mmap(const char* path) {
+#if defined(WIN32)
+    return make_fs(path);
+#else
+    int fd = open(path, O_RDONLY);
+    mgb_assert(fd >= 0, "failed to open %s: %s", path, strerror(errno));
+    // close the fd on every path out, including the asserts below; the mapping
+    // stays valid after it is closed
+    struct FdGuard {
+        int fd;
+        ~FdGuard() { close(fd); }
+    } fd_guard{fd};
+    struct stat st;
+    auto err = fstat(fd, &st);
+    mgb_assert(!err && st.st_size > 0, "failed to stat %s", path);
+    size_t size = st.st_size;
+    // pages are copied on write, so the loaded values can be modified without
+    // touching the file
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    mgb_assert(ptr != MAP_FAILED, "failed to mmap %s: %s", path, strerror(errno));
+    std::shared_ptr<void> buf{ptr, [size](void* p) { munmap(p, size); }};
+    return make_mem_proxy(std::move(buf), size, false);
+#endif
+}
+
 class OutputFile::VectorProxyImpl final : public OutputFile {
     std::vector<uint8_t>* const m_buf;
     size_t m_offset;
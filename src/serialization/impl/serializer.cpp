@@ -109,6 +109,7 @@ std::unique_ptr<GraphDumper> make_fbs_v2_dumper(
         std::unique_ptr<OutputFile> file, int version);
 bool is_fbs_file(InputFile& file);
 bool is_fbs_v2_file(InputFile& file);
+Maybe<GraphLoader::ModelInfo> read_fbs_v2_model_info(InputFile& file);
 
 bool GraphDumper::should_remove_in_dump(cg::OperatorNodeBase* opr) {
 #if MGB_ENABLE_GRAD
@@ -168,5 +169,14 @@ Maybe<GraphDumpFormat> GraphLoader::identify_graph_dump_format(InputFile& file)
     return {};
 }
 
+Maybe<GraphLoader::ModelInfo> GraphLoader::read_model_info(InputFile& file) {
+#if MGB_ENABLE_FBS_SERIALIZATION
+    if (is_fbs_v2_file(file)) {
+        return read_fbs_v2_model_info(file);
+    }
+#endif
+    return {};
+}
+
 }  // namespace serialization
 }  // namespace mgb
@@ -1,15 +1,22 @@
 #if MGB_ENABLE_FBS_SERIALIZATION
 
 #include <map>
+#include <set>
 #include "megbrain/comp_node_env.h"
 #include "megbrain/opr/io.h"
+#include "megbrain/plugin/opr_footprint.h"
 #include "megbrain/serialization/helper.h"
 #include "megbrain/serialization/internal/flatbuffers_helper.h"
 #include "megbrain/serialization/internal/schema_v2_generated.h"
 #include "megbrain/serialization/metadata.h"
 #include "megbrain/serialization/opr_load_dump.h"
 #include "megbrain/serialization/oss_opr_load_dump.h"
+#include "megbrain/utils/arena_allocator.h"
+#include "megbrain/utils/hash.h"
 #include "megbrain/utils/hash_ct.h"
+#include "megbrain/utils/infile_persistent_cache.h"
+#include "megbrain/utils/thread_pool.h"
+#include "megbrain/utils/timer.h"
 #include "megdnn/tensor_format.h"
 #include "serializer_oss_common.h"
 
@@ -18,6 +25,10 @@
 namespace mgb {
 namespace serialization {
 namespace {
+//! the tensor values are aligned in the model buffer, so that they can be
+//! shared by a read-only buffer such as a mapped file without copying
+constexpr size_t TENSOR_VALUE_ALIGNMENT = 64;
+
 fbs::v2::TensorFormat get_flatbuffer_tensor_format_type(
         const TensorLayout::Format& format) {
     using Type = megdnn::TensorFormat::Type;
@@ -33,6 +44,213 @@ fbs::v2::TensorFormat get_flatbuffer_tensor_format_type(
                     SerializationError, "invalid tensor format type in serialization.");
     }
 }
+//! compress the value of a Float32 tensor; see TensorCompression in
+//! schema_v2.fbs for the encodings
+std::vector<uint8_t> compress_tensor_value(
+        const HostTensorND& tensor, TensorCompression compression) {
+    auto&& layout = tensor.layout();
+    mgb_assert(
+            layout.dtype == dtype::Float32() && layout.is_contiguous(),
+            "tensor compression requires contiguous Float32 tensor, got %s",
+            layout.to_string().c_str());
+    size_t nr_elems = layout.total_nr_elems();
+    auto src = tensor.ptr<dt_float32>();
+    std::vector<uint8_t> ret;
+    switch (compression) {
+        case TensorCompression::FLOAT16: {
+            ret.resize(nr_elems * sizeof(dt_float16));
+            auto dst = reinterpret_cast<dt_float16*>(ret.data());
+            for (size_t i = 0; i < nr_elems; ++i) {
+                dst[i] = static_cast<dt_float16>(src[i]);
+            }
+            break;
+        }
+        case TensorCompression::BFLOAT16: {
+            ret.resize(nr_elems * sizeof(dt_bfloat16));
+            auto dst = reinterpret_cast<dt_bfloat16*>(ret.data());
+            for (size_t i = 0; i < nr_elems; ++i) {
+                dst[i] = static_cast<dt_bfloat16>(src[i]);
+            }
+            break;
+        }
+        case TensorCompression::LINEAR_UINT8: {
+            float min = nr_elems ? src[0] : 0.f, max = min;
+            for (size_t i = 0; i < nr_elems; ++i) {
+                min = std::min(min, src[i]);
+                max = std::max(max, src[i]);
+            }
+            float scale = max > min ? (max - min) / 255.f : 1.f;
+            ret.resize(sizeof(float) * 2 + nr_elems);
+            memcpy(ret.data(), &min, sizeof(float));
+            memcpy(ret.data() + sizeof(float), &scale, sizeof(float));
+            auto dst = ret.data() + sizeof(float) * 2;
+            for (size_t i = 0; i < nr_elems; ++i) {
+                float q = std::round((src[i] - min) / scale);
+                dst[i] = static_cast<uint8_t>(std::min(std::max(q, 0.f), 255.f));
+            }
+            break;
+        }
+        default:
+            mgb_throw(
+                    SerializationError, "invalid tensor compression: %d",
+                    static_cast<int>(compression));
+    }
+    return ret;
+}
+
+//! decompress the value of \p dest from the data compressed by
+//! compress_tensor_value()
+void decompress_tensor_value(
+        fbs::v2::TensorCompression compression, const uint8_t* data, size_t size,
+        HostTensorND& dest) {
+    auto&& layout = dest.layout();
+    mgb_assert(
+            layout.dtype == dtype::Float32() && layout.is_contiguous(),
+            "compressed tensor must be contiguous Float32, got %s",
+            layout.to_string().c_str());
+    size_t nr_elems = layout.total_nr_elems();
+    auto dst = dest.ptr<dt_float32>();
+    switch (compression) {
+        case fbs::v2::TensorCompression_FLOAT16: {
+            mgb_assert(size == nr_elems * sizeof(dt_float16));
+            auto src = reinterpret_cast<const dt_float16*>(data);
+            for (size_t i = 0; i < nr_elems; ++i) {
+                dst[i] = static_cast<dt_float32>(src[i]);
+            }
+            break;
+        }
+        case fbs::v2::TensorCompression_BFLOAT16: {
+            mgb_assert(size == nr_elems * sizeof(dt_bfloat16));
+            auto src = reinterpret_cast<const dt_bfloat16*>(data);
+            for (size_t i = 0; i < nr_elems; ++i) {
+                dst[i] = static_cast<dt_float32>(src[i]);
+            }
+            break;
+        }
+        case fbs::v2::TensorCompression_LINEAR_UINT8: {
+            mgb_assert(size == sizeof(float) * 2 + nr_elems);
+            float min, scale;
+            memcpy(&min, data, sizeof(float));
+            memcpy(&scale, data + sizeof(float), sizeof(float));
+            auto src = data + sizeof(float) * 2;
+            for (size_t i = 0; i < nr_elems; ++i) {
+                dst[i] = min + scale * src[i];
+            }
+            break;
+        }
+        default:
+            mgb_throw(
+                    SerializationError, "invalid tensor compression in model: %d",
+                    static_cast<int>(compression));
+    }
+}
+
+//! put the entries of an algo cache dumped by InFilePersistentCache into the
+//! current PersistentCache
+void load_algo_cache(const flatbuffers::Vector<uint8_t>* data) {
+    InFilePersistentCache cache{data->data(), data->size()};
+    auto entries = cache.get_cache();
+    auto&& inst = PersistentCache::inst();
+    for (auto&& category : entries) {
+        for (auto&& kv : category.second) {
+            inst.put(category.first, kv.first, kv.second);
+        }
+    }
+}
+
+//! the params loaded with GraphLoadConfig::share_identical_params, which are
+//! kept alive by the graphs using them
+class SharedParamPool {
+    std::mutex m_mtx;
+    std::unordered_map<std::string, std::weak_ptr<DeviceTensorND>> m_params;
+    size_t m_nr_params_after_purge = 0;
+
+public:
+    static SharedParamPool& inst() {
+        static SharedParamPool inst;
+        return inst;
+    }
+
+    std::shared_ptr<DeviceTensorND> get(const std::string& key) {
+        MGB_LOCK_GUARD(m_mtx);
+        auto iter = m_params.find(key);
+        if (iter == m_params.end())
+            return {};
+        auto ret = iter->second.lock();
+        if (!ret)
+            m_params.erase(iter);
+        return ret;
+    }
+
+    void put(const std::string& key, const std::shared_ptr<DeviceTensorND>& value) {
+        MGB_LOCK_GUARD(m_mtx);
+        m_params[key] = value;
+        if (m_params.size() >= m_nr_params_after_purge * 2 + 64) {
+            for (auto i = m_params.begin(); i != m_params.end();) {
+                if (i->second.expired())
+                    i = m_params.erase(i);
+                else
+                    ++i;
+            }
+            m_nr_params_after_purge = m_params.size();
+        }
+    }
+};
+
+//! name of \p dtype with its quantization param, which the name ignores
+std::string dtype_key(DType dtype) {
+    if (!dtype.has_param()) {
+        return dtype.name();
+    }
+    switch (dtype.enumv()) {
+#define CASE_ASYMMETRIC(_dt)                                       \
+    case DTypeEnum::_dt: {                                         \
+        auto&& p = dtype.param<dtype::_dt>();                      \
+        return ssprintf("%s(%a,%u)", #_dt, p.scale, p.zero_point); \
+    }
+#define CASE_SYMMETRIC(_dt)                                               \
+    case DTypeEnum::_dt:                                                  \
+        return ssprintf("%s(%a)", #_dt, dtype.param<dtype::_dt>().scale);
+        CASE_ASYMMETRIC(Quantized4Asymm)
+        CASE_ASYMMETRIC(Quantized8Asymm)
+        CASE_SYMMETRIC(QuantizedS1)
+        CASE_SYMMETRIC(QuantizedS4)
+        CASE_SYMMETRIC(QuantizedS8)
+        CASE_SYMMETRIC(QuantizedS16)
+        CASE_SYMMETRIC(QuantizedS32)
+#undef CASE_ASYMMETRIC
+#undef CASE_SYMMETRIC
+        default:
+            mgb_throw(
+                    SerializationError, "unexpected parameterized dtype %s",
+                    dtype.name());
+    }
+}
+
+std::string shared_param_key(
+        CompNode comp_node, const TensorLayout& layout,
+        const fbs::v2::Tensor* tensor) {
+    auto data = tensor->data();
+    return ssprintf(
+            "%s;%s;%s;%d;%zu;%llx", comp_node.to_string().c_str(),
+            layout.to_string().c_str(), dtype_key(layout.dtype).c_str(),
+            static_cast<int>(tensor->compression()), static_cast<size_t>(data->size()),
+            static_cast<unsigned long long>(
+                    XXHash{}.update(data->data(), data->size()).digest()));
+}
+
+//! make \p value hold \p buf if it is shared from the value of \p tensor in
+//! the buffer
+void hold_model_buf(
+        HostTensorND& value, const fbs::v2::Tensor* tensor, const SharedBuffer& buf) {
+    if (value.raw_ptr() != tensor->data()->data())
+        return;
+    HostTensorStorage storage;
+    storage.reset(
+            value.comp_node(), tensor->data()->size(),
+            {value.raw_ptr(), [buf](dt_byte*) {}});
+    value.reset(storage, value.layout());
+}
 }  // namespace
 
 flatbuffers::Offset<fbs::DType> GraphDumperOSSV2::build_dtype(DType dtype) {
@@ -66,6 +284,54 @@ flatbuffers::Offset<void> GraphDumperOSSV2::build_tensor_format(
     }
 }
 
+flatbuffers::Offset<fbs::v2::ModelInfo> GraphDumperOSSV2::build_model_info(
+        const SymbolVarArray& output_vars) {
+    auto build_var = [&](const std::string& name, const TensorShape& shape,
+                         DType dtype) {
+        return fbs::v2::CreateMiddleTensor(
+                m_builder, m_builder.CreateSharedString(name),
+                m_builder.CreateVectorScalarCast<uint32_t>(shape.shape, shape.ndim),
+                0, build_dtype(dtype));
+    };
+    std::vector<flatbuffers::Offset<fbs::v2::MiddleTensor>> inputs, outputs;
+    for (auto&& i : m_input_layouts) {
+        inputs.push_back(build_var(i.first, i.second, i.second.dtype));
+    }
+    for (size_t i = 0; i < output_vars.size(); ++i) {
+        auto var = output_vars[i].node();
+        auto name = m_config.keep_var_name >= 1 ? var->name()
+                                                 : ssprintf("unnamed%zu", i);
+        outputs.push_back(build_var(name, var->shape(), var->dtype()));
+    }
+
+    // the shapes are usually inferred when the graph is dumped, and the oprs
+    // with unknown shapes are not counted
+    OprFootprint footprint;
+    uint64_t flops = 0;
+    std::set<std::string> opr_types;
+    for (auto&& i : m_oprs_to_dump) {
+        auto opr = i.first;
+        opr_types.insert(i.second->name);
+        bool shape_known = true;
+        for (auto var : opr->input()) {
+            shape_known &= var->shape().ndim > 0;
+        }
+        for (auto var : opr->usable_output()) {
+            shape_known &= var->shape().ndim > 0;
+        }
+        if (shape_known) {
+            flops += footprint.get_computation(opr);
+        }
+    }
+    std::vector<flatbuffers::Offset<flatbuffers::String>> fb_opr_types;
+    for (auto&& i : opr_types) {
+        fb_opr_types.push_back(m_builder.CreateSharedString(i));
+    }
+    return fbs::v2::CreateModelInfo(
+            m_builder, m_builder.CreateVector(inputs), m_builder.CreateVector(outputs),
+            m_oprs_to_dump.size(), flops, m_builder.CreateVector(fb_opr_types));
+}
+
 flatbuffers::Offset<fbs::v2::MiddleTensor> GraphDumperOSSV2::build_middle_tensor(
         const SymbolVar var) {
     mgb_assert(var.node());
@@ -317,6 +583,8 @@ GraphDumper::DumpResult GraphDumperOSSV2::dump(
     m_var_remove_in_dump.clear();
     m_model_middle_tensors.clear();
     m_var2midtensor_id.clear();
+    m_tensor_values.clear();
+    m_input_layouts.clear();
     m_nr_shared_tensor = 0;
 
     // process output vars
@@ -371,6 +639,20 @@ GraphDumper::DumpResult GraphDumperOSSV2::dump(
     if (m_config.keep_var_name >= 1)
         fb_mid_tensor = m_builder.CreateVector(m_model_middle_tensors);
 
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> fb_algo_cache;
+    if (m_config.dump_algo_cache) {
+        auto cache = dynamic_cast<InFilePersistentCache*>(&PersistentCache::inst());
+        if (cache) {
+            fb_algo_cache = m_builder.CreateVector(cache->dump_cache());
+        } else {
+            mgb_log_warn(
+                    "algo cache is not dumped, since the persistent cache is not "
+                    "InFilePersistentCache");
+        }
+    }
+
+    auto fb_info = build_model_info(new_output_vars);
+
     fbs::v2::ModelBuilder model(m_builder);
     model.add_mge_version(MGB_VERSION);
     model.add_model_version(m_version);
@@ -382,6 +664,8 @@ GraphDumper::DumpResult GraphDumperOSSV2::dump(
     model.add_output_alias(fbs_output_alias);
     model.add_nr_shared_tensor(m_nr_shared_tensor);
     model.add_metadata(fbmeta);
+    model.add_algo_cache(fb_algo_cache);
+    model.add_info(fb_info);
     m_builder.FinishSizePrefixed(model.Finish(), fbs::v2::ModelIdentifier());
 
     // Write serialized fbs::Graph
@@ -432,26 +716,34 @@ void GraphDumperOSSV2::dump_tensor(
                     m_used_input_names.insert(name).second,
                     "duplicated input tensor name: %s", name.c_str());
             m_cur_rst.inputs.emplace_back(name);
+            m_input_layouts.emplace_back(name, tensor.layout());
             break;
     }
 
     auto& layout = tensor.layout();
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data;
+    auto compression = TensorCompression::NONE;
     if (has_value) {
         check_tensor_value_valid(name, tensor);
         auto&& dumper = m_config.tensor_value_dumper;
-        if (dumper) {
+        if (auto&& selector = m_config.tensor_compression_selector) {
+            compression = selector(*m_cur_opr, tensor);
+        }
+        if (compression != TensorCompression::NONE) {
+            mgb_assert(
+                    !dumper,
+                    "tensor compression can not be used with tensor_value_dumper");
+            auto value = compress_tensor_value(tensor, compression);
+            data = build_tensor_value(value.data(), value.size());
+        } else if (dumper) {
             std::vector<uint8_t> out_vec;
             auto temp_out_file = OutputFile::make_vector_proxy(&out_vec);
             dumper(*temp_out_file, *m_cur_opr, tensor);
-            data = m_builder.CreateVector(
-                    reinterpret_cast<uint8_t*>(out_vec.data()), out_vec.size());
-            m_cur_rst.tensor_value_bytes += out_vec.size();
+            data = build_tensor_value(out_vec.data(), out_vec.size());
         } else {
-            data = m_builder.CreateVector(
+            data = build_tensor_value(
                     reinterpret_cast<uint8_t*>(tensor.raw_ptr()),
                     layout.span().high_byte);
-            m_cur_rst.tensor_value_bytes += layout.span().high_byte;
         }
     }
 
@@ -465,10 +757,32 @@ void GraphDumperOSSV2::dump_tensor(
     auto fformat_type = get_flatbuffer_tensor_format_type(format);
     auto fformat = build_tensor_format(format);
     auto serialized_tensor = fbs::v2::CreateTensor(
-            m_builder, fbname, fshape, fcomp_node, fdtype, fformat_type, fformat, data);
+            m_builder, fbname, fshape, fcomp_node, fdtype, fformat_type, fformat, data,
+            static_cast<fbs::v2::TensorCompression>(compression));
     m_cur_opr_tensor.emplace_back(serialized_tensor);
 }
 
+flatbuffers::Offset<flatbuffers::Vector<uint8_t>> GraphDumperOSSV2::build_tensor_value(
+        const uint8_t* data, size_t size) {
+    uint64_t hash = 0;
+    if (m_config.dedup_tensor_value) {
+        hash = XXHash{}.update(data, size).digest();
+        auto range = m_tensor_values.equal_range(hash);
+        for (auto i = range.first; i != range.second; ++i) {
+            auto value = flatbuffers::GetTemporaryPointer(m_builder, i->second);
+            if (value->size() == size && !memcmp(value->data(), data, size))
+                return i->second;
+        }
+    }
+    m_builder.ForceVectorAlignment(size, sizeof(uint8_t), TENSOR_VALUE_ALIGNMENT);
+    auto ret = m_builder.CreateVector(data, size);
+    m_cur_rst.tensor_value_bytes += size;
+    if (m_config.dedup_tensor_value) {
+        m_tensor_values.emplace(hash, ret);
+    }
+    return ret;
+}
+
 void GraphDumperOSSV2::dump_buf_with_len(const void* data, uint32_t size) {
     auto blob = fbs::v2::CreateBlob(
             m_builder, m_builder.CreateVector(static_cast<const uint8_t*>(data), size));
@@ -608,6 +922,85 @@ TensorFormat GraphLoaderOSSV2::OprLoadContextImpl::load_tensor_format(size_t id)
     return format;
 }
 
+void GraphLoaderOSSV2::OprLoadContextImpl::decode_tensor_values() {
+    auto&& config = *m_loader->m_cur_load_config;
+    if (config.nr_load_threads <= 1)
+        return;
+    // uncompressed values shared from the model buffer need no decoding
+    bool decode_all =
+            config.tensor_value_loader || !m_loader->m_file->is_shared_memory();
+    std::vector<const fbs::v2::Tensor*> tensors;
+    const auto* oprs = m_loader->m_model->oprs();
+    for (flatbuffers::uoffset_t i = 0; i < oprs->size(); ++i) {
+        if (auto opr_tensors = oprs->Get(i)->tensors()) {
+            for (auto tensor : *opr_tensors) {
+                if (tensor->data() && tensor->data()->size() > 0 &&
+                    (decode_all ||
+                     tensor->compression() != fbs::v2::TensorCompression_NONE))
+                    tensors.push_back(tensor);
+            }
+        }
+    }
+    if (tensors.size() < 2)
+        return;
+
+    // the values are allocated by this thread, so the workers only fill them
+    std::vector<HostTensorND> values(tensors.size());
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        values[i] = HostTensorND{
+                CompNode::default_cpu(), load_tensor_layout_without_format(tensors[i])};
+        values[i].raw_ptr();
+    }
+    ThreadPool pool{std::min(config.nr_load_threads, tensors.size())};
+    std::vector<std::exception_ptr> errors(pool.nr_threads());
+    auto worker = [&](size_t idx, size_t thread_id) {
+        auto tensor = tensors[idx];
+        MGB_TRY { decode_tensor_value(tensor, values[idx], false); }
+        MGB_CATCH_ALL_EXCEPTION("decode tensor value", errors[thread_id]);
+    };
+    pool.add_task({worker, tensors.size()});
+    for (auto&& i : errors) {
+        if (i)
+            std::rethrow_exception(i);
+    }
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        m_decoded_values[tensors[i]] = std::move(values[i]);
+    }
+}
+
+void GraphLoaderOSSV2::OprLoadContextImpl::decode_tensor_value(
+        const fbs::v2::Tensor* tensor, HostTensorND& dest, bool shared) {
+    auto data = tensor->data()->data();
+    auto size = tensor->data()->size();
+    if (tensor->compression() != fbs::v2::TensorCompression_NONE) {
+        decompress_tensor_value(tensor->compression(), data, size, dest);
+    } else {
+        fill_tensor_memory(
+                dest, data, size, shared,
+                m_loader->m_cur_load_config->tensor_value_loader);
+    }
+}
+
+void GraphLoaderOSSV2::OprLoadContextImpl::fill_tensor_value(
+        const fbs::v2::Tensor* tensor, HostTensorND& dest, bool shared) {
+    auto iter = m_decoded_values.find(tensor);
+    if (iter == m_decoded_values.end()) {
+        decode_tensor_value(tensor, dest, shared);
+        return;
+    }
+    auto&& value = iter->second;
+    if (dest.comp_node().mem_node() == value.comp_node().mem_node()) {
+        HostTensorStorage storage;
+        storage.reset(
+                dest.comp_node(), value.storage().size(),
+                value.storage().raw_storage());
+        dest.reset(storage, dest.layout());
+    } else {
+        dest.copy_from_fixlayout(value);
+    }
+    m_decoded_values.erase(iter);
+}
+
 //! the opr loader should make sure the exist of tensors and the number of
 //! tensor, here just assert it.
 std::shared_ptr<HostTensorND> GraphLoaderOSSV2::OprLoadContextImpl::load_tensor() {
@@ -619,11 +1012,8 @@ std::shared_ptr<HostTensorND> GraphLoaderOSSV2::OprLoadContextImpl::load_tensor(
     auto layout = load_tensor_layout_without_format(tensor);
     auto ret = std::make_shared<HostTensorND>(comp_node, layout);
 
-    auto&& loader = m_loader->m_cur_load_config->tensor_value_loader;
     if (tensor->data() && tensor->data()->size() > 0) {
-        fill_tensor_memory(
-                *ret, tensor->data()->data(), tensor->data()->size(),
-                m_loader->m_file->is_shared_memory(), loader);
+        fill_tensor_value(tensor, *ret, m_loader->m_file->is_shared_memory());
     }
     if (tensor->name()) {
         m_tensor_map[tensor->name()->str()] = ret;
@@ -656,7 +1046,14 @@ std::shared_ptr<DeviceTensorND> GraphLoaderOSSV2::OprLoadContextImpl::
         if (shared_tensor_ref->comp_node() == comp_node)
             return shared_tensor_ref;
         // same mem node but different comp node, change comp node and share
-        // value
+        // value; a lazy value is copied now since the oprs on the two comp
+        // nodes are not synchronized
+        auto iter = m_lazy_device_values.find(shared_tensor_ref.get());
+        if (iter != m_lazy_device_values.end()) {
+            iter->second->apply(*shared_tensor_ref);
+            shared_tensor_ref->sync();
+            m_lazy_device_values.erase(iter);
+        }
         auto ret = std::make_shared<DeviceTensorND>(*shared_tensor_ref);
         ret->comp_node(comp_node);
         return ret;
@@ -665,16 +1062,35 @@ std::shared_ptr<DeviceTensorND> GraphLoaderOSSV2::OprLoadContextImpl::
         shared_pair.first = tensor->name()->str();
     }
 
-    auto loader = m_loader->m_cur_load_config->tensor_value_loader;
+    auto&& config = *m_loader->m_cur_load_config;
+    auto&& file = m_loader->m_file;
+    // the values in a writable buffer may be moved by m_tensor_alignment
+    std::string param_key;
+    if (config.share_identical_params && !config.lazy_device_value &&
+        !(file->writable() && file->is_shared_memory())) {
+        param_key = shared_param_key(comp_node, layout, tensor);
+        auto iter = m_shared_params.find(param_key);
+        if (iter != m_shared_params.end()) {
+            shared_tensor_ref = iter->second;
+            return shared_tensor_ref;
+        }
+        if (auto value = SharedParamPool::inst().get(param_key)) {
+            shared_tensor_ref = value;
+            return shared_tensor_ref;
+        }
+    }
+
     if (comp_node.mem_node() == CompNode::default_cpu().mem_node() || copy_immediatly) {
         // directly forward CPU memory
         shared_tensor_ref = std::make_shared<DeviceTensorND>();
         HostTensorND hv{comp_node};
         if (tensor->data() && tensor->data()->size() > 0) {
             hv.dtype(layout.dtype).resize(layout);
-            fill_tensor_memory(
-                    hv, tensor->data()->data(), tensor->data()->size(),
-                    m_loader->m_file->is_shared_memory(), loader);
+            fill_tensor_value(tensor, hv, file->is_shared_memory());
+            if (!param_key.empty()) {
+                // the value may outlive this loader in other graphs
+                hold_model_buf(hv, tensor, m_loader->m_model_buf);
+            }
         }
         if (comp_node.mem_node() == CompNode::default_cpu().mem_node()) {
             *shared_tensor_ref = DeviceTensorND::make_proxy(hv);
@@ -683,17 +1099,33 @@ std::shared_ptr<DeviceTensorND> GraphLoaderOSSV2::OprLoadContextImpl::
             mgb_assert(copy_immediatly);
             shared_tensor_ref->comp_node(comp_node).copy_from(hv).sync();
         }
+    } else if (config.lazy_device_value) {
+        // the value is kept on host until its first use, so it is not shared
+        // from a buffer that would be reordered by m_tensor_alignment
+        HostTensorND hv{CompNode::default_cpu()};
+        if (tensor->data() && tensor->data()->size() > 0) {
+            hv.dtype(layout.dtype).resize(layout);
+            fill_tensor_value(
+                    tensor, hv, file->is_shared_memory() && !file->writable());
+            // hold the model buffer as long as the shared value
+            hold_model_buf(hv, tensor, m_loader->m_model_buf);
+        }
+        shared_tensor_ref = std::make_shared<DeviceTensorND>(comp_node, layout);
+        m_lazy_device_values[shared_tensor_ref.get()] =
+                std::make_shared<opr::intl::SharedDeviceTensorBase::LazyValue>(
+                        std::move(hv));
     } else {
         // use lazy load for non-CPU devices
         HostTensorND hv{CompNode::default_cpu()};
         if (tensor->data() && tensor->data()->size() > 0) {
             hv.dtype(layout.dtype).resize(layout);
-            fill_tensor_memory(
-                    hv, tensor->data()->data(), tensor->data()->size(),
-                    m_loader->m_file->is_shared_memory(), loader);
+            fill_tensor_value(tensor, hv, m_loader->m_file->is_shared_memory());
         }
         shared_tensor_ref = m_device_value_loader.make(comp_node, std::move(hv));
     }
+    if (!param_key.empty()) {
+        m_shared_params[param_key] = shared_tensor_ref;
+    }
     return shared_tensor_ref;
 }
 
@@ -796,6 +1228,11 @@ void GraphLoaderOSSV2::OprLoadContextImpl::load_single_opr(
 }
 
 GraphLoader::LoadResult GraphLoaderOSSV2::OprLoadContextImpl::load_oprs() {
+    LoadResult ret;
+    RealTimer timer;
+    decode_tensor_values();
+    ret.stage_time.decode = timer.get_msecs_reset();
+
     // load oprs
     const auto* oprs = m_loader->m_model->oprs();
     {
@@ -803,16 +1240,21 @@ GraphLoader::LoadResult GraphLoaderOSSV2::OprLoadContextImpl::load_oprs() {
         // it tries to restore the same graph as it was dumped
         // see test TestSerializer2.LOGEXP for example
         GraphLoader::ScopedGraphOptDisabler _(m_graph);
+        ArenaAllocator::Scope arena_scope{
+                m_loader->m_cur_load_config->use_node_arena ? m_graph->node_arena()
+                                                             : nullptr};
         for (flatbuffers::uoffset_t i = 0; i < oprs->size(); ++i) {
             m_current_opr = oprs->Get(i);
             load_single_opr(m_current_opr);
         }
     }
 
+    ret.stage_time.build = timer.get_msecs_reset();
+
     // batched loading device values
     m_device_value_loader.apply();
+    ret.stage_time.upload = timer.get_msecs();
 
-    LoadResult ret;
     ret.graph = m_graph;
     ret.tensor_map = m_tensor_map;
 
@@ -829,6 +1271,46 @@ GraphLoader::LoadResult GraphLoaderOSSV2::OprLoadContextImpl::load_oprs() {
     return ret;
 }
 
+void GraphLoaderOSSV2::OprLoadContextImpl::attach_lazy_device_values(
+        const LoadResult& result) {
+    if (m_lazy_device_values.empty())
+        return;
+    auto on_opr = [&](cg::OperatorNodeBase* opr) {
+        if (auto sdt = dynamic_cast<opr::intl::SharedDeviceTensorBase*>(opr)) {
+            auto iter = m_lazy_device_values.find(&sdt->get_dev_tensor());
+            if (iter != m_lazy_device_values.end()) {
+                sdt->set_lazy_value(iter->second);
+            }
+        } else if (
+                auto holder =
+                        dynamic_cast<opr::intl::MultipleDeviceTensorHolderBase*>(
+                                opr)) {
+            // the values are read by the holder directly, so they are copied
+            // at load time as usual
+            for (auto&& i : holder->values()) {
+                auto iter = m_lazy_device_values.find(i.get());
+                if (iter != m_lazy_device_values.end()) {
+                    iter->second->apply(*i);
+                    i->sync();
+                }
+            }
+        }
+    };
+    cg::DepOprIter dep_opr_iter{on_opr};
+    for (auto i : result.output_var_list) {
+        dep_opr_iter.add(i.node()->owner_opr());
+    }
+    m_lazy_device_values.clear();
+}
+
+void GraphLoaderOSSV2::OprLoadContextImpl::publish_shared_params() {
+    auto&& pool = SharedParamPool::inst();
+    for (auto&& i : m_shared_params) {
+        pool.put(i.first, i.second);
+    }
+    m_shared_params.clear();
+}
+
 void GraphLoaderOSSV2::OprLoadContextImpl::load_middle_tensor() {
     auto model = m_loader->m_model;
     if (model->middle_tensors()) {
@@ -841,6 +1323,7 @@ void GraphLoaderOSSV2::OprLoadContextImpl::load_middle_tensor() {
 GraphLoader::LoadResult GraphLoaderOSSV2::load(const LoadConfig& config, bool rewind) {
     mgb_assert(m_file);
     m_cur_load_config = &config;
+    RealTimer timer;
     if (rewind) {
         m_file->rewind();
     }
@@ -858,6 +1341,10 @@ GraphLoader::LoadResult GraphLoaderOSSV2::load(const LoadConfig& config, bool re
     }
 
     m_model = fbs::v2::GetSizePrefixedModel(m_model_buf.data());
+    auto read_time = timer.get_msecs();
+    if (config.load_algo_cache && m_model->algo_cache()) {
+        load_algo_cache(m_model->algo_cache());
+    }
     m_mgb_version = m_model->mge_version();
     m_model_version = m_model->model_version();
     if (m_model->mge_version() > MGB_VERSION) {
@@ -886,6 +1373,7 @@ GraphLoader::LoadResult GraphLoaderOSSV2::load(const LoadConfig& config, bool re
     auto metadata = ctx.load_metadata();
     auto result = ctx.load_oprs();
     result.metadata = metadata;
+    result.stage_time.read = read_time;
     if (m_model->output_alias() && m_model->output_alias()->size() > 0) {
         auto nr_alias = m_model->output_alias()->size();
         result.output_var_list.resize(nr_alias);
@@ -898,7 +1386,9 @@ GraphLoader::LoadResult GraphLoaderOSSV2::load(const LoadConfig& config, bool re
         }
     }
     m_model_loaded = true;
+    ctx.attach_lazy_device_values(result);
     tensor_alignment.reorder_and_align_tensor();
+    ctx.publish_shared_params();
     result.graph_compile_ahead();
     return result;
 }
@@ -921,6 +1411,66 @@ bool is_fbs_v2_file(InputFile& file) {
     return fbs::v2::ModelBufferHasIdentifier(identifier + sizeof(uint32_t));
 }
 
+Maybe<GraphLoader::ModelInfo> read_fbs_v2_model_info(InputFile& file) {
+    uint32_t size;
+    file.read(&size, sizeof(size));
+    file.skip(-sizeof(size));
+    auto buf = file.read_shared(size + sizeof(size));
+    file.skip(-static_cast<int64_t>(buf.size()));
+
+    // only the summary is verified, so the rest of the model is not touched
+    auto data = static_cast<const uint8_t*>(buf.data());
+    flatbuffers::Verifier verifier(data, buf.size());
+    auto root = flatbuffers::ReadScalar<flatbuffers::uoffset_t>(data + sizeof(size));
+    mgb_throw_if(
+            buf.size() < sizeof(size) * 2 ||
+                    root > buf.size() - sizeof(size) - sizeof(root),
+            SerializationError, "invalid model buffer");
+    auto model = fbs::v2::GetSizePrefixedModel(data);
+    auto table = reinterpret_cast<const flatbuffers::Table*>(model);
+    mgb_throw_if(
+            !table->VerifyTableStart(verifier) ||
+                    !table->VerifyOffset(verifier, fbs::v2::Model::VT_INFO) ||
+                    !verifier.VerifyTable(model->info()),
+            SerializationError, "model info verification failed");
+    auto info = model->info();
+    if (!info)
+        return {};
+
+    GraphLoader::ModelInfo ret;
+    auto load_vars = [](const flatbuffers::Vector<
+                                flatbuffers::Offset<fbs::v2::MiddleTensor>>* vars,
+                        std::vector<GraphLoader::ModelInfo::Var>& dest) {
+        if (!vars)
+            return;
+        for (auto var : *vars) {
+            GraphLoader::ModelInfo::Var i;
+            if (var->name())
+                i.name = var->name()->str();
+            if (var->shape()) {
+                i.shape.ndim = var->shape()->size();
+                mgb_throw_if(
+                        i.shape.ndim > TensorShape::MAX_NDIM, SerializationError,
+                        "invalid shape in model info");
+                std::copy(var->shape()->begin(), var->shape()->end(), i.shape.shape);
+            }
+            if (var->dtype())
+                i.dtype = fbs::intl::load_dtype(var->dtype());
+            dest.push_back(std::move(i));
+        }
+    };
+    load_vars(info->inputs(), ret.inputs);
+    load_vars(info->outputs(), ret.outputs);
+    ret.nr_opr = info->nr_oprs();
+    ret.flops = info->flops();
+    if (info->opr_types()) {
+        for (auto i : *info->opr_types()) {
+            ret.opr_types.push_back(i->str());
+        }
+    }
+    return ret;
+}
+
 }  // namespace serialization
 }  // namespace mgb
 
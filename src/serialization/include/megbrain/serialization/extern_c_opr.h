@@ -23,7 +23,7 @@ extern "C" {
 #define INIT_FUNC(s)            INIT_FUNCS(s)
 #define MGB_C_OPR_INIT_FUNC_STR INIT_FUNC(MGB_C_OPR_INIT_FUNC)
 
-#define MGB_EXTERN_C_OPR_VERSION 0x24
+#define MGB_EXTERN_C_OPR_VERSION 0x25
 #define MGB_TENSOR_MAX_NDIM      8
 
 //! data types
@@ -48,9 +48,32 @@ typedef struct MGBTensorLayout {
 //! tensor representation
 typedef struct MGBTensor {
     MGBTensorLayout layout;
-    void* data;  //!< the tensor value, accessible by caller CPU thread
+    //! the tensor value, accessible by caller CPU thread in execute(), or the
+    //! device pointer in execute_device()
+    void* data;
 } MGBTensor;
 
+//! device types of MGBExecEnv
+typedef enum MGBDeviceType {
+    MGB_DEVICE_CPU,
+    MGB_DEVICE_CUDA,
+} MGBDeviceType;
+
+//! the environment to execute an opr on its device, since version 0x25
+typedef struct MGBExecEnv {
+    //! value of MGBDeviceType
+    uint32_t device_type;
+    int device_id;
+
+    //! the native stream of the device, e.g. cudaStream_t on cuda, or null on
+    //! cpu; the work of the opr must be ordered on the stream
+    void* stream;
+
+    //! device memory of the size given by get_workspace_size
+    void* workspace;
+    size_t workspace_size;
+} MGBExecEnv;
+
 //! extern device tenosr struct
 typedef struct ExternDeviceTensor {
     //! layout of device extern tensor, use to validity check with MGBTensor
@@ -140,6 +163,27 @@ typedef struct MGBOprDesc {
 
     //! dynamic extern c opr param
     ExternCOprParam* dynamic_param;
+
+    /*!
+     * \brief optional, since version 0x25: perform the computation on the
+     *      device of the operator
+     *
+     * The data of the tensors are device pointers, so no copy between host
+     * and device is needed. This function should only enqueue the work: the
+     * work is complete when all previous work on env->stream is done, so a
+     * vendor queue can make the stream wait for its own completion event
+     * instead of blocking. If given, it is used in place of execute() on cpu
+     * and cuda.
+     */
+    void (*execute_device)(
+            const struct MGBOprDesc* self, const MGBTensor* input,
+            const MGBTensor* output, const MGBExecEnv* env);
+
+    //! optional, since version 0x25: size in bytes of the workspace of
+    //! execute_device(), allocated by megbrain
+    size_t (*get_workspace_size)(
+            const struct MGBOprDesc* self, const MGBTensorLayout* input,
+            const MGBTensorLayout* output);
 } MGBOprDesc;
 
 //! foreach member function of MGBOprDesc to help initialization
@@ -24,6 +24,11 @@ MGB_DEFINE_OPR_CLASS_WITH_EXPORT(
     void init_output_dtype() override;
     void check_param();
     bool is_loader_support_dynamic_param;
+    //! whether execute_device is given by the loader, see MGBOprDesc
+    bool m_execute_on_device = false;
+
+    //! run execute_device on the comp node; return false if unsupported
+    bool execute_on_device();
 
     static cg::OperatorNodeBase* make_from_desc_shared(
             std::string& name, const VarNodeArray& inputs,
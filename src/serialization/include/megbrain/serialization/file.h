@@ -72,6 +72,18 @@ public:
     //! create an InputFile correspoding to a file on local file system
     MGE_WIN_DECLSPEC_FUC static std::unique_ptr<InputFile> make_fs(const char* path);
 
+    /*!
+     * \brief create an InputFile that maps a file on local file system into
+     *      memory
+     *
+     * The tensor values are shared with the mapped pages without copying,
+     * so the pages are loaded lazily on first access and shared by the
+     * processes that load the same model. The mapping is private, and the
+     * file is never modified. Falls back to make_fs() on platforms without
+     * mmap.
+     */
+    MGE_WIN_DECLSPEC_FUC static std::unique_ptr<InputFile> make_mmap(const char* path);
+
     //! create an InputFile correspoding to a memory region; the memory
     //! region must be alive throughout lifespan of this InputFile
     MGE_WIN_DECLSPEC_FUC static std::unique_ptr<InputFile> make_mem_proxy(
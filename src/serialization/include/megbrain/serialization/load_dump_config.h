@@ -15,6 +15,15 @@
 
 namespace mgb {
 namespace serialization {
+//! how the value of a Float32 tensor is compressed; only supported by the v2
+//! format, see TensorCompression in schema_v2.fbs
+enum class TensorCompression : uint8_t {
+    NONE = 0,
+    FLOAT16 = 1,       //!< stored as float16
+    BFLOAT16 = 2,      //!< stored as bfloat16
+    LINEAR_UINT8 = 3,  //!< linearly quantized to uint8 by the min and max
+};
+
 //! config for dumping a whole graph; setup in GraphDumper
 struct GraphDumpConfig {
     /*!
@@ -54,6 +63,18 @@ struct GraphDumpConfig {
     //! tensor value without layout; useful for compression or encryption
     TensorValueDumper tensor_value_dumper;
 
+    /*!
+     * \brief choose the compression of each tensor value; the values are
+     *      decompressed to Float32 on load
+     *
+     * The compressions other than NONE can only be chosen for Float32 tensors
+     * and can not be used with tensor_value_dumper. They are lossy, so they
+     * are usually chosen for the params only.
+     */
+    using TensorCompressionSelector = thin_function<TensorCompression(
+            const cg::OperatorNodeBase& opr, const HostTensorND& tensor)>;
+    TensorCompressionSelector tensor_compression_selector;
+
     //! a list of output nodes and names. one output node may have multiple
     //! names. this list record the mapping between output node and it's name
     std::vector<std::pair<std::string, SymbolVar>> alias_name_map;
@@ -66,6 +87,16 @@ struct GraphDumpConfig {
     //! whether dump to compat older megbrain version
     std::string compat_older_version;
 
+    //! whether to embed the algorithm cache in the model, so that the graph
+    //! need not be profiled again when it is loaded on the same devices with
+    //! GraphLoadConfig::load_algo_cache; the current PersistentCache must be
+    //! an InFilePersistentCache; only supported by the v2 format
+    bool dump_algo_cache = false;
+
+    //! whether to store identical tensor values only once in the model; only
+    //! supported by the v2 format
+    bool dedup_tensor_value = false;
+
     GraphDumpConfig(
             int keep_var_name_ = 1, bool keep_param_name_ = false,
             bool keep_opr_priority_ = false, bool keep_op_name_ = true,
@@ -120,6 +151,41 @@ struct GraphLoadConfig {
     //! the shape
     bool const_var_shape = false;
 
+    //! whether to allocate the loaded operators from the arena of the graph
+    //! (see ComputingGraph::node_arena) to reduce heap allocations of large
+    //! models; only supported by the v2 format
+    bool use_node_arena = false;
+
+    //! whether to defer copying the values of SharedDeviceTensor on non-CPU
+    //! comp nodes until their first use (see
+    //! SharedDeviceTensorBase::set_lazy_value), so loading does not wait for
+    //! the copies and the values of unused params are never copied; the host
+    //! values are shared from read-only model buffers (such as
+    //! InputFile::make_mmap) when possible; only supported by the v2 format
+    bool lazy_device_value = false;
+
+    //! number of threads to decode the tensor values that can not be shared
+    //! from the model buffer, i.e. the compressed values (see
+    //! GraphDumpConfig::tensor_compression_selector) and the values copied
+    //! from files that are not in memory or decoded by tensor_value_loader,
+    //! which must be thread-safe if this is larger than 1; only supported by
+    //! the v2 format
+    size_t nr_load_threads = 1;
+
+    //! whether to put the algorithm cache embedded in the model (see
+    //! GraphDumpConfig::dump_algo_cache) into the current PersistentCache
+    bool load_algo_cache = false;
+
+    //! whether to share the values of the params (see
+    //! OprLoadContext::load_tensor_shared) with the params of the same value
+    //! in other graphs loaded by this option in this process, so loading the
+    //! same weights in several models keeps one copy of them on each comp
+    //! node; the values are matched by the hash of their serialized bytes, so
+    //! they must be decoded to the same values and must not be modified by
+    //! the graphs; not used with lazy_device_value or writable shared memory
+    //! files; only supported by the v2 format
+    bool share_identical_params = false;
+
     //! callback to modify loaded tensors before they are inserted into the
     //! graph
     TensorModifier tensor_modifier;
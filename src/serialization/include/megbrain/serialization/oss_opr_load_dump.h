@@ -3,6 +3,7 @@
 #if MGB_ENABLE_FBS_SERIALIZATION
 #include "megbrain/comp_node_env.h"
 #include "megbrain/graph/exc_extra_info.h"
+#include "megbrain/opr/io.h"
 #include "megbrain/serialization/batched_device_value_loader.h"
 #include "megbrain/serialization/internal/schema_v2_generated.h"
 #include "megbrain/serialization/opr_load_dump.h"
@@ -40,6 +41,11 @@ class GraphDumperOSSV2 final : public GraphDumper, OprDumpContextFlatBuffers {
 
     std::vector<flatbuffers::Offset<fbs::v2::MiddleTensor>> m_model_middle_tensors;
     ThinHashMap<VarNode*, size_t> m_var2midtensor_id;
+    //! hash of the tensor values dumped, see GraphDumpConfig::dedup_tensor_value
+    std::unordered_multimap<uint64_t, flatbuffers::Offset<flatbuffers::Vector<uint8_t>>>
+            m_tensor_values;
+    //! layouts of the input tensors for the model info
+    std::vector<std::pair<std::string, TensorLayout>> m_input_layouts;
 
     SymbolVarArray converter_all_opr_to_compatiable(const SymbolVarArray& output_vars);
 
@@ -51,6 +57,9 @@ class GraphDumperOSSV2 final : public GraphDumper, OprDumpContextFlatBuffers {
 
     flatbuffers::Offset<fbs::DType> build_dtype(DType dtype);
 
+    flatbuffers::Offset<fbs::v2::ModelInfo> build_model_info(
+            const SymbolVarArray& output_vars);
+
 public:
     GraphDumperOSSV2(std::unique_ptr<OutputFile> file, int version)
             : m_file{std::move(file)}, m_version{version} {}
@@ -81,6 +90,11 @@ public:
     flatbuffers::FlatBufferBuilder& builder() override { return m_builder; }
     void dump_buf_with_len(const void* data, uint32_t size) override;
 
+    //! create the aligned vector of a tensor value, which is shared with the
+    //! identical values dumped before if GraphDumpConfig::dedup_tensor_value
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> build_tensor_value(
+            const uint8_t* data, size_t size);
+
     GraphDumpFormat format() const override { return GraphDumpFormat::FLATBUFFERS_V2; }
     flatbuffers::Offset<fbs::v2::MiddleTensor> build_middle_tensor(const SymbolVar var);
     flatbuffers::Offset<fbs::v2::OutputVar> build_output_var(const SymbolVar var);
@@ -133,6 +147,16 @@ class GraphLoaderOSSV2::OprLoadContextImpl final : public OprLoadContextFlatBuff
     VarNodeArray m_id2varnode;
     std::vector<const fbs::v2::MiddleTensor*> m_middle_tensors;
     BatchedDeviceValueLoader m_device_value_loader;
+    //! lazy values of the device tensors created by load_tensor_shared()
+    std::unordered_map<
+            const DeviceTensorND*,
+            std::shared_ptr<opr::intl::SharedDeviceTensorBase::LazyValue>>
+            m_lazy_device_values;
+    //! tensor values decoded ahead by decode_tensor_values()
+    std::unordered_map<const fbs::v2::Tensor*, HostTensorND> m_decoded_values;
+    //! params to be shared with other graphs after loading, see
+    //! GraphLoadConfig::share_identical_params
+    std::unordered_map<std::string, std::shared_ptr<DeviceTensorND>> m_shared_params;
     const fbs::v2::Operator* m_current_opr;
     size_t m_cur_opr_tensor_cnt;
     size_t m_cur_opr_blob_cnt;
@@ -168,7 +192,11 @@ public:
             mgb_assert(
                     size == tensor_size,
                     "the size is not match when shared the flatbuffer memory\n");
-            if (shared) {
+            //! a read-only buffer can not be reordered for alignment after
+            //! loading, so only the aligned values are shared
+            auto align = tensor.comp_node().get_mem_addr_alignment();
+            bool aligned = !(reinterpret_cast<uintptr_t>(data) & (align - 1));
+            if (shared && (aligned || m_loader->m_file->writable())) {
                 HostTensorStorage storage;
                 auto raw_storage = std::shared_ptr<mgb::dt_byte>(
                         static_cast<mgb::dt_byte*>(ptr), [](void*) {});
@@ -180,6 +208,20 @@ public:
         }
     }
 
+    //! decode the compressed values and the values that are not shared from
+    //! the model buffer by GraphLoadConfig::nr_load_threads threads
+    void decode_tensor_values();
+
+    //! decompress the value of \p tensor to \p dest, or fill it by
+    //! fill_tensor_memory() if it is not compressed
+    void decode_tensor_value(
+            const fbs::v2::Tensor* tensor, HostTensorND& dest, bool shared);
+
+    //! fill the value of \p dest from the decoded value of \p tensor or by
+    //! decode_tensor_value()
+    void fill_tensor_value(
+            const fbs::v2::Tensor* tensor, HostTensorND& dest, bool shared);
+
     std::shared_ptr<HostTensorND> load_tensor() override;
 
     std::shared_ptr<DeviceTensorND> load_tensor_shared(
@@ -187,6 +229,12 @@ public:
 
     void load_single_opr(const fbs::v2::Operator* opr);
 
+    //! attach the lazy device values to the oprs reachable from \p result
+    void attach_lazy_device_values(const LoadResult& result);
+
+    //! make the params loaded by this context visible to other graphs
+    void publish_shared_params();
+
     OprLoadContextImpl(
             GraphLoaderOSSV2* loader, SharedTensorAlignMent* tensor_alignment,
             uint32_t version)
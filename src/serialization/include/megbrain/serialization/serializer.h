@@ -45,6 +45,16 @@ public:
         //! GraphDumper::dump
         SymbolVarArray output_var_list;
 
+        //! time in milliseconds of the stages of load(); only filled by the
+        //! v2 format
+        struct StageTime {
+            double read = 0;    //!< reading and verifying the model buffer
+            double decode = 0;  //!< decoding tensor values ahead
+            double build = 0;   //!< loading the operators
+            double upload = 0;  //!< batched copying of the values to devices
+        };
+        StageTime stage_time;
+
         /**
          * \brief update  output_var_list with output_var_map, output_var_map_id
          *
@@ -108,6 +118,32 @@ public:
     MGE_WIN_DECLSPEC_FUC static Maybe<GraphDumpFormat> identify_graph_dump_format(
             InputFile& file);
 
+    //! the summary of a model, see read_model_info()
+    struct ModelInfo {
+        struct Var {
+            std::string name;
+            TensorShape shape;  //!< empty if unknown at dump time
+            DType dtype;
+        };
+        std::vector<Var> inputs, outputs;
+        size_t nr_opr = 0;
+        //! computation of the oprs whose shapes are known at dump time
+        uint64_t flops = 0;
+        //! names of the opr types used, in ascending order
+        std::vector<std::string> opr_types;
+    };
+
+    /*!
+     * \brief read the summary of a model without loading the graph
+     *
+     * Only the summary is accessed, so it is fast for files in memory such as
+     * InputFile::make_mmap. The position of \p file is unchanged.
+     *
+     * \return the summary, or an empty value if \p file is not in the v2
+     *      format or is dumped without the summary
+     */
+    MGE_WIN_DECLSPEC_FUC static Maybe<ModelInfo> read_model_info(InputFile& file);
+
     virtual ~GraphLoader() = default;
 
     /*!
@@ -516,4 +516,117 @@ TEST(TestExternCOpr, DummyLoaderName) {
             MegBrainError);
 }
 
+namespace {
+//! compute x * scale by execute_device with a workspace holding a copy of x
+class DeviceScaleDesc {
+    static float scale(const MGBOprDesc* self) {
+        return *static_cast<float*>(self->user_data);
+    }
+
+    static void release(MGBOprDesc* self) {
+        delete static_cast<float*>(self->user_data);
+        delete self;
+    }
+
+    static size_t hash(const MGBOprDesc* self) { return mgb::hash<float>(scale(self)); }
+
+    static int is_same(const MGBOprDesc* self, const MGBOprDesc* rhs) {
+        return scale(self) == scale(rhs);
+    }
+
+    static size_t nr_elems(const MGBTensorShape& shape) {
+        size_t ret = 1;
+        for (uint32_t i = 0; i < shape.ndim; ++i)
+            ret *= shape.shape[i];
+        return ret;
+    }
+
+public:
+    static int nr_host_exec, nr_device_exec;
+
+    static void execute(
+            const MGBOprDesc* self, const MGBTensor* input, const MGBTensor* output) {
+        ++nr_host_exec;
+        auto size = nr_elems(input[0].layout.shape);
+        auto inp = static_cast<float*>(input[0].data);
+        auto out = static_cast<float*>(output[0].data);
+        for (size_t i = 0; i < size; ++i)
+            out[i] = inp[i] * scale(self);
+    }
+
+    static void execute_device(
+            const MGBOprDesc* self, const MGBTensor* input, const MGBTensor* output,
+            const MGBExecEnv* env) {
+        ++nr_device_exec;
+        mgb_assert(env->device_type == MGB_DEVICE_CPU && !env->stream);
+        auto size = nr_elems(input[0].layout.shape);
+        mgb_assert(env->workspace_size == size * sizeof(float));
+        auto ws = static_cast<float*>(env->workspace);
+        memcpy(ws, input[0].data, env->workspace_size);
+        auto out = static_cast<float*>(output[0].data);
+        for (size_t i = 0; i < size; ++i)
+            out[i] = ws[i] * scale(self);
+    }
+
+    static size_t get_workspace_size(
+            const MGBOprDesc*, const MGBTensorLayout* input, const MGBTensorLayout*) {
+        return nr_elems(input[0].shape) * mgb_get_dtype_size(MGB_DTYPE_FLOAT32);
+    }
+
+    static void infer_shape(
+            const MGBOprDesc*, const MGBTensorShape* input, MGBTensorShape* output) {
+        output[0] = input[0];
+    }
+
+    //! \param desc_size size of the desc as given by the header of the loader
+    static MGBOprDesc* make(float scale, uint32_t desc_size = sizeof(MGBOprDesc)) {
+        auto desc = std::make_unique<MGBOprDesc>();
+        mgb_init_opr_desc(desc.get(), 1, "device_scale");
+        desc->size = desc_size;
+        desc->user_data = new float{scale};
+#define s(n) desc->n = &DeviceScaleDesc::n;
+        MGB_OPR_DESC_FOREACH_MEM_FN(s);
+        s(execute_device);
+        s(get_workspace_size);
+#undef s
+        return desc.release();
+    }
+};
+int DeviceScaleDesc::nr_host_exec = 0;
+int DeviceScaleDesc::nr_device_exec = 0;
+
+void run_device_scale(uint32_t desc_size) {
+    HostTensorGenerator<> gen;
+    auto host_x = gen({23});
+    auto graph = ComputingGraph::make();
+    auto x = opr::Host2DeviceCopy::make(*graph, host_x);
+    std::string name = "device_scale";
+    auto opr = opr::ExternCOprRunner::make_from_desc(
+            name, {x.node()}, DeviceScaleDesc::make(2.5f, desc_size));
+    HostTensorND host_y;
+    auto func = graph->compile({make_callback_copy(opr->output(0), host_y)});
+    func->execute();
+    ASSERT_EQ(TensorShape{23}, host_y.shape());
+    for (size_t i = 0; i < 23; ++i) {
+        ASSERT_FLOAT_EQ(host_x->ptr<float>()[i] * 2.5f, host_y.ptr<float>()[i]);
+    }
+}
+}  // anonymous namespace
+
+TEST(TestExternCOpr, ExecuteDevice) {
+    DeviceScaleDesc::nr_host_exec = DeviceScaleDesc::nr_device_exec = 0;
+    run_device_scale(sizeof(MGBOprDesc));
+    ASSERT_EQ(0, DeviceScaleDesc::nr_host_exec);
+    ASSERT_EQ(1, DeviceScaleDesc::nr_device_exec);
+}
+
+TEST(TestExternCOpr, ExecuteDeviceOldHeader) {
+    // a loader built with the 0x24 header has no execute_device
+    DeviceScaleDesc::nr_host_exec = DeviceScaleDesc::nr_device_exec = 0;
+    run_device_scale(offsetof(MGBOprDesc, execute_device));
+    ASSERT_EQ(1, DeviceScaleDesc::nr_host_exec);
+    ASSERT_EQ(0, DeviceScaleDesc::nr_device_exec);
+    ASSERT_NE(nullptr, mgb_get_extern_c_opr_api_versioned(0x24));
+}
+
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -9,6 +9,7 @@
 #include "megbrain/opr/utility.h"
 #include "megbrain/serialization/serializer.h"
 #include "megbrain/test/helper.h"
+#include "megbrain/utils/infile_persistent_cache.h"
 
 using namespace mgb;
 using namespace serialization;
@@ -1048,6 +1049,347 @@ TEST(TestSerializer2, ShareMemv2) {
     test_serializer_memshare(GraphDumpFormat::FLATBUFFERS_V2);
 }
 
+TEST(TestSerializer2, MmapLoadV2) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    auto xval = gen({127}, "cpu0"), bval = gen({1}, "cpu0");
+    {
+        auto graph = ComputingGraph::make();
+        auto x = opr::SharedDeviceTensor::make(*graph, *xval).rename("x");
+        auto b = opr::SharedDeviceTensor::make(*graph, *bval).rename("b");
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        dumper->dump({x + b, x});
+    }
+
+    HostTensorND expected;
+    expected.copy_from(*xval);
+    for (size_t i = 0; i < 127; ++i) {
+        expected.ptr<float>()[i] += bval->ptr<float>()[0];
+    }
+
+    auto loader = GraphLoader::make(InputFile::make_mmap(fname.c_str()), format);
+    auto rst = loader->load();
+    auto&& x = rst.output_var_map.at("x")
+                       .node()
+                       ->owner_opr()
+                       ->cast_final_safe<opr::SharedDeviceTensor>();
+    //! the values in the read-only mapping are shared only if they are aligned
+    auto align = x.dev_data()->comp_node().get_mem_addr_alignment();
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(x.dev_data()->raw_ptr()) & (align - 1));
+    MGB_ASSERT_TENSOR_EQ(*xval, HostTensorND{}.copy_from(*x.dev_data()).sync());
+
+    HostTensorND val;
+    auto func = rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)});
+    func->execute();
+    MGB_ASSERT_TENSOR_EQ(expected, val);
+}
+
+TEST(TestSerializer2, AlgoCache) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    std::string category = "test_category", key = "key", value = "value";
+    auto blob = [](const std::string& s) {
+        return PersistentCache::Blob{s.data(), s.size()};
+    };
+    auto old_cache = PersistentCache::set_impl(
+            std::make_shared<InFilePersistentCache>());
+    PersistentCache::inst().put(category, blob(key), blob(value));
+    {
+        auto graph = ComputingGraph::make();
+        HostTensorGenerator<> gen;
+        auto x = opr::Host2DeviceCopy::make(*graph, gen({2, 3})).rename("x");
+        GraphDumpConfig config;
+        config.dump_algo_cache = true;
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        dumper->dump({x + 1}, config);
+    }
+
+    //! the entries of the current cache are merged by set_impl(), so they are
+    //! cleared before switching the cache
+    auto load = [&](bool load_algo_cache) {
+        PersistentCache::inst().clear_cache();
+        PersistentCache::set_impl(std::make_shared<InMemoryPersistentCache>());
+        GraphLoadConfig config;
+        config.load_algo_cache = load_algo_cache;
+        auto loader = GraphLoader::make(InputFile::make_fs(fname.c_str()), format);
+        loader->load(config);
+        return PersistentCache::inst().get(category, blob(key));
+    };
+    ASSERT_FALSE(load(false).valid());
+    auto loaded = load(true);
+    ASSERT_TRUE(loaded.valid());
+    ASSERT_EQ(value, std::string(static_cast<const char*>(loaded->ptr), loaded->size));
+    PersistentCache::inst().clear_cache();
+    PersistentCache::set_impl(old_cache);
+}
+
+TEST(TestSerializer2, ModelInfo) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    GraphDumper::DumpResult dump_rst;
+    {
+        auto graph = ComputingGraph::make();
+        auto x = opr::Host2DeviceCopy::make(*graph, gen({2, 3})).rename("x");
+        auto y = (x * opr::SharedDeviceTensor::make(*graph, *gen({2, 3})) + 1)
+                         .rename("y");
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        dump_rst = dumper->dump({y});
+    }
+
+    auto file = InputFile::make_fs(fname.c_str());
+    auto info = GraphLoader::read_model_info(*file);
+    ASSERT_TRUE(info.valid());
+    ASSERT_EQ(1u, info->inputs.size());
+    ASSERT_EQ("x", info->inputs[0].name);
+    ASSERT_EQ(TensorShape({2, 3}), info->inputs[0].shape);
+    ASSERT_EQ(dtype::Float32(), info->inputs[0].dtype);
+    ASSERT_EQ(1u, info->outputs.size());
+    ASSERT_EQ("y", info->outputs[0].name);
+    ASSERT_EQ(TensorShape({2, 3}), info->outputs[0].shape);
+    ASSERT_EQ(dump_rst.nr_opr, info->nr_opr);
+    ASSERT_GT(info->flops, 0u);
+    ASSERT_TRUE(std::is_sorted(info->opr_types.begin(), info->opr_types.end()));
+    ASSERT_EQ(
+            1, std::count(
+                       info->opr_types.begin(), info->opr_types.end(),
+                       "Host2DeviceCopy"));
+
+    //! the file can still be loaded after reading the info
+    auto loader = GraphLoader::make(std::move(file), format);
+    auto rst = loader->load({}, false);
+    ASSERT_EQ(1u, rst.output_var_list.size());
+}
+
+TEST(TestSerializer2, ShareIdenticalParams) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    auto xval = gen({2, 3}), pval = gen({2, 3}), qval = gen({2, 3});
+    HostTensorND expected;
+    auto dump = [&](bool dedup) {
+        auto graph = ComputingGraph::make();
+        auto x = opr::Host2DeviceCopy::make(*graph, xval).rename("x");
+        auto y = x + opr::SharedDeviceTensor::make(*graph, *pval) +
+                 opr::SharedDeviceTensor::make(*graph, *qval) *
+                         opr::SharedDeviceTensor::make(*graph, *pval);
+        auto func = graph->compile({make_callback_copy(y, expected)});
+        func->execute();
+        GraphDumpConfig config;
+        config.dedup_tensor_value = dedup;
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        return dumper->dump({y}, config).tensor_value_bytes;
+    };
+    auto raw_bytes = dump(false);
+    ASSERT_EQ(raw_bytes - 2 * 3 * 4, dump(true));
+
+    //! two of the three params have the same value
+    auto load = [&](std::unique_ptr<GraphLoader>& loader)
+            -> std::vector<const DeviceTensorND*> {
+        GraphLoadConfig config;
+        config.share_identical_params = true;
+        loader = GraphLoader::make(InputFile::make_fs(fname.c_str()), format);
+        auto rst = loader->load(config);
+        rst.tensor_map.at("x")->copy_from(*xval);
+        HostTensorND val;
+        auto func =
+                rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)});
+        func->execute();
+        EXPECT_PRED_FORMAT3(::mgb::__assert_tensor_equal, expected, val, 1e-6);
+        auto&& params = loader->shared_tensor_id_map();
+        EXPECT_EQ(3u, params.size());
+        std::vector<const DeviceTensorND*> ret;
+        for (auto&& i : params) {
+            ret.push_back(i.second.begin()->second.get());
+        }
+        return ret;
+    };
+    std::unique_ptr<GraphLoader> loader0, loader1;
+    auto params0 = load(loader0), params1 = load(loader1);
+    ASSERT_EQ(params0, params1);
+    std::sort(params0.begin(), params0.end());
+    ASSERT_EQ(
+            2, std::unique(params0.begin(), params0.end()) - params0.begin());
+}
+
+TEST(TestSerializer2, ShareIdenticalParamsQuantized) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<dtype::Int8> gen;
+    auto raw = gen({2, 3});
+    //! the same bytes with different scales are different params
+    HostTensorND pval, qval;
+    pval.copy_from(*raw);
+    qval.copy_from(*raw);
+    pval.reset(pval.storage(), {{2, 3}, dtype::QuantizedS8(0.5f)});
+    qval.reset(qval.storage(), {{2, 3}, dtype::QuantizedS8(2.f)});
+    HostTensorND expected;
+    {
+        auto graph = ComputingGraph::make();
+        auto cvt = [&](const HostTensorND& val) {
+            return opr::TypeCvt::make(
+                    opr::SharedDeviceTensor::make(*graph, val), dtype::Float32());
+        };
+        auto y = cvt(pval) + cvt(qval);
+        graph->compile({make_callback_copy(y, expected)})->execute();
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        dumper->dump({y});
+    }
+
+    GraphLoadConfig config;
+    config.share_identical_params = true;
+    auto loader = GraphLoader::make(InputFile::make_fs(fname.c_str()), format);
+    auto rst = loader->load(config);
+    HostTensorND val;
+    rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)})->execute();
+    MGB_ASSERT_TENSOR_EQ(expected, val);
+    auto&& params = loader->shared_tensor_id_map();
+    ASSERT_EQ(2u, params.size());
+    ASSERT_NE(
+            params[0].second.begin()->second.get(),
+            params[1].second.begin()->second.get());
+}
+
+TEST(TestSerializer2, TensorCompression) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    auto xval = gen({4, 8});
+    std::vector<std::shared_ptr<HostTensorND>> params;
+    for (size_t i = 0; i < 4; ++i) {
+        params.push_back(gen({4, 8}));
+    }
+    size_t raw_bytes;
+    HostTensorND expected;
+    auto dump = [&](bool compress) {
+        auto graph = ComputingGraph::make();
+        SymbolVar y = opr::Host2DeviceCopy::make(*graph, xval).rename("x");
+        for (auto&& i : params) {
+            y = y + opr::SharedDeviceTensor::make(*graph, *i);
+        }
+        auto func = graph->compile({make_callback_copy(y, expected)});
+        func->execute();
+        GraphDumpConfig config;
+        if (compress) {
+            config.tensor_compression_selector = [&](const cg::OperatorNodeBase& opr,
+                                                     const HostTensorND& tensor) {
+                if (!opr.same_type<opr::SharedDeviceTensor>())
+                    return TensorCompression::NONE;
+                for (size_t i = 0; i < params.size(); ++i) {
+                    if (!memcmp(tensor.raw_ptr(), params[i]->raw_ptr(), 4 * 8 * 4))
+                        return static_cast<TensorCompression>(i);
+                }
+                return TensorCompression::NONE;
+            };
+        }
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        return dumper->dump({y}, config).tensor_value_bytes;
+    };
+    raw_bytes = dump(false);
+    auto compressed_bytes = dump(true);
+    //! the params are stored as float32, float16, bfloat16 and uint8
+    ASSERT_EQ(raw_bytes - 32 * (2 + 2 + 3) + 8, compressed_bytes);
+
+    for (size_t nr_threads : {1, 4}) {
+        GraphLoadConfig config;
+        config.nr_load_threads = nr_threads;
+        auto loader = GraphLoader::make(InputFile::make_fs(fname.c_str()), format);
+        auto rst = loader->load(config);
+        rst.tensor_map.at("x")->copy_from(*xval);
+        HostTensorND val;
+        auto func =
+                rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)});
+        func->execute();
+        MGB_ASSERT_TENSOR_NEAR(expected, val, 5e-2);
+    }
+}
+
+TEST(TestSerializer2, ParallelDecode) {
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    auto xval = gen({2, 3});
+    std::vector<std::shared_ptr<HostTensorND>> params;
+    for (size_t i = 0; i < 8; ++i) {
+        params.push_back(gen({2, 3}));
+    }
+    HostTensorND expected;
+    {
+        auto graph = ComputingGraph::make();
+        SymbolVar y = opr::Host2DeviceCopy::make(*graph, xval).rename("x");
+        for (size_t i = 0; i < params.size(); ++i) {
+            auto p = i % 2 ? opr::ImmutableTensor::make(*graph, *params[i])
+                           : opr::SharedDeviceTensor::make(*graph, *params[i]);
+            y = y * p + p;
+        }
+        auto func = graph->compile({make_callback_copy(y, expected)});
+        func->execute();
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        dumper->dump({y});
+    }
+
+    //! custom loaders are called concurrently, so they must be thread-safe
+    std::atomic_size_t nr_loader_call{0};
+    GraphLoadConfig config;
+    config.nr_load_threads = 4;
+    config.tensor_value_loader = [&](void* ptr, const TensorLayout& layout,
+                                     InputFile& fin) {
+        ++nr_loader_call;
+        fin.read(ptr, layout.span().dist_byte());
+    };
+    auto loader = GraphLoader::make(InputFile::make_fs(fname.c_str()), format);
+    auto rst = loader->load(config);
+    ASSERT_GE(nr_loader_call.load(), params.size());
+    ASSERT_GE(rst.stage_time.decode, 0.);
+    rst.tensor_map.at("x")->copy_from(*xval);
+    HostTensorND val;
+    auto func = rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(expected, val, 1e-6);
+}
+
+TEST(TestSerializer2, LazyDeviceValue) {
+    REQUIRE_GPU(1);
+    auto format = GraphDumpFormat::FLATBUFFERS_V2;
+    auto fname = GET_OUTPUT_FILE(format);
+    HostTensorGenerator<> gen;
+    auto xval = gen({127}, "gpu0"), bval = gen({1}, "gpu0");
+    {
+        auto graph = ComputingGraph::make();
+        auto x = opr::SharedDeviceTensor::make(*graph, *xval).rename("x");
+        auto b = opr::SharedDeviceTensor::make(*graph, *bval).rename("b");
+        auto dumper = GraphDumper::make(OutputFile::make_fs(fname.c_str()), format);
+        dumper->dump({x + b, x});
+    }
+
+    HostTensorND expected;
+    expected.copy_from(*xval);
+    for (size_t i = 0; i < 127; ++i) {
+        expected.ptr<float>()[i] += bval->ptr<float>()[0];
+    }
+
+    GraphLoadConfig config;
+    config.lazy_device_value = true;
+    auto loader = GraphLoader::make(InputFile::make_mmap(fname.c_str()), format);
+    auto rst = loader->load(config);
+    auto&& x = rst.output_var_map.at("x")
+                       .node()
+                       ->owner_opr()
+                       ->cast_final_safe<opr::SharedDeviceTensor>();
+    // the value is visible to readers such as dumpers before any execution
+    MGB_ASSERT_TENSOR_EQ(
+            *xval, HostTensorND{}.copy_from(x.get_dev_tensor()).sync());
+
+    HostTensorND val;
+    auto func = rst.graph_compile({make_callback_copy(rst.output_var_list[0], val)});
+    func->execute();
+    MGB_ASSERT_TENSOR_EQ(expected, val);
+    func->execute();
+    MGB_ASSERT_TENSOR_EQ(expected, val);
+    MGB_ASSERT_TENSOR_EQ(*xval, HostTensorND{}.copy_from(*x.dev_data()).sync());
+}
+
 TEST(TestSerializer2, TestSoftMaxLoadDump) {
     auto fname = GET_OUTPUT_FILE(GraphDumpFormat::FLATBUFFERS_V2);
     TensorShape shape{2, 3};
@@ -1,7 +1,10 @@
 #include "megbrain/tensorrt/tensorrt_engine_cache.h"
+#include "megbrain/utils/hash.h"
 
 #if MGB_ENABLE_TENSOR_RT
 
+#include <cinttypes>
+
 #if defined(_WIN32)
 #include <io.h>
 #define F_OK         0
@@ -12,6 +15,258 @@
 
 using namespace mgb;
 
+namespace {
+/*!
+ * \brief hash the content of a tensorrt network
+ *
+ * The tensors are identified by the order they are produced, so that the hash
+ * does not depend on the names given by the graph.
+ */
+class NetworkHasher {
+    XXHash m_hash;
+    ThinHashMap<nvinfer1::ITensor*, int> m_tensor_id;
+    bool m_inspected = true;
+
+    template <typename T>
+    void pod(const T& val) {
+        static_assert(std::is_trivially_copyable<T>::value, "must be pod");
+        m_hash.update(&val, sizeof(T));
+    }
+
+    void dims(const nvinfer1::Dims& val) {
+        pod(val.nbDims);
+        m_hash.update(val.d, sizeof(val.d[0]) * val.nbDims);
+    }
+
+    void weights(const nvinfer1::Weights& val) {
+        size_t elem_size = 4;
+        switch (val.type) {
+            case nvinfer1::DataType::kHALF:
+                elem_size = 2;
+                break;
+            case nvinfer1::DataType::kINT8:
+                elem_size = 1;
+                break;
+            default:
+                break;
+        }
+        pod(val.type);
+        pod(val.count);
+        if (val.values)
+            m_hash.update(val.values, elem_size * val.count);
+    }
+
+    void new_tensor(nvinfer1::ITensor* tensor) {
+        m_tensor_id.emplace(tensor, m_tensor_id.size());
+        dims(tensor->getDimensions());
+        pod(tensor->getType());
+    }
+
+    void tensor_ref(nvinfer1::ITensor* tensor) {
+        // optional inputs of some layers are null
+        auto iter = m_tensor_id.find(tensor);
+        pod(iter == m_tensor_id.end() ? -1 : iter->second);
+    }
+
+    void layer_param(nvinfer1::ILayer* layer);
+
+public:
+    NetworkHasher& network(nvinfer1::INetworkDefinition* network);
+
+    uint64_t digest() const { return m_hash.digest(); }
+
+    //! whether the parameters of all the layers are hashed
+    bool inspected() const { return m_inspected; }
+};
+
+void NetworkHasher::layer_param(nvinfer1::ILayer* layer) {
+    using namespace nvinfer1;
+    switch (layer->getType()) {
+#if NV_TENSOR_RT_VERSION >= 6001
+        case LayerType::kCONVOLUTION: {
+            auto l = static_cast<IConvolutionLayer*>(layer);
+            pod(l->getNbOutputMaps());
+            pod(l->getNbGroups());
+            pod(l->getPaddingMode());
+            dims(l->getKernelSizeNd());
+            dims(l->getStrideNd());
+            dims(l->getPrePadding());
+            dims(l->getPostPadding());
+            dims(l->getDilationNd());
+            weights(l->getKernelWeights());
+            weights(l->getBiasWeights());
+            return;
+        }
+        case LayerType::kDECONVOLUTION: {
+            auto l = static_cast<IDeconvolutionLayer*>(layer);
+            pod(l->getNbOutputMaps());
+            pod(l->getNbGroups());
+            pod(l->getPaddingMode());
+            dims(l->getKernelSizeNd());
+            dims(l->getStrideNd());
+            dims(l->getPrePadding());
+            dims(l->getPostPadding());
+            weights(l->getKernelWeights());
+            weights(l->getBiasWeights());
+            return;
+        }
+        case LayerType::kPOOLING: {
+            auto l = static_cast<IPoolingLayer*>(layer);
+            pod(l->getPoolingType());
+            pod(l->getPaddingMode());
+            pod(l->getAverageCountExcludesPadding());
+            dims(l->getWindowSizeNd());
+            dims(l->getStrideNd());
+            dims(l->getPrePadding());
+            dims(l->getPostPadding());
+            return;
+        }
+        case LayerType::kMATRIX_MULTIPLY: {
+            auto l = static_cast<IMatrixMultiplyLayer*>(layer);
+            pod(l->getOperation(0));
+            pod(l->getOperation(1));
+            return;
+        }
+        case LayerType::kRESIZE: {
+            auto l = static_cast<IResizeLayer*>(layer);
+            pod(l->getResizeMode());
+            dims(l->getOutputDimensions());
+            float scales[Dims::MAX_DIMS];
+            int nr_scale = l->getScales(Dims::MAX_DIMS, scales);
+            pod(nr_scale);
+            if (nr_scale > 0)
+                m_hash.update(scales, sizeof(float) * nr_scale);
+#if NV_TENSOR_RT_VERSION >= 8001
+            pod(l->getCoordinateTransformation());
+            pod(l->getSelectorForSinglePixel());
+            pod(l->getNearestRounding());
+#else
+            pod(l->getAlignCorners());
+#endif
+            return;
+        }
+#endif
+#if NV_TENSOR_RT_VERSION >= 5100
+        case LayerType::kSLICE: {
+            auto l = static_cast<ISliceLayer*>(layer);
+            dims(l->getStart());
+            dims(l->getSize());
+            dims(l->getStride());
+#if NV_TENSOR_RT_VERSION >= 8001
+            pod(l->getMode());
+#endif
+            return;
+        }
+#endif
+        case LayerType::kIDENTITY:
+            return;
+        case LayerType::kSOFTMAX:
+            pod(static_cast<ISoftMaxLayer*>(layer)->getAxes());
+            return;
+        case LayerType::kPADDING: {
+            auto l = static_cast<IPaddingLayer*>(layer);
+            dims(l->getPrePadding());
+            dims(l->getPostPadding());
+            return;
+        }
+        case LayerType::kFULLY_CONNECTED: {
+            auto l = static_cast<IFullyConnectedLayer*>(layer);
+            pod(l->getNbOutputChannels());
+            weights(l->getKernelWeights());
+            weights(l->getBiasWeights());
+            return;
+        }
+        case LayerType::kSCALE: {
+            auto l = static_cast<IScaleLayer*>(layer);
+            pod(l->getMode());
+            weights(l->getShift());
+            weights(l->getScale());
+            weights(l->getPower());
+            return;
+        }
+        case LayerType::kCONSTANT: {
+            auto l = static_cast<IConstantLayer*>(layer);
+            dims(l->getDimensions());
+            weights(l->getWeights());
+            return;
+        }
+        case LayerType::kACTIVATION: {
+            auto l = static_cast<IActivationLayer*>(layer);
+            pod(l->getActivationType());
+#if NV_TENSOR_RT_VERSION >= 5100
+            pod(l->getAlpha());
+            pod(l->getBeta());
+#endif
+            return;
+        }
+        case LayerType::kELEMENTWISE:
+            pod(static_cast<IElementWiseLayer*>(layer)->getOperation());
+            return;
+        case LayerType::kUNARY:
+            pod(static_cast<IUnaryLayer*>(layer)->getOperation());
+            return;
+        case LayerType::kCONCATENATION:
+            pod(static_cast<IConcatenationLayer*>(layer)->getAxis());
+            return;
+        case LayerType::kREDUCE: {
+            auto l = static_cast<IReduceLayer*>(layer);
+            pod(l->getOperation());
+            pod(l->getReduceAxes());
+            pod(l->getKeepDimensions());
+            return;
+        }
+        case LayerType::kSHUFFLE: {
+            auto l = static_cast<IShuffleLayer*>(layer);
+            pod(l->getFirstTranspose());
+            dims(l->getReshapeDimensions());
+            pod(l->getSecondTranspose());
+            return;
+        }
+        default:
+            // the parameters of other layers are not inspected, so two
+            // networks with the same hash may still differ
+            m_inspected = false;
+            return;
+    }
+}
+
+NetworkHasher& NetworkHasher::network(nvinfer1::INetworkDefinition* network) {
+    pod(network->getNbInputs());
+    for (int i = 0; i < network->getNbInputs(); ++i) {
+        auto input = network->getInput(i);
+        new_tensor(input);
+#if NV_TENSOR_RT_VERSION >= 6001
+        pod(input->getAllowedFormats());
+#endif
+    }
+    pod(network->getNbLayers());
+    for (int i = 0; i < network->getNbLayers(); ++i) {
+        auto layer = network->getLayer(i);
+        pod(layer->getType());
+        pod(layer->precisionIsSet() ? static_cast<int>(layer->getPrecision()) : -1);
+        pod(layer->getNbInputs());
+        for (int j = 0; j < layer->getNbInputs(); ++j) {
+            tensor_ref(layer->getInput(j));
+        }
+        layer_param(layer);
+        pod(layer->getNbOutputs());
+        for (int j = 0; j < layer->getNbOutputs(); ++j) {
+            new_tensor(layer->getOutput(j));
+        }
+    }
+    pod(network->getNbOutputs());
+    for (int i = 0; i < network->getNbOutputs(); ++i) {
+        auto output = network->getOutput(i);
+        tensor_ref(output);
+        pod(output->getType());
+#if NV_TENSOR_RT_VERSION >= 6001
+        pod(output->getAllowedFormats());
+#endif
+    }
+    return *this;
+}
+}  // anonymous namespace
+
 /* ========================== TensorRTEngineCache ========================== */
 bool TensorRTEngineCache::sm_enable_engine_cache = false;
 std::string TensorRTEngineCache::make_key_from_trt_opr(const opr::TensorRTOpr* opr) {
@@ -25,7 +280,23 @@ std::string TensorRTEngineCache::make_key_from_trt_opr(const opr::TensorRTOpr* o
     key = ssprintf(
             "dev=%s;cap=%d.%d;trt=%d;", prop.name, prop.major, prop.minor,
             tensorrt_version);
-    key.append(opr->cname());
+    // the input shapes are set to the network before the engine is built
+    std::string shapes;
+    auto&& network = opr->trt_network_def();
+    for (int i = 0; i < network->getNbInputs(); ++i) {
+        if (i)
+            shapes.append(",");
+        auto dims = network->getInput(i)->getDimensions();
+        shapes.append(opr::TensorRTOpr::dims2shape(dims).to_string());
+    }
+    NetworkHasher hasher;
+    hasher.network(network.get());
+    if (!hasher.inspected())
+        return {};
+    key.append(ssprintf(
+            "feature=%u;inp=%s;net=%016" PRIx64,
+            static_cast<uint32_t>(opr->trt_graph_feature_bits()), shapes.c_str(),
+            hasher.digest()));
     return key;
 }
 
@@ -208,8 +479,111 @@ void TensorRTEngineCacheIO::put(const std::string& key, const Engine& value) {
     m_cache[key].init_from_buf(value.ptr, value.size);
 }
 
+/* =================== TensorRTEngineCacheDir  ============= */
+TensorRTEngineCacheDir::TensorRTEngineCacheDir(std::string dirname)
+        : m_dirname{std::move(dirname)} {
+    mgb_throw_if(
+            access(m_dirname.c_str(), F_OK) != 0, SystemError,
+            "tensorrt engine cache dir %s does not exist", m_dirname.c_str());
+    mgb_log_debug("use tensorrt engine cache dir: %s", m_dirname.c_str());
+}
+
+std::string TensorRTEngineCacheDir::filename_of(const std::string& key) const {
+    auto hash = XXHash{}.update(key.data(), key.size()).digest();
+    return ssprintf("%s/trt_engine_%016" PRIx64 ".bin", m_dirname.c_str(), hash);
+}
+
+bool TensorRTEngineCacheDir::read_engine(
+        const std::string& key, EngineStorage& dest) const {
+    auto filename = filename_of(key);
+    FILE* fin = fopen(filename.c_str(), "rb");
+    if (!fin)
+        return false;
+    std::unique_ptr<FILE, int (*)(FILE*)> fin_close{fin, ::fclose};
+    uint32_t key_size;
+    std::string file_key;
+    if (fread(&key_size, sizeof(key_size), 1, fin) != 1 || key_size != key.size())
+        return false;
+    file_key.resize(key_size);
+    if (fread(&file_key[0], key_size, 1, fin) != 1 || file_key != key) {
+        mgb_log_warn(
+                "tensorrt engine cache %s mismatches key %s", filename.c_str(),
+                key.c_str());
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t nr;
+    while ((nr = fread(buf, 1, sizeof(buf), fin)) > 0) {
+        data.insert(data.end(), buf, buf + nr);
+    }
+    if (data.empty())
+        return false;
+    dest.init_from_buf(data.data(), data.size());
+    return true;
+}
+
+Maybe<TensorRTEngineCache::Engine> TensorRTEngineCacheDir::get(const std::string& key) {
+    MGB_LOCK_GUARD(m_mtx);
+    auto find = m_cache.find(key);
+    if (find != m_cache.end())
+        return find->second;
+    EngineStorage engine;
+    if (!read_engine(key, engine))
+        return None;
+    mgb_log_debug("load tensorrt engine from %s", filename_of(key).c_str());
+    return m_cache.emplace(key, std::move(engine)).first->second;
+}
+
+void TensorRTEngineCacheDir::put(const std::string& key, const Engine& value) {
+    MGB_LOCK_GUARD(m_mtx);
+    m_cache[key].init_from_buf(value.ptr, value.size);
+
+    // write to a temp file and rename it, so that other processes never read
+    // a partial file
+    auto filename = filename_of(key);
+    auto tmp_filename = ssprintf("%s.%p.tmp", filename.c_str(), this);
+    FILE* fout = fopen(tmp_filename.c_str(), "wb");
+    if (!fout) {
+        mgb_log_warn(
+                "failed to write tensorrt engine cache %s: %s", tmp_filename.c_str(),
+                strerror(errno));
+        return;
+    }
+    uint32_t key_size = key.size();
+    bool ok = fwrite(&key_size, sizeof(key_size), 1, fout) == 1 &&
+              fwrite(key.data(), key_size, 1, fout) == 1 &&
+              fwrite(value.ptr, value.size, 1, fout) == 1;
+    ok = (fclose(fout) == 0) && ok;
+    if (ok)
+        ok = rename(tmp_filename.c_str(), filename.c_str()) == 0;
+    if (!ok) {
+        mgb_log_warn(
+                "failed to write tensorrt engine cache %s: %s", filename.c_str(),
+                strerror(errno));
+        remove(tmp_filename.c_str());
+    }
+}
+
+namespace {
+std::shared_ptr<TensorRTEngineCache> make_default_engine_cache() {
+    auto dirname = MGB_GETENV("MGB_TENSORRT_ENGINE_CACHE_DIR");
+    if (dirname && access(dirname, F_OK) == 0) {
+        TensorRTEngineCache::enable_engine_cache(true);
+        return std::make_shared<TensorRTEngineCacheDir>(dirname);
+    }
+    if (dirname) {
+        mgb_log_warn(
+                "tensorrt engine cache dir %s does not exist, the engines are not "
+                "saved",
+                dirname);
+    }
+    return std::make_shared<TensorRTEngineCacheMemory>();
+}
+}  // anonymous namespace
+
 MGE_WIN_DECLSPEC_DATA std::shared_ptr<TensorRTEngineCache>
-        TensorRTEngineCache::sm_impl = std::make_shared<TensorRTEngineCacheMemory>();
+        TensorRTEngineCache::sm_impl = make_default_engine_cache();
 #endif
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -596,14 +596,9 @@ void TensorRTOpr::get_output_var_shape(
     m_builder->setMaxBatchSize(1);
 
     auto self = const_cast<TensorRTOpr*>(this);
-    if (m_engine == nullptr && TensorRTEngineCache::enable_engine_cache()) {
-        self->build_engine_from_cache();
-    }
-
-    bool engine_valid = true;
-    if (m_engine == nullptr) {
-        engine_valid = false;
-    } else {
+    auto check_engine = [&]() {
+        if (m_engine == nullptr)
+            return false;
         int nr_input = m_network->getNbInputs();
         mgb_assert(
                 static_cast<size_t>(nr_input) == input().size(), "input size changed");
@@ -622,11 +617,19 @@ void TensorRTOpr::get_output_var_shape(
                 cuda_engine_shp[4] = 4;
             }
 #endif
-            if (!cuda_engine_shp.eq_shape(inp_shape[i])) {
-                engine_valid = false;
-                break;
-            }
+            if (!cuda_engine_shp.eq_shape(inp_shape[i]))
+                return false;
         }
+        return true;
+    };
+
+    bool engine_valid = check_engine();
+    // the cache key contains the input shapes, so the engine built for each
+    // input shape is reused once it has been built
+    if (!engine_valid && TensorRTEngineCache::enable_engine_cache()) {
+        self->m_manager.clear_trt_context();
+        self->build_engine_from_cache();
+        engine_valid = check_engine();
     }
 
     if (!engine_valid) {
@@ -672,8 +675,10 @@ void TensorRTOpr::build_engine_from_cache() {
     TensorRTUniquePtr<nvinfer1::IRuntime> runtime{
             nvinfer1::createInferRuntime(TensorRTOpr::Logger::instance()), {}};
     runtime->setGpuAllocator(m_gpu_allocator.get());
-    auto ret = TensorRTEngineCache::inst().get(
-            TensorRTEngineCache::make_key_from_trt_opr(this));
+    auto key = TensorRTEngineCache::make_key_from_trt_opr(this);
+    if (key.empty())
+        return;
+    auto ret = TensorRTEngineCache::inst().get(key);
     if (!ret.valid())
         return;
     comp_node().activate();
@@ -684,11 +689,12 @@ void TensorRTOpr::build_engine_from_cache() {
 }
 
 void TensorRTOpr::serialize_engine_to_cache() const {
+    auto key = TensorRTEngineCache::make_key_from_trt_opr(this);
+    if (key.empty())
+        return;
     TensorRTUniquePtr<nvinfer1::IHostMemory> buf{trt_cuda_engine()->serialize(), {}};
     mgb_assert(buf, "failed to serialize ICudaEngine");
-    TensorRTEngineCache::inst().put(
-            TensorRTEngineCache::make_key_from_trt_opr(this),
-            {buf->data(), buf->size()});
+    TensorRTEngineCache::inst().put(key, {buf->data(), buf->size()});
 }
 
 MGB_VERSION_SYMBOL3(TENSORRT, NV_TENSORRT_MAJOR, NV_TENSORRT_MINOR, NV_TENSORRT_PATCH);
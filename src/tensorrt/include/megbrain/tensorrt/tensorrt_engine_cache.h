@@ -10,13 +10,18 @@ namespace mgb {
  *
  * The cache stores tensorrt engine as key-value pairs. The keys are ascii
  * strings, which include the device name, the compute capability, the tensorrt
- * runtime version and the name of operator. The get and put methods must be
- * thread safe. read_cache() and dump_cache() are not thread safe
+ * runtime version and a hash of the tensorrt network. The get and put methods
+ * must be thread safe. read_cache() and dump_cache() are not thread safe
  *
- * \note We did not implement the hashing of general graph, and just used the
- * name of tensorrt opr as the key. This implementation is enough, when there is
- * only one megbrain computing graph. Because the names of different tensorrt
- * opr in the same computing graph are different.
+ * The network hash covers the layers and their connections, the parameters and
+ * weights of the layers, the shapes and dtypes of the inputs and the feature
+ * bits of the opr, but not the names. So the same subgraph in different
+ * computing graphs or models shares the engine, and each input shape of an opr
+ * has its own engine.
+ *
+ * If the environment variable MGB_TENSORRT_ENGINE_CACHE_DIR is set, the cache
+ * is enabled at startup and uses a TensorRTEngineCacheDir on that directory,
+ * so that the engines are built only once across processes.
  */
 class TensorRTEngineCache : public NonCopyableObj {
     static MGE_WIN_DECLSPEC_DATA std::shared_ptr<TensorRTEngineCache> sm_impl;
@@ -34,7 +39,8 @@ public:
     virtual void put(const std::string& key, const Engine& value) = 0;
     virtual void dump_cache() = 0;
 
-    //! get the key of the TensorRTOpr
+    //! get the key of the TensorRTOpr, empty if the network has layers whose
+    //! parameters are not hashed, and then the engine must not be cached
     MGE_WIN_DECLSPEC_FUC static std::string make_key_from_trt_opr(
             const opr::TensorRTOpr* opr);
 
@@ -52,6 +58,47 @@ public:
     static TensorRTEngineCache& inst() { return *sm_impl; }
 };
 
+/*!
+ * \brief a persistent tensorrt cache which stores each engine as a file
+ *
+ * The file of an engine is named by the hash of its key, and is read on the
+ * first get() of the key and written on put(), so no dump_cache() is needed and
+ * processes can share the directory.
+ *
+ * file format: <key_size|uint32_t><key|uint8_t*><data|uint8_t*>
+ */
+class TensorRTEngineCacheDir final : public TensorRTEngineCache {
+    struct EngineStorage : public Engine {
+        std::unique_ptr<uint8_t[]> data_refhold;
+
+        EngineStorage& init_from_buf(const void* buf, size_t buf_size) {
+            data_refhold = std::make_unique<uint8_t[]>(buf_size);
+            memcpy(data_refhold.get(), buf, buf_size);
+            size = buf_size;
+            ptr = data_refhold.get();
+            return *this;
+        }
+    };
+
+    std::string m_dirname;
+    std::unordered_map<std::string, EngineStorage> m_cache;
+    std::mutex m_mtx;
+
+    std::string filename_of(const std::string& key) const;
+
+    //! read the engine of given key from its file; return false if not found
+    bool read_engine(const std::string& key, EngineStorage& dest) const;
+
+public:
+    MGE_WIN_DECLSPEC_FUC TensorRTEngineCacheDir(std::string dirname);
+
+    MGE_WIN_DECLSPEC_FUC void dump_cache() override {}
+
+    MGE_WIN_DECLSPEC_FUC Maybe<Engine> get(const std::string& key) override;
+
+    MGE_WIN_DECLSPEC_FUC void put(const std::string& key, const Engine& value) override;
+};
+
 /*!
  * \brief a infile tensorrt cache implementation
  *
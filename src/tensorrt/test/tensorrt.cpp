@@ -9,8 +9,10 @@
 #if MGB_ENABLE_TENSOR_RT
 
 #include "make_trt_net.h"
+#include "megbrain/tensorrt/tensorrt_engine_cache.h"
 #include "megbrain/tensorrt/tensorrt_opr.h"
 
+#include <sys/stat.h>
 #include <random>
 
 using namespace mgb;
@@ -141,6 +143,77 @@ TEST(TestOprTensorRT, ConcatBasic) {
     MGB_ASSERT_TENSOR_NEAR(host_z1, host_z2, 1e-4);
 }
 
+TEST(TestOprTensorRT, EngineCacheDir) {
+    REQUIRE_GPU(1);
+    auto dirname = output_file("trt_engine_cache_dir");
+    mkdir(dirname.c_str(), 0755);
+    auto old_impl = TensorRTEngineCache::set_impl(
+            std::make_shared<TensorRTEngineCacheDir>(dirname));
+    TensorRTEngineCache::enable_engine_cache(true);
+
+    intl::SimpleTensorRTNetwork net;
+    // two oprs of the same network with different names
+    auto make_opr = [&](const char* name) {
+        auto p = net.create_trt_network(true);
+        return TensorRTOpr::make(
+                TensorRTOpr::to_shared_ptr_builder(p.first),
+                TensorRTOpr::to_shared_ptr_network(p.second),
+                intl::TensorRTGraphFeatureBits::NCHW_FLOAT, {}, {net.x},
+                {nullptr, TensorRTOpr::TensorRTDeleter<ICudaEngine>()},
+                OperatorNodeConfig{name})[0];
+    };
+    auto y1 = make_opr("trt_a"), y2 = make_opr("trt_b");
+    auto key_of = [](SymbolVar y) {
+        return TensorRTEngineCache::make_key_from_trt_opr(
+                &y.node()->owner_opr()->cast_final_safe<TensorRTOpr>());
+    };
+
+    HostTensorND host_z, host_z1, host_z2;
+    auto func = net.graph->compile(
+            {make_callback_copy(net.y, host_z), make_callback_copy(y1, host_z1),
+             make_callback_copy(y2, host_z2)});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_z, host_z1, 2e-4);
+    MGB_ASSERT_TENSOR_NEAR(host_z, host_z2, 2e-4);
+    auto key = key_of(y1);
+    ASSERT_EQ(key, key_of(y2));
+
+    // each input shape has its own engine
+    *net.host_x = *net.gen({1, 23, 43, 43});
+    func->execute();
+    MGB_ASSERT_TENSOR_NEAR(host_z, host_z1, 2e-4);
+    MGB_ASSERT_TENSOR_NEAR(host_z, host_z2, 2e-4);
+    ASSERT_NE(key, key_of(y1));
+
+    // the engines are read by another cache on the same dir
+    TensorRTEngineCacheDir reloaded{dirname};
+    ASSERT_TRUE(reloaded.get(key).valid());
+    ASSERT_TRUE(reloaded.get(key_of(y1)).valid());
+    ASSERT_FALSE(reloaded.get(key + "x").valid());
+
+    TensorRTEngineCache::disable_engine_cache();
+    TensorRTEngineCache::set_impl(old_impl);
+}
+
+TEST(TestOprTensorRT, EngineCacheUninspectedLayer) {
+    REQUIRE_GPU(1);
+    intl::SimpleTensorRTNetwork net;
+    auto p = net.create_trt_network(true);
+    // the parameters of a lrn layer are not hashed
+    auto network = p.second;
+    auto output = network->getOutput(0);
+    network->unmarkOutput(*output);
+    auto lrn = network->addLRN(*output, 3, 1e-4f, 0.75f, 1.f);
+    network->markOutput(*lrn->getOutput(0));
+    auto y = TensorRTOpr::make(
+            TensorRTOpr::to_shared_ptr_builder(p.first),
+            TensorRTOpr::to_shared_ptr_network(network),
+            intl::TensorRTGraphFeatureBits::NCHW_FLOAT, {}, {net.x})[0];
+    ASSERT_TRUE(TensorRTEngineCache::make_key_from_trt_opr(
+                        &y.node()->owner_opr()->cast_final_safe<TensorRTOpr>())
+                        .empty());
+}
+
 #endif  // MGB_ENABLE_TENSOR_RT
 
 // vim: syntax=cpp.doxygen foldmethod=marker foldmarker=f{{{,f}}}
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+
+"""
+purpose: Compare the results of the megdnn benchmark suite with a stored baseline
+    to flag the performance regressions of each backend.
+how to use:
+    1. run the suite of a backend, e.g.
+       MEGDNN_BENCH_OUTPUT_DIR=out MEGDNN_BENCH_PEAK_GFLOPS=... MEGDNN_BENCH_PEAK_GBPS=... \\
+           ./megdnn_test --gtest_filter=X86.BENCHMARK_SUITE
+       which writes out/megdnn_bench_x86.json, see dnn/test/common/benchmark_suite.h;
+    2. python3 compare_benchmark.py --baseline_dir baseline out/megdnn_bench_x86.json
+       compares with baseline/megdnn_bench_x86.json and exits with 1 if any case
+       is slower than the baseline by more than --threshold;
+    3. add --update to write the current results as the new baseline.
+"""
+import argparse
+import json
+import os
+import shutil
+import sys
+
+
+def load_records(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data["backend"], {(r["opr"], r["name"]): r for r in data["records"]}
+
+
+def compare(baseline, current, threshold):
+    """return the rows of the report and the number of regressions"""
+    rows = []
+    nr_regression = 0
+    for key in sorted(current):
+        cur = current[key]
+        base = baseline.get(key)
+        if base is None:
+            rows.append((key, None, cur["time_ms"], None, "new"))
+            continue
+        if base["shapes"] != cur["shapes"]:
+            rows.append((key, base["time_ms"], cur["time_ms"], None, "shape changed"))
+            continue
+        ratio = cur["time_ms"] / base["time_ms"] if base["time_ms"] > 0 else 1
+        if ratio > 1 + threshold:
+            status = "REGRESSION"
+            nr_regression += 1
+        elif ratio < 1 - threshold:
+            status = "improved"
+        else:
+            status = ""
+        rows.append((key, base["time_ms"], cur["time_ms"], ratio, status))
+    for key in sorted(set(baseline) - set(current)):
+        rows.append((key, baseline[key]["time_ms"], None, None, "missing"))
+    return rows, nr_regression
+
+
+def fmt(value, spec):
+    return "-" if value is None else format(value, spec)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("results", nargs="+", help="json files written by the suite")
+    parser.add_argument(
+        "--baseline_dir", required=True, help="dir of the baseline json files"
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.1,
+        help="relative slowdown to be reported as a regression",
+    )
+    parser.add_argument(
+        "--update", action="store_true", help="store the results as the baseline"
+    )
+    args = parser.parse_args()
+
+    total_regression = 0
+    for path in args.results:
+        backend, current = load_records(path)
+        baseline_path = os.path.join(
+            args.baseline_dir, "megdnn_bench_{}.json".format(backend)
+        )
+        if args.update:
+            os.makedirs(args.baseline_dir, exist_ok=True)
+            shutil.copyfile(path, baseline_path)
+            print("baseline of {} updated: {}".format(backend, baseline_path))
+            continue
+        if not os.path.exists(baseline_path):
+            print("no baseline of {} at {}, skipped".format(backend, baseline_path))
+            continue
+        _, baseline = load_records(baseline_path)
+        rows, nr_regression = compare(baseline, current, args.threshold)
+        total_regression += nr_regression
+        print("==== {}: {} regression(s) ====".format(backend, nr_regression))
+        print(
+            "{:<12} {:<28} {:>12} {:>12} {:>8}  {}".format(
+                "opr", "case", "base(ms)", "cur(ms)", "ratio", ""
+            )
+        )
+        for (opr, name), base, cur, ratio, status in rows:
+            print(
+                "{:<12} {:<28} {:>12} {:>12} {:>8}  {}".format(
+                    opr,
+                    name,
+                    fmt(base, ".4f"),
+                    fmt(cur, ".4f"),
+                    fmt(ratio, ".3f"),
+                    status,
+                )
+            )
+    return 1 if total_regression else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+
+"""
+purpose: Run a corpus of models through load_and_run in every precision and layout
+    variant, and report latency, throughput, peak memory, load time and first run
+    time per device, to judge optimizations on whole models.
+how to use: python3 model_benchmark.py --help for more details, e.g.
+    python3 model_benchmark.py --load_and_run_file ./load_and_run \\
+        --models_dir models --device cpu --multithread 4 --output cpu.json
+    the corpus is described by model_benchmark_corpus.json: the model files of each
+    precision, the input shapes, the extra args of each precision variant and the
+    layout options of each device. Models missing from --models_dir are skipped.
+    Peak memory is the max RSS of the load_and_run process.
+"""
+import argparse
+import json
+import logging
+import os
+import re
+import subprocess
+import threading
+
+DEVICE_ARGS = {"cpu": ["--cpu"], "cuda": ["--cuda"]}
+
+
+def parse_log(raw_log):
+    """extract the timings printed by the normal strategy of load_and_run"""
+
+    def last_float(pattern):
+        found = re.findall(pattern, raw_log)
+        return float(found[-1]) if found else None
+
+    ret = {
+        "load_ms": last_float(r"load model: ([\d.]+)ms"),
+        "first_run_ms": last_float(r"warm up 0 +([\d.]+)ms"),
+        "avg_ms": last_float(r"avg_time=([\d.]+) ms"),
+        "std_ms": last_float(r"standard_deviation=([\d.]+) ms"),
+        "min_ms": last_float(r"min=([\d.]+) ms"),
+        "max_ms": last_float(r"max=([\d.]+) ms"),
+    }
+    if ret["avg_ms"]:
+        ret["throughput_qps"] = 1000.0 / ret["avg_ms"]
+    # printed by the throughput strategy, i.e. with --concurrency in extra_args
+    qps = last_float(r"throughput=([\d.]+) qps")
+    if qps is not None:
+        ret["throughput_qps"] = qps
+        ret["avg_ms"] = last_float(r"latency: avg=([\d.]+) ms")
+    return ret
+
+
+def run_load_and_run(cmd, timeout):
+    """run a command and return its output, exit status and max RSS in KiB"""
+    logging.debug("run cmd: {}".format(" ".join(cmd)))
+    proc = subprocess.Popen(
+        cmd, stdin=subprocess.DEVNULL, stdout=subprocess.PIPE, stderr=subprocess.STDOUT
+    )
+    timer = threading.Timer(timeout, proc.kill)
+    timer.start()
+    try:
+        out = proc.stdout.read()
+    finally:
+        timer.cancel()
+    # reap the child by wait4 to get its resource usage
+    _, status, rusage = os.wait4(proc.pid, 0)
+    if os.WIFEXITED(status):
+        proc.returncode = os.WEXITSTATUS(status)
+    else:
+        proc.returncode = -os.WTERMSIG(status)
+    proc.stdout.close()
+    return out.decode("utf-8", "replace"), proc.returncode, rusage.ru_maxrss
+
+
+def main():
+    parser = argparse.ArgumentParser(formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument(
+        "--load_and_run_file", help="path for load_and_run", required=True
+    )
+    parser.add_argument("--models_dir", help="models dir", required=True)
+    parser.add_argument(
+        "--corpus",
+        help="corpus description",
+        default=os.path.join(
+            os.path.dirname(os.path.abspath(__file__)), "model_benchmark_corpus.json"
+        ),
+    )
+    parser.add_argument("--device", choices=sorted(DEVICE_ARGS), default="cpu")
+    parser.add_argument(
+        "--multithread", type=int, default=0, help="threads of the cpu comp node"
+    )
+    parser.add_argument("--models", nargs="*", help="only run the given models")
+    parser.add_argument("--variants", nargs="*", help="only run the given variants")
+    parser.add_argument("--layouts", nargs="*", help="only run the given layouts")
+    parser.add_argument("--iter", type=int, default=20)
+    parser.add_argument("--warmup_iter", type=int, default=5)
+    parser.add_argument("--timeout", type=float, default=1800, help="seconds per run")
+    parser.add_argument(
+        "--extra_args", default="", help="args appended to each load_and_run command"
+    )
+    parser.add_argument("--output", help="write the report as json")
+    args = parser.parse_args()
+
+    assert os.path.isfile(args.load_and_run_file), "invalid args for load_and_run_file"
+    with open(args.corpus) as f:
+        corpus = json.load(f)
+
+    device_args = list(DEVICE_ARGS[args.device])
+    if args.device == "cpu" and args.multithread > 0:
+        device_args = ["--multithread", str(args.multithread)]
+    layouts = corpus["layouts"][args.device]
+
+    results = []
+    for model in corpus["models"]:
+        if args.models and model["name"] not in args.models:
+            continue
+        for variant, variant_cfg in corpus["variants"].items():
+            if args.variants and variant not in args.variants:
+                continue
+            fname = model["files"].get(variant_cfg["file"])
+            if fname is None:
+                continue
+            path = os.path.join(args.models_dir, fname)
+            if not os.path.isfile(path):
+                logging.warning("skip {}: {} not found".format(model["name"], path))
+                continue
+            for layout, layout_args in layouts.items():
+                if args.layouts and layout not in args.layouts:
+                    continue
+                cmd = (
+                    [args.load_and_run_file, path]
+                    + device_args
+                    + ["--input", model["input"]]
+                    + ["--iter", str(args.iter), "--warmup_iter", str(args.warmup_iter)]
+                    + ["--no_sanity_check"]
+                    + variant_cfg["args"]
+                    + layout_args
+                    + args.extra_args.split()
+                )
+                raw_log, status, max_rss = run_load_and_run(cmd, args.timeout)
+                item = {
+                    "model": model["name"],
+                    "variant": variant,
+                    "layout": layout,
+                    "device": args.device,
+                    "status": status,
+                    "peak_mem_mb": max_rss / 1024.0 if max_rss else None,
+                }
+                item.update(parse_log(raw_log))
+                if status != 0 or item["avg_ms"] is None:
+                    logging.error(
+                        "{} {} {} failed with status {}:\n{}".format(
+                            model["name"], variant, layout, status, raw_log[-2000:]
+                        )
+                    )
+                results.append(item)
+
+    def fmt(value, spec=".3f"):
+        return "-" if value is None else format(value, spec)
+
+    header = "{:<14} {:<6} {:<11} {:>10} {:>10} {:>10} {:>10} {:>10}".format(
+        "model", "prec", "layout", "avg(ms)", "qps", "mem(MB)", "load(ms)", "first(ms)"
+    )
+    print("==== device: {} ====".format(args.device))
+    print(header)
+    for r in results:
+        print(
+            "{:<14} {:<6} {:<11} {:>10} {:>10} {:>10} {:>10} {:>10}".format(
+                r["model"],
+                r["variant"],
+                r["layout"],
+                fmt(r["avg_ms"]),
+                fmt(r.get("throughput_qps"), ".2f"),
+                fmt(r["peak_mem_mb"], ".1f"),
+                fmt(r["load_ms"]),
+                fmt(r["first_run_ms"]),
+            )
+        )
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"device": args.device, "results": results}, f, indent=2)
+
+
+if __name__ == "__main__":
+    LOG_FORMAT = "%(asctime)s - %(levelname)s - %(message)s"
+    DATE_FORMAT = "%Y/%m/%d %H:%M:%S"
+    logging.basicConfig(level=logging.INFO, format=LOG_FORMAT, datefmt=DATE_FORMAT)
+
+    main()